@@ -28,6 +28,7 @@
 
 #include "InputFlags.hpp"
 #include "driver.hpp"
+#include "metrics.hpp"
 #include "mloNeuronHost.hpp"
 #include "tensor_driver.hpp"
 #include <algorithm>
@@ -371,6 +372,13 @@ int ActivationDriver<Tgpu, Tref>::RunForwardGPU()
                dataSz,
                2 * dataSz / lowtime / 1e6,
                avgtime / (iters - 1));
+        // one operation per element; reads x, writes y
+        PrintMetrics(GetHandle(),
+                     data_type,
+                     "fwd-activ",
+                     1.0 * GetTensorSize(inputTensor),
+                     2.0 * dataSz,
+                     lowtime);
     }
 
     out_dev->FromGPU(GetStream(), out.data());
@@ -457,6 +465,13 @@ int ActivationDriver<Tgpu, Tref>::RunBackwardGPU()
                dataSz,
                2 * dataSz / lowtime / 1e6,
                avgtime / (iters - 1));
+        // reads x, y and dy, writes dx
+        PrintMetrics(GetHandle(),
+                     data_type,
+                     "bwd-activ",
+                     2.0 * GetTensorSize(inputTensor),
+                     4.0 * dataSz,
+                     lowtime);
     }
 
     din_dev->FromGPU(GetStream(), din.data());
@@ -29,6 +29,7 @@
 #include "../test/verify.hpp"
 #include "InputFlags.hpp"
 #include "driver.hpp"
+#include "metrics.hpp"
 #include "miopen_BatchNormHost.hpp"
 #include "timer.hpp"
 #include <algorithm>
@@ -895,6 +896,9 @@ int BatchNormDriver<Tgpu, Tref, Tmix>::RunForwardGPU()
                dataSz,
                (rdCnt * dataSz + wrCnt * dataSz) / lowtime / 1e6,
                lowtime);
+        // Training also computes the mean and variance, inference only scales and shifts.
+        const double flopCnt = (forw == 1 ? 8.0 : 4.0) * M;
+        PrintMetrics(GetHandle(), data_type, "bnormf", flopCnt, (rdCnt + wrCnt) * dataSz, lowtime);
     }
     return miopenStatusSuccess;
 }
@@ -1147,6 +1151,11 @@ int BatchNormDriver<Tgpu, Tref, Tmix>::RunBackwardGPU()
         if(iters > 1)
             printf("GPU Kernel Avg Time Backward Batch Normalization Elapsed: %f ms\n",
                    avgtime / (iters - 1));
+        const size_t M      = GetTensorSize(inputTensor);
+        const size_t dataSz = (M + 2 * GetTensorSize(biasScaleTensor)) *
+                              miopen::GetTypeSize(miopen::deref(inputTensor).GetType());
+        // reads x and dy, writes dx
+        PrintMetrics(GetHandle(), data_type, "bnormb", 10.0 * M, 3.0 * dataSz, lowtime);
     }
 
     return miopenStatusSuccess;
@@ -37,6 +37,7 @@
 #include "InputFlags.hpp"
 #include "conv_verify.hpp"
 #include "driver.hpp"
+#include "metrics.hpp"
 #include "mloConvHost.hpp"
 #include "tensor_driver.hpp"
 #include "timer.hpp"
@@ -329,6 +330,16 @@ class ConvDriver : public Driver
     Timer2 wrw_auxiliary_gwss;
     Timer2 warmup_wall_total; // Counts also auxiliary time.
 
+    /// Bytes of the input, weight and output tensors, i.e. the minimum traffic of one call.
+    double GetTensorBytes() const
+    {
+        const auto bytes = [](miopenTensorDescriptor_t t) {
+            return static_cast<double>(miopen::deref(t).GetElementSpace() *
+                                       miopen::GetTypeSize(miopen::deref(t).GetType()));
+        };
+        return bytes(inputTensor) + bytes(weightTensor) + bytes(outputTensor);
+    }
+
     void PrintForwardTime(float kernel_total_time, float kernel_first_time) const;
     int RunForwardGpuImmed(bool is_transform);
     int RunForwardGpuFind(bool is_transform);
@@ -1367,6 +1378,7 @@ void ConvDriver<Tgpu, Tref>::PrintForwardTime(const float kernel_total_time,
                flopCnt / kernel_average_time / 1e6,
                (readBytes + outputBytes) / kernel_average_time / 1e6,
                kernel_average_time);
+        PrintMetrics(handle, data_type, "fwd-conv", flopCnt, GetTensorBytes(), kernel_average_time);
     }
     else
     { // 3d
@@ -1416,6 +1428,7 @@ void ConvDriver<Tgpu, Tref>::PrintForwardTime(const float kernel_total_time,
                flopCnt / kernel_average_time / 1e6,
                (readBytes + outputBytes) / kernel_average_time / 1e6,
                kernel_average_time);
+        PrintMetrics(handle, data_type, "fwd-conv", flopCnt, GetTensorBytes(), kernel_average_time);
     }
 }
 
@@ -2213,6 +2226,8 @@ void ConvDriver<Tgpu, Tref>::PrintBackwardDataTime(float kernel_total_time, floa
                flopCnt / kernel_average_time / 1e6,
                (readBytes + outputBytes) / kernel_average_time / 1e6,
                kernel_average_time);
+        PrintMetrics(
+            handle, data_type, "bwdd-conv", flopCnt, GetTensorBytes(), kernel_average_time);
     }
     else
     { // 3d
@@ -2262,6 +2277,8 @@ void ConvDriver<Tgpu, Tref>::PrintBackwardDataTime(float kernel_total_time, floa
                flopCnt / kernel_average_time / 1e6,
                (readBytes + outputBytes) / kernel_average_time / 1e6,
                kernel_average_time);
+        PrintMetrics(
+            handle, data_type, "bwdd-conv", flopCnt, GetTensorBytes(), kernel_average_time);
     }
 }
 
@@ -2417,6 +2434,8 @@ void ConvDriver<Tgpu, Tref>::PrintBackwardWrwTime(float kernel_total_time, float
                flopCnt / kernel_average_time / 1e6,
                (readBytes + outputBytes) / kernel_average_time / 1e6,
                kernel_average_time);
+        PrintMetrics(
+            handle, data_type, "bwdw-conv", flopCnt, GetTensorBytes(), kernel_average_time);
     }
     else
     { // 3d
@@ -2460,6 +2479,8 @@ void ConvDriver<Tgpu, Tref>::PrintBackwardWrwTime(float kernel_total_time, float
                flopCnt / kernel_average_time / 1e6,
                (readBytes + outputBytes) / kernel_average_time / 1e6,
                kernel_average_time);
+        PrintMetrics(
+            handle, data_type, "bwdw-conv", flopCnt, GetTensorBytes(), kernel_average_time);
     }
 }
 
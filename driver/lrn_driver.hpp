@@ -29,6 +29,7 @@
 #include "../test/verify.hpp"
 #include "InputFlags.hpp"
 #include "driver.hpp"
+#include "metrics.hpp"
 #include "mloNormHost.hpp"
 #include "tensor_driver.hpp"
 #include "timer.hpp"
@@ -77,6 +78,22 @@ class LRNDriver : public Driver
 
     int VerifyBackward();
     int VerifyForward();
+
+    /// A multiply-add per window element to sum the squares, plus the scale and power.
+    /// num_tensors is the number of input-sized tensors read or written.
+    void PrintLRNMetrics(const std::string& name, float time, int num_tensors)
+    {
+        const double lrnN   = inflags.GetValueInt("lrnN");
+        const double window = inflags.GetValueStr("mode") == "within" ? lrnN * lrnN : lrnN;
+        const double sz     = GetTensorSize(inputTensor);
+        PrintMetrics(GetHandle(),
+                     data_type,
+                     name,
+                     (2.0 * window + 4.0) * sz,
+                     num_tensors * sz * miopen::GetTypeSize(data_type),
+                     time);
+    }
+
     ~LRNDriver()
     {
 
@@ -331,6 +348,7 @@ int LRNDriver<Tgpu, Tref>::RunForwardGPU()
             printf("Wall-clock Time Forward LRN Elapsed: %f ms\n",
                    t.gettime_ms() / inflags.GetValueInt("iter"));
         printf("GPU Kernel Time Forward LRN Elapsed: %f ms\n", time);
+        PrintLRNMetrics("fwd-lrn", time, do_backward ? 3 : 2);
     }
 
     out_dev->FromGPU(GetStream(), out.data());
@@ -398,6 +416,7 @@ int LRNDriver<Tgpu, Tref>::RunBackwardGPU()
             printf("Wall-clock Time Backward LRN Elapsed: %f ms\n",
                    t.gettime_ms() / inflags.GetValueInt("iter"));
         printf("GPU Kernel Time Backward LRN Elapsed: %f ms\n", time);
+        PrintLRNMetrics("bwd-lrn", time, 5);
     }
 
     din_dev->FromGPU(GetStream(), din.data());
@@ -25,6 +25,7 @@
  *******************************************************************************/
 #include <iostream>
 #include <cstdio>
+#include <memory>
 
 #include "activ_driver.hpp"
 #include "bn_driver.hpp"
@@ -35,33 +36,20 @@
 #include "lrn_driver.hpp"
 #include "pool_driver.hpp"
 #include "softmax_driver.hpp"
+#include "sweep_driver.hpp"
 #include "rnn_driver.hpp"
 #include "ctc_driver.hpp"
 #include "dropout_driver.hpp"
 #include "tensorop_driver.hpp"
 #include "reduce_driver.hpp"
+#include "replay_driver.hpp"
+#include "throughput_driver.hpp"
+#include "timing_driver.hpp"
+#include "tune_driver.hpp"
 #include "miopen/config.h"
 
-int main(int argc, char* argv[])
+static Driver* CreateDriver(const std::string& base_arg)
 {
-
-    std::string base_arg = ParseBaseArg(argc, argv);
-
-    if(base_arg == "--version")
-    {
-        size_t major, minor, patch;
-        miopenGetVersion(&major, &minor, &patch);
-        std::cout << "MIOpen (version: " << major << "." << minor << "." << patch << ")"
-                  << std::endl;
-        exit(0);
-    }
-
-    // show command
-    std::cout << "MIOpenDriver";
-    for(int i = 1; i < argc; i++)
-        std::cout << " " << argv[i];
-    std::cout << std::endl;
-
     Driver* drv;
     if(base_arg == "conv")
     {
@@ -179,50 +167,132 @@ int main(int argc, char* argv[])
         printf("Incorrect BaseArg\n");
         exit(0);
     }
+    return drv;
+}
 
-    drv->AddCmdLineArgs();
-    int rc = drv->ParseCmdLineArgs(argc, argv);
+static int SetUpDriver(Driver& drv, int argc, char* argv[])
+{
+    drv.AddCmdLineArgs();
+    int rc = drv.ParseCmdLineArgs(argc, argv);
     if(rc != 0)
     {
         std::cout << "ParseCmdLineArgs() failed, rc = " << rc << std::endl;
         return rc;
     }
-    drv->GetandSetData();
-    rc = drv->AllocateBuffersAndCopy();
+    drv.GetandSetData();
+    rc = drv.AllocateBuffersAndCopy();
     if(rc != 0)
     {
         std::cout << "AllocateBuffersAndCopy() failed, rc = " << rc << std::endl;
         return rc;
     }
+    return 0;
+}
 
+/// Runs the directions given by -F, verifying them if requested.
+static int RunPasses(Driver& drv, const std::string& base_arg)
+{
     int fargval = ((base_arg != "CBAInfer") && (base_arg != "CBAInferfp16"))
-                      ? drv->GetInputFlags().GetValueInt("forw")
+                      ? drv.GetInputFlags().GetValueInt("forw")
                       : 1;
     bool bnFwdInVer   = (fargval == 2 && (base_arg == "bnorm"));
-    bool verifyarg    = (drv->GetInputFlags().GetValueInt("verify") == 1);
+    bool verifyarg    = (drv.GetInputFlags().GetValueInt("verify") == 1);
     int cumulative_rc = 0; // Do not stop running tests in case of errors.
+    int rc;
 
     if(fargval & 1 || fargval == 0 || bnFwdInVer)
     {
-        rc = drv->RunForwardGPU();
+        rc = drv.RunForwardGPU();
         cumulative_rc |= rc;
         if(rc != 0)
             std::cout << "RunForwardGPU() failed, rc = "
                       << "0x" << std::hex << rc << std::dec << std::endl;
         if(verifyarg) // Verify even if Run() failed.
-            cumulative_rc |= drv->VerifyForward();
+            cumulative_rc |= drv.VerifyForward();
     }
 
     if(fargval != 1)
     {
-        rc = drv->RunBackwardGPU();
+        rc = drv.RunBackwardGPU();
         cumulative_rc |= rc;
         if(rc != 0)
             std::cout << "RunBackwardGPU() failed, rc = "
                       << "0x" << std::hex << rc << std::dec << std::endl;
         if(verifyarg) // Verify even if Run() failed.
-            cumulative_rc |= drv->VerifyBackward();
+            cumulative_rc |= drv.VerifyBackward();
     }
 
     return cumulative_rc;
 }
+
+/// Sets up a driver for the throughput, timing and sweep modes, which run its passes apart.
+static ThroughputPass PrepareDriverPass(int argc, char* argv[])
+{
+    const std::string base_arg = argv[1];
+    std::shared_ptr<Driver> drv(CreateDriver(base_arg));
+    if(SetUpDriver(*drv, argc, argv) != 0)
+        return {};
+    return [drv, base_arg]() { return RunPasses(*drv, base_arg); };
+}
+
+static int RunDriver(const std::string& base_arg, int argc, char* argv[])
+{
+    std::unique_ptr<Driver> drv(CreateDriver(base_arg));
+    const int rc = SetUpDriver(*drv, argc, argv);
+    if(rc != 0)
+        return rc;
+    return RunPasses(*drv, base_arg);
+}
+
+int main(int argc, char* argv[])
+{
+
+    std::string base_arg = ParseBaseArg(argc, argv);
+
+    if(base_arg == "--version")
+    {
+        size_t major, minor, patch;
+        miopenGetVersion(&major, &minor, &patch);
+        std::cout << "MIOpen (version: " << major << "." << minor << "." << patch << ")"
+                  << std::endl;
+        exit(0);
+    }
+
+    // show command
+    std::cout << "MIOpenDriver";
+    for(int i = 1; i < argc; i++)
+        std::cout << " " << argv[i];
+    std::cout << std::endl;
+
+    if(base_arg == "tune")
+    {
+        return RunTuning(argc, argv, [](int tune_argc, char* tune_argv[]) {
+            return RunDriver(tune_argv[1], tune_argc, tune_argv);
+        });
+    }
+
+    if(base_arg == "replay")
+    {
+        return RunReplay(argc, argv, [](int replay_argc, char* replay_argv[]) {
+            return RunDriver(replay_argv[1], replay_argc, replay_argv);
+        });
+    }
+
+    if(base_arg == "throughput")
+    {
+        return RunThroughput(argc, argv, PrepareDriverPass);
+    }
+
+    if(base_arg == "timing")
+    {
+        return RunTimingBreakdown(argc, argv, PrepareDriverPass);
+    }
+
+    if(base_arg == "sweep")
+    {
+        return RunSweep(argc, argv, PrepareDriverPass);
+    }
+
+    return RunDriver(base_arg, argc, argv);
+}
+
@@ -0,0 +1,167 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_DRIVER_METRICS_HPP
+#define GUARD_MIOPEN_DRIVER_METRICS_HPP
+
+#include <miopen/miopen.h>
+#include <miopen/env.hpp>
+
+#if MIOPEN_BACKEND_OPENCL
+#if defined(__APPLE__) || defined(__MACOSX)
+#include <OpenCL/cl.h>
+#else
+#include <CL/cl.h>
+#endif
+#elif MIOPEN_BACKEND_HIP
+#include <hip/hip_runtime_api.h>
+#endif
+
+#include <cstdio>
+#include <exception>
+#include <string>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DRIVER_PEAK_TFLOPS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DRIVER_PEAK_GBPS)
+
+/// Theoretical fp32 peaks of the device, zero when unknown.
+struct DevicePeak
+{
+    double flops_per_sec = 0.0;
+    double bytes_per_sec = 0.0;
+};
+
+inline double GetPeakOverride(const char* value, double scale)
+{
+    if(value == nullptr)
+        return 0.0;
+    try
+    {
+        return std::stod(value) * scale;
+    }
+    catch(const std::exception&)
+    {
+        return 0.0;
+    }
+}
+
+/// Peak FLOPS is CUs * 64 lanes * 2 (FMA) * clock. Peak bandwidth is taken from the
+/// memory clock (double data rate) and bus width, which only HIP reports. Both can
+/// be overridden with MIOPEN_DRIVER_PEAK_TFLOPS and MIOPEN_DRIVER_PEAK_GBPS.
+inline DevicePeak QueryDevicePeak(miopenHandle_t handle)
+{
+    DevicePeak peak;
+    const double lanes_per_cu = 64.0;
+    const double flops_per_fma = 2.0;
+#if MIOPEN_BACKEND_OPENCL
+    cl_command_queue q;
+    miopenGetStream(handle, &q);
+    cl_device_id device;
+    cl_uint cus     = 0;
+    cl_uint clk_mhz = 0;
+    if(clGetCommandQueueInfo(q, CL_QUEUE_DEVICE, sizeof(device), &device, nullptr) ==
+           CL_SUCCESS &&
+       clGetDeviceInfo(device, CL_DEVICE_MAX_COMPUTE_UNITS, sizeof(cus), &cus, nullptr) ==
+           CL_SUCCESS &&
+       clGetDeviceInfo(
+           device, CL_DEVICE_MAX_CLOCK_FREQUENCY, sizeof(clk_mhz), &clk_mhz, nullptr) ==
+           CL_SUCCESS)
+    {
+        peak.flops_per_sec = cus * lanes_per_cu * flops_per_fma * clk_mhz * 1e6;
+    }
+#elif MIOPEN_BACKEND_HIP
+    (void)handle;
+    int device = 0;
+    int cus = 0, clk_khz = 0, mem_clk_khz = 0, bus_width = 0;
+    if(hipGetDevice(&device) == hipSuccess &&
+       hipDeviceGetAttribute(&cus, hipDeviceAttributeMultiprocessorCount, device) ==
+           hipSuccess &&
+       hipDeviceGetAttribute(&clk_khz, hipDeviceAttributeClockRate, device) == hipSuccess)
+    {
+        peak.flops_per_sec = cus * lanes_per_cu * flops_per_fma * clk_khz * 1e3;
+    }
+    if(hipDeviceGetAttribute(&mem_clk_khz, hipDeviceAttributeMemoryClockRate, device) ==
+           hipSuccess &&
+       hipDeviceGetAttribute(&bus_width, hipDeviceAttributeMemoryBusWidth, device) == hipSuccess)
+    {
+        peak.bytes_per_sec = 2.0 * mem_clk_khz * 1e3 * bus_width / 8.0;
+    }
+#else
+    (void)handle;
+#endif
+    const auto tflops = GetPeakOverride(miopen::GetStringEnv(MIOPEN_DRIVER_PEAK_TFLOPS{}), 1e12);
+    const auto gbps   = GetPeakOverride(miopen::GetStringEnv(MIOPEN_DRIVER_PEAK_GBPS{}), 1e9);
+    if(tflops > 0.0)
+        peak.flops_per_sec = tflops;
+    if(gbps > 0.0)
+        peak.bytes_per_sec = gbps;
+    return peak;
+}
+
+inline const DevicePeak& GetDevicePeak(miopenHandle_t handle)
+{
+    static const DevicePeak peak = QueryDevicePeak(handle);
+    return peak;
+}
+
+inline std::string FormatPercentOfPeak(double achieved, double peak)
+{
+    if(peak <= 0.0)
+        return "n/a";
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.1f", 100.0 * achieved / peak);
+    return buf;
+}
+
+/// Prints the roofline metrics of one operation in the same shape for every driver.
+/// fp16 and bf16 are compared against twice the fp32 peak (packed math).
+inline void PrintMetrics(miopenHandle_t handle,
+                         miopenDataType_t type,
+                         const std::string& name,
+                         double flops,
+                         double bytes,
+                         float time_ms)
+{
+    if(time_ms <= 0.0f)
+        return;
+    const auto& peak      = GetDevicePeak(handle);
+    const double seconds  = time_ms / 1e3;
+    const double achieved = flops / seconds;
+    const double bw       = bytes / seconds;
+    const double type_mul = (type == miopenHalf || type == miopenBFloat16) ? 2.0 : 1.0;
+
+    printf("metrics: name, flopCnt, bytes, TFLOPS, GB/s, %%peakFLOPS, %%peakBW, timeMs\n");
+    printf("metrics: %s, %.0f, %.0f, %.3f, %.1f, %s, %s, %f\n",
+           name.c_str(),
+           flops,
+           bytes,
+           achieved / 1e12,
+           bw / 1e9,
+           FormatPercentOfPeak(achieved, peak.flops_per_sec * type_mul).c_str(),
+           FormatPercentOfPeak(bw, peak.bytes_per_sec).c_str(),
+           time_ms);
+}
+
+#endif // GUARD_MIOPEN_DRIVER_METRICS_HPP
@@ -27,8 +27,11 @@
 #ifndef MIO_BATCHNORMHOST_H_
 #define MIO_BATCHNORMHOST_H_
 
+#include <miopen/par_for.hpp>
+
 #include <cmath>
 #include <iomanip>
+#include <vector>
 
 #define MIO_HEIRARCH_SEL 0
 
@@ -62,21 +65,17 @@ int miopenBNFwdTrainPerActivationRunHost(
 {
 
     // C*H*W is also stored as in_nstride, H*W is in_cstride, W is in_hstride.
-    unsigned int index;
-    unsigned int adjIndex;
     unsigned int in_dstride = height * width;
     unsigned int in_cstride = depth * in_dstride;
     unsigned int in_nstride = channels * in_cstride;
 
-    Tref mean_accum     = static_cast<Tref>(0.);
-    Tref variance_accum = static_cast<Tref>(0.);
-    Tref elemStd        = static_cast<Tref>(0.);
-
     int ret = 0;
-    for(int cidx = 0; cidx < channels; cidx++)
-    { // via channel
-        mean_accum     = static_cast<Tref>(0.);
-        variance_accum = static_cast<Tref>(0.);
+    miopen::par_for(channels, 1, [&](int cidx) { // via channel
+        unsigned int index;
+        unsigned int adjIndex;
+        Tref mean_accum     = static_cast<Tref>(0.);
+        Tref variance_accum = static_cast<Tref>(0.);
+        Tref elemStd        = static_cast<Tref>(0.);
         // process the batch per channel
         for(int didx = 0; didx < depth; didx++)
         { // via depth
@@ -153,7 +152,7 @@ int miopenBNFwdTrainPerActivationRunHost(
                 }     // for (column)
             }         // for (row)
         }             // for (depth)
-    }                 // for (channel)
+    });               // for (channel)
     return (ret);
 }
 
@@ -181,27 +180,23 @@ int miopenBNFwdTrainSpatialRunHost(
     Tref expAvgFactor)
 {
 
-    unsigned int imgIndex;
-    unsigned int index;
-    unsigned int adjIndex;
     unsigned int in_dstride = height * width;
     unsigned int in_cstride = depth * in_dstride;
     unsigned int in_nstride = channels * in_cstride;
     auto NHW                = static_cast<Tref>(in_cstride * n_batchs);
 
-    Tref elemStd        = static_cast<Tref>(0.);
-    Tref variance_accum = static_cast<Tref>(0.);
-    Tref mean_accum     = static_cast<Tref>(0.);
-
+    int ret = 0;
+    miopen::par_for(channels, 1, [&](int cidx) { // via channel
+        unsigned int imgIndex;
+        unsigned int index;
+        unsigned int adjIndex;
+        Tref elemStd        = static_cast<Tref>(0.);
+        Tref variance_accum = static_cast<Tref>(0.);
+        Tref mean_accum     = static_cast<Tref>(0.);
 #if(MIO_HEIRARCH_SEL == 1)
-    Tref variance_accum_arr[MIO_BN_DIST];
-    Tref mean_accum_arr[MIO_BN_DIST];
+        Tref variance_accum_arr[MIO_BN_DIST];
+        Tref mean_accum_arr[MIO_BN_DIST];
 #endif
-
-    int ret = 0;
-    for(int cidx = 0; cidx < channels; cidx++)
-    { // via channel
-        mean_accum = static_cast<Tref>(0.);
 #if(MIO_HEIRARCH_SEL == 1)
         for(int i = 0; i < MIO_BN_DIST; i++)
         {
@@ -376,7 +371,7 @@ int miopenBNFwdTrainSpatialRunHost(
                 } // for (column)
             }     // for (row)
         }         // for (depth)
-    }             // for (channel)
+    });           // for (channel)
     return (ret);
 }
 
@@ -405,23 +400,21 @@ int miopenBNFwdInferPerActivationRunHost(
 { // use running mean and variance
 
     // C*H*W is also stored as in_nstride, H*W is in_cstride, W is in_hstride.
-    unsigned int index;
-    unsigned int adjIndex;
     unsigned int in_dstride = height * width;
     unsigned int in_cstride = depth * in_dstride;
     unsigned int in_nstride = channels * in_cstride;
 
-    Tref elemStd = static_cast<Tref>(0.);
-
     int ret = 0;
     if(estmeanvar)
     {
 
         printf("Running estimated mean / var inference on CPU.\n");
-        Tref mean     = static_cast<Tref>(0.);
-        Tref variance = static_cast<Tref>(0.);
-        for(int cidx = 0; cidx < channels; cidx++)
-        { // via channel
+        miopen::par_for(channels, 1, [&](int cidx) { // via channel
+            unsigned int index;
+            unsigned int adjIndex;
+            Tref elemStd  = static_cast<Tref>(0.);
+            Tref mean     = static_cast<Tref>(0.);
+            Tref variance = static_cast<Tref>(0.);
             // process the batch per channel
             for(int didx = 0; didx < depth; didx++)
             { // via depth
@@ -447,15 +440,17 @@ int miopenBNFwdInferPerActivationRunHost(
                     }     // for (column)
                 }
             }
-        }
+        });
     }
     else
     {
 
-        Tref mean_accum     = static_cast<Tref>(0.);
-        Tref variance_accum = static_cast<Tref>(0.);
-        for(int cidx = 0; cidx < channels; cidx++)
-        { // via channel
+        miopen::par_for(channels, 1, [&](int cidx) { // via channel
+            unsigned int index;
+            unsigned int adjIndex;
+            Tref elemStd        = static_cast<Tref>(0.);
+            Tref mean_accum     = static_cast<Tref>(0.);
+            Tref variance_accum = static_cast<Tref>(0.);
             // process the batch per channel
             for(int didx = 0; didx < depth; didx++)
             { // via depth
@@ -507,7 +502,7 @@ int miopenBNFwdInferPerActivationRunHost(
                     }     // for (column)
                 }         // for (row)
             }
-        } // for (channel)
+        }); // for (channel)
     }
     return (ret);
 }
@@ -532,23 +527,22 @@ int miopenBNFwdInferSpatialRunHost(
     Tref* estimatedVariance)
 {
 
-    unsigned int index;
-    unsigned int adjIndex;
     unsigned int in_dstride = height * width;
     unsigned int in_cstride = depth * in_dstride;
     unsigned int in_nstride = channels * in_cstride;
 
-    Tref elemStd = static_cast<Tref>(0.);
-    int ret      = 0;
+    int ret = 0;
 
     if(estmeanvar)
     {
 
-        Tref variance = static_cast<Tref>(0.);
-        Tref mean     = static_cast<Tref>(0.);
-        Tref inhat    = static_cast<Tref>(0.);
-        for(int cidx = 0; cidx < channels; cidx++)
-        { // via channel
+        miopen::par_for(channels, 1, [&](int cidx) { // via channel
+            unsigned int index;
+            unsigned int adjIndex;
+            Tref elemStd  = static_cast<Tref>(0.);
+            Tref variance = static_cast<Tref>(0.);
+            Tref mean     = static_cast<Tref>(0.);
+            Tref inhat    = static_cast<Tref>(0.);
             mean           = estimatedMean[cidx];
             variance       = estimatedVariance[cidx];
             Tref invertVar = static_cast<Tref>(1.0) / static_cast<Tref>(sqrt(variance + epsilon));
@@ -570,20 +564,20 @@ int miopenBNFwdInferSpatialRunHost(
                     }
                 }
             }
-        }
+        });
     }
     else
     {
-
+        miopen::par_for(channels, 1, [&](int cidx) { // via channel
+            unsigned int index;
+            unsigned int adjIndex;
+            Tref elemStd        = static_cast<Tref>(0.);
+            Tref variance_accum = static_cast<Tref>(0.);
+            Tref mean_accum     = static_cast<Tref>(0.);
 #if(MIO_HEIRARCH_SEL == 1)
-        Tref variance_accum_arr[MIO_BN_DIST];
-        Tref mean_accum_arr[MIO_BN_DIST];
+            Tref variance_accum_arr[MIO_BN_DIST];
+            Tref mean_accum_arr[MIO_BN_DIST];
 #endif
-
-        Tref variance_accum = static_cast<Tref>(0.);
-        Tref mean_accum     = static_cast<Tref>(0.);
-        for(int cidx = 0; cidx < channels; cidx++)
-        { // via channel
 #if(MIO_HEIRARCH_SEL == 1)
             for(int i = 0; i < MIO_BN_DIST; i++)
             {
@@ -592,7 +586,6 @@ int miopenBNFwdInferSpatialRunHost(
             }
 #endif
 
-            mean_accum = static_cast<Tref>(0.);
 #if(MIO_HEIRARCH_SEL == 0)
             // process the batch per channel
             for(int didx = 0; didx < depth; didx++)
@@ -714,7 +707,7 @@ int miopenBNFwdInferSpatialRunHost(
                     }     // for (column)
                 }         // for (row)
             }             // for
-        }                 // for (channel)
+        });               // for (channel)
     }                     // end if
     return (ret);
 }
@@ -748,28 +741,27 @@ int miopenBNBwdPerActivationRunHost(
 {
 
     // C*H*W is also stored as in_nstride, H*W is in_cstride, W is in_hstride.
-    unsigned int index, xhat_index;
-    unsigned int adjIndex;
     unsigned int in_dstride = height * width;
     unsigned int in_cstride = depth * in_dstride;
     unsigned int in_nstride = channels * in_cstride;
-    Tref elemStd            = static_cast<Tref>(0.);
-    Tref mean               = static_cast<Tref>(0.);
-    Tref elemInvVar         = static_cast<Tref>(0.);
-    Tref dyelem             = static_cast<Tref>(0.);
-    Tref dxhat              = static_cast<Tref>(0.);
-    Tref dxhathat           = static_cast<Tref>(0.);
-    Tref tmp1, tmp2, tmp3;
-
-    std::vector<Tref> xhat(n_batchs * in_cstride);
+
     // When depth is present, flatten depth and height as height
     if(depth)
         height *= depth;
 
     if(savedmeanvar)
     {
-        for(int cidx = 0; cidx < channels; cidx++)
-        { // via channel
+        miopen::par_for(channels, 1, [&](int cidx) { // via channel
+            unsigned int index, xhat_index;
+            unsigned int adjIndex;
+            Tref elemStd    = static_cast<Tref>(0.);
+            Tref mean       = static_cast<Tref>(0.);
+            Tref elemInvVar = static_cast<Tref>(0.);
+            Tref dyelem     = static_cast<Tref>(0.);
+            Tref dxhat      = static_cast<Tref>(0.);
+            Tref dxhathat   = static_cast<Tref>(0.);
+            Tref tmp1, tmp2, tmp3;
+            std::vector<Tref> xhat(n_batchs * in_cstride);
             for(int didx = 0; didx < depth; didx++)
             { // via depth
                 // process the batch per channel
@@ -814,14 +806,23 @@ int miopenBNBwdPerActivationRunHost(
                     }     // for (column)
                 }         // for (row)
             }             // for (didx)
-        }                 // for (cidx)
+        });               // for (cidx)
     }
     else
     {
 
-        Tref variance = static_cast<Tref>(0.);
-        for(int cidx = 0; cidx < channels; cidx++)
-        { // via channel
+        miopen::par_for(channels, 1, [&](int cidx) { // via channel
+            unsigned int index, xhat_index;
+            unsigned int adjIndex;
+            Tref elemStd    = static_cast<Tref>(0.);
+            Tref mean       = static_cast<Tref>(0.);
+            Tref elemInvVar = static_cast<Tref>(0.);
+            Tref dyelem     = static_cast<Tref>(0.);
+            Tref dxhat      = static_cast<Tref>(0.);
+            Tref dxhathat   = static_cast<Tref>(0.);
+            Tref variance   = static_cast<Tref>(0.);
+            Tref tmp1, tmp2, tmp3;
+            std::vector<Tref> xhat(n_batchs * in_cstride);
             for(int didx = 0; didx < depth; didx++)
             { // via depth
                 // process the batch per channel
@@ -888,7 +889,7 @@ int miopenBNBwdPerActivationRunHost(
                     }     // for (column)
                 }         // for (row)
             }             // for (depth)
-        }                 // for (channel)
+        });               // for (channel)
     }                     // end else
 
     return 0;
@@ -919,23 +920,21 @@ int miopenBNBwdSpatialRunHost(
 {
 
     // C*H*W is also stored as in_nstride, H*W is in_cstride, W is in_hstride.
-    unsigned int index;
-    unsigned int adjIndex;
     unsigned int in_dstride = height * width;
     unsigned int in_cstride = depth * in_dstride;
     unsigned int in_nstride = channels * in_cstride;
-    unsigned int Csubindex  = 0;
-    Tref elemStd            = static_cast<Tref>(0.);
-    Tref mean               = static_cast<Tref>(0.);
-    Tref invVar             = static_cast<Tref>(0.);
-    Tref dyelem             = static_cast<Tref>(0.);
     Tref NHW                = static_cast<Tref>(n_batchs * in_cstride);
 
     if(savedmeanvar)
     {
-        for(int cidx = 0; cidx < channels; cidx++)
-        { // via channel
-            Csubindex = in_cstride * cidx;
+        miopen::par_for(channels, 1, [&](int cidx) { // via channel
+            unsigned int index;
+            unsigned int adjIndex;
+            unsigned int Csubindex = in_cstride * cidx;
+            Tref elemStd           = static_cast<Tref>(0.);
+            Tref mean              = static_cast<Tref>(0.);
+            Tref invVar            = static_cast<Tref>(0.);
+            Tref dyelem            = static_cast<Tref>(0.);
             for(int didx = 0; didx < depth; didx++)
             { // via depth
                 for(int row = 0; row < height; row++)
@@ -982,24 +981,28 @@ int miopenBNBwdSpatialRunHost(
                     }     // for (column)
                 }         // for (row)
             }             // for (depth)
-        }                 // for (cidx)
+        });               // for (cidx)
     }
     else
     {
-
+        miopen::par_for(channels, 1, [&](int cidx) { // via channel
+            unsigned int index;
+            unsigned int adjIndex;
+            unsigned int Csubindex = 0;
+            Tref elemStd           = static_cast<Tref>(0.);
+            Tref mean              = static_cast<Tref>(0.);
+            Tref invVar            = static_cast<Tref>(0.);
+            Tref dyelem            = static_cast<Tref>(0.);
+            Tref variance          = static_cast<Tref>(0.);
 #if(MIO_HEIRARCH_SEL == 1)
-        Tref variance_accum_arr[MIO_BN_DIST];
-        Tref mean_accum_arr[MIO_BN_DIST];
-        Tref dbias_accum_arr[MIO_BN_DIST];
-        Tref dscale_accum_arr[MIO_BN_DIST];
+            Tref variance_accum_arr[MIO_BN_DIST];
+            Tref mean_accum_arr[MIO_BN_DIST];
+            Tref dbias_accum_arr[MIO_BN_DIST];
+            Tref dscale_accum_arr[MIO_BN_DIST];
 #else
-        std::vector<Tref> xhat(n_batchs * in_cstride);
-        unsigned int xhat_index;
+            std::vector<Tref> xhat(n_batchs * in_cstride);
+            unsigned int xhat_index;
 #endif
-
-        Tref variance = static_cast<Tref>(0.);
-        for(int cidx = 0; cidx < channels; cidx++)
-        { // via channel
 #if(MIO_HEIRARCH_SEL == 1)
             for(int i = 0; i < MIO_BN_DIST; i++)
             {
@@ -1211,7 +1214,7 @@ int miopenBNBwdSpatialRunHost(
                 }     // for (column)
             }         // for (row)
 #endif
-        } // for (channel)
+        }); // for (channel)
     }     // end else
 
     return 0;
@@ -27,9 +27,12 @@
 #ifndef MLO_CONVHOST_H_
 #define MLO_CONVHOST_H_
 
+#include <miopen/par_for.hpp>
+
 #include <cmath>
 #include <iomanip>
 #include <iostream>
+#include <vector>
 
 #include "calcerr.hpp"
 
@@ -85,91 +88,43 @@ void ADNN_mm_cpu(const Dtype* a_ptr,
     }
 
     size_t inner_loop = (!(a_flags & ADNN_MM_TRANSPOSE)) ? a_cols : a_rows;
-
-    if(!(a_flags & ADNN_MM_TRANSPOSE) && !(b_flags & ADNN_MM_TRANSPOSE))
-    {
-        for(size_t n = 0; n < c_rows; ++n)
+    bool a_trans      = (a_flags & ADNN_MM_TRANSPOSE) != 0;
+    bool b_trans      = (b_flags & ADNN_MM_TRANSPOSE) != 0;
+
+    // Rows of C are independent. Each element still sums over m in ascending order, so the
+    // result does not depend on the thread count.
+    miopen::par_for(c_rows, 1, [&](size_t n) {
+        Dtype* c_row = c_ptr + n * c_stride;
+        auto a_elem  = [&](size_t m) {
+            return a_trans ? a_ptr[m * a_stride + n] : a_ptr[n * a_stride + m];
+        };
+
+        if(!b_trans)
         {
-            for(size_t k = 0; k < c_cols; ++k)
+            // Row-wise accumulation reads B and writes the accumulators contiguously.
+            std::vector<Dtype> mm_e(c_cols, static_cast<Dtype>(0));
+            for(size_t m = 0; m < inner_loop; ++m)
             {
-                Dtype mm_e = static_cast<Dtype>(0);
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    mm_e += a_ptr[n * a_stride + m] * b_ptr[m * b_stride + k];
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-    }
-    else if((a_flags & ADNN_MM_TRANSPOSE) && !(b_flags & ADNN_MM_TRANSPOSE))
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-
-                Dtype mm_e = static_cast<Dtype>(0);
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    mm_e += a_ptr[m * a_stride + n] * b_ptr[m * b_stride + k];
-#if 0
-					if (
-						(n == 0 && k == 33
-						|| n == 1 && k == 32
-						|| n == 3 && k == 1
-						|| n == 4 && k == 0
-
-						)
-						&& a_ptr[m*a_stride + n] * b_ptr[m*b_stride + k] != 0
-						)
-					{
-						printf("C:mm:%d %d %d   %11.9f %11.9f %11.9f %11.9f\n",
-							n, k, m,
-							mm_e, a_ptr[m*a_stride + n], b_ptr[m*b_stride + k], a_ptr[m*a_stride + n] * b_ptr[m*b_stride + k]);
-					}
-#endif
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
+                const Dtype a_nm   = a_elem(m);
+                const Dtype* b_row = b_ptr + m * b_stride;
+                for(size_t k = 0; k < c_cols; ++k)
+                    mm_e[k] += a_nm * b_row[k];
             }
-        }
-    }
-    else if(!(a_flags & ADNN_MM_TRANSPOSE) && (b_flags & ADNN_MM_TRANSPOSE))
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
             for(size_t k = 0; k < c_cols; ++k)
-            {
-                Dtype mm_e = static_cast<Dtype>(0);
-
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    mm_e += a_ptr[n * a_stride + m] * b_ptr[k * b_stride + m];
-#if 0
-					if (n == 0 && k == 6 && a_ptr[n*a_stride + m] * b_ptr[k*b_stride + m] != 0)
-					{
-						printf("%4d  %11.9f %11.9f %11.9f\n", m, mm_e, a_ptr[n*a_stride + m], b_ptr[k*b_stride + m]);
-					}
-#endif
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
+                c_row[k] = beta * c_row[k] + alpha * mm_e[k];
         }
-    }
-    else
-    {
-        for(size_t n = 0; n < c_rows; ++n)
+        else
         {
             for(size_t k = 0; k < c_cols; ++k)
             {
-                Dtype mm_e = static_cast<Dtype>(0);
+                const Dtype* b_row = b_ptr + k * b_stride;
+                Dtype mm_e         = static_cast<Dtype>(0);
                 for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    c_ptr[n * c_stride + k] += a_ptr[m * a_stride + n] * b_ptr[k * b_stride + m];
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
+                    mm_e += a_elem(m) * b_row[m];
+                c_row[k] = beta * c_row[k] + alpha * mm_e;
             }
         }
-    }
+    });
 }
 
 template <typename Dtype>
@@ -32,6 +32,9 @@
 #pragma clang diagnostic ignored "-Wfloat-equal"
 #endif
 
+#include <miopen/par_for.hpp>
+
+#include <atomic>
 #include <cmath>
 #include <cstring>
 #include <iomanip>
@@ -113,155 +116,158 @@ bool mloPoolingForwardRunHostAndVerify(int pooling_method,
                                        int index_position = 1)
 {
 
-    bool match = true;
+    std::atomic<bool> match{true};
     _Tcheck MAX_VAL(3.402823466e+38);
     _Tgpu G_MAX_VAL = (sizeof(_Tgpu) == 4 || sizeof(_Tgpu) == 8)
                           ? static_cast<_Tgpu>(3.402823466e+38)
                           : static_cast<_Tgpu>(65504);
-    // c-emulator
-    _Tcheck res = static_cast<_Tcheck>(0);
-
-    for(int b = 0; b < n_batchs && match; b++)
-    {
-        for(int o = 0; o < n_outputs && match; o++)
+    // Every (batch, channel) plane is checked independently; after a mismatch the planes which
+    // have not started yet are skipped.
+    miopen::par_for(n_batchs * n_outputs, 1, [&](int bo) {
+        if(!match)
+            return;
+        int b = bo / n_outputs;
+        int o = bo % n_outputs;
+
+        // c-emulator
+        _Tcheck res = static_cast<_Tcheck>(0);
+
+        for(int k = 0; k < top_depth && match; k++)
         {
-            for(int k = 0; k < top_depth && match; k++)
+            for(int j = 0; j < top_height && match; j++)
             {
-                for(int j = 0; j < top_height && match; j++)
+                for(int i = 0; i < top_width && match; i++)
                 {
-                    for(int i = 0; i < top_width && match; i++)
+                    // c-emulator
+                    if(pooling_method == MLO_POOLING_OP_MAX)
                     {
-                        // c-emulator
-                        if(pooling_method == MLO_POOLING_OP_MAX)
-                        {
-                            res = -MAX_VAL;
-                        }
-                        else if(pooling_method == MLO_POOLING_OP_AVE ||
-                                pooling_method == MLO_POOLING_OP_AVE_INCLUSIVE)
-                        {
-                            res = static_cast<_Tcheck>(0);
-                        }
+                        res = -MAX_VAL;
+                    }
+                    else if(pooling_method == MLO_POOLING_OP_AVE ||
+                            pooling_method == MLO_POOLING_OP_AVE_INCLUSIVE)
+                    {
+                        res = static_cast<_Tcheck>(0);
+                    }
 
-                        int dstart = k * pool_stride_d - pad_d;
-                        int hstart = j * pool_stride_h - pad_h;
-                        int wstart = i * pool_stride_w - pad_w;
-                        int dend   = std::min(dstart + filter_size_d, bot_depth);
-                        int hend   = std::min(hstart + filter_size_h, bot_height);
-                        int wend   = std::min(wstart + filter_size_w, bot_width);
-                        dstart     = std::max(dstart, 0);
-                        hstart     = std::max(hstart, 0);
-                        wstart     = std::max(wstart, 0);
-
-                        int pool_size;
-                        if(pooling_method == MLO_POOLING_OP_AVE)
-                            pool_size = (dend - dstart) * (hend - hstart) * (wend - wstart);
-                        else
-                            pool_size        = filter_size_w * filter_size_h * filter_size_d;
-                        pool_size            = (pool_size == 0) ? 1 : pool_size;
-                        size_t res_index     = 0;
-                        size_t res_index_gpu = 0;
-                        bool found           = false;
-                        for(int d = dstart; d < dend; ++d)
+                    int dstart = k * pool_stride_d - pad_d;
+                    int hstart = j * pool_stride_h - pad_h;
+                    int wstart = i * pool_stride_w - pad_w;
+                    int dend   = std::min(dstart + filter_size_d, bot_depth);
+                    int hend   = std::min(hstart + filter_size_h, bot_height);
+                    int wend   = std::min(wstart + filter_size_w, bot_width);
+                    dstart     = std::max(dstart, 0);
+                    hstart     = std::max(hstart, 0);
+                    wstart     = std::max(wstart, 0);
+
+                    int pool_size;
+                    if(pooling_method == MLO_POOLING_OP_AVE)
+                        pool_size = (dend - dstart) * (hend - hstart) * (wend - wstart);
+                    else
+                        pool_size        = filter_size_w * filter_size_h * filter_size_d;
+                    pool_size            = (pool_size == 0) ? 1 : pool_size;
+                    size_t res_index     = 0;
+                    size_t res_index_gpu = 0;
+                    bool found           = false;
+                    for(int d = dstart; d < dend; ++d)
+                    {
+                        for(int h = hstart; h < hend; ++h)
                         {
-                            for(int h = hstart; h < hend; ++h)
+                            for(int w = wstart; w < wend; ++w)
                             {
-                                for(int w = wstart; w < wend; ++w)
+                                size_t bot_index = b * bot_batch_stride +
+                                                   o * bot_channel_stride +
+                                                   d * bot_depth_stride + h * bot_stride + w;
+                                if(pooling_method == MLO_POOLING_OP_MAX)
                                 {
-                                    size_t bot_index = b * bot_batch_stride +
-                                                       o * bot_channel_stride +
-                                                       d * bot_depth_stride + h * bot_stride + w;
-                                    if(pooling_method == MLO_POOLING_OP_MAX)
-                                    {
-                                        if(static_cast<_Tcheck>(bot_ptr[bot_index]) > res)
-                                        {
-                                            res       = static_cast<_Tcheck>(bot_ptr[bot_index]);
-                                            res_index = bot_index;
-                                            res_index_gpu =
-                                                index_position == 1
-                                                    ? (d * bot_height * bot_width + h * bot_width +
-                                                       w)
-                                                    : ((d - k * pool_stride_d + pad_d) *
-                                                       filter_size_w * filter_size_h) +
-                                                          ((h - j * pool_stride_h + pad_h) *
-                                                           filter_size_w) +
-                                                          (w - i * pool_stride_w + pad_w);
-                                            found = true;
-                                        }
-                                    }
-                                    else if(pooling_method == MLO_POOLING_OP_AVE ||
-                                            pooling_method == MLO_POOLING_OP_AVE_INCLUSIVE)
-                                    {
-
-                                        res += static_cast<_Tcheck>(bot_ptr[bot_index]);
-                                    }
-                                    else
+                                    if(static_cast<_Tcheck>(bot_ptr[bot_index]) > res)
                                     {
-                                        std::cout << "ERROR: unknown operator : layer: pooling."
-                                                  << std::endl;
-                                        match = false;
-                                        continue;
+                                        res       = static_cast<_Tcheck>(bot_ptr[bot_index]);
+                                        res_index = bot_index;
+                                        res_index_gpu =
+                                            index_position == 1
+                                                ? (d * bot_height * bot_width + h * bot_width +
+                                                   w)
+                                                : ((d - k * pool_stride_d + pad_d) *
+                                                   filter_size_w * filter_size_h) +
+                                                      ((h - j * pool_stride_h + pad_h) *
+                                                       filter_size_w) +
+                                                      (w - i * pool_stride_w + pad_w);
+                                        found = true;
                                     }
                                 }
-                            }
-                        }
-                        // special index value is used to mark top points which has no associated
-                        // bottom
-                        // points
-                        if(!found)
-                        {
-                            res_index     = std::numeric_limits<size_t>::max();
-                            res_index_gpu = std::numeric_limits<uint8_t>::max();
-                        }
+                                else if(pooling_method == MLO_POOLING_OP_AVE ||
+                                        pooling_method == MLO_POOLING_OP_AVE_INCLUSIVE)
+                                {
 
-                        size_t top_index = b * top_batch_stride + o * top_channel_stride +
-                                           k * top_depth_stride + j * top_stride + i;
-                        if(pooling_method == MLO_POOLING_OP_MAX)
-                        {
-                            // the case with the odd input, the even kernel size and 2*pad == kernel
-                            // size
-                            mask_ptr[top_index] = res_index;
-                            if(do_backward)
-                            {
-                                size_t mg = mask_gpu[top_index];
-                                if(mg != res_index_gpu)
+                                    res += static_cast<_Tcheck>(bot_ptr[bot_index]);
+                                }
+                                else
                                 {
-                                    std::cout << "Mask mismatch, gpu " << mg << " cpu "
-                                              << res_index_gpu << "(" << res_index << ")"
+                                    std::cout << "ERROR: unknown operator : layer: pooling."
                                               << std::endl;
                                     match = false;
+                                    continue;
                                 }
                             }
                         }
-                        if(pooling_method == MLO_POOLING_OP_AVE ||
-                           pooling_method == MLO_POOLING_OP_AVE_INCLUSIVE)
+                    }
+                    // special index value is used to mark top points which has no associated
+                    // bottom
+                    // points
+                    if(!found)
+                    {
+                        res_index     = std::numeric_limits<size_t>::max();
+                        res_index_gpu = std::numeric_limits<uint8_t>::max();
+                    }
+
+                    size_t top_index = b * top_batch_stride + o * top_channel_stride +
+                                       k * top_depth_stride + j * top_stride + i;
+                    if(pooling_method == MLO_POOLING_OP_MAX)
+                    {
+                        // the case with the odd input, the even kernel size and 2*pad == kernel
+                        // size
+                        mask_ptr[top_index] = res_index;
+                        if(do_backward)
                         {
-                            res /= pool_size;
+                            size_t mg = mask_gpu[top_index];
+                            if(mg != res_index_gpu)
+                            {
+                                std::cout << "Mask mismatch, gpu " << mg << " cpu "
+                                          << res_index_gpu << "(" << res_index << ")"
+                                          << std::endl;
+                                match = false;
+                            }
                         }
-                        _Tcheck c_val = res;
+                    }
+                    if(pooling_method == MLO_POOLING_OP_AVE ||
+                       pooling_method == MLO_POOLING_OP_AVE_INCLUSIVE)
+                    {
+                        res /= pool_size;
+                    }
+                    _Tcheck c_val = res;
 
-                        _Tgpu gg_val = (top_ptr[top_index]);
+                    _Tgpu gg_val = (top_ptr[top_index]);
 
-                        gg_val = (_Tgpu(gg_val) == _Tgpu(-G_MAX_VAL)) ? _Tgpu(0) : _Tgpu(gg_val);
+                    gg_val = (_Tgpu(gg_val) == _Tgpu(-G_MAX_VAL)) ? _Tgpu(0) : _Tgpu(gg_val);
 
-                        c_val = (c_val == -MAX_VAL) ? 0 : c_val;
+                    c_val = (c_val == -MAX_VAL) ? 0 : c_val;
 
-                        _Tcheck g_val(gg_val);
+                    _Tcheck g_val(gg_val);
 
-                        double err = std::abs(c_val - g_val);
+                    double err = std::abs(c_val - g_val);
 
-                        if(err > allowedEps || std::isnan(c_val) || std::isnan(g_val) ||
-                           !std::isfinite(c_val) || !std::isfinite(g_val))
-                        {
-                            std::cout << "Difference " << err << " too large at " << b << ", " << o
-                                      << ", " << j << ", " << i << " c_v = " << c_val
-                                      << " vs g_val = " << g_val << std::endl;
-                            match = false;
-                        }
+                    if(err > allowedEps || std::isnan(c_val) || std::isnan(g_val) ||
+                       !std::isfinite(c_val) || !std::isfinite(g_val))
+                    {
+                        std::cout << "Difference " << err << " too large at " << b << ", " << o
+                                  << ", " << j << ", " << i << " c_v = " << c_val
+                                  << " vs g_val = " << g_val << std::endl;
+                        match = false;
                     }
                 }
             }
         }
-    }
+    });
 
     return (match);
 }
@@ -305,110 +311,110 @@ int mloPoolingBackwardRunHost(
 
     int ret = 0;
 
-    for(int b = 0; b < n_batchs; b++)
-    {
-        for(int o = 0; o < n_outputs; o++)
-        {
-            int bot_df_v_off = b * bot_df_v_batch_stride + o * bot_df_v_channel_stride;
-            int top_df_off   = b * top_df_batch_stride + o * top_df_channel_stride;
+    // The mask of a top plane only points into the bottom plane of the same (batch, channel).
+    miopen::par_for(n_batchs * n_outputs, 1, [&](int bo) {
+        int b = bo / n_outputs;
+        int o = bo % n_outputs;
 
-            if(pooling_method == MLO_POOLING_OP_MAX)
+        int bot_df_v_off = b * bot_df_v_batch_stride + o * bot_df_v_channel_stride;
+        int top_df_off   = b * top_df_batch_stride + o * top_df_channel_stride;
+
+        if(pooling_method == MLO_POOLING_OP_MAX)
+        {
+            for(int k = 0; k < top_depth; k++)
             {
-                for(int k = 0; k < top_depth; k++)
+                for(int j = 0; j < top_height; j++)
                 {
-                    for(int j = 0; j < top_height; j++)
+                    for(int i = 0; i < top_width; i++)
                     {
-                        for(int i = 0; i < top_width; i++)
-                        {
-                            size_t top_idx =
-                                top_df_off + k * top_df_depth_stride + j * top_df_stride + i;
-                            size_t bot_idx = mask_ptr[top_idx];
-                            // skip top points that don't have associated bottom points
-                            if(bot_idx == std::numeric_limits<size_t>::max())
-                                continue;
-                            bot_df_v_ptr[bot_idx] += static_cast<_Tcheck>(top_df_ptr[top_idx]);
-                        }
+                        size_t top_idx =
+                            top_df_off + k * top_df_depth_stride + j * top_df_stride + i;
+                        size_t bot_idx = mask_ptr[top_idx];
+                        // skip top points that don't have associated bottom points
+                        if(bot_idx == std::numeric_limits<size_t>::max())
+                            continue;
+                        bot_df_v_ptr[bot_idx] += static_cast<_Tcheck>(top_df_ptr[top_idx]);
                     }
                 }
             }
-            else if(pooling_method == MLO_POOLING_OP_AVE ||
-                    pooling_method == MLO_POOLING_OP_AVE_INCLUSIVE)
-            {
+        }
+        else if(pooling_method == MLO_POOLING_OP_AVE ||
+                pooling_method == MLO_POOLING_OP_AVE_INCLUSIVE)
+        {
 
-                for(int k = 0; k < bot_depth; k++)
+            for(int k = 0; k < bot_depth; k++)
+            {
+                for(int j = 0; j < bot_height; j++)
                 {
-                    for(int j = 0; j < bot_height; j++)
+                    for(int i = 0; i < bot_width; i++)
                     {
-                        for(int i = 0; i < bot_width; i++)
+                        // c-emulator
+                        bot_df_v_ptr[bot_df_v_off + k * bot_df_v_depth_stride +
+                                     j * bot_df_v_stride + i] = static_cast<_Tcheck>(0);
+                        int d                                 = k + pad_d;
+                        int h                                 = j + pad_h;
+                        int w                                 = i + pad_w;
+                        int pdstart =
+                            (d < filter_size_d) ? 0 : (d - filter_size_d) / pool_stride_d + 1;
+                        int pdend = std::min(d / pool_stride_d + 1, top_depth);
+                        int phstart =
+                            (h < filter_size_h) ? 0 : (h - filter_size_h) / pool_stride_h + 1;
+                        int phend = std::min(h / pool_stride_h + 1, top_height);
+                        int pwstart =
+                            (w < filter_size_w) ? 0 : (w - filter_size_w) / pool_stride_w + 1;
+                        int pwend        = std::min(w / pool_stride_w + 1, top_width);
+                        _Tcheck gradient = static_cast<_Tcheck>(0);
+                        for(int pd = pdstart; pd < pdend; ++pd)
                         {
-                            // c-emulator
-                            bot_df_v_ptr[bot_df_v_off + k * bot_df_v_depth_stride +
-                                         j * bot_df_v_stride + i] = static_cast<_Tcheck>(0);
-                            int d                                 = k + pad_d;
-                            int h                                 = j + pad_h;
-                            int w                                 = i + pad_w;
-                            int pdstart =
-                                (d < filter_size_d) ? 0 : (d - filter_size_d) / pool_stride_d + 1;
-                            int pdend = std::min(d / pool_stride_d + 1, top_depth);
-                            int phstart =
-                                (h < filter_size_h) ? 0 : (h - filter_size_h) / pool_stride_h + 1;
-                            int phend = std::min(h / pool_stride_h + 1, top_height);
-                            int pwstart =
-                                (w < filter_size_w) ? 0 : (w - filter_size_w) / pool_stride_w + 1;
-                            int pwend        = std::min(w / pool_stride_w + 1, top_width);
-                            _Tcheck gradient = static_cast<_Tcheck>(0);
-                            for(int pd = pdstart; pd < pdend; ++pd)
+                            for(int ph = phstart; ph < phend; ++ph)
                             {
-                                for(int ph = phstart; ph < phend; ++ph)
+                                for(int pw = pwstart; pw < pwend; ++pw)
                                 {
-                                    for(int pw = pwstart; pw < pwend; ++pw)
-                                    {
-                                        // figure out the pooling size
-                                        int dstart = pd * pool_stride_d - pad_d;
-                                        int hstart = ph * pool_stride_h - pad_h;
-                                        int wstart = pw * pool_stride_w - pad_w;
-                                        int dend   = std::min(dstart + filter_size_d, bot_depth);
-                                        int hend   = std::min(hstart + filter_size_h, bot_height);
-                                        int wend   = std::min(wstart + filter_size_w, bot_width);
-                                        dstart     = std::max(dstart, 0);
-                                        hstart     = std::max(hstart, 0);
-                                        wstart     = std::max(wstart, 0);
-
-                                        int pool_size;
-                                        if(pooling_method == MLO_POOLING_OP_AVE)
-                                            pool_size = ((dend - dstart) * (hend - hstart) *
-                                                             (wend - wstart) ==
-                                                         0)
-                                                            ? 1
-                                                            : (dend - dstart) * (hend - hstart) *
-                                                                  (wend - wstart);
-                                        else
-                                            pool_size =
-                                                (filter_size_w * filter_size_h * filter_size_d == 0)
-                                                    ? 1
-                                                    : filter_size_w * filter_size_h * filter_size_d;
-                                        gradient +=
-                                            static_cast<_Tcheck>(
-                                                top_df_ptr[top_df_off + pd * top_df_depth_stride +
-                                                           ph * top_df_stride + pw]) /
-                                            static_cast<_Tcheck>(pool_size);
-                                    }
+                                    // figure out the pooling size
+                                    int dstart = pd * pool_stride_d - pad_d;
+                                    int hstart = ph * pool_stride_h - pad_h;
+                                    int wstart = pw * pool_stride_w - pad_w;
+                                    int dend   = std::min(dstart + filter_size_d, bot_depth);
+                                    int hend   = std::min(hstart + filter_size_h, bot_height);
+                                    int wend   = std::min(wstart + filter_size_w, bot_width);
+                                    dstart     = std::max(dstart, 0);
+                                    hstart     = std::max(hstart, 0);
+                                    wstart     = std::max(wstart, 0);
+
+                                    int pool_size;
+                                    if(pooling_method == MLO_POOLING_OP_AVE)
+                                        pool_size = ((dend - dstart) * (hend - hstart) *
+                                                         (wend - wstart) ==
+                                                     0)
+                                                        ? 1
+                                                        : (dend - dstart) * (hend - hstart) *
+                                                              (wend - wstart);
+                                    else
+                                        pool_size =
+                                            (filter_size_w * filter_size_h * filter_size_d == 0)
+                                                ? 1
+                                                : filter_size_w * filter_size_h * filter_size_d;
+                                    gradient +=
+                                        static_cast<_Tcheck>(
+                                            top_df_ptr[top_df_off + pd * top_df_depth_stride +
+                                                       ph * top_df_stride + pw]) /
+                                        static_cast<_Tcheck>(pool_size);
                                 }
                             }
-                            bot_df_v_ptr[bot_df_v_off + k * bot_df_v_depth_stride +
-                                         j * bot_df_v_stride + i] = gradient;
                         }
+                        bot_df_v_ptr[bot_df_v_off + k * bot_df_v_depth_stride +
+                                     j * bot_df_v_stride + i] = gradient;
                     }
                 }
             }
-            else
-            {
-                std::cout << "ERROR: unknown operator : layer: pooling back-propagation."
-                          << std::endl;
-                continue;
-            }
         }
-    }
+        else
+        {
+            std::cout << "ERROR: unknown operator : layer: pooling back-propagation."
+                      << std::endl;
+            return;
+        }
+    });
     return (ret);
 }
 
@@ -28,12 +28,14 @@
 
 #include "InputFlags.hpp"
 #include "driver.hpp"
+#include "metrics.hpp"
 #include "mloPoolingHost.hpp"
 #include "tensor_driver.hpp"
 #include "timer.hpp"
 #include <algorithm>
 #include <cstdlib>
 #include <float.h>
+#include <functional>
 #include <memory>
 #include <miopen/miopen.h>
 #include <miopen/tensor.hpp>
@@ -79,6 +81,23 @@ class PoolDriver_impl : public Driver
 
     int VerifyBackward();
     int VerifyForward();
+
+    /// One compare or add per window element of each output, plus reading the input and
+    /// writing the output once.
+    void PrintPoolMetrics(const std::string& name, float time)
+    {
+        const auto& lens    = miopen::deref(poolDesc).GetLengths();
+        const double window = std::accumulate(lens.begin(), lens.end(), 1.0, std::multiplies<>());
+        const double in_sz  = GetTensorSize(inputTensor);
+        const double out_sz = GetTensorSize(outputTensor);
+        PrintMetrics(GetHandle(),
+                     data_type,
+                     name,
+                     out_sz * window,
+                     (in_sz + out_sz) * miopen::GetTypeSize(data_type),
+                     time);
+    }
+
     ~PoolDriver_impl()
     {
 
@@ -424,6 +443,7 @@ int PoolDriver_impl<Tgpu, Tref, Index>::RunForwardGPU()
                    t.gettime_ms() / inflags.GetValueInt("iter"));
 
         printf("GPU Kernel Time Forward Pooling Elapsed: %f ms\n", time);
+        PrintPoolMetrics("fwd-pool", time);
     }
 
     out_dev->FromGPU(GetStream(), out.data());
@@ -486,6 +506,7 @@ int PoolDriver_impl<Tgpu, Tref, Index>::RunBackwardGPU()
             printf("Wall-clock Time Backward Pooling Elapsed: %f ms\n",
                    t.gettime_ms() / inflags.GetValueInt("iter"));
         printf("GPU Kernel Time Backward Pooling Elapsed: %f ms\n", time);
+        PrintPoolMetrics("bwd-pool", time);
     }
 
     din_dev->FromGPU(GetStream(), din.data());
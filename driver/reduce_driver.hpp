@@ -29,6 +29,7 @@
 #include "../test/verify.hpp"
 #include "InputFlags.hpp"
 #include "driver.hpp"
+#include "metrics.hpp"
 #include "tensor_driver.hpp"
 #include "timer.hpp"
 #include <algorithm>
@@ -416,9 +417,19 @@ int ReduceDriver<Tgpu, Tref>::RunForwardGPU()
 
         STOP_TIME
         if(WALL_CLOCK)
-            printf("Wall-clock Time Forward LRN Elapsed: %f ms\n",
+            printf("Wall-clock Time Forward Reduce Elapsed: %f ms\n",
                    t.gettime_ms() / inflags.GetValueInt("iter"));
-        printf("GPU Kernel Time Forward LRN Elapsed: %f ms\n", time);
+        printf("GPU Kernel Time Forward Reduce Elapsed: %f ms\n", time);
+
+        // one operation per input element; reads the input, writes the output
+        const double in_sz  = GetTensorSize(inputTensor);
+        const double out_sz = GetTensorSize(outputTensor);
+        PrintMetrics(GetHandle(),
+                     data_type,
+                     "fwd-reduce",
+                     in_sz,
+                     (in_sz + out_sz) * miopen::GetTypeSize(data_type),
+                     time);
     }
 
     return miopenStatusSuccess;
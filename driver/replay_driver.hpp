@@ -0,0 +1,119 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_REPLAY_DRIVER_HPP
+#define GUARD_MIOPEN_REPLAY_DRIVER_HPP
+
+#include "tune_driver.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/// Replay of an API call stream recorded with MIOPEN_RECORD_FILE: runs every recorded call in
+/// order, with its own descriptors, solution and (if recorded) input data, and reports the time
+/// of each call and the total.
+inline std::vector<std::vector<std::string>> ReadReplayCalls(const std::string& filename)
+{
+    std::ifstream file(filename);
+    if(!file)
+    {
+        std::cerr << "Unable to open the call record: " << filename << std::endl;
+        return {};
+    }
+
+    std::vector<std::vector<std::string>> calls;
+    std::string line;
+    while(std::getline(file, line))
+    {
+        auto call = SplitDriverCommand(line);
+        if(!call.empty())
+            calls.push_back(std::move(call));
+    }
+    return calls;
+}
+
+/// MIOpenDriver replay <record_file> [--iter N]
+/// run_driver executes a single driver command line and returns its status.
+inline int RunReplay(int argc, char* argv[], const std::function<int(int, char**)>& run_driver)
+{
+    if(argc < 3)
+    {
+        printf("Usage: ./driver replay *record_file* [--iter N]\n");
+        exit(0);
+    }
+
+    std::string iter = "1";
+    for(int i = 3; i + 1 < argc; i += 2)
+    {
+        if(std::string(argv[i]) == "--iter")
+            iter = argv[i + 1];
+    }
+
+    const auto calls = ReadReplayCalls(argv[2]);
+    std::cout << "Replaying " << calls.size() << " calls" << std::endl;
+
+    int failed     = 0;
+    double total   = 0;
+    std::size_t id = 0;
+    for(const auto& call : calls)
+    {
+        // The run-control flags are appended, as the last value of a flag is the one used.
+        std::vector<std::string> args = {"MIOpenDriver"};
+        args.insert(args.end(), call.begin(), call.end());
+        args.insert(args.end(), {"-V", "0", "-t", "1", "-i", iter});
+
+        std::cout << "Call " << ++id << "/" << calls.size() << ":";
+        for(const auto& arg : call)
+            std::cout << " " << arg;
+        std::cout << std::endl;
+
+        std::vector<char*> c_args;
+        for(auto& arg : args)
+            c_args.push_back(&arg[0]);
+
+        const auto start = std::chrono::steady_clock::now();
+        if(run_driver(static_cast<int>(c_args.size()), c_args.data()) != 0)
+            ++failed;
+        const auto time = std::chrono::duration<double, std::milli>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+        total += time;
+        std::cout << "Call " << id << " wall time: " << std::fixed << std::setprecision(3) << time
+                  << " ms" << std::endl;
+    }
+
+    std::cout << "Replayed " << calls.size() - failed << " of " << calls.size()
+              << " calls, total wall time: " << std::fixed << std::setprecision(3) << total
+              << " ms" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
+
+#endif // GUARD_MIOPEN_REPLAY_DRIVER_HPP
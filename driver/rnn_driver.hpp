@@ -31,6 +31,7 @@
 #include "lstm_verify_gemm.hpp"
 #include "gru_verify_gemm.hpp"
 #include "driver.hpp"
+#include "metrics.hpp"
 #include "tensor_driver.hpp"
 #include "timer.hpp"
 #include "util_driver.hpp"
@@ -89,6 +90,30 @@ class RNNDriver : public Driver
     int RunBackwardWeightsCPU();
     int VerifyBackward();
     int VerifyForward();
+
+    /// GEMM FLOPs of one pass: for every token, each layer and direction multiplies its
+    /// input and hidden state by the gates * hid_h rows of the weights.
+    void PrintRNNMetrics(const std::string& name, float time)
+    {
+        const int hid_h        = inflags.GetValueInt("hid_h");
+        const int in_h         = inflags.GetValueInt("in_h");
+        const int layers       = inflags.GetValueInt("num_layer");
+        const int dirs         = inflags.GetValueInt("bidirection") == 1 ? 2 : 1;
+        const bool skip        = inflags.GetValueInt("inputmode") == 1;
+        const std::string mode = inflags.GetValueStr("mode");
+        const int gates        = mode == "lstm" ? 4 : (mode == "gru" ? 3 : 1);
+        const double tokens    = static_cast<double>(in_dev->GetSize()) / sizeof(Tgpu) / in_h;
+
+        double per_token = 0.0;
+        for(int l = 0; l < layers; ++l)
+        {
+            const int layer_in = l == 0 ? (skip ? 0 : in_h) : hid_h * dirs;
+            per_token += 2.0 * dirs * gates * hid_h * (layer_in + hid_h);
+        }
+        const double bytes = in_dev->GetSize() + out_dev->GetSize() + wei_dev->GetSize();
+        PrintMetrics(GetHandle(), data_type, name, tokens * per_token, bytes, time);
+    }
+
     ~RNNDriver()
     {
         miopenDestroyTensorDescriptor(outputTensor);
@@ -873,6 +898,7 @@ int RNNDriver<Tgpu, Tref>::RunForwardGPU()
         int n_iter = inflags.GetValueInt("iter") > 1 ? inflags.GetValueInt("iter") - 1
                                                      : inflags.GetValueInt("iter");
         printf("GPU Kernel Time Forward RNN Elapsed: %f ms\n", kl_time_forward / n_iter);
+        PrintRNNMetrics("fwd-rnn", kl_time_forward / n_iter);
     }
 
     if(WALL_CLOCK)
@@ -1099,6 +1125,7 @@ int RNNDriver<Tgpu, Tref>::RunBackwardGPU()
                                                          : inflags.GetValueInt("iter");
             printf("GPU Kernel Time Backward Data RNN Elapsed: %f ms\n",
                    kl_time_backward_data / n_iter);
+            PrintRNNMetrics("bwdd-rnn", kl_time_backward_data / n_iter);
         }
 
         if(WALL_CLOCK)
@@ -1156,6 +1183,7 @@ int RNNDriver<Tgpu, Tref>::RunBackwardGPU()
                                                          : inflags.GetValueInt("iter");
             printf("GPU Kernel Time Backward Weights RNN Elapsed: %f ms\n",
                    kl_time_backward_weight / n_iter);
+            PrintRNNMetrics("bwdw-rnn", kl_time_backward_weight / n_iter);
         }
 
         if(WALL_CLOCK)
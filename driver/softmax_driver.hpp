@@ -28,6 +28,7 @@
 
 #include "InputFlags.hpp"
 #include "driver.hpp"
+#include "metrics.hpp"
 #include "mloSoftmaxHost.hpp"
 #include "tensor_driver.hpp"
 #include "timer.hpp"
@@ -273,6 +274,14 @@ int SoftmaxDriver<Tgpu, Tref>::RunForwardGPU()
         float kernel_average_time =
             iter > 1 ? (kernel_total_time - kernel_first_time) / (iter - 1) : kernel_first_time;
         printf("GPU Kernel Time Forward Softmax Elapsed: %f ms\n", kernel_average_time);
+        // max, subtract, exp, sum and scale per element; reads x, writes y
+        const double sz = GetTensorSize(inputTensor);
+        PrintMetrics(GetHandle(),
+                     data_type,
+                     "fwd-softmax",
+                     5.0 * sz,
+                     2.0 * sz * miopen::GetTypeSize(data_type),
+                     kernel_average_time);
     }
 
     out_dev->FromGPU(GetStream(), out.data());
@@ -326,6 +335,14 @@ int SoftmaxDriver<Tgpu, Tref>::RunBackwardGPU()
         float kernel_average_time =
             iter > 1 ? (kernel_total_time - kernel_first_time) / (iter - 1) : kernel_first_time;
         printf("GPU Kernel Time Backward Softmax Elapsed: %f ms\n", kernel_average_time);
+        // dot(y, dy), subtract and scale per element; reads y and dy, writes dx
+        const double sz = GetTensorSize(outputTensor);
+        PrintMetrics(GetHandle(),
+                     data_type,
+                     "bwd-softmax",
+                     4.0 * sz,
+                     3.0 * sz * miopen::GetTypeSize(data_type),
+                     kernel_average_time);
     }
 
     din_dev->FromGPU(GetStream(), din.data());
@@ -0,0 +1,318 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_SWEEP_DRIVER_HPP
+#define GUARD_MIOPEN_SWEEP_DRIVER_HPP
+
+#include "throughput_driver.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/// Parameter sweep: runs one driver over every combination of a set of flag values, in this
+/// process and with one handle shared by all the runs, so the kernels built and the dbs loaded
+/// for one shape are reused by the next ones, and prints a table of the results.
+struct SweepParam
+{
+    std::string flag;                // As given on the driver command line, e.g. "-n".
+    std::vector<std::string> values; // In the order they are swept.
+};
+
+/// One row of the results table.
+struct SweepResult
+{
+    std::vector<std::string> values; // Of the swept flags, in the order of the table columns.
+    int status      = 0;
+    bool setup_ok   = false;
+    double setup_ms = 0.0;
+    double run_ms   = 0.0;
+};
+
+inline std::vector<std::string> SplitSweepList(const std::string& list, char separator)
+{
+    std::vector<std::string> items;
+    std::istringstream ss(list);
+    std::string item;
+    while(std::getline(ss, item, separator))
+    {
+        item.erase(0, item.find_first_not_of(" \t\r"));
+        item.erase(item.find_last_not_of(" \t\r") + 1);
+        items.push_back(item);
+    }
+    return items;
+}
+
+/// "n" and "-n" become "-n", "batchsize" and "--batchsize" become "--batchsize".
+inline std::string GetSweepFlag(std::string name)
+{
+    name.erase(0, name.find_first_not_of('-'));
+    return (name.size() == 1 ? "-" : "--") + name;
+}
+
+/// A comma separated list of values, each one either a value or an inclusive range of integers
+/// "first:last" or "first:last:step", e.g. "1,2,4" or "16:64:16".
+inline std::vector<std::string> ParseSweepValues(const std::string& spec)
+{
+    std::vector<std::string> values;
+    for(const auto& item : SplitSweepList(spec, ','))
+    {
+        const auto bounds = SplitSweepList(item, ':');
+        if(bounds.size() < 2 || bounds.size() > 3)
+        {
+            values.push_back(item);
+            continue;
+        }
+        const int first = std::atoi(bounds[0].c_str());
+        const int last  = std::atoi(bounds[1].c_str());
+        const int step  = bounds.size() == 3 ? std::atoi(bounds[2].c_str()) : 1;
+        if(step <= 0)
+        {
+            std::cerr << "Invalid step of the sweep range: " << item << std::endl;
+            continue;
+        }
+        for(int v = first; v <= last; v += step)
+            values.push_back(std::to_string(v));
+    }
+    return values;
+}
+
+/// The first line names the flags, every other line holds the values of one run. Empty lines and
+/// lines starting with '#' are skipped.
+inline bool ReadSweepCsv(const std::string& filename,
+                         std::vector<std::string>& flags,
+                         std::vector<std::vector<std::string>>& rows)
+{
+    std::ifstream file(filename);
+    if(!file)
+    {
+        std::cerr << "Unable to open the sweep file: " << filename << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while(std::getline(file, line))
+    {
+        if(line.find_first_not_of(" \t\r") == std::string::npos || line[0] == '#')
+            continue;
+        auto items = SplitSweepList(line, ',');
+        if(flags.empty())
+        {
+            for(const auto& name : items)
+                flags.push_back(GetSweepFlag(name));
+            continue;
+        }
+        if(items.size() != flags.size())
+        {
+            std::cerr << "Skipping the sweep line with " << items.size() << " values instead of "
+                      << flags.size() << ": " << line << std::endl;
+            continue;
+        }
+        rows.push_back(std::move(items));
+    }
+    return !flags.empty();
+}
+
+inline void PrintSweepTable(std::ostream& os,
+                            const std::vector<std::string>& flags,
+                            const std::vector<SweepResult>& results,
+                            bool csv)
+{
+    std::vector<std::string> header = flags;
+    header.insert(header.end(), {"status", "setup_ms", "run_ms"});
+
+    std::vector<std::vector<std::string>> table;
+    for(const auto& result : results)
+    {
+        std::ostringstream setup_ms, run_ms;
+        setup_ms << std::fixed << std::setprecision(3) << result.setup_ms;
+        run_ms << std::fixed << std::setprecision(3) << result.run_ms;
+        auto row = result.values;
+        row.push_back(!result.setup_ok ? "setup failed" : result.status == 0 ? "ok" : "failed");
+        row.push_back(setup_ms.str());
+        row.push_back(result.setup_ok ? run_ms.str() : "n/a");
+        table.push_back(std::move(row));
+    }
+
+    std::vector<std::size_t> widths(header.size(), 0);
+    for(std::size_t i = 0; i < header.size(); ++i)
+    {
+        widths[i] = header[i].size();
+        for(const auto& row : table)
+            widths[i] = std::max(widths[i], row[i].size());
+    }
+
+    const auto print_row = [&](const std::vector<std::string>& row) {
+        for(std::size_t i = 0; i < row.size(); ++i)
+        {
+            if(csv)
+                os << (i == 0 ? "" : ",") << row[i];
+            else
+                os << (i == 0 ? "" : "  ") << std::setw(widths[i]) << row[i];
+        }
+        os << std::endl;
+    };
+    print_row(header);
+    for(const auto& row : table)
+        print_row(row);
+}
+
+/// MIOpenDriver sweep [--param flag=values]... [--csv file] [--out file] *base_arg* ...
+/// prepare creates and sets up a driver from its command line and returns its pass (empty on
+/// failure); the drivers share the handle of the sweep.
+inline int RunSweep(int argc,
+                    char* argv[],
+                    const std::function<ThroughputPass(int, char**)>& prepare)
+{
+    std::vector<SweepParam> params;
+    std::string csv_file;
+    std::string out_file;
+    int first = 2;
+    for(; first + 1 < argc && std::string(argv[first]).compare(0, 2, "--") == 0; first += 2)
+    {
+        const std::string option = argv[first];
+        const std::string value  = argv[first + 1];
+        if(option == "--param")
+        {
+            const auto eq = value.find('=');
+            if(eq == std::string::npos || eq == 0)
+            {
+                std::cerr << "Invalid sweep parameter, expected flag=values: " << value
+                          << std::endl;
+                return 1;
+            }
+            params.push_back({GetSweepFlag(value.substr(0, eq)),
+                              ParseSweepValues(value.substr(eq + 1))});
+        }
+        else if(option == "--csv")
+            csv_file = value;
+        else if(option == "--out")
+            out_file = value;
+        else
+            break;
+    }
+    if(first >= argc || (params.empty() && csv_file.empty()))
+    {
+        printf("Usage: ./driver sweep [--param flag=values]... [--csv file] [--out file] "
+               "*base_arg* *other_args*\n");
+        exit(0);
+    }
+
+    // The rows of the csv file, each one combined with every combination of the parameters.
+    std::vector<std::string> flags;
+    std::vector<std::vector<std::string>> rows;
+    if(!csv_file.empty() && !ReadSweepCsv(csv_file, flags, rows))
+        return 1;
+    if(csv_file.empty())
+        rows.emplace_back();
+    for(const auto& param : params)
+    {
+        flags.push_back(param.flag);
+        std::vector<std::vector<std::string>> combined;
+        for(const auto& row : rows)
+        {
+            for(const auto& value : param.values)
+            {
+                combined.push_back(row);
+                combined.back().push_back(value);
+            }
+        }
+        rows = std::move(combined);
+    }
+
+    std::cout << "Sweeping " << rows.size() << " configs" << std::endl;
+
+    // Verification is off unless asked for, and the swept flags come last, as the last value of
+    // a flag is the one used.
+    std::vector<std::string> base_args = {"MIOpenDriver", argv[first], "-V", "0"};
+    base_args.insert(base_args.end(), argv + first + 1, argv + argc);
+
+    SharedDriverHandle() = CreateDriverHandle();
+
+    std::vector<SweepResult> results;
+    int failed = 0;
+    for(std::size_t id = 0; id < rows.size(); ++id)
+    {
+        auto args = base_args;
+        for(std::size_t i = 0; i < flags.size(); ++i)
+            args.insert(args.end(), {flags[i], rows[id][i]});
+
+        std::cout << "Config " << (id + 1) << "/" << rows.size() << ":";
+        for(auto arg = args.begin() + 1; arg != args.end(); ++arg)
+            std::cout << " " << *arg;
+        std::cout << std::endl;
+
+        std::vector<char*> c_args;
+        for(auto& arg : args)
+            c_args.push_back(&arg[0]);
+
+        SweepResult result;
+        result.values = rows[id];
+
+        auto start      = std::chrono::steady_clock::now();
+        const auto pass = prepare(static_cast<int>(c_args.size()), c_args.data());
+        auto end        = std::chrono::steady_clock::now();
+        result.setup_ok = static_cast<bool>(pass);
+        result.setup_ms = std::chrono::duration<double, std::milli>(end - start).count();
+        if(result.setup_ok)
+        {
+            start         = std::chrono::steady_clock::now();
+            result.status = pass();
+            end           = std::chrono::steady_clock::now();
+            result.run_ms = std::chrono::duration<double, std::milli>(end - start).count();
+        }
+        if(!result.setup_ok || result.status != 0)
+            ++failed;
+        results.push_back(std::move(result));
+    }
+
+    miopenDestroy(SharedDriverHandle());
+    SharedDriverHandle() = nullptr;
+
+    std::cout << std::endl;
+    PrintSweepTable(std::cout, flags, results, false);
+    if(!out_file.empty())
+    {
+        std::ofstream out(out_file);
+        if(out)
+            PrintSweepTable(out, flags, results, true);
+        else
+            std::cerr << "Unable to write the sweep results: " << out_file << std::endl;
+    }
+
+    std::cout << "Swept " << rows.size() - failed << " of " << rows.size() << " configs"
+              << std::endl;
+    return failed == 0 ? 0 : 1;
+}
+
+#endif // GUARD_MIOPEN_SWEEP_DRIVER_HPP
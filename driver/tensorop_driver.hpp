@@ -28,6 +28,7 @@
 
 #include "InputFlags.hpp"
 #include "driver.hpp"
+#include "metrics.hpp"
 #include "tensor_driver.hpp"
 #include "miopen/miopen.h"
 #include "miopen/tensor.hpp"
@@ -332,6 +333,13 @@ int TensorOpDriver<Tgpu, Tref>::RunForwardGPU()
                dataSz,
                4 * dataSz / min_time / 1e6,
                avgtime / (iters - 1));
+
+        // op tensor scales a, b and c, applies the op and accumulates; set only writes a
+        const bool is_op     = !is_set && !is_scale;
+        const double sz      = GetTensorSize(aTensor);
+        const double flopCnt = is_op ? 5.0 * sz : (is_scale ? sz : 0.0);
+        const double bytes   = (is_op ? 4.0 : (is_scale ? 2.0 : 1.0)) * dataSz;
+        PrintMetrics(GetHandle(), data_type, "tensor-op", flopCnt, bytes, min_time);
     }
     if(!is_set && !is_scale)
         c_dev->FromGPU(GetStream(), c.data());
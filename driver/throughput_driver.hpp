@@ -0,0 +1,197 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_THROUGHPUT_DRIVER_HPP
+#define GUARD_MIOPEN_THROUGHPUT_DRIVER_HPP
+
+#include "tune_driver.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// Throughput mode: the same problem runs concurrently in several workers, each one with its
+/// own handle (hence its own stream), spread across the devices. Every worker times each pass
+/// (the directions given by -F) separately, so contention between the workers shows up in
+/// the aggregate rate and in the tail of the latency distribution.
+struct ThroughputOptions
+{
+    int workers = 1;
+    int gpus    = 1;
+    int iter    = 100;
+    int warmup  = 1;
+};
+
+/// One pass of a prepared driver, returns its status.
+using ThroughputPass = std::function<int()>;
+
+inline double GetLatencyPercentile(const std::vector<double>& sorted, double p)
+{
+    if(sorted.empty())
+        return 0.0;
+    const auto rank = static_cast<std::size_t>(std::ceil(p / 100.0 * sorted.size()));
+    return sorted[std::min(std::max<std::size_t>(rank, 1), sorted.size()) - 1];
+}
+
+inline void PrintLatencies(const std::string& name, std::vector<double> latencies, double wall_ms)
+{
+    std::sort(latencies.begin(), latencies.end());
+    double mean = 0.0;
+    if(!latencies.empty())
+        mean = std::accumulate(latencies.begin(), latencies.end(), 0.0) / latencies.size();
+    std::cout << std::fixed << std::setprecision(3) << name << ": " << latencies.size()
+              << " passes, " << (wall_ms > 0 ? latencies.size() * 1e3 / wall_ms : 0.0)
+              << " passes/s, latency ms mean " << mean << ", p50 "
+              << GetLatencyPercentile(latencies, 50) << ", p95 "
+              << GetLatencyPercentile(latencies, 95) << ", p99 "
+              << GetLatencyPercentile(latencies, 99) << ", max "
+              << (latencies.empty() ? 0.0 : latencies.back()) << std::endl;
+}
+
+/// MIOpenDriver throughput [--workers N] [--gpus N] [--iter N] [--warmup N] *base_arg* ...
+/// prepare creates and sets up a driver from its command line, in the calling thread, and
+/// returns its pass (empty on failure).
+inline int RunThroughput(int argc,
+                         char* argv[],
+                         const std::function<ThroughputPass(int, char**)>& prepare)
+{
+    ThroughputOptions options;
+    int first = 2;
+    for(; first + 1 < argc && std::string(argv[first]).compare(0, 2, "--") == 0; first += 2)
+    {
+        const std::string option = argv[first];
+        const int value          = std::max(std::atoi(argv[first + 1]), 0);
+        if(option == "--workers")
+            options.workers = std::max(value, 1);
+        else if(option == "--gpus")
+            options.gpus = std::max(value, 1);
+        else if(option == "--iter")
+            options.iter = std::max(value, 1);
+        else if(option == "--warmup")
+            options.warmup = value;
+        else
+            break;
+    }
+    if(first >= argc)
+    {
+        printf("Usage: ./driver throughput [--workers N] [--gpus N] [--iter N] [--warmup N] "
+               "*base_arg* *other_args*\n");
+        exit(0);
+    }
+    options.gpus = std::min(options.gpus, GetTuneDeviceCount());
+
+    // The run-control flags are appended, as the last value of a flag is the one used.
+    std::vector<std::string> args = {"MIOpenDriver"};
+    args.insert(args.end(), argv + first, argv + argc);
+    args.insert(args.end(), {"-V", "0", "-t", "0", "-i", "1"});
+
+    std::cout << "Throughput of " << options.workers << " worker(s) on " << options.gpus
+              << " device(s), " << options.iter << " passes each" << std::endl;
+
+    std::vector<std::vector<double>> latencies(options.workers);
+    std::vector<double> wall(options.workers, 0.0);
+    std::atomic<int> ready{0};
+    std::atomic<int> failed{0};
+    std::atomic<bool> go{false};
+
+    const auto worker = [&](int id) {
+#if MIOPEN_BACKEND_HIP
+        hipSetDevice(id % options.gpus);
+#endif
+        auto worker_args = args;
+        std::vector<char*> c_args;
+        for(auto& arg : worker_args)
+            c_args.push_back(&arg[0]);
+        const auto pass = prepare(static_cast<int>(c_args.size()), c_args.data());
+
+        for(int i = 0; pass && i < options.warmup; ++i)
+            pass();
+
+        ++ready;
+        while(!go)
+            std::this_thread::yield();
+        if(!pass)
+        {
+            ++failed;
+            return;
+        }
+
+        latencies[id].reserve(options.iter);
+        const auto start = std::chrono::steady_clock::now();
+        for(int i = 0; i < options.iter; ++i)
+        {
+            const auto pass_start = std::chrono::steady_clock::now();
+            if(pass() != 0)
+                ++failed;
+            latencies[id].push_back(std::chrono::duration<double, std::milli>(
+                                        std::chrono::steady_clock::now() - pass_start)
+                                        .count());
+        }
+        wall[id] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() -
+                                                             start)
+                       .count();
+    };
+
+    std::vector<std::thread> threads;
+    for(int id = 0; id < options.workers; ++id)
+        threads.emplace_back(worker, id);
+    // All the workers are set up and warmed up before any of them is timed.
+    while(ready < options.workers)
+        std::this_thread::yield();
+    const auto start = std::chrono::steady_clock::now();
+    go               = true;
+    for(auto& thread : threads)
+        thread.join();
+    const auto total_ms =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+            .count();
+
+    std::vector<double> all;
+    for(int id = 0; id < options.workers; ++id)
+    {
+        std::string name = "worker " + std::to_string(id);
+#if MIOPEN_BACKEND_HIP
+        name += " (device " + std::to_string(id % options.gpus) + ")";
+#endif
+        PrintLatencies(name, latencies[id], wall[id]);
+        all.insert(all.end(), latencies[id].begin(), latencies[id].end());
+    }
+    PrintLatencies("aggregate", all, total_ms);
+
+    return failed == 0 ? 0 : 1;
+}
+
+#endif // GUARD_MIOPEN_THROUGHPUT_DRIVER_HPP
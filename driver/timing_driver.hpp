@@ -0,0 +1,144 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_TIMING_DRIVER_HPP
+#define GUARD_MIOPEN_TIMING_DRIVER_HPP
+
+#include "throughput_driver.hpp"
+
+#include <miopen/miopen.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/// Cold/warm breakdown: times the first pass of a problem apart from the steady state, and
+/// splits the first pass into the db lookups, the compiles and the module loads, as counted by
+/// miopenGetCacheStatistics.
+struct FirstPassCosts
+{
+    float db_ms          = 0.0f; // find-db and perf-db lookups
+    float compile_ms     = 0.0f; // binary cache misses, i.e. compile and save
+    float load_ms        = 0.0f; // binary cache hits, i.e. load of the code object
+    std::size_t compiles = 0;
+    std::size_t loads    = 0;
+};
+
+inline miopenCacheStatistics_t GetCacheStatistics(miopenCacheType_t cache)
+{
+    miopenCacheStatistics_t stats{};
+    miopenGetCacheStatistics(cache, &stats);
+    return stats;
+}
+
+inline float GetCacheTime(miopenCacheType_t cache)
+{
+    const auto stats = GetCacheStatistics(cache);
+    return stats.hitTimeMs + stats.missTimeMs;
+}
+
+/// The counters are reset before the first pass, so they hold its costs only.
+inline FirstPassCosts GetFirstPassCosts()
+{
+    FirstPassCosts costs;
+    costs.db_ms       = GetCacheTime(miopenCacheFindDb) + GetCacheTime(miopenCachePerfDb);
+    const auto binary = GetCacheStatistics(miopenCacheBinary);
+    costs.compile_ms  = binary.missTimeMs;
+    costs.load_ms     = binary.hitTimeMs;
+    costs.compiles    = binary.misses;
+    costs.loads       = binary.hits;
+    return costs;
+}
+
+/// MIOpenDriver timing [--iter N] *base_arg* ...
+/// prepare creates and sets up a driver from its command line and returns its pass (empty on
+/// failure).
+inline int RunTimingBreakdown(int argc,
+                              char* argv[],
+                              const std::function<ThroughputPass(int, char**)>& prepare)
+{
+    int iter  = 100;
+    int first = 2;
+    for(; first + 1 < argc && std::string(argv[first]) == "--iter"; first += 2)
+        iter = std::max(std::atoi(argv[first + 1]), 1);
+    if(first >= argc)
+    {
+        printf("Usage: ./driver timing [--iter N] *base_arg* *other_args*\n");
+        exit(0);
+    }
+
+    // The run-control flags are appended, as the last value of a flag is the one used.
+    std::vector<std::string> args = {"MIOpenDriver"};
+    args.insert(args.end(), argv + first, argv + argc);
+    args.insert(args.end(), {"-V", "0", "-t", "0", "-i", "1"});
+    std::vector<char*> c_args;
+    for(auto& arg : args)
+        c_args.push_back(&arg[0]);
+
+    using ms = std::chrono::duration<double, std::milli>;
+
+    const auto setup_start = std::chrono::steady_clock::now();
+    const auto pass        = prepare(static_cast<int>(c_args.size()), c_args.data());
+    const auto setup_ms    = ms(std::chrono::steady_clock::now() - setup_start).count();
+    if(!pass)
+        return 1;
+
+    miopenResetCacheStatistics();
+    const auto first_start = std::chrono::steady_clock::now();
+    int failed             = pass() != 0 ? 1 : 0;
+    const auto first_ms    = ms(std::chrono::steady_clock::now() - first_start).count();
+    const auto costs       = GetFirstPassCosts();
+
+    std::vector<double> latencies;
+    latencies.reserve(iter);
+    const auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < iter; ++i)
+    {
+        const auto pass_start = std::chrono::steady_clock::now();
+        if(pass() != 0)
+            ++failed;
+        latencies.push_back(ms(std::chrono::steady_clock::now() - pass_start).count());
+    }
+    const auto steady_ms = ms(std::chrono::steady_clock::now() - start).count();
+
+    const auto other_ms = first_ms - costs.db_ms - costs.compile_ms - costs.load_ms;
+    std::cout << std::fixed << std::setprecision(3) << "setup: " << setup_ms << " ms"
+              << std::endl;
+    std::cout << "first pass: " << first_ms << " ms, db lookup " << costs.db_ms << " ms, compile "
+              << costs.compile_ms << " ms (" << costs.compiles << " programs), module load "
+              << costs.load_ms << " ms (" << costs.loads << " programs), other "
+              << std::max(other_ms, 0.0) << " ms" << std::endl;
+    PrintLatencies("steady state", latencies, steady_ms);
+
+    return failed == 0 ? 0 : 1;
+}
+
+#endif // GUARD_MIOPEN_TIMING_DRIVER_HPP
@@ -0,0 +1,242 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_TUNE_DRIVER_HPP
+#define GUARD_MIOPEN_TUNE_DRIVER_HPP
+
+#include "driver.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// Offline tuning of a model: reads convolution configs, one MIOpenDriver command line
+/// per line (the MIOPEN_ENABLE_LOGGING_CMD output can be used as is), removes duplicates
+/// and runs exhaustive search for every config in this process. Perf-db, find-db and
+/// binary cache are updated as the configs are tuned.
+struct TuneConfig
+{
+    std::string base_arg;
+    std::vector<std::string> args; // Without the direction and the run-control flags.
+    int directions = 0;            // Bitmask of the -F values: 1 fwd, 2 bwd data, 4 wrw.
+};
+
+inline bool IsTuneRunControlFlag(const std::string& flag)
+{
+    // These are set by the tuning mode itself.
+    static const std::vector<std::string> flags = {"-F",
+                                                   "--forw",
+                                                   "-s",
+                                                   "--search",
+                                                   "-V",
+                                                   "--verify",
+                                                   "-i",
+                                                   "--iter",
+                                                   "-t",
+                                                   "--time",
+                                                   "-S",
+                                                   "--solution"};
+    return std::find(flags.begin(), flags.end(), flag) != flags.end();
+}
+
+/// Splits a MIOpenDriver command line into the arguments following the driver name. Any prefix
+/// up to the driver name (e.g. the logging prefix) is skipped. Returns nothing for the comments.
+inline std::vector<std::string> SplitDriverCommand(const std::string& line)
+{
+    std::istringstream ss(line);
+    std::vector<std::string> tokens;
+    std::string token;
+    while(ss >> token)
+        tokens.push_back(token);
+
+    static const std::string driver_name = "MIOpenDriver";
+    auto it                              = tokens.begin();
+    for(auto t = it; t != tokens.end(); ++t)
+    {
+        if(t->size() >= driver_name.size() &&
+           t->compare(t->size() - driver_name.size(), driver_name.size(), driver_name) == 0)
+        {
+            it = t + 1;
+            break;
+        }
+    }
+    if(it == tokens.end() || (*it)[0] == '#')
+        return {};
+    return {it, tokens.end()};
+}
+
+inline std::vector<TuneConfig> ReadTuneConfigs(const std::string& filename)
+{
+    std::ifstream file(filename);
+    if(!file)
+    {
+        std::cerr << "Unable to open tuning configs file: " << filename << std::endl;
+        return {};
+    }
+
+    std::vector<TuneConfig> configs;
+    std::map<std::string, std::size_t> index; // Keyed by the base arg and the layer flags.
+    std::string line;
+    while(std::getline(file, line))
+    {
+        const auto tokens = SplitDriverCommand(line);
+        if(tokens.empty())
+            continue;
+        auto it = tokens.begin();
+
+        TuneConfig config;
+        config.base_arg = *it++;
+        if(config.base_arg.compare(0, 4, "conv") != 0)
+            continue; // Only convolutions are tunable.
+
+        int forw = 0;
+        for(; it != tokens.end(); ++it)
+        {
+            if(IsTuneRunControlFlag(*it) && it + 1 != tokens.end())
+            {
+                if(*it == "-F" || *it == "--forw")
+                    forw = std::atoi((it + 1)->c_str());
+                ++it;
+                continue;
+            }
+            config.args.push_back(*it);
+        }
+        config.directions = forw == 0 ? 7 : forw;
+
+        std::string key = config.base_arg;
+        for(const auto& arg : config.args)
+            key += " " + arg;
+
+        const auto found = index.find(key);
+        if(found == index.end())
+        {
+            index.emplace(key, configs.size());
+            configs.push_back(std::move(config));
+        }
+        else
+        {
+            configs[found->second].directions |= config.directions;
+        }
+    }
+    return configs;
+}
+
+inline int GetTuneDeviceCount()
+{
+#if MIOPEN_BACKEND_HIP
+    int count = 0;
+    if(hipGetDeviceCount(&count) != hipSuccess || count < 1)
+        return 1;
+    return count;
+#else
+    return 1;
+#endif
+}
+
+/// MIOpenDriver tune <configs_file> [--gpus N]
+/// run_driver executes a single driver command line and returns its status.
+inline int RunTuning(int argc, char* argv[], const std::function<int(int, char**)>& run_driver)
+{
+    if(argc < 3)
+    {
+        printf("Usage: ./driver tune *configs_file* [--gpus N]\n");
+        exit(0);
+    }
+
+    int gpus = GetTuneDeviceCount();
+    for(int i = 3; i + 1 < argc; i += 2)
+    {
+        if(std::string(argv[i]) == "--gpus")
+            gpus = std::min(gpus, std::max(1, std::atoi(argv[i + 1])));
+    }
+
+    const auto configs = ReadTuneConfigs(argv[2]);
+    std::cout << "Tuning " << configs.size() << " unique configs on " << gpus << " device(s)"
+              << std::endl;
+
+    std::atomic<std::size_t> next{0};
+    std::atomic<int> failed{0};
+    std::mutex print_mutex;
+
+    const auto worker = [&](int device) {
+#if MIOPEN_BACKEND_HIP
+        hipSetDevice(device);
+#endif
+        for(auto k = next++; k < configs.size(); k = next++)
+        {
+            const auto& config = configs[k];
+            std::vector<std::string> args = {"MIOpenDriver", config.base_arg};
+            args.insert(args.end(), config.args.begin(), config.args.end());
+            args.insert(args.end(),
+                        {"-F",
+                         std::to_string(config.directions == 7 ? 0 : config.directions),
+                         "-s",
+                         "1",
+                         "-V",
+                         "0",
+                         "-i",
+                         "1",
+                         "-t",
+                         "0"});
+
+            {
+                std::lock_guard<std::mutex> lock(print_mutex);
+                std::cout << "[device " << device << "] " << (k + 1) << "/" << configs.size()
+                          << ":";
+                for(const auto& arg : args)
+                    std::cout << " " << arg;
+                std::cout << std::endl;
+            }
+
+            std::vector<char*> c_args;
+            for(auto& arg : args)
+                c_args.push_back(&arg[0]);
+            if(run_driver(static_cast<int>(c_args.size()), c_args.data()) != 0)
+                ++failed;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for(int device = 1; device < gpus; ++device)
+        threads.emplace_back(worker, device);
+    worker(0);
+    for(auto& thread : threads)
+        thread.join();
+
+    std::cout << "Tuned " << configs.size() - failed << " of " << configs.size() << " configs"
+              << std::endl;
+    return failed == 0 ? 0 : 1;
+}
+
+#endif // GUARD_MIOPEN_TUNE_DRIVER_HPP
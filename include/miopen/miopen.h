@@ -60,6 +60,9 @@
  * @defgroup fusion
  * @defgroup LossFunction
  * @defgroup TensorReduce
+ * @defgroup graph
+ * @defgroup layernorm
+ * @defgroup attention
  *
 */
 
@@ -134,6 +137,31 @@ typedef void* (*miopenAllocatorFunction)(void* context, size_t sizeBytes);
 */
 typedef void (*miopenDeallocatorFunction)(void* context, void* memory);
 
+/*! @enum miopenAllocationHint_t
+ * Expected lifetime of an internal buffer, passed to an extended allocator
+*/
+typedef enum {
+    miopenAllocationWorkspace  = 0, /*!< Workspace kept and regrown by the handle */
+    miopenAllocationPersistent = 1, /*!< Buffer living as long as the object which owns it */
+    miopenAllocationScratch    = 2, /*!< Temporary buffer released at the end of the call */
+} miopenAllocationHint_t;
+
+/*! @brief Extended custom allocator function
+ *
+ * This function allow for user-defined custom allocator which is told what a buffer is for.
+ * The requested sizes are rounded up to powers of two.
+ *
+ * @param context     A pointer a context (input)
+ * @param sizeBytes   Number of bytes to allocate (input)
+ * @param hint        Expected lifetime of the buffer (input)
+ * @param stream      The stream the buffer is first used on (input)
+ *
+*/
+typedef void* (*miopenAllocatorFunctionEx)(void* context,
+                                           size_t sizeBytes,
+                                           miopenAllocationHint_t hint,
+                                           miopenAcceleratorQueue_t stream);
+
 /*! @brief Method to return version of MIOpen
  *
  * The output values of this call follow from the versioning
@@ -201,6 +229,43 @@ MIOPEN_EXPORT miopenStatus_t miopenSetStream(miopenHandle_t handle,
 MIOPEN_EXPORT miopenStatus_t miopenGetStream(miopenHandle_t handle,
                                              miopenAcceleratorQueue_t* streamID);
 
+/*! @brief Set the accelerator command queue of the calling thread
+ *
+ * Until miopenResetThreadStream() is called, the work enqueued through the handle by the calling
+ * thread goes to the given queue instead of the one set by miopenSetStream(). This allows several
+ * threads to share a handle, and the kernels and invokers cached in it, each with a queue of its
+ * own. The other threads are not affected. The queue shall belong to the device of the handle.
+ * The threads with a queue of their own do not use the workspace arena of the handle.
+ * @param handle     MIOpen handle (input)
+ * @param streamID   An accelerator queue type (input)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenSetThreadStream(miopenHandle_t handle,
+                                                   miopenAcceleratorQueue_t streamID);
+
+/*! @brief Make the calling thread use the command queue of the handle again
+ *
+ * Undoes miopenSetThreadStream() for the calling thread.
+ * @param handle     MIOpen handle (input)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenResetThreadStream(miopenHandle_t handle);
+
+/*! @brief Set the priority of the internal streams of a handle
+ *
+ * Some operations spread independent parts of their work over internal streams of the handle,
+ * see MIOPEN_CONCURRENT_STREAMS. By default these streams have the priority of the stream the
+ * work is forked from, so that the work of a high priority stream stays high priority. This
+ * sets the priority of the internal streams explicitly, as in hipStreamCreateWithPriority().
+ * The value is clamped to the range supported by the device. Has no effect on OpenCL.
+ *
+ * @param handle     MIOpen handle (input)
+ * @param priority   Stream priority, lower numbers are higher priorities (input)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenSetConcurrentStreamsPriority(miopenHandle_t handle,
+                                                                int priority);
+
 /*! @brief Set allocator for previously created miopenHandle
  *
  * Set a command queue for an accelerator device
@@ -222,6 +287,24 @@ MIOPEN_EXPORT miopenStatus_t miopenSetAllocator(miopenHandle_t handle,
                                                 miopenDeallocatorFunction deallocator,
                                                 void* allocatorContext);
 
+/*! @brief Set an extended allocator for previously created miopenHandle
+ *
+ * Same as miopenSetAllocator(), but the allocator is also given the expected lifetime of the
+ * buffer and the stream it is first used on. The internal buffers are allocated in
+ * power-of-two sizes, so that a caching allocator can serve them from few size classes.
+ * @param handle     MIOpen handle
+ * @param allocator  A callback function MIOpen will use for internal memory allocations.
+ *      Passing 0 will restore the default MIOpen allocator and deallocator.
+ * @param deallocator  A callback function MIOpen will use to for internal memory deallocation.
+ * @param allocatorContext  User-specified pointer which is passed to \p allocator and \p
+ * deallocator
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenSetAllocatorEx(miopenHandle_t handle,
+                                                  miopenAllocatorFunctionEx allocator,
+                                                  miopenDeallocatorFunction deallocator,
+                                                  void* allocatorContext);
+
 /*! @brief Get time for last kernel launched
  *
  * This function is used only when profiling mode has been enabled.
@@ -243,6 +326,179 @@ MIOPEN_EXPORT miopenStatus_t miopenGetKernelTime(miopenHandle_t handle, float* t
  * @return           miopenStatus_t
 */
 MIOPEN_EXPORT miopenStatus_t miopenEnableProfiling(miopenHandle_t handle, bool enable);
+
+/*! @brief Memory held by the kernel and invoker caches of a handle
+ */
+typedef struct
+{
+    size_t programCount;    /*!< Number of cached programs (code objects) */
+    size_t kernelCount;     /*!< Number of cached kernels */
+    size_t codeObjectBytes; /*!< Total size of the cached code objects, in bytes */
+    size_t invokerCount;    /*!< Number of registered invokers */
+    size_t arenaBytes;      /*!< Device memory held by the workspace arena, in bytes */
+} miopenCacheFootprint_t;
+
+/*! @brief Bound the program cache of a handle
+ *
+ * When a limit is exceeded, least recently used programs are evicted together with the kernels
+ * built from them. Evicted programs are rebuilt (or reloaded from the kernel cache on disk) when
+ * needed again. Defaults are taken from MIOPEN_PROGRAM_CACHE_MAX_COUNT and
+ * MIOPEN_PROGRAM_CACHE_MAX_MB.
+ *
+ * @param handle       MIOpen handle (input)
+ * @param maxPrograms  Maximum number of cached programs, 0 means no limit (input)
+ * @param maxBytes     Maximum total size of cached code objects, 0 means no limit (input)
+ * @return             miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenSetProgramCacheLimits(miopenHandle_t handle,
+                                                         size_t maxPrograms,
+                                                         size_t maxBytes);
+
+/*! @brief Report how much the caches of a handle hold
+ *
+ * @param handle     MIOpen handle (input)
+ * @param footprint  Pointer to the structure to fill (output)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenGetCacheFootprint(miopenHandle_t handle,
+                                                     miopenCacheFootprint_t* footprint);
+
+/*! @brief Enable the workspace arena of a handle
+ *
+ * With the arena enabled, immediate mode convolutions called with a null workspace get it from
+ * a device buffer owned by the handle, and internal temporary buffers are served from it as
+ * well. The buffer grows to the largest size requested and is then reused, so no device memory
+ * is allocated after warm-up. Disabling the arena releases its memory. The default is taken
+ * from MIOPEN_WORKSPACE_ARENA.
+ *
+ * @param handle     MIOpen handle (input)
+ * @param enable     Boolean to toggle the arena (input)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenEnableWorkspaceArena(miopenHandle_t handle, bool enable);
+
+/*! @brief Device memory held by a handle, by category
+ *
+ * Only the memory owned by the handle is counted. Buffers passed in by the application, such as
+ * workspaces, reserve spaces or dropout states, are not.
+ */
+typedef struct
+{
+    size_t codeObjectBytes; /*!< Cached code objects */
+    size_t workspaceBytes;  /*!< Convolution workspace served by the arena */
+    size_t scratchBytes;    /*!< Other internal scratch buffers held by the arena */
+    size_t rocblasBytes;    /*!< rocBLAS workspace held by the arena */
+    size_t totalBytes;      /*!< Sum of all the above */
+} miopenDeviceMemoryUsage_t;
+
+/*! @brief Report the device memory held by a handle
+ *
+ * @param handle     MIOpen handle (input)
+ * @param usage      Pointer to the structure to fill (output)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenGetDeviceMemoryUsage(miopenHandle_t handle,
+                                                        miopenDeviceMemoryUsage_t* usage);
+
+/*! @brief Set a soft limit on the device memory held by a handle
+ *
+ * While the limit is set, least recently used code objects are evicted to keep the total
+ * reported by miopenGetDeviceMemoryUsage under it, and miopenConvolution*GetSolution list the
+ * solutions whose workspace fits the remaining memory first. Arena buffers are never shrunk to
+ * meet the limit, so it may still be exceeded; use miopenEnableWorkspaceArena to release them.
+ *
+ * @param handle     MIOpen handle (input)
+ * @param limit      Limit in bytes, 0 means no limit (input)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenSetDeviceMemoryLimit(miopenHandle_t handle, size_t limit);
+
+/*! @brief Make the backward weights convolutions of a handle reproducible
+ *
+ * With the deterministic mode enabled, the backward weights solvers which split the reduction
+ * over the batch and the image between blocks write the partial results to the workspace and
+ * sum them in a fixed order, instead of adding them to the weights gradient with atomics.
+ * Solvers which cannot do so are restricted to the configurations that do not split the
+ * reduction. The mode is part of the find-db key, so the records found in either mode are kept
+ * apart, and it only affects the problems prepared after the call.
+ *
+ * @param handle     MIOpen handle (input)
+ * @param enable     Boolean to toggle the deterministic mode (input)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenEnableDeterministicMode(miopenHandle_t handle, bool enable);
+
+/*! @ingroup handle
+ * @enum miopenCacheType_t
+ * Internal caches counted by miopenGetCacheStatistics
+ */
+typedef enum
+{
+    miopenCacheFindDb       = 0, /*!< Find-db records, user and system */
+    miopenCacheSystemFindDb = 1, /*!< In-memory system find-db */
+    miopenCachePerfDb       = 2, /*!< Perf-db records of the tuned solvers */
+    miopenCachePrograms     = 3, /*!< Programs held by the kernel caches of the handles */
+    miopenCacheInvokers     = 4, /*!< Invokers held by the invoker caches of the handles */
+    miopenCacheBinary       = 5, /*!< On-disk code object cache, its misses are the compiles */
+} miopenCacheType_t;
+
+/*! @brief Lookup counters of an internal cache
+ */
+typedef struct
+{
+    size_t hits;      /*!< Number of lookups served by the cache */
+    size_t misses;    /*!< Number of lookups not served by the cache */
+    float hitTimeMs;  /*!< Cumulative time of the hits, in milliseconds */
+    float missTimeMs; /*!< Cumulative time of the misses, including the fallback, in milliseconds */
+} miopenCacheStatistics_t;
+
+/*! @brief Read the lookup counters of an internal cache
+ *
+ * The counters are process-wide and include all the handles. They are also printed at the
+ * process exit if MIOPEN_DUMP_CACHE_STATS is set.
+ *
+ * @param cache       Cache to report (input)
+ * @param statistics  Pointer to the structure to fill (output)
+ * @return            miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenGetCacheStatistics(miopenCacheType_t cache,
+                                                      miopenCacheStatistics_t* statistics);
+
+/*! @brief Reset the lookup counters of all the internal caches to zero
+ *
+ * @return            miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenResetCacheStatistics(void);
+
+/*! @ingroup handle
+ * @enum miopenKernelCacheEvictPolicy_t
+ * Order in which miopenTrimKernelCache removes the entries of the kernel cache
+ */
+typedef enum
+{
+    miopenKernelCacheEvictLeastRecentlyUsed = 0, /*!< Entries loaded longest ago first */
+    miopenKernelCacheEvictCheapest          = 1, /*!< Lowest compile time per stored byte first */
+} miopenKernelCacheEvictPolicy_t;
+
+/*! @brief Bound the size of the kernel cache on disk
+ *
+ * Removes entries from the user kernel cache of the device of the handle until the stored code
+ * objects take at most maxBytes, then compacts the cache file. The cache records the compile time,
+ * size and last use of each entry, so the policy can keep the kernels that are expensive to
+ * rebuild. Removed kernels are compiled again when needed. The system kernel cache is not
+ * modified. Returns miopenStatusNotImplemented if MIOpen is built without the SQLite kernel
+ * cache.
+ *
+ * @param handle      MIOpen handle (input)
+ * @param maxBytes    Maximum total size of the stored code objects, in bytes (input)
+ * @param policy      Order in which entries are removed (input)
+ * @param freedBytes  Size of the removed code objects, in bytes, may be NULL (output)
+ * @return            miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenTrimKernelCache(miopenHandle_t handle,
+                                                   size_t maxBytes,
+                                                   miopenKernelCacheEvictPolicy_t policy,
+                                                   size_t* freedBytes);
 /** @} */
 // CLOSEOUT HANDLE DOXYGEN GROUP
 
@@ -273,6 +529,22 @@ MIOPEN_DECLARE_OBJECT(miopenTensorDescriptor);
  */
 MIOPEN_DECLARE_OBJECT(miopenConvolutionDescriptor);
 
+/*! @ingroup convolutions
+ * @brief Creates the miopenConvolutionPlan_t type
+ *
+ * Convolution plan is an object binding a convolution problem to one of its solutions, which may
+ * be run repeatedly with only the buffers given, see miopenCreateConvolutionPlan.
+ */
+MIOPEN_DECLARE_OBJECT(miopenConvolutionPlan);
+
+/*! @ingroup convolutions
+ * @brief Creates the miopenConvolutionFindFuture_t type
+ *
+ * Convolution find future is an object tracking a search started in the background, see
+ * miopenFindConvolutionForwardAlgorithmAsync.
+ */
+MIOPEN_DECLARE_OBJECT(miopenConvolutionFindFuture);
+
 /*! @ingroup pooling
  * @brief Creates the miopenPoolingDescriptor_t type
  *
@@ -304,6 +576,16 @@ MIOPEN_DECLARE_OBJECT(miopenActivationDescriptor);
 */
 MIOPEN_DECLARE_OBJECT(miopenRNNDescriptor);
 
+/*! @ingroup RNN
+* @brief Creates the miopenRNNPreparedWeights_t type
+*/
+MIOPEN_DECLARE_OBJECT(miopenRNNPreparedWeights);
+
+/*! @ingroup RNN
+* @brief Creates the miopenRNNStreamingState_t type
+*/
+MIOPEN_DECLARE_OBJECT(miopenRNNStreamingState);
+
 /*! @ingroup LossFunction
 * @brief Creates the miopenCTCLossDescriptor_t type
 */
@@ -392,10 +674,13 @@ typedef enum {
  * Pooling layer workspace index mode. miopenPoolingWorkspaceIndexMask mode records indices
  * indicating the max values' positions in the filter/mask. miopenPoolingWorkspaceIndexImage mode
  * records indices indicating the max values' positions in the image.
+ * miopenPoolingWorkspaceIndexRecompute mode records no indices; the backward pass finds the max
+ * values' positions again from the forward input and output, which it then requires.
 */
 typedef enum {
-    miopenPoolingWorkspaceIndexMask  = 0, /*!< Use mask indices, 2D pooling only */
-    miopenPoolingWorkspaceIndexImage = 1, /*!< Use image indices */
+    miopenPoolingWorkspaceIndexMask      = 0, /*!< Use mask indices, 2D pooling only */
+    miopenPoolingWorkspaceIndexImage     = 1, /*!< Use image indices */
+    miopenPoolingWorkspaceIndexRecompute = 2, /*!< Recompute indices in backward, no workspace */
 } miopenPoolingWorkspaceIndexMode_t;
 
 /*! @ingroup LRN
@@ -525,7 +810,8 @@ MIOPEN_EXPORT miopenStatus_t miopenCreateTensorDescriptor(miopenTensorDescriptor
 
 /*! @brief Set shape of 4D tensor
  *
- * Interface for setting 4-D tensor shape. MIOpen currently only implements NCHW layout.
+ * Interface for setting 4-D tensor shape in NCHW layout. Other layouts (e.g. NHWC) can be set
+ * with miopenSetTensorDescriptor() by passing the respective strides.
  *
  * @param tensorDesc Tensor descriptor type (output)
  * @param dataType   MIOpen datatype (input)
@@ -856,6 +1142,43 @@ miopenSetTransposeConvOutputPadding(miopenConvolutionDescriptor_t convDesc, int
 MIOPEN_EXPORT miopenStatus_t miopenSetTransposeConvNdOutputPadding(
     miopenConvolutionDescriptor_t convDesc, int spatialDim, int* adjA);
 
+/*! @enum miopenConvolutionAttrib_t
+ * Optional attributes of a convolution descriptor, see miopenSetConvolutionAttribute()
+ */
+typedef enum {
+    MIOPEN_CONVOLUTION_ATTRIB_PREFER_LATENCY =
+        0, /*!< Non-zero to select the solutions which finish a single call soonest, for example
+                for batch 1 inference, rather than the ones with the best throughput. Default 0 */
+} miopenConvolutionAttrib_t;
+
+/*! @brief Set an attribute of a convolution descriptor
+ *
+ *   With MIOPEN_CONVOLUTION_ATTRIB_PREFER_LATENCY set, the device idle time between the kernels
+ * of a solution counts against the solution when Find ranks the candidates and when the immediate
+ * mode estimates them, solvers which split the reduction of the GEMM between more workgroups
+ * use such a split by default, and the find-db records of the problem are kept apart from the
+ * ones of the default mode.
+ *
+ * @param convDesc   Convolution layer descriptor (output)
+ * @param attr       Attribute to set (input)
+ * @param value      Value of the attribute (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenSetConvolutionAttribute(miopenConvolutionDescriptor_t convDesc,
+                                                           const miopenConvolutionAttrib_t attr,
+                                                           int value);
+
+/*! @brief Get an attribute of a convolution descriptor
+ *
+ * @param convDesc   Convolution layer descriptor (input)
+ * @param attr       Attribute to get (input)
+ * @param value      Value of the attribute (output)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGetConvolutionAttribute(miopenConvolutionDescriptor_t convDesc,
+                                                           const miopenConvolutionAttrib_t attr,
+                                                           int* value);
+
 /*! @brief Get the shape of a resulting 4-D tensor from a 2-D convolution
  *
  * This function returns the dimensions of the resulting 4D tensor of a 2D
@@ -998,6 +1321,29 @@ typedef struct
 
 } miopenConvSolution_t;
 
+/*! @enum miopenConvDirection_t
+ * Convolution direction of a problem passed to miopenConvolutionPrewarm
+ */
+typedef enum {
+    miopenConvDirectionForward         = 0, /*!< Forward convolution */
+    miopenConvDirectionBackwardData    = 1, /*!< Back propagation on data */
+    miopenConvDirectionBackwardWeights = 2, /*!< Back propagation on weights */
+} miopenConvDirection_t;
+
+/*! @brief Convolution problem description for miopenConvolutionPrewarm
+ *
+ * Tensors are named after the forward convolution regardless of the direction: xDesc is the
+ * input data (x or dx), wDesc the weights (w or dw) and yDesc the output data (y or dy).
+ */
+typedef struct
+{
+    miopenTensorDescriptor_t xDesc;         /*!< Input data tensor descriptor */
+    miopenTensorDescriptor_t wDesc;         /*!< Weight tensor descriptor */
+    miopenTensorDescriptor_t yDesc;         /*!< Output data tensor descriptor */
+    miopenConvolutionDescriptor_t convDesc; /*!< Convolution layer descriptor */
+    miopenConvDirection_t direction;        /*!< Direction the problem is going to be run in */
+} miopenConvProblem_t;
+
 /*! @brief Query the maximum number of solutions applicable for the given input/output and weights
  *  tensor descriptor for Convolution in the Forward direction.
  *
@@ -1054,6 +1400,41 @@ miopenConvolutionForwardGetSolution(miopenHandle_t handle,
                                     size_t* solutionCount,
                                     miopenConvSolution_t* solutions);
 
+/*! @brief Query the solutions trading time for workspace size within a workspace budget
+ *
+ *  Out of the solutions returned by miopenConvolutionForwardGetSolution, keeps those which need
+ * at most workSpaceLimit bytes of workspace and are not both slower and larger than another one.
+ * The returned array is sorted in the order of decreasing performance and increasing memory
+ * efficiency: the first solution is the fastest one which fits into the budget, and each next
+ * one needs less workspace than the one before it. Pass SIZE_MAX as workSpaceLimit to get the
+ * whole time-vs-workspace front. The times are taken from the find-db, which Find fills in for
+ * all the solutions it measured, so no new Find is needed to change the budget.
+ *
+ *  solutionCount is set to zero if no solution fits into the budget.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param wDesc          Tensor descriptor for weight tensor w (input)
+ * @param xDesc          Tensor descriptor for input data tensor x (input)
+ * @param convDesc       Convolution layer descriptor (input)
+ * @param yDesc          Tensor descriptor for output data tensor y (input)
+ * @param workSpaceLimit The largest workspace size in bytes the caller can provide (input)
+ * @param maxSolutionCount The size of the solutions array passed in below (input)
+ * @param solutionCount The size of the solutions array returned (output)
+ * @param solutions      A pointer to an array of type miopenConvSolution_t allocated by the user,
+ *                      filled in by MIOpen with the solutions of the front. (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenConvolutionForwardGetSolutionWithinWorkspace(miopenHandle_t handle,
+                                                   const miopenTensorDescriptor_t wDesc,
+                                                   const miopenTensorDescriptor_t xDesc,
+                                                   const miopenConvolutionDescriptor_t convDesc,
+                                                   const miopenTensorDescriptor_t yDesc,
+                                                   const size_t workSpaceLimit,
+                                                   const size_t maxSolutionCount,
+                                                   size_t* solutionCount,
+                                                   miopenConvSolution_t* solutions);
+
 /*! @brief Returns the workspace size required for a particular solution id.
  *
  * This is an optional call for users who may have serialized the solution id and just need the
@@ -1416,6 +1797,233 @@ miopenConvolutionBackwardWeightsImmediate(miopenHandle_t handle,
                                           size_t workSpaceSize,
                                           const uint64_t solution_id);
 
+/*! @brief Compiles the best known solutions for a set of convolution problems
+ *
+ *   For every problem the fastest applicable solution is taken from the find-db, the same one
+ * that would be reported first by the corresponding miopenConvolution*GetSolution call. Kernels
+ * of all the solutions are compiled in parallel and stored in the handle, so that the first
+ * immediate mode call for each of these problems does not cause a compile.
+ *
+ *   Problems without a find-db record are skipped. This is an optional step meant to be made
+ * once per model, e.g. right after the network is loaded.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param problems       Array of problems to prepare (input)
+ * @param problemCount   Number of entries in the problems array (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenConvolutionPrewarm(miopenHandle_t handle,
+                                                      const miopenConvProblem_t* problems,
+                                                      size_t problemCount);
+
+/*! @brief Writes the tuning results of a set of convolution problems to a file
+ *
+ *   The file gets the find-db and perf-db records of the problems, taken from the user and system
+ * databases, and the code objects of the solutions named in the find-db records, taken from the
+ * binary cache. Code objects missing from the binary cache are compiled first. A process which
+ * loads the file with miopenImportTuningBundle, e.g. in a fresh container, runs these problems in
+ * immediate mode without Find and without compiling kernels.
+ *
+ *   Problems without a find-db record are skipped. The bundle holds code objects for the device
+ * of the handle only.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param problems       Array of problems to export (input)
+ * @param problemCount   Number of entries in the problems array (input)
+ * @param path           Name of the file to write (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenExportTuningBundle(miopenHandle_t handle,
+                                                      const miopenConvProblem_t* problems,
+                                                      size_t problemCount,
+                                                      const char* path);
+
+/*! @brief Loads a file written by miopenExportTuningBundle
+ *
+ *   The records are added to the user find-db and perf-db, and the code objects to the user
+ * binary cache, so that they are also seen by the other processes using the same user db
+ * directory. The records already there for the same problems and solvers are replaced.
+ *
+ * @param handle         MIOpen handle of a device of the same name as the exporting one (input)
+ * @param path           Name of the file to read (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenImportTuningBundle(miopenHandle_t handle, const char* path);
+
+/*! @brief Binds a convolution problem to a solution for repeated immediate mode execution
+ *
+ *   The descriptors are validated, the solution is compiled if needed and the parameters of its
+ * launches are prepared once, so that running the plan with miopenRunConvolutionPlan has close
+ * to no host overhead beyond the kernel launches. This is meant for the problems run many times
+ * with the same descriptors, for example in low batch inference.
+ *
+ *   The descriptors are copied: changing them afterwards does not affect the plan. The plan may
+ * only be run with the handle it was created with.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param problem        Convolution problem, the tensors are named as in miopenConvProblem_t
+ *                       (input)
+ * @param solution_id    ID of the solution, as returned by the miopenConvolution*GetSolution
+ *                       call of the direction (input)
+ * @param plan           Pointer to the created plan (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenCreateConvolutionPlan(miopenHandle_t handle,
+                                                         const miopenConvProblem_t* problem,
+                                                         const uint64_t solution_id,
+                                                         miopenConvolutionPlan_t* plan);
+
+/*! @brief Query the workspace size required to run a convolution plan
+ *
+ * @param plan           Convolution plan (input)
+ * @param workSpaceSize  Size of the workspace in bytes (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenGetConvolutionPlanWorkspaceSize(const miopenConvolutionPlan_t plan, size_t* workSpaceSize);
+
+/*! @brief Runs a convolution plan
+ *
+ *   The buffers are named after the forward convolution regardless of the direction, as the
+ * tensors of miopenConvProblem_t: x is the input data (x or dx), w the weights (w or dw) and y
+ * the output data (y or dy). The one computed by the direction of the plan is written, the
+ * others are only read.
+ *
+ *   A plan shall not be run by several threads at the same time.
+ *
+ * @param handle         MIOpen handle the plan was created with (input)
+ * @param plan           Convolution plan (input)
+ * @param x              Data tensor x or dx (input or output)
+ * @param w              Weights tensor w or dw (input or output)
+ * @param y              Data tensor y or dy (input or output)
+ * @param workSpace      Pointer to memory allocated for the workspace (input)
+ * @param workSpaceSize  Size of the workspace in bytes, at least the one reported by
+ *                       miopenGetConvolutionPlanWorkspaceSize (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenRunConvolutionPlan(miopenHandle_t handle,
+                                                      miopenConvolutionPlan_t plan,
+                                                      void* x,
+                                                      void* w,
+                                                      void* y,
+                                                      void* workSpace,
+                                                      size_t workSpaceSize);
+
+/*! @brief Destroys a convolution plan
+ *
+ * @param plan           Convolution plan to destroy (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenDestroyConvolutionPlan(miopenConvolutionPlan_t plan);
+
+/*! @brief Query the workspace size required by miopenConvolutionForwardBatched()
+ *
+ * @param handle         MIOpen handle (input)
+ * @param wDesc          Tensor descriptor shared by the weight tensors (input)
+ * @param xDesc          Tensor descriptor shared by the input tensors (input)
+ * @param convDesc       Convolution layer descriptor (input)
+ * @param yDesc          Tensor descriptor shared by the output tensors (input)
+ * @param count          Number of convolutions (input)
+ * @param workSpaceSize  Size of the workspace in bytes (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenConvolutionForwardBatchedGetWorkSpaceSize(miopenHandle_t handle,
+                                                const miopenTensorDescriptor_t wDesc,
+                                                const miopenTensorDescriptor_t xDesc,
+                                                const miopenConvolutionDescriptor_t convDesc,
+                                                const miopenTensorDescriptor_t yDesc,
+                                                int count,
+                                                size_t* workSpaceSize);
+
+/*! @brief Executes independent forward convolutions that share their descriptors
+ *
+ *   Convolution i computes y[i] from x[i] and its own weights w[i]. The arrays hold device
+ * buffers and are allocated on the host. This suits many small convolutions, such as per-sample
+ * filters or the layers of an ensemble of small models, where separate calls would leave the
+ * device idle between the launches.
+ *
+ *   With the HIP backend, when the batch size of xDesc is 1 and each of x, w and y advances by
+ * exactly one packed tensor from a convolution to the next, all of them run as one grouped
+ * convolution in a single launch. Otherwise the solution is selected once and the convolutions
+ * are launched one after the other.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param xDesc          Tensor descriptor shared by the input tensors (input)
+ * @param x              Array of count input tensors (input)
+ * @param wDesc          Tensor descriptor shared by the weight tensors (input)
+ * @param w              Array of count weight tensors (input)
+ * @param convDesc       Convolution layer descriptor (input)
+ * @param yDesc          Tensor descriptor shared by the output tensors (input)
+ * @param y              Array of count output tensors (output)
+ * @param count          Number of convolutions (input)
+ * @param workSpace      Pointer to the workspace (input)
+ * @param workSpaceSize  Size in bytes of the workspace, at least the one returned by
+ *                       miopenConvolutionForwardBatchedGetWorkSpaceSize() (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenConvolutionForwardBatched(miopenHandle_t handle,
+                                const miopenTensorDescriptor_t xDesc,
+                                const void* const* x,
+                                const miopenTensorDescriptor_t wDesc,
+                                const void* const* w,
+                                const miopenConvolutionDescriptor_t convDesc,
+                                const miopenTensorDescriptor_t yDesc,
+                                void* const* y,
+                                int count,
+                                void* workSpace,
+                                size_t workSpaceSize);
+
+/*! Number of buckets of a solver latency histogram. The bucket 0 counts the runs shorter than
+ * 1 microsecond, the bucket i the runs from 2^(i-1) to 2^i microseconds and the last bucket all
+ * the longer runs.
+ */
+#define MIOPEN_SOLVER_HISTOGRAM_BUCKETS 24
+
+/*! @brief Execution time histogram of a convolution solver
+ */
+typedef struct
+{
+    uint64_t solverId;                               /*!< Identifier of the solver */
+    miopenConvDirection_t direction;                 /*!< Direction the solver was run in */
+    miopenDataType_t dataType;                       /*!< Data type of the problems */
+    size_t count;                                    /*!< Number of recorded runs */
+    float totalTimeMs;                               /*!< Sum of the recorded times */
+    float minTimeMs;                                 /*!< Shortest recorded time */
+    float maxTimeMs;                                 /*!< Longest recorded time */
+    size_t buckets[MIOPEN_SOLVER_HISTOGRAM_BUCKETS]; /*!< Run counts per time bucket */
+} miopenSolverHistogram_t;
+
+/*! @brief Query the number of the solver latency histograms
+ *
+ *   A histogram is kept per solver, direction and data type for the whole process. When
+ * profiling is enabled on a handle, all the convolution runs on it are recorded. Otherwise one
+ * run in MIOPEN_SOLVER_HISTOGRAM_SAMPLE_PERIOD (1000 by default, 0 disables sampling) of each
+ * thread is run with profiling enabled and recorded, which makes that run synchronous.
+ *
+ * @param count          Number of histograms (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGetSolverHistogramCount(size_t* count);
+
+/*! @brief Read the solver latency histograms
+ *
+ * @param maxCount       Number of entries in the histograms array (input)
+ * @param count          Number of histograms written (output)
+ * @param histograms     Array of histograms to fill (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGetSolverHistograms(size_t maxCount,
+                                                       size_t* count,
+                                                       miopenSolverHistogram_t* histograms);
+
+/*! @brief Remove all the solver latency histograms
+ *
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenResetSolverHistograms(void);
+
 /*! @brief Query the workspace size required for a forward convolution layer
  *
  * This call is required and must be executed once before running
@@ -1498,31 +2106,105 @@ miopenFindConvolutionForwardAlgorithm(miopenHandle_t handle,
                                       size_t workSpaceSize,
                                       bool exhaustiveSearch);
 
-/*! @brief Execute a forward convolution layer
+/*! @brief Start the search of miopenFindConvolutionForwardAlgorithm() in the background
  *
- * Runs the forward convolution layer based on the selected algorithm. The function
- * miopenFindConvolutionForwardAlgorithm() must have been executed previously to
- * determine the required memory needed for the workspace and the best convolutional algorithm.
+ *   The search runs on a thread and a stream of its own, so the caller may keep enqueuing work on
+ * the handle meanwhile, and is not delayed by the profiling of the search. Its results are
+ * collected with miopenConvolutionFindFutureWait(). The find-db is updated as by the blocking
+ * call, and when the search is done miopenConvolutionForward() may be run on the handle with
+ * any of the returned algorithms.
  *
- * If using Group/Depthwise convolution mode, call miopenSetConvolutionGroupCount() before running
- * this.
+ *   The descriptors are copied. The handle and the buffers shall stay valid, and the buffers
+ * shall not be used by the caller, until the search is done.
  *
- * @param handle         MIOpen handle (input)
- * @param alpha          Floating point scaling factor, allocated on the host (input)
- * @param xDesc          Tensor descriptor for data input tensor x (input)
- * @param x              Data tensor x (input)
- * @param wDesc          Tensor descriptor for weight tensor w (input)
- * @param w              Weights tensor w (inputs)
- * @param convDesc       Convolution layer descriptor (inputs)
- * @param algo           Algorithm selected (inputs)
- * @param beta           Floating point shift factor, allocated on the host (input)
- * @param yDesc          Tensor descriptor for output data tensor y (input)
- * @param y              Data tensor y (output)
- * @param workSpace      Pointer to workspace required (input)
- * @param workSpaceSize  Size in bytes of the memory determined by the find step (input)
- * @return               miopenStatus_t
- */
-MIOPEN_EXPORT miopenStatus_t miopenConvolutionForward(miopenHandle_t handle,
+ * @param handle             MIOpen handle (input)
+ * @param xDesc              Tensor descriptor for data input tensor x (input)
+ * @param x                  Data tensor x (input)
+ * @param wDesc              Tensor descriptor for weight tensor w (input)
+ * @param w                  Weights tensor w (input)
+ * @param convDesc           Convolution layer descriptor (input)
+ * @param yDesc              Tensor descriptor for output data tensor y (input)
+ * @param y                  Data tensor y (output)
+ * @param requestAlgoCount   Number of algorithms to return kernel times (input)
+ * @param workSpace          Pointer to workspace required for the search (output)
+ * @param workSpaceSize      Size in bytes of the memory needed for find (input)
+ * @param exhaustiveSearch   A boolean to toggle a full search of all algorithms and configurations
+ * (input)
+ * @param future             Pointer to the future tracking the search (output)
+ * @return                   miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenFindConvolutionForwardAlgorithmAsync(miopenHandle_t handle,
+                                           const miopenTensorDescriptor_t xDesc,
+                                           const void* x,
+                                           const miopenTensorDescriptor_t wDesc,
+                                           const void* w,
+                                           const miopenConvolutionDescriptor_t convDesc,
+                                           const miopenTensorDescriptor_t yDesc,
+                                           void* y,
+                                           const int requestAlgoCount,
+                                           void* workSpace,
+                                           size_t workSpaceSize,
+                                           bool exhaustiveSearch,
+                                           miopenConvolutionFindFuture_t* future);
+
+/*! @brief Query if the search tracked by a future is done
+ *
+ * @param future             Convolution find future (input)
+ * @param ready              True if miopenConvolutionFindFutureWait will not block (output)
+ * @return                   miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenConvolutionFindFutureIsReady(const miopenConvolutionFindFuture_t future, bool* ready);
+
+/*! @brief Wait for the search tracked by a future and return its results
+ *
+ *   Returns the status the search failed with, if any. May be called several times.
+ *
+ * @param future             Convolution find future (input)
+ * @param returnedAlgoCount  Pointer to number of algorithms returned (output)
+ * @param perfResults        Pointer to an array of at least requestAlgoCount entries, sorted as
+ *                           by miopenFindConvolutionForwardAlgorithm (output)
+ * @return                   miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenConvolutionFindFutureWait(const miopenConvolutionFindFuture_t future,
+                                int* returnedAlgoCount,
+                                miopenConvAlgoPerf_t* perfResults);
+
+/*! @brief Destroys a convolution find future, waiting for its search to be done
+ *
+ * @param future             Convolution find future to destroy (input)
+ * @return                   miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenDestroyConvolutionFindFuture(miopenConvolutionFindFuture_t future);
+
+/*! @brief Execute a forward convolution layer
+ *
+ * Runs the forward convolution layer based on the selected algorithm. The function
+ * miopenFindConvolutionForwardAlgorithm() must have been executed previously to
+ * determine the required memory needed for the workspace and the best convolutional algorithm.
+ *
+ * If using Group/Depthwise convolution mode, call miopenSetConvolutionGroupCount() before running
+ * this.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param alpha          Floating point scaling factor, allocated on the host (input)
+ * @param xDesc          Tensor descriptor for data input tensor x (input)
+ * @param x              Data tensor x (input)
+ * @param wDesc          Tensor descriptor for weight tensor w (input)
+ * @param w              Weights tensor w (inputs)
+ * @param convDesc       Convolution layer descriptor (inputs)
+ * @param algo           Algorithm selected (inputs)
+ * @param beta           Floating point shift factor, allocated on the host (input)
+ * @param yDesc          Tensor descriptor for output data tensor y (input)
+ * @param y              Data tensor y (output)
+ * @param workSpace      Pointer to workspace required (input)
+ * @param workSpaceSize  Size in bytes of the memory determined by the find step (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenConvolutionForward(miopenHandle_t handle,
                                                       const void* alpha,
                                                       const miopenTensorDescriptor_t xDesc,
                                                       const void* x,
@@ -1824,6 +2506,70 @@ MIOPEN_EXPORT miopenStatus_t miopenConvolutionBackwardBias(miopenHandle_t handle
                                                            const miopenTensorDescriptor_t dbDesc,
                                                            void* db);
 
+/*! @brief Query the workspace size required by miopenConvolutionBackwardWeightsBias()
+ *
+ * The returned size covers both the selected backward weights algorithm and the fused GEMM path,
+ * which keeps the bias gradient next to the weights gradient in the workspace.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param dyDesc         Tensor descriptor for data input tensor dy (input)
+ * @param xDesc          Tensor descriptor for data tensor x (input)
+ * @param convDesc       Convolution layer descriptor (input)
+ * @param dwDesc         Tensor descriptor for output weights tensor dw (input)
+ * @param workSpaceSize  Size in bytes of the memory required (output)
+ * @return               miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t
+miopenConvolutionBackwardWeightsBiasGetWorkSpaceSize(miopenHandle_t handle,
+                                                     const miopenTensorDescriptor_t dyDesc,
+                                                     const miopenTensorDescriptor_t xDesc,
+                                                     const miopenConvolutionDescriptor_t convDesc,
+                                                     const miopenTensorDescriptor_t dwDesc,
+                                                     size_t* workSpaceSize);
+
+/*! @brief Calculates the gradients with respect to the weights and the bias
+ *
+ * Equivalent to miopenConvolutionBackwardWeights() followed by miopenConvolutionBackwardBias().
+ * With miopenConvolutionBwdWeightsAlgoGEMM and a workspace of at least the size returned by
+ * miopenConvolutionBackwardWeightsBiasGetWorkSpaceSize(), the bias gradient is produced by the
+ * weights GEMM itself, so the output gradient dy is read only once. The fusion applies to
+ * non-grouped, non-transposed convolutions that use im2col; other problems, algorithms, or a
+ * smaller workspace fall back to the two separate passes.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param alpha          Floating point scaling factor, allocated on the host (input)
+ * @param dyDesc         Tensor descriptor for data tensor dy (input)
+ * @param dy             Data delta tensor dy (input)
+ * @param xDesc          Tensor descriptor for data tensor x (input)
+ * @param x              Data tensor x (input)
+ * @param convDesc       Convolution layer descriptor (input)
+ * @param algo           Algorithm selected (input)
+ * @param beta           Floating point shift factor, allocated on the host (input)
+ * @param dwDesc         Tensor descriptor for weight tensor dw (input)
+ * @param dw             Weights delta tensor dw (output)
+ * @param dbDesc         Tensor descriptor for bias tensor db (input)
+ * @param db             Bias delta tensor db (output)
+ * @param workSpace      Pointer to workspace (input)
+ * @param workSpaceSize  Size in bytes of the workspace (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenConvolutionBackwardWeightsBias(miopenHandle_t handle,
+                                     const void* alpha,
+                                     const miopenTensorDescriptor_t dyDesc,
+                                     const void* dy,
+                                     const miopenTensorDescriptor_t xDesc,
+                                     const void* x,
+                                     const miopenConvolutionDescriptor_t convDesc,
+                                     miopenConvBwdWeightsAlgorithm_t algo,
+                                     const void* beta,
+                                     const miopenTensorDescriptor_t dwDesc,
+                                     void* dw,
+                                     const miopenTensorDescriptor_t dbDesc,
+                                     void* db,
+                                     void* workSpace,
+                                     size_t workSpaceSize);
+
 /** @} */
 // CLOSEOUT CONVOLUTIONS DOXYGEN GROUP
 
@@ -2050,6 +2796,8 @@ miopenPoolingGetWorkSpaceSizeV2(const miopenPoolingDescriptor_t poolDesc,
  * miopenPoolingForward().
  * If the parameter do_backward == 0, then set workSpace = nullptr and workSpaceSize = 0. However,
  * for back-propagation do_backwards must be set to 1 in miopenPoolingForward().
+ * int8 and packed int8x4 tensors are pooled in fp32 and rounded back to int8 with saturation, so
+ * the output keeps the quantization scale of the input. int8x4 max pooling cannot save indices.
  *
  * @param handle         MIOpen handle (input)
  * @param poolDesc       Descriptor for pooling layer (input)
@@ -2290,6 +3038,9 @@ MIOPEN_EXPORT miopenStatus_t miopenDeriveBNTensorDescriptor(miopenTensorDescript
  *
  * Likewise, if either resultRunningMean, or resultRunningVariance are null pointers then the values
  * for the running mean and variance will not be saved.
+ *
+ * The layer may run in place, with y the same buffer as x; see
+ * miopenBatchNormalizationBackwardFromOutput for the matching backward pass.
  * Running averages and variances are scaled using an exponential averaging factor: \f[
  * \mu_{old} = \mu_{new}*factor + \mu_{old}*(1-factor)
  * \f]
@@ -2345,6 +3096,8 @@ miopenBatchNormalizationForwardTraining(miopenHandle_t handle,
  * If either estimatedMean, or estimatedVariance are null pointers then the values for the mean and
  * variance will not be used.
  *
+ * The layer may run in place, with y the same buffer as x.
+ *
  * @param handle                    MIOpen handle (input)
  * @param bn_mode                   Batch normalization mode (input)
  * @param alpha                     Floating point scaling factor, allocated on the host (input)
@@ -2433,6 +3186,58 @@ miopenBatchNormalizationBackward(miopenHandle_t handle,
                                  const void* savedMean,
                                  const void* savedInvVariance);
 
+/*! @brief Execute backwards propagation layer for batch normalization from its output
+ *
+ * Same as miopenBatchNormalizationBackward, but takes the output y of the forward training pass
+ * instead of its input x. This is the backward pass of a forward training pass run in place
+ * (y == x). y is first overwritten with the recomputed x, from the saved mean and inverse
+ * variance and from bnScale and bnBias, which requires bnScale to have no zero entries.
+ *
+ * @param handle                    MIOpen handle (input)
+ * @param bn_mode                   Batch normalization mode (input)
+ * @param alphaDataDiff             Floating point scaling factor, allocated on the host (input)
+ * @param betaDataDiff              Floating point shift factor, allocated on the host (input)
+ * @param alphaParamDiff            Floating point scaling factor, allocated on the host (input)
+ * @param betaParamDiff             Floating point shift factor, allocated on the host (input)
+ * @param yDesc                     Tensor descriptor for the forward output tensor y (input)
+ * @param y                         Data tensor y, overwritten with x (input/output)
+ * @param dyDesc                    Tensor descriptor for output data tensor y (input)
+ * @param dy                        Data tensor y (input)
+ * @param dxDesc                    Tensor descriptor for output data tensor dx (input)
+ * @param dx                        Data delta tensor dx (output)
+ * @param bnScaleBiasDiffDesc       Tensor descriptor for BN scaling, shifting, saved variance and
+ * mean (input)
+ * @param bnScale                   Batch norm scaling, gamma, tensor (input)
+ * @param bnBias                    Batch norm bias, beta, tensor (input)
+ * @param resultBnScaleDiff         Tensor for dscale (output)
+ * @param resultBnBiasDiff          Tensor for dbias (output)
+ * @param epsilon                   Value to stabilize inverse variance calculation (input)
+ * @param savedMean                 Saved mini-batch mean, must not be null (input)
+ * @param savedInvVariance          Saved mini-batch inverse variance, must not be null (input)
+ * @return                          miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t
+miopenBatchNormalizationBackwardFromOutput(miopenHandle_t handle,
+                                           miopenBatchNormMode_t bn_mode,
+                                           const void* alphaDataDiff,
+                                           const void* betaDataDiff,
+                                           const void* alphaParamDiff,
+                                           const void* betaParamDiff,
+                                           const miopenTensorDescriptor_t yDesc,
+                                           void* y,
+                                           const miopenTensorDescriptor_t dyDesc,
+                                           const void* dy,
+                                           const miopenTensorDescriptor_t dxDesc,
+                                           void* dx,
+                                           const miopenTensorDescriptor_t bnScaleBiasDiffDesc,
+                                           const void* bnScale,
+                                           const void* bnBias,
+                                           void* resultBnScaleDiff,
+                                           void* resultBnBiasDiff,
+                                           double epsilon,
+                                           const void* savedMean,
+                                           const void* savedInvVariance);
+
 /** @} */
 // CLOSEOUT BATCHNORM DOXYGEN GROUP
 
@@ -2486,6 +3291,13 @@ miopenGetActivationDescriptor(const miopenActivationDescriptor_t activDesc,
                               double* activGamma);
 
 /*! @brief Execute an activation forward layer
+ *
+ * The layer may run in place: y may be the same buffer as x when both descriptors describe the
+ * same layout.
+ *
+ * For packed int8 and int8x4 tensors the activation is evaluated in fp32 with its parameters in
+ * the units of x, and alpha is the requantization factor (scale of x over scale of y):
+ * y = round(alpha * f(x)) saturated to int8. beta must be 0.
  *
  * @param handle         MIOpen handle (input)
  * @param activDesc      Descriptor for activation layer (input)
@@ -2507,6 +3319,11 @@ MIOPEN_EXPORT miopenStatus_t miopenActivationForward(miopenHandle_t handle,
                                                      void* y);
 
 /*! @brief Execute a activation backwards layer
+ *
+ * dx may be the same buffer as dy. For the modes whose derivative can be recovered from the
+ * output (pass-through, logistic, tanh, ReLU, clipped ReLU, and leaky ReLU and ELU with
+ * non-negative alpha) x may be NULL, so that the forward layer can overwrite its input; xDesc
+ * must still be given and may be yDesc. The other modes return miopenStatusBadParm for NULL x.
  *
  * @param handle         MIOpen handle (input)
  * @param activDesc      Descriptor for activation layer (input)
@@ -2516,7 +3333,7 @@ MIOPEN_EXPORT miopenStatus_t miopenActivationForward(miopenHandle_t handle,
  * @param dyDesc         Tensor descriptor for input data tensor dy (input)
  * @param dy             Data delta tensor dy (input)
  * @param xDesc          Tensor descriptor for data input tensor x (input)
- * @param x              Data tensor x (input)
+ * @param x              Data tensor x, may be NULL as described above (input)
  * @param beta           Floating point shift factor, allocated on the host (input)
  * @param dxDesc         Tensor descriptor for data output tensor dx (input)
  * @param dx             Output data delta tensor dx (output)
@@ -2647,6 +3464,32 @@ MIOPEN_EXPORT miopenStatus_t miopenSoftmaxBackward_V2(miopenHandle_t handle,
                                                       miopenSoftmaxAlgorithm_t algorithm,
                                                       miopenSoftmaxMode_t mode);
 
+/*! @brief Execute a fused log-softmax and negative log-likelihood loss layer
+ *
+ * Computes the cross-entropy loss of every sample directly from the logits in the channel
+ * dimension, and optionally its gradient with respect to the logits, softmax(x) - onehot(label),
+ * without materializing the probabilities. Samples with a label outside [0, C) are ignored and
+ * get a loss and a gradient of 0.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param xDesc          Tensor descriptor for the logits tensor x of N x C x H x W (input)
+ * @param x              Logits tensor x (input)
+ * @param labels         Device buffer of N x H x W int32 class indices (input)
+ * @param lossDesc       Tensor descriptor for the loss tensor of N x 1 x H x W (input)
+ * @param loss           Per-sample loss tensor (output)
+ * @param dxDesc         Tensor descriptor for the gradient tensor dx (input)
+ * @param dx             Gradient of the loss with respect to x, may be nullptr (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenSoftmaxCrossEntropy(miopenHandle_t handle,
+                                                       const miopenTensorDescriptor_t xDesc,
+                                                       const void* x,
+                                                       const void* labels,
+                                                       const miopenTensorDescriptor_t lossDesc,
+                                                       void* loss,
+                                                       const miopenTensorDescriptor_t dxDesc,
+                                                       void* dx);
+
 /** @} */
 // CLOSEOUT SOFTMAX DOXYGEN GROUP
 
@@ -2811,6 +3654,51 @@ MIOPEN_EXPORT miopenStatus_t miopenCreateOpBiasForward(miopenFusionPlanDescripto
                                                        miopenFusionOpDescriptor_t* biasOp,
                                                        const miopenTensorDescriptor_t bDesc);
 
+// Residual add create ops ---
+/*! @brief Creates a forward residual add operator.
+*
+* Adds a skip connection tensor of the same shape as the input to the output of a preceding
+* training batch normalization, ahead of an optional activation.
+*
+* @param fusePlanDesc   A fusion plan descriptor (input)
+* @param residualOp     Pointer to an operator type (output)
+* @return               miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t
+miopenCreateOpResidualAddForward(miopenFusionPlanDescriptor_t fusePlanDesc,
+                                 miopenFusionOpDescriptor_t* residualOp);
+
+/*! @brief Creates a backward residual add operator.
+*
+* Back propagates a forward residual add; the gradient of the skip connection is written next to
+* the gradient of the batch normalization input.
+*
+* @param fusePlanDesc   A fusion plan descriptor (input)
+* @param residualOp     Pointer to an operator type (output)
+* @return               miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t
+miopenCreateOpResidualAddBackward(miopenFusionPlanDescriptor_t fusePlanDesc,
+                                  miopenFusionOpDescriptor_t* residualOp);
+
+// Pooling create ops ---
+/*! @brief Creates a forward pooling operator.
+*
+* Pools the output of a convolution and the bias, activation, batch normalization and residual
+* add ops following it. It shall be the last op of the plan; the output tensor of the plan is the
+* pooled tensor. Max and average poolings of 2D tensors are supported, no indices are saved, so
+* the op is meant for inference.
+*
+* @param fusePlanDesc   A fusion plan descriptor (input)
+* @param poolOp         Pointer to an operator type (output)
+* @param poolDesc       Pooling layer descriptor (input)
+* @return               miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t
+miopenCreateOpPoolingForward(miopenFusionPlanDescriptor_t fusePlanDesc,
+                             miopenFusionOpDescriptor_t* poolOp,
+                             const miopenPoolingDescriptor_t poolDesc);
+
 // Batch normalization create ops ---
 /*! @brief Creates a forward inference batch normalization operator.
 *
@@ -3024,6 +3912,41 @@ MIOPEN_EXPORT miopenStatus_t miopenSetOpArgsBiasForward(miopenOperatorArgs_t arg
                                                         const void* alpha,
                                                         const void* beta,
                                                         const void* bias);
+
+// Residual add set arguments ---
+/*! @brief Sets the arguments for forward residual add op
+*
+* @param args           An arguments object type (output)
+* @param residualOp     Forward residual add operator (input)
+* @param alpha          Floating point scaling factor, allocated on the host (input)
+* @param beta           Floating point shift factor, allocated on the host (input)
+* @param residual       Pointer to the skip connection tensor memory, shaped as the input (input)
+* @return               miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t
+miopenSetOpArgsResidualAddForward(miopenOperatorArgs_t args,
+                                  const miopenFusionOpDescriptor_t residualOp,
+                                  const void* alpha,
+                                  const void* beta,
+                                  const void* residual);
+
+/*! @brief Sets the arguments for backward residual add op
+*
+* @param args           An arguments object type (output)
+* @param residualOp     Backward residual add operator (input)
+* @param alpha          Floating point scaling factor, allocated on the host (input)
+* @param beta           Floating point shift factor, allocated on the host (input)
+* @param residual       Pointer to the skip connection tensor memory of the forward pass (input)
+* @param residualDiff   Pointer to the skip connection gradient tensor memory (output)
+* @return               miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t
+miopenSetOpArgsResidualAddBackward(miopenOperatorArgs_t args,
+                                   const miopenFusionOpDescriptor_t residualOp,
+                                   const void* alpha,
+                                   const void* beta,
+                                   const void* residual,
+                                   void* residualDiff);
 /*! @brief Executes the fusion plan
 *
 *
@@ -3178,7 +4101,8 @@ MIOPEN_EXPORT miopenStatus_t miopenDestroyRNNDescriptor(miopenRNNDescriptor_t rn
  * @param rnnMode      RNN model type (input)
  * @param biasMode     RNN bias included (input)
  * @param algo         RNN algorithm selected (input)
- * @param dataType     Only fp32 currently supported for RNNs (input)
+ * @param dataType     fp32, fp16 or bfloat16, the latter only for LSTM and GRU with the default
+ *                     algorithm (input)
  * @return             miopenStatus_t
 */
 MIOPEN_EXPORT miopenStatus_t miopenSetRNNDescriptor(miopenRNNDescriptor_t rnnDesc,
@@ -3206,7 +4130,8 @@ MIOPEN_EXPORT miopenStatus_t miopenSetRNNDescriptor(miopenRNNDescriptor_t rnnDes
  * @param rnnMode      RNN model type (input)
  * @param biasMode     RNN bias included (input)
  * @param algo         RNN algorithm selected (input)
- * @param dataType     Only fp32 currently supported for RNNs (input)
+ * @param dataType     fp32, fp16 or bfloat16, the latter only for LSTM and GRU with the default
+ *                     algorithm and without dropout (input)
  * @return             miopenStatus_t
 */
 MIOPEN_EXPORT miopenStatus_t miopenSetRNNDescriptor_V2(miopenRNNDescriptor_t rnnDesc,
@@ -3220,6 +4145,60 @@ MIOPEN_EXPORT miopenStatus_t miopenSetRNNDescriptor_V2(miopenRNNDescriptor_t rnn
                                                        miopenRNNAlgo_t algo,
                                                        miopenDataType_t dataType);
 
+/*! @brief Set the size of the projection of the hidden state of an LSTM
+ *
+ * With a projection (LSTMP), every cell multiplies its hidden state by a projSize x hsize
+ * matrix, and the projected state is both the output of the layer and the recurrent input of
+ * its next step. hx, hy, dhx and dhy are then of size [numLayers * directions, batch, projSize]
+ * and the output of a step is of size [batch, directions * projSize], while cx, cy, dcx and
+ * dcy keep the hidden size. The recurrent weight matrices and the input weight matrices of the
+ * upper layers shrink to projSize columns per direction. A projection is supported for LSTM
+ * with the default algorithm, linear input and no dropout. Setting the RNN descriptor again
+ * clears the projection.
+ *
+ * @param rnnDesc      RNN layer descriptor type (input/output)
+ * @param projSize     Projection size, up to the hidden size, 0 to disable the projection (input)
+ * @return             miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenSetRNNProjectionSize(miopenRNNDescriptor_t rnnDesc,
+                                                        const int projSize);
+
+/*! @brief Get the size of the projection of the hidden state of an LSTM
+ *
+ * @param rnnDesc      RNN layer descriptor type (input)
+ * @param projSize     Projection size, 0 without projection (output)
+ * @return             miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenGetRNNProjectionSize(miopenRNNDescriptor_t rnnDesc,
+                                                        int* projSize);
+
+/*! @brief Set the data type of the activations kept in the reserve space of an RNN
+ *
+ * An fp32 RNN may keep its reserve space in miopenHalf or miopenBFloat16, which roughly halves
+ * the memory held between the forward and backward training passes. All computation stays in
+ * fp32: miopenRNNForwardTraining, miopenRNNBackwardData and miopenRNNBackwardWeights run on an
+ * fp32 copy of the reserve space kept at the end of the workspace, so the workspace grows by
+ * the size of an fp32 reserve space. The workspace given to miopenRNNBackwardWeights must hold
+ * what miopenRNNBackwardData left in it, as before. Query the sizes after this call. Setting
+ * the RNN descriptor again restores an fp32 reserve space.
+ *
+ * @param rnnDesc      RNN layer descriptor type (input/output)
+ * @param dataType     miopenFloat, miopenHalf or miopenBFloat16 for an fp32 RNN, the data type
+ *                     of the RNN otherwise (input)
+ * @return             miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenSetRNNReserveSpaceDataType(miopenRNNDescriptor_t rnnDesc,
+                                                              miopenDataType_t dataType);
+
+/*! @brief Get the data type of the activations kept in the reserve space of an RNN
+ *
+ * @param rnnDesc      RNN layer descriptor type (input)
+ * @param dataType     Data type of the reserve space (output)
+ * @return             miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenGetRNNReserveSpaceDataType(miopenRNNDescriptor_t rnnDesc,
+                                                              miopenDataType_t* dataType);
+
 /*! @brief Query the amount of memory required to execute the RNN layer
  *
  * This function calculates the amount of memory required to run the RNN layer given an RNN
@@ -3360,6 +4339,9 @@ MIOPEN_EXPORT miopenStatus_t miopenGetRNNHiddenTensorSize(miopenHandle_t handle,
  *
  * * paramID 3 and 7 are for the new memory gate.
  *
+ * With a projection set by miopenSetRNNProjectionSize(), paramID 8 refers to the
+ * projection matrix of an LSTM layer.
+ *
  * For miopenGRU paramID 0 to 2 refer to the weight matrix offset associated
  * with the input GEMM, while 3 through 5 are associated with the hidden state
  * GEMM.
@@ -3452,6 +4434,9 @@ MIOPEN_EXPORT miopenStatus_t miopenGetRNNLayerBiasSize(miopenHandle_t handle,
  *
  * * paramID 3 and 7 are for the new memory gate.
  *
+ * With a projection set by miopenSetRNNProjectionSize(), paramID 8 refers to the
+ * projection matrix of an LSTM layer.
+ *
  * For miopenGRU paramID 0 to 2 refer to the weight matrix offset associated
  * with the input GEMM, while 3 through 5 are associated with the hidden state
  * GEMM.
@@ -3587,6 +4572,9 @@ MIOPEN_EXPORT miopenStatus_t miopenGetRNNLayerBias(miopenHandle_t handle,
  *
  * * paramID 3 and 7 are for the new memory gate.
  *
+ * With a projection set by miopenSetRNNProjectionSize(), paramID 8 refers to the
+ * projection matrix of an LSTM layer.
+ *
  * For miopenGRU paramID 0 to 2 refer to the weight matrix offset associated
  * with the input GEMM, while 3 through 5 are associated with the hidden state
  * GEMM.
@@ -3705,6 +4693,9 @@ MIOPEN_EXPORT miopenStatus_t miopenGetRNNLayerBiasOffset(miopenRNNDescriptor_t r
  *
  * * paramID 3 and 7 are for the new memory gate.
  *
+ * With a projection set by miopenSetRNNProjectionSize(), paramID 8 refers to the
+ * projection matrix of an LSTM layer.
+ *
  * For miopenGRU paramID 0 to 2 refer to the weight matrix offset associated
  * with the input GEMM, while 3 through 5 are associated with the hidden state
  * GEMM.
@@ -4112,6 +5103,205 @@ MIOPEN_EXPORT miopenStatus_t miopenRNNForwardInference(miopenHandle_t handle,
                                                        void* workSpace,
                                                        size_t workSpaceNumBytes);
 
+/*! @brief Prepares the parameters of an RNN for repeated inference
+ *
+ * Copies the parameter tensor, typically populated with miopenSetRNNLayerParam() and
+ * miopenSetRNNLayerBias(), into device memory owned by the returned object, with the weight
+ * matrices laid out as the inference GEMMs read them best. Later changes to w are not seen
+ * by the prepared weights, which shall be recreated.
+ *
+ * @param handle          MIOpen handle (input)
+ * @param rnnDesc         RNN layer descriptor type (input)
+ * @param xDesc           A tensor descriptor to input (input)
+ * @param wDesc           A tensor descriptor to the parameter tensor (input)
+ * @param w               Pointer to memory containing parameter tensor (input)
+ * @param preparedWeights Pointer to the prepared weights (output)
+ * @return                miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t
+miopenCreateRNNPreparedWeights(miopenHandle_t handle,
+                               miopenRNNDescriptor_t rnnDesc,
+                               miopenTensorDescriptor_t xDesc,
+                               miopenTensorDescriptor_t wDesc,
+                               const void* w,
+                               miopenRNNPreparedWeights_t* preparedWeights);
+
+/*! @brief Prepares the parameters of an RNN for inference with int8 recurrent weights
+ *
+ * Same as miopenCreateRNNPreparedWeights(), except that the recurrent weight matrices are
+ * quantized to int8 with one float scale per row, the largest magnitude of the row mapping to
+ * 127. miopenRNNForwardInferencePrepared() then dequantizes them inside the recurrent GEMMs,
+ * or inside the persistent kernel, so each time step reads about a quarter of the bytes of
+ * float weights. The input matrices and the biases are kept in float. Only float parameters
+ * are supported, and the results differ from the float inference by the quantization error.
+ *
+ * @param handle          MIOpen handle (input)
+ * @param rnnDesc         RNN layer descriptor type (input)
+ * @param xDesc           A tensor descriptor to input (input)
+ * @param wDesc           A tensor descriptor to the parameter tensor (input)
+ * @param w               Pointer to memory containing parameter tensor (input)
+ * @param preparedWeights Pointer to the prepared weights (output)
+ * @return                miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t
+miopenCreateRNNQuantizedWeights(miopenHandle_t handle,
+                                miopenRNNDescriptor_t rnnDesc,
+                                miopenTensorDescriptor_t xDesc,
+                                miopenTensorDescriptor_t wDesc,
+                                const void* w,
+                                miopenRNNPreparedWeights_t* preparedWeights);
+
+/*! @brief Destroys prepared RNN weights and frees their device memory
+ *
+ * @param preparedWeights  Prepared weights to destroy (input)
+ * @return                 miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t
+miopenDestroyRNNPreparedWeights(miopenRNNPreparedWeights_t preparedWeights);
+
+/*! @brief Execute forward inference for RNN layer with prepared weights
+ *
+ * Same as miopenRNNForwardInference(), with the parameters taken from weights prepared by
+ * miopenCreateRNNPreparedWeights() for the same RNN descriptor and input vector length.
+ *
+ * @param handle                MIOpen handle (input)
+ * @param rnnDesc               RNN layer descriptor type (input)
+ * @param sequenceLen           Temporal iterations to unroll (input)
+ * @param xDesc                 An array of tensor descriptors, see miopenRNNForwardInference()
+ * (input)
+ * @param x                     Pointer to input tensor (input)
+ * @param hxDesc                A hidden tensor descriptor (input)
+ * @param hx                    Pointer to the hidden layer input tensor, or NULL (input)
+ * @param cxDesc                A cell tensor descriptor (input)
+ * @param cx                    Pointer to the cell layer input tensor, or NULL (input)
+ * @param preparedWeights       Prepared weights (input)
+ * @param yDesc                 An array of fully packed tensor descriptors associated
+ * with the output from each time step (input)
+ * @param y                     Pointer to output tensor (output)
+ * @param hyDesc                A hidden tensor descriptor (input)
+ * @param hy                    Pointer to the hidden layer output tensor, or NULL (output)
+ * @param cyDesc                A output cell tensor descriptor (input)
+ * @param cy                    Pointer to the cell layer output tensor, or NULL (output)
+ * @param workSpace             Pointer to memory allocated for forward inference (input)
+ * @param workSpaceNumBytes     Number of allocated bytes in memory for the workspace (input)
+ * @return                      miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t
+miopenRNNForwardInferencePrepared(miopenHandle_t handle,
+                                  miopenRNNDescriptor_t rnnDesc,
+                                  const int sequenceLen,
+                                  const miopenTensorDescriptor_t* xDesc,
+                                  const void* x,
+                                  const miopenTensorDescriptor_t hxDesc,
+                                  const void* hx,
+                                  const miopenTensorDescriptor_t cxDesc,
+                                  const void* cx,
+                                  const miopenRNNPreparedWeights_t preparedWeights,
+                                  const miopenTensorDescriptor_t* yDesc,
+                                  void* y,
+                                  const miopenTensorDescriptor_t hyDesc,
+                                  void* hy,
+                                  const miopenTensorDescriptor_t cyDesc,
+                                  void* cy,
+                                  void* workSpace,
+                                  size_t workSpaceNumBytes);
+
+/*! @brief Creates the state of a streaming RNN inference
+ *
+ * Streaming inference runs a unidirectional RNN without projection over a sequence given in
+ * chunks of time steps, with the input of each chunk in host memory and its output copied back
+ * to host memory. The hidden and cell states are kept on the device from one chunk to the next.
+ * Every time step of every chunk has the batch size of hxDesc. The state starts at zero, see
+ * miopenResetRNNStreamingState().
+ *
+ * The host copies run on two streams of their own, so that the copies of the neighbouring chunks
+ * overlap the inference of a chunk on the stream of the handle. They overlap, and
+ * miopenRNNForwardInferenceStreaming() returns before they are done, only for page-locked host
+ * memory, e.g. from hipHostMalloc().
+ *
+ * @param handle          MIOpen handle (input)
+ * @param rnnDesc         RNN layer descriptor type (input)
+ * @param xDesc           A tensor descriptor of one time step of the input (input)
+ * @param hxDesc          A tensor descriptor of the hidden and cell states (input)
+ * @param maxChunkLen     The most time steps of a chunk (input)
+ * @param streamingState  Pointer to the streaming state (output)
+ * @return                miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t
+miopenCreateRNNStreamingState(miopenHandle_t handle,
+                              miopenRNNDescriptor_t rnnDesc,
+                              miopenTensorDescriptor_t xDesc,
+                              miopenTensorDescriptor_t hxDesc,
+                              const int maxChunkLen,
+                              miopenRNNStreamingState_t* streamingState);
+
+/*! @brief Destroys a streaming RNN inference state
+ *
+ * Waits for the copies of the chunks enqueued so far and frees the device memory of the state.
+ *
+ * @param streamingState  Streaming state to destroy (input)
+ * @return                miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t
+miopenDestroyRNNStreamingState(miopenRNNStreamingState_t streamingState);
+
+/*! @brief Sets the hidden and cell states of a streaming RNN inference
+ *
+ * The states are copied on the stream of the handle, after the chunks enqueued so far.
+ *
+ * @param handle          MIOpen handle (input)
+ * @param streamingState  Streaming state (input)
+ * @param hx              Pointer to the hidden state on the device, or NULL for zeros (input)
+ * @param cx              Pointer to the cell state on the device, or NULL for zeros (input)
+ * @return                miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenResetRNNStreamingState(miopenHandle_t handle,
+                                                          miopenRNNStreamingState_t streamingState,
+                                                          const void* hx,
+                                                          const void* cx);
+
+/*! @brief Enqueues forward inference for one chunk of a streamed sequence
+ *
+ * Uploads x, runs miopenRNNForwardInference() over the chunk from the state left by the previous
+ * chunk and downloads its output to y. x shall not be changed and y shall not be read before
+ * miopenSynchronizeRNNStreamingState().
+ *
+ * @param handle                MIOpen handle (input)
+ * @param streamingState        Streaming state (input)
+ * @param chunkLen              Time steps of the chunk, at most maxChunkLen of the state (input)
+ * @param xDesc                 An array of tensor descriptors, see miopenRNNForwardInference()
+ * (input)
+ * @param x                     Pointer to the input of the chunk in host memory (input)
+ * @param wDesc                 A tensor descriptor to the parameter tensor (input)
+ * @param w                     Pointer to memory containing parameter tensor (input)
+ * @param yDesc                 An array of fully packed tensor descriptors associated
+ * with the output from each time step (input)
+ * @param y                     Pointer to the output of the chunk in host memory (output)
+ * @param workSpace             Pointer to memory allocated for forward inference of a chunk (input)
+ * @param workSpaceNumBytes     Number of allocated bytes in memory for the workspace (input)
+ * @return                      miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t
+miopenRNNForwardInferenceStreaming(miopenHandle_t handle,
+                                   miopenRNNStreamingState_t streamingState,
+                                   const int chunkLen,
+                                   const miopenTensorDescriptor_t* xDesc,
+                                   const void* x,
+                                   const miopenTensorDescriptor_t wDesc,
+                                   const void* w,
+                                   const miopenTensorDescriptor_t* yDesc,
+                                   void* y,
+                                   void* workSpace,
+                                   size_t workSpaceNumBytes);
+
+/*! @brief Waits for the host copies of the chunks enqueued on a streaming RNN inference
+ *
+ * @param streamingState  Streaming state (input)
+ * @return                miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t
+miopenSynchronizeRNNStreamingState(miopenRNNStreamingState_t streamingState);
+
 /** @} */
 // CLOSEOUT RNN DOXYGEN GROUP
 
@@ -4243,9 +5433,23 @@ MIOPEN_EXPORT miopenStatus_t miopenCTCLoss(miopenHandle_t handle,
 * random number generator type
 */
 typedef enum {
-    MIOPEN_RNG_PSEUDO_XORWOW = 0, /*!< XORWOW pseudorandom generator */
+    MIOPEN_RNG_PSEUDO_XORWOW  = 0, /*!< XORWOW pseudorandom generator */
+    MIOPEN_RNG_PHILOX_4X32_10 = 1, /*!< Counter-based Philox4x32-10 generator. The mask is a pure
+                                      function of (seed, reserveSpace offset, element index), so no
+                                      PRNG states are needed and backward called without
+                                      reserveSpace regenerates the forward mask */
 } miopenRNGType_t;
 
+/*!  @enum miopenDropoutMaskFormat_t
+* layout of the dropout mask in reserveSpace
+*/
+typedef enum {
+    MIOPEN_DROPOUT_MASK_BYTE = 0, /*!< One byte per element (Default) */
+    MIOPEN_DROPOUT_MASK_BIT  = 1, /*!< One bit per element, element i in bit (i % 8) of byte
+                                     (i / 8). Uses an eighth of the reserveSpace memory and
+                                     bandwidth */
+} miopenDropoutMaskFormat_t;
+
 /*! @brief Creates the dropout descriptor object
  *
  * @param dropoutDesc Pointer to a dropout descriptor type
@@ -4262,7 +5466,8 @@ MIOPEN_EXPORT miopenStatus_t miopenDestroyDropoutDescriptor(miopenDropoutDescrip
 
 /*! @brief Query the amount of memory required to run dropout
  *
- * This function calculates the amount of memory required to run dropout.
+ * This function calculates the amount of memory required to run dropout with the default
+ * MIOPEN_DROPOUT_MASK_BYTE mask format.
  * @param xDesc                    Tensor descriptor for data tensor x (input)
  * @param reserveSpaceSizeInBytes  Number of bytes of reservespace required for executing dropout
  * (Output)
@@ -4271,6 +5476,42 @@ MIOPEN_EXPORT miopenStatus_t miopenDestroyDropoutDescriptor(miopenDropoutDescrip
 MIOPEN_EXPORT miopenStatus_t miopenDropoutGetReserveSpaceSize(const miopenTensorDescriptor_t xDesc,
                                                               size_t* reserveSpaceSizeInBytes);
 
+/*! @brief Query the amount of reserveSpace required to run dropout with a given descriptor
+ *
+ * Unlike miopenDropoutGetReserveSpaceSize, this accounts for the mask format set by
+ * miopenSetDropoutMaskFormat.
+ * @param dropoutDesc              Dropout layer descriptor (input)
+ * @param xDesc                    Tensor descriptor for data tensor x (input)
+ * @param reserveSpaceSizeInBytes  Number of bytes of reservespace required for executing dropout
+ * (Output)
+ * @return                         miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t
+miopenDropoutGetDescriptorReserveSpaceSize(const miopenDropoutDescriptor_t dropoutDesc,
+                                           const miopenTensorDescriptor_t xDesc,
+                                           size_t* reserveSpaceSizeInBytes);
+
+/*! @brief Set the layout of the mask kept in reserveSpace
+ *
+ * Defaults to MIOPEN_DROPOUT_MASK_BYTE. The format applies to miopenDropoutForward,
+ * miopenDropoutBackward and to RNNs using the descriptor. A user-defined mask passed with
+ * use_mask must be in the same format.
+ * @param dropoutDesc  Dropout layer descriptor (input/Output)
+ * @param maskFormat   Mask format (input)
+ * @return             miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenSetDropoutMaskFormat(miopenDropoutDescriptor_t dropoutDesc,
+                                                        miopenDropoutMaskFormat_t maskFormat);
+
+/*! @brief Get the layout of the mask kept in reserveSpace
+ *
+ * @param dropoutDesc  Dropout layer descriptor (input)
+ * @param maskFormat   Mask format (output)
+ * @return             miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenGetDropoutMaskFormat(const miopenDropoutDescriptor_t dropoutDesc,
+                                                        miopenDropoutMaskFormat_t* maskFormat);
+
 /*! @brief Query the amount of memory required to store the states of the random number generators
  *
  * This function calculates the amount of memory required to store the states of the random number
@@ -4346,7 +5587,8 @@ MIOPEN_EXPORT miopenStatus_t miopenRestoreDropoutDescriptor(miopenDropoutDescrip
  * @param handle            MIOpen handle (input)
  * @param dropout           The probability by which the input is set to 0 in the dropout layer
  * (input)
- * @param states            Pointer to memory that holds random number generator states (input)
+ * @param states            Pointer to memory that holds random number generator states, unused
+ * with MIOPEN_RNG_PHILOX_4X32_10 (input)
  * @param stateSizeInBytes  Number of bytes provided for random generator states (input)
  * @param seed              Seed used to initialize random number generator states (input)
  * @param use_mask          Boolean flag indicating whether to use a saved mask (an existing or
@@ -4559,9 +5801,622 @@ miopenReduceTensor(miopenHandle_t handle,
                    const miopenTensorDescriptor_t cDesc,
                    void* C);
 
+/*! @brief Finds the k largest or smallest elements along one dimension of a tensor
+ *
+ * The elements are written best first, together with their indices along dim. Elements of
+ * equal value are ordered by index, and NaNs rank before all the other values. k = 1 gives the
+ * arg-max or arg-min along the dimension.
+ *
+ * All the tensors are packed. The values and indices tensors have the lengths of x, but for k
+ * elements along dim. The values are of the data type of x, the indices are miopenInt32.
+ *
+ * Supported datatypes are fp32, fp16 and bfp16
+ *
+ * @param handle       MIOpen handle (input)
+ * @param xDesc        Tensor descriptor for the input tensor x (input)
+ * @param x            Data tensor x (input)
+ * @param dim          The dimension to select along (input)
+ * @param k            Number of elements to select, between 1 and the smaller of 1024 and the
+ *                     length of dim (input)
+ * @param largest      Selects the largest elements when true, the smallest ones when false (input)
+ * @param valuesDesc   Tensor descriptor for the selected values (input)
+ * @param values       Selected values (output)
+ * @param indicesDesc  Tensor descriptor for the indices of the selected values (input)
+ * @param indices      Indices of the selected values along dim (output)
+ * @return             miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenTopK(miopenHandle_t handle,
+                                        const miopenTensorDescriptor_t xDesc,
+                                        const void* x,
+                                        int dim,
+                                        int k,
+                                        bool largest,
+                                        const miopenTensorDescriptor_t valuesDesc,
+                                        void* values,
+                                        const miopenTensorDescriptor_t indicesDesc,
+                                        void* indices);
+
 /** @} */
 // CLOSEOUT TensorReduce DOXYGEN GROUP
 
+// Optimizer APIs
+/** @addtogroup optimizer
+ *
+ *  @{
+ */
+
+/*!  @enum miopenOptimizerMode_t
+ * Parameter update rule of miopenMultiTensorOptimizerUpdate
+ */
+typedef enum {
+    miopenOptimizerSGD      = 0, /*!< w -= lr * (g + weightDecay * w) */
+    miopenOptimizerMomentum = 1, /*!< m = beta1 * m + (g + weightDecay * w), w -= lr * m */
+    miopenOptimizerAdam     = 2, /*!< Adam with L2 weight decay folded into the gradient */
+    miopenOptimizerLAMB     = 3, /*!< Adam update with decoupled weight decay, scaled per tensor
+                                    by the trust ratio ||w|| / ||update|| */
+} miopenOptimizerMode_t;
+
+/*! @brief Applies one optimizer step to a list of parameter tensors
+ *
+ * All the tensors are updated in place by a few fused launches instead of one launch per tensor
+ * and operation. Each tensor is a packed buffer of elementCounts[i] elements.
+ *
+ * Parameters and gradients are of dataType, the optimizer states are always fp32 and have to be
+ * zero-initialized before the first step. expAvgs is used by all the modes but SGD, expAvgSqs by
+ * Adam and LAMB only; the unused arrays may be NULL.
+ *
+ * Supported datatypes are fp32, fp16 and bfp16
+ *
+ * @param handle        MIOpen handle (input)
+ * @param mode          Update rule (input)
+ * @param dataType      Data type of the parameters and gradients (input)
+ * @param tensorCount   Number of tensors (input)
+ * @param elementCounts Number of elements of each tensor, allocated on the host (input)
+ * @param params        Parameter tensors, array allocated on the host (input and output)
+ * @param grads         Gradient tensors, array allocated on the host (input)
+ * @param expAvgs       Momentum / first moment tensors, array allocated on the host
+ *                      (input and output)
+ * @param expAvgSqs     Second moment tensors, array allocated on the host (input and output)
+ * @param lr            Learning rate (input)
+ * @param beta1         Momentum factor or first moment decay (input)
+ * @param beta2         Second moment decay (input)
+ * @param eps           Term added to the denominator of Adam and LAMB (input)
+ * @param weightDecay   Weight decay factor (input)
+ * @param step          1-based index of the step, used by the Adam and LAMB bias corrections
+ *                      (input)
+ * @return              miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenMultiTensorOptimizerUpdate(miopenHandle_t handle,
+                                                              miopenOptimizerMode_t mode,
+                                                              miopenDataType_t dataType,
+                                                              int tensorCount,
+                                                              const size_t* elementCounts,
+                                                              void** params,
+                                                              const void* const* grads,
+                                                              void** expAvgs,
+                                                              void** expAvgSqs,
+                                                              float lr,
+                                                              float beta1,
+                                                              float beta2,
+                                                              float eps,
+                                                              float weightDecay,
+                                                              int step);
+
+/** @} */
+// CLOSEOUT optimizer DOXYGEN GROUP
+
+// Linear layer APIs
+/** @addtogroup linear
+ *
+ *  @{
+ */
+
+/*! @brief Runs a fully-connected layer, y = activ(x * w^T + b)
+ *
+ * x is a packed [M, K] tensor, w a packed [N, K] tensor and y a packed [M, N] tensor. The bias b
+ * has N elements and is added to every row of the product. The GEMM is followed by one pass over
+ * y applying both the bias and the activation, instead of one launch per op.
+ *
+ * bDesc and b may be NULL to skip the bias, activDesc may be NULL to skip the activation.
+ *
+ * Supported datatypes are fp32 and fp16
+ *
+ * @param handle     MIOpen handle (input)
+ * @param xDesc      Tensor descriptor of the input (input)
+ * @param x          Input data tensor (input)
+ * @param wDesc      Tensor descriptor of the weights (input)
+ * @param w          Weights tensor (input)
+ * @param bDesc      Tensor descriptor of the bias, or NULL (input)
+ * @param b          Bias tensor, or NULL (input)
+ * @param activDesc  Activation descriptor, or NULL (input)
+ * @param yDesc      Tensor descriptor of the output (input)
+ * @param y          Output data tensor (output)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenLinearForward(miopenHandle_t handle,
+                                                 const miopenTensorDescriptor_t xDesc,
+                                                 const void* x,
+                                                 const miopenTensorDescriptor_t wDesc,
+                                                 const void* w,
+                                                 const miopenTensorDescriptor_t bDesc,
+                                                 const void* b,
+                                                 const miopenActivationDescriptor_t activDesc,
+                                                 const miopenTensorDescriptor_t yDesc,
+                                                 void* y);
+
+/** @} */
+// CLOSEOUT linear DOXYGEN GROUP
+
+// GEMM APIs
+/** @addtogroup gemm
+ *
+ *  @{
+ */
+
+/*! @brief Computes C = alpha * op(A) * op(B) + beta * C
+ *
+ * The matrices are row-major: op(A) is m x k, op(B) is k x n and C is m x n, where op(X) is X, or
+ * its transpose if transX is set. lda, ldb and ldc are the distances between the rows of A, B and
+ * C in elements.
+ *
+ * The GEMM goes through the same backend selection as the GEMMs of the convolutions, so it follows
+ * MIOPEN_GEMM_ENFORCE_BACKEND and the GEMM tuning records of the user database.
+ *
+ * Supported datatypes are fp32, fp16 and bfp16. A, B and C are all of dataType; alpha and beta are
+ * applied in fp32.
+ *
+ * @param handle     MIOpen handle (input)
+ * @param dataType   Data type of the matrices (input)
+ * @param transA     Whether A is transposed (input)
+ * @param transB     Whether B is transposed (input)
+ * @param m          Number of rows of op(A) and C (input)
+ * @param n          Number of columns of op(B) and C (input)
+ * @param k          Number of columns of op(A) and rows of op(B) (input)
+ * @param alpha      Scale of the product (input)
+ * @param A          Matrix A (input)
+ * @param lda        Leading dimension of A (input)
+ * @param B          Matrix B (input)
+ * @param ldb        Leading dimension of B (input)
+ * @param beta       Scale of the initial C (input)
+ * @param C          Matrix C (input/output)
+ * @param ldc        Leading dimension of C (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGemm(miopenHandle_t handle,
+                                        miopenDataType_t dataType,
+                                        bool transA,
+                                        bool transB,
+                                        int m,
+                                        int n,
+                                        int k,
+                                        float alpha,
+                                        const void* A,
+                                        int lda,
+                                        const void* B,
+                                        int ldb,
+                                        float beta,
+                                        void* C,
+                                        int ldc);
+
+/*! @brief Computes batchCount independent GEMMs of the same size, see miopenGemm()
+ *
+ * The matrices of problem i start strideA * i, strideB * i and strideC * i elements after A, B and
+ * C respectively. All the problems run in a single launch.
+ *
+ * @param handle     MIOpen handle (input)
+ * @param dataType   Data type of the matrices (input)
+ * @param transA     Whether the A matrices are transposed (input)
+ * @param transB     Whether the B matrices are transposed (input)
+ * @param m          Number of rows of op(A) and C (input)
+ * @param n          Number of columns of op(B) and C (input)
+ * @param k          Number of columns of op(A) and rows of op(B) (input)
+ * @param alpha      Scale of the products (input)
+ * @param A          First A matrix (input)
+ * @param lda        Leading dimension of the A matrices (input)
+ * @param strideA    Distance between the A matrices in elements (input)
+ * @param B          First B matrix (input)
+ * @param ldb        Leading dimension of the B matrices (input)
+ * @param strideB    Distance between the B matrices in elements (input)
+ * @param beta       Scale of the initial C matrices (input)
+ * @param C          First C matrix (input/output)
+ * @param ldc        Leading dimension of the C matrices (input)
+ * @param strideC    Distance between the C matrices in elements (input)
+ * @param batchCount Number of problems (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGemmStridedBatched(miopenHandle_t handle,
+                                                      miopenDataType_t dataType,
+                                                      bool transA,
+                                                      bool transB,
+                                                      int m,
+                                                      int n,
+                                                      int k,
+                                                      float alpha,
+                                                      const void* A,
+                                                      int lda,
+                                                      long long strideA,
+                                                      const void* B,
+                                                      int ldb,
+                                                      long long strideB,
+                                                      float beta,
+                                                      void* C,
+                                                      int ldc,
+                                                      long long strideC,
+                                                      int batchCount);
+
+/** @} */
+// CLOSEOUT gemm DOXYGEN GROUP
+
+// Graph APIs
+/** @addtogroup graph
+ *
+ *  @{
+ */
+
+/*! @ingroup graph
+ * @brief Sequence of layers recorded once and run with a single call, see miopenCreateGraph
+ */
+MIOPEN_DECLARE_OBJECT(miopenGraph);
+
+/*! @brief Creates an empty graph
+ *
+ *   A graph records the layers of a network as nodes which read and write tensors of the graph.
+ * Once compiled with miopenCompileGraph, the whole graph runs with one miopenRunGraph call:
+ * the chains of nodes a fusion plan supports run as one kernel (convolution followed by a per
+ * channel bias add, an activation and a pooling; batch norm inference followed by an
+ * activation), the other convolutions are bound to their solutions as convolution plans, and the
+ * tensors only passed between nodes share memory when they are never alive at the same time.
+ *
+ *   The nodes run in the order they are added, so a node may only read the tensors written by
+ * the nodes added before it, or external tensors. Every tensor is written by one node at most.
+ * All the nodes compute with alpha = 1 and beta = 0.
+ *
+ * @param graph      Pointer to the created graph (output)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenCreateGraph(miopenGraph_t* graph);
+
+/*! @brief Destroys a graph and the device memory it holds
+ *
+ * @param graph      Graph to destroy (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenDestroyGraph(miopenGraph_t graph);
+
+/*! @brief Adds a tensor to a graph
+ *
+ *   External tensors are the inputs, outputs and parameters of the network, their buffers are
+ * given to every miopenRunGraph call. The other tensors only pass data between the nodes and
+ * are allocated by the graph. The descriptor is copied.
+ *
+ * @param graph      Graph (input)
+ * @param desc       Tensor descriptor (input)
+ * @param external   Whether the buffer is given by the application (input)
+ * @param tensor     ID of the tensor in the graph (output)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGraphAddTensor(miopenGraph_t graph,
+                                                  const miopenTensorDescriptor_t desc,
+                                                  bool external,
+                                                  int* tensor);
+
+/*! @brief Adds a forward convolution y = conv(x, w) to a graph
+ *
+ * @param graph      Graph (input)
+ * @param convDesc   Convolution descriptor, copied (input)
+ * @param x          ID of the input tensor (input)
+ * @param w          ID of the weights tensor (input)
+ * @param y          ID of the output tensor (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGraphAddConvolutionForward(
+    miopenGraph_t graph, const miopenConvolutionDescriptor_t convDesc, int x, int w, int y);
+
+/*! @brief Adds a forward activation y = activ(x) to a graph
+ *
+ * @param graph      Graph (input)
+ * @param activDesc  Activation descriptor, copied (input)
+ * @param x          ID of the input tensor (input)
+ * @param y          ID of the output tensor (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGraphAddActivationForward(
+    miopenGraph_t graph, const miopenActivationDescriptor_t activDesc, int x, int y);
+
+/*! @brief Adds a batch normalization in inference mode to a graph
+ *
+ *   See miopenBatchNormalizationForwardInference. The scale, bias, mean and variance tensors
+ * share the descriptor of the scale tensor.
+ *
+ * @param graph      Graph (input)
+ * @param bn_mode    Batch normalization mode (input)
+ * @param epsilon    Value added to the variance (input)
+ * @param x          ID of the input tensor (input)
+ * @param scale      ID of the scale tensor (input)
+ * @param bias       ID of the bias tensor (input)
+ * @param mean       ID of the estimated mean tensor (input)
+ * @param variance   ID of the estimated variance tensor (input)
+ * @param y          ID of the output tensor (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGraphAddBatchNormInference(miopenGraph_t graph,
+                                                              miopenBatchNormMode_t bn_mode,
+                                                              double epsilon,
+                                                              int x,
+                                                              int scale,
+                                                              int bias,
+                                                              int mean,
+                                                              int variance,
+                                                              int y);
+
+/*! @brief Adds a forward pooling y = pool(x) to a graph
+ *
+ *   No indices are saved, so the graph is meant for inference.
+ *
+ * @param graph      Graph (input)
+ * @param poolDesc   Pooling descriptor, copied (input)
+ * @param x          ID of the input tensor (input)
+ * @param y          ID of the output tensor (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGraphAddPoolingForward(
+    miopenGraph_t graph, const miopenPoolingDescriptor_t poolDesc, int x, int y);
+
+/*! @brief Adds a tensor operation c = a op b to a graph, see miopenOpTensor
+ *
+ * @param graph      Graph (input)
+ * @param tensorOp   Operation (input)
+ * @param a          ID of the first operand (input)
+ * @param b          ID of the second operand (input)
+ * @param c          ID of the result (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenGraphAddOpTensor(miopenGraph_t graph, miopenTensorOp_t tensorOp, int a, int b, int c);
+
+/*! @brief Compiles a graph for a handle
+ *
+ *   Fuses the nodes, selects the solutions of the convolutions, compiles all the kernels and
+ * allocates the internal tensors and the workspace. Adding tensors or nodes afterwards requires
+ * compiling again.
+ *
+ * @param handle     MIOpen handle (input)
+ * @param graph      Graph (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenCompileGraph(miopenHandle_t handle, miopenGraph_t graph);
+
+/*! @brief Query the device memory held by a compiled graph
+ *
+ * @param graph      Compiled graph (input)
+ * @param size       Bytes of the internal tensors and the workspace (output)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGraphGetDeviceMemorySize(const miopenGraph_t graph,
+                                                            size_t* size);
+
+/*! @brief Runs a compiled graph
+ *
+ *   Every external tensor read or written by the nodes shall be given a buffer. A graph shall
+ * not be run by several threads at the same time.
+ *
+ * @param handle     MIOpen handle the graph was compiled with (input)
+ * @param graph      Compiled graph (input)
+ * @param count      Number of the external tensors given (input)
+ * @param tensors    IDs of the external tensors (input)
+ * @param buffers    Buffers of the external tensors, in the order of tensors (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenRunGraph(miopenHandle_t handle,
+                                            miopenGraph_t graph,
+                                            int count,
+                                            const int* tensors,
+                                            void* const* buffers);
+
+/** @} */
+// CLOSEOUT graph DOXYGEN GROUP
+
+// Layer normalization APIs
+/** @addtogroup layernorm
+ *
+ *  @{
+ */
+
+/*! @brief Layer normalization forward
+ *
+ * Normalizes every row of x, where a row is made of the dimensions from normalized_dim on, and
+ * the rows are the dimensions before it: y = (x - mean) / sqrt(var + epsilon) * weight + bias.
+ * The mean and the biased variance of a row are computed in a single pass (Welford) and the
+ * normalization and the affine transform are applied by the same kernel.
+ *
+ * x and y are packed tensors of the same lengths. weight and bias are packed tensors described
+ * by weightDesc, with as many elements as a row. mean and rstd (the inverse standard deviation)
+ * are packed tensors described by meanDesc with one element per row. Their data type is the data
+ * type of x, or fp32 for fp16 x. Statistics are always accumulated in fp32.
+ *
+ * weightDesc, weight and bias may be NULL to skip the affine transform, meanDesc, mean and rstd
+ * may be NULL when the statistics are not needed, e.g. for inference.
+ *
+ * Supported datatypes are fp32 and fp16
+ *
+ * @param handle         MIOpen handle (input)
+ * @param xDesc          Tensor descriptor of the input (input)
+ * @param x              Input data tensor (input)
+ * @param weightDesc     Tensor descriptor of weight and bias, or NULL (input)
+ * @param weight         Scale of the normalized rows, or NULL (input)
+ * @param bias           Shift of the normalized rows, or NULL (input)
+ * @param epsilon        Added to the variance (input)
+ * @param normalized_dim First dimension of a row, 0 < normalized_dim < number of dimensions
+ * (input)
+ * @param yDesc          Tensor descriptor of the output (input)
+ * @param y              Output data tensor (output)
+ * @param meanDesc       Tensor descriptor of mean and rstd, or NULL (input)
+ * @param mean           Mean of every row, or NULL (output)
+ * @param rstd           Inverse standard deviation of every row, or NULL (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenLayerNormForward(miopenHandle_t handle,
+                                                    const miopenTensorDescriptor_t xDesc,
+                                                    const void* x,
+                                                    const miopenTensorDescriptor_t weightDesc,
+                                                    const void* weight,
+                                                    const void* bias,
+                                                    float epsilon,
+                                                    int normalized_dim,
+                                                    const miopenTensorDescriptor_t yDesc,
+                                                    void* y,
+                                                    const miopenTensorDescriptor_t meanDesc,
+                                                    void* mean,
+                                                    void* rstd);
+
+/*! @brief Layer normalization backward
+ *
+ * Computes dx from dy and from the mean and rstd saved by miopenLayerNormForward. dx takes one
+ * kernel with one work-group per row. When dweight and dbias are given, a second kernel sums
+ * dy * (x - mean) * rstd and dy over the rows into them.
+ *
+ * The tensors are described as for miopenLayerNormForward. weightDesc, weight, dweight and dbias
+ * may be NULL when the forward pass had no affine transform. dweight and dbias are given or
+ * omitted together.
+ *
+ * Supported datatypes are fp32 and fp16
+ *
+ * @param handle         MIOpen handle (input)
+ * @param xDesc          Tensor descriptor of the forward input (input)
+ * @param x              Forward input data tensor (input)
+ * @param dyDesc         Tensor descriptor of the output gradient (input)
+ * @param dy             Output gradient tensor (input)
+ * @param weightDesc     Tensor descriptor of weight, dweight and dbias, or NULL (input)
+ * @param weight         Scale of the normalized rows, or NULL (input)
+ * @param meanDesc       Tensor descriptor of mean and rstd (input)
+ * @param mean           Mean of every row saved by the forward pass (input)
+ * @param rstd           Inverse standard deviation of every row saved by the forward pass
+ * (input)
+ * @param normalized_dim First dimension of a row (input)
+ * @param dxDesc         Tensor descriptor of the input gradient (input)
+ * @param dx             Input gradient tensor (output)
+ * @param dweight        Gradient of weight, or NULL (output)
+ * @param dbias          Gradient of bias, or NULL (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenLayerNormBackward(miopenHandle_t handle,
+                                                     const miopenTensorDescriptor_t xDesc,
+                                                     const void* x,
+                                                     const miopenTensorDescriptor_t dyDesc,
+                                                     const void* dy,
+                                                     const miopenTensorDescriptor_t weightDesc,
+                                                     const void* weight,
+                                                     const miopenTensorDescriptor_t meanDesc,
+                                                     const void* mean,
+                                                     const void* rstd,
+                                                     int normalized_dim,
+                                                     const miopenTensorDescriptor_t dxDesc,
+                                                     void* dx,
+                                                     void* dweight,
+                                                     void* dbias);
+
+/** @} */
+// CLOSEOUT layernorm DOXYGEN GROUP
+
+// Attention APIs
+/** @addtogroup attention
+ *
+ *  @{
+ */
+
+/*! @brief Scaled dot-product attention forward, o = softmax(scale * q * k^T) * v
+ *
+ * q and o are packed [batch, ..., seq_q, d] tensors, k and v packed [batch, ..., seq_kv, d]
+ * tensors with the same leading dimensions, e.g. the batch and the heads. The seq_q x seq_kv
+ * score matrix is not stored: the keys and values are streamed in tiles and the softmax of every
+ * query row is computed online in fp32. With causal set, query i only attends to the keys
+ * j <= i.
+ *
+ * lse receives the fp32 log-sum-exp of every row of the scaled scores, which
+ * miopenAttentionBackward needs. lseDesc describes a packed fp32 tensor with one element per
+ * query. lseDesc and lse may be NULL for inference.
+ *
+ * Supported datatypes are fp32, fp16 and bfp16, with d up to 128
+ *
+ * @param handle   MIOpen handle (input)
+ * @param qDesc    Tensor descriptor of the queries (input)
+ * @param q        Queries (input)
+ * @param kDesc    Tensor descriptor of the keys (input)
+ * @param k        Keys (input)
+ * @param vDesc    Tensor descriptor of the values (input)
+ * @param v        Values (input)
+ * @param scale    Scale of the scores, usually 1 / sqrt(d) (input)
+ * @param causal   Masks the keys after the query (input)
+ * @param oDesc    Tensor descriptor of the output (input)
+ * @param o        Output (output)
+ * @param lseDesc  Tensor descriptor of the log-sum-exp, or NULL (input)
+ * @param lse      Log-sum-exp of every query row, or NULL (output)
+ * @return         miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenAttentionForward(miopenHandle_t handle,
+                                                    const miopenTensorDescriptor_t qDesc,
+                                                    const void* q,
+                                                    const miopenTensorDescriptor_t kDesc,
+                                                    const void* k,
+                                                    const miopenTensorDescriptor_t vDesc,
+                                                    const void* v,
+                                                    float scale,
+                                                    bool causal,
+                                                    const miopenTensorDescriptor_t oDesc,
+                                                    void* o,
+                                                    const miopenTensorDescriptor_t lseDesc,
+                                                    void* lse);
+
+/*! @brief Scaled dot-product attention backward
+ *
+ * Computes dq, dk and dv from the output gradient dO. The probabilities are recomputed from the
+ * log-sum-exp saved by miopenAttentionForward, so the score matrix is not stored here either.
+ * dq is accumulated by one kernel over the keys, dk and dv by a second one over the queries;
+ * no atomics are used, so the results are deterministic.
+ *
+ * dq, dk and dv are described by qDesc, kDesc and vDesc, and dO by oDesc. scale and causal
+ * should be those of the forward pass.
+ *
+ * @param handle   MIOpen handle (input)
+ * @param qDesc    Tensor descriptor of the queries and of dq (input)
+ * @param q        Queries (input)
+ * @param kDesc    Tensor descriptor of the keys and of dk (input)
+ * @param k        Keys (input)
+ * @param vDesc    Tensor descriptor of the values and of dv (input)
+ * @param v        Values (input)
+ * @param oDesc    Tensor descriptor of the forward output and of dO (input)
+ * @param o        Forward output (input)
+ * @param dO       Output gradient (input)
+ * @param lseDesc  Tensor descriptor of the log-sum-exp (input)
+ * @param lse      Log-sum-exp saved by the forward pass (input)
+ * @param scale    Scale of the scores (input)
+ * @param causal   Masks the keys after the query (input)
+ * @param dq       Gradient of the queries (output)
+ * @param dk       Gradient of the keys (output)
+ * @param dv       Gradient of the values (output)
+ * @return         miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenAttentionBackward(miopenHandle_t handle,
+                                                     const miopenTensorDescriptor_t qDesc,
+                                                     const void* q,
+                                                     const miopenTensorDescriptor_t kDesc,
+                                                     const void* k,
+                                                     const miopenTensorDescriptor_t vDesc,
+                                                     const void* v,
+                                                     const miopenTensorDescriptor_t oDesc,
+                                                     const void* o,
+                                                     const void* dO,
+                                                     const miopenTensorDescriptor_t lseDesc,
+                                                     const void* lse,
+                                                     float scale,
+                                                     bool causal,
+                                                     void* dq,
+                                                     void* dk,
+                                                     void* dv);
+
+/** @} */
+// CLOSEOUT attention DOXYGEN GROUP
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,346 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/miopen.h>
+#include <miopen/convolution.hpp>
+#include <miopen/find_db.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/interned_string.hpp>
+#include <miopen/invoker_cache.hpp>
+#include <miopen/kernel.hpp>
+#include <miopen/kernel_cache.hpp>
+#include <miopen/problem_description.hpp>
+#include <miopen/readonlyramdb.hpp>
+#include <miopen/sqlite_db.hpp>
+#include <miopen/temp_file.hpp>
+#include <miopen/tensor.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/// Microbenchmarks of the host code on the hot paths of the library, where the host overhead of
+/// small problems is spent: the perf-db lookups (text db in RAM and SQLite), the invoker and
+/// kernel cache lookups, the construction of problem descriptions with their network configs,
+/// Find answered from the find-db (with the validation of the record) and the dispatch of
+/// immediate mode. The dbs and caches hold --keys entries which are looked up in turn. Every
+/// benchmark runs --iterations operations after a warm-up and prints the mean time of one.
+///
+/// speedtest_host_paths --bench all --iterations 100000 --keys 1000
+
+namespace miopen {
+namespace host_paths {
+
+// Keeps the results of the timed operations alive in release builds.
+static volatile std::size_t dead_code_saver = 0;
+
+inline void Keep(std::size_t value) { dead_code_saver = dead_code_saver + value; }
+
+template <class F>
+double MeasureNs(int iterations, const F& f)
+{
+    f(0);
+    const auto start = std::chrono::steady_clock::now();
+    for(auto i = 0; i < iterations; ++i)
+        f(i);
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start)
+               .count() /
+           iterations;
+}
+
+inline void Report(const std::string& name, double ns)
+{
+    std::cout << name << ": " << ns << " ns per operation" << std::endl;
+}
+
+/// A 1x1 convolution whose channel count varies with i, so every i gives a distinct network
+/// config.
+struct ConvProblem
+{
+    explicit ConvProblem(int i = 0)
+        : x(miopenFloat, {1, std::size_t(8 + i), 8, 8}),
+          w(miopenFloat, {8, std::size_t(8 + i), 1, 1}),
+          conv({0, 0}, {1, 1}, {1, 1}),
+          y(conv.GetForwardOutputTensor(x, w, miopenFloat))
+    {
+    }
+
+    ProblemDescription Describe() const
+    {
+        return {x, w, y, conv, conv::Direction::Forward};
+    }
+
+    TensorDescriptor x;
+    TensorDescriptor w;
+    ConvolutionDescriptor conv;
+    TensorDescriptor y;
+};
+
+struct BenchValues
+{
+    int value = 0;
+    void Serialize(std::ostream& stream) const { stream << value; }
+};
+
+struct HostPathsSpeedTest : public test_driver
+{
+    HostPathsSpeedTest()
+    {
+        add(bench, "bench");
+        add(iterations, "iterations");
+        add(keys, "keys");
+    }
+
+    void run()
+    {
+        iterations = std::max(iterations, 1);
+        keys       = std::max(keys, 1);
+
+        const auto all = bench == "all";
+        auto found     = false;
+        for(const auto& b : benchmarks())
+        {
+            if(!all && bench != b.first)
+                continue;
+            (this->*b.second)();
+            found = true;
+        }
+        if(!found)
+        {
+            std::cerr << "Unknown benchmark." << std::endl;
+            std::exit(-1);
+        }
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Permitted benchmarks: all";
+        for(const auto& b : benchmarks())
+            std::cout << ", " << b.first;
+        std::cout << std::endl;
+    }
+
+    private:
+    std::string bench = "all";
+    int iterations    = 100000;
+    int keys          = 1000;
+
+    using Benchmark = void (HostPathsSpeedTest::*)() const;
+
+    static const std::vector<std::pair<std::string, Benchmark>>& benchmarks()
+    {
+        static const std::vector<std::pair<std::string, Benchmark>> list = {
+            {"ramdb", &HostPathsSpeedTest::RamDb},
+            {"sqlite", &HostPathsSpeedTest::SQLite},
+            {"invoker_cache", &HostPathsSpeedTest::InvokerCacheLookup},
+            {"kernel_cache", &HostPathsSpeedTest::KernelCacheLookup},
+            {"problem", &HostPathsSpeedTest::Problem},
+            {"find_db", &HostPathsSpeedTest::FindDbHit},
+            {"immediate", &HostPathsSpeedTest::Immediate},
+        };
+        return list;
+    }
+
+    std::vector<std::string> MakeKeys(const std::string& prefix) const
+    {
+        std::vector<std::string> ret;
+        for(auto i = 0; i < keys; ++i)
+            ret.push_back(prefix + std::to_string(i));
+        return ret;
+    }
+
+    void RamDb() const
+    {
+        const TempFile file{"miopen.speedtest.ramdb"};
+        const auto db_keys = MakeKeys("1-8-8-8-1x1-8-8-8-1-0x0-1x1-1x1-0-NCHW-FP32-F_");
+        {
+            std::ofstream db_file{file.Path()};
+            for(auto i = 0; i < keys; ++i)
+                db_file << db_keys[i] << "=ConvOclDirectFwd1x1:" << i << ";ConvAsm1x1U:" << i
+                        << ",1,1,1\n";
+        }
+
+        const auto& db = ReadonlyRamDb::GetCached(file.Path(), false);
+        Report("ReadonlyRamDb::FindRecord", MeasureNs(iterations, [&](int i) {
+                   Keep(db.FindRecord(db_keys[i % keys]).is_initialized());
+               }));
+    }
+
+    void SQLite() const
+    {
+#if MIOPEN_ENABLE_SQLITE
+        const TempFile file{"miopen.speedtest.sqlite"};
+        SQLitePerfDb db(file.Path(), false, "gfx906", 64);
+        std::vector<ProblemDescription> problems;
+        for(auto i = 0; i < keys; ++i)
+        {
+            problems.push_back(ConvProblem{i}.Describe());
+            db.Update(problems.back(), "ConvOclDirectFwd1x1", BenchValues{i});
+        }
+
+        Report("SQLitePerfDb::FindRecord", MeasureNs(iterations, [&](int i) {
+                   Keep(db.FindRecord(problems[i % keys]).is_initialized());
+               }));
+#else
+        std::cout << "SQLitePerfDb::FindRecord: skipped, MIOpen is built without SQLite"
+                  << std::endl;
+#endif
+    }
+
+    void InvokerCacheLookup() const
+    {
+        InvokerCache cache;
+        const auto configs = MakeKeys("1-8-8-8-1x1-8-8-8-1-0x0-1x1-1x1-0-NCHW-FP32-F_");
+        const auto solver  = InternedString{"ConvOclDirectFwd1x1"};
+        std::vector<InvokerCache::Key> cache_keys;
+        for(const auto& config : configs)
+        {
+            cache_keys.emplace_back(InternedString{config}, solver);
+            cache.Register(cache_keys.back(), [](const Handle&, const AnyInvokeParams&) {});
+        }
+
+        Report("InvokerCache lookup", MeasureNs(iterations, [&](int i) {
+                   Keep(cache[cache_keys[i % keys]].is_initialized());
+               }));
+        // The network config of a call is a string, which is looked up in the pool first.
+        Report("InvokerCache lookup from the config string", MeasureNs(iterations, [&](int i) {
+                   const InvokerCache::Key key{InternedString::TryGet(configs[i % keys]), solver};
+                   Keep(cache[key].is_initialized());
+               }));
+    }
+
+    void KernelCacheLookup() const
+    {
+        KernelCache cache;
+        const auto configs = MakeKeys("1-8-8-8-1x1-8-8-8-1-0x0-1x1-1x1-0-NCHW-FP32-F_");
+        for(const auto& config : configs)
+            cache.AddKernel({"ConvOclDirectFwd1x1", config}, Kernel{}, 0);
+
+        Report("KernelCache::GetKernels", MeasureNs(iterations, [&](int i) {
+                   Keep(cache.GetKernels("ConvOclDirectFwd1x1", configs[i % keys]).size());
+               }));
+    }
+
+    void Problem() const
+    {
+        std::vector<ConvProblem> problems;
+        for(auto i = 0; i < keys; ++i)
+            problems.emplace_back(i);
+
+        Report("ProblemDescription construction", MeasureNs(iterations, [&](int i) {
+                   Keep(problems[i % keys].Describe().n_inputs);
+               }));
+        Report("ProblemDescription and network config", MeasureNs(iterations, [&](int i) {
+                   Keep(problems[i % keys].Describe().BuildConfKey().ToString().size());
+               }));
+    }
+
+    void FindDbHit() const
+    {
+        auto&& handle = get_handle();
+        const TempFile file{"miopen.speedtest.find_db"};
+        testing_find_db_path_override() = file.Path();
+
+        ConvProblem problem;
+        const auto x = handle.Create<float>(problem.x.GetElementSpace());
+        const auto w = handle.Create<float>(problem.w.GetElementSpace());
+        const auto y = handle.Create<float>(problem.y.GetElementSpace());
+
+        // The first call runs the search and fills the find-db, the timed ones are answered by the
+        // record, validated against the kernel and invoker caches.
+        Report("Find from the find-db", MeasureNs(std::max(iterations / 100, 1), [&](int) {
+                   auto count = 0;
+                   miopenConvAlgoPerf_t perf;
+                   problem.conv.FindConvFwdAlgorithm(handle,
+                                                     problem.x,
+                                                     x.get(),
+                                                     problem.w,
+                                                     w.get(),
+                                                     problem.y,
+                                                     y.get(),
+                                                     1,
+                                                     &count,
+                                                     &perf,
+                                                     nullptr,
+                                                     0,
+                                                     false);
+                   Keep(count);
+               }));
+
+        testing_find_db_path_override() = boost::none;
+    }
+
+    void Immediate() const
+    {
+        auto&& handle = get_handle();
+        ConvProblem problem;
+        const auto x = handle.Create<float>(problem.x.GetElementSpace());
+        const auto w = handle.Create<float>(problem.w.GetElementSpace());
+        const auto y = handle.Create<float>(problem.y.GetElementSpace());
+
+        auto count    = std::size_t{0};
+        auto solution = miopenConvSolution_t{};
+        STATUS(miopenConvolutionForwardGetSolution(
+            &handle, &problem.w, &problem.x, &problem.conv, &problem.y, 1, &count, &solution));
+        EXPECT(count == 1);
+        STATUS(miopenConvolutionForwardCompileSolution(
+            &handle, &problem.w, &problem.x, &problem.conv, &problem.y, solution.solution_id));
+        const auto workspace = handle.Create(std::max<std::size_t>(solution.workspace_size, 1));
+
+        // The kernels of the tiny problem are queued behind each other; the time is the host
+        // time of a call as long as the queue does not fill up.
+        const auto immediate_iterations = std::max(iterations / 10, 1);
+        handle.Finish();
+        Report("miopenConvolutionForwardImmediate", MeasureNs(immediate_iterations, [&](int) {
+                   miopenConvolutionForwardImmediate(&handle,
+                                                     &problem.w,
+                                                     w.get(),
+                                                     &problem.x,
+                                                     x.get(),
+                                                     &problem.conv,
+                                                     &problem.y,
+                                                     y.get(),
+                                                     workspace.get(),
+                                                     solution.workspace_size,
+                                                     solution.solution_id);
+               }));
+        handle.Finish();
+    }
+};
+
+} // namespace host_paths
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::host_paths::HostPathsSpeedTest>(argc, argv);
+    return 0;
+}
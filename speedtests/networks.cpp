@@ -0,0 +1,936 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/miopen.h>
+#include <miopen/activ.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/manage_ptr.hpp>
+#include <miopen/pooling.hpp>
+#include <miopen/tensor.hpp>
+
+#include <driver.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// End-to-end benchmarks of the layer sequences of standard models, run through the public API
+/// with the immediate mode of convolutions. Every layer owns its buffers, so the layers are
+/// independent and the times of each are measured apart, with the stream synchronized around
+/// them. Fully connected layers and the GEMMs of BERT are run as 1x1 convolutions, the way
+/// the frameworks map them onto MIOpen. Residual additions and attention score GEMMs are not
+/// included.
+///
+/// speedtest_networks --network resnet50 --mode train --batch 32 --iterations 10 --json r.json
+
+namespace miopen {
+namespace network {
+
+using Lens = std::vector<std::size_t>;
+
+enum class Mode
+{
+    Forward,  // Inference
+    Backward, // Backward data and weights only, the forward pass running once untimed
+    Training, // Training forward and backward
+    Unknown,
+};
+
+struct RunContext
+{
+    Handle& handle;
+    Data_t workspace;
+    std::size_t workspace_size;
+};
+
+inline Allocator::ManageDataPtr Allocate(Handle& handle, std::size_t elements)
+{
+    // Constant non-zero data, as uninitialized memory may hold denormals.
+    return handle.Write(std::vector<float>(std::max<std::size_t>(elements, 1), 0.01f));
+}
+
+inline Allocator::ManageDataPtr Allocate(Handle& handle, const TensorDescriptor& desc)
+{
+    return Allocate(handle, desc.GetElementSpace());
+}
+
+struct Layer
+{
+    Layer(std::string name_, std::string op_) : name(std::move(name_)), op(std::move(op_)) {}
+    virtual ~Layer() = default;
+    Layer(const Layer&) = delete;
+    Layer& operator=(const Layer&) = delete;
+
+    std::string name;
+    std::string op;
+    double forward_ms  = 0;
+    double backward_ms = 0;
+
+    /// Allocates the buffers, compiles the kernels and returns the workspace size.
+    virtual std::size_t Prepare(Handle& handle, Mode mode) = 0;
+    virtual void Forward(const RunContext& ctx, bool training) = 0;
+    virtual void Backward(const RunContext& ctx) = 0;
+};
+
+static const float alpha = 1.0f;
+static const float beta  = 0.0f;
+
+struct ConvLayer : Layer
+{
+    ConvLayer(std::string name_,
+              const Lens& in,
+              std::size_t k,
+              int filter,
+              int stride,
+              int pad,
+              int groups,
+              bool needs_dx_)
+        : Layer(std::move(name_), "conv"),
+          x_desc(miopenFloat, in),
+          w_desc(miopenFloat, {k, in[1] / groups, std::size_t(filter), std::size_t(filter)}),
+          conv({pad, pad}, {stride, stride}, {1, 1}, {0, 0}, groups),
+          y_desc(conv.GetForwardOutputTensor(x_desc, w_desc, miopenFloat)),
+          needs_dx(needs_dx_)
+    {
+    }
+
+    Lens GetOutput() const { return y_desc.GetLengths(); }
+
+    std::size_t Prepare(Handle& handle, Mode mode) override
+    {
+        x = Allocate(handle, x_desc);
+        w = Allocate(handle, w_desc);
+        y = Allocate(handle, y_desc);
+
+        auto workspace = std::size_t{0};
+        auto count     = std::size_t{0};
+        auto solution  = miopenConvSolution_t{};
+
+        STATUS(miopenConvolutionForwardGetSolution(
+            &handle, &w_desc, &x_desc, &conv, &y_desc, 1, &count, &solution));
+        EXPECT(count == 1);
+        fwd_solution = solution.solution_id;
+        workspace    = std::max(workspace, solution.workspace_size);
+        STATUS(miopenConvolutionForwardCompileSolution(
+            &handle, &w_desc, &x_desc, &conv, &y_desc, fwd_solution));
+
+        if(mode == Mode::Forward)
+            return workspace;
+
+        dw = Allocate(handle, w_desc);
+        dy = Allocate(handle, y_desc);
+
+        if(needs_dx)
+        {
+            dx = Allocate(handle, x_desc);
+            STATUS(miopenConvolutionBackwardDataGetSolution(
+                &handle, &y_desc, &w_desc, &conv, &x_desc, 1, &count, &solution));
+            EXPECT(count == 1);
+            bwd_solution = solution.solution_id;
+            workspace    = std::max(workspace, solution.workspace_size);
+            STATUS(miopenConvolutionBackwardDataCompileSolution(
+                &handle, &y_desc, &w_desc, &conv, &x_desc, bwd_solution));
+        }
+
+        STATUS(miopenConvolutionBackwardWeightsGetSolution(
+            &handle, &y_desc, &x_desc, &conv, &w_desc, 1, &count, &solution));
+        EXPECT(count == 1);
+        wrw_solution = solution.solution_id;
+        workspace    = std::max(workspace, solution.workspace_size);
+        STATUS(miopenConvolutionBackwardWeightsCompileSolution(
+            &handle, &y_desc, &x_desc, &conv, &w_desc, wrw_solution));
+        return workspace;
+    }
+
+    void Forward(const RunContext& ctx, bool) override
+    {
+        STATUS(miopenConvolutionForwardImmediate(&ctx.handle,
+                                                 &w_desc,
+                                                 w.get(),
+                                                 &x_desc,
+                                                 x.get(),
+                                                 &conv,
+                                                 &y_desc,
+                                                 y.get(),
+                                                 ctx.workspace,
+                                                 ctx.workspace_size,
+                                                 fwd_solution));
+    }
+
+    void Backward(const RunContext& ctx) override
+    {
+        if(needs_dx)
+        {
+            STATUS(miopenConvolutionBackwardDataImmediate(&ctx.handle,
+                                                          &y_desc,
+                                                          dy.get(),
+                                                          &w_desc,
+                                                          w.get(),
+                                                          &conv,
+                                                          &x_desc,
+                                                          dx.get(),
+                                                          ctx.workspace,
+                                                          ctx.workspace_size,
+                                                          bwd_solution));
+        }
+        STATUS(miopenConvolutionBackwardWeightsImmediate(&ctx.handle,
+                                                         &y_desc,
+                                                         dy.get(),
+                                                         &x_desc,
+                                                         x.get(),
+                                                         &conv,
+                                                         &w_desc,
+                                                         dw.get(),
+                                                         ctx.workspace,
+                                                         ctx.workspace_size,
+                                                         wrw_solution));
+    }
+
+    private:
+    TensorDescriptor x_desc;
+    TensorDescriptor w_desc;
+    ConvolutionDescriptor conv;
+    TensorDescriptor y_desc;
+    bool needs_dx;
+    uint64_t fwd_solution = 0;
+    uint64_t bwd_solution = 0;
+    uint64_t wrw_solution = 0;
+    Allocator::ManageDataPtr x, w, y, dx, dw, dy;
+};
+
+struct BatchNormLayer : Layer
+{
+    BatchNormLayer(std::string name_, const Lens& in)
+        : Layer(std::move(name_), "bnorm"),
+          x_desc(miopenFloat, in),
+          bn_desc(miopenFloat, {1, in[1], 1, 1})
+    {
+    }
+
+    std::size_t Prepare(Handle& handle, Mode mode) override
+    {
+        x             = Allocate(handle, x_desc);
+        y             = Allocate(handle, x_desc);
+        scale         = Allocate(handle, bn_desc);
+        bias          = Allocate(handle, bn_desc);
+        running_mean  = Allocate(handle, bn_desc);
+        running_var   = Allocate(handle, bn_desc);
+        saved_mean    = Allocate(handle, bn_desc);
+        saved_inv_var = Allocate(handle, bn_desc);
+        if(mode != Mode::Forward)
+        {
+            dx     = Allocate(handle, x_desc);
+            dy     = Allocate(handle, x_desc);
+            dscale = Allocate(handle, bn_desc);
+            dbias  = Allocate(handle, bn_desc);
+        }
+        return 0;
+    }
+
+    void Forward(const RunContext& ctx, bool training) override
+    {
+        auto a = alpha;
+        auto b = beta;
+        if(!training)
+        {
+            STATUS(miopenBatchNormalizationForwardInference(&ctx.handle,
+                                                            miopenBNSpatial,
+                                                            &a,
+                                                            &b,
+                                                            &x_desc,
+                                                            x.get(),
+                                                            &x_desc,
+                                                            y.get(),
+                                                            &bn_desc,
+                                                            scale.get(),
+                                                            bias.get(),
+                                                            running_mean.get(),
+                                                            running_var.get(),
+                                                            epsilon));
+            return;
+        }
+        STATUS(miopenBatchNormalizationForwardTraining(&ctx.handle,
+                                                       miopenBNSpatial,
+                                                       &a,
+                                                       &b,
+                                                       &x_desc,
+                                                       x.get(),
+                                                       &x_desc,
+                                                       y.get(),
+                                                       &bn_desc,
+                                                       scale.get(),
+                                                       bias.get(),
+                                                       0.1,
+                                                       running_mean.get(),
+                                                       running_var.get(),
+                                                       epsilon,
+                                                       saved_mean.get(),
+                                                       saved_inv_var.get()));
+    }
+
+    void Backward(const RunContext& ctx) override
+    {
+        STATUS(miopenBatchNormalizationBackward(&ctx.handle,
+                                                miopenBNSpatial,
+                                                &alpha,
+                                                &beta,
+                                                &alpha,
+                                                &beta,
+                                                &x_desc,
+                                                x.get(),
+                                                &x_desc,
+                                                dy.get(),
+                                                &x_desc,
+                                                dx.get(),
+                                                &bn_desc,
+                                                scale.get(),
+                                                dscale.get(),
+                                                dbias.get(),
+                                                epsilon,
+                                                saved_mean.get(),
+                                                saved_inv_var.get()));
+    }
+
+    private:
+    static constexpr double epsilon = 1e-5;
+    TensorDescriptor x_desc;
+    TensorDescriptor bn_desc;
+    Allocator::ManageDataPtr x, y, scale, bias, running_mean, running_var, saved_mean,
+        saved_inv_var, dx, dy, dscale, dbias;
+};
+
+struct ActivationLayer : Layer
+{
+    ActivationLayer(std::string name_, const Lens& in, miopenActivationMode_t mode, double clip)
+        : Layer(std::move(name_), "activ"), x_desc(miopenFloat, in), activ(mode, clip, 0, 1)
+    {
+    }
+
+    std::size_t Prepare(Handle& handle, Mode mode) override
+    {
+        x = Allocate(handle, x_desc);
+        y = Allocate(handle, x_desc);
+        if(mode != Mode::Forward)
+        {
+            dx = Allocate(handle, x_desc);
+            dy = Allocate(handle, x_desc);
+        }
+        return 0;
+    }
+
+    void Forward(const RunContext& ctx, bool) override
+    {
+        STATUS(miopenActivationForward(
+            &ctx.handle, &activ, &alpha, &x_desc, x.get(), &beta, &x_desc, y.get()));
+    }
+
+    void Backward(const RunContext& ctx) override
+    {
+        STATUS(miopenActivationBackward(&ctx.handle,
+                                        &activ,
+                                        &alpha,
+                                        &x_desc,
+                                        y.get(),
+                                        &x_desc,
+                                        dy.get(),
+                                        &x_desc,
+                                        x.get(),
+                                        &beta,
+                                        &x_desc,
+                                        dx.get()));
+    }
+
+    private:
+    TensorDescriptor x_desc;
+    ActivationDescriptor activ;
+    Allocator::ManageDataPtr x, y, dx, dy;
+};
+
+struct PoolingLayer : Layer
+{
+    PoolingLayer(std::string name_,
+                 const Lens& in,
+                 miopenPoolingMode_t mode,
+                 int window,
+                 int stride,
+                 int pad)
+        : Layer(std::move(name_), "pool"),
+          x_desc(miopenFloat, in),
+          pool(mode, miopenPaddingDefault, {window, window}, {stride, stride}, {pad, pad}),
+          y_desc(pool.GetForwardOutputTensor(x_desc))
+    {
+    }
+
+    Lens GetOutput() const { return y_desc.GetLengths(); }
+
+    std::size_t Prepare(Handle& handle, Mode mode) override
+    {
+        x = Allocate(handle, x_desc);
+        y = Allocate(handle, y_desc);
+        if(mode != Mode::Forward)
+        {
+            dx        = Allocate(handle, x_desc);
+            dy        = Allocate(handle, y_desc);
+            auto size = std::size_t{0};
+            STATUS(miopenPoolingGetWorkSpaceSizeV2(&pool, &y_desc, &size));
+            indices = handle.Create(std::max<std::size_t>(size, 1));
+        }
+        return 0;
+    }
+
+    void Forward(const RunContext& ctx, bool training) override
+    {
+        STATUS(miopenPoolingForward(&ctx.handle,
+                                    &pool,
+                                    &alpha,
+                                    &x_desc,
+                                    x.get(),
+                                    &beta,
+                                    &y_desc,
+                                    y.get(),
+                                    training,
+                                    training ? indices.get() : nullptr,
+                                    0));
+    }
+
+    void Backward(const RunContext& ctx) override
+    {
+        STATUS(miopenPoolingBackward(&ctx.handle,
+                                     &pool,
+                                     &alpha,
+                                     &y_desc,
+                                     y.get(),
+                                     &y_desc,
+                                     dy.get(),
+                                     &x_desc,
+                                     x.get(),
+                                     &beta,
+                                     &x_desc,
+                                     dx.get(),
+                                     indices.get()));
+    }
+
+    private:
+    TensorDescriptor x_desc;
+    PoolingDescriptor pool;
+    TensorDescriptor y_desc;
+    Allocator::ManageDataPtr x, y, dx, dy, indices;
+};
+
+using ManagedRNNDescriptor = MIOPEN_MANAGE_PTR(miopenRNNDescriptor_t, miopenDestroyRNNDescriptor);
+
+struct LstmLayer : Layer
+{
+    LstmLayer(std::string name_, int seq_len_, std::size_t batch, std::size_t input, int hidden)
+        : Layer(std::move(name_), "lstm"),
+          seq_len(seq_len_),
+          x_descs(seq_len, TensorDescriptor{miopenFloat, {batch, input}}),
+          y_descs(seq_len, TensorDescriptor{miopenFloat, {batch, std::size_t(hidden)}}),
+          h_desc(miopenFloat, {1, batch, std::size_t(hidden)})
+    {
+        miopenRNNDescriptor_t desc;
+        STATUS(miopenCreateRNNDescriptor(&desc));
+        rnn = ManagedRNNDescriptor{desc};
+        STATUS(miopenSetRNNDescriptor(rnn.get(),
+                                      hidden,
+                                      1,
+                                      miopenRNNlinear,
+                                      miopenRNNunidirection,
+                                      miopenLSTM,
+                                      miopenRNNwithBias,
+                                      miopenRNNdefault,
+                                      miopenFloat));
+        for(auto& desc_ : x_descs)
+            x_ptrs.push_back(&desc_);
+        for(auto& desc_ : y_descs)
+            y_ptrs.push_back(&desc_);
+    }
+
+    std::size_t Prepare(Handle& handle, Mode mode) override
+    {
+        auto weights_size = std::size_t{0};
+        STATUS(miopenGetRNNParamsSize(&handle, rnn.get(), x_ptrs[0], &weights_size, miopenFloat));
+        w_desc = TensorDescriptor{miopenFloat, {weights_size / sizeof(float)}};
+
+        auto workspace = std::size_t{0};
+        STATUS(miopenGetRNNWorkspaceSize(&handle, rnn.get(), seq_len, x_ptrs.data(), &workspace));
+        STATUS(miopenGetRNNTrainingReserveSize(
+            &handle, rnn.get(), seq_len, x_ptrs.data(), &reserve_size));
+
+        x       = Allocate(handle, seq_len * x_descs[0].GetElementSpace());
+        y       = Allocate(handle, seq_len * y_descs[0].GetElementSpace());
+        w       = Allocate(handle, w_desc);
+        reserve = handle.Create(std::max<std::size_t>(reserve_size, 1));
+        if(mode != Mode::Forward)
+        {
+            dx = Allocate(handle, seq_len * x_descs[0].GetElementSpace());
+            dy = Allocate(handle, seq_len * y_descs[0].GetElementSpace());
+            dw = Allocate(handle, w_desc);
+        }
+        return workspace;
+    }
+
+    // The initial and the final states are omitted, which the API treats as zeros and as not
+    // requested.
+    void Forward(const RunContext& ctx, bool training) override
+    {
+        if(!training)
+        {
+            STATUS(miopenRNNForwardInference(&ctx.handle,
+                                             rnn.get(),
+                                             seq_len,
+                                             x_ptrs.data(),
+                                             x.get(),
+                                             &h_desc,
+                                             nullptr,
+                                             &h_desc,
+                                             nullptr,
+                                             &w_desc,
+                                             w.get(),
+                                             y_ptrs.data(),
+                                             y.get(),
+                                             &h_desc,
+                                             nullptr,
+                                             &h_desc,
+                                             nullptr,
+                                             ctx.workspace,
+                                             ctx.workspace_size));
+            return;
+        }
+        STATUS(miopenRNNForwardTraining(&ctx.handle,
+                                        rnn.get(),
+                                        seq_len,
+                                        x_ptrs.data(),
+                                        x.get(),
+                                        &h_desc,
+                                        nullptr,
+                                        &h_desc,
+                                        nullptr,
+                                        &w_desc,
+                                        w.get(),
+                                        y_ptrs.data(),
+                                        y.get(),
+                                        &h_desc,
+                                        nullptr,
+                                        &h_desc,
+                                        nullptr,
+                                        ctx.workspace,
+                                        ctx.workspace_size,
+                                        reserve.get(),
+                                        reserve_size));
+    }
+
+    void Backward(const RunContext& ctx) override
+    {
+        STATUS(miopenRNNBackwardData(&ctx.handle,
+                                     rnn.get(),
+                                     seq_len,
+                                     y_ptrs.data(),
+                                     y.get(),
+                                     y_ptrs.data(),
+                                     dy.get(),
+                                     &h_desc,
+                                     nullptr,
+                                     &h_desc,
+                                     nullptr,
+                                     &w_desc,
+                                     w.get(),
+                                     &h_desc,
+                                     nullptr,
+                                     &h_desc,
+                                     nullptr,
+                                     x_ptrs.data(),
+                                     dx.get(),
+                                     &h_desc,
+                                     nullptr,
+                                     &h_desc,
+                                     nullptr,
+                                     ctx.workspace,
+                                     ctx.workspace_size,
+                                     reserve.get(),
+                                     reserve_size));
+        STATUS(miopenRNNBackwardWeights(&ctx.handle,
+                                        rnn.get(),
+                                        seq_len,
+                                        x_ptrs.data(),
+                                        x.get(),
+                                        &h_desc,
+                                        nullptr,
+                                        y_ptrs.data(),
+                                        y.get(),
+                                        &w_desc,
+                                        dw.get(),
+                                        ctx.workspace,
+                                        ctx.workspace_size,
+                                        reserve.get(),
+                                        reserve_size));
+    }
+
+    private:
+    int seq_len;
+    std::vector<TensorDescriptor> x_descs;
+    std::vector<TensorDescriptor> y_descs;
+    std::vector<miopenTensorDescriptor_t> x_ptrs;
+    std::vector<miopenTensorDescriptor_t> y_ptrs;
+    TensorDescriptor h_desc;
+    TensorDescriptor w_desc;
+    ManagedRNNDescriptor rnn;
+    std::size_t reserve_size = 0;
+    Allocator::ManageDataPtr x, y, w, dx, dy, dw, reserve;
+};
+
+/// Builds the layer sequence of a model, each function returning the output lengths of the
+/// layer it adds.
+struct Network
+{
+    std::vector<std::unique_ptr<Layer>> layers;
+
+    Lens Conv(const std::string& name,
+              const Lens& in,
+              std::size_t k,
+              int filter,
+              int stride = 1,
+              int pad    = 0,
+              int groups = 1)
+    {
+        // The data gradient of the first layer is not needed for training.
+        auto layer = std::make_unique<ConvLayer>(
+            name, in, k, filter, stride, pad, groups, !layers.empty());
+        auto out = layer->GetOutput();
+        layers.push_back(std::move(layer));
+        return out;
+    }
+
+    /// A fully connected layer, as a 1x1 convolution over rows x features.
+    Lens Dense(const std::string& name, std::size_t rows, std::size_t in, std::size_t out)
+    {
+        return Conv(name, {rows, in, 1, 1}, out, 1);
+    }
+
+    Lens BatchNorm(const std::string& name, const Lens& in)
+    {
+        layers.push_back(std::make_unique<BatchNormLayer>(name, in));
+        return in;
+    }
+
+    Lens Activation(const std::string& name,
+                    const Lens& in,
+                    miopenActivationMode_t mode = miopenActivationRELU,
+                    double clip                 = 0)
+    {
+        layers.push_back(std::make_unique<ActivationLayer>(name, in, mode, clip));
+        return in;
+    }
+
+    Lens Pool(const std::string& name,
+              const Lens& in,
+              miopenPoolingMode_t mode,
+              int window,
+              int stride,
+              int pad = 0)
+    {
+        auto layer = std::make_unique<PoolingLayer>(name, in, mode, window, stride, pad);
+        auto out   = layer->GetOutput();
+        layers.push_back(std::move(layer));
+        return out;
+    }
+
+    /// Convolution, batch normalization and activation; clip is that of ReLU6 or none.
+    Lens ConvBnAct(const std::string& name,
+                   const Lens& in,
+                   std::size_t k,
+                   int filter,
+                   int stride,
+                   int pad,
+                   int groups,
+                   bool activation,
+                   double clip = 0)
+    {
+        auto out = Conv(name, in, k, filter, stride, pad, groups);
+        out      = BatchNorm(name + ".bn", out);
+        if(!activation)
+            return out;
+        if(clip > 0)
+            return Activation(name + ".relu6", out, miopenActivationCLIPPEDRELU, clip);
+        return Activation(name + ".relu", out);
+    }
+};
+
+inline Network ResNet50(std::size_t batch)
+{
+    Network net;
+    auto x = net.ConvBnAct("conv1", {batch, 3, 224, 224}, 64, 7, 2, 3, 1, true);
+    x      = net.Pool("pool1", x, miopenPoolingMax, 3, 2, 1);
+
+    const std::size_t widths[] = {64, 128, 256, 512};
+    const int blocks[]         = {3, 4, 6, 3};
+    for(auto stage = 0; stage < 4; ++stage)
+    {
+        for(auto block = 0; block < blocks[stage]; ++block)
+        {
+            const auto name   = "layer" + std::to_string(stage + 1) + "." + std::to_string(block);
+            const auto width  = widths[stage];
+            const auto stride = (block == 0 && stage > 0) ? 2 : 1;
+            if(block == 0)
+                net.ConvBnAct(name + ".downsample", x, width * 4, 1, stride, 0, 1, false);
+            auto y = net.ConvBnAct(name + ".conv1", x, width, 1, 1, 0, 1, true);
+            y      = net.ConvBnAct(name + ".conv2", y, width, 3, stride, 1, 1, true);
+            y      = net.ConvBnAct(name + ".conv3", y, width * 4, 1, 1, 0, 1, false);
+            x      = net.Activation(name + ".relu", y);
+        }
+    }
+
+    x = net.Pool("avgpool", x, miopenPoolingAverage, 7, 1);
+    net.Dense("fc", batch, x[1], 1000);
+    return net;
+}
+
+inline Network MobileNetV2(std::size_t batch)
+{
+    Network net;
+    auto x = net.ConvBnAct("conv1", {batch, 3, 224, 224}, 32, 3, 2, 1, 1, true, 6);
+
+    struct Stage
+    {
+        std::size_t expansion;
+        std::size_t channels;
+        int blocks;
+        int stride;
+    };
+    const Stage stages[] = {{1, 16, 1, 1},
+                            {6, 24, 2, 2},
+                            {6, 32, 3, 2},
+                            {6, 64, 4, 2},
+                            {6, 96, 3, 1},
+                            {6, 160, 3, 2},
+                            {6, 320, 1, 1}};
+
+    auto index = 0;
+    for(const auto& stage : stages)
+    {
+        for(auto block = 0; block < stage.blocks; ++block)
+        {
+            const auto name   = "block" + std::to_string(index++);
+            const auto hidden = x[1] * stage.expansion;
+            const auto stride = block == 0 ? stage.stride : 1;
+            auto y            = x;
+            if(stage.expansion != 1)
+                y = net.ConvBnAct(name + ".expand", y, hidden, 1, 1, 0, 1, true, 6);
+            y = net.ConvBnAct(name + ".dw", y, hidden, 3, stride, 1, hidden, true, 6);
+            x = net.ConvBnAct(name + ".project", y, stage.channels, 1, 1, 0, 1, false);
+        }
+    }
+
+    x = net.ConvBnAct("conv2", x, 1280, 1, 1, 0, 1, true, 6);
+    x = net.Pool("avgpool", x, miopenPoolingAverage, 7, 1);
+    net.Dense("fc", batch, x[1], 1000);
+    return net;
+}
+
+/// The GEMMs of the BERT-base encoder: 12 layers, 768 hidden, 3072 intermediate, sequences of
+/// 128 tokens.
+inline Network BertEncoder(std::size_t batch)
+{
+    Network net;
+    const auto tokens = batch * 128;
+    for(auto layer = 0; layer < 12; ++layer)
+    {
+        const auto name = "layer" + std::to_string(layer);
+        net.Dense(name + ".qkv", tokens, 768, 3 * 768);
+        net.Dense(name + ".attention.out", tokens, 768, 768);
+        net.Dense(name + ".ffn1", tokens, 768, 3072);
+        net.Dense(name + ".ffn2", tokens, 3072, 768);
+    }
+    return net;
+}
+
+/// DeepSpeech: 3 fully connected layers with clipped ReLUs over 494 features per step (26 MFCC
+/// with a context of 9 steps on each side), an LSTM of 2048 cells and 2 more fully connected
+/// layers, on 100 steps.
+inline Network DeepSpeech(std::size_t batch)
+{
+    Network net;
+    const auto steps = 100;
+    const auto rows  = batch * steps;
+    auto x           = net.Dense("fc1", rows, 494, 2048);
+    x                = net.Activation("fc1.relu", x, miopenActivationCLIPPEDRELU, 20);
+    x                = net.Dense("fc2", rows, 2048, 2048);
+    x                = net.Activation("fc2.relu", x, miopenActivationCLIPPEDRELU, 20);
+    x                = net.Dense("fc3", rows, 2048, 2048);
+    x                = net.Activation("fc3.relu", x, miopenActivationCLIPPEDRELU, 20);
+    net.layers.push_back(std::make_unique<LstmLayer>("lstm", steps, batch, 2048, 2048));
+    x = net.Dense("fc5", rows, 2048, 2048);
+    x = net.Activation("fc5.relu", x, miopenActivationCLIPPEDRELU, 20);
+    net.Dense("fc6", rows, 2048, 29);
+    return net;
+}
+
+struct NetworkSpeedTest : public test_driver
+{
+    NetworkSpeedTest()
+    {
+        add(network_str, "network");
+        add(mode_str, "mode");
+        add(batch, "batch");
+        add(iterations, "iterations");
+        add(json, "json");
+    }
+
+    void run()
+    {
+        const auto mode = ParseMode(mode_str);
+        if(mode == Mode::Unknown)
+        {
+            std::cerr << "Unknown mode." << std::endl;
+            std::exit(-1);
+        }
+
+        auto net            = MakeNetwork(network_str, batch);
+        auto&& handle       = get_handle();
+        auto workspace_size = std::size_t{0};
+        for(auto& layer : net.layers)
+            workspace_size = std::max(workspace_size, layer->Prepare(handle, mode));
+        const auto workspace = handle.Create(std::max<std::size_t>(workspace_size, 1));
+        const auto ctx       = RunContext{handle, workspace.get(), workspace_size};
+
+        const auto timed = [&](double& total, const auto& f) {
+            handle.Finish();
+            const auto start = std::chrono::steady_clock::now();
+            f();
+            handle.Finish();
+            total += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() -
+                                                               start)
+                         .count();
+        };
+
+        // The first iteration is a warm-up, which also fills the buffers read by the backward
+        // pass.
+        for(auto iteration = 0; iteration <= iterations; ++iteration)
+        {
+            for(auto& layer : net.layers)
+            {
+                if(mode == Mode::Backward && iteration > 0)
+                    break;
+                auto forward_ms = 0.0;
+                timed(forward_ms, [&]() { layer->Forward(ctx, mode != Mode::Forward); });
+                if(iteration > 0)
+                    layer->forward_ms += forward_ms / iterations;
+            }
+            if(mode == Mode::Forward)
+                continue;
+            for(auto it = net.layers.rbegin(); it != net.layers.rend(); ++it)
+            {
+                auto backward_ms = 0.0;
+                timed(backward_ms, [&]() { (*it)->Backward(ctx); });
+                if(iteration > 0)
+                    (*it)->backward_ms += backward_ms / iterations;
+            }
+        }
+
+        Report(net);
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Permitted networks: resnet50, mobilenetv2, bert, deepspeech" << std::endl;
+        std::cout << "Permitted modes: fwd, bwd, train" << std::endl;
+    }
+
+    private:
+    std::string network_str = "resnet50";
+    std::string mode_str    = "fwd";
+    int batch               = 32;
+    int iterations          = 10;
+    std::string json;
+
+    static Mode ParseMode(const std::string& str)
+    {
+        if(str == "fwd")
+            return Mode::Forward;
+        if(str == "bwd")
+            return Mode::Backward;
+        if(str == "train")
+            return Mode::Training;
+        return Mode::Unknown;
+    }
+
+    static Network MakeNetwork(const std::string& str, std::size_t batch)
+    {
+        if(str == "resnet50")
+            return ResNet50(batch);
+        if(str == "mobilenetv2")
+            return MobileNetV2(batch);
+        if(str == "bert")
+            return BertEncoder(batch);
+        if(str == "deepspeech")
+            return DeepSpeech(batch);
+        std::cerr << "Unknown network." << std::endl;
+        std::exit(-1);
+    }
+
+    void Report(const Network& net) const
+    {
+        std::ostringstream ss;
+        ss << "{\n  \"network\": \"" << network_str << "\",\n  \"mode\": \"" << mode_str
+           << "\",\n  \"batch\": " << batch << ",\n  \"iterations\": " << iterations
+           << ",\n  \"layers\": [";
+        auto total = 0.0;
+        auto first = true;
+        for(const auto& layer : net.layers)
+        {
+            ss << (first ? "\n" : ",\n") << "    {\"name\": \"" << layer->name << "\", \"op\": \""
+               << layer->op << "\", \"forward_ms\": " << layer->forward_ms
+               << ", \"backward_ms\": " << layer->backward_ms << "}";
+            total += layer->forward_ms + layer->backward_ms;
+            first = false;
+        }
+        ss << "\n  ],\n  \"total_ms\": " << total << "\n}\n";
+
+        if(json.empty())
+        {
+            std::cout << ss.str();
+            return;
+        }
+        std::ofstream file{json};
+        file << ss.str();
+        std::cout << network_str << " " << mode_str << ": " << total << " ms per iteration"
+                  << std::endl;
+    }
+};
+
+} // namespace network
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::network::NetworkSpeedTest>(argc, argv);
+    return 0;
+}
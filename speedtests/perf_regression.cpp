@@ -0,0 +1,370 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/miopen.h>
+#include <miopen/convolution.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/manage_ptr.hpp>
+#include <miopen/solver_id.hpp>
+#include <miopen/tensor.hpp>
+
+#include <driver.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/// Performance regression check of the convolutions: runs a fixed set of problems in every
+/// direction and data type with the solution picked by the immediate mode, and compares the
+/// median kernel time of each one with the baseline stored for the device. A problem slower
+/// than its baseline by more than the tolerance is a regression, and the test fails.
+///
+/// speedtest_perf_regression --baselines <dir> [--tolerance 10] [--iterations 20] [--update]
+///
+/// The baselines are text files named after the device (the db basename, e.g. gfx906_60.txt),
+/// one problem per line: direction, data type, problem, solver and time in ms. --update
+/// rewrites the file of the device with the times measured.
+
+namespace miopen {
+namespace perf_regression {
+
+using Lens = std::vector<std::size_t>;
+
+struct Problem
+{
+    std::string name;
+    Lens in;
+    std::size_t k;
+    std::size_t filter;
+    int stride;
+    int pad;
+};
+
+// Layers of ResNet-50 and of the stem of the usual CNNs, batch 32.
+inline std::vector<Problem> GetProblems()
+{
+    return {
+        {"resnet_stem_7x7s2", {32, 3, 224, 224}, 64, 7, 2, 3},
+        {"resnet_3x3_64", {32, 64, 56, 56}, 64, 3, 1, 1},
+        {"resnet_1x1_256_64", {32, 256, 56, 56}, 64, 1, 1, 0},
+        {"resnet_3x3s2_128", {32, 128, 56, 56}, 128, 3, 2, 1},
+        {"resnet_1x1_1024_256", {32, 1024, 14, 14}, 256, 1, 1, 0},
+        {"resnet_3x3_512", {32, 512, 7, 7}, 512, 3, 1, 1},
+    };
+}
+
+enum class Direction
+{
+    Forward,
+    BackwardData,
+    BackwardWeights,
+};
+
+inline std::string ToString(Direction direction)
+{
+    switch(direction)
+    {
+    case Direction::Forward: return "fwd";
+    case Direction::BackwardData: return "bwd";
+    case Direction::BackwardWeights: return "wrw";
+    }
+    return "unknown";
+}
+
+inline std::string ToString(miopenDataType_t type)
+{
+    switch(type)
+    {
+    case miopenFloat: return "fp32";
+    case miopenHalf: return "fp16";
+    case miopenBFloat16: return "bfp16";
+    default: return "unknown";
+    }
+}
+
+struct Result
+{
+    std::string solver;
+    double time_ms = 0.0;
+};
+
+/// Keyed by the direction, the data type and the problem.
+using Results = std::map<std::string, Result>;
+
+inline std::string MakeKey(Direction direction, miopenDataType_t type, const std::string& name)
+{
+    return ToString(direction) + " " + ToString(type) + " " + name;
+}
+
+inline Results ReadBaselines(const std::string& filename)
+{
+    Results results;
+    std::ifstream file(filename);
+    std::string line;
+    while(std::getline(file, line))
+    {
+        if(line.empty() || line[0] == '#')
+            continue;
+        std::istringstream ss(line);
+        std::string direction, type, name;
+        Result result;
+        if(ss >> direction >> type >> name >> result.solver >> result.time_ms)
+            results[direction + " " + type + " " + name] = result;
+    }
+    return results;
+}
+
+inline bool WriteBaselines(const std::string& filename, const Results& results)
+{
+    std::ofstream file(filename);
+    if(!file)
+        return false;
+    file << "# direction data_type problem solver time_ms" << std::endl;
+    for(const auto& result : results)
+        file << result.first << " " << result.second.solver << " " << std::fixed
+             << std::setprecision(4) << result.second.time_ms << std::endl;
+    return true;
+}
+
+class ProblemRun
+{
+    public:
+    ProblemRun(Handle& handle_, const Problem& problem, miopenDataType_t type)
+        : handle(handle_),
+          x_desc(type, problem.in),
+          w_desc(type, {problem.k, problem.in[1], problem.filter, problem.filter}),
+          conv({problem.pad, problem.pad}, {problem.stride, problem.stride}, {1, 1}, {0, 0}),
+          y_desc(conv.GetForwardOutputTensor(x_desc, w_desc, type)),
+          x(Allocate(x_desc)),
+          w(Allocate(w_desc)),
+          y(Allocate(y_desc))
+    {
+    }
+
+    /// Fills the solver and the median kernel time, false if no solution applies or a run fails.
+    bool Run(Direction direction, int iterations, Result& result)
+    {
+        auto count    = std::size_t{0};
+        auto solution = miopenConvSolution_t{};
+        auto status   = miopenStatusSuccess;
+        switch(direction)
+        {
+        case Direction::Forward:
+            status = miopenConvolutionForwardGetSolution(
+                &handle, &w_desc, &x_desc, &conv, &y_desc, 1, &count, &solution);
+            break;
+        case Direction::BackwardData:
+            status = miopenConvolutionBackwardDataGetSolution(
+                &handle, &y_desc, &w_desc, &conv, &x_desc, 1, &count, &solution);
+            break;
+        case Direction::BackwardWeights:
+            status = miopenConvolutionBackwardWeightsGetSolution(
+                &handle, &y_desc, &x_desc, &conv, &w_desc, 1, &count, &solution);
+            break;
+        }
+        if(status != miopenStatusSuccess || count == 0)
+            return false;
+
+        const auto workspace = handle.Create(std::max<std::size_t>(solution.workspace_size, 1));
+        const auto run       = [&]() {
+            switch(direction)
+            {
+            case Direction::Forward:
+                return miopenConvolutionForwardImmediate(&handle,
+                                                         &w_desc,
+                                                         w.get(),
+                                                         &x_desc,
+                                                         x.get(),
+                                                         &conv,
+                                                         &y_desc,
+                                                         y.get(),
+                                                         workspace.get(),
+                                                         solution.workspace_size,
+                                                         solution.solution_id);
+            case Direction::BackwardData:
+                return miopenConvolutionBackwardDataImmediate(&handle,
+                                                              &y_desc,
+                                                              y.get(),
+                                                              &w_desc,
+                                                              w.get(),
+                                                              &conv,
+                                                              &x_desc,
+                                                              x.get(),
+                                                              workspace.get(),
+                                                              solution.workspace_size,
+                                                              solution.solution_id);
+            case Direction::BackwardWeights:
+                return miopenConvolutionBackwardWeightsImmediate(&handle,
+                                                                 &y_desc,
+                                                                 y.get(),
+                                                                 &x_desc,
+                                                                 x.get(),
+                                                                 &conv,
+                                                                 &w_desc,
+                                                                 w.get(),
+                                                                 workspace.get(),
+                                                                 solution.workspace_size,
+                                                                 solution.solution_id);
+            }
+            return miopenStatusNotImplemented;
+        };
+
+        // The first run compiles the kernels and is not timed.
+        if(run() != miopenStatusSuccess)
+            return false;
+
+        std::vector<double> times;
+        const AutoEnableProfiling profiling{handle};
+        for(auto i = 0; i < iterations; ++i)
+        {
+            if(run() != miopenStatusSuccess)
+                return false;
+            times.push_back(handle.GetKernelTime());
+        }
+        std::sort(times.begin(), times.end());
+        result.solver  = solver::Id{solution.solution_id}.ToString();
+        result.time_ms = times[times.size() / 2];
+        return true;
+    }
+
+    private:
+    Handle& handle;
+    TensorDescriptor x_desc;
+    TensorDescriptor w_desc;
+    ConvolutionDescriptor conv;
+    TensorDescriptor y_desc;
+    Allocator::ManageDataPtr x, w, y;
+
+    Allocator::ManageDataPtr Allocate(const TensorDescriptor& desc)
+    {
+        // Zeros, as uninitialized memory may hold denormals.
+        return handle.Write(std::vector<char>(
+            std::max<std::size_t>(desc.GetElementSpace() * GetTypeSize(desc.GetType()), 1), 0));
+    }
+};
+
+struct PerfRegressionTest : public test_driver
+{
+    PerfRegressionTest()
+    {
+        add(baselines, "baselines");
+        add(tolerance, "tolerance");
+        add(iterations, "iterations");
+        add(update, "update", flag());
+    }
+
+    void run()
+    {
+        auto&& handle       = get_handle();
+        const auto filename = baselines + "/" + handle.GetDbBasename() + ".txt";
+        const auto expected = ReadBaselines(filename);
+        if(expected.empty() && !update)
+            std::cout << "No baselines in " << filename << ", reporting only." << std::endl;
+
+        Results measured;
+        auto regressions = 0;
+        for(const auto type : {miopenFloat, miopenHalf, miopenBFloat16})
+        {
+            for(const auto& problem : GetProblems())
+            {
+                ProblemRun run{handle, problem, type};
+                for(const auto direction : {Direction::Forward,
+                                            Direction::BackwardData,
+                                            Direction::BackwardWeights})
+                {
+                    const auto key = MakeKey(direction, type, problem.name);
+                    Result result;
+                    if(!run.Run(direction, std::max(iterations, 1), result))
+                    {
+                        std::cout << key << ": no solution" << std::endl;
+                        continue;
+                    }
+                    measured[key] = result;
+                    if(!Report(key, result, expected))
+                        ++regressions;
+                }
+            }
+        }
+
+        if(update)
+        {
+            if(!WriteBaselines(filename, measured))
+            {
+                std::cerr << "Unable to write " << filename << std::endl;
+                std::exit(-1);
+            }
+            std::cout << "Baselines written to " << filename << std::endl;
+            return;
+        }
+        if(regressions > 0)
+        {
+            std::cerr << regressions << " performance regression(s) beyond " << tolerance << "%"
+                      << std::endl;
+            std::exit(-1);
+        }
+    }
+
+    private:
+    std::string baselines = ".";
+    double tolerance      = 10.0;
+    int iterations        = 20;
+    bool update           = false;
+
+    /// Prints the comparison with the baseline, returns false on a regression.
+    bool Report(const std::string& key, const Result& result, const Results& expected) const
+    {
+        std::cout << std::fixed << std::setprecision(4) << key << ": " << result.solver << " "
+                  << result.time_ms << " ms";
+        const auto baseline = expected.find(key);
+        if(baseline == expected.end())
+        {
+            std::cout << ", no baseline" << std::endl;
+            return true;
+        }
+        const auto change = 100.0 * (result.time_ms / baseline->second.time_ms - 1.0);
+        std::cout << ", baseline " << baseline->second.solver << " " << baseline->second.time_ms
+                  << " ms (" << std::showpos << std::setprecision(1) << change << std::noshowpos
+                  << "%)";
+        if(result.solver != baseline->second.solver)
+            std::cout << ", solver changed";
+        const auto regressed = change > tolerance;
+        std::cout << (regressed ? ", REGRESSION" : "") << std::endl;
+        return update || !regressed;
+    }
+};
+
+} // namespace perf_regression
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::perf_regression::PerfRegressionTest>(argc, argv);
+    return 0;
+}
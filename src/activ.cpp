@@ -51,6 +51,26 @@ double ActivationDescriptor::GetAlpha() const { return this->parms[0]; }
 double ActivationDescriptor::GetBeta() const { return this->parms[1]; }
 
 double ActivationDescriptor::GetGamma() const { return this->parms[2]; }
+
+bool ActivationDescriptor::IsBackwardFromOutputSupported() const
+{
+    switch(this->mode)
+    {
+    case miopenActivationPASTHRU:
+    case miopenActivationLOGISTIC:
+    case miopenActivationTANH:
+    case miopenActivationRELU:
+    case miopenActivationCLIPPEDRELU: return true;
+    // y has the sign of x only for non-negative alpha.
+    case miopenActivationLEAKYRELU:
+    case miopenActivationELU: return this->GetAlpha() >= 0;
+    case miopenActivationSOFTRELU:
+    case miopenActivationABS:
+    case miopenActivationPOWER: return false;
+    }
+    return false;
+}
+
 std::ostream& operator<<(std::ostream& stream, const ActivationDescriptor& x)
 {
     MIOPEN_LOG_ENUM(stream,
@@ -0,0 +1,135 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/attention.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/tensor.hpp>
+
+extern "C" miopenStatus_t miopenAttentionForward(miopenHandle_t handle,
+                                                 const miopenTensorDescriptor_t qDesc,
+                                                 const void* q,
+                                                 const miopenTensorDescriptor_t kDesc,
+                                                 const void* k,
+                                                 const miopenTensorDescriptor_t vDesc,
+                                                 const void* v,
+                                                 float scale,
+                                                 bool causal,
+                                                 const miopenTensorDescriptor_t oDesc,
+                                                 void* o,
+                                                 const miopenTensorDescriptor_t lseDesc,
+                                                 void* lse)
+{
+
+    MIOPEN_LOG_FUNCTION(handle,
+                        qDesc,
+                        q,
+                        kDesc,
+                        k,
+                        vDesc,
+                        v,
+                        scale,
+                        causal,
+                        oDesc,
+                        o,
+                        lseDesc,
+                        lse);
+    return miopen::try_([&] {
+        if((lseDesc == nullptr) != (lse == nullptr))
+            MIOPEN_THROW(miopenStatusBadParm, "The log-sum-exp and its descriptor go together");
+
+        miopen::AttentionForward(miopen::deref(handle),
+                                 miopen::deref(qDesc),
+                                 DataCast(q),
+                                 miopen::deref(kDesc),
+                                 DataCast(k),
+                                 miopen::deref(vDesc),
+                                 DataCast(v),
+                                 scale,
+                                 causal,
+                                 miopen::deref(oDesc),
+                                 DataCast(o),
+                                 lseDesc != nullptr ? &miopen::deref(lseDesc) : nullptr,
+                                 DataCast(lse));
+    });
+}
+
+extern "C" miopenStatus_t miopenAttentionBackward(miopenHandle_t handle,
+                                                  const miopenTensorDescriptor_t qDesc,
+                                                  const void* q,
+                                                  const miopenTensorDescriptor_t kDesc,
+                                                  const void* k,
+                                                  const miopenTensorDescriptor_t vDesc,
+                                                  const void* v,
+                                                  const miopenTensorDescriptor_t oDesc,
+                                                  const void* o,
+                                                  const void* dO,
+                                                  const miopenTensorDescriptor_t lseDesc,
+                                                  const void* lse,
+                                                  float scale,
+                                                  bool causal,
+                                                  void* dq,
+                                                  void* dk,
+                                                  void* dv)
+{
+
+    MIOPEN_LOG_FUNCTION(handle,
+                        qDesc,
+                        q,
+                        kDesc,
+                        k,
+                        vDesc,
+                        v,
+                        oDesc,
+                        o,
+                        dO,
+                        lseDesc,
+                        lse,
+                        scale,
+                        causal,
+                        dq,
+                        dk,
+                        dv);
+    return miopen::try_([&] {
+        miopen::AttentionBackward(miopen::deref(handle),
+                                  miopen::deref(qDesc),
+                                  DataCast(q),
+                                  miopen::deref(kDesc),
+                                  DataCast(k),
+                                  miopen::deref(vDesc),
+                                  DataCast(v),
+                                  miopen::deref(oDesc),
+                                  DataCast(o),
+                                  DataCast(dO),
+                                  miopen::deref(lseDesc),
+                                  DataCast(lse),
+                                  scale,
+                                  causal,
+                                  DataCast(dq),
+                                  DataCast(dk),
+                                  DataCast(dv));
+    });
+}
@@ -75,6 +75,13 @@ TensorDescriptor BuildReshaped4DTensorDescriptor(const miopen::TensorDescriptor&
     dims[3] = dims[4];
     dims.pop_back();
 
+    // A channel-last NDHWC tensor stays channel-last, as NHWC
+    if(tDesc.GetLayout("NCDHW") == "NDHWC")
+    {
+        const auto c = dims[1];
+        return {dataType, dims, std::vector<size_t>{dims[2] * dims[3] * c, 1, dims[3] * c, c}};
+    }
+
     return {dataType, dims};
 }
 
@@ -326,3 +326,93 @@ miopenBatchNormalizationBackward(miopenHandle_t handle,
             DataCast(savedInvVariance));
     });
 }
+
+extern "C" miopenStatus_t
+miopenBatchNormalizationBackwardFromOutput(miopenHandle_t handle,
+                                           miopenBatchNormMode_t bn_mode,
+                                           const void* alphaDataDiff,
+                                           const void* betaDataDiff,
+                                           const void* alphaParamDiff,
+                                           const void* betaParamDiff,
+                                           const miopenTensorDescriptor_t yDesc,
+                                           void* y,
+                                           const miopenTensorDescriptor_t dyDesc,
+                                           const void* dy,
+                                           const miopenTensorDescriptor_t dxDesc,
+                                           void* dx,
+                                           const miopenTensorDescriptor_t bnScaleBiasDiffDesc,
+                                           const void* bnScale,
+                                           const void* bnBias,
+                                           void* resultBnScaleDiff,
+                                           void* resultBnBiasDiff,
+                                           double epsilon,
+                                           const void* savedMean,
+                                           const void* savedInvVariance)
+{
+    // bfloat16 not supported for batchnorm operation
+    if(miopen::deref(yDesc).GetType() == miopenBFloat16 ||
+       miopen::deref(dyDesc).GetType() == miopenBFloat16 ||
+       miopen::deref(dxDesc).GetType() == miopenBFloat16)
+    {
+        return miopenStatusNotImplemented;
+    }
+
+    MIOPEN_LOG_FUNCTION(handle,
+                        bn_mode,
+                        yDesc,
+                        y,
+                        dyDesc,
+                        dy,
+                        dxDesc,
+                        dx,
+                        bnScaleBiasDiffDesc,
+                        bnScale,
+                        bnBias,
+                        resultBnScaleDiff,
+                        resultBnBiasDiff,
+                        epsilon,
+                        savedMean,
+                        savedInvVariance);
+    LogCmdBNorm(yDesc, bn_mode, nullptr, nullptr, savedMean, savedInvVariance, Backward);
+    // In case of NxCxDxHxW
+    int size{0};
+    miopenGetTensorDescriptorSize(yDesc, &size);
+    return miopen::try_([&] {
+        const auto reshaped = [&](const miopenTensorDescriptor_t desc) {
+            return (size == 5) ? miopen::BuildReshaped4DTensorDescriptor(miopen::deref(desc))
+                               : miopen::deref(desc);
+        };
+        if(savedMean == nullptr || savedInvVariance == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "The saved mean and inverse variance are required");
+
+        // y becomes x again, so the backward pass below is the regular one.
+        miopen::BatchNormRestoreInput(miopen::deref(handle),
+                                      bn_mode,
+                                      reshaped(yDesc),
+                                      DataCast(y),
+                                      reshaped(bnScaleBiasDiffDesc),
+                                      DataCast(bnScale),
+                                      DataCast(bnBias),
+                                      DataCast(savedMean),
+                                      DataCast(savedInvVariance));
+        miopen::BatchNormBackward(miopen::deref(handle),
+                                  bn_mode,
+                                  alphaDataDiff,
+                                  betaDataDiff,
+                                  alphaParamDiff,
+                                  betaParamDiff,
+                                  reshaped(yDesc),
+                                  DataCast(y),
+                                  reshaped(dyDesc),
+                                  DataCast(dy),
+                                  reshaped(dxDesc),
+                                  DataCast(dx),
+                                  reshaped(bnScaleBiasDiffDesc),
+                                  DataCast(bnScale),
+                                  DataCast(resultBnScaleDiff),
+                                  DataCast(resultBnBiasDiff),
+                                  epsilon,
+                                  DataCast(savedMean),
+                                  DataCast(savedInvVariance));
+    });
+}
@@ -37,13 +37,17 @@
 #include <miopen/kern_db.hpp>
 #include <miopen/db.hpp>
 #include <miopen/db_path.hpp>
+#include <miopen/load_file.hpp>
+#include <miopen/write_file.hpp>
 #include <boost/filesystem.hpp>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 
 namespace miopen {
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DISABLE_CACHE)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_CUSTOM_CACHE_DIR)
 
 static boost::filesystem::path ComputeSysCachePath()
 {
@@ -59,6 +63,9 @@ static boost::filesystem::path ComputeUserCachePath()
 {
 #ifdef MIOPEN_CACHE_DIR
     std::string cache_dir = MIOPEN_CACHE_DIR;
+    const auto custom     = GetStringEnv(MIOPEN_CUSTOM_CACHE_DIR{});
+    if(custom != nullptr && std::strlen(custom) > 0)
+        cache_dir = custom;
 
     std::string version =
         std::to_string(MIOPEN_VERSION_MAJOR) + "." + std::to_string(MIOPEN_VERSION_MINOR) + "." +
@@ -107,15 +114,19 @@ static bool IsCacheDisabled()
 
 #if MIOPEN_ENABLE_SQLITE_KERN_CACHE
 using KDb = DbTimer<MultiFileDb<KernDb, KernDb, false>>;
-KDb GetDb(const std::string& device, size_t num_cu)
+static boost::filesystem::path GetUserDbPath(const std::string& device, size_t num_cu)
 {
     static const auto user_dir = ComputeUserCachePath();
-    static const auto sys_dir  = ComputeSysCachePath();
-    boost::filesystem::path user_path =
-        user_dir / (Handle::GetDbBasename(device, num_cu) + ".ukdb");
-    boost::filesystem::path sys_path = sys_dir / (Handle::GetDbBasename(device, num_cu) + ".kdb");
     if(user_dir.empty())
-        user_path = user_dir;
+        return user_dir;
+    return user_dir / (Handle::GetDbBasename(device, num_cu) + ".ukdb");
+}
+
+KDb GetDb(const std::string& device, size_t num_cu)
+{
+    static const auto sys_dir = ComputeSysCachePath();
+    const auto user_path      = GetUserDbPath(device, num_cu);
+    auto sys_path             = sys_dir / (Handle::GetDbBasename(device, num_cu) + ".kdb");
     if(!boost::filesystem::exists(sys_path))
         sys_path = boost::filesystem::path{};
     return {sys_path.string(), user_path.string(), device, num_cu};
@@ -143,7 +154,7 @@ std::string LoadBinary(const std::string& device,
 
     auto db              = GetDb(device, num_cu);
     std::string filename = (is_kernel_str ? miopen::md5(name) : name) + ".o";
-    KernelConfig cfg{filename, args, ""};
+    KernelConfig cfg{filename, args, "", 0};
     MIOPEN_LOG_I2("Loading binary for: " << name << " ;args: " << args);
     auto record = db.FindRecord(cfg);
     if(record)
@@ -163,7 +174,8 @@ void SaveBinary(const std::string& hsaco,
                 const std::size_t num_cu,
                 const std::string& name,
                 const std::string& args,
-                bool is_kernel_str)
+                bool is_kernel_str,
+                float compile_time_ms)
 {
     if(miopen::IsCacheDisabled())
         return;
@@ -171,7 +183,7 @@ void SaveBinary(const std::string& hsaco,
     auto db = GetDb(device, num_cu);
 
     std::string filename = (is_kernel_str ? miopen::md5(name) : name) + ".o";
-    KernelConfig cfg{filename, args, hsaco};
+    KernelConfig cfg{filename, args, hsaco, static_cast<std::int64_t>(compile_time_ms)};
     MIOPEN_LOG_I2("Saving binary for: " << name << " ;args: " << args);
     db.StoreRecord(cfg);
 }
@@ -215,4 +227,64 @@ void SaveBinary(const boost::filesystem::path& binary_path,
     }
 }
 #endif
+
+std::string LoadBinaryBlob(const std::string& device,
+                           const std::size_t num_cu,
+                           const std::string& name,
+                           const std::string& args,
+                           bool is_kernel_str)
+{
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+    return LoadBinary(device, num_cu, name, args, is_kernel_str);
+#else
+    const auto path = LoadBinary(device, num_cu, name, args, is_kernel_str);
+    return path.empty() ? std::string{} : LoadFile(path);
+#endif
+}
+
+void SaveBinaryBlob(const std::string& blob,
+                    const std::string& device,
+                    const std::size_t num_cu,
+                    const std::string& name,
+                    const std::string& args,
+                    bool is_kernel_str)
+{
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+    SaveBinary(blob, device, num_cu, name, args, is_kernel_str);
+#else
+    (void)num_cu;
+    if(miopen::IsCacheDisabled())
+        return;
+    // SaveBinary() moves the file into the cache.
+    const auto path = GetCacheFile(device, name, args, is_kernel_str).parent_path() /
+                      boost::filesystem::unique_path("%%%%-%%%%-%%%%-%%%%.o");
+    boost::filesystem::create_directories(path.parent_path());
+    WriteFile(blob, path);
+    SaveBinary(path, device, name, args, is_kernel_str);
+#endif
+}
+
+std::size_t TrimBinaryCache(const std::string& device,
+                            const std::size_t num_cu,
+                            const std::size_t max_bytes,
+                            const miopenKernelCacheEvictPolicy_t policy)
+{
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+    const auto path = GetUserDbPath(device, num_cu);
+    if(path.empty() || !boost::filesystem::exists(path))
+        return 0;
+    auto db           = KernDb{path.string(), false, device, num_cu};
+    const auto result = db.Trim(max_bytes, policy);
+    MIOPEN_LOG_I("Removed " << result.removed_entries << " entries (" << result.removed_bytes
+                            << " bytes) from " << path.string());
+    return result.removed_bytes;
+#else
+    (void)device;
+    (void)num_cu;
+    (void)max_bytes;
+    (void)policy;
+    MIOPEN_THROW(miopenStatusNotImplemented,
+                 "Trimming the binary cache requires MIOPEN_ENABLE_SQLITE_KERN_CACHE");
+#endif
+}
 } // namespace miopen
@@ -0,0 +1,202 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/binary_db.hpp>
+#include <miopen/logger.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+namespace miopen {
+namespace binary_db {
+
+std::string GetPath(const std::string& text_path)
+{
+    auto path = boost::filesystem::path{text_path};
+    if(path.extension() == ".txt")
+        path.replace_extension();
+    return path.string() + ".bin";
+}
+
+std::size_t Compile(std::istream& text, std::ostream& binary, const std::string& source)
+{
+    struct Record
+    {
+        std::string key;
+        std::string contents;
+        std::uint32_t line;
+    };
+
+    auto records = std::vector<Record>{};
+    auto line    = std::string{};
+    auto n_line  = 0u;
+
+    while(std::getline(text, line))
+    {
+        ++n_line;
+
+        if(line.empty())
+            continue;
+
+        const auto key_size = line.find('=');
+        if(key_size == std::string::npos || key_size == 0)
+        {
+            MIOPEN_LOG_E("Ill-formed record: key not found: " << source << "#" << n_line);
+            continue;
+        }
+
+        records.push_back({line.substr(0, key_size), line.substr(key_size + 1), n_line});
+    }
+
+    std::stable_sort(records.begin(), records.end(), [](const Record& l, const Record& r) {
+        return l.key < r.key;
+    });
+    records.erase(std::unique(records.begin(),
+                              records.end(),
+                              [](const Record& l, const Record& r) { return l.key == r.key; }),
+                  records.end());
+
+    auto entries = std::vector<Entry>{};
+    auto strings = std::string{};
+    entries.reserve(records.size());
+
+    for(const auto& record : records)
+    {
+        auto entry            = Entry{};
+        entry.key_offset      = strings.size();
+        entry.key_size        = record.key.size();
+        entry.contents_offset = strings.size() + record.key.size();
+        entry.contents_size   = record.contents.size();
+        entry.line            = record.line;
+        entries.push_back(entry);
+        strings.append(record.key).append(record.contents);
+    }
+
+    auto header = Header{};
+    std::copy(std::begin(magic), std::end(magic), std::begin(header.magic));
+    header.version        = version;
+    header.count          = entries.size();
+    header.entries_offset = sizeof(Header);
+    header.strings_offset = header.entries_offset + entries.size() * sizeof(Entry);
+    header.strings_size   = strings.size();
+
+    binary.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    binary.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(Entry));
+    binary.write(strings.data(), strings.size());
+    return entries.size();
+}
+
+} // namespace binary_db
+
+std::shared_ptr<const MappedDb> MappedDb::Open(const std::string& path)
+{
+    namespace bip = boost::interprocess;
+
+    if(!boost::filesystem::exists(path))
+        return nullptr;
+
+    auto db = std::shared_ptr<MappedDb>{new MappedDb{}};
+
+    try
+    {
+        const auto file = bip::file_mapping{path.c_str(), bip::read_only};
+        db->region      = std::make_unique<bip::mapped_region>(file, bip::read_only);
+    }
+    catch(const bip::interprocess_exception& ex)
+    {
+        MIOPEN_LOG_W("Unable to map " << path << ": " << ex.what());
+        return nullptr;
+    }
+
+    const auto base = static_cast<const char*>(db->region->get_address());
+    const auto size = db->region->get_size();
+
+    if(size < sizeof(binary_db::Header))
+    {
+        MIOPEN_LOG_W("Binary db is truncated: " << path);
+        return nullptr;
+    }
+
+    db->header         = reinterpret_cast<const binary_db::Header*>(base);
+    const auto& header = *db->header;
+
+    if(std::memcmp(header.magic, binary_db::magic, sizeof(binary_db::magic)) != 0 ||
+       header.version != binary_db::version)
+    {
+        MIOPEN_LOG_W("Not a binary db or unsupported version: " << path);
+        return nullptr;
+    }
+
+    const auto entries_end =
+        header.entries_offset + static_cast<std::uint64_t>(header.count) * sizeof(binary_db::Entry);
+    if(header.entries_offset < sizeof(binary_db::Header) || entries_end > header.strings_offset ||
+       header.strings_offset + header.strings_size > size)
+    {
+        MIOPEN_LOG_W("Binary db is corrupt: " << path);
+        return nullptr;
+    }
+
+    db->entries = reinterpret_cast<const binary_db::Entry*>(base + header.entries_offset);
+    db->strings = base + header.strings_offset;
+    MIOPEN_LOG_I2("Mapped " << header.count << " records from " << path);
+    return db;
+}
+
+MappedDb::~MappedDb() = default;
+
+boost::optional<MappedDb::Item> MappedDb::Find(const std::string& key) const
+{
+    const auto compare = [&](const binary_db::Entry& entry, const std::string& value) {
+        const auto common = std::min<std::size_t>(entry.key_size, value.size());
+        const auto result = std::memcmp(strings + entry.key_offset, value.data(), common);
+        return result < 0 || (result == 0 && entry.key_size < value.size());
+    };
+
+    const auto end   = entries + header->count;
+    const auto found = std::lower_bound(entries, end, key, compare);
+
+    if(found == end || found->key_size != key.size() ||
+       std::memcmp(strings + found->key_offset, key.data(), key.size()) != 0)
+        return boost::none;
+
+    if(found->contents_offset + found->contents_size > header->strings_size)
+    {
+        MIOPEN_LOG_E("Binary db record is out of bounds under the key: " << key);
+        return boost::none;
+    }
+
+    return Item{static_cast<int>(found->line),
+                std::string(strings + found->contents_offset, found->contents_size)};
+}
+
+} // namespace miopen
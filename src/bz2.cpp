@@ -25,8 +25,101 @@
 *******************************************************************************/
 
 #include <miopen/bz2.hpp>
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+
+#if MIOPEN_USE_ZSTD
+#include <zstd.h>
+#endif
+
+#include <cstring>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_KERNEL_CACHE_CODEC)
 
 namespace miopen {
+
+namespace {
+
+// Blobs start with a zstd frame magic number (0xFD2FB528, little-endian).
+const char zstd_magic[] = {'\x28', '\xB5', '\x2F', '\xFD'};
+
+bool IsZstd(const std::string& s)
+{
+    return s.size() >= sizeof(zstd_magic) &&
+           std::memcmp(s.data(), zstd_magic, sizeof(zstd_magic)) == 0;
+}
+
+std::string compress_bz2(std::string s, bool* compressed)
+{
+    std::string result = s;
+    unsigned int len   = result.size();
+    auto e             = BZ2_bzBuffToBuffCompress(&result[0], &len, &s[0], s.size(), 9, 0, 30);
+    if(compressed != nullptr and e == BZ_OUTBUFF_FULL)
+    {
+        *compressed = false;
+        return s;
+    }
+    check_bz2_error(e, "BZ2_bzBuffToBuffCompress");
+    result.resize(len);
+    if(compressed != nullptr)
+        *compressed = true;
+    return result;
+}
+
+#if MIOPEN_USE_ZSTD
+std::string compress_zstd(std::string s, bool* compressed)
+{
+    if(s.empty())
+        throw std::runtime_error("ZSTD_compress failed: nothing to compress");
+    // Same as for bzip2, the result must be smaller than the input.
+    std::string result(s.size(), 0);
+    const auto len = ZSTD_compress(&result[0], result.size(), s.data(), s.size(), 3);
+    if(ZSTD_isError(len) != 0u)
+    {
+        if(compressed != nullptr && ZSTD_getErrorCode(len) == ZSTD_error_dstSize_tooSmall)
+        {
+            *compressed = false;
+            return s;
+        }
+        throw std::runtime_error(std::string("ZSTD_compress failed: ") + ZSTD_getErrorName(len));
+    }
+    result.resize(len);
+    if(compressed != nullptr)
+        *compressed = true;
+    return result;
+}
+
+std::string decompress_zstd(const std::string& s, unsigned int size)
+{
+    std::string result(size, 0);
+    const auto len = ZSTD_decompress(&result[0], result.size(), s.data(), s.size());
+    if(ZSTD_isError(len) != 0u)
+        throw std::runtime_error(std::string("ZSTD_decompress failed: ") +
+                                 ZSTD_getErrorName(len));
+    result.resize(len);
+    return result;
+}
+#endif
+
+} // namespace
+
+Codec DefaultCodec()
+{
+#if MIOPEN_USE_ZSTD
+    static const auto codec = []() {
+        const auto env = GetStringEnv(MIOPEN_DEBUG_KERNEL_CACHE_CODEC{});
+        if(env == nullptr || std::strcmp(env, "zstd") == 0)
+            return Codec::Zstd;
+        if(std::strcmp(env, "bzip2") != 0)
+            MIOPEN_LOG_W("Unknown MIOPEN_DEBUG_KERNEL_CACHE_CODEC: " << env << ", using bzip2");
+        return Codec::Bzip2;
+    }();
+    return codec;
+#else
+    return Codec::Bzip2;
+#endif
+}
+
 void check_bz2_error(int e, const std::string& name)
 {
     if(e == BZ_OK)
@@ -51,23 +144,35 @@ void check_bz2_error(int e, const std::string& name)
 
 std::string compress(std::string s, bool* compressed)
 {
-    std::string result = s;
-    unsigned int len   = result.size();
-    auto e             = BZ2_bzBuffToBuffCompress(&result[0], &len, &s[0], s.size(), 9, 0, 30);
-    if(compressed != nullptr and e == BZ_OUTBUFF_FULL)
+    return compress_with(std::move(s), DefaultCodec(), compressed);
+}
+
+std::string compress_with(std::string s, Codec codec, bool* compressed)
+{
+    switch(codec)
     {
-        *compressed = false;
-        return s;
+    case Codec::Zstd:
+#if MIOPEN_USE_ZSTD
+        return compress_zstd(std::move(s), compressed);
+#else
+        throw std::runtime_error("compress failed: MIOpen is built without zstd");
+#endif
+    case Codec::Bzip2: break;
     }
-    check_bz2_error(e, "BZ2_bzBuffToBuffCompress");
-    result.resize(len);
-    if(compressed != nullptr)
-        *compressed = true;
-    return result;
+    return compress_bz2(std::move(s), compressed);
 }
 
 std::string decompress(std::string s, unsigned int size)
 {
+    if(IsZstd(s))
+    {
+#if MIOPEN_USE_ZSTD
+        return decompress_zstd(s, size);
+#else
+        throw std::runtime_error("decompress failed: MIOpen is built without zstd");
+#endif
+    }
+
     std::string result(size, 0);
     unsigned int len = result.size();
     auto e           = BZ2_bzBuffToBuffDecompress(&result[0], &len, &s[0], s.size(), 0, 0);
@@ -0,0 +1,138 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/cache_stats.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DUMP_CACHE_STATS)
+
+namespace miopen {
+namespace cache_stats {
+
+namespace {
+
+constexpr std::size_t cache_count = miopenCacheBinary + 1;
+
+struct Counters
+{
+    std::atomic<std::uint64_t> hits{0};
+    std::atomic<std::uint64_t> misses{0};
+    std::atomic<std::uint64_t> hit_ns{0};
+    std::atomic<std::uint64_t> miss_ns{0};
+};
+
+std::array<Counters, cache_count>& GetCounters()
+{
+    // Never destroyed, so the lookups of the static destructors are counted as well.
+    static auto* const counters = new std::array<Counters, cache_count>{};
+    return *counters;
+}
+
+Counters& GetCounters(miopenCacheType_t cache)
+{
+    const auto index = static_cast<std::size_t>(cache);
+    if(index >= cache_count)
+        MIOPEN_THROW(miopenStatusBadParm, "Unknown cache: " + std::to_string(index));
+    return GetCounters()[index];
+}
+
+const char* ToCString(miopenCacheType_t cache)
+{
+    switch(cache)
+    {
+    case miopenCacheFindDb: return "find-db";
+    case miopenCacheSystemFindDb: return "system find-db";
+    case miopenCachePerfDb: return "perf-db";
+    case miopenCachePrograms: return "programs";
+    case miopenCacheInvokers: return "invokers";
+    case miopenCacheBinary: return "binary cache";
+    }
+    return "<unknown>";
+}
+
+struct Dump
+{
+    ~Dump()
+    {
+        if(!miopen::IsEnabled(MIOPEN_DUMP_CACHE_STATS{}))
+            return;
+        std::cerr << "MIOpen cache statistics (hits / misses, hit time / miss time, ms):\n";
+        for(std::size_t i = 0; i < cache_count; ++i)
+        {
+            const auto cache = static_cast<miopenCacheType_t>(i);
+            const auto stats = Get(cache);
+            std::cerr << std::setw(16) << ToCString(cache) << ": " << stats.hits << " / "
+                      << stats.misses << ", " << stats.hitTimeMs << " / " << stats.missTimeMs
+                      << '\n';
+        }
+    }
+};
+
+const Dump dump{};
+
+} // namespace
+
+void Record(miopenCacheType_t cache, bool hit, std::chrono::steady_clock::duration time)
+{
+    auto& counters = GetCounters(cache);
+    const auto ns  = std::chrono::duration_cast<std::chrono::nanoseconds>(time).count();
+    (hit ? counters.hits : counters.misses).fetch_add(1, std::memory_order_relaxed);
+    (hit ? counters.hit_ns : counters.miss_ns).fetch_add(ns, std::memory_order_relaxed);
+}
+
+miopenCacheStatistics_t Get(miopenCacheType_t cache)
+{
+    const auto& counters = GetCounters(cache);
+    auto stats           = miopenCacheStatistics_t{};
+    stats.hits           = counters.hits.load(std::memory_order_relaxed);
+    stats.misses         = counters.misses.load(std::memory_order_relaxed);
+    stats.hitTimeMs      = counters.hit_ns.load(std::memory_order_relaxed) * 1e-6f;
+    stats.missTimeMs     = counters.miss_ns.load(std::memory_order_relaxed) * 1e-6f;
+    return stats;
+}
+
+void Reset()
+{
+    for(auto& counters : GetCounters())
+    {
+        counters.hits    = 0;
+        counters.misses  = 0;
+        counters.hit_ns  = 0;
+        counters.miss_ns = 0;
+    }
+}
+
+} // namespace cache_stats
+} // namespace miopen
@@ -0,0 +1,114 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/call_record.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/tensor.hpp>
+
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+/// Path of the file to record the API call stream to.
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_RECORD_FILE)
+
+/// Save the input tensors of the recorded convolutions into <record file>.<index>.bin.
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_RECORD_TENSORS)
+
+namespace miopen {
+namespace call_record {
+
+namespace {
+
+struct Record
+{
+    std::mutex mutex;
+    std::ofstream file;
+    std::size_t tensors = 0;
+};
+
+// Leaked, as the calls may be made from the destructors of other statics. Every line is
+// flushed, so nothing is lost at exit.
+Record& GetRecord()
+{
+    static auto& record = *[] {
+        auto ret = new Record{};
+        ret->file.open(GetStringEnv(MIOPEN_RECORD_FILE{}), std::ios::out | std::ios::trunc);
+        if(!ret->file)
+            MIOPEN_LOG_E("Unable to open the record file " << GetStringEnv(MIOPEN_RECORD_FILE{}));
+        ret->file << "# MIOpen API call record, replay with: MIOpenDriver replay <file>"
+                  << std::endl;
+        return ret;
+    }();
+    return record;
+}
+
+} // namespace
+
+bool IsEnabled()
+{
+    static const bool enabled = [] {
+        const auto path = GetStringEnv(MIOPEN_RECORD_FILE{});
+        return path != nullptr && *path != '\0';
+    }();
+    return enabled;
+}
+
+bool IsSavingTensors() { return IsEnabled() && miopen::IsEnabled(MIOPEN_RECORD_TENSORS{}); }
+
+void Add(const std::string& cmd)
+{
+    auto& record = GetRecord();
+    std::lock_guard<std::mutex> lock{record.mutex};
+    record.file << "MIOpenDriver " << cmd << std::endl;
+}
+
+std::string SaveTensor(const Handle& handle, const TensorDescriptor& desc, ConstData_t data)
+{
+    auto& record = GetRecord();
+    auto index   = std::size_t{0};
+    {
+        std::lock_guard<std::mutex> lock{record.mutex};
+        index = record.tensors++;
+    }
+
+    const auto path =
+        std::string{GetStringEnv(MIOPEN_RECORD_FILE{})} + "." + std::to_string(index) + ".bin";
+    auto contents = std::vector<char>(desc.GetElementSpace() * GetTypeSize(desc.GetType()));
+    handle.ReadTo(contents.data(), data, contents.size());
+
+    std::ofstream file{path, std::ios::binary};
+    file.write(contents.data(), contents.size());
+    if(!file)
+        MIOPEN_THROW("Unable to write the recorded tensor " + path);
+    return path;
+}
+
+} // namespace call_record
+} // namespace miopen
@@ -31,9 +31,14 @@
 #include <miopen/tensor.hpp>
 #include <miopen/datatype.hpp>
 
+#include <algorithm>
+
 namespace miopen {
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_CHECK_NUMERICS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_CHECK_NUMERICS_SAMPLE_PERIOD)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_CHECK_NUMERICS_ELEMENT_STRIDE)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_CHECK_NUMERICS_REPORT_INTERVAL)
 
 bool CheckNumericsEnabled(const int bitMask)
 {
@@ -53,23 +58,70 @@ struct CheckNumericsResult
     int hasInf  = 0;
 };
 
+static bool checkNumericsReport(int mode, const CheckNumericsResult& abnormal, bool isInput)
+{
+    const bool isAbnormal = (abnormal.hasNan != 0) || (abnormal.hasInf != 0);
+
+    if(isAbnormal)
+    {
+
+        if((mode & CheckNumerics::Throw) != 0)
+        {
+            if(isInput)
+            {
+                MIOPEN_THROW(miopenStatusInternalError,
+                             "abnormal checkNumerics result detected on INPUT");
+            }
+            else
+            {
+                MIOPEN_THROW(miopenStatusInternalError,
+                             "abnormal checkNumerics result detected on OUTPUT");
+            }
+        }
+        if((mode & CheckNumerics::Abort) != 0)
+        {
+            abort();
+        }
+    }
+
+    return isAbnormal;
+}
+
 bool checkNumericsImpl(
     const Handle& handle, int mode, const TensorDescriptor& dDesc, ConstData_t data, bool isInput)
 {
     int numElements = dDesc.GetElementSize();
+    const int stride =
+        std::max(static_cast<int>(miopen::Value(MIOPEN_CHECK_NUMERICS_ELEMENT_STRIDE{}, 1)), 1);
+    const int numChecked = (numElements + stride - 1) / stride;
 
     // TODO - some constants we should get from the device:
     const int blockSize             = 256;
     const auto numBlocks            = handle.GetMaxComputeUnits() * 6;
     const size_t numGlobalWorkItems = blockSize * numBlocks;
 
-    const int computeStats = (mode & CheckNumerics::ComputeStats);
+    const bool isAsync = (mode & CheckNumerics::Async) != 0;
+    // Sums over the calls between two reports would mean nothing.
+    const int computeStats = isAsync ? 0 : (mode & CheckNumerics::ComputeStats);
 
     CheckNumericsResult abnormal_h;
 
-    auto abnormal_d =
-        handle.Create(sizeof(CheckNumericsResult)); // TODO - someday avoid slow malloc/free here
-    handle.WriteTo(&abnormal_h, abnormal_d, sizeof(CheckNumericsResult));
+    // The Async mode keeps its flags in a buffer of its own, which is reset only by the report.
+    auto& state = handle.GetCheckNumericsState();
+    Allocator::ManageDataPtr local_d;
+    if(!isAsync && !handle.IsWorkspaceArenaEnabled())
+        local_d = handle.Create(sizeof(CheckNumericsResult), miopenAllocationScratch);
+    constexpr auto slot = WorkspaceArena::Slot::CheckNumerics;
+    auto& abnormal_d    = isAsync ? state.flags
+                               : handle.IsWorkspaceArenaEnabled()
+                                     ? handle.GetArenaBuffer(slot, sizeof(CheckNumericsResult))
+                                     : local_d;
+    if(!isAsync || abnormal_d == nullptr)
+    {
+        if(abnormal_d == nullptr)
+            abnormal_d = handle.Create(sizeof(CheckNumericsResult));
+        handle.WriteTo(&abnormal_h, abnormal_d, sizeof(CheckNumericsResult));
+    }
 
     std::string params            = GetDataTypeKernelParams(dDesc.GetType());
     std::string program_name      = "MIOpenCheckNumerics.cl";
@@ -77,7 +129,18 @@ bool checkNumericsImpl(
     const std::vector<size_t> vld = {size_t{blockSize}, size_t{1}, size_t{1}};
     const std::vector<size_t> vgd = {numGlobalWorkItems, size_t{1}, size_t{1}};
     handle.AddKernel("MIOpenCheckNumerics", "", program_name, kernel_name, vld, vgd, params)(
-        data, numElements, abnormal_d.get(), computeStats);
+        data, numElements, abnormal_d.get(), computeStats, stride);
+
+    if(isAsync)
+    {
+        // Nothing is known before the results are read back, which is deferred to the report.
+        ++state.pending;
+        const auto interval =
+            std::max<std::size_t>(miopen::Value(MIOPEN_CHECK_NUMERICS_REPORT_INTERVAL{}, 100), 1);
+        if(state.pending >= interval)
+            checkNumericsFlush(handle, mode);
+        return false;
+    }
 
     handle.ReadTo(&abnormal_h, abnormal_d, sizeof(CheckNumericsResult));
 
@@ -97,10 +160,10 @@ bool checkNumericsImpl(
                                                    << "}");
         if(computeStats != 0)
         {
-            assert(numElements != 0);
+            assert(numChecked != 0);
             MIOPEN_LOG((isAbnormal ? miopen::LoggingLevel::Warning : miopen::LoggingLevel::Info),
-                       "Stats: mean=" << (abnormal_h.sum / numElements) << " absmean="
-                                      << (abnormal_h.absSum / numElements)
+                       "Stats: mean=" << (abnormal_h.sum / numChecked) << " absmean="
+                                      << (abnormal_h.absSum / numChecked)
                                       << " min="
                                       << abnormal_h.min
                                       << " max="
@@ -108,47 +171,81 @@ bool checkNumericsImpl(
         }
     }
 
-    if(isAbnormal)
-    {
+    return checkNumericsReport(mode, abnormal_h, isInput);
+};
 
-        if((mode & CheckNumerics::Throw) != 0)
-        {
-            if(isInput)
-            {
-                MIOPEN_THROW(miopenStatusInternalError,
-                             "abnormal checkNumerics result detected on INPUT");
-            }
-            else
-            {
-                MIOPEN_THROW(miopenStatusInternalError,
-                             "abnormal checkNumerics result detected on OUTPUT");
-            }
-        }
-        if((mode & CheckNumerics::Abort) != 0)
-        {
-            abort();
-        }
+bool checkNumericsFlush(const Handle& handle, int mode)
+{
+    auto& state = handle.GetCheckNumericsState();
+    if(state.pending == 0 || state.flags == nullptr)
+        return false;
+
+    // Reset first: reading back synchronizes the handle, which flushes again.
+    const auto checks = state.pending;
+    state.pending     = 0;
+    CheckNumericsResult abnormal_h;
+    handle.ReadTo(&abnormal_h, state.flags, sizeof(CheckNumericsResult));
+    // The next scans are enqueued after the reset, so none of their flags are lost.
+    const CheckNumericsResult reset_h;
+    handle.WriteTo(&reset_h, state.flags, sizeof(CheckNumericsResult));
+
+    const bool isAbnormal = (abnormal_h.hasNan != 0) || (abnormal_h.hasInf != 0);
+    if(((mode & CheckNumerics::Info) != 0) || (((mode & CheckNumerics::Warn) != 0) && isAbnormal))
+    {
+        MIOPEN_LOG((isAbnormal ? miopen::LoggingLevel::Warning : miopen::LoggingLevel::Info),
+                   "ASYNC " << checks << " checks: zeros=" << abnormal_h.hasZero << " nans="
+                            << abnormal_h.hasNan
+                            << " infs="
+                            << abnormal_h.hasInf);
     }
 
-    return isAbnormal;
-};
+    // The tensor responsible is not known anymore, the abnormal value is reported as an output.
+    return checkNumericsReport(mode, abnormal_h, false);
+}
+
+bool checkNumericsFlush(const Handle& handle)
+{
+    const auto mode = static_cast<int>(miopen::Value(MIOPEN_CHECK_NUMERICS{}));
+    if((mode & CheckNumerics::Async) == 0)
+        return false;
+    return checkNumericsFlush(handle, mode);
+}
+
+// Operations are sampled as a whole: the inputs of an operation are checked only if its output
+// is going to be checked as well.
+static bool IsSampledOperation(const Handle& handle)
+{
+    const auto period =
+        std::max<std::size_t>(miopen::Value(MIOPEN_CHECK_NUMERICS_SAMPLE_PERIOD{}, 1), 1);
+    return handle.GetCheckNumericsState().operations % period == 0;
+}
 
 // Checks data for input
 // Returns: 1 if abnormal value (inf or nan) detected in specified data, 0 otherwise
 bool checkNumericsInput(const Handle& handle, const TensorDescriptor& dDesc, ConstData_t data)
 {
+    if(!IsSampledOperation(handle))
+        return false;
+
     return checkNumericsImpl(
         handle, static_cast<int>(miopen::Value(MIOPEN_CHECK_NUMERICS{})), dDesc, data, true);
 }
 
 // Synchronizes to wait for kernel to finish, then checks data for output:
 // Returns: 1 if abnormal value (inf or nan) detected in specified data, 0 otherwise
+// In the Async mode the check is only enqueued after the kernel, and nothing is waited for.
 bool checkNumericsOutput(const Handle& handle, const TensorDescriptor& dDesc, ConstData_t data)
 {
-    handle.Finish();
+    const auto mode    = static_cast<int>(miopen::Value(MIOPEN_CHECK_NUMERICS{}));
+    const bool sampled = IsSampledOperation(handle);
+    ++handle.GetCheckNumericsState().operations;
+    if(!sampled)
+        return false;
 
-    return checkNumericsImpl(
-        handle, static_cast<int>(miopen::Value(MIOPEN_CHECK_NUMERICS{})), dDesc, data, false);
+    if((mode & CheckNumerics::Async) == 0)
+        handle.Finish();
+
+    return checkNumericsImpl(handle, mode, dDesc, data, false);
 }
 
 } // namespace miopen
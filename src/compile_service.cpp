@@ -0,0 +1,200 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/compile_service.hpp>
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iterator>
+#include <memory>
+
+namespace miopen {
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_COMPILE_PARALLEL_LEVEL)
+
+CompileService& CompileService::Get()
+{
+    // Never destroyed, so that builds still running at exit do not find the pool gone.
+    static auto* const service = [] {
+        const std::size_t hw_threads = std::max(std::thread::hardware_concurrency(), 1u);
+        const std::size_t level      = Value(MIOPEN_COMPILE_PARALLEL_LEVEL{}, 20);
+        // The calling thread takes part in the builds, so the pool has one thread less.
+        return new CompileService(std::min(hw_threads, std::max<std::size_t>(level, 1)) - 1);
+    }();
+    return *service;
+}
+
+CompileService::CompileService(std::size_t thread_num)
+{
+    for(std::size_t i = 0; i < thread_num; i++)
+    {
+        workers.emplace_back([this] { Work(); });
+        workers.back().detach();
+    }
+}
+
+Program CompileService::Build(const std::string& key, const std::function<Program()>& build)
+{
+    std::promise<Program> promise;
+    std::shared_future<Program> pending;
+    {
+        std::lock_guard<std::mutex> lock(in_flight_mutex);
+        const auto shared = loaded.find(key);
+        if(shared != loaded.end())
+        {
+            Program program;
+            if(LockProgram(shared->second, program))
+                return program;
+            loaded.erase(shared);
+        }
+
+        const auto it = in_flight.find(key);
+        if(it != in_flight.end())
+            pending = it->second;
+        else
+            in_flight.emplace(key, promise.get_future().share());
+    }
+
+    if(pending.valid())
+    {
+        MIOPEN_LOG_I2("Waiting for the build in flight: " << key);
+        return pending.get();
+    }
+
+    const auto done = [&](const Program* program) {
+        std::lock_guard<std::mutex> lock(in_flight_mutex);
+        in_flight.erase(key);
+        if(program == nullptr)
+            return;
+        loaded[key] = GetWeakProgram(*program);
+        if(loaded.size() > loaded_sweep_size)
+        {
+            for(auto it = loaded.begin(); it != loaded.end();)
+                it = it->second.expired() ? loaded.erase(it) : std::next(it);
+            loaded_sweep_size = std::max<std::size_t>(64, 2 * loaded.size());
+        }
+    };
+
+    try
+    {
+        auto program = build();
+        promise.set_value(program);
+        done(&program);
+        return program;
+    }
+    catch(...)
+    {
+        promise.set_exception(std::current_exception());
+        done(nullptr);
+        throw;
+    }
+}
+
+void CompileService::ParallelFor(std::size_t n,
+                                 std::size_t max_threads,
+                                 const std::function<void(std::size_t)>& f)
+{
+    const auto thread_num = std::min({max_threads, workers.size() + 1, n});
+    if(thread_num <= 1)
+    {
+        for(std::size_t i = 0; i < n; i++)
+            f(i);
+        return;
+    }
+
+    // Shared with the pool threads, which may only get to their task once all the work is done.
+    struct State
+    {
+        std::function<void(std::size_t)> f;
+        std::size_t n;
+        std::atomic<std::size_t> next{0};
+        std::size_t done = 0;
+        std::exception_ptr error;
+        std::mutex mutex;
+        std::condition_variable cv;
+    };
+    auto state = std::make_shared<State>();
+    state->f   = f;
+    state->n   = n;
+
+    const auto work = [state] {
+        for(auto i = state->next++; i < state->n; i = state->next++)
+        {
+            std::exception_ptr error;
+            try
+            {
+                state->f(i);
+            }
+            catch(...)
+            {
+                error = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if(error && !state->error)
+                state->error = error;
+            if(++state->done == state->n)
+                state->cv.notify_all();
+        }
+    };
+
+    for(std::size_t i = 1; i < thread_num; i++)
+        Submit(work);
+    work();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->cv.wait(lock, [&] { return state->done == state->n; });
+    if(state->error)
+        std::rethrow_exception(state->error);
+}
+
+void CompileService::Submit(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex);
+        tasks.push_back(std::move(task));
+    }
+    tasks_cv.notify_one();
+}
+
+void CompileService::Work()
+{
+    for(;;)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(tasks_mutex);
+            tasks_cv.wait(lock, [this] { return !tasks.empty(); });
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
+
+} // namespace miopen
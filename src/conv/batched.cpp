@@ -0,0 +1,224 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/conv/batched.hpp>
+
+#include <miopen/conv/plan.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/tensor.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_BATCHED_AS_GROUPED)
+
+namespace miopen {
+
+namespace {
+
+struct GroupedProblem
+{
+    TensorDescriptor x;
+    TensorDescriptor w;
+    TensorDescriptor y;
+    ConvolutionDescriptor conv;
+};
+
+bool GetSolution(Handle& handle,
+                 const TensorDescriptor& wDesc,
+                 const TensorDescriptor& xDesc,
+                 const ConvolutionDescriptor& convDesc,
+                 const TensorDescriptor& yDesc,
+                 miopenConvSolution_t& solution)
+{
+    std::size_t count = 0;
+    convDesc.GetForwardSolutions(handle, wDesc, xDesc, yDesc, 1, &count, &solution);
+    return count != 0;
+}
+
+/// With one image per problem, count consecutive N x C x H x W inputs are the N x count*C x H x W
+/// input of a convolution with count times the groups, and so are the weights and the outputs.
+bool CanRunGrouped(const TensorDescriptor& xDesc,
+                   const TensorDescriptor& wDesc,
+                   const ConvolutionDescriptor& convDesc,
+                   const TensorDescriptor& yDesc,
+                   std::size_t count)
+{
+#if MIOPEN_BACKEND_HIP
+    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_BATCHED_AS_GROUPED{}))
+        return false;
+    if(count < 2 || convDesc.mode != miopenConvolution || xDesc.GetLengths()[0] != 1)
+        return false;
+    for(const auto* desc : {&xDesc, &wDesc, &yDesc})
+        if(!desc->IsPacked() || !desc->IsDefaultLayout())
+            return false;
+    const auto channels = std::max(xDesc.GetLengths()[1], yDesc.GetLengths()[1]);
+    return channels * count <= std::numeric_limits<int>::max();
+#else
+    // Buffer objects can not be told apart from views into a single allocation.
+    std::ignore = xDesc;
+    std::ignore = wDesc;
+    std::ignore = convDesc;
+    std::ignore = yDesc;
+    std::ignore = count;
+    return false;
+#endif
+}
+
+template <class T>
+bool IsEvenlySpaced(const T* buffers, std::size_t count, std::size_t bytes)
+{
+    const auto base = reinterpret_cast<std::uintptr_t>(buffers[0]);
+    for(std::size_t i = 1; i < count; ++i)
+        if(reinterpret_cast<std::uintptr_t>(buffers[i]) != base + i * bytes)
+            return false;
+    return true;
+}
+
+GroupedProblem MakeGroupedProblem(const TensorDescriptor& xDesc,
+                                  const TensorDescriptor& wDesc,
+                                  const ConvolutionDescriptor& convDesc,
+                                  const TensorDescriptor& yDesc,
+                                  std::size_t count)
+{
+    auto x_lens = xDesc.GetLengths();
+    auto w_lens = wDesc.GetLengths();
+    auto y_lens = yDesc.GetLengths();
+    x_lens[1] *= count;
+    w_lens[0] *= count;
+    y_lens[1] *= count;
+
+    auto conv = convDesc;
+    conv.group_count *= static_cast<int>(count);
+
+    return {TensorDescriptor{xDesc.GetType(), x_lens},
+            TensorDescriptor{wDesc.GetType(), w_lens},
+            TensorDescriptor{yDesc.GetType(), y_lens},
+            conv};
+}
+
+bool FitsWorkspace(const Handle& handle,
+                   std::size_t required,
+                   Data_t workSpace,
+                   std::size_t workSpaceSize)
+{
+    if(required == 0)
+        return true;
+    if(workSpace == nullptr)
+        return handle.IsWorkspaceArenaEnabled();
+    return workSpaceSize >= required;
+}
+
+} // namespace
+
+std::size_t ConvolutionForwardBatchedGetWorkSpaceSize(Handle& handle,
+                                                      const TensorDescriptor& wDesc,
+                                                      const TensorDescriptor& xDesc,
+                                                      const ConvolutionDescriptor& convDesc,
+                                                      const TensorDescriptor& yDesc,
+                                                      std::size_t count)
+{
+    miopenConvSolution_t solution;
+    if(!GetSolution(handle, wDesc, xDesc, convDesc, yDesc, solution))
+        MIOPEN_THROW(miopenStatusNotImplemented, "No solution for the batched convolution");
+    auto workspace_size = solution.workspace_size;
+
+    if(CanRunGrouped(xDesc, wDesc, convDesc, yDesc, count))
+    {
+        const auto grouped = MakeGroupedProblem(xDesc, wDesc, convDesc, yDesc, count);
+        if(GetSolution(handle, grouped.w, grouped.x, grouped.conv, grouped.y, solution))
+            workspace_size = std::max(workspace_size, solution.workspace_size);
+    }
+    return workspace_size;
+}
+
+void ConvolutionForwardBatched(Handle& handle,
+                               const TensorDescriptor& xDesc,
+                               const ConstData_t* x,
+                               const TensorDescriptor& wDesc,
+                               const ConstData_t* w,
+                               const ConvolutionDescriptor& convDesc,
+                               const TensorDescriptor& yDesc,
+                               const Data_t* y,
+                               std::size_t count,
+                               Data_t workSpace,
+                               std::size_t workSpaceSize)
+{
+    if(count == 0)
+        return;
+    if(x == nullptr || w == nullptr || y == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm, "The buffer arrays cannot be nullptr");
+
+    miopenConvSolution_t solution;
+    if(CanRunGrouped(xDesc, wDesc, convDesc, yDesc, count) &&
+       IsEvenlySpaced(x, count, xDesc.GetNumBytes()) &&
+       IsEvenlySpaced(w, count, wDesc.GetNumBytes()) &&
+       IsEvenlySpaced(y, count, yDesc.GetNumBytes()))
+    {
+        const auto grouped = MakeGroupedProblem(xDesc, wDesc, convDesc, yDesc, count);
+        if(GetSolution(handle, grouped.w, grouped.x, grouped.conv, grouped.y, solution) &&
+           FitsWorkspace(handle, solution.workspace_size, workSpace, workSpaceSize))
+        {
+            MIOPEN_LOG_I2(count << " convolutions run as one with " << grouped.conv.group_count
+                                << " groups");
+            ConvolutionPlan plan{handle,
+                                 grouped.x,
+                                 grouped.w,
+                                 grouped.y,
+                                 grouped.conv,
+                                 conv::Direction::Forward,
+                                 solution.solution_id};
+            plan.Run(handle,
+                     const_cast<Data_t>(x[0]),
+                     const_cast<Data_t>(w[0]),
+                     y[0],
+                     workSpace,
+                     workSpaceSize);
+            return;
+        }
+    }
+
+    if(!GetSolution(handle, wDesc, xDesc, convDesc, yDesc, solution))
+        MIOPEN_THROW(miopenStatusNotImplemented, "No solution for the batched convolution");
+    ConvolutionPlan plan{
+        handle, xDesc, wDesc, yDesc, convDesc, conv::Direction::Forward, solution.solution_id};
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        plan.Run(handle,
+                 const_cast<Data_t>(x[i]),
+                 const_cast<Data_t>(w[i]),
+                 y[i],
+                 workSpace,
+                 workSpaceSize);
+    }
+}
+
+} // namespace miopen
@@ -0,0 +1,179 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv/find_future.hpp>
+
+#include <miopen/conv/context.hpp>
+#include <miopen/conv_algo_name.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <chrono>
+
+namespace miopen {
+
+ConvolutionFindFuture::ConvolutionFindFuture(Handle& handle,
+                                             const TensorDescriptor& xDesc_,
+                                             ConstData_t x_,
+                                             const TensorDescriptor& wDesc_,
+                                             ConstData_t w_,
+                                             const ConvolutionDescriptor& convDesc_,
+                                             const TensorDescriptor& yDesc_,
+                                             Data_t y_,
+                                             int requestAlgoCount,
+                                             Data_t workSpace_,
+                                             std::size_t workSpaceSize_,
+                                             bool exhaustiveSearch_)
+    : xDesc(xDesc_),
+      wDesc(wDesc_),
+      yDesc(yDesc_),
+      convDesc(convDesc_),
+      x(x_),
+      w(w_),
+      y(y_),
+      workSpace(workSpace_),
+      workSpaceSize(workSpaceSize_),
+      exhaustiveSearch(exhaustiveSearch_)
+{
+    // Report what the search would fail on right away rather than on Wait().
+    if(x == nullptr || w == nullptr || y == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm, "Buffers cannot be NULL");
+    if(requestAlgoCount < 1)
+        MIOPEN_THROW(miopenStatusBadParm, "requestAlgoCount cannot be < 1");
+
+    results.resize(requestAlgoCount);
+    done = std::async(std::launch::async, [this, &handle]() { Search(handle); }).share();
+}
+
+ConvolutionFindFuture::~ConvolutionFindFuture()
+{
+    // The search uses the buffers and the members, it shall not outlive the future.
+    if(done.valid())
+        done.wait();
+}
+
+bool ConvolutionFindFuture::IsReady() const
+{
+    return done.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+void ConvolutionFindFuture::Wait(int* returnedAlgoCount, miopenConvAlgoPerf_t* perfResults) const
+{
+    if(returnedAlgoCount == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm, "returnedAlgoCount cannot be nullptr");
+    if(perfResults == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm, "perfResults cannot be nullptr");
+
+    *returnedAlgoCount = 0;
+    done.get();
+    std::copy(results.begin(), results.end(), perfResults);
+    *returnedAlgoCount = static_cast<int>(results.size());
+}
+
+void ConvolutionFindFuture::Search(Handle& handle)
+{
+    auto background     = handle.CreateBackgroundHandle();
+    int count           = 0;
+    const auto requests = static_cast<int>(results.size());
+
+    /// workaround for previous trans conv logic
+    if(convDesc.mode == miopenTranspose)
+    {
+        convDesc.FindConvBwdDataAlgorithm(background,
+                                          xDesc,
+                                          x,
+                                          wDesc,
+                                          w,
+                                          yDesc,
+                                          y,
+                                          requests,
+                                          &count,
+                                          results.data(),
+                                          workSpace,
+                                          workSpaceSize,
+                                          exhaustiveSearch);
+
+        for(int i = 0; i < count; ++i)
+        {
+            // It is guaranteed that enum values are equal, see conv_algo_name.cpp
+            results[i].fwd_algo = static_cast<miopenConvFwdAlgorithm_t>(results[i].bwd_data_algo);
+        }
+    }
+    else
+    {
+        convDesc.FindConvFwdAlgorithm(background,
+                                      xDesc,
+                                      x,
+                                      wDesc,
+                                      w,
+                                      yDesc,
+                                      y,
+                                      requests,
+                                      &count,
+                                      results.data(),
+                                      workSpace,
+                                      workSpaceSize,
+                                      exhaustiveSearch);
+    }
+
+    results.resize(count);
+    RegisterInvokers(handle, background);
+}
+
+void ConvolutionFindFuture::RegisterInvokers(Handle& handle, const Handle& background) const
+{
+    const auto transposed = convDesc.mode == miopenTranspose;
+    const auto direction  = transposed ? conv::Direction::BackwardData : conv::Direction::Forward;
+    const auto config     = transposed
+                            ? ConvolutionContext{yDesc, wDesc, xDesc, convDesc, direction}
+                                  .BuildConfKey()
+                            : ConvolutionContext{xDesc, wDesc, yDesc, convDesc, direction}
+                                  .BuildConfKey();
+    const auto interned_config = InternedString::TryGet(config.ToString());
+
+    for(const auto& result : results)
+    {
+        const auto algorithm_name = AlgorithmName{ConvolutionAlgoToDirectionalString(
+            static_cast<miopenConvAlgorithm_t>(result.fwd_algo), direction)};
+        const auto solver = background.GetFoundSolver(interned_config, algorithm_name);
+        if(!solver.IsValid())
+            continue;
+        const auto invoker = background.GetInvoker(interned_config, solver);
+        if(!invoker)
+            continue;
+        handle.RegisterInvoker(*invoker, config, solver, algorithm_name);
+        MIOPEN_LOG_I2("Registered the invoker of " << solver.ToString() << " found in background");
+    }
+}
+
+std::ostream& operator<<(std::ostream& stream, const ConvolutionFindFuture& future)
+{
+    return stream << (future.IsReady() ? "ready" : "pending");
+}
+
+} // namespace miopen
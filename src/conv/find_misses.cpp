@@ -0,0 +1,233 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/conv/find_misses.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_FIND_MISS_LOG)
+
+namespace miopen {
+namespace conv {
+
+namespace {
+
+long GetProcessId()
+{
+#ifndef _WIN32
+    return ::getpid();
+#else
+    return 0;
+#endif
+}
+
+/// MIOpenDriver arguments of the problem, in the direction the library solves it, so that the
+/// tuning run hits the same find-db and perf-db records.
+std::string GetDriverArgs(const ProblemDescription& problem)
+{
+    const auto forward = problem.GetDirection() == Direction::Forward;
+    // The tensors of backward problems are swapped, i.e. GetIn() is dy.
+    const auto& x      = forward ? problem.GetIn() : problem.GetOut();
+    const auto spatial = problem.GetSpatialDims();
+    const auto& x_lens = x.GetLengths();
+    const auto& w_lens = problem.GetWeights().GetLengths();
+
+    std::ostringstream ss;
+    switch(x.GetType())
+    {
+    case miopenHalf: ss << "convfp16"; break;
+    case miopenBFloat16: ss << "convbfp16"; break;
+    case miopenInt8:
+    case miopenInt8x4: ss << "convint8"; break;
+    case miopenFloat:
+    case miopenInt32: ss << "conv"; break;
+    }
+
+    ss << " -n " << x_lens[0] << " -c " << x_lens[1];
+    if(spatial == 3)
+    {
+        // clang-format off
+        ss << " --in_d " << x_lens[2] << " -H " << x_lens[3] << " -W " << x_lens[4]
+           << " -k " << w_lens[0]
+           << " --fil_d " << w_lens[2] << " -y " << w_lens[3] << " -x " << w_lens[4]
+           << " --pad_d " << problem.GetPadD() << " -p " << problem.GetPadH()
+           << " -q " << problem.GetPadW()
+           << " --conv_stride_d " << problem.GetKernelStrideD()
+           << " -u " << problem.GetKernelStrideH() << " -v " << problem.GetKernelStrideW()
+           << " --dilation_d " << problem.GetDilationD()
+           << " -l " << problem.GetDilationH() << " -j " << problem.GetDilationW()
+           << " --spatial_dim 3";
+        // clang-format on
+    }
+    else
+    {
+        // clang-format off
+        ss << " -H " << x_lens[2] << " -W " << x_lens[3]
+           << " -k " << w_lens[0] << " -y " << w_lens[2] << " -x " << w_lens[3]
+           << " -p " << problem.GetPadH() << " -q " << problem.GetPadW()
+           << " -u " << problem.GetKernelStrideH() << " -v " << problem.GetKernelStrideW()
+           << " -l " << problem.GetDilationH() << " -j " << problem.GetDilationW();
+        // clang-format on
+    }
+
+    const auto direction = forward ? 1 : problem.GetDirection() == Direction::BackwardData ? 2 : 4;
+    ss << " -m conv -g " << problem.GetGroupCount() << " -F " << direction << " -t 1";
+    if(x.GetType() == miopenInt8x4)
+        ss << " -Z 1";
+    return ss.str();
+}
+
+struct Miss
+{
+    std::string db_key;
+    std::string driver_args;
+    solver::Id solver;
+    float time;
+    std::size_t lookups;
+    std::size_t calls;
+};
+
+class Recorder
+{
+    public:
+    static Recorder& Get()
+    {
+        static Recorder recorder;
+        return recorder;
+    }
+
+    Recorder(const Recorder&) = delete;
+    Recorder& operator=(const Recorder&) = delete;
+    ~Recorder()
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        Write();
+    }
+
+    void Record(const ProblemDescription& problem, const miopenConvSolution_t& fallback)
+    {
+        const auto config = InternedString{problem.BuildConfKey().ToString()};
+        const auto id     = solver::Id{fallback.solution_id};
+        const std::lock_guard<std::mutex> lock{mutex};
+
+        auto found = misses.find(config);
+        if(found != misses.end())
+        {
+            ++found->second.lookups;
+            found->second.solver = id;
+            found->second.time   = fallback.time;
+            return;
+        }
+
+        std::ostringstream db_key;
+        problem.Serialize(db_key);
+        misses.emplace(config, Miss{db_key.str(), GetDriverArgs(problem), id, fallback.time, 1, 0});
+        // New problems are rare after the warm-up, and the file is up to date if the process
+        // does not get to exit cleanly.
+        Write();
+    }
+
+    void Count(const InternedString& config, solver::Id id)
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        const auto found = misses.find(config);
+        if(found != misses.end() && found->second.solver == id)
+            ++found->second.calls;
+    }
+
+    private:
+    Recorder() = default;
+
+    /// Replaces the file of the process, so that a reader never sees a partial one and it stays
+    /// as small as the set of the problems which have missed.
+    void Write() const
+    {
+        const auto path = std::string{GetStringEnv(MIOPEN_FIND_MISS_LOG{})} + "." +
+                          std::to_string(GetProcessId()) + ".txt";
+        const auto temp_path = path + ".temp";
+        {
+            std::ofstream file{temp_path};
+            if(!file)
+                return;
+            file << "# lookups calls estimated_ms solver find-db-key driver-args\n";
+            for(const auto& entry : misses)
+            {
+                const auto& miss = entry.second;
+                file << miss.lookups << ' ' << miss.calls << ' ' << miss.time << ' '
+                     << miss.solver.ToString() << ' ' << miss.db_key << ' ' << miss.driver_args
+                     << '\n';
+            }
+        }
+        std::rename(temp_path.c_str(), path.c_str());
+    }
+
+    std::mutex mutex;
+    std::unordered_map<InternedString, Miss, InternedStringHash> misses;
+};
+
+} // namespace
+
+bool IsFindMissLogEnabled()
+{
+    static const bool enabled = [] {
+        const auto path = GetStringEnv(MIOPEN_FIND_MISS_LOG{});
+        if(path == nullptr || *path == '\0')
+            return false;
+        // Constructed before the first miss, so destroyed (and written) after the last one.
+        Recorder::Get();
+        return true;
+    }();
+    return enabled;
+}
+
+void RecordFindMiss(const ProblemDescription& problem, const miopenConvSolution_t& fallback)
+{
+    if(!IsFindMissLogEnabled())
+        return;
+    MIOPEN_LOG_I2("Find-db miss, fallback " << solver::Id{fallback.solution_id}.ToString()
+                                            << ", estimated time: " << fallback.time);
+    Recorder::Get().Record(problem, fallback);
+}
+
+void CountFindMissCall(const InternedString& config, solver::Id solver)
+{
+    if(IsFindMissLogEnabled())
+        Recorder::Get().Count(config, solver);
+}
+
+} // namespace conv
+} // namespace miopen
@@ -0,0 +1,134 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv/hot_problems.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/find_controls.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/solver.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_FIND_SPECIALIZE_TOP_N)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_FIND_SPECIALIZE_MIN_CALLS)
+
+namespace miopen {
+
+conv::HotProblems& Handle::GetHotProblems() const
+{
+    // Threads sharing the handle may race for the creation, only one of them stores its own.
+    auto current = std::atomic_load(&hot_problems);
+    if(!current)
+    {
+        auto created = std::make_shared<conv::HotProblems>();
+        if(std::atomic_compare_exchange_strong(&hot_problems, &current, created))
+            current = created;
+    }
+    return *current;
+}
+
+namespace conv {
+
+HotProblems::~HotProblems()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for(auto& entry : entries)
+        if(entry.second.build.valid())
+            entry.second.build.wait();
+}
+
+namespace {
+
+std::size_t GetTopN()
+{
+    return Value(MIOPEN_FIND_SPECIALIZE_TOP_N{}, FindMode::IsBackgroundRefineSet() ? 16 : 0);
+}
+
+} // namespace
+
+bool HotProblems::IsEnabled() { return GetTopN() > 0; }
+
+boost::optional<HotProblems::Solutions>
+HotProblems::Count(const InternedString& config,
+                   int algorithm,
+                   const std::function<std::function<Solutions()>()>& make_build)
+{
+    const auto top_n = GetTopN();
+    const auto key   = Key{config, algorithm};
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = entries.find(key);
+
+    if(found == entries.end())
+    {
+        if(started >= top_n)
+            return boost::none;
+        found = entries.emplace(key, Entry{}).first;
+    }
+
+    auto& entry = found->second;
+    if(entry.done)
+        return boost::none;
+
+    if(!entry.build.valid())
+    {
+        if(++entry.calls < Value(MIOPEN_FIND_SPECIALIZE_MIN_CALLS{}, 100) || started >= top_n)
+            return boost::none;
+        auto build = make_build();
+        if(!build)
+        {
+            entry.done = true;
+            return boost::none;
+        }
+        ++started;
+        MIOPEN_LOG_I("Specializing " << config.ToString() << " after " << entry.calls
+                                     << " calls");
+        entry.build = std::async(std::launch::async, [build]() -> Solutions {
+            try
+            {
+                return build();
+            }
+            catch(const std::exception& ex)
+            {
+                MIOPEN_LOG_WE("Specialization failed: " << ex.what());
+                return {};
+            }
+        });
+        return boost::none;
+    }
+
+    if(entry.build.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return boost::none;
+    entry.done = true;
+    return entry.build.get();
+}
+
+} // namespace conv
+} // namespace miopen
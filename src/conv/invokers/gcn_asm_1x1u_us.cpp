@@ -57,43 +57,56 @@ InvokerFactory MakeGcnAsm1x1UUSInvokerFactory(
 
             int unused       = 0;
             int* return_addr = nullptr;
-            handle.Run(kernel)(N,
-                               C,
-                               H,
-                               W,
-                               K,
-                               n_groups,
-                               unused,
-                               unused,
-                               tensors.in,
-                               tensors.w,
-                               workSpace,
-                               return_addr);
+            const auto subsample = [&]() {
+                handle.Run(kernel)(N,
+                                   C,
+                                   H,
+                                   W,
+                                   K,
+                                   n_groups,
+                                   unused,
+                                   unused,
+                                   tensors.in,
+                                   tensors.w,
+                                   workSpace,
+                                   return_addr);
+            };
 
-            if(params.type != InvokeType::AutoTune)
+            if(params.type == InvokeType::AutoTune)
             {
-                float elapsed = 0;
+                subsample();
+                return;
+            }
 
-                if(handle.IsProfilingEnabled())
-                    elapsed += handle.GetKernelTime();
+            float elapsed = 0;
 
-                /// \todo Initialization is required for upsampling. This leads to small perf drop.
-                /// 1: Add kernel (from SetTensor) to the Solution in the Solver.
-                /// 2: Fix UpSample kernel, probably by means of conditional compilation.
-                float zero = 0.f;
-                SetTensor(handle, tensors.outDesc, tensors.out, &zero);
+            // The output is not read by the main kernel, so its zeroing may run alongside it.
+            handle.RunConcurrently(2, [&](std::size_t i) {
+                if(i == 0)
+                {
+                    subsample();
+                }
+                else
+                {
+                    /// \todo Initialization is required for upsampling. This leads to small perf
+                    /// drop.
+                    /// 1: Add kernel (from SetTensor) to the Solution in the Solver.
+                    /// 2: Fix UpSample kernel, probably by means of conditional compilation.
+                    float zero = 0.f;
+                    SetTensor(handle, tensors.outDesc, tensors.out, &zero);
+                }
 
                 if(handle.IsProfilingEnabled())
                     elapsed += handle.GetKernelTime();
+            });
 
-                handle.Run(us_kernel)(workSpace, tensors.out);
+            handle.Run(us_kernel)(workSpace, tensors.out);
 
-                if(handle.IsProfilingEnabled())
-                {
-                    elapsed += handle.GetKernelTime();
-                    handle.ResetKernelTime();
-                    handle.AccumKernelTime(elapsed);
-                }
+            if(handle.IsProfilingEnabled())
+            {
+                elapsed += handle.GetKernelTime();
+                handle.ResetKernelTime();
+                handle.AccumKernelTime(elapsed);
             }
         };
     };
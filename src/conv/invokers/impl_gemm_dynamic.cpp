@@ -2,6 +2,7 @@
 #include <miopen/conv/data_invoke_params.hpp>
 #include <miopen/algorithm.hpp>
 #include <miopen/handle.hpp>
+#include <miopen/tensor.hpp>
 #include <miopen/tensor_ops.hpp>
 #include <miopen/numeric.hpp>
 #include <boost/any.hpp>
@@ -9,17 +10,13 @@
 namespace miopen {
 namespace conv {
 
-float CallImplGemmDynamicForward(const miopen::Handle& handle,
-                                 const ProblemDescription& conv_problem,
-                                 ConstData_t src,
-                                 Data_t dst,
-                                 ConstData_t wei,
-                                 const std::vector<KernelInvoke>& kernels)
+static std::vector<OpKernelArgsBlock>
+MakeImplGemmDynamicForwardArgs(const ProblemDescription& conv_problem)
 {
-    float elapsed = 0.0f;
-
-    auto kernel = kernels[0];
-    MIOPEN_LOG_I(kernel.GetName());
+    // The buffer pointers are set at launch.
+    ConstData_t src = nullptr;
+    ConstData_t wei = nullptr;
+    Data_t dst      = nullptr;
 
     // clang-format off
     int hi          = conv_problem.GetInHeight();
@@ -61,24 +58,16 @@ float CallImplGemmDynamicForward(const miopen::Handle& handle,
     opArgs.emplace_back(x);
     opArgs.emplace_back(__pack0);
 
-    kernel(opArgs);
-
-    if(handle.IsProfilingEnabled())
-        elapsed += handle.GetKernelTime();
-    return elapsed;
+    return {OpKernelArgsBlock{opArgs}};
 }
 
-float CallImplGemmDynamicForward1x1(const miopen::Handle& handle,
-                                    const ProblemDescription& conv_problem,
-                                    ConstData_t src,
-                                    Data_t dst,
-                                    ConstData_t wei,
-                                    const std::vector<KernelInvoke>& kernels)
+static std::vector<OpKernelArgsBlock>
+MakeImplGemmDynamicForward1x1Args(const ProblemDescription& conv_problem)
 {
-    float elapsed = 0.0f;
-
-    auto kernel = kernels[0];
-    MIOPEN_LOG_I(kernel.GetName());
+    // The buffer pointers are set at launch.
+    ConstData_t src = nullptr;
+    ConstData_t wei = nullptr;
+    Data_t dst      = nullptr;
 
     // clang-format off
     int hi          = conv_problem.GetInHeight();
@@ -116,24 +105,16 @@ float CallImplGemmDynamicForward1x1(const miopen::Handle& handle,
     opArgs.emplace_back(pad_w);
     opArgs.emplace_back(__pack0);
 
-    kernel(opArgs);
-
-    if(handle.IsProfilingEnabled())
-        elapsed += handle.GetKernelTime();
-    return elapsed;
+    return {OpKernelArgsBlock{opArgs}};
 }
 
-float CallImplGemmDynamicBackwardData(const miopen::Handle& handle,
-                                      const ProblemDescription& conv_problem,
-                                      ConstData_t src,
-                                      Data_t dst,
-                                      ConstData_t wei,
-                                      const std::vector<KernelInvoke>& kernels)
+static std::vector<OpKernelArgsBlock>
+MakeImplGemmDynamicBackwardDataArgs(const ProblemDescription& conv_problem)
 {
-    float elapsed = 0.0f;
-
-    auto kernel = kernels[0];
-    MIOPEN_LOG_I(kernel.GetName());
+    // The buffer pointers are set at launch.
+    Data_t dst      = nullptr;
+    ConstData_t wei = nullptr;
+    ConstData_t src = nullptr;
 
     // clang-format off
     int hi          = conv_problem.GetOutHeight();
@@ -226,6 +207,8 @@ float CallImplGemmDynamicBackwardData(const miopen::Handle& handle,
     opArgs.emplace_back(dslice_w_left);
     opArgs.emplace_back(__pack0);
 
+    // One launch per non-empty gemm.
+    std::vector<OpKernelArgsBlock> launches;
     for(int gemm_id = 0; gemm_id < num_of_gemms; gemm_id++)
     {
         int _dtile_iy          = gemm_id / x_tilda;
@@ -239,7 +222,32 @@ float CallImplGemmDynamicBackwardData(const miopen::Handle& handle,
         opArgs[26]             = OpKernelArg(_y_dot_slice);
         opArgs[27]             = OpKernelArg(_x_dot_slice);
         if(is_gemm_not_empty)
-            kernel(opArgs);
+            launches.emplace_back(opArgs);
+    }
+
+    return launches;
+}
+
+/// Launches the kernel once per packed argument block, with the buffer pointers the kernels take
+/// as their first three arguments patched in.
+static float RunImplGemmDynamic(const miopen::Handle& handle,
+                                const std::vector<OpKernelArgsBlock>& launches,
+                                const void* ptr0,
+                                const void* ptr1,
+                                const void* ptr2,
+                                const std::vector<KernelInvoke>& kernels)
+{
+    float elapsed = 0.0f;
+
+    auto kernel = kernels[0];
+    MIOPEN_LOG_I(kernel.GetName());
+
+    for(auto args : launches)
+    {
+        args.Set(0, ptr0);
+        args.Set(1, ptr1);
+        args.Set(2, ptr2);
+        kernel(args);
     }
 
     if(handle.IsProfilingEnabled())
@@ -247,10 +255,126 @@ float CallImplGemmDynamicBackwardData(const miopen::Handle& handle,
     return elapsed;
 }
 
+bool IsImplGemmDynamicDataTypeSupported(const ProblemDescription& conv_problem)
+{
+#if MIOPEN_BACKEND_HIP
+    return conv_problem.IsFp32() || conv_problem.IsFp16() || conv_problem.IsBfp16();
+#else
+    return conv_problem.IsFp32();
+#endif
+}
+
+std::size_t GetImplGemmDynamicFp32WorkspaceSize(const ProblemDescription& conv_problem)
+{
+    if(conv_problem.IsFp32())
+        return 0;
+    return (conv_problem.GetIn().GetElementSize() + conv_problem.GetWeights().GetElementSize() +
+            conv_problem.GetOut().GetElementSize()) *
+           sizeof(float);
+}
+
+float RunImplGemmDynamicOnFp32(
+    const Handle& handle,
+    const TensorDescriptor& aDesc,
+    ConstData_t a,
+    const TensorDescriptor& bDesc,
+    ConstData_t b,
+    const TensorDescriptor& cDesc,
+    Data_t c,
+    Data_t workSpace,
+    std::size_t workSpaceSize,
+    const std::function<float(ConstData_t, ConstData_t, Data_t, Data_t)>& run)
+{
+    if(cDesc.GetType() == miopenFloat)
+        return run(a, b, c, workSpace);
+
+#if MIOPEN_BACKEND_HIP
+    // Packed, the layout the kernels assume.
+    const auto a32 = TensorDescriptor{miopenFloat, aDesc.GetLengths()};
+    const auto b32 = TensorDescriptor{miopenFloat, bDesc.GetLengths()};
+    const auto c32 = TensorDescriptor{miopenFloat, cDesc.GetLengths()};
+
+    const auto a_bytes = a32.GetElementSize() * sizeof(float);
+    const auto b_bytes = b32.GetElementSize() * sizeof(float);
+    const auto c_bytes = c32.GetElementSize() * sizeof(float);
+    const auto total   = a_bytes + b_bytes + c_bytes;
+    if(workSpace == nullptr || workSpaceSize < total)
+        MIOPEN_THROW("Not enough workspace for the fp32 copies of the tensors");
+
+    const auto a_copy = workSpace;
+    const auto b_copy = static_cast<Data_t>(static_cast<char*>(workSpace) + a_bytes);
+    const auto c_copy = static_cast<Data_t>(static_cast<char*>(workSpace) + a_bytes + b_bytes);
+
+    // E.g. for the partial results of the wrw reduction.
+    const auto rest = workSpaceSize > total
+                          ? static_cast<Data_t>(static_cast<char*>(workSpace) + total)
+                          : nullptr;
+
+    const float one = 1.0f;
+    float elapsed   = 0.0f;
+    const auto add_time = [&]() {
+        if(handle.IsProfilingEnabled())
+            elapsed += handle.GetKernelTime();
+    };
+
+    CastTensor(handle, &one, aDesc, a, a32, a_copy);
+    add_time();
+    CastTensor(handle, &one, bDesc, b, b32, b_copy);
+    add_time();
+    elapsed += run(a_copy, b_copy, c_copy, rest);
+    CastTensor(handle, &one, c32, c_copy, cDesc, c);
+    add_time();
+    return elapsed;
+#else
+    std::ignore = handle;
+    std::ignore = aDesc;
+    std::ignore = a;
+    std::ignore = bDesc;
+    std::ignore = b;
+    std::ignore = c;
+    std::ignore = workSpaceSize;
+    MIOPEN_THROW(miopenStatusNotImplemented, "Dynamic implicit GEMM needs fp32 on OpenCL");
+#endif
+}
+
+float CallImplGemmDynamicForward(const miopen::Handle& handle,
+                                 const ProblemDescription& conv_problem,
+                                 ConstData_t src,
+                                 Data_t dst,
+                                 ConstData_t wei,
+                                 const std::vector<KernelInvoke>& kernels)
+{
+    return RunImplGemmDynamic(
+        handle, MakeImplGemmDynamicForwardArgs(conv_problem), src, wei, dst, kernels);
+}
+
+float CallImplGemmDynamicForward1x1(const miopen::Handle& handle,
+                                    const ProblemDescription& conv_problem,
+                                    ConstData_t src,
+                                    Data_t dst,
+                                    ConstData_t wei,
+                                    const std::vector<KernelInvoke>& kernels)
+{
+    return RunImplGemmDynamic(
+        handle, MakeImplGemmDynamicForward1x1Args(conv_problem), src, wei, dst, kernels);
+}
+
+float CallImplGemmDynamicBackwardData(const miopen::Handle& handle,
+                                      const ProblemDescription& conv_problem,
+                                      ConstData_t src,
+                                      Data_t dst,
+                                      ConstData_t wei,
+                                      const std::vector<KernelInvoke>& kernels)
+{
+    return RunImplGemmDynamic(
+        handle, MakeImplGemmDynamicBackwardDataArgs(conv_problem), dst, wei, src, kernels);
+}
+
 InvokerFactory MakeImplGemmDynamicForwardInvokerFactory(const ConvolutionContext& ctx)
 {
-    const auto& conv_problem = ctx.conv_problem;
-    return [conv_problem](const std::vector<Kernel>& kernels) {
+    // Packed once, only the buffer pointers are patched per call.
+    const auto launches = MakeImplGemmDynamicForwardArgs(ctx.conv_problem);
+    return [launches](const std::vector<Kernel>& kernels) {
         return [=](const Handle& handle, const AnyInvokeParams& primitive_parameters) {
             decltype(auto) data_ctx = primitive_parameters.CastTo<conv::DataInvokeParams>();
             const auto& tensors     = data_ctx.tensors;
@@ -261,9 +385,19 @@ InvokerFactory MakeImplGemmDynamicForwardInvokerFactory(const ConvolutionContext
                            kernels.end(),
                            std::back_inserter(ks),
                            [&](const Kernel& k) { return handle.Run(k); });
-            float elapsed = 0;
-            elapsed       = CallImplGemmDynamicForward(
-                handle, conv_problem, tensors.in, tensors.out, tensors.w, ks);
+            const auto elapsed = RunImplGemmDynamicOnFp32(
+                handle,
+                tensors.inDesc,
+                tensors.in,
+                tensors.wDesc,
+                tensors.w,
+                tensors.outDesc,
+                tensors.out,
+                data_ctx.workSpace,
+                data_ctx.workSpaceSize,
+                [&](ConstData_t in, ConstData_t w, Data_t out, Data_t) {
+                    return RunImplGemmDynamic(handle, launches, in, w, out, ks);
+                });
             if(handle.IsProfilingEnabled())
             {
                 handle.ResetKernelTime();
@@ -275,8 +409,9 @@ InvokerFactory MakeImplGemmDynamicForwardInvokerFactory(const ConvolutionContext
 
 InvokerFactory MakeImplGemmDynamicForward1x1InvokerFactory(const ConvolutionContext& ctx)
 {
-    const auto& conv_problem = ctx.conv_problem;
-    return [conv_problem](const std::vector<Kernel>& kernels) {
+    // Packed once, only the buffer pointers are patched per call.
+    const auto launches = MakeImplGemmDynamicForward1x1Args(ctx.conv_problem);
+    return [launches](const std::vector<Kernel>& kernels) {
         return [=](const Handle& handle, const AnyInvokeParams& primitive_parameters) {
             decltype(auto) data_ctx = primitive_parameters.CastTo<conv::DataInvokeParams>();
             const auto& tensors     = data_ctx.tensors;
@@ -287,9 +422,19 @@ InvokerFactory MakeImplGemmDynamicForward1x1InvokerFactory(const ConvolutionCont
                            kernels.end(),
                            std::back_inserter(ks),
                            [&](const Kernel& k) { return handle.Run(k); });
-            float elapsed = 0;
-            elapsed       = CallImplGemmDynamicForward1x1(
-                handle, conv_problem, tensors.in, tensors.out, tensors.w, ks);
+            const auto elapsed = RunImplGemmDynamicOnFp32(
+                handle,
+                tensors.inDesc,
+                tensors.in,
+                tensors.wDesc,
+                tensors.w,
+                tensors.outDesc,
+                tensors.out,
+                data_ctx.workSpace,
+                data_ctx.workSpaceSize,
+                [&](ConstData_t in, ConstData_t w, Data_t out, Data_t) {
+                    return RunImplGemmDynamic(handle, launches, in, w, out, ks);
+                });
             if(handle.IsProfilingEnabled())
             {
                 handle.ResetKernelTime();
@@ -301,8 +446,9 @@ InvokerFactory MakeImplGemmDynamicForward1x1InvokerFactory(const ConvolutionCont
 
 InvokerFactory MakeImplGemmDynamicBackwardDataInvokerFactory(const ConvolutionContext& ctx)
 {
-    const auto& conv_problem = ctx.conv_problem;
-    return [conv_problem](const std::vector<Kernel>& kernels) {
+    // Packed once, only the buffer pointers are patched per call.
+    const auto launches = MakeImplGemmDynamicBackwardDataArgs(ctx.conv_problem);
+    return [launches](const std::vector<Kernel>& kernels) {
         return [=](const Handle& handle, const AnyInvokeParams& primitive_parameters) {
             decltype(auto) data_ctx = primitive_parameters.CastTo<conv::DataInvokeParams>();
             const auto& tensors     = data_ctx.tensors;
@@ -313,10 +459,20 @@ InvokerFactory MakeImplGemmDynamicBackwardDataInvokerFactory(const ConvolutionCo
                            kernels.end(),
                            std::back_inserter(ks),
                            [&](const Kernel& k) { return handle.Run(k); });
-            float elapsed = 0;
-
-            elapsed = CallImplGemmDynamicBackwardData(
-                handle, conv_problem, tensors.in, tensors.out, tensors.w, ks);
+            // The backward data kernel takes its output first.
+            const auto elapsed = RunImplGemmDynamicOnFp32(
+                handle,
+                tensors.inDesc,
+                tensors.in,
+                tensors.wDesc,
+                tensors.w,
+                tensors.outDesc,
+                tensors.out,
+                data_ctx.workSpace,
+                data_ctx.workSpaceSize,
+                [&](ConstData_t in, ConstData_t w, Data_t out, Data_t) {
+                    return RunImplGemmDynamic(handle, launches, out, w, in, ks);
+                });
 
             if(handle.IsProfilingEnabled())
             {
@@ -0,0 +1,312 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv/perf_model.hpp>
+
+#include <miopen/conv/context.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/stringutils.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace conv {
+
+namespace {
+
+/// The model ranks candidates against each other, so a single nominal engine clock
+/// is good enough for all devices.
+constexpr double nominal_clock_hz = 1.5e9;
+/// Host-side cost of enqueueing one kernel, ms.
+constexpr double launch_overhead_ms = 0.005;
+
+struct DeviceProperties
+{
+    std::size_t n_cu    = 1;
+    double flops_per_ms = 0.0; // Peak of the vector ALUs for the data type of the problem.
+    double bytes_per_ms = 0.0;
+    double xdlops_gain  = 1.0; // Speedup of the matrix cores over vector ALUs, if any.
+};
+
+DeviceProperties GetDeviceProperties(const ConvolutionContext& ctx)
+{
+    const auto& handle = ctx.GetStream();
+    const auto name    = handle.GetDeviceName();
+    const auto type    = ctx.conv_problem.GetInDataType();
+    const auto is_int8 = type == miopenInt8 || type == miopenInt8x4;
+
+    DeviceProperties dev;
+    dev.n_cu = std::max<std::size_t>(handle.GetMaxComputeUnits(), 1);
+
+    // 64 lanes per CU, FMA counts as 2 FLOPs.
+    auto flops = static_cast<double>(dev.n_cu) * 64 * 2 * nominal_clock_hz;
+    if(type == miopenHalf && !StartsWith(name, "gfx803"))
+        flops *= 2; // Packed math.
+    if(is_int8 && (StartsWith(name, "gfx906") || StartsWith(name, "gfx908")))
+        flops *= 4; // Dot4 instructions.
+    dev.flops_per_ms = flops * 1e-3;
+
+    auto bandwidth = 512e9;
+    if(StartsWith(name, "gfx900"))
+        bandwidth = 484e9;
+    else if(StartsWith(name, "gfx906"))
+        bandwidth = 1024e9;
+    else if(StartsWith(name, "gfx908"))
+        bandwidth = 1228e9;
+    dev.bytes_per_ms = bandwidth * 1e-3;
+
+    if(StartsWith(name, "gfx908"))
+        dev.xdlops_gain = (type == miopenFloat || is_int8) ? 2.0 : 4.0;
+    return dev;
+}
+
+/// Convolution expressed as the (per group) GEMM that implicit and explicit GEMM
+/// solvers compute.
+struct GemmShape
+{
+    double m          = 1.0;
+    double n          = 1.0;
+    double k          = 1.0;
+    double batch      = 1.0; // Independent GEMMs, i.e. groups.
+    double images     = 1.0;
+    double filter     = 1.0; // Filter spatial size, a part of m, n or k.
+    double filter_h   = 1.0;
+    double filter_w   = 1.0;
+    double out_pixels = 1.0; // Spatial size of forward output, a part of n or k.
+};
+
+GemmShape GetGemmShape(const ProblemDescription& problem)
+{
+    // The input of the backward problems is dy and their output is x or dw, so the shape is
+    // built from the tensors of the forward convolution.
+    const auto dims    = problem.GetSpatialDims();
+    const auto forward = problem.GetDirection() == Direction::Forward;
+    const auto& x      = (forward ? problem.GetIn() : problem.GetOut()).GetLengths();
+    const auto& y      = (forward ? problem.GetOut() : problem.GetIn()).GetLengths();
+
+    const auto g = static_cast<double>(problem.GetGroupCount());
+    const auto c = static_cast<double>(GetC5(dims, x));
+    const auto k = static_cast<double>(GetC5(dims, y));
+    const auto n = static_cast<double>(GetN5(dims, x));
+
+    GemmShape shape;
+    shape.batch    = g;
+    shape.images   = n;
+    shape.filter_h = static_cast<double>(problem.GetWeightsHeight());
+    shape.filter_w = static_cast<double>(problem.GetWeightsWidth());
+    shape.filter   = shape.filter_h * shape.filter_w;
+    shape.filter *= static_cast<double>(problem.GetWeightsDepth());
+
+    shape.out_pixels = static_cast<double>(GetH5(dims, y) * GetW5(dims, y));
+    shape.out_pixels *= static_cast<double>(GetD5(dims, y));
+
+    switch(problem.GetDirection())
+    {
+    case Direction::Forward:
+        shape.m = k / g;
+        shape.n = n * shape.out_pixels;
+        shape.k = c / g * shape.filter;
+        break;
+    case Direction::BackwardData:
+        shape.m = c / g * shape.filter;
+        shape.n = n * shape.out_pixels;
+        shape.k = k / g;
+        break;
+    case Direction::BackwardWeights:
+        shape.m = k / g;
+        shape.n = c / g * shape.filter;
+        shape.k = n * shape.out_pixels;
+        break;
+    }
+    return shape;
+}
+
+/// Solver-specific parameters of the model.
+struct ModelParams
+{
+    double efficiency    = 0.3; // Fraction of the peak reached by the main loop.
+    double flops_scale   = 1.0; // Executed FLOPs relative to the direct convolution.
+    double tile_m        = 1.0; // Macro tile of the GEMM, defines tile waste and occupancy.
+    double tile_n        = 1.0;
+    double gemm_launches = 1.0; // Sequential GEMMs the problem is split into.
+    bool xdlops          = false;
+    bool persistent      = false; // Grid is sized by the number of CUs, not by the problem.
+    std::size_t kernels  = 1;
+};
+
+/// Returns the integer template arguments encoded in the solver id, e.g. {3, 4} for
+/// "ConvWinograd3x3MultipassWrW<3-4>".
+std::vector<int> GetTemplateArgs(const std::string& id)
+{
+    std::vector<int> args;
+    const auto begin = id.find('<');
+    const auto end   = id.find('>', begin);
+    if(begin == std::string::npos || end == std::string::npos)
+        return args;
+
+    std::istringstream ss(id.substr(begin + 1, end - begin - 1));
+    std::string arg;
+    while(std::getline(ss, arg, '-'))
+        args.push_back(std::stoi(arg));
+    return args;
+}
+
+/// Arithmetic gain of Winograd F(tile, filter) along one dimension.
+double WinogradGain(double tile, double filter) { return tile * filter / (tile + filter - 1.0); }
+
+/// Single-pass Winograd binaries decompose the filter into pieces of the native size.
+double WinogradPaddedFilter(double filter, double native)
+{
+    return std::ceil(filter / native) * native / filter;
+}
+
+ModelParams GetModelParams(const std::string& id, const GemmShape& shape, std::size_t workspace)
+{
+    ModelParams p;
+    if(workspace > 0)
+        p.kernels = 2; // Auxiliary transform or reduction of the workspace.
+
+    if(id == "gemm")
+    {
+        p.efficiency = 0.6;
+        p.tile_m     = 64;
+        p.tile_n     = 64;
+        if(workspace > 0)
+        {
+            // Non-1x1 convolutions go through im2col/col2im image by image.
+            p.gemm_launches = shape.images;
+            p.kernels       = static_cast<std::size_t>(2 * shape.images);
+        }
+    }
+    else if(StartsWith(id, "ConvAsmImplicitGemm") || StartsWith(id, "ConvHipImplicitGemm"))
+    {
+        p.efficiency = StartsWith(id, "ConvAsm") ? 0.55 : 0.45;
+        p.tile_m     = 128;
+        p.tile_n     = 128;
+        p.xdlops     = id.find("Xdlops") != std::string::npos;
+        if(p.xdlops)
+            p.efficiency = 0.5;
+    }
+    else if(StartsWith(id, "ConvBinWinograd"))
+    {
+        // Fixed-grid binaries: F(2,3) unless the id says otherwise.
+        auto tile   = 2.0;
+        auto filter = 3.0;
+        if(EndsWith(id, "f3x2"))
+        {
+            tile   = 3.0;
+            filter = 2.0;
+        }
+        p.efficiency  = 0.7;
+        p.persistent  = true;
+        p.flops_scale = WinogradPaddedFilter(shape.filter_h, filter) *
+                        WinogradPaddedFilter(shape.filter_w, filter) /
+                        (WinogradGain(tile, filter) * WinogradGain(tile, filter));
+    }
+    else if(StartsWith(id, "ConvMPBidirectWinograd") ||
+            StartsWith(id, "ConvWinograd3x3MultipassWrW"))
+    {
+        // Transforms around a GEMM in the Winograd domain.
+        const auto args = GetTemplateArgs(id);
+        if(args.size() >= 2)
+        {
+            const auto gain_h = WinogradGain(args[0], args[1]);
+            const auto gain_w = args.size() >= 4 ? WinogradGain(args[2], args[3]) : gain_h;
+            p.flops_scale     = 1.0 / (gain_h * gain_w);
+        }
+        p.efficiency = 0.6;
+        p.tile_m     = 64;
+        p.tile_n     = 64;
+        p.kernels    = 4;
+    }
+    else if(StartsWith(id, "ConvDirectNaiveConv"))
+    {
+        p.efficiency = 0.02;
+    }
+    else if(StartsWith(id, "ConvAsm") || StartsWith(id, "ConvBiasActivAsm"))
+    {
+        p.efficiency = 0.4;
+    }
+    return p;
+}
+
+double TileUtilization(double size, double tile)
+{
+    return size / (std::ceil(size / tile) * tile);
+}
+
+} // namespace
+
+float EstimateSolverTime(const ConvolutionContext& ctx,
+                         const solver::Id& solver_id,
+                         std::size_t workspace_size)
+{
+    if(!solver_id.IsValid() || solver_id == solver::Id::fft())
+        return -1.0f;
+
+    const auto& problem = ctx.conv_problem;
+    const auto dev      = GetDeviceProperties(ctx);
+    const auto shape    = GetGemmShape(problem);
+    const auto p        = GetModelParams(solver_id.ToString(), shape, workspace_size);
+
+    const auto flops = 2.0 * shape.m * shape.n * shape.k * shape.batch * p.flops_scale;
+
+    // Part of the GEMM that is done by one launch. WrW splits the reduction dimension
+    // which does not affect the tiling.
+    const auto wrw     = problem.GetDirection() == Direction::BackwardWeights;
+    const auto m       = shape.m;
+    const auto n       = wrw ? shape.n : shape.n / p.gemm_launches;
+    const auto utilize = TileUtilization(m, p.tile_m) * TileUtilization(n, p.tile_n);
+
+    auto occupancy = 1.0;
+    if(!p.persistent)
+    {
+        const auto tiles = std::ceil(m / p.tile_m) * std::ceil(n / p.tile_n) * shape.batch;
+        const auto waves = std::ceil(tiles / dev.n_cu);
+        occupancy        = tiles / (waves * dev.n_cu);
+    }
+
+    const auto peak       = dev.flops_per_ms * (p.xdlops ? dev.xdlops_gain : 1.0);
+    const auto compute_ms = flops / (peak * p.efficiency * utilize * occupancy);
+
+    // Tensors are read (written) once, the workspace is written and read back.
+    const auto bytes = static_cast<double>(problem.GetInSize() + problem.GetWeightsSize() +
+                                           problem.GetOutSize() + 2 * workspace_size);
+    const auto memory_ms = bytes / dev.bytes_per_ms;
+
+    auto launch_ms = static_cast<double>(p.kernels) * launch_overhead_ms;
+    if(problem.GetConv().prefer_latency)
+        launch_ms += static_cast<double>(p.kernels - 1) * kernel_gap_ms;
+
+    return static_cast<float>(std::max(compute_ms, memory_ms) + launch_ms);
+}
+
+} // namespace conv
+} // namespace miopen
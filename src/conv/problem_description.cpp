@@ -28,9 +28,13 @@
 
 #include <miopen/conv/data_invoke_params.hpp>
 #include <miopen/conv/wrw_invoke_params.hpp>
+#include <miopen/env.hpp>
 
+#include <algorithm>
 #include <sstream>
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_CONV_CANONICAL_PROBLEMS)
+
 namespace miopen {
 
 std::string
@@ -59,6 +63,69 @@ std::ostream& operator<<(std::ostream& stream, std::function<void(std::ostream&)
     return stream;
 }
 
+// Weights and output layouts are only spelled out if some tensor is not in the default
+// layout, to keep the existing keys intact.
+static std::string GetExtraLayouts(const ProblemDescription& problem)
+{
+    if(problem.IsLayoutDefault())
+        return "";
+    const auto weights = problem.GetWeightsLayout();
+    return "w" + (weights.empty() ? std::string{"NCHW"} : weights) + "o" + problem.GetOutLayout();
+}
+
+/// Whether the height and the width of the tensor are one dimension of the memory.
+static bool IsSpatiallyMergeable(const TensorDescriptor& desc)
+{
+    const auto& lens    = desc.GetLengths();
+    const auto& strides = desc.GetStrides();
+    return lens.size() == 4 && strides[2] == lens[3] * strides[3];
+}
+
+static TensorDescriptor TransposeSpatially(const TensorDescriptor& desc)
+{
+    const auto& lens    = desc.GetLengths();
+    const auto& strides = desc.GetStrides();
+    return {desc.GetType(),
+            std::vector<std::size_t>{lens[0], lens[1], lens[3], lens[2]},
+            std::vector<std::size_t>{strides[0], strides[1], lens[2] * strides[3], strides[3]}};
+}
+
+bool CanonicalizeTensors(const ConvolutionDescriptor& conv,
+                         const TensorDescriptor& weights,
+                         TensorDescriptor& in,
+                         TensorDescriptor& out)
+{
+    if(!miopen::IsEnabled(MIOPEN_CONV_CANONICAL_PROBLEMS{}))
+        return false;
+    if(conv.GetSpatialDimension() != 2 || conv.paddingMode != miopenPaddingDefault)
+        return false;
+    // Vectorized tensors keep four channels in the innermost dimension.
+    if(in.GetType() == miopenInt8x4 || out.GetType() == miopenInt8x4)
+        return false;
+
+    const auto is_zero = [](int v) { return v == 0; };
+    const auto is_one  = [](int v) { return v == 1; };
+    if(!std::all_of(conv.GetConvPads().begin(), conv.GetConvPads().end(), is_zero) ||
+       !std::all_of(conv.GetConvStrides().begin(), conv.GetConvStrides().end(), is_one) ||
+       !std::all_of(conv.trans_output_pads.begin(), conv.trans_output_pads.end(), is_zero))
+        return false;
+
+    const auto& w_lens   = weights.GetLengths();
+    const auto& in_lens  = in.GetLengths();
+    const auto& out_lens = out.GetLengths();
+    if(w_lens.size() != 4 || w_lens[2] != 1 || w_lens[3] != 1)
+        return false;
+    if(in_lens.size() != 4 || out_lens.size() != 4 || in_lens[2] != out_lens[2] ||
+       in_lens[3] != out_lens[3])
+        return false;
+    if(in_lens[2] <= in_lens[3] || !IsSpatiallyMergeable(in) || !IsSpatiallyMergeable(out))
+        return false;
+
+    in  = TransposeSpatially(in);
+    out = TransposeSpatially(out);
+    return true;
+}
+
 void ProblemDescription::BuildConfKey(std::string& conf_key) const
 {
     std::ostringstream ss;
@@ -70,7 +137,7 @@ void ProblemDescription::BuildConfKey(std::string& conf_key) const
     ss << 'x' << GetOutChannels();
     ss << 'x' << PrintDHW('x', GetSpatialDims(), GetOutDepth(), GetOutHeight(), GetOutWidth());
     ss << 'x' << GetInBatchSize();
-    ss << 'x' << GetInLayout();
+    ss << 'x' << GetInLayout() << GetExtraLayouts(*this);
     ss << 'x' << EncodeDataTypesForKey(GetInDataType(), GetWeightsDataType(), GetOutDataType());
     ss << 'x' << PrintDHW('x', GetSpatialDims(), GetPadD(), GetPadH(), GetPadW());
     ss << 'x'
@@ -85,10 +152,35 @@ void ProblemDescription::BuildConfKey(std::string& conf_key) const
     case Direction::BackwardData: ss << 'x' << "B"; break;
     case Direction::BackwardWeights: ss << 'x' << "W"; break;
     }
+    if(conv.prefer_latency)
+        ss << 'x' << "L";
+    if(deterministic)
+        ss << 'x' << "D";
 
     conf_key = ss.str();
 }
 
+boost::optional<ProblemDescription> ProblemDescription::WithBatchSize(std::size_t n) const
+{
+    const auto with_batch_size = [n](const TensorDescriptor& desc) {
+        auto lengths = desc.GetLengths();
+        lengths[0]   = n;
+        // The other strides do not depend on the batch size when it is the outermost.
+        return TensorDescriptor{desc.GetType(), lengths, desc.GetStrides()};
+    };
+    const auto is_batch_outermost = [](const TensorDescriptor& desc) {
+        const auto& strides = desc.GetStrides();
+        return std::max_element(strides.begin(), strides.end()) == strides.begin();
+    };
+
+    if(n == 0 || !is_batch_outermost(in) || !is_batch_outermost(out))
+        return boost::none;
+    auto result = *this;
+    result.in   = with_batch_size(in);
+    result.out  = with_batch_size(out);
+    return result;
+}
+
 void ProblemDescription::Serialize(std::ostream& stream) const
 {
     const auto sep = '-';
@@ -123,6 +215,11 @@ void ProblemDescription::Serialize(std::ostream& stream) const
         if(GetGroupCount() != 1)
             optional << 'g' << GetGroupCount();
     }
+    optional << GetExtraLayouts(*this);
+    if(conv.prefer_latency)
+        optional << 'l';
+    if(deterministic)
+        optional << 'd';
     if(!optional.str().empty())
     {
         stream << '_' << optional.str();
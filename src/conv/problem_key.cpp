@@ -0,0 +1,96 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv/problem_key.hpp>
+
+#include <miopen/convolution.hpp>
+#include <miopen/tensor.hpp>
+
+namespace miopen {
+namespace conv {
+
+ProblemKey::ProblemKey(const TensorDescriptor& x,
+                       const TensorDescriptor& w,
+                       const TensorDescriptor& y,
+                       const ConvolutionDescriptor& conv,
+                       Direction direction,
+                       bool deterministic)
+{
+    auto it = values.begin();
+
+    const auto add_tensor = [&](const TensorDescriptor& desc) {
+        const auto& lens    = desc.GetLengths();
+        const auto& strides = desc.GetStrides();
+        if(lens.size() > max_tensor_dims)
+        {
+            is_valid = false;
+            return;
+        }
+        *it++ = desc.GetType();
+        *it++ = lens.size();
+        std::copy(lens.begin(), lens.end(), it);
+        std::copy(strides.begin(), strides.end(), it + max_tensor_dims);
+        it += 2 * max_tensor_dims;
+    };
+    const auto add_spatial = [&](const std::vector<int>& params) {
+        if(params.size() > max_spatial_dims)
+        {
+            is_valid = false;
+            return;
+        }
+        // The parameters are stored as 32-bit, as negative pads shall not alias large ones.
+        for(std::size_t i = 0; i < params.size(); ++i)
+            it[i] = static_cast<std::uint32_t>(params[i]);
+        it += max_spatial_dims;
+    };
+
+    add_tensor(x);
+    add_tensor(w);
+    add_tensor(y);
+    *it++ = conv.GetSpatialDimension();
+    *it++ = conv.mode;
+    *it++ = conv.paddingMode;
+    *it++ = static_cast<std::uint32_t>(conv.GetGroupCount());
+    add_spatial(conv.GetConvPads());
+    add_spatial(conv.GetConvStrides());
+    add_spatial(conv.GetConvDilations());
+    add_spatial(conv.GetTransposeConvPads());
+    *it++ = static_cast<std::uint64_t>(direction);
+    *it++ = conv.prefer_latency ? 1 : 0;
+    *it++ = deterministic ? 1 : 0;
+
+    if(!is_valid)
+        return;
+
+    // FNV-1a over the 64-bit words.
+    std::uint64_t h = 14695981039346656037ull;
+    for(const auto value : values)
+        h = (h ^ value) * 1099511628211ull;
+    hash = static_cast<std::size_t>(h);
+}
+
+} // namespace conv
+} // namespace miopen
@@ -0,0 +1,129 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/conv/solver_histograms.hpp>
+
+#include <miopen/env.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_SOLVER_HISTOGRAM_SAMPLE_PERIOD)
+
+namespace miopen {
+namespace conv {
+
+namespace {
+
+using Key = std::tuple<uint64_t, Direction, miopenDataType_t>;
+
+struct Histograms
+{
+    std::mutex mutex;
+    std::map<Key, miopenSolverHistogram_t> entries;
+};
+
+// Leaked, as the runs may be recorded from the destructors of other statics.
+Histograms& GetHistograms()
+{
+    static auto& histograms = *new Histograms{};
+    return histograms;
+}
+
+std::size_t GetBucket(float time_ms)
+{
+    const auto time_us = time_ms * 1000;
+    if(!(time_us >= 1)) // also NaN
+        return 0;
+    const auto bucket = static_cast<std::size_t>(std::floor(std::log2(time_us))) + 1;
+    return std::min<std::size_t>(bucket, MIOPEN_SOLVER_HISTOGRAM_BUCKETS - 1);
+}
+
+} // namespace
+
+bool IsSampledRun(const Handle& handle)
+{
+    if(handle.IsProfilingEnabled())
+        return true;
+    const auto period = Value(MIOPEN_SOLVER_HISTOGRAM_SAMPLE_PERIOD{}, 1000);
+    if(period == 0)
+        return false;
+    thread_local auto runs = 0ul;
+    return ++runs % period == 0;
+}
+
+void RecordSolverTime(solver::Id solver, Direction direction, miopenDataType_t type, float time_ms)
+{
+    if(!solver.IsValid())
+        return;
+
+    auto& histograms = GetHistograms();
+    const auto key   = Key{solver.Value(), direction, type};
+    std::lock_guard<std::mutex> lock{histograms.mutex};
+    auto found = histograms.entries.find(key);
+
+    if(found == histograms.entries.end())
+    {
+        auto entry      = miopenSolverHistogram_t{};
+        entry.solverId  = solver.Value();
+        entry.direction = static_cast<miopenConvDirection_t>(direction);
+        entry.dataType  = type;
+        entry.minTimeMs = time_ms;
+        entry.maxTimeMs = time_ms;
+        found           = histograms.entries.emplace(key, entry).first;
+    }
+
+    auto& entry = found->second;
+    ++entry.count;
+    entry.totalTimeMs += time_ms;
+    entry.minTimeMs = std::min(entry.minTimeMs, time_ms);
+    entry.maxTimeMs = std::max(entry.maxTimeMs, time_ms);
+    ++entry.buckets[GetBucket(time_ms)];
+}
+
+std::vector<miopenSolverHistogram_t> GetSolverHistograms()
+{
+    auto& histograms = GetHistograms();
+    std::lock_guard<std::mutex> lock{histograms.mutex};
+    auto ret = std::vector<miopenSolverHistogram_t>{};
+    ret.reserve(histograms.entries.size());
+    for(const auto& entry : histograms.entries)
+        ret.push_back(entry.second);
+    return ret;
+}
+
+void ResetSolverHistograms()
+{
+    auto& histograms = GetHistograms();
+    std::lock_guard<std::mutex> lock{histograms.mutex};
+    histograms.entries.clear();
+}
+
+} // namespace conv
+} // namespace miopen
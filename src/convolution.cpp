@@ -52,6 +52,7 @@ MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_DIRECT)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_WINOGRAD)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_GEMM)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_WRW_BIAS_FUSION)
 
 // Workaround for issue 1430.
 // Vega20 fails to access GPU memory larger than the return value of GetMaxMemoryAllocSize() of
@@ -456,8 +457,9 @@ std::size_t ConvolutionDescriptor::ForwardGetWorkSpaceSize(Handle& handle,
         /// actually required workspace here.
         size_t count;
         miopenConvSolution_t sol;
-        GetForwardSolutions(handle, wDesc, xDesc, yDesc, 1, &count, &sol);
-        if(count < 1 || (fm.IsHybrid() && sol.time < 0))
+        bool fallback;
+        GetForwardSolutions(handle, wDesc, xDesc, yDesc, 1, &count, &sol, &fallback);
+        if(count < 1 || (fm.IsHybrid() && fallback))
         {
             ctx.skip_solutions_that_take_long_time_to_build_and_have_narrow_coverage =
                 fm.IsFastHybrid();
@@ -557,8 +559,9 @@ ConvolutionDescriptor::BackwardDataGetWorkSpaceSize(Handle& handle,
         /// \ref ffind_gwss_why_not_0
         size_t count;
         miopenConvSolution_t sol;
-        GetBackwardSolutions(handle, dyDesc, wDesc, dxDesc, 1, &count, &sol);
-        if(count < 1 || (fm.IsHybrid() && sol.time < 0))
+        bool fallback;
+        GetBackwardSolutions(handle, dyDesc, wDesc, dxDesc, 1, &count, &sol, &fallback);
+        if(count < 1 || (fm.IsHybrid() && fallback))
         {
             ctx.skip_solutions_that_take_long_time_to_build_and_have_narrow_coverage =
                 fm.IsFastHybrid();
@@ -887,15 +890,16 @@ ConvolutionDescriptor::BackwardWeightsGetWorkSpaceSize(Handle& handle,
                                                        const TensorDescriptor& dwDesc) const
 {
     MIOPEN_LOG_I("");
-    auto ctx = ConvolutionContext(xDesc, dwDesc, dyDesc, *this, conv::Direction::BackwardWeights);
+    auto ctx = ConvolutionContext(MakeWrwProblem(handle, dyDesc, xDesc, dwDesc));
     const miopen::FindMode fm(ctx);
     while(fm.IsFast() || fm.IsHybrid())
     {
         /// \ref ffind_gwss_why_not_0
         size_t count;
         miopenConvSolution_t sol;
-        GetWrwSolutions(handle, dyDesc, xDesc, dwDesc, 1, &count, &sol);
-        if(count < 1 || (fm.IsHybrid() && sol.time < 0))
+        bool fallback;
+        GetWrwSolutions(handle, dyDesc, xDesc, dwDesc, 1, &count, &sol, &fallback);
+        if(count < 1 || (fm.IsHybrid() && fallback))
         {
             ctx.skip_solutions_that_take_long_time_to_build_and_have_narrow_coverage =
                 fm.IsFastHybrid();
@@ -931,6 +935,67 @@ ConvolutionDescriptor::BackwardWeightsGetWorkSpaceSize(Handle& handle,
     return workspace_size;
 }
 
+std::size_t
+ConvolutionDescriptor::BackwardWeightsBiasGetWorkSpaceSizeGEMM(const TensorDescriptor& dyDesc,
+                                                               const TensorDescriptor& dwDesc) const
+{
+#if MIOPEN_USE_GEMM
+    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM{}) ||
+       miopen::IsDisabled(MIOPEN_DEBUG_CONV_WRW_BIAS_FUSION{}))
+        return 0;
+
+    // The bias gradient of a transposed convolution is taken over x, which the weights GEMM
+    // does not reduce, and grouped GEMMs write dw with a fixed leading dimension.
+    if(mode == miopenTranspose || group_count > 1 || dyDesc.GetType() == miopenBFloat16)
+        return 0;
+
+    // 1x1 stride 1 convolutions multiply x directly, there is no im2col buffer to extend.
+    if(BackwardWeightsGetWorkSpaceSizeGEMM(dyDesc, dwDesc) == 0)
+        return 0;
+
+    const std::size_t spatial_dim = GetSpatialDimension();
+
+    auto out_spatial = boost::adaptors::slice(dyDesc.GetLengths(), 2, 2 + spatial_dim);
+    auto wei_spatial = boost::adaptors::slice(dwDesc.GetLengths(), 2, 2 + spatial_dim);
+
+    const std::size_t wei_k = dwDesc.GetLengths()[0];
+    const std::size_t wei_c = dwDesc.GetLengths()[1];
+
+    const std::size_t out_spatial_size = std::accumulate(
+        out_spatial.begin(), out_spatial.end(), std::size_t(1), std::multiplies<std::size_t>());
+    const std::size_t gemm_n = wei_c * std::accumulate(wei_spatial.begin(),
+                                                       wei_spatial.end(),
+                                                       std::size_t(1),
+                                                       std::multiplies<std::size_t>()) +
+                               1;
+
+    // im2col(x) followed by a row of ones, then dw with db as its last column.
+    return GetTypeSize(dyDesc.GetType()) * (gemm_n * out_spatial_size + wei_k * gemm_n);
+#else
+    std::ignore = dyDesc;
+    std::ignore = dwDesc;
+    return 0;
+#endif
+}
+
+std::size_t
+ConvolutionDescriptor::BackwardWeightsBiasGetWorkSpaceSize(Handle& handle,
+                                                           const TensorDescriptor& dyDesc,
+                                                           const TensorDescriptor& xDesc,
+                                                           const TensorDescriptor& dwDesc) const
+{
+    MIOPEN_LOG_I("");
+    std::size_t workspace_size_fused = BackwardWeightsBiasGetWorkSpaceSizeGEMM(dyDesc, dwDesc);
+    /// \todo WORKAROUND for issue 1430
+    if(workspace_size_fused > MAX_MEM_ALLOC_SZ /* handle.GetMaxMemoryAllocSize() */)
+        workspace_size_fused = 0;
+
+    const std::size_t workspace_size = std::max(
+        BackwardWeightsGetWorkSpaceSize(handle, dyDesc, xDesc, dwDesc), workspace_size_fused);
+    MIOPEN_LOG_I2(workspace_size);
+    return workspace_size;
+}
+
 std::ostream& operator<<(std::ostream& stream, const ConvolutionDescriptor& c)
 {
     stream << "conv" << c.spatialDim << "d, ";
@@ -953,6 +1018,11 @@ std::ostream& operator<<(std::ostream& stream, const ConvolutionDescriptor& c)
         LogRange(stream << "{", c.GetTransposeConvPads(), ", ") << "}, ";
     }
 
+    if(c.prefer_latency)
+    {
+        stream << "latency, ";
+    }
+
     return stream;
 }
 } // namespace miopen
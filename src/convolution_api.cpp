@@ -23,11 +23,18 @@
  * SOFTWARE.
  *
  *******************************************************************************/
+#include <miopen/call_record.hpp>
+#include <miopen/conv/batched.hpp>
+#include <miopen/conv/find_future.hpp>
+#include <miopen/conv/plan.hpp>
+#include <miopen/conv/solver_histograms.hpp>
 #include <miopen/convolution.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/problem_description.hpp>
 #include <miopen/tensor_ops.hpp>
+#include <miopen/tuning_bundle.hpp>
 #include <algorithm>
 
 // TODO: Make miopenConvAlgoPerf_t loggable
@@ -90,6 +97,38 @@ extern "C" miopenStatus_t miopenSetConvolutionGroupCount(miopenConvolutionDescri
     return miopen::try_([&] { miopen::deref(convDesc).group_count = groupCount; });
 }
 
+extern "C" miopenStatus_t miopenSetConvolutionAttribute(miopenConvolutionDescriptor_t convDesc,
+                                                        const miopenConvolutionAttrib_t attr,
+                                                        int value)
+{
+    MIOPEN_LOG_FUNCTION(convDesc, attr, value);
+    return miopen::try_([&] {
+        switch(attr)
+        {
+        case MIOPEN_CONVOLUTION_ATTRIB_PREFER_LATENCY:
+            miopen::deref(convDesc).prefer_latency = value != 0;
+            break;
+        default: MIOPEN_THROW(miopenStatusBadParm, "Unknown convolution attribute");
+        }
+    });
+}
+
+extern "C" miopenStatus_t miopenGetConvolutionAttribute(miopenConvolutionDescriptor_t convDesc,
+                                                        const miopenConvolutionAttrib_t attr,
+                                                        int* value)
+{
+    MIOPEN_LOG_FUNCTION(convDesc, attr, value);
+    return miopen::try_([&] {
+        switch(attr)
+        {
+        case MIOPEN_CONVOLUTION_ATTRIB_PREFER_LATENCY:
+            miopen::deref(value) = miopen::deref(convDesc).prefer_latency ? 1 : 0;
+            break;
+        default: MIOPEN_THROW(miopenStatusBadParm, "Unknown convolution attribute");
+        }
+    });
+}
+
 extern "C" miopenStatus_t
 miopenSetTransposeConvOutputPadding(miopenConvolutionDescriptor_t convDesc, int adj_h, int adj_w)
 {
@@ -263,11 +302,49 @@ enum class ConvDirection
     WrW = 4
 };
 
+/// Saves the inputs of a convolution with the call record, see MIOPEN_RECORD_TENSORS, and
+/// returns the driver flags loading them. Tensors are named as in the forward direction.
+static std::string RecordConvInputs(miopenHandle_t handle,
+                                    const ConvDirection conv_dir,
+                                    const miopenTensorDescriptor_t xDesc,
+                                    const void* x,
+                                    const miopenTensorDescriptor_t wDesc,
+                                    const void* w,
+                                    const miopenTensorDescriptor_t yDesc,
+                                    const void* y)
+{
+    if(!miopen::call_record::IsSavingTensors())
+        return {};
+
+    const auto save = [&](const char* flag, miopenTensorDescriptor_t desc, const void* data) {
+        return std::string{" "} + flag + " " +
+               miopen::call_record::SaveTensor(
+                   miopen::deref(handle), miopen::deref(desc), DataCast(data));
+    };
+
+    // The flags are not to fail the call itself.
+    try
+    {
+        switch(conv_dir)
+        {
+        case ConvDirection::Fwd: return save("-d", xDesc, x) + save("-e", wDesc, w);
+        case ConvDirection::Bwd: return save("-e", wDesc, w) + save("-D", yDesc, y);
+        case ConvDirection::WrW: return save("-d", xDesc, x) + save("-D", yDesc, y);
+        }
+    }
+    catch(const miopen::Exception& ex)
+    {
+        MIOPEN_LOG_E("Unable to record the convolution inputs: " << ex.what());
+    }
+    return {};
+}
+
 static void LogCmdConvolution(const miopenTensorDescriptor_t xDesc,
                               const miopenTensorDescriptor_t wDesc,
                               const miopenConvolutionDescriptor_t convDesc,
                               const ConvDirection conv_dir,
-                              const bool is_immediate)
+                              const boost::optional<uint64_t>& solution_id,
+                              const std::string& data_flags = {})
 {
     if(miopen::IsLoggingCmd())
     {
@@ -333,8 +410,9 @@ static void LogCmdConvolution(const miopenTensorDescriptor_t xDesc,
             << " -t 1"; // clang-format on
         if(miopen::deref(xDesc).GetType() == miopenInt8x4)
             ss << " -Z 1";
-        if(is_immediate)
-            ss << " -S 0";
+        if(solution_id)
+            ss << " -S " << *solution_id;
+        ss << data_flags;
         MIOPEN_LOG_DRIVER_CMD(ss.str());
     }
 }
@@ -413,6 +491,72 @@ miopenFindConvolutionForwardAlgorithm(miopenHandle_t handle,
     });
 }
 
+extern "C" miopenStatus_t
+miopenFindConvolutionForwardAlgorithmAsync(miopenHandle_t handle,
+                                           const miopenTensorDescriptor_t xDesc,
+                                           const void* x,
+                                           const miopenTensorDescriptor_t wDesc,
+                                           const void* w,
+                                           const miopenConvolutionDescriptor_t convDesc,
+                                           const miopenTensorDescriptor_t yDesc,
+                                           void* y,
+                                           const int requestAlgoCount,
+                                           void* workSpace,
+                                           size_t workSpaceSize,
+                                           bool exhaustiveSearch,
+                                           miopenConvolutionFindFuture_t* future)
+{
+    MIOPEN_LOG_FUNCTION(handle,
+                        xDesc,
+                        x,
+                        wDesc,
+                        w,
+                        convDesc,
+                        yDesc,
+                        y,
+                        requestAlgoCount,
+                        workSpace,
+                        workSpaceSize,
+                        exhaustiveSearch,
+                        future);
+    return miopen::try_([&] {
+        miopen::deref(future) = new miopen::ConvolutionFindFuture(miopen::deref(handle),
+                                                                  miopen::deref(xDesc),
+                                                                  DataCast(x),
+                                                                  miopen::deref(wDesc),
+                                                                  DataCast(w),
+                                                                  miopen::deref(convDesc),
+                                                                  miopen::deref(yDesc),
+                                                                  DataCast(y),
+                                                                  requestAlgoCount,
+                                                                  DataCast(workSpace),
+                                                                  workSpaceSize,
+                                                                  exhaustiveSearch);
+    });
+}
+
+extern "C" miopenStatus_t
+miopenConvolutionFindFutureIsReady(const miopenConvolutionFindFuture_t future, bool* ready)
+{
+    MIOPEN_LOG_FUNCTION(future, ready);
+    return miopen::try_([&] { miopen::deref(ready) = miopen::deref(future).IsReady(); });
+}
+
+extern "C" miopenStatus_t
+miopenConvolutionFindFutureWait(const miopenConvolutionFindFuture_t future,
+                                int* returnedAlgoCount,
+                                miopenConvAlgoPerf_t* perfResults)
+{
+    MIOPEN_LOG_FUNCTION(future, returnedAlgoCount, perfResults);
+    return miopen::try_([&] { miopen::deref(future).Wait(returnedAlgoCount, perfResults); });
+}
+
+extern "C" miopenStatus_t miopenDestroyConvolutionFindFuture(miopenConvolutionFindFuture_t future)
+{
+    MIOPEN_LOG_FUNCTION(future);
+    return miopen::try_([&] { miopen_destroy_object(future); });
+}
+
 extern "C" miopenStatus_t miopenConvolutionForward(miopenHandle_t handle,
                                                    const void* alpha,
                                                    const miopenTensorDescriptor_t xDesc,
@@ -441,7 +585,13 @@ extern "C" miopenStatus_t miopenConvolutionForward(miopenHandle_t handle,
                         y,
                         workSpace,
                         workSpaceSize);
-    LogCmdConvolution(xDesc, wDesc, convDesc, ConvDirection::Fwd, false);
+    LogCmdConvolution(
+        xDesc,
+        wDesc,
+        convDesc,
+        ConvDirection::Fwd,
+        boost::none,
+        RecordConvInputs(handle, ConvDirection::Fwd, xDesc, x, wDesc, w, yDesc, y));
 
     /// workaround for previous trans conv logic
     if(miopen::deref(convDesc).mode == miopenTranspose)
@@ -565,6 +715,60 @@ miopenConvolutionForwardGetSolution(miopenHandle_t handle,
     });
 }
 
+extern "C" miopenStatus_t
+miopenConvolutionForwardGetSolutionWithinWorkspace(miopenHandle_t handle,
+                                                   const miopenTensorDescriptor_t wDesc,
+                                                   const miopenTensorDescriptor_t xDesc,
+                                                   const miopenConvolutionDescriptor_t convDesc,
+                                                   const miopenTensorDescriptor_t yDesc,
+                                                   const size_t workSpaceLimit,
+                                                   const size_t maxSolutionCount,
+                                                   size_t* solutionCount,
+                                                   miopenConvSolution_t* solutions)
+{
+    MIOPEN_LOG_FUNCTION(handle, wDesc, xDesc, convDesc, yDesc, workSpaceLimit, maxSolutionCount);
+    return miopen::try_([&] {
+        if(solutionCount == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "solutionCount cannot be nullptr");
+        if(solutions == nullptr && maxSolutionCount > 0)
+            MIOPEN_THROW(miopenStatusBadParm, "solutions cannot be nullptr");
+
+        auto&& conv = miopen::deref(convDesc);
+        auto&& h    = miopen::deref(handle);
+        auto count  = std::size_t{0};
+        std::vector<miopenConvSolution_t> all;
+        if(conv.mode == miopenTranspose)
+        {
+            all.resize(conv.GetBackwardSolutionCount(
+                h, miopen::deref(xDesc), miopen::deref(wDesc), miopen::deref(yDesc)));
+            conv.GetBackwardSolutions(h,
+                                      miopen::deref(xDesc),
+                                      miopen::deref(wDesc),
+                                      miopen::deref(yDesc),
+                                      all.size(),
+                                      &count,
+                                      all.data());
+        }
+        else
+        {
+            all.resize(conv.GetForwardSolutionCount(
+                h, miopen::deref(wDesc), miopen::deref(xDesc), miopen::deref(yDesc)));
+            conv.GetForwardSolutions(h,
+                                     miopen::deref(wDesc),
+                                     miopen::deref(xDesc),
+                                     miopen::deref(yDesc),
+                                     all.size(),
+                                     &count,
+                                     all.data());
+        }
+        all.resize(count);
+
+        const auto front = miopen::GetParetoSolutions(std::move(all), workSpaceLimit);
+        *solutionCount   = std::min(front.size(), maxSolutionCount);
+        std::copy_n(front.begin(), *solutionCount, solutions);
+    });
+}
+
 extern "C" miopenStatus_t
 miopenConvolutionForwardGetSolutionWorkspaceSize(miopenHandle_t handle,
                                                  const miopenTensorDescriptor_t wDesc,
@@ -618,6 +822,24 @@ miopenConvolutionForwardCompileSolution(miopenHandle_t handle,
     });
 }
 
+/// Serves the workspace from the arena of the handle if the caller did not provide any.
+template <class F>
+static void
+UseArenaWorkspace(miopenHandle_t handle, void*& workSpace, size_t& workSpaceSize, F get_size)
+{
+    const auto& h = miopen::deref(handle);
+    if(workSpace != nullptr || !h.IsWorkspaceArenaEnabled())
+        return;
+    auto size         = size_t{0};
+    const auto status = get_size(&size);
+    if(status != miopenStatusSuccess)
+        MIOPEN_THROW(status, "Failed to get the solution workspace size");
+    if(size == 0)
+        return;
+    workSpace     = h.GetArenaBuffer(miopen::WorkspaceArena::Slot::Workspace, size).get();
+    workSpaceSize = size;
+}
+
 extern "C" miopenStatus_t
 miopenConvolutionForwardImmediate(miopenHandle_t handle,
                                   const miopenTensorDescriptor_t wDesc,
@@ -633,9 +855,19 @@ miopenConvolutionForwardImmediate(miopenHandle_t handle,
 {
     MIOPEN_LOG_FUNCTION(
         handle, wDesc, w, xDesc, x, convDesc, yDesc, y, workSpace, workSpaceSize, solution_id);
-    LogCmdConvolution(xDesc, wDesc, convDesc, ConvDirection::Fwd, true);
+    LogCmdConvolution(
+        xDesc,
+        wDesc,
+        convDesc,
+        ConvDirection::Fwd,
+        solution_id,
+        RecordConvInputs(handle, ConvDirection::Fwd, xDesc, x, wDesc, w, yDesc, y));
 
     return miopen::try_([&] {
+        UseArenaWorkspace(handle, workSpace, workSpaceSize, [&](size_t* size) {
+            return miopenConvolutionForwardGetSolutionWorkspaceSize(
+                handle, wDesc, xDesc, convDesc, yDesc, solution_id, size);
+        });
         if(miopen::deref(convDesc).mode == miopenTranspose)
             miopen::deref(convDesc).ConvolutionBackwardImmediate(miopen::deref(handle),
                                                                  miopen::deref(xDesc),
@@ -785,8 +1017,18 @@ miopenConvolutionBackwardDataImmediate(miopenHandle_t handle,
 {
     MIOPEN_LOG_FUNCTION(
         handle, dyDesc, wDesc, convDesc, dxDesc, workSpace, workSpaceSize, solution_id);
-    LogCmdConvolution(dxDesc, wDesc, convDesc, ConvDirection::Bwd, true);
+    LogCmdConvolution(
+        dxDesc,
+        wDesc,
+        convDesc,
+        ConvDirection::Bwd,
+        solution_id,
+        RecordConvInputs(handle, ConvDirection::Bwd, dxDesc, dx, wDesc, w, dyDesc, dy));
     return miopen::try_([&] {
+        UseArenaWorkspace(handle, workSpace, workSpaceSize, [&](size_t* size) {
+            return miopenConvolutionBackwardDataGetSolutionWorkspaceSize(
+                handle, dyDesc, wDesc, convDesc, dxDesc, solution_id, size);
+        });
         if(miopen::deref(convDesc).mode == miopenTranspose)
             miopen::deref(convDesc).ConvolutionForwardImmediate(miopen::deref(handle),
                                                                 miopen::deref(wDesc),
@@ -933,8 +1175,18 @@ miopenConvolutionBackwardWeightsImmediate(miopenHandle_t handle,
 {
     MIOPEN_LOG_FUNCTION(
         handle, dyDesc, dy, xDesc, x, convDesc, dwDesc, dw, workSpace, workSpaceSize, solution_id);
-    LogCmdConvolution(xDesc, dwDesc, convDesc, ConvDirection::WrW, true);
+    LogCmdConvolution(
+        xDesc,
+        dwDesc,
+        convDesc,
+        ConvDirection::WrW,
+        solution_id,
+        RecordConvInputs(handle, ConvDirection::WrW, xDesc, x, dwDesc, dw, dyDesc, dy));
     return miopen::try_([&] {
+        UseArenaWorkspace(handle, workSpace, workSpaceSize, [&](size_t* size) {
+            return miopenConvolutionBackwardWeightsGetSolutionWorkspaceSize(
+                handle, dyDesc, xDesc, convDesc, dwDesc, solution_id, size);
+        });
         if(miopen::deref(convDesc).mode == miopenTranspose)
             miopen::deref(convDesc).ConvolutionWrwImmediate(miopen::deref(handle),
                                                             miopen::deref(xDesc),
@@ -960,6 +1212,219 @@ miopenConvolutionBackwardWeightsImmediate(miopenHandle_t handle,
     });
 }
 
+static miopen::conv::Direction ToConvDirection(miopenConvDirection_t dir, bool transposed)
+{
+    switch(dir)
+    {
+    case miopenConvDirectionForward:
+        return transposed ? miopen::conv::Direction::BackwardData
+                          : miopen::conv::Direction::Forward;
+    case miopenConvDirectionBackwardData:
+        return transposed ? miopen::conv::Direction::Forward
+                          : miopen::conv::Direction::BackwardData;
+    case miopenConvDirectionBackwardWeights: return miopen::conv::Direction::BackwardWeights;
+    }
+    MIOPEN_THROW(miopenStatusBadParm, "Unknown convolution direction");
+}
+
+static std::vector<miopen::ProblemDescription>
+ToProblemDescriptions(const miopenConvProblem_t* problems, size_t problemCount)
+{
+    std::vector<miopen::ProblemDescription> descriptions;
+    descriptions.reserve(problemCount);
+    for(auto i = std::size_t{0}; i < problemCount; ++i)
+    {
+        const auto& p         = problems[i];
+        const auto& conv      = miopen::deref(p.convDesc);
+        const auto transposed = conv.mode == miopenTranspose;
+        // Transposed convolutions run the opposite data direction, see CompileSolution APIs.
+        const auto& in  = miopen::deref(transposed ? p.yDesc : p.xDesc);
+        const auto& out = miopen::deref(transposed ? p.xDesc : p.yDesc);
+        descriptions.emplace_back(
+            in, miopen::deref(p.wDesc), out, conv, ToConvDirection(p.direction, transposed));
+    }
+    return descriptions;
+}
+
+extern "C" miopenStatus_t miopenConvolutionPrewarm(miopenHandle_t handle,
+                                                   const miopenConvProblem_t* problems,
+                                                   size_t problemCount)
+{
+    MIOPEN_LOG_FUNCTION(handle, problemCount);
+    return miopen::try_([&] {
+        if(problems == nullptr && problemCount != 0)
+            MIOPEN_THROW(miopenStatusBadParm, "problems cannot be nullptr");
+
+        miopen::PrewarmConvolutions(miopen::deref(handle),
+                                    ToProblemDescriptions(problems, problemCount));
+    });
+}
+
+extern "C" miopenStatus_t miopenExportTuningBundle(miopenHandle_t handle,
+                                                   const miopenConvProblem_t* problems,
+                                                   size_t problemCount,
+                                                   const char* path)
+{
+    MIOPEN_LOG_FUNCTION(handle, problemCount, path);
+    return miopen::try_([&] {
+        if(problems == nullptr && problemCount != 0)
+            MIOPEN_THROW(miopenStatusBadParm, "problems cannot be nullptr");
+        if(path == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "path cannot be nullptr");
+        miopen::ExportTuningBundle(
+            miopen::deref(handle), ToProblemDescriptions(problems, problemCount), path);
+    });
+}
+
+extern "C" miopenStatus_t miopenImportTuningBundle(miopenHandle_t handle, const char* path)
+{
+    MIOPEN_LOG_FUNCTION(handle, path);
+    return miopen::try_([&] {
+        if(path == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "path cannot be nullptr");
+        miopen::ImportTuningBundle(miopen::deref(handle), path);
+    });
+}
+
+extern "C" miopenStatus_t miopenCreateConvolutionPlan(miopenHandle_t handle,
+                                                      const miopenConvProblem_t* problem,
+                                                      const uint64_t solution_id,
+                                                      miopenConvolutionPlan_t* plan)
+{
+    MIOPEN_LOG_FUNCTION(handle, solution_id, plan);
+    return miopen::try_([&] {
+        const auto& p = miopen::deref(problem);
+        // The transposition is resolved by the plan, which exchanges x and y itself.
+        miopen::deref(plan) = new miopen::ConvolutionPlan(miopen::deref(handle),
+                                                          miopen::deref(p.xDesc),
+                                                          miopen::deref(p.wDesc),
+                                                          miopen::deref(p.yDesc),
+                                                          miopen::deref(p.convDesc),
+                                                          ToConvDirection(p.direction, false),
+                                                          solution_id);
+    });
+}
+
+extern "C" miopenStatus_t
+miopenGetConvolutionPlanWorkspaceSize(const miopenConvolutionPlan_t plan, size_t* workSpaceSize)
+{
+    MIOPEN_LOG_FUNCTION(plan, workSpaceSize);
+    return miopen::try_(
+        [&] { miopen::deref(workSpaceSize) = miopen::deref(plan).GetWorkspaceSize(); });
+}
+
+extern "C" miopenStatus_t miopenRunConvolutionPlan(miopenHandle_t handle,
+                                                   miopenConvolutionPlan_t plan,
+                                                   void* x,
+                                                   void* w,
+                                                   void* y,
+                                                   void* workSpace,
+                                                   size_t workSpaceSize)
+{
+    MIOPEN_LOG_FUNCTION(handle, plan, x, w, y, workSpace, workSpaceSize);
+    return miopen::try_([&] {
+        miopen::deref(plan).Run(miopen::deref(handle),
+                                DataCast(x),
+                                DataCast(w),
+                                DataCast(y),
+                                DataCast(workSpace),
+                                workSpaceSize);
+    });
+}
+
+extern "C" miopenStatus_t miopenDestroyConvolutionPlan(miopenConvolutionPlan_t plan)
+{
+    MIOPEN_LOG_FUNCTION(plan);
+    return miopen::try_([&] { miopen_destroy_object(plan); });
+}
+
+extern "C" miopenStatus_t
+miopenConvolutionForwardBatchedGetWorkSpaceSize(miopenHandle_t handle,
+                                                const miopenTensorDescriptor_t wDesc,
+                                                const miopenTensorDescriptor_t xDesc,
+                                                const miopenConvolutionDescriptor_t convDesc,
+                                                const miopenTensorDescriptor_t yDesc,
+                                                int count,
+                                                size_t* workSpaceSize)
+{
+    MIOPEN_LOG_FUNCTION(handle, wDesc, xDesc, convDesc, yDesc, count, workSpaceSize);
+    return miopen::try_([&] {
+        if(count < 0)
+            MIOPEN_THROW(miopenStatusBadParm, "count cannot be negative");
+        miopen::deref(workSpaceSize) =
+            miopen::ConvolutionForwardBatchedGetWorkSpaceSize(miopen::deref(handle),
+                                                              miopen::deref(wDesc),
+                                                              miopen::deref(xDesc),
+                                                              miopen::deref(convDesc),
+                                                              miopen::deref(yDesc),
+                                                              count);
+    });
+}
+
+extern "C" miopenStatus_t
+miopenConvolutionForwardBatched(miopenHandle_t handle,
+                                const miopenTensorDescriptor_t xDesc,
+                                const void* const* x,
+                                const miopenTensorDescriptor_t wDesc,
+                                const void* const* w,
+                                const miopenConvolutionDescriptor_t convDesc,
+                                const miopenTensorDescriptor_t yDesc,
+                                void* const* y,
+                                int count,
+                                void* workSpace,
+                                size_t workSpaceSize)
+{
+    MIOPEN_LOG_FUNCTION(
+        handle, xDesc, x, wDesc, w, convDesc, yDesc, y, count, workSpace, workSpaceSize);
+    return miopen::try_([&] {
+        if(count < 0 || (count > 0 && (x == nullptr || w == nullptr || y == nullptr)))
+            MIOPEN_THROW(miopenStatusBadParm, "Invalid batched convolution buffers");
+        std::vector<ConstData_t> xs, ws;
+        std::vector<Data_t> ys;
+        for(auto i = 0; i < count; ++i)
+        {
+            xs.push_back(DataCast(x[i]));
+            ws.push_back(DataCast(w[i]));
+            ys.push_back(DataCast(y[i]));
+        }
+        miopen::ConvolutionForwardBatched(miopen::deref(handle),
+                                          miopen::deref(xDesc),
+                                          xs.data(),
+                                          miopen::deref(wDesc),
+                                          ws.data(),
+                                          miopen::deref(convDesc),
+                                          miopen::deref(yDesc),
+                                          ys.data(),
+                                          count,
+                                          DataCast(workSpace),
+                                          workSpaceSize);
+    });
+}
+
+extern "C" miopenStatus_t miopenGetSolverHistogramCount(size_t* count)
+{
+    return miopen::try_([&] { miopen::deref(count) = miopen::conv::GetSolverHistograms().size(); });
+}
+
+extern "C" miopenStatus_t miopenGetSolverHistograms(size_t maxCount,
+                                                    size_t* count,
+                                                    miopenSolverHistogram_t* histograms)
+{
+    MIOPEN_LOG_FUNCTION(maxCount);
+    return miopen::try_([&] {
+        if(histograms == nullptr && maxCount != 0)
+            MIOPEN_THROW(miopenStatusBadParm, "histograms cannot be nullptr");
+        const auto all       = miopen::conv::GetSolverHistograms();
+        miopen::deref(count) = std::min(maxCount, all.size());
+        std::copy_n(all.begin(), *count, histograms);
+    });
+}
+
+extern "C" miopenStatus_t miopenResetSolverHistograms()
+{
+    return miopen::try_([&] { miopen::conv::ResetSolverHistograms(); });
+}
+
 extern "C" miopenStatus_t
 miopenFindConvolutionBackwardDataAlgorithm(miopenHandle_t handle,
                                            const miopenTensorDescriptor_t dyDesc,
@@ -1063,7 +1528,13 @@ miopenConvolutionBackwardData(miopenHandle_t handle,
                         dx,
                         workSpace,
                         workSpaceSize);
-    LogCmdConvolution(dxDesc, wDesc, convDesc, ConvDirection::Bwd, false);
+    LogCmdConvolution(
+        dxDesc,
+        wDesc,
+        convDesc,
+        ConvDirection::Bwd,
+        boost::none,
+        RecordConvInputs(handle, ConvDirection::Bwd, dxDesc, dx, wDesc, w, dyDesc, dy));
 
     /// workaround for previous trans conv logic
     if(miopen::deref(convDesc).mode == miopenTranspose)
@@ -1176,7 +1647,7 @@ miopenFindConvolutionBackwardWeightsAlgorithm(miopenHandle_t handle,
                         workSpace,
                         workSpaceSize,
                         exhaustiveSearch);
-    LogCmdConvolution(xDesc, dwDesc, convDesc, ConvDirection::WrW, false);
+    LogCmdConvolution(xDesc, dwDesc, convDesc, ConvDirection::WrW, boost::none);
 
     return miopen::try_([&] {
         miopen::deref(convDesc).FindConvBwdWeightsAlgorithm(
@@ -1228,7 +1699,13 @@ miopenConvolutionBackwardWeights(miopenHandle_t handle,
                         dw,
                         workSpace,
                         workSpaceSize);
-    LogCmdConvolution(xDesc, dwDesc, convDesc, ConvDirection::WrW, false);
+    LogCmdConvolution(
+        xDesc,
+        dwDesc,
+        convDesc,
+        ConvDirection::WrW,
+        boost::none,
+        RecordConvInputs(handle, ConvDirection::WrW, xDesc, x, dwDesc, dw, dyDesc, dy));
 
     return miopen::try_([&] {
         miopen::deref(convDesc).ConvolutionBackwardWeights(
@@ -1276,3 +1753,93 @@ extern "C" miopenStatus_t miopenConvolutionBackwardBias(miopenHandle_t handle,
                                 DataCast(db));
     });
 }
+
+extern "C" miopenStatus_t
+miopenConvolutionBackwardWeightsBiasGetWorkSpaceSize(miopenHandle_t handle,
+                                                     const miopenTensorDescriptor_t dyDesc,
+                                                     const miopenTensorDescriptor_t xDesc,
+                                                     const miopenConvolutionDescriptor_t convDesc,
+                                                     const miopenTensorDescriptor_t dwDesc,
+                                                     size_t* workSpaceSize)
+{
+
+    MIOPEN_LOG_FUNCTION(handle, dyDesc, xDesc, convDesc, dwDesc, workSpaceSize);
+    return miopen::try_([&] {
+        miopen::deref(workSpaceSize) = miopen::deref(convDesc).BackwardWeightsBiasGetWorkSpaceSize(
+            miopen::deref(handle),
+            miopen::deref(convDesc).mode == miopenTranspose ? miopen::deref(xDesc)
+                                                            : miopen::deref(dyDesc),
+            miopen::deref(convDesc).mode == miopenTranspose ? miopen::deref(dyDesc)
+                                                            : miopen::deref(xDesc),
+            miopen::deref(dwDesc));
+    });
+}
+
+extern "C" miopenStatus_t
+miopenConvolutionBackwardWeightsBias(miopenHandle_t handle,
+                                     const void* alpha,
+                                     const miopenTensorDescriptor_t dyDesc,
+                                     const void* dy,
+                                     const miopenTensorDescriptor_t xDesc,
+                                     const void* x,
+                                     const miopenConvolutionDescriptor_t convDesc,
+                                     miopenConvBwdWeightsAlgorithm_t algo,
+                                     const void* beta,
+                                     const miopenTensorDescriptor_t dwDesc,
+                                     void* dw,
+                                     const miopenTensorDescriptor_t dbDesc,
+                                     void* db,
+                                     void* workSpace,
+                                     size_t workSpaceSize)
+{
+
+    MIOPEN_LOG_FUNCTION(handle,
+                        alpha,
+                        dyDesc,
+                        dy,
+                        xDesc,
+                        x,
+                        convDesc,
+                        algo,
+                        beta,
+                        dwDesc,
+                        dw,
+                        dbDesc,
+                        db,
+                        workSpace,
+                        workSpaceSize);
+    // bfloat16 not supported for bias operation
+    if(miopen::deref(dyDesc).GetType() == miopenBFloat16 ||
+       miopen::deref(dbDesc).GetType() == miopenBFloat16)
+    {
+        return miopenStatusNotImplemented;
+    }
+    LogCmdConvolution(
+        xDesc,
+        dwDesc,
+        convDesc,
+        ConvDirection::WrW,
+        boost::none,
+        RecordConvInputs(handle, ConvDirection::WrW, xDesc, x, dwDesc, dw, dyDesc, dy));
+
+    return miopen::try_([&] {
+        miopen::deref(convDesc).ConvolutionBackwardWeightsBias(
+            miopen::deref(handle),
+            alpha,
+            /// workaround for previous trans conv logic
+            miopen::deref(convDesc).mode == miopenTranspose ? miopen::deref(xDesc)
+                                                            : miopen::deref(dyDesc),
+            miopen::deref(convDesc).mode == miopenTranspose ? DataCast(x) : DataCast(dy),
+            miopen::deref(convDesc).mode == miopenTranspose ? miopen::deref(dyDesc)
+                                                            : miopen::deref(xDesc),
+            miopen::deref(convDesc).mode == miopenTranspose ? DataCast(dy) : DataCast(x),
+            algo,
+            beta,
+            miopen::deref(dwDesc),
+            DataCast(dw),
+            miopen::deref(dbDesc),
+            DataCast(db),
+            DataCast(workSpace),
+            workSpaceSize);
+    });
+}
@@ -69,6 +69,9 @@ static size_t GetWorkSpaceSizeFFT(const TensorDescriptor& wDesc,
     supported = (std::tie(wei_h, wei_w) != std::make_tuple(5, 5)) ? false : supported;
     supported = (cparam != std::make_tuple(2, 2, 1, 1)) ? false : supported;
     supported = (yDesc.GetType() != miopenFloat) ? false : supported;
+    supported = (!xDesc.IsDefaultLayout() || !wDesc.IsDefaultLayout() || !yDesc.IsDefaultLayout())
+                    ? false
+                    : supported;
 
     const int N       = FFTConvParams::TileSize(in_h, in_w);
     const int Padding = FFTConvParams::TransposePadding;
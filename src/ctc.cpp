@@ -28,8 +28,56 @@
 #include <miopen/errors.hpp>
 #include <miopen/env.hpp>
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CTC_LOSS_TILED)
+
 namespace miopen {
 
+bool IsCTCLossTiled(const TensorDescriptor& probsDesc, int max_label_len)
+{
+    if(miopen::IsDisabled(MIOPEN_DEBUG_CTC_LOSS_TILED{}))
+        return false;
+    if(miopen::IsEnabled(MIOPEN_DEBUG_CTC_LOSS_TILED{}))
+        return true;
+
+    const std::size_t max_time_step = probsDesc.GetLengths()[0];
+    const std::size_t max_S_len     = 2 * max_label_len + 1;
+    return probsDesc.GetType() == miopenHalf || max_S_len > 256 ||
+           max_time_step * max_S_len > (1 << 18);
+}
+
+CTCLossTiledLayout
+GetCTCLossTiledLayout(const TensorDescriptor& probsDesc, int max_label_len, int total_label_len)
+{
+    const std::size_t max_time_step = probsDesc.GetLengths()[0];
+    const std::size_t batch_size    = probsDesc.GetLengths()[1];
+    const std::size_t class_sz      = probsDesc.GetLengths()[2];
+    const std::size_t max_S_len     = 2 * max_label_len + 1;
+
+    CTCLossTiledLayout layout{};
+    layout.work_per_grp = max_S_len <= 64 ? 64 : max_S_len <= 128 ? 128 : 256;
+    // The beta pass recomputes the alphas of a tile in 32 KB of local memory.
+    layout.tile_t  = 8192 / layout.work_per_grp;
+    layout.s_tiles = (max_S_len + layout.work_per_grp - 1) / layout.work_per_grp;
+    layout.t_tiles = (max_time_step + layout.tile_t - 1) / layout.tile_t;
+
+    // Labels and the log-softmax of probs are laid out as for the single workgroup kernel.
+    const std::size_t labels_bytes =
+        (4 * batch_size + total_label_len + batch_size * max_S_len) * sizeof(int);
+    const std::size_t problog_bytes =
+        max_time_step * batch_size * class_sz * GetTypeSize(probsDesc.GetType());
+
+    const std::size_t col_sz = batch_size * layout.s_tiles * max_time_step * 2;
+
+    layout.grad_log_offset   = (labels_bytes + problog_bytes + sizeof(float) - 1) / sizeof(float);
+    layout.alpha_ckpt_offset = layout.grad_log_offset + max_time_step * batch_size * class_sz;
+    layout.alpha_col_offset  = layout.alpha_ckpt_offset + batch_size * layout.t_tiles * max_S_len;
+    layout.beta_col_offset   = layout.alpha_col_offset + col_sz;
+    layout.beta_row_offset   = layout.beta_col_offset + col_sz;
+    layout.alpha_end_offset  = layout.beta_row_offset + batch_size * max_S_len;
+    layout.size              = (layout.alpha_end_offset + 2 * batch_size) * sizeof(float);
+    return layout;
+}
+
 CTCLossDescriptor::CTCLossDescriptor()
 {
     dataType            = miopenFloat;
@@ -120,7 +168,9 @@ size_t CTCLossDescriptor::GetCTCLossWorkspaceSize(Handle& handle,
     // beta buffer
     wksp_sz_dat += 2 * batch_size * (2 * max_label_len + 1);
 
-    size_t total_size = wksp_sz_dat * sizeof(float) + wksp_sz_lb * sizeof(int);
+    size_t total_size = IsCTCLossTiled(probsDesc, max_label_len)
+                            ? GetCTCLossTiledLayout(probsDesc, max_label_len, total_label_len).size
+                            : wksp_sz_dat * sizeof(float) + wksp_sz_lb * sizeof(int);
     if(total_size > handle.GetMaxMemoryAllocSize())
         MIOPEN_THROW(miopenStatusBadParm, "Error: Workspace size exceeds GPU memory capacity");
 
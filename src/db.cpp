@@ -24,11 +24,14 @@
  *
  *******************************************************************************/
 #include <miopen/db.hpp>
+#include <miopen/binary_db.hpp>
 #include <miopen/db_record.hpp>
+#include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/lock_file.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/md5.hpp>
+#include <miopen/stringutils.hpp>
 
 #include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <boost/filesystem.hpp>
@@ -38,22 +41,496 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cerrno>
 #include <chrono>
 #include <cstdio>
+#include <cstdlib>
 #include <fstream>
 #include <ios>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>
+#include <sstream>
 #include <string>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
+#ifndef _WIN32
+#include <signal.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_USER_DB_JOURNAL)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_USER_DB_SHARED_CACHE_PATH)
+
 namespace miopen {
 
+bool testing_user_db_journal_enabled = false;
+std::string testing_user_db_shared_cache_path;
+
 struct RecordPositions
 {
     std::streamoff begin = -1;
     std::streamoff end   = -1;
 };
+
+#define MIOPEN_VALIDATE_LOCK(lock)                       \
+    do                                                   \
+    {                                                    \
+        if(!(lock))                                      \
+            MIOPEN_THROW("Db lock has failed to lock."); \
+    } while(false)
+
+static std::chrono::seconds GetLockTimeout() { return std::chrono::seconds{60}; }
+
+using exclusive_lock = std::unique_lock<LockFile>;
+using shared_lock    = std::shared_lock<LockFile>;
+
+static bool IsJournalEnabled()
+{
+#ifdef _WIN32
+    return false;
+#else
+    return testing_user_db_journal_enabled || IsEnabled(MIOPEN_USER_DB_JOURNAL{});
+#endif
+}
+
+static long GetProcessId()
+{
+#ifndef _WIN32
+    return ::getpid();
+#else
+    return 0;
+#endif
+}
+
+static bool IsProcessGone(long pid)
+{
+#ifndef _WIN32
+    return ::kill(pid, 0) != 0 && errno == ESRCH;
+#else
+    std::ignore = pid;
+    return false;
+#endif
+}
+
+struct JournalEntry
+{
+    bool merge; // UpdateRecord() rather than StoreRecord()
+    DbRecord record;
+};
+
+static void ApplyJournalEntry(const JournalEntry& entry, boost::optional<DbRecord>& record)
+{
+    if(entry.merge && record)
+    {
+        auto updated = entry.record;
+        updated.Merge(*record);
+        record = std::move(updated);
+    }
+    else
+    {
+        record = entry.record;
+    }
+}
+
+/// The journal of the updates of a user db made by this process, see PlainTextDb. One line per
+/// update: 'U' for UpdateRecord() or 'S' for StoreRecord(), a space and the record as it would be
+/// in the db. The pending updates are also kept in memory, so reading doesn't parse the journal.
+class DbJournal
+{
+    public:
+    DbJournal(const std::string& db_filename_, LockFile& lock_file_)
+        : db_filename(db_filename_),
+          path(db_filename_ + "." + std::to_string(GetProcessId()) + ".journal"),
+          lock_file(lock_file_)
+    {
+        RecoverOrphans();
+    }
+
+    DbJournal(const DbJournal&) = delete;
+    DbJournal& operator=(const DbJournal&) = delete;
+
+    ~DbJournal() { Flush(); }
+
+    static DbJournal* Get(const std::string& db_filename, LockFile& lock_file)
+    {
+        // Destroyed, and so merged at exit, before the lock files which are created earlier.
+        static std::mutex journals_mutex;
+        static std::map<std::string, std::unique_ptr<DbJournal>> journals;
+        std::lock_guard<std::mutex> lock(journals_mutex);
+        auto& journal = journals[db_filename];
+        if(journal == nullptr)
+            journal = std::make_unique<DbJournal>(db_filename, lock_file);
+        return journal.get();
+    }
+
+    /// The pending updates of the key, oldest first.
+    std::vector<JournalEntry> Find(const std::string& key) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<JournalEntry> found;
+        for(const auto& entry : entries)
+            if(entry.record.key == key)
+                found.push_back(entry);
+        return found;
+    }
+
+    /// Returns false if the record shall be written to the db directly.
+    bool Append(const DbRecord& record, bool merge)
+    {
+        if(record.map.empty())
+            return false; // Empty records remove, which the journal doesn't do.
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            {
+                std::ofstream file(path, std::ios::app);
+                if(!file)
+                {
+                    MIOPEN_LOG_E("Journal is unwritable: " << path);
+                    return false;
+                }
+                file << (merge ? 'U' : 'S') << ' ';
+                record.WriteContents(file);
+                if(!file)
+                {
+                    MIOPEN_LOG_E("Failed to write the journal: " << path);
+                    return false;
+                }
+            }
+            if(entries.empty())
+            {
+                // Another process shall be able to merge it if this one dies.
+                boost::system::error_code ec;
+                boost::filesystem::permissions(path, boost::filesystem::all_all, ec);
+            }
+            MIOPEN_LOG_I2("Journaling record: " << record.key);
+            entries.push_back({merge, record});
+            if(entries.size() < flush_size)
+                return true;
+        }
+        Flush();
+        return true;
+    }
+
+    /// Merges the pending updates into the db file. Doesn't throw, it also runs at exit.
+    bool Flush()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(entries.empty())
+            return true;
+
+        const auto db_lock = exclusive_lock(lock_file, GetLockTimeout());
+        if(!db_lock)
+        {
+            MIOPEN_LOG_E("Db lock has failed to lock, the journal is kept: " << path);
+            return false;
+        }
+        if(!MergeUnsafe(db_filename, entries))
+            return false;
+        MIOPEN_LOG_I("Merged " << entries.size() << " journaled records into " << db_filename);
+        entries.clear();
+        std::remove(path.c_str());
+        return true;
+    }
+
+    private:
+    // Every appended record rewrites the db once this many are pending.
+    static constexpr std::size_t flush_size = 256;
+
+    std::string db_filename;
+    std::string path;
+    LockFile& lock_file;
+    mutable std::mutex mutex;
+    std::vector<JournalEntry> entries;
+
+    static std::vector<JournalEntry> Read(const std::string& journal_path)
+    {
+        std::vector<JournalEntry> read;
+        std::ifstream file(journal_path);
+        std::string line;
+        while(std::getline(file, line))
+        {
+            if(file.eof())
+                break; // The last line of a killed process may be torn.
+            const auto key_size = line.find('=');
+            const auto is_entry = line.size() > 2 && (line[0] == 'U' || line[0] == 'S') &&
+                                  line[1] == ' ' && key_size != std::string::npos && key_size > 2;
+            if(!is_entry)
+            {
+                MIOPEN_LOG_E("Ill-formed journal entry: " << journal_path);
+                continue;
+            }
+            JournalEntry entry{line[0] == 'U', DbRecord(line.substr(2, key_size - 2))};
+            if(entry.record.ParseContents(line.substr(key_size + 1)))
+                read.push_back(std::move(entry));
+        }
+        return read;
+    }
+
+    /// Applies the updates to the db file in one rewrite. The exclusive lock of the db file shall
+    /// be held.
+    static bool MergeUnsafe(const std::string& filename, const std::vector<JournalEntry>& updates)
+    {
+        std::vector<std::string> lines;
+        std::unordered_map<std::string, std::size_t> key_lines;
+        {
+            std::ifstream from(filename);
+            std::string line;
+            while(std::getline(from, line))
+            {
+                const auto key_size = line.find('=');
+                // The first line of a key is the one FindRecord() finds.
+                if(key_size != std::string::npos && key_size != 0)
+                    key_lines.emplace(line.substr(0, key_size), lines.size());
+                lines.push_back(std::move(line));
+            }
+        }
+
+        for(const auto& update : updates)
+        {
+            auto record   = update.record;
+            const auto it = key_lines.find(record.key);
+            if(update.merge && it != key_lines.end())
+            {
+                DbRecord old_record(record.key);
+                if(old_record.ParseContents(lines[it->second].substr(record.key.size() + 1)))
+                    record.Merge(old_record);
+            }
+
+            std::ostringstream ss;
+            record.WriteContents(ss);
+            auto text = ss.str();
+            if(!text.empty() && text.back() == '\n')
+                text.pop_back();
+
+            if(it != key_lines.end())
+            {
+                lines[it->second] = std::move(text);
+            }
+            else
+            {
+                key_lines.emplace(record.key, lines.size());
+                lines.push_back(std::move(text));
+            }
+        }
+
+        const auto temp_name = filename + ".temp";
+        {
+            std::ofstream to(temp_name);
+            for(const auto& line : lines)
+                to << line << '\n';
+            if(!to)
+            {
+                MIOPEN_LOG_E("Temp file is unwritable: " << temp_name);
+                return false;
+            }
+        }
+
+        std::remove(filename.c_str());
+        std::rename(temp_name.c_str(), filename.c_str());
+        boost::system::error_code ec;
+        boost::filesystem::permissions(filename, boost::filesystem::all_all, ec);
+        return true;
+    }
+
+    /// Merges the journals left by the processes which died before merging them.
+    void RecoverOrphans()
+    {
+        const auto db_path = boost::filesystem::path(db_filename);
+        const auto prefix  = db_path.filename().string() + ".";
+        auto directory     = db_path.parent_path();
+        if(directory.empty())
+            directory = ".";
+
+        std::vector<boost::filesystem::path> orphans;
+        boost::system::error_code ec;
+        for(boost::filesystem::directory_iterator it(directory, ec), end; !ec && it != end;
+            it.increment(ec))
+        {
+            const auto name = it->path().filename().string();
+            if(!StartsWith(name, prefix) || !EndsWith(name, ".journal"))
+                continue;
+            const auto pid = std::strtol(name.c_str() + prefix.size(), nullptr, 10);
+            if(pid > 0 && pid != GetProcessId() && IsProcessGone(pid))
+                orphans.push_back(it->path());
+        }
+
+        for(const auto& orphan : orphans)
+        {
+            const auto db_lock = exclusive_lock(lock_file, GetLockTimeout());
+            // Another process may have merged it meanwhile.
+            if(!db_lock || !boost::filesystem::exists(orphan, ec))
+                continue;
+            MIOPEN_LOG_I("Merging the journal of a process which is gone: " << orphan);
+            const auto updates = Read(orphan.string());
+            if(updates.empty() || MergeUnsafe(db_filename, updates))
+                boost::filesystem::remove(orphan, ec);
+        }
+    }
+};
+
+static std::string GetSharedCachePath()
+{
+#ifdef _WIN32
+    return {};
+#else
+    if(!testing_user_db_shared_cache_path.empty())
+        return testing_user_db_shared_cache_path;
+    const auto path = GetStringEnv(MIOPEN_USER_DB_SHARED_CACHE_PATH{});
+    return path != nullptr ? path : "";
+#endif
+}
+
+/// Identifies the state of a file: a rewrite replaces the inode, an append changes the size and
+/// the modification time. Empty if the file is missing.
+static std::string GetFileStamp(const std::string& filename)
+{
+#ifndef _WIN32
+    struct stat info;
+    if(::stat(filename.c_str(), &info) != 0)
+        return {};
+    return std::to_string(info.st_ino) + "-" + std::to_string(info.st_size) + "-" +
+           std::to_string(info.st_mtim.tv_sec) + "." + std::to_string(info.st_mtim.tv_nsec);
+#else
+    std::ignore = filename;
+    return {};
+#endif
+}
+
+/// A binary image (see binary_db.hpp) of a user db file in the directory given by
+/// MIOPEN_USER_DB_SHARED_CACHE_PATH, usually a node-local tmpfs like /dev/shm. The processes using
+/// the same db map the same image read-only, so the pages are shared by all of them.
+///
+/// An image is named after the state of the db file it was compiled from and is never modified.
+/// The first process which finds no image of the current state of the db becomes the writer: it
+/// compiles one under a lock file and removes the outdated ones. The others read the db file
+/// until the new image appears, rather than waiting. Removing an image doesn't invalidate the
+/// mappings of the processes still using it.
+class SharedDbImage
+{
+    public:
+    SharedDbImage(const std::string& db_filename_, const std::string& cache_path)
+        : db_filename(db_filename_),
+          name(boost::filesystem::path(db_filename_).filename().string() + "." +
+               md5(db_filename_)),
+          directory(cache_path)
+    {
+    }
+
+    SharedDbImage(const SharedDbImage&) = delete;
+    SharedDbImage& operator=(const SharedDbImage&) = delete;
+
+    /// Returns nullptr if no cache path is set.
+    static SharedDbImage* Get(const std::string& db_filename)
+    {
+        const auto cache_path = GetSharedCachePath();
+        if(cache_path.empty())
+            return nullptr;
+
+        static std::mutex images_mutex;
+        static std::map<std::string, std::unique_ptr<SharedDbImage>> images;
+        std::lock_guard<std::mutex> lock(images_mutex);
+        auto& image = images[cache_path + ":" + db_filename];
+        if(image == nullptr)
+        {
+            boost::system::error_code ec;
+            if(!boost::filesystem::exists(cache_path, ec))
+            {
+                if(!boost::filesystem::create_directories(cache_path, ec))
+                {
+                    MIOPEN_LOG_W("Unable to create the shared db cache directory: " << cache_path);
+                    return nullptr;
+                }
+                boost::filesystem::permissions(cache_path, boost::filesystem::all_all, ec);
+            }
+            image = std::make_unique<SharedDbImage>(db_filename, cache_path);
+        }
+        return image.get();
+    }
+
+    /// The image of the db file as it is now, or nullptr if it's not available yet. The lock of
+    /// the db file shall be held, so the file doesn't change meanwhile.
+    std::shared_ptr<const MappedDb> GetUnsafe()
+    {
+        const auto stamp = GetFileStamp(db_filename);
+        if(stamp.empty())
+            return nullptr;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if(mapped != nullptr && stamp == mapped_stamp)
+            return mapped;
+
+        const auto path = (directory / (name + "." + stamp + ".bin")).string();
+        auto image      = MappedDb::Open(path);
+        if(image == nullptr && Compile(path))
+            image = MappedDb::Open(path);
+        if(image == nullptr)
+            return nullptr;
+
+        mapped       = std::move(image);
+        mapped_stamp = stamp;
+        return mapped;
+    }
+
+    private:
+    std::string db_filename;
+    std::string name;
+    boost::filesystem::path directory;
+    std::mutex mutex;
+    std::string mapped_stamp;
+    std::shared_ptr<const MappedDb> mapped;
+
+    bool Compile(const std::string& path) const
+    {
+        auto& lock_file   = LockFile::Get(LockFilePath(directory / name).c_str());
+        const auto writer = exclusive_lock(lock_file, std::try_to_lock);
+        if(!writer)
+            return false; // Another process is compiling it.
+
+        boost::system::error_code ec;
+        if(boost::filesystem::exists(path, ec))
+            return true;
+
+        const auto temp_name = path + "." + std::to_string(GetProcessId()) + ".temp";
+        {
+            std::ifstream from(db_filename);
+            std::ofstream to(temp_name, std::ios::binary);
+            const auto count = binary_db::Compile(from, to, db_filename);
+            if(!from.eof() || !to)
+            {
+                MIOPEN_LOG_W("Unable to write the shared db image: " << temp_name);
+                to.close();
+                std::remove(temp_name.c_str());
+                return false;
+            }
+            MIOPEN_LOG_I("Compiled " << count << " records of " << db_filename << " into "
+                                     << path);
+        }
+        boost::filesystem::permissions(temp_name, boost::filesystem::all_all, ec);
+        if(std::rename(temp_name.c_str(), path.c_str()) != 0)
+        {
+            std::remove(temp_name.c_str());
+            return false;
+        }
+
+        // The images of the previous states of the db.
+        const auto prefix = name + ".";
+        for(boost::filesystem::directory_iterator it(directory, ec), end; !ec && it != end;
+            it.increment(ec))
+        {
+            const auto file = it->path().filename().string();
+            if(StartsWith(file, prefix) && EndsWith(file, ".bin") && it->path() != path)
+                boost::filesystem::remove(it->path(), ec);
+        }
+        return true;
+    }
+};
+
 /// This makes the interface for the MultiFileDb uniform and
 /// allows reusing it for the SQLite perfdb and the kernel cache.
 PlainTextDb::PlainTextDb(const std::string& filename_,
@@ -81,30 +558,38 @@ PlainTextDb::PlainTextDb(const std::string& filename_, bool is_system)
             else
                 boost::filesystem::permissions(directory, boost::filesystem::all_all);
         }
+
+        if(IsJournalEnabled())
+            journal = DbJournal::Get(filename, lock_file);
+        shared_image = SharedDbImage::Get(filename);
     }
 }
 
-#define MIOPEN_VALIDATE_LOCK(lock)                       \
-    do                                                   \
-    {                                                    \
-        if(!(lock))                                      \
-            MIOPEN_THROW("Db lock has failed to lock."); \
-    } while(false)
-
-static std::chrono::seconds GetLockTimeout() { return std::chrono::seconds{60}; }
-
-using exclusive_lock = std::unique_lock<LockFile>;
-using shared_lock    = std::shared_lock<LockFile>;
-
 boost::optional<DbRecord> PlainTextDb::FindRecord(const std::string& key)
 {
-    const auto lock = shared_lock(lock_file, GetLockTimeout());
-    MIOPEN_VALIDATE_LOCK(lock);
-    return FindRecordUnsafe(key, nullptr);
+    // Taken before reading the file, so that a merge in between can't hide the updates.
+    // Applying them again on top of the merged file gives the same record.
+    const auto pending = journal != nullptr ? journal->Find(key) : std::vector<JournalEntry>{};
+
+    boost::optional<DbRecord> record;
+    {
+        const auto lock = shared_lock(lock_file, GetLockTimeout());
+        MIOPEN_VALIDATE_LOCK(lock);
+        record = FindRecordUnsafe(key, nullptr);
+    }
+
+    for(const auto& entry : pending)
+        ApplyJournalEntry(entry, record);
+    return record;
 }
 
+bool PlainTextDb::FlushJournal() { return journal == nullptr || journal->Flush(); }
+
 bool PlainTextDb::StoreRecord(const DbRecord& record)
 {
+    if(journal != nullptr && journal->Append(record, false))
+        return true;
+
     const auto lock = exclusive_lock(lock_file, GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
     return StoreRecordUnsafe(record);
@@ -112,6 +597,21 @@ bool PlainTextDb::StoreRecord(const DbRecord& record)
 
 bool PlainTextDb::UpdateRecord(DbRecord& record)
 {
+    if(journal != nullptr)
+    {
+        // The caller gets the merged record, as without the journal.
+        auto merged         = record;
+        const auto existing = FindRecord(record.key);
+        if(existing)
+            merged.Merge(*existing);
+        if(journal->Append(record, true))
+        {
+            MIOPEN_LOG_I2((existing ? "Updating record: " : "Storing record: ") << record.key);
+            record = std::move(merged);
+            return true;
+        }
+    }
+
     const auto lock = exclusive_lock(lock_file, GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
     return UpdateRecordUnsafe(record);
@@ -119,6 +619,7 @@ bool PlainTextDb::UpdateRecord(DbRecord& record)
 
 bool PlainTextDb::RemoveRecord(const std::string& key)
 {
+    FlushJournal();
     const auto lock = exclusive_lock(lock_file, GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
     return RemoveRecordUnsafe(key);
@@ -126,6 +627,7 @@ bool PlainTextDb::RemoveRecord(const std::string& key)
 
 bool PlainTextDb::Remove(const std::string& key, const std::string& id)
 {
+    FlushJournal();
     const auto lock = exclusive_lock(lock_file, GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
     auto record = FindRecordUnsafe(key, nullptr);
@@ -137,6 +639,32 @@ bool PlainTextDb::Remove(const std::string& key, const std::string& id)
     return StoreRecordUnsafe(*record);
 }
 
+boost::optional<DbRecord> PlainTextDb::FindRecordInImage(const MappedDb& image,
+                                                         const std::string& key) const
+{
+    const auto item = image.Find(key);
+    if(!item)
+        return boost::none;
+    // As the file is read below.
+    if(item->content.empty())
+    {
+        MIOPEN_LOG_E("None contents under the key: " << key << " form file " << filename << "#"
+                                                     << item->line);
+        return boost::none;
+    }
+    MIOPEN_LOG_I2("Contents found: " << item->content);
+
+    DbRecord record(key);
+    if(!record.ParseContents(item->content))
+    {
+        MIOPEN_LOG_E("Error parsing payload under the key: " << key << " form file " << filename
+                                                             << "#"
+                                                             << item->line);
+        MIOPEN_LOG_E("Contents: " << item->content);
+    }
+    return record;
+}
+
 boost::optional<DbRecord> PlainTextDb::FindRecordUnsafe(const std::string& key,
                                                         RecordPositions* pos)
 {
@@ -148,6 +676,14 @@ boost::optional<DbRecord> PlainTextDb::FindRecordUnsafe(const std::string& key,
 
     MIOPEN_LOG_I2("Looking for key " << key << " in file " << filename);
 
+    // The positions are only needed to rewrite the file, which reads it anyway.
+    if(pos == nullptr && shared_image != nullptr)
+    {
+        const auto image = shared_image->GetUnsafe();
+        if(image != nullptr)
+            return FindRecordInImage(*image, key);
+    }
+
     std::ifstream file(filename);
 
     if(!file)
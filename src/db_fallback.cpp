@@ -0,0 +1,118 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/db_path.hpp>
+#include <miopen/env.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_DISABLE_SYSDB_CU_FALLBACK)
+
+namespace miopen {
+
+namespace {
+
+/// Inverse of Handle::GetDbBasename(): the CU count if the stem is the basename of the device.
+std::size_t ParseNumCu(const std::string& device, const std::string& stem)
+{
+    if(stem.compare(0, device.size(), device) != 0 || stem.size() == device.size())
+        return 0;
+    const auto tail    = stem.substr(device.size());
+    const auto is_dec  = tail[0] == '_';
+    const auto digits  = is_dec ? tail.substr(1) : tail;
+    char* end          = nullptr;
+    const auto num_cu  = std::strtoull(digits.c_str(), &end, is_dec ? 10 : 16);
+    const auto matches = !digits.empty() && *end == '\0' && num_cu != 0 &&
+                         Handle::GetDbBasename(device, num_cu) == stem;
+    return matches ? num_cu : 0;
+}
+
+} // namespace
+
+std::size_t GetNearestNumCu(std::size_t num_cu, const std::vector<std::size_t>& available)
+{
+    if(available.empty() || IsEnabled(MIOPEN_DEBUG_DISABLE_SYSDB_CU_FALLBACK{}))
+        return num_cu;
+
+    const auto distance = [&](std::size_t n) { return n > num_cu ? n - num_cu : num_cu - n; };
+    auto nearest        = available.front();
+    for(const auto n : available)
+    {
+        if(distance(n) < distance(nearest) || (distance(n) == distance(nearest) && n > nearest))
+            nearest = n;
+    }
+    return nearest;
+}
+
+std::string GetSystemDbBasename(const std::string& device,
+                                std::size_t num_cu,
+                                const std::string& suffix)
+{
+    const auto exact = Handle::GetDbBasename(device, num_cu);
+    const auto dir   = boost::filesystem::path{GetSystemDbPath()};
+    if(dir.empty() || boost::filesystem::exists(dir / (exact + suffix)))
+        return exact;
+
+    // The directory is scanned once per device and kind of db.
+    static std::mutex mutex;
+    static std::map<std::tuple<std::string, std::size_t, std::string>, std::string> cache;
+    const std::lock_guard<std::mutex> lock{mutex};
+    const auto key    = std::make_tuple(device, num_cu, suffix);
+    const auto cached = cache.find(key);
+    if(cached != cache.end())
+        return cached->second;
+
+    auto available = std::vector<std::size_t>{};
+    auto ec        = boost::system::error_code{};
+    for(auto it = boost::filesystem::directory_iterator{dir, ec};
+        !ec && it != boost::filesystem::directory_iterator{};
+        it.increment(ec))
+    {
+        const auto name = it->path().filename().string();
+        if(name.size() <= suffix.size() ||
+           name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0)
+            continue;
+        const auto n = ParseNumCu(device, name.substr(0, name.size() - suffix.size()));
+        if(n != 0)
+            available.push_back(n);
+    }
+
+    const auto nearest = GetNearestNumCu(num_cu, available);
+    const auto result  = Handle::GetDbBasename(device, nearest);
+    if(nearest != num_cu)
+        MIOPEN_LOG_W("No system db " << exact << suffix << ", using the one of " << result);
+    cache.emplace(key, result);
+    return result;
+}
+
+} // namespace miopen
@@ -0,0 +1,144 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/db_merge.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/perf_field.hpp>
+
+#include <istream>
+#include <ostream>
+#include <sstream>
+
+namespace miopen {
+
+DbMerger::Kind DbMerger::GetKind(const std::string& path)
+{
+    const auto suffix = std::string{"fdb.txt"};
+    return path.size() >= suffix.size() &&
+                   path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0
+               ? Kind::Find
+               : Kind::Perf;
+}
+
+std::size_t DbMerger::Add(std::istream& text, const std::string& source)
+{
+    auto line   = std::string{};
+    auto n_line = 0;
+    auto count  = std::size_t{0};
+
+    while(std::getline(text, line))
+    {
+        ++n_line;
+
+        if(line.empty())
+            continue;
+
+        const auto key_size = line.find('=');
+        if(key_size == std::string::npos || key_size == 0)
+        {
+            MIOPEN_LOG_E("Ill-formed record: key not found: " << source << "#" << n_line);
+            continue;
+        }
+
+        const auto key = line.substr(0, key_size);
+        std::istringstream contents{line.substr(key_size + 1)};
+        auto id_and_value = std::string{};
+
+        while(std::getline(contents, id_and_value, ';'))
+        {
+            const auto id_size = id_and_value.find(':');
+            if(id_size == std::string::npos || id_size == 0)
+            {
+                MIOPEN_LOG_E("Ill-formed record: id not found: " << source << "#" << n_line);
+                continue;
+            }
+            AddEntry(key, id_and_value.substr(0, id_size), id_and_value.substr(id_size + 1));
+        }
+        ++count;
+    }
+
+    return count;
+}
+
+void DbMerger::AddEntry(const std::string& key, const std::string& id, const std::string& value)
+{
+    auto& record   = records[key];
+    const auto old = record.find(id);
+    if(old == record.end())
+    {
+        record.emplace(id, value);
+        return;
+    }
+    if(old->second == value)
+        return;
+
+    ++conflicts;
+
+    if(kind == Kind::Perf)
+    {
+        MIOPEN_LOG_W("Conflicting perf-db entries, the first one is kept: " << key << ", " << id);
+        disputed.insert(key);
+        return;
+    }
+
+    auto old_data = FindDbData{};
+    auto new_data = FindDbData{};
+    if(!new_data.Deserialize(value))
+    {
+        MIOPEN_LOG_E("Ill-formed find-db entry skipped: " << key << ", " << id);
+        return;
+    }
+    const auto old_valid = old_data.Deserialize(old->second);
+    if(old_valid && old_data.solver_id != new_data.solver_id)
+        disputed.insert(key);
+    if(!old_valid || new_data.time < old_data.time)
+        old->second = value;
+}
+
+std::size_t DbMerger::Write(std::ostream& text) const
+{
+    auto count = std::size_t{0};
+    for(const auto& record : records)
+    {
+        if(record.second.empty())
+            continue;
+
+        text << record.first << '=';
+        auto first = true;
+        for(const auto& entry : record.second)
+        {
+            if(!first)
+                text << ';';
+            text << entry.first << ':' << entry.second;
+            first = false;
+        }
+        text << '\n';
+        ++count;
+    }
+    return count;
+}
+
+} // namespace miopen
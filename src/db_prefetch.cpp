@@ -0,0 +1,100 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/db_prefetch.hpp>
+
+#include <miopen/config.h>
+#include <miopen/env.hpp>
+#include <miopen/execution_context.hpp>
+#include <miopen/find_db.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/readonlyramdb.hpp>
+#if MIOPEN_ENABLE_SQLITE
+#include <miopen/sqlite_db.hpp>
+#endif
+
+#include <exception>
+#include <mutex>
+#include <set>
+#include <string>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_DISABLE_DB_PREFETCH)
+
+namespace miopen {
+
+std::future<void> PrefetchSystemDbs(Handle& handle)
+{
+    if(miopen::IsEnabled(MIOPEN_DEBUG_DISABLE_DB_PREFETCH{}))
+        return {};
+
+    const auto basename = handle.GetDbBasename();
+    {
+        static std::mutex mutex;
+        static std::set<std::string> started;
+        const std::lock_guard<std::mutex> lock{mutex};
+        if(!started.insert(basename).second)
+            return {};
+    }
+
+    // The paths are built here, the background thread shall not use the handle.
+    auto find_db = std::string{};
+#if MIOPEN_DEBUG_FIND_DB_CACHING
+    if(!miopen::IsEnabled(MIOPEN_DEBUG_DISABLE_FIND_DB{}))
+        find_db = FindDbRecord::GetInstalledPath(handle);
+#endif
+#if MIOPEN_ENABLE_SQLITE
+    auto ctx = ExecutionContext{};
+    ctx.SetStream(&handle);
+    const auto perf_db = ctx.GetPerfDbPath();
+    const auto device  = handle.GetDeviceName();
+    const auto num_cu  = handle.GetMaxComputeUnits();
+#else
+    if(find_db.empty())
+        return {};
+#endif
+
+    MIOPEN_LOG_I2("Prefetching the system dbs of " << basename);
+    return std::async(std::launch::async, [=]() {
+        try
+        {
+#if MIOPEN_DEBUG_FIND_DB_CACHING
+            if(!find_db.empty())
+                ReadonlyRamDb::GetCached(find_db, true);
+#endif
+#if MIOPEN_ENABLE_SQLITE
+            SQLitePerfDb::GetCached(perf_db, true, device, num_cu);
+#endif
+        }
+        catch(const std::exception& ex)
+        {
+            // The lookup loads the db again.
+            MIOPEN_LOG_W("Prefetching the system dbs failed: " << ex.what());
+        }
+    });
+}
+
+} // namespace miopen
@@ -37,11 +37,17 @@ DropoutDescriptor::DropoutDescriptor()
       seed(0ULL),
       use_mask(false),
       state_evo(false),
-      rng_mode(MIOPEN_RNG_PSEUDO_XORWOW)
+      rng_mode(MIOPEN_RNG_PSEUDO_XORWOW),
+      mask_format(MIOPEN_DROPOUT_MASK_BYTE)
 {
     dataType_ = miopenFloat;
 }
 
+size_t DropoutDescriptor::GetReserveSpaceSize(size_t elements) const
+{
+    return mask_format == MIOPEN_DROPOUT_MASK_BIT ? (elements + 7) / 8 : elements * sizeof(bool);
+}
+
 std::ostream& operator<<(std::ostream& stream, const DropoutDescriptor& x)
 {
     stream << x.dataType_ << ", ";
@@ -55,6 +55,41 @@ extern "C" miopenStatus_t miopenDropoutGetReserveSpaceSize(const miopenTensorDes
     });
 }
 
+extern "C" miopenStatus_t
+miopenDropoutGetDescriptorReserveSpaceSize(const miopenDropoutDescriptor_t dropoutDesc,
+                                           const miopenTensorDescriptor_t xDesc,
+                                           size_t* reserveSpaceSizeInBytes)
+{
+
+    MIOPEN_LOG_FUNCTION(dropoutDesc, xDesc, reserveSpaceSizeInBytes);
+    return miopen::try_([&] {
+        miopen::deref(reserveSpaceSizeInBytes) = miopen::deref(dropoutDesc)
+                                                     .GetReserveSpaceSize(
+                                                         miopen::deref(xDesc).GetElementSize());
+    });
+}
+
+extern "C" miopenStatus_t miopenSetDropoutMaskFormat(miopenDropoutDescriptor_t dropoutDesc,
+                                                     miopenDropoutMaskFormat_t maskFormat)
+{
+
+    MIOPEN_LOG_FUNCTION(dropoutDesc, maskFormat);
+    return miopen::try_([&] {
+        if(maskFormat != MIOPEN_DROPOUT_MASK_BYTE && maskFormat != MIOPEN_DROPOUT_MASK_BIT)
+            MIOPEN_THROW(miopenStatusBadParm, "Unknown dropout mask format");
+        miopen::deref(dropoutDesc).mask_format = maskFormat;
+    });
+}
+
+extern "C" miopenStatus_t miopenGetDropoutMaskFormat(const miopenDropoutDescriptor_t dropoutDesc,
+                                                     miopenDropoutMaskFormat_t* maskFormat)
+{
+
+    MIOPEN_LOG_FUNCTION(dropoutDesc, maskFormat);
+    return miopen::try_(
+        [&] { miopen::deref(maskFormat) = miopen::deref(dropoutDesc).mask_format; });
+}
+
 extern "C" miopenStatus_t miopenDropoutGetStatesSize(miopenHandle_t handle,
                                                      size_t* stateSizeInBytes)
 {
@@ -130,8 +165,9 @@ extern "C" miopenStatus_t miopenSetDropoutDescriptor(miopenDropoutDescriptor_t d
         miopen::deref(dropoutDesc).use_mask         = use_mask;
         miopen::deref(dropoutDesc).state_evo        = state_evo;
         miopen::deref(dropoutDesc).rng_mode         = rng_mode;
-        miopen::deref(dropoutDesc)
-            .InitPRNGState(miopen::deref(handle), DataCast(states), stateSizeInBytes, seed);
+        if(rng_mode != MIOPEN_RNG_PHILOX_4X32_10)
+            miopen::deref(dropoutDesc)
+                .InitPRNGState(miopen::deref(handle), DataCast(states), stateSizeInBytes, seed);
     });
 }
 
@@ -196,6 +196,7 @@ const char* ToCString(const FindMode::Values mode)
     case FindMode::Values::Hybrid: return "HYBRID";
     case FindMode::Values::FastHybrid: return "FAST_HYBRID";
     case FindMode::Values::DynamicHybrid: return "DYNAMIC_HYBRID";
+    case FindMode::Values::BackgroundRefine: return "BACKGROUND_REFINE";
     case FindMode::Values::End_: break;
     }
     return "<Unknown>";
@@ -224,6 +225,8 @@ FindMode::Values GetFindModeValueImpl2()
         return FindMode::Values::FastHybrid;
     else if(str == "DYNAMIC_HYBRID")
         return FindMode::Values::DynamicHybrid;
+    else if(str == "BACKGROUND_REFINE")
+        return FindMode::Values::BackgroundRefine;
     else
     { // Nop. Fall down & try numerics.
     }
@@ -263,6 +266,13 @@ FindMode::Values GetFindModeValue(const ConvolutionContext& ctx)
 } // namespace
 
 FindMode::FindMode(const ConvolutionContext& ctx) { value = GetFindModeValue(ctx); }
+
+bool FindMode::IsBackgroundRefineSet()
+{
+    static const bool set = GetFindModeValueImpl2() == Values::BackgroundRefine;
+    return set && !debug::FindModeDisable;
+}
+
 std::ostream& operator<<(std::ostream& os, const FindMode& obj) { return os << obj.value; }
 
 } // namespace miopen
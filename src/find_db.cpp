@@ -30,10 +30,16 @@
 #include <miopen/finddb_kernel_cache_key.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/perf_field.hpp>
+#include <miopen/problem_description.hpp>
 
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
 #include <string>
 #include <vector>
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_FIND_BATCH_BUCKETS)
+
 namespace miopen {
 
 bool testing_find_db_enabled = true;
@@ -48,8 +54,10 @@ template <class TDb>
 std::string FindDbRecord_t<TDb>::GetInstalledPath(Handle& handle)
 {
 #if !MIOPEN_DISABLE_SYSDB
-    return GetSystemDbPath() + "/" + handle.GetDbBasename() + "." + GetSystemFindDbSuffix() +
-           ".fdb.txt";
+    const auto suffix = "." + GetSystemFindDbSuffix() + ".fdb.txt";
+    return GetSystemDbPath() + "/" +
+           GetSystemDbBasename(handle.GetDeviceName(), handle.GetMaxComputeUnits(), suffix) +
+           suffix;
 #else
     (void)(handle);
     return "";
@@ -80,13 +88,72 @@ bool CheckInvokerSupport(const std::string& algo)
            algo == "miopenConvolutionBwdWeightsAlgoImplicitGEMM";
 }
 
+std::vector<std::size_t> GetBatchBucketCandidates(std::size_t n)
+{
+    static const auto buckets = []() {
+        auto result      = std::vector<std::size_t>{};
+        const auto value = GetStringEnv(MIOPEN_FIND_BATCH_BUCKETS{});
+        if(value == nullptr)
+            return result;
+        std::istringstream ss{value};
+        auto item = std::string{};
+        while(std::getline(ss, item, ','))
+        {
+            const auto bucket = std::strtoull(item.c_str(), nullptr, 10);
+            if(bucket > 0)
+                result.push_back(bucket);
+            else
+                MIOPEN_LOG_W("Invalid batch bucket ignored: " << item);
+        }
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+        return result;
+    }();
+
+    auto candidates  = std::vector<std::size_t>{};
+    const auto above = std::upper_bound(buckets.begin(), buckets.end(), n);
+    if(above != buckets.end())
+        candidates.push_back(*above);
+    const auto below = std::lower_bound(buckets.begin(), buckets.end(), n);
+    if(below != buckets.begin())
+        candidates.push_back(*std::prev(below));
+    return candidates;
+}
+
+template <class TDb>
+boost::optional<DbRecord> FindDbRecord_t<TDb>::FindInBatchBuckets(const ProblemDescription& problem)
+{
+    const auto n = problem.conv_problem.GetInBatchSize();
+    for(const auto bucket : GetBatchBucketCandidates(n))
+    {
+        const auto bucketed = problem.conv_problem.WithBatchSize(bucket);
+        if(!bucketed)
+            return boost::none;
+        const boost::optional<DbRecord> record = db->FindRecord(ProblemDescription{*bucketed});
+        if(!record)
+            continue;
+
+        auto result = DbRecord{problem};
+        for(const auto& pair : record->As<FindDbData>())
+            if(CheckInvokerSupport(pair.first))
+                result.SetValues(pair.first, pair.second);
+        if(result.GetSize() == 0)
+            continue;
+
+        MIOPEN_LOG_I("Find-db record of batch size " << bucket << " used for " << n);
+        from_batch_bucket = true;
+        return result;
+    }
+    return boost::none;
+}
+
 template <class TDb>
 bool FindDbRecord_t<TDb>::Validate(Handle& handle, const NetworkConfig& config) const
 {
     auto unbuilt = false;
     auto any     = false;
 
-    for(const auto& pair : content->As<FindDbData>())
+    for(const auto& pair : GetContent().template As<FindDbData>())
     {
         if(in_sync)
         {
@@ -125,10 +192,30 @@ bool FindDbRecord_t<TDb>::Validate(Handle& handle, const NetworkConfig& config)
     return !any || unbuilt;
 }
 
+template <class TDb>
+bool FindDbRecord_t<TDb>::CopyIfValid(Handle& handle,
+                                      const NetworkConfig& config,
+                                      std::vector<PerfField>& to) const
+{
+    if(handle.IsFindDbRecordValidated(config))
+    {
+        CopyTo(to);
+        return true;
+    }
+
+    const auto generation = handle.GetKernelCacheGeneration();
+    if(Validate(handle, config))
+        return false;
+
+    handle.SetFindDbRecordValidated(config, generation);
+    CopyTo(to);
+    return true;
+}
+
 template <class TDb>
 void FindDbRecord_t<TDb>::CopyTo(std::vector<PerfField>& to) const
 {
-    const auto range = content->As<FindDbData>();
+    const auto range = GetContent().template As<FindDbData>();
     std::transform(range.begin(), range.end(), std::back_inserter(to), [](const auto& pair) {
         return PerfField{
             pair.first, pair.second.solver_id, pair.second.time, pair.second.workspace};
@@ -145,13 +232,13 @@ void FindDbRecord_t<TDb>::LogFindDbItem(const std::pair<std::string, FindDbData>
         log_level,
         "Kernel cache entry not found for solver <" << pair.first << "::" << pair.second.solver_id
                                                     << "> at network config: "
-                                                    << content->GetKey()
+                                                    << GetContent().GetKey()
                                                     << " and kernel cache key: "
                                                     << pair.second.kcache_key.algorithm_name
                                                     << ", "
                                                     << pair.second.kcache_key.network_config);
 
-    for(const auto& pair2 : content->As<FindDbData>())
+    for(const auto& pair2 : GetContent().template As<FindDbData>())
         MIOPEN_LOG(log_level,
                    "Find-db record content: <" << pair2.first << "::" << pair2.second.solver_id
                                                << "> at network config: "
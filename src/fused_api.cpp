@@ -184,6 +184,49 @@ extern "C" miopenStatus_t miopenCreateOpBiasForward(miopenFusionPlanDescriptor_t
     return res;
 }
 
+extern "C" miopenStatus_t
+miopenCreateOpResidualAddForward(miopenFusionPlanDescriptor_t fusePlanDesc,
+                                 miopenFusionOpDescriptor_t* residualOp)
+{
+    MIOPEN_LOG_FUNCTION(fusePlanDesc, residualOp);
+    miopenStatus_t res = miopenStatusUnknownError;
+    miopen::try_([&] {
+        auto rod = std::make_shared<miopen::ResidualAddFwdFusionOpDescriptor>();
+        miopen::deref(residualOp) = rod.get();
+        res                       = miopen::deref(fusePlanDesc).AddOp(rod);
+    });
+    return res;
+}
+
+extern "C" miopenStatus_t
+miopenCreateOpResidualAddBackward(miopenFusionPlanDescriptor_t fusePlanDesc,
+                                  miopenFusionOpDescriptor_t* residualOp)
+{
+    MIOPEN_LOG_FUNCTION(fusePlanDesc, residualOp);
+    miopenStatus_t res = miopenStatusUnknownError;
+    miopen::try_([&] {
+        auto rod = std::make_shared<miopen::ResidualAddBwdFusionOpDescriptor>();
+        miopen::deref(residualOp) = rod.get();
+        res                       = miopen::deref(fusePlanDesc).AddOp(rod);
+    });
+    return res;
+}
+
+extern "C" miopenStatus_t miopenCreateOpPoolingForward(miopenFusionPlanDescriptor_t fusePlanDesc,
+                                                       miopenFusionOpDescriptor_t* poolOp,
+                                                       const miopenPoolingDescriptor_t poolDesc)
+{
+    MIOPEN_LOG_FUNCTION(fusePlanDesc, poolOp, poolDesc);
+    miopenStatus_t res = miopenStatusUnknownError;
+    miopen::try_([&] {
+        auto pod =
+            std::make_shared<miopen::PoolingFwdFusionOpDescriptor>(miopen::deref(poolDesc));
+        miopen::deref(poolOp) = pod.get();
+        res                   = miopen::deref(fusePlanDesc).AddOp(pod);
+    });
+    return res;
+}
+
 // Batch normalization create op
 extern "C" miopenStatus_t
 miopenCreateOpBatchNormInference(miopenFusionPlanDescriptor_t fusePlanDesc,
@@ -272,6 +315,39 @@ extern "C" miopenStatus_t miopenSetOpArgsBiasForward(miopenOperatorArgs_t args,
     });
 }
 
+extern "C" miopenStatus_t
+miopenSetOpArgsResidualAddForward(miopenOperatorArgs_t args,
+                                  const miopenFusionOpDescriptor_t residualOp,
+                                  const void* alpha,
+                                  const void* beta,
+                                  const void* residual)
+{
+
+    MIOPEN_LOG_FUNCTION(args, residualOp, alpha, beta, residual);
+    return miopen::try_([&] {
+        auto&& op =
+            dynamic_cast<miopen::ResidualAddFwdFusionOpDescriptor&>(miopen::deref(residualOp));
+        op.SetArgs(miopen::deref(args), alpha, beta, DataCast(residual));
+    });
+}
+
+extern "C" miopenStatus_t
+miopenSetOpArgsResidualAddBackward(miopenOperatorArgs_t args,
+                                   const miopenFusionOpDescriptor_t residualOp,
+                                   const void* alpha,
+                                   const void* beta,
+                                   const void* residual,
+                                   void* residualDiff)
+{
+
+    MIOPEN_LOG_FUNCTION(args, residualOp, alpha, beta, residual, residualDiff);
+    return miopen::try_([&] {
+        auto&& op =
+            dynamic_cast<miopen::ResidualAddBwdFusionOpDescriptor&>(miopen::deref(residualOp));
+        op.SetArgs(miopen::deref(args), alpha, beta, DataCast(residual), DataCast(residualDiff));
+    });
+}
+
 extern "C" miopenStatus_t miopenSetOpArgsActivForward(miopenOperatorArgs_t args,
                                                       const miopenFusionOpDescriptor_t activFwdOp,
                                                       const void* alpha,
@@ -27,6 +27,7 @@
 #include <miopen/fusion.hpp>
 #include <miopen/md_graph.hpp>
 #include <miopen/fusion_plan.hpp>
+#include <miopen/env.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/visit_float.hpp>
@@ -34,9 +35,14 @@
 #include <ostream>
 #include <ios>
 #include <algorithm>
+#include <map>
+#include <mutex>
+#include <sstream>
 #include <string>
 #include <half.hpp>
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_FUSION_PLAN_CACHE)
+
 namespace miopen {
 
 FusionPlanDescriptor::FusionPlanDescriptor(const miopenFusionDirection_t dir,
@@ -71,6 +77,11 @@ miopenStatus_t FusionPlanDescriptor::AddOp(std::shared_ptr<FusionOpDescriptor> d
     desc->GetOutputDesc(output_desc);
     op_map.emplace_back(desc);
     op_count++;
+    if(is_epilogue)
+    {
+        is_valid = IsEpiloguePlan();
+        return is_valid ? miopenStatusSuccess : miopenStatusUnsupportedOp;
+    }
     is_valid = false;
     miopen::try_([&] {
         is_valid = lu.Advance(desc, [&](const std::string& sym, int& val) -> bool {
@@ -89,6 +100,12 @@ miopenStatus_t FusionPlanDescriptor::AddOp(std::shared_ptr<FusionOpDescriptor> d
             return false;
         });
     });
+    if(!is_valid && IsEpiloguePlan())
+    {
+        MIOPEN_LOG_I2("No fused kernel supports the fusion plan, using the generic epilogue");
+        is_epilogue = true;
+        is_valid    = true;
+    }
     if(is_valid)
         return miopenStatusSuccess;
     else
@@ -156,7 +173,14 @@ miopenStatus_t FusionPlanDescriptor::GetConvAlgos(int reqAlgoCount,
                                                   int& retAlgoCount,
                                                   miopenConvFwdAlgorithm_t* ptrAlgos)
 {
-    auto algos   = lu.GetConvAlgos();
+    // The generic epilogue may run the convolution with any of them.
+    auto algos =
+        is_epilogue ? std::vector<miopenConvFwdAlgorithm_t>{miopenConvolutionFwdAlgoGEMM,
+                                                             miopenConvolutionFwdAlgoDirect,
+                                                             miopenConvolutionFwdAlgoFFT,
+                                                             miopenConvolutionFwdAlgoWinograd,
+                                                             miopenConvolutionFwdAlgoImplicitGEMM}
+                    : lu.GetConvAlgos();
     retAlgoCount = std::min(reqAlgoCount, static_cast<int>(algos.size()));
 
     for(auto idx = 0; idx < retAlgoCount; idx++)
@@ -169,10 +193,19 @@ miopenStatus_t FusionPlanDescriptor::GetConvAlgos(int reqAlgoCount,
 
 miopenStatus_t FusionPlanDescriptor::SetConvAlgo(miopenConvFwdAlgorithm_t algo)
 {
+    if(is_epilogue)
+    {
+        epilogue_algo = algo;
+        return miopenStatusSuccess;
+    }
     bool res = lu.SetConvAlgo(algo);
 
     if(res)
+    {
+        // Honored as well if Compile() switches the plan to the epilogue.
+        epilogue_algo = algo;
         return miopenStatusSuccess;
+    }
     else
         return miopenStatusUnknownError;
 }
@@ -744,6 +777,114 @@ std::vector<std::pair<std::string, OpKernelArg>> BiasFusionOpDescriptor::GetArgs
     return keys;
 }
 
+// Residual add forward
+miopenStatus_t ResidualAddFwdFusionOpDescriptor::GetOutputDesc(TensorDescriptor& output_desc)
+{
+    output_desc = input_desc;
+    return miopenStatusSuccess;
+}
+
+miopenStatus_t ResidualAddFwdFusionOpDescriptor::SetArgs(OperatorArgs& args,
+                                                         const void* /*alpha*/,
+                                                         const void* /*beta*/,
+                                                         ConstData_t residual)
+{
+    args.ins_arg("residual" + std::to_string(GetIdx()), OpKernelArg(residual));
+    return miopenStatusSuccess;
+}
+
+std::string ResidualAddFwdFusionOpDescriptor::GetArgKey(const std::string& k) const
+{
+    return k + std::to_string(GetIdx());
+}
+
+OpKernelArg ResidualAddFwdFusionOpDescriptor::GetOpAttr(const std::string& /* k */) const
+{
+    MIOPEN_THROW(miopenStatusInternalError, "Unknown Residual Add Op Attribute");
+}
+
+std::vector<std::pair<std::string, OpKernelArg>> ResidualAddFwdFusionOpDescriptor::GetArgs() const
+{
+    ConstData_t residual = nullptr;
+    std::vector<std::pair<std::string, OpKernelArg>> keys;
+    keys.emplace_back("residual" + std::to_string(GetIdx()), OpKernelArg(residual));
+    return keys;
+}
+
+// Pooling forward
+miopenStatus_t PoolingFwdFusionOpDescriptor::GetOutputDesc(TensorDescriptor& output_desc)
+{
+    output_desc = base_desc.GetForwardOutputTensor(input_desc);
+    return miopenStatusSuccess;
+}
+
+miopenStatus_t PoolingFwdFusionOpDescriptor::GetNetworkConfig(std::string& network_config,
+                                                              Handle& /*handle*/)
+{
+    auto config = std::ostringstream{};
+    config << "PoolFwd" << base_desc.GetMode() << 'k';
+    LogRange(config, base_desc.GetLengths(), "x") << 's';
+    LogRange(config, base_desc.GetStrides(), "x") << 'p';
+    LogRange(config, base_desc.GetPads(), "x");
+    network_config += config.str();
+    return miopenStatusSuccess;
+}
+
+std::string PoolingFwdFusionOpDescriptor::GetArgKey(const std::string& k) const
+{
+    return k + std::to_string(GetIdx());
+}
+
+OpKernelArg PoolingFwdFusionOpDescriptor::GetOpAttr(const std::string& /* k */) const
+{
+    MIOPEN_THROW(miopenStatusInternalError, "Unknown Pooling Op Attribute");
+}
+
+std::vector<std::pair<std::string, OpKernelArg>> PoolingFwdFusionOpDescriptor::GetArgs() const
+{
+    return {};
+}
+
+// Residual add backward
+miopenStatus_t ResidualAddBwdFusionOpDescriptor::GetOutputDesc(TensorDescriptor& output_desc)
+{
+    output_desc = input_desc;
+    return miopenStatusSuccess;
+}
+
+miopenStatus_t ResidualAddBwdFusionOpDescriptor::SetArgs(OperatorArgs& args,
+                                                         const void* /*alpha*/,
+                                                         const void* /*beta*/,
+                                                         ConstData_t residual,
+                                                         Data_t residualDiff)
+{
+    auto id = std::to_string(GetIdx());
+    args.ins_arg("residual" + id, OpKernelArg(residual));
+    args.ins_arg("residualDiff" + id, OpKernelArg(residualDiff));
+    return miopenStatusSuccess;
+}
+
+std::string ResidualAddBwdFusionOpDescriptor::GetArgKey(const std::string& k) const
+{
+    return k + std::to_string(GetIdx());
+}
+
+OpKernelArg ResidualAddBwdFusionOpDescriptor::GetOpAttr(const std::string& /* k */) const
+{
+    MIOPEN_THROW(miopenStatusInternalError, "Unknown Residual Add Op Attribute");
+}
+
+std::vector<std::pair<std::string, OpKernelArg>> ResidualAddBwdFusionOpDescriptor::GetArgs() const
+{
+    ConstData_t residual = nullptr;
+    Data_t residualDiff  = nullptr;
+    auto id              = std::to_string(GetIdx());
+    std::vector<std::pair<std::string, OpKernelArg>> keys;
+    keys.emplace_back("residual" + id, OpKernelArg(residual));
+    keys.emplace_back("residualDiff" + id, OpKernelArg(residualDiff));
+    return keys;
+}
+
 static inline void
 find_replace_first(std::string& s_where, const std::string& s_find, const std::string& s_replace)
 {
@@ -754,6 +895,8 @@ find_replace_first(std::string& s_where, const std::string& s_find, const std::s
 
 std::string FusionPlanDescriptor::GetProgramName(const Handle& handle)
 {
+    if(is_epilogue)
+        return "MIOpenConvEpilogue.cl";
     if(!op_map.empty())
     {
         program_name = lu.GetProgramName(handle);
@@ -771,6 +914,8 @@ std::string FusionPlanDescriptor::GetProgramName(const Handle& handle)
 
 std::string FusionPlanDescriptor::GetKernelName(const Handle& handle)
 {
+    if(is_epilogue)
+        return "MIOpenConvEpilogue";
     if(!op_map.empty())
     {
         kernel_name = lu.GetKernelName(handle);
@@ -784,6 +929,8 @@ std::string FusionPlanDescriptor::GetKernelName(const Handle& handle)
 
 std::string FusionPlanDescriptor::GetAlgorithmName(const Handle& handle)
 {
+    if(is_epilogue)
+        return "miopenConvolutionEpilogue";
     if(!op_map.empty())
     {
         algorithm_name = lu.GetAlgoName(handle);
@@ -913,8 +1060,127 @@ OpKernelArg FusionPlanDescriptor::GetDevAttribute(const std::string& k, const Ha
     }
 }
 
+namespace {
+
+// What FusionPlanDescriptor::Compile() derives for a plan, reused by the plans with the same
+// signature.
+struct CompiledFusionPlan
+{
+    std::string program_name;
+    std::string kernel_name;
+    std::string algorithm_name;
+    std::string network_config;
+    FusionKernelSourceType kernel_source_type;
+    std::vector<std::pair<MDGraph_vertex_ptr, cur_vertex_map>> cur_vertex;
+    std::vector<Exec_arg_t> arg_list;
+    OpKernelArgsBlock arg_block;
+    std::vector<std::size_t> epilogue_args;
+    bool is_epilogue;
+    solver::Id epilogue_solver;
+};
+
+std::ostream& LogTensor(std::ostream& stream, const TensorDescriptor& desc)
+{
+    stream << desc.GetType() << '{';
+    LogRange(stream, desc.GetLengths(), ",") << "}{";
+    return LogRange(stream, desc.GetStrides(), ",") << '}';
+}
+
+} // namespace
+
+std::string FusionPlanDescriptor::GetSignature(Handle& handle) const
+{
+    auto signature = std::ostringstream{};
+    signature << handle.GetDeviceName() << ':' << handle.GetMaxComputeUnits() << ':' << fusion_dir
+              << ':';
+    LogTensor(signature, input_desc);
+    if(epilogue_algo)
+        signature << ":algo" << *epilogue_algo;
+    for(auto&& op : op_map)
+    {
+        signature << ':' << op->kind() << ',';
+        if(op->kind() == miopenFusionOpConvForward)
+        {
+            const auto& conv = dynamic_cast<const ConvForwardOpDescriptor&>(*op);
+            LogTensor(signature, conv.filter_desc) << ',' << conv.base_desc;
+        }
+        else
+        {
+            // Those of the other ops are cheap and made of their attributes only.
+            auto config = std::string{};
+            op->GetNetworkConfig(config, handle);
+            signature << config;
+        }
+    }
+    return signature.str();
+}
+
 miopenStatus_t FusionPlanDescriptor::Compile(Handle& handle)
 {
+    if(!isValid() || IsDisabled(MIOPEN_DEBUG_FUSION_PLAN_CACHE{}))
+        return CompileUncached(handle);
+
+    // The plans are compiled once per process, kernels are built once per handle. The entries
+    // are small and as many as the distinct plans, so they are never evicted.
+    static std::mutex mutex;
+    static auto compiled = std::map<std::string, CompiledFusionPlan>{};
+
+    const auto signature = GetSignature(handle);
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        const auto it = compiled.find(signature);
+        if(it != compiled.end() &&
+           !handle.GetKernels(it->second.algorithm_name, it->second.network_config).empty())
+        {
+            MIOPEN_LOG_I2("Reusing the compiled fusion plan " << signature);
+            const auto& entry  = it->second;
+            program_name       = entry.program_name;
+            kernel_name        = entry.kernel_name;
+            algorithm_name     = entry.algorithm_name;
+            network_config     = entry.network_config;
+            kernel_source_type = entry.kernel_source_type;
+            lu.cur_vertex      = entry.cur_vertex;
+            arg_list           = entry.arg_list;
+            arg_block          = entry.arg_block;
+            epilogue_args      = entry.epilogue_args;
+            is_epilogue        = entry.is_epilogue;
+            epilogue_solver    = entry.epilogue_solver;
+            return miopenStatusSuccess;
+        }
+    }
+
+    const auto status = CompileUncached(handle);
+    if(status == miopenStatusSuccess)
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        compiled[signature] = CompiledFusionPlan{program_name,
+                                                 kernel_name,
+                                                 algorithm_name,
+                                                 network_config,
+                                                 kernel_source_type,
+                                                 lu.cur_vertex,
+                                                 arg_list,
+                                                 arg_block,
+                                                 epilogue_args,
+                                                 is_epilogue,
+                                                 epilogue_solver};
+    }
+    return status;
+}
+
+miopenStatus_t FusionPlanDescriptor::CompileUncached(Handle& handle)
+{
+    if(isValid() && !is_epilogue && lu.GetCurVertex(handle) == nullptr && IsEpiloguePlan())
+    {
+        MIOPEN_LOG_I2("No fused kernel supports the fusion plan on the device, using the generic "
+                      "epilogue");
+        is_epilogue = true;
+    }
+    else if(isValid() && !is_epilogue && PrefersImplicitGemmEpilogue(handle))
+        is_epilogue = true;
+    if(is_epilogue)
+        return CompileEpilogue(handle);
+
     miopenStatus_t status = miopenStatusUnknownError;
     if(!isValid() || (lu.GetCurVertex(handle) == nullptr))
     {
@@ -1050,6 +1316,12 @@ miopenStatus_t FusionPlanDescriptor::Compile(Handle& handle)
                 status = miopenStatusSuccess;
             }
         }
+        else if(IsEpiloguePlan())
+        {
+            MIOPEN_LOG_I("No viable fused kernel found, using the generic epilogue");
+            is_epilogue = true;
+            return CompileEpilogue(handle);
+        }
         else
         {
             MIOPEN_LOG_I("No viable kernel found to execute the fusion plan");
@@ -1058,9 +1330,26 @@ miopenStatus_t FusionPlanDescriptor::Compile(Handle& handle)
         }
     }
     arg_list = CalcArgOrder(handle);
+    PrepareArgs();
     return status;
 }
 
+void FusionPlanDescriptor::PrepareArgs()
+{
+    auto args = std::vector<OpKernelArg>{};
+    args.reserve(arg_list.size());
+    for(auto& arg : arg_list)
+    {
+        if(arg.type == Scalar || arg.type == Pointer)
+            arg.key_index = OperatorArgs::GetKeyIndex(arg.key);
+        if(arg.type == Default)
+            args.push_back(arg.val);
+        else
+            args.emplace_back(OpKernelArg(0, arg.size));
+    }
+    arg_block = OpKernelArgsBlock{args};
+}
+
 std::vector<Exec_arg_t> FusionPlanDescriptor::CalcArgOrder(const Handle& handle)
 {
     std::vector<Exec_arg_t> arg_keys;
@@ -1228,13 +1517,23 @@ std::vector<Exec_arg_t> FusionPlanDescriptor::CalcArgOrder(const Handle& handle)
     return arg_keys;
 }
 
-miopenStatus_t FusionPlanDescriptor::Execute(const Handle& handle,
+miopenStatus_t FusionPlanDescriptor::Execute(Handle& handle,
                                              const TensorDescriptor& inputDesc,
                                              ConstData_t input,
                                              const TensorDescriptor& outputDesc,
                                              Data_t output,
                                              const OperatorArgs& op_args)
 {
+    if(isValid() && is_epilogue)
+    {
+        if(output_desc != outputDesc)
+            MIOPEN_THROW(miopenStatusBadParm, "The output descriptors dont match.");
+        if(input_desc != inputDesc)
+            MIOPEN_THROW(miopenStatusBadParm, "The input descriptors dont match.");
+        ExecuteEpilogue(handle, input, output, op_args);
+        return miopenStatusSuccess;
+    }
+
     if(!isValid() || (lu.GetCurVertex(handle) == nullptr))
     {
         MIOPEN_THROW(miopenStatusBadParm, "Attempting to execute an invalid fusion plan.");
@@ -1259,42 +1558,61 @@ miopenStatus_t FusionPlanDescriptor::Execute(const Handle& handle,
     }
     KernelInvoke kernel = kernels.front();
 
-    std::vector<OpKernelArg> args;
     if(arg_list.empty())
     {
         MIOPEN_THROW("Kernel arguments not setup properly");
     }
-    for(auto& arg : arg_list)
+    // The copy shares the layout and fits in its inline buffer.
+    auto args = arg_block;
+    for(std::size_t idx = 0; idx < arg_list.size(); idx++)
     {
-        MIOPEN_LOG_I2("Key: " + arg.key);
+        const auto& arg = arg_list[idx];
         switch(arg.type)
         {
-        case Input_Ptr: args.emplace_back(OpKernelArg(input)); break;
-        case Output_Ptr: args.emplace_back(OpKernelArg(output)); break;
-        case Padding: args.emplace_back(OpKernelArg(0, arg.size)); break;
+        case Input_Ptr: args.Set(idx, input); break;
+        case Output_Ptr: args.Set(idx, output); break;
         case Scalar:
         case Pointer:
         {
-            auto it = op_args.args_map.find(arg.key);
-            if(it != op_args.args_map.end())
-            {
-                args.push_back(it->second);
-            }
-            else
+            const auto& value = op_args.Get(arg.key_index);
+            if(value.size() != args.ArgSize(idx))
             {
-                MIOPEN_THROW(miopenStatusInternalError, "Argument Not Set: " + arg.key);
+                // A few metadata graph defaults differ in size from the arguments set for the
+                // data type of the plan, those are packed as they are set.
+                ExecuteUnpacked(kernel, input, output, op_args);
+                return miopenStatusSuccess;
             }
+            args.Set(idx, value);
             break;
         }
-        case Default: args.push_back(arg.val); break;
+        case Padding:
+        case Default: break;
         }
     }
-    if(args.empty())
+    kernel(args);
+    return miopenStatusSuccess;
+}
+
+void FusionPlanDescriptor::ExecuteUnpacked(const KernelInvoke& kernel,
+                                           ConstData_t input,
+                                           Data_t output,
+                                           const OperatorArgs& op_args) const
+{
+    std::vector<OpKernelArg> args;
+    args.reserve(arg_list.size());
+    for(auto& arg : arg_list)
     {
-        MIOPEN_THROW("Operator args not populated properly");
+        switch(arg.type)
+        {
+        case Input_Ptr: args.emplace_back(OpKernelArg(input)); break;
+        case Output_Ptr: args.emplace_back(OpKernelArg(output)); break;
+        case Padding: args.emplace_back(OpKernelArg(0, arg.size)); break;
+        case Scalar:
+        case Pointer: args.push_back(op_args.Get(arg.key_index)); break;
+        case Default: args.push_back(arg.val); break;
+        }
     }
     kernel(args);
-    return miopenStatusSuccess;
 }
 
 } // namespace miopen
@@ -0,0 +1,407 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/fusion_plan.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/workspace_arena.hpp>
+
+#include <half.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_FUSION_GENERIC)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_FUSION_IGEMM)
+
+namespace miopen {
+
+namespace {
+
+// The ops of MIOpenConvEpilogue.cl.
+enum EpilogueOp
+{
+    EpilogueBias            = 1,
+    EpilogueActiv           = 2,
+    EpilogueBnSpatial       = 3,
+    EpilogueBnPerActivation = 4,
+    EpilogueAdd             = 5,
+};
+
+// The poolings of MIOpenConvEpilogue.cl.
+enum EpiloguePooling
+{
+    EpiloguePoolingMax              = 1,
+    EpiloguePoolingAverage          = 2,
+    EpiloguePoolingAverageInclusive = 3,
+};
+
+// The number of ops following the convolution the kernel has arguments for.
+constexpr std::size_t epilogue_slots = 8;
+
+// The pooling closing the plan, if any. It is applied after the other ops of the epilogue.
+const PoolingFwdFusionOpDescriptor*
+GetEpiloguePooling(const std::vector<std::shared_ptr<FusionOpDescriptor>>& ops)
+{
+    if(ops.back()->kind() != miopenFusionOpPoolingForward)
+        return nullptr;
+    return &dynamic_cast<const PoolingFwdFusionOpDescriptor&>(*ops.back());
+}
+
+int GetEpiloguePoolingMode(const PoolingFwdFusionOpDescriptor& pooling)
+{
+    switch(pooling.base_desc.GetMode())
+    {
+    case miopenPoolingMax: return EpiloguePoolingMax;
+    case miopenPoolingAverage: return EpiloguePoolingAverage;
+    case miopenPoolingAverageInclusive: return EpiloguePoolingAverageInclusive;
+    }
+    return 0;
+}
+
+// The ops after the convolution the kernel applies to each pixel, the pooling excluded.
+std::vector<std::shared_ptr<FusionOpDescriptor>>
+GetEpilogueChain(const std::vector<std::shared_ptr<FusionOpDescriptor>>& ops)
+{
+    const auto end = GetEpiloguePooling(ops) != nullptr ? ops.end() - 1 : ops.end();
+    return {ops.begin() + 1, end};
+}
+
+int GetEpilogueOp(const FusionOpDescriptor& op)
+{
+    switch(op.kind())
+    {
+    case miopenFusionOpBiasForward: return EpilogueBias;
+    case miopenFusionOpActivForward: return EpilogueActiv;
+    case miopenFusionOpBatchNormInference:
+        return dynamic_cast<const BatchNormInferenceFusionOpDescriptor&>(op).mode == miopenBNSpatial
+                   ? EpilogueBnSpatial
+                   : EpilogueBnPerActivation;
+    case miopenFusionOpResidualAddForward: return EpilogueAdd;
+    default: return 0;
+    }
+}
+
+template <class T>
+T GetArg(const OperatorArgs& args, std::size_t key_index)
+{
+    const auto& arg = args.Get(key_index);
+    if(arg.size() != sizeof(T))
+        MIOPEN_THROW(miopenStatusInternalError,
+                     "Argument of unexpected size: " + OperatorArgs::GetKey(key_index));
+    T value;
+    std::memcpy(&value, arg.buffer.data(), sizeof(T));
+    return value;
+}
+
+// The activation parameters are set in the type of the tensors.
+float GetActivArg(const OperatorArgs& args, std::size_t key_index, miopenDataType_t type)
+{
+    if(type == miopenHalf)
+        return GetArg<half_float::half>(args, key_index);
+    return GetArg<float>(args, key_index);
+}
+
+// The user arguments ExecuteEpilogue() reads for an op, in order.
+std::vector<std::string> GetEpilogueArgNames(const FusionOpDescriptor& op)
+{
+    switch(GetEpilogueOp(op))
+    {
+    case EpilogueBias: return {"bias"};
+    case EpilogueActiv: return {"activAlpha", "activBeta", "activGamma"};
+    case EpilogueBnSpatial:
+    case EpilogueBnPerActivation:
+        return {"bnScale", "bnBias", "estimatedMean", "estimatedVariance", "epsilon"};
+    case EpilogueAdd: return {"residual"};
+    default: MIOPEN_THROW(miopenStatusInternalError, "Unsupported op in the generic epilogue");
+    }
+}
+
+// The fastest forward solution FusionPlanDescriptor::Execute() can run, it has no workspace.
+boost::optional<miopenConvSolution_t>
+FindEpilogueSolution(Handle& handle,
+                     const ConvForwardOpDescriptor& conv,
+                     const TensorDescriptor& input_desc,
+                     const TensorDescriptor& output_desc,
+                     const boost::optional<miopenConvFwdAlgorithm_t>& algo)
+{
+    const auto max_count = conv.base_desc.GetForwardSolutionCount(
+        handle, conv.filter_desc, input_desc, output_desc);
+    auto solutions = std::vector<miopenConvSolution_t>(max_count);
+    auto count     = std::size_t{0};
+    conv.base_desc.GetForwardSolutions(handle,
+                                       conv.filter_desc,
+                                       input_desc,
+                                       output_desc,
+                                       solutions.size(),
+                                       &count,
+                                       solutions.data());
+    solutions.resize(count);
+    const auto solution =
+        std::find_if(solutions.begin(), solutions.end(), [&](const miopenConvSolution_t& s) {
+            const auto s_algo = static_cast<miopenConvFwdAlgorithm_t>(s.algorithm);
+            return s.workspace_size == 0 && (!algo || s_algo == *algo);
+        });
+    if(solution == solutions.end())
+        return boost::none;
+    return *solution;
+}
+
+} // namespace
+
+bool FusionPlanDescriptor::IsEpiloguePlan() const
+{
+    if(IsDisabled(MIOPEN_DEBUG_FUSION_GENERIC{}))
+        return false;
+    if(fusion_dir != miopenVerticalFusion || op_map.empty() ||
+       op_map.front()->kind() != miopenFusionOpConvForward)
+        return false;
+    if(data_type != miopenFloat && data_type != miopenHalf)
+        return false;
+    const auto pooling = GetEpiloguePooling(op_map);
+    if(pooling != nullptr &&
+       (pooling->base_desc.GetLengths().size() != 2 || pooling->input_desc.GetSize() != 4 ||
+        GetEpiloguePoolingMode(*pooling) == 0))
+        return false;
+    const auto chain = GetEpilogueChain(op_map);
+    return chain.size() <= epilogue_slots && std::all_of(chain.begin(), chain.end(), [](auto&& op) {
+               return GetEpilogueOp(*op) != 0;
+           });
+}
+
+TensorDescriptor FusionPlanDescriptor::GetEpilogueConvOutputDesc() const
+{
+    const auto pooling = GetEpiloguePooling(op_map);
+    return pooling != nullptr ? pooling->input_desc : output_desc;
+}
+
+bool FusionPlanDescriptor::PrefersImplicitGemmEpilogue(Handle& handle) const
+{
+    if(IsDisabled(MIOPEN_DEBUG_FUSION_IGEMM{}) || !IsEpiloguePlan() || !output_desc.IsPacked())
+        return false;
+    const auto& conv = dynamic_cast<const ConvForwardOpDescriptor&>(*op_map.front());
+    const auto solution =
+        FindEpilogueSolution(handle, conv, input_desc, GetEpilogueConvOutputDesc(), epilogue_algo);
+    if(!solution)
+        return false;
+    const auto id = solver::Id{solution->solution_id};
+    if(id.GetAlgorithm() != miopenConvolutionAlgoImplicitGEMM)
+        return false;
+    MIOPEN_LOG_I2(id.ToString() << " is the fastest forward solution, using the generic epilogue");
+    return true;
+}
+
+miopenStatus_t FusionPlanDescriptor::CompileEpilogue(Handle& handle)
+{
+    const auto& conv          = dynamic_cast<const ConvForwardOpDescriptor&>(*op_map.front());
+    const auto conv_out_desc = GetEpilogueConvOutputDesc();
+    if(!output_desc.IsPacked() || !conv_out_desc.IsPacked())
+    {
+        MIOPEN_LOG_I("The generic epilogue requires a packed output");
+        return miopenStatusUnsupportedOp;
+    }
+
+    const auto solution =
+        FindEpilogueSolution(handle, conv, input_desc, conv_out_desc, epilogue_algo);
+    if(!solution)
+    {
+        MIOPEN_LOG_I("No convolution solution without workspace found for the fusion plan");
+        return miopenStatusInternalError;
+    }
+    epilogue_solver = solver::Id{solution->solution_id};
+    MIOPEN_LOG_I2("Generic epilogue after " << epilogue_solver.ToString());
+    conv.base_desc.CompileForwardSolution(
+        handle, conv.filter_desc, input_desc, conv_out_desc, epilogue_solver);
+
+    const auto pooling = GetEpiloguePooling(op_map);
+    const auto chain   = GetEpilogueChain(op_map);
+    epilogue_args      = {OperatorArgs::GetKeyIndex(conv.GetArgKey("weights"))};
+    for(const auto& op : chain)
+        for(const auto& name : GetEpilogueArgNames(*op))
+            epilogue_args.push_back(OperatorArgs::GetKeyIndex(op->GetArgKey(name)));
+
+    algorithm_name = "miopenConvolutionEpilogue";
+    program_name   = "MIOpenConvEpilogue.cl";
+    kernel_name    = "MIOpenConvEpilogue";
+    if(op_map.size() == 1)
+        return miopenStatusSuccess;
+
+    auto config  = std::ostringstream{};
+    auto options = std::ostringstream{};
+    config << output_desc.ToString() << (data_type == miopenHalf ? "FP16" : "FP32");
+    options << " -DMIOPEN_USE_FP16=" << static_cast<int>(data_type == miopenHalf)
+            << " -DMIOPEN_USE_FP32=" << static_cast<int>(data_type == miopenFloat)
+            << " -DMIOPEN_EPILOGUE_SLOTS=" << chain.size();
+    for(auto slot = std::size_t{0}; slot < chain.size(); ++slot)
+    {
+        const auto& op      = *chain[slot];
+        const auto op_index = GetEpilogueOp(op);
+        config << '-' << op_index;
+        options << " -DMIOPEN_EPILOGUE_OP" << slot << '=' << op_index;
+        if(op_index == EpilogueActiv)
+        {
+            const auto mode = dynamic_cast<const ActivFwdFusionOpDescriptor&>(op).activMode;
+            config << 'a' << mode;
+            options << " -DMIOPEN_EPILOGUE_MODE" << slot << '=' << mode;
+        }
+    }
+    if(pooling != nullptr)
+    {
+        const auto& lens    = pooling->base_desc.GetLengths();
+        const auto& strides = pooling->base_desc.GetStrides();
+        const auto& pads    = pooling->base_desc.GetPads();
+        config << "-p" << GetEpiloguePoolingMode(*pooling) << 'k' << lens[0] << 'x' << lens[1]
+               << 's' << strides[0] << 'x' << strides[1] << 'p' << pads[0] << 'x' << pads[1]
+               << conv_out_desc.ToString();
+        options << " -DMIOPEN_EPILOGUE_POOLING=" << GetEpiloguePoolingMode(*pooling)
+                << " -DMIOPEN_POOLING_KERNEL_H=" << lens[0]
+                << " -DMIOPEN_POOLING_KERNEL_W=" << lens[1]
+                << " -DMIOPEN_POOLING_STRIDE_H=" << strides[0]
+                << " -DMIOPEN_POOLING_STRIDE_W=" << strides[1]
+                << " -DMIOPEN_POOLING_PAD_H=" << pads[0] << " -DMIOPEN_POOLING_PAD_W=" << pads[1];
+    }
+    network_config = config.str();
+
+    if(handle.GetKernels(algorithm_name, network_config).empty())
+    {
+        const std::size_t local = 256;
+        const auto n_elems      = output_desc.GetElementSize();
+        const auto max_groups   = handle.GetMaxComputeUnits() * 8;
+        const auto global       = std::min((n_elems + local - 1) / local, max_groups) * local;
+        handle.AddKernel(algorithm_name,
+                         network_config,
+                         program_name,
+                         kernel_name,
+                         {local, 1, 1},
+                         {global, 1, 1},
+                         options.str());
+    }
+    return miopenStatusSuccess;
+}
+
+void FusionPlanDescriptor::ExecuteEpilogue(Handle& handle,
+                                           ConstData_t input,
+                                           Data_t output,
+                                           const OperatorArgs& op_args) const
+{
+    const auto& conv   = dynamic_cast<const ConvForwardOpDescriptor&>(*op_map.front());
+    auto key_index     = epilogue_args.begin();
+    const auto weights = GetArg<ConstData_t>(op_args, *key_index++);
+
+    // With a pooling the convolution writes to a scratch buffer the epilogue pools from,
+    // otherwise the epilogue runs in place on the output.
+    const auto pooling       = GetEpiloguePooling(op_map);
+    const auto conv_out_desc = GetEpilogueConvOutputDesc();
+    const auto conv_out_size = conv_out_desc.GetElementSpace() * GetTypeSize(data_type);
+    constexpr auto slot      = WorkspaceArena::Slot::Fusion;
+    Allocator::ManageDataPtr local_conv_out;
+    if(pooling != nullptr && !handle.IsWorkspaceArenaEnabled())
+        local_conv_out = handle.Create(conv_out_size, miopenAllocationScratch);
+    auto& conv_out_d = handle.IsWorkspaceArenaEnabled() && pooling != nullptr
+                           ? handle.GetArenaBuffer(slot, conv_out_size)
+                           : local_conv_out;
+    const auto conv_out = pooling != nullptr ? conv_out_d.get() : output;
+
+    conv.base_desc.ConvolutionForwardImmediate(handle,
+                                               conv.filter_desc,
+                                               weights,
+                                               input_desc,
+                                               input,
+                                               conv_out_desc,
+                                               conv_out,
+                                               nullptr,
+                                               0,
+                                               epilogue_solver);
+    if(op_map.size() == 1)
+        return;
+
+    auto&& kernels = handle.GetKernels(algorithm_name, network_config);
+    if(kernels.empty())
+        MIOPEN_THROW(miopenStatusBadParm, "The FusionPlan was not compiled for execution");
+
+    const auto& lens      = output_desc.GetLengths();
+    const auto& conv_lens = conv_out_desc.GetLengths();
+    const auto n_elems    = output_desc.GetElementSize();
+    const auto hw         = conv_out_desc.GetElementSize() / (conv_lens[0] * conv_lens[1]);
+
+    auto args = std::vector<OpKernelArg>{};
+    args.emplace_back(output);
+    args.emplace_back(static_cast<unsigned>(n_elems));
+    args.emplace_back(static_cast<unsigned>(hw));
+    args.emplace_back(static_cast<unsigned>(lens[1]));
+    args.emplace_back(conv_out);
+    if(pooling != nullptr)
+    {
+        args.emplace_back(static_cast<unsigned>(conv_lens[2]));
+        args.emplace_back(static_cast<unsigned>(conv_lens[3]));
+        args.emplace_back(static_cast<unsigned>(lens[2]));
+        args.emplace_back(static_cast<unsigned>(lens[3]));
+    }
+    else
+    {
+        args.insert(args.end(), 4, OpKernelArg(0u));
+    }
+
+    for(const auto& chain_op : GetEpilogueChain(op_map))
+    {
+        const auto& op = *chain_op;
+        // The unused tensors of a slot point to the output, so the kernel gets valid buffers.
+        auto tensors = std::vector<ConstData_t>(4, output);
+        auto scalars = std::vector<float>(3, 0.f);
+        switch(GetEpilogueOp(op))
+        {
+        case EpilogueBias: tensors[0] = GetArg<ConstData_t>(op_args, *key_index++); break;
+        case EpilogueActiv:
+            for(auto& scalar : scalars)
+                scalar = GetActivArg(op_args, *key_index++, data_type);
+            break;
+        case EpilogueBnSpatial:
+        case EpilogueBnPerActivation:
+            for(auto& tensor : tensors)
+                tensor = GetArg<ConstData_t>(op_args, *key_index++);
+            scalars[0] = static_cast<float>(GetArg<double>(op_args, *key_index++));
+            break;
+        case EpilogueAdd: tensors[0] = GetArg<ConstData_t>(op_args, *key_index++); break;
+        default: MIOPEN_THROW(miopenStatusInternalError, "Unsupported op in the generic epilogue");
+        }
+        for(const auto tensor : tensors)
+            args.emplace_back(tensor);
+        for(const auto scalar : scalars)
+            args.emplace_back(scalar);
+    }
+
+    const auto conv_time = handle.IsProfilingEnabled() ? handle.GetKernelTime() : 0.f;
+    kernels.front()(args);
+    if(handle.IsProfilingEnabled())
+        handle.AccumKernelTime(conv_time);
+}
+
+} // namespace miopen
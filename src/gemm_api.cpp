@@ -0,0 +1,226 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/config.h>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+
+#if MIOPEN_USE_GEMM
+#include <miopen/gemm_v2.hpp>
+#endif
+
+#include <algorithm>
+
+static void ValidateGemm(miopenDataType_t dataType,
+                         bool transA,
+                         bool transB,
+                         int m,
+                         int n,
+                         int k,
+                         const void* A,
+                         int lda,
+                         const void* B,
+                         int ldb,
+                         void* C,
+                         int ldc,
+                         int batchCount)
+{
+    if(dataType != miopenFloat && dataType != miopenHalf && dataType != miopenBFloat16)
+        MIOPEN_THROW(miopenStatusBadParm, "GEMM supports fp32, fp16 and bfp16 only");
+    if(m < 0 || n < 0 || k < 0 || batchCount < 1)
+        MIOPEN_THROW(miopenStatusBadParm, "Invalid GEMM size");
+    if(lda < std::max(1, transA ? m : k) || ldb < std::max(1, transB ? k : n) ||
+       ldc < std::max(1, n))
+        MIOPEN_THROW(miopenStatusBadParm, "GEMM leading dimension is shorter than a row");
+    if(A == nullptr || B == nullptr || C == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm);
+}
+
+static void RunGemm(miopenHandle_t handle,
+                    miopenDataType_t dataType,
+                    bool transA,
+                    bool transB,
+                    int m,
+                    int n,
+                    int k,
+                    float alpha,
+                    const void* A,
+                    int lda,
+                    long long strideA,
+                    const void* B,
+                    int ldb,
+                    long long strideB,
+                    float beta,
+                    void* C,
+                    int ldc,
+                    long long strideC,
+                    int batchCount)
+{
+    ValidateGemm(dataType, transA, transB, m, n, k, A, lda, B, ldb, C, ldc, batchCount);
+
+#if MIOPEN_USE_GEMM
+    // Row-major, as the GEMMs of the convolutions, so the same tuning records apply.
+    const miopen::GemmDescriptor gemm_desc{false,
+                                           transA,
+                                           transB,
+                                           m,
+                                           n,
+                                           k,
+                                           lda,
+                                           ldb,
+                                           ldc,
+                                           batchCount,
+                                           strideA,
+                                           strideB,
+                                           strideC,
+                                           alpha,
+                                           beta,
+                                           dataType};
+
+    auto&& h = miopen::deref(handle);
+    const auto status =
+        batchCount > 1
+            ? miopen::CallGemmStridedBatched(
+                  h, gemm_desc, DataCast(A), 0, DataCast(B), 0, DataCast(C), 0, nullptr, false)
+            : miopen::CallGemm(
+                  h, gemm_desc, DataCast(A), 0, DataCast(B), 0, DataCast(C), 0, nullptr, false);
+    if(status != miopenStatusSuccess)
+        MIOPEN_THROW(status, "GEMM failed");
+#else
+    std::ignore = handle;
+    std::ignore = alpha;
+    std::ignore = strideA;
+    std::ignore = strideB;
+    std::ignore = beta;
+    std::ignore = strideC;
+    MIOPEN_THROW(miopenStatusNotImplemented, "GEMM is not supported");
+#endif
+}
+
+extern "C" miopenStatus_t miopenGemm(miopenHandle_t handle,
+                                     miopenDataType_t dataType,
+                                     bool transA,
+                                     bool transB,
+                                     int m,
+                                     int n,
+                                     int k,
+                                     float alpha,
+                                     const void* A,
+                                     int lda,
+                                     const void* B,
+                                     int ldb,
+                                     float beta,
+                                     void* C,
+                                     int ldc)
+{
+
+    MIOPEN_LOG_FUNCTION(
+        handle, dataType, transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+    return miopen::try_([&] {
+        RunGemm(handle,
+                dataType,
+                transA,
+                transB,
+                m,
+                n,
+                k,
+                alpha,
+                A,
+                lda,
+                0,
+                B,
+                ldb,
+                0,
+                beta,
+                C,
+                ldc,
+                0,
+                1);
+    });
+}
+
+extern "C" miopenStatus_t miopenGemmStridedBatched(miopenHandle_t handle,
+                                                   miopenDataType_t dataType,
+                                                   bool transA,
+                                                   bool transB,
+                                                   int m,
+                                                   int n,
+                                                   int k,
+                                                   float alpha,
+                                                   const void* A,
+                                                   int lda,
+                                                   long long strideA,
+                                                   const void* B,
+                                                   int ldb,
+                                                   long long strideB,
+                                                   float beta,
+                                                   void* C,
+                                                   int ldc,
+                                                   long long strideC,
+                                                   int batchCount)
+{
+
+    MIOPEN_LOG_FUNCTION(handle,
+                        dataType,
+                        transA,
+                        transB,
+                        m,
+                        n,
+                        k,
+                        alpha,
+                        A,
+                        lda,
+                        strideA,
+                        B,
+                        ldb,
+                        strideB,
+                        beta,
+                        C,
+                        ldc,
+                        strideC,
+                        batchCount);
+    return miopen::try_([&] {
+        RunGemm(handle,
+                dataType,
+                transA,
+                transB,
+                m,
+                n,
+                k,
+                alpha,
+                A,
+                lda,
+                strideA,
+                B,
+                ldb,
+                strideB,
+                beta,
+                C,
+                ldc,
+                strideC,
+                batchCount);
+    });
+}
@@ -29,6 +29,9 @@
 #include <miopen/tensor.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/finddb_kernel_cache_key.hpp>
+#include <miopen/db.hpp>
+#include <miopen/db_path.hpp>
+#include <miopen/float_equal.hpp>
 
 #if MIOPEN_USE_ROCBLAS
 #include <half.hpp>
@@ -43,6 +46,13 @@
 
 #include <boost/range/adaptors.hpp>
 
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
 #if MIOPEN_USE_ROCBLAS
 #define ROCBLAS_TIMING_MEMSET_SIZE (10 * 1024 * 1024)
 
@@ -201,6 +211,171 @@ static GemmBackend_t enforce_gemm_backend(miopenDataType_t data_type,
     return gemm_backend_enforced;
 }
 
+// MIOPEN_GEMM_ENFORCE_BACKEND=4 picks the backend of each fp32 GEMM shape by timing rocBLAS and
+// MIOpenGEMM on its first call. The winner is kept in memory and in a GEMM db next to the user
+// perf db, so the timing is paid once per shape and machine.
+static bool IsGemmBackendTuned(miopenDataType_t data_type, GemmBackend_t gemm_backend_preferred)
+{
+#if MIOPEN_USE_ROCBLAS && MIOPEN_USE_MIOPENGEMM
+    return Value(MIOPEN_GEMM_ENFORCE_BACKEND{}) == 4 && data_type == miopenFloat &&
+           gemm_backend_preferred != GemmBackend_t::nogemmbackend;
+#else
+    (void)data_type;
+    (void)gemm_backend_preferred;
+    return false;
+#endif
+}
+
+namespace {
+
+struct GemmBackendTuning
+{
+    int backend           = GemmBackend_t::nogemmbackend;
+    float rocblas_time    = 0.0f;
+    float miopengemm_time = 0.0f;
+
+    void Serialize(std::ostream& stream) const
+    {
+        stream << backend << ',' << rocblas_time << ',' << miopengemm_time;
+    }
+
+    bool Deserialize(const std::string& str)
+    {
+        std::istringstream ss{str};
+        char sep0 = 0;
+        char sep1 = 0;
+        if(!(ss >> backend >> sep0 >> rocblas_time >> sep1 >> miopengemm_time))
+            return false;
+        return sep0 == ',' && sep1 == ',' &&
+               (backend == GemmBackend_t::rocblas || backend == GemmBackend_t::miopengemm);
+    }
+};
+
+/// Runs the GEMM with the given backend into the given C buffer.
+using GemmBackendCall = std::function<miopenStatus_t(GemmBackend_t, Data_t)>;
+
+} // namespace
+
+static std::string GetGemmTuningDbPath(const Handle& handle)
+{
+    const auto& udb = GetUserDbPath();
+    if(udb.empty())
+        return "";
+    return udb + "/" + handle.GetDbBasename() + "." + GetUserDbSuffix() + ".gemm.updb.txt";
+}
+
+static std::string GetGemmTuningKey(const GemmDescriptor& gemm_desc, CallGemmType_t call_gemm_type)
+{
+    std::ostringstream ss;
+    ss << call_gemm_type << '-' << gemm_desc.isColMajor << gemm_desc.transA << gemm_desc.transB
+       << '-' << gemm_desc.m << 'x' << gemm_desc.n << 'x' << gemm_desc.k << '-' << gemm_desc.lda
+       << 'x' << gemm_desc.ldb << 'x' << gemm_desc.ldc << '-' << gemm_desc.batch_count << '-'
+       << gemm_desc.strideA << 'x' << gemm_desc.strideB << 'x' << gemm_desc.strideC << '-'
+       << gemm_desc.dataType;
+    return ss.str();
+}
+
+// The number of elements spanned by one C matrix of a GEMM.
+static std::size_t GetGemmCSpan(const GemmDescriptor& gemm_desc)
+{
+    const auto rows = gemm_desc.isColMajor ? gemm_desc.n : gemm_desc.m;
+    const auto cols = gemm_desc.isColMajor ? gemm_desc.m : gemm_desc.n;
+    return static_cast<std::size_t>(rows - 1) * gemm_desc.ldc + cols;
+}
+
+// The size in bytes of the C matrices of a GEMM, from the start of the buffer.
+static std::size_t GetGemmCSize(const GemmDescriptor& gemm_desc, int c_offset, bool batched)
+{
+    auto elements = static_cast<std::size_t>(c_offset) + GetGemmCSpan(gemm_desc);
+    if(batched && gemm_desc.batch_count > 1)
+        elements += static_cast<std::size_t>(gemm_desc.strideC) * (gemm_desc.batch_count - 1);
+    return elements * GetTypeSize(gemm_desc.dataType);
+}
+
+static float TimeGemmBackend(const Handle& handle,
+                             const GemmBackendCall& call,
+                             GemmBackend_t backend,
+                             Data_t C)
+{
+    try
+    {
+        // The warm-up call also builds the MIOpenGEMM kernels.
+        if(call(backend, C) != miopenStatusSuccess)
+            return std::numeric_limits<float>::max();
+        handle.ResetKernelTime();
+        if(call(backend, C) != miopenStatusSuccess)
+            return std::numeric_limits<float>::max();
+        return handle.GetKernelTime();
+    }
+    catch(const Exception& ex)
+    {
+        MIOPEN_LOG_W("GEMM backend " << backend << " failed while tuning: " << ex.what());
+        return std::numeric_limits<float>::max();
+    }
+}
+
+static GemmBackend_t SelectGemmBackend(const Handle& handle,
+                                       const GemmDescriptor& gemm_desc,
+                                       CallGemmType_t call_gemm_type,
+                                       GemmBackend_t gemm_backend_preferred,
+                                       std::size_t c_size,
+                                       const GemmBackendCall& call)
+{
+    if(!IsGemmBackendTuned(gemm_desc.dataType, gemm_backend_preferred))
+        return enforce_gemm_backend(gemm_desc.dataType, gemm_backend_preferred);
+
+    static std::mutex mutex;
+    static std::unordered_map<std::string, GemmBackend_t> tuned;
+
+    const auto key     = GetGemmTuningKey(gemm_desc, call_gemm_type);
+    const auto mem_key = handle.GetDbBasename() + "-" + key;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto it = tuned.find(mem_key);
+        if(it != tuned.end())
+            return it->second;
+    }
+
+    const auto db_path = GetGemmTuningDbPath(handle);
+    auto tuning        = GemmBackendTuning{};
+    auto found         = false;
+    if(!db_path.empty())
+    {
+        auto db           = PlainTextDb{db_path};
+        const auto record = db.FindRecord(key);
+        found             = record && record->GetValues("gemm", tuning);
+    }
+
+    if(!found)
+    {
+        // Both backends are timed on a scratch C, so that a GEMM with beta != 0 still
+        // accumulates into the user buffer exactly once.
+        auto scratch = handle.Create(c_size, miopenAllocationScratch);
+        {
+            AutoEnableProfiling enable_profiling{handle};
+            tuning.rocblas_time =
+                TimeGemmBackend(handle, call, GemmBackend_t::rocblas, scratch.get());
+            tuning.miopengemm_time =
+                TimeGemmBackend(handle, call, GemmBackend_t::miopengemm, scratch.get());
+        }
+        tuning.backend = tuning.miopengemm_time < tuning.rocblas_time ? GemmBackend_t::miopengemm
+                                                                      : GemmBackend_t::rocblas;
+        MIOPEN_LOG_I2("GEMM " << key << ": rocBLAS " << tuning.rocblas_time << " ms, MIOpenGEMM "
+                              << tuning.miopengemm_time << " ms");
+        if(!db_path.empty())
+        {
+            auto db = PlainTextDb{db_path};
+            if(!db.Update(key, "gemm", tuning))
+                MIOPEN_LOG_W("Unable to store the GEMM backend tuning to " << db_path);
+        }
+    }
+
+    const auto backend = static_cast<GemmBackend_t>(tuning.backend);
+    std::lock_guard<std::mutex> lock(mutex);
+    tuned.emplace(mem_key, backend);
+    return backend;
+}
+
 miopenStatus_t CallGemmTimeMeasure(const Handle& handle,
                                    GemmDescriptor gemm_desc,
                                    ConstData_t A,
@@ -310,17 +485,17 @@ miopenStatus_t CallGemmTimeMeasure(const Handle& handle,
     return miopenStatusNotImplemented;
 }
 
-miopenStatus_t CallGemm(const Handle& handle,
-                        GemmDescriptor gemm_desc,
-                        ConstData_t A,
-                        int a_offset,
-                        ConstData_t B,
-                        int b_offset,
-                        Data_t C,
-                        int c_offset,
-                        FindDbKCacheKey* kcache_key,
-                        bool enqueue_dummy_kernel,
-                        GemmBackend_t gemm_backend)
+static miopenStatus_t CallGemmBackend(const Handle& handle,
+                                      GemmDescriptor gemm_desc,
+                                      ConstData_t A,
+                                      int a_offset,
+                                      ConstData_t B,
+                                      int b_offset,
+                                      Data_t C,
+                                      int c_offset,
+                                      FindDbKCacheKey* kcache_key,
+                                      bool enqueue_dummy_kernel,
+                                      GemmBackend_t gemm_backend)
 {
 #if !MIOPEN_USE_ROCBLAS
     (void)enqueue_dummy_kernel;
@@ -328,8 +503,6 @@ miopenStatus_t CallGemm(const Handle& handle,
 
     MIOPEN_LOG_I2("gemm_desc: " << gemm_desc);
 
-    gemm_backend = enforce_gemm_backend(gemm_desc.dataType, gemm_backend);
-
     // do row-to-column major conversion here
     if(!gemm_desc.isColMajor)
     {
@@ -616,17 +789,49 @@ miopenStatus_t CallGemm(const Handle& handle,
     return miopenStatusUnknownError;
 }
 
-miopenStatus_t CallGemmStridedBatched(const Handle& handle,
-                                      GemmDescriptor gemm_desc,
-                                      ConstData_t A,
-                                      int a_offset,
-                                      ConstData_t B,
-                                      int b_offset,
-                                      Data_t C,
-                                      int c_offset,
-                                      FindDbKCacheKey* kcache_key,
-                                      bool enqueue_dummy_kernel,
-                                      GemmBackend_t gemm_backend)
+miopenStatus_t CallGemm(const Handle& handle,
+                        GemmDescriptor gemm_desc,
+                        ConstData_t A,
+                        int a_offset,
+                        ConstData_t B,
+                        int b_offset,
+                        Data_t C,
+                        int c_offset,
+                        FindDbKCacheKey* kcache_key,
+                        bool enqueue_dummy_kernel,
+                        GemmBackend_t gemm_backend)
+{
+    const auto c_size = GetGemmCSize(gemm_desc, c_offset, false);
+    gemm_backend      = SelectGemmBackend(
+        handle, gemm_desc, callGemm, gemm_backend, c_size, [&](GemmBackend_t backend, Data_t c) {
+            return CallGemmBackend(
+                handle, gemm_desc, A, a_offset, B, b_offset, c, c_offset, nullptr, false, backend);
+        });
+
+    return CallGemmBackend(handle,
+                           gemm_desc,
+                           A,
+                           a_offset,
+                           B,
+                           b_offset,
+                           C,
+                           c_offset,
+                           kcache_key,
+                           enqueue_dummy_kernel,
+                           gemm_backend);
+}
+
+static miopenStatus_t CallGemmBackendStridedBatched(const Handle& handle,
+                                                    GemmDescriptor gemm_desc,
+                                                    ConstData_t A,
+                                                    int a_offset,
+                                                    ConstData_t B,
+                                                    int b_offset,
+                                                    Data_t C,
+                                                    int c_offset,
+                                                    FindDbKCacheKey* kcache_key,
+                                                    bool enqueue_dummy_kernel,
+                                                    GemmBackend_t gemm_backend)
 {
 #if !MIOPEN_USE_ROCBLAS
     (void)enqueue_dummy_kernel;
@@ -634,8 +839,6 @@ miopenStatus_t CallGemmStridedBatched(const Handle& handle,
 
     MIOPEN_LOG_I2("gemm_desc: " << gemm_desc);
 
-    gemm_backend = enforce_gemm_backend(gemm_desc.dataType, gemm_backend);
-
     // do row-to-column major conversion here
     if(!gemm_desc.isColMajor)
     {
@@ -879,6 +1082,51 @@ miopenStatus_t CallGemmStridedBatched(const Handle& handle,
     return miopenStatusUnknownError;
 }
 
+miopenStatus_t CallGemmStridedBatched(const Handle& handle,
+                                      GemmDescriptor gemm_desc,
+                                      ConstData_t A,
+                                      int a_offset,
+                                      ConstData_t B,
+                                      int b_offset,
+                                      Data_t C,
+                                      int c_offset,
+                                      FindDbKCacheKey* kcache_key,
+                                      bool enqueue_dummy_kernel,
+                                      GemmBackend_t gemm_backend)
+{
+    const auto c_size = GetGemmCSize(gemm_desc, c_offset, true);
+    gemm_backend      = SelectGemmBackend(handle,
+                                     gemm_desc,
+                                     callGemmStridedBatched,
+                                     gemm_backend,
+                                     c_size,
+                                     [&](GemmBackend_t backend, Data_t c) {
+                                         return CallGemmBackendStridedBatched(handle,
+                                                                              gemm_desc,
+                                                                              A,
+                                                                              a_offset,
+                                                                              B,
+                                                                              b_offset,
+                                                                              c,
+                                                                              c_offset,
+                                                                              nullptr,
+                                                                              false,
+                                                                              backend);
+                                     });
+
+    return CallGemmBackendStridedBatched(handle,
+                                         gemm_desc,
+                                         A,
+                                         a_offset,
+                                         B,
+                                         b_offset,
+                                         C,
+                                         c_offset,
+                                         kcache_key,
+                                         enqueue_dummy_kernel,
+                                         gemm_backend);
+}
+
 miopenStatus_t CallGemmStridedBatchedSequential(const Handle& handle,
                                                 GemmDescriptor gemm_desc,
                                                 ConstData_t A,
@@ -1223,6 +1471,113 @@ miopenStatus_t CallGemmStridedBatchedSequential(const Handle& handle,
     return miopenStatusUnknownError;
 }
 
+// Whether two problems of a group differ in their offsets only, so that they may share a
+// strided batched launch.
+static bool IsSameGemmShape(const GemmGroupProblem& x, const GemmGroupProblem& y)
+{
+    const auto& a = x.gemm_desc;
+    const auto& b = y.gemm_desc;
+    return x.A == y.A && x.B == y.B && x.C == y.C && a.batch_count == 1 && b.batch_count == 1 &&
+           a.isColMajor == b.isColMajor && a.transA == b.transA && a.transB == b.transB &&
+           a.m == b.m && a.n == b.n && a.k == b.k && a.lda == b.lda && a.ldb == b.ldb &&
+           a.ldc == b.ldc && float_equal(a.alpha, b.alpha) && float_equal(a.beta, b.beta) &&
+           a.dataType == b.dataType;
+}
+
+miopenStatus_t CallGemmGrouped(const Handle& handle,
+                               const std::vector<GemmGroupProblem>& problems,
+                               GemmBackend_t gemm_backend)
+{
+    // The problems of each shape, in order of first appearance.
+    std::vector<std::vector<const GemmGroupProblem*>> shapes;
+    for(const auto& problem : problems)
+    {
+        auto shape = std::find_if(shapes.begin(), shapes.end(), [&](const auto& same) {
+            return IsSameGemmShape(*same.front(), problem);
+        });
+        if(shape == shapes.end())
+            shapes.push_back({&problem});
+        else
+            shape->push_back(&problem);
+    }
+
+    float time = 0.0f;
+    for(const auto& same : shapes)
+    {
+        const auto c_span = static_cast<long long>(GetGemmCSpan(same.front()->gemm_desc));
+        for(std::size_t first = 0; first < same.size();)
+        {
+            // The longest run of evenly spaced problems with disjoint C matrices.
+            long long stride_a = 0;
+            long long stride_b = 0;
+            long long stride_c = 0;
+            auto last          = first + 1;
+            if(last < same.size())
+            {
+                stride_a = static_cast<long long>(same[last]->a_offset) - same[first]->a_offset;
+                stride_b = static_cast<long long>(same[last]->b_offset) - same[first]->b_offset;
+                stride_c = static_cast<long long>(same[last]->c_offset) - same[first]->c_offset;
+                if(stride_a >= 0 && stride_b >= 0 && stride_c >= c_span)
+                {
+                    ++last;
+                    while(last < same.size() &&
+                          same[last]->a_offset - same[last - 1]->a_offset == stride_a &&
+                          same[last]->b_offset - same[last - 1]->b_offset == stride_b &&
+                          same[last]->c_offset - same[last - 1]->c_offset == stride_c)
+                        ++last;
+                }
+            }
+
+            const auto& problem = *same[first];
+            auto gemm_desc      = problem.gemm_desc;
+            miopenStatus_t gemm_status;
+            if(last - first > 1)
+            {
+                gemm_desc.batch_count = static_cast<int>(last - first);
+                gemm_desc.strideA     = stride_a;
+                gemm_desc.strideB     = stride_b;
+                gemm_desc.strideC     = stride_c;
+            }
+            if(gemm_desc.batch_count > 1)
+                gemm_status = CallGemmStridedBatched(handle,
+                                                     gemm_desc,
+                                                     problem.A,
+                                                     problem.a_offset,
+                                                     problem.B,
+                                                     problem.b_offset,
+                                                     problem.C,
+                                                     problem.c_offset,
+                                                     nullptr,
+                                                     false,
+                                                     gemm_backend);
+            else
+                gemm_status = CallGemm(handle,
+                                       gemm_desc,
+                                       problem.A,
+                                       problem.a_offset,
+                                       problem.B,
+                                       problem.b_offset,
+                                       problem.C,
+                                       problem.c_offset,
+                                       nullptr,
+                                       false,
+                                       gemm_backend);
+            if(gemm_status != miopenStatusSuccess)
+                return gemm_status;
+            if(handle.IsProfilingEnabled())
+                time += handle.GetKernelTime();
+            first = last;
+        }
+    }
+
+    if(handle.IsProfilingEnabled())
+    {
+        handle.ResetKernelTime();
+        handle.AccumKernelTime(time);
+    }
+    return miopenStatusSuccess;
+}
+
 // y = w * Im2Col(x)
 GemmDescriptor CreateGemmDescriptorConvFwd(const TensorDescriptor& wDesc,
                                            const TensorDescriptor& xDesc,
@@ -0,0 +1,171 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/gpu_sensors.hpp>
+
+#include <miopen/db.hpp>
+#include <miopen/db_path.hpp>
+#include <miopen/env.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_GPU_SENSORS)
+
+namespace miopen {
+
+namespace {
+
+std::string GetConditionsPath() { return GetUserDbPath() + "/tuning_conditions.txt"; }
+
+int ReadInt(const std::string& path)
+{
+    std::ifstream file{path};
+    auto value = 0;
+    return file >> value ? value : 0;
+}
+
+} // namespace
+
+int ParseCurrentSclk(const std::string& pp_dpm_sclk)
+{
+    // Lines look like "1: 1000Mhz *".
+    std::istringstream ss{pp_dpm_sclk};
+    std::string line;
+    while(std::getline(ss, line))
+    {
+        if(line.find('*') == std::string::npos)
+            continue;
+        const auto colon = line.find(':');
+        if(colon == std::string::npos)
+            return 0;
+        std::istringstream level{line.substr(colon + 1)};
+        auto mhz = 0;
+        return level >> mhz ? mhz : 0;
+    }
+    return 0;
+}
+
+GpuSensors::GpuSensors(const std::string& device_dir)
+{
+    namespace fs = boost::filesystem;
+    boost::system::error_code ec;
+    const auto dir = fs::path{device_dir};
+    if(!fs::exists(dir / "pp_dpm_sclk", ec))
+        return;
+    sclk_path = (dir / "pp_dpm_sclk").string();
+
+    // The driver registers one hwmon device per GPU, its number is not stable across boots.
+    for(fs::directory_iterator it{dir / "hwmon", ec}, end; !ec && it != end; it.increment(ec))
+    {
+        const auto temperature = it->path() / "temp1_input";
+        if(fs::exists(temperature, ec))
+        {
+            temperature_path = temperature.string();
+            break;
+        }
+    }
+}
+
+GpuSensors GpuSensors::FromHandle(const Handle& handle)
+{
+    if(miopen::IsDisabled(MIOPEN_DEBUG_GPU_SENSORS{}))
+        return {};
+    const auto bus_id = handle.GetPciBusId();
+    if(bus_id.empty())
+        return {};
+    auto sensors = GpuSensors{"/sys/bus/pci/devices/" + bus_id};
+    if(!sensors.IsEnabled())
+        MIOPEN_LOG_I2("No clock sensors for " << bus_id);
+    return sensors;
+}
+
+GpuConditions GpuSensors::Read() const
+{
+    auto conditions = GpuConditions{};
+    if(!IsEnabled())
+        return conditions;
+    std::ifstream file{sclk_path};
+    std::stringstream contents;
+    contents << file.rdbuf();
+    conditions.sclk_mhz = ParseCurrentSclk(contents.str());
+    if(!temperature_path.empty())
+        conditions.temperature_mc = ReadInt(temperature_path);
+    return conditions;
+}
+
+void TuningConditions::Add(const GpuConditions& conditions)
+{
+    if(!conditions.IsKnown())
+        return;
+    min_sclk_mhz = IsKnown() ? std::min(min_sclk_mhz, conditions.sclk_mhz) : conditions.sclk_mhz;
+    max_sclk_mhz = std::max(max_sclk_mhz, conditions.sclk_mhz);
+    max_temperature_mc = std::max(max_temperature_mc, conditions.temperature_mc);
+}
+
+void TuningConditions::SetBest(const GpuConditions& conditions)
+{
+    best_sclk_mhz       = conditions.sclk_mhz;
+    best_temperature_mc = conditions.temperature_mc;
+}
+
+// best_sclk_mhz,best_temperature_mc,min_sclk_mhz,max_sclk_mhz,max_temperature_mc,remeasured
+void TuningConditions::Serialize(std::ostream& stream) const
+{
+    stream << best_sclk_mhz << ',' << best_temperature_mc << ',' << min_sclk_mhz << ','
+           << max_sclk_mhz << ',' << max_temperature_mc << ',' << remeasured;
+}
+
+bool TuningConditions::Deserialize(const std::string& str)
+{
+    std::istringstream ss{str};
+    auto out   = TuningConditions{};
+    auto comma = std::vector<char>(5);
+    if(!(ss >> out.best_sclk_mhz >> comma[0] >> out.best_temperature_mc >> comma[1] >>
+         out.min_sclk_mhz >> comma[2] >> out.max_sclk_mhz >> comma[3] >> out.max_temperature_mc >>
+         comma[4] >> out.remeasured))
+        return false;
+    if(std::any_of(comma.begin(), comma.end(), [](char c) { return c != ','; }))
+        return false;
+    *this = out;
+    return true;
+}
+
+void TuningConditions::Store(const std::string& key, const std::string& id) const
+{
+    if(!IsKnown())
+        return;
+    auto db = PlainTextDb{GetConditionsPath()};
+    if(!db.Update(key, id, *this))
+        MIOPEN_LOG_E("Unable to save the tuning conditions to " << GetConditionsPath());
+}
+
+} // namespace miopen
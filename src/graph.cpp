@@ -0,0 +1,527 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/graph.hpp>
+
+#include <miopen/batch_norm.hpp>
+#include <miopen/conv/plan.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/fusion.hpp>
+#include <miopen/fusion_plan.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/tensor_ops.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <string>
+
+namespace miopen {
+
+namespace {
+
+// OpenCL sub-buffers need an origin aligned to the base address alignment of the device.
+constexpr std::size_t tensor_alignment = 4096;
+
+std::size_t AlignUp(std::size_t value, std::size_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+const float alpha = 1.0f;
+const float beta  = 0.0f;
+
+} // namespace
+
+int Graph::AddTensor(const TensorDescriptor& desc, bool external)
+{
+    compiled = false;
+    tensors.push_back({desc, external});
+    return static_cast<int>(tensors.size() - 1);
+}
+
+const Graph::Tensor& Graph::GetTensor(int id) const
+{
+    if(id < 0 || id >= static_cast<int>(tensors.size()))
+        MIOPEN_THROW(miopenStatusBadParm, "Unknown graph tensor " + std::to_string(id));
+    return tensors[id];
+}
+
+void Graph::AddNode(Node node)
+{
+    const auto written = [&](int id) {
+        return std::any_of(
+            nodes.begin(), nodes.end(), [&](const Node& n) { return n.output == id; });
+    };
+
+    for(const auto input : node.inputs)
+    {
+        if(!GetTensor(input).external && !written(input))
+            MIOPEN_THROW(miopenStatusBadParm,
+                         "Graph tensor " + std::to_string(input) +
+                             " is read before any node writes it");
+        if(input == node.output)
+            MIOPEN_THROW(miopenStatusBadParm,
+                         "Graph tensor " + std::to_string(input) + " is both read and written");
+    }
+    GetTensor(node.output);
+    if(written(node.output))
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "Graph tensor " + std::to_string(node.output) + " is written twice");
+
+    compiled = false;
+    nodes.push_back(std::move(node));
+}
+
+void Graph::AddConvolutionForward(const ConvolutionDescriptor& conv, int x, int w, int y)
+{
+    auto node = Node{Kind::Convolution, {x, w}, y};
+    node.conv = conv;
+    AddNode(std::move(node));
+}
+
+void Graph::AddActivationForward(const ActivationDescriptor& activ, int x, int y)
+{
+    auto node  = Node{Kind::Activation, {x}, y};
+    node.activ = activ;
+    AddNode(std::move(node));
+}
+
+void Graph::AddBatchNormInference(miopenBatchNormMode_t mode,
+                                  double epsilon,
+                                  int x,
+                                  int scale,
+                                  int bias,
+                                  int mean,
+                                  int variance,
+                                  int y)
+{
+    auto node    = Node{Kind::BatchNormInference, {x, scale, bias, mean, variance}, y};
+    node.bn_mode = mode;
+    node.epsilon = epsilon;
+    AddNode(std::move(node));
+}
+
+void Graph::AddPoolingForward(const PoolingDescriptor& pooling, int x, int y)
+{
+    auto node    = Node{Kind::Pooling, {x}, y};
+    node.pooling = pooling;
+    AddNode(std::move(node));
+}
+
+void Graph::AddOpTensor(miopenTensorOp_t op, int a, int b, int c)
+{
+    auto node      = Node{Kind::OpTensor, {a, b}, c};
+    node.tensor_op = op;
+    AddNode(std::move(node));
+}
+
+std::size_t Graph::GetFusableLength(std::size_t first) const
+{
+    const auto& head = nodes[first];
+    if(head.kind != Kind::Convolution && head.kind != Kind::BatchNormInference)
+        return 0;
+
+    // The ops a fusion plan takes after the head, in order; each one is optional.
+    const auto chain = head.kind == Kind::Convolution
+                           ? std::vector<Kind>{Kind::OpTensor, Kind::Activation, Kind::Pooling}
+                           : std::vector<Kind>{Kind::Activation};
+
+    auto current = head.output;
+    auto next    = first + 1;
+    auto stage   = chain.begin();
+    for(; next < nodes.size(); ++next)
+    {
+        const auto& node = nodes[next];
+        // The intermediate result must not be needed anywhere else.
+        const auto uses = std::count_if(nodes.begin(), nodes.end(), [&](const Node& n) {
+            return std::count(n.inputs.begin(), n.inputs.end(), current) > 0;
+        });
+        if(tensors[current].external || uses != 1 ||
+           std::count(node.inputs.begin(), node.inputs.end(), current) != 1)
+            break;
+
+        stage = std::find(stage, chain.end(), node.kind);
+        if(stage == chain.end())
+            break;
+        if(node.kind == Kind::OpTensor)
+        {
+            // Only a per channel bias is fused.
+            const auto bias     = node.inputs[0] == current ? node.inputs[1] : node.inputs[0];
+            const auto& lengths = tensors[current].desc.GetLengths();
+            if(node.tensor_op != miopenTensorOpAdd || !tensors[bias].external ||
+               lengths.size() != 4 ||
+               tensors[bias].desc.GetLengths() != std::vector<std::size_t>{1, lengths[1], 1, 1})
+                break;
+        }
+        ++stage;
+        current = node.output;
+    }
+
+    const auto length = next - first;
+    return length < 2 ? 0 : length;
+}
+
+bool Graph::TryFuse(Handle& handle, std::size_t first, std::size_t length)
+{
+    const auto& head = nodes[first];
+    const auto in    = head.inputs[0];
+    const auto out   = nodes[first + length - 1].output;
+
+    auto plan = std::make_shared<FusionPlanDescriptor>(miopenVerticalFusion, tensors[in].desc);
+    std::vector<std::shared_ptr<FusionOpDescriptor>> ops;
+
+    auto current = in;
+    for(auto i = first; i < first + length; ++i)
+    {
+        const auto& node = nodes[i];
+        switch(node.kind)
+        {
+        case Kind::Convolution: {
+            auto conv = *node.conv;
+            auto w    = tensors[node.inputs[1]].desc;
+            ops.push_back(std::make_shared<ConvForwardOpDescriptor>(conv, w));
+            break;
+        }
+        case Kind::OpTensor: {
+            const auto bias = node.inputs[0] == current ? node.inputs[1] : node.inputs[0];
+            ops.push_back(std::make_shared<BiasFusionOpDescriptor>(tensors[bias].desc));
+            break;
+        }
+        case Kind::Activation:
+            ops.push_back(std::make_shared<ActivFwdFusionOpDescriptor>(node.activ->GetMode()));
+            break;
+        case Kind::BatchNormInference:
+            ops.push_back(std::make_shared<BatchNormInferenceFusionOpDescriptor>(
+                node.bn_mode, tensors[node.inputs[1]].desc));
+            break;
+        case Kind::Pooling:
+            ops.push_back(std::make_shared<PoolingFwdFusionOpDescriptor>(*node.pooling));
+            break;
+        }
+        current = node.output;
+    }
+
+    try
+    {
+        for(const auto& op : ops)
+            if(plan->AddOp(op) != miopenStatusSuccess)
+                return false;
+        if(plan->Compile(handle) != miopenStatusSuccess)
+            return false;
+    }
+    catch(const Exception& ex)
+    {
+        MIOPEN_LOG_I2("Graph nodes " << first << " to " << first + length - 1
+                                     << " are not fused: " << ex.what());
+        return false;
+    }
+
+    const auto in_desc  = tensors[in].desc;
+    const auto out_desc = tensors[out].desc;
+    // Arguments of the ops, tensor ids are resolved at every run.
+    const auto chain = std::vector<Node>(nodes.begin() + first, nodes.begin() + first + length);
+    steps.push_back([=](Handle& h, const Buffers& buffers) {
+        OperatorArgs args;
+        auto previous = in;
+        for(std::size_t i = 0; i < chain.size(); ++i)
+        {
+            const auto& node = chain[i];
+            const auto& op   = ops[i];
+            switch(node.kind)
+            {
+            case Kind::Convolution:
+                static_cast<ConvForwardOpDescriptor&>(*op).SetArgs(
+                    args, &alpha, &beta, buffers[node.inputs[1]]);
+                break;
+            case Kind::OpTensor: {
+                const auto bias = node.inputs[0] == previous ? node.inputs[1] : node.inputs[0];
+                static_cast<BiasFusionOpDescriptor&>(*op).SetArgs(
+                    args, &alpha, &beta, buffers[bias]);
+                break;
+            }
+            case Kind::Activation:
+                static_cast<ActivFwdFusionOpDescriptor&>(*op).SetArgs(args,
+                                                                      &alpha,
+                                                                      &beta,
+                                                                      node.activ->GetAlpha(),
+                                                                      node.activ->GetBeta(),
+                                                                      node.activ->GetGamma());
+                break;
+            case Kind::BatchNormInference:
+                static_cast<BatchNormInferenceFusionOpDescriptor&>(*op).SetArgs(
+                    args,
+                    &alpha,
+                    &beta,
+                    buffers[node.inputs[1]],
+                    buffers[node.inputs[2]],
+                    buffers[node.inputs[3]],
+                    buffers[node.inputs[4]],
+                    node.epsilon);
+                break;
+            case Kind::Pooling: break;
+            }
+            previous = node.output;
+        }
+        plan->Execute(h, in_desc, buffers[in], out_desc, buffers[out], args);
+    });
+    step_nodes.emplace_back(first, length);
+    MIOPEN_LOG_I2("Graph nodes " << first << " to " << first + length - 1 << " are fused");
+    return true;
+}
+
+void Graph::AddStep(Handle& handle, std::size_t index)
+{
+    const auto& node = nodes[index];
+    const auto out   = node.output;
+    const auto in    = node.inputs[0];
+    const auto x     = tensors[in].desc;
+    const auto y     = tensors[out].desc;
+
+    switch(node.kind)
+    {
+    case Kind::Convolution: {
+        const auto wt  = node.inputs[1];
+        const auto& w  = tensors[wt].desc;
+        const auto& cd = *node.conv;
+
+        std::size_t count = 0;
+        miopenConvSolution_t solution;
+        cd.GetForwardSolutions(handle, w, x, y, 1, &count, &solution);
+        if(count == 0)
+            MIOPEN_THROW(miopenStatusNotImplemented,
+                         "No solution for the convolution of graph node " +
+                             std::to_string(index));
+        const auto plan = std::make_shared<ConvolutionPlan>(
+            handle, x, w, y, cd, conv::Direction::Forward, solution.solution_id);
+        workspace_size = std::max(workspace_size, plan->GetWorkspaceSize());
+        steps.push_back([=](Handle& h, const Buffers& buffers) {
+            plan->Run(h, buffers[in], buffers[wt], buffers[out], workspace.get(), workspace_size);
+        });
+        break;
+    }
+    case Kind::Activation: {
+        const auto activ = std::make_shared<ActivationDescriptor>(*node.activ);
+        steps.push_back([=](Handle& h, const Buffers& buffers) {
+            activ->Forward(h, &alpha, x, buffers[in], &beta, y, buffers[out]);
+        });
+        break;
+    }
+    case Kind::BatchNormInference: {
+        const auto mode    = node.bn_mode;
+        const auto epsilon = node.epsilon;
+        const auto inputs  = node.inputs;
+        const auto bn_desc = tensors[inputs[1]].desc;
+        steps.push_back([=](Handle& h, const Buffers& buffers) {
+            BatchNormForwardInference(h,
+                                      mode,
+                                      &alpha,
+                                      &beta,
+                                      x,
+                                      buffers[in],
+                                      y,
+                                      buffers[out],
+                                      bn_desc,
+                                      buffers[inputs[1]],
+                                      buffers[inputs[2]],
+                                      buffers[inputs[3]],
+                                      buffers[inputs[4]],
+                                      epsilon);
+        });
+        break;
+    }
+    case Kind::Pooling: {
+        const auto pooling = *node.pooling;
+        steps.push_back([=](Handle& h, const Buffers& buffers) {
+            pooling.Forward(
+                h, &alpha, x, buffers[in], &beta, y, buffers[out], false, nullptr, 0);
+        });
+        break;
+    }
+    case Kind::OpTensor: {
+        const auto op = node.tensor_op;
+        const auto b  = node.inputs[1];
+        const auto bd = tensors[b].desc;
+        steps.push_back([=](Handle& h, const Buffers& buffers) {
+            OpTensor(
+                h, op, &alpha, x, buffers[in], &alpha, bd, buffers[b], &beta, y, buffers[out]);
+        });
+        break;
+    }
+    }
+    step_nodes.emplace_back(index, 1);
+}
+
+void Graph::PlanMemory(Handle& handle)
+{
+    // Steps from the one writing every internal tensor to the last one reading it. The tensors
+    // passed between the ops of a fused step never reach memory.
+    const auto none = std::numeric_limits<std::size_t>::max();
+    std::vector<std::size_t> first(tensors.size(), none);
+    std::vector<std::size_t> last(tensors.size(), 0);
+    std::vector<bool> outside(tensors.size(), false);
+    for(std::size_t s = 0; s < steps.size(); ++s)
+    {
+        const auto begin = step_nodes[s].first;
+        const auto end   = begin + step_nodes[s].second;
+        for(auto i = begin; i < end; ++i)
+        {
+            const auto& node = nodes[i];
+            first[node.output] = s;
+            last[node.output]  = s;
+            if(i + 1 == end)
+                outside[node.output] = true;
+            for(const auto input : node.inputs)
+            {
+                last[input] = s;
+                if(first[input] != s)
+                    outside[input] = true;
+            }
+        }
+    }
+
+    std::vector<int> order;
+    for(std::size_t t = 0; t < tensors.size(); ++t)
+        if(!tensors[t].external && first[t] != none && outside[t])
+            order.push_back(static_cast<int>(t));
+    const auto size_of = [&](int t) {
+        return tensors[t].desc.GetElementSpace() * GetTypeSize(tensors[t].desc.GetType());
+    };
+    std::stable_sort(
+        order.begin(), order.end(), [&](int a, int b) { return size_of(a) > size_of(b); });
+
+    // Greedy first fit: the largest tensors go first to the lowest offset that is free over
+    // their whole lifetime.
+    struct Placement
+    {
+        int tensor;
+        std::size_t offset;
+        std::size_t size;
+    };
+    std::vector<Placement> placed;
+    std::vector<std::size_t> offsets(tensors.size(), 0);
+    arena_size = 0;
+    for(const auto t : order)
+    {
+        std::vector<Placement> conflicts;
+        for(const auto& p : placed)
+            if(first[p.tensor] <= last[t] && first[t] <= last[p.tensor])
+                conflicts.push_back(p);
+        std::sort(conflicts.begin(), conflicts.end(), [](const Placement& a, const Placement& b) {
+            return a.offset < b.offset;
+        });
+
+        const auto size = size_of(t);
+        auto offset     = std::size_t{0};
+        for(const auto& c : conflicts)
+        {
+            if(offset + size <= c.offset)
+                break;
+            offset = std::max(offset, AlignUp(c.offset + c.size, tensor_alignment));
+        }
+        placed.push_back({t, offset, size});
+        offsets[t] = offset;
+        arena_size = std::max(arena_size, offset + size);
+    }
+
+    internal.assign(tensors.size(), nullptr);
+    views.clear();
+    arena = arena_size > 0 ? handle.Create(arena_size) : nullptr;
+    workspace =
+        workspace_size > 0 ? handle.Create(workspace_size, miopenAllocationWorkspace) : nullptr;
+    for(const auto& p : placed)
+    {
+        views.push_back(handle.CreateSubBuffer(arena.get(), p.offset, p.size));
+        internal[p.tensor] = views.back().get();
+    }
+    MIOPEN_LOG_I2("Graph of " << nodes.size() << " nodes compiled to " << steps.size()
+                              << " steps, " << arena_size << " bytes for " << order.size()
+                              << " internal tensors");
+}
+
+void Graph::Compile(Handle& handle)
+{
+    compiled = false;
+    steps.clear();
+    step_nodes.clear();
+    workspace_size = 0;
+
+    for(std::size_t i = 0; i < nodes.size();)
+    {
+        auto length = GetFusableLength(i);
+        // A shorter chain may still fuse when the whole one does not.
+        while(length >= 2 && !TryFuse(handle, i, length))
+            --length;
+        if(length < 2)
+        {
+            AddStep(handle, i);
+            length = 1;
+        }
+        i += length;
+    }
+
+    PlanMemory(handle);
+    compiled = true;
+}
+
+std::size_t Graph::GetDeviceMemorySize() const { return arena_size + workspace_size; }
+
+void Graph::Run(Handle& handle, const std::vector<std::pair<int, Data_t>>& bindings) const
+{
+    if(!compiled)
+        MIOPEN_THROW(miopenStatusBadParm, "The graph is not compiled");
+
+    auto buffers = internal;
+    for(const auto& binding : bindings)
+    {
+        if(!GetTensor(binding.first).external)
+            MIOPEN_THROW(miopenStatusBadParm,
+                         "Graph tensor " + std::to_string(binding.first) + " is not external");
+        buffers[binding.first] = binding.second;
+    }
+    for(const auto& node : nodes)
+    {
+        auto ids = node.inputs;
+        ids.push_back(node.output);
+        for(const auto id : ids)
+            if(tensors[id].external && buffers[id] == nullptr)
+                MIOPEN_THROW(miopenStatusBadParm,
+                             "External graph tensor " + std::to_string(id) + " is not bound");
+    }
+
+    for(const auto& step : steps)
+        step(handle, buffers);
+}
+
+std::ostream& operator<<(std::ostream& stream, const Graph& graph)
+{
+    stream << "graph of " << graph.tensors.size() << " tensors, " << graph.nodes.size()
+           << " nodes";
+    if(graph.compiled)
+        stream << ", " << graph.steps.size() << " steps";
+    return stream;
+}
+
+} // namespace miopen
@@ -0,0 +1,139 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/activ.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/graph.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/pooling.hpp>
+#include <miopen/tensor.hpp>
+
+#include <utility>
+#include <vector>
+
+extern "C" miopenStatus_t miopenCreateGraph(miopenGraph_t* graph)
+{
+    MIOPEN_LOG_FUNCTION(graph);
+    return miopen::try_([&] { miopen::deref(graph) = new miopen::Graph(); });
+}
+
+extern "C" miopenStatus_t miopenDestroyGraph(miopenGraph_t graph)
+{
+    MIOPEN_LOG_FUNCTION(graph);
+    return miopen::try_([&] { miopen_destroy_object(graph); });
+}
+
+extern "C" miopenStatus_t miopenGraphAddTensor(miopenGraph_t graph,
+                                               const miopenTensorDescriptor_t desc,
+                                               bool external,
+                                               int* tensor)
+{
+    MIOPEN_LOG_FUNCTION(graph, desc, external, tensor);
+    return miopen::try_([&] {
+        miopen::deref(tensor) = miopen::deref(graph).AddTensor(miopen::deref(desc), external);
+    });
+}
+
+extern "C" miopenStatus_t miopenGraphAddConvolutionForward(
+    miopenGraph_t graph, const miopenConvolutionDescriptor_t convDesc, int x, int w, int y)
+{
+    MIOPEN_LOG_FUNCTION(graph, convDesc, x, w, y);
+    return miopen::try_(
+        [&] { miopen::deref(graph).AddConvolutionForward(miopen::deref(convDesc), x, w, y); });
+}
+
+extern "C" miopenStatus_t miopenGraphAddActivationForward(
+    miopenGraph_t graph, const miopenActivationDescriptor_t activDesc, int x, int y)
+{
+    MIOPEN_LOG_FUNCTION(graph, activDesc, x, y);
+    return miopen::try_(
+        [&] { miopen::deref(graph).AddActivationForward(miopen::deref(activDesc), x, y); });
+}
+
+extern "C" miopenStatus_t miopenGraphAddBatchNormInference(miopenGraph_t graph,
+                                                           miopenBatchNormMode_t bn_mode,
+                                                           double epsilon,
+                                                           int x,
+                                                           int scale,
+                                                           int bias,
+                                                           int mean,
+                                                           int variance,
+                                                           int y)
+{
+    MIOPEN_LOG_FUNCTION(graph, bn_mode, epsilon, x, scale, bias, mean, variance, y);
+    return miopen::try_([&] {
+        miopen::deref(graph).AddBatchNormInference(
+            bn_mode, epsilon, x, scale, bias, mean, variance, y);
+    });
+}
+
+extern "C" miopenStatus_t miopenGraphAddPoolingForward(miopenGraph_t graph,
+                                                       const miopenPoolingDescriptor_t poolDesc,
+                                                       int x,
+                                                       int y)
+{
+    MIOPEN_LOG_FUNCTION(graph, poolDesc, x, y);
+    return miopen::try_(
+        [&] { miopen::deref(graph).AddPoolingForward(miopen::deref(poolDesc), x, y); });
+}
+
+extern "C" miopenStatus_t
+miopenGraphAddOpTensor(miopenGraph_t graph, miopenTensorOp_t tensorOp, int a, int b, int c)
+{
+    MIOPEN_LOG_FUNCTION(graph, tensorOp, a, b, c);
+    return miopen::try_([&] { miopen::deref(graph).AddOpTensor(tensorOp, a, b, c); });
+}
+
+extern "C" miopenStatus_t miopenCompileGraph(miopenHandle_t handle, miopenGraph_t graph)
+{
+    MIOPEN_LOG_FUNCTION(handle, graph);
+    return miopen::try_([&] { miopen::deref(graph).Compile(miopen::deref(handle)); });
+}
+
+extern "C" miopenStatus_t miopenGraphGetDeviceMemorySize(const miopenGraph_t graph, size_t* size)
+{
+    MIOPEN_LOG_FUNCTION(graph, size);
+    return miopen::try_([&] { miopen::deref(size) = miopen::deref(graph).GetDeviceMemorySize(); });
+}
+
+extern "C" miopenStatus_t miopenRunGraph(miopenHandle_t handle,
+                                         miopenGraph_t graph,
+                                         int count,
+                                         const int* tensors,
+                                         void* const* buffers)
+{
+    MIOPEN_LOG_FUNCTION(handle, graph, count, tensors, buffers);
+    return miopen::try_([&] {
+        if(count < 0 || (count > 0 && (tensors == nullptr || buffers == nullptr)))
+            MIOPEN_THROW(miopenStatusBadParm, "Invalid graph tensor bindings");
+        std::vector<std::pair<int, Data_t>> bindings;
+        bindings.reserve(count);
+        for(auto i = 0; i < count; ++i)
+            bindings.emplace_back(tensors[i], DataCast(buffers[i]));
+        miopen::deref(graph).Run(miopen::deref(handle), bindings);
+    });
+}
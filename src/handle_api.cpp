@@ -25,6 +25,8 @@
  *******************************************************************************/
 #include <cstdio>
 #include <miopen/version.h>
+#include <miopen/binary_cache.hpp>
+#include <miopen/cache_stats.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/handle.hpp>
 
@@ -88,6 +90,22 @@ extern "C" miopenStatus_t miopenGetStream(miopenHandle_t handle, miopenAccelerat
     return miopen::try_([&] { miopen::deref(streamID) = miopen::deref(handle).GetStream(); });
 }
 
+extern "C" miopenStatus_t miopenSetThreadStream(miopenHandle_t handle,
+                                                miopenAcceleratorQueue_t streamID)
+{
+    return miopen::try_([&] { miopen::deref(handle).SetThreadStream(streamID); });
+}
+
+extern "C" miopenStatus_t miopenResetThreadStream(miopenHandle_t handle)
+{
+    return miopen::try_([&] { miopen::deref(handle).ResetThreadStream(); });
+}
+
+extern "C" miopenStatus_t miopenSetConcurrentStreamsPriority(miopenHandle_t handle, int priority)
+{
+    return miopen::try_([&] { miopen::deref(handle).SetConcurrentStreamsPriority(priority); });
+}
+
 extern "C" miopenStatus_t miopenSetAllocator(miopenHandle_t handle,
                                              miopenAllocatorFunction allocator,
                                              miopenDeallocatorFunction deallocator,
@@ -97,6 +115,15 @@ extern "C" miopenStatus_t miopenSetAllocator(miopenHandle_t handle,
         [&] { miopen::deref(handle).SetAllocator(allocator, deallocator, allocatorContext); });
 }
 
+extern "C" miopenStatus_t miopenSetAllocatorEx(miopenHandle_t handle,
+                                               miopenAllocatorFunctionEx allocator,
+                                               miopenDeallocatorFunction deallocator,
+                                               void* allocatorContext)
+{
+    return miopen::try_(
+        [&] { miopen::deref(handle).SetAllocatorEx(allocator, deallocator, allocatorContext); });
+}
+
 extern "C" miopenStatus_t miopenDestroy(miopenHandle_t handle)
 {
     return miopen::try_([&] { miopen_destroy_object(handle); });
@@ -110,3 +137,64 @@ extern "C" miopenStatus_t miopenEnableProfiling(miopenHandle_t handle, bool enab
 {
     return miopen::try_([&] { miopen::deref(handle).EnableProfiling(enable); });
 }
+
+extern "C" miopenStatus_t
+miopenSetProgramCacheLimits(miopenHandle_t handle, size_t maxPrograms, size_t maxBytes)
+{
+    return miopen::try_(
+        [&] { miopen::deref(handle).SetProgramCacheLimits(maxPrograms, maxBytes); });
+}
+
+extern "C" miopenStatus_t miopenGetCacheFootprint(miopenHandle_t handle,
+                                                  miopenCacheFootprint_t* footprint)
+{
+    return miopen::try_(
+        [&] { miopen::deref(footprint) = miopen::deref(handle).GetCacheFootprint(); });
+}
+
+extern "C" miopenStatus_t miopenEnableWorkspaceArena(miopenHandle_t handle, bool enable)
+{
+    return miopen::try_([&] { miopen::deref(handle).EnableWorkspaceArena(enable); });
+}
+
+extern "C" miopenStatus_t miopenEnableDeterministicMode(miopenHandle_t handle, bool enable)
+{
+    return miopen::try_([&] { miopen::deref(handle).EnableDeterministicMode(enable); });
+}
+
+extern "C" miopenStatus_t miopenGetDeviceMemoryUsage(miopenHandle_t handle,
+                                                     miopenDeviceMemoryUsage_t* usage)
+{
+    return miopen::try_(
+        [&] { miopen::deref(usage) = miopen::deref(handle).GetDeviceMemoryUsage(); });
+}
+
+extern "C" miopenStatus_t miopenSetDeviceMemoryLimit(miopenHandle_t handle, size_t limit)
+{
+    return miopen::try_([&] { miopen::deref(handle).SetDeviceMemoryLimit(limit); });
+}
+
+extern "C" miopenStatus_t miopenGetCacheStatistics(miopenCacheType_t cache,
+                                                   miopenCacheStatistics_t* statistics)
+{
+    return miopen::try_([&] { miopen::deref(statistics) = miopen::cache_stats::Get(cache); });
+}
+
+extern "C" miopenStatus_t miopenResetCacheStatistics()
+{
+    return miopen::try_([&] { miopen::cache_stats::Reset(); });
+}
+
+extern "C" miopenStatus_t miopenTrimKernelCache(miopenHandle_t handle,
+                                                size_t maxBytes,
+                                                miopenKernelCacheEvictPolicy_t policy,
+                                                size_t* freedBytes)
+{
+    return miopen::try_([&] {
+        const auto& h    = miopen::deref(handle);
+        const auto freed = miopen::TrimBinaryCache(
+            h.GetDeviceName(), h.GetMaxComputeUnits(), maxBytes, policy);
+        if(freedBytes != nullptr)
+            *freedBytes = freed;
+    });
+}
@@ -28,6 +28,10 @@
 #include <miopen/handle.hpp>
 
 #include <miopen/binary_cache.hpp>
+#include <miopen/cache_stats.hpp>
+#include <miopen/check_numerics.hpp>
+#include <miopen/compile_service.hpp>
+#include <miopen/db_prefetch.hpp>
 #include <miopen/device_name.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/gemm_geometry.hpp>
@@ -35,13 +39,17 @@
 #include <miopen/invoker.hpp>
 #include <miopen/kernel_cache.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/sqlite_db.hpp>
+#include <miopen/thread_streams.hpp>
 #include <miopen/timer.hpp>
+#include <miopen/trace.hpp>
 
 #if !MIOPEN_ENABLE_SQLITE_KERN_CACHE
 #include <miopen/write_file.hpp>
 #endif
 
 #include <boost/filesystem.hpp>
+#include <boost/optional.hpp>
 #include <miopen/handle_lock.hpp>
 #include <miopen/load_file.hpp>
 #include <miopen/gemm_geometry.hpp>
@@ -51,14 +59,42 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cctype>
 #include <chrono>
+#include <iterator>
+#include <map>
+#include <mutex>
 #include <thread>
+#include <tuple>
+#if MIOPEN_USE_HIP_GRAPHS
+#include <unordered_map>
+#include <unordered_set>
+#endif
 
 #define MIOPEN_WORKAROUND_ROCM_COMPILER_SUPPORT_ISSUE_30 (MIOPEN_USE_COMGR && BUILD_SHARED_LIBS)
 
+#if MIOPEN_USE_HIP_GRAPHS
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_HIP_GRAPHS)
+#endif
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_CONCURRENT_STREAMS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_ROCBLAS_WORKSPACE_SIZE)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_PROFILE_BATCH)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_STREAM_ORDERED_ALLOCATOR)
+
+// hipMallocAsync and the device memory pools appeared in HIP 5.2.
+#if defined(HIP_VERSION) && HIP_VERSION >= 50200000
+#define MIOPEN_USE_STREAM_ORDERED_ALLOC 1
+#else
+#define MIOPEN_USE_STREAM_ORDERED_ALLOC 0
+#endif
+
 namespace miopen {
 
+// The handle whose launches the thread measures together, see Handle::ProfileBatch().
+static thread_local const HandleImpl* profile_batch = nullptr;
+
 #if MIOPEN_WORKAROUND_ROCM_COMPILER_SUPPORT_ISSUE_30
 namespace {
 void toCallHipInit() __attribute__((constructor(1000)));
@@ -105,6 +141,33 @@ void* default_allocator(void*, size_t sz)
 
 void default_deallocator(void*, void* mem) { hipFree(mem); }
 
+#if MIOPEN_USE_STREAM_ORDERED_ALLOC
+// The context is the stream of the handle. Allocations and releases are ordered with the work
+// on that stream instead of synchronizing the device, and released blocks return to the
+// default memory pool of the device, which serves the next allocations.
+void* stream_ordered_allocator(void* stream, size_t sz)
+{
+    void* result;
+    auto status = hipMallocAsync(&result, sz, static_cast<hipStream_t>(stream));
+    if(status != hipSuccess)
+        MIOPEN_THROW_HIP_STATUS(status, "Hip error creating buffer " + std::to_string(sz) + ": ");
+    return result;
+}
+
+void stream_ordered_deallocator(void* stream, void* mem)
+{
+    hipFreeAsync(mem, static_cast<hipStream_t>(stream));
+}
+
+bool IsStreamOrderedAllocSupported(int device)
+{
+    int supported = 0;
+    return hipDeviceGetAttribute(&supported, hipDeviceAttributeMemoryPoolsSupported, device) ==
+               hipSuccess &&
+           supported != 0;
+}
+#endif
+
 int get_device_id() // Get random device
 {
     int device;
@@ -141,6 +204,83 @@ int set_default_device()
     return (pid % n);
 }
 
+#if MIOPEN_USE_HIP_GRAPHS
+using hipGraphPtr     = MIOPEN_MANAGE_PTR(hipGraph_t, hipGraphDestroy);
+using hipGraphExecPtr = MIOPEN_MANAGE_PTR(hipGraphExec_t, hipGraphExecDestroy);
+
+/// Invoker launches captured into HIP graphs, keyed by the problem, solver and buffers.
+struct GraphCache
+{
+    // Every distinct set of buffer addresses produces a graph, so keep it bounded.
+    static constexpr std::size_t max_size = 1024;
+
+    std::mutex mutex;
+    std::unordered_map<std::string, hipGraphExecPtr> graphs;
+    std::unordered_set<std::string> not_capturable;
+    // Keys run once without capture. Code objects are loaded on the first launch,
+    // which must not happen while the stream is being captured.
+    std::unordered_set<std::string> warmed_up;
+};
+#endif
+
+#if MIOPEN_USE_ROCBLAS
+static std::size_t GetRocblasWorkspaceSize()
+{
+    const auto value = Value(MIOPEN_ROCBLAS_WORKSPACE_SIZE{});
+    return value == 0 ? 32 * 1024 * 1024 : value;
+}
+
+/// rocBLAS work enqueued on one stream runs in order, so all the rocBLAS handles of the process
+/// which use the same stream share one buffer of device memory, allocated once per stream
+/// instead of once per handle.
+static std::shared_ptr<void> AcquireRocblasMemory(hipStream_t stream)
+{
+    using Key = std::pair<int, hipStream_t>;
+    static std::mutex mutex;
+    static std::map<Key, std::weak_ptr<void>> pool;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for(auto it = pool.begin(); it != pool.end();)
+        it = it->second.expired() ? pool.erase(it) : std::next(it);
+
+    auto& entry = pool[Key{get_device_id(), stream}];
+    auto result = entry.lock();
+    if(result == nullptr)
+    {
+        void* memory      = nullptr;
+        const auto status = hipMalloc(&memory, GetRocblasWorkspaceSize());
+        if(status != hipSuccess)
+            MIOPEN_THROW_HIP_STATUS(status, "Hip error allocating the rocBLAS workspace: ");
+        result = std::shared_ptr<void>{memory, [](void* x) { hipFree(x); }};
+        entry  = result;
+    }
+    return result;
+}
+
+/// A rocBLAS handle along with the device memory it was last given, see Handle::rhandle().
+/// rocBLAS handles keep host state which shall not be used by several threads at the same time,
+/// so each MIOpen handle creates its own for every stream it uses, and only the memory is shared.
+struct RocblasHandle
+{
+    explicit RocblasHandle(hipStream_t s) : stream(s)
+    {
+        rocblas_handle x  = nullptr;
+        const auto status = rocblas_create_handle(&x);
+        if(status != rocblas_status_success)
+            MIOPEN_THROW(miopenStatusInternalError, "rocblas_create_handle failed");
+        handle = rocblas_handle_ptr{x};
+        rocblas_set_stream(x, stream);
+    }
+
+    hipStream_t stream;
+    // Acquired when there is no arena to serve the memory, released after the handle.
+    std::shared_ptr<void> shared_memory;
+    rocblas_handle_ptr handle;
+    void* workspace            = nullptr;
+    std::size_t workspace_size = 0;
+};
+#endif
+
 struct HandleImpl
 {
     // typedef MIOPEN_MANAGE_PTR(hipStream_t, hipStreamDestroy) StreamPtr;
@@ -157,18 +297,33 @@ struct HandleImpl
         return StreamPtr{result, &hipStreamDestroy};
     }
 
+    StreamPtr create_stream(int priority)
+    {
+        hipStream_t result;
+        auto status = hipStreamCreateWithPriority(&result, hipStreamDefault, priority);
+        if(status != hipSuccess)
+            MIOPEN_THROW_HIP_STATUS(status, "Failed to allocate stream");
+        return StreamPtr{result, &hipStreamDestroy};
+    }
+
     static StreamPtr reference_stream(hipStream_t s) { return StreamPtr{s, null_deleter{}}; }
 
-    void elapsed_time(hipEvent_t start, hipEvent_t stop)
+    void elapsed_time(hipEvent_t start, hipEvent_t stop, const std::string& kernel_name)
     {
+        if(!enable_profiling && !trace::IsEnabled())
+            return;
+        float elapsed = 0.0;
+        hipEventElapsedTime(&elapsed, start, stop);
         if(enable_profiling)
-            hipEventElapsedTime(&this->profiling_result, start, stop);
+            this->profiling_result = elapsed;
+        trace::AddKernel(kernel_name, elapsed);
     }
 
-    std::function<void(hipEvent_t, hipEvent_t)> elapsed_time_handler()
+    std::function<void(hipEvent_t, hipEvent_t)> elapsed_time_handler(std::string kernel_name)
     {
-        return std::bind(
-            &HandleImpl::elapsed_time, this, std::placeholders::_1, std::placeholders::_2);
+        return [this, kernel_name](hipEvent_t start, hipEvent_t stop) {
+            elapsed_time(start, stop, kernel_name);
+        };
     }
 
     void set_ctx() const
@@ -180,13 +335,28 @@ struct HandleImpl
             MIOPEN_THROW("Running handle on wrong device");
     }
 
-    bool enable_profiling  = false;
-    StreamPtr stream       = nullptr;
-    float profiling_result = 0.0;
-    int device             = -1;
+    std::atomic<bool> enable_profiling{false};
+    StreamPtr stream = nullptr;
+    std::atomic<float> profiling_result{0.0f};
+    int device = -1;
     Allocator allocator{};
+    /// The default allocator is stream_ordered_allocator, see MIOPEN_STREAM_ORDERED_ALLOCATOR.
+    bool stream_ordered_alloc = false;
     KernelCache cache;
     hipCtx_t ctx;
+#if MIOPEN_USE_HIP_GRAPHS
+    GraphCache graph_cache;
+#endif
+    /// Created on demand by Handle::RunConcurrently, per stream priority.
+    std::map<int, std::vector<StreamPtr>> aux_streams;
+    boost::optional<int> aux_streams_priority;
+    std::mutex aux_streams_mutex;
+#if MIOPEN_USE_ROCBLAS
+    std::unique_ptr<RocblasHandle> rhandle;
+    /// Created on demand for the thread streams, see Handle::rhandle().
+    std::unordered_map<hipStream_t, std::unique_ptr<RocblasHandle>> stream_rhandles;
+    std::mutex stream_rhandles_mutex;
+#endif
 };
 
 Handle::Handle(miopenAcceleratorQueue_t stream) : impl(new HandleImpl())
@@ -202,9 +372,10 @@ Handle::Handle(miopenAcceleratorQueue_t stream) : impl(new HandleImpl())
     this->SetAllocator(nullptr, nullptr, nullptr);
 
 #if MIOPEN_USE_ROCBLAS
-    rhandle_ = CreateRocblasHandle();
+    this->impl->rhandle = std::make_unique<RocblasHandle>(this->impl->stream.get());
 #endif
     MIOPEN_LOG_NQI(*this);
+    db_prefetch = PrefetchSystemDbs(*this);
 }
 
 Handle::Handle() : impl(new HandleImpl())
@@ -221,23 +392,42 @@ Handle::Handle() : impl(new HandleImpl())
     this->SetAllocator(nullptr, nullptr, nullptr);
 
 #if MIOPEN_USE_ROCBLAS
-    rhandle_ = CreateRocblasHandle();
+    this->impl->rhandle = std::make_unique<RocblasHandle>(this->impl->stream.get());
 #endif
     MIOPEN_LOG_NQI(*this);
+    db_prefetch = PrefetchSystemDbs(*this);
 }
 
-Handle::~Handle() {}
+Handle::~Handle()
+{
+    // The last scans would not be reported otherwise. A destructor must not throw.
+    try
+    {
+        checkNumericsFlush(*this);
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_E(ex.what());
+    }
+#if MIOPEN_ENABLE_SQLITE
+    SQLite::FlushAll();
+#endif
+}
 
 void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
 {
     this->impl->stream = HandleImpl::reference_stream(streamID);
 
 #if MIOPEN_USE_ROCBLAS
-    rocblas_set_stream(this->rhandle_.get(), this->GetStream());
+    this->impl->rhandle = std::make_unique<RocblasHandle>(this->impl->stream.get());
 #endif
 }
 
-miopenAcceleratorQueue_t Handle::GetStream() const { return impl->stream.get(); }
+miopenAcceleratorQueue_t Handle::GetStream() const
+{
+    const auto thread_stream = thread_streams::Find(id);
+    return thread_stream != nullptr ? *thread_stream : impl->stream.get();
+}
 
 void Handle::SetAllocator(miopenAllocatorFunction allocator,
                           miopenDeallocatorFunction deallocator,
@@ -246,18 +436,58 @@ void Handle::SetAllocator(miopenAllocatorFunction allocator,
     this->impl->allocator.allocator   = allocator == nullptr ? default_allocator : allocator;
     this->impl->allocator.deallocator = deallocator == nullptr ? default_deallocator : deallocator;
 
-    this->impl->allocator.context = allocatorContext;
+    this->impl->allocator.allocator_ex = nullptr;
+    this->impl->allocator.context      = allocatorContext;
+    this->impl->stream_ordered_alloc   = false;
+
+#if MIOPEN_USE_STREAM_ORDERED_ALLOC
+    if(allocator == nullptr && deallocator == nullptr &&
+       IsEnabled(MIOPEN_STREAM_ORDERED_ALLOCATOR{}) &&
+       IsStreamOrderedAllocSupported(this->impl->device))
+    {
+        this->impl->allocator.allocator   = stream_ordered_allocator;
+        this->impl->allocator.deallocator = stream_ordered_deallocator;
+        this->impl->allocator.context     = this->impl->stream.get();
+        this->impl->stream_ordered_alloc  = true;
+    }
+#endif
+}
+
+void Handle::SetAllocatorEx(miopenAllocatorFunctionEx allocator,
+                            miopenDeallocatorFunction deallocator,
+                            void* allocatorContext) const
+{
+    if(allocator == nullptr)
+    {
+        this->SetAllocator(nullptr, deallocator, allocatorContext);
+        return;
+    }
+    this->impl->allocator.allocator   = nullptr;
+    this->impl->allocator.deallocator = deallocator == nullptr ? default_deallocator : deallocator;
+
+    this->impl->allocator.allocator_ex = allocator;
+    this->impl->allocator.context      = allocatorContext;
+    this->impl->stream_ordered_alloc   = false;
 }
 
 void Handle::EnableProfiling(bool enable) const { this->impl->enable_profiling = enable; }
 
 float Handle::GetKernelTime() const { return this->impl->profiling_result; }
 
-Allocator::ManageDataPtr Handle::Create(std::size_t sz) const
+Allocator::ManageDataPtr Handle::Create(std::size_t sz, miopenAllocationHint_t hint) const
 {
     MIOPEN_HANDLE_LOCK
+    if(this->impl->stream_ordered_alloc)
+    {
+        // A thread with a stream of its own would use the buffer out of the order of the
+        // handle stream that owns the pool allocation.
+        if(this->GetStream() == this->impl->stream.get())
+            return this->impl->allocator(sz);
+        this->Finish();
+        return Allocator{default_allocator, default_deallocator, nullptr}(sz);
+    }
     this->Finish();
-    return this->impl->allocator(sz);
+    return this->impl->allocator(sz, hint, this->GetStream());
 }
 
 Allocator::ManageDataPtr&
@@ -272,14 +502,58 @@ Handle::WriteTo(const void* data, Allocator::ManageDataPtr& ddata, std::size_t s
 }
 
 void Handle::ReadTo(void* data, const Allocator::ManageDataPtr& ddata, std::size_t sz) const
+{
+    this->ReadTo(data, ddata.get(), sz);
+}
+
+void Handle::ReadTo(void* data, ConstData_t ddata, std::size_t sz) const
 {
     MIOPEN_HANDLE_LOCK
     this->Finish();
-    auto status = hipMemcpy(data, ddata.get(), sz, hipMemcpyDeviceToHost);
+    auto status = hipMemcpy(data, ddata, sz, hipMemcpyDeviceToHost);
+    if(status != hipSuccess)
+        MIOPEN_THROW_HIP_STATUS(status, "Hip error reading from buffer: ");
+}
+
+void Handle::WriteToAsync(const void* data, Data_t ddata, std::size_t sz) const
+{
+    MIOPEN_HANDLE_LOCK
+    this->impl->set_ctx();
+    auto status = hipMemcpyAsync(ddata, data, sz, hipMemcpyHostToDevice, this->GetStream());
+    if(status != hipSuccess)
+        MIOPEN_THROW_HIP_STATUS(status, "Hip error writing to buffer: ");
+}
+
+void Handle::ReadToAsync(void* data, ConstData_t ddata, std::size_t sz) const
+{
+    MIOPEN_HANDLE_LOCK
+    this->impl->set_ctx();
+    auto status = hipMemcpyAsync(data, ddata, sz, hipMemcpyDeviceToHost, this->GetStream());
     if(status != hipSuccess)
         MIOPEN_THROW_HIP_STATUS(status, "Hip error reading from buffer: ");
 }
 
+StreamEvent Handle::RecordEvent() const
+{
+    this->impl->set_ctx();
+    auto event  = std::make_shared<HipEventPtr>(make_hip_event(hipEventDisableTiming));
+    auto status = hipEventRecord(event->get(), this->GetStream());
+    if(status != hipSuccess)
+        MIOPEN_THROW_HIP_STATUS(status, "Failed to record an event");
+    return {event};
+}
+
+void Handle::WaitFor(const StreamEvent& event) const
+{
+    if(!event.impl)
+        return;
+    this->impl->set_ctx();
+    const auto& hip_event = *static_cast<const HipEventPtr*>(event.impl.get());
+    auto status           = hipStreamWaitEvent(this->GetStream(), hip_event.get(), 0);
+    if(status != hipSuccess)
+        MIOPEN_THROW_HIP_STATUS(status, "Failed to wait for an event");
+}
+
 void Handle::Copy(ConstData_t src, Data_t dest, std::size_t size) const
 {
     MIOPEN_HANDLE_LOCK
@@ -318,6 +592,7 @@ KernelInvoke Handle::AddKernel(const std::string& algorithm,
 Invoker Handle::PrepareInvoker(const InvokerFactory& factory,
                                const std::vector<solver::KernelInfo>& kernels) const
 {
+    MIOPEN_TRACE_SCOPE("invoker", "PrepareInvoker");
     std::vector<Kernel> built;
     for(auto& k : kernels)
     {
@@ -341,8 +616,8 @@ void Handle::ClearKernels(const std::string& algorithm, const std::string& netwo
     this->impl->cache.ClearKernels(algorithm, network_config);
 }
 
-const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
-                                                  const std::string& network_config) const
+std::vector<Kernel> Handle::GetKernelsImpl(const std::string& algorithm,
+                                           const std::string& network_config) const
 {
     return this->impl->cache.GetKernels(algorithm, network_config);
 }
@@ -355,8 +630,8 @@ bool Handle::HasKernel(const std::string& algorithm, const std::string& network_
 KernelInvoke Handle::Run(Kernel k) const
 {
     this->impl->set_ctx();
-    if(this->impl->enable_profiling || MIOPEN_GPU_SYNC)
-        return k.Invoke(this->GetStream(), this->impl->elapsed_time_handler());
+    if(this->IsProfilingEnabled() || MIOPEN_GPU_SYNC || trace::IsEnabled())
+        return k.Invoke(this->GetStream(), this->impl->elapsed_time_handler(k.GetName()));
     else
         return k.Invoke(this->GetStream());
 }
@@ -368,6 +643,23 @@ Program Handle::LoadProgram(const std::string& program_name,
 {
     this->impl->set_ctx();
     params += " -mcpu=" + this->GetDeviceName();
+
+    // Threads loading the same program at the same time share a single build.
+    const auto key = std::to_string(this->impl->device) + ":" + program_name + ":" + params + ":" +
+                     std::to_string(static_cast<int>(is_kernel_str)) + ":" +
+                     std::to_string(std::hash<std::string>{}(kernel_src));
+    return CompileService::Get().Build(key, [&]() -> Program {
+        this->impl->set_ctx();
+        return this->LoadProgramImpl(program_name, params, is_kernel_str, kernel_src);
+    });
+}
+
+Program Handle::LoadProgramImpl(const std::string& program_name,
+                                const std::string& params,
+                                bool is_kernel_str,
+                                const std::string& kernel_src) const
+{
+    const cache_stats::Lookup lookup{miopenCacheBinary};
     auto hsaco = miopen::LoadBinary(
         this->GetDeviceName(), this->GetMaxComputeUnits(), program_name, params, is_kernel_str);
     if(hsaco.empty())
@@ -379,6 +671,7 @@ Program Handle::LoadProgram(const std::string& program_name,
 
 // Save to cache
 #if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+        const auto compile_time_ms = ct.ElapsedMs();
         miopen::SaveBinary(p.IsCodeObjectInMemory()
                                ? p.GetCodeObjectBlob()
                                : miopen::LoadFile(p.GetCodeObjectPathname().string()),
@@ -386,7 +679,8 @@ Program Handle::LoadProgram(const std::string& program_name,
                            this->GetMaxComputeUnits(),
                            program_name,
                            params,
-                           is_kernel_str);
+                           is_kernel_str,
+                           compile_time_ms);
 #else
         auto path      = miopen::GetCachePath(false) / boost::filesystem::unique_path();
         if(p.IsCodeObjectInMemory())
@@ -396,14 +690,39 @@ Program Handle::LoadProgram(const std::string& program_name,
         miopen::SaveBinary(path, this->GetDeviceName(), program_name, params, is_kernel_str);
 #endif
 
+        lookup.Miss();
         return p;
     }
     else
     {
+        lookup.Hit();
         return HIPOCProgram{program_name, hsaco};
     }
 }
 
+std::string Handle::LoadCodeObject(const std::string& program_name,
+                                   std::string params,
+                                   bool is_kernel_str) const
+{
+    params += " -mcpu=" + this->GetDeviceName();
+    return miopen::LoadBinaryBlob(
+        this->GetDeviceName(), this->GetMaxComputeUnits(), program_name, params, is_kernel_str);
+}
+
+void Handle::SaveCodeObject(const std::string& program_name,
+                            std::string params,
+                            bool is_kernel_str,
+                            const std::string& code_object) const
+{
+    params += " -mcpu=" + this->GetDeviceName();
+    miopen::SaveBinaryBlob(code_object,
+                           this->GetDeviceName(),
+                           this->GetMaxComputeUnits(),
+                           program_name,
+                           params,
+                           is_kernel_str);
+}
+
 bool Handle::HasProgram(const std::string& program_name, const std::string& params) const
 {
     return this->impl->cache.HasProgram(program_name, params);
@@ -416,6 +735,263 @@ void Handle::AddProgram(Program prog,
     this->impl->cache.AddProgram(prog, program_name, params);
 }
 
+void Handle::SetProgramCacheLimits(std::size_t max_programs, std::size_t max_bytes) const
+{
+    this->impl->cache.SetLimits(max_programs, max_bytes);
+}
+
+#if MIOPEN_USE_HIP_GRAPHS
+/// Returns nullptr if the launches cannot be captured. The invoker has not run in this case.
+static hipGraphExecPtr CaptureInvoker(const Handle& handle,
+                                      const Invoker& invoker,
+                                      const AnyInvokeParams& params)
+{
+    const auto stream = handle.GetStream();
+    auto status       = hipStreamBeginCapture(stream, hipStreamCaptureModeThreadLocal);
+    if(status != hipSuccess)
+        return nullptr;
+
+    auto failed = false;
+    try
+    {
+        invoker(handle, params);
+    }
+    catch(const Exception& ex)
+    {
+        MIOPEN_LOG_I2("Invoker failed during capture: " << ex.what());
+        failed = true;
+    }
+
+    hipGraph_t raw_graph = nullptr;
+    status               = hipStreamEndCapture(stream, &raw_graph);
+    const auto graph     = hipGraphPtr{raw_graph};
+    if(failed || status != hipSuccess || graph == nullptr)
+        return nullptr;
+
+    hipGraphExec_t raw_exec = nullptr;
+    status = hipGraphInstantiate(&raw_exec, graph.get(), nullptr, nullptr, 0);
+    if(status != hipSuccess)
+        return nullptr;
+    return hipGraphExecPtr{raw_exec};
+}
+#endif
+
+void Handle::RunInvoker(const Invoker& invoker,
+                        const AnyInvokeParams& params,
+                        const std::string& graph_key) const
+{
+#if MIOPEN_USE_HIP_GRAPHS
+    // The legacy default stream cannot be captured, profiling and tracing need individual
+    // launches.
+    if(!graph_key.empty() && !IsDisabled(MIOPEN_DEBUG_HIP_GRAPHS{}) &&
+       !this->impl->enable_profiling && !trace::IsEnabled() && this->GetStream() != nullptr)
+    {
+        auto& cache = this->impl->graph_cache;
+        std::unique_lock<std::mutex> lock(cache.mutex);
+        auto it = cache.graphs.find(graph_key);
+        if(it == cache.graphs.end() && cache.not_capturable.count(graph_key) == 0 &&
+           cache.graphs.size() < GraphCache::max_size)
+        {
+            if(cache.warmed_up.size() >= GraphCache::max_size)
+                cache.warmed_up.clear();
+            if(cache.warmed_up.insert(graph_key).second)
+            {
+                lock.unlock();
+                invoker(*this, params);
+                return;
+            }
+            cache.warmed_up.erase(graph_key);
+            // The capture is thread-local, don't hold up the other threads meanwhile.
+            lock.unlock();
+            auto exec = CaptureInvoker(*this, invoker, params);
+            lock.lock();
+            if(exec)
+            {
+                MIOPEN_LOG_I2("Captured graph: " << graph_key);
+                it = cache.graphs.emplace(graph_key, std::move(exec)).first;
+            }
+            else
+            {
+                MIOPEN_LOG_I2("Not capturable: " << graph_key);
+                cache.not_capturable.insert(graph_key);
+            }
+        }
+        if(it != cache.graphs.end())
+        {
+            // The graphs are never erased, so the exec outlives the lock.
+            const auto exec = it->second.get();
+            lock.unlock();
+            const auto status = hipGraphLaunch(exec, this->GetStream());
+            if(status != hipSuccess)
+                MIOPEN_THROW_HIP_STATUS(status, "Failed to launch graph");
+            return;
+        }
+    }
+#else
+    std::ignore = graph_key;
+#endif
+    invoker(*this, params);
+}
+
+static std::size_t GetConcurrentStreamsLimit()
+{
+    const auto value = Value(MIOPEN_CONCURRENT_STREAMS{});
+    return value == 0 ? 4 : value;
+}
+
+static bool IsCapturing(hipStream_t stream)
+{
+#if MIOPEN_USE_HIP_GRAPHS
+    auto status = hipStreamCaptureStatusNone;
+    if(stream != nullptr && hipStreamIsCapturing(stream, &status) == hipSuccess)
+        return status != hipStreamCaptureStatusNone;
+#else
+    std::ignore = stream;
+#endif
+    return false;
+}
+
+void Handle::RunConcurrently(std::size_t count,
+                             const std::function<void(std::size_t)>& task) const
+{
+    const auto n_streams = std::min(count, GetConcurrentStreamsLimit());
+
+    // Kernel timing is measured with events on the handle stream.
+    if(n_streams < 2 || this->impl->enable_profiling || trace::IsEnabled() ||
+       IsCapturing(this->GetStream()))
+    {
+        for(std::size_t i = 0; i < count; ++i)
+            task(i);
+        return;
+    }
+
+    this->impl->set_ctx();
+    // The tasks see the auxiliary streams through the stream override of this thread, so the
+    // other threads sharing the handle are not affected.
+    const auto main_stream  = this->GetStream();
+    const auto had_override = this->HasThreadStream();
+
+    std::vector<HandleImpl::StreamPtr> aux;
+    {
+        std::lock_guard<std::mutex> lock(this->impl->aux_streams_mutex);
+        // Forked work keeps the priority of the stream it is forked from.
+        auto priority = 0;
+        if(this->impl->aux_streams_priority)
+            priority = *this->impl->aux_streams_priority;
+        else if(hipStreamGetPriority(main_stream, &priority) != hipSuccess)
+            priority = 0;
+        auto& streams = this->impl->aux_streams[priority];
+        while(streams.size() < n_streams)
+            streams.push_back(this->impl->create_stream(priority));
+        aux = streams;
+    }
+
+    const auto fork = make_hip_event(hipEventDisableTiming);
+    hipEventRecord(fork.get(), main_stream);
+    for(std::size_t s = 0; s < n_streams; ++s)
+        hipStreamWaitEvent(aux[s].get(), fork.get(), 0);
+
+    // Restores the stream of the thread and joins the auxiliary streams even if a task throws.
+    const auto join = [&]() {
+        if(had_override)
+            this->SetThreadStream(main_stream);
+        else
+            this->ResetThreadStream();
+        for(std::size_t s = 0; s < n_streams; ++s)
+        {
+            const auto done = make_hip_event(hipEventDisableTiming);
+            hipEventRecord(done.get(), aux[s].get());
+            hipStreamWaitEvent(main_stream, done.get(), 0);
+        }
+    };
+
+    try
+    {
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            this->SetThreadStream(aux[i % n_streams].get());
+            task(i);
+        }
+    }
+    catch(...)
+    {
+        join();
+        throw;
+    }
+    join();
+}
+
+void Handle::SetConcurrentStreamsPriority(int priority) const
+{
+    this->impl->set_ctx();
+    auto least    = 0;
+    auto greatest = 0;
+    if(hipDeviceGetStreamPriorityRange(&least, &greatest) == hipSuccess)
+        priority = std::min(std::max(priority, greatest), least);
+    std::lock_guard<std::mutex> lock(this->impl->aux_streams_mutex);
+    this->impl->aux_streams_priority = priority;
+}
+
+Handle Handle::CreateBackgroundHandle() const
+{
+    set_device(this->impl->device);
+    // Non-blocking, so that the work of the background handle does not serialize with the
+    // default stream.
+    hipStream_t result;
+    auto status = hipStreamCreateWithFlags(&result, hipStreamNonBlocking);
+    if(status != hipSuccess)
+        MIOPEN_THROW_HIP_STATUS(status, "Failed to allocate stream");
+    auto stream = HandleImpl::StreamPtr{result, &hipStreamDestroy};
+
+    Handle background{stream.get()};
+    background.impl->stream = stream;
+    // The stream-ordered allocator set up by the constructor already works on the new stream.
+    if(!this->impl->stream_ordered_alloc)
+    {
+        background.impl->allocator            = this->impl->allocator;
+        background.impl->stream_ordered_alloc = false;
+    }
+    return background;
+}
+
+miopenCacheFootprint_t Handle::GetCacheFootprint() const
+{
+    miopenCacheFootprint_t result{};
+    result.programCount    = this->impl->cache.GetProgramCount();
+    result.kernelCount     = this->impl->cache.GetKernelCount();
+    result.codeObjectBytes = this->impl->cache.GetProgramBytes();
+    result.invokerCount    = invokers.Size();
+    result.arenaBytes      = arena.GetBytes();
+    return result;
+}
+
+std::size_t Handle::GetKernelCacheGeneration() const
+{
+    return this->impl->cache.GetGeneration();
+}
+
+miopenDeviceMemoryUsage_t Handle::GetDeviceMemoryUsage() const
+{
+    miopenDeviceMemoryUsage_t result{};
+    result.codeObjectBytes = this->impl->cache.GetProgramBytes();
+    result.workspaceBytes  = arena.GetBytes(WorkspaceArena::Slot::Workspace);
+    result.rocblasBytes    = arena.GetBytes(WorkspaceArena::Slot::RocBLAS);
+    result.scratchBytes    = arena.GetBytes() - result.workspaceBytes - result.rocblasBytes;
+    result.totalBytes      = result.codeObjectBytes + arena.GetBytes();
+    return result;
+}
+
+void Handle::UpdateMemoryBudget() const
+{
+    if(device_memory_limit == 0)
+    {
+        this->impl->cache.SetMemoryBudget(std::numeric_limits<std::size_t>::max());
+        return;
+    }
+    const auto held = arena.GetBytes();
+    this->impl->cache.SetMemoryBudget(device_memory_limit > held ? device_memory_limit - held : 0);
+}
+
 void Handle::Finish() const
 {
     this->impl->set_ctx();
@@ -434,19 +1010,71 @@ void Handle::Finish() const
     }
 #else
     // hipStreamSynchronize is broken, so we use hipEventSynchronize instead
-    auto ev = make_hip_event();
+    auto ev = make_hip_event(hipEventDisableTiming);
     hipEventRecord(ev.get(), this->GetStream());
     auto status = hipEventSynchronize(ev.get());
     if(status != hipSuccess)
         MIOPEN_THROW_HIP_STATUS(status, "Failed hip sychronization");
 #endif
+    checkNumericsFlush(*this);
 }
 void Handle::Flush() const {}
 
-bool Handle::IsProfilingEnabled() const { return this->impl->enable_profiling; }
+bool Handle::IsProfilingEnabled() const
+{
+    return this->impl->enable_profiling && profile_batch != this->impl.get();
+}
+
+void Handle::ProfileBatch(const std::function<void()>& launches) const
+{
+    if(!this->IsProfilingEnabled())
+    {
+        launches();
+        return;
+    }
+
+    this->impl->set_ctx();
+    const auto start = make_hip_event();
+    const auto stop  = make_hip_event();
+    hipEventRecord(start.get(), this->GetStream());
+    profile_batch = this->impl.get();
+    try
+    {
+        launches();
+    }
+    catch(...)
+    {
+        profile_batch = nullptr;
+        throw;
+    }
+    profile_batch = nullptr;
+    hipEventRecord(stop.get(), this->GetStream());
+    auto status = hipEventSynchronize(stop.get());
+    if(status != hipSuccess)
+        MIOPEN_THROW_HIP_STATUS(status, "Failed hip sychronization");
+    auto elapsed = 0.0f;
+    hipEventElapsedTime(&elapsed, start.get(), stop.get());
+    this->impl->profiling_result = elapsed;
+}
+
+void Handle::ProfileLaunches(const std::function<void()>& launches) const
+{
+    if(IsEnabled(MIOPEN_DEBUG_PROFILE_BATCH{}))
+        this->ProfileBatch(launches);
+    else
+        launches();
+}
 
 void Handle::ResetKernelTime() const { this->impl->profiling_result = 0.0; }
-void Handle::AccumKernelTime(float curr_time) const { this->impl->profiling_result += curr_time; }
+void Handle::AccumKernelTime(float curr_time) const
+{
+    auto& result = this->impl->profiling_result;
+    auto prev    = result.load();
+    while(!result.compare_exchange_weak(prev, prev + curr_time))
+    {
+        // prev has been reloaded, retry.
+    }
+}
 
 std::size_t Handle::GetLocalMemorySize() const
 {
@@ -523,6 +1151,16 @@ std::string Handle::GetDeviceName() const
     return GetDeviceNameFromMap(n);
 }
 
+std::string Handle::GetPciBusId() const
+{
+    char bus_id[64] = {};
+    if(hipDeviceGetPCIBusId(bus_id, sizeof(bus_id), this->impl->device) != hipSuccess)
+        return {};
+    std::string result = bus_id;
+    std::transform(result.begin(), result.end(), result.begin(), ::tolower);
+    return result;
+}
+
 std::ostream& Handle::Print(std::ostream& os) const
 {
     os << "stream: " << this->impl->stream << ", device_id: " << this->impl->device;
@@ -542,13 +1180,43 @@ shared<ConstData_t> Handle::CreateSubBuffer(ConstData_t data, std::size_t offset
 }
 
 #if MIOPEN_USE_ROCBLAS
-rocblas_handle_ptr Handle::CreateRocblasHandle() const
+const rocblas_handle_ptr& Handle::rhandle() const
 {
-    rocblas_handle x = nullptr;
-    rocblas_create_handle(&x);
-    auto result = rocblas_handle_ptr{x};
-    rocblas_set_stream(result.get(), GetStream());
-    return result;
+    auto* result             = impl->rhandle.get();
+    const auto thread_stream = thread_streams::Find(id);
+    if(thread_stream != nullptr && *thread_stream != impl->stream.get())
+    {
+        std::lock_guard<std::mutex> lock(impl->stream_rhandles_mutex);
+        auto& created = impl->stream_rhandles[*thread_stream];
+        if(created == nullptr)
+            created = std::make_unique<RocblasHandle>(*thread_stream);
+        result = created.get();
+    }
+
+    // The arena is disabled for the thread streams, so their handles use the shared memory.
+    const auto workspace_size = GetRocblasWorkspaceSize();
+    void* workspace           = nullptr;
+    if(IsWorkspaceArenaEnabled())
+    {
+        workspace = GetArenaBuffer(WorkspaceArena::Slot::RocBLAS, workspace_size).get();
+    }
+    else
+    {
+        if(result->shared_memory == nullptr)
+            result->shared_memory = AcquireRocblasMemory(result->stream);
+        workspace = result->shared_memory.get();
+    }
+
+    // The arena may have been enabled, disabled or grown since the last call.
+    if(workspace != result->workspace || workspace_size != result->workspace_size)
+    {
+        const auto status = rocblas_set_workspace(result->handle.get(), workspace, workspace_size);
+        if(status != rocblas_status_success)
+            MIOPEN_THROW(miopenStatusInternalError, "rocblas_set_workspace failed");
+        result->workspace      = workspace;
+        result->workspace_size = workspace_size;
+    }
+    return result->handle;
 }
 #endif
 } // namespace miopen
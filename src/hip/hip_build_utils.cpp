@@ -25,11 +25,14 @@
 *******************************************************************************/
 
 #include <miopen/config.h>
+#include <miopen/binary_cache.hpp>
 #include <miopen/hip_build_utils.hpp>
 #include <miopen/stringutils.hpp>
 #include <miopen/exec_utils.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/env.hpp>
+#include <miopen/md5.hpp>
+#include <boost/filesystem/operations.hpp>
 #include <boost/optional.hpp>
 #include <sstream>
 #include <string>
@@ -37,6 +40,7 @@
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_HIP_ENFORCE_COV3)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_HIP_VERBOSE)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_HIP_DUMP)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_HIP_PCH)
 
 namespace miopen {
 
@@ -81,6 +85,87 @@ inline const std::string& GetCoV3Option(const bool enable)
     else
         return no_option;
 }
+
+/// Leading #include directives of the source. These make up its precompiled header.
+std::string GetIncludePrologue(const std::string& src)
+{
+    std::istringstream ss(src);
+    std::string line;
+    std::string prologue;
+    while(std::getline(ss, line))
+    {
+        const auto first = line.find_first_not_of(" \t\r");
+        if(first == std::string::npos || line.compare(first, 2, "//") == 0)
+            continue;
+        if(line.compare(first, 8, "#include") != 0)
+            break;
+        prologue += line + '\n';
+    }
+    return prologue;
+}
+
+/// The problem and tuning parameters of composable_kernel sources are not used
+/// by the headers, so the options are keyed without them.
+std::string RemoveKernelParams(const std::string& params)
+{
+    std::istringstream ss(params);
+    std::string option;
+    std::string result;
+    while(ss >> option)
+    {
+        if(!StartsWith(option, "-DCK_PARAM_"))
+            result += option + ' ';
+    }
+    return result;
+}
+
+/// composable_kernel sources include large template headers which are re-parsed
+/// for every network config. The headers a source includes first are precompiled
+/// once and kept in the user cache, keyed by compiler and options.
+/// \return Pathname of the PCH, or empty path if it is not available.
+boost::filesystem::path GetPrecompiledHeader(const TmpDir& tmp_dir,
+                                             const std::string& src,
+                                             const std::string& params)
+{
+    if(IsDisabled(MIOPEN_DEBUG_HIP_PCH{}))
+        return {};
+    const auto cache_path = GetCachePath(false);
+    if(cache_path.empty())
+        return {};
+    const auto prologue = GetIncludePrologue(src);
+    if(prologue.empty())
+        return {};
+
+    const auto pch_params = RemoveKernelParams(params);
+    const auto version    = HipCompilerVersion();
+    const auto compiler   = std::string(MIOPEN_HIP_COMPILER) + ' ' + std::to_string(version.major) +
+                          '.' + std::to_string(version.minor) + '.' +
+                          std::to_string(version.patch);
+    const auto key = md5(compiler + ' ' + pch_params + prologue);
+    const auto pch = cache_path / "hip_pch" / (key + ".pch");
+    if(boost::filesystem::exists(pch))
+        return pch;
+
+    try
+    {
+        WriteFile(prologue, tmp_dir.path / "miopen_pch.hpp");
+        tmp_dir.Execute(MIOPEN_HIP_COMPILER,
+                        pch_params + "-x hip -Xclang -emit-pch miopen_pch.hpp -o miopen_pch.pch");
+        // Publish atomically, other processes may be building the same PCH.
+        boost::filesystem::create_directories(pch.parent_path());
+        const auto tmp_pch =
+            pch.parent_path() / boost::filesystem::unique_path(key + "-%%%%-%%%%-%%%%.tmp");
+        boost::filesystem::copy_file(tmp_dir.path / "miopen_pch.pch", tmp_pch);
+        boost::filesystem::rename(tmp_pch, pch);
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_W("Unable to precompile headers: " << ex.what());
+        return {};
+    }
+    MIOPEN_LOG_I2("Precompiled headers: " << pch.string());
+    return pch;
+}
 } // namespace
 
 boost::filesystem::path HipBuild(boost::optional<TmpDir>& tmp_dir,
@@ -158,8 +243,33 @@ boost::filesystem::path HipBuild(boost::optional<TmpDir>& tmp_dir,
     auto bin_file = tmp_dir->path / (filename + ".o");
 
     // compile
-    tmp_dir->Execute(env + std::string(" ") + MIOPEN_HIP_COMPILER,
-                     params + filename + " -o " + bin_file.string());
+    const auto compile = [&](const std::string& options) {
+        tmp_dir->Execute(env + std::string(" ") + MIOPEN_HIP_COMPILER,
+                         params + options + filename + " -o " + bin_file.string());
+    };
+    const auto pch = IsHipClangCompiler() ? GetPrecompiledHeader(*tmp_dir, src, params)
+                                          : boost::filesystem::path{};
+    if(pch.empty())
+    {
+        compile("");
+    }
+    else
+    {
+        try
+        {
+            // The headers the PCH was built from are gone with its temporary
+            // directory, hence no validation.
+            compile("-include-pch " + pch.string() + " -Xclang -fno-validate-pch ");
+        }
+        catch(const Exception&)
+        {
+            MIOPEN_LOG_W("Build with precompiled headers failed, retrying without: "
+                         << pch.string());
+            boost::system::error_code ec;
+            boost::filesystem::remove(pch, ec);
+            compile("");
+        }
+    }
     if(!boost::filesystem::exists(bin_file))
         MIOPEN_THROW(filename + " failed to compile");
 #ifdef EXTRACTKERNEL_BIN
@@ -36,6 +36,7 @@
 #include <miopen/write_file.hpp>
 #include <miopen/env.hpp>
 #include <miopen/comgr.hpp>
+#include <boost/filesystem/operations.hpp>
 #include <boost/optional.hpp>
 
 #include <cstring>
@@ -118,11 +119,10 @@ struct HIPOCProgramImpl
     HIPOCProgramImpl(const std::string& program_name, const boost::filesystem::path& filespec)
         : program(program_name), hsaco_file(filespec)
     {
-        module = CreateModule(hsaco_file);
     }
 
     HIPOCProgramImpl(const std::string& program_name, const std::string& blob)
-        : program(program_name), module(CreateModuleInMem(blob))
+        : program(program_name), pending_blob(blob), blob_size(blob.size())
     {
     }
 
@@ -134,18 +134,41 @@ struct HIPOCProgramImpl
         : program(program_name), device(dev_name)
     {
         BuildCodeObject(params, is_kernel_str, kernel_src);
-        if(!binary.empty())
-            module = CreateModuleInMem(binary);
-        else
-            module = CreateModule(hsaco_file);
+    }
+
+    /// The code object is loaded to the device on the first call only, so programs
+    /// which are built or fetched from the binary cache but never launched
+    /// do not occupy device memory and do not pay for the module load.
+    hipModule_t GetModule() const
+    {
+        std::call_once(module_loaded, [this]() {
+            if(!binary.empty())
+            {
+                module = CreateModuleInMem(binary);
+            }
+            else if(!pending_blob.empty())
+            {
+                module = CreateModuleInMem(pending_blob);
+                std::string{}.swap(pending_blob);
+            }
+            else
+            {
+                module = CreateModule(hsaco_file);
+            }
+        });
+        return module.get();
     }
 
     std::string program;
     std::string device;
     boost::filesystem::path hsaco_file;
-    hipModulePtr module;
+    mutable std::once_flag module_loaded;
+    mutable hipModulePtr module;
+    /// CO blob fetched from the binary cache, released once the module is loaded.
+    mutable std::string pending_blob;
     boost::optional<TmpDir> dir;
     std::vector<char> binary;
+    std::size_t blob_size = 0;
 
 #if !MIOPEN_USE_COMGR
     void
@@ -258,7 +281,7 @@ HIPOCProgram::HIPOCProgram(const std::string& program_name, const std::string& h
 {
 }
 
-hipModule_t HIPOCProgram::GetModule() const { return impl->module.get(); }
+hipModule_t HIPOCProgram::GetModule() const { return impl->GetModule(); }
 
 boost::filesystem::path HIPOCProgram::GetCodeObjectPathname() const { return impl->hsaco_file; }
 
@@ -269,4 +292,15 @@ std::string HIPOCProgram::GetCodeObjectBlob() const
 
 bool HIPOCProgram::IsCodeObjectInMemory() const { return !impl->binary.empty(); };
 
+std::size_t HIPOCProgram::GetCodeObjectSize() const
+{
+    if(!impl->binary.empty())
+        return impl->binary.size();
+    if(impl->blob_size != 0)
+        return impl->blob_size;
+    boost::system::error_code ec;
+    const auto size = boost::filesystem::file_size(impl->hsaco_file, ec);
+    return ec ? 0 : static_cast<std::size_t>(size);
+}
+
 } // namespace miopen
@@ -47,6 +47,9 @@ struct ActivationDescriptor : miopenActivationDescriptor
     double GetBeta() const;
     double GetGamma() const;
 
+    /// True when dx can be computed from y and dy alone, i.e. Backward() accepts x == nullptr.
+    bool IsBackwardFromOutputSupported() const;
+
     miopenStatus_t Forward(Handle& handle,
                            const void* alpha,
                            const TensorDescriptor& xDesc,
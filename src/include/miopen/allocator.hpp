@@ -2,6 +2,7 @@
 #define GUARD_MLOPEN_ALLOCATOR_HPP
 
 #include <cassert>
+#include <limits>
 
 #include <miopen/common.hpp>
 #include <miopen/errors.hpp>
@@ -30,15 +31,38 @@ struct Allocator
     miopenAllocatorFunction allocator;
     miopenDeallocatorFunction deallocator;
     void* context;
+    /// Set by miopenSetAllocatorEx(), used instead of allocator when not null.
+    miopenAllocatorFunctionEx allocator_ex = nullptr;
 
     using ManageDataPtr =
         std::unique_ptr<typename std::remove_pointer<Data_t>::type, AllocatorDeleter>;
 
+    /// The smallest power of two not less than n, the sizes requested from an extended
+    /// allocator. Buffers of similar sizes then land in the same bucket of a caching allocator.
+    static std::size_t GetBucketSize(std::size_t n)
+    {
+        if(n > (std::numeric_limits<std::size_t>::max() >> 1) + 1)
+            return n;
+        std::size_t bucket = 1;
+        while(bucket < n)
+            bucket <<= 1;
+        return bucket;
+    }
+
     ManageDataPtr operator()(std::size_t n) const
     {
-        assert(allocator != nullptr);
+        return (*this)(n, miopenAllocationPersistent, nullptr);
+    }
+
+    ManageDataPtr
+    operator()(std::size_t n, miopenAllocationHint_t hint, miopenAcceleratorQueue_t stream) const
+    {
+        assert(allocator != nullptr || allocator_ex != nullptr);
         assert(deallocator != nullptr);
-        auto result = allocator(context, n);
+        if(allocator_ex != nullptr && n != 0)
+            n = GetBucketSize(n);
+        auto result = allocator_ex != nullptr ? allocator_ex(context, n, hint, stream)
+                                              : allocator(context, n);
         if(result == nullptr && n != 0)
         {
             MIOPEN_THROW("Custom allocator failed to allocate memory for buffer size " +
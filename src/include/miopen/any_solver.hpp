@@ -50,6 +50,16 @@ struct AnySolver
         assert(ptr_value != nullptr);
         return ptr_value->IsApplicable(ctx);
     };
+    bool IsDynamic() const
+    {
+        assert(ptr_value != nullptr);
+        return ptr_value->IsDynamic();
+    };
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        assert(ptr_value != nullptr);
+        return ptr_value->GetApplicabilityTraits();
+    };
     const std::type_info& Type() const
     {
         assert(ptr_value != nullptr);
@@ -82,6 +92,8 @@ struct AnySolver
 
         virtual ~AnySolver_base(){};
         virtual bool IsApplicable(const ConvolutionContext& ctx) const = 0;
+        virtual bool IsDynamic() const                                 = 0;
+        virtual applicability::Traits GetApplicabilityTraits() const   = 0;
         virtual const std::type_info& Type() const                     = 0;
         virtual std::string GetSolverDbId() const                      = 0;
         virtual ConvSolution FindSolution(const ConvolutionContext& ctx,
@@ -97,6 +109,8 @@ struct AnySolver
         AnySolver_tmpl(T obj) : value(std::move(obj)){};
         bool IsApplicable(const ConvolutionContext& ctx) const override
         {
+            if(!ctx.IsLayoutDefault() && !value.IsLayoutAgnostic())
+                return false;
             return value.IsApplicable(ctx);
         }
         ConvSolution FindSolution(const ConvolutionContext& ctx,
@@ -109,6 +123,11 @@ struct AnySolver
         {
             return value.GetWorkspaceSize(ctx);
         }
+        bool IsDynamic() const override { return value.IsDynamic(); }
+        applicability::Traits GetApplicabilityTraits() const override
+        {
+            return value.GetApplicabilityTraits();
+        }
         const std::type_info& Type() const override { return typeid(T); };
         std::string GetSolverDbId() const override { return ComputeSolverDbId(value); }
 
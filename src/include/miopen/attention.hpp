@@ -0,0 +1,75 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_ATTENTION_HPP_
+#define GUARD_MIOPEN_ATTENTION_HPP_
+
+#include <miopen/common.hpp>
+
+namespace miopen {
+
+struct Handle;
+struct TensorDescriptor;
+
+/// o = softmax(scale * q * k^T) * v over [..., seq, d] tensors, without storing the scores.
+/// lseDesc describes the fp32 log-sum-exp of every row of the scores, saved for the backward
+/// pass, and may be null.
+void AttentionForward(const Handle& handle,
+                      const TensorDescriptor& qDesc,
+                      ConstData_t q,
+                      const TensorDescriptor& kDesc,
+                      ConstData_t k,
+                      const TensorDescriptor& vDesc,
+                      ConstData_t v,
+                      float scale,
+                      bool causal,
+                      const TensorDescriptor& oDesc,
+                      Data_t o,
+                      const TensorDescriptor* lseDesc,
+                      Data_t lse);
+
+/// dq, dk and dv from do, recomputing the probabilities from the saved log-sum-exp. dq, dk and
+/// dv are described by qDesc, kDesc and vDesc, do by oDesc.
+void AttentionBackward(const Handle& handle,
+                       const TensorDescriptor& qDesc,
+                       ConstData_t q,
+                       const TensorDescriptor& kDesc,
+                       ConstData_t k,
+                       const TensorDescriptor& vDesc,
+                       ConstData_t v,
+                       const TensorDescriptor& oDesc,
+                       ConstData_t o,
+                       ConstData_t dO,
+                       const TensorDescriptor& lseDesc,
+                       ConstData_t lse,
+                       float scale,
+                       bool causal,
+                       Data_t dq,
+                       Data_t dk,
+                       Data_t dv);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_ATTENTION_HPP_
@@ -214,6 +214,18 @@ void BatchNormBackward(Handle& handle,
                        ConstData_t savedMean,
                        ConstData_t savedInvVariance);
 
+/// Overwrites y, the output of a batch norm training pass, with the input x it was computed from.
+/// Needs a scale without zeros; lets the backward pass follow a forward pass run in place.
+void BatchNormRestoreInput(Handle& handle,
+                           miopenBatchNormMode_t bn_mode,
+                           const TensorDescriptor& yDesc,
+                           Data_t y,
+                           const TensorDescriptor& bnScaleBiasMeanVarDesc,
+                           ConstData_t bnScale,
+                           ConstData_t bnBias,
+                           ConstData_t savedMean,
+                           ConstData_t savedInvVariance);
+
 } // namespace miopen
 
 #endif // GUARD_MIOPEN_BATCHNORMALIZATION_HPP_
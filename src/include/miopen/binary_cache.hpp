@@ -28,6 +28,7 @@
 #define GUARD_MLOPEN_BINARY_CACHE_HPP
 
 #include <miopen/config.h>
+#include <miopen/miopen.h>
 #include <boost/filesystem/path.hpp>
 #include <string>
 
@@ -63,9 +64,31 @@ void SaveBinary(const std::string& hsaco,
                 std::size_t num_cu,
                 const std::string& name,
                 const std::string& args,
-                bool is_kernel_str = false);
+                bool is_kernel_str    = false,
+                float compile_time_ms = 0.0f);
 #endif
 
+/// Code object of the program in the binary cache, empty if it is not there.
+std::string LoadBinaryBlob(const std::string& device,
+                           std::size_t num_cu,
+                           const std::string& name,
+                           const std::string& args,
+                           bool is_kernel_str = false);
+/// Stores the code object in the user binary cache.
+void SaveBinaryBlob(const std::string& blob,
+                    const std::string& device,
+                    std::size_t num_cu,
+                    const std::string& name,
+                    const std::string& args,
+                    bool is_kernel_str = false);
+
+/// Removes entries from the user binary cache of the device until the stored code objects take
+/// at most max_bytes. Returns the size of the removed ones. Requires the SQLite kernel cache.
+std::size_t TrimBinaryCache(const std::string& device,
+                            std::size_t num_cu,
+                            std::size_t max_bytes,
+                            miopenKernelCacheEvictPolicy_t policy);
+
 } // namespace miopen
 
 #endif
@@ -0,0 +1,119 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_BINARY_DB_HPP_
+#define GUARD_MIOPEN_BINARY_DB_HPP_
+
+#include <boost/optional.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+
+namespace boost {
+namespace interprocess {
+class mapped_region;
+} // namespace interprocess
+} // namespace boost
+
+namespace miopen {
+
+/// Memory-mappable form of the text databases (find-db, plain text perf-db).
+///
+/// Layout (host byte order):
+///   Header
+///   Entry[Header::count] sorted by key
+///   string area holding all keys and contents
+///
+/// Contents are stored exactly as they follow the "=" in the text file, so
+/// a record is parsed only when it is looked up.
+namespace binary_db {
+
+constexpr char magic[8]         = {'M', 'I', 'O', 'P', 'B', 'D', 'B', '\0'};
+constexpr std::uint32_t version  = 1;
+
+struct Header
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t count;
+    std::uint64_t entries_offset;
+    std::uint64_t strings_offset;
+    std::uint64_t strings_size;
+};
+
+struct Entry
+{
+    std::uint64_t key_offset;
+    std::uint64_t contents_offset;
+    std::uint32_t key_size;
+    std::uint32_t contents_size;
+    std::uint32_t line;
+    std::uint32_t reserved;
+};
+
+/// "gfx906_60.HIP.fdb.txt" -> "gfx906_60.HIP.fdb.bin"
+std::string GetPath(const std::string& text_path);
+
+/// Converts a text db into the binary form. Ill-formed lines are skipped
+/// with an error message, duplicate keys keep the first occurrence just
+/// like the text readers do. Returns the number of records written.
+std::size_t Compile(std::istream& text, std::ostream& binary, const std::string& source);
+
+} // namespace binary_db
+
+class MappedDb
+{
+    public:
+    struct Item
+    {
+        int line;
+        std::string content;
+    };
+
+    /// Returns nullptr if the file does not exist or is not a valid binary db.
+    static std::shared_ptr<const MappedDb> Open(const std::string& path);
+
+    ~MappedDb();
+    MappedDb(const MappedDb&) = delete;
+    MappedDb& operator=(const MappedDb&) = delete;
+
+    boost::optional<Item> Find(const std::string& key) const;
+    std::size_t Size() const { return header->count; }
+
+    private:
+    MappedDb() = default;
+
+    std::unique_ptr<boost::interprocess::mapped_region> region;
+    const binary_db::Header* header = nullptr;
+    const binary_db::Entry* entries = nullptr;
+    const char* strings             = nullptr;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_BINARY_DB_HPP_
@@ -26,13 +26,28 @@
 #ifndef GUARD_MIOPEN_BZ2_HPP_
 #define GUARD_MIOPEN_BZ2_HPP_
 
+#include <miopen/config.h>
+
 #include <bzlib.h>
 #include <string>
 #include <stdexcept>
 
 namespace miopen {
+
+/// Codecs for the kernel cache blobs. The codec is recognized by the magic bytes
+/// of the blob on decompression, so caches with mixed entries load fine.
+enum class Codec
+{
+    Bzip2,
+    Zstd, // Only if MIOPEN_USE_ZSTD
+};
+
+/// Zstd if available, unless MIOPEN_DEBUG_KERNEL_CACHE_CODEC=bzip2.
+Codec DefaultCodec();
+
 void check_bz2_error(int e, const std::string& name);
 std::string compress(std::string s, bool* compressed = nullptr);
+std::string compress_with(std::string s, Codec codec, bool* compressed);
 std::string decompress(std::string s, unsigned int size);
 
 } // namespace miopen
@@ -0,0 +1,63 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_CACHE_STATS_HPP
+#define GUARD_MIOPEN_CACHE_STATS_HPP
+
+#include <miopen/miopen.h>
+
+#include <chrono>
+
+namespace miopen {
+namespace cache_stats {
+
+/// Process-wide lookup counters of the internal caches, see miopenGetCacheStatistics(). These
+/// are relaxed atomics, any thread may record.
+void Record(miopenCacheType_t cache, bool hit, std::chrono::steady_clock::duration time);
+miopenCacheStatistics_t Get(miopenCacheType_t cache);
+void Reset();
+
+/// Measures a lookup from the construction to the call of Hit() or Miss().
+class Lookup
+{
+    public:
+    explicit Lookup(miopenCacheType_t cache_)
+        : cache(cache_), start(std::chrono::steady_clock::now())
+    {
+    }
+
+    void Hit() const { Record(cache, true, std::chrono::steady_clock::now() - start); }
+    void Miss() const { Record(cache, false, std::chrono::steady_clock::now() - start); }
+    void Done(bool hit) const { Record(cache, hit, std::chrono::steady_clock::now() - start); }
+
+    private:
+    miopenCacheType_t cache;
+    std::chrono::steady_clock::time_point start;
+};
+
+} // namespace cache_stats
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_CACHE_STATS_HPP
@@ -0,0 +1,56 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#pragma once
+
+#include <miopen/common.hpp>
+
+#include <string>
+
+namespace miopen {
+
+struct Handle;
+struct TensorDescriptor;
+
+/// Recording of the API call stream, see MIOPEN_RECORD_FILE. Every call that has a driver
+/// command line (the ones printed with MIOPEN_ENABLE_LOGGING_CMD) is appended to the record in
+/// the order of the calls, duplicates included, and the record is replayed by
+/// "MIOpenDriver replay".
+namespace call_record {
+
+bool IsEnabled();
+
+/// Returns true if the input tensors of the recorded convolutions are saved as well.
+bool IsSavingTensors();
+
+/// Appends a driver command line, given without the driver name.
+void Add(const std::string& cmd);
+
+/// Saves the contents of a device tensor next to the record, in the raw format of the driver
+/// data file flags, and returns the path of the file.
+std::string SaveTensor(const Handle& handle, const TensorDescriptor& desc, ConstData_t data);
+
+} // namespace call_record
+} // namespace miopen
@@ -1,8 +1,11 @@
 #ifndef GUARD_MIOPEN_CHECK_NUMERICS_HPP
 #define GUARD_MIOPEN_CHECK_NUMERICS_HPP
 
+#include <miopen/allocator.hpp>
 #include <miopen/common.hpp>
 
+#include <cstddef>
+
 namespace miopen {
 
 struct Handle;
@@ -15,13 +18,28 @@ struct CheckNumerics
     static const int Throw        = 0x04; // MIOPEN_THROW on abnormal result
     static const int Abort        = 0x08; // abort on abnormal result (to drop into debugger)
     static const int ComputeStats = 0x10; // Print mean/absmean/min/max (slow)
+    static const int Async        = 0x20; // accumulate results on device, report at sync points
 };
 bool CheckNumericsEnabled(int bitMask = -1);
 
+/// Per-handle state of the numeric checks. In the Async mode the kernels only raise the flags
+/// of a device buffer, which is read back and reported by checkNumericsFlush.
+struct CheckNumericsState
+{
+    Allocator::ManageDataPtr flags = nullptr;
+    std::size_t operations         = 0; // operations seen, for MIOPEN_CHECK_NUMERICS_SAMPLE_PERIOD
+    std::size_t pending            = 0; // scans accumulated in flags since the last report
+};
+
 bool checkNumericsInput(const Handle& handle, const TensorDescriptor& dDesc, ConstData_t data);
 bool checkNumericsOutput(const Handle& handle, const TensorDescriptor& dDesc, ConstData_t data);
 bool checkNumericsImpl(
     const Handle& handle, int mode, const TensorDescriptor& dDesc, ConstData_t data, bool isInput);
+/// Reads back the results accumulated in the Async mode and reports them as mode asks for.
+/// Returns true if an abnormal value was detected since the last report.
+bool checkNumericsFlush(const Handle& handle, int mode);
+/// Reports the pending results if the Async mode is enabled, as the handle is synchronized.
+bool checkNumericsFlush(const Handle& handle);
 } // namespace miopen
 
 #endif // GUARD_MIOPEN_CHECK_NUMERICS_HPP
@@ -0,0 +1,89 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_COMPILE_SERVICE_HPP_
+#define GUARD_MIOPEN_COMPILE_SERVICE_HPP_
+
+#include <miopen/kernel.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace miopen {
+
+/// Process-wide service building programs. Requests for the same program which arrive while it
+/// is being built wait for that build instead of compiling it again, and batches of builds run on
+/// a persistent pool of threads sized by MIOPEN_COMPILE_PARALLEL_LEVEL.
+///
+/// Built programs are also remembered by weak reference, so handles on the same device (or
+/// context) share a program as long as any of them holds it, instead of loading their own copies.
+class CompileService
+{
+    public:
+    static CompileService& Get();
+
+    /// Returns the program with the key if some handle still holds it. Otherwise runs build
+    /// unless a build with the same key is in flight, in which case returns the result of that
+    /// one (or rethrows its error). The key shall identify the program and the device or
+    /// context it is built for.
+    Program Build(const std::string& key, const std::function<Program()>& build);
+
+    /// Calls f for every index in [0, n) on up to max_threads threads of the pool, the calling
+    /// thread included, and waits for all of them. The first exception thrown is rethrown.
+    void
+    ParallelFor(std::size_t n, std::size_t max_threads, const std::function<void(std::size_t)>& f);
+
+    CompileService(const CompileService&) = delete;
+    CompileService& operator=(const CompileService&) = delete;
+
+    private:
+    explicit CompileService(std::size_t thread_num);
+
+    void Submit(std::function<void()> task);
+    void Work();
+
+    std::mutex in_flight_mutex;
+    std::unordered_map<std::string, std::shared_future<Program>> in_flight;
+    std::unordered_map<std::string, WeakProgram> loaded;
+    // Expired entries of loaded are swept when it grows past this size.
+    std::size_t loaded_sweep_size = 64;
+
+    std::mutex tasks_mutex;
+    std::condition_variable tasks_cv;
+    std::deque<std::function<void()>> tasks;
+    std::vector<std::thread> workers;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_COMPILE_SERVICE_HPP_
@@ -0,0 +1,61 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#pragma once
+
+#include <miopen/common.hpp>
+
+#include <cstddef>
+
+namespace miopen {
+
+struct ConvolutionDescriptor;
+struct Handle;
+struct TensorDescriptor;
+
+/// Forward convolutions of count independent problems that share the descriptors, see
+/// miopenConvolutionForwardBatched. When every array advances by exactly one packed tensor per
+/// problem and the batch size is 1, the problems are run as one convolution whose groups are the
+/// groups of all the problems. Otherwise each problem is run through one convolution plan.
+std::size_t ConvolutionForwardBatchedGetWorkSpaceSize(Handle& handle,
+                                                      const TensorDescriptor& wDesc,
+                                                      const TensorDescriptor& xDesc,
+                                                      const ConvolutionDescriptor& convDesc,
+                                                      const TensorDescriptor& yDesc,
+                                                      std::size_t count);
+
+void ConvolutionForwardBatched(Handle& handle,
+                               const TensorDescriptor& xDesc,
+                               const ConstData_t* x,
+                               const TensorDescriptor& wDesc,
+                               const ConstData_t* w,
+                               const ConvolutionDescriptor& convDesc,
+                               const TensorDescriptor& yDesc,
+                               const Data_t* y,
+                               std::size_t count,
+                               Data_t workSpace,
+                               std::size_t workSpaceSize);
+
+} // namespace miopen
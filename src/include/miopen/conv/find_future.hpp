@@ -0,0 +1,96 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#pragma once
+
+#include <miopen/common.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/miopen.h>
+#include <miopen/object.hpp>
+#include <miopen/tensor.hpp>
+
+#include <cstddef>
+#include <future>
+#include <ostream>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+
+/// Find 1.0 of a forward convolution running on a background thread, see
+/// miopenFindConvolutionForwardAlgorithmAsync. The search runs on a background handle with a
+/// stream of its own, so it neither blocks the caller nor interferes with the profiling of the
+/// work the caller enqueues meanwhile. The find-db is updated by the search itself, the invokers
+/// of the results are registered in the handle the search was started with once it is done.
+///
+/// The descriptors are copied. The handle and the buffers shall stay valid, and the buffers
+/// shall not be used, until the search is done. The destructor waits for it.
+struct ConvolutionFindFuture : miopenConvolutionFindFuture
+{
+    ConvolutionFindFuture(Handle& handle,
+                          const TensorDescriptor& xDesc_,
+                          ConstData_t x_,
+                          const TensorDescriptor& wDesc_,
+                          ConstData_t w_,
+                          const ConvolutionDescriptor& convDesc_,
+                          const TensorDescriptor& yDesc_,
+                          Data_t y_,
+                          int requestAlgoCount,
+                          Data_t workSpace_,
+                          std::size_t workSpaceSize_,
+                          bool exhaustiveSearch_);
+
+    ConvolutionFindFuture(const ConvolutionFindFuture&) = delete;
+    ConvolutionFindFuture& operator=(const ConvolutionFindFuture&) = delete;
+    ~ConvolutionFindFuture();
+
+    bool IsReady() const;
+    /// Waits for the search, then returns its results or throws its error.
+    void Wait(int* returnedAlgoCount, miopenConvAlgoPerf_t* perfResults) const;
+
+    private:
+    void Search(Handle& handle);
+    void RegisterInvokers(Handle& handle, const Handle& background) const;
+
+    TensorDescriptor xDesc;
+    TensorDescriptor wDesc;
+    TensorDescriptor yDesc;
+    ConvolutionDescriptor convDesc;
+    ConstData_t x;
+    ConstData_t w;
+    Data_t y;
+    Data_t workSpace;
+    std::size_t workSpaceSize;
+    bool exhaustiveSearch;
+
+    std::vector<miopenConvAlgoPerf_t> results;
+    std::shared_future<void> done;
+};
+
+std::ostream& operator<<(std::ostream& stream, const ConvolutionFindFuture& future);
+
+} // namespace miopen
+MIOPEN_DEFINE_OBJECT(miopenConvolutionFindFuture, miopen::ConvolutionFindFuture);
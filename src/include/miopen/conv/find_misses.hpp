@@ -0,0 +1,50 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#pragma once
+
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/interned_string.hpp>
+#include <miopen/miopen.h>
+#include <miopen/solver_id.hpp>
+
+namespace miopen {
+namespace conv {
+
+/// Find-db misses of the immediate mode, see MIOPEN_FIND_MISS_LOG. A problem answered by the
+/// fallback path is counted with the solution it got, and so are the following immediate calls
+/// of that solution. The counters of the process are kept in <prefix>.<pid>.txt, one line per
+/// problem, which utils/find_miss_jobs.sh turns into tuning jobs.
+
+bool IsFindMissLogEnabled();
+
+/// The fallback is the solution the caller is going to use, i.e. the first one reported.
+void RecordFindMiss(const ProblemDescription& problem, const miopenConvSolution_t& fallback);
+
+/// Counts an immediate call of the problem with the network config, if it has missed.
+void CountFindMissCall(const InternedString& config, solver::Id solver);
+
+} // namespace conv
+} // namespace miopen
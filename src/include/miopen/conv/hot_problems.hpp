@@ -0,0 +1,109 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/interned_string.hpp>
+
+#include <boost/optional.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace miopen {
+
+namespace solver {
+struct ConvSolution;
+} // namespace solver
+
+namespace conv {
+
+/// Hot problem specialization, a policy of MIOPEN_FIND_MODE=DYNAMIC_HYBRID and
+/// BACKGROUND_REFINE. These modes serve the problems with the generic (dynamic) kernels or the
+/// immediate mode fallback. The immediate mode calls are counted per problem and algorithm, and
+/// the first MIOPEN_FIND_SPECIALIZE_TOP_N problems of the handle (16 by default in the
+/// BACKGROUND_REFINE mode) to reach MIOPEN_FIND_SPECIALIZE_MIN_CALLS calls have the solutions of
+/// all the solvers found and built in a background thread. The caller times these against the
+/// one in use once they are ready, and registers the fastest invoker instead of it.
+class HotProblems
+{
+    public:
+    using Solutions = std::vector<solver::ConvSolution>;
+
+    HotProblems() = default;
+    HotProblems(const HotProblems&) = delete;
+    HotProblems& operator=(const HotProblems&) = delete;
+    /// Waits for the background builds, as these use the handle.
+    ~HotProblems();
+
+    static bool IsEnabled();
+
+    /// Counts a call of the problem. When it becomes hot, runs the job returned by make_build in
+    /// the background, or leaves the problem generic if there is none. Returns the solutions
+    /// built once they are ready, on one call only.
+    boost::optional<Solutions> Count(const InternedString& config,
+                                     int algorithm,
+                                     const std::function<std::function<Solutions()>()>& make_build);
+
+    private:
+    struct Key
+    {
+        InternedString config;
+        int algorithm;
+
+        friend bool operator==(const Key& lhs, const Key& rhs)
+        {
+            return lhs.config == rhs.config && lhs.algorithm == rhs.algorithm;
+        }
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator()(const Key& key) const
+        {
+            return key.config.Hash() ^ (static_cast<std::size_t>(key.algorithm) * 0x9e3779b9);
+        }
+    };
+
+    struct Entry
+    {
+        std::size_t calls = 0;
+        std::future<Solutions> build;
+        bool done = false;
+    };
+
+    // Guards the entries and the count of the builds started, the handle may be shared.
+    std::mutex mutex;
+    std::unordered_map<Key, Entry, KeyHash> entries;
+    std::size_t started = 0;
+};
+
+} // namespace conv
+} // namespace miopen
@@ -30,6 +30,7 @@
 #include <miopen/kernel.hpp>
 #include <miopen/conv/context.hpp>
 
+#include <functional>
 #include <vector>
 
 namespace miopen {
@@ -54,6 +55,26 @@ float CallImplGemmDynamicBackwardData(const miopen::Handle& handle,
                                       ConstData_t wei,
                                       const std::vector<KernelInvoke>& kernels);
 
+/// The kernels are fp32 only. fp16 and bf16 problems run them on fp32 copies of the tensors in the
+/// workspace, converted on the way in and out.
+bool IsImplGemmDynamicDataTypeSupported(const ProblemDescription& conv_problem);
+/// Size of the fp32 copies of the tensors, zero for fp32 problems.
+std::size_t GetImplGemmDynamicFp32WorkspaceSize(const ProblemDescription& conv_problem);
+/// Calls run(a, b, c, workspace) with the tensors of the problem, where c is computed from a and b.
+/// For fp16 and bf16 they are fp32 copies kept at the start of the workspace, and run gets the
+/// workspace after the copies, or nullptr if nothing is left.
+float RunImplGemmDynamicOnFp32(
+    const Handle& handle,
+    const TensorDescriptor& aDesc,
+    ConstData_t a,
+    const TensorDescriptor& bDesc,
+    ConstData_t b,
+    const TensorDescriptor& cDesc,
+    Data_t c,
+    Data_t workSpace,
+    std::size_t workSpaceSize,
+    const std::function<float(ConstData_t, ConstData_t, Data_t, Data_t)>& run);
+
 InvokerFactory MakeImplGemmDynamicForwardInvokerFactory(const ConvolutionContext& ctx);
 InvokerFactory MakeImplGemmDynamicForward1x1InvokerFactory(const ConvolutionContext& ctx);
 InvokerFactory MakeImplGemmDynamicBackwardDataInvokerFactory(const ConvolutionContext& ctx);
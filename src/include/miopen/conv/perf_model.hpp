@@ -0,0 +1,56 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/solver_id.hpp>
+
+#include <cstddef>
+
+namespace miopen {
+
+struct ConvolutionContext;
+
+namespace conv {
+
+/// Device idle time between two dependent kernels, ms. It is hidden when many calls are in
+/// flight, but adds to the latency of a single call.
+constexpr double kernel_gap_ms = 0.01;
+
+/// Analytical performance model used by the immediate mode fallback, i.e. when the
+/// find-db has no record for a problem. The estimate is derived from the problem
+/// (FLOPs, bytes moved, GEMM tile waste, occupancy of the compute units) and from
+/// nominal device properties. It is meant to rank solutions against each other and
+/// is not expected to match measured times.
+///
+/// Returns estimated execution time in milliseconds, or a negative value when the
+/// model has no information about the solver.
+float EstimateSolverTime(const ConvolutionContext& ctx,
+                         const solver::Id& solver_id,
+                         std::size_t workspace_size);
+
+} // namespace conv
+} // namespace miopen
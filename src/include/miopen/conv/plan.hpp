@@ -0,0 +1,112 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/common.hpp>
+#include <miopen/conv_algo_name.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/invoke_params.hpp>
+#include <miopen/invoker.hpp>
+#include <miopen/miopen.h>
+#include <miopen/object.hpp>
+#include <miopen/solver_id.hpp>
+#include <miopen/tensor.hpp>
+
+#include <cstddef>
+#include <ostream>
+
+namespace miopen {
+
+struct Handle;
+
+namespace conv {
+struct DataInvokeParams;
+struct WrWInvokeParams;
+} // namespace conv
+
+/// Convolution bound to its descriptors and to a solution, see miopenCreateConvolutionPlan.
+/// The descriptors are validated and the invoker is prepared once; running the plan only stores
+/// the buffers into invoke parameters built ahead and calls the invoker. Solutions which do not
+/// have an invoker, as well as the runs with MIOPEN_CHECK_NUMERICS, go through the immediate
+/// mode calls instead.
+///
+/// Tensors are named after the forward convolution in all the directions, as in
+/// miopenConvProblem_t. A plan shall not be run by several threads at the same time.
+struct ConvolutionPlan : miopenConvolutionPlan
+{
+    ConvolutionPlan(Handle& handle,
+                    const TensorDescriptor& xDesc_,
+                    const TensorDescriptor& wDesc_,
+                    const TensorDescriptor& yDesc_,
+                    const ConvolutionDescriptor& convDesc_,
+                    conv::Direction direction_,
+                    solver::Id solver_id_);
+
+    ConvolutionPlan(const ConvolutionPlan&) = delete;
+    ConvolutionPlan& operator=(const ConvolutionPlan&) = delete;
+
+    /// The workspace is served from the arena of the handle if it is enabled and none is given.
+    void Run(Handle& handle,
+             Data_t x,
+             Data_t w,
+             Data_t y,
+             Data_t workSpace,
+             std::size_t workSpaceSize);
+
+    std::size_t GetWorkspaceSize() const { return workspace_size; }
+    solver::Id GetSolverId() const { return solver_id; }
+
+    private:
+    void RunImmediate(Handle& handle,
+                      Data_t x,
+                      Data_t w,
+                      Data_t y,
+                      Data_t workSpace,
+                      std::size_t workSpaceSize) const;
+
+    ConvolutionDescriptor convDesc;
+    // Transposed convolutions run the opposite data direction with x and y exchanged.
+    bool transposed;
+    TensorDescriptor xDesc;
+    TensorDescriptor wDesc;
+    TensorDescriptor yDesc;
+    conv::Direction direction;
+    solver::Id solver_id;
+    std::size_t workspace_size = 0;
+
+    const Handle* bound_handle = nullptr;
+    Invoker invoker;
+    AnyInvokeParams params;
+    // Point into params.
+    conv::DataInvokeParams* data_params = nullptr;
+    conv::WrWInvokeParams* wrw_params   = nullptr;
+};
+
+std::ostream& operator<<(std::ostream& stream, const ConvolutionPlan& plan);
+
+} // namespace miopen
+MIOPEN_DEFINE_OBJECT(miopenConvolutionPlan, miopen::ConvolutionPlan);
@@ -33,6 +33,7 @@
 #include <miopen/tensor.hpp>
 
 #include <boost/any.hpp>
+#include <boost/optional.hpp>
 
 namespace miopen {
 
@@ -121,6 +122,17 @@ constexpr TElement GetW5(int spatial_dims, const std::vector<TElement>& data)
 
 namespace conv {
 
+/// Unstrided and unpadded 1x1 convolutions only see the height and the width of the images
+/// through their product, so two problems which split the same pixels the other way round are
+/// the same convolution of the same memory. With MIOPEN_CONV_CANONICAL_PROBLEMS these share one
+/// canonical problem, the one with the height not above the width, and so its db records,
+/// tuning and kernels. ProblemDescription is always canonical, the callers remap the descriptors
+/// the invokers run with. Returns true if the tensors have been transposed.
+bool CanonicalizeTensors(const ConvolutionDescriptor& conv,
+                         const TensorDescriptor& weights,
+                         TensorDescriptor& in,
+                         TensorDescriptor& out);
+
 struct ProblemDescription
 #if MIOPEN_ENABLE_SQLITE
     : SQLiteSerializable<ProblemDescription>
@@ -136,6 +148,7 @@ struct ProblemDescription
                        int bias_ = 0)
         : in(in_), weights(weights_), out(out_), conv(conv_), direction(direction_), bias(bias_)
     {
+        CanonicalizeTensors(conv, weights, in, out);
     }
 
     // Conv descriptor getters
@@ -163,7 +176,7 @@ struct ProblemDescription
     std::size_t GetInStrideD() const { return GetD5(GetSpatialDims(), in.GetStrides()); }
     std::size_t GetInStrideH() const { return GetH5(GetSpatialDims(), in.GetStrides()); }
     std::size_t GetInStrideW() const { return GetW5(GetSpatialDims(), in.GetStrides()); }
-    std::string GetInLayout() const { return "NCHW"; }
+    std::string GetInLayout() const { return ComputeLayout(in); }
     std::size_t GetInElementSize() const { return GetTypeSize(GetInDataType()); }
 
     std::size_t GetInSize() const
@@ -171,7 +184,7 @@ struct ProblemDescription
         // clang-format off
         return (GetInLayout() == "NCHW")
             ? GetInBatchSize() * GetInChannels() * GetInDepth() * GetInHeight() * GetInWidth() * GetInElementSize()
-            : GetInBatchSize() * GetInBatchStride() * GetInChannelStride() * GetInStrideH() * GetInStrideW() * GetInElementSize(); // Todo: GetInStrideD() ?
+            : in.GetElementSpace() * GetInElementSize();
         // clang-format on
     }
 
@@ -187,7 +200,7 @@ struct ProblemDescription
     std::size_t GetOutStrideD() const { return GetD5(GetSpatialDims(), out.GetStrides()); }
     std::size_t GetOutStrideH() const { return GetH5(GetSpatialDims(), out.GetStrides()); }
     std::size_t GetOutStrideW() const { return GetW5(GetSpatialDims(), out.GetStrides()); }
-    std::string GetOutLayout() const { return "NCHW"; }
+    std::string GetOutLayout() const { return ComputeLayout(out); }
     std::size_t GetOutElementSize() const { return GetTypeSize(GetOutDataType()); }
 
     std::size_t GetOutSize() const
@@ -195,7 +208,7 @@ struct ProblemDescription
         // clang-format off
         return (GetOutLayout() == "NCHW")
             ? GetOutBatchSize() * GetOutChannels() * GetOutDepth() * GetOutHeight() * GetOutWidth() * GetOutElementSize()
-            : GetOutBatchSize() * GetOutBatchStride() * GetOutChannelStride() * GetOutStrideH() * GetOutStrideW() * GetOutElementSize(); // Todo: GetOutStrideD() ?
+            : out.GetElementSpace() * GetOutElementSize();
         // clang-format on
     }
 
@@ -210,7 +223,12 @@ struct ProblemDescription
     // }
     // std::size_t GetWeightsStrideW() const { return GetW5(GetSpatialDims(), weights.GetStrides());
     // }
-    std::string GetWeightsLayout() const { return ""; }
+    std::string GetWeightsLayout() const
+    {
+        // Default (KCYX) weights are historically denoted by an empty string.
+        const auto layout = ComputeLayout(weights);
+        return layout == "NCHW" ? "" : layout;
+    }
     std::size_t GetWeightsElementSize() const { return GetTypeSize(GetWeightsDataType()); }
 
     std::size_t GetWeightsSize() const
@@ -229,6 +247,9 @@ struct ProblemDescription
     const ConvolutionDescriptor& GetConv() const { return conv; }
     Direction GetDirection() const { return direction; }
     int GetBias() const { return bias; }
+    /// Backward weights shall be reproducible run to run, see Handle::EnableDeterministicMode.
+    bool IsDeterministic() const { return deterministic; }
+    void SetDeterministic(bool value) { deterministic = value; }
 
     std::size_t GetBaiasSize() const
     {
@@ -249,6 +270,13 @@ struct ProblemDescription
 
     bool Is2d() const { return GetSpatialDims() == 2; }
 
+    /// True if all tensors use the default (NCHW/NCDHW, KCYX) layout. Most solvers
+    /// can only handle that, see SolverBase::IsLayoutAgnostic().
+    bool IsLayoutDefault() const
+    {
+        return GetInLayout() == "NCHW" && GetOutLayout() == "NCHW" && GetWeightsLayout().empty();
+    }
+
     bool IsFp32() const
     {
         return GetInDataType() == miopenFloat && GetWeightsDataType() == miopenFloat &&
@@ -264,6 +292,12 @@ struct ProblemDescription
         return GetInDataType() == miopenBFloat16 && GetWeightsDataType() == miopenBFloat16 &&
                GetOutDataType() == miopenBFloat16;
     }
+    /// int8 inputs and weights; the output is either int32 or fp32.
+    bool IsInt8() const
+    {
+        return GetInDataType() == miopenInt8 && GetWeightsDataType() == miopenInt8 &&
+               (GetOutDataType() == miopenInt32 || GetOutDataType() == miopenFloat);
+    }
 
     void BuildConfKey(std::string& conf_key) const;
 
@@ -276,6 +310,10 @@ struct ProblemDescription
 
     void Serialize(std::ostream& stream) const;
 
+    /// The same problem with another batch size, none unless the batch is the outermost
+    /// dimension of the tensors. See MIOPEN_FIND_BATCH_BUCKETS.
+    boost::optional<ProblemDescription> WithBatchSize(std::size_t n) const;
+
     friend std::ostream& operator<<(std::ostream& os, const ProblemDescription& obj)
     {
         obj.Serialize(os);
@@ -317,12 +355,25 @@ struct ProblemDescription
     }
 
     private:
+    /// Returns "NCHW" for the default layout regardless of the number of spatial
+    /// dimensions, to keep the existing db keys intact. Otherwise returns the actual
+    /// order, e.g. "NHWC" or "NDHWC".
+    std::string ComputeLayout(const TensorDescriptor& desc) const
+    {
+        const std::string labels = GetSpatialDims() == 3 ? "NCDHW" : "NCHW";
+        if(desc.GetLengths().size() != labels.size())
+            return "NCHW";
+        const auto layout = desc.GetLayout(labels);
+        return layout == labels ? "NCHW" : layout;
+    }
+
     TensorDescriptor in;
     TensorDescriptor weights;
     TensorDescriptor out;
     ConvolutionDescriptor conv;
     Direction direction = Direction::Forward;
     int bias            = 0;
+    bool deterministic  = false;
 };
 
 } // namespace conv
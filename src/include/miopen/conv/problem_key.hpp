@@ -0,0 +1,89 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/conv_algo_name.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace miopen {
+
+struct ConvolutionDescriptor;
+struct TensorDescriptor;
+
+namespace conv {
+
+/// Fixed-size binary image of everything a convolution network config depends on: the types,
+/// lengths and strides of the three tensors, the convolution parameters and the direction.
+/// Unlike the network config it is built without any formatting, so the immediate mode calls
+/// may use it to find the (interned) network config of a problem seen before, see
+/// Handle::GetProblemConfig. Equal keys always yield equal network configs.
+///
+/// x, w and y are the input, weights and output of the forward convolution in all the directions.
+class ProblemKey
+{
+    public:
+    ProblemKey(const TensorDescriptor& x,
+               const TensorDescriptor& w,
+               const TensorDescriptor& y,
+               const ConvolutionDescriptor& conv,
+               Direction direction,
+               bool deterministic = false);
+
+    /// Problems of more than 5 dimensions are not represented, these shall use the config.
+    bool IsValid() const { return is_valid; }
+    std::size_t Hash() const { return hash; }
+
+    friend bool operator==(const ProblemKey& lhs, const ProblemKey& rhs)
+    {
+        return lhs.hash == rhs.hash && lhs.values == rhs.values;
+    }
+    friend bool operator!=(const ProblemKey& lhs, const ProblemKey& rhs) { return !(lhs == rhs); }
+
+    private:
+    static constexpr std::size_t max_tensor_dims  = 5;
+    static constexpr std::size_t max_spatial_dims = 3;
+    // {type, rank, lengths, strides} per tensor, then {spatial dims, mode, padding mode, groups,
+    // pads, strides, dilations, transposed output pads}, the direction, the latency preference
+    // and the deterministic mode.
+    static constexpr std::size_t tensor_size = 2 + 2 * max_tensor_dims;
+    static constexpr std::size_t size        = 3 * tensor_size + 4 + 4 * max_spatial_dims + 3;
+
+    std::array<std::uint64_t, size> values{};
+    std::size_t hash = 0;
+    bool is_valid    = true;
+};
+
+struct ProblemKeyHash
+{
+    std::size_t operator()(const ProblemKey& key) const { return key.Hash(); }
+};
+
+} // namespace conv
+} // namespace miopen
@@ -0,0 +1,81 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#pragma once
+
+#include <miopen/conv_algo_name.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/miopen.h>
+#include <miopen/solver_id.hpp>
+
+#include <vector>
+
+namespace miopen {
+namespace conv {
+
+/// Latency histograms of the convolution solvers, one per solver, direction and data type for
+/// the whole process, see miopenGetSolverHistograms. These are filled from all the runs on the
+/// handles with profiling enabled, and from one sampled run in
+/// MIOPEN_SOLVER_HISTOGRAM_SAMPLE_PERIOD per thread otherwise.
+
+/// Returns true if the next invoker run on the handle is to be timed and recorded.
+bool IsSampledRun(const Handle& handle);
+
+void RecordSolverTime(solver::Id solver, Direction direction, miopenDataType_t type, float time_ms);
+
+std::vector<miopenSolverHistogram_t> GetSolverHistograms();
+
+void ResetSolverHistograms();
+
+/// Calls run, timing it if this run is sampled. The solver is only queried for the timed runs,
+/// as finding it may cost a lookup. A sampled run on a handle without profiling enables it for
+/// the duration of the run, which makes the run synchronous.
+template <class GetSolver, class Run>
+void RunSampled(const Handle& handle,
+                Direction direction,
+                miopenDataType_t type,
+                const GetSolver& get_solver,
+                const Run& run)
+{
+    if(!IsSampledRun(handle))
+    {
+        run();
+        return;
+    }
+
+    if(handle.IsProfilingEnabled())
+    {
+        run();
+        RecordSolverTime(get_solver(), direction, type, handle.GetKernelTime());
+        return;
+    }
+
+    const AutoEnableProfiling profiling{handle};
+    run();
+    RecordSolverTime(get_solver(), direction, type, handle.GetKernelTime());
+}
+
+} // namespace conv
+} // namespace miopen
@@ -88,6 +88,11 @@ struct ConvSolution
 
 std::ostream& operator<<(std::ostream& os, const ConvSolution& s);
 
+/// Returns the kernels of the successful solutions which are not in the program cache yet,
+/// each (file, options) pair only once.
+std::vector<KernelInfo> GetUncompiledKernels(const Handle& h,
+                                             const std::vector<ConvSolution>& sols);
+
 void PrecompileSolutions(const Handle& h, const std::vector<ConvSolution>& sols);
 
 } // namespace solver
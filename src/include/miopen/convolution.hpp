@@ -247,7 +247,8 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
                              const TensorDescriptor& yDesc,
                              size_t maxSolutionCount,
                              size_t* solutionCount,
-                             miopenConvSolution_t* solutions) const;
+                             miopenConvSolution_t* solutions,
+                             bool* fallback = nullptr) const;
 
     void CompileForwardSolution(Handle& handle,
                                 const TensorDescriptor& wDesc,
@@ -325,7 +326,8 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
                               const TensorDescriptor& dxDesc,
                               size_t maxSolutionCount,
                               size_t* solutionCount,
-                              miopenConvSolution_t* solutions) const;
+                              miopenConvSolution_t* solutions,
+                              bool* fallback = nullptr) const;
 
     void CompileBackwardSolution(Handle& handle,
                                  const TensorDescriptor& dyDesc,
@@ -361,7 +363,8 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
                          const TensorDescriptor& dwDesc,
                          size_t maxSolutionCount,
                          size_t* solutionCount,
-                         miopenConvSolution_t* solutions) const;
+                         miopenConvSolution_t* solutions,
+                         bool* fallback = nullptr) const;
 
     void CompileWrwSolution(Handle& handle,
                             const TensorDescriptor& dyDesc,
@@ -427,6 +430,31 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
                                     Data_t workSpace,
                                     std::size_t workSpaceSize) const;
 
+    /// Workspace needed by ConvolutionBackwardWeightsBias(): the requirement of the weights pass,
+    /// or of the fused GEMM path when that one applies and needs more.
+    std::size_t BackwardWeightsBiasGetWorkSpaceSize(Handle& handle,
+                                                    const TensorDescriptor& dyDesc,
+                                                    const TensorDescriptor& xDesc,
+                                                    const TensorDescriptor& dwDesc) const;
+
+    /// Computes the weights gradient dw and the bias gradient db of the layer. When the GEMM
+    /// algorithm is selected and the workspace is large enough, db comes out of the weights GEMM
+    /// itself, so dy is read once. Otherwise the two gradients are computed one after another.
+    void ConvolutionBackwardWeightsBias(Handle& handle,
+                                        const void* alpha,
+                                        const TensorDescriptor& dyDesc,
+                                        ConstData_t dy,
+                                        const TensorDescriptor& xDesc,
+                                        ConstData_t x,
+                                        miopenConvBwdWeightsAlgorithm_t algo,
+                                        const void* beta,
+                                        const TensorDescriptor& dwDesc,
+                                        Data_t dw,
+                                        const TensorDescriptor& dbDesc,
+                                        Data_t db,
+                                        Data_t workSpace,
+                                        std::size_t workSpaceSize) const;
+
     std::size_t spatialDim;
     miopenConvolutionMode_t mode;
     miopenPaddingMode_t paddingMode;
@@ -436,6 +464,9 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
     std::vector<int> trans_output_pads;
     int group_count;
     float lowp_quant; // quantization factor for low precision
+    // Rank the solutions by the latency of a single call, see
+    // MIOPEN_CONVOLUTION_ATTRIB_PREFER_LATENCY.
+    bool prefer_latency = false;
 
     private:
     void ConvFwdGemm(Handle& handle,
@@ -459,7 +490,9 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
                     size_t workSpaceSize,
                     const NetworkConfig& kcache_key) const;
 
-    ProblemDescription MakeWrwProblem(const TensorDescriptor& dyDesc,
+    /// Follows the deterministic mode of the handle.
+    ProblemDescription MakeWrwProblem(const Handle& handle,
+                                      const TensorDescriptor& dyDesc,
                                       const TensorDescriptor& xDesc,
                                       const TensorDescriptor& dwDesc) const;
 
@@ -468,6 +501,17 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
                              Data_t workSpace,
                              std::size_t workSpaceSize) const;
 
+    /// Zero when the fused weights and bias GEMM does not apply to the problem.
+    std::size_t BackwardWeightsBiasGetWorkSpaceSizeGEMM(const TensorDescriptor& dyDesc,
+                                                        const TensorDescriptor& dwDesc) const;
+
+    void BackwardWeightsBiasGemm(Handle& handle,
+                                 const ConvWrwTensors& tensors,
+                                 const TensorDescriptor& dbDesc,
+                                 Data_t db,
+                                 Data_t workSpace,
+                                 std::size_t workSpaceSize) const;
+
     template <class TKernels>
     void BackwardWeightsDirect(Handle& handle,
                                const ConvolutionContext& ctx,
@@ -514,15 +558,18 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
                              const TensorDescriptor& xDesc,
                              const TensorDescriptor& dwDesc) const;
 
-    std::size_t GetFwdSolutionCountFallback(const TensorDescriptor& wDesc,
+    std::size_t GetFwdSolutionCountFallback(Handle& handle,
+                                            const TensorDescriptor& wDesc,
                                             const TensorDescriptor& xDesc,
                                             const TensorDescriptor& yDesc) const;
 
-    std::size_t GetBwdSolutionCountFallback(const TensorDescriptor& dyDesc,
+    std::size_t GetBwdSolutionCountFallback(Handle& handle,
+                                            const TensorDescriptor& dyDesc,
                                             const TensorDescriptor& wDesc,
                                             const TensorDescriptor& dxDesc) const;
 
-    std::size_t GetWrwSolutionCountFallback(const TensorDescriptor& dyDesc,
+    std::size_t GetWrwSolutionCountFallback(Handle& handle,
+                                            const TensorDescriptor& dyDesc,
                                             const TensorDescriptor& xDesc,
                                             const TensorDescriptor& dwDesc) const;
 
@@ -549,6 +596,16 @@ void ConvolutionBackwardBias(const Handle& handle,
                              const TensorDescriptor& dbDesc,
                              Data_t db);
 
+/// Compiles the best find-db solution of every problem and stores the resulting kernels and
+/// invokers in the handle. Problems without a find-db record are skipped.
+void PrewarmConvolutions(Handle& handle, const std::vector<ProblemDescription>& problems);
+
+/// Keeps the solutions which fit into workspace_limit and are not beaten by another one in both
+/// time and workspace size. The result is ordered by time, so the workspace sizes decrease along
+/// it and the first solution is the fastest one which fits.
+std::vector<miopenConvSolution_t> GetParetoSolutions(std::vector<miopenConvSolution_t> solutions,
+                                                     std::size_t workspace_limit);
+
 std::ostream& operator<<(std::ostream& stream, const ConvolutionDescriptor& c);
 
 } // namespace miopen
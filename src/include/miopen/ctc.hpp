@@ -70,6 +70,31 @@ struct CTCLossDescriptor : miopenCTCLossDescriptor
                  size_t workSpaceSize) const;
 };
 
+/// Workspace layout of the tiled CTC loss kernels. The lattice of every sample is split into
+/// tiles of work_per_grp states and tile_t time steps, each processed by its own workgroup. Only
+/// the tile boundaries are kept in the workspace; offsets are in floats from its start.
+struct CTCLossTiledLayout
+{
+    std::size_t work_per_grp;
+    std::size_t tile_t;
+    std::size_t s_tiles;
+    std::size_t t_tiles;
+    std::size_t grad_log_offset;
+    std::size_t alpha_ckpt_offset;
+    std::size_t alpha_col_offset;
+    std::size_t beta_col_offset;
+    std::size_t beta_row_offset;
+    std::size_t alpha_end_offset;
+    std::size_t size; ///< Bytes of workspace required
+};
+
+/// Long labels and utterances, which do not fit a single workgroup per sample, and fp16 inputs
+/// are handled by the tiled kernels.
+bool IsCTCLossTiled(const TensorDescriptor& probsDesc, int max_label_len);
+
+CTCLossTiledLayout
+GetCTCLossTiledLayout(const TensorDescriptor& probsDesc, int max_label_len, int total_label_len);
+
 std::ostream& operator<<(std::ostream& stream, const CTCLossDescriptor& r);
 
 } // namespace miopen
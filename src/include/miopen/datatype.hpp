@@ -57,6 +57,13 @@ inline std::string GetDataType(miopenDataType_t type)
     return type_str;
 }
 
+// Type of the elements in the kernels built for OpenCL C, which has no bfloat16 and works on
+// its bits in ushort instead.
+inline std::string GetKernelStorageType(miopenDataType_t type)
+{
+    return type == miopenBFloat16 ? std::string("ushort") : GetDataType(type);
+}
+
 inline std::size_t get_data_size(miopenDataType_t) { MIOPEN_THROW("not implemented"); }
 
 inline std::size_t get_data_size(miopenIndexType_t index_type)
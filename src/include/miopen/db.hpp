@@ -46,8 +46,25 @@ namespace miopen {
 
 struct RecordPositions;
 class LockFile;
+class DbJournal;
+class SharedDbImage;
+class MappedDb;
+
+extern bool testing_user_db_journal_enabled;          // For unit tests.
+extern std::string testing_user_db_shared_cache_path; // For unit tests.
 
 /// No instance of this class should be used from several threads at the same time.
+///
+/// With MIOPEN_USER_DB_JOURNAL enabled, StoreRecord() and UpdateRecord() of a user db append to a
+/// journal private to the process instead of rewriting the db file under its lock, so that the
+/// processes sharing the db don't serialize on every update. FindRecord() sees the journal of
+/// the own process on top of the db file. The journal is merged into the db file in one rewrite
+/// when it grows large, before RemoveRecord() and Remove(), and at exit. The journal of a
+/// process which died before merging it is merged by the next one opening the db.
+///
+/// With MIOPEN_USER_DB_SHARED_CACHE_PATH set, the record reads of a user db look up a binary
+/// image of the db file there, which all the processes of the node using the same db map
+/// read-only instead of scanning the file on each lookup. See SharedDbImage.
 class PlainTextDb
 {
     public:
@@ -141,12 +158,29 @@ class PlainTextDb
         return record->GetValues(id, values);
     }
 
+    /// The text db keeps the problems as serialized keys only, so it does not take part in the
+    /// nearest problem lookups, see SQLitePerfDb::LoadNearest().
+    template <class T, class V, class TValid>
+    inline boost::optional<double> LoadNearest(const T&, const std::string&, V&, const TValid&)
+    {
+        return boost::none;
+    }
+
+    /// Merges the journal of this process into the db file, see MIOPEN_USER_DB_JOURNAL.
+    ///
+    /// Returns true if there was nothing to merge or the merge was successful.
+    bool FlushJournal();
+
     private:
     std::string filename;
     LockFile& lock_file;
     const bool warn_if_unreadable;
+    DbJournal* journal          = nullptr;
+    SharedDbImage* shared_image = nullptr;
 
     boost::optional<DbRecord> FindRecordUnsafe(const std::string& key, RecordPositions* pos);
+    boost::optional<DbRecord> FindRecordInImage(const MappedDb& image,
+                                                const std::string& key) const;
     bool FlushUnsafe(const DbRecord& record, const RecordPositions* pos);
     bool StoreRecordUnsafe(const DbRecord& record);
     bool UpdateRecordUnsafe(DbRecord& record);
@@ -170,6 +204,17 @@ struct sink
 };
 #endif
 
+/// A record which is either owned or, if the db keeps its records parsed, points into the db,
+/// which outlives it.
+struct DbRecordRef
+{
+    boost::optional<DbRecord> owned;
+    const DbRecord* ref = nullptr;
+
+    explicit operator bool() const { return owned || ref != nullptr; }
+    const DbRecord& operator*() const { return ref != nullptr ? *ref : *owned; }
+};
+
 template <class TInstalled, class TUser, bool merge_records>
 class MultiFileDb
 {
@@ -222,6 +267,18 @@ class MultiFileDb
 #endif
     }
 
+    /// Same as FindRecord(), except that a record kept parsed by the installed db is not copied.
+    template <bool merge = merge_records, std::enable_if_t<!merge>* = nullptr, typename... U>
+    DbRecordRef FindRecordRef(const U&... args)
+    {
+#if !MIOPEN_DISABLE_USERDB
+        auto users = _user.FindRecord(args...);
+        if(users)
+            return {std::move(users), nullptr};
+#endif
+        return FindInstalledRecordRef(rank<1>{}, _installed, args...);
+    }
+
     template <typename... U>
     auto StoreRecord(const U&... args)
     {
@@ -276,6 +333,26 @@ class MultiFileDb
         return _installed.Load(args...);
     }
 
+    /// Takes the nearer of the problems found in the user and the installed dbs.
+    template <class T, class V, class TValid>
+    boost::optional<double> LoadNearest(const T& problem_config,
+                                        const std::string& id,
+                                        V& values,
+                                        const TValid& is_valid)
+    {
+        const auto installed = _installed.LoadNearest(problem_config, id, values, is_valid);
+#if !MIOPEN_DISABLE_USERDB
+        auto user_values = values;
+        const auto user  = _user.LoadNearest(problem_config, id, user_values, is_valid);
+        if(user && (!installed || *user <= *installed))
+        {
+            values = user_values;
+            return user;
+        }
+#endif
+        return installed;
+    }
+
     template <typename... U>
     auto Remove(const U&... args)
     {
@@ -288,6 +365,21 @@ class MultiFileDb
     }
 
     private:
+    template <class TDb, typename... U>
+    static auto FindInstalledRecordRef(rank<1>, const TDb& db, const U&... args)
+        -> decltype(db.IsPreparsed(), DbRecordRef{})
+    {
+        if(db.IsPreparsed())
+            return {boost::none, db.FindRecordRef(args...)};
+        return {db.FindRecord(args...), nullptr};
+    }
+
+    template <class TDb, typename... U>
+    static DbRecordRef FindInstalledRecordRef(rank<0>, TDb& db, const U&... args)
+    {
+        return {db.FindRecord(args...), nullptr};
+    }
+
     template <class TDb, class TRet = decltype(TDb::GetCached("", true, "", 0))>
     static TRet GetDbInstance(rank<1>,
                               const std::string& path,
@@ -338,6 +430,12 @@ class DbTimer
         return Measure("FindRecord", [&]() { return inner.FindRecord(args...); });
     }
 
+    template <typename... U>
+    auto FindRecordRef(const U&... args)
+    {
+        return Measure("FindRecord", [&]() { return inner.FindRecordRef(args...); });
+    }
+
     template <typename... U>
     auto StoreRecord(U&... record)
     {
@@ -368,6 +466,12 @@ class DbTimer
         return Measure("Load", [&]() { return inner.Load(args...); });
     }
 
+    template <typename... U>
+    auto LoadNearest(U&... args)
+    {
+        return Measure("LoadNearest", [&]() { return inner.LoadNearest(args...); });
+    }
+
     template <typename... U>
     bool Remove(const U&... args)
     {
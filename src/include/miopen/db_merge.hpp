@@ -0,0 +1,80 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_DB_MERGE_HPP_
+#define GUARD_MIOPEN_DB_MERGE_HPP_
+
+#include <cstddef>
+#include <iosfwd>
+#include <map>
+#include <set>
+#include <string>
+
+namespace miopen {
+
+/// Combines the text find-dbs or perf-dbs produced by several tuning nodes into one, which may be
+/// installed as the system db of the fleet.
+///
+/// Conflicts are resolved per key and id (algorithm for the find-db, solver for the perf-db):
+///  - find-db: the entry with the lowest time wins;
+///  - perf-db: entries carry no time, so the input added first wins.
+/// Keys whose inputs disagreed on the solver (find-db) or the parameters (perf-db) are reported
+/// as disputed: times measured on different nodes may not be comparable, so these are the
+/// candidates for re-tuning on a reference node.
+class DbMerger
+{
+    public:
+    enum class Kind
+    {
+        Find,
+        Perf,
+    };
+
+    /// Find-db for "*.fdb.txt" files, perf-db otherwise.
+    static Kind GetKind(const std::string& path);
+
+    DbMerger(Kind kind_) : kind(kind_) {}
+
+    /// Ill-formed lines and entries are skipped with an error message. Returns the number of
+    /// records read.
+    std::size_t Add(std::istream& text, const std::string& source);
+    /// Writes the merged db, sorted by key. Returns the number of records written.
+    std::size_t Write(std::ostream& text) const;
+
+    std::size_t GetConflictCount() const { return conflicts; }
+    const std::set<std::string>& GetDisputedKeys() const { return disputed; }
+
+    private:
+    void AddEntry(const std::string& key, const std::string& id, const std::string& value);
+
+    Kind kind;
+    std::map<std::string, std::map<std::string, std::string>> records;
+    std::set<std::string> disputed;
+    std::size_t conflicts = 0;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_DB_MERGE_HPP_
@@ -26,7 +26,9 @@
 #ifndef GUARD_MIOPEN_DB_PATH_HPP
 #define GUARD_MIOPEN_DB_PATH_HPP
 
+#include <cstddef>
 #include <string>
+#include <vector>
 
 namespace miopen {
 
@@ -35,6 +37,19 @@ const std::string& GetUserDbPath();
 std::string GetUserDbSuffix();
 std::string GetSystemFindDbSuffix();
 
+/// Of the CU counts the system dbs have been tuned for, the one to use on a device with
+/// num_cu: num_cu itself if available, else the nearest one, the larger on a tie. Returns
+/// num_cu if none is available or MIOPEN_DEBUG_DISABLE_SYSDB_CU_FALLBACK is set.
+std::size_t GetNearestNumCu(std::size_t num_cu, const std::vector<std::size_t>& available);
+
+/// Basename of the file in the system db directory named <basename><suffix> for the device,
+/// e.g. "gfx906_60" for the suffix ".HIP.fdb.txt". Devices with a CU count the system dbs
+/// have not been tuned for, like partitioned or harvested SKUs, get the file of the same
+/// arch with the nearest CU count, see GetNearestNumCu().
+std::string GetSystemDbBasename(const std::string& device,
+                                std::size_t num_cu,
+                                const std::string& suffix);
+
 } // namespace miopen
 
 #endif
@@ -239,6 +239,7 @@ class DbRecord
         return *this;
     }
 
+    friend class DbJournal;
     friend class PlainTextDb;
     friend class SQLitePerfDb;
     friend class ReadonlyRamDb;
@@ -65,9 +65,13 @@ struct DropoutDescriptor : miopenDropoutDescriptor
     bool use_mask;
     bool state_evo;
     miopenRNGType_t rng_mode;
+    miopenDropoutMaskFormat_t mask_format;
 
     miopenDataType_t dataType_;
 
+    /// Bytes of reserveSpace that hold the mask of elements elements
+    size_t GetReserveSpaceSize(size_t elements) const;
+
     void InitPRNGState(Handle& handle,
                        Data_t prng_states,
                        size_t prng_stateSizeInBytes,
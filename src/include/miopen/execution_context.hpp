@@ -82,6 +82,7 @@ struct ExecutionContext
 
     inline Handle& GetStream() const { return *stream; }
     inline void SetStream(Handle* stream_) { stream = stream_; }
+    inline bool HasStream() const { return stream != nullptr; }
 
     ExecutionContext() = default;
 
@@ -95,7 +96,9 @@ struct ExecutionContext
 #if MIOPEN_ENABLE_SQLITE
             filename << "miopen.db";
 #else
-            filename << GetStream().GetDbBasename()
+            filename << GetSystemDbBasename(GetStream().GetDeviceName(),
+                                            GetStream().GetMaxComputeUnits(),
+                                            ".cd.pdb.txt")
             << ".cd.pdb.txt";
 #endif
         // clang-format on
@@ -113,7 +116,7 @@ struct ExecutionContext
         boost::filesystem::path pdb_path(udb);
         std::ostringstream filename;
 #if MIOPEN_ENABLE_SQLITE
-             filename << "miopen_" << SQLitePerfDb::MIOPEN_PERFDB_SCHEMA_VER << ".udb";
+             filename << "miopen_" << SQLitePerfDb::MIOPEN_USER_PERFDB_FILE_VER << ".udb";
 #else
              filename << GetStream().GetDbBasename()
              << "."
@@ -130,6 +130,7 @@ class FindMode
         Hybrid,
         FastHybrid,
         DynamicHybrid,
+        BackgroundRefine,
         End_,
         Default_ = Hybrid,
     };
@@ -140,7 +141,12 @@ class FindMode
     public:
     FindMode(const ConvolutionContext& ctx);
 
-    bool IsFast() const { return value == Values::Fast && !debug::FindModeDisable; }
+    /// Background refine answers the Find calls as the fast mode does.
+    bool IsFast() const
+    {
+        return (value == Values::Fast || value == Values::BackgroundRefine) &&
+               !debug::FindModeDisable;
+    }
     bool IsHybrid() const
     {
         return (value == Values::Hybrid || value == Values::FastHybrid ||
@@ -152,6 +158,13 @@ class FindMode
     {
         return value == Values::DynamicHybrid && !debug::FindModeDisable;
     }
+    bool IsBackgroundRefine() const
+    {
+        return value == Values::BackgroundRefine && !debug::FindModeDisable;
+    }
+    /// MIOPEN_FIND_MODE=BACKGROUND_REFINE is set. Unlike IsBackgroundRefine(), needs no problem
+    /// and ignores MIOPEN_FIND_ENFORCE, so it is only a hint for the paths which have none.
+    static bool IsBackgroundRefineSet();
     friend std::ostream& operator<<(std::ostream&, const FindMode&);
 };
 
@@ -29,10 +29,12 @@
 
 #include <miopen/db.hpp>
 #include <miopen/db_path.hpp>
+#include <miopen/cache_stats.hpp>
 #include <miopen/db_record.hpp>
 #include <miopen/env.hpp>
 #include <miopen/perf_field.hpp>
 #include <miopen/readonlyramdb.hpp>
+#include <miopen/trace.hpp>
 
 #include <boost/optional.hpp>
 
@@ -45,6 +47,7 @@ namespace miopen {
 
 struct Handle;
 struct NetworkConfig;
+struct ProblemDescription;
 
 template <class TDb>
 class FindDbRecord_t;
@@ -67,6 +70,11 @@ testing_find_db_path_override(); /// \todo Remove when #1723 is resolved.
 
 bool CheckInvokerSupport(const std::string& algo);
 
+/// Batch sizes whose find-db records stand in for a missing record of batch size n, nearest
+/// first: the closest buckets of MIOPEN_FIND_BATCH_BUCKETS above and below n. Empty if the
+/// variable is not set.
+std::vector<std::size_t> GetBatchBucketCandidates(std::size_t n);
+
 template <class TDb>
 class FindDbRecord_t
 {
@@ -94,8 +102,15 @@ class FindDbRecord_t
         if(!db.is_initialized())
             return;
 
-        content = db->FindRecord(problem);
-        in_sync = content.is_initialized();
+        // Records of a pre-parsed system find-db are used in place.
+        auto found = db->FindRecordRef(problem);
+        content    = std::move(found.owned);
+        installed  = found.ref;
+        if(!found)
+            content = FindInBatchBuckets(problem);
+        in_sync = !empty();
+        lookup.Done(in_sync);
+        trace::AddSpanFrom("db", in_sync ? "find-db hit" : "find-db miss", lookup_start);
     }
 
     template <class TProblemDescription, class TTestDb = TDb>
@@ -115,6 +130,8 @@ class FindDbRecord_t
 
         content = db->FindRecord(problem);
         in_sync = content.is_initialized();
+        lookup.Done(in_sync);
+        trace::AddSpanFrom("db", in_sync ? "find-db hit" : "find-db miss", lookup_start);
     }
 
     ~FindDbRecord_t()
@@ -125,11 +142,14 @@ class FindDbRecord_t
             MIOPEN_LOG_E("Failed to store record to find-db at <" << path << ">");
     }
 
-    auto begin() const { return content->As<FindDbData>().begin(); }
-    auto begin() { return content->As<FindDbData>().begin(); }
-    auto end() const { return content->As<FindDbData>().end(); }
-    auto end() { return content->As<FindDbData>().end(); }
-    bool empty() const { return !content.is_initialized(); }
+    auto begin() const { return GetContent().template As<FindDbData>().begin(); }
+    auto end() const { return GetContent().template As<FindDbData>().end(); }
+    bool empty() const { return !content.is_initialized() && installed == nullptr; }
+    /// The record has been tuned for another batch size, see GetBatchBucketCandidates().
+    bool IsFromBatchBucket() const { return from_batch_bucket; }
+
+    static std::string GetInstalledPath(Handle& handle);
+    static std::string GetUserPath(Handle& handle);
 
     template <class TProblemDescription>
     static std::vector<PerfField> TryLoad(Handle& handle,
@@ -139,17 +159,13 @@ class FindDbRecord_t
         auto ret = std::vector<PerfField>{};
         FindDbRecord_t<TDb> record{handle, problem};
 
-        const auto network_config = problem.BuildConfKey();
-
-        if(record.in_sync && !record.Validate(handle, network_config))
-        {
-            record.CopyTo(ret);
+        if(record.in_sync && record.CopyIfValid(handle, problem.BuildConfKey(), ret))
             return ret;
-        }
 
         MIOPEN_LOG_I("Find-db regenerating.");
         ret.clear();
-        record.in_sync = false;
+        record.in_sync   = false;
+        record.installed = nullptr;
         record.content.emplace(problem);
         regenerator(*record.content);
         record.CopyTo(ret);
@@ -157,21 +173,52 @@ class FindDbRecord_t
         return ret;
     }
 
+    /// Sets the entry of one algorithm in the user find-db record of the problem, keeping the
+    /// other entries of the record.
+    template <class TProblemDescription, class TTestDb = TDb>
+    static bool Update(Handle& handle,
+                       const TProblemDescription& problem,
+                       const std::string& id,
+                       const FindDbData& data,
+                       is_find_t<TTestDb> = 0)
+    {
+        FindDbRecord_t<TDb> record{handle, problem};
+        return record.db.is_initialized() && record.db->Update(problem, id, data);
+    }
+
     private:
+    // First, so the lookup includes the opening of the db.
+    trace::Clock::time_point lookup_start = trace::Now();
+    cache_stats::Lookup lookup{miopenCacheFindDb};
     std::string path;
     std::string installed_path;
     boost::optional<DbTimer<TDb>> db;
     boost::optional<DbRecord> content{boost::none};
-    bool in_sync = false;
+    // Set instead of the content when it is a record of the pre-parsed system find-db.
+    const DbRecord* installed = nullptr;
+    bool in_sync              = false;
+    bool from_batch_bucket    = false;
 
     static bool HasKernel(Handle& handle, const FindDbKCacheKey& key);
 
-    static std::string GetInstalledPath(Handle& handle);
-    static std::string GetUserPath(Handle& handle);
+    const DbRecord& GetContent() const { return installed != nullptr ? *installed : *content; }
+
+    /// Only convolution problems are bucketed.
+    template <class TProblemDescription>
+    boost::optional<DbRecord> FindInBatchBuckets(const TProblemDescription&)
+    {
+        return boost::none;
+    }
+    /// Keeps the entries of the solvers which have invokers: these are checked for
+    /// applicability and built for the actual problem, unlike the kernels named by kcache_key.
+    boost::optional<DbRecord> FindInBatchBuckets(const ProblemDescription& problem);
 
     // Returns true if rebuild is required
     bool Validate(Handle& handle, const NetworkConfig& config) const;
     void CopyTo(std::vector<PerfField>& to) const;
+    /// Copies the record if it is still valid. Records validated once are not checked against
+    /// the caches again until the kernel cache drops something.
+    bool CopyIfValid(Handle& handle, const NetworkConfig& config, std::vector<PerfField>& to) const;
 
     void LogFindDbItem(const std::pair<std::string, FindDbData>& pair,
                        bool log_as_error = false) const;
@@ -27,14 +27,18 @@
 #ifndef MIOPEN_GUARD_MLOPEN_FIND_SOLUTION_HPP
 #define MIOPEN_GUARD_MLOPEN_FIND_SOLUTION_HPP
 
+#include <miopen/cache_stats.hpp>
 #include <miopen/env.hpp>
 #include <miopen/conv_solution.hpp>
 #include <miopen/find_controls.hpp>
+#include <miopen/solver_applicability.hpp>
 #include <miopen/solver_id.hpp>
 
 #include <limits>
 #include <vector>
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_PERFDB_NEAREST)
+
 namespace miopen {
 
 struct AnyInvokeParams;
@@ -68,7 +72,10 @@ auto FindSolutionImpl(
         {
             using PerformanceConfig = decltype(s.GetPerformanceConfig(context));
             PerformanceConfig config{};
-            if(db.Load(context, SolverDbId(s), config))
+            const cache_stats::Lookup lookup{miopenCachePerfDb};
+            const auto loaded = db.Load(context, SolverDbId(s), config);
+            lookup.Done(loaded);
+            if(loaded)
             {
                 MIOPEN_LOG_I2("Perf Db: record loaded: " << SolverDbId(s));
                 if(s.IsValidPerformanceConfig(context, config))
@@ -82,6 +89,21 @@ auto FindSolutionImpl(
             else
             {
                 MIOPEN_LOG_I("Perf Db: record not found for: " << SolverDbId(s));
+                if(!(context.do_search || enforce.IsSearch(context)) &&
+                   miopen::IsEnabled(MIOPEN_DEBUG_PERFDB_NEAREST{}))
+                {
+                    const auto is_valid = [&](const PerformanceConfig& c) {
+                        return s.IsValidPerformanceConfig(context, c);
+                    };
+                    const auto distance = db.LoadNearest(context, SolverDbId(s), config, is_valid);
+                    if(distance)
+                    {
+                        MIOPEN_LOG_I("Perf Db: nearest record loaded: "
+                                     << SolverDbId(s) << ", distance: " << *distance << ": "
+                                     << config);
+                        return s.GetSolution(context, config);
+                    }
+                }
             }
         }
 
@@ -144,6 +166,7 @@ struct SolverContainer
         std::vector<Solution> ss;
         std::size_t count    = 0;
         const auto find_only = GetEnvFindOnlySolver();
+        const auto memo      = applicability::Memo{search_params};
         miopen::each_args(
             [&](auto solver) {
                 if(count >= limit)
@@ -151,7 +174,9 @@ struct SolverContainer
                 if(find_only.IsValid() && find_only != Id{SolverDbId(solver)})
                 { // Do nothing (and keep silence for the sake of Tuna), just skip.
                 }
-                else if(!solver.IsApplicable(search_params))
+                else if(!search_params.IsLayoutDefault() && !solver.IsLayoutAgnostic())
+                    MIOPEN_LOG_I2(SolverDbId(solver) << ": Skipped (layout)");
+                else if(!memo.IsApplicable(solver, search_params))
                     MIOPEN_LOG_I2(SolverDbId(solver) << ": Not applicable");
                 else if(search_params.use_dynamic_solutions_only && !solver.IsDynamic())
                     MIOPEN_LOG_I2(SolverDbId(solver) << ": Skipped (non-dynamic)");
@@ -184,12 +209,15 @@ struct SolverContainer
     {
         std::vector<std::pair<std::string, size_t>> res;
         const auto find_only = GetEnvFindOnlySolver();
+        const auto memo      = applicability::Memo{search_params};
         miopen::each_args(
             [&](auto solver) {
                 if(find_only.IsValid() && find_only != Id{SolverDbId(solver)})
                 { // Do nothing (and keep silence for the sake of Tuna), just skip.
                 }
-                else if(!solver.IsApplicable(search_params))
+                else if(!search_params.IsLayoutDefault() && !solver.IsLayoutAgnostic())
+                    MIOPEN_LOG_I2(SolverDbId(solver) << ": Skipped (layout)");
+                else if(!memo.IsApplicable(solver, search_params))
                     MIOPEN_LOG_I2(SolverDbId(solver) << ": Not applicable");
                 else if(search_params.use_dynamic_solutions_only && !solver.IsDynamic())
                     MIOPEN_LOG_I2(SolverDbId(solver) << ": Skipped (non-dynamic)");
@@ -30,9 +30,11 @@
 #include <miopen/miopen.h>
 #include <miopen/tensor.hpp>
 #include <miopen/convolution.hpp>
+#include <miopen/pooling.hpp>
 #include <miopen/solver.hpp>
 #include <miopen/op_kernel_args.hpp>
 #include <miopen/fusion_ops.hpp>
+#include <boost/optional.hpp>
 
 #include <set>
 #include <vector>
@@ -53,9 +55,15 @@ struct OperatorArgs : miopenOperatorArgs
 {
     OperatorArgs();
     void ins_arg(std::string name, OpKernelArg v);
+    /// The arguments are also indexed by a process-wide number of their key, so the plans look
+    /// them up at execution without building or hashing strings.
+    static std::size_t GetKeyIndex(const std::string& key);
+    static std::string GetKey(std::size_t key_index);
+    const OpKernelArg& Get(std::size_t key_index) const;
     friend std::ostream& operator<<(std::ostream& stream, const OperatorArgs& x);
     std::vector<OpKernelArg> args_vec;
     std::unordered_map<std::string, OpKernelArg> args_map;
+    std::vector<boost::optional<OpKernelArg>> args_by_index;
 };
 
 struct FusionOpDescriptor : miopenFusionOpDescriptor
@@ -108,6 +116,57 @@ struct BiasFusionOpDescriptor : FusionOpDescriptor
     TensorDescriptor base_desc;
 };
 
+// Adds a skip connection of the input's shape to the output of a training batch norm, ahead of the
+// activation that follows it.
+struct ResidualAddFwdFusionOpDescriptor : FusionOpDescriptor
+{
+    miopenStatus_t GetOutputDesc(TensorDescriptor& output_desc) override;
+    miopenStatus_t GetNetworkConfig(std::string& network_config, Handle& handle) override;
+    miopenStatus_t GetCompileParms(std::string& compile_config,
+                                   Handle& handle,
+                                   FusionKernelSourceType source,
+                                   const std::vector<solver::AnySolver>& solvers) override;
+    miopenStatus_t
+    SetArgs(OperatorArgs& args, const void* alpha, const void* beta, ConstData_t residual);
+    std::vector<std::pair<std::string, OpKernelArg>> GetArgs() const override;
+    std::string GetArgKey(const std::string& k) const override;
+    OpKernelArg GetOpAttr(const std::string& k) const override;
+    miopenFusionOp_t kind() const override { return miopenFusionOpResidualAddForward; };
+};
+
+struct ResidualAddBwdFusionOpDescriptor : FusionOpDescriptor
+{
+    miopenStatus_t GetOutputDesc(TensorDescriptor& output_desc) override;
+    miopenStatus_t GetNetworkConfig(std::string& network_config, Handle& handle) override;
+    miopenStatus_t GetCompileParms(std::string& compile_config,
+                                   Handle& handle,
+                                   FusionKernelSourceType source,
+                                   const std::vector<solver::AnySolver>& solvers) override;
+    miopenStatus_t SetArgs(OperatorArgs& args,
+                           const void* alpha,
+                           const void* beta,
+                           ConstData_t residual,
+                           Data_t residualDiff);
+    std::vector<std::pair<std::string, OpKernelArg>> GetArgs() const override;
+    std::string GetArgKey(const std::string& k) const override;
+    OpKernelArg GetOpAttr(const std::string& k) const override;
+    miopenFusionOp_t kind() const override { return miopenFusionOpResidualAddBackward; };
+};
+
+// Pools the output of the ops before it, so only the pooled tensor is written. It has no
+// arguments, the output of the plan is the pooled tensor.
+struct PoolingFwdFusionOpDescriptor : FusionOpDescriptor
+{
+    PoolingFwdFusionOpDescriptor(const PoolingDescriptor& desc) : base_desc(desc){};
+    miopenStatus_t GetOutputDesc(TensorDescriptor& output_desc) override;
+    miopenStatus_t GetNetworkConfig(std::string& network_config, Handle& handle) override;
+    std::vector<std::pair<std::string, OpKernelArg>> GetArgs() const override;
+    std::string GetArgKey(const std::string& k) const override;
+    OpKernelArg GetOpAttr(const std::string& k) const override;
+    miopenFusionOp_t kind() const override { return miopenFusionOpPoolingForward; };
+    PoolingDescriptor base_desc;
+};
+
 struct ActivFwdFusionOpDescriptor : FusionOpDescriptor
 {
     ActivFwdFusionOpDescriptor(miopenActivationMode_t mode) : activMode(mode){};
@@ -37,13 +37,16 @@ namespace miopen {
 // Supported operators
 enum miopenFusionOp_t
 {
-    miopenFusionOpConvForward        = 0,
-    miopenFusionOpActivForward       = 1,
-    miopenFusionOpBatchNormInference = 2,
-    miopenFusionOpBiasForward        = 3,
-    miopenFusionOpBatchNormFwdTrain  = 4,
-    miopenFusionOpBatchNormBwdTrain  = 5,
-    miopenFusionOpActivBackward      = 6,
+    miopenFusionOpConvForward         = 0,
+    miopenFusionOpActivForward        = 1,
+    miopenFusionOpBatchNormInference  = 2,
+    miopenFusionOpBiasForward         = 3,
+    miopenFusionOpBatchNormFwdTrain   = 4,
+    miopenFusionOpBatchNormBwdTrain   = 5,
+    miopenFusionOpActivBackward       = 6,
+    miopenFusionOpResidualAddForward  = 7,
+    miopenFusionOpResidualAddBackward = 8,
+    miopenFusionOpPoolingForward      = 9,
 };
 
 enum MDGraph_op_t
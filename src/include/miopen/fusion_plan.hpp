@@ -6,6 +6,9 @@
 #include <miopen/tensor.hpp>
 #include <miopen/fusion.hpp>
 #include <miopen/md_graph.hpp>
+#include <miopen/kernel.hpp>
+
+#include <boost/optional.hpp>
 
 namespace miopen {
 
@@ -25,6 +28,8 @@ struct Exec_arg_t
     Exec_Arg_Type_t type;
     int size;
     OpKernelArg val;
+    /// OperatorArgs::GetKeyIndex() of the key, for the Scalar and Pointer arguments.
+    std::size_t key_index = 0;
     Exec_arg_t(std::string k, Exec_Arg_Type_t t, int s)
         : key(std::move(k)), type(t), size(s), val(OpKernelArg(0))
     {
@@ -45,7 +50,7 @@ struct FusionPlanDescriptor : miopenFusionPlanDescriptor
     TensorDescriptor DeriveOutputDescriptor();
     miopenStatus_t
     GetWorkspaceSizeImmed(Handle& handle, size_t& workSpaceSize, miopenConvFwdAlgorithm_t algo);
-    miopenStatus_t Execute(const Handle& handle,
+    miopenStatus_t Execute(Handle& handle,
                            const TensorDescriptor& inputDesc,
                            ConstData_t input,
                            const TensorDescriptor& outputDesc,
@@ -68,10 +73,38 @@ struct FusionPlanDescriptor : miopenFusionPlanDescriptor
     auto GetLocalWGSz();
     auto GetGlobalWGSz();
     std::vector<Exec_arg_t> CalcArgOrder(const Handle& handle);
+    /// Resolves the keys of arg_list and lays the arguments out in arg_block, so Execute()
+    /// only copies the user arguments in by index.
+    void PrepareArgs();
+    void ExecuteUnpacked(const KernelInvoke& kernel,
+                         ConstData_t input,
+                         Data_t output,
+                         const OperatorArgs& op_args) const;
     bool GetEnumVal(const std::string& sym, int& val) const;
     OpKernelArg GetDevAttribute(const std::string& k, const Handle& handle) const;
     OpKernelArg GetTensorAttr(const std::string& sym) const;
     bool GetTensorAttr(const std::string& sym, int& val) const;
+    /// What the compiled state of the plan depends on: the device, the input, the convolution
+    /// algorithm and the kind and the attributes of every op.
+    std::string GetSignature(Handle& handle) const;
+    miopenStatus_t CompileUncached(Handle& handle);
+
+    /// The generic backend, for the plans none of the fused kernels can run: a forward
+    /// convolution followed by any chain of bias, activation, inference batch norm and residual
+    /// add ops, optionally closed by a pooling. The convolution runs with the solver it would use
+    /// alone, then one kernel generated for the chain applies all the other ops in place in a
+    /// single pass, or pools the result of the chain from a scratch buffer into the output.
+    bool IsEpiloguePlan() const;
+    /// The xdlops and dynamic implicit GEMMs have no fused kernels, so a plan the fused kernels
+    /// can run still goes to the epilogue when an implicit GEMM is its fastest convolution.
+    bool PrefersImplicitGemmEpilogue(Handle& handle) const;
+    /// The output of the convolution, with a closing pooling the input of the pooling.
+    TensorDescriptor GetEpilogueConvOutputDesc() const;
+    miopenStatus_t CompileEpilogue(Handle& handle);
+    void ExecuteEpilogue(Handle& handle,
+                         ConstData_t input,
+                         Data_t output,
+                         const OperatorArgs& op_args) const;
 
     private:
     miopenFusionDirection_t fusion_dir;
@@ -90,6 +123,11 @@ struct FusionPlanDescriptor : miopenFusionPlanDescriptor
     std::string network_config;
     miopenDataType_t data_type;
     std::vector<Exec_arg_t> arg_list;
+    OpKernelArgsBlock arg_block;
+    std::vector<std::size_t> epilogue_args;
+    bool is_epilogue = false;
+    boost::optional<miopenConvFwdAlgorithm_t> epilogue_algo;
+    solver::Id epilogue_solver;
 };
 
 } // namespace miopen
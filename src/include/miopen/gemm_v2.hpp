@@ -29,6 +29,8 @@
 #include <miopen/common.hpp>
 #include <miopen/miopen.h>
 
+#include <vector>
+
 namespace miopen {
 
 struct Handle;
@@ -127,6 +129,27 @@ CallGemmStridedBatchedSequential(const Handle& handle,
                                  bool enqueue_dummy_kernel,
                                  GemmBackend_t gemm_backend = GemmBackend_t::rocblas);
 
+// One GEMM of a grouped GEMM, with its own buffers and offsets.
+struct GemmGroupProblem
+{
+    GemmDescriptor gemm_desc;
+    ConstData_t A;
+    int a_offset;
+    ConstData_t B;
+    int b_offset;
+    Data_t C;
+    int c_offset;
+};
+
+// Runs a list of independent GEMMs of several sizes. The problems differing only in their
+// offsets are merged into strided batched launches where those are evenly spaced, so a group
+// takes one launch per distinct size in the common cases. The problems may run in any order:
+// a problem must not read the C of another one, several of them may accumulate (beta = 1) into
+// the same C. With profiling enabled the kernel time is the one of the whole group.
+miopenStatus_t CallGemmGrouped(const Handle& handle,
+                               const std::vector<GemmGroupProblem>& problems,
+                               GemmBackend_t gemm_backend = GemmBackend_t::rocblas);
+
 // GEMM parameters for Convolution (using Im2Col) Fwd
 // y = w * Im2Col(x)
 GemmDescriptor CreateGemmDescriptorConvFwd(const TensorDescriptor& wDesc,
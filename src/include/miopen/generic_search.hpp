@@ -29,8 +29,14 @@
 
 #include <miopen/config.h>
 #include <miopen/logger.hpp>
+#include <miopen/gpu_sensors.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/invoke_params.hpp>
+#include <miopen/search_checkpoint.hpp>
+#include <miopen/search_dump.hpp>
+#include <miopen/search_shard.hpp>
+#include <miopen/measurement_policy.hpp>
+#include <miopen/env.hpp>
 
 #include <vector>
 #include <cstdlib>
@@ -38,6 +44,8 @@
 #include <iterator>
 #include <chrono>
 #include <cassert>
+#include <sstream>
+#include <future>
 
 #include <miopen/conv/context.hpp>
 #include <miopen/conv_solution.hpp>
@@ -45,6 +53,8 @@
 #include <miopen/handle.hpp>
 #include <miopen/timer.hpp>
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_SEARCH_COMPILE_AHEAD)
+
 namespace miopen {
 namespace solver {
 
@@ -335,26 +345,154 @@ auto GenericSearch(const Solver s, const Context& context, const AnyInvokeParams
                                << (useSpare ? " (spare)" : "")
                                << "...");
 
-    bool is_passed   = false; // left false only if all iterations failed.
-    float best_time  = std::numeric_limits<float>::max();
-    size_t n_failed  = 0;
-    size_t n_current = 0;
-    size_t n_best    = 0;
+    const auto shard       = SearchShard::FromEnv();
+    const auto problem_key = [&]() {
+        std::ostringstream ss;
+        context.Serialize(ss);
+        return ss.str();
+    }();
+    if(shard.IsEnabled())
+    {
+        MIOPEN_LOG_I("Search shard " << shard.Index() << " of " << shard.Count());
+        shard.Reset(problem_key, SolverDbId(s));
+    }
+    SearchDump dump{
+        SolverDbId(s), problem_key, shard.IsEnabled() ? static_cast<int>(shard.Index()) : -1};
+
+    const auto policy  = MeasurementPolicy::FromEnv();
+    const auto sensors = GpuSensors::FromHandle(profile_h);
+    TuningConditions conditions;
+
+    SearchCheckpoint checkpoint{
+        SolverDbId(s), problem_key, shard.IsEnabled() ? static_cast<int>(shard.Index()) : -1};
+    auto progress = SearchProgress{};
+    if(const auto saved = checkpoint.Load(n_runs_total))
+    {
+        progress = *saved;
+        MIOPEN_LOG_W("Resuming the search from #" << progress.next << ", best #"
+                                                  << progress.best_index
+                                                  << ' '
+                                                  << progress.best_time);
+        if(!progress.best_config.empty() && !best_config.Deserialize(progress.best_config))
+            progress = SearchProgress{};
+    }
+    progress.total = n_runs_total;
+
+    // Kernels of the next window of configs are built on host threads
+    // while the current window is being measured.
+    const std::size_t compile_ahead = Value(MIOPEN_DEBUG_SEARCH_COMPILE_AHEAD{}, 16);
+    auto lookahead                  = all_configs.begin();
+    std::size_t n_lookahead         = 0;
+    std::vector<KernelInfo> compiling_kernels;
+    std::future<std::vector<boost::optional<Program>>> compiling;
+
+    const auto compile_next_window = [&]() {
+        std::vector<ConvSolution> window;
+        for(std::size_t i = 0; i < compile_ahead && lookahead != all_configs.end();
+            ++lookahead, ++n_lookahead)
+        {
+            if(!shard.Owns(n_lookahead))
+                continue;
+            ++i;
+            try
+            {
+                window.push_back(s.GetSolution(context, *lookahead, true));
+            }
+            catch(...)
+            {
+                // Will fail again and be reported in the main loop.
+            }
+        }
+        compiling_kernels = GetUncompiledKernels(profile_h, window);
+        if(compiling_kernels.empty())
+            return;
+        compiling = std::async(std::launch::async, [&profile_h, kernels = compiling_kernels]() {
+            return TryPrecompileKernels(profile_h, kernels);
+        });
+    };
+
+    const auto add_compiled_window = [&]() {
+        if(!compiling.valid())
+            return;
+        const auto programs = compiling.get();
+        for(std::size_t i = 0; i < programs.size(); ++i)
+        {
+            const KernelInfo& k = compiling_kernels[i];
+            if(programs[i] && !profile_h.HasProgram(k.kernel_file, k.comp_options))
+                profile_h.AddProgram(*programs[i], k.kernel_file, k.comp_options);
+        }
+    };
+
+    for(; n_lookahead < progress.next && lookahead != all_configs.end(); ++lookahead)
+        ++n_lookahead;
+
+    if(compile_ahead > 0)
+    {
+        compile_next_window();
+        add_compiled_window();
+        compile_next_window();
+    }
+
+    bool is_passed    = !progress.best_config.empty(); // left false only if all iterations failed.
+    float best_time   = progress.best_time;
+    size_t n_failed   = progress.failed.size();
+    size_t n_current  = 0;
+    size_t n_best     = progress.best_index;
+    size_t n_measured = 0;
+    // Kept to measure the best config again when the clock drifts. A search resumed from a
+    // checkpoint has no invoker of the best config until a better one is found.
+    Invoker best_invoker;
+    std::size_t best_batch = 1;
+    GpuConditions best_conditions;
     HeartBeat<PerformanceConfig> heartbeat;
+
+    // A sample of a short kernel is the mean of several runs between one pair of events.
+    const auto measure_invoker = [&](const Invoker& inv, std::size_t n) {
+        if(n == 1)
+        {
+            profile_h.ProfileLaunches([&]() { inv(profile_h, invoke_ctx); });
+            return profile_h.GetKernelTime();
+        }
+        profile_h.ProfileBatch([&]() {
+            for(std::size_t i = 0; i < n; ++i)
+                inv(profile_h, invoke_ctx);
+        });
+        return profile_h.GetKernelTime() / n;
+    };
     heartbeat.Start();
 
     for(const auto& current_config : all_configs)
     {
+        if(n_current < progress.next || !shard.Owns(n_current))
+        {
+            ++n_current;
+            continue;
+        }
+
+        if(compile_ahead > 0 && n_measured > 0 && n_measured % compile_ahead == 0)
+        {
+            add_compiled_window();
+            compile_next_window();
+        }
+        ++n_measured;
+
         float elapsed_time = 0.0f;
+        float compile_time = 0.0f;
+        size_t n_runs      = 0;
         int ret            = 0;
         MIOPEN_LOG_I2('#' << n_current << '/' << n_failed << '/' << n_runs_total << ' '
                           << current_config);
 
         ConvSolution current_solution;
         Invoker invoker;
+        std::size_t batch = 1;
+        GpuConditions current_conditions;
+        const auto measure = [&]() { return measure_invoker(invoker, batch); };
 
         try
         {
+            Timer compile_timer;
+            compile_timer.start();
             current_solution = s.GetSolution(context, current_config, true);
 
             if(default_solution.workspce_sz != current_solution.workspce_sz)
@@ -369,14 +507,60 @@ auto GenericSearch(const Solver s, const Context& context, const AnyInvokeParams
 
             invoker = profile_h.PrepareInvoker(*current_solution.invoker_factory,
                                                current_solution.construction_params);
-            invoker(profile_h, invoke_ctx);
+            compile_time = compile_timer.elapsed_ms();
+            // The times of the warm-up runs are not used, so they do not wait for each launch.
+            if(policy.warmup_runs > 0)
+            {
+                profile_h.ProfileBatch([&]() {
+                    for(std::size_t i = 0; i < policy.warmup_runs; ++i)
+                        invoker(profile_h, invoke_ctx);
+                });
+            }
+            profile_h.ProfileLaunches([&]() { invoker(profile_h, invoke_ctx); });
             elapsed_time = profile_h.GetKernelTime();
+            n_runs       = 1;
+
+            batch = policy.GetBatchSize(elapsed_time);
+            if(batch > 1)
+            {
+                MIOPEN_LOG_I2("Timing " << batch << " runs together: " << elapsed_time);
+                elapsed_time = measure();
+            }
+            current_conditions = sensors.Read();
+            conditions.Add(current_conditions);
         }
         catch(...)
         {
             ret = 1;
         }
 
+        // Throttling makes every later config look slower than the best one, and a boost
+        // makes them look faster, so the best one is timed again at the current clock.
+        if(ret == 0 && best_invoker &&
+           policy.IsClockDrifted(best_conditions, current_conditions))
+        {
+            try
+            {
+                RunningStats stats;
+                do
+                    stats.Add(measure_invoker(best_invoker, best_batch));
+                while(policy.NeedsMoreRuns(stats));
+                MIOPEN_LOG_I("Clock drifted from " << best_conditions.sclk_mhz << " to "
+                                                   << current_conditions.sclk_mhz
+                                                   << " MHz, best time "
+                                                   << best_time
+                                                   << " -> "
+                                                   << stats.Mean());
+                best_time       = stats.Mean();
+                best_conditions = current_conditions;
+                ++conditions.remeasured;
+            }
+            catch(...)
+            {
+                MIOPEN_LOG_W("Unable to measure the best config again: #" << n_best);
+            }
+        }
+
         MIOPEN_LOG_T("##"
                      << "(n_current, n_failed, n_runs_total):  "
                      << n_current
@@ -388,27 +572,28 @@ auto GenericSearch(const Solver s, const Context& context, const AnyInvokeParams
                      << elapsed_time
                      << ", best_time: "
                      << best_time
+                     << ", sclk: "
+                     << current_conditions.sclk_mhz
                      << ", "
                      << current_config);
 
         if(ret == 0)
         {
             // Smooth the jitter of measurements:
-            // If the 1st probe is NOT too bad (measured time <= 1.05 * best known time),
-            // then re-run it 4 times more and compute average time,
-            // and decide using average of all 5 attempts vs. the best.
-            if(elapsed_time / best_time < 1.05f)
+            // If the 1st probe is NOT too bad (not pruned by the policy),
+            // then re-run it until the policy is satisfied with the samples,
+            // and decide using average of all attempts vs. the best.
+            if(!policy.IsPruned(elapsed_time, best_time))
             {
                 MIOPEN_LOG_I2("Finding average for: " << elapsed_time << " / " << best_time << " = "
                                                       << (elapsed_time / best_time));
 
+                RunningStats stats;
+                stats.Add(elapsed_time);
                 try
                 {
-                    for(int i = 0; i < 4; ++i)
-                    {
-                        invoker(profile_h, invoke_ctx);
-                        elapsed_time += profile_h.GetKernelTime();
-                    }
+                    while(policy.NeedsMoreRuns(stats))
+                        stats.Add(measure());
                 }
                 catch(...)
                 {
@@ -417,8 +602,12 @@ auto GenericSearch(const Solver s, const Context& context, const AnyInvokeParams
 
                 if(ret == 0)
                 {
-                    is_passed = true;
-                    elapsed_time /= 5;
+                    is_passed    = true;
+                    elapsed_time = stats.Mean();
+                    n_runs       = stats.Count();
+                    MIOPEN_LOG_I2("Average of " << stats.Count() << " runs: " << elapsed_time
+                                                << ", relative error: "
+                                                << stats.RelativeError());
                     if(elapsed_time < best_time)
                     {
                         MIOPEN_LOG_I('#' << n_current << '/' << n_failed << '/' << n_runs_total
@@ -428,9 +617,12 @@ auto GenericSearch(const Solver s, const Context& context, const AnyInvokeParams
                                          << best_time
                                          << ' '
                                          << current_config);
-                        best_config = current_config;
-                        best_time   = elapsed_time;
-                        n_best      = n_current;
+                        best_config     = current_config;
+                        best_time       = elapsed_time;
+                        n_best          = n_current;
+                        best_invoker    = invoker;
+                        best_batch      = batch;
+                        best_conditions = current_conditions;
                     }
                     else
                     {
@@ -450,8 +642,31 @@ auto GenericSearch(const Solver s, const Context& context, const AnyInvokeParams
         }
         heartbeat.Monitor(
             ret != 0, elapsed_time, n_current, best_time, n_failed, n_runs_total, current_config);
+        if(dump.IsEnabled())
+        {
+            std::ostringstream ss;
+            current_config.Serialize(ss);
+            dump.Add(n_current, ss.str(), elapsed_time, n_runs, ret != 0, compile_time);
+        }
         ++n_current;
+
+        if(checkpoint.IsEnabled())
+        {
+            progress.next = n_current;
+            if(ret != 0)
+                progress.failed.push_back(n_current - 1);
+            if(is_passed)
+            {
+                std::ostringstream ss;
+                best_config.Serialize(ss);
+                progress.best_config = ss.str();
+                progress.best_time   = best_time;
+                progress.best_index  = n_best;
+            }
+            checkpoint.Update(progress);
+        }
     }
+    checkpoint.Remove();
 
     MIOPEN_LOG_W("Done: " << n_runs_total << '/' << n_failed << '/' << n_runs_total << ", best #"
                           << n_best
@@ -459,13 +674,45 @@ auto GenericSearch(const Solver s, const Context& context, const AnyInvokeParams
                           << best_time
                           << ' '
                           << best_config);
+
+    if(sensors.IsEnabled())
+    {
+        MIOPEN_LOG_I("Shader clock " << conditions.min_sclk_mhz << ".." << conditions.max_sclk_mhz
+                                     << " MHz, best measured at "
+                                     << best_conditions.sclk_mhz
+                                     << " MHz, "
+                                     << conditions.remeasured
+                                     << " re-measurements of the best");
+        // A shard does not know which of the searches provides the merged best config.
+        if(!shard.IsEnabled())
+        {
+            conditions.SetBest(best_conditions);
+            conditions.Store(problem_key, SolverDbId(s));
+        }
+    }
+
+    if(shard.IsEnabled())
+    {
+        std::ostringstream ss;
+        best_config.Serialize(ss);
+        const auto merged = shard.Merge(problem_key,
+                                        SolverDbId(s),
+                                        is_passed ? boost::make_optional(ss.str()) : boost::none,
+                                        best_time);
+        PerformanceConfig merged_config;
+        is_passed = merged && merged_config.Deserialize(*merged) &&
+                    s.IsValidPerformanceConfig(context, merged_config);
+        if(is_passed)
+            best_config = merged_config;
+    }
+
     if(!is_passed)
         MIOPEN_THROW("Search failed");
     // Run once with the default config and show score.
 
     const auto& invoker = profile_h.PrepareInvoker(*default_solution.invoker_factory,
                                                    default_solution.construction_params);
-    invoker(profile_h, invoke_ctx);
+    profile_h.ProfileLaunches([&]() { invoker(profile_h, invoke_ctx); });
     const auto default_time = profile_h.GetKernelTime();
     const auto score        = (best_time > 0.0f) ? default_time / best_time : 0.0f;
     MIOPEN_LOG_W("...Score: " << score << " (default time " << default_time << ')');
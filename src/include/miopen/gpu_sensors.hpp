@@ -0,0 +1,95 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_GPU_SENSORS_HPP_
+#define GUARD_MIOPEN_GPU_SENSORS_HPP_
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+namespace miopen {
+
+struct Handle;
+
+/// State of the GPU at the time of a measurement, 0 if unknown.
+struct GpuConditions
+{
+    int sclk_mhz       = 0;
+    int temperature_mc = 0; // Millidegrees Celsius.
+
+    bool IsKnown() const { return sclk_mhz > 0; }
+};
+
+/// Reads the shader clock and the temperature of a device from the files the amdgpu driver
+/// exposes in sysfs, the same ones rocm-smi reports. Disabled if MIOPEN_DEBUG_GPU_SENSORS=0
+/// or when the files are not there, then Read() returns unknown conditions.
+class GpuSensors
+{
+    public:
+    GpuSensors() = default;
+    /// device_dir is the sysfs directory of the PCI device, e.g. /sys/bus/pci/devices/<id>.
+    explicit GpuSensors(const std::string& device_dir);
+
+    static GpuSensors FromHandle(const Handle& handle);
+
+    bool IsEnabled() const { return !sclk_path.empty(); }
+    GpuConditions Read() const;
+
+    private:
+    std::string sclk_path;
+    std::string temperature_path;
+};
+
+/// Returns the clock of the current level (marked with '*') from the contents of pp_dpm_sclk,
+/// 0 if there is none.
+int ParseCurrentSclk(const std::string& pp_dpm_sclk);
+
+/// Conditions of the measurements that picked a db entry. They are kept in
+/// tuning_conditions.txt in the user db directory under the key and id of the entry, as the
+/// perf-db and find-db records have no room for them.
+struct TuningConditions
+{
+    int best_sclk_mhz       = 0;
+    int best_temperature_mc = 0;
+    int min_sclk_mhz        = 0;
+    int max_sclk_mhz        = 0;
+    int max_temperature_mc  = 0;
+    std::size_t remeasured  = 0; // Times the best was timed again after the clock drifted.
+
+    /// Accounts for one measurement.
+    void Add(const GpuConditions& conditions);
+    void SetBest(const GpuConditions& conditions);
+    bool IsKnown() const { return max_sclk_mhz > 0; }
+
+    void Serialize(std::ostream& stream) const;
+    bool Deserialize(const std::string& str);
+
+    void Store(const std::string& key, const std::string& id) const;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_GPU_SENSORS_HPP_
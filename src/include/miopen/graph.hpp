@@ -0,0 +1,160 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_GRAPH_HPP_
+#define GUARD_MIOPEN_GRAPH_HPP_
+
+#include <miopen/activ.hpp>
+#include <miopen/allocator.hpp>
+#include <miopen/common.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/manage_ptr.hpp>
+#include <miopen/miopen.h>
+#include <miopen/object.hpp>
+#include <miopen/pooling.hpp>
+#include <miopen/tensor.hpp>
+
+#include <boost/optional.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+
+/// Sequence of layers recorded once and executed with a single call, see miopenCreateGraph.
+///
+/// Tensors are numbered in the order they are added. The external ones are bound to buffers of
+/// the application at every run, the internal ones only pass data between the nodes and live in
+/// device memory of the graph. Nodes run in the order they are added, so a node may only read
+/// the tensors written by the nodes before it or external ones.
+///
+/// Compile() groups the chains a fusion plan supports (convolution, bias, activation, pooling;
+/// batch norm inference, activation) into single kernels, binds the other convolutions to
+/// ConvolutionPlans and lays the internal tensors out in one allocation, where the ones which
+/// are never alive at the same time share memory.
+struct Graph : miopenGraph
+{
+    int AddTensor(const TensorDescriptor& desc, bool external);
+
+    void AddConvolutionForward(const ConvolutionDescriptor& conv, int x, int w, int y);
+    void AddActivationForward(const ActivationDescriptor& activ, int x, int y);
+    /// scale, bias, mean and variance share the descriptor of scale.
+    void AddBatchNormInference(miopenBatchNormMode_t mode,
+                               double epsilon,
+                               int x,
+                               int scale,
+                               int bias,
+                               int mean,
+                               int variance,
+                               int y);
+    void AddPoolingForward(const PoolingDescriptor& pooling, int x, int y);
+    /// c = a op b
+    void AddOpTensor(miopenTensorOp_t op, int a, int b, int c);
+
+    /// Adding any tensors or nodes afterwards requires compiling again.
+    void Compile(Handle& handle);
+    bool IsCompiled() const { return compiled; }
+
+    /// Device memory held by the compiled graph for the internal tensors and the workspace.
+    std::size_t GetDeviceMemorySize() const;
+    /// Launch groups of the compiled graph, a fused chain counts as one.
+    std::size_t GetStepCount() const { return steps.size(); }
+
+    /// Every external tensor used by the nodes shall be bound.
+    void Run(Handle& handle, const std::vector<std::pair<int, Data_t>>& bindings) const;
+
+    friend std::ostream& operator<<(std::ostream& stream, const Graph& graph);
+
+    private:
+    enum class Kind
+    {
+        Convolution,
+        Activation,
+        BatchNormInference,
+        Pooling,
+        OpTensor,
+    };
+
+    struct Tensor
+    {
+        TensorDescriptor desc;
+        bool external;
+    };
+
+    struct Node
+    {
+        Node(Kind kind_, std::vector<int> inputs_, int output_)
+            : kind(kind_), inputs(std::move(inputs_)), output(output_)
+        {
+        }
+
+        Kind kind;
+        std::vector<int> inputs;
+        int output;
+        boost::optional<ConvolutionDescriptor> conv;
+        boost::optional<ActivationDescriptor> activ;
+        boost::optional<PoolingDescriptor> pooling;
+        miopenBatchNormMode_t bn_mode = miopenBNSpatial;
+        double epsilon                = 0.;
+        miopenTensorOp_t tensor_op    = miopenTensorOpAdd;
+    };
+
+    using Buffers = std::vector<Data_t>;
+    using Step    = std::function<void(Handle&, const Buffers&)>;
+
+    void AddNode(Node node);
+    const Tensor& GetTensor(int id) const;
+    /// Nodes from first which a fusion plan runs as one kernel, 0 if none.
+    std::size_t GetFusableLength(std::size_t first) const;
+    bool TryFuse(Handle& handle, std::size_t first, std::size_t length);
+    void AddStep(Handle& handle, std::size_t node);
+    void PlanMemory(Handle& handle);
+
+    std::vector<Tensor> tensors;
+    std::vector<Node> nodes;
+
+    bool compiled = false;
+    std::vector<Step> steps;
+    // Nodes of every step, for the lifetimes of the internal tensors.
+    std::vector<std::pair<std::size_t, std::size_t>> step_nodes;
+    std::size_t workspace_size = 0;
+    std::size_t arena_size     = 0;
+    Allocator::ManageDataPtr arena;
+    Allocator::ManageDataPtr workspace;
+    std::vector<shared<Data_t>> views;
+    // Buffers of the internal tensors, null for the external ones and the fused away ones.
+    Buffers internal;
+};
+
+} // namespace miopen
+MIOPEN_DEFINE_OBJECT(miopenGraph, miopen::Graph);
+
+#endif // GUARD_MIOPEN_GRAPH_HPP_
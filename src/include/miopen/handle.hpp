@@ -27,22 +27,31 @@
 #define GUARD_MIOPEN_CONTEXT_HPP_
 
 #include <miopen/config.h>
+#include <miopen/check_numerics.hpp>
+#include <miopen/conv/problem_key.hpp>
 #include <miopen/kernel_info.hpp>
 #include <miopen/common.hpp>
+#include <miopen/interned_string.hpp>
 #include <miopen/invoker_cache.hpp>
 #include <miopen/kernel.hpp>
 #include <miopen/miopen.h>
 #include <miopen/names.hpp>
 #include <miopen/object.hpp>
+#include <miopen/read_mostly_map.hpp>
 #include <miopen/allocator.hpp>
 #include <miopen/simple_hash.hpp>
 #include <miopen/solver_id.hpp>
+#include <miopen/thread_streams.hpp>
+#include <miopen/workspace_arena.hpp>
 
 #include <boost/range/adaptor/transformed.hpp>
 
 #include <cstdio>
 #include <cstring>
+#include <functional>
+#include <future>
 #include <ios>
+#include <limits>
 #include <sstream>
 #include <memory>
 #include <vector>
@@ -56,6 +65,10 @@
 namespace miopen {
 
 struct HandleImpl;
+class TransformedWeightsCache;
+namespace conv {
+class HotProblems;
+} // namespace conv
 #if MIOPEN_USE_MIOPENGEMM
 struct GemmGeometry;
 using GemmKey = std::pair<std::string, std::string>;
@@ -65,6 +78,13 @@ using GemmKey = std::pair<std::string, std::string>;
 using rocblas_handle_ptr = MIOPEN_MANAGE_PTR(rocblas_handle, rocblas_destroy_handle);
 #endif
 
+/// Marks the point reached by the work enqueued on a stream, see Handle::RecordEvent(). An empty
+/// event is reached from the start.
+struct StreamEvent
+{
+    std::shared_ptr<void> impl;
+};
+
 struct Handle : miopenHandle
 {
 
@@ -76,9 +96,19 @@ struct Handle : miopenHandle
     miopenAcceleratorQueue_t GetStream() const;
     void SetStream(miopenAcceleratorQueue_t streamID) const;
 
+    /// Makes GetStream() of the calling thread return the stream, until ResetThreadStream().
+    /// This lets several threads share the handle (and its caches) while each of them enqueues
+    /// on a stream of its own. The stream shall belong to the device (context) of the handle.
+    void SetThreadStream(miopenAcceleratorQueue_t stream) const { thread_streams::Set(id, stream); }
+    void ResetThreadStream() const { thread_streams::Clear(id); }
+    bool HasThreadStream() const { return thread_streams::Find(id) != nullptr; }
+
     void SetAllocator(miopenAllocatorFunction allocator,
                       miopenDeallocatorFunction deallocator,
                       void* allocatorContext) const;
+    void SetAllocatorEx(miopenAllocatorFunctionEx allocator,
+                        miopenDeallocatorFunction deallocator,
+                        void* allocatorContext) const;
 
     void EnableProfiling(bool enable = true) const;
 
@@ -86,8 +116,18 @@ struct Handle : miopenHandle
     void AccumKernelTime(float curr_time) const;
 
     float GetKernelTime() const;
+    /// False on the thread running ProfileBatch() of the handle.
     bool IsProfilingEnabled() const;
 
+    /// When profiling is enabled, measures all the launches between one pair of events instead
+    /// of synchronizing after each launch, and makes GetKernelTime() return the time from the
+    /// first launch to the end of the last one. Meant for invokers running several kernels,
+    /// and for warm-up runs. On OpenCL the launches are profiled one by one.
+    void ProfileBatch(const std::function<void()>& launches) const;
+    /// ProfileBatch() if MIOPEN_DEBUG_PROFILE_BATCH is enabled, otherwise just the launches.
+    /// Used to time the candidates of Find and of tuning.
+    void ProfileLaunches(const std::function<void()>& launches) const;
+
     KernelInvoke AddKernel(const std::string& algorithm,
                            const std::string& network_config,
                            const std::string& program_name,
@@ -103,14 +143,19 @@ struct Handle : miopenHandle
 
     void ClearKernels(const std::string& algorithm, const std::string& network_config) const;
 
-    auto GetKernels(const std::string& algorithm, const std::string& network_config) const
+    std::vector<KernelInvoke> GetKernels(const std::string& algorithm,
+                                         const std::string& network_config) const
     {
-        return this->GetKernelsImpl(algorithm, network_config) |
-               boost::adaptors::transformed([this](Kernel k) { return this->Run(k); });
+        const auto kernels = this->GetKernelsImpl(algorithm, network_config);
+        std::vector<KernelInvoke> result;
+        result.reserve(kernels.size());
+        for(const auto& k : kernels)
+            result.push_back(this->Run(k));
+        return result;
     }
     KernelInvoke GetKernel(const std::string& algorithm, const std::string& network_config) const
     {
-        auto ks = this->GetKernelsImpl(algorithm, network_config);
+        const auto ks = this->GetKernelsImpl(algorithm, network_config);
         if(ks.empty())
         {
             MIOPEN_THROW("looking for default kernel (does not exist): " + algorithm + ", " +
@@ -120,8 +165,9 @@ struct Handle : miopenHandle
     }
 
     KernelInvoke Run(Kernel k) const;
-    const std::vector<Kernel>& GetKernelsImpl(const std::string& algorithm,
-                                              const std::string& network_config) const;
+    /// Returns a copy, another thread may replace the cached kernels meanwhile.
+    std::vector<Kernel> GetKernelsImpl(const std::string& algorithm,
+                                       const std::string& network_config) const;
 
     Program LoadProgram(const std::string& program_name,
                         std::string params,
@@ -130,8 +176,88 @@ struct Handle : miopenHandle
 
     bool HasProgram(const std::string& program_name, const std::string& params) const;
 
+    /// Code object LoadProgram() would take from the binary cache, empty if it is not there.
+    std::string LoadCodeObject(const std::string& program_name,
+                               std::string params,
+                               bool is_kernel_str) const;
+    /// Stores the code object for LoadProgram() to find in the user binary cache.
+    void SaveCodeObject(const std::string& program_name,
+                        std::string params,
+                        bool is_kernel_str,
+                        const std::string& code_object) const;
+
     void AddProgram(Program prog, const std::string& program_name, const std::string& params) const;
 
+    /// Bounds the program cache of the handle, see KernelCache. 0 means no limit.
+    void SetProgramCacheLimits(std::size_t max_programs, std::size_t max_bytes) const;
+    miopenCacheFootprint_t GetCacheFootprint() const;
+    /// See KernelCache::GetGeneration().
+    std::size_t GetKernelCacheGeneration() const;
+
+    /// Find-db records of the network config have been validated against the kernel and
+    /// invoker caches of the handle, and no kernel has been dropped since.
+    bool IsFindDbRecordValidated(const std::string& network_config) const
+    {
+        const auto generation = validated_find_db_records.Find(network_config);
+        return generation != nullptr && *generation == GetKernelCacheGeneration();
+    }
+    /// The generation shall be taken before the validation starts.
+    void SetFindDbRecordValidated(const std::string& network_config, std::size_t generation) const
+    {
+        validated_find_db_records.InsertOrAssign(network_config, generation);
+    }
+
+    /// Serve workspace and internal scratch from a per-handle arena, see WorkspaceArena.
+    /// The arena is not used by the threads with a stream of their own, see SetThreadStream().
+    void EnableWorkspaceArena(bool enable = true) const
+    {
+        if(!enable)
+        {
+            this->Finish();
+            arena.Clear();
+        }
+        arena_enabled = enable;
+    }
+    bool IsWorkspaceArenaEnabled() const { return arena_enabled && !HasThreadStream(); }
+    Allocator::ManageDataPtr& GetArenaBuffer(WorkspaceArena::Slot slot, std::size_t size) const
+    {
+        auto& buffer = arena.Get(*this, slot, size);
+        if(device_memory_limit != 0)
+            UpdateMemoryBudget();
+        return buffer;
+    }
+
+    /// Backward weights convolutions are reproducible run to run: the solvers which split their
+    /// reduction between blocks sum the partial results in a fixed order, or do not split it.
+    void EnableDeterministicMode(bool enable = true) const { deterministic = enable; }
+    bool IsDeterministicModeEnabled() const { return deterministic; }
+
+    miopenDeviceMemoryUsage_t GetDeviceMemoryUsage() const;
+    /// Soft limit on GetDeviceMemoryUsage().totalBytes, 0 means no limit. Code objects are
+    /// evicted to stay under it, the arena buffers are kept.
+    void SetDeviceMemoryLimit(std::size_t bytes) const
+    {
+        device_memory_limit = bytes;
+        UpdateMemoryBudget();
+    }
+    std::size_t GetDeviceMemoryLimit() const { return device_memory_limit; }
+    /// Workspace a solution may use without taking the handle over its device memory limit,
+    /// counting the code objects as evictable.
+    std::size_t GetWorkspaceBudget() const
+    {
+        if(device_memory_limit == 0)
+            return std::numeric_limits<std::size_t>::max();
+        const auto held = arena.GetBytes() - arena.GetBytes(WorkspaceArena::Slot::Workspace);
+        return device_memory_limit > held ? device_memory_limit - held : 0;
+    }
+
+    CheckNumericsState& GetCheckNumericsState() const { return check_numerics; }
+    /// Created on the first use, see MIOPEN_FIND_SPECIALIZE_TOP_N.
+    conv::HotProblems& GetHotProblems() const;
+    /// Created on the first use, see MIOPEN_CONV_FFT_CACHE_WEIGHTS and
+    /// MIOPEN_CONV_WINOGRAD_CACHE_WEIGHTS.
+    TransformedWeightsCache& GetTransformedWeightsCache() const;
+
     void Finish() const;
     void Flush() const;
 
@@ -145,23 +271,43 @@ struct Handle : miopenHandle
     std::size_t GetMaxMemoryAllocSize();
 
     std::string GetDeviceName() const;
+    /// PCI address of the device as named in sysfs, e.g. 0000:03:00.0, or empty if unknown.
+    std::string GetPciBusId() const;
     std::ostream& Print(std::ostream& os) const;
 
     void Copy(ConstData_t src, Data_t dest, std::size_t size) const;
 
-    Allocator::ManageDataPtr Create(std::size_t sz) const;
+    /// The hint is passed to an extended allocator, see miopenSetAllocatorEx().
+    Allocator::ManageDataPtr Create(std::size_t sz,
+                                    miopenAllocationHint_t hint = miopenAllocationPersistent) const;
     Allocator::ManageDataPtr&
     WriteTo(const void* data, Allocator::ManageDataPtr& ddata, std::size_t sz) const;
     void ReadTo(void* data, const Allocator::ManageDataPtr& ddata, std::size_t sz) const;
+    void ReadTo(void* data, ConstData_t ddata, std::size_t sz) const;
+    /// Enqueue the copies on GetStream() and return. The host memory shall stay valid, and
+    /// unchanged for WriteToAsync(), until the copy is done. The copies overlap the work of other
+    /// streams only from page-locked host memory.
+    void WriteToAsync(const void* data, Data_t ddata, std::size_t sz) const;
+    void ReadToAsync(void* data, ConstData_t ddata, std::size_t sz) const;
+
+    /// Marks the work enqueued on GetStream() so far.
+    StreamEvent RecordEvent() const;
+    /// Makes the work enqueued on GetStream() from now on wait for the event, which may have been
+    /// recorded on another handle of the same device and context.
+    void WaitFor(const StreamEvent& event) const;
+    /// A view of data at offset. Free on HIP, but a clCreateSubBuffer call with an aligned
+    /// origin on OpenCL, and the view keeps the whole parent buffer alive. Kernels and GEMMs
+    /// used in per-step loops take element offsets as arguments instead.
     shared<Data_t> CreateSubBuffer(Data_t data, std::size_t offset, std::size_t size);
 #if MIOPEN_BACKEND_HIP
     shared<ConstData_t> CreateSubBuffer(ConstData_t data, std::size_t offset, std::size_t size);
 #endif
 
     template <class T>
-    Allocator::ManageDataPtr Create(std::size_t sz)
+    Allocator::ManageDataPtr Create(std::size_t sz,
+                                    miopenAllocationHint_t hint = miopenAllocationPersistent)
     {
-        return this->Create(sz * sizeof(T));
+        return this->Create(sz * sizeof(T), hint);
     }
 
     template <class Container>
@@ -200,7 +346,6 @@ struct Handle : miopenHandle
     }
 
     std::unique_ptr<HandleImpl> impl;
-    std::unordered_map<std::string, std::vector<miopenConvSolution_t>> find_map;
 #if MIOPEN_USE_MIOPENGEMM
     std::unordered_map<GemmKey, std::unique_ptr<GemmGeometry>, SimpleHash> geo_map;
 #endif
@@ -208,19 +353,53 @@ struct Handle : miopenHandle
     Invoker PrepareInvoker(const InvokerFactory& factory,
                            const std::vector<solver::KernelInfo>& kernels) const;
 
+    /// Runs the invoker. If graph_key is not empty and the backend supports it, the launches are
+    /// captured into a graph the first time and the graph is replayed for the same key later.
+    /// The key shall identify the problem, the solver and all the buffers passed in params.
+    void RunInvoker(const Invoker& invoker,
+                    const AnyInvokeParams& params,
+                    const std::string& graph_key = "") const;
+
+    /// Runs count independent tasks, each of which enqueues its work on GetStream().
+    /// On HIP the tasks are spread round-robin over up to MIOPEN_CONCURRENT_STREAMS auxiliary
+    /// streams, which wait for the work already enqueued on GetStream(); GetStream() waits for
+    /// all of them before this returns. The other threads sharing the handle are not affected.
+    /// The tasks run one after another on GetStream() when profiling is enabled, while
+    /// capturing a graph, or on OpenCL.
+    void RunConcurrently(std::size_t count, const std::function<void(std::size_t)>& task) const;
+    /// The auxiliary streams have the priority of GetStream() unless this is set, see
+    /// miopenSetConcurrentStreamsPriority().
+    void SetConcurrentStreamsPriority(int priority) const;
+
+    /// Makes a handle on the device and context of this one which enqueues on a stream of its
+    /// own, for the work run on a background thread. Its kernels and invokers may be used with
+    /// this handle. On HIP the device of the calling thread is set to the one of this handle.
+    Handle CreateBackgroundHandle() const;
+
     void RegisterInvoker(const Invoker& invoker,
                          const NetworkConfig& config,
                          solver::Id solver,
                          const AlgorithmName& algo)
     {
-        invokers.Register({config, solver.ToString()}, invoker);
-        invokers.SetAsFound1_0(config, algo, solver.ToString());
+        const auto interned_config = InternedString{config.ToString()};
+        const auto interned_solver = InternedString{solver.ToString()};
+        invokers.Register({interned_config, interned_solver}, invoker);
+        invokers.SetAsFound1_0(interned_config, InternedString{algo.ToString()}, interned_solver);
     }
 
     boost::optional<const Invoker&>
     GetInvoker(const NetworkConfig& config,
                const boost::optional<solver::Id>& solver,
                const boost::optional<AlgorithmName>& algo = boost::none) const
+    {
+        // Nothing could have been registered for strings which were never interned.
+        return GetInvoker(InternedString::TryGet(config.ToString()), solver, algo);
+    }
+
+    boost::optional<const Invoker&>
+    GetInvoker(const InternedString& config,
+               const boost::optional<solver::Id>& solver,
+               const boost::optional<AlgorithmName>& algo = boost::none) const
     {
         assert(solver || algo);
         assert(!(solver && algo));
@@ -228,23 +407,81 @@ struct Handle : miopenHandle
         {
             MIOPEN_LOG_I2("Returning an invoker for problem " << config.ToString() << " and solver "
                                                               << solver->ToString());
-            return invokers[std::make_pair(config.ToString(), solver->ToString())];
+            const auto interned_solver = InternedString::TryGet(solver->ToString());
+            if(config.IsEmpty() || interned_solver.IsEmpty())
+                return boost::none;
+            return invokers[{config, interned_solver}];
         }
         MIOPEN_LOG_I2("Returning an invoker for problem " << config.ToString() << " and algorithm "
                                                           << algo->ToString());
-        return invokers.GetFound1_0(config, *algo);
+        const auto interned_algo = InternedString::TryGet(algo->ToString());
+        if(config.IsEmpty() || interned_algo.IsEmpty())
+            return boost::none;
+        return invokers.GetFound1_0(config, interned_algo);
+    }
+
+    /// Returns the solver of the invoker GetInvoker(config, {}, algo) returns, invalid if none.
+    solver::Id GetFoundSolver(const InternedString& config, const AlgorithmName& algo) const
+    {
+        const auto interned_algo = InternedString::TryGet(algo.ToString());
+        if(config.IsEmpty() || interned_algo.IsEmpty())
+            return {};
+        const auto solver = invokers.GetFound1_0Id(config, interned_algo);
+        return solver.IsEmpty() ? solver::Id{} : solver::Id{solver.ToString()};
+    }
+
+    /// Returns the network config registered for the key, empty if there is none. This spares
+    /// the calls on a known problem building the config, see conv::ProblemKey.
+    InternedString GetProblemConfig(const conv::ProblemKey& key) const
+    {
+        if(!key.IsValid())
+            return {};
+        const auto config = problem_configs.Find(key);
+        return config != nullptr ? *config : InternedString{};
+    }
+
+    InternedString RegisterProblemConfig(const conv::ProblemKey& key,
+                                         const NetworkConfig& config) const
+    {
+        const auto interned_config = InternedString{config.ToString()};
+        if(key.IsValid())
+            problem_configs.Insert(key, interned_config);
+        return interned_config;
     }
 
 #if MIOPEN_USE_ROCBLAS
-    const rocblas_handle_ptr& rhandle() const { return rhandle_; }
+    /// The rocBLAS handle bound to GetStream() of the calling thread. It is shared with the other
+    /// handles which use the same stream. While the workspace arena is enabled, rocBLAS takes its
+    /// device memory from the arena.
+    const rocblas_handle_ptr& rhandle() const;
+#endif
 
     private:
-    rocblas_handle_ptr CreateRocblasHandle() const;
-    rocblas_handle_ptr rhandle_;
-#else
-    private:
-#endif
+    /// LoadProgram() without the deduplication of concurrent builds.
+    Program LoadProgramImpl(const std::string& program_name,
+                            const std::string& params,
+                            bool is_kernel_str,
+                            const std::string& kernel_src) const;
+    /// Leaves the code objects what the device memory limit spares of the arena.
+    void UpdateMemoryBudget() const;
+
+    // Identifies the handle for the thread streams.
+    const std::size_t id = thread_streams::NewHandleId();
     InvokerCache invokers;
+    // conv::ProblemKey -> network config
+    mutable ReadMostlyMap<conv::ProblemKey, InternedString, conv::ProblemKeyHash> problem_configs;
+    // network config -> kernel cache generation at the validation of its find-db records
+    mutable ReadMostlyMap<std::string, std::size_t> validated_find_db_records;
+    mutable WorkspaceArena arena;
+    mutable bool arena_enabled = WorkspaceArena::IsEnabledByDefault();
+    mutable std::size_t device_memory_limit = 0;
+    mutable bool deterministic              = false;
+    mutable CheckNumericsState check_numerics;
+    // Set by the handle which started the prefetch of the system dbs, see PrefetchSystemDbs().
+    std::future<void> db_prefetch;
+    mutable std::shared_ptr<TransformedWeightsCache> transformed_weights;
+    // Destroyed first, as it waits for the background builds using the handle.
+    mutable std::shared_ptr<conv::HotProblems> hot_problems;
 };
 
 inline std::ostream& operator<<(std::ostream& os, const Handle& handle) { return handle.Print(os); }
@@ -32,18 +32,29 @@
 #include <miopen/hipoc_program.hpp>
 #include <miopen/stringutils.hpp>
 #include <miopen/op_kernel_args.hpp>
+#include <memory>
+#include <mutex>
+#include <type_traits>
 #include <vector>
 #include <memory.h>
 
 namespace miopen {
 
-using HipEventPtr = MIOPEN_MANAGE_PTR(hipEvent_t, hipEventDestroy);
-inline HipEventPtr make_hip_event()
+/// Returns the event to the pool it was taken from by make_hip_event().
+struct HipEventDeleter
 {
-    hipEvent_t result = nullptr;
-    hipEventCreate(&result);
-    return HipEventPtr{result};
-}
+    unsigned flags = hipEventDefault;
+    int device     = 0;
+    void operator()(hipEvent_t event) const;
+};
+using HipEventPtr =
+    std::unique_ptr<typename std::remove_pointer<hipEvent_t>::type, HipEventDeleter>;
+
+/// Takes an event with the flags from a pool of the current device, creating it if there is
+/// none, as the creation of an event costs a call into the runtime. hipEventBlockingSync is
+/// added unless MIOPEN_DEBUG_HIP_BLOCKING_SYNC is disabled, so that hipEventSynchronize()
+/// blocks the calling thread instead of spinning on a host core.
+HipEventPtr make_hip_event(unsigned flags = hipEventDefault);
 
 #if 1
 
@@ -157,6 +168,12 @@ struct HIPOCKernelInvoke
         run(hip_args, sz_left);
     }
 
+    void operator()(const OpKernelArgsBlock& args) const
+    {
+        // The launch only reads the arguments.
+        run(const_cast<char*>(args.Data()), args.Size()); // NOLINT
+    }
+
     template <class... Ts>
     void operator()(Ts... xs) const
     {
@@ -176,7 +193,6 @@ struct HIPOCKernel
     std::array<size_t, 3> ldims = {};
     std::array<size_t, 3> gdims = {};
     std::string kernel_module;
-    hipFunction_t fun = nullptr;
 
     HIPOCKernel() {}
     HIPOCKernel(HIPOCProgram p,
@@ -193,15 +209,22 @@ struct HIPOCKernel
         std::copy(global_dims.begin(), global_dims.end(), gdims.begin());
 
         kernel_module = name;
-        auto status   = hipModuleGetFunction(&fun, program.GetModule(), kernel_module.c_str());
-        if(hipSuccess != status)
-            MIOPEN_THROW_HIP_STATUS(status,
-                                    "Failed to get function: " + kernel_module + " from " +
-                                        program.GetCodeObjectPathname().string());
     }
 
+    /// Loads the module and resolves the function on the first call.
     HIPOCKernelInvoke Invoke(hipStream_t stream,
                              std::function<void(hipEvent_t, hipEvent_t)> callback = nullptr) const;
+
+    private:
+    struct LazyFunction
+    {
+        std::once_flag resolved;
+        hipFunction_t fun = nullptr;
+    };
+    /// Shared by the copies of the kernel, so the function is resolved once.
+    std::shared_ptr<LazyFunction> function = std::make_shared<LazyFunction>();
+
+    hipFunction_t GetFunction() const;
 };
 
 } // namespace miopen
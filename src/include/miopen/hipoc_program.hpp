@@ -38,12 +38,14 @@ struct HIPOCProgramImpl;
 struct HIPOCProgram
 {
     HIPOCProgram();
-    /// This ctor builds the program from source, initializes module.
-    /// Also either CO pathname (typically if offline tools were used)
+    /// This ctor builds the program from source.
+    /// Either CO pathname (typically if offline tools were used)
     /// or binary blob (if comgr was used to build the program)
     /// is initialized. GetModule(), GetCodeObjectPathname(),
     /// GetCodeObjectBlob() return appropriate data after this ctor.
-    /// Other ctors only guarantee to initialize module.
+    /// Other ctors only guarantee that GetModule() succeeds.
+    /// None of the ctors load the code object to the device;
+    /// that is deferred to the first GetModule() call.
     HIPOCProgram(const std::string& program_name,
                  std::string params,
                  bool is_kernel_str,
@@ -52,6 +54,7 @@ struct HIPOCProgram
     HIPOCProgram(const std::string& program_name, const boost::filesystem::path& hsaco);
     HIPOCProgram(const std::string& program_name, const std::string& hsaco);
     std::shared_ptr<const HIPOCProgramImpl> impl;
+    /// Loads the code object on the first call. Thread-safe.
     hipModule_t GetModule() const;
     /// \return Pathname of CO file, if it resides on the filesystem.
     boost::filesystem::path GetCodeObjectPathname() const;
@@ -60,6 +63,8 @@ struct HIPOCProgram
     /// \return True if CO blob resides in-memory.
     /// False if CO resides on filesystem.
     bool IsCodeObjectInMemory() const;
+    /// \return Size of the code object in bytes, 0 if unknown.
+    std::size_t GetCodeObjectSize() const;
 };
 } // namespace miopen
 
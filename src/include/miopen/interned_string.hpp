@@ -0,0 +1,72 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace miopen {
+
+/// Handle to a string stored in the process-wide intern pool. Equal strings
+/// share one pool entry, so comparison is a pointer compare and the hash is
+/// computed once, at interning time. Pool entries are never released.
+class InternedString
+{
+    public:
+    InternedString() = default;
+    explicit InternedString(const std::string& str);
+
+    /// Does not grow the pool: returns an empty handle if str was never interned.
+    static InternedString TryGet(const std::string& str);
+
+    bool IsEmpty() const { return entry == nullptr; }
+    const std::string& ToString() const;
+    std::size_t Hash() const;
+
+    friend bool operator==(const InternedString& lhs, const InternedString& rhs)
+    {
+        return lhs.entry == rhs.entry;
+    }
+    friend bool operator!=(const InternedString& lhs, const InternedString& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    struct Entry;
+
+    private:
+    explicit InternedString(const Entry* entry_) : entry(entry_) {}
+
+    const Entry* entry = nullptr;
+};
+
+struct InternedStringHash
+{
+    std::size_t operator()(const InternedString& str) const { return str.Hash(); }
+};
+
+} // namespace miopen
@@ -27,45 +27,68 @@
 #pragma once
 
 #include <miopen/errors.hpp>
+#include <miopen/interned_string.hpp>
 #include <miopen/invoker.hpp>
+#include <miopen/read_mostly_map.hpp>
 
 #include <boost/optional.hpp>
 
-#include <map>
-#include <memory>
+#include <cstddef>
 #include <string>
-#include <utility>
 
 namespace miopen {
 
+/// Lookups are lock-free and cost a couple of hash probes regardless of the
+/// length of the network config. Registration is rare (find time) and is
+/// serialized internally, so one cache may be shared by several host threads.
 class InvokerCache
 {
     public:
-    // network_config, solver_id
-    using Key = std::pair<std::string, std::string>;
+    struct Key
+    {
+        Key() = default;
+        Key(const InternedString& network_config_, const InternedString& solver_id_)
+            : network_config(network_config_), solver_id(solver_id_)
+        {
+        }
+
+        InternedString network_config;
+        InternedString solver_id;
+
+        friend bool operator==(const Key& lhs, const Key& rhs)
+        {
+            return lhs.network_config == rhs.network_config && lhs.solver_id == rhs.solver_id;
+        }
+    };
 
     boost::optional<const Invoker&> operator[](const Key& key) const;
     // For find 1.0
-    boost::optional<const Invoker&> GetFound1_0(const std::string& network_config,
-                                                const std::string& algorithm) const;
+    boost::optional<const Invoker&> GetFound1_0(const InternedString& network_config,
+                                                const InternedString& algorithm) const;
+    // For find 1.0, empty if nothing was found
+    InternedString GetFound1_0Id(const InternedString& network_config,
+                                 const InternedString& algorithm) const;
     void Register(const Key& key, const Invoker& invoker);
+    std::size_t Size() const { return invokers.Size(); }
     // For find 1.0
-    void SetAsFound1_0(const std::string& network_config,
-                       const std::string& algorithm,
-                       const std::string& solver_id);
+    void SetAsFound1_0(const InternedString& network_config,
+                       const InternedString& algorithm,
+                       const InternedString& solver_id);
 
     private:
-    struct Item
+    struct KeyHash
     {
-        // algorithm -> solver_id
-        // for find 1.0
-        std::map<std::string, std::string> found_1_0;
-        // solver_id -> invoker
-        std::map<std::string, Invoker> invokers;
+        std::size_t operator()(const Key& key) const
+        {
+            return key.network_config.Hash() ^ (key.solver_id.Hash() * 31);
+        }
     };
 
-    // network_config -> Item
-    std::map<std::string, Item> invokers;
+    // {network_config, solver_id} -> invoker
+    ReadMostlyMap<Key, Invoker, KeyHash> invokers;
+    // {network_config, algorithm} -> solver_id
+    // for find 1.0
+    ReadMostlyMap<Key, InternedString, KeyHash> found_1_0;
 };
 
 } // namespace miopen
@@ -30,6 +30,7 @@
 
 #if MIOPEN_ENABLE_SQLITE
 
+#include <miopen/miopen.h>
 #include <miopen/sqlite_db.hpp>
 #include <miopen/bz2.hpp>
 #include <miopen/md5.hpp>
@@ -38,6 +39,7 @@
 #include <boost/none.hpp>
 #include <boost/optional/optional.hpp>
 
+#include <cstdint>
 #include <string>
 #include <chrono>
 #include <thread>
@@ -55,10 +57,20 @@ struct KernelConfig
     std::string kernel_name;
     std::string kernel_args;
     std::string kernel_blob;
+    /// Time it took to build the code object, 0 if unknown.
+    std::int64_t compile_time_ms = 0;
     static std::vector<std::string> FieldNames()
     {
         return {"kernel_name", "kernel_args", "kernel_blob"};
     }
+    /// Columns added after the first release of the table. Databases that lack them, such as
+    /// older system databases, remain usable without the metadata. code_size is the size of the
+    /// uncompressed code object and last_use the time of the last store or load, in seconds since
+    /// the epoch.
+    static std::vector<std::string> MetadataFieldNames()
+    {
+        return {"compile_time_ms", "code_size", "last_use"};
+    }
     static std::string CreateQuery()
     {
         std::ostringstream ss;
@@ -69,6 +81,9 @@ struct KernelConfig
            << ",`kernel_blob` BLOB NOT NULL"
            << ",`kernel_hash` TEXT NOT NULL"
            << ",`uncompressed_size` INT NOT NULL"
+           << ",`compile_time_ms` INT NOT NULL DEFAULT 0"
+           << ",`code_size` INT NOT NULL DEFAULT 0"
+           << ",`last_use` INT NOT NULL DEFAULT 0"
            << ");"
            << "CREATE UNIQUE INDEX IF NOT EXISTS "
            << "`idx_" << KernelConfig::table_name() << "` "
@@ -85,10 +100,22 @@ struct KernelConfig
     }
 };
 
+struct KernDbTrimResult
+{
+    std::size_t removed_entries = 0;
+    std::size_t removed_bytes   = 0;
+    std::size_t remaining_bytes = 0;
+};
+
 class KernDb : public SQLiteBase<KernDb>
 {
     std::function<std::string(std::string, bool*)> compress_fn;
     std::function<std::string(std::string, unsigned int)> decompress_fn;
+    bool has_metadata = false;
+    bool track_use    = false;
+
+    void AddMetadataColumns();
+    void TouchRecord(std::int64_t id);
 
     public:
     KernDb(const std::string& filename_,
@@ -126,7 +153,7 @@ class KernDb : public SQLiteBase<KernDb>
         if(filename.empty())
             return boost::none;
         // Where clause with inserted values defeats the purpose of a prepraed statement
-        auto select_query = "SELECT kernel_blob, kernel_hash, uncompressed_size FROM " +
+        auto select_query = "SELECT kernel_blob, kernel_hash, uncompressed_size, id FROM " +
                             T::table_name() + " WHERE " + problem_config.Where() + ";";
         auto stmt = SQLite::Statement{sql, select_query};
         // only one result field
@@ -145,6 +172,8 @@ class KernDb : public SQLiteBase<KernDb>
             auto new_md5 = md5(decompressed_blob);
             if(new_md5 != md5_hash)
                 MIOPEN_THROW(miopenStatusInternalError, "Possible database corruption");
+            if(track_use)
+                TouchRecord(stmt.ColumnInt64(3));
             return decompressed_blob;
         }
         else if(rc == SQLITE_DONE)
@@ -159,9 +188,12 @@ class KernDb : public SQLiteBase<KernDb>
     {
         if(filename.empty())
             return boost::none;
-        auto insert_query = "INSERT OR REPLACE INTO " + T::table_name() +
-                            "(kernel_name, kernel_args, kernel_blob, kernel_hash, "
-                            "uncompressed_size) VALUES(?, ?, ?, ?, ?);";
+        auto insert_query =
+            "INSERT OR REPLACE INTO " + T::table_name() +
+            "(kernel_name, kernel_args, kernel_blob, kernel_hash, uncompressed_size" +
+            (has_metadata ? ", compile_time_ms, code_size, last_use) "
+                            "VALUES(?, ?, ?, ?, ?, ?, ?, ?);"
+                          : ") VALUES(?, ?, ?, ?, ?);");
         auto md5_sum           = md5(problem_config.kernel_blob);
         auto uncompressed_size = problem_config.kernel_blob.size();
         bool success           = false;
@@ -180,12 +212,26 @@ class KernDb : public SQLiteBase<KernDb>
             stmt.BindInt64(5, uncompressed_size);
         }
         stmt.BindText(4, md5_sum);
+        if(has_metadata)
+        {
+            stmt.BindInt64(6, problem_config.compile_time_ms);
+            stmt.BindInt64(7, uncompressed_size);
+            stmt.BindInt64(8, Now());
+        }
 
         auto rc = stmt.Step(sql);
         if(rc != SQLITE_DONE)
             MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
         return problem_config.kernel_blob;
     }
+
+    /// Removes entries until the stored blobs take at most max_bytes, then compacts the file.
+    /// miopenKernelCacheEvictLeastRecentlyUsed removes the entries loaded longest ago first,
+    /// miopenKernelCacheEvictCheapest those with the lowest compile time per stored byte, so the
+    /// expensive kernels are kept. Entries without metadata count as the oldest and cheapest.
+    KernDbTrimResult Trim(std::size_t max_bytes, miopenKernelCacheEvictPolicy_t policy);
+
+    static std::int64_t Now();
 };
 } // namespace miopen
 #endif
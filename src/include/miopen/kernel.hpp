@@ -26,6 +26,7 @@
 #ifndef GUARD_MIOPEN_KERNEL_HPP
 #define GUARD_MIOPEN_KERNEL_HPP
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -46,6 +47,17 @@ namespace miopen {
 using Kernel       = OCLKernel;
 using KernelInvoke = OCLKernelInvoke;
 using Program      = SharedProgramPtr;
+using WeakProgram  = std::weak_ptr<typename std::remove_pointer<cl_program>::type>;
+
+inline std::size_t GetCodeObjectSize(const Program& p) { return GetProgramBinarySize(p.get()); }
+
+inline WeakProgram GetWeakProgram(const Program& p) { return p; }
+
+inline bool LockProgram(const WeakProgram& weak, Program& p)
+{
+    p = weak.lock();
+    return p != nullptr;
+}
 
 } // namespace miopen
 
@@ -56,6 +68,17 @@ namespace miopen {
 using Kernel       = HIPOCKernel;
 using KernelInvoke = HIPOCKernelInvoke;
 using Program      = HIPOCProgram;
+using WeakProgram  = std::weak_ptr<const HIPOCProgramImpl>;
+
+inline std::size_t GetCodeObjectSize(const Program& p) { return p.GetCodeObjectSize(); }
+
+inline WeakProgram GetWeakProgram(const Program& p) { return p.impl; }
+
+inline bool LockProgram(const WeakProgram& weak, Program& p)
+{
+    p.impl = weak.lock();
+    return p.impl != nullptr;
+}
 
 } // namespace miopen
 #endif
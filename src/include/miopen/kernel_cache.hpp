@@ -46,6 +46,10 @@
 #include <miopen/kernel.hpp>
 #include <miopen/simple_hash.hpp>
 #include <miopen/miopen.h>
+#include <atomic>
+#include <limits>
+#include <list>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -55,14 +59,20 @@ namespace miopen {
 /**
  * @brief The KernelCache class Build and cache kernels
  *
+ * Programs are kept in LRU order. When a limit on the number of programs or on the total size of
+ * their code objects is set, the least recently used programs are evicted together with the
+ * kernels built from them. Device memory is released once nothing else (e.g. an invoker) holds
+ * the program.
+ *
+ * All the methods are thread-safe. The programs are built without holding the lock, so the
+ * threads sharing a handle don't wait for the builds of each other.
  */
 class KernelCache
 {
 
     public:
-    using Key        = std::pair<std::string, std::string>;
-    using KernelMap  = std::unordered_map<Key, std::vector<Kernel>, SimpleHash>;
-    using ProgramMap = std::unordered_map<Key, Program, SimpleHash>;
+    using Key       = std::pair<std::string, std::string>;
+    using KernelMap = std::unordered_map<Key, std::vector<Kernel>, SimpleHash>;
 
     Kernel AddKernel(const Handle& h,
                      const std::string& algorithm,
@@ -80,8 +90,7 @@ class KernelCache
 
     void ClearKernels(const std::string& algorithm, const std::string& network_config);
 
-    const std::vector<Kernel>& GetKernels(const std::string& algorithm,
-                                          const std::string& network_config);
+    std::vector<Kernel> GetKernels(const std::string& algorithm, const std::string& network_config);
 
     bool HasKernels(const std::string& algorithm, const std::string& network_config) const;
 
@@ -89,11 +98,52 @@ class KernelCache
 
     void AddProgram(Program prog, const std::string& program_name, std::string params);
 
+    /// 0 means no limit. Evicts immediately if the cache is over the new limits.
+    void SetLimits(std::size_t max_programs, std::size_t max_bytes);
+    /// Bytes left to the code objects by the device memory limit of the handle, on top of the
+    /// limits above. Evicts immediately if the cache is over it.
+    void SetMemoryBudget(std::size_t budget_bytes);
+
+    std::size_t GetProgramCount() const;
+    std::size_t GetKernelCount() const;
+    /// Total size of the cached code objects, in bytes.
+    std::size_t GetProgramBytes() const;
+    /// Changes whenever kernels are dropped from the cache, by eviction or ClearKernels().
+    std::size_t GetGeneration() const { return generation.load(std::memory_order_acquire); }
+
     KernelCache();
 
     private:
+    using LruList = std::list<Key>;
+
+    struct ProgramEntry
+    {
+        Program program;
+        std::size_t bytes;
+        LruList::iterator lru;
+        std::vector<Key> kernels; // kernel_map keys built from this program
+    };
+
+    using ProgramMap = std::unordered_map<Key, ProgramEntry, SimpleHash>;
+
+    // The methods below expect the mutex to be held.
+    void InsertKernel(const Key& key, const Kernel& k, std::size_t cache_index);
+    ProgramMap::iterator InsertProgram(const Key& key, const Program& prog);
+    void TouchProgram(ProgramEntry& entry);
+    void EvictPrograms();
+
+    mutable std::mutex mutex;
     KernelMap kernel_map;
     ProgramMap program_map;
+    // Most recently used first.
+    LruList program_lru;
+    // kernel_map key -> program_map key, to refresh the program on kernel lookups.
+    std::unordered_map<Key, Key, SimpleHash> kernel_programs;
+    std::size_t program_bytes = 0;
+    std::size_t max_programs  = 0;
+    std::size_t max_bytes     = 0;
+    std::size_t budget_bytes  = std::numeric_limits<std::size_t>::max();
+    std::atomic<std::size_t> generation{0};
 };
 
 } // namespace miopen
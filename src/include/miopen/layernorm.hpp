@@ -0,0 +1,73 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_LAYERNORM_HPP_
+#define GUARD_MIOPEN_LAYERNORM_HPP_
+
+#include <miopen/common.hpp>
+
+namespace miopen {
+
+struct Handle;
+struct TensorDescriptor;
+
+/// Normalizes the rows of x made of the dimensions from normalized_dim on. weightDesc describes
+/// weight and bias and may be null to skip the affine transform, meanDesc describes mean and
+/// rstd and may be null when the statistics are not saved.
+void LayerNormForward(const Handle& handle,
+                      const TensorDescriptor& xDesc,
+                      ConstData_t x,
+                      const TensorDescriptor* weightDesc,
+                      ConstData_t weight,
+                      ConstData_t bias,
+                      float epsilon,
+                      int normalized_dim,
+                      const TensorDescriptor& yDesc,
+                      Data_t y,
+                      const TensorDescriptor* meanDesc,
+                      Data_t mean,
+                      Data_t rstd);
+
+/// dx from dy and the saved statistics, and optionally dweight and dbias, which are described
+/// by weightDesc.
+void LayerNormBackward(const Handle& handle,
+                       const TensorDescriptor& xDesc,
+                       ConstData_t x,
+                       const TensorDescriptor& dyDesc,
+                       ConstData_t dy,
+                       const TensorDescriptor* weightDesc,
+                       ConstData_t weight,
+                       const TensorDescriptor& meanDesc,
+                       ConstData_t mean,
+                       ConstData_t rstd,
+                       int normalized_dim,
+                       const TensorDescriptor& dxDesc,
+                       Data_t dx,
+                       Data_t dweight,
+                       Data_t dbias);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_LAYERNORM_HPP_
@@ -30,6 +30,7 @@
 #include <miopen/config.h>
 #include <miopen/serializable.hpp>
 #include <iostream>
+#include <string>
 
 namespace miopen {
 namespace solver {
@@ -46,6 +47,9 @@ struct LegacyPerformanceConfig : Serializable<LegacyPerformanceConfig>
     int n_in_data_tiles = 0;
     int n_stacks        = 0;
 
+    /// Alternate the LDS chunks of MIOpenConvUni between two buffers, 0 or 1.
+    int lds_double_buffer = 0;
+
     template <class Solution>
     void CopyTo(Solution& iud) const
     {
@@ -72,6 +76,14 @@ struct LegacyPerformanceConfig : Serializable<LegacyPerformanceConfig>
         f(self.n_out_pix_tiles, "temp.n_out_pix_tiles");
         f(self.n_in_data_tiles, "temp.n_in_data_tiles");
         f(self.n_stacks, "temp.n_stacks");
+        f(self.lds_double_buffer, "temp.lds_double_buffer");
+    }
+
+    /// Records written before lds_double_buffer was added lack the last field.
+    bool Deserialize(const std::string& s)
+    {
+        return Serializable<LegacyPerformanceConfig>::Deserialize(s) ||
+               Serializable<LegacyPerformanceConfig>::Deserialize(s + ",0");
     }
 };
 } // namespace solver
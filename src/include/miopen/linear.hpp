@@ -0,0 +1,53 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_LINEAR_HPP_
+#define GUARD_MIOPEN_LINEAR_HPP_
+
+#include <miopen/common.hpp>
+
+namespace miopen {
+
+struct Handle;
+struct TensorDescriptor;
+struct ActivationDescriptor;
+
+/// y = activ(x * w^T + b), with x of [M, K], w of [N, K], b of N elements and y of [M, N].
+/// The bias and the activation are applied by one pass over y after the GEMM, either may be
+/// omitted by passing null.
+void LinearForward(const Handle& handle,
+                   const TensorDescriptor& xDesc,
+                   ConstData_t x,
+                   const TensorDescriptor& wDesc,
+                   ConstData_t w,
+                   const TensorDescriptor* bDesc,
+                   ConstData_t b,
+                   const ActivationDescriptor* activDesc,
+                   const TensorDescriptor& yDesc,
+                   Data_t y);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_LINEAR_HPP_
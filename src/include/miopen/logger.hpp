@@ -36,6 +36,7 @@
 #include <miopen/each_args.hpp>
 #include <miopen/object.hpp>
 #include <miopen/config.h>
+#include <miopen/trace.hpp>
 
 // See https://github.com/pfultz2/Cloak/wiki/C-Preprocessor-tricks,-tips,-and-idioms
 #define MIOPEN_PP_CAT(x, y) MIOPEN_PP_PRIMITIVE_CAT(x, y)
@@ -208,7 +209,10 @@ std::string LoggingPrefix();
 /// \return true if level is enabled.
 /// \param level - one of the values defined in LoggingLevel.
 bool IsLogging(LoggingLevel level, bool disableQuieting = false);
+/// True if the driver command lines are printed or recorded, see MIOPEN_LOG_DRIVER_CMD.
 bool IsLoggingCmd();
+/// Prints the driver command line of an API call and appends it to the call record.
+void LogDriverCmd(const std::string& function, const std::string& cmd);
 bool IsLoggingFunctionCalls();
 
 namespace logger {
@@ -236,6 +240,10 @@ inline void* LogObjImpl(void* x) { return x; }
 
 inline const void* LogObjImpl(const void* x) { return x; }
 
+/// Traces the enclosing scope as a span of the calling thread, see miopen::trace.
+#define MIOPEN_TRACE_SCOPE(category, name) \
+    const miopen::trace::Span MIOPEN_PP_CAT(miopen_trace_span_, __LINE__) { category, name }
+
 #ifndef _MSC_VER
 template <class T, typename std::enable_if<(std::is_pointer<T>{}), int>::type = 0>
 std::ostream& LogParam(std::ostream& os, std::string name, const T& x)
@@ -277,7 +285,9 @@ std::ostream& LogParam(std::ostream& os, std::string name, const std::vector<T>&
         std::cerr << miopen_log_func_ss.str();                                  \
     } while(false);
 
+// Also traces the enclosing scope, see miopen::trace.
 #define MIOPEN_LOG_FUNCTION(...)                                                        \
+    MIOPEN_TRACE_SCOPE("call", __func__);                                               \
     do                                                                                  \
         if(miopen::IsLoggingFunctionCalls())                                            \
         {                                                                               \
@@ -292,7 +302,7 @@ std::ostream& LogParam(std::ostream& os, std::string name, const std::vector<T>&
         }                                                                               \
     while(false)
 #else
-#define MIOPEN_LOG_FUNCTION(...)
+#define MIOPEN_LOG_FUNCTION(...) MIOPEN_TRACE_SCOPE("call", __func__)
 #endif
 
 std::string LoggingParseFunction(const char* func, const char* pretty_func);
@@ -331,15 +341,14 @@ std::string LoggingParseFunction(const char* func, const char* pretty_func);
 // Warnings in installable builds, errors otherwise.
 #define MIOPEN_LOG_WE(...) MIOPEN_LOG(LogWELevel, __VA_ARGS__)
 
-#define MIOPEN_LOG_DRIVER_CMD(...)                                                      \
-    do                                                                                  \
-    {                                                                                   \
-        std::ostringstream miopen_driver_cmd_ss;                                        \
-        miopen_driver_cmd_ss << miopen::LoggingPrefix() << "Command"                    \
-                             << " [" << miopen::LoggingParseFunction(                   \
-                                            __func__, __PRETTY_FUNCTION__) /* NOLINT */ \
-                             << "] ./bin/MIOpenDriver " << __VA_ARGS__ << std::endl;    \
-        std::cerr << miopen_driver_cmd_ss.str();                                        \
+#define MIOPEN_LOG_DRIVER_CMD(...)                                                    \
+    do                                                                                \
+    {                                                                                 \
+        std::ostringstream miopen_driver_cmd_ss;                                      \
+        miopen_driver_cmd_ss << __VA_ARGS__;                                          \
+        miopen::LogDriverCmd(                                                         \
+            miopen::LoggingParseFunction(__func__, __PRETTY_FUNCTION__), /* NOLINT */ \
+            miopen_driver_cmd_ss.str());                                              \
     } while(false)
 
 } // namespace miopen
@@ -32,7 +32,9 @@
 #include <miopen/fusion.hpp>
 #include <miopen/any_solver.hpp>
 
+#include <functional>
 #include <unordered_map>
+#include <vector>
 
 namespace miopen {
 
@@ -84,6 +86,68 @@ struct MDGraph_vertex
 using MDGraph_vertex_ptr = std::shared_ptr<MDGraph_vertex>;
 using cur_vertex_map     = std::unordered_map<std::string, boost::any>;
 
+/// A constraint expression of the metadata graph, parsed once when the graph is built. The
+/// nodes are stored flat, each after its operands, and the symbols are numbered process-wide
+/// by MDGSymbolIndex(), so matching an op does not touch strings.
+struct MDGConstraint
+{
+    enum NodeKind
+    {
+        Constant,
+        Boolean,
+        Symbol,
+        Binary,
+    };
+
+    struct Node
+    {
+        NodeKind kind;
+        MDGraph_op_t op;
+        int value; // the constant, or the index of the symbol
+        std::size_t lhs;
+        std::size_t rhs;
+    };
+
+    explicit MDGConstraint(const std::string& expr);
+
+    std::string text;
+    std::vector<Node> nodes;
+};
+
+std::size_t MDGSymbolIndex(const std::string& sym);
+std::string MDGSymbolName(std::size_t index);
+
+/// The values of the symbols while one op is matched against the graph, looked up once each.
+struct MDGSymbolTable
+{
+    explicit MDGSymbolTable(std::function<bool(const std::string& sym, int& val)> f);
+    bool Lookup(std::size_t sym, int& val);
+
+    private:
+    std::function<bool(const std::string& sym, int& val)> lookup;
+    std::vector<char> state;
+    std::vector<int> values;
+};
+
+/// The symbols an edge assigns with "===", e.g. its weight and algorithm.
+using MDGLocals = std::vector<std::pair<std::size_t, int>>;
+
+/// Evaluates the constraints in order, as they were interpreted from their text; stops at the
+/// first one that is not satisfied.
+bool MDGEvaluate(const std::vector<MDGConstraint>& constraints,
+                 MDGSymbolTable& symbols,
+                 MDGLocals& locals);
+
+struct MDGraph_edge
+{
+    FusionMDGraph_Edge_Map map;
+    std::vector<MDGConstraint> constraints;
+};
+
+using MDGraph_edges =
+    std::unordered_map<MDGraph_vertex_ptr,
+                       std::unordered_map<MDGraph_vertex_ptr, std::vector<MDGraph_edge>>>;
+
 struct FusionMDGraph
 {
     FusionMDGraph() { Reset(); }
@@ -97,9 +161,7 @@ struct FusionMDGraph
                  std::function<bool(const std::string& sym, int& val)> attr_fun);
     void AddEdge(MDGraph_vertex_ptr src, MDGraph_vertex_ptr dst, FusionMDGraph_Edge_Map& map);
 
-    bool CmpOpKey(const FusionMDGraph_Edge_Map& edge_val,
-                  std::function<bool(const std::string& sym, int& val)> attr_fun,
-                  std::unordered_map<std::string, int>& syms) const;
+    bool CmpOpKey(const MDGraph_edge& edge, MDGSymbolTable& symbols, MDGLocals& locals) const;
     MDGraph_vertex_ptr GetCurVertex(const Handle& handle);
     std::string GetProgramName(const Handle& handle);
     std::string GetKernelName(const Handle& handle);
@@ -113,9 +175,10 @@ struct FusionMDGraph
     std::vector<std::pair<MDGraph_vertex_ptr, cur_vertex_map>> cur_vertex;
     std::set<miopenConvFwdAlgorithm_t> conv_algo_set;
 
-    std::unordered_map<MDGraph_vertex_ptr,
-                       std::unordered_map<MDGraph_vertex_ptr, FusionMDGraph_Edge_Map_Vec>>
-        edge_list;
+    /// The graphs are built once per process for each first op and shared by the plans, the
+    /// edges are only added to while building.
+    std::shared_ptr<const MDGraph_edges> graph;
+    MDGraph_edges edge_list;
 };
 
 } // namespace miopen
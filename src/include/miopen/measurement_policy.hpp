@@ -0,0 +1,98 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_MEASUREMENT_POLICY_HPP_
+#define GUARD_MIOPEN_MEASUREMENT_POLICY_HPP_
+
+#include <miopen/gpu_sensors.hpp>
+
+#include <cstddef>
+
+namespace miopen {
+namespace solver {
+
+/// Accumulates kernel time samples (Welford's algorithm).
+class RunningStats
+{
+    public:
+    void Add(float sample);
+
+    std::size_t Count() const { return count; }
+    float Mean() const { return static_cast<float>(mean); }
+    /// Unbiased sample variance, 0 until there are at least 2 samples.
+    float Variance() const;
+    /// Standard error of the mean relative to the mean.
+    float RelativeError() const;
+
+    private:
+    std::size_t count = 0;
+    double mean       = 0.0;
+    double m2         = 0.0;
+};
+
+/// Decides how many times GenericSearch runs each candidate:
+/// - warmup_runs unmeasured runs are done before the first sample;
+/// - a candidate whose first sample exceeds the best known time by prune_ratio is
+///   dropped without further measurements;
+/// - otherwise it is re-run until max_runs samples are taken or, if target_rel_error > 0,
+///   until the standard error of the mean falls below target_rel_error * mean;
+/// - if min_span_ms > 0, each sample of a candidate whose first run took less than that is the
+///   time of GetBatchSize() back-to-back runs between one pair of events divided by their
+///   count, so short kernels are not measured at the resolution of the events;
+/// - if clock_drift_ratio > 0 and the shader clock has moved by more than that since the best
+///   time was measured, the best config is measured again before it is compared with others.
+/// Defaults reproduce the former behavior: 5 samples if the first one is within 1.05x
+/// of the best, 1 otherwise.
+struct MeasurementPolicy
+{
+    std::size_t warmup_runs = 0;
+    std::size_t max_runs    = 5;
+    float prune_ratio       = 1.05f;
+    float target_rel_error  = 0.0f;
+    float min_span_ms       = 0.0f;
+    std::size_t max_batch   = 256;
+    float clock_drift_ratio = 0.05f;
+
+    static MeasurementPolicy FromEnv();
+
+    bool IsPruned(float first_sample, float best_time) const
+    {
+        return !(first_sample / best_time < prune_ratio);
+    }
+
+    bool NeedsMoreRuns(const RunningStats& stats) const;
+
+    /// Runs timed together for a candidate whose single run took single_time, 1 to max_batch.
+    std::size_t GetBatchSize(float single_time) const;
+
+    /// False if either of the clocks is unknown.
+    bool IsClockDrifted(const GpuConditions& reference, const GpuConditions& now) const;
+};
+
+} // namespace solver
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_MEASUREMENT_POLICY_HPP_
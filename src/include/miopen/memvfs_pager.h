@@ -0,0 +1,49 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_MEMVFS_PAGER_H_
+#define GUARD_MIOPEN_MEMVFS_PAGER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Read-only file content that memvfs gets page by page from the application, which
+** may produce the pages on demand (e.g. decompress them). Passed to memvfs as the
+** pager= query parameter in place of ptr=, sz= is the size of the file.
+*/
+typedef struct miopen_memvfs_pager
+{
+    void* ctx;     /* Passed back to page() */
+    int page_size; /* Size of every page but the last one */
+    /* The content of the page, or 0 on failure. Must stay valid while the file is open. */
+    const unsigned char* (*page)(void* ctx, long long index);
+} miopen_memvfs_pager;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GUARD_MIOPEN_MEMVFS_PAGER_H_
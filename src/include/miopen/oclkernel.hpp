@@ -110,6 +110,24 @@ struct OCLKernelInvoke
         run();
     }
 
+    void operator()(const OpKernelArgsBlock& args) const
+    {
+        for(size_t idx = 0; idx < args.Count(); idx++)
+        {
+            cl_int status = clSetKernelArg(kernel.get(),
+                                           idx,
+                                           args.ArgSize(idx),
+                                           reinterpret_cast<const void*>(args.Arg(idx)));
+            if(status != CL_SUCCESS)
+            {
+                MIOPEN_THROW("Error setting argument #" + std::to_string(idx) +
+                             " to kernel (size = " + std::to_string(args.ArgSize(idx)) + "): " +
+                             OpenCLErrorMessage(status));
+            }
+        }
+        run();
+    }
+
     template <class... Ts>
     void operator()(const Ts&... xs) const
     {
@@ -2,7 +2,11 @@
 #define MIOPEN_GUARD_MLOPEN_OP_KERNEL_ARGS_HPP
 
 #include <type_traits>
+#include <cassert>
 #include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
 #include <half.hpp>
 
 #include <boost/container/small_vector.hpp>
@@ -32,4 +36,59 @@ struct OpKernelArg
     bool is_ptr = false;
 };
 
+/// Kernel arguments packed once, e.g. when an invoker is built, in the layout the HIP backend
+/// passes to kernels. Only the arguments which differ between launches (typically the buffer
+/// pointers) are patched before each one. Copies share the layout and do not allocate.
+struct OpKernelArgsBlock
+{
+    OpKernelArgsBlock() {}
+    explicit OpKernelArgsBlock(const std::vector<OpKernelArg>& args)
+    {
+        auto layout      = std::make_shared<Layout>();
+        std::size_t size = 0;
+        for(const auto& arg : args)
+        {
+            const auto alignment = arg.size();
+            const auto offset    = (size + alignment - 1) / alignment * alignment;
+            layout->offsets.push_back(offset);
+            layout->sizes.push_back(arg.size());
+            size = offset + arg.size();
+        }
+        buffer.resize(size);
+        for(std::size_t i = 0; i < args.size(); i++)
+            std::memcpy(&buffer[layout->offsets[i]], args[i].buffer.data(), args[i].size());
+        arg_layout = std::move(layout);
+    }
+
+    template <typename T>
+    void Set(std::size_t index, const T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>{}, "Only for trivially copyable types");
+        assert(sizeof(T) == arg_layout->sizes[index]);
+        std::memcpy(&buffer[arg_layout->offsets[index]], &value, sizeof(T));
+    }
+
+    void Set(std::size_t index, const OpKernelArg& arg)
+    {
+        assert(arg.size() == arg_layout->sizes[index]);
+        std::memcpy(&buffer[arg_layout->offsets[index]], arg.buffer.data(), arg.size());
+    }
+
+    std::size_t Count() const { return arg_layout == nullptr ? 0 : arg_layout->sizes.size(); }
+    const char* Arg(std::size_t index) const { return &buffer[arg_layout->offsets[index]]; }
+    std::size_t ArgSize(std::size_t index) const { return arg_layout->sizes[index]; }
+    const char* Data() const { return buffer.data(); }
+    std::size_t Size() const { return buffer.size(); }
+
+    private:
+    struct Layout
+    {
+        std::vector<std::size_t> offsets;
+        std::vector<std::size_t> sizes;
+    };
+
+    boost::container::small_vector<char, 256> buffer;
+    std::shared_ptr<const Layout> arg_layout;
+};
+
 #endif
@@ -0,0 +1,57 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_OPTIMIZER_HPP_
+#define GUARD_MIOPEN_OPTIMIZER_HPP_
+
+#include <miopen/common.hpp>
+#include <miopen/miopen.h>
+
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+
+/// Applies one step of the optimizer to every tensor of the list, up to 16 tensors per launch.
+/// expAvgs is unused by SGD and expAvgSqs by SGD and momentum, those may be empty.
+void MultiTensorOptimizerUpdate(const Handle& handle,
+                                miopenOptimizerMode_t mode,
+                                miopenDataType_t dataType,
+                                const std::vector<size_t>& elementCounts,
+                                const std::vector<Data_t>& params,
+                                const std::vector<ConstData_t>& grads,
+                                const std::vector<Data_t>& expAvgs,
+                                const std::vector<Data_t>& expAvgSqs,
+                                float lr,
+                                float beta1,
+                                float beta2,
+                                float eps,
+                                float weightDecay,
+                                int step);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_OPTIMIZER_HPP_
@@ -0,0 +1,117 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_PAGED_IMAGE_HPP_
+#define GUARD_MIOPEN_PAGED_IMAGE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace miopen {
+
+/// Image of a file made of independently compressed pages, so that a reader decompresses
+/// only the pages it touches. The embedded system db is stored this way when built with
+/// MIOPEN_EMBED_DB_COMPRESSED. Layout, integers are 64-bit little-endian:
+///
+///     "MIOPNPG1", page size, file size, page count n,
+///     n + 1 offsets of the stored pages from the end of the offset table,
+///     stored pages.
+///
+/// A stored page of the same length as the page itself is kept verbatim (compression did
+/// not pay off), otherwise it is a blob miopen::decompress() recognizes.
+class PagedImage
+{
+    public:
+    static constexpr const char* magic       = "MIOPNPG1";
+    static constexpr std::size_t magic_size  = 8;
+    static constexpr std::size_t header_size = magic_size + 3 * sizeof(uint64_t);
+
+    static bool IsPagedImage(const char* data, std::size_t size);
+
+    /// Builds an image of the file. The compress functor returns the stored form of a page,
+    /// header only, so that the build time tool can use it without the library.
+    template <class Compress>
+    static std::string Make(const std::string& file, std::size_t page_size, Compress compress)
+    {
+        const auto page_count = (file.size() + page_size - 1) / page_size;
+        std::string pages;
+        std::string offsets;
+        AppendUInt64(offsets, 0);
+        for(std::size_t i = 0; i < page_count; ++i)
+        {
+            const auto page   = file.substr(i * page_size, page_size);
+            const auto stored = compress(page);
+            pages += stored.size() < page.size() ? stored : page;
+            AppendUInt64(offsets, pages.size());
+        }
+
+        std::string image{magic, magic_size};
+        AppendUInt64(image, page_size);
+        AppendUInt64(image, file.size());
+        AppendUInt64(image, page_count);
+        return image + offsets + pages;
+    }
+
+    /// The image must outlive the object. Throws if the image is malformed.
+    PagedImage(const char* data, std::size_t size);
+    PagedImage(const PagedImage&) = delete;
+    PagedImage& operator=(const PagedImage&) = delete;
+    ~PagedImage();
+
+    std::size_t GetPageSize() const { return page_size; }
+    std::size_t GetPageCount() const { return page_count; }
+    /// Size of the file the image holds.
+    std::size_t GetSize() const { return size; }
+
+    /// Decompresses the page on the first call. Thread safe, the page stays valid for the
+    /// lifetime of the object. Throws if the page fails to decompress.
+    const unsigned char* GetPage(std::size_t index) const;
+    /// Pages decompressed so far, verbatim pages are not counted.
+    std::size_t GetDecompressedPageCount() const { return decompressed; }
+
+    private:
+    const char* pages;
+    const char* offsets;
+    std::size_t page_size;
+    std::size_t size;
+    std::size_t page_count;
+    std::unique_ptr<std::atomic<const unsigned char*>[]> cache;
+    mutable std::atomic<std::size_t> decompressed{0};
+
+    static void AppendUInt64(std::string& s, uint64_t value)
+    {
+        for(int i = 0; i < 8; ++i)
+            s.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+    }
+    static uint64_t ReadUInt64(const char* p);
+    std::size_t GetOffset(std::size_t index) const { return ReadUInt64(offsets + 8 * index); }
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_PAGED_IMAGE_HPP_
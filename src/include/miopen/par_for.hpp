@@ -27,16 +27,26 @@
 #ifndef MIOPEN_GUARD_MLOPEN_PAR_FOR_HPP
 #define MIOPEN_GUARD_MLOPEN_PAR_FOR_HPP
 
+#include <miopen/env.hpp>
+
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cmath>
+#include <deque>
+#include <exception>
 #include <functional>
+#include <memory>
 #include <numeric>
 #include <vector>
 
 #ifdef __MINGW32__
+#include <mingw.condition_variable.h>
+#include <mingw.mutex.h>
 #include <mingw.thread.h>
 #else
+#include <condition_variable>
+#include <mutex>
 #include <thread>
 #endif
 
@@ -59,22 +69,157 @@ struct joinable_thread : std::thread
     }
 };
 
-struct thread_factory
+/// Persistent pool of threads running the par_for() loops, created on the first use. Its size is
+/// the number of hardware threads, limited by MIOPEN_COMPILE_PARALLEL_LEVEL if that is set.
+///
+/// The calling thread takes part in its loop. All the threads of a loop claim chunks of the
+/// iterations from a shared counter, and the chunks shrink as the loop drains, so iterations of
+/// very different costs (e.g. kernel compiles) balance between the threads instead of waiting
+/// for the slowest of fixed, equal ranges.
+class par_for_pool
 {
-    template <class F>
-    joinable_thread operator()(std::size_t& work, std::size_t n, std::size_t grainsize, F f) const
+    public:
+    static par_for_pool& get()
     {
-        auto result = joinable_thread([=] {
-            std::size_t start = work;
-            std::size_t last  = std::min(n, work + grainsize);
-            for(std::size_t i = start; i < last; i++)
-            {
+        // Never destroyed, so that the detached workers do not find the pool gone at exit.
+        static auto* const pool = new par_for_pool(default_size());
+        return *pool;
+    }
+
+    /// The number of threads a loop can run on, the calling thread included.
+    std::size_t size() const { return worker_num + 1; }
+
+    /// Calls f for every index in [0, n) on up to threadsize threads and waits for all of them.
+    /// The first exception thrown is rethrown.
+    void run(std::size_t n, std::size_t threadsize, std::function<void(std::size_t)> f)
+    {
+        threadsize = std::min({threadsize, size(), n});
+        if(threadsize <= 1)
+        {
+            for(std::size_t i = 0; i < n; i++)
                 f(i);
+            return;
+        }
+
+        // Shared with the workers, which may only get to their task once the loop is done.
+        auto l = std::make_shared<loop>(n, threadsize, std::move(f));
+        for(std::size_t i = 1; i < threadsize; i++)
+            submit([l] { l->work(); });
+        l->work();
+        l->wait();
+    }
+
+    par_for_pool(const par_for_pool&) = delete;
+    par_for_pool& operator=(const par_for_pool&) = delete;
+
+    private:
+    struct loop
+    {
+        loop(std::size_t n_, std::size_t threadsize_, std::function<void(std::size_t)> f_)
+            : n(n_), threadsize(threadsize_), f(std::move(f_))
+        {
+        }
+
+        // Guided chunking: a share of what is left, but at least one iteration.
+        bool claim(std::size_t& first, std::size_t& last)
+        {
+            auto start = next.load();
+            do
+            {
+                if(start >= n)
+                    return false;
+                const auto chunk = std::max<std::size_t>(1, (n - start) / (2 * threadsize));
+                last             = std::min(n, start + chunk);
+            } while(!next.compare_exchange_weak(start, last));
+            first = start;
+            return true;
+        }
+
+        void work()
+        {
+            std::size_t first = 0;
+            std::size_t last  = 0;
+            while(claim(first, last))
+            {
+                std::exception_ptr failure;
+                try
+                {
+                    for(auto i = first; i < last; i++)
+                        f(i);
+                }
+                catch(...)
+                {
+                    failure = std::current_exception();
+                }
+
+                std::lock_guard<std::mutex> lock(mutex);
+                if(failure && !error)
+                    error = failure;
+                done += last - first;
+                if(done == n)
+                    cv.notify_all();
             }
-        });
-        work += grainsize;
-        return result;
+        }
+
+        void wait()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [&] { return done == n; });
+            if(error)
+                std::rethrow_exception(error);
+        }
+
+        const std::size_t n;
+        const std::size_t threadsize;
+        const std::function<void(std::size_t)> f;
+        std::atomic<std::size_t> next{0};
+        std::size_t done = 0;
+        std::exception_ptr error;
+        std::mutex mutex;
+        std::condition_variable cv;
+    };
+
+    static std::size_t default_size()
+    {
+        const std::size_t hw_threads = std::max(std::thread::hardware_concurrency(), 1u);
+        const std::size_t level      = EnvvarValue("MIOPEN_COMPILE_PARALLEL_LEVEL", 0);
+        return level == 0 ? hw_threads : std::min(hw_threads, level);
+    }
+
+    explicit par_for_pool(std::size_t threads) : worker_num(threads - 1)
+    {
+        for(std::size_t i = 0; i < worker_num; i++)
+            std::thread([this] { serve(); }).detach();
+    }
+
+    void submit(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(tasks_mutex);
+            tasks.push_back(std::move(task));
+        }
+        tasks_cv.notify_one();
+    }
+
+    void serve()
+    {
+        for(;;)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(tasks_mutex);
+                tasks_cv.wait(lock, [this] { return !tasks.empty(); });
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
     }
+
+    const std::size_t worker_num;
+    std::mutex tasks_mutex;
+    std::condition_variable tasks_cv;
+    std::deque<std::function<void()>> tasks;
 };
 
 template <class F>
@@ -87,14 +232,7 @@ void par_for_impl(std::size_t n, std::size_t threadsize, F f)
     }
     else
     {
-        std::vector<joinable_thread> threads(threadsize);
-        const std::size_t grainsize = std::ceil(static_cast<double>(n) / threads.size());
-
-        std::size_t work = 0;
-        std::generate(threads.begin(),
-                      threads.end(),
-                      std::bind(thread_factory{}, std::ref(work), n, grainsize, f));
-        assert(work >= n);
+        par_for_pool::get().run(n, threadsize, f);
     }
 }
 
@@ -107,6 +107,16 @@ struct PoolingDescriptor : miopenPoolingDescriptor
                             Data_t dx,
                             ConstData_t workSpace) const;
 
+    miopenStatus_t BackwardMaxRecompute(Handle& handle,
+                                        const TensorDescriptor& yDesc,
+                                        ConstData_t y,
+                                        const TensorDescriptor& dyDesc,
+                                        ConstData_t dy,
+                                        const TensorDescriptor& xDesc,
+                                        ConstData_t x,
+                                        const TensorDescriptor& dxDesc,
+                                        Data_t dx) const;
+
     friend std::ostream& operator<<(std::ostream& stream, const PoolingDescriptor& x);
 
     std::vector<int> lens;
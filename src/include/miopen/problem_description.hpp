@@ -37,6 +37,7 @@
 #include <cassert>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <boost/optional/optional.hpp>
 namespace miopen {
 
@@ -141,6 +142,22 @@ struct ProblemDescription
         f(self.group_counts, "group_count");
     }
 
+    /// The columns in which a tuned problem may differ from this one to lend it its
+    /// performance configs, see MIOPEN_DEBUG_PERFDB_NEAREST. All the other columns should match.
+    static const std::vector<std::string>& NearestFieldNames()
+    {
+        static const std::vector<std::string> names = {"in_channels",
+                                                       "in_h",
+                                                       "in_w",
+                                                       "in_d",
+                                                       "fil_h",
+                                                       "fil_w",
+                                                       "fil_d",
+                                                       "out_channels",
+                                                       "batchsize"};
+        return names;
+    }
+
     template <class Self>
     static void Visit(Self&& self, std::function<void(std::string, std::string)> f)
     {
@@ -180,6 +197,12 @@ struct ProblemDescription
     bool Is2d() const { return spatial_dims == 2; }
     bool Is3d() const { return spatial_dims == 3; }
 
+    bool IsLayoutDefault() const
+    {
+        return (in_layout.empty() || in_layout == "NCHW") &&
+               (out_layout.empty() || out_layout == "NCHW") && weights_layout.empty();
+    }
+
     bool IsFp32() const
     {
         return in_data_type == miopenFloat && weights_data_type == miopenFloat &&
@@ -195,6 +218,12 @@ struct ProblemDescription
         return in_data_type == miopenBFloat16 && weights_data_type == miopenBFloat16 &&
                out_data_type == miopenBFloat16;
     }
+    /// int8 inputs and weights; the output is either int32 or fp32.
+    bool IsInt8() const
+    {
+        return in_data_type == miopenInt8 && weights_data_type == miopenInt8 &&
+               (out_data_type == miopenInt32 || out_data_type == miopenFloat);
+    }
 
     ProblemDescription() = default;
 
@@ -0,0 +1,196 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+
+/// Insert-only hash map tuned for the read-mostly access pattern of the
+/// library caches: lookups never take a lock, while inserts are serialized
+/// by a mutex. Published nodes are immutable and are only released together
+/// with the map, so pointers returned by Find() stay valid for its lifetime.
+///
+/// Assigning a new value to an existing key shadows the old node instead of
+/// modifying it; shadowed nodes are dropped on the next rehash.
+template <class Key, class Value, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+class ReadMostlyMap
+{
+    public:
+    ReadMostlyMap() : ReadMostlyMap(16) {}
+    explicit ReadMostlyMap(std::size_t initial_buckets)
+    {
+        std::size_t size = 1;
+        while(size < initial_buckets)
+            size <<= 1;
+        tables.emplace_back(std::make_unique<Table>(size));
+        current.store(tables.back().get(), std::memory_order_release);
+    }
+
+    ReadMostlyMap(const ReadMostlyMap&) = delete;
+    ReadMostlyMap& operator=(const ReadMostlyMap&) = delete;
+
+    /// Not thread-safe: the source shall not be accessed concurrently. Pointers returned by the
+    /// source stay valid, and the source is left empty.
+    ReadMostlyMap(ReadMostlyMap&& other)
+        : current(other.current.load(std::memory_order_acquire)),
+          size(other.size.load(std::memory_order_relaxed)),
+          tables(std::move(other.tables)),
+          nodes(std::move(other.nodes))
+    {
+        other.tables.clear();
+        other.nodes.clear();
+        other.tables.emplace_back(std::make_unique<Table>(16));
+        other.current.store(other.tables.back().get(), std::memory_order_release);
+        other.size.store(0, std::memory_order_relaxed);
+    }
+
+    const Value* Find(const Key& key) const
+    {
+        const auto hash   = Hash{}(key);
+        const auto* table = current.load(std::memory_order_acquire);
+        for(auto node = table->Head(hash); node != nullptr; node = node->next)
+            if(node->hash == hash && KeyEqual{}(node->key, key))
+                return &node->value;
+        return nullptr;
+    }
+
+    /// Returns the value stored for the key and whether it has been inserted by this call.
+    std::pair<const Value*, bool> Insert(const Key& key, const Value& value)
+    {
+        const std::lock_guard<std::mutex> lock(write_mutex);
+        if(const auto existing = Find(key))
+            return {existing, false};
+        return {Publish(key, value), true};
+    }
+
+    const Value* InsertOrAssign(const Key& key, const Value& value)
+    {
+        const std::lock_guard<std::mutex> lock(write_mutex);
+        const auto existing = Find(key);
+        if(existing != nullptr && *existing == value)
+            return existing;
+        return Publish(key, value, existing != nullptr);
+    }
+
+    std::size_t Size() const { return size.load(std::memory_order_relaxed); }
+
+    private:
+    struct Node
+    {
+        Node(const Key& key_, const Value& value_, std::size_t hash_, const Node* next_)
+            : key(key_), value(value_), hash(hash_), next(next_)
+        {
+        }
+
+        const Key key;
+        const Value value;
+        const std::size_t hash;
+        const Node* const next;
+    };
+
+    struct Table
+    {
+        explicit Table(std::size_t size_)
+            : mask(size_ - 1), buckets(std::make_unique<std::atomic<const Node*>[]>(size_))
+        {
+            for(std::size_t i = 0; i < size_; ++i)
+                buckets[i].store(nullptr, std::memory_order_relaxed);
+        }
+
+        const Node* Head(std::size_t hash) const
+        {
+            return buckets[hash & mask].load(std::memory_order_acquire);
+        }
+
+        std::size_t Buckets() const { return mask + 1; }
+
+        const std::size_t mask;
+        std::unique_ptr<std::atomic<const Node*>[]> buckets;
+    };
+
+    const Value* Publish(const Key& key, const Value& value, bool shadows = false)
+    {
+        const auto hash = Hash{}(key);
+        auto* table     = current.load(std::memory_order_relaxed);
+
+        if(!shadows && size.load(std::memory_order_relaxed) + 1 > table->Buckets())
+            table = Rehash(*table);
+
+        auto& bucket = table->buckets[hash & table->mask];
+        nodes.emplace_back(
+            std::make_unique<Node>(key, value, hash, bucket.load(std::memory_order_relaxed)));
+        bucket.store(nodes.back().get(), std::memory_order_release);
+        if(!shadows)
+            size.fetch_add(1, std::memory_order_relaxed);
+        return &nodes.back()->value;
+    }
+
+    // Old tables and nodes are retained: concurrent readers may still be walking them and
+    // references handed out by Find() must stay valid. The geometric growth keeps the
+    // retained memory within a small factor of the live one.
+    Table* Rehash(const Table& old)
+    {
+        tables.emplace_back(std::make_unique<Table>(old.Buckets() * 2));
+        auto* table = tables.back().get();
+
+        for(std::size_t i = 0; i < old.Buckets(); ++i)
+        {
+            for(auto node = old.buckets[i].load(std::memory_order_relaxed); node != nullptr;
+                node      = node->next)
+            {
+                auto& bucket        = table->buckets[node->hash & table->mask];
+                const auto new_head = bucket.load(std::memory_order_relaxed);
+                auto shadowed       = false;
+                for(auto it = new_head; it != nullptr && !shadowed; it = it->next)
+                    shadowed = it->hash == node->hash && KeyEqual{}(it->key, node->key);
+                if(shadowed)
+                    continue;
+                nodes.emplace_back(
+                    std::make_unique<Node>(node->key, node->value, node->hash, new_head));
+                bucket.store(nodes.back().get(), std::memory_order_relaxed);
+            }
+        }
+
+        current.store(table, std::memory_order_release);
+        return table;
+    }
+
+    std::atomic<Table*> current{nullptr};
+    std::atomic<std::size_t> size{0};
+    std::mutex write_mutex;
+    std::vector<std::unique_ptr<Table>> tables;
+    std::vector<std::unique_ptr<Node>> nodes;
+};
+
+} // namespace miopen
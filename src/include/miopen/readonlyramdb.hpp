@@ -26,51 +26,33 @@
 #ifndef MIOPEN_GUARD_MLOPEN_READONLYRAMDB_HPP
 #define MIOPEN_GUARD_MLOPEN_READONLYRAMDB_HPP
 
+#include <miopen/binary_db.hpp>
+#include <miopen/cache_stats.hpp>
 #include <miopen/db_record.hpp>
+#include <miopen/string_arena_map.hpp>
 
 #include <boost/optional.hpp>
 
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <string>
 #include <sstream>
+#include <vector>
 
 namespace miopen {
 
 class ReadonlyRamDb
 {
     public:
-    ReadonlyRamDb(std::string path) : db_path(path) {}
+    ReadonlyRamDb(std::string path);
 
     static ReadonlyRamDb& GetCached(const std::string& path,
                                     bool warn_if_unreadable,
                                     const std::string& arch = "",
                                     std::size_t num_cu      = 0);
 
-    boost::optional<DbRecord> FindRecord(const std::string& problem) const
-    {
-        const auto it = cache.find(problem);
-
-        if(it == cache.end())
-            return boost::none;
-
-        auto record = DbRecord{problem};
-
-        if(!record.ParseContents(it->second.content))
-        {
-            MIOPEN_LOG_E("Error parsing payload under the key: " << problem << " form file "
-                                                                 << db_path
-                                                                 << "#"
-                                                                 << it->second.line);
-            MIOPEN_LOG_E("Contents: " << it->second.content);
-            return boost::none;
-        }
-        else
-        {
-            MIOPEN_LOG_I2("Looking for key " << problem << " in file " << db_path);
-        }
-
-        return record;
-    }
+    boost::optional<DbRecord> FindRecord(const std::string& problem) const;
 
     template <class TProblem>
     boost::optional<DbRecord> FindRecord(const TProblem& problem) const
@@ -79,9 +61,28 @@ class ReadonlyRamDb
         return FindRecord(key);
     }
 
+    /// In the pre-parsed mode the records can be looked up by FindRecordRef(), without a copy.
+    bool IsPreparsed() const { return preparsed && mapped == nullptr; }
+
+    /// The stored record of the problem or null, only in the pre-parsed mode.
+    template <class TProblem>
+    const DbRecord* FindRecordRef(const TProblem& problem) const
+    {
+        const cache_stats::Lookup lookup{miopenCacheSystemFindDb};
+        const auto record = FindParsedRecord(DbRecord::Serialize(problem));
+        lookup.Done(record != nullptr);
+        return record;
+    }
+
     template <class TProblem, class TValue>
     bool Load(const TProblem& problem, const std::string& id, TValue& value) const
     {
+        if(IsPreparsed())
+        {
+            const auto record = FindRecordRef(problem);
+            return record != nullptr && record->GetValues(id, value);
+        }
+
         const auto record = FindRecord(problem);
         if(!record)
             return false;
@@ -89,21 +90,34 @@ class ReadonlyRamDb
     }
 
     private:
-    struct CacheItem
-    {
-        int line;
-        std::string content;
-    };
-
     std::string db_path;
-    std::unordered_map<std::string, CacheItem> cache;
+    // key -> contents, with the source line of entry i in cache_lines[i]
+    StringArenaMap cache;
+    std::vector<int> cache_lines;
+    // In the pre-parsed mode the contents are parsed once at prefetch time and
+    // stored here instead of the cache, so a lookup does no text processing.
+    std::unordered_map<std::string, DbRecord> records;
+    bool preparsed;
+    // Compiled binary db. When present, neither of the maps above is used.
+    std::shared_ptr<const MappedDb> mapped;
+    std::once_flag prefetched;
+
+    boost::optional<DbRecord> FindRecordImpl(const std::string& problem) const;
+
+    const DbRecord* FindParsedRecord(const std::string& problem) const
+    {
+        const auto it = records.find(problem);
+        if(it == records.end())
+            return nullptr;
+        MIOPEN_LOG_I2("Looking for key " << problem << " in file " << db_path);
+        return &it->second;
+    }
 
-    ReadonlyRamDb(const ReadonlyRamDb&) = default;
-    ReadonlyRamDb(ReadonlyRamDb&&)      = default;
-    ReadonlyRamDb& operator=(const ReadonlyRamDb&) = default;
-    ReadonlyRamDb& operator=(ReadonlyRamDb&&) = default;
+    ReadonlyRamDb(const ReadonlyRamDb&) = delete;
+    ReadonlyRamDb& operator=(const ReadonlyRamDb&) = delete;
 
     void Prefetch(const std::string& path, bool warn_if_unreadable);
+    bool TryMapBinary(const std::string& path);
     void
     ParseAndLoadDb(std::istream& input_stream, const std::string& path, bool warn_if_unreadable);
 };
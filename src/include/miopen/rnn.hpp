@@ -27,6 +27,7 @@
 #ifndef GUARD_MIOPEN_RNN_HPP_
 #define GUARD_MIOPEN_RNN_HPP_
 
+#include <miopen/allocator.hpp>
 #include <miopen/common.hpp>
 #include <miopen/dropout.hpp>
 #include <miopen/errors.hpp>
@@ -39,12 +40,14 @@
 #include <cstddef>
 #include <iosfwd>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace miopen {
 
 struct Handle;
 struct TensorDescriptor;
+struct RNNPreparedWeights;
 
 template <class T>
 struct c_array_view
@@ -102,6 +105,24 @@ struct RNNDescriptor : miopenRNNDescriptor
     miopenDataType_t dataType;
     std::size_t typeSize;
     miopenDropoutDescriptor_t dropoutDesc{};
+    size_t projSize = 0; // Size of the projected hidden state of LSTMP, 0 without projection.
+    // Type of the activations kept in the reserve space between the forward and backward passes.
+    miopenDataType_t reserveDataType = miopenFloat;
+
+    void SetProjectionSize(int proj_size);
+
+    void SetReserveDataType(miopenDataType_t type);
+
+    /// The reserve space keeps the activations in a narrower type than dataType. Training then
+    /// runs on a dataType copy of the reserve space at the end of the workspace, see
+    /// GetFullReserveOffset().
+    inline bool IsReserveCompressed() const
+    {
+        return dataType == miopenFloat && reserveDataType != miopenFloat;
+    }
+
+    /// Size of the hidden state fed back to the cells and to the next layer.
+    inline size_t RecurrentSize() const { return projSize != 0 ? projSize : hsize; }
 
     size_t biasOffsetCalculation(const TensorDescriptor& xDesc, int layer, int biasID) const;
 
@@ -118,6 +139,28 @@ struct RNNDescriptor : miopenRNNDescriptor
                           int seqLength,
                           c_array_view<const miopenTensorDescriptor_t> xDesc) const;
 
+    /// Bytes of the reserve space laid out in dataType: the activations, which a compressed
+    /// reserve space stores in reserveDataType, followed by the dropout masks.
+    std::pair<size_t, size_t>
+    GetFullReserveLayout(int seqLength, c_array_view<const miopenTensorDescriptor_t> xDesc) const;
+
+    /// Offset of the dataType copy of a compressed reserve space in the workspace.
+    size_t GetFullReserveOffset(Handle& handle,
+                                int seqLength,
+                                c_array_view<const miopenTensorDescriptor_t> xDesc) const;
+
+    /// Converts between the dataType copy of a compressed reserve space and the reserve space.
+    void CompressReserve(const Handle& handle,
+                         int seqLength,
+                         c_array_view<const miopenTensorDescriptor_t> xDesc,
+                         ConstData_t fullReserve,
+                         Data_t reserveSpace) const;
+    void DecompressReserve(const Handle& handle,
+                           int seqLength,
+                           c_array_view<const miopenTensorDescriptor_t> xDesc,
+                           ConstData_t reserveSpace,
+                           Data_t fullReserve) const;
+
     size_t
     GetParamsSize(Handle& handle, const TensorDescriptor& xDesc, miopenDataType_t dtype) const;
 
@@ -226,6 +269,66 @@ struct RNNDescriptor : miopenRNNDescriptor
                              Data_t workSpace,
                              size_t workSpaceSize) const;
 
+    /// Inference with parameters prepared once by RNNPreparedWeights.
+    void RNNForwardInference(Handle& handle,
+                             int seqLen,
+                             c_array_view<const miopenTensorDescriptor_t> xDesc,
+                             ConstData_t x,
+                             const TensorDescriptor& hxDesc,
+                             ConstData_t hx,
+                             const TensorDescriptor& cxDesc,
+                             ConstData_t cx,
+                             const RNNPreparedWeights& weights,
+                             c_array_view<const miopenTensorDescriptor_t> yDesc,
+                             Data_t y,
+                             const TensorDescriptor& hyDesc,
+                             Data_t hy,
+                             const TensorDescriptor& cyDesc,
+                             Data_t cy,
+                             Data_t workSpace,
+                             size_t workSpaceSize) const;
+
+    /// transposed_weights tells that every weight matrix of w is stored transposed, as laid
+    /// out by RNNPreparedWeights. With a non-null wei_q the recurrent GEMMs read the int8
+    /// recurrent matrices of wei_q and their row scales wei_scale instead of those of w.
+    void RNNForwardInferenceImpl(Handle& handle,
+                                 int seqLen,
+                                 c_array_view<const miopenTensorDescriptor_t> xDesc,
+                                 ConstData_t x,
+                                 const TensorDescriptor& hxDesc,
+                                 ConstData_t hx,
+                                 const TensorDescriptor& cxDesc,
+                                 ConstData_t cx,
+                                 const TensorDescriptor& wDesc,
+                                 ConstData_t w,
+                                 bool transposed_weights,
+                                 ConstData_t wei_q,
+                                 ConstData_t wei_scale,
+                                 c_array_view<const miopenTensorDescriptor_t> yDesc,
+                                 Data_t y,
+                                 const TensorDescriptor& hyDesc,
+                                 Data_t hy,
+                                 const TensorDescriptor& cyDesc,
+                                 Data_t cy,
+                                 Data_t workSpace,
+                                 size_t workSpaceSize) const;
+
+    /// Inference of stacked unidirectional LSTM layers with the default algo, which runs
+    /// the cells of each (layer, time) diagonal concurrently.
+    void RNNForwardInferenceWavefront(Handle& handle,
+                                      const std::vector<int>& in_n,
+                                      int in_h,
+                                      ConstData_t x,
+                                      ConstData_t hx,
+                                      ConstData_t cx,
+                                      ConstData_t w,
+                                      bool transposed_weights,
+                                      Data_t hy,
+                                      Data_t cy,
+                                      Data_t workSpace,
+                                      int hy_n,
+                                      float& ctime) const;
+
     void RNNBackwardData(Handle& handle,
                          int seqLen,
                          c_array_view<const miopenTensorDescriptor_t> yDesc,
@@ -268,13 +371,92 @@ struct RNNDescriptor : miopenRNNDescriptor
                             ConstData_t reserveSpace,
                             size_t reserveSpaceSize) const;
 
+    /// LSTM with a projection of the hidden state, which the entry points above run in place
+    /// of the default algorithm. space is the reserve space in training and the workspace in
+    /// inference.
+    void LSTMProjectionForward(Handle& handle,
+                               int seqLen,
+                               c_array_view<const miopenTensorDescriptor_t> xDesc,
+                               ConstData_t x,
+                               const TensorDescriptor& hxDesc,
+                               ConstData_t hx,
+                               const TensorDescriptor& cxDesc,
+                               ConstData_t cx,
+                               ConstData_t w,
+                               c_array_view<const miopenTensorDescriptor_t> yDesc,
+                               Data_t y,
+                               Data_t hy,
+                               Data_t cy,
+                               Data_t space,
+                               bool is_inference) const;
+
+    void LSTMProjectionBackwardData(Handle& handle,
+                                    int seqLen,
+                                    c_array_view<const miopenTensorDescriptor_t> dyDesc,
+                                    ConstData_t dy,
+                                    ConstData_t dhy,
+                                    ConstData_t dcy,
+                                    ConstData_t w,
+                                    const TensorDescriptor& hxDesc,
+                                    const TensorDescriptor& cxDesc,
+                                    ConstData_t cx,
+                                    c_array_view<const miopenTensorDescriptor_t> dxDesc,
+                                    Data_t dx,
+                                    Data_t dhx,
+                                    Data_t dcx,
+                                    Data_t workSpace,
+                                    Data_t reserveSpace) const;
+
+    void LSTMProjectionBackwardWeights(Handle& handle,
+                                       int seqLen,
+                                       c_array_view<const miopenTensorDescriptor_t> xDesc,
+                                       ConstData_t x,
+                                       const TensorDescriptor& hxDesc,
+                                       ConstData_t hx,
+                                       c_array_view<const miopenTensorDescriptor_t> dyDesc,
+                                       Data_t dw,
+                                       ConstData_t workSpace,
+                                       ConstData_t reserveSpace) const;
+
     inline bool isNotRNNskip() const { return inputMode != miopenRNNskip; }
     inline bool isRNNskip() const { return inputMode == miopenRNNskip; }
 };
 
 std::ostream& operator<<(std::ostream& stream, const RNNDescriptor& r);
 
+/// Copy of the parameters of an RNN in the layout the inference GEMMs read without
+/// transposition: every weight matrix is stored transposed, as K rows of the gates of all the
+/// directions, at the offset it has in the canonical layout. The biases are copied as they are.
+///
+/// Quantized weights instead keep the canonical layout for the input matrices and the biases,
+/// and hold the recurrent matrices of every layer as int8, one float scale per row.
+struct RNNPreparedWeights : miopenRNNPreparedWeights
+{
+    RNNPreparedWeights(Handle& handle,
+                       const RNNDescriptor& rnn,
+                       const TensorDescriptor& xDesc,
+                       const TensorDescriptor& wDesc,
+                       ConstData_t w,
+                       bool quantize = false);
+
+    /// Whether the weights were prepared for rnn and input vectors of length in_h.
+    bool IsPreparedFor(const RNNDescriptor& rnn, int in_h) const;
+
+    RNNDescriptor rnnDesc;
+    int inputSize;
+    TensorDescriptor wDesc;
+    Allocator::ManageDataPtr data;
+    bool quantized;
+    /// Recurrent matrices of layer li at li * wei_stride * hsize, their scales at
+    /// li * wei_stride, where wei_stride is the number of gate rows of all the directions.
+    Allocator::ManageDataPtr quantizedData;
+    Allocator::ManageDataPtr scales;
+};
+
+std::ostream& operator<<(std::ostream& stream, const RNNPreparedWeights& w);
+
 } // namespace miopen
 MIOPEN_DEFINE_OBJECT(miopenRNNDescriptor, miopen::RNNDescriptor);
+MIOPEN_DEFINE_OBJECT(miopenRNNPreparedWeights, miopen::RNNPreparedWeights);
 
 #endif // GUARD_MIOPEN_RNN_HPP_
@@ -0,0 +1,103 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_RNN_STREAMING_HPP_
+#define GUARD_MIOPEN_RNN_STREAMING_HPP_
+
+#include <miopen/allocator.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/object.hpp>
+#include <miopen/rnn.hpp>
+#include <miopen/tensor.hpp>
+
+#include <array>
+#include <cstddef>
+#include <iosfwd>
+
+namespace miopen {
+
+/// Inference of a unidirectional RNN over a sequence which arrives in chunks from the host. The
+/// hidden (and cell) state stays on the device between the chunks. Every chunk is uploaded on
+/// a stream of its own into one of two staging buffers, and its output downloaded on another
+/// from one of two more, so that the copies of the next and the previous chunks overlap the
+/// inference of the current one on the stream of the handle.
+struct RNNStreamingState : miopenRNNStreamingState
+{
+    RNNStreamingState(Handle& handle,
+                      const RNNDescriptor& rnn,
+                      const TensorDescriptor& xDesc,
+                      const TensorDescriptor& hxDesc,
+                      int maxChunkLen);
+    RNNStreamingState(const RNNStreamingState&) = delete;
+    RNNStreamingState& operator=(const RNNStreamingState&) = delete;
+    ~RNNStreamingState();
+
+    /// Sets the state to hx and cx, or to zeros for null pointers, on the stream of the handle.
+    void Reset(const Handle& handle, ConstData_t hx, ConstData_t cx);
+
+    /// Enqueues the upload of x, the inference of the chunk and the download of y, and returns.
+    /// x shall stay unchanged and y shall not be read until Synchronize().
+    void Forward(Handle& handle,
+                 int chunkLen,
+                 c_array_view<const miopenTensorDescriptor_t> xDesc,
+                 const void* x,
+                 const TensorDescriptor& wDesc,
+                 ConstData_t w,
+                 c_array_view<const miopenTensorDescriptor_t> yDesc,
+                 void* y,
+                 Data_t workSpace,
+                 size_t workSpaceSize);
+
+    /// Waits for the uploads and the downloads of all the chunks enqueued so far.
+    void Synchronize() const;
+
+    RNNDescriptor rnnDesc;
+    TensorDescriptor hxDesc;
+    int maxChunkLen;
+    std::size_t xChunkSize;
+    std::size_t yChunkSize;
+
+    private:
+    Handle upload;
+    Handle download;
+    std::array<Allocator::ManageDataPtr, 2> xStage;
+    std::array<Allocator::ManageDataPtr, 2> yStage;
+    /// The chunk of an even count reads the state from [0] and writes it to [1].
+    std::array<Allocator::ManageDataPtr, 2> hState;
+    std::array<Allocator::ManageDataPtr, 2> cState;
+    /// The last inference which read xStage[i] and wrote yStage[i], and the last download of
+    /// yStage[i].
+    std::array<StreamEvent, 2> computed;
+    std::array<StreamEvent, 2> downloaded;
+    std::size_t chunkCount = 0;
+};
+
+std::ostream& operator<<(std::ostream& stream, const RNNStreamingState& s);
+
+} // namespace miopen
+MIOPEN_DEFINE_OBJECT(miopenRNNStreamingState, miopen::RNNStreamingState);
+
+#endif // GUARD_MIOPEN_RNN_STREAMING_HPP_
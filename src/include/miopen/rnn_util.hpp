@@ -55,7 +55,11 @@ void LSTMForwardHiddenStateUpdate(const Handle& handle,
                                   std::size_t cell_offset,
                                   std::size_t cell_offset_pre,
                                   std::size_t activ_cell_offset,
-                                  std::size_t hidden_offset);
+                                  std::size_t hidden_offset,
+                                  ConstData_t w,
+                                  std::size_t bias_offset,
+                                  bool use_bias,
+                                  bool use_hx);
 
 void LSTMBackwardHiddenStateUpdate(const Handle& handle,
                                    miopenDataType_t rnn_data_type,
@@ -90,6 +94,104 @@ void LSTMBackwardHiddenStateUpdate(const Handle& handle,
                                    std::size_t dcell_offset_pre,
                                    std::size_t dhidden_offset,
                                    std::size_t f_offset_pre);
+
+/// Fused GRU cell: activates the z, r and c gates, applies the reset gate to the recurrent part
+/// of the c gate and interpolates the hidden state. In training the activated gates go to
+/// activ_offset past the GEMM results.
+void GRUForwardHiddenStateUpdate(const Handle& handle,
+                                 miopenDataType_t rnn_data_type,
+                                 bool is_inference,
+                                 bool is_seq_begin,
+                                 int direction,
+                                 int max_batch,
+                                 int cur_batch,
+                                 int use_batch,
+                                 int hy_h,
+                                 int hy_stride,
+                                 ConstData_t hx,
+                                 std::size_t hx_offset,
+                                 Data_t reserve_space,
+                                 std::size_t z_offset,
+                                 std::size_t r_offset,
+                                 std::size_t c_offset,
+                                 std::size_t hidden_offset,
+                                 std::size_t hidden_offset_pre,
+                                 std::size_t activ_offset);
+
+/// Gate gradients of the fused GRU cell, from the activated gates stored in the reserve space.
+void GRUBackwardHiddenStateUpdate(const Handle& handle,
+                                  miopenDataType_t rnn_data_type,
+                                  bool is_seq_begin,
+                                  int direction,
+                                  int max_batch,
+                                  int cur_batch,
+                                  int use_batch,
+                                  int hy_h,
+                                  int hy_stride,
+                                  ConstData_t hx,
+                                  std::size_t hx_offset,
+                                  Data_t reserve_space,
+                                  std::size_t z_offset,
+                                  std::size_t r_offset,
+                                  std::size_t c_offset,
+                                  std::size_t hidden_offset,
+                                  std::size_t hidden_offset_pre,
+                                  Data_t work_space,
+                                  std::size_t dz_offset,
+                                  std::size_t dr_offset,
+                                  std::size_t dc_offset,
+                                  std::size_t dhidden_offset);
+
+/// c[i][j] += scale[j] * dot(a[i], w[j]) for the m rows of a and the n rows of the int8 matrix
+/// w, of k values each, as the recurrent GEMMs of RNN inference with quantized weights.
+void RNNQuantizedGemm(const Handle& handle,
+                      miopenDataType_t rnn_data_type,
+                      int m,
+                      int n,
+                      int k,
+                      ConstData_t a,
+                      std::size_t a_offset,
+                      int lda,
+                      ConstData_t w,
+                      std::size_t w_offset,
+                      ConstData_t scale,
+                      std::size_t scale_offset,
+                      Data_t c,
+                      std::size_t c_offset,
+                      int ldc);
+
+/// Whether the recurrent part of a unidirectional layer with a constant batch size fits
+/// the persistent inference kernel on this device.
+bool IsRNNPersistentInferenceApplicable(const Handle& handle,
+                                        miopenDataType_t rnn_data_type,
+                                        miopenRNNMode_t rnn_mode,
+                                        int batch,
+                                        int hy_h);
+
+/// Runs all the time steps of one layer in a single launch. The workspace shall hold the
+/// input projections and biases of every step. sync[sync_index] is the counter used for
+/// the global barriers, and shall be zero. With a non-null w_scale the recurrent weights are
+/// int8 rows, each scaled by its float of w_scale from scale_offset.
+void RNNPersistentForwardInference(const Handle& handle,
+                                   miopenDataType_t rnn_data_type,
+                                   miopenRNNMode_t rnn_mode,
+                                   int seq_len,
+                                   int batch,
+                                   int hy_h,
+                                   int hy_stride,
+                                   int hid_off,
+                                   int cell_off,
+                                   ConstData_t w,
+                                   std::size_t wei_offset,
+                                   ConstData_t w_scale,
+                                   std::size_t scale_offset,
+                                   ConstData_t hx,
+                                   ConstData_t cx,
+                                   std::size_t hx_offset,
+                                   Data_t work_space,
+                                   std::size_t hid_offset,
+                                   Data_t sync,
+                                   int sync_index);
 } // namespace miopen
 
 #endif // GUARD_MIOPEN_RNN_UTIL_HPP_
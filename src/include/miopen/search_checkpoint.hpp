@@ -0,0 +1,83 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_SEARCH_CHECKPOINT_HPP_
+#define GUARD_MIOPEN_SEARCH_CHECKPOINT_HPP_
+
+#include <boost/optional.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace solver {
+
+/// State of a GenericSearch after the first configs of the search space.
+struct SearchProgress
+{
+    std::size_t total      = 0; // Size of the search space, a mismatch discards the checkpoint.
+    std::size_t next       = 0; // First config not measured yet.
+    float best_time        = std::numeric_limits<float>::max();
+    std::size_t best_index = 0;
+    std::string best_config; // Serialized, empty if no config has passed.
+    std::vector<std::size_t> failed;
+
+    void Serialize(std::ostream& stream) const;
+    bool Deserialize(const std::string& str);
+};
+
+/// Periodic checkpoints of GenericSearch, enabled by MIOPEN_SEARCH_CHECKPOINT_INTERVAL (seconds).
+/// The progress is saved to search_checkpoints.txt in the user db directory, so a search that
+/// has been killed resumes after the last config measured before the checkpoint. The
+/// checkpoint is removed when the search completes.
+class SearchCheckpoint
+{
+    public:
+    /// The shard index tells apart the checkpoints of the sharded searches of one problem.
+    SearchCheckpoint(const std::string& solver, const std::string& problem, int shard = -1);
+
+    bool IsEnabled() const { return interval.count() > 0; }
+
+    /// Returns the saved progress of a search over a space of the given size, if any.
+    boost::optional<SearchProgress> Load(std::size_t total) const;
+    /// Saves the progress if the interval has elapsed since the last save.
+    void Update(const SearchProgress& progress);
+    void Remove() const;
+
+    private:
+    std::string key;
+    std::string id;
+    std::chrono::seconds interval;
+    std::chrono::steady_clock::time_point last_save;
+};
+
+} // namespace solver
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_SEARCH_CHECKPOINT_HPP_
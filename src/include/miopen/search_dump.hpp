@@ -0,0 +1,66 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_SEARCH_DUMP_HPP_
+#define GUARD_MIOPEN_SEARCH_DUMP_HPP_
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+
+namespace miopen {
+namespace solver {
+
+/// Dump of every config measured by GenericSearch, enabled by MIOPEN_SEARCH_DUMP_DIR. One CSV
+/// file is written per solver and problem, named <solver>_<md5 of the problem>.csv, with the
+/// problem on the first line as a comment and a row per config:
+///   index,config,time_ms,runs,failed,compile_ms
+/// The config is serialized as in the perf-db and quoted. time_ms is the mean of the runs made
+/// (one for the configs pruned after the first run) and compile_ms the time to prepare the
+/// invoker in the search loop, which only includes the build of the kernels when they were not
+/// built ahead (MIOPEN_DEBUG_SEARCH_COMPILE_AHEAD=0 to measure all of them).
+class SearchDump
+{
+    public:
+    /// The shard index is appended to the file name of the sharded searches.
+    SearchDump(const std::string& solver, const std::string& problem, int shard = -1);
+
+    bool IsEnabled() const { return file.is_open(); }
+
+    void Add(std::size_t index,
+             const std::string& config,
+             float time_ms,
+             std::size_t runs,
+             bool failed,
+             float compile_ms);
+
+    private:
+    std::ofstream file;
+};
+
+} // namespace solver
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_SEARCH_DUMP_HPP_
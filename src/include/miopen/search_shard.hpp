@@ -0,0 +1,77 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_SEARCH_SHARD_HPP_
+#define GUARD_MIOPEN_SEARCH_SHARD_HPP_
+
+#include <boost/optional.hpp>
+
+#include <cstddef>
+#include <string>
+
+namespace miopen {
+namespace solver {
+
+/// Splits the search space of GenericSearch between several processes, typically
+/// one per GPU (e.g. with HIP_VISIBLE_DEVICES), which tune the same problems:
+///   MIOPEN_SEARCH_SHARDS=N MIOPEN_SEARCH_SHARD_INDEX=i
+/// Shard i measures configs i, i+N, i+2N,... only. When done, the shards exchange
+/// their best results through a file in the user db directory and every shard
+/// returns the overall best, so all of them write the same value to the perf-db.
+/// Runs that should not see each other's results must use distinct
+/// MIOPEN_SEARCH_SHARD_SESSION names.
+class SearchShard
+{
+    public:
+    SearchShard() = default;
+    SearchShard(std::size_t index_, std::size_t count_);
+
+    static SearchShard FromEnv();
+
+    bool IsEnabled() const { return count > 1; }
+    bool Owns(std::size_t n) const { return n % count == index; }
+    std::size_t Index() const { return index; }
+    std::size_t Count() const { return count; }
+
+    /// Forgets the result this shard may have left from a previous search.
+    void Reset(const std::string& problem, const std::string& solver) const;
+
+    /// Publishes the result of this shard and waits until all shards report or a
+    /// timeout expires (MIOPEN_SEARCH_SHARD_TIMEOUT, seconds).
+    /// Returns the serialized best config among the reported ones, none if all failed.
+    boost::optional<std::string> Merge(const std::string& problem,
+                                       const std::string& solver,
+                                       const boost::optional<std::string>& local_best,
+                                       float local_time) const;
+
+    private:
+    std::size_t index = 0;
+    std::size_t count = 1;
+};
+
+} // namespace solver
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_SEARCH_SHARD_HPP_
@@ -61,5 +61,14 @@ miopenStatus_t SoftmaxBackward(const Handle& handle,
                                int dy_offset = 0,
                                int dx_offset = 0);
 
+miopenStatus_t SoftmaxCrossEntropy(const Handle& handle,
+                                   const TensorDescriptor& xDesc,
+                                   ConstData_t x,
+                                   ConstData_t labels,
+                                   const TensorDescriptor& lossDesc,
+                                   Data_t loss,
+                                   const TensorDescriptor& dxDesc,
+                                   Data_t dx);
+
 } // namespace miopen
 #endif // _MIOPEN_SOFTMAX_HPP_
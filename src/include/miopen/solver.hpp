@@ -33,6 +33,7 @@
 #include <miopen/logger.hpp>
 #include <miopen/mlo_internal.hpp>
 #include <miopen/legacy_exhaustive_search.hpp>
+#include <miopen/solver_applicability.hpp>
 #include <miopen/type_name.hpp>
 #include <miopen/miopen.h>
 #include <miopen/buffer_info.hpp>
@@ -116,6 +117,16 @@ struct SolverBase
     /// run-time parameters.
     bool IsDynamic() const { return false; }
 
+    /// Most solvers assume the default (NCHW/NCDHW, KCYX) memory layout and are
+    /// not even asked about problems with other layouts (e.g. NHWC). Solvers that
+    /// address tensors through their actual strides shall return true.
+    bool IsLayoutAgnostic() const { return false; }
+
+    /// Coarse properties of the problems the solver may be applicable to, see
+    /// applicability::Traits. Solvers not asked about other problems save the time of
+    /// IsApplicable(). Everything is admitted by default.
+    applicability::Traits GetApplicabilityTraits() const { return {}; }
+
     // Returns the workspace size required by the solver for a given ConvolutionContext
     size_t GetWorkspaceSize(const Context&) const { return 0; };
 
@@ -157,6 +168,11 @@ struct PerformanceConfigConvAsm3x3U : Serializable<PerformanceConfigConvAsm3x3U>
 struct ConvAsm3x3U : SolverBase<ConvolutionContext>
 {
     bool IsApplicable(const ConvolutionContext& params) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.SpatialDims(Dims2).Types(Fp32).Families(Gfx8 | Gfx9);
+    }
     PerformanceConfigConvAsm3x3U GetPerformanceConfig(const ConvolutionContext&) const;
     bool IsValidPerformanceConfig(const ConvolutionContext&,
                                   const PerformanceConfigConvAsm3x3U&) const;
@@ -219,6 +235,15 @@ struct PerformanceConfigConvAsm1x1U : Serializable<PerformanceConfigConvAsm1x1U>
     bool IsValid(const ConvolutionContext& config) const;
     bool operator==(const PerformanceConfigConvAsm1x1U& other) const;
     std::string ToString() const;
+
+    private:
+    int GetVgprCount(const ConvolutionContext& config) const;
+    /// Share of the workgroup slots of the GPU, over all the waves of workgroups needed for
+    /// the grid, which the grid keeps busy.
+    double GetWaveFill(const ConvolutionContext& config) const;
+    /// Trades tile size for a fuller last wave of workgroups, see
+    /// MIOPEN_DEBUG_CONV_DIRECT_ASM_1X1U_BALANCE_WAVES.
+    void BalanceWaves(const ConvolutionContext& config);
 };
 
 struct ConvAsm1x1U : SolverBase<ConvolutionContext>
@@ -229,6 +254,11 @@ struct ConvAsm1x1U : SolverBase<ConvolutionContext>
     PerformanceConfigConvAsm1x1U Search(const ConvolutionContext&,
                                         const AnyInvokeParams& invoke_ctx) const;
     bool IsApplicable(const ConvolutionContext& params) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.SpatialDims(Dims2).Types(Fp32 | Fp16 | Bfp16).Families(Gfx8 | Gfx9);
+    }
     size_t GetWorkspaceSize(const ConvolutionContext& params) const;
     ConvSolution GetSolution(const ConvolutionContext& params,
                              const PerformanceConfigConvAsm1x1U& config,
@@ -325,6 +355,11 @@ struct ConvAsm1x1UV2 : SolverBase<ConvolutionContext>
     PerformanceConfigConvAsm1x1UV2 Search(const ConvolutionContext&,
                                           const AnyInvokeParams& invoke_ctx) const;
     bool IsApplicable(const ConvolutionContext& params) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.SpatialDims(Dims2).Types(Fp32).Families(Gfx8 | Gfx9);
+    }
     ConvSolution GetSolution(const ConvolutionContext& params,
                              const PerformanceConfigConvAsm1x1UV2& config,
                              bool disableConfigOverrideFromEnv = false) const;
@@ -333,36 +368,66 @@ struct ConvAsm1x1UV2 : SolverBase<ConvolutionContext>
 struct ConvAsm5x10u2v2f1 : SolverBase<ConvolutionContext>
 {
     bool IsApplicable(const ConvolutionContext& params) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.Directions(Fwd).SpatialDims(Dims2).Families(Gfx8 | Gfx9);
+    }
     ConvSolution GetSolution(const ConvolutionContext& params) const;
 };
 
 struct ConvAsm5x10u2v2b1 : SolverBase<ConvolutionContext>
 {
     bool IsApplicable(const ConvolutionContext& params) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.Directions(Bwd).SpatialDims(Dims2).Families(Gfx8 | Gfx9);
+    }
     ConvSolution GetSolution(const ConvolutionContext& params) const;
 };
 
 struct ConvAsm7x7c3h224w224k64u2v2p3q3f1 : SolverBase<ConvolutionContext>
 {
     bool IsApplicable(const ConvolutionContext& params) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.Directions(Fwd).SpatialDims(Dims2).Families(Gfx8 | Gfx9);
+    }
     ConvSolution GetSolution(const ConvolutionContext& params) const;
 };
 
 struct ConvOclDirectFwd11x11 : SolverBase<ConvolutionContext>
 {
     bool IsApplicable(const ConvolutionContext& params) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.Directions(Fwd).SpatialDims(Dims2).Types(Fp32 | Fp16 | Bfp16).NoGroups();
+    }
     ConvSolution GetSolution(const ConvolutionContext& params) const;
 };
 
 struct ConvOclDirectFwdGen : SolverBase<ConvolutionContext>
 {
     bool IsApplicable(const ConvolutionContext& params) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.SpatialDims(Dims2).Types(Fp32 | Fp16 | Bfp16).NoGroups();
+    }
     ConvSolution GetSolution(const ConvolutionContext& params) const;
 };
 
 struct ConvOclDirectFwd3x3 : SolverBase<ConvolutionContext>
 {
     bool IsApplicable(const ConvolutionContext& params) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.Directions(Fwd).SpatialDims(Dims2).Types(Fp32 | Fp16 | Bfp16).NoGroups();
+    }
     ConvSolution GetSolution(const ConvolutionContext& params) const;
 };
 
@@ -749,6 +814,11 @@ struct ConvHipImplicitGemmV4R1Fwd : SolverBase<ConvolutionContext>
                                   const PerformanceImplicitGemmV4R1& c) const;
 
     bool IsApplicable(const ConvolutionContext& ctx) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.Directions(Fwd).SpatialDims(Dims2).Types(Fp32 | Fp16 | Bfp16);
+    }
     ConvSolution GetSolution(const ConvolutionContext& ctx,
                              const PerformanceImplicitGemmV4R1& config,
                              bool disableConfigOverrideFromEnv = false) const;
@@ -761,6 +831,11 @@ struct ConvHipImplicitGemmV4R4Fwd : SolverBase<ConvolutionContext>
 {
     static std::tuple<int, int, int> CalculateGemmSize(const ConvolutionContext& ctx);
     bool IsApplicable(const ConvolutionContext& ctx) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.Directions(Fwd).SpatialDims(Dims2 | Dims3).Types(Fp32).NoGroups();
+    }
     PerformanceImplicitGemmV4R4Fwd GetPerformanceConfig(const ConvolutionContext& ctx) const;
     bool IsValidPerformanceConfig(const ConvolutionContext& ctx,
                                   const PerformanceImplicitGemmV4R4Fwd& config) const;
@@ -822,6 +897,11 @@ struct ConvHipImplicitGemmV4R4GenXdlopsFwdFp32 : SolverBase<ConvolutionContext>
     bool IsValidPerformanceConfig(const ConvolutionContext& ctx,
                                   const PerformanceImplicitGemmV4R4GenXdlopsFwdFp32& c) const;
     bool IsApplicable(const ConvolutionContext& ctx) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.Directions(Fwd).SpatialDims(Dims2).Types(Fp32);
+    }
     ConvSolution GetSolution(const ConvolutionContext& ctx,
                              const PerformanceImplicitGemmV4R4GenXdlopsFwdFp32& config,
                              bool disableConfigOverrideFromEnv = false) const;
@@ -833,7 +913,16 @@ struct ConvHipImplicitGemmV4R4GenXdlopsFwdFp32 : SolverBase<ConvolutionContext>
 struct ConvHipImplicitGemmV4R4WrW : SolverBase<ConvolutionContext>
 {
     static std::tuple<int, int, int> CalculateGemmSize(const ConvolutionContext& ctx);
+    /// Number of batch groups GemmK is split into. Each group accumulates a partial
+    /// weight gradient in the workspace, so that small batches still occupy all CUs.
+    static int CalculateGemmKGroups(const ConvolutionContext& ctx);
     bool IsApplicable(const ConvolutionContext& ctx) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.Directions(WrW).SpatialDims(Dims2 | Dims3).Types(Fp32).NoGroups();
+    }
+    size_t GetWorkspaceSize(const ConvolutionContext& ctx) const;
     PerformanceImplicitGemmV4R4WrW GetPerformanceConfig(const ConvolutionContext& ctx) const;
     bool IsValidPerformanceConfig(const ConvolutionContext& ctx,
                                   const PerformanceImplicitGemmV4R4WrW& config) const;
@@ -999,6 +1088,11 @@ struct ConvHipImplicitGemmV4R4GenFwdXdlops : SolverBase<ConvolutionContext>
     bool IsValidPerformanceConfig(const ConvolutionContext& ctx,
                                   const PerformanceImplicitGemmXdlops& c) const;
     bool IsApplicable(const ConvolutionContext& ctx) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.Directions(Fwd).SpatialDims(Dims2).Types(Fp16 | Bfp16);
+    }
     ConvSolution GetSolution(const ConvolutionContext& ctx,
                              const PerformanceImplicitGemmXdlops& config,
                              bool disableConfigOverrideFromEnv = false) const;
@@ -1015,6 +1109,14 @@ struct ConvHipImplicitGemmForwardV4R4Xdlops : SolverBase<ConvolutionContext>
     bool IsValidPerformanceConfig(const ConvolutionContext& ctx,
                                   const PerformanceImplicitGemmForwardV4R4Xdlops& c) const;
     bool IsApplicable(const ConvolutionContext& ctx) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}
+            .Directions(Fwd)
+            .SpatialDims(Dims2 | Dims3)
+            .Types(Fp32 | Fp16 | Bfp16 | Int8);
+    }
     ConvSolution GetSolution(const ConvolutionContext& ctx,
                              const PerformanceImplicitGemmForwardV4R4Xdlops& config,
                              bool disableConfigOverrideFromEnv = false) const;
@@ -1091,6 +1193,11 @@ struct ConvHipImplicitGemmV4R4GenWrWXdlops : SolverBase<ConvolutionContext>
     bool IsValidPerformanceConfig(const ConvolutionContext& ctx,
                                   const PerformanceImplicitGemmXdlops& c) const;
     bool IsApplicable(const ConvolutionContext& ctx) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.Directions(WrW).SpatialDims(Dims2).Types(Fp32 | Fp16 | Bfp16);
+    }
     size_t GetWorkspaceSize(const ConvolutionContext& ctx) const;
     ConvSolution GetSolution(const ConvolutionContext& ctx,
                              const PerformanceImplicitGemmXdlops& config,
@@ -1105,6 +1212,11 @@ struct ConvHipImplicitGemmV4R1WrW : SolverBase<ConvolutionContext>
     bool IsValidPerformanceConfig(const ConvolutionContext& ctx,
                                   const PerformanceImplicitGemmV4R1& c) const;
     bool IsApplicable(const ConvolutionContext& ctx) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.Directions(WrW).SpatialDims(Dims2).Types(Fp32 | Fp16 | Bfp16);
+    }
     ConvSolution GetSolution(const ConvolutionContext& ctx,
                              const PerformanceImplicitGemmV4R1& config,
                              bool disableConfigOverrideFromEnv = false) const;
@@ -1117,6 +1229,11 @@ struct ConvHipImplicitGemmBwdDataV1R1 : SolverBase<ConvolutionContext>
 {
     static std::tuple<int, int, int> CalculateGemmSize(const ConvolutionContext& ctx);
     bool IsApplicable(const ConvolutionContext& ctx) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.Directions(Bwd).SpatialDims(Dims2 | Dims3).Types(Fp32 | Bfp16).NoGroups();
+    }
     PerformanceImplicitGemmBwdDataV1R1 GetPerformanceConfig(const ConvolutionContext& ctx) const;
     bool IsValidPerformanceConfig(const ConvolutionContext& ctx,
                                   const PerformanceImplicitGemmBwdDataV1R1& config) const;
@@ -1133,6 +1250,11 @@ struct ConvHipImplicitGemmBwdDataV4R1 : SolverBase<ConvolutionContext>
     static int CalculateNumberOfGemm(const ConvolutionContext& ctx);
     static std::tuple<int, int, int> CalculateGemmSize(const ConvolutionContext& ctx, int gemm_id);
     bool IsApplicable(const ConvolutionContext& ctx) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.Directions(Bwd).SpatialDims(Dims2 | Dims3).Types(Fp32).NoGroups();
+    }
     PerformanceImplicitGemmBwdDataV4R1 GetPerformanceConfig(const ConvolutionContext& ctx) const;
     bool IsValidPerformanceConfig(const ConvolutionContext& ctx,
                                   const PerformanceImplicitGemmBwdDataV4R1& config) const;
@@ -1153,6 +1275,11 @@ struct ConvHipImplicitGemmBwdDataV4R1Xdlops : SolverBase<ConvolutionContext>
     bool IsValidPerformanceConfig(const ConvolutionContext& ctx,
                                   const PerformanceImplicitGemmBwdDataV4R1Xdlops& c) const;
     bool IsApplicable(const ConvolutionContext& ctx) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.Directions(Bwd).SpatialDims(Dims2 | Dims3).Types(Fp32 | Fp16 | Bfp16);
+    }
     ConvSolution GetSolution(const ConvolutionContext& ctx,
                              const PerformanceImplicitGemmBwdDataV4R1Xdlops& config,
                              bool disableConfigOverrideFromEnv = false) const;
@@ -1167,6 +1294,11 @@ struct ConvHipImplicitGemmBwdDataV1R1Xdlops : SolverBase<ConvolutionContext>
     bool IsValidPerformanceConfig(const ConvolutionContext& ctx,
                                   const PerformanceImplicitGemmBwdV1R1Xdlops& c) const;
     bool IsApplicable(const ConvolutionContext& ctx) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.Directions(Bwd).SpatialDims(Dims2).Types(Fp32 | Fp16 | Bfp16);
+    }
     size_t GetWorkspaceSize(const ConvolutionContext& ctx) const;
     ConvSolution GetSolution(const ConvolutionContext& ctx,
                              const PerformanceImplicitGemmBwdV1R1Xdlops& config,
@@ -1178,20 +1310,37 @@ struct ConvHipImplicitGemmBwdDataV1R1Xdlops : SolverBase<ConvolutionContext>
 struct ConvAsmImplicitGemmV4R1DynamicFwd : SolverBase<ConvolutionContext>
 {
     bool IsApplicable(const ConvolutionContext& ctx) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.Directions(Fwd).SpatialDims(Dims2).Families(Gfx9).NoGroups();
+    }
     bool IsDynamic() const { return true; }
+    size_t GetWorkspaceSize(const ConvolutionContext& ctx) const;
     ConvSolution GetSolution(const ConvolutionContext& ctx) const;
 };
 
 struct ConvAsmImplicitGemmV4R1DynamicFwd_1x1 : SolverBase<ConvolutionContext>
 {
     bool IsApplicable(const ConvolutionContext& ctx) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.Directions(Fwd).SpatialDims(Dims2).Families(Gfx9).NoGroups();
+    }
     bool IsDynamic() const { return true; }
+    size_t GetWorkspaceSize(const ConvolutionContext& ctx) const;
     ConvSolution GetSolution(const ConvolutionContext& ctx) const;
 };
 
 struct ConvAsmImplicitGemmV4R1DynamicWrw : SolverBase<ConvolutionContext>
 {
     bool IsApplicable(const ConvolutionContext& ctx) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.Directions(WrW).SpatialDims(Dims2).Families(Gfx9).NoGroups();
+    }
     bool IsDynamic() const { return true; }
     size_t GetWorkspaceSize(const ConvolutionContext& ctx) const;
     ConvSolution GetSolution(const ConvolutionContext& ctx) const;
@@ -1200,10 +1349,137 @@ struct ConvAsmImplicitGemmV4R1DynamicWrw : SolverBase<ConvolutionContext>
 struct ConvAsmImplicitGemmV4R1DynamicBwd : SolverBase<ConvolutionContext>
 {
     bool IsApplicable(const ConvolutionContext&) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.Directions(Bwd).SpatialDims(Dims2).Families(Gfx9).NoGroups();
+    }
     bool IsDynamic() const { return true; }
+    size_t GetWorkspaceSize(const ConvolutionContext& ctx) const;
     ConvSolution GetSolution(const ConvolutionContext&) const;
 };
 
+/// The reduction over C * Y * X is split between GemmKBlocks blocks, which add their
+/// partial outputs in place with atomics. It fills the CUs when N * Ho * Wo is small.
+struct PerformanceImplicitGemmFwdV4R4XdlopsDynamic
+    : Serializable<PerformanceImplicitGemmFwdV4R4XdlopsDynamic>
+{
+    int GemmKBlocks; // 2^n[1..64]
+
+    PerformanceImplicitGemmFwdV4R4XdlopsDynamic(int GemmKBlocks_);
+    PerformanceImplicitGemmFwdV4R4XdlopsDynamic()
+        : PerformanceImplicitGemmFwdV4R4XdlopsDynamic(-1)
+    {
+    }
+    PerformanceImplicitGemmFwdV4R4XdlopsDynamic(bool)
+        : PerformanceImplicitGemmFwdV4R4XdlopsDynamic(1)
+    {
+    }
+
+    template <class Self, class F>
+    static void Visit(Self&& self, F f)
+    {
+        f(self.GemmKBlocks, "GemmKBlocks");
+    }
+
+    void EuristicInit(const ConvolutionContext& ctx);
+    bool IsValidValue() const;
+    bool SetNextValue();
+    bool IsValid(const ConvolutionContext& ctx) const;
+    bool operator==(const PerformanceImplicitGemmFwdV4R4XdlopsDynamic& other) const;
+    std::string ToString() const;
+};
+
+/// xdlops implicit GEMM convolutions with the problem sizes, including the group count,
+/// passed as kernel arguments. The tile is selected from a small fixed set, so a new
+/// shape does not trigger a kernel build.
+struct ConvHipImplicitGemmForwardV4R4XdlopsDynamic : SolverBase<ConvolutionContext>
+{
+    PerformanceImplicitGemmFwdV4R4XdlopsDynamic
+    GetPerformanceConfig(const ConvolutionContext& ctx) const;
+    bool IsValidPerformanceConfig(const ConvolutionContext& ctx,
+                                  const PerformanceImplicitGemmFwdV4R4XdlopsDynamic& c) const;
+    PerformanceImplicitGemmFwdV4R4XdlopsDynamic Search(const ConvolutionContext& ctx,
+                                                       const AnyInvokeParams& invoke_ctx) const;
+
+    bool IsApplicable(const ConvolutionContext& ctx) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.Directions(Fwd);
+    }
+    bool IsDynamic() const { return true; }
+    ConvSolution GetSolution(const ConvolutionContext& ctx,
+                             const PerformanceImplicitGemmFwdV4R4XdlopsDynamic& config,
+                             bool disableConfigOverrideFromEnv = false) const;
+};
+
+struct ConvHipImplicitGemmBwdDataV4R1XdlopsDynamic : SolverBase<ConvolutionContext>
+{
+    bool IsApplicable(const ConvolutionContext& ctx) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.Directions(Bwd);
+    }
+    bool IsDynamic() const { return true; }
+    ConvSolution GetSolution(const ConvolutionContext& ctx) const;
+};
+
+/// The reduction over N * Ho * Wo is split between GemmKBlocks blocks, which add their
+/// partial weight gradients in place with atomics, so no workspace is needed.
+struct PerformanceImplicitGemmWrwV4R4XdlopsDynamic
+    : Serializable<PerformanceImplicitGemmWrwV4R4XdlopsDynamic>
+{
+    int GemmKBlocks; // 2^n[1..64]
+
+    PerformanceImplicitGemmWrwV4R4XdlopsDynamic(int GemmKBlocks_);
+    PerformanceImplicitGemmWrwV4R4XdlopsDynamic()
+        : PerformanceImplicitGemmWrwV4R4XdlopsDynamic(-1)
+    {
+    }
+    PerformanceImplicitGemmWrwV4R4XdlopsDynamic(bool)
+        : PerformanceImplicitGemmWrwV4R4XdlopsDynamic(1)
+    {
+    }
+
+    template <class Self, class F>
+    static void Visit(Self&& self, F f)
+    {
+        f(self.GemmKBlocks, "GemmKBlocks");
+    }
+
+    void EuristicInit(const ConvolutionContext& ctx);
+    bool IsValidValue() const;
+    bool SetNextValue();
+    bool IsValid(const ConvolutionContext& ctx) const;
+    bool operator==(const PerformanceImplicitGemmWrwV4R4XdlopsDynamic& other) const;
+    std::string ToString() const;
+};
+
+struct ConvHipImplicitGemmWrwV4R4XdlopsDynamic : SolverBase<ConvolutionContext>
+{
+    PerformanceImplicitGemmWrwV4R4XdlopsDynamic
+    GetPerformanceConfig(const ConvolutionContext& ctx) const;
+    bool IsValidPerformanceConfig(const ConvolutionContext& ctx,
+                                  const PerformanceImplicitGemmWrwV4R4XdlopsDynamic& c) const;
+    PerformanceImplicitGemmWrwV4R4XdlopsDynamic Search(const ConvolutionContext& ctx,
+                                                       const AnyInvokeParams& invoke_ctx) const;
+
+    bool IsApplicable(const ConvolutionContext& ctx) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.Directions(WrW);
+    }
+    bool IsDynamic() const { return true; }
+    /// Partial results of the K blocks in the deterministic mode.
+    size_t GetWorkspaceSize(const ConvolutionContext& ctx) const;
+    ConvSolution GetSolution(const ConvolutionContext& ctx,
+                             const PerformanceImplicitGemmWrwV4R4XdlopsDynamic& config,
+                             bool disableConfigOverrideFromEnv = false) const;
+};
+
 /// Holds common member functions for the Solvers which share the same
 /// "legacy exhaustive search" machinery.
 struct ConvOclDirectFwdLegacyExhaustiveSearch : SolverBase<ConvolutionContext>
@@ -1220,6 +1496,11 @@ struct ConvOclDirectFwdLegacyExhaustiveSearch : SolverBase<ConvolutionContext>
 struct ConvOclDirectFwd : ConvOclDirectFwdLegacyExhaustiveSearch
 {
     bool IsApplicable(const ConvolutionContext& params) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.SpatialDims(Dims2).Types(Fp32 | Fp16 | Bfp16);
+    }
 
     ConvSolution GetSolution(const ConvolutionContext& params,
                              const LegacyPerformanceConfig& searched_params) const;
@@ -1238,6 +1519,11 @@ struct ConvOclDirectFwdFused : ConvOclDirectFwd
 struct ConvOclDirectFwd1x1 : ConvOclDirectFwdLegacyExhaustiveSearch
 {
     bool IsApplicable(const ConvolutionContext& params) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.SpatialDims(Dims2).Types(Fp32 | Fp16 | Bfp16).NoGroups();
+    }
     ConvSolution GetSolution(const ConvolutionContext& params,
                              const LegacyPerformanceConfig& searched_params) const;
     bool IsValidPerformanceConfig(const ConvolutionContext&, const LegacyPerformanceConfig&) const
@@ -1249,6 +1535,11 @@ struct ConvOclDirectFwd1x1 : ConvOclDirectFwdLegacyExhaustiveSearch
 struct ConvBinWinograd3x3U : SolverBase<ConvolutionContext>
 {
     bool IsApplicable(const ConvolutionContext& params) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.SpatialDims(Dims2).Families(Gfx8 | Gfx9);
+    }
     bool IsDynamic() const { return true; }
     ConvSolution GetSolution(const ConvolutionContext& params) const;
 };
@@ -1256,6 +1547,11 @@ struct ConvBinWinograd3x3U : SolverBase<ConvolutionContext>
 struct ConvBinWinogradRxS : SolverBase<ConvolutionContext>
 {
     bool IsApplicable(const ConvolutionContext& params) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.SpatialDims(Dims2).Types(Fp32 | Fp16);
+    }
     bool IsDynamic() const { return true; }
     ConvSolution GetSolution(const ConvolutionContext& params) const;
 };
@@ -1263,10 +1559,37 @@ struct ConvBinWinogradRxS : SolverBase<ConvolutionContext>
 struct ConvBinWinogradRxSf3x2 : SolverBase<ConvolutionContext>
 {
     bool IsApplicable(const ConvolutionContext& params) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}
+            .Directions(Fwd | Bwd)
+            .SpatialDims(Dims2)
+            .Types(Fp32)
+            .Families(Gfx9)
+            .NoGroups();
+    }
     bool IsDynamic() const { return true; }
     ConvSolution GetSolution(const ConvolutionContext& params) const;
 };
 
+/// Dilated stride-1 convolutions by the interleaved sub-grid decomposition: the input is
+/// split into dilation_h * dilation_w sub-grids batched along N, the undilated sub-problem is
+/// solved by the wrapped Winograd solver and the outputs are merged back.
+struct ConvBinWinogradRxSDilated : SolverBase<ConvolutionContext>
+{
+    bool IsApplicable(const ConvolutionContext& ctx) const;
+    size_t GetWorkspaceSize(const ConvolutionContext& ctx) const;
+    ConvSolution GetSolution(const ConvolutionContext& ctx) const;
+};
+
+struct ConvBinWinogradRxSf3x2Dilated : SolverBase<ConvolutionContext>
+{
+    bool IsApplicable(const ConvolutionContext& ctx) const;
+    size_t GetWorkspaceSize(const ConvolutionContext& ctx) const;
+    ConvSolution GetSolution(const ConvolutionContext& ctx) const;
+};
+
 struct PerformanceConfigConvBinWinogradRxSf2x3
     : Serializable<PerformanceConfigConvBinWinogradRxSf2x3>
 {
@@ -1299,6 +1622,11 @@ struct ConvBinWinogradRxSf2x3 : SolverBase<ConvolutionContext>
                                                    const AnyInvokeParams& invoke_ctx) const;
 
     bool IsApplicable(const ConvolutionContext& params) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.SpatialDims(Dims2).Types(Fp32 | Fp16).Families(Gfx9);
+    }
     bool IsDynamic() const { return true; }
     ConvSolution GetSolution(const ConvolutionContext& params,
                              const PerformanceConfigConvBinWinogradRxSf2x3& config,
@@ -1320,6 +1648,11 @@ template <int WinoDataH, int WinoFilterH, int WinoDataW = WinoDataH, int WinoFil
 struct ConvMPBidirectWinograd : SolverBase<ConvolutionContext>
 {
     bool IsApplicable(const ConvolutionContext& params) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.SpatialDims(Dims2).Directions(Fwd | Bwd).Types(Fp32);
+    }
     bool IsDynamic() const { return true; }
     size_t GetWorkspaceSize(const ConvolutionContext& params) const;
     ConvSolution GetSolution(const ConvolutionContext& params) const;
@@ -1457,6 +1790,11 @@ struct ConvAsmBwdWrW3x3 : SolverBase<ConvolutionContext>
     PerformanceConfigAsmDirect3x3WrW Search(const ConvolutionContext&,
                                             const AnyInvokeParams& invoke_ctx) const;
     bool IsApplicable(const ConvolutionContext& params) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.SpatialDims(Dims2).Types(Fp32 | Fp16).Families(Gfx8 | Gfx9);
+    }
     ConvSolution GetSolution(const ConvolutionContext& params,
                              const PerformanceConfigAsmDirect3x3WrW& config,
                              bool disableConfigOverrideFromEnv = false) const;
@@ -1561,6 +1899,11 @@ struct ConvAsmBwdWrW1x1 : SolverBase<ConvolutionContext>
     PerformanceConfigConvAsmBwdWrW1x1 Search(const ConvolutionContext&,
                                              const AnyInvokeParams& invoke_ctx) const;
     bool IsApplicable(const ConvolutionContext& params) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.SpatialDims(Dims2).Types(Fp32 | Fp16 | Bfp16).Families(Gfx8 | Gfx9);
+    }
     size_t GetWorkspaceSize(const ConvolutionContext& params) const;
     ConvSolution GetSolution(const ConvolutionContext& params,
                              const PerformanceConfigConvAsmBwdWrW1x1& config,
@@ -1674,6 +2017,11 @@ struct ConvOclBwdWrW2NonTunable : ConvOclBwdWrW2<1>
 struct ConvOclBwdWrW53 : SolverBase<ConvolutionContext>
 {
     bool IsApplicable(const ConvolutionContext& params) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.Directions(WrW).SpatialDims(Dims2).Types(Fp32 | Fp16 | Bfp16);
+    }
     size_t GetWorkspaceSize(const ConvolutionContext& params) const;
     ConvSolution GetSolution(const ConvolutionContext& params) const;
 };
@@ -1681,10 +2029,107 @@ struct ConvOclBwdWrW53 : SolverBase<ConvolutionContext>
 struct ConvOclBwdWrW1x1 : SolverBase<ConvolutionContext>
 {
     bool IsApplicable(const ConvolutionContext& params) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.SpatialDims(Dims2).Types(Fp32 | Fp16 | Bfp16).NoGroups();
+    }
     ConvSolution GetSolution(const ConvolutionContext& params) const;
     size_t GetWorkspaceSize(const ConvolutionContext& params) const;
 };
 
+/// Reference-style direct convolutions which address all tensors through their
+/// actual strides, and thus support any memory layout (NHWC etc) without conversion.
+/// Used when no layout-specific solver applies.
+struct ConvDirectNaiveConvFwd : SolverBase<ConvolutionContext>
+{
+    bool IsApplicable(const ConvolutionContext& params) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.Directions(Fwd);
+    }
+    bool IsDynamic() const { return true; }
+    bool IsLayoutAgnostic() const { return true; }
+    ConvSolution GetSolution(const ConvolutionContext& params) const;
+};
+
+struct ConvDirectNaiveConvBwd : SolverBase<ConvolutionContext>
+{
+    bool IsApplicable(const ConvolutionContext& params) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.Directions(Bwd);
+    }
+    bool IsDynamic() const { return true; }
+    bool IsLayoutAgnostic() const { return true; }
+    ConvSolution GetSolution(const ConvolutionContext& params) const;
+};
+
+struct ConvDirectNaiveConvWrw : SolverBase<ConvolutionContext>
+{
+    bool IsApplicable(const ConvolutionContext& params) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.Directions(WrW);
+    }
+    bool IsDynamic() const { return true; }
+    bool IsLayoutAgnostic() const { return true; }
+    ConvSolution GetSolution(const ConvolutionContext& params) const;
+};
+
+/// Direct depthwise convolutions (group count equal to the input channels, channel
+/// multiplier 1 or 2) with 3x3 or 5x5 filters and stride 1 or 2. Each work-item keeps
+/// a tile of outputs, its input window and the weights in registers.
+struct ConvDirectDepthwiseFwd : SolverBase<ConvolutionContext>
+{
+    bool IsApplicable(const ConvolutionContext& params) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.Directions(Fwd);
+    }
+    ConvSolution GetSolution(const ConvolutionContext& params) const;
+};
+
+struct ConvDirectDepthwiseBwd : SolverBase<ConvolutionContext>
+{
+    bool IsApplicable(const ConvolutionContext& params) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.Directions(Bwd);
+    }
+    ConvSolution GetSolution(const ConvolutionContext& params) const;
+};
+
+struct ConvDirectDepthwiseWrw : SolverBase<ConvolutionContext>
+{
+    bool IsApplicable(const ConvolutionContext& params) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.Directions(WrW);
+    }
+    ConvSolution GetSolution(const ConvolutionContext& params) const;
+};
+
+/// Strided backward data, which is also the forward pass of transposed convolutions, as
+/// stride_h * stride_w dense sub-convolutions of dy, one per phase of dx, so that no
+/// work is spent on the zeros a stride inserts between dy elements.
+struct ConvDirectTransposePhaseBwd : SolverBase<ConvolutionContext>
+{
+    bool IsApplicable(const ConvolutionContext& params) const;
+    applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace applicability;
+        return Traits{}.Directions(Bwd).SpatialDims(Dims2).Types(Fp32 | Fp16 | Bfp16);
+    }
+    ConvSolution GetSolution(const ConvolutionContext& params) const;
+};
+
 /// Partial implementation.
 struct gemm : SolverBase<ConvolutionContext>
 {
@@ -0,0 +1,173 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef MIOPEN_GUARD_MLOPEN_SOLVER_APPLICABILITY_HPP
+#define MIOPEN_GUARD_MLOPEN_SOLVER_APPLICABILITY_HPP
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+struct ConvolutionContext;
+
+namespace solver {
+
+struct AnySolver;
+struct Id;
+
+template <class Solver>
+const std::string& SolverDbId(Solver solver);
+
+namespace applicability {
+
+struct ProblemResults;
+
+// Bits of the coarse properties of a problem.
+constexpr unsigned Fwd = 1 << 0;
+constexpr unsigned Bwd = 1 << 1;
+constexpr unsigned WrW = 1 << 2;
+
+constexpr unsigned Fp32       = 1 << 0;
+constexpr unsigned Fp16       = 1 << 1;
+constexpr unsigned Bfp16      = 1 << 2;
+constexpr unsigned Int8       = 1 << 3;
+constexpr unsigned OtherTypes = 1 << 4;
+
+constexpr unsigned Dims2     = 1 << 0;
+constexpr unsigned Dims3     = 1 << 1;
+constexpr unsigned OtherDims = 1 << 2;
+
+constexpr unsigned Gfx8          = 1 << 0;
+constexpr unsigned Gfx9          = 1 << 1;
+constexpr unsigned Gfx10         = 1 << 2;
+constexpr unsigned OtherFamilies = 1 << 3;
+
+/// Direction, weights data type, spatial dims, group mode and device family of a problem,
+/// a bit of each.
+struct Key
+{
+    unsigned direction    = 0;
+    unsigned type         = 0;
+    unsigned spatial_dims = 0;
+    unsigned family       = 0;
+    bool grouped          = false;
+
+    static Key From(const ConvolutionContext& ctx);
+    int Encode() const;
+};
+
+/// Problems a solver may be applicable to. These are necessary conditions taken from the
+/// unconditional early exits of IsApplicable(), which is not called for other problems.
+/// Solvers that declare nothing are asked about every problem.
+struct Traits
+{
+    unsigned directions   = ~0u;
+    unsigned types        = ~0u;
+    unsigned spatial_dims = ~0u;
+    unsigned families     = ~0u;
+    bool groups           = true;
+
+    Traits& Directions(unsigned value)
+    {
+        directions = value;
+        return *this;
+    }
+    Traits& Types(unsigned value)
+    {
+        types = value;
+        return *this;
+    }
+    Traits& SpatialDims(unsigned value)
+    {
+        spatial_dims = value;
+        return *this;
+    }
+    Traits& Families(unsigned value)
+    {
+        families = value;
+        return *this;
+    }
+    Traits& NoGroups()
+    {
+        groups = false;
+        return *this;
+    }
+
+    bool Admits(const Key& key) const
+    {
+        return (directions & key.direction) != 0 && (types & key.type) != 0 &&
+               (spatial_dims & key.spatial_dims) != 0 && (families & key.family) != 0 &&
+               (groups || !key.grouped);
+    }
+};
+
+/// Registered solver ids that are not excluded by their traits for problems with the key,
+/// in the order of registration, see GetAllIds(). Ids without a solver are always listed.
+const std::vector<Id>& GetCandidateIds(const Key& key);
+
+/// IsApplicable() results of the solvers for one problem, shared by all memos of the problem
+/// within the process. Find, the solution count and immediate mode calls thus check each solver
+/// once per problem. The problem is identified by its db key together with the tensor strides,
+/// the device and the execution flags that solvers look at. MIOPEN_DEBUG_CONV_APPLICABILITY_INDEX=0
+/// disables both the memo and the traits.
+class Memo
+{
+    public:
+    explicit Memo(const ConvolutionContext& ctx);
+
+    /// Same as solver.IsApplicable(ctx), ctx must describe the problem of the memo.
+    template <class Solver>
+    bool IsApplicable(const Solver& solver, const ConvolutionContext& ctx) const
+    {
+        return IsApplicableImpl(solver.GetApplicabilityTraits(), SolverDbId(solver), [&]() {
+            return solver.IsApplicable(ctx);
+        });
+    }
+    bool IsApplicable(const AnySolver& solver, const ConvolutionContext& ctx) const;
+
+    /// Entries are dropped when more problems than this are memoized.
+    static constexpr std::size_t max_problems = 4096;
+
+    private:
+    bool IsApplicableImpl(const Traits& traits,
+                          const std::string& solver,
+                          const std::function<bool()>& is_applicable) const;
+
+    Key key;
+    bool enabled = false;
+    std::shared_ptr<ProblemResults> results;
+};
+
+/// Empties the memo of all problems, e.g. for tests.
+void ClearMemo();
+
+} // namespace applicability
+} // namespace solver
+} // namespace miopen
+
+#endif
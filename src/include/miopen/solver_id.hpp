@@ -32,6 +32,7 @@
 
 #include <cstdint>
 #include <unordered_map>
+#include <vector>
 
 namespace miopen {
 namespace solver {
@@ -50,6 +51,7 @@ struct Id
     std::string ToString() const;
     AnySolver GetSolver() const;
     std::string GetAlgo(conv::Direction dir) const;
+    miopenConvAlgorithm_t GetAlgorithm() const;
 
     bool IsValid() const { return is_valid; }
     uint64_t Value() const { return value; }
@@ -78,6 +80,9 @@ struct Id
     bool is_valid  = false;
 };
 
+/// Returns all registered ids in the order of registration.
+std::vector<Id> GetAllIds();
+
 } // namespace solver
 } // namespace miopen
 
@@ -41,12 +41,16 @@
 #include <boost/thread.hpp>
 #include <boost/thread/thread_time.hpp>
 #include "sqlite3.h"
+#include <algorithm>
+#include <cmath>
 #include <mutex>
 #include <thread>
 
 #include <string>
 #include <chrono>
+#include <functional>
 #include <unordered_map>
+#include <vector>
 
 namespace boost {
 namespace filesystem {
@@ -77,7 +81,25 @@ struct SQLiteSerializable
 
         return names;
     }
-    std::tuple<std::string, std::vector<std::string>> WhereClause() const
+    /// 64-bit FNV-1a hash of the field VALUES in the order of WhereClause(). It is the indexed
+    /// integer key of the table, rows that collide on it are told apart by the full clause.
+    static int64_t HashValues(const std::vector<std::string>& values)
+    {
+        const uint64_t prime = 1099511628211ull;
+        uint64_t hash        = 14695981039346656037ull;
+        for(const auto& value : values)
+        {
+            for(const auto c : value)
+                hash = (hash ^ static_cast<unsigned char>(c)) * prime;
+            // Separates the values, so that {"ab", "c"} and {"a", "bc"} differ.
+            hash = (hash ^ 0xffu) * prime;
+        }
+        return static_cast<int64_t>(hash);
+    }
+    int64_t Hash() const { return HashValues(std::get<1>(WhereClause())); }
+    /// WITH_HASH leads the clause by the hash column, so that the lookup seeks its index. The
+    /// rest of the clause rejects the rows of colliding problems.
+    std::tuple<std::string, std::vector<std::string>> WhereClause(bool with_hash = false) const
     {
         std::vector<std::string> values;
         std::vector<std::string> clauses;
@@ -91,10 +113,17 @@ struct SQLiteSerializable
                            clauses.push_back("(" + name + " = ? )");
                            values.push_back(std::to_string(value));
                        });
+        if(with_hash)
+        {
+            clauses.insert(clauses.begin(), "(hash = ? )");
+            values.insert(values.begin(), std::to_string(HashValues(values)));
+        }
         std::string clause = JoinStrings(clauses, " AND ");
         return std::make_tuple(clause, values);
     }
-    std::tuple<std::string, std::vector<std::string>> InsertQuery() const
+    /// WITH_HASH also fills the hash column. The hashed tables have no unique index to ignore
+    /// the existing rows, so the row is only inserted if the lookup by the hash finds none.
+    std::tuple<std::string, std::vector<std::string>> InsertQuery(bool with_hash = false) const
     {
         std::vector<std::string> int_names, str_names, values;
         Derived::Visit(static_cast<const Derived&>(*this),
@@ -107,12 +136,31 @@ struct SQLiteSerializable
                            int_names.push_back(name);
                            values.push_back(std::to_string(value));
                        });
+        if(with_hash)
+        {
+            const auto hash = HashValues(values);
+            int_names.push_back("hash");
+            values.push_back(std::to_string(hash));
+        }
         std::vector<std::string> tokens((values.size()), "?");
         ;
 
-        std::string q = "INSERT OR IGNORE INTO " + Derived::table_name() + "( " +
-                        JoinStrings(str_names, ",") + "," + JoinStrings(int_names, ",") +
-                        " ) VALUES( " + JoinStrings(tokens, ",") + ");";
+        const auto columns = "( " + JoinStrings(str_names, ",") + "," +
+                             JoinStrings(int_names, ",") + " )";
+        if(with_hash)
+        {
+            std::string clause;
+            std::vector<std::string> where_values;
+            std::tie(clause, where_values) = WhereClause(true);
+            const auto q = "INSERT INTO " + Derived::table_name() + columns + " SELECT " +
+                           JoinStrings(tokens, ",") + " WHERE NOT EXISTS ( SELECT 1 FROM " +
+                           Derived::table_name() + " WHERE " + clause + " );";
+            values.insert(values.end(), where_values.begin(), where_values.end());
+            return std::make_tuple(q, values);
+        }
+
+        std::string q = "INSERT OR IGNORE INTO " + Derived::table_name() + columns +
+                        " VALUES( " + JoinStrings(tokens, ",") + ");";
         return std::make_tuple(q, values);
     }
     std::tuple<std::string, std::vector<std::string>> SelectQuery() const
@@ -145,11 +193,12 @@ struct SQLiteSerializable
             ss << ",`" << el << "` TEXT NOT NULL";
         for(auto& el : int_fields)
             ss << ",`" << el << "` INT NOT NULL";
+        ss << ",`hash` INT NOT NULL DEFAULT 0";
         ss << ");";
-        ss << "CREATE UNIQUE INDEX IF NOT EXISTS "
-           << "`idx_" << Derived::table_name() << "` "
-           << "ON " << Derived::table_name() << "( " << miopen::JoinStrings(str_fields, ",") << ", "
-           << miopen::JoinStrings(int_fields, ",") << " );";
+        // The hash is the only index, it is much smaller than one over all the fields.
+        ss << "CREATE INDEX IF NOT EXISTS "
+           << "`idx_" << Derived::table_name() << "_hash` "
+           << "ON " << Derived::table_name() << "( hash );";
         return ss.str();
     }
 };
@@ -185,6 +234,26 @@ class SQLite
         int BindInt64(int idx, int64_t);
     };
 
+    /// Lends a connection of a pool of read-only connections to the database, so that the
+    /// threads reading it do not serialize on one connection. The pool holds up to
+    /// MIOPEN_DEBUG_SQLITE_READ_CONNECTIONS connections (the number of hardware threads by
+    /// default). The connection of the database itself is lent when the pool is exhausted, and
+    /// while a write-behind transaction is pending, as the other connections do not see its
+    /// writes yet.
+    class Reader
+    {
+        public:
+        explicit Reader(const SQLite& sql_);
+        ~Reader();
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+        const SQLite& Get() const { return connection != nullptr ? *connection : sql; }
+
+        private:
+        const SQLite& sql;
+        std::unique_ptr<SQLite> connection;
+    };
+
     using result_type = std::vector<std::unordered_map<std::string, std::string>>;
     SQLite();
     SQLite(const std::string& filename_, bool is_system);
@@ -194,10 +263,21 @@ class SQLite
     SQLite& operator=(const SQLite&) = delete;
     bool Valid() const;
     result_type Exec(const std::string& query) const;
+    /// Runs the write within a transaction shared with the writes that follow, which saves
+    /// a disk sync per write. The transaction is committed once it is older than the interval
+    /// (also from a background thread), by Flush(), FlushAll() and on destruction.
+    /// Only user database files support this, otherwise the write is done right away.
+    void WriteBehind(const std::function<void()>& write, std::chrono::milliseconds interval) const;
+    void Flush() const;
+    /// Commits pending writes of all open databases.
+    static void FlushAll();
     int Changes() const;
     int Retry(std::function<int()>) const;
     static int Retry(std::function<int()> f, std::string filename);
     std::string ErrorMessage() const;
+
+    private:
+    explicit SQLite(std::unique_ptr<impl> pImpl_);
 };
 
 template <typename Derived>
@@ -325,6 +405,12 @@ class SQLiteBase
         return reinterpret_cast<Derived*>(this)->LoadUnsafe(args...);
     }
 
+    template <typename... U>
+    inline auto LoadNearest(U&&... args)
+    {
+        return reinterpret_cast<Derived*>(this)->LoadNearestUnsafe(args...);
+    }
+
     std::string filename;
     std::string arch;
     size_t num_cu;
@@ -354,7 +440,11 @@ Derived& SQLiteBase<Derived>::GetCached(const std::string& path,
 class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
 {
     public:
-    static constexpr char const* MIOPEN_PERFDB_SCHEMA_VER = "1.0.0";
+    /// 1.1.0 keys the config table by the hash of the problem, see SQLiteSerializable.
+    static constexpr char const* MIOPEN_PERFDB_SCHEMA_VER = "1.1.0";
+    /// Names the user perf-db file. It is not bumped with the schema, which is migrated in place,
+    /// so that the tuning in the existing files is kept.
+    static constexpr char const* MIOPEN_USER_PERFDB_FILE_VER = "1.0.0";
     SQLitePerfDb(const std::string& filename_,
                  bool is_system,
                  const std::string& arch_,
@@ -365,7 +455,7 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
     {
         std::string clause;
         std::vector<std::string> vals;
-        std::tie(clause, vals) = prob_desc.InsertQuery();
+        std::tie(clause, vals) = prob_desc.InsertQuery(hashed);
         auto stmt = SQLite::Statement{sql, clause, vals};
         auto rc   = stmt.Step(sql);
         if(rc != SQLITE_DONE)
@@ -379,7 +469,7 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
     {
         std::string clause;
         std::vector<std::string> vals;
-        std::tie(clause, vals) = prob_desc.WhereClause();
+        std::tie(clause, vals) = prob_desc.WhereClause(hashed);
         auto query = "SELECT id FROM " + prob_desc.table_name() + " WHERE ( " + clause + " );";
         auto stmt  = SQLite::Statement{sql, query, vals};
         while(true)
@@ -400,7 +490,7 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
             return boost::none;
         std::string clause;
         std::vector<std::string> values;
-        std::tie(clause, values) = problem_config.WhereClause();
+        std::tie(clause, values) = problem_config.WhereClause(hashed);
         // clang-format off
         auto select_query =
             "SELECT solver, params "
@@ -412,17 +502,19 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
             "AND (arch = '" + arch + "' ) "
             "AND (num_cu = '" + std::to_string(num_cu) + "');";
         // clang-format on
-        auto stmt = SQLite::Statement{sql, select_query, values};
+        const SQLite::Reader reader{sql};
+        const auto& conn = reader.Get();
+        auto stmt        = SQLite::Statement{conn, select_query, values};
         DbRecord rec;
         while(true)
         {
-            auto rc = stmt.Step(sql);
+            auto rc = stmt.Step(conn);
             if(rc == SQLITE_ROW)
                 rec.SetValues(stmt.ColumnText(0), stmt.ColumnText(1));
             else if(rc == SQLITE_DONE)
                 break;
             else if(rc == SQLITE_ERROR || rc == SQLITE_MISUSE)
-                MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+                MIOPEN_THROW(miopenStatusInternalError, conn.ErrorMessage());
         }
         if(rec.GetSize() == 0)
             return boost::none;
@@ -441,7 +533,7 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
             return false;
         std::string clause;
         std::vector<std::string> values;
-        std::tie(clause, values) = problem_config.WhereClause();
+        std::tie(clause, values) = problem_config.WhereClause(hashed);
         // clang-format off
         auto query =
             "DELETE FROM perf_db "
@@ -470,11 +562,40 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
     {
         if(dbInvalid)
             return boost::none;
+        boost::optional<DbRecord> record;
+        sql.WriteBehind([&]() { record = UpdateNow(problem_config, id, values); },
+                        WriteBehindInterval());
+        return record;
+    }
+
+    /// Interval of committing the updates of a user perf-db,
+    /// MIOPEN_DEBUG_PERFDB_WRITE_BEHIND_MS (0 by default, which commits each update).
+    static std::chrono::milliseconds WriteBehindInterval();
+
+    template <class T, class V>
+    inline bool StoreRecordUnsafe(const T& problem_config, const std::string& id, const V& values)
+    {
+        if(dbInvalid)
+            return false;
+        return bool(UpdateUnsafe(problem_config, id, values));
+    }
+
+    private:
+    /// The config table has the hash column. The files of the schema 1.0.0 do not, the user
+    /// ones get it as they are opened.
+    bool hashed = false;
+
+    void AddConfigHashes();
+
+    template <class T, class V>
+    inline boost::optional<DbRecord>
+    UpdateNow(const T& problem_config, const std::string& id, const V& values)
+    {
         // UPSERT the value
         {
             std::string clause;
             std::vector<std::string> vals;
-            std::tie(clause, vals) = problem_config.InsertQuery();
+            std::tie(clause, vals) = problem_config.InsertQuery(hashed);
             auto stmt = SQLite::Statement{sql, clause, vals};
             auto rc   = stmt.Step(sql);
             if(rc != SQLITE_DONE)
@@ -490,7 +611,7 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
             values.Serialize(params);
             std::string clause;
             std::vector<std::string> vals;
-            std::tie(clause, vals) = problem_config.WhereClause();
+            std::tie(clause, vals) = problem_config.WhereClause(hashed);
 
             // clang-format off
             std::string query =
@@ -518,13 +639,7 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
         return record;
     }
 
-    template <class T, class V>
-    inline bool StoreRecordUnsafe(const T& problem_config, const std::string& id, const V& values)
-    {
-        if(dbInvalid)
-            return false;
-        return bool(UpdateUnsafe(problem_config, id, values));
-    }
+    public:
 
     /**
      * clears both the config and the associated solver values from the database
@@ -536,7 +651,7 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
             return true;
         std::string clause;
         std::vector<std::string> values;
-        std::tie(clause, values) = problem_config.WhereClause();
+        std::tie(clause, values) = problem_config.WhereClause(hashed);
         // clang-format off
         auto query =
             "DELETE FROM perf_db "
@@ -572,6 +687,99 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
             return false;
         return record->GetValues(id, values);
     }
+
+    /// Searches the records of the solver ID for the problems which differ from PROBLEM_CONFIG
+    /// only in the T::NearestFieldNames() columns, and gets the VALUES of the closest one which
+    /// IS_VALID accepts. The distance of two problems is the sum of the absolute log2 ratios of
+    /// those columns.
+    ///
+    /// Returns the distance of the problem the VALUES were taken from, or none if no problem
+    /// gave valid VALUES.
+    template <class T, class V, class TValid>
+    inline boost::optional<double> LoadNearestUnsafe(const T& problem_config,
+                                                     const std::string& id,
+                                                     V& values,
+                                                     const TValid& is_valid)
+    {
+        if(dbInvalid)
+            return boost::none;
+
+        const auto& nearest_names = T::NearestFieldNames();
+        std::vector<std::string> clauses;
+        std::vector<std::string> vals;
+        std::vector<std::string> columns;
+        std::vector<int> sizes;
+        T::Visit(problem_config, [&](const std::string& value, const std::string& name) {
+            clauses.push_back("(" + name + " = ? )");
+            vals.push_back(value);
+        });
+        T::Visit(problem_config, [&](const int value, const std::string name) {
+            if(std::find(nearest_names.begin(), nearest_names.end(), name) != nearest_names.end())
+            {
+                columns.push_back(name);
+                sizes.push_back(value);
+            }
+            else
+            {
+                clauses.push_back("(" + name + " = ? )");
+                vals.push_back(std::to_string(value));
+            }
+        });
+        vals.push_back(id);
+
+        // clang-format off
+        auto select_query =
+            "SELECT params, " + JoinStrings(columns, ", ") + " "
+            "FROM perf_db "
+            "INNER JOIN " + problem_config.table_name() + " "
+            "ON perf_db.config = " + problem_config.table_name() +".id "
+            "WHERE "
+            "( " + JoinStrings(clauses, " AND ") + " )"
+            "AND (solver = ? ) "
+            "AND (arch = '" + arch + "' ) "
+            "AND (num_cu = '" + std::to_string(num_cu) + "');";
+        // clang-format on
+        std::vector<std::pair<double, std::string>> candidates;
+        {
+            const SQLite::Reader reader{sql};
+            const auto& conn = reader.Get();
+            auto stmt        = SQLite::Statement{conn, select_query, vals};
+            while(true)
+            {
+                auto rc = stmt.Step(conn);
+                if(rc == SQLITE_ROW)
+                {
+                    auto distance = 0.0;
+                    for(std::size_t i = 0; i < sizes.size(); ++i)
+                    {
+                        const auto size =
+                            std::max<int64_t>(stmt.ColumnInt64(static_cast<int>(i) + 1), 1);
+                        distance += std::abs(std::log2(static_cast<double>(size) /
+                                                       std::max(sizes[i], 1)));
+                    }
+                    candidates.emplace_back(distance, stmt.ColumnText(0));
+                }
+                else if(rc == SQLITE_DONE)
+                    break;
+                else if(rc == SQLITE_ERROR || rc == SQLITE_MISUSE)
+                    MIOPEN_THROW(miopenStatusInternalError, conn.ErrorMessage());
+            }
+        }
+
+        std::stable_sort(candidates.begin(), candidates.end(), [](const auto& l, const auto& r) {
+            return l.first < r.first;
+        });
+        for(const auto& candidate : candidates)
+        {
+            V candidate_values;
+            if(candidate_values.Deserialize(candidate.second) && is_valid(candidate_values))
+            {
+                values = candidate_values;
+                return candidate.first;
+            }
+        }
+        return boost::none;
+    }
 };
 } // namespace miopen
 #endif
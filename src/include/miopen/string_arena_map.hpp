@@ -0,0 +1,89 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_STRING_ARENA_MAP_HPP_
+#define GUARD_MIOPEN_STRING_ARENA_MAP_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+/// Insert-only map from strings to strings for large read-mostly tables, such as the text
+/// system dbs. Keys and values are appended to one contiguous buffer and indexed by an
+/// open-addressing table of 32-bit slots, so an entry costs its text plus about 24 bytes
+/// instead of two heap-allocated strings and a hash node. A lookup reads one slot, one
+/// entry and the key text.
+///
+/// Entries are addressed by their index, in insertion order. Not thread-safe for writes.
+class StringArenaMap
+{
+    public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    /// Sizes the buffers for the given number of entries and bytes of text upfront.
+    void Reserve(std::size_t entry_count, std::size_t text_bytes);
+
+    /// Returns false, leaving the map unchanged, if the key is already present.
+    bool Emplace(const char* key, std::size_t key_size, const char* value, std::size_t value_size);
+    bool Emplace(const std::string& key, const std::string& value)
+    {
+        return Emplace(key.data(), key.size(), value.data(), value.size());
+    }
+
+    /// Index of the entry, or npos.
+    std::size_t Find(const std::string& key) const;
+
+    std::string GetKey(std::size_t index) const;
+    std::string GetValue(std::size_t index) const;
+
+    std::size_t Size() const { return entries.size(); }
+    bool Empty() const { return entries.empty(); }
+
+    private:
+    struct Entry
+    {
+        std::uint32_t hash;
+        std::uint32_t text_offset; // key immediately followed by value
+        std::uint32_t key_size;
+        std::uint32_t value_size;
+    };
+
+    static std::uint32_t Hash(const char* str, std::size_t size);
+    std::size_t FindImpl(const char* key, std::size_t key_size, std::uint32_t hash) const;
+    void Rehash(std::size_t slot_count);
+
+    std::vector<char> text;
+    std::vector<Entry> entries;
+    // entry index + 1, 0 for an empty slot; the size is a power of two
+    std::vector<std::uint32_t> slots;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_STRING_ARENA_MAP_HPP_
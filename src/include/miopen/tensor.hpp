@@ -166,6 +166,14 @@ struct TensorDescriptor : miopenTensorDescriptor
 
     bool IsPacked() const;
 
+    /// Returns the memory order of the dimensions, outermost first, as a permutation of
+    /// labels (one character per dimension, given in logical order). For example, a 4D
+    /// tensor with NHWC strides yields "NHWC" for labels "NCHW". Dimensions of length 1
+    /// do not affect the result.
+    std::string GetLayout(std::string labels) const;
+    /// True if dimensions are laid out in their logical order (e.g. NCHW, NCDHW).
+    bool IsDefaultLayout() const;
+
     bool operator==(const TensorDescriptor& rhs) const;
     bool operator!=(const TensorDescriptor& rhs) const;
     bool operator<(const TensorDescriptor& rhs) const;
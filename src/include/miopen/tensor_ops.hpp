@@ -193,6 +193,30 @@ void CastTensor(const Handle& handle,
                 int srcOffset = 0,
                 int dstOffset = 0);
 
+/// Affine quantization done by CastTensor along with the type conversion:
+/// dst = alpha * channelScales[c] * (src - srcZeroPoint) + dstZeroPoint
+struct CastTensorQuantization
+{
+    float srcZeroPoint = 0.0f;
+    float dstZeroPoint = 0.0f;
+    /// Integer destinations are always rounded to nearest even. Saturation clamps to the range
+    /// of the destination type instead of wrapping around.
+    bool saturate = false;
+    /// Optional fp32 device buffer with one scale per index of dimension channelDim.
+    ConstData_t channelScales = nullptr;
+    int channelDim            = 1;
+};
+
+void CastTensor(const Handle& handle,
+                const void* alpha,
+                const CastTensorQuantization& quant,
+                const TensorDescriptor& srcDesc,
+                ConstData_t src,
+                const TensorDescriptor& dstDesc,
+                Data_t dst,
+                int srcOffset = 0,
+                int dstOffset = 0);
+
 void TransformTensor(const Handle& handle,
                      const void* alpha,
                      const TensorDescriptor& xDesc,
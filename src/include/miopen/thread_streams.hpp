@@ -0,0 +1,50 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_THREAD_STREAMS_HPP
+#define GUARD_MIOPEN_THREAD_STREAMS_HPP
+
+#include <miopen/miopen.h>
+
+#include <cstddef>
+
+namespace miopen {
+namespace thread_streams {
+
+/// Per-thread overrides of the stream of a handle, see miopenSetThreadStream(). The handles are
+/// identified by a process-unique id rather than by address, so that a handle created at the
+/// address of a destroyed one doesn't pick up the stale overrides.
+std::size_t NewHandleId();
+
+/// Returns nullptr if the calling thread has no override for the handle. Note that the
+/// override itself may be the null (default) stream.
+const miopenAcceleratorQueue_t* Find(std::size_t handle_id);
+void Set(std::size_t handle_id, miopenAcceleratorQueue_t stream);
+void Clear(std::size_t handle_id);
+
+} // namespace thread_streams
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_THREAD_STREAMS_HPP
@@ -49,20 +49,21 @@ class Timer
     std::chrono::time_point<std::chrono::steady_clock> et;
 };
 
+/// Also records a span of the compilation when tracing, see miopen::trace.
 class CompileTimer
 {
-#if MIOPEN_BUILD_DEV
     Timer timer;
-#endif
+    trace::Clock::time_point trace_start = trace::Now();
+
     public:
-    CompileTimer()
-    {
-#if MIOPEN_BUILD_DEV
-        timer.start();
-#endif
-    }
+    CompileTimer() { timer.start(); }
+    /// Time since construction, stored with the code object in the binary cache.
+    float ElapsedMs() { return timer.elapsed_ms(); }
     void Log(const std::string& s1, const std::string& s2 = {})
     {
+        if(trace_start != trace::Clock::time_point{})
+            trace::AddSpan(
+                "compile", s2.empty() ? s1 : s1 + " " + s2, trace_start, trace::Clock::now());
 #if MIOPEN_BUILD_DEV
         MIOPEN_LOG_I2(
             s1 << (s2.empty() ? "" : " ") << s2 << " Compile Time, ms: " << timer.elapsed_ms());
@@ -0,0 +1,86 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_TRACE_HPP
+#define GUARD_MIOPEN_TRACE_HPP
+
+#include <chrono>
+#include <string>
+
+namespace miopen {
+namespace trace {
+
+/// Tracing of the library activity into a file of the Chrome trace event format, which
+/// chrome://tracing and Perfetto open. It is enabled by setting MIOPEN_TRACE_FILE to the path
+/// of the file, which is written at the process exit. The timestamps are of the steady clock
+/// (CLOCK_MONOTONIC on Linux), so the trace may be lined up with the traces of the frameworks.
+///
+/// The host spans are recorded per thread. The kernels go to a separate GPU track, each ending
+/// when the host saw it completed and lasting the time measured by the events of its launch.
+/// Tracing makes the launches synchronous, as profiling does.
+bool IsEnabled();
+
+using Clock = std::chrono::steady_clock;
+
+inline Clock::time_point Now() { return IsEnabled() ? Clock::now() : Clock::time_point{}; }
+
+/// Records a span of the calling thread. Does nothing unless tracing is enabled.
+void AddSpan(const char* category,
+             const std::string& name,
+             Clock::time_point start,
+             Clock::time_point end);
+
+/// Records a span of the calling thread from start, taken by Now(), to the current time.
+inline void AddSpanFrom(const char* category, const char* name, Clock::time_point start)
+{
+    if(start != Clock::time_point{})
+        AddSpan(category, name, start, Clock::now());
+}
+
+/// Records a kernel on the GPU track. Does nothing unless tracing is enabled.
+void AddKernel(const std::string& name, float elapsed_ms);
+
+/// Span of the calling thread from the construction to the destruction.
+class Span
+{
+    public:
+    Span(const char* category_, const char* name_)
+        : category(category_), name(name_), start(Now())
+    {
+    }
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+    ~Span() { AddSpanFrom(category, name, start); }
+
+    private:
+    const char* category;
+    const char* name;
+    Clock::time_point start;
+};
+
+} // namespace trace
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_TRACE_HPP
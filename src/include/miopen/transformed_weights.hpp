@@ -0,0 +1,73 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_TRANSFORMED_WEIGHTS_HPP_
+#define GUARD_MIOPEN_TRANSFORMED_WEIGHTS_HPP_
+
+#include <miopen/allocator.hpp>
+#include <miopen/common.hpp>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+
+namespace miopen {
+
+/// Filters of the convolutions of a handle in the form the kernels consume them (the FFT
+/// spectrum, the Winograd transform), kept between the calls when the convolution enables it,
+/// see MIOPEN_CONV_FFT_CACHE_WEIGHTS and MIOPEN_CONV_WINOGRAD_CACHE_WEIGHTS. The weights are
+/// recognized by their buffer, so these shall neither be written nor freed while the handle
+/// runs convolutions with them, which holds for inference. Each convolution keeps the
+/// transformed filters of its last weights. The threads sharing the handle may use the cache
+/// concurrently.
+class TransformedWeightsCache
+{
+    public:
+    /// Shared with the callers, so that filters replaced meanwhile stay valid while in use.
+    using Filters = std::shared_ptr<typename std::remove_pointer<Data_t>::type>;
+
+    /// The filters stored for these weights of the convolution, nullptr if there are none.
+    Filters Find(const std::string& key, ConstData_t weights) const;
+    /// Stores the filters of new weights of the convolution, replacing the previous ones.
+    /// Other threads may use them right away, so the kernels writing them shall be enqueued
+    /// on the handle already.
+    void Insert(const std::string& key, ConstData_t weights, Filters transformed);
+
+    private:
+    struct Entry
+    {
+        ConstData_t weights;
+        Filters transformed;
+    };
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, Entry> entries;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_TRANSFORMED_WEIGHTS_HPP_
@@ -0,0 +1,88 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_TUNING_BUNDLE_HPP_
+#define GUARD_MIOPEN_TUNING_BUNDLE_HPP_
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+struct ProblemDescription;
+
+/// What a process needs to run a set of convolution problems without Find and without compiling
+/// kernels: their find-db and perf-db records and the code objects of the solutions named in the
+/// find-db records. See miopenExportTuningBundle().
+struct TuningBundle
+{
+    struct Problem
+    {
+        /// Text db key, see ProblemDescription::Serialize().
+        std::string key;
+        /// Columns of the SQLite perf-db, in the order of ProblemDescription::Visit().
+        std::vector<std::pair<std::string, std::string>> text_fields;
+        std::vector<std::pair<std::string, int>> int_fields;
+        /// ID and VALUES of the records.
+        std::vector<std::pair<std::string, std::string>> find_db;
+        std::vector<std::pair<std::string, std::string>> perf_db;
+    };
+
+    struct CodeObject
+    {
+        /// Arguments of Handle::LoadProgram().
+        std::string program_name;
+        std::string params;
+        bool is_kernel_str = false;
+        std::string blob;
+    };
+
+    std::string device;
+    std::size_t num_cu = 0;
+    std::vector<Problem> problems;
+    std::vector<CodeObject> code_objects;
+
+    /// The format is binary safe: every string is prefixed by its size.
+    void Write(std::ostream& stream) const;
+    /// Throws miopenStatusBadParm if the stream does not hold a bundle.
+    static TuningBundle Read(std::istream& stream);
+};
+
+/// Problems without a find-db record are skipped. Code objects missing from the binary cache are
+/// built.
+void ExportTuningBundle(Handle& handle,
+                        const std::vector<ProblemDescription>& problems,
+                        const std::string& path);
+/// Adds the records to the user find-db and perf-db and the code objects to the user binary cache
+/// of the device of the handle.
+void ImportTuningBundle(Handle& handle, const std::string& path);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_TUNING_BUNDLE_HPP_
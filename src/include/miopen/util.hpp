@@ -48,7 +48,8 @@ float Im2ColGPU(
     const std::vector<int>& stride_spatial,
     const std::vector<int>& dilation_spatial,
     Data_t col,
-    miopenDataType_t type);
+    miopenDataType_t type,
+    std::size_t col_offset = 0);
 
 float Col2ImGPU(
     const Handle& handle,
@@ -63,7 +64,8 @@ float Col2ImGPU(
     const decltype(boost::adaptors::slice(std::vector<std::size_t>(), 0, 1))& in_spatial,
     Data_t im,
     std::size_t im_offset,
-    miopenDataType_t type);
+    miopenDataType_t type,
+    std::size_t col_offset = 0);
 
 float transpose_NCHW2CNHW(const Handle& handle,
                           int n,
@@ -0,0 +1,84 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_WORKSPACE_ARENA_HPP_
+#define GUARD_MIOPEN_WORKSPACE_ARENA_HPP_
+
+#include <miopen/allocator.hpp>
+
+#include <array>
+#include <cstddef>
+
+namespace miopen {
+
+struct Handle;
+
+/// Device memory of a handle which is reused from call to call instead of being allocated on
+/// the fly. All the work of a handle is ordered by its stream, so a buffer used by one call may
+/// be handed out to the next one right away. Each slot only grows, up to the largest size asked
+/// for, so nothing is allocated once the application has warmed up.
+class WorkspaceArena
+{
+    public:
+    /// Users of the same slot shall never overlap within one call.
+    enum class Slot
+    {
+        Workspace,
+        CheckNumerics,
+        RNNSync,
+        MultiTensor,
+        Fusion,
+        RocBLAS,
+        BwdBias,
+        Count,
+    };
+
+    /// Returns a buffer holding at least size bytes. Growing a slot waits for the stream to
+    /// finish before the old buffer is released.
+    Allocator::ManageDataPtr& Get(const Handle& handle, Slot slot, std::size_t size);
+
+    /// Total size of the buffers held, in bytes.
+    std::size_t GetBytes() const;
+    std::size_t GetBytes(Slot slot) const;
+
+    void Clear();
+
+    /// The arena is off unless MIOPEN_WORKSPACE_ARENA is enabled.
+    static bool IsEnabledByDefault();
+
+    private:
+    struct Buffer
+    {
+        Allocator::ManageDataPtr data;
+        std::size_t size = 0;
+    };
+
+    std::array<Buffer, static_cast<std::size_t>(Slot::Count)> buffers;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_WORKSPACE_ARENA_HPP_
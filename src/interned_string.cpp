@@ -0,0 +1,93 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/interned_string.hpp>
+#include <miopen/read_mostly_map.hpp>
+
+#include <deque>
+#include <mutex>
+
+namespace miopen {
+
+struct InternedString::Entry
+{
+    Entry(const std::string& value_, std::size_t hash_) : value(value_), hash(hash_) {}
+
+    const std::string value;
+    const std::size_t hash;
+};
+
+namespace {
+
+struct InternPool
+{
+    ReadMostlyMap<std::string, const InternedString::Entry*> index{1024};
+    std::deque<InternedString::Entry> entries;
+    std::mutex mutex;
+};
+
+InternPool& GetInternPool()
+{
+    static InternPool pool;
+    return pool;
+}
+
+} // namespace
+
+InternedString::InternedString(const std::string& str)
+{
+    auto& pool = GetInternPool();
+    if(const auto found = pool.index.Find(str))
+    {
+        entry = *found;
+        return;
+    }
+
+    const std::lock_guard<std::mutex> lock(pool.mutex);
+    if(const auto found = pool.index.Find(str))
+    {
+        entry = *found;
+        return;
+    }
+    pool.entries.emplace_back(str, std::hash<std::string>{}(str));
+    entry = *pool.index.Insert(str, &pool.entries.back()).first;
+}
+
+InternedString InternedString::TryGet(const std::string& str)
+{
+    const auto found = GetInternPool().index.Find(str);
+    return found != nullptr ? InternedString{*found} : InternedString{};
+}
+
+const std::string& InternedString::ToString() const
+{
+    static const std::string empty;
+    return entry != nullptr ? entry->value : empty;
+}
+
+std::size_t InternedString::Hash() const { return entry != nullptr ? entry->hash : 0; }
+
+} // namespace miopen
@@ -25,85 +25,70 @@
  *******************************************************************************/
 
 #include <miopen/invoker_cache.hpp>
+#include <miopen/cache_stats.hpp>
 #include <miopen/logger.hpp>
 
 namespace miopen {
 
 boost::optional<const Invoker&> InvokerCache::operator[](const Key& key) const
 {
-    const auto item = invokers.find(key.first);
-    if(item == invokers.end())
+    const cache_stats::Lookup lookup{miopenCacheInvokers};
+    const auto invoker = invokers.Find(key);
+    lookup.Done(invoker != nullptr);
+    if(invoker == nullptr)
         return boost::none;
-    const auto& item_invokers = item->second.invokers;
-    const auto invoker        = item_invokers.find(key.second);
-    if(invoker == item_invokers.end())
-        return boost::none;
-    return invoker->second;
+    return *invoker;
 }
 
-boost::optional<const Invoker&> InvokerCache::GetFound1_0(const std::string& network_config,
-                                                          const std::string& algorithm) const
+boost::optional<const Invoker&> InvokerCache::GetFound1_0(const InternedString& network_config,
+                                                          const InternedString& algorithm) const
 {
-    const auto item = invokers.find(network_config);
-    if(item == invokers.end())
-    {
-        MIOPEN_LOG_I2("No invokers found for " << network_config);
-        return boost::none;
-    }
-    if(item->second.found_1_0.empty())
-    {
-        MIOPEN_LOG_I2("Invokers found for " << network_config
-                                            << " but there is no find 1.0 result.");
-        return boost::none;
-    }
-    const auto& item_invokers = item->second.invokers;
-    const auto& found_1_0_ids = item->second.found_1_0;
-    const auto found_1_0_id   = found_1_0_ids.find(algorithm);
-    if(found_1_0_id == found_1_0_ids.end())
+    const cache_stats::Lookup lookup{miopenCacheInvokers};
+    const auto found_1_0_id = found_1_0.Find({network_config, algorithm});
+    lookup.Done(found_1_0_id != nullptr);
+    if(found_1_0_id == nullptr)
     {
-        MIOPEN_LOG_I2("Invokers found for " << network_config
-                                            << " but there is no one with an algorithm "
-                                            << algorithm);
+        MIOPEN_LOG_I2("No find 1.0 result for " << network_config.ToString()
+                                                << " with an algorithm "
+                                                << algorithm.ToString());
         return boost::none;
     }
-    const auto invoker = item_invokers.find(found_1_0_id->second);
-    if(invoker == item_invokers.end())
-        MIOPEN_THROW("No invoker with solver_id of " + found_1_0_id->second +
-                     " was registered for " + network_config);
-    return invoker->second;
+    const auto invoker = invokers.Find({network_config, *found_1_0_id});
+    if(invoker == nullptr)
+        MIOPEN_THROW("No invoker with solver_id of " + found_1_0_id->ToString() +
+                     " was registered for " + network_config.ToString());
+    return *invoker;
 }
 
-void InvokerCache::Register(const Key& key, const Invoker& invoker)
+InternedString InvokerCache::GetFound1_0Id(const InternedString& network_config,
+                                           const InternedString& algorithm) const
 {
-    auto it = invokers.find(key.first);
-    if(it != invokers.end())
-        it->second.invokers.insert({key.second, invoker});
-    auto& item = invokers.insert({key.first, Item{}}).first->second;
-    item.invokers.insert({key.second, invoker});
-    MIOPEN_LOG_I2("Invoker registered for algorithm " << key.first << " and solver " << key.second);
+    const auto found_1_0_id = found_1_0.Find({network_config, algorithm});
+    return found_1_0_id != nullptr ? *found_1_0_id : InternedString{};
 }
 
-void InvokerCache::SetAsFound1_0(const std::string& network_config,
-                                 const std::string& algorithm,
-                                 const std::string& solver_id)
+void InvokerCache::Register(const Key& key, const Invoker& invoker)
 {
-    const auto item = invokers.find(network_config);
-    if(item == invokers.end())
-        MIOPEN_THROW("No invoker was registered for " + network_config);
+    invokers.Insert(key, invoker);
+    MIOPEN_LOG_I2("Invoker registered for algorithm " << key.network_config.ToString()
+                                                      << " and solver "
+                                                      << key.solver_id.ToString());
+}
 
-    {
-        // Validating at find time
-        const auto& item_invokers = item->second.invokers;
-        const auto invoker        = item_invokers.find(solver_id);
-        if(invoker == item_invokers.end())
-            MIOPEN_THROW("No invoker with solver_id of " + solver_id + " was registered for " +
-                         network_config);
-    }
+void InvokerCache::SetAsFound1_0(const InternedString& network_config,
+                                 const InternedString& algorithm,
+                                 const InternedString& solver_id)
+{
+    // Validating at find time
+    if(invokers.Find({network_config, solver_id}) == nullptr)
+        MIOPEN_THROW("No invoker with solver_id of " + solver_id.ToString() +
+                     " was registered for " + network_config.ToString());
 
-    item->second.found_1_0[algorithm] = solver_id;
-    MIOPEN_LOG_I2("Solver " << solver_id << " registered as find 1.0 best for " << algorithm
+    found_1_0.InsertOrAssign({network_config, algorithm}, solver_id);
+    MIOPEN_LOG_I2("Solver " << solver_id.ToString() << " registered as find 1.0 best for "
+                            << algorithm.ToString()
                             << " in "
-                            << network_config);
+                            << network_config.ToString());
 }
 
 } // namespace miopen
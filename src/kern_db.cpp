@@ -25,6 +25,10 @@
  *******************************************************************************/
 #include <miopen/kern_db.hpp>
 
+#include <numeric>
+#include <utility>
+#include <vector>
+
 namespace miopen {
 KernDb::KernDb(const std::string& filename_,
                bool is_system,
@@ -57,6 +61,7 @@ KernDb::KernDb(const std::string& filename_,
         const std::string create_table = KernelConfig::CreateQuery();
         sql.Exec(create_table);
         MIOPEN_LOG_I2("Database created successfully");
+        AddMetadataColumns();
     }
     if(!CheckTableColumns(KernelConfig::table_name(), KernelConfig::FieldNames()))
     {
@@ -65,7 +70,106 @@ KernDb::KernDb(const std::string& filename_,
            << filename;
         MIOPEN_LOG_W(ss.str());
         dbInvalid = true;
+        return;
+    }
+    has_metadata =
+        CheckTableColumns(KernelConfig::table_name(), KernelConfig::MetadataFieldNames());
+    // System databases are read-only and shared, their entries are never evicted.
+    track_use = has_metadata && !is_system;
+}
+
+void KernDb::AddMetadataColumns()
+{
+    for(const auto& field : KernelConfig::MetadataFieldNames())
+    {
+        if(CheckTableColumns(KernelConfig::table_name(), {field}))
+            continue;
+        // Another process may be upgrading the same database, the check below tells.
+        try
+        {
+            sql.Exec("ALTER TABLE `" + KernelConfig::table_name() + "` ADD COLUMN `" + field +
+                     "` INT NOT NULL DEFAULT 0;");
+        }
+        catch(const Exception& ex)
+        {
+            MIOPEN_LOG_I2("Unable to add " << field << " to " << filename << ": " << ex.what());
+        }
+    }
+}
+
+void KernDb::TouchRecord(const std::int64_t id)
+{
+    // A failure only makes the entry look older to Trim(), so it does not fail the lookup.
+    try
+    {
+        auto stmt = SQLite::Statement{
+            sql, "UPDATE " + KernelConfig::table_name() + " SET last_use = ? WHERE id = ?;"};
+        stmt.BindInt64(1, Now());
+        stmt.BindInt64(2, id);
+        if(stmt.Step(sql) != SQLITE_DONE)
+            MIOPEN_LOG_I2("Unable to update the last use in " << filename << ": "
+                                                               << sql.ErrorMessage());
+    }
+    catch(const Exception& ex)
+    {
+        MIOPEN_LOG_I2("Unable to update the last use in " << filename << ": " << ex.what());
     }
 }
 
+KernDbTrimResult KernDb::Trim(const std::size_t max_bytes,
+                              const miopenKernelCacheEvictPolicy_t policy)
+{
+    KernDbTrimResult result;
+    if(filename.empty() || dbInvalid)
+        return result;
+
+    std::string order = "id";
+    if(has_metadata)
+    {
+        order = policy == miopenKernelCacheEvictCheapest
+                    ? "CAST(compile_time_ms AS REAL) / MAX(LENGTH(kernel_blob), 1), last_use, id"
+                    : "last_use, id";
+    }
+    auto stmt = SQLite::Statement{sql,
+                                  "SELECT id, LENGTH(kernel_blob) FROM " +
+                                      KernelConfig::table_name() + " ORDER BY " + order + ";"};
+    // Eviction order, the entries to keep come last.
+    std::vector<std::pair<std::int64_t, std::size_t>> entries;
+    int rc;
+    while((rc = stmt.Step(sql)) == SQLITE_ROW)
+        entries.emplace_back(stmt.ColumnInt64(0), stmt.ColumnInt64(1));
+    if(rc != SQLITE_DONE)
+        MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+
+    result.remaining_bytes = std::accumulate(
+        entries.begin(), entries.end(), std::size_t{0}, [](auto acc, const auto& entry) {
+            return acc + entry.second;
+        });
+
+    std::ostringstream ids;
+    for(const auto& entry : entries)
+    {
+        if(result.remaining_bytes <= max_bytes)
+            break;
+        ids << (result.removed_entries == 0 ? "" : ", ") << entry.first;
+        ++result.removed_entries;
+        result.removed_bytes += entry.second;
+        result.remaining_bytes -= entry.second;
+    }
+    if(result.removed_entries == 0)
+        return result;
+
+    sql.Exec("DELETE FROM " + KernelConfig::table_name() + " WHERE id IN (" + ids.str() + ");");
+    // Deleted rows only become free pages, the file shrinks when it is rebuilt.
+    sql.Exec("VACUUM;");
+    return result;
+}
+
+std::int64_t KernDb::Now()
+{
+    return std::chrono::duration_cast<std::chrono::seconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
 } // namespace miopen
@@ -39,14 +39,20 @@
  * limitations under the License.
  * ************************************************************************ */
 
+#include <miopen/cache_stats.hpp>
+#include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/kernel_cache.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/stringutils.hpp>
 
+#include <algorithm>
 #include <iostream>
 #include <iterator>
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_PROGRAM_CACHE_MAX_COUNT)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_PROGRAM_CACHE_MAX_MB)
+
 namespace miopen {
 
 static std::ostream& operator<<(std::ostream& os, const std::vector<size_t>& v)
@@ -125,23 +131,30 @@ static void ProcessParams(std::string& params)
     }
 }
 
-const std::vector<Kernel>& KernelCache::GetKernels(const std::string& algorithm,
-                                                   const std::string& network_config)
+std::vector<Kernel> KernelCache::GetKernels(const std::string& algorithm,
+                                            const std::string& network_config)
 {
 
     std::pair<std::string, std::string> key = std::make_pair(algorithm, network_config);
 
+    std::lock_guard<std::mutex> lock(mutex);
     const auto it = kernel_map.find(key);
     if(it != kernel_map.end())
     {
         MIOPEN_LOG_I2(it->second.size() << " kernels for key: " << key.first << " \"" << key.second
                                         << '\"');
+        const auto source = kernel_programs.find(key);
+        if(source != kernel_programs.end())
+        {
+            const auto program_it = program_map.find(source->second);
+            if(program_it != program_map.end())
+                TouchProgram(program_it->second);
+        }
         return it->second;
     }
 
-    static const std::vector<Kernel> empty{};
     MIOPEN_LOG_I2("0 kernels for key: " << key.first << " \"" << key.second << '\"');
-    return empty;
+    return {};
 }
 
 bool KernelCache::HasKernels(const std::string& algorithm, const std::string& network_config) const
@@ -150,6 +163,7 @@ bool KernelCache::HasKernels(const std::string& algorithm, const std::string& ne
 #ifndef NDEBUG
     MIOPEN_LOG_I("Key: " << key.first << " \"" << key.second << '\"');
 #endif
+    std::lock_guard<std::mutex> lock(mutex);
     const auto it = kernel_map.find(key);
     if(it == kernel_map.end())
         return false;
@@ -165,13 +179,104 @@ bool KernelCache::HasKernels(const std::string& algorithm, const std::string& ne
 bool KernelCache::HasProgram(const std::string& name, const std::string& params) const
 {
     const auto key = std::make_pair(name, params);
+    std::lock_guard<std::mutex> lock(mutex);
     return program_map.count(key) > 0;
 }
 
 void KernelCache::AddProgram(Program prog, const std::string& program_name, std::string params)
 {
     ProcessParams(params);
-    program_map[std::make_pair(program_name, params)] = prog;
+    std::lock_guard<std::mutex> lock(mutex);
+    InsertProgram(std::make_pair(program_name, params), prog);
+    EvictPrograms();
+}
+
+KernelCache::ProgramMap::iterator KernelCache::InsertProgram(const Key& key, const Program& prog)
+{
+    auto it = program_map.find(key);
+    if(it != program_map.end())
+    {
+        program_bytes -= it->second.bytes;
+        it->second.program = prog;
+        it->second.bytes   = GetCodeObjectSize(prog);
+        program_bytes += it->second.bytes;
+        TouchProgram(it->second);
+        return it;
+    }
+
+    program_lru.push_front(key);
+    const auto bytes = GetCodeObjectSize(prog);
+    it = program_map.emplace(key, ProgramEntry{prog, bytes, program_lru.begin(), {}}).first;
+    program_bytes += bytes;
+    return it;
+}
+
+void KernelCache::TouchProgram(ProgramEntry& entry)
+{
+    program_lru.splice(program_lru.begin(), program_lru, entry.lru);
+}
+
+void KernelCache::EvictPrograms()
+{
+    const auto over_limits = [&]() {
+        return (max_programs != 0 && program_map.size() > max_programs) ||
+               (max_bytes != 0 && program_bytes > max_bytes) || program_bytes > budget_bytes;
+    };
+
+    // The most recent program is never evicted, it is about to be used.
+    while(program_lru.size() > 1 && over_limits())
+    {
+        const auto it = program_map.find(program_lru.back());
+        MIOPEN_LOG_I2("Evicting program: " << it->first.first << " \"" << it->first.second << '\"');
+        for(const auto& kernel_key : it->second.kernels)
+        {
+            const auto source = kernel_programs.find(kernel_key);
+            if(source == kernel_programs.end() || source->second != it->first)
+                continue;
+            kernel_map.erase(kernel_key);
+            kernel_programs.erase(source);
+        }
+        program_bytes -= it->second.bytes;
+        program_map.erase(it);
+        ++generation;
+        program_lru.pop_back();
+    }
+}
+
+void KernelCache::SetLimits(std::size_t max_programs_, std::size_t max_bytes_)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    max_programs = max_programs_;
+    max_bytes    = max_bytes_;
+    EvictPrograms();
+}
+
+void KernelCache::SetMemoryBudget(std::size_t budget_bytes_)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    budget_bytes = budget_bytes_;
+    EvictPrograms();
+}
+
+std::size_t KernelCache::GetProgramCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return program_map.size();
+}
+
+std::size_t KernelCache::GetProgramBytes() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return program_bytes;
+}
+
+std::size_t KernelCache::GetKernelCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    std::size_t count = 0;
+    for(const auto& entry : kernel_map)
+        count += entry.second.size();
+    return count;
 }
 
 Kernel KernelCache::AddKernel(const Handle& h,
@@ -193,11 +298,24 @@ Kernel KernelCache::AddKernel(const Handle& h,
         MIOPEN_LOG_I2("Key: " << key.first << " \"" << key.second << '\"');
 
     Program program;
+    const auto program_key = std::make_pair(program_name, params);
 
-    auto program_it = program_map.find(std::make_pair(program_name, params));
-    if(program_it != program_map.end())
+    const cache_stats::Lookup lookup{miopenCachePrograms};
+    bool cached = false;
     {
-        program = program_it->second;
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto program_it = program_map.find(program_key);
+        if(program_it != program_map.end())
+        {
+            program = program_it->second.program;
+            TouchProgram(program_it->second);
+            cached = true;
+        }
+    }
+
+    if(cached)
+    {
+        lookup.Hit();
     }
     else
     {
@@ -215,18 +333,36 @@ Kernel KernelCache::AddKernel(const Handle& h,
                                       vgd,
                                       params);
         }
+        // Concurrent builds of the same program are merged by the handle, see CompileService.
         program = h.LoadProgram(program_name, params, is_kernel_miopengemm_str, kernel_src);
-        program_map[std::make_pair(program_name, params)] = program;
+        lookup.Miss();
     }
     Kernel kernel{program, kernel_name, vld, vgd};
+
+    std::lock_guard<std::mutex> lock(mutex);
+    // Another thread may have evicted or inserted the program meanwhile.
+    auto program_it = program_map.find(program_key);
+    if(program_it == program_map.end())
+        program_it = InsertProgram(program_key, program);
     if(!network_config.empty() && !algorithm.empty())
     {
-        this->AddKernel(key, kernel, cache_index);
+        InsertKernel(key, kernel, cache_index);
+        auto& built = program_it->second.kernels;
+        if(std::find(built.begin(), built.end(), key) == built.end())
+            built.push_back(key);
+        kernel_programs[key] = program_key;
     }
+    EvictPrograms();
     return kernel;
 }
 
 void KernelCache::AddKernel(Key key, Kernel k, std::size_t cache_index)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    InsertKernel(key, k, cache_index);
+}
+
+void KernelCache::InsertKernel(const Key& key, const Kernel& k, std::size_t cache_index)
 {
     auto&& v = kernel_map[key];
     if(cache_index >= v.size())
@@ -243,14 +379,20 @@ void KernelCache::ClearKernels(const std::string& algorithm, const std::string&
         MIOPEN_THROW("Network config or algorithm empty.");
     }
     const std::pair<std::string, std::string> key = std::make_pair(algorithm, network_config);
+    std::lock_guard<std::mutex> lock(mutex);
     auto&& v = this->kernel_map[key];
     if(!v.empty())
     {
         MIOPEN_LOG_I2(v.size() << " kernels for key: " << key.first << " \"" << key.second << '\"');
+        ++generation;
     }
     v.clear();
 }
 
-KernelCache::KernelCache() {}
+KernelCache::KernelCache()
+    : max_programs(Value(MIOPEN_PROGRAM_CACHE_MAX_COUNT{}, 0)),
+      max_bytes(Value(MIOPEN_PROGRAM_CACHE_MAX_MB{}, 0) * 1024 * 1024)
+{
+}
 
 } // namespace miopen
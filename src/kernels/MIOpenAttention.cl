@@ -0,0 +1,341 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "float_types.h"
+
+// Scaled dot-product attention, o = softmax(scale * q * k^T) * v, over packed [batch, seq, d]
+// tensors (the batch covers the heads). The seq_q x seq_kv score matrix is never stored: the
+// keys and values are streamed through LDS in tiles of ATT_KV_TILE rows, and every work-item
+// keeps the softmax of its query row online, rescaling its accumulator when the running maximum
+// grows. The log-sum-exp of every row is saved for the backward pass, which recomputes the
+// probabilities from it. All arithmetic is in _FLOAT_ACCUM (fp32).
+//
+// ATT_D          head dimension
+// ATT_TILE       work-group size, the rows (queries or keys) owned by a work-group
+// ATT_KV_TILE    rows staged in LDS at a time
+// ATT_CAUSAL     query i only attends to the keys j <= i
+// ATT_SAVE_LSE   the forward kernel writes the log-sum-exp of every row
+
+#ifndef ATT_TILE
+#define ATT_TILE 64
+#endif
+
+#ifndef ATT_KV_TILE
+#define ATT_KV_TILE 32
+#endif
+
+#ifndef ATT_CAUSAL
+#define ATT_CAUSAL 0
+#endif
+
+#ifndef ATT_SAVE_LSE
+#define ATT_SAVE_LSE 1
+#endif
+
+// Stages rows [first, first + ATT_KV_TILE) of a and b, zeros past the end.
+static inline void load_tiles(local _FLOAT_ACCUM* lcl_a,
+                              local _FLOAT_ACCUM* lcl_b,
+                              const __global _FLOAT* a,
+                              const __global _FLOAT* b,
+                              uint first,
+                              uint rows,
+                              uint lid)
+{
+    barrier(CLK_LOCAL_MEM_FENCE);
+    for(uint e = lid; e < ATT_KV_TILE * ATT_D; e += ATT_TILE)
+    {
+        const bool in_range = first + e / ATT_D < rows;
+        const size_t i      = (size_t)first * ATT_D + e;
+        lcl_a[e]            = in_range ? CVT_FLOAT2ACCUM(a[i]) : (_FLOAT_ACCUM)0;
+        lcl_b[e]            = in_range ? CVT_FLOAT2ACCUM(b[i]) : (_FLOAT_ACCUM)0;
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+}
+
+static inline _FLOAT_ACCUM dot_row(const _FLOAT_ACCUM* a, const local _FLOAT_ACCUM* b)
+{
+    _FLOAT_ACCUM sum = (_FLOAT_ACCUM)0;
+    for(uint d = 0; d < ATT_D; ++d)
+        sum = mad(a[d], b[d], sum);
+    return sum;
+}
+
+// One work-item per query row, ATT_TILE rows per work-group, get_group_id(1) is the batch.
+__attribute__((reqd_work_group_size(ATT_TILE, 1, 1))) __kernel void
+MIOpenAttentionFwd(const __global _FLOAT* __restrict q,
+                   const __global _FLOAT* __restrict k,
+                   const __global _FLOAT* __restrict v,
+                   __global _FLOAT* __restrict o,
+                   __global float* __restrict lse,
+                   float scale,
+                   uint seq_q,
+                   uint seq_kv)
+{
+    local _FLOAT_ACCUM lcl_k[ATT_KV_TILE * ATT_D];
+    local _FLOAT_ACCUM lcl_v[ATT_KV_TILE * ATT_D];
+
+    const uint lid    = get_local_id(0);
+    const uint row    = get_group_id(0) * ATT_TILE + lid;
+    const size_t b    = get_group_id(1);
+    const bool active = row < seq_q;
+
+    const __global _FLOAT* k_b = k + b * seq_kv * ATT_D;
+    const __global _FLOAT* v_b = v + b * seq_kv * ATT_D;
+    const size_t q_offset      = (b * seq_q + row) * ATT_D;
+
+    // the scale is folded into q
+    _FLOAT_ACCUM q_row[ATT_D];
+    _FLOAT_ACCUM acc[ATT_D];
+    for(uint d = 0; d < ATT_D; ++d)
+    {
+        q_row[d] = active ? CVT_FLOAT2ACCUM(q[q_offset + d]) * scale : (_FLOAT_ACCUM)0;
+        acc[d]   = (_FLOAT_ACCUM)0;
+    }
+
+    _FLOAT_ACCUM row_max = -INFINITY;
+    _FLOAT_ACCUM row_sum = (_FLOAT_ACCUM)0;
+
+#if ATT_CAUSAL
+    const uint kv_end = min(seq_kv, (uint)(get_group_id(0) + 1) * ATT_TILE);
+#else
+    const uint kv_end = seq_kv;
+#endif
+    for(uint kv0 = 0; kv0 < kv_end; kv0 += ATT_KV_TILE)
+    {
+        load_tiles(lcl_k, lcl_v, k_b, v_b, kv0, seq_kv, lid);
+
+        // The first tile always holds key 0, so row_max is finite from then on and fully
+        // masked tiles add nothing.
+        _FLOAT_ACCUM s[ATT_KV_TILE];
+        _FLOAT_ACCUM tile_max = -INFINITY;
+        for(uint j = 0; j < ATT_KV_TILE; ++j)
+        {
+            const uint key = kv0 + j;
+#if ATT_CAUSAL
+            const bool masked = key >= seq_kv || key > row;
+#else
+            const bool masked = key >= seq_kv;
+#endif
+            s[j]     = masked ? -INFINITY : dot_row(q_row, lcl_k + j * ATT_D);
+            tile_max = fmax(tile_max, s[j]);
+        }
+
+        const _FLOAT_ACCUM new_max = fmax(row_max, tile_max);
+        const _FLOAT_ACCUM rescale = exp(row_max - new_max);
+        row_sum *= rescale;
+        for(uint d = 0; d < ATT_D; ++d)
+            acc[d] *= rescale;
+        row_max = new_max;
+
+        for(uint j = 0; j < ATT_KV_TILE; ++j)
+        {
+            const _FLOAT_ACCUM p = exp(s[j] - row_max);
+            row_sum += p;
+            for(uint d = 0; d < ATT_D; ++d)
+                acc[d] = mad(p, lcl_v[j * ATT_D + d], acc[d]);
+        }
+    }
+
+    if(!active)
+        return;
+
+    const _FLOAT_ACCUM inv_sum = (_FLOAT_ACCUM)1 / row_sum;
+    for(uint d = 0; d < ATT_D; ++d)
+        o[q_offset + d] = CVT_ACCUM2FLOAT(acc[d] * inv_sum);
+#if ATT_SAVE_LSE
+    lse[b * seq_q + row] = row_max + log(row_sum);
+#endif
+}
+
+// Backward, with p = exp(scale * q * k^T - lse), dp = do * v^T, delta = rowsum(do .* o) and
+// ds = p .* (dp - delta): dq = scale * ds * k, dk = scale * ds^T * q and dv = p^T * do. dq is
+// accumulated over the keys by the work-item of a query row, dk and dv over the queries by the
+// work-item of a key row, so neither needs atomics and the results do not depend on the order
+// in which the work-groups run.
+
+// One work-item per query row.
+__attribute__((reqd_work_group_size(ATT_TILE, 1, 1))) __kernel void
+MIOpenAttentionBwdQ(const __global _FLOAT* __restrict q,
+                    const __global _FLOAT* __restrict k,
+                    const __global _FLOAT* __restrict v,
+                    const __global _FLOAT* __restrict o,
+                    const __global _FLOAT* __restrict d_o,
+                    const __global float* __restrict lse,
+                    __global _FLOAT* __restrict dq,
+                    float scale,
+                    uint seq_q,
+                    uint seq_kv)
+{
+    local _FLOAT_ACCUM lcl_k[ATT_KV_TILE * ATT_D];
+    local _FLOAT_ACCUM lcl_v[ATT_KV_TILE * ATT_D];
+
+    const uint lid    = get_local_id(0);
+    const uint row    = get_group_id(0) * ATT_TILE + lid;
+    const size_t b    = get_group_id(1);
+    const bool active = row < seq_q;
+
+    const __global _FLOAT* k_b = k + b * seq_kv * ATT_D;
+    const __global _FLOAT* v_b = v + b * seq_kv * ATT_D;
+    const size_t q_offset      = (b * seq_q + row) * ATT_D;
+
+    _FLOAT_ACCUM q_row[ATT_D];
+    _FLOAT_ACCUM do_row[ATT_D];
+    _FLOAT_ACCUM dq_row[ATT_D];
+    _FLOAT_ACCUM delta = (_FLOAT_ACCUM)0;
+    for(uint d = 0; d < ATT_D; ++d)
+    {
+        q_row[d]  = active ? CVT_FLOAT2ACCUM(q[q_offset + d]) * scale : (_FLOAT_ACCUM)0;
+        do_row[d] = active ? CVT_FLOAT2ACCUM(d_o[q_offset + d]) : (_FLOAT_ACCUM)0;
+        dq_row[d] = (_FLOAT_ACCUM)0;
+        if(active)
+            delta = mad(do_row[d], CVT_FLOAT2ACCUM(o[q_offset + d]), delta);
+    }
+    const _FLOAT_ACCUM row_lse = active ? lse[b * seq_q + row] : (_FLOAT_ACCUM)0;
+
+#if ATT_CAUSAL
+    const uint kv_end = min(seq_kv, (uint)(get_group_id(0) + 1) * ATT_TILE);
+#else
+    const uint kv_end = seq_kv;
+#endif
+    for(uint kv0 = 0; kv0 < kv_end; kv0 += ATT_KV_TILE)
+    {
+        load_tiles(lcl_k, lcl_v, k_b, v_b, kv0, seq_kv, lid);
+
+        for(uint j = 0; j < ATT_KV_TILE; ++j)
+        {
+            const uint key = kv0 + j;
+#if ATT_CAUSAL
+            if(key >= seq_kv || key > row)
+                continue;
+#else
+            if(key >= seq_kv)
+                continue;
+#endif
+            const _FLOAT_ACCUM p  = exp(dot_row(q_row, lcl_k + j * ATT_D) - row_lse);
+            const _FLOAT_ACCUM ds = p * (dot_row(do_row, lcl_v + j * ATT_D) - delta);
+            for(uint d = 0; d < ATT_D; ++d)
+                dq_row[d] = mad(ds, lcl_k[j * ATT_D + d], dq_row[d]);
+        }
+    }
+
+    if(!active)
+        return;
+    for(uint d = 0; d < ATT_D; ++d)
+        dq[q_offset + d] = CVT_ACCUM2FLOAT(dq_row[d] * scale);
+}
+
+// One work-item per key row. The delta of a staged query is computed by one work-item.
+__attribute__((reqd_work_group_size(ATT_TILE, 1, 1))) __kernel void
+MIOpenAttentionBwdKV(const __global _FLOAT* __restrict q,
+                     const __global _FLOAT* __restrict k,
+                     const __global _FLOAT* __restrict v,
+                     const __global _FLOAT* __restrict o,
+                     const __global _FLOAT* __restrict d_o,
+                     const __global float* __restrict lse,
+                     __global _FLOAT* __restrict dk,
+                     __global _FLOAT* __restrict dv,
+                     float scale,
+                     uint seq_q,
+                     uint seq_kv)
+{
+    local _FLOAT_ACCUM lcl_q[ATT_KV_TILE * ATT_D];
+    local _FLOAT_ACCUM lcl_do[ATT_KV_TILE * ATT_D];
+    local _FLOAT_ACCUM lcl_lse[ATT_KV_TILE];
+    local _FLOAT_ACCUM lcl_delta[ATT_KV_TILE];
+
+    const uint lid    = get_local_id(0);
+    const uint key    = get_group_id(0) * ATT_TILE + lid;
+    const size_t b    = get_group_id(1);
+    const bool active = key < seq_kv;
+
+    const __global _FLOAT* q_b  = q + b * seq_q * ATT_D;
+    const __global _FLOAT* o_b  = o + b * seq_q * ATT_D;
+    const __global _FLOAT* do_b = d_o + b * seq_q * ATT_D;
+    const size_t kv_offset      = (b * seq_kv + key) * ATT_D;
+
+    _FLOAT_ACCUM k_row[ATT_D];
+    _FLOAT_ACCUM v_row[ATT_D];
+    _FLOAT_ACCUM dk_row[ATT_D];
+    _FLOAT_ACCUM dv_row[ATT_D];
+    for(uint d = 0; d < ATT_D; ++d)
+    {
+        k_row[d]  = active ? CVT_FLOAT2ACCUM(k[kv_offset + d]) * scale : (_FLOAT_ACCUM)0;
+        v_row[d]  = active ? CVT_FLOAT2ACCUM(v[kv_offset + d]) : (_FLOAT_ACCUM)0;
+        dk_row[d] = (_FLOAT_ACCUM)0;
+        dv_row[d] = (_FLOAT_ACCUM)0;
+    }
+
+#if ATT_CAUSAL
+    // the queries before the first key of the work-group see none of its keys
+    const uint q_begin = ((get_group_id(0) * ATT_TILE) / ATT_KV_TILE) * ATT_KV_TILE;
+#else
+    const uint q_begin = 0;
+#endif
+    for(uint q0 = q_begin; q0 < seq_q; q0 += ATT_KV_TILE)
+    {
+        load_tiles(lcl_q, lcl_do, q_b, do_b, q0, seq_q, lid);
+        if(lid < ATT_KV_TILE)
+        {
+            const uint i       = q0 + lid;
+            _FLOAT_ACCUM delta = (_FLOAT_ACCUM)0;
+            if(i < seq_q)
+                for(uint d = 0; d < ATT_D; ++d)
+                    delta = mad(lcl_do[lid * ATT_D + d],
+                                CVT_FLOAT2ACCUM(o_b[(size_t)i * ATT_D + d]),
+                                delta);
+            lcl_delta[lid] = delta;
+            lcl_lse[lid]   = i < seq_q ? lse[b * seq_q + i] : (_FLOAT_ACCUM)0;
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        for(uint j = 0; j < ATT_KV_TILE; ++j)
+        {
+            const uint i = q0 + j;
+#if ATT_CAUSAL
+            if(i >= seq_q || key > i)
+                continue;
+#else
+            if(i >= seq_q)
+                continue;
+#endif
+            const _FLOAT_ACCUM p  = exp(dot_row(k_row, lcl_q + j * ATT_D) - lcl_lse[j]);
+            const _FLOAT_ACCUM ds = p * (dot_row(v_row, lcl_do + j * ATT_D) - lcl_delta[j]);
+            for(uint d = 0; d < ATT_D; ++d)
+            {
+                dv_row[d] = mad(p, lcl_do[j * ATT_D + d], dv_row[d]);
+                dk_row[d] = mad(ds, lcl_q[j * ATT_D + d], dk_row[d]);
+            }
+        }
+    }
+
+    if(!active)
+        return;
+    for(uint d = 0; d < ATT_D; ++d)
+    {
+        dk[kv_offset + d] = CVT_ACCUM2FLOAT(dk_row[d] * scale);
+        dv[kv_offset + d] = CVT_ACCUM2FLOAT(dv_row[d]);
+    }
+}
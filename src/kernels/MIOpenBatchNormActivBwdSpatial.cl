@@ -39,6 +39,21 @@
 #include "activation_functions.h"
 #include "reduction_functions.h"
 
+#ifndef MIO_BN_RESIDUAL
+#define MIO_BN_RESIDUAL 0
+#endif
+
+// With MIO_BN_RESIDUAL the forward pass added a skip connection ahead of the activation. The
+// activation is differentiated at that sum and its gradient, which is also the gradient of the
+// skip connection, is written to residual_diff.
+#if(MIO_BN_RESIDUAL == 1)
+#define MIO_BN_ADD_RESIDUAL(value, idx) ((value) += (_FLOAT_PREC)(*(residual + (idx))))
+#define MIO_BN_STORE_RESIDUAL_DIFF(value, idx) (*(residual_diff + (idx)) = (_FLOAT)(value))
+#else
+#define MIO_BN_ADD_RESIDUAL(value, idx)
+#define MIO_BN_STORE_RESIDUAL_DIFF(value, idx)
+#endif
+
 #if(MIO_BN_VARIANT == 0)
 
 #define MIO_BN_SEGTMP (MIO_BN_HW * (MIO_BN_GRP0 / MIO_BN_HW))
@@ -53,6 +68,10 @@ MIOpenBatchNormActivBwdSpatial(const __global _FLOAT* __restrict x_in,
                                const __global _FLOAT* __restrict y_in,
                                const __global _FLOAT* __restrict dy_in,
                                __global _FLOAT* __restrict dx_out,
+#if(MIO_BN_RESIDUAL == 1)
+                               const __global _FLOAT* __restrict residual,
+                               __global _FLOAT* __restrict residual_diff,
+#endif
                                _FLOAT diff_scale,
                                _FLOAT gamma,
                                _FLOAT beta,
@@ -120,8 +139,10 @@ MIOpenBatchNormActivBwdSpatial(const __global _FLOAT* __restrict x_in,
             _FLOAT_PREC bn_dyin;
             _FLOAT_PREC act_dyin = *(dy_in + index);
             _FLOAT_PREC act_out  = *(y_in + index);
+            MIO_BN_ADD_RESIDUAL(bn_out, index);
             ActivationFunction_Diff(
                 1, &bn_dyin, &act_dyin, &bn_out, &act_out, diff_scale, gamma, beta, alpha);
+            MIO_BN_STORE_RESIDUAL_DIFF(bn_dyin, index);
             dyvalues[n] = bn_dyin;
             db += dyvalues[n];
             batchvalues[n] = xhat;
@@ -142,8 +163,10 @@ MIOpenBatchNormActivBwdSpatial(const __global _FLOAT* __restrict x_in,
             _FLOAT_PREC bn_dyin;
             _FLOAT_PREC act_dyin = (_FLOAT_PREC)(*(dy_in + index));
             _FLOAT_PREC act_out  = (_FLOAT_PREC)(*(y_in + index));
+            MIO_BN_ADD_RESIDUAL(bn_out, index);
             ActivationFunction_Diff(
                 1, &bn_dyin, &act_dyin, &bn_out, &act_out, diff_scale, gamma, beta, alpha);
+            MIO_BN_STORE_RESIDUAL_DIFF(bn_dyin, index);
             dyvalues[MIO_BN_NLOOPM] = bn_dyin;
 
 #if MIO_BN_CBA_WRITE_INTERMEDIATE
@@ -229,6 +252,10 @@ MIOpenBatchNormActivBwdSpatial(const __global _FLOAT* __restrict x_in,
                                const __global _FLOAT* __restrict y_in,
                                const __global _FLOAT* __restrict dy_in,
                                __global _FLOAT* __restrict dx_out,
+#if(MIO_BN_RESIDUAL == 1)
+                               const __global _FLOAT* __restrict residual,
+                               __global _FLOAT* __restrict residual_diff,
+#endif
                                _FLOAT diff_scale,
                                _FLOAT gamma,
                                _FLOAT beta,
@@ -304,32 +331,40 @@ MIOpenBatchNormActivBwdSpatial(const __global _FLOAT* __restrict x_in,
         _FLOAT_PREC pbndyin  = 0.;
         _FLOAT_PREC pactdyin = act_dyin4.x;
         _FLOAT_PREC pbnout   = bn_out4.x;
+        MIO_BN_ADD_RESIDUAL(pbnout, index);
         _FLOAT_PREC pactout  = act_out4.x;
         ActivationFunction_Diff(
             1, &pbndyin, &pactdyin, &pbnout, &pactout, diff_scale, gamma, beta, alpha);
+        MIO_BN_STORE_RESIDUAL_DIFF(pbndyin, index);
 
         db += pbndyin;
         ds       = mad(xhat4.x, pbndyin, ds);
         pactdyin = act_dyin4.y;
         pbnout   = bn_out4.y;
+        MIO_BN_ADD_RESIDUAL(pbnout, index + 1);
         pactout  = act_out4.y;
         ActivationFunction_Diff(
             1, &pbndyin, &pactdyin, &pbnout, &pactout, diff_scale, gamma, beta, alpha);
+        MIO_BN_STORE_RESIDUAL_DIFF(pbndyin, index + 1);
 
         db += pbndyin;
         ds       = mad(xhat4.y, pbndyin, ds);
         pactdyin = act_dyin4.z;
         pbnout   = bn_out4.z;
+        MIO_BN_ADD_RESIDUAL(pbnout, index + 2);
         pactout  = act_out4.z;
         ActivationFunction_Diff(
             1, &pbndyin, &pactdyin, &pbnout, &pactout, diff_scale, gamma, beta, alpha);
+        MIO_BN_STORE_RESIDUAL_DIFF(pbndyin, index + 2);
         db += pbndyin;
         ds       = mad(xhat4.z, pbndyin, ds);
         pactdyin = act_dyin4.w;
         pbnout   = bn_out4.w;
+        MIO_BN_ADD_RESIDUAL(pbnout, index + 3);
         pactout  = act_out4.w;
         ActivationFunction_Diff(
             1, &pbndyin, &pactdyin, &pbnout, &pactout, diff_scale, gamma, beta, alpha);
+        MIO_BN_STORE_RESIDUAL_DIFF(pbndyin, index + 3);
         db += pbndyin;
         ds = mad(xhat4.w, pbndyin, ds);
 
@@ -370,32 +405,40 @@ MIOpenBatchNormActivBwdSpatial(const __global _FLOAT* __restrict x_in,
         _FLOAT_PREC pbndyin  = 0.;
         _FLOAT_PREC pactdyin = act_dyin4.x;
         _FLOAT_PREC pbnout   = bn_out4.x;
+        MIO_BN_ADD_RESIDUAL(pbnout, index);
         _FLOAT_PREC pactout  = act_out4.x;
         ActivationFunction_Diff(
             1, &pbndyin, &pactdyin, &pbnout, &pactout, diff_scale, gamma, beta, alpha);
+        MIO_BN_STORE_RESIDUAL_DIFF(pbndyin, index);
 
         db += pbndyin;
         ds       = mad(xhat4.x, pbndyin, ds);
         pactdyin = act_dyin4.y;
         pbnout   = bn_out4.y;
+        MIO_BN_ADD_RESIDUAL(pbnout, index + 1);
         pactout  = act_out4.y;
         ActivationFunction_Diff(
             1, &pbndyin, &pactdyin, &pbnout, &pactout, diff_scale, gamma, beta, alpha);
+        MIO_BN_STORE_RESIDUAL_DIFF(pbndyin, index + 1);
 
         db += pbndyin;
         ds       = mad(xhat4.y, pbndyin, ds);
         pactdyin = act_dyin4.z;
         pbnout   = bn_out4.z;
+        MIO_BN_ADD_RESIDUAL(pbnout, index + 2);
         pactout  = act_out4.z;
         ActivationFunction_Diff(
             1, &pbndyin, &pactdyin, &pbnout, &pactout, diff_scale, gamma, beta, alpha);
+        MIO_BN_STORE_RESIDUAL_DIFF(pbndyin, index + 2);
         db += pbndyin;
         ds       = mad(xhat4.z, pbndyin, ds);
         pactdyin = act_dyin4.w;
         pbnout   = bn_out4.w;
+        MIO_BN_ADD_RESIDUAL(pbnout, index + 3);
         pactout  = act_out4.w;
         ActivationFunction_Diff(
             1, &pbndyin, &pactdyin, &pbnout, &pactout, diff_scale, gamma, beta, alpha);
+        MIO_BN_STORE_RESIDUAL_DIFF(pbndyin, index + 3);
         db += pbndyin;
         ds = mad(xhat4.w, pbndyin, ds);
 
@@ -450,6 +493,7 @@ MIOpenBatchNormActivBwdSpatial(const __global _FLOAT* __restrict x_in,
             _FLOAT_PREC act_out  = (_FLOAT_PREC) * (y_in + index);
             xhat                 = ((_FLOAT_PREC)(*(x_in + index)) - mean) * invVariance;
             _FLOAT_PREC bn_out   = mad(xhat, lcl_scale, lcl_bias);
+            MIO_BN_ADD_RESIDUAL(bn_out, index);
             ActivationFunction_Diff(
                 1, &bn_dyin, &act_dyin, &bn_out, &act_out, diff_scale, gamma, beta, alpha);
             tmp1    = mad(NHW, bn_dyin, -db);
@@ -482,6 +526,7 @@ MIOpenBatchNormActivBwdSpatial(const __global _FLOAT* __restrict x_in,
             _FLOAT_PREC act_out  = (_FLOAT_PREC) * (y_in + index);
             xhat                 = (*(x_in + index) - mean) * invVariance;
             _FLOAT_PREC bn_out   = mad(xhat, lcl_scale, lcl_bias);
+            MIO_BN_ADD_RESIDUAL(bn_out, index);
             ActivationFunction_Diff(
                 1, &bn_dyin, &act_dyin, &bn_out, &act_out, diff_scale, gamma, beta, alpha);
 
@@ -516,6 +561,10 @@ MIOpenBatchNormActivBwdSpatial(const __global _FLOAT* __restrict x_in,
                                const __global _FLOAT* __restrict y_in,
                                const __global _FLOAT* __restrict dy_in,
                                __global _FLOAT* __restrict dx_out,
+#if(MIO_BN_RESIDUAL == 1)
+                               const __global _FLOAT* __restrict residual,
+                               __global _FLOAT* __restrict residual_diff,
+#endif
                                _FLOAT diff_scale,
                                _FLOAT gamma,
                                _FLOAT beta,
@@ -578,6 +627,7 @@ MIOpenBatchNormActivBwdSpatial(const __global _FLOAT* __restrict x_in,
             _FLOAT_PREC bn_dyin;
             _FLOAT_PREC act_dyin = (_FLOAT_PREC) * (dy_in + index);
             _FLOAT_PREC act_out  = (_FLOAT_PREC) * (y_in + index);
+            MIO_BN_ADD_RESIDUAL(bn_out, index);
             ActivationFunction_Diff(1,
                                     &bn_dyin,
                                     &act_dyin,
@@ -587,6 +637,7 @@ MIOpenBatchNormActivBwdSpatial(const __global _FLOAT* __restrict x_in,
                                     gamma,
                                     beta,
                                     alpha);
+            MIO_BN_STORE_RESIDUAL_DIFF(bn_dyin, index);
 
 #if MIO_BN_CBA_WRITE_INTERMEDIATE
             // for debugging
@@ -641,6 +692,7 @@ MIOpenBatchNormActivBwdSpatial(const __global _FLOAT* __restrict x_in,
             _FLOAT_PREC xhat     = ((_FLOAT_PREC) * (x_in + index) - mean) * invVariance;
             _FLOAT_PREC bn_out   = mad(xhat, lcl_scale, lcl_bias);
             _FLOAT_PREC bn_dyin;
+            MIO_BN_ADD_RESIDUAL(bn_out, index);
             ActivationFunction_Diff(
                 1, &bn_dyin, &act_dyin, &bn_out, &act_out, diff_scale, gamma, beta, alpha);
 
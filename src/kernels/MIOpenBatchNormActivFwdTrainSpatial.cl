@@ -40,6 +40,18 @@
 #include "activation_functions.h"
 #include "reduction_functions.h"
 
+#ifndef MIO_BN_RESIDUAL
+#define MIO_BN_RESIDUAL 0
+#endif
+
+// With MIO_BN_RESIDUAL the skip connection of a residual block is added to the normalized value
+// ahead of the activation, so the sum is never written out.
+#if(MIO_BN_RESIDUAL == 1)
+#define MIO_BN_ADD_RESIDUAL(value, idx) ((value) += (_FLOAT_PREC)(*(residual + (idx))))
+#else
+#define MIO_BN_ADD_RESIDUAL(value, idx)
+#endif
+
 #if(MIO_BN_VARIANT == 0)
 
 #define MIO_BN_SEGTMP (MIO_BN_HW * (MIO_BN_GRP0 / MIO_BN_HW))
@@ -60,6 +72,9 @@ MIOpenBatchNormActivFwdTrainSpatial(float INHW,
 #endif
                                     const __global _FLOAT* __restrict in,
                                     __global _FLOAT* __restrict out,
+#if(MIO_BN_RESIDUAL == 1)
+                                    const __global _FLOAT* __restrict residual,
+#endif
                                     __constant _FLOAT_PREC* __restrict bias,
                                     __constant _FLOAT_PREC* __restrict scale
 
@@ -153,6 +168,7 @@ MIOpenBatchNormActivFwdTrainSpatial(float INHW,
             nid    = n * MIO_BN_SEGIHW + lidihw;
             index  = nid * MIO_BN_CHW + chwid;
             bn_out = mad(pvscale, inhat, pvbias);
+            MIO_BN_ADD_RESIDUAL(bn_out, index);
             ActivationFunction(1, &act_out, &bn_out, gamma, beta, alpha);
             out[index] = (_FLOAT)act_out;
         } // end for
@@ -164,6 +180,7 @@ MIOpenBatchNormActivFwdTrainSpatial(float INHW,
         if(index < MIO_BN_NCHW)
         {
             bn_out = mad(pvscale, inhat, pvbias);
+            MIO_BN_ADD_RESIDUAL(bn_out, index);
             ActivationFunction(1, &act_out, &bn_out, gamma, beta, alpha);
             out[index] = (_FLOAT)act_out;
         }
@@ -216,6 +233,9 @@ MIOpenBatchNormActivFwdTrainSpatial(
 #endif
     const __global _FLOAT* __restrict in,
     __global _FLOAT* __restrict out,
+#if(MIO_BN_RESIDUAL == 1)
+    const __global _FLOAT* __restrict residual,
+#endif
     __constant _FLOAT_PREC* __restrict bias,
     __constant _FLOAT_PREC* __restrict scale
 
@@ -350,6 +370,7 @@ MIOpenBatchNormActivFwdTrainSpatial(
         hwidx  = k - (nidx * MIO_BN_HW);
         index  = nidx * MIO_BN_CHW + chwid + hwidx;
         bn_out = mad(pvscale, (*(in + index) - mean) * invVariance, pvbias);
+        MIO_BN_ADD_RESIDUAL(bn_out, index);
         ActivationFunction(1, &act_out, &bn_out, gamma, beta, alpha);
         out[index] = (_FLOAT)act_out;
 
@@ -376,6 +397,7 @@ MIOpenBatchNormActivFwdTrainSpatial(
             hwidx          = l - (nidx * MIO_BN_HW);
             index          = nidx * MIO_BN_CHW + chwid + hwidx;
             bn_out         = mad(pvscale, xhat[j], pvbias);
+            MIO_BN_ADD_RESIDUAL(bn_out, index);
             ActivationFunction(1, &act_out, &bn_out, gamma, beta, alpha);
             out[index] = (_FLOAT)act_out;
         }
@@ -402,6 +424,7 @@ MIOpenBatchNormActivFwdTrainSpatial(
         if(index < MIO_BN_NCHW)
         {
             bn_out = mad(pvscale, xhat[j], pvbias);
+            MIO_BN_ADD_RESIDUAL(bn_out, index);
             ActivationFunction(1, &act_out, &bn_out, gamma, beta, alpha);
             out[index] = (_FLOAT)act_out;
         }
@@ -441,6 +464,9 @@ MIOpenBatchNormActivFwdTrainSpatial(
 #endif
     const __global _FLOAT* __restrict in,
     __global _FLOAT* __restrict out,
+#if(MIO_BN_RESIDUAL == 1)
+    const __global _FLOAT* __restrict residual,
+#endif
     __constant _FLOAT_PREC* __restrict bias,
     __constant _FLOAT_PREC* __restrict scale
 
@@ -583,6 +609,7 @@ MIOpenBatchNormActivFwdTrainSpatial(
             inhat = ((_FLOAT_PREC)(*(in + index)) - mean) * invVariance;
 #endif
             bn_out = mad(pvscale, inhat, pvbias);
+            MIO_BN_ADD_RESIDUAL(bn_out, index);
             ActivationFunction(1, &act_out, &bn_out, gamma, beta, alpha);
             out[index] = (_FLOAT)act_out;
 
@@ -228,6 +228,8 @@ MIOpenBatchNormBwdSpatial(const __global _FLOAT* __restrict x_in,
 #elif(MIO_BN_VARIANT == 1)
 
 #define MIO_MAX_READ 2
+// fp16 channels of whole half4 vectors are read and written four elements at a time.
+#define MIO_BN_HALF4 (MIO_BN_HALF == 1 && MIO_BN_HW % 4 == 0)
 #define RD_BLK 1
 #define GRPRD (MIO_BN_GRP0 * RD_BLK * 4)
 #define MIO_BN_REM4 (MIO_BN_NHW - ((MIO_BN_NHW / GRPRD) * GRPRD))
@@ -258,20 +260,18 @@ MIOpenBatchNormBwdSpatial(const __global _FLOAT* __restrict x_in,
 {
 
     // SPATIAL
-    _FLOAT_PREC mean        = (_FLOAT_PREC)0.;
-    _FLOAT_PREC invVariance = (_FLOAT_PREC)0.;
-    _FLOAT_PREC pscale      = (_FLOAT_PREC)0.;
-    _FLOAT_ACCUM db         = (_FLOAT_ACCUM)0.;
-    _FLOAT_ACCUM ds         = (_FLOAT_ACCUM)0.;
-    _FLOAT_PREC xhat        = (_FLOAT_PREC)0.;
-    _FLOAT_PREC dyvalue     = (_FLOAT_PREC)0.;
+    _FLOAT_ACCUM mean        = (_FLOAT_ACCUM)0.;
+    _FLOAT_ACCUM invVariance = (_FLOAT_ACCUM)0.;
+    _FLOAT_ACCUM pscale      = (_FLOAT_ACCUM)0.;
+    _FLOAT_ACCUM db          = (_FLOAT_ACCUM)0.;
+    _FLOAT_ACCUM ds          = (_FLOAT_ACCUM)0.;
 
 #if(MIO_BN_USESAVED == 1)
     __local _FLOAT_PREC lmean, lvar;
 #endif
 
     __local _FLOAT_PREC lcl_scale;
-    _FLOAT_PREC NHW = (_FLOAT_PREC)MIO_BN_NHW;
+    _FLOAT_ACCUM NHW = (_FLOAT_ACCUM)MIO_BN_NHW;
 
     unsigned int index = 0;
     unsigned int lid   = get_local_id(0);
@@ -292,9 +292,9 @@ MIOpenBatchNormBwdSpatial(const __global _FLOAT* __restrict x_in,
 
 #if(MIO_BN_USESAVED == 0)
     //==== CALC MEAN and VARIANCE ONCE AGAIN =======================
-    _FLOAT_PREC variance = (_FLOAT_PREC)0.;
-#if(MIO_BN_HW >= 4096)
-    _FLOAT4 read4;
+    _FLOAT_ACCUM variance = (_FLOAT_ACCUM)0.;
+#if(MIO_BN_HW >= 4096 || MIO_BN_HALF4)
+    _FLOAT_ACCUM4 read4;
 #if(MIO_BN_N > MIO_BN_LOOP_UNROLL_MAXN)
     __attribute__((opencl_unroll_hint(4))) for(unsigned int k = lid << 2; k < MIO_BN_LESS4;
                                                k += GRPRD)
@@ -306,15 +306,15 @@ MIOpenBatchNormBwdSpatial(const __global _FLOAT* __restrict x_in,
         nidx  = k / MIO_BN_HW;
         hwidx = k - (nidx * MIO_BN_HW);
         index = nidx * MIO_BN_CHW + chwid + hwidx;
-        read4 = *((const global _FLOAT4*)(x_in + index));
-        mean += (_FLOAT_PREC)read4.x;
-        mean += (_FLOAT_PREC)read4.y;
-        mean += (_FLOAT_PREC)read4.z;
-        mean += (_FLOAT_PREC)read4.w;
-        variance = mad((_FLOAT_PREC)read4.x, (_FLOAT_PREC)read4.x, variance);
-        variance = mad((_FLOAT_PREC)read4.y, (_FLOAT_PREC)read4.y, variance);
-        variance = mad((_FLOAT_PREC)read4.z, (_FLOAT_PREC)read4.z, variance);
-        variance = mad((_FLOAT_PREC)read4.w, (_FLOAT_PREC)read4.w, variance);
+        read4 = _CVT_ACCUM4(*((const global _FLOAT4*)(x_in + index)));
+        mean += read4.x;
+        mean += read4.y;
+        mean += read4.z;
+        mean += read4.w;
+        variance = mad(read4.x, read4.x, variance);
+        variance = mad(read4.y, read4.y, variance);
+        variance = mad(read4.z, read4.z, variance);
+        variance = mad(read4.w, read4.w, variance);
     }
 
 #if(MIO_BN_REM4)
@@ -326,15 +326,15 @@ MIOpenBatchNormBwdSpatial(const __global _FLOAT* __restrict x_in,
         index               = nidx * MIO_BN_CHW + chwid + hwidx;
         if(index < MIO_BN_NCHW)
         {
-            read4 = *((const global _FLOAT4*)(x_in + index));
-            mean += (_FLOAT_PREC)read4.x;
-            mean += (_FLOAT_PREC)read4.y;
-            mean += (_FLOAT_PREC)read4.z;
-            mean += (_FLOAT_PREC)read4.w;
-            variance = mad((_FLOAT_PREC)read4.x, (_FLOAT_PREC)read4.x, variance);
-            variance = mad((_FLOAT_PREC)read4.y, (_FLOAT_PREC)read4.y, variance);
-            variance = mad((_FLOAT_PREC)read4.z, (_FLOAT_PREC)read4.z, variance);
-            variance = mad((_FLOAT_PREC)read4.w, (_FLOAT_PREC)read4.w, variance);
+            read4 = _CVT_ACCUM4(*((const global _FLOAT4*)(x_in + index)));
+            mean += read4.x;
+            mean += read4.y;
+            mean += read4.z;
+            mean += read4.w;
+            variance = mad(read4.x, read4.x, variance);
+            variance = mad(read4.y, read4.y, variance);
+            variance = mad(read4.z, read4.z, variance);
+            variance = mad(read4.w, read4.w, variance);
         }
     }
 #endif
@@ -346,10 +346,10 @@ MIOpenBatchNormBwdSpatial(const __global _FLOAT* __restrict x_in,
     for(unsigned int k = lid; k < MIO_BN_LESS; k += MIO_BN_GRP0)
 #endif
     {
-        nidx           = k / MIO_BN_HW;
-        hwidx          = k - (nidx * MIO_BN_HW);
-        index          = nidx * MIO_BN_CHW + chwid + hwidx;
-        _FLOAT_PREC in = (_FLOAT_PREC)(*(x_in + index));
+        nidx            = k / MIO_BN_HW;
+        hwidx           = k - (nidx * MIO_BN_HW);
+        index           = nidx * MIO_BN_CHW + chwid + hwidx;
+        _FLOAT_ACCUM in = (_FLOAT_ACCUM)(*(x_in + index));
         mean += in;
         variance = mad(in, in, variance);
     }
@@ -360,7 +360,8 @@ MIOpenBatchNormBwdSpatial(const __global _FLOAT* __restrict x_in,
         nidx                = remkey / MIO_BN_HW;
         hwidx               = remkey - (nidx * MIO_BN_HW);
         index               = nidx * MIO_BN_CHW + chwid + hwidx;
-        _FLOAT_PREC in = (index < MIO_BN_NCHW) ? (_FLOAT_PREC)(*(x_in + index)) : (_FLOAT_PREC)0.;
+        _FLOAT_ACCUM in =
+            (index < MIO_BN_NCHW) ? (_FLOAT_ACCUM)(*(x_in + index)) : (_FLOAT_ACCUM)0.;
         mean += in;
         variance = mad(in, in, variance);
     }
@@ -385,18 +386,18 @@ MIOpenBatchNormBwdSpatial(const __global _FLOAT* __restrict x_in,
     {
         variance = 0;
     }
-    invVariance = rsqrt(variance + epsilon);
+    invVariance = rsqrt(variance + (_FLOAT_ACCUM)epsilon);
 
 #else // MIO_BN_USESAVED == 1
 
-    mean        = lmean;
-    invVariance = lvar;
+    mean        = (_FLOAT_ACCUM)lmean;
+    invVariance = (_FLOAT_ACCUM)lvar;
 
 #endif
 
-    _FLOAT4 dyRead4;
-    _FLOAT4 xread4;
-    _FLOAT_PREC4 xhat4;
+    _FLOAT_ACCUM4 dyRead4;
+    _FLOAT_ACCUM4 xread4;
+    _FLOAT_ACCUM4 xhat4;
 #if(MIO_BN_N > MIO_BN_LOOP_UNROLL_MAXN)
     __attribute__((opencl_unroll_hint(4))) for(unsigned int k = lid << 2; k < MIO_BN_LESS4;
                                                k += GRPRD)
@@ -408,20 +409,17 @@ MIOpenBatchNormBwdSpatial(const __global _FLOAT* __restrict x_in,
         nidx    = k / MIO_BN_HW;
         hwidx   = k - (nidx * MIO_BN_HW);
         index   = nidx * MIO_BN_CHW + chwid + hwidx;
-        xread4  = *((const global _FLOAT4*)(x_in + index));
-        dyRead4 = *((const global _FLOAT4*)(dy_in + index));
-        xhat4.x = ((_FLOAT_PREC)xread4.x - mean) * invVariance;
-        xhat4.y = ((_FLOAT_PREC)xread4.y - mean) * invVariance;
-        xhat4.z = ((_FLOAT_PREC)xread4.z - mean) * invVariance;
-        xhat4.w = ((_FLOAT_PREC)xread4.w - mean) * invVariance;
-        db += (_FLOAT_PREC)dyRead4.x;
-        db += (_FLOAT_PREC)dyRead4.y;
-        db += (_FLOAT_PREC)dyRead4.z;
-        db += (_FLOAT_PREC)dyRead4.w;
-        ds = mad(xhat4.x, (_FLOAT_PREC)dyRead4.x, ds);
-        ds = mad(xhat4.y, (_FLOAT_PREC)dyRead4.y, ds);
-        ds = mad(xhat4.z, (_FLOAT_PREC)dyRead4.z, ds);
-        ds = mad(xhat4.w, (_FLOAT_PREC)dyRead4.w, ds);
+        xread4  = _CVT_ACCUM4(*((const global _FLOAT4*)(x_in + index)));
+        dyRead4 = _CVT_ACCUM4(*((const global _FLOAT4*)(dy_in + index)));
+        xhat4   = (xread4 - mean) * invVariance;
+        db += dyRead4.x;
+        db += dyRead4.y;
+        db += dyRead4.z;
+        db += dyRead4.w;
+        ds = mad(xhat4.x, dyRead4.x, ds);
+        ds = mad(xhat4.y, dyRead4.y, ds);
+        ds = mad(xhat4.z, dyRead4.z, ds);
+        ds = mad(xhat4.w, dyRead4.w, ds);
     }
 
 #if(MIO_BN_REM4)
@@ -431,20 +429,17 @@ MIOpenBatchNormBwdSpatial(const __global _FLOAT* __restrict x_in,
     index               = nidx * MIO_BN_CHW + chwid + hwidx;
     if(index < MIO_BN_NCHW)
     {
-        xread4  = *((const global _FLOAT4*)(x_in + index));
-        dyRead4 = *((const global _FLOAT4*)(dy_in + index));
-        xhat4.x = ((_FLOAT_PREC)xread4.x - mean) * invVariance;
-        xhat4.y = ((_FLOAT_PREC)xread4.y - mean) * invVariance;
-        xhat4.z = ((_FLOAT_PREC)xread4.z - mean) * invVariance;
-        xhat4.w = ((_FLOAT_PREC)xread4.w - mean) * invVariance;
-        db += (_FLOAT_PREC)dyRead4.x;
-        db += (_FLOAT_PREC)dyRead4.y;
-        db += (_FLOAT_PREC)dyRead4.z;
-        db += (_FLOAT_PREC)dyRead4.w;
-        ds = mad(xhat4.x, (_FLOAT_PREC)dyRead4.x, ds);
-        ds = mad(xhat4.y, (_FLOAT_PREC)dyRead4.y, ds);
-        ds = mad(xhat4.z, (_FLOAT_PREC)dyRead4.z, ds);
-        ds = mad(xhat4.w, (_FLOAT_PREC)dyRead4.w, ds);
+        xread4  = _CVT_ACCUM4(*((const global _FLOAT4*)(x_in + index)));
+        dyRead4 = _CVT_ACCUM4(*((const global _FLOAT4*)(dy_in + index)));
+        xhat4   = (xread4 - mean) * invVariance;
+        db += dyRead4.x;
+        db += dyRead4.y;
+        db += dyRead4.z;
+        db += dyRead4.w;
+        ds = mad(xhat4.x, dyRead4.x, ds);
+        ds = mad(xhat4.y, dyRead4.y, ds);
+        ds = mad(xhat4.z, dyRead4.z, ds);
+        ds = mad(xhat4.w, dyRead4.w, ds);
     }
 
 #endif
@@ -460,23 +455,51 @@ MIOpenBatchNormBwdSpatial(const __global _FLOAT* __restrict x_in,
     gcn_reduce2(&ds, &db, (_FLOAT_ACCUM)1.0, lcl_data_x2, lcl_data_y2, lid);
 #endif
 
-    pscale           = lcl_scale;
-    _FLOAT_PREC tmp1 = 0.;
-    _FLOAT_PREC tmp2 = 0.;
-    _FLOAT_PREC tmp3 = pscale * invVariance * INHW;
+    pscale            = (_FLOAT_ACCUM)lcl_scale;
+    _FLOAT_ACCUM tmp3 = pscale * invVariance * (_FLOAT_ACCUM)INHW;
     barrier(CLK_LOCAL_MEM_FENCE);
     if(lid == 0)
     {
 #if MIOPEN_USE_FP16 == 1
-        *(dbias + grpid)  = (temp_db >= (float)MAX_VAL) ? MAX_VAL : db;
-        *(dscale + grpid) = (temp_ds >= (float)MAX_VAL || temp_ds < 0) ? MAX_VAL : ds;
+        *(dbias + grpid)  = (_FLOAT_PREC)((db >= (float)MAX_VAL) ? MAX_VAL : db);
+        *(dscale + grpid) = (_FLOAT_PREC)((ds >= (float)MAX_VAL || ds < 0) ? MAX_VAL : ds);
 #else
         *(dbias + grpid)  = (_FLOAT_PREC)db;
         *(dscale + grpid) = (_FLOAT_PREC)ds;
 #endif
     }
 
-    _FLOAT_PREC vals[MIO_MAX_READ];
+#if MIO_BN_HALF4
+    _FLOAT_ACCUM4 vals4;
+    for(unsigned int k = lid << 2; k < MIO_BN_LESS4; k += GRPRD)
+    {
+        nidx    = k / MIO_BN_HW;
+        hwidx   = k - (nidx * MIO_BN_HW);
+        index   = nidx * MIO_BN_CHW + chwid + hwidx;
+        dyRead4 = _CVT_ACCUM4(*((const global _FLOAT4*)(dy_in + index)));
+        xhat4   = (_CVT_ACCUM4(*((const global _FLOAT4*)(x_in + index))) - mean) * invVariance;
+        vals4   = tmp3 * (mad((_FLOAT_ACCUM4)NHW, dyRead4, (_FLOAT_ACCUM4)(-db)) - xhat4 * ds);
+        *((global _FLOAT4*)(dx_out + index)) = _CVT_FLOAT4(vals4);
+    }
+
+#if(MIO_BN_REM4)
+    nidx  = remkey / MIO_BN_HW;
+    hwidx = remkey - (nidx * MIO_BN_HW);
+    index = nidx * MIO_BN_CHW + chwid + hwidx;
+    if(index < MIO_BN_NCHW)
+    {
+        dyRead4 = _CVT_ACCUM4(*((const global _FLOAT4*)(dy_in + index)));
+        xhat4   = (_CVT_ACCUM4(*((const global _FLOAT4*)(x_in + index))) - mean) * invVariance;
+        vals4   = tmp3 * (mad((_FLOAT_ACCUM4)NHW, dyRead4, (_FLOAT_ACCUM4)(-db)) - xhat4 * ds);
+        *((global _FLOAT4*)(dx_out + index)) = _CVT_FLOAT4(vals4);
+    }
+#endif
+#else
+    _FLOAT_ACCUM xhat    = (_FLOAT_ACCUM)0.;
+    _FLOAT_ACCUM dyvalue = (_FLOAT_ACCUM)0.;
+    _FLOAT_ACCUM tmp1    = 0.;
+    _FLOAT_ACCUM tmp2    = 0.;
+    _FLOAT_ACCUM vals[MIO_MAX_READ];
 #if(MIO_BN_N > MIO_BN_LOOP_UNROLL_MAXN)
     __attribute__((opencl_unroll_hint(4))) for(unsigned int k = (MIO_MAX_READ * lid);
                                                k < MIO_BN_LESSOUT;
@@ -493,18 +516,11 @@ MIOpenBatchNormBwdSpatial(const __global _FLOAT* __restrict x_in,
             nidx           = l / MIO_BN_HW;
             hwidx          = l - (nidx * MIO_BN_HW);
             index          = nidx * MIO_BN_CHW + chwid + hwidx;
-            dyvalue        = (_FLOAT_PREC)(*(dy_in + index));
-            xhat = ((_FLOAT_PREC)(*(x_in + index)) - mean) * invVariance;
-#if MIOPEN_USE_FP16 == 1
-            float temp_tmp1 = mad((float)NHW, (float)dyvalue, -temp_db);
-            float temp_tmp2 = -((float)xhat) * temp_ds;
-            float temp_vals = (float)tmp3 * (temp_tmp2 + temp_tmp1);
-            vals[j]         = (_FLOAT_PREC)temp_vals;
-#else
-            tmp1    = mad(NHW, dyvalue, -db);
-            tmp2    = -xhat * ds;
-            vals[j] = tmp3 * (tmp2 + tmp1);
-#endif
+            dyvalue        = (_FLOAT_ACCUM)(*(dy_in + index));
+            xhat           = ((_FLOAT_ACCUM)(*(x_in + index)) - mean) * invVariance;
+            tmp1           = mad(NHW, dyvalue, -db);
+            tmp2           = -xhat * ds;
+            vals[j]        = tmp3 * (tmp2 + tmp1);
         }
         barrier(CLK_GLOBAL_MEM_FENCE);
 #if(MIO_BN_N > MIO_BN_LOOP_UNROLL_MAXN)
@@ -535,8 +551,8 @@ MIOpenBatchNormBwdSpatial(const __global _FLOAT* __restrict x_in,
         index          = nidx * MIO_BN_CHW + chwid + hwidx;
         if(index < MIO_BN_NCHW)
         {
-            dyvalue = (_FLOAT_PREC)(*(dy_in + index));
-            xhat    = ((_FLOAT_PREC)(*(x_in + index)) - mean) * invVariance;
+            dyvalue = (_FLOAT_ACCUM)(*(dy_in + index));
+            xhat    = ((_FLOAT_ACCUM)(*(x_in + index)) - mean) * invVariance;
             tmp1    = mad(NHW, dyvalue, -db);
             tmp2    = -xhat * ds;
             vals[j] = tmp3 * (tmp2 + tmp1);
@@ -555,10 +571,11 @@ MIOpenBatchNormBwdSpatial(const __global _FLOAT* __restrict x_in,
         index          = nidx * MIO_BN_CHW + chwid + hwidx;
         if(index < MIO_BN_NCHW)
         {
-            *(dx_out + index) = (_FLOAT_PREC)vals[j];
+            *(dx_out + index) = (_FLOAT)vals[j];
         }
     }
 #endif
+#endif
 }
 
 #elif(MIO_BN_VARIANT == 2)
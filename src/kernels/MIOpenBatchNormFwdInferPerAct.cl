@@ -36,7 +36,7 @@
 
 __attribute__((reqd_work_group_size(MIO_BN_GRP0, MIO_BN_GRP1, MIO_BN_GRP2))) __kernel void
 MIOpenBatchNormFwdInferPerActivationEst(const __global _FLOAT* in,
-                                        __global _FLOAT* __restrict out,
+                                        __global _FLOAT* out,
                                         __global _FLOAT_PREC* __restrict estimatedMean,
                                         __global _FLOAT_PREC* __restrict estimatedVariance,
                                         const __global _FLOAT_PREC* __restrict scale,
@@ -34,9 +34,15 @@
 
 #include "batchnorm_functions.h"
 
+// Elements of the channel image taken by a work-item at a time. 2 requires fp16 data and an
+// even image size.
+#ifndef MIO_BN_VEC_SIZE
+#define MIO_BN_VEC_SIZE 1
+#endif
+
 __attribute__((reqd_work_group_size(MIO_BN_GRP0, MIO_BN_GRP1, MIO_BN_GRP2))) __kernel void
-MIOpenBatchNormFwdInferSpatialEst(const __global _FLOAT* __restrict in, /* x input */
-                                  __global _FLOAT* __restrict out,      /* y output */
+MIOpenBatchNormFwdInferSpatialEst(const __global _FLOAT* in, /* x input */
+                                  __global _FLOAT* out,      /* y output */
                                   const __global _FLOAT_PREC* __restrict estimatedMean,
                                   const __global _FLOAT_PREC* __restrict estimatedVariance,
                                   const __global _FLOAT_PREC* __restrict scale,
@@ -52,25 +58,40 @@ MIOpenBatchNormFwdInferSpatialEst(const __global _FLOAT* __restrict in, /* x inp
 
     unsigned int index;
 
-    _FLOAT_PREC mean, variance, invVariance;
-    _FLOAT_PREC inhat;
-    _FLOAT_PREC pscale, pbias;
+    _FLOAT_ACCUM mean, variance, invVariance;
+    _FLOAT_ACCUM pscale, pbias;
 
-    mean        = *(estimatedMean + xgid);
-    variance    = *(estimatedVariance + xgid);
-    pscale      = *(scale + xgid);
-    pbias       = *(bias + xgid);
-    invVariance = rsqrt(fabs(variance + epsilon));
+    mean        = (_FLOAT_ACCUM)(*(estimatedMean + xgid));
+    variance    = (_FLOAT_ACCUM)(*(estimatedVariance + xgid));
+    pscale      = (_FLOAT_ACCUM)(*(scale + xgid));
+    pbias       = (_FLOAT_ACCUM)(*(bias + xgid));
+    invVariance = rsqrt(fabs(variance + (_FLOAT_ACCUM)epsilon));
 
+#if MIO_BN_VEC_SIZE == 2
+    // The image size and the batch stride are even, so every pair is aligned.
+    _FLOAT_ACCUM2 inhat2;
+    for(int idx = 2 * ygid; idx < imageDims; idx += 2 * get_global_size(1))
+    {
+        for(int n = 0; n < batchSize; n++)
+        {
+            index  = (n * batchStride) + (xgid * imageDims) + idx;
+            inhat2 = (_CVT_ACCUM2(*((const global _FLOAT2*)(in + index))) - mean) * invVariance;
+            *((global _FLOAT2*)(out + index)) =
+                _CVT_FLOAT2(mad((_FLOAT_ACCUM2)pscale, inhat2, (_FLOAT_ACCUM2)pbias));
+        }
+    }
+#else
+    _FLOAT_ACCUM inhat;
     for(int idx = ygid; idx < imageDims; idx += get_global_size(1))
     {
         for(int n = 0; n < batchSize; n++)
         {
             index      = (n * batchStride) + (xgid * imageDims) + idx;
-            inhat      = ((_FLOAT_PREC)(*(in + index)) - mean) * invVariance;
+            inhat      = ((_FLOAT_ACCUM)(*(in + index)) - mean) * invVariance;
             out[index] = (_FLOAT)(mad(pscale, inhat, pbias));
         }
     }
+#endif
 } // end spatial norm
 
 #ifdef __clang__
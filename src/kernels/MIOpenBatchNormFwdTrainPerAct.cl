@@ -37,10 +37,10 @@
 //==================== PER ACTIVATION =======================
 
 __kernel void MIOpenBatchNormFwdTrainPerActivation(
-    const __global _FLOAT* __restrict in,         /* x input */
+    const __global _FLOAT* in,                    /* x input */
     unsigned int in_nstride,                      /* C*H*W */
     unsigned int in_cstride,                      /* H*W */
-    __global _FLOAT* __restrict out,              /* y output */
+    __global _FLOAT* out,                         /* y output */
     const __global _FLOAT_PREC* __restrict scale, /* gamma 1xCxHxW */
     const __global _FLOAT_PREC* __restrict bias,  /* beta 1xCxHxW */
 #if(MIO_RUNNING_RESULT == 1)
@@ -51,8 +51,8 @@
 #define MIO_BN_SNHW (MIO_BN_NLOOPM * MIO_BN_SEGIHW)
 
 __attribute__((reqd_work_group_size(MIO_BN_GRP0, MIO_BN_GRP1, MIO_BN_GRP2))) __kernel void
-MIOpenBatchNormFwdTrainSpatial(const __global _FLOAT* __restrict in,
-                               __global _FLOAT* __restrict out,
+MIOpenBatchNormFwdTrainSpatial(const __global _FLOAT* in,
+                               __global _FLOAT* out,
                                __constant _FLOAT_PREC* __restrict scale,
                                __constant _FLOAT_PREC* __restrict bias,
                                _FLOAT_PREC INHW,
@@ -184,6 +184,8 @@ MIOpenBatchNormFwdTrainSpatial(const __global _FLOAT* __restrict in,
 #else
 #define MIO_MAX_READ 2
 #endif
+// fp16 channels of whole half4 vectors are read and written four elements at a time.
+#define MIO_BN_HALF4 (MIO_BN_HALF == 1 && MIO_BN_HW % 4 == 0)
 #define RD_BLK 1
 #define GRPRD (MIO_BN_GRP0 * RD_BLK * 4)
 #define MIO_BN_REM4 (MIO_BN_NHW - ((MIO_BN_NHW / GRPRD) * GRPRD))
@@ -198,8 +200,8 @@ MIOpenBatchNormFwdTrainSpatial(const __global _FLOAT* __restrict in,
 #define MIO_BN_LESSOUT (MIO_BN_NHW - MIO_BN_REMOUT)
 
 __attribute__((reqd_work_group_size(MIO_BN_GRP0, MIO_BN_GRP1, MIO_BN_GRP2))) __kernel void
-MIOpenBatchNormFwdTrainSpatial(const __global _FLOAT* __restrict in,
-                               __global _FLOAT* __restrict out,
+MIOpenBatchNormFwdTrainSpatial(const __global _FLOAT* in,
+                               __global _FLOAT* out,
                                __constant _FLOAT_PREC* __restrict scale,
                                __constant _FLOAT_PREC* __restrict bias,
                                _FLOAT_PREC INHW,
@@ -219,10 +221,10 @@ MIOpenBatchNormFwdTrainSpatial(const __global _FLOAT* __restrict in,
 
     // SPATIAL
 
-    _FLOAT_PREC mean        = (_FLOAT_PREC)0.;
-    _FLOAT_PREC variance    = (_FLOAT_PREC)0.;
-    _FLOAT_PREC invVariance = (_FLOAT_PREC)0.;
-    _FLOAT_PREC pvscale, pvbias;
+    _FLOAT_ACCUM mean        = (_FLOAT_ACCUM)0.;
+    _FLOAT_ACCUM variance    = (_FLOAT_ACCUM)0.;
+    _FLOAT_ACCUM invVariance = (_FLOAT_ACCUM)0.;
+    _FLOAT_ACCUM pvscale, pvbias;
 
     __local _FLOAT_PREC lcl_bias;
     __local _FLOAT_PREC lcl_scale;
@@ -241,23 +243,23 @@ MIOpenBatchNormFwdTrainSpatial(const __global _FLOAT* __restrict in,
     }
     barrier(CLK_LOCAL_MEM_FENCE);
 
-#if(MIO_BN_HW >= 4096)
-    _FLOAT4 read4;
+#if(MIO_BN_HW >= 4096 || MIO_BN_HALF4)
+    _FLOAT_ACCUM4 read4;
     __attribute__((opencl_unroll_hint(2))) for(unsigned int k = lid << 2; k < MIO_BN_LESS4;
                                                k += GRPRD)
     {
         nidx  = k / MIO_BN_HW;
         hwidx = k - (nidx * MIO_BN_HW);
         index = nidx * MIO_BN_CHW + chwid + hwidx;
-        read4 = *((const global _FLOAT4*)(in + index));
-        mean += (_FLOAT_PREC)read4.x;
-        mean += (_FLOAT_PREC)read4.y;
-        mean += (_FLOAT_PREC)read4.z;
-        mean += (_FLOAT_PREC)read4.w;
-        variance = mad((_FLOAT_PREC)read4.x, (_FLOAT_PREC)read4.x, variance);
-        variance = mad((_FLOAT_PREC)read4.y, (_FLOAT_PREC)read4.y, variance);
-        variance = mad((_FLOAT_PREC)read4.z, (_FLOAT_PREC)read4.z, variance);
-        variance = mad((_FLOAT_PREC)read4.w, (_FLOAT_PREC)read4.w, variance);
+        read4 = _CVT_ACCUM4(*((const global _FLOAT4*)(in + index)));
+        mean += read4.x;
+        mean += read4.y;
+        mean += read4.z;
+        mean += read4.w;
+        variance = mad(read4.x, read4.x, variance);
+        variance = mad(read4.y, read4.y, variance);
+        variance = mad(read4.z, read4.z, variance);
+        variance = mad(read4.w, read4.w, variance);
     }
 
 #if(MIO_BN_REM4)
@@ -267,15 +269,15 @@ MIOpenBatchNormFwdTrainSpatial(const __global _FLOAT* __restrict in,
     index               = nidx * MIO_BN_CHW + chwid + hwidx;
     if(index < MIO_BN_NCHW)
     {
-        read4 = *((const global _FLOAT4*)(in + index));
-        mean += (_FLOAT_PREC)read4.x;
-        mean += (_FLOAT_PREC)read4.y;
-        mean += (_FLOAT_PREC)read4.z;
-        mean += (_FLOAT_PREC)read4.w;
-        variance = mad((_FLOAT_PREC)read4.x, (_FLOAT_PREC)read4.x, variance);
-        variance = mad((_FLOAT_PREC)read4.y, (_FLOAT_PREC)read4.y, variance);
-        variance = mad((_FLOAT_PREC)read4.z, (_FLOAT_PREC)read4.z, variance);
-        variance = mad((_FLOAT_PREC)read4.w, (_FLOAT_PREC)read4.w, variance);
+        read4 = _CVT_ACCUM4(*((const global _FLOAT4*)(in + index)));
+        mean += read4.x;
+        mean += read4.y;
+        mean += read4.z;
+        mean += read4.w;
+        variance = mad(read4.x, read4.x, variance);
+        variance = mad(read4.y, read4.y, variance);
+        variance = mad(read4.z, read4.z, variance);
+        variance = mad(read4.w, read4.w, variance);
     }
 
 #endif
@@ -287,7 +289,7 @@ MIOpenBatchNormFwdTrainSpatial(const __global _FLOAT* __restrict in,
         nidx            = k / MIO_BN_HW;
         hwidx           = k - (nidx * MIO_BN_HW);
         index           = nidx * MIO_BN_CHW + chwid + hwidx;
-        _FLOAT_PREC xin = (_FLOAT_PREC)(*(in + index));
+        _FLOAT_ACCUM xin = (_FLOAT_ACCUM)(*(in + index));
         mean += xin;
         variance = mad(xin, xin, variance);
     }
@@ -298,7 +300,8 @@ MIOpenBatchNormFwdTrainSpatial(const __global _FLOAT* __restrict in,
         nidx                = remkey / MIO_BN_HW;
         hwidx               = remkey - (nidx * MIO_BN_HW);
         index               = nidx * MIO_BN_CHW + chwid + hwidx;
-        _FLOAT_PREC xin = (index < MIO_BN_NCHW) ? (_FLOAT_PREC)(*(in + index)) : (_FLOAT_PREC)0.;
+        _FLOAT_ACCUM xin =
+            (index < MIO_BN_NCHW) ? (_FLOAT_ACCUM)(*(in + index)) : (_FLOAT_ACCUM)0.;
         mean += xin;
         variance = mad(xin, xin, variance);
     }
@@ -322,12 +325,37 @@ MIOpenBatchNormFwdTrainSpatial(const __global _FLOAT* __restrict in,
     {
         variance = 0;
     }
-    invVariance = rsqrt(variance + epsilon);
+    invVariance = rsqrt(variance + (_FLOAT_ACCUM)epsilon);
 
-    pvscale = lcl_scale;
-    pvbias  = lcl_bias;
+    pvscale = (_FLOAT_ACCUM)lcl_scale;
+    pvbias  = (_FLOAT_ACCUM)lcl_bias;
 
-#if(MIO_BN_REM == 0)
+#if MIO_BN_HALF4
+    _FLOAT_ACCUM4 xhat4;
+    __attribute__((opencl_unroll_hint(2))) for(unsigned int k = lid << 2; k < MIO_BN_LESS4;
+                                               k += GRPRD)
+    {
+        nidx  = k / MIO_BN_HW;
+        hwidx = k - (nidx * MIO_BN_HW);
+        index = nidx * MIO_BN_CHW + chwid + hwidx;
+        xhat4 = (_CVT_ACCUM4(*((const global _FLOAT4*)(in + index))) - mean) * invVariance;
+        *((global _FLOAT4*)(out + index)) =
+            _CVT_FLOAT4(mad((_FLOAT_ACCUM4)pvscale, xhat4, (_FLOAT_ACCUM4)pvbias));
+    }
+
+#if(MIO_BN_REM4)
+    unsigned int remkeyout = (lid << 2) + MIO_BN_LESS4;
+    nidx                   = remkeyout / MIO_BN_HW;
+    hwidx                  = remkeyout - (nidx * MIO_BN_HW);
+    index                  = nidx * MIO_BN_CHW + chwid + hwidx;
+    if(index < MIO_BN_NCHW)
+    {
+        xhat4 = (_CVT_ACCUM4(*((const global _FLOAT4*)(in + index))) - mean) * invVariance;
+        *((global _FLOAT4*)(out + index)) =
+            _CVT_FLOAT4(mad((_FLOAT_ACCUM4)pvscale, xhat4, (_FLOAT_ACCUM4)pvbias));
+    }
+#endif
+#elif(MIO_BN_REM == 0)
     __attribute__((opencl_unroll_hint(2))) for(unsigned int k = lid; k < MIO_BN_LESS;
                                                k += MIO_BN_GRP0)
     {
@@ -335,10 +363,10 @@ MIOpenBatchNormFwdTrainSpatial(const __global _FLOAT* __restrict in,
         hwidx = k - (nidx * MIO_BN_HW);
         index = nidx * MIO_BN_CHW + chwid + hwidx;
         out[index] =
-            (_FLOAT)mad(pvscale, ((_FLOAT_PREC)(*(in + index)) - mean) * invVariance, pvbias);
+            (_FLOAT)mad(pvscale, ((_FLOAT_ACCUM)(*(in + index)) - mean) * invVariance, pvbias);
     } // end for
 #else
-    _FLOAT_PREC xhat[MIO_MAX_READ];
+    _FLOAT_ACCUM xhat[MIO_MAX_READ];
     __attribute__((opencl_unroll_hint(2))) for(unsigned int k = (MIO_MAX_READ * lid);
                                                k < MIO_BN_LESSOUT;
                                                k += MIO_BN_CHUNK)
@@ -349,7 +377,7 @@ MIOpenBatchNormFwdTrainSpatial(const __global _FLOAT* __restrict in,
             nidx           = l / MIO_BN_HW;
             hwidx          = l - (nidx * MIO_BN_HW);
             index          = nidx * MIO_BN_CHW + chwid + hwidx;
-            xhat[j]        = ((_FLOAT_PREC)(*(in + index)) - mean) * invVariance;
+            xhat[j]        = ((_FLOAT_ACCUM)(*(in + index)) - mean) * invVariance;
         }
         barrier(CLK_GLOBAL_MEM_FENCE);
         for(unsigned int j = 0; j < MIO_MAX_READ; j++)
@@ -370,8 +398,9 @@ MIOpenBatchNormFwdTrainSpatial(const __global _FLOAT* __restrict in,
         nidx            = l / MIO_BN_HW;
         hwidx           = l - (nidx * MIO_BN_HW);
         index           = nidx * MIO_BN_CHW + chwid + hwidx;
-        _FLOAT_PREC xin = (index < MIO_BN_NCHW) ? (_FLOAT_PREC)(*(in + index)) : (_FLOAT_PREC)0.;
-        xhat[j]         = (xin - mean) * invVariance;
+        _FLOAT_ACCUM xin =
+            (index < MIO_BN_NCHW) ? (_FLOAT_ACCUM)(*(in + index)) : (_FLOAT_ACCUM)0.;
+        xhat[j] = (xin - mean) * invVariance;
     }
     barrier(CLK_GLOBAL_MEM_FENCE);
     for(unsigned int j = 0; j < MIO_MAX_READ; j++)
@@ -404,8 +433,8 @@ MIOpenBatchNormFwdTrainSpatial(const __global _FLOAT* __restrict in,
 #elif(MIO_BN_VARIANT == 2) // MULTI-KERNEL reduction for > 33M elements
 
 __attribute__((reqd_work_group_size(MIO_BN_GRP0, MIO_BN_GRP1, MIO_BN_GRP2))) __kernel void
-MIOpenBatchNormFwdTrainSpatialNorm(const __global _FLOAT* __restrict in,
-                                   __global _FLOAT* __restrict out,
+MIOpenBatchNormFwdTrainSpatialNorm(const __global _FLOAT* in,
+                                   __global _FLOAT* out,
                                    const __global _FLOAT* __restrict scale,
                                    const __global _FLOAT* __restrict bias)
 {
@@ -542,7 +571,7 @@ MIOpenBatchNormFwdTrainSpatialFinalMeanVariance(
 }
 
 __attribute__((reqd_work_group_size(MIO_BN_GRP0, MIO_BN_GRP1, MIO_BN_GRP2))) __kernel void
-MIOpenBatchNormFwdTrainSpatialMeanVariance(const __global _FLOAT* __restrict in,
+MIOpenBatchNormFwdTrainSpatialMeanVariance(const __global _FLOAT* in,
                                            __global _FLOAT* __restrict mvbuff)
 {
 
@@ -595,8 +624,8 @@ MIOpenBatchNormFwdTrainSpatialMeanVariance(const __global _FLOAT* __restrict in,
 
 // This kernel implies the image is greater than a wavefront, but smaller than 257
 __attribute__((reqd_work_group_size(MIO_BN_GRP0, MIO_BN_GRP1, MIO_BN_GRP2))) __kernel void
-MIOpenBatchNormFwdTrainSpatial(const __global _FLOAT* __restrict in,
-                               __global _FLOAT* __restrict out,
+MIOpenBatchNormFwdTrainSpatial(const __global _FLOAT* in,
+                               __global _FLOAT* out,
                                __constant _FLOAT_PREC* __restrict scale,
                                __constant _FLOAT_PREC* __restrict bias,
                                _FLOAT_PREC INHW,
@@ -714,8 +743,8 @@ MIOpenBatchNormFwdTrainSpatial(const __global _FLOAT* __restrict in,
 #endif
 // Batch size 1 and 2
 /* __attribute__((reqd_work_group_size(MIO_BN_GRP0, MIO_BN_GRP1, MIO_BN_GRP2)))  */
-__kernel void MIOpenBatchNormFwdTrainSpatial(const __global _FLOAT* __restrict in,
-                                             __global _FLOAT* __restrict out,
+__kernel void MIOpenBatchNormFwdTrainSpatial(const __global _FLOAT* in,
+                                             __global _FLOAT* out,
                                              __constant _FLOAT_PREC* __restrict scale,
                                              __constant _FLOAT_PREC* __restrict bias,
                                              _FLOAT_PREC INHW,
@@ -826,6 +855,246 @@ __kernel void MIOpenBatchNormFwdTrainSpatial(const __global _FLOAT* __restrict i
 #pragma clang diagnostic pop
 #endif
 
+#elif(MIO_BN_VARIANT == 5) // MULTI-KERNEL Welford reduction over chunks of N*H*W
+
+// The N*H*W elements of every channel are split into chunks of MIO_BN_CHUNK, one work-group
+// each, so that a few channels of very many elements still fill the device. Every chunk keeps
+// its partial Welford statistics, and then the merged mean and inverse variance, in the
+// first elements of its own part of the output, which is only normalized by the last kernel.
+// The host keeps every chunk longer than these slots.
+
+#define MIO_BN_NCHUNKS ((MIO_BN_NHW + MIO_BN_CHUNK - 1) / MIO_BN_CHUNK)
+
+#if MIOPEN_USE_FP32 == 1
+#define MIO_BN_STASH_WIDTH 1
+#else
+#define MIO_BN_STASH_WIDTH 2
+#endif
+
+#define MIO_BN_STASH_M2 MIO_BN_STASH_WIDTH
+#define MIO_BN_STASH_MEAN (2 * MIO_BN_STASH_WIDTH)
+#define MIO_BN_STASH_IVAR (3 * MIO_BN_STASH_WIDTH)
+
+// Address of the element e of the N*H*W elements of a channel
+static inline unsigned int welford_index(unsigned int channel, unsigned int e)
+{
+    return (e / MIO_BN_HW) * MIO_BN_CHW + channel * MIO_BN_HW + e % MIO_BN_HW;
+}
+
+// Keeps a float in the output at the element e of a channel, in two elements for half.
+static inline void
+welford_stash(__global _FLOAT* buff, unsigned int channel, unsigned int e, _FLOAT_ACCUM value)
+{
+#if MIOPEN_USE_FP32 == 1
+    buff[welford_index(channel, e)] = value;
+#else
+    const half2 bits                    = as_half2(value);
+    buff[welford_index(channel, e)]     = bits.x;
+    buff[welford_index(channel, e + 1)] = bits.y;
+#endif
+}
+
+static inline _FLOAT_ACCUM
+welford_unstash(const __global _FLOAT* buff, unsigned int channel, unsigned int e)
+{
+#if MIOPEN_USE_FP32 == 1
+    return buff[welford_index(channel, e)];
+#else
+    return as_float((half2)(buff[welford_index(channel, e)], buff[welford_index(channel, e + 1)]));
+#endif
+}
+
+static inline unsigned int welford_chunk_size(unsigned int chunk)
+{
+    const unsigned int start = chunk * MIO_BN_CHUNK;
+    return (start + MIO_BN_CHUNK > MIO_BN_NHW) ? MIO_BN_NHW - start : MIO_BN_CHUNK;
+}
+
+// Merges the statistics (count_b, mean_b, m2_b) into (count, mean, m2).
+static inline void welford_merge(_FLOAT_ACCUM* count,
+                                 _FLOAT_ACCUM* mean,
+                                 _FLOAT_ACCUM* m2,
+                                 _FLOAT_ACCUM count_b,
+                                 _FLOAT_ACCUM mean_b,
+                                 _FLOAT_ACCUM m2_b)
+{
+    const _FLOAT_ACCUM total = *count + count_b;
+    if(total == (_FLOAT_ACCUM)0)
+        return;
+    const _FLOAT_ACCUM delta  = mean_b - *mean;
+    const _FLOAT_ACCUM weight = count_b / total;
+    *mean                     = mad(delta, weight, *mean);
+    *m2 += m2_b + delta * delta * *count * weight;
+    *count = total;
+}
+
+// Tree merge of the statistics of the work-group, left in the first element of each array
+static inline void welford_lds_merge(_FLOAT_ACCUM* count,
+                                     _FLOAT_ACCUM* mean,
+                                     _FLOAT_ACCUM* m2,
+                                     local _FLOAT_ACCUM* lcl_count,
+                                     local _FLOAT_ACCUM* lcl_mean,
+                                     local _FLOAT_ACCUM* lcl_m2,
+                                     unsigned int lid)
+{
+    lcl_count[lid] = *count;
+    lcl_mean[lid]  = *mean;
+    lcl_m2[lid]    = *m2;
+    barrier(CLK_LOCAL_MEM_FENCE);
+    for(unsigned int s = MIO_BN_GRP1 >> 1; s > 0; s >>= 1)
+    {
+        if(lid < s)
+        {
+            welford_merge(count, mean, m2, lcl_count[lid + s], lcl_mean[lid + s], lcl_m2[lid + s]);
+            lcl_count[lid] = *count;
+            lcl_mean[lid]  = *mean;
+            lcl_m2[lid]    = *m2;
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+    *count = lcl_count[0];
+    *mean  = lcl_mean[0];
+    *m2    = lcl_m2[0];
+}
+
+__attribute__((reqd_work_group_size(MIO_BN_GRP0, MIO_BN_GRP1, MIO_BN_GRP2))) __kernel void
+MIOpenBatchNormFwdTrainSpatialMeanVariance(const __global _FLOAT* in,
+                                           __global _FLOAT* __restrict mvbuff)
+{
+    local _FLOAT_ACCUM lcl_count[MIO_BN_GRP1];
+    local _FLOAT_ACCUM lcl_mean[MIO_BN_GRP1];
+    local _FLOAT_ACCUM lcl_m2[MIO_BN_GRP1];
+
+    const unsigned int lid     = get_local_id(1);
+    const unsigned int channel = get_global_id(0);
+    const unsigned int chunk   = get_group_id(1);
+    const unsigned int start   = chunk * MIO_BN_CHUNK;
+    const unsigned int end     = start + welford_chunk_size(chunk);
+
+    _FLOAT_ACCUM count = (_FLOAT_ACCUM)0.;
+    _FLOAT_ACCUM mean  = (_FLOAT_ACCUM)0.;
+    _FLOAT_ACCUM m2    = (_FLOAT_ACCUM)0.;
+    for(unsigned int e = start + lid; e < end; e += MIO_BN_GRP1)
+    {
+        const _FLOAT_ACCUM value = (_FLOAT_ACCUM)(*(in + welford_index(channel, e)));
+        count += (_FLOAT_ACCUM)1.;
+        const _FLOAT_ACCUM delta = value - mean;
+        mean += delta / count;
+        m2 = mad(delta, value - mean, m2);
+    }
+
+    welford_lds_merge(&count, &mean, &m2, lcl_count, lcl_mean, lcl_m2, lid);
+
+    // The count of a chunk is known from its index.
+    if(lid == 0)
+    {
+        welford_stash(mvbuff, channel, start, mean);
+        welford_stash(mvbuff, channel, start + MIO_BN_STASH_M2, m2);
+    }
+} // end spatial mean kernel
+
+__attribute__((reqd_work_group_size(MIO_BN_GRP0, MIO_BN_GRP1, MIO_BN_GRP2))) __kernel void
+MIOpenBatchNormFwdTrainSpatialFinalMeanVariance(
+    __global _FLOAT* __restrict meanvarbuff,
+    _FLOAT_PREC INHW
+#if(MIO_RUNNING_RESULT == 1)
+    ,
+    double expAvgFactor /* input momentum */
+    ,
+    __global _FLOAT_PREC* __restrict resultRunningMean, /*input and output*/
+    __global _FLOAT_PREC* __restrict resultRunningVariance
+#endif
+    ,
+    double epsilon
+#if(MIO_SAVE_MEAN_VARIANCE == 1)
+    ,
+    __global _FLOAT_PREC* __restrict resultSaveMean /*output only*/
+    ,
+    __global _FLOAT_PREC* __restrict resultSaveInvVariance
+#endif
+    )
+{
+    local _FLOAT_ACCUM lcl_count[MIO_BN_GRP1];
+    local _FLOAT_ACCUM lcl_mean[MIO_BN_GRP1];
+    local _FLOAT_ACCUM lcl_m2[MIO_BN_GRP1];
+
+    const unsigned int lid     = get_local_id(1);
+    const unsigned int channel = get_global_id(0);
+    const unsigned int chunk   = get_group_id(1);
+
+    // Every chunk merges the partial statistics of all of them, so it can go on to normalize
+    // without waiting for the others.
+    _FLOAT_ACCUM count = (_FLOAT_ACCUM)0.;
+    _FLOAT_ACCUM mean  = (_FLOAT_ACCUM)0.;
+    _FLOAT_ACCUM m2    = (_FLOAT_ACCUM)0.;
+    for(unsigned int k = lid; k < MIO_BN_NCHUNKS; k += MIO_BN_GRP1)
+    {
+        const unsigned int start = k * MIO_BN_CHUNK;
+        welford_merge(&count,
+                      &mean,
+                      &m2,
+                      (_FLOAT_ACCUM)welford_chunk_size(k),
+                      welford_unstash(meanvarbuff, channel, start),
+                      welford_unstash(meanvarbuff, channel, start + MIO_BN_STASH_M2));
+    }
+
+    welford_lds_merge(&count, &mean, &m2, lcl_count, lcl_mean, lcl_m2, lid);
+
+    _FLOAT_ACCUM variance = m2 * (_FLOAT_ACCUM)INHW;
+    variance              = (variance < 0) ? (_FLOAT_ACCUM)0. : variance;
+    const _FLOAT_ACCUM invVariance = rsqrt(variance + (_FLOAT_ACCUM)epsilon);
+
+    if(lid == 0)
+    {
+        const unsigned int start = chunk * MIO_BN_CHUNK;
+        welford_stash(meanvarbuff, channel, start + MIO_BN_STASH_MEAN, mean);
+        welford_stash(meanvarbuff, channel, start + MIO_BN_STASH_IVAR, invVariance);
+
+        if(chunk == 0)
+        {
+#if(MIO_RUNNING_RESULT == 1)
+            running_stash(
+                resultRunningMean, resultRunningVariance, expAvgFactor, mean, variance, channel);
+#endif
+
+#if(MIO_SAVE_MEAN_VARIANCE == 1)
+            saved_stash(resultSaveMean, resultSaveInvVariance, mean, invVariance, channel);
+#endif
+        }
+    }
+}
+
+__attribute__((reqd_work_group_size(MIO_BN_GRP0, MIO_BN_GRP1, MIO_BN_GRP2))) __kernel void
+MIOpenBatchNormFwdTrainSpatialNorm(const __global _FLOAT* in,
+                                   __global _FLOAT* out,
+                                   const __global _FLOAT_PREC* __restrict scale,
+                                   const __global _FLOAT_PREC* __restrict bias)
+{
+    local _FLOAT_ACCUM lcl_mean, lcl_ivar;
+
+    const unsigned int lid     = get_local_id(1);
+    const unsigned int channel = get_global_id(0);
+    const unsigned int chunk   = get_group_id(1);
+    const unsigned int start   = chunk * MIO_BN_CHUNK;
+    const unsigned int end     = start + welford_chunk_size(chunk);
+
+    if(lid == 0)
+    {
+        lcl_mean = welford_unstash(out, channel, start + MIO_BN_STASH_MEAN);
+        lcl_ivar = welford_unstash(out, channel, start + MIO_BN_STASH_IVAR);
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    const _FLOAT_ACCUM mean      = lcl_mean;
+    const _FLOAT_ACCUM pvt_scale = (_FLOAT_ACCUM)(*(scale + channel)) * lcl_ivar;
+    const _FLOAT_ACCUM pvt_bias  = (_FLOAT_ACCUM)(*(bias + channel));
+    for(unsigned int e = start + lid; e < end; e += MIO_BN_GRP1)
+    {
+        const unsigned int index = welford_index(channel, e);
+        out[index] = (_FLOAT)mad(pvt_scale, (_FLOAT_ACCUM)(*(in + index)) - mean, pvt_bias);
+    }
+} // end spatial norm
+
 #endif
 
 // Restore warnings
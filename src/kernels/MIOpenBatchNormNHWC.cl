@@ -0,0 +1,283 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Spatial batch normalization of channel-last (NHWC) tensors, which are MIO_BN_NHW rows of
+// MIO_BN_C channels. A work-group owns MIO_BN_GRP0 vectors of MIO_BN_VEC adjacent channels,
+// so that a row of the group is one contiguous read, and its MIO_BN_GRP1 rows of threads
+// stride over the N*H*W pixels. The per-channel sums are then reduced across the rows in LDS.
+//
+// MIO_BN_VEC         channels per vector (1, 2 or 4), which divides MIO_BN_C
+// MIO_BN_GRP0        channel vectors per work-group
+// MIO_BN_GRP1        rows of threads per work-group, a power of two
+
+#ifdef __AMDGCN__
+#undef __AMDGCN__
+#endif
+
+#include "batchnorm_functions.h"
+
+#ifndef MIO_BN_VEC
+#define MIO_BN_VEC 1
+#endif
+
+#ifndef MIO_BN_USESAVED
+#define MIO_BN_USESAVED 1
+#endif
+
+#define MIO_BN_CVECS (MIO_BN_C / MIO_BN_VEC)
+#define MIO_BN_CTILE (MIO_BN_GRP0 * MIO_BN_VEC)
+
+#if MIO_BN_VEC == 1
+#define _FLOAT_VEC _FLOAT
+#define _ACCUM_VEC _FLOAT_ACCUM
+#define VLOAD(p) (*(p))
+#define VSTORE(v, p) (*(p) = (v))
+#else
+#define _FLOAT_VEC PPCAT(_FLOAT, MIO_BN_VEC)
+#define _ACCUM_VEC PPCAT(_FLOAT_ACCUM, MIO_BN_VEC)
+#define VLOAD(p) PPCAT(vload, MIO_BN_VEC)(0, p)
+#define VSTORE(v, p) PPCAT(vstore, MIO_BN_VEC)(v, 0, p)
+#endif
+
+#define CVT_VEC2ACCUM(x) PPCAT(convert_, _ACCUM_VEC)(x)
+#define CVT_ACCUM2VEC(x) PPCAT(convert_, _FLOAT_VEC)(x)
+
+// Sums v over the rows of the work-group. The totals of the channel vector lid0 are left in
+// lcl[lid0 * MIO_BN_VEC], one value per channel.
+static inline void
+reduce_rows(__local _FLOAT_ACCUM* lcl, _ACCUM_VEC v, const uint lid0, const uint lid1)
+{
+    barrier(CLK_LOCAL_MEM_FENCE);
+    VSTORE(v, lcl + (lid1 * MIO_BN_GRP0 + lid0) * MIO_BN_VEC);
+    barrier(CLK_LOCAL_MEM_FENCE);
+    for(uint s = MIO_BN_GRP1 >> 1; s > 0; s >>= 1)
+    {
+        if(lid1 < s)
+        {
+            __local _FLOAT_ACCUM* p = lcl + (lid1 * MIO_BN_GRP0 + lid0) * MIO_BN_VEC;
+            VSTORE(VLOAD(p) + VLOAD(p + s * MIO_BN_CTILE), p);
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+}
+
+__attribute__((reqd_work_group_size(MIO_BN_GRP0, MIO_BN_GRP1, 1))) __kernel void
+MIOpenBatchNormFwdTrainSpatialNHWC(const __global _FLOAT* in,
+                                   __global _FLOAT* out,
+                                   const __global _FLOAT_PREC* __restrict scale,
+                                   const __global _FLOAT_PREC* __restrict bias,
+                                   _FLOAT_PREC INHW,
+#if(MIO_RUNNING_RESULT == 1)
+                                   double expAvgFactor,
+                                   __global _FLOAT_PREC* __restrict resultRunningMean,
+                                   __global _FLOAT_PREC* __restrict resultRunningVariance,
+#endif
+                                   double epsilon
+#if(MIO_SAVE_MEAN_VARIANCE == 1)
+                                   ,
+                                   __global _FLOAT_PREC* __restrict resultSaveMean,
+                                   __global _FLOAT_PREC* __restrict resultSaveInvVariance
+#endif
+                                   )
+{
+    __local _FLOAT_ACCUM lcl_sum[MIO_BN_GRP1 * MIO_BN_CTILE];
+    __local _FLOAT_ACCUM lcl_sqr[MIO_BN_GRP1 * MIO_BN_CTILE];
+
+    const uint lid0    = get_local_id(0);
+    const uint lid1    = get_local_id(1);
+    const uint cv      = get_group_id(0) * MIO_BN_GRP0 + lid0;
+    const bool active  = cv < MIO_BN_CVECS;
+    const uint channel = cv * MIO_BN_VEC;
+
+    _ACCUM_VEC sum = (_ACCUM_VEC)0;
+    _ACCUM_VEC sqr = (_ACCUM_VEC)0;
+    if(active)
+    {
+        for(uint r = lid1; r < MIO_BN_NHW; r += MIO_BN_GRP1)
+        {
+            const _ACCUM_VEC v = CVT_VEC2ACCUM(VLOAD(in + (size_t)r * MIO_BN_C + channel));
+            sum += v;
+            sqr = mad(v, v, sqr);
+        }
+    }
+    reduce_rows(lcl_sum, sum, lid0, lid1);
+    reduce_rows(lcl_sqr, sqr, lid0, lid1);
+
+    const _FLOAT_ACCUM inhw    = (_FLOAT_ACCUM)INHW;
+    const _ACCUM_VEC mean      = VLOAD(lcl_sum + lid0 * MIO_BN_VEC) * inhw;
+    const _ACCUM_VEC variance  = mad(-mean, mean, VLOAD(lcl_sqr + lid0 * MIO_BN_VEC) * inhw);
+    const _ACCUM_VEC invVariance = rsqrt(variance + (_FLOAT_ACCUM)epsilon);
+
+    // The rows lid1 < MIO_BN_VEC store the statistics of one channel of the vector each.
+    if(active && lid1 < MIO_BN_VEC)
+    {
+        const _FLOAT_ACCUM mean_c = lcl_sum[lid0 * MIO_BN_VEC + lid1] * inhw;
+        const _FLOAT_ACCUM var_c  = mad(-mean_c, mean_c, lcl_sqr[lid0 * MIO_BN_VEC + lid1] * inhw);
+#if(MIO_RUNNING_RESULT == 1)
+        running_stash(
+            resultRunningMean, resultRunningVariance, expAvgFactor, mean_c, var_c, channel + lid1);
+#endif
+#if(MIO_SAVE_MEAN_VARIANCE == 1)
+        saved_stash(resultSaveMean,
+                    resultSaveInvVariance,
+                    mean_c,
+                    rsqrt(var_c + (_FLOAT_ACCUM)epsilon),
+                    channel + lid1);
+#endif
+    }
+
+    if(active)
+    {
+        const _ACCUM_VEC pvscale = CVT_VEC2ACCUM(VLOAD(scale + channel)) * invVariance;
+        const _ACCUM_VEC pvbias  = CVT_VEC2ACCUM(VLOAD(bias + channel));
+        for(uint r = lid1; r < MIO_BN_NHW; r += MIO_BN_GRP1)
+        {
+            const size_t index = (size_t)r * MIO_BN_C + channel;
+            const _ACCUM_VEC v = CVT_VEC2ACCUM(VLOAD(in + index));
+            VSTORE(CVT_ACCUM2VEC(mad(pvscale, v - mean, pvbias)), out + index);
+        }
+    }
+}
+
+// The grid covers all the channel vectors in dimension 0 and strides over the rows in
+// dimension 1.
+__attribute__((reqd_work_group_size(MIO_BN_GRP0, MIO_BN_GRP1, 1))) __kernel void
+MIOpenBatchNormFwdInferSpatialNHWC(const __global _FLOAT* in,
+                                   __global _FLOAT* out,
+                                   const __global _FLOAT_PREC* __restrict estimatedMean,
+                                   const __global _FLOAT_PREC* __restrict estimatedVariance,
+                                   const __global _FLOAT_PREC* __restrict scale,
+                                   const __global _FLOAT_PREC* __restrict bias,
+                                   double epsilon)
+{
+    const uint cv = get_global_id(0);
+    if(cv >= MIO_BN_CVECS)
+        return;
+    const uint channel = cv * MIO_BN_VEC;
+
+    const _ACCUM_VEC mean = CVT_VEC2ACCUM(VLOAD(estimatedMean + channel));
+    const _ACCUM_VEC invVariance =
+        rsqrt(CVT_VEC2ACCUM(VLOAD(estimatedVariance + channel)) + (_FLOAT_ACCUM)epsilon);
+    const _ACCUM_VEC pvscale = CVT_VEC2ACCUM(VLOAD(scale + channel)) * invVariance;
+    const _ACCUM_VEC pvbias  = CVT_VEC2ACCUM(VLOAD(bias + channel));
+
+    for(uint r = get_global_id(1); r < MIO_BN_NHW; r += get_global_size(1))
+    {
+        const size_t index = (size_t)r * MIO_BN_C + channel;
+        const _ACCUM_VEC v = CVT_VEC2ACCUM(VLOAD(in + index));
+        VSTORE(CVT_ACCUM2VEC(mad(pvscale, v - mean, pvbias)), out + index);
+    }
+}
+
+__attribute__((reqd_work_group_size(MIO_BN_GRP0, MIO_BN_GRP1, 1))) __kernel void
+MIOpenBatchNormBwdSpatialNHWC(const __global _FLOAT* __restrict x_in,
+                              const __global _FLOAT* __restrict dy_in,
+                              __global _FLOAT* __restrict dx_out,
+                              const __global _FLOAT_PREC* bnScale,
+                              __global _FLOAT_PREC* __restrict dscale,
+                              __global _FLOAT_PREC* __restrict dbias,
+#if(MIO_BN_USESAVED == 0)
+                              double epsilon,
+#elif(MIO_BN_USESAVED == 1)
+                              const __global _FLOAT_PREC* savedMean,
+                              const __global _FLOAT_PREC* savedInvVariance,
+#endif
+                              _FLOAT_PREC INHW)
+{
+    __local _FLOAT_ACCUM lcl_a[MIO_BN_GRP1 * MIO_BN_CTILE];
+    __local _FLOAT_ACCUM lcl_b[MIO_BN_GRP1 * MIO_BN_CTILE];
+
+    const uint lid0    = get_local_id(0);
+    const uint lid1    = get_local_id(1);
+    const uint cv      = get_group_id(0) * MIO_BN_GRP0 + lid0;
+    const bool active  = cv < MIO_BN_CVECS;
+    const uint channel = cv * MIO_BN_VEC;
+    const _FLOAT_ACCUM inhw = (_FLOAT_ACCUM)INHW;
+
+#if(MIO_BN_USESAVED == 0)
+    _ACCUM_VEC sum = (_ACCUM_VEC)0;
+    _ACCUM_VEC sqr = (_ACCUM_VEC)0;
+    if(active)
+    {
+        for(uint r = lid1; r < MIO_BN_NHW; r += MIO_BN_GRP1)
+        {
+            const _ACCUM_VEC v = CVT_VEC2ACCUM(VLOAD(x_in + (size_t)r * MIO_BN_C + channel));
+            sum += v;
+            sqr = mad(v, v, sqr);
+        }
+    }
+    reduce_rows(lcl_a, sum, lid0, lid1);
+    reduce_rows(lcl_b, sqr, lid0, lid1);
+    const _ACCUM_VEC mean     = VLOAD(lcl_a + lid0 * MIO_BN_VEC) * inhw;
+    const _ACCUM_VEC variance = mad(-mean, mean, VLOAD(lcl_b + lid0 * MIO_BN_VEC) * inhw);
+    const _ACCUM_VEC invVariance = rsqrt(variance + (_FLOAT_ACCUM)epsilon);
+#else
+    _ACCUM_VEC mean        = (_ACCUM_VEC)0;
+    _ACCUM_VEC invVariance = (_ACCUM_VEC)0;
+    if(active)
+    {
+        mean        = CVT_VEC2ACCUM(VLOAD(savedMean + channel));
+        invVariance = CVT_VEC2ACCUM(VLOAD(savedInvVariance + channel));
+    }
+#endif
+
+    // db = sum(dy), ds = sum(xhat * dy)
+    _ACCUM_VEC db = (_ACCUM_VEC)0;
+    _ACCUM_VEC ds = (_ACCUM_VEC)0;
+    if(active)
+    {
+        for(uint r = lid1; r < MIO_BN_NHW; r += MIO_BN_GRP1)
+        {
+            const size_t index  = (size_t)r * MIO_BN_C + channel;
+            const _ACCUM_VEC dy = CVT_VEC2ACCUM(VLOAD(dy_in + index));
+            db += dy;
+            ds = mad(CVT_VEC2ACCUM(VLOAD(x_in + index)) - mean, dy, ds);
+        }
+    }
+    reduce_rows(lcl_a, db, lid0, lid1);
+    reduce_rows(lcl_b, ds * invVariance, lid0, lid1);
+    db = VLOAD(lcl_a + lid0 * MIO_BN_VEC);
+    ds = VLOAD(lcl_b + lid0 * MIO_BN_VEC);
+
+    if(active && lid1 < MIO_BN_VEC)
+    {
+        dbias[channel + lid1]  = (_FLOAT_PREC)lcl_a[lid0 * MIO_BN_VEC + lid1];
+        dscale[channel + lid1] = (_FLOAT_PREC)lcl_b[lid0 * MIO_BN_VEC + lid1];
+    }
+
+    if(active)
+    {
+        const _ACCUM_VEC pscale = CVT_VEC2ACCUM(VLOAD(bnScale + channel)) * invVariance * inhw;
+        for(uint r = lid1; r < MIO_BN_NHW; r += MIO_BN_GRP1)
+        {
+            const size_t index    = (size_t)r * MIO_BN_C + channel;
+            const _ACCUM_VEC xhat = (CVT_VEC2ACCUM(VLOAD(x_in + index)) - mean) * invVariance;
+            const _ACCUM_VEC dy   = CVT_VEC2ACCUM(VLOAD(dy_in + index));
+            const _ACCUM_VEC dx   = pscale * (dy * (_FLOAT_ACCUM)MIO_BN_NHW - db - xhat * ds);
+            VSTORE(CVT_ACCUM2VEC(dx), dx_out + index);
+        }
+    }
+}
@@ -0,0 +1,52 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "batchnorm_functions.h"
+
+// Overwrites the output y of a batch norm training pass with its input x,
+//   x = mean + (y - bias) / (scale * invVariance),
+// so that the forward pass may run in place and the backward pass still gets x. The parameter
+// of element i is (i / paramStride) % paramCount: H*W and C for spatial NCHW, 1 and C for
+// spatial NHWC, 1 and C*H*W for per-activation.
+__kernel void MIOpenBatchNormRestoreInput(__global _FLOAT* data,
+                                          const __global _FLOAT_PREC* __restrict scale,
+                                          const __global _FLOAT_PREC* __restrict bias,
+                                          const __global _FLOAT_PREC* __restrict savedMean,
+                                          const __global _FLOAT_PREC* __restrict savedInvVariance,
+                                          unsigned int elemCount,
+                                          unsigned int paramStride,
+                                          unsigned int paramCount)
+{
+    for(unsigned int i = get_global_id(0); i < elemCount; i += get_global_size(0))
+    {
+        const unsigned int p = (i / paramStride) % paramCount;
+        const _FLOAT_ACCUM y = (_FLOAT_ACCUM)data[i];
+        const _FLOAT_ACCUM x = (_FLOAT_ACCUM)savedMean[p] +
+                               (y - (_FLOAT_ACCUM)bias[p]) /
+                                   ((_FLOAT_ACCUM)scale[p] * (_FLOAT_ACCUM)savedInvVariance[p]);
+        data[i] = (_FLOAT)x;
+    }
+}
@@ -0,0 +1,426 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// CTC loss with the (time x label) lattice of every sample split into tiles of TILE_T time steps
+// and TILE_S states of the blank-extended label, one state per work-item. Each launch of the
+// alpha and beta kernels processes one anti-diagonal of tiles: a tile only depends on the tiles
+// above, to the left and on the upper left of it (below and to the right for beta), so all tiles
+// of a diagonal run in parallel in separate workgroups.
+//
+// The lattice is never stored. The alpha pass keeps the last row of each tile and the two
+// rightmost states of every time step, which is all a tile needs from its neighbours; the beta
+// pass recomputes the alphas of a tile from them in local memory and accumulates alpha * beta
+// per class in log-space. Lattice values are kept in fp32 for fp16 inputs as well.
+
+#ifndef USE_HIP_BACKEND
+#define USE_HIP_BACKEND 0
+#endif
+
+#ifndef USE_OCL_BACKEND
+#define USE_OCL_BACKEND 0
+#endif
+
+#if USE_OCL_BACKEND == 1
+#if __OPENCL_VERSION__ <= CL_VERSION_1_0
+#if defined(cl_khr_global_int32_base_atomics) && defined(cl_khr_global_int32_extended_atomics)
+#pragma OPENCL EXTENSION cl_khr_global_int32_base_atomics : enable
+#pragma OPENCL_EXTENSION cl_khr_global_int32_extended_atomics : enable
+#else
+#error "Required integer atomics not supported by this OpenCL implemenation."
+#endif
+#endif
+#endif
+
+#ifndef MIOPEN_USE_FP32
+#define MIOPEN_USE_FP32 0
+#endif
+
+#ifndef MIOPEN_USE_FP16
+#define MIOPEN_USE_FP16 0
+#endif
+
+#if MIOPEN_USE_FP16 == 1
+#pragma OPENCL EXTENSION cl_khr_fp16 : enable
+#define _FLOAT half
+#endif
+#if MIOPEN_USE_FP32 == 1
+#define _FLOAT float
+#endif
+
+#define NEGATIVE_CUTOFF_VAL (-1e20f)
+
+#ifndef SOFTMAX_APPLIED
+#define SOFTMAX_APPLIED 1
+#endif
+
+#ifndef PROBS_STRIDE0
+#define PROBS_STRIDE0 (BATCH_SZ * CLASS_SZ)
+#endif
+#ifndef PROBS_STRIDE1
+#define PROBS_STRIDE1 CLASS_SZ
+#endif
+
+#if SOFTMAX_APPLIED == 1
+#define USE_PROBS_STRIDE0 (BATCH_SZ * CLASS_SZ)
+#define USE_PROBS_STRIDE1 CLASS_SZ
+#else
+#define USE_PROBS_STRIDE0 PROBS_STRIDE0
+#define USE_PROBS_STRIDE1 PROBS_STRIDE1
+#endif
+
+#ifndef GRADS_STRIDE0
+#define GRADS_STRIDE0 (BATCH_SZ * CLASS_SZ)
+#endif
+#ifndef GRADS_STRIDE1
+#define GRADS_STRIDE1 CLASS_SZ
+#endif
+
+#ifndef BLANK_LB_ID
+#define BLANK_LB 0
+#elif BLANK_LB_ID < 0
+#define BLANK_LB 0
+#elif BLANK_LB_ID >= CLASS_SZ
+#define BLANK_LB (CLASS_SZ - 1)
+#else
+#define BLANK_LB BLANK_LB_ID
+#endif
+
+#define GRAD_LOG_IDX(t, b, c) (GRAD_LOG_OFFSET + ((size_t)(t)*BATCH_SZ + (b)) * CLASS_SZ + (c))
+#define ALPHA_CKPT_IDX(b, ti, s) \
+    (ALPHA_CKPT_OFFSET + ((size_t)(b)*T_TILES + (ti)) * MAX_S_LEN + (s))
+#define ALPHA_COL_IDX(b, si, t, k) \
+    (ALPHA_COL_OFFSET + (((size_t)(b)*S_TILES + (si)) * MAX_TSTEP + (t)) * 2 + (k))
+#define BETA_COL_IDX(b, si, t, k) \
+    (BETA_COL_OFFSET + (((size_t)(b)*S_TILES + (si)) * MAX_TSTEP + (t)) * 2 + (k))
+#define BETA_ROW_IDX(b, s) (BETA_ROW_OFFSET + (size_t)(b)*MAX_S_LEN + (s))
+#define ALPHA_END_IDX(b, k) (ALPHA_END_OFFSET + (size_t)(b)*2 + (k))
+
+static inline float LogAddExp(const float x, const float y)
+{
+    float a = max(x, y);
+    float b = min(x, y);
+
+    return b - a <= NEGATIVE_CUTOFF_VAL ? max(a, NEGATIVE_CUTOFF_VAL)
+                                        : max(a + log1p(exp(b - a)), NEGATIVE_CUTOFF_VAL);
+}
+
+static inline void AtomicLogAddExp(volatile global float* addr, const float operand)
+{
+    if(operand <= NEGATIVE_CUTOFF_VAL)
+        return;
+
+    union
+    {
+        unsigned int uval;
+        float fval;
+    } newVal, curVal, prevVal;
+    curVal.fval = *((global float*)addr);
+
+    do
+    {
+        prevVal.uval = curVal.uval;
+        newVal.fval  = LogAddExp(prevVal.fval, operand);
+        curVal.uval =
+            atomic_cmpxchg((volatile global unsigned int*)addr, prevVal.uval, newVal.uval);
+    } while(curVal.uval != prevVal.uval);
+}
+
+static inline const global _FLOAT* Logits(const global _FLOAT* probs, global _FLOAT* workSpace)
+{
+#if SOFTMAX_APPLIED == 1
+    (void)probs;
+    return workSpace + PROBLOG_OFFSET;
+#else
+    (void)workSpace;
+    return probs;
+#endif
+}
+
+// Forward recursion of one state; prev holds the previous time step of the tile, preceded by the
+// two states on the left of it.
+static inline float
+CTCAlphaStep(const local float* prev, const uint lid, const bool skip, const float logit)
+{
+    float alpha = LogAddExp(prev[lid + 2], prev[lid + 1]);
+    if(skip)
+        alpha = LogAddExp(alpha, prev[lid]);
+    return max(alpha + logit, NEGATIVE_CUTOFF_VAL);
+}
+
+// Backward recursion of one state; next holds the next time step of the tile, followed by the two
+// states on the right of it.
+static inline float
+CTCBetaStep(const local float* next, const uint lid, const bool skip, const float logit)
+{
+    float beta = LogAddExp(next[lid], next[lid + 1]);
+    if(skip)
+        beta = LogAddExp(beta, next[lid + 2]);
+    return max(beta + logit, NEGATIVE_CUTOFF_VAL);
+}
+
+// Computes the alphas of the tile rows [t0, t1). With keep_tile the rows are stored in alpha_tile,
+// otherwise the boundaries needed by the neighbouring tiles are written to the lattice buffer.
+static inline void CTCAlphaTile(const global _FLOAT* logits,
+                                global float* lattice,
+                                local float* prev,
+                                local float* alpha_tile,
+                                const bool keep_tile,
+                                const uint bid,
+                                const int ti,
+                                const int si,
+                                const uint input_len,
+                                const uint label_prime_len,
+                                const int lb_cur,
+                                const bool skip)
+{
+    const uint lid    = get_local_id(0);
+    const uint s      = si * TILE_S + lid;
+    const bool active = s < label_prime_len;
+    const uint t0     = ti * TILE_T;
+    const uint t1     = min(t0 + TILE_T, input_len);
+
+    prev[lid + 2] =
+        ti > 0 && active ? lattice[ALPHA_CKPT_IDX(bid, ti - 1, s)] : NEGATIVE_CUTOFF_VAL;
+    if(lid < 2)
+        prev[lid] = ti > 0 && si > 0 ? lattice[ALPHA_COL_IDX(bid, si - 1, t0 - 1, lid)]
+                                     : NEGATIVE_CUTOFF_VAL;
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    float alpha = NEGATIVE_CUTOFF_VAL;
+    for(uint t = t0; t < t1; t++)
+    {
+        if(active)
+        {
+            const float logit = logits[t * USE_PROBS_STRIDE0 + bid * USE_PROBS_STRIDE1 + lb_cur];
+            if(t == 0)
+                alpha = s < 2 ? logit : NEGATIVE_CUTOFF_VAL;
+            else
+                alpha = CTCAlphaStep(prev, lid, skip, logit);
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        prev[lid + 2] = alpha;
+        if(lid < 2)
+            prev[lid] = si > 0 ? lattice[ALPHA_COL_IDX(bid, si - 1, t, lid)] : NEGATIVE_CUTOFF_VAL;
+
+        if(keep_tile)
+        {
+            alpha_tile[(t - t0) * TILE_S + lid] = alpha;
+        }
+        else
+        {
+            if(lid >= TILE_S - 2)
+                lattice[ALPHA_COL_IDX(bid, si, t, lid - (TILE_S - 2))] = alpha;
+            if(active && t == input_len - 1 && s + 2 >= label_prime_len)
+                lattice[ALPHA_END_IDX(bid, label_prime_len - 1 - s)] = alpha;
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+
+    if(!keep_tile && active)
+        lattice[ALPHA_CKPT_IDX(bid, ti, s)] = alpha;
+}
+
+kernel void CTCLossTiledInit(global float* lattice)
+{
+    for(size_t i = get_global_id(0); i < (size_t)MAX_TSTEP * BATCH_SZ * CLASS_SZ;
+        i += get_global_size(0))
+        lattice[GRAD_LOG_OFFSET + i] = NEGATIVE_CUTOFF_VAL;
+
+    for(size_t i = get_global_id(0); i < 2 * BATCH_SZ; i += get_global_size(0))
+        lattice[ALPHA_END_OFFSET + i] = NEGATIVE_CUTOFF_VAL;
+}
+
+kernel void CTCLossTiledAlpha(const global _FLOAT* probs,
+                              global _FLOAT* workSpace,
+                              global int* dim_data,
+                              global float* lattice,
+                              const int diag)
+{
+    local float prev[TILE_S + 2];
+
+    const uint lid = get_local_id(0);
+    const uint bid = get_group_id(0) / S_TILES;
+    const int si   = get_group_id(0) % S_TILES;
+    const int ti   = diag - si;
+
+    const uint input_len       = dim_data[bid];
+    const uint label_prime_len = 2 * dim_data[BATCH_SZ + bid] + 1;
+    if(ti < 0 || ti * TILE_T >= input_len || si * TILE_S >= label_prime_len)
+        return;
+
+    const global int* labels = dim_data + 4 * BATCH_SZ + dim_data[2 * BATCH_SZ + bid];
+    const uint s             = si * TILE_S + lid;
+    const bool active        = s < label_prime_len;
+    const int lb_cur         = active && s % 2 == 1 ? labels[s / 2] : BLANK_LB;
+    const bool skip          = active && s % 2 == 1 && s >= 2 && lb_cur != labels[s / 2 - 1];
+
+    CTCAlphaTile(Logits(probs, workSpace),
+                 lattice,
+                 prev,
+                 prev, // not written to
+                 false,
+                 bid,
+                 ti,
+                 si,
+                 input_len,
+                 label_prime_len,
+                 lb_cur,
+                 skip);
+}
+
+kernel void CTCLossTiledBeta(const global _FLOAT* probs,
+                             global _FLOAT* workSpace,
+                             global int* dim_data,
+                             global float* lattice,
+                             const int diag)
+{
+    local float prev[TILE_S + 2];
+    local float next[TILE_S + 2];
+    local float blank_sum[TILE_S];
+    local float alpha_tile[TILE_T * TILE_S];
+
+    const uint lid = get_local_id(0);
+    const uint bid = get_group_id(0) / S_TILES;
+    const int si   = get_group_id(0) % S_TILES;
+    const int ti   = diag - si;
+
+    const uint input_len       = dim_data[bid];
+    const uint label_prime_len = 2 * dim_data[BATCH_SZ + bid] + 1;
+    if(ti < 0 || ti * TILE_T >= input_len || si * TILE_S >= label_prime_len)
+        return;
+
+    const global int* labels    = dim_data + 4 * BATCH_SZ + dim_data[2 * BATCH_SZ + bid];
+    const global _FLOAT* logits = Logits(probs, workSpace);
+    const uint s                = si * TILE_S + lid;
+    const bool active           = s < label_prime_len;
+    const int lb_cur            = active && s % 2 == 1 ? labels[s / 2] : BLANK_LB;
+    const bool skip_alpha       = active && s % 2 == 1 && s >= 2 && lb_cur != labels[s / 2 - 1];
+    const bool skip_beta =
+        active && s % 2 == 1 && s + 2 < label_prime_len && lb_cur != labels[s / 2 + 1];
+    const bool has_right = (si + 1) * TILE_S < label_prime_len;
+    const uint t0        = ti * TILE_T;
+    const uint t1        = min(t0 + TILE_T, input_len);
+
+    CTCAlphaTile(logits,
+                 lattice,
+                 prev,
+                 alpha_tile,
+                 true,
+                 bid,
+                 ti,
+                 si,
+                 input_len,
+                 label_prime_len,
+                 lb_cur,
+                 skip_alpha);
+
+    next[lid] = t1 < input_len && active ? lattice[BETA_ROW_IDX(bid, s)] : NEGATIVE_CUTOFF_VAL;
+    if(lid < 2)
+        next[TILE_S + lid] = t1 < input_len && has_right
+                                 ? lattice[BETA_COL_IDX(bid, si + 1, t1, lid)]
+                                 : NEGATIVE_CUTOFF_VAL;
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    float beta = NEGATIVE_CUTOFF_VAL;
+    for(uint t = t1; t-- > t0;)
+    {
+        float alpha_beta = NEGATIVE_CUTOFF_VAL;
+        if(active)
+        {
+            const float logit = logits[t * USE_PROBS_STRIDE0 + bid * USE_PROBS_STRIDE1 + lb_cur];
+            if(t == input_len - 1)
+                beta = s + 2 >= label_prime_len ? logit : NEGATIVE_CUTOFF_VAL;
+            else
+                beta = CTCBetaStep(next, lid, skip_beta, logit);
+            alpha_beta = alpha_tile[(t - t0) * TILE_S + lid] + beta;
+        }
+
+        // Half of the states of a tile are blanks, reduce them before going to global memory.
+        blank_sum[lid] = s % 2 == 0 ? alpha_beta : NEGATIVE_CUTOFF_VAL;
+        barrier(CLK_LOCAL_MEM_FENCE);
+        for(uint k = TILE_S / 2; k > 0; k >>= 1)
+        {
+            if(lid < k)
+                blank_sum[lid] = LogAddExp(blank_sum[lid], blank_sum[lid + k]);
+            barrier(CLK_LOCAL_MEM_FENCE);
+        }
+        if(lid == 0)
+            AtomicLogAddExp(&lattice[GRAD_LOG_IDX(t, bid, BLANK_LB)], blank_sum[0]);
+        if(s % 2 == 1)
+            AtomicLogAddExp(&lattice[GRAD_LOG_IDX(t, bid, lb_cur)], alpha_beta);
+
+        next[lid] = beta;
+        if(lid < 2)
+        {
+            next[TILE_S + lid] =
+                has_right ? lattice[BETA_COL_IDX(bid, si + 1, t, lid)] : NEGATIVE_CUTOFF_VAL;
+            lattice[BETA_COL_IDX(bid, si, t, lid)] = beta;
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+
+    if(active)
+        lattice[BETA_ROW_IDX(bid, s)] = beta;
+}
+
+kernel void CTCLossTiledFinalize(const global _FLOAT* probs,
+                                 global _FLOAT* workSpace,
+                                 global int* dim_data,
+                                 global float* lattice,
+                                 global _FLOAT* losses,
+                                 global _FLOAT* gradients)
+{
+    const global _FLOAT* logits = Logits(probs, workSpace);
+
+    for(size_t i = get_global_id(0); i < (size_t)MAX_TSTEP * BATCH_SZ * CLASS_SZ;
+        i += get_global_size(0))
+    {
+        const uint c   = i % CLASS_SZ;
+        const uint bid = (i / CLASS_SZ) % BATCH_SZ;
+        const uint t   = i / (CLASS_SZ * BATCH_SZ);
+
+        const float prob_lx_log =
+            LogAddExp(lattice[ALPHA_END_IDX(bid, 0)], lattice[ALPHA_END_IDX(bid, 1)]);
+        if(t == 0 && c == 0)
+            losses[bid] = (_FLOAT)(-prob_lx_log);
+        if(t >= (uint)dim_data[bid])
+            continue;
+
+        const float logit = logits[t * USE_PROBS_STRIDE0 + bid * USE_PROBS_STRIDE1 + c];
+        float grad        = lattice[GRAD_LOG_IDX(t, bid, c)] - logit - prob_lx_log;
+#if SOFTMAX_APPLIED == 0
+        grad -= logit;
+#endif
+        grad = grad <= NEGATIVE_CUTOFF_VAL ? 0 : exp(grad);
+
+        gradients[t * GRADS_STRIDE0 + bid * GRADS_STRIDE1 + c] = (_FLOAT)(
+#if SOFTMAX_APPLIED == 1
+            exp(logit)
+#endif
+            - grad);
+    }
+}
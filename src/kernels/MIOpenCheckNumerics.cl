@@ -80,18 +80,21 @@ void cl_atomic_max_float(volatile __global float* addr, float val)
     }
 
 // Checks a block of data for abnormal numeric values :
+// Only every stride-th element is inspected. The flags are only ever raised, so the results
+// of several launches accumulate when abnormal is not reset in between.
 __kernel void MIOpenCheckNumerics(const __global DTYPE* data,
                                   int size,
                                   __global struct CheckNumericsResult* abnormal,
-                                  int computeStats)
+                                  int computeStats,
+                                  int stride)
 {
     const int lid           = get_local_id(0);
     const int gid           = get_global_id(0);
-    const int total_wi_size = get_global_size(0);
+    const int total_wi_size = get_global_size(0) * stride;
 
     local float stats[4 * GROUP_SIZE];
 
-    int offset       = gid;
+    int offset       = gid * stride;
     ACCUMTYPE sum    = 0.0f;
     ACCUMTYPE abssum = 0.0f;
     DTYPE minV       = FLT_MAX;
@@ -53,8 +53,11 @@ __kernel void Col2Im3d(global _FLOAT* col,
                        const int height,
                        const int width,
                        global _FLOAT* im,
-                       const int im_offset)
+                       const int im_offset,
+                       const int col_offset)
 {
+    col += col_offset;
+
     global _FLOAT* im_off = im + im_offset;
     int gid               = (int)get_global_id(0);
 
@@ -0,0 +1,178 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "float_types.h"
+
+#if MIOPEN_USE_FP16
+#define ACCUMULATOR_NEEDS_CONVERSION 1
+#elif MIOPEN_USE_BFP16
+#define ACCUMULATOR_NEEDS_CONVERSION 1
+#elif MIOPEN_USE_FP32
+#define ACCUMULATOR_NEEDS_CONVERSION 0
+#endif
+
+// Col2Im of 2d and 3d convolutions (2d ones have a depth of 1) as a gather over the filter
+// taps instead of the column windows. An image position p (padded) receives col((p - t *
+// dilation) / stride) from the taps t for which the division is exact, which are every
+// C2I_STEP_*-th tap from the first one, so the kernel visits no tap that misses.
+//
+// A work-group takes one image row. Its depth and height taps are the same for the whole row
+// and are looked up once into LDS, as the offsets of the column rows they read. A work-item
+// then sums C2I_TILE_W pixels of the row that lie stride_w apart: these have the same width
+// taps and read consecutive column elements.
+//
+// C2I_IN_D, C2I_IN_H, C2I_IN_W image sizes
+// C2I_COL_D/H/W                column sizes, i.e. the output sizes of the convolution
+// C2I_WEI_D/H/W                filter sizes
+// C2I_PAD_D/H/W                left paddings
+// C2I_STRIDE_D/H/W             strides
+// C2I_DILATION_D/H/W           dilations
+// C2I_STEP_D/H/W               distance between the taps of one position, stride /
+//                              gcd(stride, dilation)
+// C2I_TILE_W                   pixels of a row summed by one work-item
+
+#define C2I_LOCAL_SIZE 64
+
+#define C2I_TAPS_D ((C2I_WEI_D + C2I_STEP_D - 1) / C2I_STEP_D)
+#define C2I_TAPS_H ((C2I_WEI_H + C2I_STEP_H - 1) / C2I_STEP_H)
+#define C2I_TAPS_DH (C2I_TAPS_D * C2I_TAPS_H)
+
+#define C2I_COL_SIZE (C2I_COL_D * C2I_COL_H * C2I_COL_W)
+
+// Pixels of the widest row phase
+#define C2I_PHASE_W ((C2I_IN_W + C2I_STRIDE_W - 1) / C2I_STRIDE_W)
+#define C2I_PHASE_TILES_W ((C2I_PHASE_W + C2I_TILE_W - 1) / C2I_TILE_W)
+
+static inline int PositiveMod(int a, int b)
+{
+    const int r = a % b;
+    return r < 0 ? r + b : r;
+}
+
+// First tap reaching the padded position, or -1 when none does (possible only when stride
+// and dilation share a factor).
+static inline int FirstTap(int pos, int stride, int dilation, int step)
+{
+    for(int t = 0; t < step; ++t)
+        if(PositiveMod(pos - t * dilation, stride) == 0)
+            return t;
+    return -1;
+}
+
+__attribute__((reqd_work_group_size(C2I_LOCAL_SIZE, 1, 1))) __kernel void
+Col2ImGather(const global _FLOAT* __restrict col,
+             global _FLOAT* __restrict im,
+             const int im_offset,
+             const int col_offset)
+{
+    local int tap_offsets[C2I_TAPS_DH];
+
+    const int lid = (int)get_local_id(0);
+    const int row = (int)get_group_id(1);
+    const int ic  = row / (C2I_IN_D * C2I_IN_H);
+    const int id  = (row / C2I_IN_H) % C2I_IN_D;
+    const int ih  = row % C2I_IN_H;
+    const int dp  = id + C2I_PAD_D;
+    const int hp  = ih + C2I_PAD_H;
+    const int kd0 = FirstTap(dp, C2I_STRIDE_D, C2I_DILATION_D, C2I_STEP_D);
+    const int kh0 = FirstTap(hp, C2I_STRIDE_H, C2I_DILATION_H, C2I_STEP_H);
+
+    // Offset of the column row read by each depth and height tap of the row, -1 when the tap
+    // falls outside the column.
+    for(int i = lid; i < C2I_TAPS_DH; i += C2I_LOCAL_SIZE)
+    {
+        const int kd    = kd0 + (i / C2I_TAPS_H) * C2I_STEP_D;
+        const int kh    = kh0 + (i % C2I_TAPS_H) * C2I_STEP_H;
+        const int d_num = dp - kd * C2I_DILATION_D;
+        const int h_num = hp - kh * C2I_DILATION_H;
+        int offset      = -1;
+        if(kd0 >= 0 && kh0 >= 0 && kd < C2I_WEI_D && kh < C2I_WEI_H && d_num >= 0 && h_num >= 0)
+        {
+            const int cd = d_num / C2I_STRIDE_D;
+            const int ch = h_num / C2I_STRIDE_H;
+            if(cd < C2I_COL_D && ch < C2I_COL_H)
+                offset = (kd * C2I_WEI_H + kh) * C2I_WEI_W * C2I_COL_SIZE +
+                         (cd * C2I_COL_H + ch) * C2I_COL_W;
+        }
+        tap_offsets[i] = offset;
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    const int gid = (int)get_global_id(0);
+    if(gid >= C2I_STRIDE_W * C2I_PHASE_TILES_W)
+        return;
+
+    const int pw  = gid / C2I_PHASE_TILES_W;
+    const int iw0 = pw + (gid % C2I_PHASE_TILES_W) * C2I_TILE_W * C2I_STRIDE_W;
+    if(iw0 >= C2I_IN_W)
+        return;
+
+    _FLOAT_ACCUM acc[C2I_TILE_W];
+    for(int t = 0; t < C2I_TILE_W; ++t)
+        acc[t] = (_FLOAT_ACCUM)0;
+
+    const int wp0 = iw0 + C2I_PAD_W;
+    const int kw0 = FirstTap(wp0, C2I_STRIDE_W, C2I_DILATION_W, C2I_STEP_W);
+
+    if(kw0 >= 0)
+    {
+        const global _FLOAT* col_c =
+            col + col_offset + (size_t)ic * C2I_WEI_D * C2I_WEI_H * C2I_WEI_W * C2I_COL_SIZE;
+
+        for(int i = 0; i < C2I_TAPS_DH; ++i)
+        {
+            const int offset = tap_offsets[i];
+            if(offset < 0)
+                continue;
+
+            for(int kw = kw0; kw < C2I_WEI_W; kw += C2I_STEP_W)
+            {
+                // Pixel t of the tile reads column element cw0 + t. The division is exact, so
+                // it is also right for the taps that only the later pixels of the tile reach.
+                const int cw0 = (wp0 - kw * C2I_DILATION_W) / C2I_STRIDE_W;
+                const global _FLOAT* p_col_row = col_c + offset + (size_t)kw * C2I_COL_SIZE;
+                for(int t = 0; t < C2I_TILE_W; ++t)
+                {
+                    if(cw0 + t >= 0 && cw0 + t < C2I_COL_W)
+                        acc[t] += CVT_FLOAT2ACCUM(p_col_row[cw0 + t]);
+                }
+            }
+        }
+    }
+
+    global _FLOAT* p_im_row = im + im_offset + (size_t)row * C2I_IN_W;
+    for(int t = 0; t < C2I_TILE_W; ++t)
+    {
+        const int iw = iw0 + t * C2I_STRIDE_W;
+        if(iw < C2I_IN_W)
+        {
+#if ACCUMULATOR_NEEDS_CONVERSION
+            p_im_row[iw] = acc[t] > CVT_FLOAT2ACCUM(MAX_VAL) ? MAX_VAL : CVT_ACCUM2FLOAT(acc[t]);
+#else
+            p_im_row[iw] = CVT_ACCUM2FLOAT(acc[t]);
+#endif
+        }
+    }
+}
@@ -0,0 +1,113 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "float_types.h"
+
+// Bias gradient of problems with few channels and large images, in two stages: MLO_BLOCKS
+// work-groups per channel sum consecutive runs of dy into partial sums, kept as _FLOAT_ACCUM
+// (float for the 16-bit types), and one work-group per channel then adds those up.
+//
+// MLO_CONVBWD_GROUP_SZ0    work-group size, a power of 2
+// MLO_BLOCKS               partial sums per channel, at most MLO_CONVBWD_GROUP_SZ0
+// MLO_OUT_BATCH_SZ         N
+// MLO_OUT_CHANNEL_STRIDE   dy strides
+// MLO_OUT_BATCH_STRIDE
+// MLO_MAP_SIZE             H x W (x D)
+// MLO_VEC                  elements read at once, 4 or 1; 4 divides MLO_MAP_SIZE and both
+//                          strides
+
+#if MIOPEN_USE_FP16
+typedef half4 _FLOAT_VEC4;
+#elif MIOPEN_USE_BFP16
+typedef ushort4 _FLOAT_VEC4;
+#else
+typedef float4 _FLOAT_VEC4;
+#endif
+
+#define MLO_MAP_VECS (MLO_MAP_SIZE / MLO_VEC)
+#define MLO_BLOCK_VECS ((MLO_OUT_BATCH_SZ * MLO_MAP_VECS + MLO_BLOCKS - 1) / MLO_BLOCKS)
+
+static inline _FLOAT_ACCUM ReduceGroup(__local _FLOAT_ACCUM* lcl_sum, _FLOAT_ACCUM sum, int lid)
+{
+    lcl_sum[lid] = sum;
+    barrier(CLK_LOCAL_MEM_FENCE);
+    for(int s = MLO_CONVBWD_GROUP_SZ0 / 2; s > 0; s >>= 1)
+    {
+        if(lid < s)
+            lcl_sum[lid] += lcl_sum[lid + s];
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+    return lcl_sum[0];
+}
+
+__attribute__((reqd_work_group_size(MLO_CONVBWD_GROUP_SZ0, 1, 1))) __kernel void
+MIOpenConvBwdBPartial(const __global _FLOAT* __restrict top_df,
+                      __global _FLOAT_ACCUM* __restrict partial)
+{
+    __local _FLOAT_ACCUM lcl_sum[MLO_CONVBWD_GROUP_SZ0];
+
+    const int lid        = (int)get_local_id(0);
+    const int block      = (int)get_group_id(0);
+    const int output_map = (int)get_group_id(1);
+
+    const __global _FLOAT* top_df_k = top_df + (size_t)output_map * MLO_OUT_CHANNEL_STRIDE;
+
+    const int first = block * MLO_BLOCK_VECS;
+    const int last  = min(first + MLO_BLOCK_VECS, MLO_OUT_BATCH_SZ * MLO_MAP_VECS);
+
+    _FLOAT_ACCUM sum = (_FLOAT_ACCUM)0;
+    for(int j = first + lid; j < last; j += MLO_CONVBWD_GROUP_SZ0)
+    {
+        const int n         = j / MLO_MAP_VECS;
+        const int v         = j % MLO_MAP_VECS;
+        const size_t offset = (size_t)n * MLO_OUT_BATCH_STRIDE + (size_t)v * MLO_VEC;
+#if MLO_VEC == 4
+        const _FLOAT_VEC4 val = vload4(0, top_df_k + offset);
+        sum += CVT_FLOAT2ACCUM(val.x) + CVT_FLOAT2ACCUM(val.y) + CVT_FLOAT2ACCUM(val.z) +
+               CVT_FLOAT2ACCUM(val.w);
+#else
+        sum += CVT_FLOAT2ACCUM(top_df_k[offset]);
+#endif
+    }
+
+    sum = ReduceGroup(lcl_sum, sum, lid);
+    if(lid == 0)
+        partial[output_map * MLO_BLOCKS + block] = sum;
+}
+
+__attribute__((reqd_work_group_size(MLO_CONVBWD_GROUP_SZ0, 1, 1))) __kernel void
+MIOpenConvBwdBFinal(const __global _FLOAT_ACCUM* __restrict partial,
+                    __global _FLOAT* __restrict bias_df)
+{
+    __local _FLOAT_ACCUM lcl_sum[MLO_CONVBWD_GROUP_SZ0];
+
+    const int lid        = (int)get_local_id(0);
+    const int output_map = (int)get_group_id(1);
+
+    const _FLOAT_ACCUM sum = ReduceGroup(
+        lcl_sum, lid < MLO_BLOCKS ? partial[output_map * MLO_BLOCKS + lid] : (_FLOAT_ACCUM)0, lid);
+    if(lid == 0)
+        bias_df[output_map] = CVT_ACCUM2FLOAT(sum);
+}
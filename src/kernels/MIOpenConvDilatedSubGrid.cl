@@ -0,0 +1,95 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+
+#include "float_types.h"
+
+// Interleaved sub-grids of a dilated convolution. NCHW packed tensors only.
+//
+// With stride 1 and dilation d, output row o reads only input rows o + r * d - pad, which
+// all share the residue of o modulo d. Rows (columns) of one residue therefore form a dense
+// sub-problem with an undilated filter, and the d_h * d_w sub-problems are batched along N
+// so a single non-dilated convolution computes all of them.
+//
+// Sub-grid buffers are laid out as [SG_DILATION_H][SG_DILATION_W][SG_N][SG_C][SG_HS][SG_WS],
+// i.e. as an NCHW tensor with batch SG_DILATION_H * SG_DILATION_W * SG_N. Element (hs, ws)
+// of sub-grid (a, b) corresponds to element (hs * SG_DILATION_H + a - SG_PAD_H,
+// ws * SG_DILATION_W + b - SG_PAD_W) of the full tensor.
+//
+// SG_N, SG_C, SG_H, SG_W     full tensor sizes
+// SG_HS, SG_WS               sub-grid sizes
+// SG_DILATION_H/W            dilations
+// SG_PAD_H, SG_PAD_W         offset of the full tensor inside the sub-grids
+
+#define SG_SUB_GRID_SIZE ((size_t)SG_N * SG_C * SG_HS * SG_WS)
+#define SG_SPLIT_SIZE (SG_DILATION_H * SG_DILATION_W * SG_SUB_GRID_SIZE)
+#define SG_MERGE_SIZE ((size_t)SG_N * SG_C * SG_H * SG_W)
+
+// Gathers the full tensor into the sub-grids. Elements that fall outside of the full tensor
+// (padding, or the tail of a sub-grid that is shorter than the others) are zeroed.
+__kernel void MIOpenConvDilatedSubGridSplit(const __global _FLOAT* __restrict p_full,
+                                            __global _FLOAT* __restrict p_sub)
+{
+    const size_t gid = get_global_id(0);
+    if(gid >= SG_SPLIT_SIZE)
+        return;
+
+    const int ws    = (int)(gid % SG_WS);
+    const int hs    = (int)((gid / SG_WS) % SG_HS);
+    const size_t nc = (gid / ((size_t)SG_HS * SG_WS)) % ((size_t)SG_N * SG_C);
+    const int grid  = (int)(gid / SG_SUB_GRID_SIZE);
+    const int a     = grid / SG_DILATION_W;
+    const int b     = grid % SG_DILATION_W;
+
+    const int h = hs * SG_DILATION_H + a - SG_PAD_H;
+    const int w = ws * SG_DILATION_W + b - SG_PAD_W;
+
+    p_sub[gid] = (h >= 0 && h < SG_H && w >= 0 && w < SG_W)
+                     ? p_full[(nc * SG_H + h) * SG_W + w]
+                     : (_FLOAT)0;
+}
+
+// Scatters the sub-grids back into the full tensor. Every full element is written exactly
+// once; sub-grid elements outside of it are dropped.
+__kernel void MIOpenConvDilatedSubGridMerge(const __global _FLOAT* __restrict p_sub,
+                                            __global _FLOAT* __restrict p_full)
+{
+    const size_t gid = get_global_id(0);
+    if(gid >= SG_MERGE_SIZE)
+        return;
+
+    const int w     = (int)(gid % SG_W);
+    const int h     = (int)((gid / SG_W) % SG_H);
+    const size_t nc = gid / ((size_t)SG_H * SG_W);
+
+    const int a  = (h + SG_PAD_H) % SG_DILATION_H;
+    const int b  = (w + SG_PAD_W) % SG_DILATION_W;
+    const int hs = (h + SG_PAD_H) / SG_DILATION_H;
+    const int ws = (w + SG_PAD_W) / SG_DILATION_W;
+
+    p_full[gid] =
+        p_sub[(a * SG_DILATION_W + b) * SG_SUB_GRID_SIZE + (nc * SG_HS + hs) * SG_WS + ws];
+}
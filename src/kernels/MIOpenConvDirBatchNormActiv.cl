@@ -328,6 +328,10 @@ static inline void Conv(uint o_map_base,
 #define MLO_CONV_BIAS 0
 #endif
 
+#ifndef MLO_CONV_RESIDUAL
+#define MLO_CONV_RESIDUAL 0
+#endif
+
 #if MIOPEN_USE_FP16 == 1
 #pragma OPENCL EXTENSION cl_khr_fp16 : enable
 #define _FLOAT half
@@ -363,6 +367,10 @@ MIOpenConvUniBatchNormActiv(
     ,
     const __global _FLOAT* __restrict conv_bias
 #endif
+#if MLO_CONV_RESIDUAL
+    ,
+    const __global _FLOAT* __restrict residual
+#endif
 #ifndef NO_BN
     ,
     const __global _FLOAT* __restrict bn_bias,
@@ -772,6 +780,9 @@ MIOpenConvUniBatchNormActiv(
                                 (_FLOAT)pvt_accum[o * MLO_OUT_TILE_SZ + j * MLO_OUT_TILE0 + i]
 #if MLO_CONV_BIAS
                                 + conv_bias[o_map + o]
+#endif
+#if MLO_CONV_RESIDUAL
+                                + residual[out_off2 + i]
 #endif
                                 ;
 
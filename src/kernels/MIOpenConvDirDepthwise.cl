@@ -0,0 +1,274 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "float_types.h"
+
+// Direct depthwise convolutions (group count == input channels, channel multiplier
+// MULT = K / C). NCHW packed tensors only. The whole geometry is given at compile time,
+// so that all loops over the filter and the register tiles are fully unrolled:
+//
+// DW_N, DW_C, DW_HI, DW_WI   input (x, dx) sizes
+// DW_MULT                    output channels per input channel, K = C * MULT
+// DW_HO, DW_WO               output (y, dy) spatial sizes
+// DW_FILTER                  square filter size
+// DW_STRIDE                  stride, same for H and W
+// DW_PAD_H, DW_PAD_W         symmetric padding
+// DW_TILE_H, DW_TILE_W       outputs computed by one work-item
+//
+// Every work-item keeps its weights and the input window of its tile in registers, so
+// each input element is read from memory once per tile instead of once per filter tap.
+
+#define DW_K (DW_C * DW_MULT)
+
+#define DW_TILES_W ((DW_WO + DW_TILE_W - 1) / DW_TILE_W)
+#define DW_TILES_H ((DW_HO + DW_TILE_H - 1) / DW_TILE_H)
+
+// input window of a forward tile
+#define DW_WIN_H ((DW_TILE_H - 1) * DW_STRIDE + DW_FILTER)
+#define DW_WIN_W ((DW_TILE_W - 1) * DW_STRIDE + DW_FILTER)
+
+// backward data tiles are over dx
+#define DW_BWD_TILES_W ((DW_WI + DW_TILE_W - 1) / DW_TILE_W)
+#define DW_BWD_TILES_H ((DW_HI + DW_TILE_H - 1) / DW_TILE_H)
+
+// dy window of a backward data tile, an upper bound of the dy rows (columns) reached by
+// DW_TILE_H + DW_FILTER - 1 consecutive dx rows (columns)
+#define DW_BWD_WIN_H ((DW_TILE_H + DW_FILTER - 2) / DW_STRIDE + 2)
+#define DW_BWD_WIN_W ((DW_TILE_W + DW_FILTER - 2) / DW_STRIDE + 2)
+
+#define DW_WRW_LOCAL_SIZE 256
+#define DW_FILTER_SIZE (DW_FILTER * DW_FILTER)
+
+static inline int FloorDiv(int a, int b) { return a >= 0 ? a / b : -((-a + b - 1) / b); }
+
+static inline void LoadWeights(const __global _FLOAT* __restrict p_wei,
+                               int ik,
+                               _FLOAT_ACCUM wei[DW_FILTER][DW_FILTER])
+{
+    const __global _FLOAT* p = p_wei + (size_t)ik * DW_FILTER_SIZE;
+    for(int iy = 0; iy < DW_FILTER; ++iy)
+        for(int ix = 0; ix < DW_FILTER; ++ix)
+            wei[iy][ix] = CVT_FLOAT2ACCUM(p[iy * DW_FILTER + ix]);
+}
+
+__kernel void MIOpenConvDepthwiseFwd(const __global _FLOAT* __restrict p_in,
+                                     const __global _FLOAT* __restrict p_wei,
+                                     __global _FLOAT* __restrict p_out)
+{
+    const int tile = (int)get_global_id(0);
+    if(tile >= DW_TILES_W * DW_TILES_H)
+        return;
+
+    const int nk  = (int)get_global_id(1);
+    const int ik  = nk % DW_K;
+    const int in  = nk / DW_K;
+    const int ic  = ik / DW_MULT;
+    const int ho0 = (tile / DW_TILES_W) * DW_TILE_H;
+    const int wo0 = (tile % DW_TILES_W) * DW_TILE_W;
+    const int hi0 = ho0 * DW_STRIDE - DW_PAD_H;
+    const int wi0 = wo0 * DW_STRIDE - DW_PAD_W;
+
+    _FLOAT_ACCUM wei[DW_FILTER][DW_FILTER];
+    LoadWeights(p_wei, ik, wei);
+
+    // rows of the window are contiguous in memory, so the loads of a row vectorize
+    const __global _FLOAT* p_in_c = p_in + ((size_t)in * DW_C + ic) * DW_HI * DW_WI;
+    _FLOAT_ACCUM win[DW_WIN_H][DW_WIN_W];
+    for(int j = 0; j < DW_WIN_H; ++j)
+    {
+        const int ihi = hi0 + j;
+        for(int i = 0; i < DW_WIN_W; ++i)
+        {
+            const int iwi = wi0 + i;
+            win[j][i]     = (ihi >= 0 && ihi < DW_HI && iwi >= 0 && iwi < DW_WI)
+                            ? CVT_FLOAT2ACCUM(p_in_c[ihi * DW_WI + iwi])
+                            : (_FLOAT_ACCUM)0;
+        }
+    }
+
+    __global _FLOAT* p_out_k = p_out + ((size_t)in * DW_K + ik) * DW_HO * DW_WO;
+    for(int th = 0; th < DW_TILE_H; ++th)
+    {
+        const int iho = ho0 + th;
+        for(int tw = 0; tw < DW_TILE_W; ++tw)
+        {
+            const int iwo = wo0 + tw;
+
+            _FLOAT_ACCUM acc = (_FLOAT_ACCUM)0;
+            for(int iy = 0; iy < DW_FILTER; ++iy)
+                for(int ix = 0; ix < DW_FILTER; ++ix)
+                    acc += win[th * DW_STRIDE + iy][tw * DW_STRIDE + ix] * wei[iy][ix];
+
+            if(iho < DW_HO && iwo < DW_WO)
+                p_out_k[iho * DW_WO + iwo] = CVT_ACCUM2FLOAT(acc);
+        }
+    }
+}
+
+__kernel void MIOpenConvDepthwiseBwd(__global _FLOAT* __restrict p_in,
+                                     const __global _FLOAT* __restrict p_wei,
+                                     const __global _FLOAT* __restrict p_out)
+{
+    const int tile = (int)get_global_id(0);
+    if(tile >= DW_BWD_TILES_W * DW_BWD_TILES_H)
+        return;
+
+    const int nc  = (int)get_global_id(1);
+    const int ic  = nc % DW_C;
+    const int in  = nc / DW_C;
+    const int hi0 = (tile / DW_BWD_TILES_W) * DW_TILE_H;
+    const int wi0 = (tile % DW_BWD_TILES_W) * DW_TILE_W;
+
+    // dx(h) gathers dy((h + pad - y) / stride) for the taps y where the division is exact.
+    // Offsets are taken relative to the first dy row of the window, which keeps them
+    // non-negative, so the exactness check is a plain modulo.
+    const int ho0 = FloorDiv(hi0 + DW_PAD_H - (DW_FILTER - 1), DW_STRIDE);
+    const int wo0 = FloorDiv(wi0 + DW_PAD_W - (DW_FILTER - 1), DW_STRIDE);
+
+    _FLOAT_ACCUM acc[DW_TILE_H][DW_TILE_W];
+    for(int th = 0; th < DW_TILE_H; ++th)
+        for(int tw = 0; tw < DW_TILE_W; ++tw)
+            acc[th][tw] = (_FLOAT_ACCUM)0;
+
+    for(int m = 0; m < DW_MULT; ++m)
+    {
+        const int ik = ic * DW_MULT + m;
+
+        _FLOAT_ACCUM wei[DW_FILTER][DW_FILTER];
+        LoadWeights(p_wei, ik, wei);
+
+        const __global _FLOAT* p_out_k = p_out + ((size_t)in * DW_K + ik) * DW_HO * DW_WO;
+        _FLOAT_ACCUM win[DW_BWD_WIN_H][DW_BWD_WIN_W];
+        for(int j = 0; j < DW_BWD_WIN_H; ++j)
+        {
+            const int iho = ho0 + j;
+            for(int i = 0; i < DW_BWD_WIN_W; ++i)
+            {
+                const int iwo = wo0 + i;
+                win[j][i]     = (iho >= 0 && iho < DW_HO && iwo >= 0 && iwo < DW_WO)
+                                ? CVT_FLOAT2ACCUM(p_out_k[iho * DW_WO + iwo])
+                                : (_FLOAT_ACCUM)0;
+            }
+        }
+
+        for(int th = 0; th < DW_TILE_H; ++th)
+            for(int tw = 0; tw < DW_TILE_W; ++tw)
+                for(int iy = 0; iy < DW_FILTER; ++iy)
+                {
+                    const int ty = hi0 + th + DW_PAD_H - iy - ho0 * DW_STRIDE;
+                    if(ty % DW_STRIDE != 0)
+                        continue;
+                    for(int ix = 0; ix < DW_FILTER; ++ix)
+                    {
+                        const int tx = wi0 + tw + DW_PAD_W - ix - wo0 * DW_STRIDE;
+                        if(tx % DW_STRIDE != 0)
+                            continue;
+                        acc[th][tw] += win[ty / DW_STRIDE][tx / DW_STRIDE] * wei[iy][ix];
+                    }
+                }
+    }
+
+    __global _FLOAT* p_in_c = p_in + ((size_t)in * DW_C + ic) * DW_HI * DW_WI;
+    for(int th = 0; th < DW_TILE_H; ++th)
+        for(int tw = 0; tw < DW_TILE_W; ++tw)
+        {
+            const int ihi = hi0 + th;
+            const int iwi = wi0 + tw;
+            if(ihi < DW_HI && iwi < DW_WI)
+                p_in_c[ihi * DW_WI + iwi] = CVT_ACCUM2FLOAT(acc[th][tw]);
+        }
+}
+
+// One work-group per output channel. Work-items stride over rows of DW_TILE_W outputs of
+// all images, keep the partial filter gradient in registers, and reduce it through LDS.
+__kernel void MIOpenConvDepthwiseWrw(const __global _FLOAT* __restrict p_in,
+                                     __global _FLOAT* __restrict p_wei,
+                                     const __global _FLOAT* __restrict p_out)
+{
+    __local _FLOAT_ACCUM lds[DW_FILTER_SIZE * DW_WRW_LOCAL_SIZE];
+
+    const int lid = (int)get_local_id(0);
+    const int ik  = (int)get_group_id(1);
+    const int ic  = ik / DW_MULT;
+
+    _FLOAT_ACCUM dw[DW_FILTER][DW_FILTER];
+    for(int iy = 0; iy < DW_FILTER; ++iy)
+        for(int ix = 0; ix < DW_FILTER; ++ix)
+            dw[iy][ix] = (_FLOAT_ACCUM)0;
+
+    for(int row = lid; row < DW_N * DW_HO * DW_TILES_W; row += DW_WRW_LOCAL_SIZE)
+    {
+        const int wo0 = (row % DW_TILES_W) * DW_TILE_W;
+        const int iho = (row / DW_TILES_W) % DW_HO;
+        const int in  = row / (DW_TILES_W * DW_HO);
+        const int hi0 = iho * DW_STRIDE - DW_PAD_H;
+        const int wi0 = wo0 * DW_STRIDE - DW_PAD_W;
+
+        const __global _FLOAT* p_in_c  = p_in + ((size_t)in * DW_C + ic) * DW_HI * DW_WI;
+        const __global _FLOAT* p_out_k = p_out + ((size_t)in * DW_K + ik) * DW_HO * DW_WO;
+
+        _FLOAT_ACCUM dy[DW_TILE_W];
+        for(int tw = 0; tw < DW_TILE_W; ++tw)
+            dy[tw] = (wo0 + tw < DW_WO) ? CVT_FLOAT2ACCUM(p_out_k[iho * DW_WO + wo0 + tw])
+                                        : (_FLOAT_ACCUM)0;
+
+        for(int iy = 0; iy < DW_FILTER; ++iy)
+        {
+            const int ihi = hi0 + iy;
+            if(ihi < 0 || ihi >= DW_HI)
+                continue;
+
+            _FLOAT_ACCUM x[DW_WIN_W];
+            for(int i = 0; i < DW_WIN_W; ++i)
+            {
+                const int iwi = wi0 + i;
+                x[i]          = (iwi >= 0 && iwi < DW_WI)
+                           ? CVT_FLOAT2ACCUM(p_in_c[ihi * DW_WI + iwi])
+                           : (_FLOAT_ACCUM)0;
+            }
+
+            for(int ix = 0; ix < DW_FILTER; ++ix)
+                for(int tw = 0; tw < DW_TILE_W; ++tw)
+                    dw[iy][ix] += x[tw * DW_STRIDE + ix] * dy[tw];
+        }
+    }
+
+    for(int iy = 0; iy < DW_FILTER; ++iy)
+        for(int ix = 0; ix < DW_FILTER; ++ix)
+            lds[(iy * DW_FILTER + ix) * DW_WRW_LOCAL_SIZE + lid] = dw[iy][ix];
+
+    for(int s = DW_WRW_LOCAL_SIZE / 2; s > 0; s >>= 1)
+    {
+        barrier(CLK_LOCAL_MEM_FENCE);
+        if(lid < s)
+            for(int j = 0; j < DW_FILTER_SIZE; ++j)
+                lds[j * DW_WRW_LOCAL_SIZE + lid] += lds[j * DW_WRW_LOCAL_SIZE + lid + s];
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    if(lid < DW_FILTER_SIZE)
+        p_wei[(size_t)ik * DW_FILTER_SIZE + lid] = CVT_ACCUM2FLOAT(lds[lid * DW_WRW_LOCAL_SIZE]);
+}
@@ -0,0 +1,208 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "float_types.h"
+
+// Straightforward direct convolutions, one work-item per element of the tensor being
+// computed. Spatial sizes and all strides are run-time parameters, so the same binary
+// handles any problem and any memory layout (NCHW, NHWC, ...). 2D problems are passed
+// as 3D ones with depth of 1.
+//
+// Naming follows the forward convolution: in (N,C,Di,Hi,Wi), wei (K,C/G,Z,Y,X),
+// out (N,K,Do,Ho,Wo), regardless of direction.
+
+#define NAIVE_CONV_PARAMS                                                                         \
+    const int n, const int c, const int di, const int hi, const int wi, const int k,             \
+        const int do_, const int ho, const int wo, const int fz, const int fy, const int fx,     \
+        const int group, const int pad_d, const int pad_h, const int pad_w, const int stride_d,  \
+        const int stride_h, const int stride_w, const int dilation_d, const int dilation_h,      \
+        const int dilation_w, const int in_sn, const int in_sc, const int in_sd,                 \
+        const int in_sh, const int in_sw, const int wei_sk, const int wei_sc, const int wei_sd,  \
+        const int wei_sh, const int wei_sw, const int out_sn, const int out_sk,                  \
+        const int out_sd, const int out_sh, const int out_sw
+
+static inline size_t
+NaiveOffset(int i0, int i1, int i2, int i3, int i4, int s0, int s1, int s2, int s3, int s4)
+{
+    return (size_t)i0 * s0 + (size_t)i1 * s1 + (size_t)i2 * s2 + (size_t)i3 * s3 +
+           (size_t)i4 * s4;
+}
+
+__kernel void MIOpenConvNaiveFwd(const __global _FLOAT* __restrict p_in,
+                                 const __global _FLOAT* __restrict p_wei,
+                                 __global _FLOAT* __restrict p_out,
+                                 NAIVE_CONV_PARAMS)
+{
+    const int gid = (int)get_global_id(0);
+    if(gid >= n * k * do_ * ho * wo)
+        return;
+
+    const int iwo = gid % wo;
+    const int iho = (gid / wo) % ho;
+    const int ido = (gid / (wo * ho)) % do_;
+    const int ik  = (gid / (wo * ho * do_)) % k;
+    const int in  = gid / (wo * ho * do_ * k);
+
+    const int c_per_group = c / group;
+    const int k_per_group = k / group;
+    const int ic_base     = (ik / k_per_group) * c_per_group;
+
+    _FLOAT_ACCUM acc = (_FLOAT_ACCUM)0;
+    for(int ic = 0; ic < c_per_group; ++ic)
+        for(int iz = 0; iz < fz; ++iz)
+        {
+            const int idi = ido * stride_d - pad_d + iz * dilation_d;
+            if(idi < 0 || idi >= di)
+                continue;
+            for(int iy = 0; iy < fy; ++iy)
+            {
+                const int ihi = iho * stride_h - pad_h + iy * dilation_h;
+                if(ihi < 0 || ihi >= hi)
+                    continue;
+                for(int ix = 0; ix < fx; ++ix)
+                {
+                    const int iwi = iwo * stride_w - pad_w + ix * dilation_w;
+                    if(iwi < 0 || iwi >= wi)
+                        continue;
+                    const size_t in_off = NaiveOffset(
+                        in, ic_base + ic, idi, ihi, iwi, in_sn, in_sc, in_sd, in_sh, in_sw);
+                    const size_t wei_off =
+                        NaiveOffset(ik, ic, iz, iy, ix, wei_sk, wei_sc, wei_sd, wei_sh, wei_sw);
+                    acc += CVT_FLOAT2ACCUM(p_in[in_off]) * CVT_FLOAT2ACCUM(p_wei[wei_off]);
+                }
+            }
+        }
+
+    p_out[NaiveOffset(in, ik, ido, iho, iwo, out_sn, out_sk, out_sd, out_sh, out_sw)] =
+        CVT_ACCUM2FLOAT(acc);
+}
+
+__kernel void MIOpenConvNaiveBwd(__global _FLOAT* __restrict p_in,
+                                 const __global _FLOAT* __restrict p_wei,
+                                 const __global _FLOAT* __restrict p_out,
+                                 NAIVE_CONV_PARAMS)
+{
+    const int gid = (int)get_global_id(0);
+    if(gid >= n * c * di * hi * wi)
+        return;
+
+    const int iwi = gid % wi;
+    const int ihi = (gid / wi) % hi;
+    const int idi = (gid / (wi * hi)) % di;
+    const int ic  = (gid / (wi * hi * di)) % c;
+    const int in  = gid / (wi * hi * di * c);
+
+    const int c_per_group = c / group;
+    const int k_per_group = k / group;
+    const int ik_base     = (ic / c_per_group) * k_per_group;
+    const int ic_local    = ic % c_per_group;
+
+    _FLOAT_ACCUM acc = (_FLOAT_ACCUM)0;
+    for(int ik = 0; ik < k_per_group; ++ik)
+        for(int iz = 0; iz < fz; ++iz)
+        {
+            const int tz = idi + pad_d - iz * dilation_d;
+            if(tz < 0 || tz % stride_d != 0 || tz / stride_d >= do_)
+                continue;
+            for(int iy = 0; iy < fy; ++iy)
+            {
+                const int ty = ihi + pad_h - iy * dilation_h;
+                if(ty < 0 || ty % stride_h != 0 || ty / stride_h >= ho)
+                    continue;
+                for(int ix = 0; ix < fx; ++ix)
+                {
+                    const int tx = iwi + pad_w - ix * dilation_w;
+                    if(tx < 0 || tx % stride_w != 0 || tx / stride_w >= wo)
+                        continue;
+                    const size_t out_off = NaiveOffset(in,
+                                                       ik_base + ik,
+                                                       tz / stride_d,
+                                                       ty / stride_h,
+                                                       tx / stride_w,
+                                                       out_sn,
+                                                       out_sk,
+                                                       out_sd,
+                                                       out_sh,
+                                                       out_sw);
+                    const size_t wei_off = NaiveOffset(
+                        ik_base + ik, ic_local, iz, iy, ix, wei_sk, wei_sc, wei_sd, wei_sh, wei_sw);
+                    acc += CVT_FLOAT2ACCUM(p_out[out_off]) * CVT_FLOAT2ACCUM(p_wei[wei_off]);
+                }
+            }
+        }
+
+    p_in[NaiveOffset(in, ic, idi, ihi, iwi, in_sn, in_sc, in_sd, in_sh, in_sw)] =
+        CVT_ACCUM2FLOAT(acc);
+}
+
+__kernel void MIOpenConvNaiveWrw(const __global _FLOAT* __restrict p_in,
+                                 __global _FLOAT* __restrict p_wei,
+                                 const __global _FLOAT* __restrict p_out,
+                                 NAIVE_CONV_PARAMS)
+{
+    const int c_per_group = c / group;
+    const int k_per_group = k / group;
+
+    const int gid = (int)get_global_id(0);
+    if(gid >= k * c_per_group * fz * fy * fx)
+        return;
+
+    const int ix       = gid % fx;
+    const int iy       = (gid / fx) % fy;
+    const int iz       = (gid / (fx * fy)) % fz;
+    const int ic_local = (gid / (fx * fy * fz)) % c_per_group;
+    const int ik       = gid / (fx * fy * fz * c_per_group);
+    const int ic       = (ik / k_per_group) * c_per_group + ic_local;
+
+    _FLOAT_ACCUM acc = (_FLOAT_ACCUM)0;
+    for(int in = 0; in < n; ++in)
+        for(int ido = 0; ido < do_; ++ido)
+        {
+            const int idi = ido * stride_d - pad_d + iz * dilation_d;
+            if(idi < 0 || idi >= di)
+                continue;
+            for(int iho = 0; iho < ho; ++iho)
+            {
+                const int ihi = iho * stride_h - pad_h + iy * dilation_h;
+                if(ihi < 0 || ihi >= hi)
+                    continue;
+                for(int iwo = 0; iwo < wo; ++iwo)
+                {
+                    const int iwi = iwo * stride_w - pad_w + ix * dilation_w;
+                    if(iwi < 0 || iwi >= wi)
+                        continue;
+                    const size_t in_off =
+                        NaiveOffset(in, ic, idi, ihi, iwi, in_sn, in_sc, in_sd, in_sh, in_sw);
+                    const size_t out_off = NaiveOffset(
+                        in, ik, ido, iho, iwo, out_sn, out_sk, out_sd, out_sh, out_sw);
+                    acc += CVT_FLOAT2ACCUM(p_in[in_off]) * CVT_FLOAT2ACCUM(p_out[out_off]);
+                }
+            }
+        }
+
+    p_wei[NaiveOffset(ik, ic_local, iz, iy, ix, wei_sk, wei_sc, wei_sd, wei_sh, wei_sw)] =
+        CVT_ACCUM2FLOAT(acc);
+}
@@ -0,0 +1,165 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "float_types.h"
+
+// Strided backward data convolution (equivalently, the forward pass of a transposed
+// convolution) by phase decomposition. NCHW packed tensors only.
+//
+// dx(h) gathers dy((h + pad - y * dilation) / stride) over the filter taps y for which
+// the division is exact. Which taps those are depends only on the phase h % stride, so
+// the dx rows (columns) of one phase form a dense stride-1 convolution of dy with a
+// sub-filter made of every TP_STEP_H-th (TP_STEP_W-th) tap. The kernel runs the
+// stride_h * stride_w sub-convolutions side by side and never visits a tap that would
+// meet an inserted zero.
+//
+// TP_N, TP_C, TP_HI, TP_WI   dx sizes
+// TP_K, TP_HO, TP_WO         dy sizes
+// TP_Y, TP_X                 filter sizes
+// TP_STRIDE_H, TP_STRIDE_W   strides
+// TP_DILATION_H/W            dilations
+// TP_PAD_H, TP_PAD_W         left paddings
+// TP_GROUPS                  group count
+// TP_TILE_C                  dx channels computed by one work-item, divides C / TP_GROUPS
+// TP_TILE_W                  dx columns of one phase computed by one work-item
+// TP_STEP_H, TP_STEP_W       distance between the taps of one phase, stride / gcd(stride,
+//                            dilation)
+
+#define TP_C_PER_GROUP (TP_C / TP_GROUPS)
+#define TP_K_PER_GROUP (TP_K / TP_GROUPS)
+
+// dx rows (columns) of the largest phase
+#define TP_PHASE_H ((TP_HI + TP_STRIDE_H - 1) / TP_STRIDE_H)
+#define TP_PHASE_W ((TP_WI + TP_STRIDE_W - 1) / TP_STRIDE_W)
+#define TP_PHASE_TILES_W ((TP_PHASE_W + TP_TILE_W - 1) / TP_TILE_W)
+
+#define TP_TILES_PER_PHASE (TP_PHASE_H * TP_PHASE_TILES_W)
+
+static inline int PositiveMod(int a, int b)
+{
+    const int r = a % b;
+    return r < 0 ? r + b : r;
+}
+
+// First tap of the sub-filter that serves dx positions of the given phase, or -1 when no
+// tap reaches them (possible only when stride and dilation share a factor).
+static inline int FirstTap(int phase, int pad, int stride, int dilation, int step)
+{
+    for(int t = 0; t < step; ++t)
+        if(PositiveMod(phase + pad - t * dilation, stride) == 0)
+            return t;
+    return -1;
+}
+
+__kernel void MIOpenConvTransposePhaseBwd(__global _FLOAT* __restrict p_in,
+                                          const __global _FLOAT* __restrict p_wei,
+                                          const __global _FLOAT* __restrict p_out)
+{
+    const int gid = (int)get_global_id(0);
+    if(gid >= TP_STRIDE_H * TP_STRIDE_W * TP_TILES_PER_PHASE)
+        return;
+
+    const int phase = gid / TP_TILES_PER_PHASE;
+    const int tile  = gid % TP_TILES_PER_PHASE;
+    const int ph    = phase / TP_STRIDE_W;
+    const int pw    = phase % TP_STRIDE_W;
+    const int ihi   = ph + (tile / TP_PHASE_TILES_W) * TP_STRIDE_H;
+    const int j0    = (tile % TP_PHASE_TILES_W) * TP_TILE_W;
+    if(ihi >= TP_HI || pw + j0 * TP_STRIDE_W >= TP_WI)
+        return;
+
+    const int nc  = (int)get_global_id(1);
+    const int in  = nc / (TP_C / TP_TILE_C);
+    const int ic0 = (nc % (TP_C / TP_TILE_C)) * TP_TILE_C;
+    const int ig  = ic0 / TP_C_PER_GROUP;
+    const int icl = ic0 % TP_C_PER_GROUP;
+
+    _FLOAT_ACCUM acc[TP_TILE_C][TP_TILE_W];
+    for(int c = 0; c < TP_TILE_C; ++c)
+        for(int t = 0; t < TP_TILE_W; ++t)
+            acc[c][t] = (_FLOAT_ACCUM)0;
+
+    const int y0 = FirstTap(ph, TP_PAD_H, TP_STRIDE_H, TP_DILATION_H, TP_STEP_H);
+    const int x0 = FirstTap(pw, TP_PAD_W, TP_STRIDE_W, TP_DILATION_W, TP_STEP_W);
+
+    if(y0 >= 0 && x0 >= 0)
+    {
+        // dx column pw + (j0 + t) * stride meets dy column wo_base + t for every tap x of
+        // the phase, so a tile reads consecutive dy elements.
+        const int wi0 = pw + j0 * TP_STRIDE_W;
+
+        for(int iy = y0; iy < TP_Y; iy += TP_STEP_H)
+        {
+            const int ho_num = ihi + TP_PAD_H - iy * TP_DILATION_H;
+            if(ho_num < 0)
+                break;
+            const int iho = ho_num / TP_STRIDE_H;
+            if(iho >= TP_HO)
+                continue;
+
+            for(int ix = x0; ix < TP_X; ix += TP_STEP_W)
+            {
+                const int wo_base = (wi0 + TP_PAD_W - ix * TP_DILATION_W) / TP_STRIDE_W;
+
+                for(int kl = 0; kl < TP_K_PER_GROUP; ++kl)
+                {
+                    const int ik = ig * TP_K_PER_GROUP + kl;
+
+                    const __global _FLOAT* p_out_row =
+                        p_out + (((size_t)in * TP_K + ik) * TP_HO + iho) * TP_WO;
+                    const __global _FLOAT* p_wei_k =
+                        p_wei + (((size_t)ik * TP_C_PER_GROUP + icl) * TP_Y + iy) * TP_X + ix;
+
+                    _FLOAT_ACCUM dy[TP_TILE_W];
+                    for(int t = 0; t < TP_TILE_W; ++t)
+                    {
+                        const int iwo = wo_base + t;
+                        dy[t]         = (iwo >= 0 && iwo < TP_WO) ? CVT_FLOAT2ACCUM(p_out_row[iwo])
+                                                                   : (_FLOAT_ACCUM)0;
+                    }
+
+                    for(int c = 0; c < TP_TILE_C; ++c)
+                    {
+                        const _FLOAT_ACCUM w = CVT_FLOAT2ACCUM(p_wei_k[(size_t)c * TP_Y * TP_X]);
+                        for(int t = 0; t < TP_TILE_W; ++t)
+                            acc[c][t] += dy[t] * w;
+                    }
+                }
+            }
+        }
+    }
+
+    for(int c = 0; c < TP_TILE_C; ++c)
+    {
+        __global _FLOAT* p_in_row = p_in + (((size_t)in * TP_C + ic0 + c) * TP_HI + ihi) * TP_WI;
+        for(int t = 0; t < TP_TILE_W; ++t)
+        {
+            const int iwi = pw + (j0 + t) * TP_STRIDE_W;
+            if(iwi < TP_WI)
+                p_in_row[iwi] = CVT_ACCUM2FLOAT(acc[c][t]);
+        }
+    }
+}
@@ -47,6 +47,18 @@
 /// \todo Pass available LDS size to kernel during compilation.
 #define MLO_LDS_MAX_SIZE 65536
 
+// With double buffering the input and weight chunks alternate between two LDS buffers, so a
+// chunk is loaded while the slower waves still compute on the previous one, and the loop needs
+// one barrier per chunk instead of two.
+#ifndef MLO_LDS_DOUBLE_BUFFER
+#define MLO_LDS_DOUBLE_BUFFER 0
+#endif
+#if MLO_LDS_DOUBLE_BUFFER
+#define MLO_LDS_N_BUFFERS 2
+#else
+#define MLO_LDS_N_BUFFERS 1
+#endif
+
 #define MLO_FILTER_SZ (MLO_FILTER_SIZE1 * MLO_FILTER_SIZE0)
 
 #define MLO_GRP_SZ0 (MLO_GRP_TILE0 * MLO_GRP_TILE1)
@@ -321,11 +333,13 @@ MIOpenConvUni(const __global _FLOAT* __restrict in,
               __global _FLOAT* __restrict out,
               UNUSED _FLOAT padding_val)
 {
-#if((MLO_IN_LCL_SZ + MLO_WEIGHTS_SZ) * SIZEOF_FLOAT) > MLO_LDS_MAX_SIZE
+#if((MLO_IN_LCL_SZ + MLO_WEIGHTS_SZ) * MLO_LDS_N_BUFFERS * SIZEOF_FLOAT) > MLO_LDS_MAX_SIZE
 #error "Local memory size should not exceed 64k."
 #endif
-    __local _FLOAT lcl_indata[MLO_IN_LCL_SZ];
-    __local _FLOAT lcl_wei[MLO_WEIGHTS_SZ];
+    __local _FLOAT lcl_indata_buf[MLO_IN_LCL_SZ * MLO_LDS_N_BUFFERS];
+    __local _FLOAT lcl_wei_buf[MLO_WEIGHTS_SZ * MLO_LDS_N_BUFFERS];
+    __local _FLOAT* lcl_indata = lcl_indata_buf;
+    __local _FLOAT* lcl_wei    = lcl_wei_buf;
     __private _FLOAT_ACCUM pvt_accum[MLO_PVT_ACCUM_DATA_SZ];
     __private _FLOAT pvt_in_stage[MLO_PVT_IN_HEIGHT * MLO_PVT_IN_WIDTH];
     __private _FLOAT pvt_wei_stage[MLO_FILTER_SIZE0];
@@ -425,11 +439,15 @@ MIOpenConvUni(const __global _FLOAT* __restrict in,
     uint in_stg_off = stack * MLO_IN_LCL_PERSTACK_SZ + (y_in_lcl)*MLO_IN_LCL_WIDTH + x_in_lcl;
 
 #if MLO_LARGE_MAP == 0
-    for(uint i = lcl_id; i < MLO_IN_LCL_SZ; i += MLO_GRP_SZ)
+    for(uint i = lcl_id; i < MLO_IN_LCL_SZ * MLO_LDS_N_BUFFERS; i += MLO_GRP_SZ)
     {
-        lcl_indata[i] = CVT_ACCUM2FLOAT(0);
+        lcl_indata_buf[i] = CVT_ACCUM2FLOAT(0);
     }
 #endif
+#if MLO_LDS_DOUBLE_BUFFER
+    // The loop does not begin with a barrier, so order the zeroing before the first loads.
+    barrier(CLK_LOCAL_MEM_FENCE);
+#endif
 
     for(uint i = 0; i < MLO_PVT_ACCUM_DATA_SZ; ++i)
     {
@@ -479,7 +497,12 @@ MIOpenConvUni(const __global _FLOAT* __restrict in,
 #endif
         )
     {
+#if MLO_LDS_DOUBLE_BUFFER
+        // Every wave read this buffer for the last time before the barrier that follows the
+        // loads of the previous chunk.
+#else
         barrier(CLK_LOCAL_MEM_FENCE);
+#endif
 
 // small map has been read in full continiously into the lDS buffer within padded rect,
 // padding has been done on initilization.
@@ -693,6 +716,12 @@ MIOpenConvUni(const __global _FLOAT* __restrict in,
         // convolution
         Conv(o_map_base, in_stg_off, pvt_in_stage, lcl_indata, pvt_wei_stage, lcl_wei, pvt_accum);
 
+#if MLO_LDS_DOUBLE_BUFFER
+        const bool first_buf = (lcl_indata == lcl_indata_buf);
+        lcl_indata           = first_buf ? lcl_indata_buf + MLO_IN_LCL_SZ : lcl_indata_buf;
+        lcl_wei              = first_buf ? lcl_wei_buf + MLO_WEIGHTS_SZ : lcl_wei_buf;
+#endif
+
         //		barrier(CLK_LOCAL_MEM_FENCE);
     }
 // write results out
@@ -0,0 +1,328 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Disable specific warnings
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wconditional-uninitialized"
+#endif
+
+#include "batchnorm_functions.h"
+#include "activation_functions.h"
+
+// The epilogue of a fusion plan, applied in place to the output of the convolution. Each of the
+// MIOPEN_EPILOGUE_SLOTS ops of the chain is selected by MIOPEN_EPILOGUE_OP<slot>, activations by
+// MIOPEN_EPILOGUE_MODE<slot>, so the ops of the plan are unrolled into one pass over the output.
+#define MIOPEN_EPILOGUE_NONE 0
+#define MIOPEN_EPILOGUE_BIAS 1
+#define MIOPEN_EPILOGUE_ACTIV 2
+#define MIOPEN_EPILOGUE_BN_SPATIAL 3
+#define MIOPEN_EPILOGUE_BN_PER_ACTIVATION 4
+#define MIOPEN_EPILOGUE_ADD 5
+
+// The pooling applied after the chain by MIOpenConvEpiloguePooling, over a
+// MIOPEN_POOLING_KERNEL_H x MIOPEN_POOLING_KERNEL_W window.
+#define MIOPEN_POOLING_MAX 1
+#define MIOPEN_POOLING_AVERAGE 2
+#define MIOPEN_POOLING_AVERAGE_INCLUSIVE 3
+
+#ifndef MIOPEN_EPILOGUE_SLOTS
+#define MIOPEN_EPILOGUE_SLOTS 0
+#endif
+
+#ifndef MIOPEN_EPILOGUE_OP0
+#define MIOPEN_EPILOGUE_OP0 MIOPEN_EPILOGUE_NONE
+#endif
+#ifndef MIOPEN_EPILOGUE_OP1
+#define MIOPEN_EPILOGUE_OP1 MIOPEN_EPILOGUE_NONE
+#endif
+#ifndef MIOPEN_EPILOGUE_OP2
+#define MIOPEN_EPILOGUE_OP2 MIOPEN_EPILOGUE_NONE
+#endif
+#ifndef MIOPEN_EPILOGUE_OP3
+#define MIOPEN_EPILOGUE_OP3 MIOPEN_EPILOGUE_NONE
+#endif
+#ifndef MIOPEN_EPILOGUE_OP4
+#define MIOPEN_EPILOGUE_OP4 MIOPEN_EPILOGUE_NONE
+#endif
+#ifndef MIOPEN_EPILOGUE_OP5
+#define MIOPEN_EPILOGUE_OP5 MIOPEN_EPILOGUE_NONE
+#endif
+#ifndef MIOPEN_EPILOGUE_OP6
+#define MIOPEN_EPILOGUE_OP6 MIOPEN_EPILOGUE_NONE
+#endif
+#ifndef MIOPEN_EPILOGUE_OP7
+#define MIOPEN_EPILOGUE_OP7 MIOPEN_EPILOGUE_NONE
+#endif
+
+#ifndef MIOPEN_EPILOGUE_MODE0
+#define MIOPEN_EPILOGUE_MODE0 MIOPEN_NEURON_PASTHRU
+#endif
+#ifndef MIOPEN_EPILOGUE_MODE1
+#define MIOPEN_EPILOGUE_MODE1 MIOPEN_NEURON_PASTHRU
+#endif
+#ifndef MIOPEN_EPILOGUE_MODE2
+#define MIOPEN_EPILOGUE_MODE2 MIOPEN_NEURON_PASTHRU
+#endif
+#ifndef MIOPEN_EPILOGUE_MODE3
+#define MIOPEN_EPILOGUE_MODE3 MIOPEN_NEURON_PASTHRU
+#endif
+#ifndef MIOPEN_EPILOGUE_MODE4
+#define MIOPEN_EPILOGUE_MODE4 MIOPEN_NEURON_PASTHRU
+#endif
+#ifndef MIOPEN_EPILOGUE_MODE5
+#define MIOPEN_EPILOGUE_MODE5 MIOPEN_NEURON_PASTHRU
+#endif
+#ifndef MIOPEN_EPILOGUE_MODE6
+#define MIOPEN_EPILOGUE_MODE6 MIOPEN_NEURON_PASTHRU
+#endif
+#ifndef MIOPEN_EPILOGUE_MODE7
+#define MIOPEN_EPILOGUE_MODE7 MIOPEN_NEURON_PASTHRU
+#endif
+
+// The arguments of a slot: up to four tensors and three scalars, depending on the op.
+#define MIOPEN_EPILOGUE_ARGS(slot)                                     \
+    , const __global _FLOAT* __restrict PPCAT(p, slot),                \
+        const __global _FLOAT* __restrict PPCAT(q, slot),              \
+        const __global _FLOAT* __restrict PPCAT(r, slot),              \
+        const __global _FLOAT* __restrict PPCAT(s, slot),              \
+        const float PPCAT(alpha, slot), const float PPCAT(beta, slot), \
+        const float PPCAT(gamma, slot)
+
+#define MIOPEN_EPILOGUE_APPLY(slot)                       \
+    value = EpilogueOp(PPCAT(MIOPEN_EPILOGUE_OP, slot),   \
+                       PPCAT(MIOPEN_EPILOGUE_MODE, slot), \
+                       value,                             \
+                       index,                             \
+                       channel,                           \
+                       index % chw,                       \
+                       PPCAT(p, slot),                    \
+                       PPCAT(q, slot),                    \
+                       PPCAT(r, slot),                    \
+                       PPCAT(s, slot),                    \
+                       (_FLOAT_PREC)PPCAT(alpha, slot),   \
+                       (_FLOAT_PREC)PPCAT(beta, slot),    \
+                       (_FLOAT_PREC)PPCAT(gamma, slot))
+
+_FLOAT_PREC Activate(const int mode,
+                     _FLOAT_PREC value,
+                     const _FLOAT_PREC alpha,
+                     const _FLOAT_PREC beta,
+                     const _FLOAT_PREC gamma)
+{
+    _FLOAT_PREC res = value;
+    switch(mode)
+    {
+    case MIOPEN_NEURON_LOGISTIC:
+        ActivationFunction_Sigmoid(1, &res, &value, gamma, beta, alpha);
+        break;
+    case MIOPEN_NEURON_TANH: ActivationFunction_TanH(1, &res, &value, gamma, beta, alpha); break;
+    case MIOPEN_NEURON_RELU: ActivationFunction_ReLU(1, &res, &value, gamma, beta, alpha); break;
+    case MIOPEN_NEURON_SOFTRELU:
+        ActivationFunction_BNLL(1, &res, &value, gamma, beta, alpha);
+        break;
+    case MIOPEN_NEURON_ABS: ActivationFunction_Abs(1, &res, &value, gamma, beta, alpha); break;
+    case MIOPEN_NEURON_POWER: ActivationFunction_Power(1, &res, &value, gamma, beta, alpha); break;
+    case MIOPEN_NEURON_CLIPPED_RELU:
+        ActivationFunction_Clipped_ReLU(1, &res, &value, gamma, beta, alpha);
+        break;
+    case MIOPEN_NEURON_LEAKY_RELU:
+        ActivationFunction_Leaky_ReLU(1, &res, &value, gamma, beta, alpha);
+        break;
+    case MIOPEN_NEURON_ELU: ActivationFunction_ELU(1, &res, &value, gamma, beta, alpha); break;
+    default: break;
+    }
+    return res;
+}
+
+// The op and mode are compile-time constants, so only one case remains of each call.
+_FLOAT_PREC EpilogueOp(const int op,
+                       const int mode,
+                       const _FLOAT_PREC value,
+                       const uint index,
+                       const uint channel,
+                       const uint chw_index,
+                       const __global _FLOAT* __restrict p,
+                       const __global _FLOAT* __restrict q,
+                       const __global _FLOAT* __restrict r,
+                       const __global _FLOAT* __restrict s,
+                       const _FLOAT_PREC alpha,
+                       const _FLOAT_PREC beta,
+                       const _FLOAT_PREC gamma)
+{
+    switch(op)
+    {
+    // p: bias
+    case MIOPEN_EPILOGUE_BIAS: return value + (_FLOAT_PREC)p[channel];
+    // alpha, beta, gamma: activation parameters
+    case MIOPEN_EPILOGUE_ACTIV: return Activate(mode, value, alpha, beta, gamma);
+    // p: scale, q: bias, r: estimated mean, s: estimated variance, alpha: epsilon
+    case MIOPEN_EPILOGUE_BN_SPATIAL:
+        return mad((_FLOAT_PREC)p[channel],
+                   (value - (_FLOAT_PREC)r[channel]) * rsqrt((_FLOAT_PREC)s[channel] + alpha),
+                   (_FLOAT_PREC)q[channel]);
+    case MIOPEN_EPILOGUE_BN_PER_ACTIVATION:
+        return mad((_FLOAT_PREC)p[chw_index],
+                   (value - (_FLOAT_PREC)r[chw_index]) * rsqrt((_FLOAT_PREC)s[chw_index] + alpha),
+                   (_FLOAT_PREC)q[chw_index]);
+    // p: a tensor of the shape of the output
+    case MIOPEN_EPILOGUE_ADD: return value + (_FLOAT_PREC)p[index];
+    default: return value;
+    }
+}
+
+#ifndef MIOPEN_EPILOGUE_POOLING
+#define MIOPEN_EPILOGUE_POOLING 0
+#endif
+
+// The output is packed NC<spatial>, hw is the product of its spatial lengths, and the chain is
+// applied in place. With MIOPEN_EPILOGUE_POOLING, in is the packed NCHW output of the convolution
+// and hw the product of its spatial lengths: the chain is applied to every pixel of a window of in
+// before the window is pooled into out, so the unpooled result is never written. Without it, in
+// and the lengths that follow are unused.
+__kernel void MIOpenConvEpilogue(__global _FLOAT* out,
+                                 const uint n_elems,
+                                 const uint hw,
+                                 const uint channels,
+                                 const __global _FLOAT* in,
+                                 const uint in_h,
+                                 const uint in_w,
+                                 const uint out_h,
+                                 const uint out_w
+#if MIOPEN_EPILOGUE_SLOTS > 0
+                                 MIOPEN_EPILOGUE_ARGS(0)
+#endif
+#if MIOPEN_EPILOGUE_SLOTS > 1
+                                 MIOPEN_EPILOGUE_ARGS(1)
+#endif
+#if MIOPEN_EPILOGUE_SLOTS > 2
+                                 MIOPEN_EPILOGUE_ARGS(2)
+#endif
+#if MIOPEN_EPILOGUE_SLOTS > 3
+                                 MIOPEN_EPILOGUE_ARGS(3)
+#endif
+#if MIOPEN_EPILOGUE_SLOTS > 4
+                                 MIOPEN_EPILOGUE_ARGS(4)
+#endif
+#if MIOPEN_EPILOGUE_SLOTS > 5
+                                 MIOPEN_EPILOGUE_ARGS(5)
+#endif
+#if MIOPEN_EPILOGUE_SLOTS > 6
+                                 MIOPEN_EPILOGUE_ARGS(6)
+#endif
+#if MIOPEN_EPILOGUE_SLOTS > 7
+                                 MIOPEN_EPILOGUE_ARGS(7)
+#endif
+                                 )
+{
+    const uint chw = hw * channels;
+#if MIOPEN_EPILOGUE_POOLING
+    const __global _FLOAT* src = in;
+#else
+    const __global _FLOAT* src = out;
+    (void)in_h;
+    (void)in_w;
+    (void)out_h;
+    (void)out_w;
+#endif
+    for(uint gid = get_global_id(0); gid < n_elems; gid += get_global_size(0))
+    {
+#if MIOPEN_EPILOGUE_POOLING
+        const uint nc      = gid / (out_h * out_w);
+        const uint channel = nc % channels;
+        const uint oh      = (gid / out_w) % out_h;
+        const uint ow      = gid % out_w;
+        const int top      = (int)oh * MIOPEN_POOLING_STRIDE_H - MIOPEN_POOLING_PAD_H;
+        const int left     = (int)ow * MIOPEN_POOLING_STRIDE_W - MIOPEN_POOLING_PAD_W;
+        const int hstart   = max(top, 0);
+        const int wstart   = max(left, 0);
+        const int hend     = min(top + MIOPEN_POOLING_KERNEL_H, (int)in_h);
+        const int wend     = min(left + MIOPEN_POOLING_KERNEL_W, (int)in_w);
+#if MIOPEN_EPILOGUE_POOLING == MIOPEN_POOLING_MAX
+        _FLOAT_PREC pooled = (_FLOAT_PREC)(-MAX_VAL);
+#else
+        _FLOAT_PREC pooled = (_FLOAT_PREC)0;
+#endif
+        for(int h = hstart; h < hend; ++h)
+        {
+            for(int w = wstart; w < wend; ++w)
+            {
+                const uint index = nc * hw + (uint)(h * (int)in_w + w);
+#else
+        const uint channel = (gid / hw) % channels;
+        {
+            {
+                const uint index = gid;
+#endif
+                _FLOAT_PREC value = (_FLOAT_PREC)src[index];
+#if MIOPEN_EPILOGUE_SLOTS > 0
+                MIOPEN_EPILOGUE_APPLY(0);
+#endif
+#if MIOPEN_EPILOGUE_SLOTS > 1
+                MIOPEN_EPILOGUE_APPLY(1);
+#endif
+#if MIOPEN_EPILOGUE_SLOTS > 2
+                MIOPEN_EPILOGUE_APPLY(2);
+#endif
+#if MIOPEN_EPILOGUE_SLOTS > 3
+                MIOPEN_EPILOGUE_APPLY(3);
+#endif
+#if MIOPEN_EPILOGUE_SLOTS > 4
+                MIOPEN_EPILOGUE_APPLY(4);
+#endif
+#if MIOPEN_EPILOGUE_SLOTS > 5
+                MIOPEN_EPILOGUE_APPLY(5);
+#endif
+#if MIOPEN_EPILOGUE_SLOTS > 6
+                MIOPEN_EPILOGUE_APPLY(6);
+#endif
+#if MIOPEN_EPILOGUE_SLOTS > 7
+                MIOPEN_EPILOGUE_APPLY(7);
+#endif
+#if MIOPEN_EPILOGUE_POOLING == MIOPEN_POOLING_MAX
+                pooled = max(pooled, value);
+#elif MIOPEN_EPILOGUE_POOLING
+                pooled += value;
+#else
+                out[gid] = (_FLOAT)value;
+#endif
+            }
+        }
+#if MIOPEN_EPILOGUE_POOLING == MIOPEN_POOLING_MAX
+        out[gid] = (_FLOAT)pooled;
+#elif MIOPEN_EPILOGUE_POOLING == MIOPEN_POOLING_AVERAGE
+        const int pool_size = max((hend - hstart) * (wend - wstart), 1);
+        out[gid]            = (_FLOAT)(pooled / (_FLOAT_PREC)pool_size);
+#elif MIOPEN_EPILOGUE_POOLING == MIOPEN_POOLING_AVERAGE_INCLUSIVE
+        const int pool_size = MIOPEN_POOLING_KERNEL_H * MIOPEN_POOLING_KERNEL_W;
+        out[gid]            = (_FLOAT)(pooled / (_FLOAT_PREC)pool_size);
+#endif
+    }
+}
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
@@ -107,6 +107,40 @@ uint xorwow_lite_next(prngStates* cur_state)
 
 float uniform_distribution(uint v) { return ROCRAND_2POW32_INV + (v * ROCRAND_2POW32_INV); }
 
+#define PHILOX_M4x32_0 0xD2511F53U
+#define PHILOX_M4x32_1 0xCD9E8D57U
+#define PHILOX_W32_0 0x9E3779B9U
+#define PHILOX_W32_1 0xBB67AE85U
+
+// Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3"), applied in
+// place to the 128-bit counter ctr with the 64-bit key (key0, key1)
+void philox4x32_10(uint* ctr, uint key0, uint key1)
+{
+    for(int r = 0; r < 10; r++)
+    {
+        const uint hi0 = mul_hi(PHILOX_M4x32_0, ctr[0]);
+        const uint lo0 = PHILOX_M4x32_0 * ctr[0];
+        const uint hi1 = mul_hi(PHILOX_M4x32_1, ctr[2]);
+        const uint lo1 = PHILOX_M4x32_1 * ctr[2];
+
+        ctr[0] = hi1 ^ ctr[1] ^ key0;
+        ctr[1] = lo1;
+        ctr[2] = hi0 ^ ctr[3] ^ key1;
+        ctr[3] = lo0;
+
+        key0 += PHILOX_W32_0;
+        key1 += PHILOX_W32_1;
+    }
+}
+
+// random word of element idx: stateless, so forward and backward can regenerate the same mask
+uint philox_element(uint idx, uint offset, uint seed_lo, uint seed_hi)
+{
+    uint ctr[4] = {idx / 4, offset, 0, 0};
+    philox4x32_10(ctr, seed_lo, seed_hi);
+    return ctr[idx % 4];
+}
+
 #if RUN_INIT_PRNG
 void copy_const_arr(uint* dst, constant uint* src, const int arr_size)
 {
@@ -302,17 +336,32 @@ __kernel void InitKernelState(__global prngStates* state)
 #define USE_PRNG 0
 #endif
 
+#ifndef USE_PHILOX
+#define USE_PHILOX 0
+#endif
+
+// mask holds one bit per element, bit (i % 8) of byte (i / 8); RD_BLCK is 1
+#ifndef USE_BITMASK
+#define USE_BITMASK 0
+#endif
+
+// mask is drawn in-kernel (forward without a saved mask, or backward without reservespace)
+#define DRAW_MASK ((RUN_FORWARD && !USE_MASK) || (!RUN_FORWARD && USE_PRNG))
+
+// bit-packed mask is stored by this kernel: a work-group gathers the bits of its 256
+// consecutive elements in local memory and writes them out as 32 whole bytes, so no two
+// work-items ever update the same byte
+#define PACK_MASK (USE_BITMASK && RUN_FORWARD && DRAW_MASK && USE_RSVSP)
+#define PACK_GROUP_SIZE 256
+
 __kernel void
 #if RUN_FORWARD
 DropoutForward(
-#if USE_MASK
-    UNUSED
-#endif
 #else
 DropoutBackward(
-#if !USE_PRNG
-    UNUSED
 #endif
+#if !DRAW_MASK || USE_PHILOX
+    UNUSED
 #endif
     const __global prngStates* state,
     const float dropout,
@@ -344,21 +393,42 @@ DropoutBackward(
     const uint total_work,
     const uint in_offset,
     const uint out_offset,
-#if(RUN_FORWARD && !USE_RSVSP && !USE_MASK) || (!RUN_FORWARD && USE_PRNG)
+#if((RUN_FORWARD && !USE_RSVSP && !USE_MASK) || (!RUN_FORWARD && USE_PRNG)) && !USE_PHILOX
+    UNUSED
+#endif
+    const uint rsvsp_offset,
+#if !DRAW_MASK || !USE_PHILOX
+    UNUSED
+#endif
+    const uint seed_lo,
+#if !DRAW_MASK || !USE_PHILOX
     UNUSED
 #endif
-    const uint rsvsp_offset)
+    const uint seed_hi)
 {
     _FLOAT dat_blk[RD_BLCK];
     uchar is_kept[RD_BLCK];
-#if(RUN_FORWARD && !USE_MASK) || (!RUN_FORWARD && USE_PRNG)
+#if DRAW_MASK && !USE_PHILOX
     uint sid = get_global_id(0);
     prngStates cur_state;
     cur_state = *((__global prngStates*)(state + sid));
 #endif
 
+#if PACK_MASK
+    local uchar group_kept[PACK_GROUP_SIZE];
+    const uint lid = get_local_id(0);
+
+    // all work-items of a group run the same iterations to meet at the barriers
+    for(uint gid = get_global_id(0); gid - lid < total_work; gid += get_global_size(0))
+#else
     for(uint gid = get_global_id(0); gid < total_work; gid += get_global_size(0))
+#endif
     {
+#if PACK_MASK
+        const bool in_range = gid < total_work;
+#else
+        const bool in_range = true;
+#endif
         uint i0    = gid / dim1 / dim2 / dim3 / dim4;
         uint i1    = (gid / dim2 / dim3 / dim4) % dim1;
         uint i2    = (gid / dim3 / dim4) % dim2;
@@ -370,22 +440,44 @@ DropoutBackward(
         uint y_idx =
             i0 * out_str0 + i1 * out_str1 + i2 * out_str2 + i3 * out_str3 + i4_rd * RD_BLCK;
 
-        *((READ_DAT_TYPE*)dat_blk) = *((const global READ_DAT_TYPE*)(
+        if(in_range)
+        {
+            *((READ_DAT_TYPE*)dat_blk) = *((const global READ_DAT_TYPE*)(
 #if RUN_FORWARD
-            x + in_offset + x_idx
+                x + in_offset + x_idx
 #else
-            y + out_offset + y_idx
+                y + out_offset + y_idx
 #endif
-            ));
-#if(RUN_FORWARD && !USE_MASK) || (!RUN_FORWARD && USE_PRNG)
+                ));
+        }
+#if DRAW_MASK
         for(int i = 0; i < RD_BLCK; ++i)
         {
-            is_kept[i] = (uchar)(uniform_distribution(xorwow_lite_next(&cur_state)) > dropout);
+#if USE_PHILOX
+            uint rnd =
+                philox_element(gid - i4 + i4_rd * RD_BLCK + i, rsvsp_offset, seed_lo, seed_hi);
+#else
+            uint rnd = xorwow_lite_next(&cur_state);
+#endif
+            is_kept[i] = (uchar)(uniform_distribution(rnd) > dropout);
         }
-#if RUN_FORWARD && USE_RSVSP
+#if PACK_MASK
+        group_kept[lid] = in_range ? is_kept[0] : 0;
+        barrier(CLK_LOCAL_MEM_FENCE);
+        if(lid < PACK_GROUP_SIZE / 8 && gid - lid + lid * 8 < total_work)
+        {
+            uchar bits = 0;
+            for(int b = 0; b < 8; ++b)
+                bits |= group_kept[lid * 8 + b] << b;
+            reserveSpace[rsvsp_offset + (gid - lid) / 8 + lid] = bits;
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+#elif RUN_FORWARD && USE_RSVSP
         *((global READ_BOOL_TYPE*)(reserveSpace + rsvsp_offset + gid - i4 + i4_rd * RD_BLCK)) =
             *((READ_BOOL_TYPE*)is_kept);
 #endif
+#elif USE_BITMASK
+        is_kept[0] = (reserveSpace[rsvsp_offset + gid / 8] >> (gid % 8)) & 1;
 #else
         *((READ_BOOL_TYPE*)is_kept) = *((const global READ_BOOL_TYPE*)(reserveSpace + rsvsp_offset +
                                                                        gid - i4 + i4_rd * RD_BLCK));
@@ -395,13 +487,16 @@ DropoutBackward(
             dat_blk[i] = (bool)(is_kept[i]) ? dat_blk[i] * (_FLOAT)scale : (_FLOAT)0;
         }
 
-        *((global READ_DAT_TYPE*)(
+        if(in_range)
+        {
+            *((global READ_DAT_TYPE*)(
 #if RUN_FORWARD
-            y + out_offset + y_idx
+                y + out_offset + y_idx
 #else
-            x + in_offset + x_idx
+                x + in_offset + x_idx
 #endif
-            )) = *((READ_DAT_TYPE*)dat_blk);
+                )) = *((READ_DAT_TYPE*)dat_blk);
+        }
     }
     (void)dropout;
 }
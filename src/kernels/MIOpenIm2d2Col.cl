@@ -118,8 +118,11 @@ kernel void Im2d2Col(const int data_size_off,
                      const int stride_w,
                      const int dilation_h,
                      const int dilation_w,
-                     global data_t* col)
+                     global data_t* col,
+                     const int col_offset)
 {
+    col += col_offset;
+
 #define THREADS_PER_CH (256 / NUM_CH_PER_WG)
 
 #if USE_IM_OFF_GUARD
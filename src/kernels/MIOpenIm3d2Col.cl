@@ -84,8 +84,11 @@ kernel void Im3d2Col(global data_t* const __restrict im,
                      const unsigned dilation_d_size,
                      const unsigned dilation_h_size,
                      const unsigned dilation_w_size,
-                     global data_t* __restrict col)
+                     global data_t* __restrict col,
+                     const unsigned col_offset)
 {
+    col += col_offset;
+
     unsigned col_size =
         out_d_size * out_h_size * out_w_size * wei_d_size * wei_h_size * wei_w_size * im_c_size;
 
@@ -0,0 +1,227 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef MIOPEN_USE_FP32
+#define MIOPEN_USE_FP32 0
+#endif
+
+#ifndef MIOPEN_USE_FP16
+#define MIOPEN_USE_FP16 0
+#endif
+
+#ifndef MIOPEN_USE_BFP16
+#define MIOPEN_USE_BFP16 0
+#endif
+
+#ifndef MIOPEN_USE_INT8
+#define MIOPEN_USE_INT8 0
+#endif
+
+#ifndef MIOPEN_USE_INT8x4
+#define MIOPEN_USE_INT8x4 0
+#endif
+
+#ifndef MIOPEN_USE_INT32
+#define MIOPEN_USE_INT32 0
+#endif
+
+#if MIOPEN_USE_INT8
+typedef char data_t;
+typedef char4 data4_t;
+#elif MIOPEN_USE_INT8x4
+typedef uint data_t;
+typedef uint4 data4_t;
+#elif MIOPEN_USE_INT32
+typedef int data_t;
+typedef int4 data4_t;
+#elif(MIOPEN_USE_FP16 || MIOPEN_USE_BFP16)
+// The values are only moved, so short does as well as half, see MIOpenIm3d2Col.cl.
+typedef short data_t;
+typedef short4 data4_t;
+#elif MIOPEN_USE_FP32
+typedef float data_t;
+typedef float4 data4_t;
+#endif
+
+kernel void Im3d2Col(global data_t* const __restrict im,
+                     const unsigned im_offset,
+                     const unsigned im_c_size,
+                     const unsigned im_d_size,
+                     const unsigned im_h_size,
+                     const unsigned im_w_size,
+                     const unsigned wei_d_size,
+                     const unsigned wei_h_size,
+                     const unsigned wei_w_size,
+
+// Im2col of 3d convolutions by tiles. A work-group takes one channel, I3C_TILE_D output
+// depths and an I3C_TILE_OH x I3C_TILE_OW block of output pixels. It stages the input brick
+// the block reads from one depth slice in LDS, then every filter tap of the slice writes its
+// column rows of the block from it, four consecutive pixels per work-item.
+//
+// With stride 1, no padding and no dilation in depth (I3C_DEPTH_SLIDE), the slice od + kd
+// serves all the (output depth, filter depth) pairs of the tile which sum to it, so each slice
+// is staged once per work-group instead of once per filter depth.
+//
+// I3C_IM_D/H/W        input sizes
+// I3C_WEI_D/H/W       filter sizes
+// I3C_OUT_D/H/W       output sizes
+// I3C_PAD_D/H/W       left paddings
+// I3C_STRIDE_D/H/W    strides
+// I3C_DILATION_D/H/W  dilations
+// I3C_TILE_D          output depths of a work-group, 1 unless I3C_DEPTH_SLIDE
+// I3C_TILE_OH/OW      output block of a work-group, I3C_TILE_OW is a multiple of 4
+// I3C_DEPTH_SLIDE     see above
+
+#define I3C_LOCAL_SIZE 256
+#define I3C_VEC 4
+
+#define I3C_BRICK_H ((I3C_TILE_OH - 1) * I3C_STRIDE_H + (I3C_WEI_H - 1) * I3C_DILATION_H + 1)
+#define I3C_BRICK_W ((I3C_TILE_OW - 1) * I3C_STRIDE_W + (I3C_WEI_W - 1) * I3C_DILATION_W + 1)
+
+#define I3C_OUT_HW (I3C_OUT_H * I3C_OUT_W)
+#define I3C_OUT_SIZE (I3C_OUT_D * I3C_OUT_HW)
+
+#define I3C_TILES_D ((I3C_OUT_D + I3C_TILE_D - 1) / I3C_TILE_D)
+#define I3C_TILES_H ((I3C_OUT_H + I3C_TILE_OH - 1) / I3C_TILE_OH)
+#define I3C_TILES_W ((I3C_OUT_W + I3C_TILE_OW - 1) / I3C_TILE_OW)
+
+// Writes of one slice: the filter taps in height and width by the block, I3C_VEC pixels each
+#define I3C_VECS_W (I3C_TILE_OW / I3C_VEC)
+#define I3C_SLICE_ITEMS (I3C_WEI_H * I3C_WEI_W * I3C_TILE_OH * I3C_VECS_W)
+
+static inline void LoadSlice(local data_t* brick,
+                             const global data_t* im_c,
+                             const int id,
+                             const int ih0,
+                             const int iw0,
+                             const int lid)
+{
+    for(int i = lid; i < I3C_BRICK_H * I3C_BRICK_W; i += I3C_LOCAL_SIZE)
+    {
+        const int ih = ih0 + i / I3C_BRICK_W;
+        const int iw = iw0 + i % I3C_BRICK_W;
+        const bool inside =
+            id >= 0 && id < I3C_IM_D && ih >= 0 && ih < I3C_IM_H && iw >= 0 && iw < I3C_IM_W;
+        brick[i] = inside ? im_c[((size_t)id * I3C_IM_H + ih) * I3C_IM_W + iw] : (data_t)0;
+    }
+}
+
+static inline void StoreSlice(const local data_t* brick,
+                              global data_t* col_c,
+                              const int kd,
+                              const int od,
+                              const int oh0,
+                              const int ow0,
+                              const int lid)
+{
+    global data_t* col_kd =
+        col_c + (size_t)kd * I3C_WEI_H * I3C_WEI_W * I3C_OUT_SIZE + (size_t)od * I3C_OUT_HW;
+
+    // Consecutive work-items write consecutive pixels of a column row.
+    for(int i = lid; i < I3C_SLICE_ITEMS; i += I3C_LOCAL_SIZE)
+    {
+        const int v   = i % I3C_VECS_W;
+        int tmp       = i / I3C_VECS_W;
+        const int y   = tmp % I3C_TILE_OH;
+        tmp           = tmp / I3C_TILE_OH;
+        const int kw  = tmp % I3C_WEI_W;
+        const int kh  = tmp / I3C_WEI_W;
+        const int oh  = oh0 + y;
+        const int ow  = ow0 + v * I3C_VEC;
+        if(oh >= I3C_OUT_H || ow >= I3C_OUT_W)
+            continue;
+
+        const local data_t* src = brick + (y * I3C_STRIDE_H + kh * I3C_DILATION_H) * I3C_BRICK_W +
+                                  v * I3C_VEC * I3C_STRIDE_W + kw * I3C_DILATION_W;
+        global data_t* dst = col_kd + (size_t)(kh * I3C_WEI_W + kw) * I3C_OUT_SIZE +
+                             oh * I3C_OUT_W + ow;
+
+        if(ow + I3C_VEC <= I3C_OUT_W)
+        {
+            vstore4((data4_t)(src[0],
+                              src[I3C_STRIDE_W],
+                              src[2 * I3C_STRIDE_W],
+                              src[3 * I3C_STRIDE_W]),
+                    0,
+                    dst);
+        }
+        else
+        {
+            for(int t = 0; ow + t < I3C_OUT_W; ++t)
+                dst[t] = src[t * I3C_STRIDE_W];
+        }
+    }
+}
+
+__attribute__((reqd_work_group_size(I3C_LOCAL_SIZE, 1, 1))) kernel void
+Im3d2ColTiled(const global data_t* __restrict im,
+              const unsigned im_offset,
+              global data_t* __restrict col,
+              const unsigned col_offset)
+{
+    local data_t brick[I3C_BRICK_H * I3C_BRICK_W];
+
+    const int lid = (int)get_local_id(0);
+    int group     = (int)get_group_id(0);
+    const int tw  = group % I3C_TILES_W;
+    group /= I3C_TILES_W;
+    const int th = group % I3C_TILES_H;
+    group /= I3C_TILES_H;
+    const int td = group % I3C_TILES_D;
+    const int ic = group / I3C_TILES_D;
+
+    const int oh0 = th * I3C_TILE_OH;
+    const int ow0 = tw * I3C_TILE_OW;
+    const int ih0 = oh0 * I3C_STRIDE_H - I3C_PAD_H;
+    const int iw0 = ow0 * I3C_STRIDE_W - I3C_PAD_W;
+
+    const global data_t* im_c = im + im_offset + (size_t)ic * I3C_IM_D * I3C_IM_H * I3C_IM_W;
+    global data_t* col_c =
+        col + col_offset + (size_t)ic * I3C_WEI_D * I3C_WEI_H * I3C_WEI_W * I3C_OUT_SIZE;
+
+#if I3C_DEPTH_SLIDE
+    const int od0 = td * I3C_TILE_D;
+    for(int s = 0; s < I3C_TILE_D + I3C_WEI_D - 1 && od0 + s < I3C_IM_D; ++s)
+    {
+        LoadSlice(brick, im_c, od0 + s, ih0, iw0, lid);
+        barrier(CLK_LOCAL_MEM_FENCE);
+        for(int kd = max(0, s - (I3C_TILE_D - 1)); kd <= min(s, I3C_WEI_D - 1); ++kd)
+        {
+            if(od0 + s - kd < I3C_OUT_D)
+                StoreSlice(brick, col_c, kd, od0 + s - kd, oh0, ow0, lid);
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+#else
+    for(int kd = 0; kd < I3C_WEI_D; ++kd)
+    {
+        LoadSlice(brick, im_c, td * I3C_STRIDE_D - I3C_PAD_D + kd * I3C_DILATION_D, ih0, iw0, lid);
+        barrier(CLK_LOCAL_MEM_FENCE);
+        StoreSlice(brick, col_c, kd, td, oh0, ow0, lid);
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+#endif
+}
@@ -469,3 +469,102 @@ MIOpenLRNAcrossChannelsBwd1(const __global _FLOAT* top,
         }
     }
 }
+
+/*
+
+Sliding-window, vectorized counterpart of MIOpenLRNAcrossChannelsBwd1.
+Each work-item owns MLO_READ_UNIT consecutive pixels of a flattened map and walks the
+channels once, keeping the running ratio sum and the MLO_LRN_KERNEL_SZ deep window of
+top_df / scale / ratio in registers; requires contiguous planes in every tensor.
+
+*/
+
+__attribute__((reqd_work_group_size(MLO_LRN_GROUP_SZ0, MLO_LRN_GROUP_SZ1, MLO_LRN_GROUP_SZ2)))
+__kernel void
+MIOpenLRNAcrossChannelsBwd4(const __global _FLOAT* top,
+                            const __global _FLOAT* bot,
+                            const __global _FLOAT* top_df,
+                            const __global _FLOAT* scale,
+                            __global _FLOAT* bot_df,
+                            _FLOAT ratio,
+                            UNUSED _FLOAT alpha,
+                            _FLOAT beta)
+{
+    int pix_id = get_global_id(0); // vector of pixels
+    int b      = get_global_id(2); // batch
+
+    if(pix_id >= MLO_MAP_SZ4)
+    {
+        return;
+    }
+
+    int pix = pix_id * MLO_READ_UNIT;
+
+    MLO_READ_TYPE accum_ratio = 0;
+    MLO_READ_TYPE top_df_in[MLO_LRN_KERNEL_SZ];
+    MLO_READ_TYPE scale_in[MLO_LRN_KERNEL_SZ];
+    MLO_READ_TYPE ratio_dta[MLO_LRN_KERNEL_SZ];
+
+    for(int i = 0; i < MLO_LRN_KERNEL_SZ; ++i)
+    {
+        top_df_in[i] = 0;
+        scale_in[i]  = 1;
+        ratio_dta[i] = 0;
+    }
+
+    // the window holds channels [c_i - MLO_LRN_KERNEL_SZ + 1, c_i]; the output channel
+    // c_o = c_i - MLO_LRN_PRE_PAD sits at MLO_LRN_PAD
+    for(int c_i = 0; c_i < MLO_LRN_N_INPUTS + MLO_LRN_PRE_PAD; ++c_i)
+    {
+        accum_ratio = accum_ratio - ratio_dta[0];
+
+        for(int i = 0; i < MLO_LRN_KERNEL_SZ - 1; ++i)
+        {
+            top_df_in[i] = top_df_in[i + 1];
+            scale_in[i]  = scale_in[i + 1];
+            ratio_dta[i] = ratio_dta[i + 1];
+        }
+
+        MLO_READ_TYPE prv_top_df_in = 0;
+        MLO_READ_TYPE prv_scale_in  = 1;
+        MLO_READ_TYPE prv_ratio_dta = 0;
+
+        if(c_i < MLO_LRN_N_OUTPUTS)
+        {
+            int top_df_off =
+                MLO_LRN_TOPDF_BATCH_STRIDE * b + MLO_LRN_TOPDF_CHANNEL_STRIDE * c_i + pix;
+            int scale_off =
+                MLO_LRN_SCALE_BATCH_STRIDE * b + MLO_LRN_SCALE_CHANNEL_STRIDE * c_i + pix;
+            int top_off = MLO_LRN_TOP_BATCH_STRIDE * b + MLO_LRN_TOP_CHANNEL_STRIDE * c_i + pix;
+
+            prv_top_df_in         = *(const __global MLO_READ_TYPE*)&top_df[top_df_off];
+            prv_scale_in          = *(const __global MLO_READ_TYPE*)&scale[scale_off];
+            MLO_READ_TYPE top_dta = *(const __global MLO_READ_TYPE*)&top[top_off];
+
+            prv_ratio_dta = (prv_top_df_in * top_dta) / prv_scale_in;
+        }
+
+        top_df_in[MLO_LRN_KERNEL_SZ - 1] = prv_top_df_in;
+        scale_in[MLO_LRN_KERNEL_SZ - 1]  = prv_scale_in;
+        ratio_dta[MLO_LRN_KERNEL_SZ - 1] = prv_ratio_dta;
+
+        accum_ratio = accum_ratio + prv_ratio_dta;
+
+        int c_o = c_i - MLO_LRN_PRE_PAD;
+        if(c_o >= 0)
+        {
+            int bot_off = MLO_LRN_BOT_BATCH_STRIDE * b + MLO_LRN_BOT_CHANNEL_STRIDE * c_o + pix;
+            int bot_df_off =
+                MLO_LRN_BOTDF_BATCH_STRIDE * b + MLO_LRN_BOTDF_CHANNEL_STRIDE * c_o + pix;
+
+            MLO_READ_TYPE bot_dta = *(const __global MLO_READ_TYPE*)&bot[bot_off];
+
+            MLO_READ_TYPE exp_scale = exp((MLO_READ_TYPE)-beta * log(scale_in[MLO_LRN_PAD]));
+
+            MLO_READ_TYPE out_val = top_df_in[MLO_LRN_PAD] * exp_scale -
+                                    (MLO_READ_TYPE)ratio * bot_dta * accum_ratio;
+
+            *((__global MLO_READ_TYPE*)&bot_df[bot_df_off]) = out_val;
+        }
+    }
+}
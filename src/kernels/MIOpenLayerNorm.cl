@@ -0,0 +1,257 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Layer normalization over the rows of a packed tensor: a row holds the LN_INNER elements of
+// the trailing normalized dimensions. All statistics are accumulated in _FLOAT_ACCUM (fp32),
+// also for half data. The types follow the batch normalization kernels: x and y are _FLOAT,
+// weight, bias, mean and rstd are _FLOAT_PREC (fp32 under MIOPEN_USE_FPMIX).
+//
+// LN_LOCAL          work-group size of the row kernels, a power of 2
+// LN_AFFINE         the rows are scaled by weight and shifted by bias
+// LN_SAVE_STATS     the forward kernel writes the mean and the inverse standard deviation
+// LN_COLS, LN_ROW_LANES  work-group of the weight gradient kernel, LN_COLS columns of
+//                   LN_ROW_LANES work-items each
+
+#ifdef __AMDGCN__
+#undef __AMDGCN__
+#endif
+
+#ifndef LN_LOCAL
+#define LN_LOCAL 256
+#endif
+
+// lds_reduce2 covers the whole work-group
+#define MIO_BN_LDS_SIZE LN_LOCAL
+
+#include "batchnorm_functions.h"
+#include "reduction_functions.h"
+
+#ifndef LN_AFFINE
+#define LN_AFFINE 1
+#endif
+
+#ifndef LN_SAVE_STATS
+#define LN_SAVE_STATS 1
+#endif
+
+#ifndef LN_COLS
+#define LN_COLS 64
+#endif
+
+#ifndef LN_ROW_LANES
+#define LN_ROW_LANES 4
+#endif
+
+// Chan et al. merge of the Welford states (count, mean, m2) of two disjoint sets into a.
+static inline void welford_merge(_FLOAT_ACCUM* count,
+                                 _FLOAT_ACCUM* mean,
+                                 _FLOAT_ACCUM* m2,
+                                 _FLOAT_ACCUM count_b,
+                                 _FLOAT_ACCUM mean_b,
+                                 _FLOAT_ACCUM m2_b)
+{
+    const _FLOAT_ACCUM n = *count + count_b;
+    if(n == (_FLOAT_ACCUM)0)
+        return;
+    const _FLOAT_ACCUM delta = mean_b - *mean;
+    *mean += delta * count_b / n;
+    *m2 += m2_b + delta * delta * *count * count_b / n;
+    *count = n;
+}
+
+// One work-group per row. Each work-item runs Welford over its strided part of the row, the
+// states are merged in LDS, and the same work-items then normalize their elements.
+__attribute__((reqd_work_group_size(LN_LOCAL, 1, 1))) __kernel void
+MIOpenLayerNormFwd(const __global _FLOAT* __restrict x,
+                   __global _FLOAT* __restrict y,
+                   const __global _FLOAT_PREC* __restrict weight,
+                   const __global _FLOAT_PREC* __restrict bias,
+                   __global _FLOAT_PREC* __restrict mean_out,
+                   __global _FLOAT_PREC* __restrict rstd_out,
+                   float epsilon,
+                   uint inner)
+{
+    local _FLOAT_ACCUM lcl_count[LN_LOCAL];
+    local _FLOAT_ACCUM lcl_mean[LN_LOCAL];
+    local _FLOAT_ACCUM lcl_m2[LN_LOCAL];
+
+    const uint lid   = get_local_id(0);
+    const size_t row = get_group_id(0);
+
+    const __global _FLOAT* x_row = x + row * inner;
+    __global _FLOAT* y_row       = y + row * inner;
+
+    _FLOAT_ACCUM count = (_FLOAT_ACCUM)0;
+    _FLOAT_ACCUM mean  = (_FLOAT_ACCUM)0;
+    _FLOAT_ACCUM m2    = (_FLOAT_ACCUM)0;
+    for(uint i = lid; i < inner; i += LN_LOCAL)
+    {
+        const _FLOAT_ACCUM v     = (_FLOAT_ACCUM)x_row[i];
+        const _FLOAT_ACCUM delta = v - mean;
+        count += (_FLOAT_ACCUM)1;
+        mean += delta / count;
+        m2 += delta * (v - mean);
+    }
+
+    lcl_count[lid] = count;
+    lcl_mean[lid]  = mean;
+    lcl_m2[lid]    = m2;
+    barrier(CLK_LOCAL_MEM_FENCE);
+    for(uint red = LN_LOCAL >> 1; red > 0; red >>= 1)
+    {
+        if(lid < red)
+        {
+            welford_merge(
+                &count, &mean, &m2, lcl_count[lid + red], lcl_mean[lid + red], lcl_m2[lid + red]);
+            lcl_count[lid] = count;
+            lcl_mean[lid]  = mean;
+            lcl_m2[lid]    = m2;
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+
+    mean                    = lcl_mean[0];
+    const _FLOAT_ACCUM rstd = rsqrt(lcl_m2[0] / (_FLOAT_ACCUM)inner + (_FLOAT_ACCUM)epsilon);
+
+#if LN_SAVE_STATS
+    if(lid == 0)
+        saved_stash(mean_out, rstd_out, mean, rstd, (uint)row);
+#endif
+
+    // The row was just read by the same work-items, so this pass is served by the cache.
+    for(uint i = lid; i < inner; i += LN_LOCAL)
+    {
+        _FLOAT_ACCUM v = ((_FLOAT_ACCUM)x_row[i] - mean) * rstd;
+#if LN_AFFINE
+        v = mad(v, (_FLOAT_ACCUM)weight[i], (_FLOAT_ACCUM)bias[i]);
+#endif
+        y_row[i] = (_FLOAT)v;
+    }
+}
+
+// One work-group per row. With g = dy * weight and xhat = (x - mean) * rstd,
+// dx = rstd * (g - mean(g) - xhat * mean(g * xhat)), both means taken in one LDS reduction.
+__attribute__((reqd_work_group_size(LN_LOCAL, 1, 1))) __kernel void
+MIOpenLayerNormBwd(const __global _FLOAT* __restrict x,
+                   const __global _FLOAT* __restrict dy,
+                   const __global _FLOAT_PREC* __restrict weight,
+                   const __global _FLOAT_PREC* __restrict mean_in,
+                   const __global _FLOAT_PREC* __restrict rstd_in,
+                   __global _FLOAT* __restrict dx,
+                   uint inner)
+{
+    local _FLOAT_ACCUM lcl_data_x[LN_LOCAL];
+    local _FLOAT_ACCUM lcl_data_y[LN_LOCAL];
+
+    const uint lid   = get_local_id(0);
+    const size_t row = get_group_id(0);
+
+    const __global _FLOAT* x_row  = x + row * inner;
+    const __global _FLOAT* dy_row = dy + row * inner;
+    __global _FLOAT* dx_row       = dx + row * inner;
+
+    const _FLOAT_ACCUM mean = (_FLOAT_ACCUM)mean_in[row];
+    const _FLOAT_ACCUM rstd = (_FLOAT_ACCUM)rstd_in[row];
+
+    _FLOAT_ACCUM sum_g      = (_FLOAT_ACCUM)0;
+    _FLOAT_ACCUM sum_g_xhat = (_FLOAT_ACCUM)0;
+    for(uint i = lid; i < inner; i += LN_LOCAL)
+    {
+        _FLOAT_ACCUM g = (_FLOAT_ACCUM)dy_row[i];
+#if LN_AFFINE
+        g *= (_FLOAT_ACCUM)weight[i];
+#endif
+        sum_g += g;
+        sum_g_xhat = mad(g, ((_FLOAT_ACCUM)x_row[i] - mean) * rstd, sum_g_xhat);
+    }
+    lds_reduce2(&sum_g,
+                &sum_g_xhat,
+                (_FLOAT_ACCUM)1 / (_FLOAT_ACCUM)inner,
+                lcl_data_x,
+                lcl_data_y,
+                lid);
+
+    for(uint i = lid; i < inner; i += LN_LOCAL)
+    {
+        _FLOAT_ACCUM g = (_FLOAT_ACCUM)dy_row[i];
+#if LN_AFFINE
+        g *= (_FLOAT_ACCUM)weight[i];
+#endif
+        const _FLOAT_ACCUM xhat = ((_FLOAT_ACCUM)x_row[i] - mean) * rstd;
+        dx_row[i]               = (_FLOAT)(rstd * (g - sum_g - xhat * sum_g_xhat));
+    }
+}
+
+// dweight = sum over the rows of dy * xhat, dbias = sum over the rows of dy. Each column is
+// summed by LN_ROW_LANES work-items taking every LN_ROW_LANES-th row, so the reads of a row
+// are coalesced, and their partial sums are added in LDS.
+__attribute__((reqd_work_group_size(LN_COLS * LN_ROW_LANES, 1, 1))) __kernel void
+MIOpenLayerNormBwdWeights(const __global _FLOAT* __restrict x,
+                          const __global _FLOAT* __restrict dy,
+                          const __global _FLOAT_PREC* __restrict mean_in,
+                          const __global _FLOAT_PREC* __restrict rstd_in,
+                          __global _FLOAT_PREC* __restrict dweight,
+                          __global _FLOAT_PREC* __restrict dbias,
+                          uint outer,
+                          uint inner)
+{
+    local _FLOAT_ACCUM lcl_dw[LN_COLS * LN_ROW_LANES];
+    local _FLOAT_ACCUM lcl_db[LN_COLS * LN_ROW_LANES];
+
+    const uint lid  = get_local_id(0);
+    const uint col  = get_group_id(0) * LN_COLS + lid % LN_COLS;
+    const uint lane = lid / LN_COLS;
+
+    _FLOAT_ACCUM dw = (_FLOAT_ACCUM)0;
+    _FLOAT_ACCUM db = (_FLOAT_ACCUM)0;
+    if(col < inner)
+    {
+        for(uint row = lane; row < outer; row += LN_ROW_LANES)
+        {
+            const size_t i          = (size_t)row * inner + col;
+            const _FLOAT_ACCUM g    = (_FLOAT_ACCUM)dy[i];
+            const _FLOAT_ACCUM xhat = ((_FLOAT_ACCUM)x[i] - (_FLOAT_ACCUM)mean_in[row]) *
+                                      (_FLOAT_ACCUM)rstd_in[row];
+            dw = mad(g, xhat, dw);
+            db += g;
+        }
+    }
+
+    lcl_dw[lid] = dw;
+    lcl_db[lid] = db;
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    if(lane == 0 && col < inner)
+    {
+        for(uint l = 1; l < LN_ROW_LANES; ++l)
+        {
+            dw += lcl_dw[lid + l * LN_COLS];
+            db += lcl_db[lid + l * LN_COLS];
+        }
+        dweight[col] = (_FLOAT_PREC)dw;
+        dbias[col]   = (_FLOAT_PREC)db;
+    }
+}
@@ -217,6 +217,114 @@ __kernel void MIOpenActiveBwd2DLite(__global _FLOAT* bot_diff,
         *((MIOPEN_READ_TYPE*)bot_diff_dat);
 }
 
+/**********************************************************************************************
+**********************************************************************************************/
+
+// Packed tensors of any length: every work-item strides over the tensor by the grid size, one
+// MIOPEN_READ_UNIT-wide vector at a time, and the elements past the last whole vector are done
+// one by one at the end.
+// local size = (256, 1, 1)
+// global size = (256 * min(ceil(TENS_LEN / MIOPEN_READ_UNIT / 256), MAX_GROUPS), 1, 1)
+
+__kernel void MIOpenActiveFwdPacked(const __global _FLOAT* bot,
+                                    __global _FLOAT* top,
+                                    _FLOAT gamma,
+                                    _FLOAT beta,
+                                    _FLOAT alpha,
+                                    const long bot_offset,
+                                    const long top_offset,
+                                    const long tens_len)
+{
+    const __global _FLOAT* p_bot = bot + bot_offset;
+    __global _FLOAT* p_top       = top + top_offset;
+
+    const long n_vec  = tens_len / MIOPEN_READ_UNIT;
+    const long stride = get_global_size(0);
+
+    _FLOAT data[MIOPEN_READ_UNIT];
+    _FLOAT response[MIOPEN_READ_UNIT];
+
+    for(long v = get_global_id(0); v < n_vec; v += stride)
+    {
+        *((MIOPEN_READ_TYPE*)data) = ((const __global MIOPEN_READ_TYPE*)p_bot)[v];
+
+        ActivationFunction(MIOPEN_READ_UNIT, response, (const _FLOAT*)data, gamma, beta, alpha);
+
+        ((__global MIOPEN_READ_TYPE*)p_top)[v] = *((MIOPEN_READ_TYPE*)response);
+    }
+
+    for(long i = n_vec * MIOPEN_READ_UNIT + get_global_id(0); i < tens_len; i += stride)
+    {
+        data[0] = p_bot[i];
+
+        ActivationFunction(1, response, (const _FLOAT*)data, gamma, beta, alpha);
+
+        p_top[i] = response[0];
+    }
+}
+
+/**********************************************************************************************
+**********************************************************************************************/
+
+__kernel void MIOpenActiveBwdPacked(__global _FLOAT* bot_diff,
+                                    __global const _FLOAT* top_diff,
+                                    __global const _FLOAT* bot,
+                                    __global const _FLOAT* top,
+                                    _FLOAT diff_scale,
+                                    _FLOAT gamma,
+                                    _FLOAT beta,
+                                    _FLOAT alpha,
+                                    const long bot_diff_offset,
+                                    const long top_diff_offset,
+                                    const long bot_offset,
+                                    const long top_offset,
+                                    const long tens_len)
+{
+    __global _FLOAT* p_bot_diff       = bot_diff + bot_diff_offset;
+    const __global _FLOAT* p_top_diff = top_diff + top_diff_offset;
+    const __global _FLOAT* p_bot      = bot + bot_offset;
+    const __global _FLOAT* p_top      = top + top_offset;
+
+    const long n_vec  = tens_len / MIOPEN_READ_UNIT;
+    const long stride = get_global_size(0);
+
+    _FLOAT bot_diff_dat[MIOPEN_READ_UNIT];
+    _FLOAT top_diff_dat[MIOPEN_READ_UNIT];
+    _FLOAT bot_dat[MIOPEN_READ_UNIT];
+    _FLOAT top_dat[MIOPEN_READ_UNIT];
+
+    for(long v = get_global_id(0); v < n_vec; v += stride)
+    {
+        *((MIOPEN_READ_TYPE*)top_diff_dat) = ((const __global MIOPEN_READ_TYPE*)p_top_diff)[v];
+        *((MIOPEN_READ_TYPE*)bot_dat)      = ((const __global MIOPEN_READ_TYPE*)p_bot)[v];
+        *((MIOPEN_READ_TYPE*)top_dat)      = ((const __global MIOPEN_READ_TYPE*)p_top)[v];
+
+        ActivationFunction_Diff(MIOPEN_READ_UNIT,
+                                bot_diff_dat,
+                                top_diff_dat,
+                                bot_dat,
+                                top_dat,
+                                diff_scale,
+                                gamma,
+                                beta,
+                                alpha);
+
+        ((__global MIOPEN_READ_TYPE*)p_bot_diff)[v] = *((MIOPEN_READ_TYPE*)bot_diff_dat);
+    }
+
+    for(long i = n_vec * MIOPEN_READ_UNIT + get_global_id(0); i < tens_len; i += stride)
+    {
+        top_diff_dat[0] = p_top_diff[i];
+        bot_dat[0]      = p_bot[i];
+        top_dat[0]      = p_top[i];
+
+        ActivationFunction_Diff(
+            1, bot_diff_dat, top_diff_dat, bot_dat, top_dat, diff_scale, gamma, beta, alpha);
+
+        p_bot_diff[i] = bot_diff_dat[0];
+    }
+}
+
 /**************************************************************************************************************/
 
 #else
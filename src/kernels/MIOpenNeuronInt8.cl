@@ -0,0 +1,82 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#define _FLOAT char
+#define _FLOAT_PREC float
+#define EPSILON (_FLOAT_PREC)0.000001
+
+#define UNUSED __attribute__((__unused__))
+
+#include "activation_functions.h"
+
+// Forward activation of int8 (and int8x4) tensors with the same number of elements.
+//
+// The activation is evaluated in fp32 on x as stored, so its parameters are given in the units
+// of x (e.g. the clipped ReLU ceiling is the real ceiling divided by the scale of x). The result
+// is requantized to y as round(scale * f(x)) saturated to [-128, 127], where scale is the ratio
+// of the x and y quantization scales.
+//
+// local size = (256, 1, 1)
+// global size = (256 * min(ceil(TENS_LEN / 4 / 256), MAX_GROUPS), 1, 1)
+
+__kernel void MIOpenActiveFwdInt8(const __global _FLOAT* bot,
+                                  __global _FLOAT* top,
+                                  float gamma,
+                                  float beta,
+                                  float alpha,
+                                  float scale,
+                                  const long bot_offset,
+                                  const long top_offset,
+                                  const long tens_len)
+{
+    const __global _FLOAT* p_bot = bot + bot_offset;
+    __global _FLOAT* p_top       = top + top_offset;
+
+    const long n_vec  = tens_len / 4;
+    const long stride = get_global_size(0);
+
+    float data[4];
+    float response[4];
+
+    for(long v = get_global_id(0); v < n_vec; v += stride)
+    {
+        // vload4/vstore4 need only byte alignment, so any offsets take this path
+        *((float4*)data) = convert_float4(vload4(v, p_bot));
+
+        ActivationFunction(4, response, (const float*)data, gamma, beta, alpha);
+
+        vstore4(convert_char4_sat_rte(scale * *((float4*)response)), v, p_top);
+    }
+
+    for(long i = n_vec * 4 + get_global_id(0); i < tens_len; i += stride)
+    {
+        data[0] = convert_float(p_bot[i]);
+
+        ActivationFunction(1, response, (const float*)data, gamma, beta, alpha);
+
+        p_top[i] = convert_char_sat_rte(scale * response[0]);
+    }
+}
@@ -81,7 +81,7 @@ mloPoolingG(const __global _FLOAT* bot,
     uint bot_off = b * mlo_bot_batch_str + o * mlo_bot_channel_str;
 
     _FLOAT bot_data[MLO_BOT_DATA_SZ1][MLO_BOT_DATA_SZ0];
-    _FLOAT res[MLO_POOLING_N_VERT_OUT_PIX][MLO_POOLING_N_HORIZ_OUT_PIX];
+    _FLOAT_PREC res[MLO_POOLING_N_VERT_OUT_PIX][MLO_POOLING_N_HORIZ_OUT_PIX];
 #if defined(MLO_POOLING_SAVE_INDEX) && MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX
     index_t mask_private[MLO_POOLING_N_VERT_OUT_PIX][MLO_POOLING_N_HORIZ_OUT_PIX];
 #endif
@@ -90,10 +90,10 @@ mloPoolingG(const __global _FLOAT* bot,
         for(int l = 0; l < MLO_POOLING_N_HORIZ_OUT_PIX; l++)
         {
 #if MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX
-            res[k][l] = (_FLOAT)(-MAX_VAL);
+            res[k][l] = (_FLOAT_PREC)(-MAX_VAL);
 #elif(MLO_POOLING_OP_ID == MLO_POOLING_OP_AVE) || \
     (MLO_POOLING_OP_ID == MLO_POOLING_OP_AVE_INCLUSIVE)
-            res[k][l] = (_FLOAT)(0);
+            res[k][l] = (_FLOAT_PREC)(0);
 #endif
         }
     }
@@ -159,8 +159,8 @@ mloPoolingG(const __global _FLOAT* bot,
                 for(uint i = 0; i < MLO_POOLING_KERNEL_SZ0; i++)
                 {
 
-                    _FLOAT bot_val =
-                        bot_data[j + k * MLO_POOLING_STRIDE1][i + l * MLO_POOLING_STRIDE0];
+                    _FLOAT_PREC bot_val = CVT_FLOAT2PREC(
+                        bot_data[j + k * MLO_POOLING_STRIDE1][i + l * MLO_POOLING_STRIDE0]);
 
 #if defined(MLO_POOLING_SAVE_INDEX) && MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX
                     if(bot_val > res[k][l])
@@ -181,7 +181,7 @@ mloPoolingG(const __global _FLOAT* bot,
             }
 
 #if(MLO_POOLING_OP_ID == MLO_POOLING_OP_AVE) || (MLO_POOLING_OP_ID == MLO_POOLING_OP_AVE_INCLUSIVE)
-            res[k][l] *= (_FLOAT)1.f / (_FLOAT)pool_size;
+            res[k][l] *= (_FLOAT_PREC)1.f / (_FLOAT_PREC)pool_size;
 #endif
         }
     }
@@ -195,7 +195,7 @@ mloPoolingG(const __global _FLOAT* bot,
         {
             if(top_y + k < mlo_top_height && top_x + l < mlo_top_width)
             {
-                top[top_off + k * mlo_top_str + l] = res[k][l];
+                top[top_off + k * mlo_top_str + l] = CVT_PREC2FLOAT(res[k][l]);
 #if defined(MLO_POOLING_SAVE_INDEX) && MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX
                 mask[top_off + k * mlo_top_str + l] = mask_private[k][l];
 #endif
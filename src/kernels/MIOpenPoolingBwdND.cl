@@ -144,6 +144,153 @@ mloPoolingNDMaxBwd(const __global _FLOAT* top_df,
     }
 }
 
+// Max pooling backward without a saved index: the position each top value came from is recomputed
+// as the first bottom value of its window that equals it, scanning in the same order as the
+// forward kernel, which only replaces its running max on a strictly greater value. bot and top
+// share the strides of bot_df and top_df.
+__attribute__((reqd_work_group_size(MLO_POOLING_GROUP_SZ0, 1, 1))) __kernel void
+mloPoolingNDMaxBwdRecompute(const __global _FLOAT* top_df,
+                            __global _FLOAT* bot_df,
+                            const __global _FLOAT* bot,
+                            const __global _FLOAT* top,
+                            const uint pad_d,
+                            const uint pad_h,
+                            const uint pad_w,
+                            const uint batch,
+                            const uint chal,
+                            const uint bot_d,
+                            const uint bot_h,
+                            const uint bot_w,
+                            const uint top_d,
+                            const uint top_h,
+                            const uint top_w,
+                            const uint bot_str_b,
+                            const uint bot_str_c,
+                            const uint bot_str_d,
+                            const uint bot_str_h,
+                            const uint top_str_b,
+                            const uint top_str_c,
+                            const uint top_str_d,
+                            const uint top_str_h,
+                            const uint total_work)
+{
+
+    int bot_blk_w = (bot_w + PIX_W_PER_WORK - 1) / PIX_W_PER_WORK;
+    int bot_blk_h = (bot_h + PIX_H_PER_WORK - 1) / PIX_H_PER_WORK;
+    int bot_blk_d = (bot_d + PIX_D_PER_WORK - 1) / PIX_D_PER_WORK;
+
+    bot_blk_w = max(bot_blk_w, 1);
+    bot_blk_h = max(bot_blk_h, 1);
+    bot_blk_d = max(bot_blk_d, 1);
+
+    for(uint gid = get_global_id(0); gid < total_work; gid += MAX_ACTIV_WORKITEM)
+    {
+        int b_id = gid / chal / bot_blk_w / bot_blk_h / bot_blk_d;
+        int c_id = (gid / bot_blk_w / bot_blk_h / bot_blk_d) % chal;
+
+        int bot_d_id = ((gid / bot_blk_w / bot_blk_h) % bot_blk_d) * PIX_D_PER_WORK;
+        int bot_h_id = ((gid / bot_blk_w) % bot_blk_h) * PIX_H_PER_WORK;
+        int bot_w_id = (gid % bot_blk_w) * PIX_W_PER_WORK;
+
+        int top_d_start =
+            bot_d_id + pad_d < KERNEL_SZ_D ? 0 : (bot_d_id + pad_d - KERNEL_SZ_D) / STRIDE_D + 1;
+        int top_h_start =
+            bot_h_id + pad_h < KERNEL_SZ_H ? 0 : (bot_h_id + pad_h - KERNEL_SZ_H) / STRIDE_H + 1;
+        int top_w_start =
+            bot_w_id + pad_w < KERNEL_SZ_W ? 0 : (bot_w_id + pad_w - KERNEL_SZ_W) / STRIDE_W + 1;
+
+        int top_d_end = (bot_d_id + PIX_D_PER_WORK - 1 + pad_d) / STRIDE_D + 1;
+        int top_h_end = (bot_h_id + PIX_H_PER_WORK - 1 + pad_h) / STRIDE_H + 1;
+        int top_w_end = (bot_w_id + PIX_W_PER_WORK - 1 + pad_w) / STRIDE_W + 1;
+
+        top_d_end = min(top_d_end, (int)top_d);
+        top_h_end = min(top_h_end, (int)top_h);
+        top_w_end = min(top_w_end, (int)top_w);
+
+        _FLOAT bot_data[PIX_D_PER_WORK][PIX_H_PER_WORK][PIX_W_PER_WORK] = {0};
+
+        uint bot_bc_off = b_id * bot_str_b + c_id * bot_str_c;
+
+        for(int h = top_d_start; h < top_d_end && b_id < batch; ++h)
+        {
+            for(int j = top_h_start; j < top_h_end; ++j)
+            {
+                for(int i = top_w_start; i < top_w_end; ++i)
+                {
+                    uint top_gbl_off =
+                        b_id * top_str_b + c_id * top_str_c + h * top_str_d + j * top_str_h + i;
+
+                    _FLOAT top_val = top_df[top_gbl_off];
+                    _FLOAT max_val = top[top_gbl_off];
+
+                    int mask_d_id = -1;
+                    int mask_h_id = -1;
+                    int mask_w_id = -1;
+
+                    for(int kd = 0; kd < KERNEL_SZ_D && mask_d_id < 0; ++kd)
+                    {
+                        int run_d = h * STRIDE_D + kd - (int)pad_d;
+                        if(run_d < 0 || run_d >= (int)bot_d)
+                            continue;
+                        for(int kh = 0; kh < KERNEL_SZ_H && mask_d_id < 0; ++kh)
+                        {
+                            int run_h = j * STRIDE_H + kh - (int)pad_h;
+                            if(run_h < 0 || run_h >= (int)bot_h)
+                                continue;
+                            for(int kw = 0; kw < KERNEL_SZ_W && mask_d_id < 0; ++kw)
+                            {
+                                int run_w = i * STRIDE_W + kw - (int)pad_w;
+                                if(run_w < 0 || run_w >= (int)bot_w)
+                                    continue;
+                                uint bot_gbl_off =
+                                    bot_bc_off + run_d * bot_str_d + run_h * bot_str_h + run_w;
+                                if(bot[bot_gbl_off] == max_val)
+                                {
+                                    mask_d_id = run_d;
+                                    mask_h_id = run_h;
+                                    mask_w_id = run_w;
+                                }
+                            }
+                        }
+                    }
+
+                    if(mask_d_id >= bot_d_id && mask_h_id >= bot_h_id && mask_w_id >= bot_w_id &&
+                       mask_d_id < bot_d_id + PIX_D_PER_WORK &&
+                       mask_h_id < bot_h_id + PIX_H_PER_WORK &&
+                       mask_w_id < bot_w_id + PIX_W_PER_WORK)
+                    {
+                        mask_d_id -= bot_d_id;
+                        mask_h_id -= bot_h_id;
+                        mask_w_id -= bot_w_id;
+
+                        bot_data[mask_d_id][mask_h_id][mask_w_id] += top_val;
+                    }
+                }
+            }
+        }
+
+        uint bot_off = bot_bc_off + bot_d_id * bot_str_d + bot_h_id * bot_str_h + bot_w_id;
+
+        for(uint m = 0; m < PIX_D_PER_WORK; m++)
+        {
+            for(uint k = 0; k < PIX_H_PER_WORK; k++)
+            {
+                for(uint l = 0; l < PIX_W_PER_WORK; l++)
+                {
+
+                    if(bot_d_id + m < bot_d && bot_h_id + k < bot_h && bot_w_id + l < bot_w &&
+                       b_id < batch)
+                    {
+                        uint bot_idx = bot_off + m * bot_str_d + k * bot_str_h + l;
+
+                        bot_df[bot_idx] = bot_data[m][k][l];
+                    }
+                }
+            }
+        }
+    }
+}
+
 __attribute__((reqd_work_group_size(MLO_POOLING_GROUP_SZ0, 1, 1))) __kernel void
 mloPoolingNDAveBwd(const __global _FLOAT* top_df,
                    __global _FLOAT* bot_df,
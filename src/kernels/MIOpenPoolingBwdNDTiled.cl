@@ -0,0 +1,279 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "pooling_functions.h"
+
+#ifndef MLO_POOLING_INDEX_MAX
+#error "MLO_POOLING_INDEX_MAX not defined"
+#endif
+
+// Pooling backward by bottom tiles. A work-group owns a PT_TILE_D x PT_TILE_H x PT_TILE_W block
+// of one (n, c) image. It first stages in LDS the top_df values of every window reaching the
+// block, together with the saved indices for max pooling and already divided by the window size
+// for average pooling, with consecutive work-items on consecutive top columns. Each work-item
+// then gathers its bottom pixels from LDS, also along columns, so both the reads of top_df and
+// mask and the writes of bot_df are coalesced.
+//
+// PT_TOP_D/H/W is the most top positions whose windows reach one block, whatever the padding.
+
+#define PT_TOP_D ((PT_TILE_D + KERNEL_SZ_D - 2) / STRIDE_D + 1)
+#define PT_TOP_H ((PT_TILE_H + KERNEL_SZ_H - 2) / STRIDE_H + 1)
+#define PT_TOP_W ((PT_TILE_W + KERNEL_SZ_W - 2) / STRIDE_W + 1)
+
+#define PT_TOP_SZ (PT_TOP_D * PT_TOP_H * PT_TOP_W)
+#define PT_TILE_SZ (PT_TILE_D * PT_TILE_H * PT_TILE_W)
+
+// first top position whose window reaches bottom position b
+static inline int TopStart(int b, int pad, int ksz, int stride)
+{
+    return b + pad < ksz ? 0 : (b + pad - ksz) / stride + 1;
+}
+
+// one past the last top position whose window reaches bottom position b
+static inline int TopEnd(int b, int pad, int stride, int top_len)
+{
+    return min((b + pad) / stride + 1, top_len);
+}
+
+static inline void PoolingNDBwdTiled(const __global _FLOAT* top_df,
+                                     __global _FLOAT* bot_df,
+                                     const __global index_t* mask,
+                                     __local _FLOAT* lcl_top,
+                                     __local index_t* lcl_mask,
+                                     const int pad_d,
+                                     const int pad_h,
+                                     const int pad_w,
+                                     const uint chal,
+                                     const int bot_d,
+                                     const int bot_h,
+                                     const int bot_w,
+                                     const int top_d,
+                                     const int top_h,
+                                     const int top_w,
+                                     const uint bot_str_b,
+                                     const uint bot_str_c,
+                                     const uint bot_str_d,
+                                     const uint bot_str_h,
+                                     const uint top_str_b,
+                                     const uint top_str_c,
+                                     const uint top_str_d,
+                                     const uint top_str_h)
+{
+    const int lid   = get_local_id(0);
+    const int blk_w = (bot_w + PT_TILE_W - 1) / PT_TILE_W;
+    const int blk_h = (bot_h + PT_TILE_H - 1) / PT_TILE_H;
+
+    const int tile   = get_group_id(0);
+    const int bot_w0 = (tile % blk_w) * PT_TILE_W;
+    const int bot_h0 = ((tile / blk_w) % blk_h) * PT_TILE_H;
+    const int bot_d0 = (tile / blk_w / blk_h) * PT_TILE_D;
+
+    const uint b_id = get_group_id(1) / chal;
+    const uint c_id = get_group_id(1) % chal;
+
+    const int top_d0 = TopStart(bot_d0, pad_d, KERNEL_SZ_D, STRIDE_D);
+    const int top_h0 = TopStart(bot_h0, pad_h, KERNEL_SZ_H, STRIDE_H);
+    const int top_w0 = TopStart(bot_w0, pad_w, KERNEL_SZ_W, STRIDE_W);
+
+    const uint top_bc_off = b_id * top_str_b + c_id * top_str_c;
+
+    for(int i = lid; i < PT_TOP_SZ; i += MLO_POOLING_GROUP_SZ0)
+    {
+        const int td = top_d0 + i / (PT_TOP_H * PT_TOP_W);
+        const int th = top_h0 + (i / PT_TOP_W) % PT_TOP_H;
+        const int tw = top_w0 + i % PT_TOP_W;
+
+        _FLOAT top_val = 0;
+        if(td < top_d && th < top_h && tw < top_w)
+        {
+            const uint top_gbl_off = top_bc_off + td * top_str_d + th * top_str_h + tw;
+            top_val                = top_df[top_gbl_off];
+#if MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX
+            lcl_mask[i] = mask[top_gbl_off];
+#else
+#if MLO_POOLING_OP_ID == MLO_POOLING_OP_AVE_INCLUSIVE
+            uint pool_size = KERNEL_SZ_W * KERNEL_SZ_H * KERNEL_SZ_D;
+#else
+            const int dstart = max(td * STRIDE_D - pad_d, 0);
+            const int hstart = max(th * STRIDE_H - pad_h, 0);
+            const int wstart = max(tw * STRIDE_W - pad_w, 0);
+            const int dend   = min(td * STRIDE_D - pad_d + KERNEL_SZ_D, bot_d);
+            const int hend   = min(th * STRIDE_H - pad_h + KERNEL_SZ_H, bot_h);
+            const int wend   = min(tw * STRIDE_W - pad_w + KERNEL_SZ_W, bot_w);
+            uint pool_size   = (dend - dstart) * (hend - hstart) * (wend - wstart);
+#endif
+            pool_size = (pool_size == 0) ? 1 : pool_size;
+            top_val /= (_FLOAT)pool_size;
+#endif
+        }
+        lcl_top[i] = top_val;
+    }
+
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    const uint bot_bc_off = b_id * bot_str_b + c_id * bot_str_c;
+
+    for(int p = lid; p < PT_TILE_SZ; p += MLO_POOLING_GROUP_SZ0)
+    {
+        const int bd = bot_d0 + p / (PT_TILE_H * PT_TILE_W);
+        const int bh = bot_h0 + (p / PT_TILE_W) % PT_TILE_H;
+        const int bw = bot_w0 + p % PT_TILE_W;
+        if(bd >= bot_d || bh >= bot_h || bw >= bot_w)
+            continue;
+
+#if MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX
+        const uint bot_img_idx = (bd * bot_h + bh) * bot_w + bw;
+#endif
+        const int td_end = TopEnd(bd, pad_d, STRIDE_D, top_d);
+        const int th_end = TopEnd(bh, pad_h, STRIDE_H, top_h);
+        const int tw_end = TopEnd(bw, pad_w, STRIDE_W, top_w);
+
+        _FLOAT bot_val = 0;
+        for(int td = TopStart(bd, pad_d, KERNEL_SZ_D, STRIDE_D); td < td_end; ++td)
+        {
+            for(int th = TopStart(bh, pad_h, KERNEL_SZ_H, STRIDE_H); th < th_end; ++th)
+            {
+                for(int tw = TopStart(bw, pad_w, KERNEL_SZ_W, STRIDE_W); tw < tw_end; ++tw)
+                {
+                    const int l =
+                        ((td - top_d0) * PT_TOP_H + th - top_h0) * PT_TOP_W + tw - top_w0;
+#if MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX
+                    if(lcl_mask[l] == bot_img_idx)
+                        bot_val += lcl_top[l];
+#else
+                    bot_val += lcl_top[l];
+#endif
+                }
+            }
+        }
+
+        bot_df[bot_bc_off + bd * bot_str_d + bh * bot_str_h + bw] = bot_val;
+    }
+}
+
+__attribute__((reqd_work_group_size(MLO_POOLING_GROUP_SZ0, 1, 1))) __kernel void
+mloPoolingNDMaxBwdTiled(const __global _FLOAT* top_df,
+                        __global _FLOAT* bot_df,
+                        __global index_t* mask,
+                        const uint pad_d,
+                        const uint pad_h,
+                        const uint pad_w,
+                        UNUSED const uint batch,
+                        const uint chal,
+                        const uint bot_d,
+                        const uint bot_h,
+                        const uint bot_w,
+                        const uint top_d,
+                        const uint top_h,
+                        const uint top_w,
+                        const uint bot_str_b,
+                        const uint bot_str_c,
+                        const uint bot_str_d,
+                        const uint bot_str_h,
+                        const uint top_str_b,
+                        const uint top_str_c,
+                        const uint top_str_d,
+                        const uint top_str_h,
+                        UNUSED const uint total_work)
+{
+    __local _FLOAT lcl_top[PT_TOP_SZ];
+    __local index_t lcl_mask[PT_TOP_SZ];
+
+    PoolingNDBwdTiled(top_df,
+                      bot_df,
+                      mask,
+                      lcl_top,
+                      lcl_mask,
+                      pad_d,
+                      pad_h,
+                      pad_w,
+                      chal,
+                      bot_d,
+                      bot_h,
+                      bot_w,
+                      top_d,
+                      top_h,
+                      top_w,
+                      bot_str_b,
+                      bot_str_c,
+                      bot_str_d,
+                      bot_str_h,
+                      top_str_b,
+                      top_str_c,
+                      top_str_d,
+                      top_str_h);
+}
+
+__attribute__((reqd_work_group_size(MLO_POOLING_GROUP_SZ0, 1, 1))) __kernel void
+mloPoolingNDAveBwdTiled(const __global _FLOAT* top_df,
+                        __global _FLOAT* bot_df,
+                        const uint pad_d,
+                        const uint pad_h,
+                        const uint pad_w,
+                        UNUSED const uint batch,
+                        const uint chal,
+                        const uint bot_d,
+                        const uint bot_h,
+                        const uint bot_w,
+                        const uint top_d,
+                        const uint top_h,
+                        const uint top_w,
+                        const uint bot_str_b,
+                        const uint bot_str_c,
+                        const uint bot_str_d,
+                        const uint bot_str_h,
+                        const uint top_str_b,
+                        const uint top_str_c,
+                        const uint top_str_d,
+                        const uint top_str_h,
+                        UNUSED const uint total_work)
+{
+    __local _FLOAT lcl_top[PT_TOP_SZ];
+
+    PoolingNDBwdTiled(top_df,
+                      bot_df,
+                      0,
+                      lcl_top,
+                      0,
+                      pad_d,
+                      pad_h,
+                      pad_w,
+                      chal,
+                      bot_d,
+                      bot_h,
+                      bot_w,
+                      top_d,
+                      top_h,
+                      top_w,
+                      bot_str_b,
+                      bot_str_c,
+                      bot_str_d,
+                      bot_str_h,
+                      top_str_b,
+                      top_str_c,
+                      top_str_d,
+                      top_str_h);
+}
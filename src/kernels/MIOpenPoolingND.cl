@@ -154,9 +154,9 @@ mloPoolingNDFwd(const __global _FLOAT* bot,
                     pool_size = (pool_size == 0) ? 1 : pool_size;
 #endif
 
-                    _FLOAT top_val =
+                    _FLOAT_PREC top_val =
 #if MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX
-                        (_FLOAT)(-MAX_VAL)
+                        (_FLOAT_PREC)(-MAX_VAL)
 #elif(MLO_POOLING_OP_ID == MLO_POOLING_OP_AVE) || \
     (MLO_POOLING_OP_ID == MLO_POOLING_OP_AVE_INCLUSIVE)
                         0
@@ -174,8 +174,8 @@ mloPoolingNDFwd(const __global _FLOAT* bot,
                             for(uint i = 0; i < KERNEL_SZ_W; i++)
                             {
 
-                                _FLOAT bot_val =
-                                    bot_data[h + m * STRIDE_D][j + k * STRIDE_H][i + l * STRIDE_W];
+                                _FLOAT_PREC bot_val = CVT_FLOAT2PREC(
+                                    bot_data[h + m * STRIDE_D][j + k * STRIDE_H][i + l * STRIDE_W]);
 
 #if defined(MLO_POOLING_SAVE_INDEX) && MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX
                                 if(bot_val > top_val)
@@ -199,7 +199,7 @@ mloPoolingNDFwd(const __global _FLOAT* bot,
                     }
 
 #if(MLO_POOLING_OP_ID == MLO_POOLING_OP_AVE) || (MLO_POOLING_OP_ID == MLO_POOLING_OP_AVE_INCLUSIVE)
-                    top_val *= ((_FLOAT)1.f / (_FLOAT)pool_size);
+                    top_val *= ((_FLOAT_PREC)1.f / (_FLOAT_PREC)pool_size);
 #endif
 
                     if(top_d_id + m < top_d && top_h_id + k < top_h && top_w_id + l < top_w &&
@@ -209,7 +209,7 @@ mloPoolingNDFwd(const __global _FLOAT* bot,
                                        (top_d_id + m) * top_str_d + (top_h_id + k) * top_str_h +
                                        top_w_id + l;
 
-                        top[top_idx] = top_val;
+                        top[top_idx] = CVT_PREC2FLOAT(top_val);
 #if defined(MLO_POOLING_SAVE_INDEX) && MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX
                         mask[top_idx] = mask_idx;
 #endif
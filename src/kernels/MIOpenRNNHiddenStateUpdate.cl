@@ -24,34 +24,12 @@
  *
  *******************************************************************************/
 
-#ifndef MIOPEN_USE_FP16
-#define MIOPEN_USE_FP16 0
-#endif
-#ifndef MIOPEN_USE_FP32
-#define MIOPEN_USE_FP32 0
-#endif
-
-#if MIOPEN_USE_FP16 == 1
-#pragma OPENCL EXTENSION cl_khr_fp16 : enable
-#define _FLOAT half
-#define EPSILON (_FLOAT)0.0001
-#ifndef HALF_MAX
-#define MAX_VAL 65504 /* max value */
-#else
-#define MAX_VAL HALF_MAX
-#endif
-#endif
-#if MIOPEN_USE_FP32 == 1
-#define _FLOAT float
-#define EPSILON (_FLOAT)0.000001
-#ifndef FLT_MAX
-#define MAX_VAL 3.402823466e+38F /* max value */
-#else
-#define MAX_VAL FLT_MAX
-#endif
-#endif
+#include "float_types.h"
 
-#define _FLOAT_PREC _FLOAT
+// The gates and the cell state are computed in float also for the 16-bit types, only the values
+// kept in the workspace and the reserve space are rounded to the storage type.
+#define _FLOAT_PREC _FLOAT_ACCUM
+#define EPSILON (_FLOAT_PREC)0.000001
 #define UNUSED __attribute__((__unused__))
 
 #include "activation_functions.h"
@@ -62,6 +40,33 @@
 #ifndef LSTM_BWD_HID
 #define LSTM_BWD_HID 0
 #endif
+#ifndef GRU_FWD_HID
+#define GRU_FWD_HID 0
+#endif
+#ifndef GRU_BWD_HID
+#define GRU_BWD_HID 0
+#endif
+
+// Moves RD_BLCK consecutive values between the buffers and the registers of the kernels.
+void LoadBlock(_FLOAT_PREC* dst, const global _FLOAT* src)
+{
+    _FLOAT dat[RD_BLCK];
+    *((READ_TYPE*)dat) = *((const global READ_TYPE*)src);
+    for(int i = 0; i < RD_BLCK; ++i)
+    {
+        dst[i] = CVT_FLOAT2ACCUM(dat[i]);
+    }
+}
+
+void StoreBlock(global _FLOAT* dst, const _FLOAT_PREC* src)
+{
+    _FLOAT dat[RD_BLCK];
+    for(int i = 0; i < RD_BLCK; ++i)
+    {
+        dat[i] = CVT_ACCUM2FLOAT(src[i]);
+    }
+    *((global READ_TYPE*)dst) = *((READ_TYPE*)dat);
+}
 
 #if LSTM_FWD_HID
 #ifndef INFERENCE_MODE
@@ -84,24 +89,33 @@ __kernel void LSTMFwdHidUpdate(const global _FLOAT* cx,
 #endif
                                const long activ_cell_offset,
                                const long hidden_offset,
+                               const global _FLOAT* w,
+                               const long bias_offset,
+                               const long hidden_bias_offset,
+                               const char use_bias,
+                               const char use_hx,
                                const char use_cx,
                                const char is_seq_begin,
                                const int direction,
                                const int cur_batch,
                                const int use_batch)
 {
-    int total_item     = cur_batch * hy_h / RD_BLCK;
-    total_item         = max(total_item, 1);
-    _FLOAT activ_param = 1;
+    int total_item          = cur_batch * hy_h / RD_BLCK;
+    total_item              = max(total_item, 1);
+    _FLOAT_PREC activ_param = 1;
 
-    _FLOAT s_dat[RD_BLCK];
+    _FLOAT_PREC s_dat[RD_BLCK];
 
-    _FLOAT i_dat[RD_BLCK];
-    _FLOAT f_dat[RD_BLCK];
-    _FLOAT o_dat[RD_BLCK];
-    _FLOAT c_dat[RD_BLCK];
+    _FLOAT_PREC i_dat[RD_BLCK];
+    _FLOAT_PREC f_dat[RD_BLCK];
+    _FLOAT_PREC o_dat[RD_BLCK];
+    _FLOAT_PREC c_dat[RD_BLCK];
 
-    _FLOAT cx_dat[RD_BLCK];
+    _FLOAT_PREC cx_dat[RD_BLCK];
+
+    // Biases of the gates i, f, o, c (in this order), the hidden ones right after the input
+    // ones.
+    _FLOAT_PREC b_dat[4][RD_BLCK];
 
     for(int gid = get_global_id(0); gid < total_item; gid += get_global_size(0))
     {
@@ -109,34 +123,72 @@ __kernel void LSTMFwdHidUpdate(const global _FLOAT* cx,
         int h_idx   = gid * RD_BLCK - b_idx * hy_h;
         int rsv_idx = b_idx * hy_stride + h_idx;
 
-        *((READ_TYPE*)s_dat) = *((const global READ_TYPE*)(reservespace + i_offset + rsv_idx));
+        // The hidden bias goes with the product of the previous hidden state, and thus is not
+        // applied at the beginning of a sequence without hx.
+        const bool use_hidden_bias = (bool)use_hx || (!(bool)is_seq_begin && b_idx < use_batch);
+        for(int g = 0; g < 4; ++g)
+        {
+            for(int i = 0; i < RD_BLCK; ++i)
+            {
+                b_dat[g][i] = (_FLOAT_PREC)0;
+            }
+            if((bool)use_bias)
+            {
+                LoadBlock(b_dat[g], w + bias_offset + g * hy_h + h_idx);
+                if(use_hidden_bias)
+                {
+                    LoadBlock(s_dat, w + hidden_bias_offset + g * hy_h + h_idx);
+                    for(int i = 0; i < RD_BLCK; ++i)
+                    {
+                        b_dat[g][i] += s_dat[i];
+                    }
+                }
+            }
+        }
+
+        LoadBlock(s_dat, reservespace + i_offset + rsv_idx);
+        for(int i = 0; i < RD_BLCK; ++i)
+        {
+            s_dat[i] += b_dat[0][i];
+        }
         ActivationFunction_Sigmoid(
-            RD_BLCK, i_dat, (const _FLOAT*)s_dat, activ_param, activ_param, activ_param);
+            RD_BLCK, i_dat, (const _FLOAT_PREC*)s_dat, activ_param, activ_param, activ_param);
 
-        *((READ_TYPE*)s_dat) = *((const global READ_TYPE*)(reservespace + f_offset + rsv_idx));
+        LoadBlock(s_dat, reservespace + f_offset + rsv_idx);
+        for(int i = 0; i < RD_BLCK; ++i)
+        {
+            s_dat[i] += b_dat[1][i];
+        }
         ActivationFunction_Sigmoid(
-            RD_BLCK, f_dat, (const _FLOAT*)s_dat, activ_param, activ_param, activ_param);
+            RD_BLCK, f_dat, (const _FLOAT_PREC*)s_dat, activ_param, activ_param, activ_param);
 
-        *((READ_TYPE*)s_dat) = *((const global READ_TYPE*)(reservespace + o_offset + rsv_idx));
+        LoadBlock(s_dat, reservespace + o_offset + rsv_idx);
+        for(int i = 0; i < RD_BLCK; ++i)
+        {
+            s_dat[i] += b_dat[2][i];
+        }
         ActivationFunction_Sigmoid(
-            RD_BLCK, o_dat, (const _FLOAT*)s_dat, activ_param, activ_param, activ_param);
+            RD_BLCK, o_dat, (const _FLOAT_PREC*)s_dat, activ_param, activ_param, activ_param);
 
-        *((READ_TYPE*)s_dat) = *((const global READ_TYPE*)(reservespace + c_offset + rsv_idx));
+        LoadBlock(s_dat, reservespace + c_offset + rsv_idx);
+        for(int i = 0; i < RD_BLCK; ++i)
+        {
+            s_dat[i] += b_dat[3][i];
+        }
         ActivationFunction_TanH(
-            RD_BLCK, c_dat, (const _FLOAT*)s_dat, activ_param, activ_param, activ_param);
+            RD_BLCK, c_dat, (const _FLOAT_PREC*)s_dat, activ_param, activ_param, activ_param);
 
         if((bool)is_seq_begin)
         {
             if((bool)use_cx)
             {
-                *((READ_TYPE*)cx_dat) =
-                    *((const global READ_TYPE*)(cx + cx_offset + gid * RD_BLCK));
+                LoadBlock(cx_dat, cx + cx_offset + gid * RD_BLCK);
             }
             else
             {
                 for(int i = 0; i < RD_BLCK; ++i)
                 {
-                    cx_dat[i] = (_FLOAT)0;
+                    cx_dat[i] = (_FLOAT_PREC)0;
                 }
             }
         }
@@ -144,21 +196,19 @@ __kernel void LSTMFwdHidUpdate(const global _FLOAT* cx,
         {
             if(b_idx < use_batch)
             {
-                *((READ_TYPE*)cx_dat) =
-                    *((const global READ_TYPE*)(reservespace + cell_offset_pre + rsv_idx));
+                LoadBlock(cx_dat, reservespace + cell_offset_pre + rsv_idx);
             }
             else
             {
                 if(direction == 1 && (bool)use_cx)
                 {
-                    *((READ_TYPE*)cx_dat) =
-                        *((const global READ_TYPE*)(cx + cx_offset + gid * RD_BLCK));
+                    LoadBlock(cx_dat, cx + cx_offset + gid * RD_BLCK);
                 }
                 else
                 {
                     for(int i = 0; i < RD_BLCK; ++i)
                     {
-                        cx_dat[i] = (_FLOAT)0;
+                        cx_dat[i] = (_FLOAT_PREC)0;
                     }
                 }
             }
@@ -170,22 +220,21 @@ __kernel void LSTMFwdHidUpdate(const global _FLOAT* cx,
         }
         ActivationFunction_TanH(RD_BLCK, cx_dat, s_dat, activ_param, activ_param, activ_param);
 
-        *((global READ_TYPE*)(reservespace + i_offset + rsv_idx)) = *((READ_TYPE*)i_dat);
-        *((global READ_TYPE*)(reservespace + f_offset + rsv_idx)) = *((READ_TYPE*)f_dat);
-        *((global READ_TYPE*)(reservespace + o_offset + rsv_idx)) = *((READ_TYPE*)o_dat);
-        *((global READ_TYPE*)(reservespace + c_offset + rsv_idx)) = *((READ_TYPE*)c_dat);
+        StoreBlock(reservespace + i_offset + rsv_idx, i_dat);
+        StoreBlock(reservespace + f_offset + rsv_idx, f_dat);
+        StoreBlock(reservespace + o_offset + rsv_idx, o_dat);
+        StoreBlock(reservespace + c_offset + rsv_idx, c_dat);
 
-        *((global READ_TYPE*)(reservespace + cell_offset + rsv_idx)) = *((READ_TYPE*)s_dat);
+        StoreBlock(reservespace + cell_offset + rsv_idx, s_dat);
 #if !INFERENCE_MODE
-        *((global READ_TYPE*)(reservespace + activ_cell_offset + b_idx * hy_stride / 6 + h_idx)) =
-            *((READ_TYPE*)cx_dat);
+        StoreBlock(reservespace + activ_cell_offset + b_idx * hy_stride / 6 + h_idx, cx_dat);
 #endif
         for(int i = 0; i < RD_BLCK; ++i)
         {
             s_dat[i] = o_dat[i] * cx_dat[i];
         }
 
-        *((global READ_TYPE*)(reservespace + hidden_offset + rsv_idx)) = *((READ_TYPE*)s_dat);
+        StoreBlock(reservespace + hidden_offset + rsv_idx, s_dat);
     }
 }
 #endif
@@ -222,26 +271,26 @@ __kernel void LSTMBwdHidUpdate(const global _FLOAT* cx,
                                const int use_batch,
                                const int use_batch2)
 {
-    int total_item     = cur_batch * hy_h / RD_BLCK;
-    total_item         = max(total_item, 1);
-    _FLOAT activ_param = 1;
+    int total_item          = cur_batch * hy_h / RD_BLCK;
+    total_item              = max(total_item, 1);
+    _FLOAT_PREC activ_param = 1;
 
-    _FLOAT dh_dat[RD_BLCK];
+    _FLOAT_PREC dh_dat[RD_BLCK];
 
-    _FLOAT s_dat[RD_BLCK];
+    _FLOAT_PREC s_dat[RD_BLCK];
 
-    _FLOAT i_dat[RD_BLCK];
-    _FLOAT f_dat[RD_BLCK];
-    _FLOAT o_dat[RD_BLCK];
-    _FLOAT c_dat[RD_BLCK];
+    _FLOAT_PREC i_dat[RD_BLCK];
+    _FLOAT_PREC f_dat[RD_BLCK];
+    _FLOAT_PREC o_dat[RD_BLCK];
+    _FLOAT_PREC c_dat[RD_BLCK];
 
-    _FLOAT di_dat[RD_BLCK];
-    _FLOAT df_dat[RD_BLCK];
-    _FLOAT do_dat[RD_BLCK];
-    _FLOAT dc_dat[RD_BLCK];
+    _FLOAT_PREC di_dat[RD_BLCK];
+    _FLOAT_PREC df_dat[RD_BLCK];
+    _FLOAT_PREC do_dat[RD_BLCK];
+    _FLOAT_PREC dc_dat[RD_BLCK];
 
-    _FLOAT cx_dat[RD_BLCK];
-    _FLOAT dcx_dat[RD_BLCK];
+    _FLOAT_PREC cx_dat[RD_BLCK];
+    _FLOAT_PREC dcx_dat[RD_BLCK];
 
     for(int gid = get_global_id(0); gid < total_item; gid += get_global_size(0))
     {
@@ -249,20 +298,19 @@ __kernel void LSTMBwdHidUpdate(const global _FLOAT* cx,
         int h_idx   = gid * RD_BLCK - b_idx * hy_h;
         int rsv_idx = b_idx * hy_stride + h_idx;
 
-        *((READ_TYPE*)dh_dat) = *((const global READ_TYPE*)(workspace + dhidden_offset + rsv_idx));
-        *((READ_TYPE*)o_dat)  = *((const global READ_TYPE*)(reservespace + o_offset + rsv_idx));
+        LoadBlock(dh_dat, workspace + dhidden_offset + rsv_idx);
+        LoadBlock(o_dat, reservespace + o_offset + rsv_idx);
 
-        *((READ_TYPE*)i_dat) = *((const global READ_TYPE*)(reservespace + i_offset + rsv_idx));
+        LoadBlock(i_dat, reservespace + i_offset + rsv_idx);
 
-        *((READ_TYPE*)c_dat) = *((const global READ_TYPE*)(reservespace + c_offset + rsv_idx));
+        LoadBlock(c_dat, reservespace + c_offset + rsv_idx);
 
         for(int i = 0; i < RD_BLCK; ++i)
         {
             s_dat[i] = dh_dat[i] * o_dat[i];
         }
 
-        *((READ_TYPE*)cx_dat) = *((const global READ_TYPE*)(reservespace + activ_cell_offset +
-                                                            b_idx * hy_stride / 6 + h_idx));
+        LoadBlock(cx_dat, reservespace + activ_cell_offset + b_idx * hy_stride / 6 + h_idx);
 
         ActivationFunction_TanH_Diff(RD_BLCK,
                                      dcx_dat,
@@ -278,8 +326,7 @@ __kernel void LSTMBwdHidUpdate(const global _FLOAT* cx,
         {
             if((bool)use_dcy)
             {
-                *((READ_TYPE*)s_dat) =
-                    *((const global READ_TYPE*)(dcy + dcy_offset + gid * RD_BLCK));
+                LoadBlock(s_dat, dcy + dcy_offset + gid * RD_BLCK);
 
                 for(int i = 0; i < RD_BLCK; ++i)
                 {
@@ -291,10 +338,8 @@ __kernel void LSTMBwdHidUpdate(const global _FLOAT* cx,
         {
             if(b_idx < use_batch)
             {
-                *((READ_TYPE*)s_dat) =
-                    *((const global READ_TYPE*)(workspace + dcell_offset_pre + rsv_idx));
-                *((READ_TYPE*)f_dat) =
-                    *((const global READ_TYPE*)(reservespace + f_offset_pre + rsv_idx));
+                LoadBlock(s_dat, workspace + dcell_offset_pre + rsv_idx);
+                LoadBlock(f_dat, reservespace + f_offset_pre + rsv_idx);
 
                 for(int i = 0; i < RD_BLCK; ++i)
                 {
@@ -305,8 +350,7 @@ __kernel void LSTMBwdHidUpdate(const global _FLOAT* cx,
             {
                 if(direction == 0 && (bool)use_dcy)
                 {
-                    *((READ_TYPE*)s_dat) =
-                        *((const global READ_TYPE*)(dcy + dcy_offset + gid * RD_BLCK));
+                    LoadBlock(s_dat, dcy + dcy_offset + gid * RD_BLCK);
 
                     for(int i = 0; i < RD_BLCK; ++i)
                     {
@@ -320,8 +364,7 @@ __kernel void LSTMBwdHidUpdate(const global _FLOAT* cx,
         {
             if((bool)use_cx)
             {
-                *((READ_TYPE*)df_dat) =
-                    *((const global READ_TYPE*)(cx + cx_offset + gid * RD_BLCK));
+                LoadBlock(df_dat, cx + cx_offset + gid * RD_BLCK);
 
                 for(int i = 0; i < RD_BLCK; ++i)
                 {
@@ -332,7 +375,7 @@ __kernel void LSTMBwdHidUpdate(const global _FLOAT* cx,
             {
                 for(int i = 0; i < RD_BLCK; ++i)
                 {
-                    df_dat[i] = (_FLOAT)0;
+                    df_dat[i] = (_FLOAT_PREC)0;
                 }
             }
         }
@@ -340,8 +383,7 @@ __kernel void LSTMBwdHidUpdate(const global _FLOAT* cx,
         {
             if(b_idx < use_batch2)
             {
-                *((READ_TYPE*)df_dat) =
-                    *((const global READ_TYPE*)(reservespace + cell_offset_pre + rsv_idx));
+                LoadBlock(df_dat, reservespace + cell_offset_pre + rsv_idx);
 
                 for(int i = 0; i < RD_BLCK; ++i)
                 {
@@ -352,8 +394,7 @@ __kernel void LSTMBwdHidUpdate(const global _FLOAT* cx,
             {
                 if(direction == 1 && (bool)use_cx)
                 {
-                    *((READ_TYPE*)df_dat) =
-                        *((const global READ_TYPE*)(cx + cx_offset + gid * RD_BLCK));
+                    LoadBlock(df_dat, cx + cx_offset + gid * RD_BLCK);
 
                     for(int i = 0; i < RD_BLCK; ++i)
                     {
@@ -364,13 +405,13 @@ __kernel void LSTMBwdHidUpdate(const global _FLOAT* cx,
                 {
                     for(int i = 0; i < RD_BLCK; ++i)
                     {
-                        df_dat[i] = (_FLOAT)0;
+                        df_dat[i] = (_FLOAT_PREC)0;
                     }
                 }
             }
         }
 
-        *((READ_TYPE*)f_dat) = *((const global READ_TYPE*)(reservespace + f_offset + rsv_idx));
+        LoadBlock(f_dat, reservespace + f_offset + rsv_idx);
 
         ActivationFunction_Sigmoid_Diff(RD_BLCK,
                                         s_dat,
@@ -382,7 +423,7 @@ __kernel void LSTMBwdHidUpdate(const global _FLOAT* cx,
                                         activ_param,
                                         activ_param);
 
-        *((global READ_TYPE*)(workspace + df_offset + rsv_idx)) = *((READ_TYPE*)s_dat);
+        StoreBlock(workspace + df_offset + rsv_idx, s_dat);
 
         for(int i = 0; i < RD_BLCK; ++i)
         {
@@ -399,7 +440,7 @@ __kernel void LSTMBwdHidUpdate(const global _FLOAT* cx,
                                         activ_param,
                                         activ_param);
 
-        *((global READ_TYPE*)(workspace + di_offset + rsv_idx)) = *((READ_TYPE*)s_dat);
+        StoreBlock(workspace + di_offset + rsv_idx, s_dat);
 
         for(int i = 0; i < RD_BLCK; ++i)
         {
@@ -416,7 +457,7 @@ __kernel void LSTMBwdHidUpdate(const global _FLOAT* cx,
                                         activ_param,
                                         activ_param);
 
-        *((global READ_TYPE*)(workspace + do_offset + rsv_idx)) = *((READ_TYPE*)s_dat);
+        StoreBlock(workspace + do_offset + rsv_idx, s_dat);
 
         for(int i = 0; i < RD_BLCK; ++i)
         {
@@ -433,10 +474,277 @@ __kernel void LSTMBwdHidUpdate(const global _FLOAT* cx,
                                      activ_param,
                                      activ_param);
 
-        *((global READ_TYPE*)(workspace + dc_offset + rsv_idx)) = *((READ_TYPE*)s_dat);
+        StoreBlock(workspace + dc_offset + rsv_idx, s_dat);
+
+        StoreBlock(workspace + dcell_offset + rsv_idx, dcx_dat);
+        StoreBlock(workspace + dhidden_offset + rsv_idx, dh_dat);
+    }
+}
+#endif
+
+#if GRU_FWD_HID
+#ifndef INFERENCE_MODE
+#define INFERENCE_MODE 0
+#endif
+
+// The gates z, r and c hold the GEMM results, the c gate only the part from the previous hidden
+// state, while the part from the input has been moved to the hidden state slot beforehand.
+// The activated gates go to activ_offset past the inputs, which is 0 in inference, and in
+// training the recurrent part of the c gate is kept in the activated hidden state slot for the
+// backward pass.
+__kernel void GRUFwdHidUpdate(const global _FLOAT* hx,
+                              global _FLOAT* reservespace,
+                              const int hy_h,
+                              const int hy_stride,
+                              const long hx_offset,
+                              const long z_offset,
+                              const long r_offset,
+                              const long c_offset,
+                              const long hidden_offset,
+                              const long hidden_offset_pre,
+                              const long activ_offset,
+                              const char use_hx,
+                              const char is_seq_begin,
+                              const int direction,
+                              const int cur_batch,
+                              const int use_batch)
+{
+    int total_item          = cur_batch * hy_h / RD_BLCK;
+    total_item              = max(total_item, 1);
+    _FLOAT_PREC activ_param = 1;
+
+    _FLOAT_PREC s_dat[RD_BLCK];
+
+    _FLOAT_PREC z_dat[RD_BLCK];
+    _FLOAT_PREC r_dat[RD_BLCK];
+    _FLOAT_PREC c_dat[RD_BLCK];
+    _FLOAT_PREC uc_dat[RD_BLCK];
+
+    _FLOAT_PREC hx_dat[RD_BLCK];
+
+    for(int gid = get_global_id(0); gid < total_item; gid += get_global_size(0))
+    {
+        int b_idx   = gid * RD_BLCK / hy_h;
+        int h_idx   = gid * RD_BLCK - b_idx * hy_h;
+        int rsv_idx = b_idx * hy_stride + h_idx;
+
+        LoadBlock(s_dat, reservespace + z_offset + rsv_idx);
+        ActivationFunction_Sigmoid(
+            RD_BLCK, z_dat, (const _FLOAT_PREC*)s_dat, activ_param, activ_param, activ_param);
+
+        LoadBlock(s_dat, reservespace + r_offset + rsv_idx);
+        ActivationFunction_Sigmoid(
+            RD_BLCK, r_dat, (const _FLOAT_PREC*)s_dat, activ_param, activ_param, activ_param);
+
+        LoadBlock(uc_dat, reservespace + c_offset + rsv_idx);
+        LoadBlock(s_dat, reservespace + hidden_offset + rsv_idx);
+        for(int i = 0; i < RD_BLCK; ++i)
+        {
+            s_dat[i] += r_dat[i] * uc_dat[i];
+        }
+        ActivationFunction_TanH(
+            RD_BLCK, c_dat, (const _FLOAT_PREC*)s_dat, activ_param, activ_param, activ_param);
+
+        if((bool)is_seq_begin)
+        {
+            if((bool)use_hx)
+            {
+                LoadBlock(hx_dat, hx + hx_offset + gid * RD_BLCK);
+            }
+            else
+            {
+                for(int i = 0; i < RD_BLCK; ++i)
+                {
+                    hx_dat[i] = (_FLOAT_PREC)0;
+                }
+            }
+        }
+        else
+        {
+            if(b_idx < use_batch)
+            {
+                LoadBlock(hx_dat, reservespace + hidden_offset_pre + rsv_idx);
+            }
+            else
+            {
+                if(direction == 1 && (bool)use_hx)
+                {
+                    LoadBlock(hx_dat, hx + hx_offset + gid * RD_BLCK);
+                }
+                else
+                {
+                    for(int i = 0; i < RD_BLCK; ++i)
+                    {
+                        hx_dat[i] = (_FLOAT_PREC)0;
+                    }
+                }
+            }
+        }
+
+        for(int i = 0; i < RD_BLCK; ++i)
+        {
+            s_dat[i] = ((_FLOAT_PREC)1 - z_dat[i]) * c_dat[i] + z_dat[i] * hx_dat[i];
+        }
+
+        StoreBlock(reservespace + z_offset + activ_offset + rsv_idx, z_dat);
+        StoreBlock(reservespace + r_offset + activ_offset + rsv_idx, r_dat);
+        StoreBlock(reservespace + c_offset + activ_offset + rsv_idx, c_dat);
+#if !INFERENCE_MODE
+        StoreBlock(reservespace + hidden_offset + activ_offset + rsv_idx, uc_dat);
+#endif
+
+        StoreBlock(reservespace + hidden_offset + rsv_idx, s_dat);
+    }
+}
+#endif
+
+#if GRU_BWD_HID
+// Reads the activated gates and the recurrent part of the c gate stored by GRUFwdHidUpdate, and
+// leaves the gradient of that recurrent part, dc * r, in its place for the weight update.
+__kernel void GRUBwdHidUpdate(const global _FLOAT* hx,
+                              global _FLOAT* reservespace,
+                              global _FLOAT* workspace,
+                              const int hy_h,
+                              const int hy_stride,
+                              const long hx_offset,
+                              const long z_offset,
+                              const long r_offset,
+                              const long c_offset,
+                              const long hidden_offset,
+                              const long hidden_offset_pre,
+                              const long dz_offset,
+                              const long dr_offset,
+                              const long dc_offset,
+                              const long dhidden_offset,
+                              const char use_hx,
+                              const char is_seq_begin,
+                              const int direction,
+                              const int cur_batch,
+                              const int use_batch)
+{
+    int total_item          = cur_batch * hy_h / RD_BLCK;
+    total_item              = max(total_item, 1);
+    _FLOAT_PREC activ_param = 1;
+
+    _FLOAT_PREC dh_dat[RD_BLCK];
+
+    _FLOAT_PREC s_dat[RD_BLCK];
+
+    _FLOAT_PREC z_dat[RD_BLCK];
+    _FLOAT_PREC r_dat[RD_BLCK];
+    _FLOAT_PREC c_dat[RD_BLCK];
+    _FLOAT_PREC uc_dat[RD_BLCK];
+
+    _FLOAT_PREC dc_dat[RD_BLCK];
+
+    _FLOAT_PREC hx_dat[RD_BLCK];
+
+    for(int gid = get_global_id(0); gid < total_item; gid += get_global_size(0))
+    {
+        int b_idx   = gid * RD_BLCK / hy_h;
+        int h_idx   = gid * RD_BLCK - b_idx * hy_h;
+        int rsv_idx = b_idx * hy_stride + h_idx;
+
+        LoadBlock(dh_dat, workspace + dhidden_offset + rsv_idx);
+
+        LoadBlock(z_dat, reservespace + z_offset + rsv_idx);
+        LoadBlock(r_dat, reservespace + r_offset + rsv_idx);
+        LoadBlock(c_dat, reservespace + c_offset + rsv_idx);
+        LoadBlock(uc_dat, reservespace + hidden_offset + rsv_idx);
+
+        for(int i = 0; i < RD_BLCK; ++i)
+        {
+            s_dat[i] = ((_FLOAT_PREC)1 - z_dat[i]) * dh_dat[i];
+        }
+
+        ActivationFunction_TanH_Diff(RD_BLCK,
+                                     dc_dat,
+                                     s_dat,
+                                     c_dat,
+                                     c_dat,
+                                     activ_param,
+                                     activ_param,
+                                     activ_param,
+                                     activ_param);
+
+        StoreBlock(workspace + dc_offset + rsv_idx, dc_dat);
+
+        for(int i = 0; i < RD_BLCK; ++i)
+        {
+            uc_dat[i] *= dc_dat[i];
+        }
+
+        ActivationFunction_Sigmoid_Diff(RD_BLCK,
+                                        s_dat,
+                                        uc_dat,
+                                        r_dat,
+                                        r_dat,
+                                        activ_param,
+                                        activ_param,
+                                        activ_param,
+                                        activ_param);
+
+        StoreBlock(workspace + dr_offset + rsv_idx, s_dat);
+
+        for(int i = 0; i < RD_BLCK; ++i)
+        {
+            s_dat[i] = dc_dat[i] * r_dat[i];
+        }
+
+        StoreBlock(reservespace + hidden_offset + rsv_idx, s_dat);
+
+        if((bool)is_seq_begin)
+        {
+            if((bool)use_hx)
+            {
+                LoadBlock(hx_dat, hx + hx_offset + gid * RD_BLCK);
+            }
+            else
+            {
+                for(int i = 0; i < RD_BLCK; ++i)
+                {
+                    hx_dat[i] = (_FLOAT_PREC)0;
+                }
+            }
+        }
+        else
+        {
+            if(b_idx < use_batch)
+            {
+                LoadBlock(hx_dat, reservespace + hidden_offset_pre + rsv_idx);
+            }
+            else
+            {
+                if(direction == 1 && (bool)use_hx)
+                {
+                    LoadBlock(hx_dat, hx + hx_offset + gid * RD_BLCK);
+                }
+                else
+                {
+                    for(int i = 0; i < RD_BLCK; ++i)
+                    {
+                        hx_dat[i] = (_FLOAT_PREC)0;
+                    }
+                }
+            }
+        }
+
+        for(int i = 0; i < RD_BLCK; ++i)
+        {
+            hx_dat[i] = (hx_dat[i] - c_dat[i]) * dh_dat[i];
+        }
+
+        ActivationFunction_Sigmoid_Diff(RD_BLCK,
+                                        s_dat,
+                                        hx_dat,
+                                        z_dat,
+                                        z_dat,
+                                        activ_param,
+                                        activ_param,
+                                        activ_param,
+                                        activ_param);
 
-        *((global READ_TYPE*)(workspace + dcell_offset + rsv_idx))   = *((READ_TYPE*)dcx_dat);
-        *((global READ_TYPE*)(workspace + dhidden_offset + rsv_idx)) = *((READ_TYPE*)dh_dat);
+        StoreBlock(workspace + dz_offset + rsv_idx, s_dat);
     }
 }
 #endif
@@ -0,0 +1,242 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "float_types.h"
+
+// Persistent inference of the recurrent part of one unidirectional RNN layer. The input
+// projections and biases of all time steps are already in the workspace, so each step only
+// has to add the product of the previous hidden state with the recurrent weights, and apply
+// the cell. One launch runs all the time steps: every work-group owns RNN_UNITS hidden units
+// (all the gates of them, so the cell update is local), keeps their weights on chip and
+// waits for the other work-groups at the end of each step on a counter in global memory,
+// sync[sync_index], which shall be zero at launch.
+// All RNN_NUM_GROUPS work-groups shall be resident at once, which the host ensures by
+// launching no more of them than there are compute units.
+//
+// RNN_MODE           0 - ReLU, 1 - tanh, 2 - LSTM, 3 - GRU
+// RNN_GATES          gates per hidden unit (1, 4 or 3)
+// RNN_HY_H           hidden size
+// RNN_BATCH          batch size, the same at all time steps
+// RNN_HY_STRIDE      workspace row length
+// RNN_HID_OFF        offset of the hidden state in a workspace row
+// RNN_CELL_OFF       offset of the LSTM cell state in a workspace row
+// RNN_UNITS          hidden units per work-group
+// RNN_NUM_GROUPS     work-groups
+// RNN_WEI_IN_LDS     whether the weights of a work-group fit LDS
+// RNN_QUANT_WEI      whether the weights are int8 rows, each scaled by its float of w_scale
+
+#define RNN_LOCAL_SIZE 256
+// work-items cooperating on one dot product
+#define RNN_DOT_LANES 16
+#define RNN_DOT_SLOTS (RNN_LOCAL_SIZE / RNN_DOT_LANES)
+#define RNN_NOUT (RNN_BATCH * RNN_GATES * RNN_UNITS)
+
+#if RNN_QUANT_WEI
+#define RNN_WEI_TYPE char
+#define CVT_WEI2ACCUM(x) ((_FLOAT_ACCUM)(x))
+#else
+#define RNN_WEI_TYPE _FLOAT
+#define CVT_WEI2ACCUM(x) CVT_FLOAT2ACCUM(x)
+#endif
+
+static inline _FLOAT_ACCUM Sigmoid(_FLOAT_ACCUM x) { return 1 / (1 + exp(-x)); }
+
+static inline _FLOAT_ACCUM Activate(_FLOAT_ACCUM x)
+{
+#if RNN_MODE == 0
+    return fmax(x, (_FLOAT_ACCUM)0);
+#else
+    return tanh(x);
+#endif
+}
+
+__kernel void MIOpenRNNPersistentFwd(__global _FLOAT* __restrict workspace,
+                                     const __global RNN_WEI_TYPE* __restrict w,
+                                     const __global float* __restrict w_scale,
+                                     const __global _FLOAT* __restrict hx,
+                                     const __global _FLOAT* __restrict cx,
+                                     volatile __global int* sync,
+                                     const int sync_index,
+                                     const long hid_shift,
+                                     const long wei_shift,
+                                     const long scale_shift,
+                                     const long hx_shift,
+                                     const int seq_len,
+                                     const int use_hx,
+                                     const int use_cx)
+{
+    __local _FLOAT_ACCUM h_prev[RNN_BATCH * RNN_HY_H];
+    __local _FLOAT_ACCUM dot[RNN_NOUT];
+    __local _FLOAT_ACCUM partial[RNN_LOCAL_SIZE];
+#if RNN_WEI_IN_LDS
+    __local _FLOAT_ACCUM wei[RNN_GATES * RNN_UNITS * RNN_HY_H];
+#endif
+
+    const int lid  = (int)get_local_id(0);
+    const int u0   = (int)get_group_id(0) * RNN_UNITS;
+    const int lane = lid % RNN_DOT_LANES;
+    const int slot = lid / RNN_DOT_LANES;
+
+    // Rows of the recurrent weights: gate g of unit u is row g * RNN_HY_H + u.
+    const __global RNN_WEI_TYPE* p_w = w + wei_shift;
+#if RNN_WEI_IN_LDS
+    for(int i = lid; i < RNN_GATES * RNN_UNITS * RNN_HY_H; i += RNN_LOCAL_SIZE)
+    {
+        const int k  = i % RNN_HY_H;
+        const int uu = (i / RNN_HY_H) % RNN_UNITS;
+        const int g  = i / (RNN_HY_H * RNN_UNITS);
+        const int j  = g * RNN_HY_H + u0 + uu;
+        _FLOAT_ACCUM wk = (_FLOAT_ACCUM)0;
+        if(u0 + uu < RNN_HY_H)
+        {
+            wk = CVT_WEI2ACCUM(p_w[j * RNN_HY_H + k]);
+#if RNN_QUANT_WEI
+            wk *= w_scale[scale_shift + j];
+#endif
+        }
+        wei[i] = wk;
+    }
+#endif
+
+    // The work-item lid < RNN_BATCH * RNN_UNITS updates unit u0 + lid % RNN_UNITS of batch
+    // lid / RNN_UNITS, and keeps its cell state across steps.
+    const int cell_b = lid / RNN_UNITS;
+    const int cell_u = u0 + lid % RNN_UNITS;
+    const bool owner = lid < RNN_BATCH * RNN_UNITS && cell_u < RNN_HY_H;
+    _FLOAT_ACCUM c   = (_FLOAT_ACCUM)0;
+#if RNN_MODE == 2
+    if(owner && use_cx)
+        c = CVT_FLOAT2ACCUM(cx[hx_shift + cell_b * RNN_HY_H + cell_u]);
+#endif
+
+    for(int t = 0; t < seq_len; ++t)
+    {
+        const long row = hid_shift + (long)t * RNN_BATCH * RNN_HY_STRIDE;
+
+        // Hidden state of the previous step, written by all the work-groups. The reads are
+        // volatile to bypass the non-coherent vector cache.
+        const bool has_prev = t > 0 || use_hx;
+        if(t > 0)
+        {
+            const volatile __global _FLOAT* p_prev =
+                workspace + row - RNN_BATCH * RNN_HY_STRIDE + RNN_HID_OFF;
+            for(int i = lid; i < RNN_BATCH * RNN_HY_H; i += RNN_LOCAL_SIZE)
+                h_prev[i] = CVT_FLOAT2ACCUM(p_prev[(i / RNN_HY_H) * RNN_HY_STRIDE + i % RNN_HY_H]);
+        }
+        else if(use_hx)
+        {
+            for(int i = lid; i < RNN_BATCH * RNN_HY_H; i += RNN_LOCAL_SIZE)
+                h_prev[i] = CVT_FLOAT2ACCUM(hx[hx_shift + i]);
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        for(int base = 0; base < RNN_NOUT; base += RNN_DOT_SLOTS)
+        {
+            // output o is gate g of unit u0 + uu of batch b
+            const int o  = base + slot;
+            const int uu = o % RNN_UNITS;
+            const int g  = (o / RNN_UNITS) % RNN_GATES;
+            const int b  = o / (RNN_UNITS * RNN_GATES);
+
+            _FLOAT_ACCUM sum = (_FLOAT_ACCUM)0;
+            if(has_prev && o < RNN_NOUT && u0 + uu < RNN_HY_H)
+            {
+                for(int k = lane; k < RNN_HY_H; k += RNN_DOT_LANES)
+                {
+#if RNN_WEI_IN_LDS
+                    const _FLOAT_ACCUM wk = wei[(g * RNN_UNITS + uu) * RNN_HY_H + k];
+#else
+                    const _FLOAT_ACCUM wk =
+                        CVT_WEI2ACCUM(p_w[(g * RNN_HY_H + u0 + uu) * RNN_HY_H + k]);
+#endif
+                    sum += h_prev[b * RNN_HY_H + k] * wk;
+                }
+#if RNN_QUANT_WEI && !RNN_WEI_IN_LDS
+                sum *= w_scale[scale_shift + g * RNN_HY_H + u0 + uu];
+#endif
+            }
+            partial[lid] = sum;
+            barrier(CLK_LOCAL_MEM_FENCE);
+
+            if(lid < RNN_DOT_SLOTS && base + lid < RNN_NOUT)
+            {
+                _FLOAT_ACCUM total = (_FLOAT_ACCUM)0;
+                for(int i = 0; i < RNN_DOT_LANES; ++i)
+                    total += partial[lid * RNN_DOT_LANES + i];
+                dot[base + lid] = total;
+            }
+            barrier(CLK_LOCAL_MEM_FENCE);
+        }
+
+        if(owner)
+        {
+            __global _FLOAT* p_row = workspace + row + cell_b * RNN_HY_STRIDE;
+            const int d            = (cell_b * RNN_GATES) * RNN_UNITS + lid % RNN_UNITS;
+
+#if RNN_MODE == 0 || RNN_MODE == 1
+            const _FLOAT_ACCUM h = Activate(CVT_FLOAT2ACCUM(p_row[cell_u]) + dot[d]);
+#elif RNN_MODE == 2
+            const _FLOAT_ACCUM gi = Sigmoid(CVT_FLOAT2ACCUM(p_row[cell_u]) + dot[d]);
+            const _FLOAT_ACCUM gf =
+                Sigmoid(CVT_FLOAT2ACCUM(p_row[RNN_HY_H + cell_u]) + dot[d + RNN_UNITS]);
+            const _FLOAT_ACCUM go =
+                Sigmoid(CVT_FLOAT2ACCUM(p_row[2 * RNN_HY_H + cell_u]) + dot[d + 2 * RNN_UNITS]);
+            const _FLOAT_ACCUM gc =
+                tanh(CVT_FLOAT2ACCUM(p_row[3 * RNN_HY_H + cell_u]) + dot[d + 3 * RNN_UNITS]);
+            c = gf * c + gi * gc;
+
+            p_row[RNN_CELL_OFF + cell_u] = CVT_ACCUM2FLOAT(c);
+            const _FLOAT_ACCUM h         = go * tanh(c);
+#else
+            // The candidate gate holds only its recurrent bias, its input projection was
+            // moved to the hidden state slot.
+            const _FLOAT_ACCUM gz = Sigmoid(CVT_FLOAT2ACCUM(p_row[cell_u]) + dot[d]);
+            const _FLOAT_ACCUM gr =
+                Sigmoid(CVT_FLOAT2ACCUM(p_row[RNN_HY_H + cell_u]) + dot[d + RNN_UNITS]);
+            const _FLOAT_ACCUM hc =
+                CVT_FLOAT2ACCUM(p_row[2 * RNN_HY_H + cell_u]) + dot[d + 2 * RNN_UNITS];
+            const _FLOAT_ACCUM gc = tanh(gr * hc + CVT_FLOAT2ACCUM(p_row[RNN_HID_OFF + cell_u]));
+            const _FLOAT_ACCUM hp = has_prev ? h_prev[cell_b * RNN_HY_H + cell_u] : 0;
+            const _FLOAT_ACCUM h  = (1 - gz) * gc + gz * hp;
+#endif
+            p_row[RNN_HID_OFF + cell_u] = CVT_ACCUM2FLOAT(h);
+        }
+
+        // Global barrier: the next step reads the hidden state of all the units.
+        if(t + 1 < seq_len)
+        {
+            mem_fence(CLK_GLOBAL_MEM_FENCE);
+            barrier(CLK_GLOBAL_MEM_FENCE | CLK_LOCAL_MEM_FENCE);
+            if(lid == 0)
+            {
+                atomic_inc(sync + sync_index);
+                while(atomic_add(sync + sync_index, 0) < (t + 1) * RNN_NUM_GROUPS)
+                    ;
+            }
+            barrier(CLK_GLOBAL_MEM_FENCE | CLK_LOCAL_MEM_FENCE);
+        }
+    }
+}
@@ -0,0 +1,92 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "float_types.h"
+
+// Recurrent GEMM of RNN inference with int8 weights:
+//   c[i][j] += scale[j] * sum_k a[i][k] * w[j][k]
+// for the m rows of a and the n rows of w, of k values each. Every work-group loads one row of
+// w once for QGEMM_ROWS rows of a and dequantizes it in registers, so the weights cost a
+// quarter of the bytes of fp32.
+
+#define QGEMM_LOCAL_SIZE 64
+#define QGEMM_ROWS 4
+
+__kernel void MIOpenRNNQuantizedGemm(const __global _FLOAT* __restrict a,
+                                     const __global char* __restrict w,
+                                     const __global float* __restrict scale,
+                                     __global _FLOAT* __restrict c,
+                                     const long a_shift,
+                                     const long w_shift,
+                                     const long scale_shift,
+                                     const long c_shift,
+                                     const int lda,
+                                     const int ldc,
+                                     const int m,
+                                     const int k)
+{
+    __local _FLOAT_ACCUM partial[QGEMM_ROWS * QGEMM_LOCAL_SIZE];
+
+    const int lid = (int)get_local_id(0);
+    const int j   = (int)get_group_id(0);
+    const int i0  = (int)get_group_id(1) * QGEMM_ROWS;
+
+    _FLOAT_ACCUM sum[QGEMM_ROWS];
+    for(int r = 0; r < QGEMM_ROWS; ++r)
+        sum[r] = (_FLOAT_ACCUM)0;
+
+    const __global char* p_w = w + w_shift + (long)j * k;
+    for(int kk = lid; kk < k; kk += QGEMM_LOCAL_SIZE)
+    {
+        const _FLOAT_ACCUM wk = (_FLOAT_ACCUM)p_w[kk];
+        for(int r = 0; r < QGEMM_ROWS; ++r)
+        {
+            if(i0 + r < m)
+                sum[r] += CVT_FLOAT2ACCUM(a[a_shift + (long)(i0 + r) * lda + kk]) * wk;
+        }
+    }
+
+    for(int r = 0; r < QGEMM_ROWS; ++r)
+        partial[r * QGEMM_LOCAL_SIZE + lid] = sum[r];
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    for(int s = QGEMM_LOCAL_SIZE / 2; s > 0; s >>= 1)
+    {
+        if(lid < s)
+        {
+            for(int r = 0; r < QGEMM_ROWS; ++r)
+                partial[r * QGEMM_LOCAL_SIZE + lid] += partial[r * QGEMM_LOCAL_SIZE + lid + s];
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+
+    if(lid < QGEMM_ROWS && i0 + lid < m)
+    {
+        __global _FLOAT* p_c = c + c_shift + (long)(i0 + lid) * ldc + j;
+        *p_c = CVT_ACCUM2FLOAT(CVT_FLOAT2ACCUM(*p_c) +
+                               scale[scale_shift + j] * partial[lid * QGEMM_LOCAL_SIZE]);
+    }
+}
@@ -73,6 +73,10 @@
 #define USE_SOFTMAX_FAST 0
 #endif
 
+#ifndef USE_SOFTMAX_ONLINE
+#define USE_SOFTMAX_ONLINE 0
+#endif
+
 #ifndef USE_SOFTMAX_MODE_INSTANCE
 #define USE_SOFTMAX_MODE_INSTANCE 0
 #endif
@@ -111,6 +115,10 @@
 #error "Wrong values of USE_SOFTMAX_... macros -- exactly one should be 1, others shall be 0"
 #endif
 
+#if USE_SOFTMAX_ONLINE && (USE_SOFTMAX_FAST || NUM_BATCH != 1)
+#error "USE_SOFTMAX_ONLINE is only supported by the CSR-Vector kernel of accurate and log softmax"
+#endif
+
 #if USE_SOFTMAX_MODE_INSTANCE == USE_SOFTMAX_MODE_CHANNEL
 #error "Wrong values of USE_SOFTMAX_MODE_... macros -- exactly one should be 1, others shall be 0"
 #endif
@@ -225,6 +233,74 @@ __kernel void SoftmaxForward(global _FLOAT* x,
         int s1 = s % input_w;
 #endif
 
+#if USE_SOFTMAX_ONLINE
+        /* Online softmax: a single read pass in which every thread keeps a running max and
+         * the sum of exponents relative to it, rescaling the sum whenever the max grows.
+         * The (max, sum) pairs of the threads are then merged the same way, which saves the
+         * separate max pass over the channels.
+         */
+        local _FLOAT l_max[256];
+
+        _FLOAT t_max = (_FLOAT)-MAX_VAL;
+        _FLOAT t_sum = (_FLOAT)0.;
+
+        for(int i = lid; i < vector_size; i += get_local_size(0))
+        {
+#if !IS_INPUT_PACKED && USE_SOFTMAX_MODE_INSTANCE
+            int i0 = i / (input_w * input_h);
+            int i1 = (i % (input_w * input_h)) / input_w;
+            int i2 = (i % (input_w * input_h)) % input_w;
+#endif
+
+            int x_gidx = x_offset;
+#if IS_INPUT_PACKED
+            x_gidx += mad24(n, vector_size, i) * spatial_dim + s;
+#else
+            x_gidx += n * in_nstr;
+#if USE_SOFTMAX_MODE_INSTANCE
+            x_gidx += i0 * in_cstr + i1 * in_hstr + i2;
+#else
+            x_gidx += i * in_cstr + s0 * in_hstr + s1;
+#endif
+#endif
+
+            _FLOAT value = x[x_gidx];
+            if(value > t_max)
+            {
+                t_sum = t_sum * exp(t_max - value) + (_FLOAT)1.;
+                t_max = value;
+            }
+            else
+            {
+                t_sum += exp(value - t_max);
+            }
+        }
+
+        l_max[lid]    = t_max;
+        l_helper[lid] = t_sum;
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        for(int i = (get_local_size(0) >> 1); i > 0; i >>= 1)
+        {
+            if(lid < i)
+            {
+                _FLOAT m      = max(l_max[lid], l_max[lid + i]);
+                l_helper[lid] = l_helper[lid] * exp(l_max[lid] - m) +
+                                l_helper[lid + i] * exp(l_max[lid + i] - m);
+                l_max[lid] = m;
+            }
+            barrier(CLK_LOCAL_MEM_FENCE);
+        }
+
+        _FLOAT channel_max = l_max[0];
+#if USE_SOFTMAX_LOG
+        _FLOAT channel_sum = log(l_helper[0]);
+#else
+        _FLOAT channel_sum = l_helper[0];
+#endif
+        // The next spatial_dim overwrites the helpers.
+        barrier(CLK_LOCAL_MEM_FENCE);
+#else
 #if !USE_SOFTMAX_FAST
         l_helper[lid] = (_FLOAT)-MAX_VAL;
 
@@ -339,6 +415,7 @@ __kernel void SoftmaxForward(global _FLOAT* x,
         }
 
         _FLOAT channel_sum = l_helper[0];
+#endif
 
         // Normalize each value in the channel by the channel_sum
         for(int i = lid; i < vector_size; i += get_local_size(0))
@@ -622,7 +699,7 @@ __kernel void SoftmaxForward(global _FLOAT* x,
 }
 #endif
 
-#if !RUN_FORWARD
+#if !RUN_FORWARD && !RUN_CROSS_ENTROPY
 __kernel void SoftmaxBackward(global _FLOAT* y,
                               global _FLOAT* dy,
                               global _FLOAT* dx,
@@ -998,3 +1075,102 @@ __kernel void SoftmaxBackward(global _FLOAT* y,
 #endif // CSR-Vector vs CSR-Stream
 }
 #endif
+
+#if RUN_CROSS_ENTROPY
+/* Fused log-softmax and negative log-likelihood over the channels of every (n, s).
+ * A workgroup reads the logits once for the running max and sum of exponents, writes
+ * loss = max + log(sum) - x[label] and, when requested, the gradient
+ * softmax(x) - onehot(label) in a second pass, so the probabilities are never stored.
+ * Samples whose label is out of [0, vector_size) are ignored: loss and gradient are 0.
+ */
+__kernel void SoftmaxCrossEntropy(const global _FLOAT* x,
+                                  const global int* labels,
+                                  global _FLOAT* loss,
+#if !USE_GRADIENT
+                                  UNUSED
+#endif
+                                  global _FLOAT* dx,
+                                  const int vector_size,
+                                  const int grid_size,
+                                  const int spatial_dim,
+                                  const int x_offset,
+#if !USE_GRADIENT
+                                  UNUSED
+#endif
+                                  const int dx_offset)
+{
+    local _FLOAT l_max[256];
+    local _FLOAT l_helper[256];
+
+    int lid = get_local_id(0);
+
+    for(int gid = get_group_id(0); gid < grid_size; gid += get_num_groups(0))
+    {
+        int n = gid / spatial_dim;
+        int s = gid % spatial_dim;
+
+        _FLOAT t_max = (_FLOAT)-MAX_VAL;
+        _FLOAT t_sum = (_FLOAT)0.;
+
+        for(int i = lid; i < vector_size; i += get_local_size(0))
+        {
+            _FLOAT value = x[x_offset + mad24(n, vector_size, i) * spatial_dim + s];
+            if(value > t_max)
+            {
+                t_sum = t_sum * exp(t_max - value) + (_FLOAT)1.;
+                t_max = value;
+            }
+            else
+            {
+                t_sum += exp(value - t_max);
+            }
+        }
+
+        l_max[lid]    = t_max;
+        l_helper[lid] = t_sum;
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        for(int i = (get_local_size(0) >> 1); i > 0; i >>= 1)
+        {
+            if(lid < i)
+            {
+                _FLOAT m      = max(l_max[lid], l_max[lid + i]);
+                l_helper[lid] = l_helper[lid] * exp(l_max[lid] - m) +
+                                l_helper[lid + i] * exp(l_max[lid + i] - m);
+                l_max[lid] = m;
+            }
+            barrier(CLK_LOCAL_MEM_FENCE);
+        }
+
+        _FLOAT channel_max = l_max[0];
+        _FLOAT channel_sum = l_helper[0];
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        int label  = labels[gid];
+        bool valid = label >= 0 && label < vector_size;
+
+        if(lid == 0)
+        {
+            loss[gid] =
+                valid ? channel_max + log(channel_sum) -
+                            x[x_offset + mad24(n, vector_size, label) * spatial_dim + s]
+                      : (_FLOAT)0.;
+        }
+
+#if USE_GRADIENT
+        for(int i = lid; i < vector_size; i += get_local_size(0))
+        {
+            int idx      = mad24(n, vector_size, i) * spatial_dim + s;
+            _FLOAT value = (_FLOAT)0.;
+            if(valid)
+            {
+                value = exp(x[x_offset + idx] - channel_max) / channel_sum;
+                if(i == label)
+                    value -= (_FLOAT)1.;
+            }
+            dx[dx_offset + idx] = value;
+        }
+#endif
+    }
+}
+#endif
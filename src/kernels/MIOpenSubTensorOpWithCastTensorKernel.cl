@@ -365,3 +365,100 @@ __kernel void SubTensorOpWithCastTensor5d(const global _FLOAT_SRC* __restrict sr
         }
     }
 }
+
+#ifndef MIOPEN_CAST_SATURATE
+#define MIOPEN_CAST_SATURATE 0
+#endif
+
+#ifndef MIOPEN_CAST_CHANNEL_SCALES
+#define MIOPEN_CAST_CHANNEL_SCALES 0
+#endif
+
+#define UNUSED __attribute__((__unused__))
+
+#if MIOPEN_SRC_TYPE == 4
+#define CAST_SRC_TO_FLOAT(x) bfloat16_to_float(x)
+#else
+#define CAST_SRC_TO_FLOAT(x) ((float)(x))
+#endif
+
+// integer destinations round to nearest even, saturation clamps to the range of the type
+#if MIOPEN_DST_TYPE == 0 && MIOPEN_CAST_SATURATE
+#define CAST_FLOAT_TO_DST(x) convert_char_sat_rte(x)
+#elif MIOPEN_DST_TYPE == 0
+#define CAST_FLOAT_TO_DST(x) convert_char_rte(x)
+#elif MIOPEN_DST_TYPE == 1 && MIOPEN_CAST_SATURATE
+#define CAST_FLOAT_TO_DST(x) convert_int_sat_rte(x)
+#elif MIOPEN_DST_TYPE == 1
+#define CAST_FLOAT_TO_DST(x) convert_int_rte(x)
+#elif MIOPEN_DST_TYPE == 4 && MIOPEN_CAST_SATURATE
+#define CAST_FLOAT_TO_DST(x) float_to_bfloat16(clamp((x), -FLT_MAX, FLT_MAX))
+#elif MIOPEN_DST_TYPE == 4
+#define CAST_FLOAT_TO_DST(x) float_to_bfloat16(x)
+#elif MIOPEN_CAST_SATURATE
+#define CAST_FLOAT_TO_DST(x) ((_FLOAT_DST)clamp((x), -(float)MAX_VAL, (float)MAX_VAL))
+#else
+#define CAST_FLOAT_TO_DST(x) ((_FLOAT_DST)(x))
+#endif
+
+// Cast with affine quantization in one pass over up to 5 flattened dimensions:
+// dst = alpha * scale[c] * (src - src_zero_point) + dst_zero_point
+// src_zero_point dequantizes an integer source, dst_zero_point quantizes into an integer
+// destination. The channel c of an element is (linear index / ch_inner) % ch_len, which holds
+// for the flattened dimensions as they keep the order of the original ones.
+// local size = (256, 1, 1)
+__kernel void SubTensorOpWithCastTensorQuant(const global _FLOAT_SRC* __restrict src,
+                                             const float alpha,
+                                             const float src_zero_point,
+                                             const float dst_zero_point,
+                                             UNUSED const global float* __restrict channel_scales,
+                                             UNUSED const uint ch_inner,
+                                             UNUSED const uint ch_len,
+                                             const int srcOffset,
+                                             const int srcStride0,
+                                             const int srcStride1,
+                                             const int srcStride2,
+                                             const int srcStride3,
+                                             const int srcStride4,
+                                             const int srcLen0,
+                                             const int srcLen1,
+                                             const int srcLen2,
+                                             const int srcLen3,
+                                             const int srcLen4,
+                                             global _FLOAT_DST* __restrict dst,
+                                             const int dstOffset,
+                                             const int dstStride0,
+                                             const int dstStride1,
+                                             const int dstStride2,
+                                             const int dstStride3,
+                                             const int dstStride4)
+{
+    const uint total = (uint)srcLen0 * srcLen1 * srcLen2 * srcLen3 * srcLen4;
+
+    for(uint gid = get_global_id(0); gid < total; gid += get_global_size(0))
+    {
+        uint rem        = gid;
+        const uint did4 = rem % srcLen4;
+        rem /= srcLen4;
+        const uint did3 = rem % srcLen3;
+        rem /= srcLen3;
+        const uint did2 = rem % srcLen2;
+        rem /= srcLen2;
+        const uint did1 = rem % srcLen1;
+        const uint did0 = rem / srcLen1;
+
+        const uint sindex = srcStride0 * did0 + srcStride1 * did1 + srcStride2 * did2 +
+                            srcStride3 * did3 + srcStride4 * did4;
+        const uint dindex = dstStride0 * did0 + dstStride1 * did1 + dstStride2 * did2 +
+                            dstStride3 * did3 + dstStride4 * did4;
+
+        float scale = alpha;
+#if MIOPEN_CAST_CHANNEL_SCALES
+        scale *= channel_scales[(gid / ch_inner) % ch_len];
+#endif
+        const float v =
+            scale * (CAST_SRC_TO_FLOAT(*(src + sindex + srcOffset)) - src_zero_point) +
+            dst_zero_point;
+        *(dst + dindex + dstOffset) = CAST_FLOAT_TO_DST(v);
+    }
+}
@@ -94,19 +94,32 @@
 #define SUBTENSOR_OP_WITH_SCALAR_SET(t, a) (t = a)
 #define SUBTENSOR_OP_WITH_SCALAR_MULTIPLY(t, a) (t *= a)
 
+// Sizes and strides are 64-bit only for tensors whose element space does not fit in int
+#ifndef MIOPEN_USE_64BIT_INDEX
+#define MIOPEN_USE_64BIT_INDEX 0
+#endif
+
+#if MIOPEN_USE_64BIT_INDEX
+typedef long index_t;
+typedef ulong uindex_t;
+#else
+typedef int index_t;
+typedef uint uindex_t;
+#endif
+
 __kernel void SubTensorOpWithScalar1d(global _FLOAT* __restrict dst,
                                       const _FLOAT alpha,
                                       const int offset,
-                                      const int stride0,
-                                      const int len0)
+                                      const index_t stride0,
+                                      const index_t len0)
 {
-    uint itmp = get_global_id(0);
+    uindex_t itmp = get_global_id(0);
 
-    const uint did0_begin = itmp / WORK_STRIDE_0;
+    const uindex_t did0_begin = itmp / WORK_STRIDE_0;
 
-    for(uint did0 = did0_begin; did0 < len0; did0 += WORK_LENGTH_0)
+    for(uindex_t did0 = did0_begin; did0 < len0; did0 += WORK_LENGTH_0)
     {
-        const uint i = stride0 * did0;
+        const uindex_t i = stride0 * did0;
 
         SUBTENSOR_OP_WITH_SCALAR(dst[i + offset], alpha);
     }
@@ -115,24 +128,24 @@ __kernel void SubTensorOpWithScalar1d(global _FLOAT* __restrict dst,
 __kernel void SubTensorOpWithScalar2d(global _FLOAT* __restrict dst,
                                       const _FLOAT alpha,
                                       const int offset,
-                                      const int stride0,
-                                      const int stride1,
-                                      const int len0,
-                                      const int len1)
+                                      const index_t stride0,
+                                      const index_t stride1,
+                                      const index_t len0,
+                                      const index_t len1)
 {
-    uint itmp = get_global_id(0);
+    uindex_t itmp = get_global_id(0);
 
-    const uint did0_begin = itmp / WORK_STRIDE_0;
+    const uindex_t did0_begin = itmp / WORK_STRIDE_0;
 
     itmp -= did0_begin * WORK_STRIDE_0;
 
-    const uint did1_begin = itmp / WORK_STRIDE_1;
+    const uindex_t did1_begin = itmp / WORK_STRIDE_1;
 
-    for(uint did0 = did0_begin; did0 < len0; did0 += WORK_LENGTH_0)
+    for(uindex_t did0 = did0_begin; did0 < len0; did0 += WORK_LENGTH_0)
     {
-        for(uint did1 = did1_begin; did1 < len1; did1 += WORK_LENGTH_1)
+        for(uindex_t did1 = did1_begin; did1 < len1; did1 += WORK_LENGTH_1)
         {
-            const uint i = stride0 * did0 + stride1 * did1;
+            const uindex_t i = stride0 * did0 + stride1 * did1;
 
             SUBTENSOR_OP_WITH_SCALAR(dst[i + offset], alpha);
         }
@@ -142,32 +155,32 @@ __kernel void SubTensorOpWithScalar2d(global _FLOAT* __restrict dst,
 __kernel void SubTensorOpWithScalar3d(global _FLOAT* __restrict dst,
                                       const _FLOAT alpha,
                                       const int offset,
-                                      const int stride0,
-                                      const int stride1,
-                                      const int stride2,
-                                      const int len0,
-                                      const int len1,
-                                      const int len2)
+                                      const index_t stride0,
+                                      const index_t stride1,
+                                      const index_t stride2,
+                                      const index_t len0,
+                                      const index_t len1,
+                                      const index_t len2)
 {
-    uint itmp = get_global_id(0);
+    uindex_t itmp = get_global_id(0);
 
-    const uint did0_begin = itmp / WORK_STRIDE_0;
+    const uindex_t did0_begin = itmp / WORK_STRIDE_0;
 
     itmp -= did0_begin * WORK_STRIDE_0;
 
-    const uint did1_begin = itmp / WORK_STRIDE_1;
+    const uindex_t did1_begin = itmp / WORK_STRIDE_1;
 
     itmp -= did1_begin * WORK_STRIDE_1;
 
-    const uint did2_begin = itmp / WORK_STRIDE_2;
+    const uindex_t did2_begin = itmp / WORK_STRIDE_2;
 
-    for(uint did0 = did0_begin; did0 < len0; did0 += WORK_LENGTH_0)
+    for(uindex_t did0 = did0_begin; did0 < len0; did0 += WORK_LENGTH_0)
     {
-        for(uint did1 = did1_begin; did1 < len1; did1 += WORK_LENGTH_1)
+        for(uindex_t did1 = did1_begin; did1 < len1; did1 += WORK_LENGTH_1)
         {
-            for(uint did2 = did2_begin; did2 < len2; did2 += WORK_LENGTH_2)
+            for(uindex_t did2 = did2_begin; did2 < len2; did2 += WORK_LENGTH_2)
             {
-                const uint i = stride0 * did0 + stride1 * did1 + stride2 * did2;
+                const uindex_t i = stride0 * did0 + stride1 * did1 + stride2 * did2;
 
                 SUBTENSOR_OP_WITH_SCALAR(dst[i + offset], alpha);
             }
@@ -178,40 +191,40 @@ __kernel void SubTensorOpWithScalar3d(global _FLOAT* __restrict dst,
 __kernel void SubTensorOpWithScalar4d(global _FLOAT* __restrict dst,
                                       const _FLOAT alpha,
                                       const int offset,
-                                      const int stride0,
-                                      const int stride1,
-                                      const int stride2,
-                                      const int stride3,
-                                      const int len0,
-                                      const int len1,
-                                      const int len2,
-                                      const int len3)
+                                      const index_t stride0,
+                                      const index_t stride1,
+                                      const index_t stride2,
+                                      const index_t stride3,
+                                      const index_t len0,
+                                      const index_t len1,
+                                      const index_t len2,
+                                      const index_t len3)
 {
-    uint itmp = get_global_id(0);
+    uindex_t itmp = get_global_id(0);
 
-    const uint did0_begin = itmp / WORK_STRIDE_0;
+    const uindex_t did0_begin = itmp / WORK_STRIDE_0;
 
     itmp -= did0_begin * WORK_STRIDE_0;
 
-    const uint did1_begin = itmp / WORK_STRIDE_1;
+    const uindex_t did1_begin = itmp / WORK_STRIDE_1;
 
     itmp -= did1_begin * WORK_STRIDE_1;
 
-    const uint did2_begin = itmp / WORK_STRIDE_2;
+    const uindex_t did2_begin = itmp / WORK_STRIDE_2;
 
     itmp -= did2_begin * WORK_STRIDE_2;
 
-    const uint did3_begin = itmp / WORK_STRIDE_3;
+    const uindex_t did3_begin = itmp / WORK_STRIDE_3;
 
-    for(uint did0 = did0_begin; did0 < len0; did0 += WORK_LENGTH_0)
+    for(uindex_t did0 = did0_begin; did0 < len0; did0 += WORK_LENGTH_0)
     {
-        for(uint did1 = did1_begin; did1 < len1; did1 += WORK_LENGTH_1)
+        for(uindex_t did1 = did1_begin; did1 < len1; did1 += WORK_LENGTH_1)
         {
-            for(uint did2 = did2_begin; did2 < len2; did2 += WORK_LENGTH_2)
+            for(uindex_t did2 = did2_begin; did2 < len2; did2 += WORK_LENGTH_2)
             {
-                for(uint did3 = did3_begin; did3 < len3; did3 += WORK_LENGTH_3)
+                for(uindex_t did3 = did3_begin; did3 < len3; did3 += WORK_LENGTH_3)
                 {
-                    const uint i =
+                    const uindex_t i =
                         stride0 * did0 + stride1 * did1 + stride2 * did2 + stride3 * did3;
 
                     SUBTENSOR_OP_WITH_SCALAR(dst[i + offset], alpha);
@@ -224,49 +237,49 @@ __kernel void SubTensorOpWithScalar4d(global _FLOAT* __restrict dst,
 __kernel void SubTensorOpWithScalar5d(global _FLOAT* __restrict dst,
                                       const _FLOAT alpha,
                                       const int offset,
-                                      const int stride0,
-                                      const int stride1,
-                                      const int stride2,
-                                      const int stride3,
-                                      const int stride4,
-                                      const int len0,
-                                      const int len1,
-                                      const int len2,
-                                      const int len3,
-                                      const int len4)
+                                      const index_t stride0,
+                                      const index_t stride1,
+                                      const index_t stride2,
+                                      const index_t stride3,
+                                      const index_t stride4,
+                                      const index_t len0,
+                                      const index_t len1,
+                                      const index_t len2,
+                                      const index_t len3,
+                                      const index_t len4)
 {
-    uint itmp = get_global_id(0);
+    uindex_t itmp = get_global_id(0);
 
-    const uint did0_begin = itmp / WORK_STRIDE_0;
+    const uindex_t did0_begin = itmp / WORK_STRIDE_0;
 
     itmp -= did0_begin * WORK_STRIDE_0;
 
-    const uint did1_begin = itmp / WORK_STRIDE_1;
+    const uindex_t did1_begin = itmp / WORK_STRIDE_1;
 
     itmp -= did1_begin * WORK_STRIDE_1;
 
-    const uint did2_begin = itmp / WORK_STRIDE_2;
+    const uindex_t did2_begin = itmp / WORK_STRIDE_2;
 
     itmp -= did2_begin * WORK_STRIDE_2;
 
-    const uint did3_begin = itmp / WORK_STRIDE_3;
+    const uindex_t did3_begin = itmp / WORK_STRIDE_3;
 
     itmp -= did3_begin * WORK_STRIDE_3;
 
-    const uint did4_begin = itmp / WORK_STRIDE_4;
+    const uindex_t did4_begin = itmp / WORK_STRIDE_4;
 
-    for(uint did0 = did0_begin; did0 < len0; did0 += WORK_LENGTH_0)
+    for(uindex_t did0 = did0_begin; did0 < len0; did0 += WORK_LENGTH_0)
     {
-        for(uint did1 = did1_begin; did1 < len1; did1 += WORK_LENGTH_1)
+        for(uindex_t did1 = did1_begin; did1 < len1; did1 += WORK_LENGTH_1)
         {
-            for(uint did2 = did2_begin; did2 < len2; did2 += WORK_LENGTH_2)
+            for(uindex_t did2 = did2_begin; did2 < len2; did2 += WORK_LENGTH_2)
             {
-                for(uint did3 = did3_begin; did3 < len3; did3 += WORK_LENGTH_3)
+                for(uindex_t did3 = did3_begin; did3 < len3; did3 += WORK_LENGTH_3)
                 {
-                    for(uint did4 = did4_begin; did4 < len4; did4 += WORK_LENGTH_4)
+                    for(uindex_t did4 = did4_begin; did4 < len4; did4 += WORK_LENGTH_4)
                     {
-                        const uint i = stride0 * did0 + stride1 * did1 + stride2 * did2 +
-                                       stride3 * did3 + stride4 * did4;
+                        const uindex_t i = stride0 * did0 + stride1 * did1 + stride2 * did2 +
+                                           stride3 * did3 + stride4 * did4;
 
                         SUBTENSOR_OP_WITH_SCALAR(dst[i + offset], alpha);
                     }
@@ -117,22 +117,35 @@
 
 #define SUBTENSOR_OP_WITH_SUBTENSOR_COPY(dst, src) (dst = src)
 
+// Sizes and strides are 64-bit only for tensors whose element space does not fit in int
+#ifndef MIOPEN_USE_64BIT_INDEX
+#define MIOPEN_USE_64BIT_INDEX 0
+#endif
+
+#if MIOPEN_USE_64BIT_INDEX
+typedef long index_t;
+typedef ulong uindex_t;
+#else
+typedef int index_t;
+typedef uint uindex_t;
+#endif
+
 __kernel void SubTensorOpWithSubTensor1d(const global _FLOAT* __restrict src,
                                          const int srcOffset,
-                                         const int srcStride0,
-                                         const int srcLen0,
+                                         const index_t srcStride0,
+                                         const index_t srcLen0,
                                          global _FLOAT* __restrict dst,
                                          const int dstOffset,
-                                         const int dstStride0)
+                                         const index_t dstStride0)
 {
-    uint itmp = get_global_id(0);
+    uindex_t itmp = get_global_id(0);
 
-    const uint did0_begin = itmp / WORK_STRIDE_0;
+    const uindex_t did0_begin = itmp / WORK_STRIDE_0;
 
-    for(uint did0 = did0_begin; did0 < srcLen0; did0 += WORK_LENGTH_0)
+    for(uindex_t did0 = did0_begin; did0 < srcLen0; did0 += WORK_LENGTH_0)
     {
-        const uint sindex = srcStride0 * did0;
-        const uint dindex = dstStride0 * did0;
+        const uindex_t sindex = srcStride0 * did0;
+        const uindex_t dindex = dstStride0 * did0;
 
         SUBTENSOR_OP_WITH_SUBTENSOR(dst[dindex + dstOffset], src[sindex + srcOffset]);
     }
@@ -140,29 +153,29 @@ __kernel void SubTensorOpWithSubTensor1d(const global _FLOAT* __restrict src,
 
 __kernel void SubTensorOpWithSubTensor2d(const global _FLOAT* __restrict src,
                                          const int srcOffset,
-                                         const int srcStride0,
-                                         const int srcStride1,
-                                         const int srcLen0,
-                                         const int srcLen1,
+                                         const index_t srcStride0,
+                                         const index_t srcStride1,
+                                         const index_t srcLen0,
+                                         const index_t srcLen1,
                                          global _FLOAT* __restrict dst,
                                          const int dstOffset,
-                                         const int dstStride0,
-                                         const int dstStride1)
+                                         const index_t dstStride0,
+                                         const index_t dstStride1)
 {
-    uint itmp = get_global_id(0);
+    uindex_t itmp = get_global_id(0);
 
-    const uint did0_begin = itmp / WORK_STRIDE_0;
+    const uindex_t did0_begin = itmp / WORK_STRIDE_0;
 
     itmp -= did0_begin * WORK_STRIDE_0;
 
-    const uint did1_begin = itmp / WORK_STRIDE_1;
+    const uindex_t did1_begin = itmp / WORK_STRIDE_1;
 
-    for(uint did0 = did0_begin; did0 < srcLen0; did0 += WORK_LENGTH_0)
+    for(uindex_t did0 = did0_begin; did0 < srcLen0; did0 += WORK_LENGTH_0)
     {
-        for(uint did1 = did1_begin; did1 < srcLen1; did1 += WORK_LENGTH_1)
+        for(uindex_t did1 = did1_begin; did1 < srcLen1; did1 += WORK_LENGTH_1)
         {
-            const uint sindex = srcStride0 * did0 + srcStride1 * did1;
-            const uint dindex = dstStride0 * did0 + dstStride1 * did1;
+            const uindex_t sindex = srcStride0 * did0 + srcStride1 * did1;
+            const uindex_t dindex = dstStride0 * did0 + dstStride1 * did1;
 
             SUBTENSOR_OP_WITH_SUBTENSOR(dst[dindex + dstOffset], src[sindex + srcOffset]);
         }
@@ -171,38 +184,38 @@ __kernel void SubTensorOpWithSubTensor2d(const global _FLOAT* __restrict src,
 
 __kernel void SubTensorOpWithSubTensor3d(const global _FLOAT* __restrict src,
                                          const int srcOffset,
-                                         const int srcStride0,
-                                         const int srcStride1,
-                                         const int srcStride2,
-                                         const int srcLen0,
-                                         const int srcLen1,
-                                         const int srcLen2,
+                                         const index_t srcStride0,
+                                         const index_t srcStride1,
+                                         const index_t srcStride2,
+                                         const index_t srcLen0,
+                                         const index_t srcLen1,
+                                         const index_t srcLen2,
                                          global _FLOAT* __restrict dst,
                                          const int dstOffset,
-                                         const int dstStride0,
-                                         const int dstStride1,
-                                         const int dstStride2)
+                                         const index_t dstStride0,
+                                         const index_t dstStride1,
+                                         const index_t dstStride2)
 {
-    uint itmp = get_global_id(0);
+    uindex_t itmp = get_global_id(0);
 
-    const uint did0_begin = itmp / WORK_STRIDE_0;
+    const uindex_t did0_begin = itmp / WORK_STRIDE_0;
 
     itmp -= did0_begin * WORK_STRIDE_0;
 
-    const uint did1_begin = itmp / WORK_STRIDE_1;
+    const uindex_t did1_begin = itmp / WORK_STRIDE_1;
 
     itmp -= did1_begin * WORK_STRIDE_1;
 
-    const uint did2_begin = itmp / WORK_STRIDE_2;
+    const uindex_t did2_begin = itmp / WORK_STRIDE_2;
 
-    for(uint did0 = did0_begin; did0 < srcLen0; did0 += WORK_LENGTH_0)
+    for(uindex_t did0 = did0_begin; did0 < srcLen0; did0 += WORK_LENGTH_0)
     {
-        for(uint did1 = did1_begin; did1 < srcLen1; did1 += WORK_LENGTH_1)
+        for(uindex_t did1 = did1_begin; did1 < srcLen1; did1 += WORK_LENGTH_1)
         {
-            for(uint did2 = did2_begin; did2 < srcLen2; did2 += WORK_LENGTH_2)
+            for(uindex_t did2 = did2_begin; did2 < srcLen2; did2 += WORK_LENGTH_2)
             {
-                const uint sindex = srcStride0 * did0 + srcStride1 * did1 + srcStride2 * did2;
-                const uint dindex = dstStride0 * did0 + dstStride1 * did1 + dstStride2 * did2;
+                const uindex_t sindex = srcStride0 * did0 + srcStride1 * did1 + srcStride2 * did2;
+                const uindex_t dindex = dstStride0 * did0 + dstStride1 * did1 + dstStride2 * did2;
 
                 SUBTENSOR_OP_WITH_SUBTENSOR(dst[dindex + dstOffset], src[sindex + srcOffset]);
             }
@@ -212,49 +225,49 @@ __kernel void SubTensorOpWithSubTensor3d(const global _FLOAT* __restrict src,
 
 __kernel void SubTensorOpWithSubTensor4d(const global _FLOAT* __restrict src,
                                          const int srcOffset,
-                                         const int srcStride0,
-                                         const int srcStride1,
-                                         const int srcStride2,
-                                         const int srcStride3,
-                                         const int srcLen0,
-                                         const int srcLen1,
-                                         const int srcLen2,
-                                         const int srcLen3,
+                                         const index_t srcStride0,
+                                         const index_t srcStride1,
+                                         const index_t srcStride2,
+                                         const index_t srcStride3,
+                                         const index_t srcLen0,
+                                         const index_t srcLen1,
+                                         const index_t srcLen2,
+                                         const index_t srcLen3,
                                          global _FLOAT* __restrict dst,
                                          const int dstOffset,
-                                         const int dstStride0,
-                                         const int dstStride1,
-                                         const int dstStride2,
-                                         const int dstStride3)
+                                         const index_t dstStride0,
+                                         const index_t dstStride1,
+                                         const index_t dstStride2,
+                                         const index_t dstStride3)
 {
-    uint itmp = get_global_id(0);
+    uindex_t itmp = get_global_id(0);
 
-    const uint did0_begin = itmp / WORK_STRIDE_0;
+    const uindex_t did0_begin = itmp / WORK_STRIDE_0;
 
     itmp -= did0_begin * WORK_STRIDE_0;
 
-    const uint did1_begin = itmp / WORK_STRIDE_1;
+    const uindex_t did1_begin = itmp / WORK_STRIDE_1;
 
     itmp -= did1_begin * WORK_STRIDE_1;
 
-    const uint did2_begin = itmp / WORK_STRIDE_2;
+    const uindex_t did2_begin = itmp / WORK_STRIDE_2;
 
     itmp -= did2_begin * WORK_STRIDE_2;
 
-    const uint did3_begin = itmp / WORK_STRIDE_3;
+    const uindex_t did3_begin = itmp / WORK_STRIDE_3;
 
-    for(uint did0 = did0_begin; did0 < srcLen0; did0 += WORK_LENGTH_0)
+    for(uindex_t did0 = did0_begin; did0 < srcLen0; did0 += WORK_LENGTH_0)
     {
-        for(uint did1 = did1_begin; did1 < srcLen1; did1 += WORK_LENGTH_1)
+        for(uindex_t did1 = did1_begin; did1 < srcLen1; did1 += WORK_LENGTH_1)
         {
-            for(uint did2 = did2_begin; did2 < srcLen2; did2 += WORK_LENGTH_2)
+            for(uindex_t did2 = did2_begin; did2 < srcLen2; did2 += WORK_LENGTH_2)
             {
-                for(uint did3 = did3_begin; did3 < srcLen3; did3 += WORK_LENGTH_3)
+                for(uindex_t did3 = did3_begin; did3 < srcLen3; did3 += WORK_LENGTH_3)
                 {
-                    const uint sindex = srcStride0 * did0 + srcStride1 * did1 + srcStride2 * did2 +
-                                        srcStride3 * did3;
-                    const uint dindex = dstStride0 * did0 + dstStride1 * did1 + dstStride2 * did2 +
-                                        dstStride3 * did3;
+                    const uindex_t sindex = srcStride0 * did0 + srcStride1 * did1 +
+                                            srcStride2 * did2 + srcStride3 * did3;
+                    const uindex_t dindex = dstStride0 * did0 + dstStride1 * did1 +
+                                            dstStride2 * did2 + dstStride3 * did3;
 
                     SUBTENSOR_OP_WITH_SUBTENSOR(dst[dindex + dstOffset], src[sindex + srcOffset]);
                 }
@@ -265,60 +278,60 @@ __kernel void SubTensorOpWithSubTensor4d(const global _FLOAT* __restrict src,
 
 __kernel void SubTensorOpWithSubTensor5d(const global _FLOAT* __restrict src,
                                          const int srcOffset,
-                                         const int srcStride0,
-                                         const int srcStride1,
-                                         const int srcStride2,
-                                         const int srcStride3,
-                                         const int srcStride4,
-                                         const int srcLen0,
-                                         const int srcLen1,
-                                         const int srcLen2,
-                                         const int srcLen3,
-                                         const int srcLen4,
+                                         const index_t srcStride0,
+                                         const index_t srcStride1,
+                                         const index_t srcStride2,
+                                         const index_t srcStride3,
+                                         const index_t srcStride4,
+                                         const index_t srcLen0,
+                                         const index_t srcLen1,
+                                         const index_t srcLen2,
+                                         const index_t srcLen3,
+                                         const index_t srcLen4,
                                          global _FLOAT* __restrict dst,
                                          const int dstOffset,
-                                         const int dstStride0,
-                                         const int dstStride1,
-                                         const int dstStride2,
-                                         const int dstStride3,
-                                         const int dstStride4)
+                                         const index_t dstStride0,
+                                         const index_t dstStride1,
+                                         const index_t dstStride2,
+                                         const index_t dstStride3,
+                                         const index_t dstStride4)
 {
-    uint itmp = get_global_id(0);
+    uindex_t itmp = get_global_id(0);
 
-    const uint did0_begin = itmp / WORK_STRIDE_0;
+    const uindex_t did0_begin = itmp / WORK_STRIDE_0;
 
     itmp -= did0_begin * WORK_STRIDE_0;
 
-    const uint did1_begin = itmp / WORK_STRIDE_1;
+    const uindex_t did1_begin = itmp / WORK_STRIDE_1;
 
     itmp -= did1_begin * WORK_STRIDE_1;
 
-    const uint did2_begin = itmp / WORK_STRIDE_2;
+    const uindex_t did2_begin = itmp / WORK_STRIDE_2;
 
     itmp -= did2_begin * WORK_STRIDE_2;
 
-    const uint did3_begin = itmp / WORK_STRIDE_3;
+    const uindex_t did3_begin = itmp / WORK_STRIDE_3;
 
     itmp -= did3_begin * WORK_STRIDE_3;
 
-    const uint did4_begin = itmp / WORK_STRIDE_4;
+    const uindex_t did4_begin = itmp / WORK_STRIDE_4;
 
-    for(uint did0 = did0_begin; did0 < srcLen0; did0 += WORK_LENGTH_0)
+    for(uindex_t did0 = did0_begin; did0 < srcLen0; did0 += WORK_LENGTH_0)
     {
-        for(uint did1 = did1_begin; did1 < srcLen1; did1 += WORK_LENGTH_1)
+        for(uindex_t did1 = did1_begin; did1 < srcLen1; did1 += WORK_LENGTH_1)
         {
-            for(uint did2 = did2_begin; did2 < srcLen2; did2 += WORK_LENGTH_2)
+            for(uindex_t did2 = did2_begin; did2 < srcLen2; did2 += WORK_LENGTH_2)
             {
-                for(uint did3 = did3_begin; did3 < srcLen3; did3 += WORK_LENGTH_3)
+                for(uindex_t did3 = did3_begin; did3 < srcLen3; did3 += WORK_LENGTH_3)
                 {
-                    for(uint did4 = did4_begin; did4 < srcLen4; did4 += WORK_LENGTH_4)
+                    for(uindex_t did4 = did4_begin; did4 < srcLen4; did4 += WORK_LENGTH_4)
                     {
-                        const uint sindex = srcStride0 * did0 + srcStride1 * did1 +
-                                            srcStride2 * did2 + srcStride3 * did3 +
-                                            srcStride4 * did4;
-                        const uint dindex = dstStride0 * did0 + dstStride1 * did1 +
-                                            dstStride2 * did2 + dstStride3 * did3 +
-                                            dstStride4 * did4;
+                        const uindex_t sindex = srcStride0 * did0 + srcStride1 * did1 +
+                                                srcStride2 * did2 + srcStride3 * did3 +
+                                                srcStride4 * did4;
+                        const uindex_t dindex = dstStride0 * did0 + dstStride1 * did1 +
+                                                dstStride2 * did2 + dstStride3 * did3 +
+                                                dstStride4 * did4;
 
                         SUBTENSOR_OP_WITH_SUBTENSOR(dst[dindex + dstOffset],
                                                     src[sindex + srcOffset]);
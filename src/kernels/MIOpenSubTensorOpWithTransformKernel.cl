@@ -330,3 +330,91 @@ __kernel void SubTensorOpWithTransform5d(global _FLOAT* __restrict src,
         }
     }
 }
+
+#ifndef TRANSPOSE_TILE_A
+#define TRANSPOSE_TILE_A 32
+#endif
+
+#ifndef TRANSPOSE_TILE_B
+#define TRANSPOSE_TILE_B 32
+#endif
+
+#ifndef TRANSPOSE_SCALE
+#define TRANSPOSE_SCALE 0
+#endif
+
+#define TRANSPOSE_TILE_SIZE (TRANSPOSE_TILE_A * TRANSPOSE_TILE_B)
+
+// Batched 2-D transpose through LDS for layout changes such as NCHW <-> NHWC / CHWN / NCHWc.
+// Dimension a is contiguous in src and dimension b in dst, the up to three other dimensions
+// are the batch. Each work-group moves a TRANSPOSE_TILE_A x TRANSPOSE_TILE_B tile: it reads it
+// along a and writes it along b, so both sides are coalesced. The extra LDS column keeps the
+// transposed reads free of bank conflicts.
+// local size = (256, 1, 1)
+// global size = (256 * tiles_a * tiles_b * batch_len0 * batch_len1 * batch_len2, 1, 1)
+__kernel void SubTensorOpWithTransposeTile(global _FLOAT* __restrict src,
+                                           const float alpha,
+                                           global _FLOAT* __restrict dst,
+                                           const float beta,
+                                           const uint src_offset,
+                                           const uint dst_offset,
+                                           const uint len_a,
+                                           const uint len_b,
+                                           const uint src_stride_b,
+                                           const uint dst_stride_a,
+                                           const uint tiles_a,
+                                           const uint tiles_b,
+                                           const uint batch_len1,
+                                           const uint batch_len2,
+                                           const uint src_batch_stride0,
+                                           const uint src_batch_stride1,
+                                           const uint src_batch_stride2,
+                                           const uint dst_batch_stride0,
+                                           const uint dst_batch_stride1,
+                                           const uint dst_batch_stride2)
+{
+    local _FLOAT tile[TRANSPOSE_TILE_B][TRANSPOSE_TILE_A + 1];
+
+    uint gid          = get_group_id(0);
+    const uint tile_a = gid % tiles_a;
+    gid /= tiles_a;
+    const uint tile_b = gid % tiles_b;
+    gid /= tiles_b;
+    const uint bid2 = gid % batch_len2;
+    gid /= batch_len2;
+    const uint bid1 = gid % batch_len1;
+    const uint bid0 = gid / batch_len1;
+
+    const uint src_base = src_offset + bid0 * src_batch_stride0 + bid1 * src_batch_stride1 +
+                          bid2 * src_batch_stride2;
+    const uint dst_base = dst_offset + bid0 * dst_batch_stride0 + bid1 * dst_batch_stride1 +
+                          bid2 * dst_batch_stride2;
+
+    const uint a0 = tile_a * TRANSPOSE_TILE_A;
+    const uint b0 = tile_b * TRANSPOSE_TILE_B;
+
+    for(uint e = get_local_id(0); e < TRANSPOSE_TILE_SIZE; e += 256)
+    {
+        const uint ia = e % TRANSPOSE_TILE_A;
+        const uint ib = e / TRANSPOSE_TILE_A;
+        if(a0 + ia < len_a && b0 + ib < len_b)
+            tile[ib][ia] = src[src_base + (b0 + ib) * src_stride_b + a0 + ia];
+    }
+
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    for(uint e = get_local_id(0); e < TRANSPOSE_TILE_SIZE; e += 256)
+    {
+        const uint ib = e % TRANSPOSE_TILE_B;
+        const uint ia = e / TRANSPOSE_TILE_B;
+        if(a0 + ia < len_a && b0 + ib < len_b)
+        {
+            const uint di = dst_base + (a0 + ia) * dst_stride_a + b0 + ib;
+#if TRANSPOSE_SCALE
+            dst[di] = (_FLOAT)(alpha * (float)tile[ib][ia] + beta * (float)dst[di]);
+#else
+            dst[di] = tile[ib][ia];
+#endif
+        }
+    }
+}
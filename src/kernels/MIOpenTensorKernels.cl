@@ -42,6 +42,19 @@
 #endif
 #endif
 
+// bfloat16 elements are held as ushort and the arithmetic is done in float, which is also the
+// type of the scaling factors.
+#if MIOPEN_USE_BFP16 == 1
+#include "bfloat16_dev.hpp"
+#define MIOPEN_ACCUM_TYPE float
+#define CVT_FLOAT2ACCUM(x) bfloat16_to_float(x)
+#define CVT_ACCUM2FLOAT(x) float_to_bfloat16(x)
+#else
+#define MIOPEN_ACCUM_TYPE MIOPEN_TYPE
+#define CVT_FLOAT2ACCUM(x) (x)
+#define CVT_ACCUM2FLOAT(x) (x)
+#endif
+
 /* Only works for NCHW
  * bitmap tracks which dims are the same between 'a' and 'c'.
  * Example: 0, 1, 1, 0 means that C and H dims are the same and the rest are ones
@@ -58,13 +71,13 @@
 
 #define UNUSED __attribute__((__unused__))
 
-MIOPEN_TYPE miopenAdd(MIOPEN_TYPE a, MIOPEN_TYPE b) { return a + b; }
+MIOPEN_ACCUM_TYPE miopenAdd(MIOPEN_ACCUM_TYPE a, MIOPEN_ACCUM_TYPE b) { return a + b; }
 
-MIOPEN_TYPE miopenMul(MIOPEN_TYPE a, MIOPEN_TYPE b) { return a * b; }
+MIOPEN_ACCUM_TYPE miopenMul(MIOPEN_ACCUM_TYPE a, MIOPEN_ACCUM_TYPE b) { return a * b; }
 
-MIOPEN_TYPE miopenMax(MIOPEN_TYPE a, MIOPEN_TYPE b) { return ((a > b) ? a : b); }
+MIOPEN_ACCUM_TYPE miopenMax(MIOPEN_ACCUM_TYPE a, MIOPEN_ACCUM_TYPE b) { return ((a > b) ? a : b); }
 
-MIOPEN_TYPE miopenMin(MIOPEN_TYPE a, MIOPEN_TYPE b) { return ((a < b) ? a : b); }
+MIOPEN_ACCUM_TYPE miopenMin(MIOPEN_ACCUM_TYPE a, MIOPEN_ACCUM_TYPE b) { return ((a < b) ? a : b); }
 
 #ifdef USE_FWD_BIAS
 
@@ -76,9 +89,9 @@ __kernel void OpTensorFwdBias(global MIOPEN_TYPE* a,
                               const int c_nstride,
                               const int c_cstride,
                               const int work_per_wg,
-                              const MIOPEN_TYPE alpha0,
-                              const MIOPEN_TYPE alpha1,
-                              const MIOPEN_TYPE beta,
+                              const MIOPEN_ACCUM_TYPE alpha0,
+                              const MIOPEN_ACCUM_TYPE alpha1,
+                              const MIOPEN_ACCUM_TYPE beta,
                               const long Aoffset,
                               const long Boffset,
                               const long Coffset,
@@ -99,7 +112,7 @@ __kernel void OpTensorFwdBias(global MIOPEN_TYPE* a,
         int lid = get_local_id(0);
 
         int o_c             = incr_wg == 1 ? (gid % b_c) : gid;
-        MIOPEN_TYPE operand = b_off[o_c] * alpha1;
+        MIOPEN_ACCUM_TYPE operand = CVT_FLOAT2ACCUM(b_off[o_c]) * alpha1;
 
         // each workgroup computes N*H*W for each C (bias-term)
         // number of workgroups = c_c (b_c)
@@ -108,7 +121,9 @@ __kernel void OpTensorFwdBias(global MIOPEN_TYPE* a,
             int o_hw     = incr_wg == 0 ? (lid % (work_per_wg / c_n)) : lid;
             int o_n      = incr_wg == 0 ? (lid / (work_per_wg / c_n)) : (gid / b_c);
             int index    = o_n * c_nstride + o_c * c_cstride + o_hw;
-            c_off[index] = MIOPEN_TENSOR_OP(a_off[index] * alpha0, operand) + beta * c_off[index];
+            c_off[index] =
+                CVT_ACCUM2FLOAT(MIOPEN_TENSOR_OP(CVT_FLOAT2ACCUM(a_off[index]) * alpha0, operand) +
+                                beta * CVT_FLOAT2ACCUM(c_off[index]));
 
             lid += get_local_size(0);
         }
@@ -132,9 +147,9 @@ __kernel void OpTensorFwdBiasGeneric(global MIOPEN_TYPE* a,
                                      const int c_nstride,
                                      const int c_cstride,
                                      const int c_hstride,
-                                     const MIOPEN_TYPE alpha0,
-                                     const MIOPEN_TYPE alpha1,
-                                     const MIOPEN_TYPE beta,
+                                     const MIOPEN_ACCUM_TYPE alpha0,
+                                     const MIOPEN_ACCUM_TYPE alpha1,
+                                     const MIOPEN_ACCUM_TYPE beta,
                                      const int work_per_wg,
                                      const long Aoffset,
                                      const long Boffset,
@@ -157,7 +172,7 @@ __kernel void OpTensorFwdBiasGeneric(global MIOPEN_TYPE* a,
         // each workgroup computes N*H*W for each C (bias-term)
         // number of workgroups = c_c (b_c)
         int o_c             = (incr_wg == 1) ? (gid % b_c) : gid;
-        MIOPEN_TYPE operand = b_off[o_c * b_cstride] * alpha1;
+        MIOPEN_ACCUM_TYPE operand = CVT_FLOAT2ACCUM(b_off[o_c * b_cstride]) * alpha1;
 
         while(lid < work_per_wg)
         {
@@ -167,7 +182,8 @@ __kernel void OpTensorFwdBiasGeneric(global MIOPEN_TYPE* a,
             int aindex = o_n * a_nstride + o_c * a_cstride + o_h * a_hstride + o_w;
             int cindex = o_n * c_nstride + o_c * c_cstride + o_h * c_hstride + o_w;
             c_off[cindex] =
-                MIOPEN_TENSOR_OP(a_off[aindex] * alpha0, operand) + beta * c_off[cindex];
+                CVT_ACCUM2FLOAT(MIOPEN_TENSOR_OP(CVT_FLOAT2ACCUM(a_off[aindex]) * alpha0, operand) +
+                                beta * CVT_FLOAT2ACCUM(c_off[cindex]));
 
             lid += get_local_size(0);
         }
@@ -188,9 +204,9 @@ __kernel void OpTensorLeadingOnes(global MIOPEN_TYPE* a,
                                   const int c_nstride,
                                   const int c_cstride,
                                   const int work_per_wg,
-                                  const MIOPEN_TYPE alpha0,
-                                  const MIOPEN_TYPE alpha1,
-                                  const MIOPEN_TYPE beta,
+                                  const MIOPEN_ACCUM_TYPE alpha0,
+                                  const MIOPEN_ACCUM_TYPE alpha1,
+                                  const MIOPEN_ACCUM_TYPE beta,
                                   const long Aoffset,
                                   const long Boffset,
                                   const long Coffset,
@@ -214,7 +230,7 @@ __kernel void OpTensorLeadingOnes(global MIOPEN_TYPE* a,
 
         int lid             = (bitmap == 0xF) ? 0 : get_local_id(0);
         int lcl_sz          = (bitmap == 0xF) ? work_per_wg : get_local_size(0);
-        MIOPEN_TYPE operand = b_off[gid] * alpha1;
+        MIOPEN_ACCUM_TYPE operand = CVT_FLOAT2ACCUM(b_off[gid]) * alpha1;
 
         int o_w = (bitmap & (1 << 0)) ? (gid % c_w) : 0;
         int o_h = (bitmap & (1 << 1)) ? ((gid / ((bitmap & (1 << 0)) ? c_w : 1)) % c_h) : 0;
@@ -229,7 +245,9 @@ __kernel void OpTensorLeadingOnes(global MIOPEN_TYPE* a,
         while(lid < work_per_wg)
         {
             int index    = o_n * c_nstride + o_c * c_cstride + o_h * c_w + o_w + lid;
-            c_off[index] = MIOPEN_TENSOR_OP(a_off[index] * alpha0, operand) + beta * c_off[index];
+            c_off[index] =
+                CVT_ACCUM2FLOAT(MIOPEN_TENSOR_OP(CVT_FLOAT2ACCUM(a_off[index]) * alpha0, operand) +
+                                beta * CVT_FLOAT2ACCUM(c_off[index]));
             lid += lcl_sz;
         }
     }
@@ -255,9 +273,9 @@ __kernel void OpTensorLeadingOnesGeneric(global MIOPEN_TYPE* a,
                                          const int c_nstride,
                                          const int c_cstride,
                                          const int c_hstride,
-                                         const MIOPEN_TYPE alpha0,
-                                         const MIOPEN_TYPE alpha1,
-                                         const MIOPEN_TYPE beta,
+                                         const MIOPEN_ACCUM_TYPE alpha0,
+                                         const MIOPEN_ACCUM_TYPE alpha1,
+                                         const MIOPEN_ACCUM_TYPE beta,
                                          const int work_per_wg,
                                          const long Aoffset,
                                          const long Boffset,
@@ -293,7 +311,7 @@ __kernel void OpTensorLeadingOnesGeneric(global MIOPEN_TYPE* a,
                          ((bitmap & (1 << 2)) ? c_c : 1));
 
         int bindex          = o_n * b_nstride + o_c * b_cstride + o_h * b_hstride + o_w;
-        MIOPEN_TYPE operand = b_off[bindex] * alpha1;
+        MIOPEN_ACCUM_TYPE operand = CVT_FLOAT2ACCUM(b_off[bindex]) * alpha1;
 
         while(lid < work_per_wg)
         {
@@ -307,7 +325,8 @@ __kernel void OpTensorLeadingOnesGeneric(global MIOPEN_TYPE* a,
             int aindex = o_n * a_nstride + o_c * a_cstride + o_h * a_hstride + o_w;
             int cindex = o_n * c_nstride + o_c * c_cstride + o_h * c_hstride + o_w;
             c_off[cindex] =
-                MIOPEN_TENSOR_OP(a_off[aindex] * alpha0, operand) + beta * c_off[cindex];
+                CVT_ACCUM2FLOAT(MIOPEN_TENSOR_OP(CVT_FLOAT2ACCUM(a_off[aindex]) * alpha0, operand) +
+                                beta * CVT_FLOAT2ACCUM(c_off[cindex]));
 
             lid += lcl_sz;
         }
@@ -336,9 +355,9 @@ __kernel void Op4dTensorGeneric(global MIOPEN_TYPE* a,
                                 const int c_nstride,
                                 const int c_cstride,
                                 const int c_hstride,
-                                const MIOPEN_TYPE alpha0,
-                                const MIOPEN_TYPE alpha1,
-                                const MIOPEN_TYPE beta,
+                                const MIOPEN_ACCUM_TYPE alpha0,
+                                const MIOPEN_ACCUM_TYPE alpha1,
+                                const MIOPEN_ACCUM_TYPE beta,
                                 const unsigned int bitmap,
                                 const int work_per_wg,
                                 const long Aoffset,
@@ -370,7 +389,7 @@ __kernel void Op4dTensorGeneric(global MIOPEN_TYPE* a,
 
         int bindex = o_n_gid_off * b_nstride + o_c_gid_off * b_cstride + o_h_gid_off * b_hstride +
                      o_w_gid_off;
-        MIOPEN_TYPE operand = b_off[bindex] * alpha1;
+        MIOPEN_ACCUM_TYPE operand = CVT_FLOAT2ACCUM(b_off[bindex]) * alpha1;
 
         while(lid < work_per_wg)
         {
@@ -382,7 +401,8 @@ __kernel void Op4dTensorGeneric(global MIOPEN_TYPE* a,
             int aindex = o_n * a_nstride + o_c * a_cstride + o_h * a_hstride + o_w;
             int cindex = o_n * c_nstride + o_c * c_cstride + o_h * c_hstride + o_w;
             c_off[cindex] =
-                MIOPEN_TENSOR_OP(a_off[aindex] * alpha0, operand) + beta * c_off[cindex];
+                CVT_ACCUM2FLOAT(MIOPEN_TENSOR_OP(CVT_FLOAT2ACCUM(a_off[aindex]) * alpha0, operand) +
+                                beta * CVT_FLOAT2ACCUM(c_off[cindex]));
 
             lid += get_local_size(0);
         }
@@ -417,9 +437,9 @@ __kernel void Op5dTensorGeneric(global MIOPEN_TYPE* a,
                                 const int c_cstride,
                                 const int c_dstride,
                                 const int c_hstride,
-                                const MIOPEN_TYPE alpha0,
-                                const MIOPEN_TYPE alpha1,
-                                const MIOPEN_TYPE beta,
+                                const MIOPEN_ACCUM_TYPE alpha0,
+                                const MIOPEN_ACCUM_TYPE alpha1,
+                                const MIOPEN_ACCUM_TYPE beta,
                                 const unsigned int bitmap,
                                 const int work_per_wg,
                                 const long Aoffset,
@@ -454,7 +474,7 @@ __kernel void Op5dTensorGeneric(global MIOPEN_TYPE* a,
         int bindex = o_n_gid_off * b_nstride + o_c_gid_off * b_cstride + o_d_gid_off * b_dstride +
                      o_h_gid_off * b_hstride + o_w_gid_off;
 
-        MIOPEN_TYPE operand = b_off[bindex] * alpha1;
+        MIOPEN_ACCUM_TYPE operand = CVT_FLOAT2ACCUM(b_off[bindex]) * alpha1;
 
         while(lid < work_per_wg)
         {
@@ -470,7 +490,8 @@ __kernel void Op5dTensorGeneric(global MIOPEN_TYPE* a,
                 o_n * c_nstride + o_c * c_cstride + o_d * c_dstride + o_h * c_hstride + o_w;
 
             c_off[cindex] =
-                MIOPEN_TENSOR_OP(a_off[aindex] * alpha0, operand) + beta * c_off[cindex];
+                CVT_ACCUM2FLOAT(MIOPEN_TENSOR_OP(CVT_FLOAT2ACCUM(a_off[aindex]) * alpha0, operand) +
+                                beta * CVT_FLOAT2ACCUM(c_off[cindex]));
 
             lid += get_local_size(0);
         }
@@ -494,9 +515,9 @@ __kernel void Op3dTensorGeneric(global MIOPEN_TYPE* a,
                                 const int c_h,
                                 const int c_nstride,
                                 const int c_cstride,
-                                const MIOPEN_TYPE alpha0,
-                                const MIOPEN_TYPE alpha1,
-                                const MIOPEN_TYPE beta,
+                                const MIOPEN_ACCUM_TYPE alpha0,
+                                const MIOPEN_ACCUM_TYPE alpha1,
+                                const MIOPEN_ACCUM_TYPE beta,
                                 const unsigned int bitmap,
                                 const int work_per_wg,
                                 const long Aoffset,
@@ -524,7 +545,7 @@ __kernel void Op3dTensorGeneric(global MIOPEN_TYPE* a,
         int o_n_gid_off = (gid / b_h) / b_c;
 
         int bindex          = o_n_gid_off * b_nstride + o_c_gid_off * b_cstride + o_h_gid_off;
-        MIOPEN_TYPE operand = b_off[bindex] * alpha1;
+        MIOPEN_ACCUM_TYPE operand = CVT_FLOAT2ACCUM(b_off[bindex]) * alpha1;
 
         while(lid < work_per_wg)
         {
@@ -536,7 +557,8 @@ __kernel void Op3dTensorGeneric(global MIOPEN_TYPE* a,
             int cindex = o_n * c_nstride + o_c * c_cstride + o_h;
 
             c_off[cindex] =
-                MIOPEN_TENSOR_OP(a_off[aindex] * alpha0, operand) + beta * c_off[cindex];
+                CVT_ACCUM2FLOAT(MIOPEN_TENSOR_OP(CVT_FLOAT2ACCUM(a_off[aindex]) * alpha0, operand) +
+                                beta * CVT_FLOAT2ACCUM(c_off[cindex]));
 
             lid += get_local_size(0);
         }
@@ -552,9 +574,9 @@ __kernel void Op2dTensorLite(const global MIOPEN_TYPE* a,
                              const int b_nstride,
                              global MIOPEN_TYPE* c,
                              const int c_nstride,
-                             const MIOPEN_TYPE alpha0,
-                             const MIOPEN_TYPE alpha1,
-                             const MIOPEN_TYPE beta,
+                             const MIOPEN_ACCUM_TYPE alpha0,
+                             const MIOPEN_ACCUM_TYPE alpha1,
+                             const MIOPEN_ACCUM_TYPE beta,
                              const long Aoffset,
                              const long Boffset,
                              const long Coffset,
@@ -602,11 +624,14 @@ __kernel void Op2dTensorLite(const global MIOPEN_TYPE* a,
 
             for(int i = 0; i < RD_BLCK; ++i)
             {
+                MIOPEN_ACCUM_TYPE c_val = CVT_FLOAT2ACCUM(c_dat[i]);
                 if(use_beta == 1)
                 {
-                    c_dat[i] *= beta;
+                    c_val *= beta;
                 }
-                c_dat[i] += MIOPEN_TENSOR_OP(a_dat[i] * alpha0, b_dat[i] * alpha1);
+                c_val += MIOPEN_TENSOR_OP(CVT_FLOAT2ACCUM(a_dat[i]) * alpha0,
+                                          CVT_FLOAT2ACCUM(b_dat[i]) * alpha1);
+                c_dat[i] = CVT_ACCUM2FLOAT(c_val);
             }
 
             *((global READ_TYPE*)(c + Coffset + c_index)) = *((READ_TYPE*)c_dat);
@@ -622,9 +647,9 @@ __kernel void Op2dTensorSquash(const global MIOPEN_TYPE* a,
                                const int b_c,
                                const int b_nstride,
                                global MIOPEN_TYPE* c,
-                               const MIOPEN_TYPE alpha0,
-                               const MIOPEN_TYPE alpha1,
-                               const MIOPEN_TYPE beta,
+                               const MIOPEN_ACCUM_TYPE alpha0,
+                               const MIOPEN_ACCUM_TYPE alpha1,
+                               const MIOPEN_ACCUM_TYPE beta,
                                const long Aoffset,
                                const long Boffset,
                                const long Coffset,
@@ -637,6 +662,9 @@ __kernel void Op2dTensorSquash(const global MIOPEN_TYPE* a,
     MIOPEN_TYPE b_dat[RD_BLCK];
     MIOPEN_TYPE c_dat[RD_BLCK];
 
+    MIOPEN_ACCUM_TYPE a_val[RD_BLCK];
+    MIOPEN_ACCUM_TYPE c_val[RD_BLCK];
+
     for(int i = 0; i < RD_BLCK; ++i)
     {
         b_dat[i] = (MIOPEN_TYPE)0;
@@ -646,8 +674,8 @@ __kernel void Op2dTensorSquash(const global MIOPEN_TYPE* a,
     {
         for(int i = 0; i < RD_BLCK; ++i)
         {
-            a_dat[i] = (MIOPEN_TYPE)0;
-            c_dat[i] = (MIOPEN_TYPE)0;
+            a_val[i] = (MIOPEN_ACCUM_TYPE)0;
+            c_val[i] = (MIOPEN_ACCUM_TYPE)0;
         }
 
         int io_index = gid * RD_BLCK;
@@ -656,7 +684,7 @@ __kernel void Op2dTensorSquash(const global MIOPEN_TYPE* a,
             *((READ_TYPE*)a_dat) = *((const global READ_TYPE*)(a + Aoffset + io_index));
             for(int i = 0; i < RD_BLCK; ++i)
             {
-                a_dat[i] *= alpha0;
+                a_val[i] = CVT_FLOAT2ACCUM(a_dat[i]) * alpha0;
             }
         }
 
@@ -665,7 +693,7 @@ __kernel void Op2dTensorSquash(const global MIOPEN_TYPE* a,
             *((READ_TYPE*)c_dat) = *((const global READ_TYPE*)(c + Coffset + io_index));
             for(int i = 0; i < RD_BLCK; ++i)
             {
-                c_dat[i] *= beta;
+                c_val[i] = CVT_FLOAT2ACCUM(c_dat[i]) * beta;
             }
         }
 
@@ -678,9 +706,13 @@ __kernel void Op2dTensorSquash(const global MIOPEN_TYPE* a,
             }
             for(int i = 0; i < RD_BLCK; ++i)
             {
-                c_dat[i] += MIOPEN_TENSOR_OP(a_dat[i], b_dat[i] * alpha1);
+                c_val[i] += MIOPEN_TENSOR_OP(a_val[i], CVT_FLOAT2ACCUM(b_dat[i]) * alpha1);
             }
         }
+        for(int i = 0; i < RD_BLCK; ++i)
+        {
+            c_dat[i] = CVT_ACCUM2FLOAT(c_val[i]);
+        }
         *((global READ_TYPE*)(c + Coffset + io_index)) = *((READ_TYPE*)c_dat);
     }
 }
@@ -696,9 +728,9 @@ __kernel void Op2dTensorGeneric(global MIOPEN_TYPE* a,
                                 global MIOPEN_TYPE* c,
                                 const int c_c,
                                 const int c_nstride,
-                                const MIOPEN_TYPE alpha0,
-                                const MIOPEN_TYPE alpha1,
-                                const MIOPEN_TYPE beta,
+                                const MIOPEN_ACCUM_TYPE alpha0,
+                                const MIOPEN_ACCUM_TYPE alpha1,
+                                const MIOPEN_ACCUM_TYPE beta,
                                 const unsigned int bitmap,
                                 const int work_per_wg,
                                 const long Aoffset,
@@ -724,7 +756,7 @@ __kernel void Op2dTensorGeneric(global MIOPEN_TYPE* a,
         int o_n_gid_off = gid / b_c;
 
         int bindex          = o_n_gid_off * b_nstride + o_c_gid_off;
-        MIOPEN_TYPE operand = b_off[bindex] * alpha1;
+        MIOPEN_ACCUM_TYPE operand = CVT_FLOAT2ACCUM(b_off[bindex]) * alpha1;
 
         while(lid < work_per_wg)
         {
@@ -733,7 +765,8 @@ __kernel void Op2dTensorGeneric(global MIOPEN_TYPE* a,
             int aindex = o_n * a_nstride + o_c;
             int cindex = o_n * c_nstride + o_c;
             c_off[cindex] =
-                MIOPEN_TENSOR_OP(a_off[aindex] * alpha0, operand) + beta * c_off[cindex];
+                CVT_ACCUM2FLOAT(MIOPEN_TENSOR_OP(CVT_FLOAT2ACCUM(a_off[aindex]) * alpha0, operand) +
+                                beta * CVT_FLOAT2ACCUM(c_off[cindex]));
             lid += get_local_size(0);
         }
     }
@@ -748,9 +781,9 @@ __kernel void Op1dTensorGeneric(global MIOPEN_TYPE* a,
                                 const int b_n,
                                 global MIOPEN_TYPE* c,
                                 const int c_n,
-                                const MIOPEN_TYPE alpha0,
-                                const MIOPEN_TYPE alpha1,
-                                const MIOPEN_TYPE beta,
+                                const MIOPEN_ACCUM_TYPE alpha0,
+                                const MIOPEN_ACCUM_TYPE alpha1,
+                                const MIOPEN_ACCUM_TYPE beta,
                                 const unsigned int bitmap,
                                 const int work_per_wg,
                                 const long Aoffset,
@@ -771,11 +804,13 @@ __kernel void Op1dTensorGeneric(global MIOPEN_TYPE* a,
         int lid             = get_local_id(0);
         int o_n_gid_off     = gid % b_n;
         int bindex          = o_n_gid_off;
-        MIOPEN_TYPE operand = b_off[bindex] * alpha1;
+        MIOPEN_ACCUM_TYPE operand = CVT_FLOAT2ACCUM(b_off[bindex]) * alpha1;
         while(lid < work_per_wg)
         {
             int o_n    = (bitmap & (1 << 0)) ? o_n_gid_off : lid % c_n;
-            c_off[o_n] = MIOPEN_TENSOR_OP(a_off[o_n] * alpha0, operand) + beta * c_off[o_n];
+            c_off[o_n] =
+                CVT_ACCUM2FLOAT(MIOPEN_TENSOR_OP(CVT_FLOAT2ACCUM(a_off[o_n]) * alpha0, operand) +
+                                beta * CVT_FLOAT2ACCUM(c_off[o_n]));
             lid += get_local_size(0);
         }
     }
@@ -797,9 +832,9 @@ __kernel void Op1dTensorGeneric(global MIOPEN_TYPE* a,
 __kernel void Op4dTensorLite(const global MIOPEN_TYPE* a,
                              const global MIOPEN_TYPE* b,
                              global MIOPEN_TYPE* c,
-                             const MIOPEN_TYPE alpha0,
-                             const MIOPEN_TYPE alpha1,
-                             const MIOPEN_TYPE beta,
+                             const MIOPEN_ACCUM_TYPE alpha0,
+                             const MIOPEN_ACCUM_TYPE alpha1,
+                             const MIOPEN_ACCUM_TYPE beta,
                              const long Aoffset,
                              const long Boffset,
                              const long Coffset,
@@ -830,11 +865,14 @@ __kernel void Op4dTensorLite(const global MIOPEN_TYPE* a,
 
         for(int i = 0; i < RD_BLCK; ++i)
         {
+            MIOPEN_ACCUM_TYPE c_val = CVT_FLOAT2ACCUM(c_dat[i]);
             if(use_beta == 1)
             {
-                c_dat[i] *= beta;
+                c_val *= beta;
             }
-            c_dat[i] += MIOPEN_TENSOR_OP(a_dat[i] * alpha0, b_dat[i] * alpha1);
+            c_val += MIOPEN_TENSOR_OP(CVT_FLOAT2ACCUM(a_dat[i]) * alpha0,
+                                      CVT_FLOAT2ACCUM(b_dat[i]) * alpha1);
+            c_dat[i] = CVT_ACCUM2FLOAT(c_val);
         }
 
         *((global READ_TYPE*)(c + index + Coffset)) = *((READ_TYPE*)c_dat);
@@ -842,3 +880,340 @@ __kernel void Op4dTensorLite(const global MIOPEN_TYPE* a,
 }
 
 #endif
+
+#ifdef USE_ND_TENSOR_LITE
+// Collapsed (rows x cols) problem whose cols are contiguous in a and c.
+// B_COL_STRIDE: 1 when b runs along the cols (elementwise / row broadcast),
+//               0 when b is constant along them (column broadcast)
+// RD_BLCK divides cols and every row stride / offset that is read as a vector
+// local size = (256, 1, 1)
+// global size = (256 * min(ceil(rows * cols / RD_BLCK / 256), MAX_NUM_WG), 1, 1)
+__kernel void OpTensorNdLite(const global MIOPEN_TYPE* a,
+                             const long a_rstride,
+                             const global MIOPEN_TYPE* b,
+                             const long b_rstride,
+                             global MIOPEN_TYPE* c,
+                             const long c_rstride,
+                             const MIOPEN_ACCUM_TYPE alpha0,
+                             const MIOPEN_ACCUM_TYPE alpha1,
+                             const MIOPEN_ACCUM_TYPE beta,
+                             const long Aoffset,
+                             const long Boffset,
+                             const long Coffset,
+                             const long cols_vec,
+                             const long total_work,
+                             const int use_beta)
+{
+    MIOPEN_TYPE a_dat[RD_BLCK];
+    MIOPEN_TYPE b_dat[RD_BLCK];
+    MIOPEN_TYPE c_dat[RD_BLCK];
+
+    for(long gid = get_global_id(0); gid < total_work; gid += get_global_size(0))
+    {
+        long row = gid / cols_vec;
+        long col = (gid - row * cols_vec) * RD_BLCK;
+
+        long a_index = Aoffset + row * a_rstride + col;
+        long c_index = Coffset + row * c_rstride + col;
+
+        *((READ_TYPE*)a_dat) = *((const global READ_TYPE*)(a + a_index));
+#if B_COL_STRIDE == 1
+        *((READ_TYPE*)b_dat) = *((const global READ_TYPE*)(b + Boffset + row * b_rstride + col));
+#else
+        MIOPEN_TYPE b_val = b[Boffset + row * b_rstride];
+        for(int i = 0; i < RD_BLCK; ++i)
+        {
+            b_dat[i] = b_val;
+        }
+#endif
+
+        for(int i = 0; i < RD_BLCK; ++i)
+        {
+            c_dat[i] = (MIOPEN_TYPE)0;
+        }
+        if(use_beta == 1)
+        {
+            *((READ_TYPE*)c_dat) = *((const global READ_TYPE*)(c + c_index));
+        }
+
+        for(int i = 0; i < RD_BLCK; ++i)
+        {
+            MIOPEN_ACCUM_TYPE c_val = CVT_FLOAT2ACCUM(c_dat[i]);
+            if(use_beta == 1)
+            {
+                c_val *= beta;
+            }
+            c_val += MIOPEN_TENSOR_OP(CVT_FLOAT2ACCUM(a_dat[i]) * alpha0,
+                                      CVT_FLOAT2ACCUM(b_dat[i]) * alpha1);
+            c_dat[i] = CVT_ACCUM2FLOAT(c_val);
+        }
+
+        *((global READ_TYPE*)(c + c_index)) = *((READ_TYPE*)c_dat);
+    }
+}
+
+#endif
+
+#ifdef USE_ND_TENSOR_GENERIC
+// Up to 8 collapsed dimensions, innermost first: dimK = (length, a stride, b stride, c stride),
+// b stride is 0 along broadcast dimensions. MIOPEN_ND_DIMS of them are in use.
+// local size = (256, 1, 1)
+// global size = (256 * min(ceil(TENS_LEN / 256), MAX_NUM_WG), 1, 1)
+#define ND_TENSOR_STEP(dim)           \
+    {                                 \
+        long i = rem % (dim).x;       \
+        rem /= (dim).x;               \
+        a_index += i * (long)(dim).y; \
+        b_index += i * (long)(dim).z; \
+        c_index += i * (long)(dim).w; \
+    }
+
+__kernel void OpTensorNdGeneric(const global MIOPEN_TYPE* a,
+                                const global MIOPEN_TYPE* b,
+                                global MIOPEN_TYPE* c,
+                                const uint4 dim0,
+                                UNUSED const uint4 dim1,
+                                UNUSED const uint4 dim2,
+                                UNUSED const uint4 dim3,
+                                UNUSED const uint4 dim4,
+                                UNUSED const uint4 dim5,
+                                UNUSED const uint4 dim6,
+                                UNUSED const uint4 dim7,
+                                const MIOPEN_ACCUM_TYPE alpha0,
+                                const MIOPEN_ACCUM_TYPE alpha1,
+                                const MIOPEN_ACCUM_TYPE beta,
+                                const long Aoffset,
+                                const long Boffset,
+                                const long Coffset,
+                                const long total_work,
+                                const int use_beta)
+{
+    for(long gid = get_global_id(0); gid < total_work; gid += get_global_size(0))
+    {
+        long rem     = gid;
+        long a_index = Aoffset;
+        long b_index = Boffset;
+        long c_index = Coffset;
+
+        ND_TENSOR_STEP(dim0)
+#if MIOPEN_ND_DIMS > 1
+        ND_TENSOR_STEP(dim1)
+#endif
+#if MIOPEN_ND_DIMS > 2
+        ND_TENSOR_STEP(dim2)
+#endif
+#if MIOPEN_ND_DIMS > 3
+        ND_TENSOR_STEP(dim3)
+#endif
+#if MIOPEN_ND_DIMS > 4
+        ND_TENSOR_STEP(dim4)
+#endif
+#if MIOPEN_ND_DIMS > 5
+        ND_TENSOR_STEP(dim5)
+#endif
+#if MIOPEN_ND_DIMS > 6
+        ND_TENSOR_STEP(dim6)
+#endif
+#if MIOPEN_ND_DIMS > 7
+        ND_TENSOR_STEP(dim7)
+#endif
+
+        MIOPEN_ACCUM_TYPE c_val = use_beta == 1 ? beta * CVT_FLOAT2ACCUM(c[c_index]) : 0;
+        c_val += MIOPEN_TENSOR_OP(CVT_FLOAT2ACCUM(a[a_index]) * alpha0,
+                                  CVT_FLOAT2ACCUM(b[b_index]) * alpha1);
+        c[c_index] = CVT_ACCUM2FLOAT(c_val);
+    }
+}
+
+#endif
+
+#ifdef USE_MULTI_TENSOR_OPTIMIZER
+// One optimizer step over up to MT_SLOTS (16) tensors per launch. Slot k is passed as its own
+// parameter, gradient, first and second fp32 state buffers and element count; unused slots have
+// 0 elements. MT_MODE follows miopenOptimizerMode_t: 0 SGD, 1 momentum, 2 Adam, 3 LAMB.
+// bc1 and bc2 are the Adam bias corrections 1 - beta1^step and 1 - beta2^step.
+// local size = (MT_LOCAL_SIZE, 1, 1)
+#define MT_FOR_SLOTS(X) \
+    X(0) X(1) X(2) X(3) X(4) X(5) X(6) X(7) X(8) X(9) X(10) X(11) X(12) X(13) X(14) X(15)
+
+#define MT_PARAM_ARG(k) global MIOPEN_TYPE* p##k,
+#define MT_GRAD_ARG(k) UNUSED const global MIOPEN_TYPE* g##k,
+#define MT_M_ARG(k) UNUSED global float* m##k,
+#define MT_V_ARG(k) UNUSED global float* v##k,
+#define MT_N_ARG(k) const long n##k,
+
+#define MT_TENSOR_ARGS         \
+    MT_FOR_SLOTS(MT_PARAM_ARG) \
+    MT_FOR_SLOTS(MT_GRAD_ARG)  \
+    MT_FOR_SLOTS(MT_M_ARG)     \
+    MT_FOR_SLOTS(MT_V_ARG)     \
+    MT_FOR_SLOTS(MT_N_ARG)
+
+#define MT_HYPER_ARGS             \
+    const float lr,               \
+        UNUSED const float beta1, \
+        UNUSED const float beta2, \
+        UNUSED const float eps,   \
+        const float wd,           \
+        UNUSED const float bc1,   \
+        UNUSED const float bc2
+
+#define MT_HYPER lr, beta1, beta2, eps, wd, bc1, bc2
+
+float MultiTensorAdamDir(float m, float v, float bc1, float bc2, float eps)
+{
+    return (m / bc1) / (sqrt(v / bc2) + eps);
+}
+
+#if MT_MODE != 3
+void MultiTensorUpdate(global MIOPEN_TYPE* p,
+                       const global MIOPEN_TYPE* g,
+                       UNUSED global float* m,
+                       UNUSED global float* v,
+                       const long i,
+                       MT_HYPER_ARGS)
+{
+    float w = (float)CVT_FLOAT2ACCUM(p[i]);
+    float d = (float)CVT_FLOAT2ACCUM(g[i]) + wd * w;
+#if MT_MODE == 0
+    w -= lr * d;
+#elif MT_MODE == 1
+    float mom = beta1 * m[i] + d;
+    m[i]      = mom;
+    w -= lr * mom;
+#else
+    float mm = beta1 * m[i] + (1.0f - beta1) * d;
+    float vv = beta2 * v[i] + (1.0f - beta2) * d * d;
+    m[i]     = mm;
+    v[i]     = vv;
+    w -= lr * MultiTensorAdamDir(mm, vv, bc1, bc2, eps);
+#endif
+    p[i] = (MIOPEN_TYPE)CVT_ACCUM2FLOAT(w);
+}
+
+// the slots are laid end to end along the grid
+// global size = (MT_LOCAL_SIZE * min(ceil(total_work / MT_LOCAL_SIZE), MAX_NUM_WG), 1, 1)
+__kernel void MultiTensorOptimizer(MT_TENSOR_ARGS MT_HYPER_ARGS, const long total_work)
+{
+    for(long gid = get_global_id(0); gid < total_work; gid += get_global_size(0))
+    {
+        long i = gid;
+#define MT_UPDATE_SLOT(k)                                       \
+    if(i >= 0 && i < n##k)                                      \
+        MultiTensorUpdate(p##k, g##k, m##k, v##k, i, MT_HYPER); \
+    i -= n##k;
+
+        MT_FOR_SLOTS(MT_UPDATE_SLOT)
+    }
+}
+
+#else
+// LAMB scales the update of every tensor by ||w|| / ||r||, so it runs in two launches over the
+// same grid of MT_LAMB_GROUPS work-groups per slot. The first one updates the moments and writes
+// the partial sums of w^2 and r^2 of each work-group to norms, the second one adds them up and
+// applies w -= lr * ratio * r, recomputing r from the new moments.
+// global size = (MT_LOCAL_SIZE * MT_LAMB_GROUPS * MT_SLOTS, 1, 1)
+float MultiTensorLambDir(float w, float m, float v, MT_HYPER_ARGS)
+{
+    return MultiTensorAdamDir(m, v, bc1, bc2, eps) + wd * w;
+}
+
+void MultiTensorLambNormsSlot(global MIOPEN_TYPE* p,
+                              const global MIOPEN_TYPE* g,
+                              global float* m,
+                              global float* v,
+                              const long n,
+                              MT_HYPER_ARGS,
+                              local float* lcl_w,
+                              local float* lcl_r,
+                              global float* norms)
+{
+    const uint lid = get_local_id(0);
+    float w2       = 0;
+    float r2       = 0;
+
+    for(long i = (get_group_id(0) % MT_LAMB_GROUPS) * MT_LOCAL_SIZE + lid; i < n;
+        i += MT_LAMB_GROUPS * MT_LOCAL_SIZE)
+    {
+        float w  = (float)CVT_FLOAT2ACCUM(p[i]);
+        float d  = (float)CVT_FLOAT2ACCUM(g[i]);
+        float mm = beta1 * m[i] + (1.0f - beta1) * d;
+        float vv = beta2 * v[i] + (1.0f - beta2) * d * d;
+        m[i]     = mm;
+        v[i]     = vv;
+        float r  = MultiTensorLambDir(w, mm, vv, MT_HYPER);
+        w2 += w * w;
+        r2 += r * r;
+    }
+
+    lcl_w[lid] = w2;
+    lcl_r[lid] = r2;
+    barrier(CLK_LOCAL_MEM_FENCE);
+    for(uint s = MT_LOCAL_SIZE / 2; s > 0; s >>= 1)
+    {
+        if(lid < s)
+        {
+            lcl_w[lid] += lcl_w[lid + s];
+            lcl_r[lid] += lcl_r[lid + s];
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+
+    if(lid == 0)
+    {
+        norms[2 * get_group_id(0)]     = lcl_w[0];
+        norms[2 * get_group_id(0) + 1] = lcl_r[0];
+    }
+}
+
+__kernel void MultiTensorLambNorms(MT_TENSOR_ARGS MT_HYPER_ARGS, global float* norms)
+{
+    local float lcl_w[MT_LOCAL_SIZE];
+    local float lcl_r[MT_LOCAL_SIZE];
+
+    const uint slot = get_group_id(0) / MT_LAMB_GROUPS;
+#define MT_LAMB_NORMS_SLOT(k) \
+    if(slot == k)             \
+        MultiTensorLambNormsSlot(p##k, g##k, m##k, v##k, n##k, MT_HYPER, lcl_w, lcl_r, norms);
+
+    MT_FOR_SLOTS(MT_LAMB_NORMS_SLOT)
+}
+
+void MultiTensorLambApplySlot(global MIOPEN_TYPE* p,
+                              const global float* m,
+                              const global float* v,
+                              const long n,
+                              MT_HYPER_ARGS,
+                              const global float* norms)
+{
+    const uint first = (get_group_id(0) / MT_LAMB_GROUPS) * MT_LAMB_GROUPS;
+    float w2         = 0;
+    float r2         = 0;
+    for(uint j = first; j < first + MT_LAMB_GROUPS; j++)
+    {
+        w2 += norms[2 * j];
+        r2 += norms[2 * j + 1];
+    }
+    float ratio = (w2 > 0 && r2 > 0) ? sqrt(w2) / sqrt(r2) : 1.0f;
+
+    for(long i = (get_group_id(0) % MT_LAMB_GROUPS) * MT_LOCAL_SIZE + get_local_id(0); i < n;
+        i += MT_LAMB_GROUPS * MT_LOCAL_SIZE)
+    {
+        float w = (float)CVT_FLOAT2ACCUM(p[i]);
+        w -= lr * ratio * MultiTensorLambDir(w, m[i], v[i], MT_HYPER);
+        p[i] = (MIOPEN_TYPE)CVT_ACCUM2FLOAT(w);
+    }
+}
+
+__kernel void MultiTensorLambApply(MT_TENSOR_ARGS MT_HYPER_ARGS, const global float* norms)
+{
+    const uint slot = get_group_id(0) / MT_LAMB_GROUPS;
+#define MT_LAMB_APPLY_SLOT(k) \
+    if(slot == k)             \
+        MultiTensorLambApplySlot(p##k, m##k, v##k, n##k, MT_HYPER, norms);
+
+    MT_FOR_SLOTS(MT_LAMB_APPLY_SLOT)
+}
+
+#endif
+#endif
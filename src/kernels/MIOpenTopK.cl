@@ -0,0 +1,168 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "float_types.h"
+
+// The k best elements along one dimension of a packed tensor, with their indices along that
+// dimension. A work-group sorts one row: the best TOPK_P elements seen so far stay ranked in
+// local memory, and each chunk of TOPK_CHUNK elements of the row is bitonic sorted and merged
+// into them. Elements of equal value rank by index, so the result does not depend on the
+// scheduling. NaNs rank before all the other values.
+//
+// TOPK_LOCAL    work-group size
+// TOPK_P        a power of 2 not less than k
+// TOPK_CHUNK    elements sorted at a time, a power of 2 not less than TOPK_P
+// TOPK_LARGEST  1 for the largest elements, 0 for the smallest
+
+#ifndef TOPK_LOCAL
+#define TOPK_LOCAL 256
+#endif
+
+#ifndef TOPK_LARGEST
+#define TOPK_LARGEST 1
+#endif
+
+#define TOPK_NO_INDEX 0x7fffffff
+
+// The smallest elements are the largest of the negated ones.
+#if TOPK_LARGEST
+#define TOPK_KEY(x) (x)
+#else
+#define TOPK_KEY(x) (-(x))
+#endif
+
+// true when (a, ia) ranks before (b, ib)
+static inline bool TopKBefore(_FLOAT_ACCUM a, int ia, _FLOAT_ACCUM b, int ib)
+{
+    const bool a_nan = isnan(a);
+    const bool b_nan = isnan(b);
+    if(a_nan != b_nan)
+        return a_nan;
+    if(!a_nan && a != b)
+        return a > b;
+    return ia < ib;
+}
+
+static inline void TopKSwap(local _FLOAT_ACCUM* key, local int* idx, uint i, uint j)
+{
+    const _FLOAT_ACCUM k = key[i];
+    const int n          = idx[i];
+    key[i]               = key[j];
+    idx[i]               = idx[j];
+    key[j]               = k;
+    idx[j]               = n;
+}
+
+// Index of the t-th pair of a compare-exchange step with pairs stride apart.
+static inline uint TopKPairFirst(uint t, uint stride) { return 2 * t - (t & (stride - 1)); }
+
+__kernel void MIOpenTopK(const global _FLOAT* __restrict x,
+                         global _FLOAT* __restrict values,
+                         global int* __restrict indices,
+                         const uint len,
+                         const uint k,
+                         const uint inner)
+{
+    // [0, TOPK_P) the best elements so far, best first, [TOPK_P, TOPK_P + TOPK_CHUNK) a chunk
+    local _FLOAT_ACCUM lcl_key[TOPK_P + TOPK_CHUNK];
+    local int lcl_idx[TOPK_P + TOPK_CHUNK];
+
+    const uint lid      = get_local_id(0);
+    const uint row      = get_group_id(0);
+    const uint outer_id = row / inner;
+    const uint inner_id = row % inner;
+
+    const global _FLOAT* x_row = x + (size_t)outer_id * len * inner + inner_id;
+    local _FLOAT_ACCUM* chunk_key = lcl_key + TOPK_P;
+    local int* chunk_idx          = lcl_idx + TOPK_P;
+
+    for(uint i = lid; i < TOPK_P; i += TOPK_LOCAL)
+    {
+        lcl_key[i] = (_FLOAT_ACCUM)(-INFINITY);
+        lcl_idx[i] = TOPK_NO_INDEX;
+    }
+
+    for(uint base = 0; base < len; base += TOPK_CHUNK)
+    {
+        for(uint i = lid; i < TOPK_CHUNK; i += TOPK_LOCAL)
+        {
+            const uint j = base + i;
+            chunk_key[i] = j < len ? TOPK_KEY(CVT_FLOAT2ACCUM(x_row[(size_t)j * inner]))
+                                   : (_FLOAT_ACCUM)(-INFINITY);
+            chunk_idx[i] = j < len ? (int)j : TOPK_NO_INDEX;
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        // Sort the chunk worst first.
+        for(uint size = 2; size <= TOPK_CHUNK; size <<= 1)
+        {
+            for(uint stride = size / 2; stride > 0; stride >>= 1)
+            {
+                for(uint t = lid; t < TOPK_CHUNK / 2; t += TOPK_LOCAL)
+                {
+                    const uint i   = TopKPairFirst(t, stride);
+                    const uint j   = i + stride;
+                    const bool asc = (i & size) == 0;
+                    if(TopKBefore(chunk_key[i], chunk_idx[i], chunk_key[j], chunk_idx[j]) == asc)
+                        TopKSwap(chunk_key, chunk_idx, i, j);
+                }
+                barrier(CLK_LOCAL_MEM_FENCE);
+            }
+        }
+
+        // Pairing the i-th best so far with the (TOPK_P - 1 - i)-th best of the chunk, the better
+        // ones of the pairs are the TOPK_P best of both and form a bitonic sequence.
+        for(uint i = lid; i < TOPK_P; i += TOPK_LOCAL)
+        {
+            const uint j = TOPK_CHUNK - TOPK_P + i;
+            if(TopKBefore(chunk_key[j], chunk_idx[j], lcl_key[i], lcl_idx[i]))
+            {
+                lcl_key[i] = chunk_key[j];
+                lcl_idx[i] = chunk_idx[j];
+            }
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        for(uint stride = TOPK_P / 2; stride > 0; stride >>= 1)
+        {
+            for(uint t = lid; t < TOPK_P / 2; t += TOPK_LOCAL)
+            {
+                const uint i = TopKPairFirst(t, stride);
+                const uint j = i + stride;
+                if(TopKBefore(lcl_key[j], lcl_idx[j], lcl_key[i], lcl_idx[i]))
+                    TopKSwap(lcl_key, lcl_idx, i, j);
+            }
+            barrier(CLK_LOCAL_MEM_FENCE);
+        }
+    }
+
+    const size_t out_base = (size_t)outer_id * k * inner + inner_id;
+    for(uint i = lid; i < k; i += TOPK_LOCAL)
+    {
+        values[out_base + (size_t)i * inner]  = CVT_ACCUM2FLOAT(TOPK_KEY(lcl_key[i]));
+        indices[out_base + (size_t)i * inner] = lcl_idx[i];
+    }
+}
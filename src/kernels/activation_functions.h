@@ -3,6 +3,11 @@
 #define MIOPEN_NRN_OP_ID 0
 #endif
 
+// The backward pass gets y in place of x: bot_data holds y, see miopenActivationBackward.
+#ifndef MIOPEN_NRN_FROM_TOP
+#define MIOPEN_NRN_FROM_TOP 0
+#endif
+
 #define MIOPEN_NEURON_PASTHRU 0      // x
 #define MIOPEN_NEURON_LOGISTIC 1     // 1 / (1 + e^-x)  //Sigmoid
 #define MIOPEN_NEURON_TANH 2         // beta * tanh(alpha * x)
@@ -401,8 +406,14 @@ void ActivationFunction_Clipped_ReLU_Diff(const uint n,
 {
     for(uint i = 0; i < n; ++i)
     {
+#if MIOPEN_NRN_FROM_TOP
+        // y == alpha for all x >= alpha, so the clipping point itself counts as clipped.
+        bot_diff[i] = top_diff[i] * ((bot_data[i] > 0 && bot_data[i] < alpha) ? (_FLOAT_PREC)1.f
+                                                                              : (_FLOAT_PREC)0.f);
+#else
         bot_diff[i] = top_diff[i] * ((bot_data[i] > 0 && bot_data[i] <= alpha) ? (_FLOAT_PREC)1.f
                                                                                : (_FLOAT_PREC)0.f);
+#endif
     }
 }
 
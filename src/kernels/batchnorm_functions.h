@@ -61,6 +61,21 @@
 
 #define _FLOAT_PREC4 PPCAT(_FLOAT_PREC, FOUR)
 
+// Vectors of the data in the precision of the arithmetic and back.
+#define _FLOAT_ACCUM2 float2
+#define _FLOAT_ACCUM4 float4
+#define _CVT_ACCUM2 convert_float2
+#define _CVT_ACCUM4 convert_float4
+#define _CVT_FLOAT2 PPCAT(convert_, _FLOAT2)
+#define _CVT_FLOAT4 PPCAT(convert_, _FLOAT4)
+
+// fp16 data, with either fp16 or fp32 scale, bias and statistics.
+#if MIOPEN_USE_FP16 == 1 || MIOPEN_USE_FPMIX == 1
+#define MIO_BN_HALF 1
+#else
+#define MIO_BN_HALF 0
+#endif
+
 #ifndef MIO_BN_LDSGCN_SIZE
 #define MIO_BN_LDSGCN_SIZE 16
 #endif
@@ -0,0 +1,445 @@
+#ifndef CK_GRIDWISE_CONVOLUTION_IMPLICIT_GEMM_XDLOPS_DYNAMIC_NCHW_KCYX_NKHW_HPP
+#define CK_GRIDWISE_CONVOLUTION_IMPLICIT_GEMM_XDLOPS_DYNAMIC_NCHW_KCYX_NKHW_HPP
+
+#include "common_header.hpp"
+
+// Implicit GEMM convolutions which take the problem sizes as kernel arguments, so that one
+// binary per tile configuration and data type serves every shape. The GEMM views of the
+// tensors are computed with run-time index arithmetic instead of compile-time tensor
+// descriptors, and the block tile is multiplied with fp32 xdlops (mfma 32x32x2).
+
+namespace ck {
+
+// p[i] += v, for the GEMMs whose K is split between blocks
+__device__ void atomic_add_c(float* p, index_t i, float v)
+{
+#if CK_USE_AMD_BUFFER_ATOMIC_ADD
+    amd_buffer_atomic_add<float, 1>(&v, p, i, 0);
+#else
+    atomicAdd(&p[i], v);
+#endif
+}
+
+// p[i] += v[0], p[i + 1] += v[1] with one packed atomic, i should be even
+__device__ void atomic_add_c(half_t* p, index_t i, half2_t v)
+{
+#if CK_USE_AMD_BUFFER_ATOMIC_ADD
+    amd_buffer_atomic_add<half_t, 2>(reinterpret_cast<const half_t*>(&v), p, i, 0);
+#else
+    union
+    {
+        half2_t pair;
+        unsigned int word;
+    } assumed, sum;
+
+    unsigned int* p_word = reinterpret_cast<unsigned int*>(&p[i]);
+    unsigned int old     = *p_word;
+
+    do
+    {
+        assumed.word = old;
+        sum.pair     = assumed.pair + v;
+        old          = atomicCAS(p_word, assumed.word, sum.word);
+    } while(old != assumed.word);
+#endif
+}
+
+// p[i] += v for the lanes with in_range set, called by all the lanes of a wave together. For
+// fp16 the lanes holding elements i and i + 1 are neighbours, the even one adds both. There are
+// no atomics for bfloat16.
+__device__ void atomic_add_c_wave(float* p, index_t i, float v, bool in_range)
+{
+    if(in_range)
+        atomic_add_c(p, i, v);
+}
+
+__device__ void atomic_add_c_wave(half_t* p, index_t i, float v, bool in_range)
+{
+    const float v_next = __shfl_xor(v, 1);
+
+    if(in_range && i % 2 == 0)
+        atomic_add_c(p, i, half2_t{type_convert<half_t>{}(v), type_convert<half_t>{}(v_next)});
+}
+
+__device__ void atomic_add_c_wave(ushort*, index_t, float, bool) {}
+
+// The G groups are independent GEMMs of the sizes below, with C and K standing for the channels
+// of one group. Group g reads and writes channels [g * C / G, (g + 1) * C / G) of the images
+// and the filters [g * K / G, (g + 1) * K / G). StoreC is called by all the lanes of a wave
+// together with the K block they reduce, also for the out-of-range elements of C which it
+// should drop.
+
+// forward: C[K, N * Ho * Wo] = A[C * Y * X, K]^T * B[C * Y * X, N * Ho * Wo].
+// The reduction over C * Y * X may be split between KBlocks blocks, which add their partial
+// results to the zero-initialized output. fp16 needs an even Ho * Wo, so that the pairs of
+// adjacent elements stay within one image. KBlocks should be 1 for bfloat16.
+template <class Float, class FloatOut>
+struct DynamicConvFwdGemm_nchw_kcyx_nkhw
+{
+    const Float* p_in;
+    const Float* p_wei;
+    FloatOut* p_out;
+
+    index_t G, N, C, Hi, Wi, K, Y, X, Ho, Wo;
+    index_t ConvStrideH, ConvStrideW, ConvDilationH, ConvDilationW, InLeftPadH, InLeftPadW;
+    index_t KBlocks;
+
+    __device__ index_t GetGemmG() const { return G; }
+    __device__ index_t GetGemmM() const { return K / G; }
+    __device__ index_t GetGemmN() const { return N * Ho * Wo; }
+    __device__ index_t GetGemmK() const { return (C / G) * Y * X; }
+    __device__ index_t GetGemmKBlocks() const { return KBlocks; }
+
+    __device__ float LoadA(index_t g, index_t gemm_k, index_t gemm_m) const
+    {
+        return type_convert<float>{}(p_wei[(g * GetGemmM() + gemm_m) * GetGemmK() + gemm_k]);
+    }
+
+    __device__ float LoadB(index_t g, index_t gemm_k, index_t gemm_n) const
+    {
+        const index_t c  = gemm_k / (Y * X);
+        const index_t y  = (gemm_k - c * Y * X) / X;
+        const index_t x  = gemm_k - (c * Y + y) * X;
+        const index_t n  = gemm_n / (Ho * Wo);
+        const index_t ho = (gemm_n - n * Ho * Wo) / Wo;
+        const index_t wo = gemm_n - (n * Ho + ho) * Wo;
+
+        const index_t hi = ho * ConvStrideH + y * ConvDilationH - InLeftPadH;
+        const index_t wi = wo * ConvStrideW + x * ConvDilationW - InLeftPadW;
+
+        if(hi < 0 || hi >= Hi || wi < 0 || wi >= Wi)
+            return 0;
+
+        return type_convert<float>{}(p_in[((n * C + g * (C / G) + c) * Hi + hi) * Wi + wi]);
+    }
+
+    __device__ void StoreC(index_t g, index_t gemm_m, index_t gemm_n, index_t, float v) const
+    {
+        const bool in_range = gemm_m < GetGemmM() && gemm_n < GetGemmN();
+        const index_t n     = gemm_n / (Ho * Wo);
+        const index_t howo  = gemm_n - n * Ho * Wo;
+        const index_t i     = (n * K + g * GetGemmM() + gemm_m) * Ho * Wo + howo;
+
+        if(KBlocks == 1)
+        {
+            if(in_range)
+                p_out[i] = type_convert<FloatOut>{}(v);
+        }
+        else
+        {
+            atomic_add_c_wave(p_out, i, v, in_range);
+        }
+    }
+};
+
+// backward data: C[C, N * Hi * Wi] = A[K * Y * X, C]^T * B[K * Y * X, N * Hi * Wi],
+// where B gathers the output gradient pixels which each input pixel contributed to
+template <class Float>
+struct DynamicConvBwdDataGemm_nchw_kcyx_nkhw
+{
+    Float* p_in;
+    const Float* p_wei;
+    const Float* p_out;
+
+    index_t G, N, C, Hi, Wi, K, Y, X, Ho, Wo;
+    index_t ConvStrideH, ConvStrideW, ConvDilationH, ConvDilationW, InLeftPadH, InLeftPadW;
+
+    __device__ index_t GetGemmG() const { return G; }
+    __device__ index_t GetGemmM() const { return C / G; }
+    __device__ index_t GetGemmN() const { return N * Hi * Wi; }
+    __device__ index_t GetGemmK() const { return (K / G) * Y * X; }
+    __device__ index_t GetGemmKBlocks() const { return 1; }
+
+    __device__ float LoadA(index_t g, index_t gemm_k, index_t gemm_m) const
+    {
+        const index_t k  = gemm_k / (Y * X);
+        const index_t yx = gemm_k - k * Y * X;
+
+        return type_convert<float>{}(
+            p_wei[((g * (K / G) + k) * GetGemmM() + gemm_m) * Y * X + yx]);
+    }
+
+    __device__ float LoadB(index_t g, index_t gemm_k, index_t gemm_n) const
+    {
+        const index_t k  = gemm_k / (Y * X);
+        const index_t y  = (gemm_k - k * Y * X) / X;
+        const index_t x  = gemm_k - (k * Y + y) * X;
+        const index_t n  = gemm_n / (Hi * Wi);
+        const index_t hi = (gemm_n - n * Hi * Wi) / Wi;
+        const index_t wi = gemm_n - (n * Hi + hi) * Wi;
+
+        const index_t ho_stride = hi + InLeftPadH - y * ConvDilationH;
+        const index_t wo_stride = wi + InLeftPadW - x * ConvDilationW;
+
+        if(ho_stride < 0 || wo_stride < 0 || ho_stride % ConvStrideH != 0 ||
+           wo_stride % ConvStrideW != 0)
+            return 0;
+
+        const index_t ho = ho_stride / ConvStrideH;
+        const index_t wo = wo_stride / ConvStrideW;
+
+        if(ho >= Ho || wo >= Wo)
+            return 0;
+
+        return type_convert<float>{}(p_out[((n * K + g * (K / G) + k) * Ho + ho) * Wo + wo]);
+    }
+
+    __device__ void StoreC(index_t g, index_t gemm_m, index_t gemm_n, index_t, float v) const
+    {
+        if(gemm_m >= GetGemmM() || gemm_n >= GetGemmN())
+            return;
+
+        const index_t n    = gemm_n / (Hi * Wi);
+        const index_t hiwi = gemm_n - n * Hi * Wi;
+
+        p_in[(n * C + g * GetGemmM() + gemm_m) * Hi * Wi + hiwi] = type_convert<Float>{}(v);
+    }
+};
+
+// backward weights: C[K, C * Y * X] = A[N * Ho * Wo, K]^T * B[N * Ho * Wo, C * Y * X].
+// The reduction over N * Ho * Wo may be split between KBlocks blocks, which then add their
+// partial results to the zero-initialized weight gradient with atomics. fp16 partial results
+// are added in pairs of adjacent elements, which needs an even C * Y * X. There are no
+// atomics for bfloat16, KBlocks should be 1. With p_wei_partial set, K block b rather stores
+// its fp32 partial result to p_wei_partial[b * K * (C / G) * Y * X, (b + 1) * K * (C / G) * Y * X)
+// for a separate kernel to sum them in order, which is deterministic and works for any type.
+template <class Float>
+struct DynamicConvWrwGemm_nchw_kcyx_nkhw
+{
+    const Float* p_in;
+    Float* p_wei;
+    const Float* p_out;
+
+    index_t G, N, C, Hi, Wi, K, Y, X, Ho, Wo;
+    index_t ConvStrideH, ConvStrideW, ConvDilationH, ConvDilationW, InLeftPadH, InLeftPadW;
+    index_t KBlocks;
+    float* p_wei_partial;
+
+    __device__ index_t GetGemmG() const { return G; }
+    __device__ index_t GetGemmM() const { return K / G; }
+    __device__ index_t GetGemmN() const { return (C / G) * Y * X; }
+    __device__ index_t GetGemmK() const { return N * Ho * Wo; }
+    __device__ index_t GetGemmKBlocks() const { return KBlocks; }
+
+    __device__ float LoadA(index_t g, index_t gemm_k, index_t gemm_m) const
+    {
+        const index_t n    = gemm_k / (Ho * Wo);
+        const index_t howo = gemm_k - n * Ho * Wo;
+
+        return type_convert<float>{}(p_out[(n * K + g * GetGemmM() + gemm_m) * Ho * Wo + howo]);
+    }
+
+    __device__ float LoadB(index_t g, index_t gemm_k, index_t gemm_n) const
+    {
+        const index_t c  = gemm_n / (Y * X);
+        const index_t y  = (gemm_n - c * Y * X) / X;
+        const index_t x  = gemm_n - (c * Y + y) * X;
+        const index_t n  = gemm_k / (Ho * Wo);
+        const index_t ho = (gemm_k - n * Ho * Wo) / Wo;
+        const index_t wo = gemm_k - (n * Ho + ho) * Wo;
+
+        const index_t hi = ho * ConvStrideH + y * ConvDilationH - InLeftPadH;
+        const index_t wi = wo * ConvStrideW + x * ConvDilationW - InLeftPadW;
+
+        if(hi < 0 || hi >= Hi || wi < 0 || wi >= Wi)
+            return 0;
+
+        return type_convert<float>{}(p_in[((n * C + g * (C / G) + c) * Hi + hi) * Wi + wi]);
+    }
+
+    __device__ void
+    StoreC(index_t g, index_t gemm_m, index_t gemm_n, index_t k_block_id, float v) const
+    {
+        const bool in_range = gemm_m < GetGemmM() && gemm_n < GetGemmN();
+        const index_t i     = (g * GetGemmM() + gemm_m) * GetGemmN() + gemm_n;
+
+        if(p_wei_partial != nullptr)
+        {
+            if(in_range)
+                p_wei_partial[k_block_id * G * GetGemmM() * GetGemmN() + i] = v;
+        }
+        else if(KBlocks == 1)
+        {
+            if(in_range)
+                p_wei[i] = type_convert<Float>{}(v);
+        }
+        else
+        {
+            atomic_add_c_wave(p_wei, i, v, in_range);
+        }
+    }
+};
+
+// Each block computes a GemmMPerBlock x GemmNPerBlock tile of C, each wave a
+// GemmMPerWave x GemmNPerWave sub-tile made of 32x32 xdlops tiles. A and B are staged in LDS
+// as [GemmK, GemmM] and [GemmK, GemmN] in fp32, so that any input data type uses the same
+// fp32 xdlops. Out-of-range GEMM elements are loaded as zeros and not stored. The groups and
+// the K blocks are folded into the grid: consecutive runs of K-blocks x M-blocks x N-blocks
+// blocks belong to one group, and each K block reduces its own slice of GemmK.
+template <index_t BlockSize,
+          index_t GemmMPerBlock,
+          index_t GemmNPerBlock,
+          index_t GemmKPerBlock,
+          index_t GemmMPerWave,
+          index_t GemmNPerWave>
+struct GridwiseGemmXdlopsDynamic
+{
+    static constexpr index_t WaveSize = 64;
+    static constexpr index_t MWaves   = GemmMPerBlock / GemmMPerWave;
+    static constexpr index_t NWaves   = GemmNPerBlock / GemmNPerWave;
+    static constexpr index_t MRepeat  = GemmMPerWave / 32;
+    static constexpr index_t NRepeat  = GemmNPerWave / 32;
+
+    // padding the LDS rows by one element spreads the transposed writes of A over the banks
+    static constexpr index_t ALdsStride = GemmMPerBlock + 1;
+    static constexpr index_t BLdsStride = GemmNPerBlock;
+
+    static constexpr index_t ACopyPerThread = GemmKPerBlock * GemmMPerBlock / BlockSize;
+    static constexpr index_t BCopyPerThread = GemmKPerBlock * GemmNPerBlock / BlockSize;
+
+    template <class Gemm>
+    __device__ void Run(const Gemm& gemm) const
+    {
+        static_assert(MWaves * NWaves * WaveSize == BlockSize,
+                      "wrong! waves should cover the block tile");
+        static_assert(GemmMPerWave % 32 == 0 && GemmNPerWave % 32 == 0,
+                      "wrong! wave tile should consist of 32x32 xdlops tiles");
+        static_assert(GemmKPerBlock % 2 == 0, "wrong! xdlops consume K by 2");
+        static_assert(ACopyPerThread * BlockSize == GemmKPerBlock * GemmMPerBlock &&
+                          BCopyPerThread * BlockSize == GemmKPerBlock * GemmNPerBlock,
+                      "wrong! block copy should be divisible between threads");
+
+        __shared__ float p_a_block[GemmKPerBlock * ALdsStride];
+        __shared__ float p_b_block[GemmKPerBlock * BLdsStride];
+
+        const index_t gemm_m = gemm.GetGemmM();
+        const index_t gemm_n = gemm.GetGemmN();
+        const index_t gemm_k = gemm.GetGemmK();
+
+        const index_t m_block_num = (gemm_m + GemmMPerBlock - 1) / GemmMPerBlock;
+        const index_t n_block_num = (gemm_n + GemmNPerBlock - 1) / GemmNPerBlock;
+        const index_t mn_blocks   = m_block_num * n_block_num;
+        const index_t k_blocks    = gemm.GetGemmKBlocks();
+        const index_t g           = get_block_1d_id() / (k_blocks * mn_blocks);
+        const index_t k_block_id  = (get_block_1d_id() - g * k_blocks * mn_blocks) / mn_blocks;
+        const index_t block_id    = get_block_1d_id() - (g * k_blocks + k_block_id) * mn_blocks;
+
+        // the K slices are whole multiples of GemmKPerBlock, the last one may be shorter
+        const index_t k_slice =
+            ((gemm_k + k_blocks * GemmKPerBlock - 1) / (k_blocks * GemmKPerBlock)) *
+            GemmKPerBlock;
+        const index_t k_begin = k_block_id * k_slice;
+        const index_t k_end   = math::min(gemm_k, k_begin + k_slice);
+
+        const index_t m_block_begin = (block_id / n_block_num) * GemmMPerBlock;
+        const index_t n_block_begin = (block_id % n_block_num) * GemmNPerBlock;
+
+        const index_t tid     = get_thread_local_1d_id();
+        const index_t wave_id = tid / WaveSize;
+        const index_t lane_id = tid % WaveSize;
+
+        const index_t m_wave_begin = (wave_id / NWaves) * GemmMPerWave;
+        const index_t n_wave_begin = (wave_id % NWaves) * GemmNPerWave;
+
+        float16_t p_c_thread[MRepeat * NRepeat];
+
+#pragma unroll
+        for(index_t i = 0; i < MRepeat * NRepeat; ++i)
+            for(index_t j = 0; j < 16; ++j)
+                p_c_thread[i][j] = 0;
+
+        for(index_t k_block_begin = k_begin; k_block_begin < k_end;
+            k_block_begin += GemmKPerBlock)
+        {
+            float p_a_thread[ACopyPerThread];
+            float p_b_thread[BCopyPerThread];
+
+            // A is walked along GemmK, which is contiguous in the weights (forward, backward
+            // data) or the output gradient (backward weights)
+#pragma unroll
+            for(index_t i = 0; i < ACopyPerThread; ++i)
+            {
+                const index_t e  = tid + i * BlockSize;
+                const index_t gm = m_block_begin + e / GemmKPerBlock;
+                const index_t gk = k_block_begin + e % GemmKPerBlock;
+
+                p_a_thread[i] = (gm < gemm_m && gk < k_end) ? gemm.LoadA(g, gk, gm) : 0;
+            }
+
+            // B is walked along GemmN, which is contiguous in the images for forward and
+            // backward data
+#pragma unroll
+            for(index_t i = 0; i < BCopyPerThread; ++i)
+            {
+                const index_t e  = tid + i * BlockSize;
+                const index_t gk = k_block_begin + e / GemmNPerBlock;
+                const index_t gn = n_block_begin + e % GemmNPerBlock;
+
+                p_b_thread[i] = (gn < gemm_n && gk < k_end) ? gemm.LoadB(g, gk, gn) : 0;
+            }
+
+            // the previous iteration should be done with the LDS tiles
+            block_sync_lds();
+
+#pragma unroll
+            for(index_t i = 0; i < ACopyPerThread; ++i)
+            {
+                const index_t e = tid + i * BlockSize;
+
+                p_a_block[(e % GemmKPerBlock) * ALdsStride + e / GemmKPerBlock] = p_a_thread[i];
+            }
+
+#pragma unroll
+            for(index_t i = 0; i < BCopyPerThread; ++i)
+                p_b_block[tid + i * BlockSize] = p_b_thread[i];
+
+            block_sync_lds();
+
+            // lanes 0-31 provide k = 0 and lanes 32-63 k = 1 of each 32x32x2 xdlops
+#pragma unroll
+            for(index_t k = 0; k < GemmKPerBlock; k += 2)
+            {
+                const index_t k_lane = k + lane_id / 32;
+
+                float p_a_reg[MRepeat];
+                float p_b_reg[NRepeat];
+
+#pragma unroll
+                for(index_t mr = 0; mr < MRepeat; ++mr)
+                    p_a_reg[mr] =
+                        p_a_block[k_lane * ALdsStride + m_wave_begin + mr * 32 + lane_id % 32];
+
+#pragma unroll
+                for(index_t nr = 0; nr < NRepeat; ++nr)
+                    p_b_reg[nr] =
+                        p_b_block[k_lane * BLdsStride + n_wave_begin + nr * 32 + lane_id % 32];
+
+#pragma unroll
+                for(index_t mr = 0; mr < MRepeat; ++mr)
+#pragma unroll
+                    for(index_t nr = 0; nr < NRepeat; ++nr)
+                        p_c_thread[mr * NRepeat + nr] = llvm_intrin_amdgcn_mfma_f32_32x32x2f32(
+                            p_a_reg[mr], p_b_reg[nr], p_c_thread[mr * NRepeat + nr], 0, 0, 0);
+            }
+        }
+
+        // element j of a 32x32 xdlops tile is held by row (j / 4) * 8 + (lane / 32) * 4 + j % 4
+        // and column lane % 32, out-of-range elements are dropped by StoreC
+#pragma unroll
+        for(index_t mr = 0; mr < MRepeat; ++mr)
+#pragma unroll
+            for(index_t nr = 0; nr < NRepeat; ++nr)
+#pragma unroll
+                for(index_t j = 0; j < 16; ++j)
+                {
+                    const index_t gm = m_block_begin + m_wave_begin + mr * 32 + (j / 4) * 8 +
+                                       (lane_id / 32) * 4 + j % 4;
+                    const index_t gn = n_block_begin + n_wave_begin + nr * 32 + lane_id % 32;
+
+                    gemm.StoreC(g, gm, gn, k_block_id, p_c_thread[mr * NRepeat + nr][j]);
+                }
+    }
+};
+
+} // namespace ck
+#endif
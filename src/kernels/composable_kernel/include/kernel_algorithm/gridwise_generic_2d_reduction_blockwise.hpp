@@ -46,7 +46,8 @@ template <index_t BlockSize,
           NanPropagation_t nanPropaOpt,
           ReduceTensorIndices_t reduceIndicesOpt,
           index_t callId,
-          index_t GredAccessesPerThreadInBlock>
+          index_t GredAccessesPerThreadInBlock,
+          index_t GredSrcDataPerRead = 1> // vector width of the loads along the toReduce dimension
 struct GridwiseReduction_xy_to_x_blockwise
 {
     static constexpr bool indexable = reduce_binary_operator<compType, op>::indexable;
@@ -108,7 +109,7 @@ struct GridwiseReduction_xy_to_x_blockwise
                                                Sequence<0, 1>,
                                                1,
                                                1,
-                                               1,
+                                               GredSrcDataPerRead,
                                                1,
                                                AddressSpace::Global,
                                                AddressSpace::Vgpr,
@@ -231,7 +232,7 @@ struct GridwiseReduction_xy_to_x_blockwise
                                                Sequence<0, 1>,
                                                1,
                                                1,
-                                               1,
+                                               GredSrcDataPerRead,
                                                1,
                                                AddressSpace::Global,
                                                AddressSpace::Vgpr,
@@ -365,7 +366,7 @@ struct GridwiseReduction_xy_to_x_blockwise
                                                Sequence<0, 1>,
                                                1,
                                                1,
-                                               1,
+                                               GredSrcDataPerRead,
                                                1,
                                                AddressSpace::Global,
                                                AddressSpace::Vgpr,
@@ -46,7 +46,8 @@ template <index_t BlockSize,
           NanPropagation_t nanPropaOpt,
           ReduceTensorIndices_t reduceIndicesOpt,
           index_t blkGroupSize, // The number of blocks for doing each reduction
-          index_t GredAccessesPerThreadInBlock>
+          index_t GredAccessesPerThreadInBlock,
+          index_t GredSrcDataPerRead = 1> // vector width of the loads along the toReduce dimension
 struct GridwiseReduction_xy_to_x_multiblock
 {
     static constexpr bool indexable = reduce_binary_operator<compType, op>::indexable;
@@ -58,7 +59,7 @@ struct GridwiseReduction_xy_to_x_multiblock
     __device__ void Run(srcDataType alpha,
                         const srcDataType* const __restrict__ p_src_global,
                         dstDataType beta,
-                        srcDataType* const __restrict__ workspace_global,
+                        compType* const __restrict__ workspace_global,
                         int* const __restrict__ ws_indices_global)
     {
         static_if<need_indices>{}([&](auto) {
@@ -69,7 +70,7 @@ struct GridwiseReduction_xy_to_x_multiblock
     __device__ static void RunImpl1(srcDataType alpha,
                                     const srcDataType* const __restrict__ p_src_global,
                                     dstDataType beta,
-                                    srcDataType* const __restrict__ workspace_global)
+                                    compType* const __restrict__ workspace_global)
     {
         (void)alpha; // unused
         (void)beta;  // unused
@@ -112,7 +113,7 @@ struct GridwiseReduction_xy_to_x_multiblock
                                                Sequence<0, 1>,
                                                1,
                                                1,
-                                               1,
+                                               GredSrcDataPerRead,
                                                1,
                                                AddressSpace::Global,
                                                AddressSpace::Vgpr,
@@ -179,7 +180,7 @@ struct GridwiseReduction_xy_to_x_multiblock
     __device__ static void RunImpl2(srcDataType alpha,
                                     const srcDataType* const __restrict__ p_src_global,
                                     dstDataType beta,
-                                    srcDataType* const __restrict__ workspace_global,
+                                    compType* const __restrict__ workspace_global,
                                     int* const __restrict__ ws_indices_global)
     {
         (void)alpha; // unused
@@ -225,7 +226,7 @@ struct GridwiseReduction_xy_to_x_multiblock
                                                Sequence<0, 1>,
                                                1,
                                                1,
-                                               1,
+                                               GredSrcDataPerRead,
                                                1,
                                                AddressSpace::Global,
                                                AddressSpace::Vgpr,
@@ -58,7 +58,9 @@ template <index_t BlkGroupSize,
           index_t reduceIndicesOpt_I, // the enumerate value representing the Reduce Indices Option
           index_t GredThreadBufferLength,
           index_t GredAccessesPerThreadInBlock,
-          index_t GredAccessesPerThreadInWarp>
+          index_t GredAccessesPerThreadInWarp,
+          index_t GredSrcDataPerRead> // vector width of the first-time loads along the toReduce
+                                      // dimension, which needs it to be contiguous in memory
 struct GridwiseReduction
 {
     static constexpr auto reduceImpl = static_cast<ReductionMethod_t>(reduceImpl_I);
@@ -68,6 +70,10 @@ struct GridwiseReduction
     static constexpr auto nanPropaOpt      = static_cast<NanPropagation_t>(nanPropaOpt_I);
     static constexpr auto reduceIndicesOpt = static_cast<ReduceTensorIndices_t>(reduceIndicesOpt_I);
 
+    // the second-time reduction reads the partial results the first one kept in compType
+    template <index_t callId>
+    using inDataType = typename std::conditional<callId == 0, srcDataType, compType>::type;
+
     template <ReductionMethod_t impl, index_t callId>
     struct GridwiseReduction_2d_wrapper;
 
@@ -78,11 +84,11 @@ struct GridwiseReduction
         template <typename src2dDesc, typename dst1dDesc>
         __device__ static void Run(src2dDesc,
                                    dst1dDesc,
-                                   srcDataType alpha,
-                                   const srcDataType* const __restrict__ p_src_global,
+                                   inDataType<callId> alpha,
+                                   const inDataType<callId>* const __restrict__ p_src_global,
                                    dstDataType beta,
                                    dstDataType* const __restrict__ p_dst_global,
-                                   srcDataType* const __restrict__ ws_buf1_global,
+                                   compType* const __restrict__ ws_buf1_global,
                                    int* const __restrict__ ws_buf2_global,
                                    int* const __restrict__ indices_global)
         {
@@ -107,7 +113,7 @@ struct GridwiseReduction
 
             using gridwise_reduce = GridwiseReduction_xy_to_x_direct_threadwise<
                 BlockSize,
-                srcDataType,
+                inDataType<callId>,
                 dstDataType,
                 src2dDesc_touse,
                 dst1dDesc,
@@ -133,11 +139,11 @@ struct GridwiseReduction
         template <typename src2dDesc, typename dst1dDesc>
         __device__ static void Run(src2dDesc,
                                    dst1dDesc,
-                                   srcDataType alpha,
-                                   const srcDataType* const __restrict__ p_src_global,
+                                   inDataType<callId> alpha,
+                                   const inDataType<callId>* const __restrict__ p_src_global,
                                    dstDataType beta,
                                    dstDataType* const __restrict__ p_dst_global,
-                                   srcDataType* const __restrict__ ws_buf1_global,
+                                   compType* const __restrict__ ws_buf1_global,
                                    int* const __restrict__ ws_buf2_global,
                                    int* const __restrict__ indices_global)
         {
@@ -162,7 +168,7 @@ struct GridwiseReduction
 
             using gridwise_reduce = GridwiseReduction_xy_to_x_direct_warpwise<
                 BlockSize,
-                srcDataType,
+                inDataType<callId>,
                 dstDataType,
                 src2dDesc_touse,
                 dst1dDesc,
@@ -189,11 +195,11 @@ struct GridwiseReduction
         template <typename src2dDesc, typename dst1dDesc>
         __device__ static void Run(src2dDesc,
                                    dst1dDesc,
-                                   srcDataType alpha,
-                                   const srcDataType* const __restrict__ p_src_global,
+                                   inDataType<callId> alpha,
+                                   const inDataType<callId>* const __restrict__ p_src_global,
                                    dstDataType beta,
                                    dstDataType* const __restrict__ p_dst_global,
-                                   srcDataType* const __restrict__ ws_buf1_global,
+                                   compType* const __restrict__ ws_buf1_global,
                                    int* const __restrict__ ws_buf2_global,
                                    int* const __restrict__ indices_global)
         {
@@ -218,7 +224,7 @@ struct GridwiseReduction
 
             using gridwise_reduce = GridwiseReduction_xy_to_x_blockwise<
                 BlockSize,
-                srcDataType,
+                inDataType<callId>,
                 dstDataType,
                 src2dDesc_touse,
                 dst1dDesc,
@@ -227,8 +233,9 @@ struct GridwiseReduction
                 nanPropaOpt,
                 reduceIndicesOpt,
                 callId,
-                GredAccessesPerThreadInBlock>; // the callId indicates the first or second-time
-                                               // reduction
+                GredAccessesPerThreadInBlock,
+                callId == 0 ? GredSrcDataPerRead : 1>; // the callId indicates the first or
+                                                       // second-time reduction
 
             gridwise_reduce{}.Run(alpha,
                                   p_src_global,
@@ -246,11 +253,11 @@ struct GridwiseReduction
         template <typename src2dDesc, typename dst1dDesc>
         __device__ static void Run(src2dDesc,
                                    dst1dDesc,
-                                   srcDataType alpha,
-                                   const srcDataType* const __restrict__ p_src_global,
+                                   inDataType<callId> alpha,
+                                   const inDataType<callId>* const __restrict__ p_src_global,
                                    dstDataType beta,
                                    dstDataType* const __restrict__ p_dst_global,
-                                   srcDataType* const __restrict__ ws_buf1_global,
+                                   compType* const __restrict__ ws_buf1_global,
                                    int* const __restrict__ ws_buf2_global,
                                    int* const __restrict__ indices_global)
         {
@@ -286,8 +293,8 @@ struct GridwiseReduction
                 nanPropaOpt,
                 reduceIndicesOpt,
                 BlkGroupSize,
-                GredAccessesPerThreadInBlock>; // MultiBlock case is not used by second-time
-                                               // reduction
+                GredAccessesPerThreadInBlock,
+                GredSrcDataPerRead>; // MultiBlock case is not used by second-time reduction
 
             gridwise_reduce{}.Run(alpha,
                                   p_src_global,
@@ -370,7 +377,7 @@ struct GridwiseReduction
                                      type_convert<dstDataType>{}(beta),
                                      const_cast<dstDataType* const __restrict__>(
                                          static_cast<dstDataType*>(p_dst_global)),
-                                     static_cast<srcDataType* const __restrict__>(ws_buf1_global),
+                                     static_cast<compType* const __restrict__>(ws_buf1_global),
                                      static_cast<int* const __restrict__>(ws_buf2_global),
                                      static_cast<int* const __restrict__>(indices_global));
         }).Else([&](auto) { // All dimensions are to be reduced
@@ -404,7 +411,7 @@ struct GridwiseReduction
                                      type_convert<dstDataType>{}(beta),
                                      const_cast<dstDataType* const __restrict__>(
                                          static_cast<dstDataType*>(p_dst_global)),
-                                     static_cast<srcDataType* const __restrict__>(ws_buf1_global),
+                                     static_cast<compType* const __restrict__>(ws_buf1_global),
                                      static_cast<int* const __restrict__>(ws_buf2_global),
                                      static_cast<int* const __restrict__>(indices_global));
         });
@@ -448,13 +455,13 @@ struct GridwiseReduction
             gridwise_2d_reduce{}.Run(
                 workspace_2d_desc,
                 one_dim_dstDesc,
-                type_convert<srcDataType>{}(alpha),
-                const_cast<const srcDataType* const __restrict__>(
-                    static_cast<srcDataType*>(ws_buf1_global)),
+                type_convert<compType>{}(alpha),
+                const_cast<const compType* const __restrict__>(
+                    static_cast<compType*>(ws_buf1_global)),
                 type_convert<dstDataType>{}(beta),
                 const_cast<dstDataType* const __restrict__>(
                     static_cast<dstDataType*>(p_dst_global)),
-                const_cast<dstDataType* const __restrict__>(static_cast<dstDataType*>(nullptr)),
+                static_cast<compType* const __restrict__>(nullptr),
                 static_cast<int* const __restrict__>(ws_buf2_global),
                 static_cast<int* const __restrict__>(indices_global));
         }).Else([&](auto) {});
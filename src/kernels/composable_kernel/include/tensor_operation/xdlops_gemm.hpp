@@ -27,6 +27,9 @@ enum struct mfma_instr
     mfma_f32_4x4x2bf16,
     mfma_f32_32x32x4bf16, // k reduction
     mfma_f32_16x16x8bf16, // k reduction
+    // int8
+    mfma_i32_32x32x8i8,  // k reduction
+    mfma_i32_16x16x16i8, // k reduction
 };
 
 template <mfma_instr instr>
@@ -531,6 +534,72 @@ struct mfma_info<mfma_instr::mfma_f32_4x4x2bf16>
     }
 };
 
+template <>
+struct mfma_info<mfma_instr::mfma_i32_32x32x8i8>
+{
+    static constexpr index_t group_size      = 4;
+    static constexpr index_t num_groups_blk  = 4;
+    static constexpr index_t num_regs_blk    = group_size * num_groups_blk;
+    static constexpr index_t num_threads_blk = 32;
+    static constexpr index_t wave_size       = 64;
+    static constexpr index_t num_input_blks  = wave_size / num_threads_blk;
+    static constexpr index_t num_output_blks = 1;
+    static constexpr index_t num_regs_xdlops = num_regs_blk * num_output_blks;
+    static constexpr index_t m               = 32;
+    static constexpr index_t n               = 32;
+    static constexpr index_t k               = 8;
+    static constexpr index_t cycles          = 64;
+    static constexpr index_t k_base          = 4;
+
+    template <index_t MPerXdlops,
+              index_t NPerXdlops,
+              index_t AStride,
+              index_t BStride,
+              class FloatA,
+              class FloatB,
+              class FloatC>
+    __device__ FloatC run(const FloatA* a, const FloatB* b, FloatC reg_c) const
+    {
+        const auto p_a = reinterpret_cast<const int8x4_t*>(a);
+        const auto p_b = reinterpret_cast<const int8x4_t*>(b);
+
+        return intrin_mfma_i32_32x32x8i8(p_a, p_b, reg_c);
+    }
+};
+
+template <>
+struct mfma_info<mfma_instr::mfma_i32_16x16x16i8>
+{
+    static constexpr index_t group_size      = 4;
+    static constexpr index_t num_groups_blk  = 1;
+    static constexpr index_t num_regs_blk    = group_size * num_groups_blk;
+    static constexpr index_t num_threads_blk = 16;
+    static constexpr index_t wave_size       = 64;
+    static constexpr index_t num_input_blks  = wave_size / num_threads_blk;
+    static constexpr index_t num_output_blks = 1;
+    static constexpr index_t num_regs_xdlops = num_regs_blk * num_output_blks;
+    static constexpr index_t m               = 16;
+    static constexpr index_t n               = 16;
+    static constexpr index_t k               = 16;
+    static constexpr index_t cycles          = 32;
+    static constexpr index_t k_base          = 4;
+
+    template <index_t MPerXdlops,
+              index_t NPerXdlops,
+              index_t AStride,
+              index_t BStride,
+              class FloatA,
+              class FloatB,
+              class FloatC>
+    __device__ FloatC run(const FloatA* a, const FloatB* b, FloatC reg_c) const
+    {
+        const auto p_a = reinterpret_cast<const int8x4_t*>(a);
+        const auto p_b = reinterpret_cast<const int8x4_t*>(b);
+
+        return intrin_mfma_i32_16x16x16i8(p_a, p_b, reg_c);
+    }
+};
+
 template <mfma_instr instr,
           index_t MPerXdlops_,
           index_t NPerXdlops_,
@@ -716,8 +785,8 @@ struct XdlopsGemm_t
         static_assert(is_same<FloatA, FloatB>::value, "FloatA != FloatB");
 
         static_assert(is_same<data_type, float>::value || is_same<data_type, half_t>::value ||
-                          is_same<data_type, ushort>::value,
-                      "base data_type must be float, half, ushort!");
+                          is_same<data_type, ushort>::value || is_same<data_type, int8_t>::value,
+                      "base data_type must be float, half, ushort, int8!");
 
 #if CK_USE_AMD_XDLOPS_EMULATE
         p_c_thread = XdlopsEmulate<M, N, K>(p_a_wave, p_b_wave, p_c_thread);
@@ -1032,6 +1101,18 @@ struct XdlopsGemm_t
         return xdlops_info<mfma_instr::mfma_f32_16x16x8bf16, 16, 16, 1, 1, c_vec4_1_t>{};
     }
 
+    template <>
+    static constexpr auto GetXdlopsInfo<int8_t, 32, 32>()
+    {
+        return xdlops_info<mfma_instr::mfma_i32_32x32x8i8, 32, 32, 1, 1, c_vec16_1_i32_t>{};
+    }
+
+    template <>
+    static constexpr auto GetXdlopsInfo<int8_t, 16, 16>()
+    {
+        return xdlops_info<mfma_instr::mfma_i32_16x16x16i8, 16, 16, 1, 1, c_vec4_1_i32_t>{};
+    }
+
     static constexpr index_t MRepeats   = GetXdlopsInfo().MRepeats;
     static constexpr index_t NRepeats   = GetXdlopsInfo().NRepeats;
     static constexpr index_t MPerXdlops = GetXdlopsInfo().MPerXdlops;
@@ -145,6 +145,13 @@ __llvm_amdgcn_buffer_atomic_add_f32(float vdata,
                                     index_t vindex,
                                     index_t offset,
                                     bool slc) __asm("llvm.amdgcn.buffer.atomic.fadd.f32");
+
+__device__ void
+__llvm_amdgcn_buffer_atomic_add_v2f16(half2_t vdata,
+                                      int32x4_t rsrc,
+                                      index_t vindex,
+                                      index_t offset,
+                                      bool slc) __asm("llvm.amdgcn.buffer.atomic.fadd.v2f16");
 #endif
 
 // buffer_load requires:
@@ -786,6 +793,31 @@ __device__ void amd_buffer_atomic_add<float, 4>(const float* p_src,
             &p_src[i], p_dst_block, dst_thread_data_offset, dst_const_data_offset + i);
     }
 }
+
+template <>
+__device__ void amd_buffer_atomic_add<half_t, 2>(const half_t* p_src,
+                                                 half_t* p_dst_block,
+                                                 index_t dst_thread_data_offset,
+                                                 index_t dst_const_data_offset)
+{
+    BufferAddressConfig<half_t> dst_block_config;
+
+    // fill in byte 0 - 1
+    dst_block_config.address[0] = p_dst_block;
+    // fill in byte 2
+    dst_block_config.range[2] = -1;
+    // fill in byte 3
+    dst_block_config.range[3] = 0x00027000;
+
+    index_t dst_thread_addr_offset = dst_thread_data_offset * sizeof(half_t);
+    index_t dst_const_addr_offset  = dst_const_data_offset * sizeof(half_t);
+
+    __llvm_amdgcn_buffer_atomic_add_v2f16(*reinterpret_cast<const half2_t*>(p_src),
+                                          dst_block_config.data,
+                                          0,
+                                          dst_thread_addr_offset + dst_const_addr_offset,
+                                          false);
+}
 #endif // CK_USE_AMD_BUFFER_ATOMIC_ADD
 
 } // namespace ck
@@ -51,6 +51,13 @@ extern "C" __device__ float16_t llvm_intrin_amdgcn_mfma_f32_16x16x2bf16(
 extern "C" __device__ float4_t llvm_intrin_amdgcn_mfma_f32_4x4x2bf16(
     ushort2_t, ushort2_t, float4_t, int, int, int) __asm("llvm.amdgcn.mfma.f32.4x4x2bf16");
 
+// int8 operands are passed as 4 values packed into one 32-bit register
+extern "C" __device__ int32x16_t llvm_intrin_amdgcn_mfma_i32_32x32x8i8(
+    int, int, int32x16_t, int, int, int) __asm("llvm.amdgcn.mfma.i32.32x32x8i8");
+
+extern "C" __device__ int32x4_t llvm_intrin_amdgcn_mfma_i32_16x16x16i8(
+    int, int, int32x4_t, int, int, int) __asm("llvm.amdgcn.mfma.i32.16x16x16i8");
+
 template <index_t MPerWave, index_t NPerWave, index_t AStride, index_t BStride>
 struct intrin_mfma_f32_32x32x1f32;
 
@@ -464,5 +471,31 @@ struct intrin_mfma_f32_4x4x2bf16<8, 64>
         return reg_c;
     }
 };
+
+__device__ c_vec16_1_i32_t::VecType intrin_mfma_i32_32x32x8i8(const int8x4_t* reg_a,
+                                                              const int8x4_t* reg_b,
+                                                              c_vec16_1_i32_t::VecType reg_c)
+{
+    reg_c.s.x = llvm_intrin_amdgcn_mfma_i32_32x32x8i8(*reinterpret_cast<const int*>(reg_a),
+                                                      *reinterpret_cast<const int*>(reg_b),
+                                                      reg_c.s.x,
+                                                      0,
+                                                      0,
+                                                      0);
+    return reg_c;
+}
+
+__device__ c_vec4_1_i32_t::VecType intrin_mfma_i32_16x16x16i8(const int8x4_t* reg_a,
+                                                              const int8x4_t* reg_b,
+                                                              c_vec4_1_i32_t::VecType reg_c)
+{
+    reg_c.s.x = llvm_intrin_amdgcn_mfma_i32_16x16x16i8(*reinterpret_cast<const int*>(reg_a),
+                                                       *reinterpret_cast<const int*>(reg_b),
+                                                       reg_c.s.x,
+                                                       0,
+                                                       0,
+                                                       0);
+    return reg_c;
+}
 }
 #endif
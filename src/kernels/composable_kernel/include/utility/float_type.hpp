@@ -21,6 +21,14 @@ typedef ushort ushort2_t __attribute__((ext_vector_type(2)));
 typedef ushort ushort4_t __attribute__((ext_vector_type(4)));
 typedef ushort ushort8_t __attribute__((ext_vector_type(8)));
 
+// int8
+typedef int8_t int8x4_t __attribute__((ext_vector_type(4)));
+typedef int8_t int8x8_t __attribute__((ext_vector_type(8)));
+typedef int8_t int8x16_t __attribute__((ext_vector_type(16)));
+
+// int32
+typedef int32_t int32x16_t __attribute__((ext_vector_type(16)));
+
 struct c_vec32_4_t
 {
     union VecType
@@ -168,6 +176,45 @@ struct c_vec4_1_t
     }
 };
 
+// int32 accumulators of the int8 xdlops
+struct c_vec16_1_i32_t
+{
+    union VecType
+    {
+        struct
+        {
+            int32x16_t x;
+        } s;
+        int32_t n[16];
+    };
+
+    __host__ __device__ static VecType CreateVecZero()
+    {
+        VecType c;
+        c.s.x = 0;
+        return c;
+    }
+};
+
+struct c_vec4_1_i32_t
+{
+    union VecType
+    {
+        struct
+        {
+            int32x4_t x;
+        } s;
+        int32_t n[4];
+    };
+
+    __host__ __device__ static VecType CreateVecZero()
+    {
+        VecType c;
+        c.s.x = 0;
+        return c;
+    }
+};
+
 template <class T, index_t N>
 struct vector_type
 {
@@ -408,6 +455,76 @@ struct vector_type<ushort, 8>
     }
 };
 
+template <>
+struct vector_type<int8_t, 1>
+{
+    using MemoryType = int8_t;
+
+    template <index_t I>
+    __host__ __device__ static void SetScalar(MemoryType& v, int8_t s, Number<I>)
+    {
+        static_assert(I < 1, "wrong");
+        *(reinterpret_cast<int8_t*>(&v) + I) = s;
+    }
+};
+
+template <>
+struct vector_type<int8_t, 4>
+{
+    using MemoryType = int8x4_t;
+
+    union DataType
+    {
+        MemoryType vector;
+        int8_t scalar[4];
+    };
+
+    template <index_t I>
+    __host__ __device__ static void SetScalar(MemoryType& v, int8_t s, Number<I>)
+    {
+        static_assert(I < 4, "wrong");
+        *(reinterpret_cast<int8_t*>(&v) + I) = s;
+    }
+};
+
+template <>
+struct vector_type<int8_t, 8>
+{
+    using MemoryType = int8x8_t;
+
+    union DataType
+    {
+        MemoryType vector;
+        int8_t scalar[8];
+    };
+
+    template <index_t I>
+    __host__ __device__ static void SetScalar(MemoryType& v, int8_t s, Number<I>)
+    {
+        static_assert(I < 8, "wrong");
+        *(reinterpret_cast<int8_t*>(&v) + I) = s;
+    }
+};
+
+template <>
+struct vector_type<int8_t, 16>
+{
+    using MemoryType = int8x16_t;
+
+    union DataType
+    {
+        MemoryType vector;
+        int8_t scalar[16];
+    };
+
+    template <index_t I>
+    __host__ __device__ static void SetScalar(MemoryType& v, int8_t s, Number<I>)
+    {
+        static_assert(I < 16, "wrong");
+        *(reinterpret_cast<int8_t*>(&v) + I) = s;
+    }
+};
+
 // data type conversion
 template <typename T>
 struct type_convert
@@ -547,6 +664,19 @@ struct inner_product_with_conversion
         }
         return acc;
     }
+
+    __device__ T operator()(int8x4_t a, int8x4_t b) const
+    {
+        const int8_t* p_a_int8 = reinterpret_cast<const int8_t*>(&a);
+        const int8_t* p_b_int8 = reinterpret_cast<const int8_t*>(&b);
+
+        T acc = 0;
+        for(index_t v = 0; v < 4; ++v)
+        {
+            acc += convert(p_a_int8[v]) * convert(p_b_int8[v]);
+        }
+        return acc;
+    }
 };
 
 } // namespace ck
@@ -98,6 +98,33 @@ struct SetData<int, DataPerAccess>
     }
 };
 
+// int8 data is moved as packed 32-bit words whenever the access is wide enough, so the float
+// buffer load/store is reused. Narrower accesses fall back to a plain element-wise copy.
+template <index_t DataPerAccess>
+struct SetData<int8_t, DataPerAccess>
+{
+    template <AddressSpace SrcAddressSpace, AddressSpace DstAddressSpace>
+    __device__ void
+    Run(const int8_t* p_src, index_t src_offset, int8_t* p_dst, index_t dst_offset) const
+    {
+        // round up so that the untaken branch still names a valid SetData
+        constexpr index_t DataPerAccessPacked = (DataPerAccess + 3) / 4;
+
+        static_if<DataPerAccess % 4 == 0>{}([&](auto fwd) {
+            SetData<float, DataPerAccessPacked>{}.template Run<SrcAddressSpace, DstAddressSpace>(
+                reinterpret_cast<const float*>(reinterpret_cast<const void*>(fwd(p_src))),
+                src_offset / 4,
+                reinterpret_cast<float*>(reinterpret_cast<void*>(p_dst)),
+                dst_offset / 4);
+        }).Else([&](auto) {
+            for(index_t i = 0; i < DataPerAccess; ++i)
+            {
+                p_dst[dst_offset + i] = p_src[src_offset + i];
+            }
+        });
+    }
+};
+
 template <typename T, index_t DataPerAccess>
 struct AtomicAddData
 {
@@ -2,6 +2,10 @@
 #include "gridwise_convolution_backward_weights_implicit_gemm_v4r4_nchw_kcyx_nkhw.hpp"
 #include "float_types.h"
 
+#ifndef CK_PARAM_GEMM_K_GROUPS
+#define CK_PARAM_GEMM_K_GROUPS 1
+#endif
+
 extern "C" __global__
     __launch_bounds__(CK_PARAM_TUNABLE_BLOCK_SIZE, 2) void gridwise_convolution_backward_weights_implicit_gemm_v4r4_nchw_kcyx_nkhw(
         const FLOAT* const __restrict__ p_in_global,
@@ -10,8 +14,16 @@ extern "C" __global__
 {
     using namespace ck;
 
+    // GemmK (N * Ho * Wo) may be split among GemmKGroups groups of images, one group per
+    // blockIdx.y. Each group writes a partial weight gradient into its own slice of
+    // p_out_global, which the host reduces afterwards.
+    constexpr index_t GemmKGroups = CK_PARAM_GEMM_K_GROUPS;
+
+    static_assert(CK_PARAM_PROBLEM_N % GemmKGroups == 0,
+                  "wrong! batch size should be divisible by GemmKGroups");
+
     // read problem parameters
-    constexpr index_t N  = CK_PARAM_PROBLEM_N;
+    constexpr index_t N  = CK_PARAM_PROBLEM_N / GemmKGroups;
     constexpr index_t K  = CK_PARAM_PROBLEM_K;
     constexpr index_t C  = CK_PARAM_PROBLEM_C;
     constexpr index_t Hi = CK_PARAM_PROBLEM_HI;
@@ -155,6 +167,11 @@ extern "C" __global__
             GemmBBlockCopySrcDataPerRead_GemmK,
             GemmBBlockCopyDstDataPerWrite_GemmN,
             GemmCThreadCopyDstDataPerWrite_GemmN1>{};
+
+    const index_t group_id = blockIdx.y;
+
     // in hpp is in,out,wei => dout * din = wei
-    gridwise_conv.Run(p_in_global, p_wei_global, p_out_global);
+    gridwise_conv.Run(p_in_global + group_id * in_nchw_desc.GetElementSpace(),
+                      p_wei_global + group_id * out_nkhw_desc.GetElementSpace(),
+                      p_out_global + group_id * wei_kcyx_desc.GetElementSpace());
 }
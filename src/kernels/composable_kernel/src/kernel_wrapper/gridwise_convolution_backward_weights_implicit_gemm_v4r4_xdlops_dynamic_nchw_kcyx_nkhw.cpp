@@ -0,0 +1,85 @@
+#include "common_header.hpp"
+#include "gridwise_convolution_implicit_gemm_xdlops_dynamic_nchw_kcyx_nkhw.hpp"
+#include "float_types.h"
+
+// Only the tile configuration and the data type are compile-time parameters, all the problem
+// sizes are kernel arguments. With GemmKBlocks > 1 the weight gradient should be zeroed, unless
+// the partial results go to p_wei_partial_global, which is null otherwise.
+extern "C" __global__
+    __launch_bounds__(CK_PARAM_TUNABLE_BLOCK_SIZE) void gridwise_convolution_backward_weights_implicit_gemm_v4r4_xdlops_dynamic_nchw_kcyx_nkhw(
+        const FLOAT* const __restrict__ p_in_global,
+        const FLOAT* const __restrict__ p_out_global,
+        FLOAT* const __restrict__ p_wei_global,
+        ck::index_t G,
+        ck::index_t N,
+        ck::index_t C,
+        ck::index_t Hi,
+        ck::index_t Wi,
+        ck::index_t K,
+        ck::index_t Y,
+        ck::index_t X,
+        ck::index_t Ho,
+        ck::index_t Wo,
+        ck::index_t ConvStrideH,
+        ck::index_t ConvStrideW,
+        ck::index_t ConvDilationH,
+        ck::index_t ConvDilationW,
+        ck::index_t InLeftPadH,
+        ck::index_t InLeftPadW,
+        ck::index_t GemmKBlocks,
+        float* const __restrict__ p_wei_partial_global)
+{
+    using namespace ck;
+
+    const auto gemm = DynamicConvWrwGemm_nchw_kcyx_nkhw<FLOAT>{p_in_global,
+                                                               p_wei_global,
+                                                               p_out_global,
+                                                               G,
+                                                               N,
+                                                               C,
+                                                               Hi,
+                                                               Wi,
+                                                               K,
+                                                               Y,
+                                                               X,
+                                                               Ho,
+                                                               Wo,
+                                                               ConvStrideH,
+                                                               ConvStrideW,
+                                                               ConvDilationH,
+                                                               ConvDilationW,
+                                                               InLeftPadH,
+                                                               InLeftPadW,
+                                                               GemmKBlocks,
+                                                               p_wei_partial_global};
+
+    constexpr auto gridwise_gemm = GridwiseGemmXdlopsDynamic<CK_PARAM_TUNABLE_BLOCK_SIZE,
+                                                             CK_PARAM_TUNABLE_GEMM_M_PER_BLOCK,
+                                                             CK_PARAM_TUNABLE_GEMM_N_PER_BLOCK,
+                                                             CK_PARAM_TUNABLE_GEMM_K_PER_BLOCK,
+                                                             CK_PARAM_TUNABLE_GEMM_M_PER_WAVE,
+                                                             CK_PARAM_TUNABLE_GEMM_N_PER_WAVE>{};
+    gridwise_gemm.Run(gemm);
+}
+
+// Sums the GemmKBlocks partial weight gradients of WeiSize elements each, in the order of the
+// K blocks, so that the result does not depend on the scheduling of the blocks.
+extern "C" __global__ void
+gridwise_convolution_backward_weights_implicit_gemm_v4r4_xdlops_dynamic_reduction(
+    FLOAT* const __restrict__ p_wei_global,
+    const float* const __restrict__ p_wei_partial_global,
+    ck::index_t WeiSize,
+    ck::index_t GemmKBlocks)
+{
+    using namespace ck;
+
+    const index_t i = get_block_1d_id() * blockDim.x + get_thread_local_1d_id();
+    if(i >= WeiSize)
+        return;
+
+    float sum = 0;
+    for(index_t k_block_id = 0; k_block_id < GemmKBlocks; ++k_block_id)
+        sum += p_wei_partial_global[k_block_id * WeiSize + i];
+
+    p_wei_global[i] = type_convert<FLOAT>{}(sum);
+}
@@ -0,0 +1,60 @@
+#include "common_header.hpp"
+#include "gridwise_convolution_implicit_gemm_xdlops_dynamic_nchw_kcyx_nkhw.hpp"
+#include "float_types.h"
+
+// Only the tile configuration and the data type are compile-time parameters, all the problem
+// sizes are kernel arguments. With GemmKBlocks > 1 the output should be zeroed.
+extern "C" __global__
+    __launch_bounds__(CK_PARAM_TUNABLE_BLOCK_SIZE) void gridwise_convolution_forward_implicit_gemm_v4r4_xdlops_dynamic_nchw_kcyx_nkhw(
+        const FLOAT* const __restrict__ p_in_global,
+        const FLOAT* const __restrict__ p_wei_global,
+        FLOAT* const __restrict__ p_out_global,
+        ck::index_t G,
+        ck::index_t N,
+        ck::index_t C,
+        ck::index_t Hi,
+        ck::index_t Wi,
+        ck::index_t K,
+        ck::index_t Y,
+        ck::index_t X,
+        ck::index_t Ho,
+        ck::index_t Wo,
+        ck::index_t ConvStrideH,
+        ck::index_t ConvStrideW,
+        ck::index_t ConvDilationH,
+        ck::index_t ConvDilationW,
+        ck::index_t InLeftPadH,
+        ck::index_t InLeftPadW,
+        ck::index_t GemmKBlocks)
+{
+    using namespace ck;
+
+    const auto gemm = DynamicConvFwdGemm_nchw_kcyx_nkhw<FLOAT, FLOAT>{p_in_global,
+                                                                      p_wei_global,
+                                                                      p_out_global,
+                                                                      G,
+                                                                      N,
+                                                                      C,
+                                                                      Hi,
+                                                                      Wi,
+                                                                      K,
+                                                                      Y,
+                                                                      X,
+                                                                      Ho,
+                                                                      Wo,
+                                                                      ConvStrideH,
+                                                                      ConvStrideW,
+                                                                      ConvDilationH,
+                                                                      ConvDilationW,
+                                                                      InLeftPadH,
+                                                                      InLeftPadW,
+                                                                      GemmKBlocks};
+
+    constexpr auto gridwise_gemm = GridwiseGemmXdlopsDynamic<CK_PARAM_TUNABLE_BLOCK_SIZE,
+                                                             CK_PARAM_TUNABLE_GEMM_M_PER_BLOCK,
+                                                             CK_PARAM_TUNABLE_GEMM_N_PER_BLOCK,
+                                                             CK_PARAM_TUNABLE_GEMM_K_PER_BLOCK,
+                                                             CK_PARAM_TUNABLE_GEMM_M_PER_WAVE,
+                                                             CK_PARAM_TUNABLE_GEMM_N_PER_WAVE>{};
+    gridwise_gemm.Run(gemm);
+}
@@ -2,11 +2,24 @@
 #include "gridwise_convolution_forward_implicit_gemm_v4r4_xdlops_nchw_kcyx_nkhw.hpp"
 #include "float_types.h"
 
+#if MIOPEN_USE_INT8
+// int8 inputs and weights accumulate in int32, the output tensor is either int32 or fp32
+#define FLOAT int8_t
+#define FLOAT_ACCUM int32_t
+#if CK_PARAM_INT8_OUT_FP32
+#define FLOAT_OUT float
+#else
+#define FLOAT_OUT int32_t
+#endif
+#else
+#define FLOAT_OUT FLOAT
+#endif
+
 extern "C" __global__
     __launch_bounds__(CK_PARAM_DEPENDENT_BLOCK_SIZE) void gridwise_convolution_forward_implicit_gemm_v4r4_xdlops_nchw_kcyx_nkhw(
         const FLOAT* const __restrict__ p_in_global,
         const FLOAT* const __restrict__ p_wei_global,
-        FLOAT* const __restrict__ p_out_global)
+        FLOAT_OUT* const __restrict__ p_out_global)
 {
     using namespace ck;
 
@@ -144,7 +157,7 @@ extern "C" __global__
             BlockSize,
             FLOAT,       // Input data type
             FLOAT_ACCUM, // Acc data type
-            FLOAT,       // Ouput data type
+            FLOAT_OUT,   // Ouput data type
             decltype(in_n_c_hi_wi_desc),
             decltype(wei_k_cpergroup_y_x_desc),
             decltype(out_n_k_ho_wo_desc),
@@ -0,0 +1,148 @@
+#include "common_header.hpp"
+#include "ConstantTensorDescriptor_deprecated.hpp"
+#include "gridwise_convolution_implicit_gemm_v4r4_gen_xdlops_wrw_fp32_ncdhw_kczyx_nkdhw_lds_double_buffer.hpp"
+#include "float_types.h"
+
+extern "C" __global__
+    __launch_bounds__(CK_PARAM_TUNABLE_BLOCK_SIZE, 2) void gridwise_convolution_implicit_gemm_v4r4_gen_xdlops_wrw_fp32_ncdhw_kczyx_nkdhw_lds_double_buffer(
+        const FLOAT* const __restrict__ p_in_global,
+        const FLOAT* const __restrict__ p_out_global,
+        FLOAT* const __restrict__ p_wei_global)
+{
+#if !(MIOPEN_USE_FP32 && CK_PARAM_PROBLEM_CONV_DIRECTION_BACKWARD_WEIGHT)
+    static_assert(false, "Only support backward weight fp32!");
+#endif
+
+    using namespace ck;
+
+    // read params: problem decription
+    constexpr index_t N  = CK_PARAM_PROBLEM_N;
+    constexpr index_t K  = CK_PARAM_PROBLEM_K;
+    constexpr index_t C  = CK_PARAM_PROBLEM_C;
+    constexpr index_t Di = CK_PARAM_PROBLEM_DI;
+    constexpr index_t Hi = CK_PARAM_PROBLEM_HI;
+    constexpr index_t Wi = CK_PARAM_PROBLEM_WI;
+    constexpr index_t Do = CK_PARAM_PROBLEM_DO;
+    constexpr index_t Ho = CK_PARAM_PROBLEM_HO;
+    constexpr index_t Wo = CK_PARAM_PROBLEM_WO;
+    constexpr index_t Z  = CK_PARAM_PROBLEM_Z;
+    constexpr index_t Y  = CK_PARAM_PROBLEM_Y;
+    constexpr index_t X  = CK_PARAM_PROBLEM_X;
+
+    constexpr index_t ConvStrideD = CK_PARAM_PROBLEM_CONV_STRIDE_D;
+    constexpr index_t ConvStrideH = CK_PARAM_PROBLEM_CONV_STRIDE_H;
+    constexpr index_t ConvStrideW = CK_PARAM_PROBLEM_CONV_STRIDE_W;
+
+    constexpr index_t ConvDilationD = CK_PARAM_PROBLEM_CONV_DILATION_D;
+    constexpr index_t ConvDilationH = CK_PARAM_PROBLEM_CONV_DILATION_H;
+    constexpr index_t ConvDilationW = CK_PARAM_PROBLEM_CONV_DILATION_W;
+
+    // read params: tunable params
+    constexpr index_t BlockSize = CK_PARAM_TUNABLE_BLOCK_SIZE;
+
+    constexpr index_t GemmMPerBlock = CK_PARAM_TUNABLE_GEMM_M_PER_BLOCK;
+    constexpr index_t GemmNPerBlock = CK_PARAM_TUNABLE_GEMM_N_PER_BLOCK;
+    constexpr index_t GemmKPerBlock = CK_PARAM_TUNABLE_GEMM_K_PER_BLOCK;
+    constexpr index_t GemmKBlocks   = CK_PARAM_TUNABLE_GEMM_K_BLOCKS;
+
+    // read params: dependent params
+    constexpr index_t GridSize = CK_PARAM_DEPENDENT_GRID_SIZE;
+
+    constexpr index_t LeftPadD = CK_PARAM_PROBLEM_LEFT_PAD_D;
+    constexpr index_t LeftPadH = CK_PARAM_PROBLEM_LEFT_PAD_H;
+    constexpr index_t LeftPadW = CK_PARAM_PROBLEM_LEFT_PAD_W;
+
+    constexpr index_t RightPadD = CK_PARAM_PROBLEM_RIGHT_PAD_D;
+    constexpr index_t RightPadH = CK_PARAM_PROBLEM_RIGHT_PAD_H;
+    constexpr index_t RightPadW = CK_PARAM_PROBLEM_RIGHT_PAD_W;
+
+    using InLeftPads  = Sequence<LeftPadD, LeftPadH, LeftPadW>;
+    using InRightPads = Sequence<RightPadD, RightPadH, RightPadW>;
+
+    constexpr auto in_ncdhw_desc =
+        make_native_tensor_descriptor_packed(Sequence<N, C, Di, Hi, Wi>{});
+    constexpr auto wei_kczyx_desc =
+        make_native_tensor_descriptor_packed(Sequence<K, C, Z, Y, X>{});
+    constexpr auto out_nkdhw_desc =
+        make_native_tensor_descriptor_packed(Sequence<N, K, Do, Ho, Wo>{});
+
+    using ConvStrides   = Sequence<ConvStrideD, ConvStrideH, ConvStrideW>;
+    using ConvDilations = Sequence<ConvDilationD, ConvDilationH, ConvDilationW>;
+
+    constexpr index_t GemmBBlockCopyClusterLengths_GemmK =
+        CK_PARAM_TUNABLE_GEMM_B_BLOCK_COPY_CLUSTER_LENGTHS_GEMM_K;
+    constexpr index_t GemmBBlockCopyClusterLengths_GemmN =
+        CK_PARAM_TUNABLE_GEMM_B_BLOCK_COPY_CLUSTER_LENGTHS_GEMM_N;
+
+    constexpr index_t GemmBBlockCopyThreadSliceLengths_GemmK =
+        GemmKPerBlock / GemmBBlockCopyClusterLengths_GemmK;
+    constexpr index_t GemmBBlockCopyThreadSliceLengths_GemmN =
+        GemmNPerBlock / GemmBBlockCopyClusterLengths_GemmN;
+
+    constexpr index_t GemmABlockCopyClusterLengths_GemmK =
+        CK_PARAM_TUNABLE_GEMM_A_BLOCK_COPY_CLUSTER_LENGTHS_GEMM_K;
+    constexpr index_t GemmABlockCopyClusterLengths_GemmM =
+        CK_PARAM_TUNABLE_GEMM_A_BLOCK_COPY_CLUSTER_LENGTHS_GEMM_M;
+
+    constexpr index_t GemmABlockCopyThreadSliceLengths_GemmK =
+        GemmKPerBlock / GemmABlockCopyClusterLengths_GemmK;
+    constexpr index_t GemmABlockCopyThreadSliceLengths_GemmM =
+        GemmMPerBlock / GemmABlockCopyClusterLengths_GemmM;
+
+    using GemmBBlockCopyThreadSliceLengths_GemmG_GemmK_GemmN =
+        Sequence<1, GemmBBlockCopyThreadSliceLengths_GemmK, GemmBBlockCopyThreadSliceLengths_GemmN>;
+    using GemmBBlockCopyThreadClusterLengths_GemmG_GemmK_GemmN =
+        Sequence<1, GemmBBlockCopyClusterLengths_GemmK, GemmBBlockCopyClusterLengths_GemmN>;
+
+    using GemmABlockCopyThreadSliceLengths_GemmG_GemmK_GemmM =
+        Sequence<1, GemmABlockCopyThreadSliceLengths_GemmK, GemmABlockCopyThreadSliceLengths_GemmM>;
+    using GemmABlockCopyThreadClusterLengths_GemmG_GemmK_GemmM =
+        Sequence<1, GemmABlockCopyClusterLengths_GemmK, GemmABlockCopyClusterLengths_GemmM>;
+
+    constexpr index_t GemmBBlockCopyDstDataPerWrite_GemmN =
+        CK_PARAM_TUNABLE_GEMM_B_BLOCK_COPY_DST_DATA_PER_WRITE_GEMM_N;
+    constexpr index_t GemmABlockCopyDstDataPerWrite_GemmM =
+        CK_PARAM_TUNABLE_GEMM_A_BLOCK_COPY_DST_DATA_PER_WRITE_GEMM_M;
+
+    constexpr index_t GemmBBlockCopySrcDataPerRead_GemmK =
+        CK_PARAM_TUNABLE_GEMM_B_BLOCK_COPY_SRC_DATA_PER_READ_GEMM;
+    constexpr index_t GemmABlockCopySrcDataPerRead_GemmK =
+        CK_PARAM_TUNABLE_GEMM_A_BLOCK_COPY_SRC_DATA_PER_READ_GEMM;
+
+    constexpr auto GemmMPerWave                   = CK_PARAM_GEMM_M_PER_WAVE;
+    constexpr auto GemmNPerWave                   = CK_PARAM_GEMM_N_PER_WAVE;
+    constexpr index_t ThreadGemmDataPerRead_GemmM = 1;
+    constexpr index_t ThreadGemmDataPerRead_GemmN = 1;
+
+    constexpr auto gridwise_conv =
+        GridwiseConvolutionImplicitGemm_v4r4_gen_xdlops_wrw_fp32_ncdhw_kczyx_nkdhw_lds_double_buffer<
+            GridSize,
+            BlockSize,
+            FLOAT,
+            FLOAT_ACCUM,
+            decltype(in_ncdhw_desc),
+            decltype(wei_kczyx_desc),
+            decltype(out_nkdhw_desc),
+            ConvStrides,
+            ConvDilations,
+            InLeftPads,
+            InRightPads,
+            GemmMPerBlock,
+            GemmNPerBlock,
+            GemmKPerBlock,
+            GemmKBlocks,
+            GemmMPerWave,
+            GemmNPerWave,
+            ThreadGemmDataPerRead_GemmM,
+            ThreadGemmDataPerRead_GemmN,
+            GemmABlockCopyThreadSliceLengths_GemmG_GemmK_GemmM,
+            GemmABlockCopyThreadClusterLengths_GemmG_GemmK_GemmM,
+            GemmABlockCopySrcDataPerRead_GemmK,
+            GemmABlockCopyDstDataPerWrite_GemmM,
+            GemmBBlockCopyThreadSliceLengths_GemmG_GemmK_GemmN,
+            GemmBBlockCopyThreadClusterLengths_GemmG_GemmK_GemmN,
+            GemmBBlockCopySrcDataPerRead_GemmK,
+            GemmBBlockCopyDstDataPerWrite_GemmN>{};
+
+    gridwise_conv.Run(p_in_global, p_wei_global, p_out_global);
+}
@@ -89,6 +89,7 @@ constexpr ReduceTensorIndices_t reduceIndicesOpt = CK_PARAM_REDUCE_INDICES == 0
 constexpr index_t GredThreadBufferLength       = CK_PARAM_THREAD_BUFFER_LENGTH;        // tunable
 constexpr index_t GredAccessesPerThreadInBlock = CK_PARAM_ACCESSES_PER_THREAD_INBLOCK; // tunable
 constexpr index_t GredAccessesPerThreadInWarp  = CK_PARAM_ACCESSES_PER_THREAD_INWARP;  // tunable
+constexpr index_t GredSrcDataPerRead           = CK_PARAM_SRC_DATA_PER_READ;           // src layout
 
 extern "C" __global__ void gridwise_generic_reduce_1(float alpha,
                                                      const void* p_src_global,
@@ -123,7 +124,8 @@ extern "C" __global__ void gridwise_generic_reduce_1(float alpha,
                                                        static_cast<index_t>(reduceIndicesOpt),
                                                        GredThreadBufferLength,
                                                        GredAccessesPerThreadInBlock,
-                                                       GredAccessesPerThreadInWarp>{};
+                                                       GredAccessesPerThreadInWarp,
+                                                       GredSrcDataPerRead>{};
 
     gridwise_reduce.Run(alpha,
                         const_cast<const void* const __restrict__>(p_src_global),
@@ -167,7 +169,8 @@ extern "C" __global__ void gridwise_generic_reduce_2(float alpha,
                                                        static_cast<index_t>(reduceIndicesOpt),
                                                        GredThreadBufferLength,
                                                        GredAccessesPerThreadInBlock,
-                                                       GredAccessesPerThreadInWarp>{};
+                                                       GredAccessesPerThreadInWarp,
+                                                       GredSrcDataPerRead>{};
 
     gridwise_reduce.Run_2(alpha,
                           const_cast<const void* const __restrict__>(p_src_global),
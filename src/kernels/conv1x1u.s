@@ -86,8 +86,8 @@ static_assert (stride_h == 1 && stride_w == 1)
 static_assert (wei_h == 1 && wei_w == 1)
 
 //TODO take them from host, as symbols
-// krenel supports fp32 regular layout or fp16_vec2 or int8_vec4
-static_assert ((acc_type == TYPE_FP32 && buf_type == TYPE_FP32&& vec_c_in == 1) || (acc_type == TYPE_FP32&& buf_type == TYPE_FP16 && (vec_c_in == 2 || vec_c_in == 1)) || (acc_type == TYPE_INT32 && buf_type == TYPE_INT16 && vec_c_in == 2) || (acc_type == TYPE_INT32 && buf_type == TYPE_INT8 && vec_c_in == 4) || (acc_type == TYPE_INT32 && buf_type == TYPE_INT4 && vec_c_in == 8))
+// krenel supports fp32 regular layout or fp16_vec2, bfp16_vec2 or int8_vec4
+static_assert ((acc_type == TYPE_FP32 && buf_type == TYPE_FP32&& vec_c_in == 1) || (acc_type == TYPE_FP32&& (buf_type == TYPE_FP16 || buf_type == TYPE_BFP16) && (vec_c_in == 2 || vec_c_in == 1)) || (acc_type == TYPE_INT32 && buf_type == TYPE_INT16 && vec_c_in == 2) || (acc_type == TYPE_INT32 && buf_type == TYPE_INT8 && vec_c_in == 4) || (acc_type == TYPE_INT32 && buf_type == TYPE_INT4 && vec_c_in == 8))
 static_assert (k_mult % vec_k_out == 0)
 
 static_assert( (vec_c_in == 1) || (vec_c_in == 2) || (vec_c_in == 4) || (vec_c_in == 8) )
@@ -98,7 +98,7 @@ static_assert( (vec_c_in == vec_k_out) || (vec_k_out == 1) )
 elements_in_dword = 1
 output_dword_chunks_cnt = 1
 input_dword_chunks_cnt = 1
-.if(buf_type == TYPE_FP16 || buf_type == TYPE_INT16)
+.if(buf_type == TYPE_FP16 || buf_type == TYPE_BFP16 || buf_type == TYPE_INT16)
     elements_in_dword = 2
 .elseif(buf_type == TYPE_INT8)
     elements_in_dword = 4
@@ -651,6 +651,15 @@ miopenGcnAsmConv1x1U:
                                 v_cvt_f32_f16 v[vtmp_f_cvt], v[vtmp_f_cvt]
                                 v_mac_f32     v[acc], v[vtmp], v[vtmp_f_cvt]
                             .endif
+                        .elseif acc_type == TYPE_FP32 && buf_type == TYPE_BFP16
+                            // bfp16 is the upper half of fp32: widen the low element by a shift, the high one by a mask
+                            v_lshlrev_b32 v[vtmp], 16, v[inp_gpr]
+                            s_lshl_b32    s[stmp], s[f_gpr], 16
+                            v_mac_f32     v[acc], s[stmp], v[vtmp]
+
+                            v_and_b32     v[vtmp], 0xffff0000, v[inp_gpr]
+                            s_and_b32     s[stmp], s[f_gpr], 0xffff0000
+                            v_mac_f32     v[acc], s[stmp], v[vtmp]
                         .elseif acc_type == TYPE_INT32 && buf_type == TYPE_INT16 && vec_c_in == 2
                             .if dot_instructions_available
                                 v_dot2_i32_i16 v[acc], s[f_gpr], v[inp_gpr], v[acc]
@@ -858,6 +867,11 @@ last_wave:
                     set_all_acc_idx hi_k, vec_k_out, nb, hi_chunk  * output_dword_chunks_cnt
                     .if acc_type == TYPE_FP32 && buf_type == TYPE_FP16
                         v_cvt_pkrtz_f16_f32 v[acc1], v[acc1], v[acc2]
+                    .elseif acc_type == TYPE_FP32 && buf_type == TYPE_BFP16
+                        v_reg_data_type_convert v[acc1], TYPE_BFP16, v[acc1], TYPE_FP32, v[vtmp], vcc
+                        v_reg_data_type_convert v[acc2], TYPE_BFP16, v[acc2], TYPE_FP32, v[vtmp], vcc
+                        v_lshlrev_b32 v[acc2], 16, v[acc2]
+                        v_or_b32 v[acc1], v[acc1], v[acc2]
                     .elseif acc_type == TYPE_INT32 && buf_type == TYPE_INT16
                         v_cvt_pk_i16_i32 v[acc1], v[acc1], v[acc2]
                     .elseif acc_type == TYPE_INT32 && buf_type == TYPE_INT8
@@ -61,8 +61,11 @@ default activ_mode, MIOPEN_NEURON_PASTHRU
 default bias_mode, 0
 default fusion_mode, 0
 default enable_activ, 0
+default residual_mode, 0
 
 static_assert(fusion_mode || (bias_mode == 0 && enable_activ == 0))
+// residual add is applied between bias and activation
+static_assert(residual_mode == 0 || (fusion_mode && bias_mode && enable_activ))
 
 elements_in_dword = 1
 .if(buf_type == TYPE_FP16 || buf_type == TYPE_INT16)
@@ -139,6 +142,11 @@ static_assert(!fusion_mode || buf_type == TYPE_FP16 || buf_type == TYPE_FP32)
     .set KERNEL_ARGUMENTS_SIZE, dbg_ptr_off + 8
 .endif
 
+.if residual_mode
+    .set residual_ptr_off, bias_ptr_off + 8
+    .set KERNEL_ARGUMENTS_SIZE, residual_ptr_off + 8
+.endif
+
 
 maxU24 = 1 << 24
 invalid_addr_lit = 0x7FFFFFFF
@@ -332,6 +340,9 @@ bias_buffer_size = (output_channels + elements_in_dword - 1) / elements_in_dword
     .if fusion_mode && bias_mode
         .SGPR_ALLOC desc_bias, 4 // bias buffer descriptor
     .endif
+    .if residual_mode
+        .SGPR_ALLOC desc_res, 4 // residual buffer descriptor
+    .endif
     .SGPR_ALLOC filtersA, k_mult * c_mult, 1
     .if .SGPR_NEXT_FREE % 4
         .SGPR_ALLOC_ONCE wave_c_id // wave_c_id in group
@@ -434,6 +445,9 @@ miopenGcnAsmConv1x1U:
 .if fusion_mode && bias_mode
     s_load_dwordx2 s[desc_bias:desc_bias+1], s[kernarg:kernarg+1], 0x0 + bias_ptr_off
 .endif
+.if residual_mode
+    s_load_dwordx2 s[desc_res:desc_res+1], s[kernarg:kernarg+1], 0x0 + residual_ptr_off
+.endif
 
     // mask off unused lanes
     s_mov_b32 exec_lo, active_mask_lo
@@ -451,6 +465,10 @@ miopenGcnAsmConv1x1U:
     s_mov_b32 s[desc_bias+2], bias_buffer_size
     s_mov_b32 s[desc_bias+3], 0x00027000
 .endif
+.if residual_mode
+    s_mov_b32 s[desc_res+2], output_buffer_size
+    s_mov_b32 s[desc_res+3], 0x00027000
+.endif
 
     v_lshrrev_b32 v[vtmp], 6, v[tid]
     v_readfirstlane_b32 s[wave_c_id], v[vtmp]
@@ -1049,6 +1067,16 @@ last_wave:
             v_add_f32 v[\base], s[bias+k], v[\base]
         .endif
     .endm
+    .macro residual_f base, dword
+        // the residual tensor shares the output layout
+        buffer_load_dword v[vtmp], v[voffset_out], s[desc_res:desc_res+3], s[soffset_out] offen offset:0+4 * \dword
+        s_waitcnt vmcnt(0)
+        .if elements_in_dword == 2
+            v_pk_add_f16 v[\base], v[vtmp], v[\base]
+        .else
+            v_add_f32 v[\base], v[vtmp], v[\base]
+        .endif
+    .endm
     .macro store_result
         rem_hw_out = (img_h * img_w) % output_dword_chunks_cnt
         k = 0
@@ -1056,6 +1084,9 @@ last_wave:
             nb = 0
             s_cmpk_ge_i32 s[current_k], 0 + hi_output_channels - k
             s_cmov_b32 s[desc_out+2], 0
+            .if residual_mode
+                s_cmov_b32 s[desc_res+2], 0
+            .endif
 
             .rept n_mult
                 s_mov_b32 exec_lo, active_mask_lo
@@ -1067,6 +1098,9 @@ last_wave:
                     .if fusion_mode && bias_mode
                         bias_f acc, k, stmp, stmp2
                     .endif
+                    .if residual_mode
+                        residual_f acc, chunk
+                    .endif
                     .if fusion_mode && enable_activ
                         .if elements_in_dword == 2
                             activ_f_half acc, activ_mode, alpha, beta, gamma, vtmp, vtmp2
@@ -1091,6 +1125,11 @@ last_wave:
                     .if fusion_mode && bias_mode
                         bias_f acc, k, stmp, stmp2
                     .endif
+                    .if residual_mode
+                        buffer_load_ushort v[vtmp], v[voffset_out], s[desc_res:desc_res+3], s[soffset_out] offen offset:0+4 * last_dword
+                        s_waitcnt vmcnt(0)
+                        v_add_f16 v[acc], v[vtmp], v[acc]
+                    .endif
                     buffer_store_short v[acc], v[voffset_out], s[desc_out:desc_out+3], s[soffset_out] offen offset:0+4 * last_dword
                 .endif
                 nb = nb + 1
@@ -1229,6 +1268,38 @@ amdhsa.kernels:
 .end_amdgpu_metadata
 .endm // metadata_conv_bias_activ_half
 
+.macro metadata_conv_bias_res_activ_half sc,vc,wg_x,lds_sz,kernarg_size
+.amdgpu_metadata
+---
+amdhsa.version: [ 1, 0 ]
+amdhsa.kernels:
+  - .name: miopenGcnAsmConv1x1U
+    .symbol: miopenGcnAsmConv1x1U.kd
+    .sgpr_count: \sc
+    .vgpr_count: \vc
+    .language: "OpenCL C"
+    .language_version: [ 1, 2 ]
+    .kernarg_segment_size: \kernarg_size
+    .kernarg_segment_align: 8
+    .group_segment_fixed_size: \lds_sz
+    .private_segment_fixed_size: 0
+    .reqd_workgroup_size: [ \wg_x, 1, 1 ]
+    .max_flat_workgroup_size: \wg_x
+    .wavefront_size: 64
+    .args:
+    - { .size: 2, .offset:  0, .value_kind: by_value, .value_type: f16, .name: alpha }
+    - { .size: 2, .offset:  2, .value_kind: by_value, .value_type: f16, .name: beta }
+    - { .size: 2, .offset:  4, .value_kind: by_value, .value_type: f16, .name: gamma }
+    - { .size: 2, .offset:  6, .value_kind: by_value, .value_type: f16, .name: unused }
+    - { .size: 8, .offset:  8, .value_kind: global_buffer, .value_type: f32, .name: x,        .address_space: global, .is_const: true }
+    - { .size: 8, .offset: 16, .value_kind: global_buffer, .value_type: f32, .name: y,        .address_space: global, .is_const: false }
+    - { .size: 8, .offset: 24, .value_kind: global_buffer, .value_type: f32, .name: w,        .address_space: global, .is_const: true }
+    - { .size: 8, .offset: 32, .value_kind: global_buffer, .value_type: f16, .name: bias,     .address_space: global, .is_const: true }
+    - { .size: 8, .offset: 40, .value_kind: global_buffer, .value_type: f16, .name: residual, .address_space: global, .is_const: true }
+...
+.end_amdgpu_metadata
+.endm // metadata_conv_bias_res_activ_half
+
 .macro metadata_conv_bias_activ_float sc,vc,wg_x,lds_sz,kernarg_size
 .amdgpu_metadata
 ---
@@ -1260,6 +1331,38 @@ amdhsa.kernels:
 .end_amdgpu_metadata
 .endm // metadata_conv_bias_activ_float
 
+.macro metadata_conv_bias_res_activ_float sc,vc,wg_x,lds_sz,kernarg_size
+.amdgpu_metadata
+---
+amdhsa.version: [ 1, 0 ]
+amdhsa.kernels:
+  - .name: miopenGcnAsmConv1x1U
+    .symbol: miopenGcnAsmConv1x1U.kd
+    .sgpr_count: \sc
+    .vgpr_count: \vc
+    .language: "OpenCL C"
+    .language_version: [ 1, 2 ]
+    .kernarg_segment_size: \kernarg_size
+    .kernarg_segment_align: 8
+    .group_segment_fixed_size: \lds_sz
+    .private_segment_fixed_size: 0
+    .reqd_workgroup_size: [ \wg_x, 1, 1 ]
+    .max_flat_workgroup_size: \wg_x
+    .wavefront_size: 64
+    .args:
+    - { .size: 4, .offset:  0, .value_kind: by_value, .value_type: f32, .name: alpha }
+    - { .size: 4, .offset:  4, .value_kind: by_value, .value_type: f32, .name: beta }
+    - { .size: 4, .offset:  8, .value_kind: by_value, .value_type: f32, .name: gamma }
+    - { .size: 4, .offset: 12, .value_kind: by_value, .value_type: f32, .name: unused }
+    - { .size: 8, .offset: 16, .value_kind: global_buffer, .value_type: f32, .name: x,        .address_space: global, .is_const: true }
+    - { .size: 8, .offset: 24, .value_kind: global_buffer, .value_type: f32, .name: y,        .address_space: global, .is_const: false }
+    - { .size: 8, .offset: 32, .value_kind: global_buffer, .value_type: f32, .name: w,        .address_space: global, .is_const: true }
+    - { .size: 8, .offset: 40, .value_kind: global_buffer, .value_type: f32, .name: bias,     .address_space: global, .is_const: true }
+    - { .size: 8, .offset: 48, .value_kind: global_buffer, .value_type: f32, .name: residual, .address_space: global, .is_const: true }
+...
+.end_amdgpu_metadata
+.endm // metadata_conv_bias_res_activ_float
+
 .macro metadata_conv_activ_float sc,vc,wg_x,lds_sz,kernarg_size
 .amdgpu_metadata
 ---
@@ -1377,7 +1480,13 @@ amdhsa.kernels:
 .altmacro
 .macro METADATA sc, wc, wg_x, lds_size, kernarg_size
   .if fusion_mode
-    .if bias_mode && enable_activ
+    .if bias_mode && enable_activ && residual_mode
+        .if elements_in_dword == 2
+            metadata_conv_bias_res_activ_half \sc, \wc, \wg_x, \lds_size, \kernarg_size
+        .else
+            metadata_conv_bias_res_activ_float \sc, \wc, \wg_x, \lds_size, \kernarg_size
+        .endif
+    .elseif bias_mode && enable_activ
 		.if elements_in_dword == 2
             metadata_conv_bias_activ_half \sc, \wc, \wg_x, \lds_size, \kernarg_size
         .else
@@ -1456,6 +1565,30 @@ METADATA %.AUTO_SGPR_COUNT, %.AUTO_VGPR_COUNT, %workgroup_size_x, %.AUTO_LDS_BYT
     .end_amd_amdgpu_hsa_metadata
 .endm
 
+.macro metadata_conv_bias_res_activ_half wg_x, lds_size, kernarg_size
+    .amd_amdgpu_hsa_metadata
+    { Version: [ 1, 0 ],
+        Kernels:
+        - { Name: miopenGcnAsmConv1x1U, SymbolName: 'miopenGcnAsmConv1x1U@kd', Language: OpenCL C, LanguageVersion: [ 1, 2 ],
+            Attrs:
+              { ReqdWorkGroupSize: [ \wg_x, 1, 1 ] }
+            CodeProps:
+              { KernargSegmentSize: \kernarg_size, GroupSegmentFixedSize: \lds_size, PrivateSegmentFixedSize: 0, KernargSegmentAlign: 8, WavefrontSize: 64, MaxFlatWorkGroupSize: \wg_x }
+            Args:
+            - { Name: alpha   , Size: 2, Align: 2, ValueKind: ByValue, ValueType: F16, TypeName: 'float16', AccQual: Default, IsConst: true }
+            - { Name: beta    , Size: 2, Align: 2, ValueKind: ByValue, ValueType: F16, TypeName: 'float16', AccQual: Default, IsConst: true }
+            - { Name: gamma   , Size: 2, Align: 2, ValueKind: ByValue, ValueType: F16, TypeName: 'float16', AccQual: Default, IsConst: true }
+            - { Name: unused  , Size: 2, Align: 2, ValueKind: ByValue, ValueType: F16, TypeName: 'float16', AccQual: Default, IsConst: true }
+            - { Name: x       , Size: 8, Align: 8, ValueKind: GlobalBuffer, ValueType: F32, TypeName: 'float*', AddrSpaceQual: Global, AccQual: Default, IsConst: true }
+            - { Name: y       , Size: 8, Align: 8, ValueKind: GlobalBuffer, ValueType: F32, TypeName: 'float*', AddrSpaceQual: Global, AccQual: Default }
+            - { Name: w       , Size: 8, Align: 8, ValueKind: GlobalBuffer, ValueType: F32, TypeName: 'float*', AddrSpaceQual: Global, AccQual: Default, IsConst: true }
+            - { Name: bias    , Size: 8, Align: 8, ValueKind: GlobalBuffer, ValueType: F16, TypeName: 'float16*', AddrSpaceQual: Global, AccQual: Default, IsConst: true }
+            - { Name: residual, Size: 8, Align: 8, ValueKind: GlobalBuffer, ValueType: F16, TypeName: 'float16*', AddrSpaceQual: Global, AccQual: Default, IsConst: true }
+          }
+    }
+    .end_amd_amdgpu_hsa_metadata
+.endm
+
 .macro metadata_conv_bias_activ_float wg_x, lds_size, kernarg_size
     .amd_amdgpu_hsa_metadata
     { Version: [ 1, 0 ],
@@ -1479,6 +1612,30 @@ METADATA %.AUTO_SGPR_COUNT, %.AUTO_VGPR_COUNT, %workgroup_size_x, %.AUTO_LDS_BYT
     .end_amd_amdgpu_hsa_metadata
 .endm
 
+.macro metadata_conv_bias_res_activ_float wg_x, lds_size, kernarg_size
+    .amd_amdgpu_hsa_metadata
+    { Version: [ 1, 0 ],
+        Kernels:
+        - { Name: miopenGcnAsmConv1x1U, SymbolName: 'miopenGcnAsmConv1x1U@kd', Language: OpenCL C, LanguageVersion: [ 1, 2 ],
+            Attrs:
+              { ReqdWorkGroupSize: [ \wg_x, 1, 1 ] }
+            CodeProps:
+              { KernargSegmentSize: \kernarg_size, GroupSegmentFixedSize: \lds_size, PrivateSegmentFixedSize: 0, KernargSegmentAlign: 8, WavefrontSize: 64, MaxFlatWorkGroupSize: \wg_x }
+            Args:
+            - { Name: alpha   , Size: 4, Align: 4, ValueKind: ByValue, ValueType: F32, TypeName: 'float', AccQual: Default, IsConst: true }
+            - { Name: beta    , Size: 4, Align: 4, ValueKind: ByValue, ValueType: F32, TypeName: 'float', AccQual: Default, IsConst: true }
+            - { Name: gamma   , Size: 4, Align: 4, ValueKind: ByValue, ValueType: F32, TypeName: 'float', AccQual: Default, IsConst: true }
+            - { Name: unused  , Size: 4, Align: 4, ValueKind: ByValue, ValueType: F32, TypeName: 'float', AccQual: Default, IsConst: true }
+            - { Name: x       , Size: 8, Align: 8, ValueKind: GlobalBuffer, ValueType: F32, TypeName: 'float*', AddrSpaceQual: Global, AccQual: Default, IsConst: true }
+            - { Name: y       , Size: 8, Align: 8, ValueKind: GlobalBuffer, ValueType: F32, TypeName: 'float*', AddrSpaceQual: Global, AccQual: Default }
+            - { Name: w       , Size: 8, Align: 8, ValueKind: GlobalBuffer, ValueType: F32, TypeName: 'float*', AddrSpaceQual: Global, AccQual: Default, IsConst: true }
+            - { Name: bias    , Size: 8, Align: 8, ValueKind: GlobalBuffer, ValueType: F32, TypeName: 'float*', AddrSpaceQual: Global, AccQual: Default, IsConst: true }
+            - { Name: residual, Size: 8, Align: 8, ValueKind: GlobalBuffer, ValueType: F32, TypeName: 'float*', AddrSpaceQual: Global, AccQual: Default, IsConst: true }
+          }
+    }
+    .end_amd_amdgpu_hsa_metadata
+.endm
+
 .macro metadata_conv_activ_float wg_x, lds_size, kernarg_size
     .amd_amdgpu_hsa_metadata
     { Version: [ 1, 0 ],
@@ -1544,7 +1701,13 @@ METADATA %.AUTO_SGPR_COUNT, %.AUTO_VGPR_COUNT, %workgroup_size_x, %.AUTO_LDS_BYT
 
 .macro METADATA wg_x, lds_size, kernarg_size
   .if fusion_mode
-    .if bias_mode && enable_activ
+    .if bias_mode && enable_activ && residual_mode
+        .if elements_in_dword == 2
+            metadata_conv_bias_res_activ_half \wg_x, \lds_size, \kernarg_size
+        .else
+            metadata_conv_bias_res_activ_float \wg_x, \lds_size, \kernarg_size
+        .endif
+    .elseif bias_mode && enable_activ
 		.if elements_in_dword == 2
             metadata_conv_bias_activ_half \wg_x, \lds_size, \kernarg_size
         .else
@@ -22,6 +22,34 @@
 #endif
 #endif
 
+#ifndef MIOPEN_USE_INT8
+#define MIOPEN_USE_INT8 0
+#endif
+#ifndef MIOPEN_USE_INT8x4
+#define MIOPEN_USE_INT8x4 0
+#endif
+
+// Quantized data is pooled in fp32 and rounded back with saturation. -MAX_VAL is the most
+// negative int8, so padding never exceeds a real value.
+#if MIOPEN_USE_INT8 == 1
+#define _FLOAT char
+#define _FLOAT_PREC float
+#define CVT_FLOAT2PREC(x) convert_float(x)
+#define CVT_PREC2FLOAT(x) convert_char_sat_rte(x)
+#define MAX_VAL 128
+#elif MIOPEN_USE_INT8x4 == 1
+// four consecutive channels of one pixel, pooled independently
+#define _FLOAT char4
+#define _FLOAT_PREC float4
+#define CVT_FLOAT2PREC(x) convert_float4(x)
+#define CVT_PREC2FLOAT(x) convert_char4_sat_rte(x)
+#define MAX_VAL 128
+#else
+#define _FLOAT_PREC _FLOAT
+#define CVT_FLOAT2PREC(x) (x)
+#define CVT_PREC2FLOAT(x) (x)
+#endif
+
 #define _FLOAT2 PPCAT(_FLOAT, TWO)
 #define _FLOAT4 PPCAT(_FLOAT, FOUR)
 #define _FLOAT8 PPCAT(_FLOAT, EIGHT)
@@ -42,3 +70,8 @@ typedef MLO_POOLING_INDEX_TYPE index_t;
 #ifndef MLO_POOLING_OP_ID
 #define MLO_POOLING_OP_ID 0
 #endif
+
+#if MIOPEN_USE_INT8x4 == 1 && defined(MLO_POOLING_SAVE_INDEX) && \
+    MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX
+#error "int8x4 max pooling does not save indices"
+#endif
@@ -0,0 +1,139 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/layernorm.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/tensor.hpp>
+
+extern "C" miopenStatus_t miopenLayerNormForward(miopenHandle_t handle,
+                                                 const miopenTensorDescriptor_t xDesc,
+                                                 const void* x,
+                                                 const miopenTensorDescriptor_t weightDesc,
+                                                 const void* weight,
+                                                 const void* bias,
+                                                 float epsilon,
+                                                 int normalized_dim,
+                                                 const miopenTensorDescriptor_t yDesc,
+                                                 void* y,
+                                                 const miopenTensorDescriptor_t meanDesc,
+                                                 void* mean,
+                                                 void* rstd)
+{
+
+    MIOPEN_LOG_FUNCTION(handle,
+                        xDesc,
+                        x,
+                        weightDesc,
+                        weight,
+                        bias,
+                        epsilon,
+                        normalized_dim,
+                        yDesc,
+                        y,
+                        meanDesc,
+                        mean,
+                        rstd);
+    return miopen::try_([&] {
+        if((weightDesc == nullptr) != (weight == nullptr) ||
+           (weightDesc == nullptr) != (bias == nullptr))
+            MIOPEN_THROW(miopenStatusBadParm, "The weight, bias and their descriptor go together");
+        if((meanDesc == nullptr) != (mean == nullptr) || (meanDesc == nullptr) != (rstd == nullptr))
+            MIOPEN_THROW(miopenStatusBadParm, "The mean, rstd and their descriptor go together");
+
+        miopen::LayerNormForward(miopen::deref(handle),
+                                 miopen::deref(xDesc),
+                                 DataCast(x),
+                                 weightDesc != nullptr ? &miopen::deref(weightDesc) : nullptr,
+                                 DataCast(weight),
+                                 DataCast(bias),
+                                 epsilon,
+                                 normalized_dim,
+                                 miopen::deref(yDesc),
+                                 DataCast(y),
+                                 meanDesc != nullptr ? &miopen::deref(meanDesc) : nullptr,
+                                 DataCast(mean),
+                                 DataCast(rstd));
+    });
+}
+
+extern "C" miopenStatus_t miopenLayerNormBackward(miopenHandle_t handle,
+                                                  const miopenTensorDescriptor_t xDesc,
+                                                  const void* x,
+                                                  const miopenTensorDescriptor_t dyDesc,
+                                                  const void* dy,
+                                                  const miopenTensorDescriptor_t weightDesc,
+                                                  const void* weight,
+                                                  const miopenTensorDescriptor_t meanDesc,
+                                                  const void* mean,
+                                                  const void* rstd,
+                                                  int normalized_dim,
+                                                  const miopenTensorDescriptor_t dxDesc,
+                                                  void* dx,
+                                                  void* dweight,
+                                                  void* dbias)
+{
+
+    MIOPEN_LOG_FUNCTION(handle,
+                        xDesc,
+                        x,
+                        dyDesc,
+                        dy,
+                        weightDesc,
+                        weight,
+                        meanDesc,
+                        mean,
+                        rstd,
+                        normalized_dim,
+                        dxDesc,
+                        dx,
+                        dweight,
+                        dbias);
+    return miopen::try_([&] {
+        if((weightDesc == nullptr) != (weight == nullptr))
+            MIOPEN_THROW(miopenStatusBadParm, "The weight and its descriptor go together");
+        if((dweight == nullptr) != (dbias == nullptr))
+            MIOPEN_THROW(miopenStatusBadParm, "The weight and bias gradients go together");
+        if(dweight != nullptr && weightDesc == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "The weight gradient needs the weight descriptor");
+
+        miopen::LayerNormBackward(miopen::deref(handle),
+                                  miopen::deref(xDesc),
+                                  DataCast(x),
+                                  miopen::deref(dyDesc),
+                                  DataCast(dy),
+                                  weightDesc != nullptr ? &miopen::deref(weightDesc) : nullptr,
+                                  DataCast(weight),
+                                  miopen::deref(meanDesc),
+                                  DataCast(mean),
+                                  DataCast(rstd),
+                                  normalized_dim,
+                                  miopen::deref(dxDesc),
+                                  DataCast(dx),
+                                  DataCast(dweight),
+                                  DataCast(dbias));
+    });
+}
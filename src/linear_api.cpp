@@ -0,0 +1,61 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/activ.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/linear.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/tensor.hpp>
+
+extern "C" miopenStatus_t miopenLinearForward(miopenHandle_t handle,
+                                              const miopenTensorDescriptor_t xDesc,
+                                              const void* x,
+                                              const miopenTensorDescriptor_t wDesc,
+                                              const void* w,
+                                              const miopenTensorDescriptor_t bDesc,
+                                              const void* b,
+                                              const miopenActivationDescriptor_t activDesc,
+                                              const miopenTensorDescriptor_t yDesc,
+                                              void* y)
+{
+
+    MIOPEN_LOG_FUNCTION(handle, xDesc, x, wDesc, w, bDesc, b, activDesc, yDesc, y);
+    return miopen::try_([&] {
+        if((bDesc == nullptr) != (b == nullptr))
+            MIOPEN_THROW(miopenStatusBadParm, "The bias and its descriptor go together");
+
+        miopen::LinearForward(miopen::deref(handle),
+                              miopen::deref(xDesc),
+                              DataCast(x),
+                              miopen::deref(wDesc),
+                              DataCast(w),
+                              bDesc != nullptr ? &miopen::deref(bDesc) : nullptr,
+                              DataCast(b),
+                              activDesc != nullptr ? &miopen::deref(activDesc) : nullptr,
+                              miopen::deref(yDesc),
+                              DataCast(y));
+    });
+}
@@ -1,12 +1,16 @@
 #include <miopen/load_file.hpp>
+#include <miopen/logger.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
 #include <sstream>
 #include <fstream>
 
 namespace miopen {
 
-std::string LoadFile(const boost::filesystem::path& p) { return LoadFile(p.string()); }
-
-std::string LoadFile(const std::string& s)
+static std::string LoadFileStream(const std::string& s)
 {
     std::ifstream t(s);
     std::stringstream buffer;
@@ -14,4 +18,33 @@ std::string LoadFile(const std::string& s)
     return buffer.str();
 }
 
+std::string LoadFile(const boost::filesystem::path& p) { return LoadFile(p.string()); }
+
+std::string LoadFile(const std::string& s)
+{
+    namespace bip = boost::interprocess;
+
+    // Code objects and dbs are read in full, so map the file, let the kernel read it ahead and
+    // copy it once into a string of the final size. The stream is left for what cannot be
+    // mapped, e.g. empty files.
+    boost::system::error_code ec;
+    const auto size = boost::filesystem::file_size(s, ec);
+    if(ec || size == 0)
+        return LoadFileStream(s);
+
+    try
+    {
+        const auto file = bip::file_mapping{s.c_str(), bip::read_only};
+        auto region     = bip::mapped_region{file, bip::read_only, 0, size};
+        region.advise(bip::mapped_region::advice_sequential);
+        region.advise(bip::mapped_region::advice_willneed);
+        return {static_cast<const char*>(region.get_address()), region.get_size()};
+    }
+    catch(const bip::interprocess_exception& ex)
+    {
+        MIOPEN_LOG_I2("Unable to map " << s << ", reading it instead: " << ex.what());
+        return LoadFileStream(s);
+    }
+}
+
 } // namespace miopen
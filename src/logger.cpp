@@ -23,6 +23,7 @@
  * SOFTWARE.
  *
  *******************************************************************************/
+#include <miopen/call_record.hpp>
 #include <miopen/env.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/config.h>
@@ -163,11 +164,26 @@ const char* LoggingLevelToCString(const LoggingLevel level)
     else
         return "<Unknown>";
 }
-bool IsLoggingCmd()
+static bool IsPrintingCmd()
 {
     return miopen::IsEnabled(MIOPEN_ENABLE_LOGGING_CMD{}) && !IsLoggingDebugQuiet();
 }
 
+bool IsLoggingCmd() { return IsPrintingCmd() || call_record::IsEnabled(); }
+
+void LogDriverCmd(const std::string& function, const std::string& cmd)
+{
+    if(IsPrintingCmd())
+    {
+        std::ostringstream ss;
+        ss << LoggingPrefix() << "Command [" << function << "] ./bin/MIOpenDriver " << cmd
+           << std::endl;
+        std::cerr << ss.str();
+    }
+    if(call_record::IsEnabled())
+        call_record::Add(cmd);
+}
+
 std::string LoggingPrefix()
 {
     std::stringstream ss;
@@ -33,6 +33,8 @@
 #endif
 #include <miopen/db.hpp>
 
+#include <mutex>
+
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_AMD_FUSED_WINOGRAD)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_GCN_ASM_KERNELS)
 
@@ -218,19 +220,40 @@ bool FusionMDGraph::SetConvAlgo(miopenConvFwdAlgorithm_t algo)
 
 void FusionMDGraph::Init(FusionMDGraph& g, miopenFusionOp_t op)
 {
+    // The graphs only depend on the first op and on the environment, which is read once.
+    static std::mutex mutex;
+    static auto graphs = std::map<miopenFusionOp_t, std::shared_ptr<const MDGraph_edges>>{};
+    const std::lock_guard<std::mutex> lock{mutex};
+    const auto it = graphs.find(op);
+    if(it != graphs.end())
+    {
+        g.graph = it->second;
+        return;
+    }
+
+    FusionMDGraph built;
     switch(op)
     {
-    case miopenFusionOpConvForward: InitConv(g); break;
-    case miopenFusionOpBatchNormInference: InitBN(g); break;
-    case miopenFusionOpBatchNormFwdTrain: InitBNFwd(g); break;
-    case miopenFusionOpBatchNormBwdTrain: InitBNBwd(g); break;
+    case miopenFusionOpConvForward: InitConv(built); break;
+    case miopenFusionOpBatchNormInference: InitBN(built); break;
+    case miopenFusionOpBatchNormFwdTrain: InitBNFwd(built); break;
+    case miopenFusionOpBatchNormBwdTrain: InitBNBwd(built); break;
     case miopenFusionOpActivForward:
     case miopenFusionOpActivBackward:
     case miopenFusionOpBiasForward:
         MIOPEN_THROW(
             miopenStatusNotImplemented,
             "Operators Activ and Bias are not supported as first ops in a Fusion Plan (yet)");
+    case miopenFusionOpResidualAddForward:
+    case miopenFusionOpResidualAddBackward:
+        MIOPEN_THROW(
+            miopenStatusNotImplemented,
+            "Residual Add is only supported after a convolution or a training batch norm op");
+    case miopenFusionOpPoolingForward:
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "Pooling is only supported as the last op of a convolution fusion plan");
     }
+    g.graph = graphs[op] = std::make_shared<const MDGraph_edges>(std::move(built.edge_list));
 }
 
 static std::vector<DefaultKernelArg> BNFwdArgs(miopenBatchNormMode_t mode)
@@ -278,6 +301,23 @@ static std::vector<DefaultKernelArg> BNFwdArgs(miopenBatchNormMode_t mode)
     }
 }
 
+// With a residual add op between the batch norm and the activation the activation moves to op 2,
+// and the ops of the residual add are passed right after the output tensor.
+static std::vector<DefaultKernelArg> ResidualArgs(const std::vector<DefaultKernelArg>& bn_args,
+                                                  const std::vector<DefaultKernelArg>& res_args)
+{
+    std::vector<DefaultKernelArg> args;
+    for(auto arg : bn_args)
+    {
+        if(arg.op_idx == 1)
+            arg.op_idx = 2;
+        args.push_back(arg);
+        if(arg.type == OutputTensor)
+            args.insert(args.end(), res_args.begin(), res_args.end());
+    }
+    return args;
+}
+
 void FusionMDGraph::InitBNFwd(FusionMDGraph& g)
 {
     FusionMDGraph_Edge_Map empty_map;
@@ -317,6 +357,24 @@ void FusionMDGraph::InitBNFwd(FusionMDGraph& g)
                                                         "MIOpenBatchNormActivFwdTrainSpatial");
         activ_v->default_args = BNFwdArgs(miopenBNSpatial);
         g.AddEdge(bn_v, activ_v, empty_map);
+
+        // Batch Norm + Residual Add + Activation Fwd Training
+        const std::vector<DefaultKernelArg> res_args = {
+            DefaultKernelArg("residual", OpArg, OpKernelArg(nullptr), 1),
+        };
+        auto add_v = std::make_shared<MDGraph_vertex>(miopenFusionOpResidualAddForward,
+                                                      "MIOpenBatchNormActivFwdTrainSpatial.cl",
+                                                      "MIOpenBatchNormActivFwdTrainSpatial",
+                                                      "MIOpenBatchNormActivFwdTrainSpatial");
+        add_v->default_args = ResidualArgs(BNFwdArgs(miopenBNSpatial), res_args);
+        g.AddEdge(bn_v, add_v, empty_map);
+        auto res_activ_v =
+            std::make_shared<MDGraph_vertex>(miopenFusionOpActivForward,
+                                             "MIOpenBatchNormActivFwdTrainSpatial.cl",
+                                             "MIOpenBatchNormActivFwdTrainSpatial",
+                                             "MIOpenBatchNormActivFwdTrainSpatial");
+        res_activ_v->default_args = add_v->default_args;
+        g.AddEdge(add_v, res_activ_v, empty_map);
     }
 }
 
@@ -406,6 +464,25 @@ void FusionMDGraph::InitBNBwd(FusionMDGraph& g)
                                                         "MIOpenBatchNormActivBwdSpatial");
         activ_v->default_args = BNBwdArgs(miopenBNSpatial);
         g.AddEdge(bn_v, activ_v, empty_map);
+
+        // Batch Norm + Residual Add + Activation Backwards Training
+        const std::vector<DefaultKernelArg> res_args = {
+            DefaultKernelArg("residual", OpArg, OpKernelArg(nullptr), 1),
+            DefaultKernelArg("residualDiff", OpArg, OpKernelArg(nullptr), 1),
+        };
+        auto add_v = std::make_shared<MDGraph_vertex>(miopenFusionOpResidualAddBackward,
+                                                      "MIOpenBatchNormActivBwdSpatial.cl",
+                                                      "MIOpenBatchNormActivBwdSpatial",
+                                                      "MIOpenBatchNormActivBwdSpatial");
+        add_v->default_args = ResidualArgs(BNBwdArgs(miopenBNSpatial), res_args);
+        g.AddEdge(bn_v, add_v, empty_map);
+        auto res_activ_v =
+            std::make_shared<MDGraph_vertex>(miopenFusionOpActivBackward,
+                                             "MIOpenBatchNormActivBwdSpatial.cl",
+                                             "MIOpenBatchNormActivBwdSpatial",
+                                             "MIOpenBatchNormActivBwdSpatial");
+        res_activ_v->default_args = add_v->default_args;
+        g.AddEdge(add_v, res_activ_v, empty_map);
     }
 }
 
@@ -476,6 +553,31 @@ static std::vector<DefaultKernelArg> WinogradNodeArgs()
     };
 }
 
+// The v21 kernels extend the fused Winograd argument list with explicit strides and group
+// count. The stride flags are left unset, so the strides are ignored and packed NCHW is assumed.
+static std::vector<DefaultKernelArg> WinogradV21NodeArgs()
+{
+    auto zero_int = OpKernelArg(static_cast<int>(0));
+    auto args     = WinogradNodeArgs();
+    for(const auto& key : {"d_N_stride",
+                           "d_C_stride",
+                           "d_H_stride",
+                           "d_W_stride",
+                           "f_K_stride",
+                           "f_C_stride",
+                           "f_R_stride",
+                           "f_S_stride",
+                           "o_N_stride",
+                           "o_K_stride",
+                           "o_H_stride",
+                           "o_W_stride"})
+        args.emplace_back(key, Other, zero_int);
+    args.emplace_back("G", Other, OpKernelArg(static_cast<int>(1)));
+    for(const auto& key : {"d_G_stride", "f_G_stride", "o_G_stride"})
+        args.emplace_back(key, Other, zero_int);
+    return args;
+}
+
 void FusionMDGraph::InitConv(FusionMDGraph& g)
 {
     const auto common_constr = {
@@ -686,6 +788,80 @@ void FusionMDGraph::InitConv(FusionMDGraph& g)
             g.AddEdge(vc_s2, va_leaf_s2, edg_activ_relu_s2);
             g.AddEdge(vc_s2, va_leaf_s2, edg_activ_leaky_relu_s2);
         }
+
+        // Half precision, fp16 dot2 f2x3 kernels
+        for(const auto stride : {1, 2})
+        {
+            const auto postfix    = "_v21_1_0_gfx9_fp16_dot2_edc_stride" + std::to_string(stride);
+            const auto program_h  = "Conv_Winograd" + postfix + ".s";
+            const auto kernel_h   = "miopenSp3AsmConv" + postfix;
+            const auto stride_str = std::to_string(stride);
+
+            auto vc_h = std::make_shared<MDGraph_vertex>(
+                miopenFusionOpConvForward, program_h, kernel_h, algo);
+            vc_h->solver         = solver::ConvBinWinogradRxSFused{};
+            vc_h->default_args   = WinogradV21NodeArgs();
+            vc_h->supported_arch = {"gfx906", "gfx908"};
+
+            FusionMDGraph_Edge_Map map_wino_conv_h;
+            map_wino_conv_h["constraints"] = {"group_count == 1",
+                                              "stride_h == " + stride_str,
+                                              "stride_w == " + stride_str,
+                                              "dilation_h == 1",
+                                              "dilation_w == 1",
+                                              "precision == miopenHalf",
+                                              "iN < (2^16)",
+                                              "c < (2^16)",
+                                              "k < (2^16)",
+                                              "iH < (2^16)",
+                                              "iW < (2^16)",
+                                              "oH < (2^16)",
+                                              "oW < (2^16)",
+                                              "pad_h < (2^16)",
+                                              "pad_w < (2^16)",
+                                              "x < (2^16)",
+                                              "y < (2^16)",
+                                              "c * iH * iW <= (2^28)",
+                                              "oH * oW <= (2^23)",
+                                              "k * oH * oW <= (2^28)",
+                                              "k * x * y <= (2^28)",
+                                              "c * x * y <= (2^28)",
+                                              "weight === 5",
+                                              "algo === miopenConvolutionFwdAlgoWinograd"};
+            g.AddEdge(nullptr, vc_h, map_wino_conv_h);
+
+            FusionMDGraph_Edge_Map edg_activ_relu_h;
+            edg_activ_relu_h["constraints"] = {"activ_mode == miopenActivationRELU",
+                                               "weight === 0"};
+
+            /// C>B>A|
+            auto vb_h = std::make_shared<MDGraph_vertex>(
+                miopenFusionOpBiasForward, program_h, kernel_h, algo);
+            vb_h->default_args                = WinogradV21NodeArgs();
+            vb_h->default_args[6].default_val = OpKernelArg(1 << 7);
+            vb_h->default_args[18].type       = OpArg;
+            vb_h->default_args[18].op_idx     = 1;
+            g.AddEdge(vc_h, vb_h, empty_map);
+
+            auto vba_leaf_h = std::make_shared<MDGraph_vertex>(
+                miopenFusionOpActivForward, program_h, kernel_h, algo, true);
+            vba_leaf_h->default_args                = WinogradV21NodeArgs();
+            vba_leaf_h->default_args[6].default_val = OpKernelArg((1 << 7) + (1 << 8));
+            vba_leaf_h->default_args[18].type       = OpArg;
+            vba_leaf_h->default_args[18].op_idx     = 1;
+            vba_leaf_h->default_args[19].type       = OpArg;
+            vba_leaf_h->default_args[19].op_idx     = 2;
+            g.AddEdge(vb_h, vba_leaf_h, edg_activ_relu_h);
+
+            /// C>A|
+            auto va_leaf_h = std::make_shared<MDGraph_vertex>(
+                miopenFusionOpActivForward, program_h, kernel_h, algo, true);
+            va_leaf_h->default_args                = WinogradV21NodeArgs();
+            va_leaf_h->default_args[6].default_val = OpKernelArg((1 << 8));
+            va_leaf_h->default_args[19].type       = OpArg;
+            va_leaf_h->default_args[19].op_idx     = 1;
+            g.AddEdge(vc_h, va_leaf_h, edg_activ_relu_h);
+        }
     }
 
     // first path (asm kernel)
@@ -736,6 +912,21 @@ void FusionMDGraph::InitConv(FusionMDGraph& g)
             g.AddEdge(bias_v, activ_v, empty_map);
 
             g.AddEdge(conv_v, activ_v, empty_map);
+
+            // Conv -> Bias -> Residual Add -> Activ
+            auto add_v = std::make_shared<MDGraph_vertex>(miopenFusionOpResidualAddForward,
+                                                          "conv1x1u_bias_activ.s",
+                                                          "miopenGcnAsmConv1x1U",
+                                                          "miopenConvolutionDirectBiasActivAsm");
+            g.AddEdge(bias_v, add_v, empty_map);
+
+            auto res_activ_v =
+                std::make_shared<MDGraph_vertex>(miopenFusionOpActivForward,
+                                                 "conv1x1u_bias_activ.s",
+                                                 "miopenGcnAsmConv1x1U",
+                                                 "miopenConvolutionDirectBiasActivAsm",
+                                                 true);
+            g.AddEdge(add_v, res_activ_v, empty_map);
         }
         // half precision
         {
@@ -788,6 +979,21 @@ void FusionMDGraph::InitConv(FusionMDGraph& g)
             g.AddEdge(bias_v, activ_v, empty_map);
 
             g.AddEdge(conv_v, activ_v, empty_map);
+
+            // Conv -> Bias -> Residual Add -> Activ
+            auto add_v = std::make_shared<MDGraph_vertex>(miopenFusionOpResidualAddForward,
+                                                          "conv1x1u_bias_activ.s",
+                                                          "miopenGcnAsmConv1x1U",
+                                                          "miopenConvolutionDirectBiasActivAsm");
+            g.AddEdge(bias_v, add_v, empty_map);
+
+            auto res_activ_v =
+                std::make_shared<MDGraph_vertex>(miopenFusionOpActivForward,
+                                                 "conv1x1u_bias_activ.s",
+                                                 "miopenGcnAsmConv1x1U",
+                                                 "miopenConvolutionDirectBiasActivAsm",
+                                                 true);
+            g.AddEdge(add_v, res_activ_v, empty_map);
         }
     }
 
@@ -850,6 +1056,21 @@ void FusionMDGraph::InitConv(FusionMDGraph& g)
 
                 g.AddEdge(conv_v, activ_v, empty_map);
             }
+            { // Conv -> (Bias) -> Residual Add -> (Activ)
+                auto add_v   = std::make_shared<MDGraph_vertex>(miopenFusionOpResidualAddForward,
+                                                                "MIOpenConvDirBatchNormActiv.cl",
+                                                                "MIOpenConvUniBatchNormActiv",
+                                                                "miopenConvolutionDirectBiasActiv",
+                                                                true);
+                auto activ_v = std::make_shared<MDGraph_vertex>(miopenFusionOpActivForward,
+                                                                "MIOpenConvDirBatchNormActiv.cl",
+                                                                "MIOpenConvUniBatchNormActiv",
+                                                                "miopenConvolutionDirectBiasActiv",
+                                                                true);
+                g.AddEdge(bias_v, add_v, empty_map);
+                g.AddEdge(conv_v, add_v, empty_map);
+                g.AddEdge(add_v, activ_v, empty_map);
+            }
         }
     }
 
@@ -941,68 +1162,39 @@ void FusionMDGraph::AddEdge(MDGraph_vertex_ptr src,
                             MDGraph_vertex_ptr dst,
                             FusionMDGraph_Edge_Map& map)
 {
-    if(edge_list[src][dst].empty())
-    {
-        edge_list[src][dst] = {map};
-    }
-    else
-    {
-        edge_list[src][dst].emplace_back(map);
-    }
-}
-
-bool FusionMDGraph::CmpOpKey(const FusionMDGraph_Edge_Map& edge_val,
-                             std::function<bool(const std::string& sym, int& val)> attr_fun,
-                             std::unordered_map<std::string, int>& syms) const
-{
-    for(auto& kv : edge_val)
+    MDGraph_edge edge;
+    for(auto& kv : map)
     {
         if(kv.first == "constraints")
         {
-            tree_visit v(attr_fun);
             for(auto& edg_op : kv.second)
-            {
-                using It = std::string::const_iterator;
-                It f(edg_op.begin()), l(edg_op.end());
-                MDGExprParser p;
-                boost::spirit::utree e;
-                auto parse_success =
-                    boost::spirit::qi::phrase_parse(f, l, p, boost::spirit::ascii::space, e);
-                if(!parse_success)
-                {
-                    MIOPEN_LOG_I2(
-                        "Remaining unparsed: " << std::string(edg_op.begin(), edg_op.end()));
-                    MIOPEN_THROW(miopenStatusInternalError,
-                                 "Unable to parse graph constraint expression");
-                }
-                visit_res r = boost::spirit::utree::visit(e, v);
-                v.tabl.insert(r.tabl.begin(), r.tabl.end());
-                syms = v.tabl;
-                if(r.b_res)
-                {
-                    MIOPEN_LOG_I2("Constraint satisfied: " + edg_op);
-                }
-                else
-                {
-                    MIOPEN_LOG_I("Condition unsuccessful while matching graph: " + edg_op);
-                    return false;
-                }
-            }
+                edge.constraints.emplace_back(edg_op);
         }
         else
         {
             assert(false);
         }
     }
-    return true;
+    edge.map = map;
+    edge_list[src][dst].push_back(std::move(edge));
+}
+
+bool FusionMDGraph::CmpOpKey(const MDGraph_edge& edge,
+                             MDGSymbolTable& symbols,
+                             MDGLocals& locals) const
+{
+    return MDGEvaluate(edge.constraints, symbols, locals);
 }
 
 bool FusionMDGraph::Advance(std::shared_ptr<FusionOpDescriptor> op,
                             std::function<bool(const std::string& sym, int& val)> attr_fun)
 {
     MIOPEN_LOG_I("Adding Op: " << *op);
+    static const auto weight_sym = MDGSymbolIndex("weight");
+    static const auto algo_sym   = MDGSymbolIndex("algo");
     std::vector<std::pair<MDGraph_vertex_ptr, cur_vertex_map>> new_list;
     std::set<miopenConvFwdAlgorithm_t> new_set;
+    MDGSymbolTable symbols{std::move(attr_fun)};
     // iterate over the list of current vertices
     for(auto& kinder : cur_vertex)
     {
@@ -1016,9 +1208,11 @@ bool FusionMDGraph::Advance(std::shared_ptr<FusionOpDescriptor> op,
             MIOPEN_LOG_I2("Current vertex: " << *cur_vertex_ptr);
         }
         // get the children of the cur_vertex
-        auto& ch = edge_list[cur_vertex_ptr];
+        const auto children = graph->find(cur_vertex_ptr);
+        if(children == graph->end())
+            continue;
         // if op is in the children and the edge key satisfies update cur_vertex
-        for(auto& ch_it : ch)
+        for(auto& ch_it : children->second)
         {
             auto cur_map = kinder.second;
             MIOPEN_LOG_I2("Current path weight: " << boost::any_cast<int>(cur_map["weight"]));
@@ -1026,16 +1220,22 @@ bool FusionMDGraph::Advance(std::shared_ptr<FusionOpDescriptor> op,
             std::set<miopenConvFwdAlgorithm_t> cur_path_set;
             if(ch_it.first->op == op->kind())
             {
-                for(auto& edg_map : ch_it.second)
+                for(auto& edge : ch_it.second)
                 {
                     int weight = boost::any_cast<int>(cur_map["weight"]);
-                    std::unordered_map<std::string, int> syms;
-                    if(CmpOpKey(edg_map, attr_fun, syms))
+                    MDGLocals syms;
+                    if(CmpOpKey(edge, symbols, syms))
                     {
                         MIOPEN_LOG_I2("Key Match Successfull");
-                        if(syms.count("weight") != 0)
+                        const auto get_sym = [&](std::size_t sym) {
+                            return std::find_if(syms.begin(), syms.end(), [&](const auto& l) {
+                                return l.first == sym;
+                            });
+                        };
+                        const auto weight_it = get_sym(weight_sym);
+                        if(weight_it != syms.end())
                         {
-                            weight += syms.at("weight");
+                            weight += weight_it->second;
                         }
                         else
                         {
@@ -1046,9 +1246,10 @@ bool FusionMDGraph::Advance(std::shared_ptr<FusionOpDescriptor> op,
                         // Update the algo set
                         if(op->kind() == miopenFusionOpConvForward)
                         {
-                            if(syms.count("algo") != 0)
+                            const auto algo_it = get_sym(algo_sym);
+                            if(algo_it != syms.end())
                             {
-                                auto algo = static_cast<miopenConvFwdAlgorithm_t>(syms.at("algo"));
+                                auto algo = static_cast<miopenConvFwdAlgorithm_t>(algo_it->second);
                                 MIOPEN_LOG_I2("Operator Matched: Convolution: Algo: " +
                                               std::to_string(algo));
                                 cur_path_set.insert(algo);
@@ -1169,7 +1370,7 @@ void FusionMDGraph::WriteToFile(std::string filename)
     std::stringstream dot_graph;
     dot_file.open(filename);
 
-    for(auto& edge : edge_list)
+    for(auto& edge : *graph)
     {
         nodes.insert(edge.first);
         for(auto& edge2 : edge.second)
@@ -1194,7 +1395,7 @@ void FusionMDGraph::WriteToFile(std::string filename)
 
     int src_id, dst_id;
 
-    for(auto& edge : edge_list)
+    for(auto& edge : *graph)
     {
         if(edge.first != nullptr)
             src_id = edge.first->id;
@@ -1206,10 +1407,10 @@ void FusionMDGraph::WriteToFile(std::string filename)
                 dst_id = edge2.first->id;
             else
                 dst_id = 0;
-            for(auto& edg_map : edge2.second)
+            for(auto& edg : edge2.second)
             {
                 std::stringstream edge_label;
-                for(auto& edg_ops : edg_map)
+                for(auto& edg_ops : edg.map)
                 {
                     for(auto& e : edg_ops.second)
                     {
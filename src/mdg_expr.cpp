@@ -1,4 +1,8 @@
 #include <miopen/mdg_expr.hpp>
+#include <miopen/md_graph.hpp>
+
+#include <deque>
+#include <mutex>
 
 namespace miopen {
 
@@ -50,4 +54,260 @@ MDGExprParser::MDGExprParser() : MDGExprParser::base_type(expression)
     BOOST_SPIRIT_DEBUG_NODE(variable);
 }
 
+namespace {
+
+struct MDGSymbols
+{
+    std::mutex mutex;
+    std::unordered_map<std::string, std::size_t> indices;
+    std::deque<std::string> names;
+};
+
+MDGSymbols& GetMDGSymbols()
+{
+    static MDGSymbols symbols;
+    return symbols;
+}
+
+// Flattens the tree of an expression into nodes, the same way tree_visit interprets it.
+struct tree_flatten
+{
+    using result_type = std::size_t;
+    std::vector<MDGConstraint::Node>* nodes;
+
+    std::size_t Add(MDGConstraint::NodeKind kind,
+                    int value,
+                    MDGraph_op_t op = OpAny,
+                    std::size_t lhs = 0,
+                    std::size_t rhs = 0)
+    {
+        nodes->push_back({kind, op, value, lhs, rhs});
+        return nodes->size() - 1;
+    }
+
+    std::size_t operator()(spirit::utree::invalid_type) { return Add(MDGConstraint::Constant, 0); }
+    std::size_t operator()(spirit::utree::nil_type) { return Add(MDGConstraint::Constant, 0); }
+    std::size_t operator()(double d)
+    {
+        return Add(MDGConstraint::Constant, static_cast<int>(d));
+    }
+    std::size_t operator()(int i) { return Add(MDGConstraint::Constant, i); }
+    std::size_t operator()(bool b) { return Add(MDGConstraint::Boolean, b ? 1 : 0); }
+
+    template <typename T>
+    std::size_t operator()(T /*val*/)
+    {
+        return Add(MDGConstraint::Constant, 0);
+    }
+
+    std::size_t operator()(spirit::binary_range_type const& /*b*/)
+    {
+        return Add(MDGConstraint::Constant, 0);
+    }
+
+    std::size_t operator()(spirit::utf8_string_range_type const& str)
+    {
+        const auto index = MDGSymbolIndex(std::string(str.begin(), str.end()));
+        return Add(MDGConstraint::Symbol, static_cast<int>(index));
+    }
+
+    std::size_t operator()(spirit::utf8_symbol_range_type const& /*str*/)
+    {
+        return Add(MDGConstraint::Constant, 0);
+    }
+
+    template <typename Iterator>
+    std::size_t operator()(boost::iterator_range<Iterator> const& range)
+    {
+        std::vector<spirit::utree> v(range.begin(), range.end());
+        assert(v.size() == 3);
+        // An unknown operator is only an error if the constraint is evaluated.
+        auto op    = OpEval;
+        auto value = 0;
+        try
+        {
+            tree_visit op_visit;
+            op = boost::spirit::utree::visit(v[0], op_visit).op;
+        }
+        catch(const Exception&)
+        {
+            const auto sym = v[0].get<spirit::utf8_symbol_range_type>();
+            value          = static_cast<int>(MDGSymbolIndex(std::string(sym.begin(), sym.end())));
+        }
+        const auto lhs = boost::spirit::utree::visit(v[1], *this);
+        const auto rhs = boost::spirit::utree::visit(v[2], *this);
+        return Add(MDGConstraint::Binary, value, op, lhs, rhs);
+    }
+
+    std::size_t operator()(spirit::any_ptr const&) { return Add(MDGConstraint::Constant, 0); }
+
+    std::size_t operator()(spirit::function_base const&)
+    {
+        return Add(MDGConstraint::Constant, 0);
+    }
+};
+
+struct MDGValue
+{
+    int res         = 0;
+    bool b_res      = false;
+    bool unresolved = false;
+    std::size_t sym = 0;
+};
+
+MDGValue MDGEval(const MDGConstraint& constraint,
+                 std::size_t index,
+                 MDGSymbolTable& symbols,
+                 MDGLocals& locals,
+                 bool root)
+{
+    const auto& node = constraint.nodes[index];
+    MDGValue r;
+    switch(node.kind)
+    {
+    case MDGConstraint::Constant: r.res = node.value; return r;
+    case MDGConstraint::Boolean: r.b_res = node.value != 0; return r;
+    case MDGConstraint::Symbol:
+    {
+        const auto sym = static_cast<std::size_t>(node.value);
+        if(symbols.Lookup(sym, r.res))
+            return r;
+        const auto local = std::find_if(
+            locals.begin(), locals.end(), [&](const auto& l) { return l.first == sym; });
+        if(local != locals.end())
+        {
+            r.res = local->second;
+            return r;
+        }
+        r.unresolved = true;
+        r.sym        = sym;
+        return r;
+    }
+    case MDGConstraint::Binary: break;
+    }
+
+    if(node.op == OpEval)
+        MIOPEN_THROW(miopenStatusInternalError,
+                     "Parsing error: Unknown operator: " + MDGSymbolName(node.value));
+    const auto lhs_res = MDGEval(constraint, node.lhs, symbols, locals, false);
+    const auto rhs_res = MDGEval(constraint, node.rhs, symbols, locals, false);
+    if(node.op != OpAssign && lhs_res.unresolved)
+        MIOPEN_THROW("Invalid variable access: " + MDGSymbolName(lhs_res.sym));
+
+    switch(node.op)
+    {
+    // Arith ops
+    case OpAdd: r.res    = lhs_res.res + rhs_res.res; break;
+    case OpSub: r.res    = lhs_res.res - rhs_res.res; break;
+    case OpMul: r.res    = lhs_res.res * rhs_res.res; break;
+    case OpDiv: r.res    = lhs_res.res / rhs_res.res; break;
+    case OpModulo: r.res = lhs_res.res % rhs_res.res; break;
+    case OpPow: r.res    = static_cast<int>(std::pow(lhs_res.res, rhs_res.res)); break;
+    case OpCeil:
+    {
+        int vv = lhs_res.res;
+        int mm = rhs_res.res;
+        r.res  = (vv % mm != 0) ? (vv / mm + 1) * mm : vv;
+        break;
+    }
+    case OpAssign:
+        // Only the assignments of whole constraints to new symbols are kept.
+        if(root && lhs_res.unresolved)
+            locals.emplace_back(lhs_res.sym, rhs_res.res);
+        r.b_res = true;
+        break;
+    // Logical ops
+    case OpEqual: r.b_res    = lhs_res.res == rhs_res.res; break;
+    case OpNotEqual: r.b_res = lhs_res.res != rhs_res.res; break;
+    case OpGTE: r.b_res      = lhs_res.res >= rhs_res.res; break;
+    case OpLTE: r.b_res      = lhs_res.res <= rhs_res.res; break;
+    case OpGT: r.b_res       = lhs_res.res > rhs_res.res; break;
+    case OpLT: r.b_res       = lhs_res.res < rhs_res.res; break;
+    case OpAnd: r.b_res      = lhs_res.b_res && rhs_res.b_res; break;
+    case OpOr: r.b_res       = lhs_res.b_res || rhs_res.b_res; break;
+    case OpAny:
+    case OpEval: MIOPEN_THROW("Unsupported op");
+    }
+    if(node.op != OpAssign && r.b_res)
+        r.res = 1;
+    return r;
+}
+
+} // namespace
+
+std::size_t MDGSymbolIndex(const std::string& sym)
+{
+    auto& symbols = GetMDGSymbols();
+    const std::lock_guard<std::mutex> lock{symbols.mutex};
+    const auto inserted = symbols.indices.emplace(sym, symbols.names.size());
+    if(inserted.second)
+        symbols.names.push_back(sym);
+    return inserted.first->second;
+}
+
+std::string MDGSymbolName(std::size_t index)
+{
+    auto& symbols = GetMDGSymbols();
+    const std::lock_guard<std::mutex> lock{symbols.mutex};
+    return symbols.names.at(index);
+}
+
+MDGConstraint::MDGConstraint(const std::string& expr) : text(expr)
+{
+    MDGExprParser p;
+    boost::spirit::utree e;
+    auto f = text.cbegin();
+    // A constraint which does not parse is left without nodes and fails when evaluated.
+    if(!boost::spirit::qi::phrase_parse(f, text.cend(), p, boost::spirit::ascii::space, e))
+        return;
+    boost::spirit::utree::visit(e, tree_flatten{&nodes});
+}
+
+MDGSymbolTable::MDGSymbolTable(std::function<bool(const std::string& sym, int& val)> f)
+    : lookup(std::move(f))
+{
+}
+
+bool MDGSymbolTable::Lookup(std::size_t sym, int& val)
+{
+    if(sym >= state.size())
+    {
+        state.resize(sym + 1, 0);
+        values.resize(sym + 1, 0);
+    }
+    // 0: not looked up yet, 1: undefined, 2: defined.
+    if(state[sym] == 0)
+        state[sym] = lookup(MDGSymbolName(sym), values[sym]) ? 2 : 1;
+    if(state[sym] == 1)
+        return false;
+    val = values[sym];
+    return true;
+}
+
+bool MDGEvaluate(const std::vector<MDGConstraint>& constraints,
+                 MDGSymbolTable& symbols,
+                 MDGLocals& locals)
+{
+    for(const auto& constraint : constraints)
+    {
+        if(constraint.nodes.empty())
+        {
+            MIOPEN_LOG_I2("Remaining unparsed: " << constraint.text);
+            MIOPEN_THROW(miopenStatusInternalError, "Unable to parse graph constraint expression");
+        }
+        const auto r =
+            MDGEval(constraint, constraint.nodes.size() - 1, symbols, locals, true);
+        if(r.b_res)
+        {
+            MIOPEN_LOG_I2("Constraint satisfied: " << constraint.text);
+        }
+        else
+        {
+            MIOPEN_LOG_I("Condition unsuccessful while matching graph: " << constraint.text);
+            return false;
+        }
+    }
+    return true;
+}
+
 } // namespace miopen
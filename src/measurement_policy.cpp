@@ -0,0 +1,112 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/measurement_policy.hpp>
+
+#include <miopen/config.h>
+#include <miopen/env.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TUNING_WARMUP_RUNS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TUNING_MAX_RUNS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TUNING_PRUNE_PERCENT)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TUNING_TARGET_ERROR_PERCENT)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TUNING_MIN_SPAN_US)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TUNING_MAX_BATCH)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TUNING_CLOCK_DRIFT_PERCENT)
+
+namespace miopen {
+namespace solver {
+
+void RunningStats::Add(float sample)
+{
+    ++count;
+    const auto delta = sample - mean;
+    mean += delta / count;
+    m2 += delta * (sample - mean);
+}
+
+float RunningStats::Variance() const
+{
+    return count < 2 ? 0.0f : static_cast<float>(m2 / (count - 1));
+}
+
+float RunningStats::RelativeError() const
+{
+    if(count < 2 || mean <= 0.0)
+        return 0.0f;
+    return static_cast<float>(std::sqrt(Variance() / count) / mean);
+}
+
+MeasurementPolicy MeasurementPolicy::FromEnv()
+{
+    MeasurementPolicy policy;
+    policy.warmup_runs = Value(MIOPEN_DEBUG_TUNING_WARMUP_RUNS{}, policy.warmup_runs);
+    policy.max_runs    = std::max<std::size_t>(Value(MIOPEN_DEBUG_TUNING_MAX_RUNS{}, 5), 1);
+    policy.prune_ratio = 1.0f + Value(MIOPEN_DEBUG_TUNING_PRUNE_PERCENT{}, 5) / 100.0f;
+    policy.target_rel_error = Value(MIOPEN_DEBUG_TUNING_TARGET_ERROR_PERCENT{}, 0) / 100.0f;
+#if MIOPEN_BACKEND_HIP
+    // OpenCL profiles the launches one by one, see Handle::ProfileBatch().
+    policy.min_span_ms = Value(MIOPEN_DEBUG_TUNING_MIN_SPAN_US{}, 0) / 1000.0f;
+#endif
+    policy.max_batch = std::max<std::size_t>(Value(MIOPEN_DEBUG_TUNING_MAX_BATCH{}, 256), 1);
+    policy.clock_drift_ratio = Value(MIOPEN_DEBUG_TUNING_CLOCK_DRIFT_PERCENT{}, 5) / 100.0f;
+    return policy;
+}
+
+bool MeasurementPolicy::NeedsMoreRuns(const RunningStats& stats) const
+{
+    if(stats.Count() >= max_runs)
+        return false;
+    // The variance estimate is too rough with less than 3 samples.
+    if(target_rel_error > 0.0f && stats.Count() >= 3)
+        return stats.RelativeError() > target_rel_error;
+    return true;
+}
+
+std::size_t MeasurementPolicy::GetBatchSize(float single_time) const
+{
+    if(min_span_ms <= 0.0f || single_time >= min_span_ms)
+        return 1;
+    // Below the resolution of the events.
+    if(single_time <= 0.0f)
+        return max_batch;
+    const auto batch = static_cast<std::size_t>(std::ceil(min_span_ms / single_time));
+    return std::min(std::max<std::size_t>(batch, 1), max_batch);
+}
+
+bool MeasurementPolicy::IsClockDrifted(const GpuConditions& reference,
+                                       const GpuConditions& now) const
+{
+    if(clock_drift_ratio <= 0.0f || !reference.IsKnown() || !now.IsKnown())
+        return false;
+    return std::abs(now.sclk_mhz - reference.sclk_mhz) > clock_drift_ratio * reference.sclk_mhz;
+}
+
+} // namespace solver
+} // namespace miopen
@@ -122,27 +122,35 @@ static auto GetDirectSolvers()
                                            miopen::solver::ConvAsm5x10u2v2f1,
                                            miopen::solver::ConvAsm7x7c3h224w224k64u2v2p3q3f1,
                                            miopen::solver::ConvAsm5x10u2v2b1,
+                                           miopen::solver::ConvDirectDepthwiseFwd,
+                                           miopen::solver::ConvDirectDepthwiseBwd,
+                                           miopen::solver::ConvDirectTransposePhaseBwd,
                                            miopen::solver::ConvOclDirectFwd11x11,
                                            miopen::solver::ConvOclDirectFwdGen,
                                            miopen::solver::ConvOclDirectFwd3x3,
                                            miopen::solver::ConvOclDirectFwd1x1,
-                                           miopen::solver::ConvOclDirectFwd>{};
+                                           miopen::solver::ConvOclDirectFwd,
+                                           miopen::solver::ConvDirectNaiveConvFwd,
+                                           miopen::solver::ConvDirectNaiveConvBwd>{};
 }
 
 static auto GetImplicitGemmSolvers()
 {
-    return miopen::solver::SolverContainer<miopen::solver::ConvHipImplicitGemmForwardV4R4Xdlops,
-                                           miopen::solver::ConvHipImplicitGemmV4R4GenXdlopsFwdFp32,
-                                           miopen::solver::ConvHipImplicitGemmV4R4GenFwdXdlops,
-                                           miopen::solver::ConvHipImplicitGemmBwdDataV4R1Xdlops,
-                                           miopen::solver::ConvHipImplicitGemmBwdDataV1R1Xdlops,
-                                           miopen::solver::ConvHipImplicitGemmV4R1Fwd,
-                                           miopen::solver::ConvHipImplicitGemmV4R4Fwd,
-                                           miopen::solver::ConvHipImplicitGemmBwdDataV1R1,
-                                           miopen::solver::ConvHipImplicitGemmBwdDataV4R1,
-                                           miopen::solver::ConvAsmImplicitGemmV4R1DynamicFwd_1x1,
-                                           miopen::solver::ConvAsmImplicitGemmV4R1DynamicFwd,
-                                           miopen::solver::ConvAsmImplicitGemmV4R1DynamicBwd>{};
+    return miopen::solver::SolverContainer<
+        miopen::solver::ConvHipImplicitGemmForwardV4R4Xdlops,
+        miopen::solver::ConvHipImplicitGemmV4R4GenXdlopsFwdFp32,
+        miopen::solver::ConvHipImplicitGemmV4R4GenFwdXdlops,
+        miopen::solver::ConvHipImplicitGemmBwdDataV4R1Xdlops,
+        miopen::solver::ConvHipImplicitGemmBwdDataV1R1Xdlops,
+        miopen::solver::ConvHipImplicitGemmV4R1Fwd,
+        miopen::solver::ConvHipImplicitGemmV4R4Fwd,
+        miopen::solver::ConvHipImplicitGemmBwdDataV1R1,
+        miopen::solver::ConvHipImplicitGemmBwdDataV4R1,
+        miopen::solver::ConvAsmImplicitGemmV4R1DynamicFwd_1x1,
+        miopen::solver::ConvAsmImplicitGemmV4R1DynamicFwd,
+        miopen::solver::ConvAsmImplicitGemmV4R1DynamicBwd,
+        miopen::solver::ConvHipImplicitGemmForwardV4R4XdlopsDynamic,
+        miopen::solver::ConvHipImplicitGemmBwdDataV4R1XdlopsDynamic>{};
 }
 
 static auto GetWindogradSolvers()
@@ -151,6 +159,8 @@ static auto GetWindogradSolvers()
                                            miopen::solver::ConvBinWinogradRxSf3x2,
                                            miopen::solver::ConvBinWinogradRxSf2x3,
                                            miopen::solver::ConvBinWinogradRxS,
+                                           miopen::solver::ConvBinWinogradRxSf3x2Dilated,
+                                           miopen::solver::ConvBinWinogradRxSDilated,
                                            miopen::solver::ConvMPBidirectWinograd<3, 3>,
                                            miopen::solver::ConvMPBidirectWinograd<4, 3>,
                                            miopen::solver::ConvMPBidirectWinograd<5, 3>,
@@ -159,11 +169,13 @@ static auto GetWindogradSolvers()
 
 static auto GetImplicitGemmWrWSolvers()
 {
-    return miopen::solver::SolverContainer<miopen::solver::ConvHipImplicitGemmV4R4GenXdlopsWrWFp32,
-                                           miopen::solver::ConvHipImplicitGemmV4R4GenWrWXdlops,
-                                           miopen::solver::ConvHipImplicitGemmV4R1WrW,
-                                           miopen::solver::ConvHipImplicitGemmV4R4WrW,
-                                           miopen::solver::ConvAsmImplicitGemmV4R1DynamicWrw>{};
+    return miopen::solver::SolverContainer<
+        miopen::solver::ConvHipImplicitGemmV4R4GenXdlopsWrWFp32,
+        miopen::solver::ConvHipImplicitGemmV4R4GenWrWXdlops,
+        miopen::solver::ConvHipImplicitGemmV4R1WrW,
+        miopen::solver::ConvHipImplicitGemmV4R4WrW,
+        miopen::solver::ConvAsmImplicitGemmV4R1DynamicWrw,
+        miopen::solver::ConvHipImplicitGemmWrwV4R4XdlopsDynamic>{};
 }
 
 static auto GetWindogradWrWSolvers()
@@ -189,6 +201,7 @@ static auto GetBwdWrW2DSolvers()
 {
     return miopen::solver::SolverContainer<miopen::solver::ConvAsmBwdWrW1x1,
                                            miopen::solver::ConvAsmBwdWrW3x3,
+                                           miopen::solver::ConvDirectDepthwiseWrw,
                                            miopen::solver::ConvOclBwdWrW2<1>,
                                            miopen::solver::ConvOclBwdWrW2<2>,
                                            miopen::solver::ConvOclBwdWrW2<4>,
@@ -196,7 +209,8 @@ static auto GetBwdWrW2DSolvers()
                                            miopen::solver::ConvOclBwdWrW2<16>,
                                            miopen::solver::ConvOclBwdWrW2NonTunable,
                                            miopen::solver::ConvOclBwdWrW53,
-                                           miopen::solver::ConvOclBwdWrW1x1>{};
+                                           miopen::solver::ConvOclBwdWrW1x1,
+                                           miopen::solver::ConvDirectNaiveConvWrw>{};
 }
 
 std::vector<miopen::solver::ConvSolution>
@@ -269,7 +283,7 @@ FindAllBwdWrW2DSolutions(const miopen::ConvolutionContext& ctx,
 
 void miopen::ConvolutionContext::SetupFloats()
 {
-    if(IsFp32() || IsFp16() || IsBfp16())
+    if(IsFp32() || IsFp16() || IsBfp16() || IsInt8())
     {
         general_compile_options += GetDataTypeKernelParams(in_data_type);
     }
@@ -293,6 +307,17 @@ void mlo_construct_activ_lrn_pooling_common::setupFloats()
     {
         _search_params.general_compile_options += " -DMIOPEN_USE_FP32=0 -DMIOPEN_USE_FP16=1";
     }
+    else if(_search_params.in_data_type == miopenInt8 && _search_params.out_data_type == miopenInt8)
+    {
+        _search_params.general_compile_options +=
+            " -DMIOPEN_USE_FP32=0 -DMIOPEN_USE_FP16=0 -DMIOPEN_USE_INT8=1";
+    }
+    else if(_search_params.in_data_type == miopenInt8x4 &&
+            _search_params.out_data_type == miopenInt8x4)
+    {
+        _search_params.general_compile_options +=
+            " -DMIOPEN_USE_FP32=0 -DMIOPEN_USE_FP16=0 -DMIOPEN_USE_INT8x4=1";
+    }
     else
     {
         MIOPEN_LOG_W("Unsupported data types configuration: "
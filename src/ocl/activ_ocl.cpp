@@ -31,6 +31,70 @@
 
 namespace miopen {
 
+// Quantized tensors are activated in fp32 and requantized with scale, see MIOpenNeuronInt8.cl.
+static void ActivationForwardInt8(Handle& handle,
+                                  const ActivationDescriptor& desc,
+                                  float scale,
+                                  const TensorDescriptor& xDesc,
+                                  ConstData_t x,
+                                  const TensorDescriptor& yDesc,
+                                  Data_t y,
+                                  size_t xOffset,
+                                  size_t yOffset)
+{
+    if(xDesc.GetType() != yDesc.GetType())
+        MIOPEN_THROW(miopenStatusBadParm, "int8 activation requires x and y of the same type");
+    if(!xDesc.IsPacked() || !yDesc.IsPacked() ||
+       xDesc.GetElementSize() != yDesc.GetElementSize())
+        MIOPEN_THROW(miopenStatusBadParm, "int8 activation requires packed tensors of one size");
+
+    const auto elem_sz = xDesc.GetElementSize();
+    const auto grp_num =
+        std::max<size_t>(std::min((elem_sz / 4 + 255) / 256, handle.GetMaxComputeUnits() * 8), 1);
+
+    const auto network_config = "int8" + std::to_string(desc.GetMode()) + "_" +
+                                std::to_string(grp_num);
+
+    const auto f_alpha = static_cast<float>(desc.GetAlpha());
+    const auto f_beta  = static_cast<float>(desc.GetBeta());
+    const auto f_gamma = static_cast<float>(desc.GetGamma());
+
+    auto&& kernels = handle.GetKernels("miopenActivationForward", network_config);
+    if(!kernels.empty())
+    {
+        kernels.front()(x,
+                        y,
+                        f_gamma,
+                        f_beta,
+                        f_alpha,
+                        scale,
+                        static_cast<long long>(xOffset),
+                        static_cast<long long>(yOffset),
+                        static_cast<long long>(elem_sz));
+        return;
+    }
+
+    const std::vector<size_t> vld{256, 1, 1};
+    const std::vector<size_t> vgd{256 * grp_num, 1, 1};
+
+    handle.AddKernel("miopenActivationForward",
+                     network_config,
+                     "MIOpenNeuronInt8.cl",
+                     "MIOpenActiveFwdInt8",
+                     vld,
+                     vgd,
+                     " -DMIOPEN_NRN_OP_ID=" + std::to_string(desc.GetMode()))(
+        x,
+        y,
+        f_gamma,
+        f_beta,
+        f_alpha,
+        scale,
+        static_cast<long long>(xOffset),
+        static_cast<long long>(yOffset),
+        static_cast<long long>(elem_sz));
+}
+
 miopenStatus_t ActivationDescriptor::Forward(Handle& handle,
                                              const void* alpha,
                                              const TensorDescriptor& xDesc,
@@ -41,6 +105,23 @@ miopenStatus_t ActivationDescriptor::Forward(Handle& handle,
                                              size_t xOffset,
                                              size_t yOffset)
 {
+    // for quantized data alpha is the requantization factor from x to y
+    if(xDesc.GetType() == miopenInt8 || xDesc.GetType() == miopenInt8x4)
+    {
+        if(!float_equal(*(static_cast<const float*>(beta)), 0))
+            MIOPEN_THROW("Only beta=0 is supported");
+        ActivationForwardInt8(handle,
+                              *this,
+                              *(static_cast<const float*>(alpha)),
+                              xDesc,
+                              x,
+                              yDesc,
+                              y,
+                              xOffset,
+                              yOffset);
+        return miopenStatusSuccess;
+    }
+
     if(!float_equal(*(static_cast<const float*>(alpha)), 1.0) ||
        !float_equal(*(static_cast<const float*>(beta)), 0))
     {
@@ -95,9 +176,69 @@ miopenStatus_t ActivationDescriptor::Forward(Handle& handle,
                   y_lens[0] == 1 && y_lens[1] == 1 && y_lens[2] == 1)));
     bool packed = xDesc.IsPacked() && yDesc.IsPacked();
 
+    // packed tensors at vector-aligned offsets are walked with 16-byte loads by a grid-stride loop
+    const size_t packed_unit = (xDesc.GetType() == miopenHalf) ? 8 : 4;
+    bool packed_vec = packed && x_elem_sz == y_elem_sz && xOffset % packed_unit == 0 &&
+                      yOffset % packed_unit == 0;
+
     visit_float(xDesc.GetType(), [&](auto as_float) {
 
-        if(x_elem_sz == y_elem_sz && (packed || t2D))
+        if(packed_vec)
+        {
+            auto f_activ_alpha = as_float(activ_alpha);
+            auto f_activ_beta  = as_float(activ_beta);
+            auto f_activ_gamma = as_float(activ_gamma);
+
+            size_t grp_num = std::max<size_t>(
+                std::min((x_elem_sz / packed_unit + 255) / 256, handle.GetMaxComputeUnits() * 8),
+                1);
+
+            network_config = "12" + std::to_string(xDesc.GetType()) + std::to_string(mode) +
+                             std::to_string(packed_unit) + std::to_string(grp_num);
+
+            auto&& kernels = handle.GetKernels("miopenActivationForward", network_config);
+            if(!kernels.empty())
+            {
+                kernels.front()(x,
+                                y,
+                                f_activ_gamma,
+                                f_activ_beta,
+                                f_activ_alpha,
+                                static_cast<long long>(xOffset),
+                                static_cast<long long>(yOffset),
+                                static_cast<long long>(x_elem_sz));
+            }
+            else
+            {
+                std::string type_opt = (xDesc.GetType() == miopenHalf)
+                                           ? " -DMIOPEN_USE_FP16=1 -DMIOPEN_USE_FP32=0"
+                                           : " -DMIOPEN_USE_FP16=0 -DMIOPEN_USE_FP32=1";
+
+                std::string compiler_options =
+                    " -DLITE -DMIOPEN_READ_UNIT=" + std::to_string(packed_unit) +
+                    " -DMIOPEN_READ_TYPE=_FLOAT" + std::to_string(packed_unit) +
+                    " -DMIOPEN_NRN_OP_ID=" + std::to_string(mode) + type_opt;
+
+                const std::vector<size_t> vld{256, 1, 1};
+                const std::vector<size_t> vgd{256 * grp_num, 1, 1};
+
+                handle.AddKernel("miopenActivationForward",
+                                 network_config,
+                                 "MIOpenNeuron.cl",
+                                 "MIOpenActiveFwdPacked",
+                                 vld,
+                                 vgd,
+                                 compiler_options)(x,
+                                                   y,
+                                                   f_activ_gamma,
+                                                   f_activ_beta,
+                                                   f_activ_alpha,
+                                                   static_cast<long long>(xOffset),
+                                                   static_cast<long long>(yOffset),
+                                                   static_cast<long long>(x_elem_sz));
+            }
+        }
+        else if(x_elem_sz == y_elem_sz && (packed || t2D))
         {
             std::string compiler_options;
             auto f_activ_alpha = as_float(activ_alpha);
@@ -391,14 +532,14 @@ miopenStatus_t ActivationDescriptor::Backward(Handle& handle,
                                               ConstData_t y,
                                               const TensorDescriptor& dyDesc,
                                               ConstData_t dy,
-                                              const TensorDescriptor& xDesc,
-                                              ConstData_t x,
+                                              const TensorDescriptor& xDescIn,
+                                              ConstData_t xIn,
                                               const void* beta,
                                               const TensorDescriptor& dxDesc,
                                               Data_t dx,
                                               size_t yOffset,
                                               size_t dyOffset,
-                                              size_t xOffset,
+                                              size_t xOffsetIn,
                                               size_t dxOffset)
 {
     if(!float_equal(*(static_cast<const float*>(alpha)), 1.0) ||
@@ -406,6 +547,16 @@ miopenStatus_t ActivationDescriptor::Backward(Handle& handle,
     {
         MIOPEN_THROW("Only alpha=1 and beta=0 is supported");
     }
+
+    // Without x the kernels read y in its place, which gives the same derivative for the modes
+    // accepted by IsBackwardFromOutputSupported().
+    const bool from_output = xIn == nullptr;
+    if(from_output && !IsBackwardFromOutputSupported())
+        MIOPEN_THROW(miopenStatusBadParm, "The backward pass of this activation mode requires x");
+    const auto& xDesc     = from_output ? yDesc : xDescIn;
+    const auto x          = from_output ? y : xIn;
+    const auto xOffset    = from_output ? yOffset : xOffsetIn;
+    const auto from_top   = std::string(from_output ? " -DMIOPEN_NRN_FROM_TOP=1" : "");
     miopenStatus_t status = miopenStatusSuccess;
 
     mlo_construct_neuron construct_params(conv::Direction::BackwardData);
@@ -490,10 +641,85 @@ miopenStatus_t ActivationDescriptor::Backward(Handle& handle,
                   dy_lens[1] == 1 && dy_lens[2] == 1 && dx_lens[0] == 1 && dx_lens[1] == 1 &&
                   dx_lens[2] == 1)));
     bool packed = xDesc.IsPacked() && yDesc.IsPacked() && dxDesc.IsPacked() && dyDesc.IsPacked();
+
+    // packed tensors at vector-aligned offsets are walked with 16-byte loads by a grid-stride loop
+    const size_t packed_unit = (xDesc.GetType() == miopenHalf) ? 8 : 4;
+    bool packed_vec = packed && x_elem_sz == y_elem_sz && dx_elem_sz == dy_elem_sz &&
+                      x_elem_sz == dx_elem_sz && xOffset % packed_unit == 0 &&
+                      yOffset % packed_unit == 0 && dxOffset % packed_unit == 0 &&
+                      dyOffset % packed_unit == 0;
+
     visit_float(xDesc.GetType(), [&](auto as_float) {
 
-        if(x_elem_sz == y_elem_sz && dx_elem_sz == dy_elem_sz && x_elem_sz == dx_elem_sz &&
-           (packed || t2D))
+        if(packed_vec)
+        {
+            auto f_activ_alpha = as_float(activ_alpha);
+            auto f_activ_beta  = as_float(activ_beta);
+            auto f_activ_gamma = as_float(activ_gamma);
+            auto f_diff_scale  = as_float(activ_beta * activ_gamma);
+
+            size_t grp_num = std::max<size_t>(
+                std::min((x_elem_sz / packed_unit + 255) / 256, handle.GetMaxComputeUnits() * 8),
+                1);
+
+            network_config = "12" + std::to_string(xDesc.GetType()) + std::to_string(mode) +
+                             std::to_string(packed_unit) + std::to_string(grp_num) +
+                             (from_output ? "y" : "");
+
+            auto&& kernels = handle.GetKernels("miopenActivationBackward", network_config);
+            if(!kernels.empty())
+            {
+                kernels.front()(dx,
+                                dy,
+                                x,
+                                y,
+                                f_diff_scale,
+                                f_activ_gamma,
+                                f_activ_beta,
+                                f_activ_alpha,
+                                static_cast<long long>(dxOffset),
+                                static_cast<long long>(dyOffset),
+                                static_cast<long long>(xOffset),
+                                static_cast<long long>(yOffset),
+                                static_cast<long long>(x_elem_sz));
+            }
+            else
+            {
+                std::string type_opt = (xDesc.GetType() == miopenHalf)
+                                           ? " -DMIOPEN_USE_FP16=1 -DMIOPEN_USE_FP32=0"
+                                           : " -DMIOPEN_USE_FP16=0 -DMIOPEN_USE_FP32=1";
+
+                std::string compiler_options =
+                    " -DLITE -DMIOPEN_READ_UNIT=" + std::to_string(packed_unit) +
+                    " -DMIOPEN_READ_TYPE=_FLOAT" + std::to_string(packed_unit) +
+                    " -DMIOPEN_NRN_OP_ID=" + std::to_string(mode) + type_opt + from_top;
+
+                const std::vector<size_t> vld{256, 1, 1};
+                const std::vector<size_t> vgd{256 * grp_num, 1, 1};
+
+                handle.AddKernel("miopenActivationBackward",
+                                 network_config,
+                                 "MIOpenNeuron.cl",
+                                 "MIOpenActiveBwdPacked",
+                                 vld,
+                                 vgd,
+                                 compiler_options)(dx,
+                                                   dy,
+                                                   x,
+                                                   y,
+                                                   f_diff_scale,
+                                                   f_activ_gamma,
+                                                   f_activ_beta,
+                                                   f_activ_alpha,
+                                                   static_cast<long long>(dxOffset),
+                                                   static_cast<long long>(dyOffset),
+                                                   static_cast<long long>(xOffset),
+                                                   static_cast<long long>(yOffset),
+                                                   static_cast<long long>(x_elem_sz));
+            }
+        }
+        else if(x_elem_sz == y_elem_sz && dx_elem_sz == dy_elem_sz && x_elem_sz == dx_elem_sz &&
+                (packed || t2D))
         {
             std::string compiler_options;
 
@@ -520,7 +746,7 @@ miopenStatus_t ActivationDescriptor::Backward(Handle& handle,
             network_config = ((packed) ? "11" : "10") // + lite bit
                              + std::to_string(xDesc.GetType()) + std::to_string(mode) +
                              std::to_string(read_unit) + std::to_string(MAP_RD) +
-                             std::to_string(height);
+                             std::to_string(height) + (from_output ? "y" : "");
 
             auto&& kernels = handle.GetKernels("miopenActivationBackward", network_config);
             if(!kernels.empty())
@@ -576,7 +802,7 @@ miopenStatus_t ActivationDescriptor::Backward(Handle& handle,
 
                 compiler_options = " -DLITE -DMIOPEN_READ_UNIT=" + std::to_string(read_unit) +
                                    " -DMIOPEN_READ_TYPE=" + READ_TYPE + " -DMIOPEN_NRN_OP_ID=" +
-                                   std::to_string(mode) + type_opt;
+                                   std::to_string(mode) + type_opt + from_top;
 
                 std::vector<size_t> vld;
                 std::vector<size_t> vgd;
@@ -893,7 +1119,8 @@ miopenStatus_t ActivationDescriptor::Backward(Handle& handle,
                 " -DMIOPEN_IN_BLOCK_SZ=" + std::to_string(cIn * hIn * wIn) +
                 " -DMIOPEN_OUT_BLOCK_SZ=" + std::to_string(cOut * hOut * wOut) +
                 " -DMIOPEN_DIN_BLOCK_SZ=" + std::to_string(cdIn * hdIn * wdIn) +
-                " -DMIOPEN_DOUT_BLOCK_SZ=" + std::to_string(cdOut * hdOut * wdOut);
+                " -DMIOPEN_DOUT_BLOCK_SZ=" + std::to_string(cdOut * hdOut * wdOut) +
+                from_top;
 
             handle.AddKernel("miopenActivationBackward",
                              network_config,
@@ -0,0 +1,245 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/attention.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/datatype.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/kernel_cache.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/tensor.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+namespace {
+
+// Work-group size and LDS tile rows of MIOpenAttention.cl.
+constexpr std::size_t att_tile    = 64;
+constexpr std::size_t att_kv_tile = 32;
+// Every work-item holds up to four rows of the head dimension in registers.
+constexpr std::size_t att_max_head_dim = 128;
+
+struct AttentionShape
+{
+    std::size_t batch; // all the dimensions before the sequence, heads included
+    std::size_t seq_q;
+    std::size_t seq_kv;
+    std::size_t head_dim;
+};
+
+AttentionShape GetAttentionShape(const TensorDescriptor& qDesc,
+                                 const TensorDescriptor& kDesc,
+                                 const TensorDescriptor& vDesc,
+                                 const TensorDescriptor& oDesc)
+{
+    const auto type = qDesc.GetType();
+    if(type != miopenFloat && type != miopenHalf && type != miopenBFloat16)
+        MIOPEN_THROW(miopenStatusBadParm, "Attention supports fp32, fp16 and bfp16 only");
+    if(kDesc.GetType() != type || vDesc.GetType() != type || oDesc.GetType() != type)
+        MIOPEN_THROW(miopenStatusBadParm, "The tensors of attention differ in data type");
+    if(!qDesc.IsPacked() || !kDesc.IsPacked() || !vDesc.IsPacked() || !oDesc.IsPacked())
+        MIOPEN_THROW(miopenStatusBadParm, "Attention takes packed tensors");
+
+    const auto& q_lengths = qDesc.GetLengths();
+    const auto& k_lengths = kDesc.GetLengths();
+    if(q_lengths.size() < 3 || q_lengths.size() != k_lengths.size())
+        MIOPEN_THROW(miopenStatusBadParm, "Attention takes [batch, ..., seq, d] tensors");
+    if(oDesc.GetLengths() != q_lengths || vDesc.GetLengths() != k_lengths ||
+       !std::equal(q_lengths.begin(), q_lengths.end() - 2, k_lengths.begin()) ||
+       q_lengths.back() != k_lengths.back())
+        MIOPEN_THROW(miopenStatusBadParm, "The tensors of attention differ in size");
+
+    const AttentionShape shape{std::accumulate(q_lengths.begin(),
+                                               q_lengths.end() - 2,
+                                               std::size_t{1},
+                                               std::multiplies<std::size_t>{}),
+                               q_lengths[q_lengths.size() - 2],
+                               k_lengths[k_lengths.size() - 2],
+                               q_lengths.back()};
+
+    if(shape.head_dim == 0 || shape.head_dim > att_max_head_dim)
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "Attention supports head dimensions up to " +
+                         std::to_string(att_max_head_dim));
+    if(shape.seq_q > std::numeric_limits<unsigned>::max() ||
+       shape.seq_kv > std::numeric_limits<unsigned>::max())
+        MIOPEN_THROW(miopenStatusBadParm, "Attention sequence is too long");
+    return shape;
+}
+
+void CheckAttentionLse(const TensorDescriptor& lseDesc, const AttentionShape& shape)
+{
+    if(lseDesc.GetType() != miopenFloat || !lseDesc.IsPacked() ||
+       lseDesc.GetElementSize() != shape.batch * shape.seq_q)
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "Attention log-sum-exp is a packed fp32 tensor with one value per query");
+}
+
+std::string GetAttentionConfig(miopenDataType_t type, const AttentionShape& shape, bool causal)
+{
+    return std::to_string(type) + "-d" + std::to_string(shape.head_dim) + "-c" +
+           std::to_string(int(causal)) + "-b" + std::to_string(shape.batch);
+}
+
+std::string GetAttentionParams(miopenDataType_t type, const AttentionShape& shape, bool causal)
+{
+    return GetDataTypeKernelParams(type) + " -DATT_D=" + std::to_string(shape.head_dim) +
+           " -DATT_TILE=" + std::to_string(att_tile) + " -DATT_KV_TILE=" +
+           std::to_string(att_kv_tile) + " -DATT_CAUSAL=" + std::to_string(int(causal));
+}
+
+/// ATT_TILE rows per work-group along dimension 0, the batch along dimension 1.
+KernelInvoke GetAttentionKernel(const Handle& handle,
+                                const std::string& network_config,
+                                const std::string& kernel_name,
+                                std::size_t rows,
+                                std::size_t batch,
+                                const std::string& params)
+{
+    const std::string algo_name = "miopenAttention";
+    auto&& kernels              = handle.GetKernels(algo_name, network_config);
+    if(!kernels.empty())
+        return kernels.front();
+
+    const auto global = (rows + att_tile - 1) / att_tile * att_tile;
+    return handle.AddKernel(algo_name,
+                            network_config,
+                            "MIOpenAttention.cl",
+                            kernel_name,
+                            {att_tile, 1, 1},
+                            {global, batch, 1},
+                            params);
+}
+
+} // namespace
+
+void AttentionForward(const Handle& handle,
+                      const TensorDescriptor& qDesc,
+                      ConstData_t q,
+                      const TensorDescriptor& kDesc,
+                      ConstData_t k,
+                      const TensorDescriptor& vDesc,
+                      ConstData_t v,
+                      float scale,
+                      bool causal,
+                      const TensorDescriptor& oDesc,
+                      Data_t o,
+                      const TensorDescriptor* lseDesc,
+                      Data_t lse)
+{
+    if(q == nullptr || k == nullptr || v == nullptr || o == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm);
+
+    const auto shape = GetAttentionShape(qDesc, kDesc, vDesc, oDesc);
+    if(lseDesc != nullptr)
+        CheckAttentionLse(*lseDesc, shape);
+    if(shape.batch == 0 || shape.seq_q == 0)
+        return;
+    if(shape.seq_kv == 0)
+        MIOPEN_THROW(miopenStatusBadParm, "Attention needs at least one key");
+
+    const bool save_lse       = lse != nullptr;
+    const auto type           = qDesc.GetType();
+    const auto network_config = "fwd-" + GetAttentionConfig(type, shape, causal) + "-q" +
+                                std::to_string(shape.seq_q) + "-s" +
+                                std::to_string(int(save_lse));
+    const auto params         = GetAttentionParams(type, shape, causal) + " -DATT_SAVE_LSE=" +
+                                std::to_string(int(save_lse));
+
+    auto kernel = GetAttentionKernel(
+        handle, network_config, "MIOpenAttentionFwd", shape.seq_q, shape.batch, params);
+
+    // Without the log-sum-exp the kernel gets the output as a valid buffer it does not write.
+    kernel(q,
+           k,
+           v,
+           o,
+           save_lse ? lse : o,
+           scale,
+           static_cast<unsigned>(shape.seq_q),
+           static_cast<unsigned>(shape.seq_kv));
+}
+
+void AttentionBackward(const Handle& handle,
+                       const TensorDescriptor& qDesc,
+                       ConstData_t q,
+                       const TensorDescriptor& kDesc,
+                       ConstData_t k,
+                       const TensorDescriptor& vDesc,
+                       ConstData_t v,
+                       const TensorDescriptor& oDesc,
+                       ConstData_t o,
+                       ConstData_t dO,
+                       const TensorDescriptor& lseDesc,
+                       ConstData_t lse,
+                       float scale,
+                       bool causal,
+                       Data_t dq,
+                       Data_t dk,
+                       Data_t dv)
+{
+    if(q == nullptr || k == nullptr || v == nullptr || o == nullptr || dO == nullptr ||
+       lse == nullptr || dq == nullptr || dk == nullptr || dv == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm);
+
+    const auto shape = GetAttentionShape(qDesc, kDesc, vDesc, oDesc);
+    CheckAttentionLse(lseDesc, shape);
+    if(shape.batch == 0 || shape.seq_q == 0 || shape.seq_kv == 0)
+        return;
+
+    const auto type   = qDesc.GetType();
+    const auto config = GetAttentionConfig(type, shape, causal);
+    const auto params = GetAttentionParams(type, shape, causal);
+    const auto seq_q  = static_cast<unsigned>(shape.seq_q);
+    const auto seq_kv = static_cast<unsigned>(shape.seq_kv);
+
+    auto q_kernel = GetAttentionKernel(handle,
+                                       "bwd-q-" + config + "-q" + std::to_string(shape.seq_q),
+                                       "MIOpenAttentionBwdQ",
+                                       shape.seq_q,
+                                       shape.batch,
+                                       params);
+    q_kernel(q, k, v, o, dO, lse, dq, scale, seq_q, seq_kv);
+    const auto q_time = handle.IsProfilingEnabled() ? handle.GetKernelTime() : 0.f;
+
+    auto kv_kernel = GetAttentionKernel(handle,
+                                        "bwd-kv-" + config + "-k" + std::to_string(shape.seq_kv),
+                                        "MIOpenAttentionBwdKV",
+                                        shape.seq_kv,
+                                        shape.batch,
+                                        params);
+    kv_kernel(q, k, v, o, dO, lse, dk, dv, scale, seq_q, seq_kv);
+    if(handle.IsProfilingEnabled())
+        handle.AccumKernelTime(q_time);
+}
+
+} // namespace miopen
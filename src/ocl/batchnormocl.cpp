@@ -37,6 +37,7 @@
 #include <miopen/convolution.hpp>
 #include <miopen/mlo_internal.hpp>
 
+#include <algorithm>
 #include <chrono>
 
 namespace miopen {
@@ -53,6 +54,37 @@ static auto GetContext(Handle& handle)
     return ctx;
 }
 
+/// Channel-last tensors are normalized by the kernels of MIOpenBatchNormNHWC.cl, which read
+/// vectors of adjacent channels and reduce every channel over the N*H*W rows.
+static bool IsBatchNormNHWC(const TensorDescriptor& xDesc)
+{
+    return xDesc.GetSize() == 4 && xDesc.GetLayout("NCHW") == "NHWC";
+}
+
+/// Sets the work-group and grid sizes of the NHWC kernels and returns the build parameters they
+/// share. Dimension 0 is over the vectors of channels and dimension 1 over the rows, which the
+/// elementwise inference kernel spreads over \p row_groups work-groups.
+static std::string BatchNormNHWCParms(int c,
+                                      unsigned int in_nhw,
+                                      std::size_t row_groups,
+                                      std::vector<size_t>& vld,
+                                      std::vector<size_t>& vgd)
+{
+    const int vec           = (c % 4 == 0) ? 4 : (c % 2 == 0) ? 2 : 1;
+    const std::size_t cvecs = c / vec;
+    std::size_t grp0        = 1;
+    while(grp0 < cvecs && grp0 < 16)
+        grp0 *= 2;
+    const std::size_t grp1 = 256 / grp0;
+
+    vld = {grp0, grp1, 1};
+    vgd = {grp0 * ((cvecs + grp0 - 1) / grp0), grp1 * row_groups, 1};
+
+    return " -DMIO_BN_C=" + std::to_string(c) + " -DMIO_BN_NHW=" + std::to_string(in_nhw) +
+           " -DMIO_BN_VEC=" + std::to_string(vec) + " -DMIO_BN_GRP0=" + std::to_string(grp0) +
+           " -DMIO_BN_GRP1=" + std::to_string(grp1);
+}
+
 void BatchNormForwardTraining(Handle& handle,
                               miopenBatchNormMode_t bn_mode,
                               const void* alpha,
@@ -156,7 +188,89 @@ void BatchNormForwardTraining(Handle& handle,
         resultrunning = true;
     }
 
-    if(bn_mode == miopenBNSpatial)
+    if(bn_mode == miopenBNSpatial && IsBatchNormNHWC(xDesc))
+    {
+        if(yDesc.GetStrides() != xDesc.GetStrides())
+        {
+            MIOPEN_THROW(miopenStatusBadParm, "x and y of NHWC batch norm must have one layout");
+        }
+
+        std::string algo_name      = "miopenBatchNormForwardTrainingSpatialNHWC";
+        std::string network_config =
+            "nhwcrs" + std::to_string(static_cast<int>(resultsave)) + "rr" +
+            std::to_string(static_cast<int>(resultrunning)) + "fp16" +
+            std::to_string(static_cast<int>(bfp16parm)) + "fp32" +
+            std::to_string(static_cast<int>(bfp32parm)) + "c" + std::to_string(c) + "nhw" +
+            std::to_string(in_nhw);
+
+        // The NHWC kernel takes the arguments of the NCHW ones for n > 2.
+        const unsigned int nhwc_n = 3;
+        auto&& kernels            = handle.GetKernels(algo_name, network_config);
+        if(!kernels.empty())
+        {
+            bnFwdTrainSelectSingleFull(handle,
+                                       bnScaleBiasMeanVarDesc.GetType(),
+                                       algo_name,
+                                       network_config,
+                                       x,
+                                       y,
+                                       bnScale,
+                                       bnBias,
+                                       resultsave,
+                                       resultrunning,
+                                       expAvgFactor,
+                                       resultRunningMean,
+                                       resultRunningVariance,
+                                       epsilon,
+                                       resultSaveMean,
+                                       resultSaveInvVariance,
+                                       inhw,
+                                       nhwc_n,
+                                       in_cstride,
+                                       in_nstride);
+        }
+        else
+        {
+            std::string kernel_name  = "MIOpenBatchNormFwdTrainSpatialNHWC";
+            std::string program_name = "MIOpenBatchNormNHWC.cl";
+            std::string parms =
+                " -DMIOPEN_USE_FP16=" + std::to_string(static_cast<int>(bfp16parm)) +
+                " -DMIOPEN_USE_FP32=" + std::to_string(static_cast<int>(bfp32parm)) +
+                " -DMIOPEN_USE_FPMIX=" + std::to_string(static_cast<int>(bfpmixparm)) +
+                " -DMIO_SAVE_MEAN_VARIANCE=" + std::to_string(static_cast<int>(resultsave)) +
+                " -DMIO_RUNNING_RESULT=" + std::to_string(static_cast<int>(resultrunning)) +
+                BatchNormNHWCParms(c, in_nhw, 1, vld, vgd);
+
+            MIOPEN_LOG_I2(kernel_name << ":: " << parms);
+
+            bnFwdTrainSelectSingleEmpty(handle,
+                                        bnScaleBiasMeanVarDesc.GetType(),
+                                        program_name,
+                                        algo_name,
+                                        kernel_name,
+                                        network_config,
+                                        parms,
+                                        vld,
+                                        vgd,
+                                        x,
+                                        y,
+                                        bnScale,
+                                        bnBias,
+                                        resultsave,
+                                        resultrunning,
+                                        expAvgFactor,
+                                        resultRunningMean,
+                                        resultRunningVariance,
+                                        epsilon,
+                                        resultSaveMean,
+                                        resultSaveInvVariance,
+                                        inhw,
+                                        nhwc_n,
+                                        in_cstride,
+                                        in_nstride);
+        }
+    }
+    else if(bn_mode == miopenBNSpatial)
     {
         bool single           = true;
         unsigned int variant  = 1;
@@ -209,6 +323,27 @@ void BatchNormForwardTraining(Handle& handle,
             ldsnogcn     = ylocalsize;
         }
 
+        // With few channels of very many elements each, a work-group per channel leaves most of
+        // the device idle. Variant 5 splits the N*H*W elements of every channel into chunks that
+        // are reduced with Welford's algorithm and then merged, so the device is filled.
+        unsigned int welford_chunk = 0;
+        if(in_nhw >= 1024 * 1024)
+        {
+            const std::size_t target_groups = 4 * handle.GetMaxComputeUnits();
+            const std::size_t chunks = std::min(
+                {(target_groups + c - 1) / c, std::size_t{in_nhw / 2048}, std::size_t{1024}});
+            if(chunks >= 2)
+            {
+                variant       = 5;
+                welford_chunk = (in_nhw + chunks - 1) / chunks;
+                xlocalsize    = 1;
+                ylocalsize    = 256;
+                xgridsize     = c;
+                ygridsize     = chunks * ylocalsize;
+                single        = false;
+            }
+        }
+
         std::string network_config{};
 
         if(variant == 4)
@@ -429,6 +564,8 @@ void BatchNormForwardTraining(Handle& handle,
                     std::to_string(ldsgcn) + " -DMIO_BN_VARIANT=" + std::to_string(variant) +
                     " -DMIO_BN_GRP0=" + std::to_string(xlocalsize) + " -DMIO_BN_GRP1=" +
                     std::to_string(ylocalsize) + " -DMIO_BN_GRP2=" + std::to_string(zlocalsize);
+                if(variant == 5)
+                    parms += " -DMIO_BN_CHUNK=" + std::to_string(welford_chunk);
 
                 MIOPEN_LOG_I2(kernel_name << ":: " << parms);
 
@@ -701,7 +838,56 @@ void BatchNormForwardInference(Handle& handle,
                                      std::to_string(in_cstride) + "C" + std::to_string(c);
 
         auto&& kernels = handle.GetKernels(algo_name, network_config);
-        if(!kernels.empty())
+        if(bn_mode == miopenBNSpatial && IsBatchNormNHWC(xDesc))
+        {
+            if(yDesc.GetStrides() != xDesc.GetStrides())
+            {
+                MIOPEN_THROW(miopenStatusBadParm,
+                             "x and y of NHWC batch norm must have one layout");
+            }
+
+            const unsigned int in_nhw = n * in_cstride;
+
+            const std::string nhwc_algo_name      = "miopenBatchNormalizationForwardInferenceNHWC";
+            const std::string nhwc_network_config =
+                "nhwcfp16" + std::to_string(static_cast<int>(bfp16parm)) + "fp32" +
+                std::to_string(static_cast<int>(bfp32parm)) + "c" + std::to_string(c) + "nhw" +
+                std::to_string(in_nhw);
+
+            auto&& nhwc_kernels = handle.GetKernels(nhwc_algo_name, nhwc_network_config);
+            if(!nhwc_kernels.empty())
+            {
+                nhwc_kernels.front()(
+                    x, y, estimatedMean, estimatedVariance, bnScale, bnBias, epsilon);
+            }
+            else
+            {
+                std::vector<size_t> vld;
+                std::vector<size_t> vgd;
+                // Every work-group of the elementwise kernel takes a share of the rows.
+                const auto row_groups = std::min<std::size_t>(1 + in_nhw / 64, 256);
+
+                std::string program_name = "MIOpenBatchNormNHWC.cl";
+                std::string kernel_name  = "MIOpenBatchNormFwdInferSpatialNHWC";
+                std::string parms =
+                    " -DMIOPEN_USE_FP16=" + std::to_string(static_cast<int>(bfp16parm)) +
+                    " -DMIOPEN_USE_FP32=" + std::to_string(static_cast<int>(bfp32parm)) +
+                    " -DMIOPEN_USE_FPMIX=" + std::to_string(static_cast<int>(bfpmixparm)) +
+                    BatchNormNHWCParms(c, in_nhw, row_groups, vld, vgd);
+
+                MIOPEN_LOG_I2(kernel_name << ":: " << parms);
+
+                handle.AddKernel(nhwc_algo_name,
+                                 nhwc_network_config,
+                                 program_name,
+                                 kernel_name,
+                                 vld,
+                                 vgd,
+                                 parms)(
+                    x, y, estimatedMean, estimatedVariance, bnScale, bnBias, epsilon);
+            }
+        }
+        else if(!kernels.empty())
         {
             auto kernel = kernels.front();
             kernel(x,
@@ -717,10 +903,15 @@ void BatchNormForwardInference(Handle& handle,
         }
         else
         {
+            // The spatial fp16 kernel reads pairs of elements of even images.
+            const unsigned int vec_size =
+                bn_mode == miopenBNSpatial && !bfp32parm && in_cstride % 2 == 0 ? 2 : 1;
+
             size_t xlocalsize = 1;
             auto xgridsize    = c;
             size_t ylocalsize = 256;
-            size_t ygridsize  = ylocalsize * ((in_cstride + ylocalsize - 1) / ylocalsize);
+            size_t ygridsize =
+                ylocalsize * ((in_cstride / vec_size + ylocalsize - 1) / ylocalsize);
             size_t zlocalsize = 1;
             size_t zgridsize  = 1;
 
@@ -742,7 +933,8 @@ void BatchNormForwardInference(Handle& handle,
                 " -DMIOPEN_USE_FP32=" + std::to_string(static_cast<int>(bfp32parm)) +
                 " -DMIOPEN_USE_FPMIX=" + std::to_string(static_cast<int>(bfpmixparm)) +
                 " -DMIO_BN_GRP0=" + std::to_string(xlocalsize) + " -DMIO_BN_GRP1=" +
-                std::to_string(ylocalsize) + " -DMIO_BN_GRP2=" + std::to_string(zlocalsize);
+                std::to_string(ylocalsize) + " -DMIO_BN_GRP2=" + std::to_string(zlocalsize) +
+                " -DMIO_BN_VEC_SIZE=" + std::to_string(vec_size);
 
             std::vector<size_t> vld;
             std::vector<size_t> vgd;
@@ -903,7 +1095,87 @@ void BatchNormBackward(Handle& handle,
         useSaved = true;
     }
 
-    if(bn_mode == miopenBNSpatial)
+    if(bn_mode == miopenBNSpatial && IsBatchNormNHWC(xDesc))
+    {
+        if(dyDesc.GetStrides() != xDesc.GetStrides() || dxDesc.GetStrides() != xDesc.GetStrides())
+        {
+            MIOPEN_THROW(miopenStatusBadParm,
+                         "x, dy and dx of NHWC batch norm must have one layout");
+        }
+
+        std::string algo_name = "miopenBatchNormBackwardPropSpatialNHWC";
+        std::string network_config =
+            "nhwcus" + std::to_string(static_cast<int>(useSaved)) + "fp16" +
+            std::to_string(static_cast<int>(bfp16parm)) + "fp32" +
+            std::to_string(static_cast<int>(bfp32parm)) + "c" + std::to_string(c) + "nhw" +
+            std::to_string(in_nhw);
+
+        auto&& kernels = handle.GetKernels(algo_name, network_config);
+        if(!kernels.empty())
+        {
+            auto kernel = kernels.front();
+            visit_float(bnScaleBiasDiffDesc.GetType(), [&](auto as_float) {
+                if(useSaved)
+                {
+                    kernel(x,
+                           dy,
+                           dx,
+                           bnScale,
+                           resultBnScaleDiff,
+                           resultBnBiasDiff,
+                           savedMean,
+                           savedInvVariance,
+                           as_float(inhw));
+                }
+                else
+                {
+                    kernel(x,
+                           dy,
+                           dx,
+                           bnScale,
+                           resultBnScaleDiff,
+                           resultBnBiasDiff,
+                           epsilon,
+                           as_float(inhw));
+                }
+            });
+        }
+        else
+        {
+            std::string kernel_name  = "MIOpenBatchNormBwdSpatialNHWC";
+            std::string program_name = "MIOpenBatchNormNHWC.cl";
+            std::string parms =
+                " -DMIOPEN_USE_FP16=" + std::to_string(static_cast<int>(bfp16parm)) +
+                " -DMIOPEN_USE_FP32=" + std::to_string(static_cast<int>(bfp32parm)) +
+                " -DMIOPEN_USE_FPMIX=" + std::to_string(static_cast<int>(bfpmixparm)) +
+                " -DMIO_BN_USESAVED=" + std::to_string(static_cast<int>(useSaved)) +
+                BatchNormNHWCParms(c, in_nhw, 1, vld, vgd);
+
+            MIOPEN_LOG_I2(kernel_name << ":: " << parms);
+
+            bnBwdTrainSelectSingle(handle,
+                                   bnScaleBiasDiffDesc.GetType(),
+                                   program_name,
+                                   algo_name,
+                                   kernel_name,
+                                   network_config,
+                                   parms,
+                                   vld,
+                                   vgd,
+                                   x,
+                                   dy,
+                                   dx,
+                                   bnScale,
+                                   resultBnScaleDiff,
+                                   resultBnBiasDiff,
+                                   useSaved,
+                                   epsilon,
+                                   savedMean,
+                                   savedInvVariance,
+                                   inhw);
+        }
+    }
+    else if(bn_mode == miopenBNSpatial)
     { // SPATIAL kernels
 
         unsigned int ldsgcn   = 0;
@@ -1356,4 +1628,111 @@ void BatchNormBackward(Handle& handle,
         miopen::checkNumericsOutput(handle, bnScaleBiasDiffDesc, resultBnBiasDiff);
     }
 }
+
+void BatchNormRestoreInput(Handle& handle,
+                           miopenBatchNormMode_t bn_mode,
+                           const TensorDescriptor& yDesc,
+                           Data_t y,
+                           const TensorDescriptor& bnScaleBiasMeanVarDesc,
+                           ConstData_t bnScale,
+                           ConstData_t bnBias,
+                           ConstData_t savedMean,
+                           ConstData_t savedInvVariance)
+{
+    if(y == nullptr || bnScale == nullptr || bnBias == nullptr || savedMean == nullptr ||
+       savedInvVariance == nullptr)
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+    if(yDesc.GetSize() != bnScaleBiasMeanVarDesc.GetSize() || yDesc.GetSize() < 3)
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+    if(!yDesc.IsPacked())
+    {
+        MIOPEN_LOG_E("Only fully packed tensors supported.");
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+
+    bool bfpmixparm = false;
+    bool bfp16parm  = false;
+    bool bfp32parm  = true;
+    if(yDesc.GetType() == miopenHalf && bnScaleBiasMeanVarDesc.GetType() == miopenHalf)
+    {
+        bfp16parm = true;
+        bfp32parm = false;
+    }
+    else if(yDesc.GetType() == miopenHalf && bnScaleBiasMeanVarDesc.GetType() == miopenFloat)
+    {
+        bfpmixparm = true;
+        bfp32parm  = false;
+    }
+
+    int n, c, h, w;
+    std::tie(n, c, h, w) = tien<4>(yDesc.GetLengths());
+
+    unsigned int param_stride = h * w;
+    unsigned int param_count  = c;
+    if(bn_mode == miopenBNSpatial && IsBatchNormNHWC(yDesc))
+    {
+        param_stride = 1;
+    }
+    else if(bn_mode == miopenBNPerActivation)
+    {
+        if(IsBatchNormNHWC(yDesc))
+        {
+            MIOPEN_THROW(miopenStatusNotImplemented,
+                         "Per-activation batch norm does not support NHWC");
+        }
+        param_stride = 1;
+        param_count  = c * h * w;
+    }
+
+    const unsigned int elem_count = yDesc.GetElementSize();
+    const std::size_t local_size  = 256;
+    const std::size_t groups =
+        std::min<std::size_t>((elem_count + local_size - 1) / local_size, 1024);
+
+    std::string algo_name      = "miopenBatchNormalizationRestoreInput";
+    std::string network_config = "fp16" + std::to_string(static_cast<int>(bfp16parm)) + "fpmix" +
+                                 std::to_string(static_cast<int>(bfpmixparm)) + "groups" +
+                                 std::to_string(groups);
+
+    auto&& kernels = handle.GetKernels(algo_name, network_config);
+    if(!kernels.empty())
+    {
+        kernels.front()(y,
+                        bnScale,
+                        bnBias,
+                        savedMean,
+                        savedInvVariance,
+                        elem_count,
+                        param_stride,
+                        param_count);
+    }
+    else
+    {
+        std::string parms = " -DMIOPEN_USE_FP16=" + std::to_string(static_cast<int>(bfp16parm)) +
+                            " -DMIOPEN_USE_FP32=" + std::to_string(static_cast<int>(bfp32parm)) +
+                            " -DMIOPEN_USE_FPMIX=" + std::to_string(static_cast<int>(bfpmixparm));
+
+        const std::vector<size_t> vld{local_size, 1, 1};
+        const std::vector<size_t> vgd{local_size * groups, 1, 1};
+
+        handle.AddKernel(algo_name,
+                         network_config,
+                         "MIOpenBatchNormRestoreInput.cl",
+                         "MIOpenBatchNormRestoreInput",
+                         vld,
+                         vgd,
+                         parms)(y,
+                                bnScale,
+                                bnBias,
+                                savedMean,
+                                savedInvVariance,
+                                elem_count,
+                                param_stride,
+                                param_count);
+    }
+}
 } // namespace miopen
@@ -194,6 +194,15 @@ ClProgramPtr LoadProgram(cl_context ctx,
     }
 }
 
+std::size_t GetProgramBinarySize(cl_program program)
+{
+    size_t binary_size = 0;
+    if(clGetProgramInfo(program, CL_PROGRAM_BINARY_SIZES, sizeof(size_t), &binary_size, nullptr) !=
+       CL_SUCCESS)
+        return 0;
+    return binary_size;
+}
+
 void GetProgramBinary(const ClProgramPtr& program, std::string& binary)
 {
     size_t binary_size;
@@ -36,9 +36,12 @@
 #include <miopen/finddb_kernel_cache_key.hpp>
 #include <miopen/find_controls.hpp>
 #include <miopen/float_equal.hpp>
+#include <miopen/gpu_sensors.hpp>
 #include <miopen/invoker.hpp>
 #include <miopen/kernel.hpp>
+#include <miopen/measurement_policy.hpp>
 #include <miopen/solver.hpp>
+#include <miopen/solver_applicability.hpp>
 #include <miopen/tensor_ops.hpp>
 #include <miopen/tensor.hpp>
 #include <miopen/util.hpp>
@@ -47,14 +50,24 @@
 #include <miopen/any_solver.hpp>
 #include <miopen/conv/tensors.hpp>
 #include <miopen/conv/compiled_in_parameters.hpp>
+#include <miopen/conv/perf_model.hpp>
+#include <miopen/conv/plan.hpp>
+#include <miopen/conv/problem_key.hpp>
 #include <miopen/conv/data_invoke_params.hpp>
+#include <miopen/conv/find_misses.hpp>
+#include <miopen/conv/hot_problems.hpp>
+#include <miopen/conv/solver_histograms.hpp>
 #include <miopen/conv/wrw_invoke_params.hpp>
 
 #if MIOPEN_USE_GEMM
 #include <miopen/gemm_v2.hpp>
 #endif
 
+#include <algorithm>
 #include <cassert>
+#include <set>
+#include <sstream>
+#include <tuple>
 #include <type_traits>
 
 #include <boost/range/adaptors.hpp>
@@ -62,12 +75,31 @@
 namespace miopen {
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_GEMM)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_GEMM_CHUNKED)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_DIRECT)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_WINOGRAD)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_CONV_PRECISE_ROCBLAS_TIMING)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_FFT)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMMED_FALLBACK)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_FIND_COMPILE_ALL)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_BWD_BIAS_MULTI_BLOCK)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_CONV_WARM_UP)
+
+/// The descriptors the invokers of the canonical problem expect, see conv::CanonicalizeTensors().
+static ConvDataTensors CanonicalTensors(ConvDataTensors tensors,
+                                        const ConvolutionDescriptor& conv)
+{
+    conv::CanonicalizeTensors(conv, tensors.wDesc, tensors.inDesc, tensors.outDesc);
+    return tensors;
+}
+
+static ConvWrwTensors CanonicalTensors(ConvWrwTensors tensors,
+                                       const ConvolutionDescriptor& conv)
+{
+    conv::CanonicalizeTensors(conv, tensors.dwDesc, tensors.dyDesc, tensors.xDesc);
+    return tensors;
+}
 
 #if MIOPEN_USE_GEMM
 #ifdef CPPCHECK
@@ -84,6 +116,14 @@ static inline bool IsAnyBufferBF16(const TensorDescriptor& xDesc,
     return xDesc.GetType() == miopenBFloat16 || yDesc.GetType() == miopenBFloat16 ||
            wDesc.GetType() == miopenBFloat16;
 }
+
+/// GEMM-based convolutions assume the default (NCHW) layout of all tensors.
+static inline bool IsAnyBufferNonDefaultLayout(const TensorDescriptor& xDesc,
+                                               const TensorDescriptor& yDesc,
+                                               const TensorDescriptor& wDesc)
+{
+    return !xDesc.IsDefaultLayout() || !yDesc.IsDefaultLayout() || !wDesc.IsDefaultLayout();
+}
 #endif
 
 size_t GetKernelGlobalWorkDim(const KernelInvoke& kernel, int dim)
@@ -260,11 +300,16 @@ static void EvaluateInvokers(Handle& handle,
                              const AlgorithmName& algorithm_name,
                              const NetworkConfig& network_config,
                              const InvokeParams& invoke_ctx,
-                             DbRecord& record)
+                             DbRecord& record,
+                             bool prefer_latency)
 {
     miopen::solver::ConvSolution selected{miopenStatusUnknownError};
     float best = std::numeric_limits<float>::max();
     Invoker best_invoker;
+    const auto policy  = solver::MeasurementPolicy::FromEnv();
+    const auto sensors = GpuSensors::FromHandle(handle);
+    TuningConditions conditions;
+    GpuConditions best_conditions;
 
     for(const auto& sol : solutions)
     {
@@ -294,15 +339,43 @@ static void EvaluateInvokers(Handle& handle,
             MIOPEN_THROW("Invoker is not provided by solver " + sol.solver_id);
 
         const auto invoker = handle.PrepareInvoker(*sol.invoker_factory, sol.construction_params);
-        invoker(handle, invoke_ctx);
-        const auto elapsed = handle.GetKernelTime();
+        handle.ProfileLaunches([&]() { invoker(handle, invoke_ctx); });
+        auto elapsed       = handle.GetKernelTime();
+        const auto current = sensors.Read();
+        conditions.Add(current);
+        // The profiled times add up the kernels, but the device also idles between them.
+        if(prefer_latency && sol.construction_params.size() > 1)
+            elapsed += static_cast<float>(conv::kernel_gap_ms *
+                                          static_cast<double>(sol.construction_params.size() - 1));
+
+        // The best solution is timed again at the current clock, the penalty of the kernel
+        // gaps stays the same.
+        if(best_invoker && policy.IsClockDrifted(best_conditions, current))
+        {
+            handle.ProfileLaunches([&]() { best_invoker(handle, invoke_ctx); });
+            auto remeasured = handle.GetKernelTime();
+            if(prefer_latency && selected.construction_params.size() > 1)
+                remeasured += static_cast<float>(
+                    conv::kernel_gap_ms *
+                    static_cast<double>(selected.construction_params.size() - 1));
+            MIOPEN_LOG_I("Clock drifted from " << best_conditions.sclk_mhz << " to "
+                                               << current.sclk_mhz
+                                               << " MHz, best time "
+                                               << best
+                                               << " -> "
+                                               << remeasured);
+            best            = remeasured;
+            best_conditions = current;
+            ++conditions.remeasured;
+        }
 
         MIOPEN_LOG_I(sol << ": " << elapsed << (elapsed < best ? " < " : " >= ") << best);
         if(elapsed < best)
         {
-            best         = elapsed;
-            selected     = sol;
-            best_invoker = invoker;
+            best            = elapsed;
+            selected        = sol;
+            best_invoker    = invoker;
+            best_conditions = current;
         }
     }
 
@@ -316,6 +389,64 @@ static void EvaluateInvokers(Handle& handle,
                                     best,
                                     selected.workspce_sz,
                                     FindDbKCacheKey::MakeUnused(algorithm_name)});
+        conditions.SetBest(best_conditions);
+        conditions.Store(record.GetKey(), algorithm_name);
+    }
+}
+
+/// Solutions of one algorithm found by a Find call.
+struct AlgorithmSolutions
+{
+    AlgorithmName name;
+    std::vector<solver::ConvSolution> solutions;
+    bool may_fail = false; // Errors are logged, and the other algorithms are still timed.
+};
+
+/// The kernels of all the algorithms are built in one batch, so the compiler threads are kept
+/// busy across the solver families instead of waiting for the slowest kernel of each. The
+/// solutions are then timed one by one on the stream of the handle. A kernel that fails to
+/// build in the batch is built again with its algorithm to report the error. GEMM and FFT are
+/// timed by the callers apart: the GEMM kernels belong to rocBLAS or MIOpenGEMM, and the FFT
+/// ones are few, built from one source file as their plan is made, without a ConvSolution.
+template <class InvokeParams>
+static void EvaluateAlgorithms(Handle& handle,
+                               const std::vector<AlgorithmSolutions>& algorithms,
+                               const NetworkConfig& network_config,
+                               const InvokeParams& invoke_ctx,
+                               DbRecord& record,
+                               bool prefer_latency)
+{
+    if(!miopen::IsDisabled(MIOPEN_DEBUG_FIND_COMPILE_ALL{}))
+    {
+        std::vector<solver::ConvSolution> all;
+        for(const auto& algorithm : algorithms)
+            all.insert(all.end(), algorithm.solutions.begin(), algorithm.solutions.end());
+        const auto kernels  = solver::GetUncompiledKernels(handle, all);
+        const auto programs = solver::TryPrecompileKernels(handle, kernels);
+        for(std::size_t i = 0; i < programs.size(); ++i)
+            if(programs[i])
+                handle.AddProgram(*programs[i], kernels[i].kernel_file, kernels[i].comp_options);
+    }
+
+    for(const auto& algorithm : algorithms)
+    {
+        try
+        {
+            PrecompileSolutions(handle, algorithm.solutions);
+            EvaluateInvokers(handle,
+                             algorithm.solutions,
+                             algorithm.name,
+                             network_config,
+                             invoke_ctx,
+                             record,
+                             prefer_latency);
+        }
+        catch(const miopen::Exception& ex)
+        {
+            if(!algorithm.may_fail)
+                throw;
+            MIOPEN_LOG_WE("Find " << algorithm.name.ToString() << " failed:" << ex.what());
+        }
     }
 }
 
@@ -339,7 +470,8 @@ static void DirConvFindCore(Handle& handle,
 
 #if MIOPEN_USE_GEMM
     if(!use_winograd_only && !miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM{}) &&
-       !(IsAnyBufferBF16(xDesc, yDesc, wDesc) && !IsUseRocBlas))
+       !(IsAnyBufferBF16(xDesc, yDesc, wDesc) && !IsUseRocBlas) &&
+       !IsAnyBufferNonDefaultLayout(xDesc, yDesc, wDesc))
     { // GEMM algo
         std::size_t in_n, in_c;
         std::tie(in_n, in_c) = tie_pick<0, 1>()(xDesc.GetLengths());
@@ -660,27 +792,31 @@ static void DirConvFindCore(Handle& handle,
 #endif
 
     const auto network_config = ctx.BuildConfKey();
-    const auto invoke_ctx =
-        conv::DataInvokeParams{{xDesc, x, wDesc, w, yDesc, y}, workSpace, workSpaceSize};
+    const auto invoke_ctx = conv::DataInvokeParams{
+        CanonicalTensors(ConvDataTensors{xDesc, x, wDesc, w, yDesc, y}, conv),
+        workSpace,
+        workSpaceSize};
+
+    std::vector<AlgorithmSolutions> algorithms;
 
     // Winograd algo
-    {
-        const auto all = conv.FindWinogradSolutions(ctx, invoke_ctx);
-        PrecompileSolutions(handle, all);
-        const auto algorithm_name = AlgorithmName{"miopenConvolutionFwdAlgoWinograd"};
-        EvaluateInvokers(handle, all, algorithm_name, network_config, invoke_ctx, record);
-    }
+    algorithms.push_back({AlgorithmName{"miopenConvolutionFwdAlgoWinograd"},
+                          conv.FindWinogradSolutions(ctx, invoke_ctx)});
 
     // Direct algo
     if(!use_winograd_only)
     {
         ConvolutionUserBuffers bufs(workSpace, workSpaceSize);
         bufs.SetFwd(x, w, y);
-        const auto all = conv.FindDataDirectSolutions(
-            handle, xDesc, wDesc, yDesc, exhaustiveSearch, true, bufs, invoke_ctx);
-        PrecompileSolutions(handle, all);
-        const auto algorithm_name = AlgorithmName{"miopenConvolutionFwdAlgoDirect"};
-        EvaluateInvokers(handle, all, algorithm_name, network_config, invoke_ctx, record);
+        algorithms.push_back({AlgorithmName{"miopenConvolutionFwdAlgoDirect"},
+                              conv.FindDataDirectSolutions(handle,
+                                                           xDesc,
+                                                           wDesc,
+                                                           yDesc,
+                                                           exhaustiveSearch,
+                                                           true,
+                                                           bufs,
+                                                           invoke_ctx)});
     }
 
     // Implicit GEMM algo
@@ -688,13 +824,19 @@ static void DirConvFindCore(Handle& handle,
     {
         ConvolutionUserBuffers bufs(workSpace, workSpaceSize);
         bufs.SetFwd(x, w, y);
-        const auto all = conv.FindDataImplicitGemmSolutions(
-            handle, xDesc, wDesc, yDesc, exhaustiveSearch, true, bufs, invoke_ctx);
-        PrecompileSolutions(handle, all);
-        const auto algorithm_name = AlgorithmName{"miopenConvolutionFwdAlgoImplicitGEMM"};
-        EvaluateInvokers(handle, all, algorithm_name, network_config, invoke_ctx, record);
+        algorithms.push_back({AlgorithmName{"miopenConvolutionFwdAlgoImplicitGEMM"},
+                              conv.FindDataImplicitGemmSolutions(handle,
+                                                                 xDesc,
+                                                                 wDesc,
+                                                                 yDesc,
+                                                                 exhaustiveSearch,
+                                                                 true,
+                                                                 bufs,
+                                                                 invoke_ctx)});
     }
 
+    EvaluateAlgorithms(handle, algorithms, network_config, invoke_ctx, record, conv.prefer_latency);
+
     // FFT algo
     if(!use_winograd_only && conv.GetSpatialDimension() == 2 &&
        miopen::all_of(conv.GetConvDilations(), [](auto v) { return v == 1; }) &&
@@ -783,8 +925,9 @@ void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
     if((fm.IsFast() || fm.IsHybrid()) && !use_winograd_only)
     {
         size_t count;
-        GetForwardSolutions(handle, wDesc, xDesc, yDesc, 1, &count, &sol);
-        use_immediate_solution = (count > 0) && !(fm.IsHybrid() && sol.time < 0);
+        bool fallback;
+        GetForwardSolutions(handle, wDesc, xDesc, yDesc, 1, &count, &sol, &fallback);
+        use_immediate_solution = (count > 0) && !(fm.IsHybrid() && fallback);
         // In Hybrid Find mode, we use Normal Find instead of Immediate fallback kernels.
     }
 
@@ -842,30 +985,37 @@ void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
                                          << perf_db[0].time);
 }
 
-void ValidateConvTensors(const ConvTensors& tensors)
+static void ValidateConvTensorDescriptors(const TensorDescriptor& xDesc,
+                                          const TensorDescriptor& wDesc,
+                                          const TensorDescriptor& yDesc)
 {
-    const auto invalid_buffers =
-        tensors.x == nullptr || tensors.w == nullptr || tensors.y == nullptr;
-
-    const auto tensor_sizes_not_matched = tensors.xDesc.GetSize() != tensors.yDesc.GetSize() ||
-                                          tensors.xDesc.GetSize() != tensors.wDesc.GetSize();
+    const auto tensor_sizes_not_matched =
+        xDesc.GetSize() != yDesc.GetSize() || xDesc.GetSize() != wDesc.GetSize();
 
     const auto tensor_types_not_matched =
-        (tensors.xDesc.GetType() != tensors.yDesc.GetType() &&
-         tensors.xDesc.GetType() != miopenInt8 && tensors.xDesc.GetType() != miopenInt8x4) ||
-        tensors.xDesc.GetType() != tensors.wDesc.GetType();
+        (xDesc.GetType() != yDesc.GetType() && xDesc.GetType() != miopenInt8 &&
+         xDesc.GetType() != miopenInt8x4) ||
+        xDesc.GetType() != wDesc.GetType();
 
     // if(xDesc.GetLengths()[1] != wDesc.GetLengths()[1]) {
     //    MIOPEN_THROW(miopenStatusBadParm);
     //}
 
-    const auto x_tensor_invalid = tensors.xDesc.GetSize() < 3;
+    const auto x_tensor_invalid = xDesc.GetSize() < 3;
+
+    if(tensor_sizes_not_matched || tensor_types_not_matched || x_tensor_invalid)
+        MIOPEN_THROW(miopenStatusBadParm);
+}
 
-    const auto bad_parameters =
-        invalid_buffers || tensor_sizes_not_matched || tensor_types_not_matched || x_tensor_invalid;
+void ValidateConvTensors(const ConvTensors& tensors)
+{
+    const auto invalid_buffers =
+        tensors.x == nullptr || tensors.w == nullptr || tensors.y == nullptr;
 
-    if(bad_parameters)
+    if(invalid_buffers)
         MIOPEN_THROW(miopenStatusBadParm);
+
+    ValidateConvTensorDescriptors(tensors.xDesc, tensors.wDesc, tensors.yDesc);
 }
 
 void ValidateAlphaBeta(const void* alpha, const void* beta)
@@ -895,6 +1045,135 @@ static void ConvForwardCheckNumerics(const Handle& handle,
     miopen::checkNumericsOutput(handle, tensors.yDesc, tensors.y);
 }
 
+/// Returns the network config of the problem. It is only built on the first call for a problem,
+/// further calls find it by the binary key.
+static InternedString GetProblemConfig(const Handle& handle,
+                                       const conv::ProblemKey& key,
+                                       const std::function<NetworkConfig()>& build_config)
+{
+    const auto config = handle.GetProblemConfig(key);
+    if(!config.IsEmpty())
+        return config;
+    return handle.RegisterProblemConfig(key, build_config());
+}
+
+/// Finds the solutions of the algorithm among all the solvers, not only the dynamic ones, and
+/// builds their kernels. This is the background job of conv::HotProblems, so the kernels only go
+/// to the binary cache here, the handle gets them from there on PrecompileSolutions().
+static std::vector<solver::ConvSolution> FindSpecializedSolutions(ConvolutionContext ctx,
+                                                                  miopenConvAlgorithm_t algo)
+{
+    ctx.use_dynamic_solutions_only = false;
+    const auto invoke_ctx          = AnyInvokeParams{};
+    std::vector<solver::ConvSolution> all;
+
+    const bool wrw = ctx.direction.IsBackwardWrW();
+    switch(algo)
+    {
+    case miopenConvolutionAlgoDirect:
+        if(!miopen::IsDisabled(MIOPEN_DEBUG_CONV_DIRECT{}))
+            all = wrw ? FindAllBwdWrW2DSolutions(ctx, invoke_ctx)
+                      : FindAllDirectSolutions(ctx, invoke_ctx);
+        break;
+    case miopenConvolutionAlgoWinograd:
+        if(!miopen::IsDisabled(MIOPEN_DEBUG_CONV_WINOGRAD{}))
+            all = wrw ? FindWinogradWrWAllSolutions(ctx, invoke_ctx)
+                      : FindAllWinogradSolutions(ctx, invoke_ctx);
+        break;
+    case miopenConvolutionAlgoImplicitGEMM:
+        if(!miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM{}))
+            all = wrw ? FindImplicitGemmWrWAllSolutions(ctx, invoke_ctx)
+                      : FindAllImplicitGemmSolutions(ctx, invoke_ctx);
+        break;
+    case miopenConvolutionAlgoGEMM:
+    case miopenConvolutionAlgoFFT: break;
+    }
+
+    std::vector<solver::KernelInfo> kernels;
+    std::set<std::pair<std::string, std::string>> seen;
+    for(const auto& sol : all)
+        for(const auto& kernel : sol.construction_params)
+            if(seen.emplace(kernel.kernel_file, kernel.comp_options).second)
+                kernels.push_back(kernel);
+    solver::PrecompileKernels(ctx.GetStream(), kernels);
+    return all;
+}
+
+/// The find-db has a measured entry of the algorithm for the problem. Entries of other batch
+/// sizes do not count.
+static bool HasFindDbEntry(Handle& handle,
+                           const ProblemDescription& problem,
+                           const AlgorithmName& algorithm_name)
+{
+    const FindDbRecord record{handle, problem};
+    if(record.empty() || record.IsFromBatchBucket())
+        return false;
+    return std::any_of(record.begin(), record.end(), [&](const auto& entry) {
+        return entry.first == algorithm_name.ToString();
+    });
+}
+
+/// Counts the call for conv::HotProblems. Once all the solutions are built for a hot problem,
+/// these are timed with the buffers of the call, each recomputing its output, and the fastest
+/// replaces the invoker in use. In the BACKGROUND_REFINE mode the problems with a find-db entry
+/// of the algorithm are left as they are, and the refined choice is saved into the user find-db.
+template <class InvokeParams>
+static void SpecializeHotProblem(Handle& handle,
+                                 const InternedString& config,
+                                 const AlgorithmName& algorithm_name,
+                                 miopenConvAlgorithm_t algo,
+                                 const InvokeParams& invoke_ctx,
+                                 const std::function<ConvolutionContext()>& make_ctx)
+{
+    if(!conv::HotProblems::IsEnabled())
+        return;
+    if(algo != miopenConvolutionAlgoDirect && algo != miopenConvolutionAlgoWinograd &&
+       algo != miopenConvolutionAlgoImplicitGEMM)
+        return;
+
+    using Solutions = conv::HotProblems::Solutions;
+    const auto make = [&]() -> std::function<Solutions()> {
+        auto ctx        = make_ctx();
+        const auto mode = FindMode(ctx);
+        if(!mode.IsDynamicHybrid() && !mode.IsBackgroundRefine())
+            return {};
+        if(mode.IsBackgroundRefine() && HasFindDbEntry(handle, ctx, algorithm_name))
+            return {};
+        ctx.do_search               = false;
+        ctx.general_compile_options = "";
+        ctx.SetStream(&handle);
+        ctx.DetectRocm();
+        ctx.SetupFloats();
+        return [ctx, algo]() { return FindSpecializedSolutions(ctx, algo); };
+    };
+
+    const auto built = handle.GetHotProblems().Count(config, algo, make);
+    if(!built || built->empty())
+        return;
+
+    PrecompileSolutions(handle, *built);
+    const AutoEnableProfiling enable_profiling{handle};
+    const auto ctx = make_ctx();
+    auto record    = DbRecord{};
+    EvaluateInvokers(handle,
+                     *built,
+                     algorithm_name,
+                     NetworkConfig{config.ToString()},
+                     invoke_ctx,
+                     record,
+                     ctx.conv_problem.GetConv().prefer_latency);
+
+    // The find-db records of the DYNAMIC_HYBRID mode are written by the find calls.
+    auto refined = FindDbData{};
+    if(!FindMode(ctx).IsBackgroundRefine() || !record.GetValues(algorithm_name, refined))
+        return;
+    MIOPEN_LOG_I("Refined " << config.ToString() << ": " << refined.solver_id << ", "
+                            << refined.time);
+    if(!UserFindDbRecord::Update(
+           handle, static_cast<const ProblemDescription&>(ctx), algorithm_name, refined))
+        MIOPEN_LOG_W("Unable to save the refined solution to the user find-db");
+}
+
 void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
                                                const void* alpha,
                                                const TensorDescriptor& xDesc,
@@ -916,7 +1195,9 @@ void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
     if(algo != miopenConvolutionFwdAlgoGEMM &&
        (xDesc.GetType() == miopenInt8 || xDesc.GetType() == miopenInt8x4))
     {
-        MIOPEN_THROW(miopenStatusBadParm);
+        // int8 is also served by the xdlops implicit GEMM, but not int8x4
+        if(!(algo == miopenConvolutionFwdAlgoImplicitGEMM && xDesc.GetType() == miopenInt8))
+            MIOPEN_THROW(miopenStatusBadParm);
     }
 
     ConvForwardCheckNumerics(handle, tensors, [&]() {
@@ -925,16 +1206,31 @@ void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
         const auto algorithm_name = AlgorithmName{ConvolutionAlgoToDirectionalString(
             static_cast<miopenConvAlgorithm_t>(algo), conv::Direction::Forward)};
 
-        auto ctx =
-            ConvolutionContext{xDesc, wDesc, yDesc, *this, conv::Direction::Forward}; // forward
-        ctx.SetStream(&handle);
-        const auto network_config = ctx.BuildConfKey();
-        const auto& invoker       = handle.GetInvoker(network_config, {}, algorithm_name);
+        const auto key    = conv::ProblemKey{xDesc, wDesc, yDesc, *this, conv::Direction::Forward};
+        const auto config = GetProblemConfig(handle, key, [&]() {
+            return ConvolutionContext{xDesc, wDesc, yDesc, *this, conv::Direction::Forward}
+                .BuildConfKey();
+        });
+        const auto& invoker = handle.GetInvoker(config, {}, algorithm_name);
 
         if(invoker)
         {
-            const auto& invoke_ctx = conv::DataInvokeParams{tensors, workSpace, workSpaceSize};
-            (*invoker)(handle, invoke_ctx);
+            const auto& invoke_ctx =
+                conv::DataInvokeParams{CanonicalTensors(tensors, *this), workSpace, workSpaceSize};
+            conv::RunSampled(handle,
+                             conv::Direction::Forward,
+                             xDesc.GetType(),
+                             [&]() { return handle.GetFoundSolver(config, algorithm_name); },
+                             [&]() { (*invoker)(handle, invoke_ctx); });
+            SpecializeHotProblem(handle,
+                                 config,
+                                 algorithm_name,
+                                 static_cast<miopenConvAlgorithm_t>(algo),
+                                 invoke_ctx,
+                                 [&]() {
+                                     return ConvolutionContext{
+                                         xDesc, wDesc, yDesc, *this, conv::Direction::Forward};
+                                 });
             return;
         }
 
@@ -950,7 +1246,7 @@ void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
             break;
 
         case miopenConvolutionFwdAlgoFFT:
-            ConvFwdFFT(handle, tensors, workSpace, workSpaceSize, network_config);
+            ConvFwdFFT(handle, tensors, workSpace, workSpaceSize, NetworkConfig{config.ToString()});
             break;
         }
     });
@@ -1137,8 +1433,8 @@ void ConvolutionDescriptor::ConvFwdGemm(Handle& handle,
                                                           std::size_t(1),
                                                           std::multiplies<std::size_t>());
 
-            for(std::size_t i = 0; i < in_n; i++)
-            {
+            // Images are independent, so their GEMMs may run on several streams.
+            handle.RunConcurrently(in_n, [&](std::size_t i) {
                 std::size_t out_offset = i * wei_k * out_spatial_size;
 
                 std::size_t in_offset = i * in_c * in_spatial_size;
@@ -1159,7 +1455,7 @@ void ConvolutionDescriptor::ConvFwdGemm(Handle& handle,
                         handle.AccumKernelTime(time_0);
                     time_0 += handle.GetKernelTime();
                 }
-            }
+            });
         }
         else
         {
@@ -1267,107 +1563,187 @@ void ConvolutionDescriptor::ConvFwdGemm(Handle& handle,
         std::size_t in_spatial_size = std::accumulate(
             in_spatial.begin(), in_spatial.end(), std::size_t(1), std::multiplies<std::size_t>());
 
-        float time_0 = 0;
-        float t1     = 0;
-        for(std::size_t i = 0; i < in_n; i++)
-        {
-            std::size_t out_offset = i * wei_k * out_spatial_size;
+        std::size_t wei_spatial_size = std::accumulate(
+            wei_spatial.begin(), wei_spatial.end(), std::size_t(1), std::multiplies<std::size_t>());
 
-            std::size_t in_offset = i * in_c * in_spatial_size;
+        // Im2Col of a chunk of images is kept in each of two halves of the workspace, so both the
+        // im2col of the next chunk and the GEMM of the current one are batched over the images and
+        // the two may overlap on separate streams.
+        const std::size_t col_size   = in_c * wei_spatial_size * out_spatial_size;
+        const std::size_t col_bytes  = col_size * GetTypeSize(tensors.xDesc.GetType());
+        const std::size_t chunk_size = std::min(in_n, workSpaceSize / (2 * col_bytes));
 
-            Im2ColGPU(handle,
-                      GetSpatialDimension(),
-                      tensors.x,
-                      in_offset,
-                      in_c,
-                      in_spatial,
-                      wei_spatial,
-                      out_spatial,
-                      GetConvPads(),
-                      GetConvStrides(),
-                      GetConvDilations(),
-                      workSpace,
-                      tensors.xDesc.GetType());
+        if(group_count == 1 && in_n > 1 && chunk_size > 0 &&
+           tensors.wDesc.GetType() != miopenInt8 && tensors.wDesc.GetType() != miopenInt8x4 &&
+           !miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM_CHUNKED{}))
+        {
+            MIOPEN_LOG_I2("im2col chunk of " << chunk_size << " images");
 
-            if(handle.IsProfilingEnabled())
-                t1 = handle.GetKernelTime();
+            GemmDescriptor chunk_desc = gemm_desc;
+            chunk_desc.strideA        = 0;
+            chunk_desc.strideB        = col_size;
+            chunk_desc.strideC        = wei_k * out_spatial_size;
 
-            std::size_t wksp_offset = 0;
-            if(tensors.wDesc.GetType() == miopenInt8)
+            const std::size_t chunk_count = (in_n + chunk_size - 1) / chunk_size;
+
+            float time_0 = 0;
+            for(std::size_t wave = 0; wave < chunk_count; wave += 2)
             {
-                std::size_t wei_spatial_size = std::accumulate(wei_spatial.begin(),
-                                                               wei_spatial.end(),
-                                                               std::size_t(1),
-                                                               std::multiplies<std::size_t>());
+                const auto slots = std::min<std::size_t>(2, chunk_count - wave);
 
-                wksp_offset = in_c * wei_spatial_size * out_spatial_size;
+                handle.RunConcurrently(slots, [&](std::size_t slot) {
+                    const std::size_t first      = (wave + slot) * chunk_size;
+                    const std::size_t images     = std::min(chunk_size, in_n - first);
+                    const std::size_t col_offset = slot * chunk_size * col_size;
 
-                transpose_packed_MN2NM(handle,
-                                       static_cast<int>(in_c * wei_spatial_size),
-                                       out_spatial_size,
-                                       0,
-                                       wksp_offset,
-                                       workSpace,
-                                       workSpace,
-                                       tensors.xDesc.GetType());
+                    for(std::size_t j = 0; j < images; j++)
+                    {
+                        Im2ColGPU(handle,
+                                  GetSpatialDimension(),
+                                  tensors.x,
+                                  (first + j) * in_c * in_spatial_size,
+                                  in_c,
+                                  in_spatial,
+                                  wei_spatial,
+                                  out_spatial,
+                                  GetConvPads(),
+                                  GetConvStrides(),
+                                  GetConvDilations(),
+                                  workSpace,
+                                  tensors.xDesc.GetType(),
+                                  col_offset + j * col_size);
+
+                        if(handle.IsProfilingEnabled())
+                            time_0 += handle.GetKernelTime();
+                    }
 
-                if(handle.IsProfilingEnabled())
-                    t1 += handle.GetKernelTime();
-            }
+                    GemmDescriptor desc = chunk_desc;
+                    desc.batch_count    = images;
 
-            // tensors.y = tensors.w * Im2Col(tensors.x)
-            if(group_count > 1)
-                CallGemmStridedBatched(handle,
-                                       gemm_desc,
-                                       tensors.w,
-                                       0,
-                                       workSpace,
-                                       0,
-                                       tensors.y,
-                                       out_offset,
-                                       nullptr,
-                                       false);
-            else
-                CallGemm(handle,
-                         gemm_desc,
-                         tensors.w,
-                         0,
-                         workSpace,
-                         wksp_offset,
-                         tensors.y,
-                         out_offset,
-                         nullptr,
-                         false,
-                         (tensors.wDesc.GetType() == miopenInt8 ||
-                          tensors.wDesc.GetType() == miopenInt8x4)
-                             ? GemmBackend_t::rocblas
-                             : GemmBackend_t::miopengemm);
+                    // tensors.y = tensors.w * Im2Col(tensors.x) for each image of the chunk
+                    CallGemmStridedBatched(handle,
+                                           desc,
+                                           tensors.w,
+                                           0,
+                                           workSpace,
+                                           col_offset,
+                                           tensors.y,
+                                           first * wei_k * out_spatial_size,
+                                           nullptr,
+                                           false);
+
+                    if(handle.IsProfilingEnabled())
+                        time_0 += handle.GetKernelTime();
+                });
+            }
 
-            // Update times for both the kernels
             if(handle.IsProfilingEnabled())
             {
-                if(i == in_n - 1)
+                handle.ResetKernelTime();
+                handle.AccumKernelTime(time_0);
+            }
+        }
+        else
+        {
+            float time_0 = 0;
+            float t1     = 0;
+            for(std::size_t i = 0; i < in_n; i++)
+            {
+                std::size_t out_offset = i * wei_k * out_spatial_size;
+
+                std::size_t in_offset = i * in_c * in_spatial_size;
+
+                Im2ColGPU(handle,
+                          GetSpatialDimension(),
+                          tensors.x,
+                          in_offset,
+                          in_c,
+                          in_spatial,
+                          wei_spatial,
+                          out_spatial,
+                          GetConvPads(),
+                          GetConvStrides(),
+                          GetConvDilations(),
+                          workSpace,
+                          tensors.xDesc.GetType());
+
+                if(handle.IsProfilingEnabled())
+                    t1 = handle.GetKernelTime();
+
+                std::size_t wksp_offset = 0;
+                if(tensors.wDesc.GetType() == miopenInt8)
                 {
-                    handle.AccumKernelTime(t1 + time_0);
-                    time_0 = handle.GetKernelTime();
+                    wksp_offset = col_size;
+
+                    transpose_packed_MN2NM(handle,
+                                           static_cast<int>(in_c * wei_spatial_size),
+                                           out_spatial_size,
+                                           0,
+                                           wksp_offset,
+                                           workSpace,
+                                           workSpace,
+                                           tensors.xDesc.GetType());
+
+                    if(handle.IsProfilingEnabled())
+                        t1 += handle.GetKernelTime();
                 }
+
+                // tensors.y = tensors.w * Im2Col(tensors.x)
+                if(group_count > 1)
+                    CallGemmStridedBatched(handle,
+                                           gemm_desc,
+                                           tensors.w,
+                                           0,
+                                           workSpace,
+                                           0,
+                                           tensors.y,
+                                           out_offset,
+                                           nullptr,
+                                           false);
                 else
+                    CallGemm(handle,
+                             gemm_desc,
+                             tensors.w,
+                             0,
+                             workSpace,
+                             wksp_offset,
+                             tensors.y,
+                             out_offset,
+                             nullptr,
+                             false,
+                             (tensors.wDesc.GetType() == miopenInt8 ||
+                              tensors.wDesc.GetType() == miopenInt8x4)
+                                 ? GemmBackend_t::rocblas
+                                 : GemmBackend_t::miopengemm);
+
+                // Update times for both the kernels
+                if(handle.IsProfilingEnabled())
                 {
-                    handle.AccumKernelTime(t1);
-                    time_0 += handle.GetKernelTime();
+                    if(i == in_n - 1)
+                    {
+                        handle.AccumKernelTime(t1 + time_0);
+                        time_0 = handle.GetKernelTime();
+                    }
+                    else
+                    {
+                        handle.AccumKernelTime(t1);
+                        time_0 += handle.GetKernelTime();
+                    }
                 }
             }
-        }
 
-        if((tensors.wDesc.GetType() == miopenInt8 || tensors.wDesc.GetType() == miopenInt8x4) &&
-           tensors.yDesc.GetType() != miopenInt32)
-        {
-            TensorDescriptor ygemmDesc(
-                miopenInt32, tensors.yDesc.GetLengths(), tensors.yDesc.GetStrides());
+            if((tensors.wDesc.GetType() == miopenInt8 ||
+                tensors.wDesc.GetType() == miopenInt8x4) &&
+               tensors.yDesc.GetType() != miopenInt32)
+            {
+                TensorDescriptor ygemmDesc(
+                    miopenInt32, tensors.yDesc.GetLengths(), tensors.yDesc.GetStrides());
 
-            CastTensor(handle, &lowp_quant, ygemmDesc, tensors.y, tensors.yDesc, tensors.y, 0, 0);
-            if(handle.IsProfilingEnabled())
-                handle.AccumKernelTime(time_0);
+                CastTensor(
+                    handle, &lowp_quant, ygemmDesc, tensors.y, tensors.yDesc, tensors.y, 0, 0);
+                if(handle.IsProfilingEnabled())
+                    handle.AccumKernelTime(time_0);
+            }
         }
     }
 #ifdef NDEBUG
@@ -1416,52 +1792,149 @@ void ConvolutionDescriptor::ConvFwdFFT(const Handle& handle,
     }
 }
 
-std::size_t ConvolutionDescriptor::GetFwdSolutionCountFallback(const TensorDescriptor& wDesc,
-                                                               const TensorDescriptor& xDesc,
-                                                               const TensorDescriptor& yDesc) const
+static inline bool IsAlgorithmDisabled(const miopenConvAlgorithm_t algo)
 {
-    // This is needed on fallback path only.
-    // Regular (find-db) path have been verified during Find().
-    ValidateGroupCount(xDesc, wDesc, *this);
+    switch(algo)
+    { // clang-format off
+    case miopenConvolutionAlgoGEMM:
+        return miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM{}) || !MIOPEN_USE_GEMM;
+    case miopenConvolutionAlgoDirect:
+        return miopen::IsDisabled(MIOPEN_DEBUG_CONV_DIRECT{});
+    case miopenConvolutionAlgoFFT:
+        return miopen::IsDisabled(MIOPEN_DEBUG_CONV_FFT{});
+    case miopenConvolutionAlgoWinograd:
+        return miopen::IsDisabled(MIOPEN_DEBUG_CONV_WINOGRAD{});
+    case miopenConvolutionAlgoImplicitGEMM:
+        return miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM{});
+    default: // Disable future algos by default to enforce explicit handling:
+        return true;
+    } // clang-format on
+}
 
-    if(IsGemmApplicableFwd(wDesc, xDesc, yDesc) &&
-       !miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK{}))
+
+/// Collects the immediate mode fallback solutions: GEMM, if applicable, and all applicable
+/// dynamic solvers. Non-dynamic solvers are skipped because these would compile new kernels
+/// for every new input size. There are no measured times on this path, so the solutions are
+/// ordered by the time estimated by the analytical performance model.
+static std::vector<miopenConvSolution_t>
+GetFallbackSolutions(Handle& handle,
+                     const ProblemDescription& problem,
+                     bool is_gemm_applicable,
+                     const std::function<std::size_t()>& get_gemm_workspace)
+{
+    std::vector<miopenConvSolution_t> solutions;
+    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK{}))
     {
-        MIOPEN_LOG_I("Fallback path, GEMM");
-        return 1;
+        MIOPEN_LOG_I("Fallback path disabled");
+        return solutions;
     }
-    MIOPEN_LOG_I("Fallback path, GEMM disabled");
-    /// When count=0 the reason could be:
-    /// * (1) Convolution is not implemented in the library at all, so Find() would fail as
-    ///   well. This is case when rc = miopenStatusNotImplemented is correct.
-    /// * (2) Variant of the above: Convolution is implemented, but implementation is disabled,
-    ///   for example, rocBLAS is not installed or some convolutions are disabled by the
-    ///   environment setting.
-    /// * (3) There is none relevant record in the find-db and fallback path was unable to
-    ///   choose suitable solution.
-    ///
-    /// We can't distinguish these three cases.
-    /// Let's do like Find() does:
-    MIOPEN_THROW(miopenStatusNotImplemented,
-                 "Requested convolution is not supported or immedate mode fallback has failed.");
+
+    auto ctx = ConvolutionContext{problem};
+    ctx.SetStream(&handle);
+    ctx.DetectRocm();
+    ctx.SetupFloats();
+
+    if(is_gemm_applicable)
+    {
+        const auto ws = get_gemm_workspace();
+        solutions.push_back({conv::EstimateSolverTime(ctx, solver::Id::gemm(), ws),
+                             ws,
+                             solver::Id::gemm().Value(),
+                             miopenConvolutionAlgoGEMM});
+    }
+
+    // Solvers which cannot be applicable to the problem by their traits are not listed.
+    const auto key  = solver::applicability::Key::From(ctx);
+    const auto memo = solver::applicability::Memo{ctx};
+    for(const auto& id : solver::applicability::GetCandidateIds(key))
+    {
+        const auto solver = id.GetSolver();
+        // gemm and fft have no solver objects.
+        if(solver.IsEmpty() || !solver.IsDynamic())
+            continue;
+        const auto algo = id.GetAlgorithm();
+        if(IsAlgorithmDisabled(algo) || !memo.IsApplicable(solver, ctx))
+            continue;
+        const auto ws   = solver.GetWorkspaceSize(ctx);
+        const auto time = conv::EstimateSolverTime(ctx, id, ws);
+        if(time < 0)
+            continue;
+        solutions.push_back({time, ws, id.Value(), algo});
+    }
+
+    std::stable_sort(solutions.begin(),
+                     solutions.end(),
+                     [](const miopenConvSolution_t& lhs, const miopenConvSolution_t& rhs) {
+                         return lhs.time < rhs.time;
+                     });
+
+    for(const auto& solution : solutions)
+        MIOPEN_LOG_I("Fallback path, " << solver::Id{solution.solution_id}.ToString()
+                                       << ", estimated time: " << solution.time);
+    return solutions;
+}
+
+static std::size_t GetFallbackSolutionCount(const std::vector<miopenConvSolution_t>& solutions)
+{
+    if(!solutions.empty())
+        return solutions.size();
+
+    MIOPEN_LOG_I("Fallback path, no applicable solutions");
+    /// When count=0 the reason could be:
+    /// * (1) Convolution is not implemented in the library at all, so Find() would fail as
+    ///   well. This is case when rc = miopenStatusNotImplemented is correct.
+    /// * (2) Variant of the above: Convolution is implemented, but implementation is disabled,
+    ///   for example, rocBLAS is not installed or some convolutions are disabled by the
+    ///   environment setting.
+    /// * (3) There is none relevant record in the find-db and fallback path was unable to
+    ///   choose suitable solution.
+    ///
+    /// We can't distinguish these three cases.
+    /// Let's do like Find() does:
+    MIOPEN_THROW(miopenStatusNotImplemented,
+                 "Requested convolution is not supported or immedate mode fallback has failed.");
+}
+
+static void WriteFallbackSolutions(const std::vector<miopenConvSolution_t>& candidates,
+                                   const size_t maxSolutionCount,
+                                   size_t* const solutionCount,
+                                   miopenConvSolution_t* const solutions)
+{
+    auto i = std::size_t{0};
+    for(; i < candidates.size() && i < maxSolutionCount; ++i)
+        solutions[i] = candidates[i];
+    *solutionCount = i;
 }
 
-std::size_t ConvolutionDescriptor::GetBwdSolutionCountFallback(const TensorDescriptor& dyDesc,
+std::size_t ConvolutionDescriptor::GetFwdSolutionCountFallback(Handle& handle,
+                                                               const TensorDescriptor& wDesc,
+                                                               const TensorDescriptor& xDesc,
+                                                               const TensorDescriptor& yDesc) const
+{
+    // This is needed on fallback path only.
+    // Regular (find-db) path have been verified during Find().
+    ValidateGroupCount(xDesc, wDesc, *this);
+
+    const auto problem = ProblemDescription{xDesc, wDesc, yDesc, *this, conv::Direction::Forward};
+    return GetFallbackSolutionCount(
+        GetFallbackSolutions(handle, problem, IsGemmApplicableFwd(wDesc, xDesc, yDesc), [&]() {
+            return ForwardGetValidWorkSpaceSizeGemm(handle, wDesc, xDesc, yDesc);
+        }));
+}
+
+std::size_t ConvolutionDescriptor::GetBwdSolutionCountFallback(Handle& handle,
+                                                               const TensorDescriptor& dyDesc,
                                                                const TensorDescriptor& wDesc,
                                                                const TensorDescriptor& dxDesc) const
 {
     ValidateGroupCount(dxDesc, wDesc, *this); // See comment in Forward method.
 
-    if(IsGemmApplicableBwd(dyDesc, wDesc, dxDesc) &&
-       !miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK{}))
-    {
-        MIOPEN_LOG_I("Fallback path, GEMM");
-        return 1;
-    }
-    MIOPEN_LOG_I("Fallback path, GEMM disabled");
-    // See comment in Forward method.
-    MIOPEN_THROW(miopenStatusNotImplemented,
-                 "Requested convolution is not supported or immedate mode fallback has failed.");
+    const auto problem =
+        ProblemDescription{dxDesc, wDesc, dyDesc, *this, conv::Direction::BackwardData};
+    return GetFallbackSolutionCount(
+        GetFallbackSolutions(handle, problem, IsGemmApplicableBwd(dyDesc, wDesc, dxDesc), [&]() {
+            return BackwardGetValidWorkSpaceSizeGemm(dyDesc, wDesc, dxDesc);
+        }));
 }
 
 bool ConvolutionDescriptor::IsGemmApplicableWrw(const TensorDescriptor& dyDesc,
@@ -1470,7 +1943,8 @@ bool ConvolutionDescriptor::IsGemmApplicableWrw(const TensorDescriptor& dyDesc,
 {
 #if MIOPEN_USE_GEMM
     if(!miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM{}) &&
-       !(IsAnyBufferBF16(xDesc, dyDesc, dwDesc) && !IsUseRocBlas))
+       !(IsAnyBufferBF16(xDesc, dyDesc, dwDesc) && !IsUseRocBlas) &&
+       !IsAnyBufferNonDefaultLayout(xDesc, dyDesc, dwDesc))
     {
         const std::size_t spatial_dim = GetSpatialDimension();
         const auto wei_spatial = boost::adaptors::slice(dwDesc.GetLengths(), 2, 2 + spatial_dim);
@@ -1502,7 +1976,8 @@ bool ConvolutionDescriptor::IsGemmApplicableFwd(const TensorDescriptor& wDesc,
 {
 #if MIOPEN_USE_GEMM
     return !miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM{}) &&
-           !(IsAnyBufferBF16(xDesc, yDesc, wDesc) && !IsUseRocBlas);
+           !(IsAnyBufferBF16(xDesc, yDesc, wDesc) && !IsUseRocBlas) &&
+           !IsAnyBufferNonDefaultLayout(xDesc, yDesc, wDesc);
 #else
     std::ignore = wDesc;
     std::ignore = xDesc;
@@ -1517,7 +1992,8 @@ bool ConvolutionDescriptor::IsGemmApplicableBwd(const TensorDescriptor& dyDesc,
 {
 #if MIOPEN_USE_GEMM
     return !miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM{}) &&
-           !(IsAnyBufferBF16(dxDesc, dyDesc, wDesc) && !IsUseRocBlas);
+           !(IsAnyBufferBF16(dxDesc, dyDesc, wDesc) && !IsUseRocBlas) &&
+           !IsAnyBufferNonDefaultLayout(dxDesc, dyDesc, wDesc);
 #else
     std::ignore = dyDesc;
     std::ignore = wDesc;
@@ -1526,22 +2002,19 @@ bool ConvolutionDescriptor::IsGemmApplicableBwd(const TensorDescriptor& dyDesc,
 #endif
 }
 
-std::size_t ConvolutionDescriptor::GetWrwSolutionCountFallback(const TensorDescriptor& dyDesc,
+
+std::size_t ConvolutionDescriptor::GetWrwSolutionCountFallback(Handle& handle,
+                                                               const TensorDescriptor& dyDesc,
                                                                const TensorDescriptor& xDesc,
                                                                const TensorDescriptor& dwDesc) const
 {
     ValidateGroupCount(xDesc, dwDesc, *this); // See comment in Forward method.
 
-    if(IsGemmApplicableWrw(xDesc, dyDesc, dwDesc) &&
-       !miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK{}))
-    {
-        MIOPEN_LOG_I("Fallback path, GEMM");
-        return 1;
-    }
-    MIOPEN_LOG_I("Fallback path, GEMM disabled");
-    // See comment in Forward method.
-    MIOPEN_THROW(miopenStatusNotImplemented,
-                 "Requested convolution is not supported or immedate mode fallback has failed.");
+    const auto problem = MakeWrwProblem(handle, dyDesc, xDesc, dwDesc);
+    return GetFallbackSolutionCount(
+        GetFallbackSolutions(handle, problem, IsGemmApplicableWrw(dyDesc, xDesc, dwDesc), [&]() {
+            return WrwGetValidWorkSpaceSizeGemm(dyDesc, xDesc, dwDesc);
+        }));
 }
 
 std::size_t GetSolutionCount(Handle& handle, const ProblemDescription& problem)
@@ -1562,27 +2035,9 @@ std::size_t ConvolutionDescriptor::GetForwardSolutionCount(Handle& handle,
     const auto n       = GetSolutionCount(handle, problem);
     if(n > 0)
         return n;
-    return GetFwdSolutionCountFallback(wDesc, xDesc, yDesc);
+    return GetFwdSolutionCountFallback(handle, wDesc, xDesc, yDesc);
 }
 
-static inline bool IsAlgorithmDisabled(const miopenConvAlgorithm_t algo)
-{
-    switch(algo)
-    { // clang-format off
-    case miopenConvolutionAlgoGEMM:
-        return miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM{}) || !MIOPEN_USE_GEMM;
-    case miopenConvolutionAlgoDirect:
-        return miopen::IsDisabled(MIOPEN_DEBUG_CONV_DIRECT{});
-    case miopenConvolutionAlgoFFT:
-        return miopen::IsDisabled(MIOPEN_DEBUG_CONV_FFT{});
-    case miopenConvolutionAlgoWinograd:
-        return miopen::IsDisabled(MIOPEN_DEBUG_CONV_WINOGRAD{});
-    case miopenConvolutionAlgoImplicitGEMM:
-        return miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM{});
-    default: // Disable future algos by default to enforce explicit handling:
-        return true;
-    } // clang-format on
-}
 
 void GetSolutions(Handle& handle,
                   const ProblemDescription& problem,
@@ -1600,7 +2055,6 @@ void GetSolutions(Handle& handle,
     }
 
     // Read all what we have, then sort and write out up to max asked.
-    // Fallback path currently returns only one solution, so no need to sort there.
     struct SortWrapper : miopenConvSolution_t // For emplace and sort.
     {
         SortWrapper(const float& t,
@@ -1623,6 +2077,7 @@ void GetSolutions(Handle& handle,
     auto ctx = ConvolutionContext{problem};
     ctx.SetStream(&handle);
     ctx.DetectRocm();
+    const auto memo = solver::applicability::Memo{ctx};
 
     for(const auto& pair : fdb_record)
     {
@@ -1642,12 +2097,21 @@ void GetSolutions(Handle& handle,
         // gemm and fft are always applicable.
         // These can be disabled/enabled at algorithm level.
         if(!(solver_id == solver::Id::gemm() || solver_id == solver::Id::fft()))
-            if(!solver_id.GetSolver().IsApplicable(ctx))
+            if(!memo.IsApplicable(solver_id.GetSolver(), ctx))
                 continue;
 
-        interim.emplace_back(pair.second.time, pair.second.workspace, solver_id.Value(), algo);
+        // The workspace recorded for another batch size may be too small.
+        const auto workspace = fdb_record.IsFromBatchBucket()
+                                   ? solver_id.GetSolver().GetWorkspaceSize(ctx)
+                                   : pair.second.workspace;
+        interim.emplace_back(pair.second.time, workspace, solver_id.Value(), algo);
     }
     std::sort(begin(interim), end(interim));
+    // Under a device memory limit, the solutions which fit what is left come first.
+    const auto workspace_budget = handle.GetWorkspaceBudget();
+    std::stable_partition(begin(interim), end(interim), [&](const SortWrapper& s) {
+        return s.workspace_size <= workspace_budget;
+    });
 
     auto i = std::size_t{0};
     for(const auto& entry : interim)
@@ -1660,6 +2124,31 @@ void GetSolutions(Handle& handle,
     *solutionCount = i;
 }
 
+std::vector<miopenConvSolution_t> GetParetoSolutions(std::vector<miopenConvSolution_t> solutions,
+                                                     const std::size_t workspace_limit)
+{
+    solutions.erase(std::remove_if(solutions.begin(),
+                                   solutions.end(),
+                                   [&](const miopenConvSolution_t& s) {
+                                       return s.workspace_size > workspace_limit;
+                                   }),
+                    solutions.end());
+    std::stable_sort(solutions.begin(),
+                     solutions.end(),
+                     [](const miopenConvSolution_t& lhs, const miopenConvSolution_t& rhs) {
+                         return lhs.time < rhs.time ||
+                                (lhs.time == rhs.time && lhs.workspace_size < rhs.workspace_size);
+                     });
+
+    // A solution is dominated unless it needs less workspace than all the faster ones.
+    std::vector<miopenConvSolution_t> front;
+    for(const auto& solution : solutions)
+        if(front.empty() || solution.workspace_size < front.back().workspace_size)
+            front.push_back(solution);
+    return front;
+}
+
+
 void ConvolutionDescriptor::GetForwardSolutionsFallback(Handle& handle,
                                                         const TensorDescriptor& wDesc,
                                                         const TensorDescriptor& xDesc,
@@ -1671,29 +2160,16 @@ void ConvolutionDescriptor::GetForwardSolutionsFallback(Handle& handle,
     // This check is needed on fallback path only.
     // Regular (find-db) path have been verified during Find().
     ValidateGroupCount(xDesc, wDesc, *this);
-    auto i = std::size_t{0};
 
-    if(IsGemmApplicableFwd(wDesc, xDesc, yDesc) &&
-       !miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK{}))
-    {
-        MIOPEN_LOG_I("Fallback path, GEMM");
-        if(i < maxSolutionCount)
-        {
-            solutions[i].algorithm = miopenConvolutionAlgoGEMM;
-            solutions[i].time      = -1.0; /// \todo Evaluate time.
-            solutions[i].workspace_size =
-                ForwardGetValidWorkSpaceSizeGemm(handle, wDesc, xDesc, yDesc);
-            solutions[i].solution_id = solver::Id::gemm().Value();
-            ++i;
-        }
-    }
-    else
-        MIOPEN_LOG_I("Fallback path, GEMM disabled");
-
-    *solutionCount = i;
+    const auto problem = ProblemDescription{xDesc, wDesc, yDesc, *this, conv::Direction::Forward};
+    const auto candidates =
+        GetFallbackSolutions(handle, problem, IsGemmApplicableFwd(wDesc, xDesc, yDesc), [&]() {
+            return ForwardGetValidWorkSpaceSizeGemm(handle, wDesc, xDesc, yDesc);
+        });
+    WriteFallbackSolutions(candidates, maxSolutionCount, solutionCount, solutions);
 }
 
-void ConvolutionDescriptor::GetBwdSolutionsFallback(Handle& /*handle*/,
+void ConvolutionDescriptor::GetBwdSolutionsFallback(Handle& handle,
                                                     const TensorDescriptor& dyDesc,
                                                     const TensorDescriptor& wDesc,
                                                     const TensorDescriptor& dxDesc,
@@ -1702,28 +2178,17 @@ void ConvolutionDescriptor::GetBwdSolutionsFallback(Handle& /*handle*/,
                                                     miopenConvSolution_t* const solutions) const
 {
     ValidateGroupCount(dxDesc, wDesc, *this);
-    auto i = std::size_t{0};
 
-    if(IsGemmApplicableBwd(dyDesc, wDesc, dxDesc) &&
-       !miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK{}))
-    {
-        MIOPEN_LOG_I("Fallback path, GEMM");
-        if(i < maxSolutionCount)
-        {
-            solutions[i].algorithm      = miopenConvolutionAlgoGEMM;
-            solutions[i].time           = -1.0; /// \todo Evaluate time.
-            solutions[i].workspace_size = BackwardGetValidWorkSpaceSizeGemm(dyDesc, wDesc, dxDesc);
-            solutions[i].solution_id    = solver::Id::gemm().Value();
-            ++i;
-        }
-    }
-    else
-        MIOPEN_LOG_I("Fallback path, GEMM disabled");
-
-    *solutionCount = i;
+    const auto problem =
+        ProblemDescription{dxDesc, wDesc, dyDesc, *this, conv::Direction::BackwardData};
+    const auto candidates =
+        GetFallbackSolutions(handle, problem, IsGemmApplicableBwd(dyDesc, wDesc, dxDesc), [&]() {
+            return BackwardGetValidWorkSpaceSizeGemm(dyDesc, wDesc, dxDesc);
+        });
+    WriteFallbackSolutions(candidates, maxSolutionCount, solutionCount, solutions);
 }
 
-void ConvolutionDescriptor::GetWrwSolutionsFallback(Handle& /*handle*/,
+void ConvolutionDescriptor::GetWrwSolutionsFallback(Handle& handle,
                                                     const TensorDescriptor& dyDesc,
                                                     const TensorDescriptor& xDesc,
                                                     const TensorDescriptor& dwDesc,
@@ -1732,25 +2197,13 @@ void ConvolutionDescriptor::GetWrwSolutionsFallback(Handle& /*handle*/,
                                                     miopenConvSolution_t* const solutions) const
 {
     ValidateGroupCount(xDesc, dwDesc, *this);
-    auto i = std::size_t{0};
 
-    if(IsGemmApplicableWrw(dyDesc, xDesc, dwDesc) &&
-       !miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK{}))
-    {
-        MIOPEN_LOG_I("Fallback path, GEMM");
-        if(i < maxSolutionCount)
-        {
-            solutions[i].algorithm      = miopenConvolutionAlgoGEMM;
-            solutions[i].time           = -1.0; /// \todo Evaluate time.
-            solutions[i].workspace_size = WrwGetValidWorkSpaceSizeGemm(dyDesc, xDesc, dwDesc);
-            solutions[i].solution_id    = solver::Id::gemm().Value();
-            ++i;
-        }
-    }
-    else
-        MIOPEN_LOG_I("Fallback path, GEMM disabled");
-
-    *solutionCount = i;
+    const auto problem = MakeWrwProblem(handle, dyDesc, xDesc, dwDesc);
+    const auto candidates =
+        GetFallbackSolutions(handle, problem, IsGemmApplicableWrw(dyDesc, xDesc, dwDesc), [&]() {
+            return WrwGetValidWorkSpaceSizeGemm(dyDesc, xDesc, dwDesc);
+        });
+    WriteFallbackSolutions(candidates, maxSolutionCount, solutionCount, solutions);
 }
 
 void ConvolutionDescriptor::GetForwardSolutions(Handle& handle,
@@ -1759,7 +2212,8 @@ void ConvolutionDescriptor::GetForwardSolutions(Handle& handle,
                                                 const TensorDescriptor& yDesc,
                                                 const size_t maxSolutionCount,
                                                 size_t* const solutionCount,
-                                                miopenConvSolution_t* const solutions) const
+                                                miopenConvSolution_t* const solutions,
+                                                bool* const fallback) const
 {
     MIOPEN_LOG_I("");
     if(solutionCount == nullptr)
@@ -1771,9 +2225,15 @@ void ConvolutionDescriptor::GetForwardSolutions(Handle& handle,
     GetSolutions(
         handle, problem, maxSolutionCount, solutionCount, solutions, StringToConvolutionFwdAlgo);
 
+    if(fallback != nullptr)
+        *fallback = *solutionCount == 0;
     if(*solutionCount == 0)
+    {
         GetForwardSolutionsFallback(
             handle, wDesc, xDesc, yDesc, maxSolutionCount, solutionCount, solutions);
+        if(*solutionCount > 0)
+            conv::RecordFindMiss(problem.conv_problem, solutions[0]);
+    }
 }
 
 std::size_t
@@ -1859,7 +2319,7 @@ std::size_t ConvolutionDescriptor::GetForwardSolutionWorkspaceSize(Handle& handl
         auto ctx = ConvolutionContext{xDesc, wDesc, yDesc, *this, conv::Direction::Forward};
         ctx.SetStream(&handle);
         ctx.DetectRocm();
-        if(sol.IsApplicable(ctx))
+        if(solver::applicability::Memo{ctx}.IsApplicable(sol, ctx))
             return sol.GetWorkspaceSize(ctx);
         else
         {
@@ -1923,12 +2383,96 @@ static Invoker LoadOrPrepareInvoker(Handle& handle,
     return PrepareInvoker(handle, ctx, config, solver_id, dir);
 }
 
+/// The context is not made unless the invoker has to be prepared.
+static Invoker LoadOrPrepareInvoker(Handle& handle,
+                                    const conv::ProblemKey& key,
+                                    const std::function<ConvolutionContext()>& make_ctx,
+                                    solver::Id solver_id,
+                                    conv::Direction dir,
+                                    InternedString& config)
+{
+    config = GetProblemConfig(handle, key, [&]() { return make_ctx().BuildConfKey(); });
+    conv::CountFindMissCall(config, solver_id);
+    const auto invoker = handle.GetInvoker(config, solver_id);
+    if(invoker)
+        return *invoker;
+    auto ctx = make_ctx();
+    return PrepareInvoker(handle, ctx, NetworkConfig{config.ToString()}, solver_id, dir);
+}
+
+/// Identifies immediate mode launches that may be replayed from a captured graph.
+static std::string GetGraphKey(const InternedString& config,
+                               solver::Id solver_id,
+                               std::size_t workspace_size,
+                               std::initializer_list<ConstData_t> buffers)
+{
+#if MIOPEN_USE_HIP_GRAPHS
+    std::ostringstream ss;
+    ss << config.ToString() << ' ' << solver_id.ToString() << ' ' << workspace_size;
+    for(const auto buffer : buffers)
+        ss << ' ' << buffer;
+    return ss.str();
+#else
+    std::ignore = config;
+    std::ignore = solver_id;
+    std::ignore = workspace_size;
+    std::ignore = buffers;
+    return {};
+#endif
+}
+
 static bool CheckInvokerSupport(const solver::Id solver_id, conv::Direction dir)
 {
     const auto& algo = solver_id.GetAlgo(dir);
     return CheckInvokerSupport(algo);
 }
 
+/// Runs the invoker once on uninitialized buffers of the sizes of the problem, so that the code
+/// objects of its kernels are resident on the device before the first real call. The background
+/// handle keeps the launches off the stream of the application and the garbage out of the caches
+/// of its handle. The caller waits for the handle.
+static void WarmUpInvoker(const Handle& background,
+                          const conv::ProblemDescription& problem,
+                          const Invoker& invoker,
+                          std::size_t workspace_size)
+{
+    const auto create = [&](const TensorDescriptor& desc) {
+        return background.Create(desc.GetElementSpace() * GetTypeSize(desc.GetType()),
+                                 miopenAllocationScratch);
+    };
+    // Tensors of backward problems are swapped, i.e. GetIn() is dy and GetOut() is x or dx.
+    auto in        = create(problem.GetIn());
+    auto weights   = create(problem.GetWeights());
+    auto out       = create(problem.GetOut());
+    auto workspace = workspace_size > 0
+                         ? background.Create(workspace_size, miopenAllocationScratch)
+                         : Allocator::ManageDataPtr{};
+
+    if(problem.GetDirection() == conv::Direction::BackwardWeights)
+    {
+        const auto tensors = ConvWrwTensors{problem.GetIn(),
+                                            in.get(),
+                                            problem.GetOut(),
+                                            out.get(),
+                                            problem.GetWeights(),
+                                            weights.get()};
+        const auto params = conv::WrWInvokeParams{tensors, workspace.get(), workspace_size};
+        invoker(background, params);
+    }
+    else
+    {
+        const auto tensors = ConvDataTensors{problem.GetIn(),
+                                             in.get(),
+                                             problem.GetWeights(),
+                                             weights.get(),
+                                             problem.GetOut(),
+                                             out.get()};
+        const auto params = conv::DataInvokeParams{tensors, workspace.get(), workspace_size};
+        invoker(background, params);
+    }
+    // The buffers are released in stream order, after the launches.
+}
+
 static void CompileSolution(Handle& handle,
                             const solver::Id solver_id,
                             ConvolutionContext& ctx,
@@ -1940,7 +2484,18 @@ static void CompileSolution(Handle& handle,
 
     if(CheckInvokerSupport(solver_id, dir))
     {
-        LoadOrPrepareInvoker(handle, ctx, solver_id, dir);
+        const auto prepared = static_cast<bool>(handle.GetInvoker(ctx.BuildConfKey(), solver_id));
+        const auto invoker  = LoadOrPrepareInvoker(handle, ctx, solver_id, dir);
+        if(!prepared && miopen::IsEnabled(MIOPEN_CONV_WARM_UP{}))
+        {
+            const auto solver     = solver_id.GetSolver();
+            const auto background = handle.CreateBackgroundHandle();
+            WarmUpInvoker(background,
+                          ctx.conv_problem,
+                          invoker,
+                          solver.IsEmpty() ? 0 : solver.GetWorkspaceSize(ctx));
+            background.Finish();
+        }
         return;
     }
 
@@ -2016,15 +2571,28 @@ void ConvolutionDescriptor::ConvolutionForwardImmediate(Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm);
 
     ConvForwardCheckNumerics(handle, tensors, [&]() {
-        auto ctx = ConvolutionContext{xDesc, wDesc, yDesc, *this, conv::Direction::Forward};
-        ctx.SetStream(&handle);
+        const auto make_ctx = [&]() {
+            auto ctx = ConvolutionContext{xDesc, wDesc, yDesc, *this, conv::Direction::Forward};
+            ctx.SetStream(&handle);
+            return ctx;
+        };
 
         if(CheckInvokerSupport(solver_id, conv::Direction::Forward))
         {
-            const auto invoker =
-                LoadOrPrepareInvoker(handle, ctx, solver_id, conv::Direction::Forward);
-            const auto invoke_ctx = conv::DataInvokeParams{tensors, workSpace, workSpaceSize};
-            invoker(handle, invoke_ctx);
+            const auto key =
+                conv::ProblemKey{xDesc, wDesc, yDesc, *this, conv::Direction::Forward};
+            auto config        = InternedString{};
+            const auto invoker = LoadOrPrepareInvoker(
+                handle, key, make_ctx, solver_id, conv::Direction::Forward, config);
+            const auto invoke_ctx =
+                conv::DataInvokeParams{CanonicalTensors(tensors, *this), workSpace, workSpaceSize};
+            const auto graph_key =
+                GetGraphKey(config, solver_id, workSpaceSize, {x, w, y, workSpace});
+            conv::RunSampled(handle,
+                             conv::Direction::Forward,
+                             xDesc.GetType(),
+                             [&]() { return solver_id; },
+                             [&]() { handle.RunInvoker(invoker, invoke_ctx, graph_key); });
             return;
         }
 
@@ -2035,6 +2603,7 @@ void ConvolutionDescriptor::ConvolutionForwardImmediate(Handle& handle,
             return;
         }
 
+        auto ctx                  = make_ctx();
         const auto network_config = ctx.BuildConfKey();
         const auto algo_name      = solver_id.GetAlgo(conv::Direction::Forward);
         const auto&& chk_kernels  = handle.GetKernels(algo_name, network_config);
@@ -2132,8 +2701,9 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
     if((fm.IsFast() || fm.IsHybrid()) && !use_winograd_only)
     {
         size_t count;
-        GetBackwardSolutions(handle, dyDesc, wDesc, dxDesc, 1, &count, &imm_sol);
-        use_immediate_solution = (count > 0) && !(fm.IsHybrid() && imm_sol.time < 0);
+        bool fallback;
+        GetBackwardSolutions(handle, dyDesc, wDesc, dxDesc, 1, &count, &imm_sol, &fallback);
+        use_immediate_solution = (count > 0) && !(fm.IsHybrid() && fallback);
     }
 
     if(use_immediate_solution)
@@ -2150,7 +2720,11 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
         perf_db = UserFindDbRecord::TryLoad(handle, problem, [&](DbRecord& record) {
             const auto network_config = problem.BuildConfKey();
             const auto invoke_ctx     = conv::DataInvokeParams{
-                {dyDesc, dy, wDesc, w, dxDesc, dx}, workSpace, workSpaceSize};
+                CanonicalTensors(ConvDataTensors{dyDesc, dy, wDesc, w, dxDesc, dx}, *this),
+                workSpace,
+                workSpaceSize};
+
+            std::vector<AlgorithmSolutions> algorithms;
 
             // Winograd algo
             {
@@ -2163,10 +2737,8 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
                 ctx.SetBufs(bufs);
                 ctx.SetStream(&handle);
                 ctx.DetectRocm();
-                const auto all            = FindWinogradSolutions(ctx, invoke_ctx);
-                const auto algorithm_name = AlgorithmName{"miopenConvolutionBwdDataAlgoWinograd"};
-                PrecompileSolutions(handle, all);
-                EvaluateInvokers(handle, all, algorithm_name, network_config, invoke_ctx, record);
+                algorithms.push_back({AlgorithmName{"miopenConvolutionBwdDataAlgoWinograd"},
+                                      FindWinogradSolutions(ctx, invoke_ctx)});
             }
 
             // Direct algo
@@ -2174,11 +2746,15 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
             {
                 ConvolutionUserBuffers bufs(workSpace, workSpaceSize);
                 bufs.SetBwd(dx, w, dy);
-                const auto all = FindDataDirectSolutions(
-                    handle, dxDesc, wDesc, dyDesc, exhaustiveSearch, false, bufs, invoke_ctx);
-                const auto algorithm_name = AlgorithmName{"miopenConvolutionBwdDataAlgoDirect"};
-                PrecompileSolutions(handle, all);
-                EvaluateInvokers(handle, all, algorithm_name, network_config, invoke_ctx, record);
+                algorithms.push_back({AlgorithmName{"miopenConvolutionBwdDataAlgoDirect"},
+                                      FindDataDirectSolutions(handle,
+                                                              dxDesc,
+                                                              wDesc,
+                                                              dyDesc,
+                                                              exhaustiveSearch,
+                                                              false,
+                                                              bufs,
+                                                              invoke_ctx)});
             }
 
             // Implicit GEMM algo
@@ -2186,14 +2762,20 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
             {
                 ConvolutionUserBuffers bufs(workSpace, workSpaceSize);
                 bufs.SetBwd(dx, w, dy);
-                const auto all = this->FindDataImplicitGemmSolutions(
-                    handle, dxDesc, wDesc, dyDesc, exhaustiveSearch, false, bufs, invoke_ctx);
-                PrecompileSolutions(handle, all);
-                const auto algorithm_name =
-                    AlgorithmName{"miopenConvolutionBwdDataAlgoImplicitGEMM"};
-                EvaluateInvokers(handle, all, algorithm_name, network_config, invoke_ctx, record);
+                algorithms.push_back({AlgorithmName{"miopenConvolutionBwdDataAlgoImplicitGEMM"},
+                                      this->FindDataImplicitGemmSolutions(handle,
+                                                                          dxDesc,
+                                                                          wDesc,
+                                                                          dyDesc,
+                                                                          exhaustiveSearch,
+                                                                          false,
+                                                                          bufs,
+                                                                          invoke_ctx)});
             }
 
+            EvaluateAlgorithms(
+                handle, algorithms, network_config, invoke_ctx, record, prefer_latency);
+
             if(GetSpatialDimension() == 2 && GetConvDilations()[0] == 1 &&
                GetConvDilations()[1] == 1 && group_count == 1 && !use_winograd_only)
             {
@@ -2231,7 +2813,8 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
 
 #if MIOPEN_USE_GEMM
             if(!use_winograd_only && !miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM{}) &&
-               !(IsAnyBufferBF16(dxDesc, dyDesc, wDesc) && !IsUseRocBlas))
+               !(IsAnyBufferBF16(dxDesc, dyDesc, wDesc) && !IsUseRocBlas) &&
+               !IsAnyBufferNonDefaultLayout(dxDesc, dyDesc, wDesc))
             { // GEMM based
                 ValidateGroupCount(dxDesc, wDesc, *this);
 
@@ -2523,15 +3106,35 @@ void ConvolutionDescriptor::ConvolutionBackwardData(Handle& handle,
         const auto algorithm_name = AlgorithmName{ConvolutionAlgoToDirectionalString(
             static_cast<miopenConvAlgorithm_t>(algo), conv::Direction::BackwardData)};
 
-        auto ctx = ConvolutionContext{dxDesc, wDesc, dyDesc, *this, conv::Direction::BackwardData};
-        ctx.SetStream(&handle);
-        const auto network_config = ctx.BuildConfKey();
-        const auto& invoker       = handle.GetInvoker(network_config, {}, algorithm_name);
+        const auto key =
+            conv::ProblemKey{dxDesc, wDesc, dyDesc, *this, conv::Direction::BackwardData};
+        const auto config = GetProblemConfig(handle, key, [&]() {
+            return ConvolutionContext{dxDesc, wDesc, dyDesc, *this, conv::Direction::BackwardData}
+                .BuildConfKey();
+        });
+        const auto& invoker = handle.GetInvoker(config, {}, algorithm_name);
 
         if(invoker)
         {
-            const auto& invoke_ctx = conv::DataInvokeParams{tensors, workSpace, workSpaceSize};
-            (*invoker)(handle, invoke_ctx);
+            const auto& invoke_ctx =
+                conv::DataInvokeParams{CanonicalTensors(tensors, *this), workSpace, workSpaceSize};
+            conv::RunSampled(handle,
+                             conv::Direction::BackwardData,
+                             dyDesc.GetType(),
+                             [&]() { return handle.GetFoundSolver(config, algorithm_name); },
+                             [&]() { (*invoker)(handle, invoke_ctx); });
+            SpecializeHotProblem(handle,
+                                 config,
+                                 algorithm_name,
+                                 static_cast<miopenConvAlgorithm_t>(algo),
+                                 invoke_ctx,
+                                 [&]() {
+                                     return ConvolutionContext{dxDesc,
+                                                               wDesc,
+                                                               dyDesc,
+                                                               *this,
+                                                               conv::Direction::BackwardData};
+                                 });
             return;
         }
 
@@ -2547,7 +3150,7 @@ void ConvolutionDescriptor::ConvolutionBackwardData(Handle& handle,
             break;
 
         case miopenConvolutionBwdDataAlgoFFT:
-            ConvBwdFFT(handle, tensors, workSpace, workSpaceSize, network_config);
+            ConvBwdFFT(handle, tensors, workSpace, workSpaceSize, NetworkConfig{config.ToString()});
             break;
 
         case miopenTransposeBwdDataAlgoGEMM: break;
@@ -2594,32 +3197,39 @@ void ConvolutionDescriptor::ConvBwdGemm(Handle& handle,
         }
 
         float t1 = 0;
-        // Initialization required for upsampling in bwd direction
-        float zero = 0.f;
-        SetTensor(handle, tensors.dxDesc, tensors.dx, &zero);
-        if(handle.IsProfilingEnabled())
-            t1 = handle.GetKernelTime();
 
         assert(workSpace != nullptr &&
                workSpaceSize >=
                    BackwardDataGetWorkSpaceSizeGEMMTranspose(tensors.dyDesc, tensors.dxDesc));
 
-        transpose_NCHW2CNHW(handle,
-                            in_n,
-                            wei_k,
-                            out_spatial[0],
-                            out_spatial[1],
-                            out_spatial[0],
-                            out_spatial[1],
-                            tensors.dy,
-                            workSpace,
-                            0,
-                            0,
-                            1,
-                            1,
-                            tensors.dyDesc.GetType());
-        if(handle.IsProfilingEnabled())
-            t1 += handle.GetKernelTime();
+        // Zeroing of dx does not depend on the transpose into the workspace, so they may overlap.
+        handle.RunConcurrently(2, [&](std::size_t i) {
+            if(i == 0)
+            {
+                // Initialization required for upsampling in bwd direction
+                float zero = 0.f;
+                SetTensor(handle, tensors.dxDesc, tensors.dx, &zero);
+            }
+            else
+            {
+                transpose_NCHW2CNHW(handle,
+                                    in_n,
+                                    wei_k,
+                                    out_spatial[0],
+                                    out_spatial[1],
+                                    out_spatial[0],
+                                    out_spatial[1],
+                                    tensors.dy,
+                                    workSpace,
+                                    0,
+                                    0,
+                                    1,
+                                    1,
+                                    tensors.dyDesc.GetType());
+            }
+            if(handle.IsProfilingEnabled())
+                t1 += handle.GetKernelTime();
+        });
 
         if(group_count > 1)
         {
@@ -2694,8 +3304,8 @@ void ConvolutionDescriptor::ConvBwdGemm(Handle& handle,
                 tensors.wDesc, tensors.dyDesc, tensors.dxDesc, group_count);
 
             float time_0 = 0;
-            for(std::size_t i = 0; i < in_n; i++)
-            {
+            // Images are independent, so their GEMMs may run on several streams.
+            handle.RunConcurrently(in_n, [&](std::size_t i) {
                 std::size_t out_spatial_size = std::accumulate(out_spatial.begin(),
                                                                out_spatial.end(),
                                                                std::size_t(1),
@@ -2727,7 +3337,7 @@ void ConvolutionDescriptor::ConvBwdGemm(Handle& handle,
                         handle.AccumKernelTime(time_0);
                     time_0 += handle.GetKernelTime();
                 }
-            }
+            });
         }
         else
         {
@@ -2773,63 +3383,144 @@ void ConvolutionDescriptor::ConvBwdGemm(Handle& handle,
         std::size_t in_spatial_size = std::accumulate(
             in_spatial.begin(), in_spatial.end(), std::size_t(1), std::multiplies<std::size_t>());
 
-        float time_0 = 0;
-        float t1     = 0;
-        for(std::size_t i = 0; i < in_n; i++)
+        std::size_t wei_spatial_size = std::accumulate(
+            wei_spatial.begin(), wei_spatial.end(), std::size_t(1), std::multiplies<std::size_t>());
+
+        // The columns of a chunk of images are kept in each of two halves of the workspace, so the
+        // GEMM of the next chunk may overlap the col2im of the current one on separate streams.
+        const std::size_t col_size   = in_c * wei_spatial_size * out_spatial_size;
+        const std::size_t col_bytes  = col_size * GetTypeSize(tensors.dyDesc.GetType());
+        const std::size_t chunk_size = std::min(in_n, workSpaceSize / (2 * col_bytes));
+
+        if(group_count == 1 && in_n > 1 && chunk_size > 0 &&
+           !miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM_CHUNKED{}))
         {
-            std::size_t out_offset = i * wei_k * out_spatial_size;
-            std::size_t in_offset  = i * in_c * in_spatial_size;
+            MIOPEN_LOG_I2("col2im chunk of " << chunk_size << " images");
 
-            // tensors.dx = transpose(tensors.w) * tensors.dy
-            if(group_count > 1)
-                CallGemmStridedBatched(handle,
-                                       gemm_desc,
-                                       tensors.w,
-                                       0,
-                                       tensors.dy,
-                                       out_offset,
-                                       workSpace,
-                                       0,
-                                       nullptr,
-                                       false);
-            else
-                CallGemm(handle,
-                         gemm_desc,
-                         tensors.w,
-                         0,
-                         tensors.dy,
-                         out_offset,
-                         workSpace,
-                         0,
-                         nullptr,
-                         false,
-                         GemmBackend_t::miopengemm);
+            GemmDescriptor chunk_desc = gemm_desc;
+            chunk_desc.strideA        = 0;
+            chunk_desc.strideB        = wei_k * out_spatial_size;
+            chunk_desc.strideC        = col_size;
 
-            if(handle.IsProfilingEnabled())
-                t1 = handle.GetKernelTime();
+            const std::size_t chunk_count = (in_n + chunk_size - 1) / chunk_size;
 
-            Col2ImGPU(handle,
-                      GetSpatialDimension(),
-                      workSpace,
-                      out_spatial,
-                      wei_spatial,
-                      GetConvPads(),
-                      GetConvStrides(),
-                      GetConvDilations(),
-                      in_c,
-                      in_spatial,
-                      tensors.dx,
-                      in_offset,
-                      tensors.dyDesc.GetType());
+            float time_0 = 0;
+            for(std::size_t wave = 0; wave < chunk_count; wave += 2)
+            {
+                const auto slots = std::min<std::size_t>(2, chunk_count - wave);
+
+                handle.RunConcurrently(slots, [&](std::size_t slot) {
+                    const std::size_t first      = (wave + slot) * chunk_size;
+                    const std::size_t images     = std::min(chunk_size, in_n - first);
+                    const std::size_t col_offset = slot * chunk_size * col_size;
+
+                    GemmDescriptor desc = chunk_desc;
+                    desc.batch_count    = images;
+
+                    // tensors.dx = transpose(tensors.w) * tensors.dy for each image of the chunk
+                    CallGemmStridedBatched(handle,
+                                           desc,
+                                           tensors.w,
+                                           0,
+                                           tensors.dy,
+                                           first * wei_k * out_spatial_size,
+                                           workSpace,
+                                           col_offset,
+                                           nullptr,
+                                           false);
+
+                    if(handle.IsProfilingEnabled())
+                        time_0 += handle.GetKernelTime();
+
+                    for(std::size_t j = 0; j < images; j++)
+                    {
+                        Col2ImGPU(handle,
+                                  GetSpatialDimension(),
+                                  workSpace,
+                                  out_spatial,
+                                  wei_spatial,
+                                  GetConvPads(),
+                                  GetConvStrides(),
+                                  GetConvDilations(),
+                                  in_c,
+                                  in_spatial,
+                                  tensors.dx,
+                                  (first + j) * in_c * in_spatial_size,
+                                  tensors.dyDesc.GetType(),
+                                  col_offset + j * col_size);
+
+                        if(handle.IsProfilingEnabled())
+                            time_0 += handle.GetKernelTime();
+                    }
+                });
+            }
 
-            // Update times for both the kernels
             if(handle.IsProfilingEnabled())
             {
-                if(i == in_n - 1)
-                    handle.AccumKernelTime(t1 + time_0);
+                handle.ResetKernelTime();
+                handle.AccumKernelTime(time_0);
+            }
+        }
+        else
+        {
+            float time_0 = 0;
+            float t1     = 0;
+            for(std::size_t i = 0; i < in_n; i++)
+            {
+                std::size_t out_offset = i * wei_k * out_spatial_size;
+                std::size_t in_offset  = i * in_c * in_spatial_size;
+
+                // tensors.dx = transpose(tensors.w) * tensors.dy
+                if(group_count > 1)
+                    CallGemmStridedBatched(handle,
+                                           gemm_desc,
+                                           tensors.w,
+                                           0,
+                                           tensors.dy,
+                                           out_offset,
+                                           workSpace,
+                                           0,
+                                           nullptr,
+                                           false);
                 else
-                    handle.AccumKernelTime(t1);
-                time_0 += handle.GetKernelTime();
+                    CallGemm(handle,
+                             gemm_desc,
+                             tensors.w,
+                             0,
+                             tensors.dy,
+                             out_offset,
+                             workSpace,
+                             0,
+                             nullptr,
+                             false,
+                             GemmBackend_t::miopengemm);
+
+                if(handle.IsProfilingEnabled())
+                    t1 = handle.GetKernelTime();
+
+                Col2ImGPU(handle,
+                          GetSpatialDimension(),
+                          workSpace,
+                          out_spatial,
+                          wei_spatial,
+                          GetConvPads(),
+                          GetConvStrides(),
+                          GetConvDilations(),
+                          in_c,
+                          in_spatial,
+                          tensors.dx,
+                          in_offset,
+                          tensors.dyDesc.GetType());
+
+                // Update times for both the kernels
+                if(handle.IsProfilingEnabled())
+                {
+                    if(i == in_n - 1)
+                        handle.AccumKernelTime(t1 + time_0);
+                    else
+                        handle.AccumKernelTime(t1);
+                    time_0 += handle.GetKernelTime();
+                }
             }
         }
     }
@@ -2889,7 +3580,7 @@ std::size_t ConvolutionDescriptor::GetBackwardSolutionCount(Handle& handle,
     const auto count = GetSolutionCount(handle, problem);
     if(count > 0)
         return count;
-    return GetBwdSolutionCountFallback(dyDesc, wDesc, dxDesc);
+    return GetBwdSolutionCountFallback(handle, dyDesc, wDesc, dxDesc);
 }
 
 void ConvolutionDescriptor::GetBackwardSolutions(Handle& handle,
@@ -2898,7 +3589,8 @@ void ConvolutionDescriptor::GetBackwardSolutions(Handle& handle,
                                                  const TensorDescriptor& dxDesc,
                                                  size_t maxSolutionCount,
                                                  size_t* solutionCount,
-                                                 miopenConvSolution_t* solutions) const
+                                                 miopenConvSolution_t* solutions,
+                                                 bool* fallback) const
 {
     MIOPEN_LOG_I("");
     if(solutionCount == nullptr)
@@ -2915,9 +3607,15 @@ void ConvolutionDescriptor::GetBackwardSolutions(Handle& handle,
                  solutions,
                  StringToConvolutionBwdDataAlgo);
 
+    if(fallback != nullptr)
+        *fallback = *solutionCount == 0;
     if(*solutionCount == 0)
+    {
         GetBwdSolutionsFallback(
             handle, dyDesc, wDesc, dxDesc, maxSolutionCount, solutionCount, solutions);
+        if(*solutionCount > 0)
+            conv::RecordFindMiss(problem.conv_problem, solutions[0]);
+    }
 }
 
 void ConvolutionDescriptor::CompileBackwardSolution(Handle& handle,
@@ -2955,7 +3653,7 @@ std::size_t ConvolutionDescriptor::GetBackwardSolutionWorkspaceSize(Handle& hand
         auto ctx = ConvolutionContext{dxDesc, wDesc, dyDesc, *this, conv::Direction::BackwardData};
         ctx.SetStream(&handle);
         ctx.DetectRocm();
-        if(sol.IsApplicable(ctx))
+        if(solver::applicability::Memo{ctx}.IsApplicable(sol, ctx))
             return sol.GetWorkspaceSize(ctx);
         else
         {
@@ -2996,14 +3694,26 @@ void ConvolutionDescriptor::ConvolutionBackwardImmediate(Handle& handle,
         }
         ValidateGroupCount(dxDesc, wDesc, *this);
 
-        auto ctx = ConvolutionContext{dxDesc, wDesc, dyDesc, *this, conv::Direction::BackwardData};
+        const auto make_ctx = [&]() {
+            return ConvolutionContext{dxDesc, wDesc, dyDesc, *this, conv::Direction::BackwardData};
+        };
 
         if(CheckInvokerSupport(solver_id, conv::Direction::BackwardData))
         {
-            const auto invoker =
-                LoadOrPrepareInvoker(handle, ctx, solver_id, conv::Direction::BackwardData);
-            const auto invoke_ctx = conv::DataInvokeParams{tensors, workSpace, workSpaceSize};
-            invoker(handle, invoke_ctx);
+            const auto key =
+                conv::ProblemKey{dxDesc, wDesc, dyDesc, *this, conv::Direction::BackwardData};
+            auto config        = InternedString{};
+            const auto invoker = LoadOrPrepareInvoker(
+                handle, key, make_ctx, solver_id, conv::Direction::BackwardData, config);
+            const auto invoke_ctx =
+                conv::DataInvokeParams{CanonicalTensors(tensors, *this), workSpace, workSpaceSize};
+            const auto graph_key =
+                GetGraphKey(config, solver_id, workSpaceSize, {dy, w, dx, workSpace});
+            conv::RunSampled(handle,
+                             conv::Direction::BackwardData,
+                             dyDesc.GetType(),
+                             [&]() { return solver_id; },
+                             [&]() { handle.RunInvoker(invoker, invoke_ctx, graph_key); });
             return;
         }
 
@@ -3013,6 +3723,7 @@ void ConvolutionDescriptor::ConvolutionBackwardImmediate(Handle& handle,
             return;
         }
 
+        auto ctx = make_ctx();
         ctx.SetStream(&handle);
         const auto network_config = ctx.BuildConfKey();
         const auto algo_name      = solver_id.GetAlgo(conv::Direction::BackwardData);
@@ -3093,8 +3804,7 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
 
     AutoEnableProfiling enableProfiling{handle};
 
-    auto problem =
-        ProblemDescription{xDesc, dwDesc, dyDesc, *this, conv::Direction::BackwardWeights};
+    auto problem = MakeWrwProblem(handle, dyDesc, xDesc, dwDesc);
 
     std::vector<PerfField> perf_db;
     const miopen::FindMode fm(problem);
@@ -3103,8 +3813,9 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
     if(fm.IsFast() || fm.IsHybrid())
     {
         size_t count;
-        GetWrwSolutions(handle, dyDesc, xDesc, dwDesc, 1, &count, &imm_sol);
-        use_immediate_solution = (count > 0) && !(fm.IsHybrid() && imm_sol.time < 0);
+        bool fallback;
+        GetWrwSolutions(handle, dyDesc, xDesc, dwDesc, 1, &count, &imm_sol, &fallback);
+        use_immediate_solution = (count > 0) && !(fm.IsHybrid() && fallback);
     }
 
     if(use_immediate_solution)
@@ -3121,7 +3832,8 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
         perf_db = UserFindDbRecord::TryLoad(handle, problem, [&](DbRecord& record) {
 #if MIOPEN_USE_GEMM
             if(!miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM{}) &&
-               !(IsAnyBufferBF16(xDesc, dyDesc, dwDesc) && !IsUseRocBlas))
+               !(IsAnyBufferBF16(xDesc, dyDesc, dwDesc) && !IsUseRocBlas) &&
+               !IsAnyBufferNonDefaultLayout(xDesc, dyDesc, dwDesc))
             {
                 const bool time_precision = (!IsDisabled(MIOPEN_CONV_PRECISE_ROCBLAS_TIMING{}));
 
@@ -3252,8 +3964,7 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
 #endif
             ConvolutionUserBuffers bufs(workSpace, workSpaceSize);
             bufs.SetWrW(x, dw, dy);
-            auto ctx =
-                ConvolutionContext{xDesc, dwDesc, dyDesc, *this, conv::Direction::BackwardWeights};
+            auto ctx = ConvolutionContext{MakeWrwProblem(handle, dyDesc, xDesc, dwDesc)};
             ctx.skip_solutions_that_take_long_time_to_build_and_have_narrow_coverage =
                 miopen::FindMode(ctx).IsFastHybrid();
             ctx.use_dynamic_solutions_only = miopen::FindMode(ctx).IsDynamicHybrid();
@@ -3263,24 +3974,24 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
             ctx.SetupFloats();
             ctx.DetectRocm();
             const auto network_config = ctx.BuildConfKey();
-            const auto invoke_ctx =
-                conv::WrWInvokeParams{{dyDesc, dy, xDesc, x, dwDesc, dw}, workSpace, workSpaceSize};
+            const auto invoke_ctx = conv::WrWInvokeParams{
+                CanonicalTensors(ConvWrwTensors{dyDesc, dy, xDesc, x, dwDesc, dw}, *this),
+                workSpace,
+                workSpaceSize};
+            std::vector<AlgorithmSolutions> algorithms;
+
             // direct convolution
             if(!miopen::IsDisabled(MIOPEN_DEBUG_CONV_DIRECT{}))
-            {
-                const auto all            = FindAllBwdWrW2DSolutions(ctx, invoke_ctx);
-                const auto algorithm_name = AlgorithmName{"miopenConvolutionBwdWeightsAlgoDirect"};
-                EvaluateInvokers(handle, all, algorithm_name, network_config, invoke_ctx, record);
-            }
+                algorithms.push_back({AlgorithmName{"miopenConvolutionBwdWeightsAlgoDirect"},
+                                      FindAllBwdWrW2DSolutions(ctx, invoke_ctx)});
 
             try
             {
-                const auto all = miopen::IsDisabled(MIOPEN_DEBUG_CONV_WINOGRAD{})
-                                     ? std::vector<miopen::solver::ConvSolution>()
-                                     : FindWinogradWrWAllSolutions(ctx, invoke_ctx);
-                const auto algorithm_name =
-                    AlgorithmName{"miopenConvolutionBwdWeightsAlgoWinograd"};
-                EvaluateInvokers(handle, all, algorithm_name, network_config, invoke_ctx, record);
+                if(!miopen::IsDisabled(MIOPEN_DEBUG_CONV_WINOGRAD{}))
+                    algorithms.push_back(
+                        {AlgorithmName{"miopenConvolutionBwdWeightsAlgoWinograd"},
+                         FindWinogradWrWAllSolutions(ctx, invoke_ctx),
+                         true});
             }
             catch(const miopen::Exception& ex)
             {
@@ -3289,12 +4000,11 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
 
             // Implicit GEMM
             if(!miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM{}))
-            {
-                const auto all = FindImplicitGemmWrWAllSolutions(ctx, invoke_ctx);
-                const auto algorithm_name =
-                    AlgorithmName{"miopenConvolutionBwdWeightsAlgoImplicitGEMM"};
-                EvaluateInvokers(handle, all, algorithm_name, network_config, invoke_ctx, record);
-            }
+                algorithms.push_back({AlgorithmName{"miopenConvolutionBwdWeightsAlgoImplicitGEMM"},
+                                      FindImplicitGemmWrWAllSolutions(ctx, invoke_ctx)});
+
+            EvaluateAlgorithms(
+                handle, algorithms, network_config, invoke_ctx, record, prefer_latency);
         });
     }
 
@@ -3374,15 +4084,32 @@ void ConvolutionDescriptor::ConvolutionBackwardWeights(Handle& handle,
         decltype(auto) direction      = conv::Direction::BackwardWeights;
         decltype(auto) algorithm_name = AlgorithmName{ConvolutionAlgoToDirectionalString(
             static_cast<miopenConvAlgorithm_t>(algo), direction)};
-        decltype(auto) ctx = conv::ProblemDescription{dyDesc, dwDesc, xDesc, *this, direction};
-        decltype(auto) network_config = ctx.BuildConfKey();
-        decltype(auto) invoker = handle.GetInvoker(network_config, boost::none, algorithm_name);
+        decltype(auto) key            = conv::ProblemKey{
+            xDesc, dwDesc, dyDesc, *this, direction, handle.IsDeterministicModeEnabled()};
+        decltype(auto) config = GetProblemConfig(handle, key, [&]() {
+            return MakeWrwProblem(handle, dyDesc, xDesc, dwDesc).BuildConfKey();
+        });
+        decltype(auto) invoker = handle.GetInvoker(config, boost::none, algorithm_name);
 
         if(!invoker)
             MIOPEN_THROW("No invoker was registered for convolution weights. Was find executed?");
 
-        const auto invoke_ctx = conv::WrWInvokeParams{tensors, workSpace, workSpaceSize};
-        (*invoker)(handle, invoke_ctx);
+        const auto invoke_ctx =
+            conv::WrWInvokeParams{CanonicalTensors(tensors, *this), workSpace, workSpaceSize};
+        conv::RunSampled(handle,
+                         direction,
+                         xDesc.GetType(),
+                         [&]() { return handle.GetFoundSolver(config, algorithm_name); },
+                         [&]() { (*invoker)(handle, invoke_ctx); });
+        SpecializeHotProblem(handle,
+                             config,
+                             algorithm_name,
+                             static_cast<miopenConvAlgorithm_t>(algo),
+                             invoke_ctx,
+                             [&]() {
+                                 return ConvolutionContext{
+                                     MakeWrwProblem(handle, dyDesc, xDesc, dwDesc)};
+                             });
     });
 }
 
@@ -3591,12 +4318,233 @@ void ConvolutionDescriptor::BackwardWeightsGemm(Handle& handle,
     MIOPEN_THROW("GEMM is not supported");
 #endif
 }
-ProblemDescription ConvolutionDescriptor::MakeWrwProblem(const TensorDescriptor& dyDesc,
+
+void ConvolutionDescriptor::ConvolutionBackwardWeightsBias(Handle& handle,
+                                                           const void* alpha,
+                                                           const TensorDescriptor& dyDesc,
+                                                           ConstData_t dy,
+                                                           const TensorDescriptor& xDesc,
+                                                           ConstData_t x,
+                                                           miopenConvBwdWeightsAlgorithm_t algo,
+                                                           const void* beta,
+                                                           const TensorDescriptor& dwDesc,
+                                                           Data_t dw,
+                                                           const TensorDescriptor& dbDesc,
+                                                           Data_t db,
+                                                           Data_t workSpace,
+                                                           size_t workSpaceSize) const
+{
+    MIOPEN_LOG_I("algo = " << algo << ", workspace = " << workSpaceSize);
+
+    const auto fused_workspace = algo == miopenConvolutionBwdWeightsAlgoGEMM
+                                     ? BackwardWeightsBiasGetWorkSpaceSizeGEMM(dyDesc, dwDesc)
+                                     : 0;
+
+    if(fused_workspace == 0 || workSpace == nullptr || workSpaceSize < fused_workspace)
+    {
+        MIOPEN_LOG_I2("Weights and bias gradients are computed separately");
+        ConvolutionBackwardWeights(handle,
+                                   alpha,
+                                   dyDesc,
+                                   dy,
+                                   xDesc,
+                                   x,
+                                   algo,
+                                   beta,
+                                   dwDesc,
+                                   dw,
+                                   workSpace,
+                                   workSpaceSize);
+        // The caller swaps dy and x of transposed convolutions.
+        if(mode == miopenTranspose)
+            ConvolutionBackwardBias(handle, alpha, xDesc, x, beta, dbDesc, db);
+        else
+            ConvolutionBackwardBias(handle, alpha, dyDesc, dy, beta, dbDesc, db);
+        return;
+    }
+
+    decltype(auto) tensors = ConvWrwTensors{dyDesc, dy, xDesc, x, dwDesc, dw};
+    ValidateConvTensors(tensors);
+    ValidateAlphaBeta(alpha, beta);
+
+    if(xDesc.GetType() == miopenInt8)
+        MIOPEN_THROW(miopenStatusBadParm);
+
+    if(db == nullptr || dbDesc.GetType() != dyDesc.GetType() ||
+       dbDesc.GetLengths().size() < 2 || dbDesc.GetLengths()[1] != dyDesc.GetLengths()[1] ||
+       dbDesc.GetElementSize() != dbDesc.GetLengths()[1])
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+
+    ConvWrwCheckNumerics(handle, tensors, beta, [&]() {
+        ValidateGroupCount(xDesc, dwDesc, *this);
+        BackwardWeightsBiasGemm(handle, tensors, dbDesc, db, workSpace, workSpaceSize);
+    });
+
+    if(miopen::CheckNumericsEnabled())
+        miopen::checkNumericsOutput(handle, dbDesc, db);
+}
+
+void ConvolutionDescriptor::BackwardWeightsBiasGemm(Handle& handle,
+                                                    const ConvWrwTensors& tensors,
+                                                    const TensorDescriptor& dbDesc,
+                                                    Data_t db,
+                                                    Data_t workSpace,
+                                                    std::size_t workSpaceSize) const
+{
+#if MIOPEN_USE_GEMM
+    MIOPEN_LOG_FUNCTION("convolution, non 1x1, bias");
+    assert(workSpace != nullptr &&
+           workSpaceSize >=
+               BackwardWeightsBiasGetWorkSpaceSizeGEMM(tensors.dyDesc, tensors.dwDesc));
+
+    std::size_t in_n, in_c;
+    std::tie(in_n, in_c) = tie_pick<0, 1>()(tensors.xDesc.GetLengths());
+
+    std::size_t wei_k = tensors.dwDesc.GetLengths()[0];
+
+    auto in_spatial =
+        boost::adaptors::slice(tensors.xDesc.GetLengths(), 2, 2 + GetSpatialDimension());
+    auto wei_spatial =
+        boost::adaptors::slice(tensors.dwDesc.GetLengths(), 2, 2 + GetSpatialDimension());
+    auto out_spatial =
+        boost::adaptors::slice(tensors.dyDesc.GetLengths(), 2, 2 + GetSpatialDimension());
+
+    std::size_t out_spatial_size = std::accumulate(
+        out_spatial.begin(), out_spatial.end(), std::size_t(1), std::multiplies<std::size_t>());
+
+    std::size_t in_spatial_size = std::accumulate(
+        in_spatial.begin(), in_spatial.end(), std::size_t(1), std::multiplies<std::size_t>());
+
+    std::size_t wei_spatial_size = std::accumulate(
+        wei_spatial.begin(), wei_spatial.end(), std::size_t(1), std::multiplies<std::size_t>());
+
+    // The workspace holds im2col(x) with a row of ones appended, followed by the GEMM result
+    // [dw | db]: multiplying dy by the ones row sums every output channel over its pixels.
+    const auto type            = tensors.dyDesc.GetType();
+    const std::size_t gemm_n   = in_c * wei_spatial_size + 1;
+    const std::size_t col_size = gemm_n * out_spatial_size;
+
+    handle.ResetKernelTime();
+    float time_0     = 0;
+    const auto accum = [&]() {
+        if(handle.IsProfilingEnabled())
+            time_0 += handle.GetKernelTime();
+    };
+
+    float one  = 1.0f;
+    float zero = 0.0f;
+    SetTensor(handle,
+              TensorDescriptor{type, {out_spatial_size}},
+              workSpace,
+              &one,
+              static_cast<int>(col_size - out_spatial_size));
+    accum();
+    SetTensor(handle,
+              TensorDescriptor{type, {wei_k * gemm_n}},
+              workSpace,
+              &zero,
+              static_cast<int>(col_size));
+    accum();
+
+    // [dw | db] = dy * transpose([Im2Col(x); 1])
+    GemmDescriptor gemm_desc =
+        CreateGemmDescriptorConvBwdWeight(tensors.dyDesc, tensors.xDesc, tensors.dwDesc);
+    gemm_desc.n   = static_cast<int>(gemm_n);
+    gemm_desc.ldc = static_cast<int>(gemm_n);
+
+    for(std::size_t i = 0; i < in_n; i++)
+    {
+        std::size_t out_offset = i * wei_k * out_spatial_size;
+
+        std::size_t in_offset = i * in_c * in_spatial_size;
+
+        Im2ColGPU(handle,
+                  GetSpatialDimension(),
+                  tensors.x,
+                  in_offset,
+                  in_c,
+                  in_spatial,
+                  wei_spatial,
+                  out_spatial,
+                  GetConvPads(),
+                  GetConvStrides(),
+                  GetConvDilations(),
+                  workSpace,
+                  type);
+        accum();
+
+        CallGemm(handle,
+                 gemm_desc,
+                 tensors.dy,
+                 out_offset,
+                 workSpace,
+                 0,
+                 workSpace,
+                 col_size,
+                 nullptr,
+                 false,
+                 GemmBackend_t::miopengemm);
+        accum();
+    }
+
+    // dw and db are strided views of the GEMM result.
+    const auto& dw_lens = tensors.dwDesc.GetLengths();
+    std::vector<std::size_t> dw_strides(dw_lens.size(), 1);
+    for(std::size_t d = dw_lens.size() - 1; d > 1; --d)
+        dw_strides[d - 1] = dw_strides[d] * dw_lens[d];
+    dw_strides[0] = gemm_n;
+
+    std::vector<std::size_t> db_strides(dbDesc.GetLengths().size(), 1);
+    db_strides[0] = wei_k * gemm_n;
+    db_strides[1] = gemm_n;
+
+    CopyTensor(handle,
+               TensorDescriptor{type, dw_lens, dw_strides},
+               workSpace,
+               tensors.dwDesc,
+               tensors.dw,
+               static_cast<int>(col_size),
+               0);
+    accum();
+    CopyTensor(handle,
+               TensorDescriptor{type, dbDesc.GetLengths(), db_strides},
+               workSpace,
+               dbDesc,
+               db,
+               static_cast<int>(col_size + gemm_n - 1),
+               0);
+    accum();
+
+    if(handle.IsProfilingEnabled())
+    {
+        handle.ResetKernelTime();
+        handle.AccumKernelTime(time_0);
+    }
+
+#ifdef NDEBUG
+    std::ignore = workSpaceSize;
+#endif
+#else
+    std::ignore = handle;
+    std::ignore = tensors;
+    std::ignore = dbDesc;
+    std::ignore = db;
+    std::ignore = workSpace;
+    std::ignore = workSpaceSize;
+    MIOPEN_THROW("GEMM is not supported");
+#endif
+}
+
+ProblemDescription ConvolutionDescriptor::MakeWrwProblem(const Handle& handle,
+                                                         const TensorDescriptor& dyDesc,
                                                          const TensorDescriptor& xDesc,
                                                          const TensorDescriptor& dwDesc) const
 {
     auto problem =
         ProblemDescription{xDesc, dwDesc, dyDesc, *this, conv::Direction::BackwardWeights};
+    problem.conv_problem.SetDeterministic(handle.IsDeterministicModeEnabled());
     return problem;
 }
 
@@ -3606,11 +4554,11 @@ std::size_t ConvolutionDescriptor::GetWrwSolutionCount(Handle& handle,
                                                        const TensorDescriptor& dwDesc) const
 {
     MIOPEN_LOG_I("");
-    const auto problem = MakeWrwProblem(dyDesc, xDesc, dwDesc);
+    const auto problem = MakeWrwProblem(handle, dyDesc, xDesc, dwDesc);
     const auto count   = GetSolutionCount(handle, problem);
     if(count > 0)
         return count;
-    return GetWrwSolutionCountFallback(dyDesc, xDesc, dwDesc);
+    return GetWrwSolutionCountFallback(handle, dyDesc, xDesc, dwDesc);
 }
 
 void ConvolutionDescriptor::GetWrwSolutions(Handle& handle,
@@ -3619,7 +4567,8 @@ void ConvolutionDescriptor::GetWrwSolutions(Handle& handle,
                                             const TensorDescriptor& dwDesc,
                                             size_t maxSolutionCount,
                                             size_t* solutionCount,
-                                            miopenConvSolution_t* solutions) const
+                                            miopenConvSolution_t* solutions,
+                                            bool* fallback) const
 {
     MIOPEN_LOG_I("");
     if(solutionCount == nullptr)
@@ -3627,7 +4576,7 @@ void ConvolutionDescriptor::GetWrwSolutions(Handle& handle,
     if(solutions == nullptr)
         MIOPEN_THROW(miopenStatusBadParm, "solutions cannot be nullptr");
 
-    const auto problem = MakeWrwProblem(dyDesc, xDesc, dwDesc);
+    const auto problem = MakeWrwProblem(handle, dyDesc, xDesc, dwDesc);
     GetSolutions(handle,
                  problem,
                  maxSolutionCount,
@@ -3635,9 +4584,15 @@ void ConvolutionDescriptor::GetWrwSolutions(Handle& handle,
                  solutions,
                  StringToConvolutionBwdWeightsAlgo);
 
+    if(fallback != nullptr)
+        *fallback = *solutionCount == 0;
     if(*solutionCount == 0)
+    {
         GetWrwSolutionsFallback(
             handle, dyDesc, xDesc, dwDesc, maxSolutionCount, solutionCount, solutions);
+        if(*solutionCount > 0)
+            conv::RecordFindMiss(problem.conv_problem, solutions[0]);
+    }
 }
 
 void ConvolutionDescriptor::CompileWrwSolution(Handle& handle,
@@ -3647,7 +4602,7 @@ void ConvolutionDescriptor::CompileWrwSolution(Handle& handle,
                                                solver::Id solver_id) const
 {
     MIOPEN_LOG_I("solver_id = " << solver_id.ToString());
-    auto ctx = ConvolutionContext{xDesc, dwDesc, dyDesc, *this, conv::Direction::BackwardWeights};
+    auto ctx = ConvolutionContext{MakeWrwProblem(handle, dyDesc, xDesc, dwDesc)};
     ctx.SetStream(&handle);
     ctx.disable_search_enforce = true;
 
@@ -3656,6 +4611,121 @@ void ConvolutionDescriptor::CompileWrwSolution(Handle& handle,
     });
 }
 
+static std::function<int(const std::string&)> GetAlgoResolver(conv::Direction dir)
+{
+    switch(dir)
+    {
+    case conv::Direction::Forward: return StringToConvolutionFwdAlgo;
+    case conv::Direction::BackwardData: return StringToConvolutionBwdDataAlgo;
+    case conv::Direction::BackwardWeights: return StringToConvolutionBwdWeightsAlgo;
+    }
+    MIOPEN_THROW(miopenStatusInternalError);
+}
+
+static void CompileLegacySolution(Handle& handle,
+                                  const ProblemDescription& problem,
+                                  const solver::Id solver_id)
+{
+    const auto& p    = problem.conv_problem;
+    const auto& conv = p.GetConv();
+    switch(p.GetDirection())
+    {
+    case conv::Direction::Forward:
+        conv.CompileForwardSolution(handle, p.GetWeights(), p.GetIn(), p.GetOut(), solver_id);
+        break;
+    case conv::Direction::BackwardData:
+        conv.CompileBackwardSolution(handle, p.GetIn(), p.GetWeights(), p.GetOut(), solver_id);
+        break;
+    case conv::Direction::BackwardWeights:
+        conv.CompileWrwSolution(handle, p.GetIn(), p.GetOut(), p.GetWeights(), solver_id);
+        break;
+    }
+}
+
+void PrewarmConvolutions(Handle& handle, const std::vector<ProblemDescription>& problems)
+{
+    MIOPEN_LOG_I("problems = " << problems.size());
+
+    struct PendingInvoker
+    {
+        NetworkConfig config;
+        solver::Id solver_id;
+        conv::Direction dir;
+        const ProblemDescription* problem;
+    };
+
+    // Resolving solutions is cheap compared to building kernels, so it is done serially and only
+    // the compilation of everything collected below is spread across threads.
+    std::vector<solver::ConvSolution> solutions;
+    std::vector<PendingInvoker> pending;
+    std::vector<std::pair<const ProblemDescription*, solver::Id>> legacy;
+
+    for(const auto& problem : problems)
+    {
+        const auto dir = problem.conv_problem.GetDirection();
+
+        auto count    = std::size_t{0};
+        auto solution = miopenConvSolution_t{};
+        GetSolutions(handle, problem, 1, &count, &solution, GetAlgoResolver(dir));
+        if(count == 0)
+        {
+            MIOPEN_LOG_I("No find-db record, skipped: " << problem);
+            continue;
+        }
+
+        const auto solver_id = solver::Id{solution.solution_id};
+        if(!CheckInvokerSupport(solver_id, dir))
+        {
+            legacy.emplace_back(&problem, solver_id);
+            continue;
+        }
+
+        auto ctx = ConvolutionContext{problem};
+        ctx.SetStream(&handle);
+        ctx.disable_search_enforce = true;
+        const auto config = ctx.BuildConfKey();
+        if(handle.GetInvoker(config, solver_id))
+            continue;
+
+        ctx.DetectRocm();
+        ctx.SetupFloats();
+        auto db  = GetDb(ctx);
+        auto sol = solver_id.GetSolver().FindSolution(ctx, db, {});
+        if(!sol.Succeeded() || !sol.invoker_factory)
+        {
+            MIOPEN_LOG_I("No invoker from " << solver_id.ToString() << ", skipped: " << problem);
+            continue;
+        }
+        solutions.push_back(std::move(sol));
+        pending.push_back({config, solver_id, dir, &problem});
+    }
+
+    PrecompileSolutions(handle, solutions);
+
+    // One background handle runs the warm-up of all the invokers.
+    const auto warm_up = miopen::IsEnabled(MIOPEN_CONV_WARM_UP{}) && !solutions.empty();
+    const auto background =
+        warm_up ? std::make_unique<Handle>(handle.CreateBackgroundHandle()) : nullptr;
+
+    // All the programs are in the cache now, so preparing invokers does not compile anything.
+    for(std::size_t i = 0; i < solutions.size(); ++i)
+    {
+        const auto& solution = solutions[i];
+        const auto& p        = pending[i];
+        const auto invoker =
+            handle.PrepareInvoker(*solution.invoker_factory, solution.construction_params);
+        handle.RegisterInvoker(
+            invoker, p.config, p.solver_id, AlgorithmName(p.solver_id.GetAlgo(p.dir)));
+        if(background)
+            WarmUpInvoker(*background, p.problem->conv_problem, invoker, solution.workspce_sz);
+    }
+    if(background)
+        background->Finish();
+
+    for(const auto& entry : legacy)
+        CompileLegacySolution(handle, *entry.first, entry.second);
+}
+
 std::size_t ConvolutionDescriptor::GetWrwSolutionWorkspaceSize(Handle& handle,
                                                                const TensorDescriptor& dyDesc,
                                                                const TensorDescriptor& xDesc,
@@ -3667,13 +4737,12 @@ std::size_t ConvolutionDescriptor::GetWrwSolutionWorkspaceSize(Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm, "invalid solution id = " + solver_id.ToString());
     if(solver_id != solver::Id::gemm() && solver_id != solver::Id::fft())
     {
-        auto sol = solver_id.GetSolver();
-        auto problem =
-            ProblemDescription{xDesc, dwDesc, dyDesc, *this, conv::Direction::BackwardWeights};
-        auto ctx = ConvolutionContext{problem};
+        auto sol     = solver_id.GetSolver();
+        auto problem = MakeWrwProblem(handle, dyDesc, xDesc, dwDesc);
+        auto ctx     = ConvolutionContext{problem};
         ctx.SetStream(&handle);
         ctx.DetectRocm();
-        if(sol.IsApplicable(ctx))
+        if(solver::applicability::Memo{ctx}.IsApplicable(sol, ctx))
             return sol.GetWorkspaceSize(ctx);
         else
         {
@@ -3707,10 +4776,6 @@ void ConvolutionDescriptor::ConvolutionWrwImmediate(Handle& handle,
     ConvWrwCheckNumerics(handle, tensors, &beta, [&]() {
         ValidateGroupCount(xDesc, dwDesc, *this);
 
-        auto ctx =
-            ConvolutionContext{xDesc, dwDesc, dyDesc, *this, conv::Direction::BackwardWeights};
-        ctx.SetStream(&handle);
-
         if(solver_id == solver::Id::gemm())
         {
             BackwardWeightsGemm(handle, tensors, workSpace, workSpaceSize);
@@ -3723,13 +4788,200 @@ void ConvolutionDescriptor::ConvolutionWrwImmediate(Handle& handle,
                          " requested in immediate WrW, which is not supported.");
         }
 
-        const auto invoker =
-            LoadOrPrepareInvoker(handle, ctx, solver_id, conv::Direction::BackwardWeights);
-        const auto invoke_ctx = conv::WrWInvokeParams{tensors, workSpace, workSpaceSize};
-        invoker(handle, invoke_ctx);
+        const auto make_ctx = [&]() {
+            auto ctx = ConvolutionContext{MakeWrwProblem(handle, dyDesc, xDesc, dwDesc)};
+            ctx.SetStream(&handle);
+            return ctx;
+        };
+        const auto key = conv::ProblemKey{xDesc,
+                                          dwDesc,
+                                          dyDesc,
+                                          *this,
+                                          conv::Direction::BackwardWeights,
+                                          handle.IsDeterministicModeEnabled()};
+        auto config        = InternedString{};
+        const auto invoker = LoadOrPrepareInvoker(
+            handle, key, make_ctx, solver_id, conv::Direction::BackwardWeights, config);
+        const auto invoke_ctx =
+            conv::WrWInvokeParams{CanonicalTensors(tensors, *this), workSpace, workSpaceSize};
+        const auto graph_key =
+            GetGraphKey(config, solver_id, workSpaceSize, {dy, x, dw, workSpace});
+        conv::RunSampled(handle,
+                         conv::Direction::BackwardWeights,
+                         xDesc.GetType(),
+                         [&]() { return solver_id; },
+                         [&]() { handle.RunInvoker(invoker, invoke_ctx, graph_key); });
     });
 }
 
+ConvolutionPlan::ConvolutionPlan(Handle& handle,
+                                 const TensorDescriptor& xDesc_,
+                                 const TensorDescriptor& wDesc_,
+                                 const TensorDescriptor& yDesc_,
+                                 const ConvolutionDescriptor& convDesc_,
+                                 conv::Direction direction_,
+                                 solver::Id solver_id_)
+    : convDesc(convDesc_),
+      transposed(convDesc_.mode == miopenTranspose),
+      xDesc(transposed ? yDesc_ : xDesc_),
+      wDesc(wDesc_),
+      yDesc(transposed ? xDesc_ : yDesc_),
+      direction(direction_),
+      solver_id(solver_id_)
+{
+    MIOPEN_LOG_I("solver_id = " << solver_id.ToString());
+    if(!solver_id.IsValid())
+        MIOPEN_THROW(miopenStatusBadParm, "solver_id = " + solver_id.ToString());
+
+    if(transposed && direction != conv::Direction::BackwardWeights)
+    {
+        direction = direction == conv::Direction::Forward ? conv::Direction::BackwardData
+                                                          : conv::Direction::Forward;
+    }
+
+    ValidateConvTensorDescriptors(xDesc, wDesc, yDesc);
+    ValidateGroupCount(xDesc, wDesc, convDesc);
+
+    switch(direction)
+    {
+    case conv::Direction::Forward:
+        workspace_size =
+            convDesc.GetForwardSolutionWorkspaceSize(handle, wDesc, xDesc, yDesc, solver_id);
+        break;
+    case conv::Direction::BackwardData:
+        if(wDesc.GetType() == miopenInt8 || yDesc.GetLengths()[1] != wDesc.GetLengths()[0])
+            MIOPEN_THROW(miopenStatusBadParm);
+        workspace_size =
+            convDesc.GetBackwardSolutionWorkspaceSize(handle, yDesc, wDesc, xDesc, solver_id);
+        break;
+    case conv::Direction::BackwardWeights:
+        workspace_size =
+            convDesc.GetWrwSolutionWorkspaceSize(handle, yDesc, xDesc, wDesc, solver_id);
+        break;
+    }
+
+    // The other solutions are run through the immediate mode calls.
+    if(solver_id == solver::Id::gemm() || !CheckInvokerSupport(solver_id, direction))
+        return;
+
+    const auto deterministic =
+        direction == conv::Direction::BackwardWeights && handle.IsDeterministicModeEnabled();
+    const auto make_ctx = [&]() {
+        auto ctx = ConvolutionContext{xDesc, wDesc, yDesc, convDesc, direction};
+        ctx.conv_problem.SetDeterministic(deterministic);
+        ctx.SetStream(&handle);
+        return ctx;
+    };
+    const auto key = conv::ProblemKey{xDesc, wDesc, yDesc, convDesc, direction, deterministic};
+    auto config    = InternedString{};
+    invoker        = LoadOrPrepareInvoker(handle, key, make_ctx, solver_id, direction, config);
+    bound_handle   = &handle;
+
+    if(direction == conv::Direction::BackwardWeights)
+    {
+        const auto wrw = conv::WrWInvokeParams{
+            CanonicalTensors(ConvWrwTensors{yDesc, nullptr, xDesc, nullptr, wDesc, nullptr},
+                             convDesc),
+            nullptr,
+            0};
+        params     = wrw;
+        wrw_params = &params.CastTo<conv::WrWInvokeParams>();
+    }
+    else
+    {
+        // The tensors own copies of the descriptors, only the buffers are set by the runs.
+        const auto tensors =
+            direction == conv::Direction::Forward
+                ? ConvDataTensors{xDesc, nullptr, wDesc, nullptr, yDesc, nullptr}
+                : ConvDataTensors{yDesc, nullptr, wDesc, nullptr, xDesc, nullptr};
+        const auto data = conv::DataInvokeParams{CanonicalTensors(tensors, convDesc), nullptr, 0};
+        params          = data;
+        data_params = &params.CastTo<conv::DataInvokeParams>();
+    }
+}
+
+void ConvolutionPlan::Run(Handle& handle,
+                          Data_t x,
+                          Data_t w,
+                          Data_t y,
+                          Data_t workSpace,
+                          std::size_t workSpaceSize)
+{
+    if(transposed)
+        std::swap(x, y);
+
+    if(workSpace == nullptr && workspace_size != 0 && handle.IsWorkspaceArenaEnabled())
+    {
+        constexpr auto slot = WorkspaceArena::Slot::Workspace;
+        workSpace           = handle.GetArenaBuffer(slot, workspace_size).get();
+        workSpaceSize       = workspace_size;
+    }
+
+    if(!invoker || miopen::CheckNumericsEnabled())
+    {
+        RunImmediate(handle, x, w, y, workSpace, workSpaceSize);
+        return;
+    }
+
+    if(&handle != bound_handle)
+        MIOPEN_THROW(miopenStatusBadParm, "The convolution plan was created with another handle");
+    if(x == nullptr || w == nullptr || y == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm);
+
+    if(wrw_params != nullptr)
+    {
+        wrw_params->tensors.dy    = y;
+        wrw_params->tensors.x     = x;
+        wrw_params->tensors.dw    = w;
+        wrw_params->workSpace     = workSpace;
+        wrw_params->workSpaceSize = workSpaceSize;
+    }
+    else
+    {
+        const auto forward         = direction == conv::Direction::Forward;
+        data_params->tensors.in    = forward ? x : y;
+        data_params->tensors.w     = w;
+        data_params->tensors.out   = forward ? y : x;
+        data_params->workSpace     = workSpace;
+        data_params->workSpaceSize = workSpaceSize;
+    }
+
+    conv::RunSampled(handle,
+                     direction,
+                     xDesc.GetType(),
+                     [&]() { return solver_id; },
+                     [&]() { handle.RunInvoker(invoker, params); });
+}
+
+void ConvolutionPlan::RunImmediate(Handle& handle,
+                                   Data_t x,
+                                   Data_t w,
+                                   Data_t y,
+                                   Data_t workSpace,
+                                   std::size_t workSpaceSize) const
+{
+    switch(direction)
+    {
+    case conv::Direction::Forward:
+        convDesc.ConvolutionForwardImmediate(
+            handle, wDesc, w, xDesc, x, yDesc, y, workSpace, workSpaceSize, solver_id);
+        break;
+    case conv::Direction::BackwardData:
+        convDesc.ConvolutionBackwardImmediate(
+            handle, yDesc, y, wDesc, w, xDesc, x, workSpace, workSpaceSize, solver_id);
+        break;
+    case conv::Direction::BackwardWeights:
+        convDesc.ConvolutionWrwImmediate(
+            handle, yDesc, y, xDesc, x, wDesc, w, workSpace, workSpaceSize, solver_id);
+        break;
+    }
+}
+
+std::ostream& operator<<(std::ostream& stream, const ConvolutionPlan& plan)
+{
+    return stream << plan.GetSolverId().ToString() << ", " << plan.GetWorkspaceSize();
+}
+
 void ConvolutionBackwardBias(const Handle& handle,
                              const void* alpha,
                              const TensorDescriptor& dyDesc,
@@ -3771,27 +5023,77 @@ void ConvolutionBackwardBias(const Handle& handle,
                                            dyDesc.GetLengths().end(),
                                            std::size_t(1),
                                            std::multiplies<std::size_t>());
-    std::size_t read_unit        = 4;
-    std::size_t map_size_aligned = (map_size + (read_unit - 1)) / read_unit;
-    std::size_t off_pix          = map_size - (map_size / read_unit) * read_unit;
-
-    params = " -DMLO_CONVBWD_GROUP_SZ0=" + std::to_string(lcl_grp_size0);
-    params += " -DMLO_CONVBWD_GROUP_SZ1=" + std::to_string(lcl_grp_size1);
-    params += " -DMLO_CONVBWDB_LCL_MEMSZ=" + std::to_string(local_mem_sz);
-    params += " -DMLO_CONVBWDB_UNITSIZE=" + std::to_string(read_unit);
-    params += " -DMLO_OUT_BATCH_SZ=" + std::to_string(out_n);
-    params += " -DMLO_OUT_CHANNEL_STRIDE=" + std::to_string(stride_k);
-    params += " -DMLO_OUT_BATCH_STRIDE=" + std::to_string(stride_n);
-    params += " -DMLO_WK_SIZE=" + std::to_string(map_size_aligned);
-    params += " -DMLO_N_PIX_OFF=" + std::to_string(off_pix);
-
-    params += GetDataTypeKernelParams(dyDesc.GetType());
-
-    const std::vector<size_t> vld = {lcl_grp_size0, size_t{1}, size_t{1}};
-    const std::vector<size_t> vgd = {lcl_grp_size0, static_cast<size_t>(out_k), size_t{1}};
-
-    handle.AddKernel("miopenConvolutionBwdBias", "", program_name, kernel_name, vld, vgd, params)(
-        dy, db);
+
+    // One work-group per channel leaves most of the GPU idle when there are few channels, so
+    // these are split between several work-groups whose partial sums are added up by a second
+    // kernel.
+    const auto num_cus  = handle.GetMaxComputeUnits();
+    const auto per_map  = out_n * map_size;
+    const auto n_blocks = std::min<std::size_t>(
+        {lcl_grp_size0, (4 * num_cus + out_k - 1) / out_k, per_map / (4 * 4 * lcl_grp_size0)});
+    if(!miopen::IsDisabled(MIOPEN_DEBUG_CONV_BWD_BIAS_MULTI_BLOCK{}) && n_blocks >= 2)
+    {
+        const auto vec = map_size % 4 == 0 && stride_n % 4 == 0 && stride_k % 4 == 0 ? 4 : 1;
+
+        params = " -DMLO_CONVBWD_GROUP_SZ0=" + std::to_string(lcl_grp_size0);
+        params += " -DMLO_BLOCKS=" + std::to_string(n_blocks);
+        params += " -DMLO_OUT_BATCH_SZ=" + std::to_string(out_n);
+        params += " -DMLO_OUT_CHANNEL_STRIDE=" + std::to_string(stride_k);
+        params += " -DMLO_OUT_BATCH_STRIDE=" + std::to_string(stride_n);
+        params += " -DMLO_MAP_SIZE=" + std::to_string(map_size);
+        params += " -DMLO_VEC=" + std::to_string(vec);
+        params += GetDataTypeKernelParams(dyDesc.GetType());
+
+        Allocator::ManageDataPtr local_partial;
+        constexpr auto slot     = WorkspaceArena::Slot::BwdBias;
+        const auto partial_size = n_blocks * out_k * sizeof(float);
+        if(!handle.IsWorkspaceArenaEnabled())
+            local_partial = handle.Create(partial_size, miopenAllocationScratch);
+        auto& partial = handle.IsWorkspaceArenaEnabled()
+                            ? handle.GetArenaBuffer(slot, partial_size)
+                            : local_partial;
+
+        const auto file               = "MIOpenConvBwdBiasMultiBlock.cl";
+        const std::vector<size_t> vld = {lcl_grp_size0, size_t{1}, size_t{1}};
+        handle.AddKernel("miopenConvolutionBwdBias",
+                         "",
+                         file,
+                         "MIOpenConvBwdBPartial",
+                         vld,
+                         {lcl_grp_size0 * n_blocks, static_cast<size_t>(out_k), size_t{1}},
+                         params)(dy, partial.get());
+        handle.AddKernel("miopenConvolutionBwdBias",
+                         "",
+                         file,
+                         "MIOpenConvBwdBFinal",
+                         vld,
+                         {lcl_grp_size0, static_cast<size_t>(out_k), size_t{1}},
+                         params)(partial.get(), db);
+    }
+    else
+    {
+        std::size_t read_unit        = 4;
+        std::size_t map_size_aligned = (map_size + (read_unit - 1)) / read_unit;
+        std::size_t off_pix          = map_size - (map_size / read_unit) * read_unit;
+
+        params = " -DMLO_CONVBWD_GROUP_SZ0=" + std::to_string(lcl_grp_size0);
+        params += " -DMLO_CONVBWD_GROUP_SZ1=" + std::to_string(lcl_grp_size1);
+        params += " -DMLO_CONVBWDB_LCL_MEMSZ=" + std::to_string(local_mem_sz);
+        params += " -DMLO_CONVBWDB_UNITSIZE=" + std::to_string(read_unit);
+        params += " -DMLO_OUT_BATCH_SZ=" + std::to_string(out_n);
+        params += " -DMLO_OUT_CHANNEL_STRIDE=" + std::to_string(stride_k);
+        params += " -DMLO_OUT_BATCH_STRIDE=" + std::to_string(stride_n);
+        params += " -DMLO_WK_SIZE=" + std::to_string(map_size_aligned);
+        params += " -DMLO_N_PIX_OFF=" + std::to_string(off_pix);
+
+        params += GetDataTypeKernelParams(dyDesc.GetType());
+
+        const std::vector<size_t> vld = {lcl_grp_size0, size_t{1}, size_t{1}};
+        const std::vector<size_t> vgd = {lcl_grp_size0, static_cast<size_t>(out_k), size_t{1}};
+
+        handle.AddKernel(
+            "miopenConvolutionBwdBias", "", program_name, kernel_name, vld, vgd, params)(dy, db);
+    }
 
     if(miopen::CheckNumericsEnabled())
     {
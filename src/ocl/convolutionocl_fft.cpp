@@ -29,11 +29,15 @@
 #include <miopen/handle.hpp>
 #include <miopen/tensor_ops.hpp>
 #include <miopen/tensor.hpp>
+#include <miopen/transformed_weights.hpp>
 #include <miopen/util.hpp>
 
+#include <limits>
+
 namespace miopen {
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_FFT)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_CONV_FFT_CACHE_WEIGHTS)
 
 static void cgemm_grid(size_t* global_work_size,
                        size_t* local_work_size,
@@ -372,7 +376,6 @@ static float ExecuteFFTKernel(const Handle& handle,
 {
 
     (void)wDesc; // suppress warning
-    (void)fwd;   // suppress warning
 
     int halfw = static_cast<int>(workSpaceSize) / (2 * 2 * static_cast<int>(sizeof(float)));
     int in_n, in_c, in_h, in_w;
@@ -389,6 +392,24 @@ static float ExecuteFFTKernel(const Handle& handle,
     const auto kernels = handle.GetKernels("miopenConvolutionFwdAlgoFFT", kcache_key);
     auto k_it          = kernels.begin();
 
+    // The transposed spectrum of the filters, the first cgemm operand, in floats.
+    const auto spectrum_offset = 2 * (static_cast<std::size_t>(halfw) +
+                                      static_cast<std::size_t>(N) * (in_n * in_c + Padding));
+    const auto spectrum_size = 2 * static_cast<std::size_t>(N) * (in_c * out_c + Padding);
+    TransformedWeightsCache::Filters cached_spectrum = nullptr;
+    TransformedWeightsCache::Filters new_spectrum    = nullptr;
+    std::string cache_key;
+    if(miopen::IsEnabled(MIOPEN_CONV_FFT_CACHE_WEIGHTS{}) &&
+       spectrum_offset + spectrum_size <= static_cast<std::size_t>(std::numeric_limits<int>::max()))
+    {
+        cache_key       = kcache_key.ToString() + (fwd ? "/fwd" : "/bwd");
+        cached_spectrum = handle.GetTransformedWeightsCache().Find(cache_key, w);
+        if(cached_spectrum == nullptr)
+            new_spectrum = handle.Create(spectrum_size * sizeof(float));
+    }
+    // CopyTensor flattens these into one run of floats.
+    const auto spectrum_desc = TensorDescriptor{miopenFloat, {spectrum_size}};
+
     for(int ik = 0; ik < NumKernels; ik++)
     {
         // skip front transposes for 7x7
@@ -402,6 +423,36 @@ static float ExecuteFFTKernel(const Handle& handle,
         const auto k = *k_it;
         ++k_it;
 
+        // The filters are neither transformed nor transposed again.
+        if(cached_spectrum != nullptr && (ik == 1 || ik == 3))
+            continue;
+
+        if(ik == 4 && (cached_spectrum != nullptr || new_spectrum != nullptr))
+        {
+            if(cached_spectrum != nullptr)
+                CopyTensor(handle,
+                           spectrum_desc,
+                           cached_spectrum.get(),
+                           spectrum_desc,
+                           workSpace,
+                           0,
+                           static_cast<int>(spectrum_offset));
+            else
+            {
+                CopyTensor(handle,
+                           spectrum_desc,
+                           workSpace,
+                           spectrum_desc,
+                           new_spectrum.get(),
+                           static_cast<int>(spectrum_offset),
+                           0);
+                // Published once the copy is enqueued, the other users of the handle follow it.
+                handle.GetTransformedWeightsCache().Insert(cache_key, w, new_spectrum);
+            }
+            if(timed)
+                time_fft += handle.GetKernelTime();
+        }
+
         switch(ik)
         {
         case 0: k(x, workSpace); break;
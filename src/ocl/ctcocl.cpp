@@ -207,7 +207,95 @@ void CTCLossDescriptor::CTCLoss(const Handle& handle,
             time += handle.GetKernelTime();
     }
 
-    if(!kernels.empty())
+    if(IsCTCLossTiled(probsDesc, max_label_len))
+    {
+        const auto layout = GetCTCLossTiledLayout(probsDesc, max_label_len, total_label_len);
+        const auto tiled_config =
+            network_config + "dt" + std::to_string(static_cast<int>(probsDesc.GetType())) + "ps" +
+            std::to_string(probsDesc.GetStrides()[0]) + "x" +
+            std::to_string(probsDesc.GetStrides()[1]) + "gs" +
+            std::to_string(gradientsDesc.GetStrides()[0]) + "x" +
+            std::to_string(gradientsDesc.GetStrides()[1]);
+
+        std::string params;
+        params += " -DCLASS_SZ=" + std::to_string(class_sz) + " -DBATCH_SZ=" +
+                  std::to_string(batch_size) + " -DMAX_TSTEP=" + std::to_string(max_time_step) +
+                  " -DMAX_S_LEN=" + std::to_string(max_S_len) + " -DTILE_S=" +
+                  std::to_string(layout.work_per_grp) + " -DTILE_T=" +
+                  std::to_string(layout.tile_t) + " -DS_TILES=" + std::to_string(layout.s_tiles) +
+                  " -DT_TILES=" + std::to_string(layout.t_tiles) + " -DPROBLOG_OFFSET=" +
+                  std::to_string(problog_offset) + " -DGRAD_LOG_OFFSET=" +
+                  std::to_string(layout.grad_log_offset) + " -DALPHA_CKPT_OFFSET=" +
+                  std::to_string(layout.alpha_ckpt_offset) + " -DALPHA_COL_OFFSET=" +
+                  std::to_string(layout.alpha_col_offset) + " -DBETA_COL_OFFSET=" +
+                  std::to_string(layout.beta_col_offset) + " -DBETA_ROW_OFFSET=" +
+                  std::to_string(layout.beta_row_offset) + " -DALPHA_END_OFFSET=" +
+                  std::to_string(layout.alpha_end_offset) + " -DBLANK_LB_ID=" +
+                  std::to_string(blank_label_id) + " -DSOFTMAX_APPLIED=" +
+                  std::to_string(static_cast<int>(apply_softmax_layer));
+
+        if(!probsDesc.IsPacked())
+            params += " -DPROBS_STRIDE0=" + std::to_string(probsDesc.GetStrides()[0]) +
+                      " -DPROBS_STRIDE1=" + std::to_string(probsDesc.GetStrides()[1]);
+
+        if(!gradientsDesc.IsPacked())
+            params += " -DGRADS_STRIDE0=" + std::to_string(gradientsDesc.GetStrides()[0]) +
+                      " -DGRADS_STRIDE1=" + std::to_string(gradientsDesc.GetStrides()[1]);
+
+        if(probsDesc.GetType() == miopenHalf)
+            params += " -DMIOPEN_USE_FP16=1";
+        else
+            params += " -DMIOPEN_USE_FP32=1";
+
+#if MIOPEN_BACKEND_HIP
+        params += " -DUSE_HIP_BACKEND=1";
+#elif MIOPEN_BACKEND_OPENCL
+        params += " -DUSE_OCL_BACKEND=1";
+#endif
+
+        const std::size_t elem_num = max_time_step * batch_size * class_sz;
+        const std::size_t elem_glb =
+            std::min<std::size_t>((elem_num + layout.work_per_grp - 1) / layout.work_per_grp *
+                                      layout.work_per_grp,
+                                  MAX_ACTIVE_THREADS);
+        const std::vector<size_t> vld{layout.work_per_grp, 1, 1};
+        const std::vector<size_t> vgd_elem{elem_glb, 1, 1};
+        const std::vector<size_t> vgd_tile{batch_size * layout.s_tiles * layout.work_per_grp, 1, 1};
+
+        const auto get_kernel = [&](const std::string& name, const std::vector<size_t>& vgd) {
+            auto&& tiled_kernels = handle.GetKernels(name, tiled_config);
+            if(!tiled_kernels.empty())
+                return tiled_kernels.front();
+            return handle.AddKernel(
+                name, tiled_config, "MIOpenCTCLossTiled.cl", name, vld, vgd, params);
+        };
+        const auto accum_time = [&]() {
+            if(handle.IsProfilingEnabled())
+                time += handle.GetKernelTime();
+        };
+
+        get_kernel("CTCLossTiledInit", vgd_elem)(workSpace);
+        accum_time();
+
+        // Tiles of the same anti-diagonal of the lattice are independent of each other.
+        const int diag_num = static_cast<int>(layout.t_tiles + layout.s_tiles - 1);
+        auto alpha_kernel  = get_kernel("CTCLossTiledAlpha", vgd_tile);
+        for(int diag = 0; diag < diag_num; diag++)
+        {
+            alpha_kernel(probs, workSpace, workSpace, workSpace, diag);
+            accum_time();
+        }
+        auto beta_kernel = get_kernel("CTCLossTiledBeta", vgd_tile);
+        for(int diag = diag_num - 1; diag >= 0; diag--)
+        {
+            beta_kernel(probs, workSpace, workSpace, workSpace, diag);
+            accum_time();
+        }
+
+        get_kernel("CTCLossTiledFinalize", vgd_elem)(
+            probs, workSpace, workSpace, workSpace, losses, gradients);
+    }
+    else if(!kernels.empty())
     {
         auto kernel = kernels.front();
 
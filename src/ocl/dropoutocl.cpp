@@ -216,7 +216,7 @@ void DropoutDescriptor::DropoutForward(const Handle& handle,
 
     bool use_rsvsp = !(reserveSpace == nullptr);
     if(((use_rsvsp || use_mask) &&
-        reserveSpaceSizeInBytes < xDesc.GetElementSize() * sizeof(bool)) ||
+        reserveSpaceSizeInBytes < GetReserveSpaceSize(xDesc.GetElementSize())) ||
        (use_mask && reserveSpace == nullptr))
     {
         MIOPEN_THROW("Insufficient reservespace size");
@@ -252,17 +252,25 @@ void DropoutDescriptor::DropoutForward(const Handle& handle,
                        out_len,
                        out_str);
 
-    size_t RD_BLCK    = /* (in_len[4] % 4 == 0) ? 4 : */ (in_len[2] % 2 == 0) ? 2 : 1;
+    // a bit-packed mask is addressed by element, one per work-item
+    bool use_bitmask = mask_format == MIOPEN_DROPOUT_MASK_BIT;
+
+    size_t RD_BLCK =
+        use_bitmask ? 1 : /* (in_len[4] % 4 == 0) ? 4 : */ (in_len[2] % 2 == 0) ? 2 : 1;
     size_t total_work = (in_len[4] / RD_BLCK) * in_len[3] * in_len[2] * in_len[1] * in_len[0];
 
-    size_t max_wk_grp =
-        use_mask ? MAX_WORKITEM_NUM : std::min(size_t(MAX_PRNG_STATE), handle.GetImage3dMaxWidth());
+    // counter-based generator keeps no per-thread state, so any grid size regenerates the same mask
+    bool use_philox = rng_mode == MIOPEN_RNG_PHILOX_4X32_10;
+
+    size_t max_wk_grp = (use_mask || use_philox)
+                            ? MAX_WORKITEM_NUM
+                            : std::min(size_t(MAX_PRNG_STATE), handle.GetImage3dMaxWidth());
     size_t wk_grp_num =
         std::min(max_wk_grp / 256,
                  ((in_len[4] * in_len[3] * in_len[2] * in_len[1] * in_len[0] + 255) / 256));
 
     size_t states_num = stateSizeInBytes / sizeof(prngStates);
-    if(states_num < wk_grp_num * 256 && !use_mask)
+    if(states_num < wk_grp_num * 256 && !use_mask && !use_philox)
     {
         MIOPEN_THROW("Insufficient state size for parallel PRNG");
     }
@@ -270,12 +278,15 @@ void DropoutDescriptor::DropoutForward(const Handle& handle,
     std::string program_name = "MIOpenDropout.cl";
     std::string kernel_name  = "DropoutForward";
 
+    // philox takes the seed as a kernel argument
     std::string network_config =
         "fwd-" + std::string(xDesc.GetType() == miopenHalf ? "fp16-" : "fp32-") + "-seed" +
-        std::to_string(seed) + "-rng" + std::to_string(rng_mode) + "-rsvsp" +
+        (use_philox ? std::string() : std::to_string(seed)) + "-rng" + std::to_string(rng_mode) +
+        "-rsvsp" +
         std::to_string(static_cast<int>(use_rsvsp)) + "-mask" +
         std::to_string(static_cast<int>(use_mask)) + "-evo" +
-        std::to_string(static_cast<int>(state_evo)) + "-blk" + std::to_string(RD_BLCK) + "-wg" +
+        std::to_string(static_cast<int>(state_evo)) + "-bit" +
+        std::to_string(static_cast<int>(use_bitmask)) + "-blk" + std::to_string(RD_BLCK) + "-wg" +
         std::to_string(wk_grp_num) /* + "-noise" + std::to_string(noise_shape.GetLengths()[0])*/;
 
     // TODO: Add noise shape
@@ -308,7 +319,9 @@ void DropoutDescriptor::DropoutForward(const Handle& handle,
                         uint(total_work),
                         uint(in_offset),
                         uint(out_offset),
-                        uint(rsvsp_offset));
+                        uint(rsvsp_offset),
+                        uint(seed & 0xFFFFFFFF),
+                        uint(seed >> 32));
     }
     else
     {
@@ -331,6 +344,8 @@ void DropoutDescriptor::DropoutForward(const Handle& handle,
 
         params += " -DUSE_RSVSP=" + std::to_string(static_cast<size_t>(use_rsvsp));
         params += " -DUSE_MASK=" + std::to_string(static_cast<size_t>(use_mask));
+        params += " -DUSE_PHILOX=" + std::to_string(static_cast<size_t>(use_philox));
+        params += " -DUSE_BITMASK=" + std::to_string(static_cast<size_t>(use_bitmask));
 
         const std::vector<size_t> vld{256, 1, 1};
         const std::vector<size_t> vgd{wk_grp_num * 256, 1, 1};
@@ -357,7 +372,9 @@ void DropoutDescriptor::DropoutForward(const Handle& handle,
             uint(total_work),
             uint(in_offset),
             uint(out_offset),
-            uint(rsvsp_offset));
+            uint(rsvsp_offset),
+            uint(seed & 0xFFFFFFFF),
+            uint(seed >> 32));
     }
 
     if(miopen::CheckNumericsEnabled())
@@ -418,7 +435,7 @@ void DropoutDescriptor::DropoutBackward(const Handle& handle,
 
     bool use_prng = reserveSpace == nullptr;
     if(((!use_prng || use_mask) &&
-        reserveSpaceSizeInBytes < dyDesc.GetElementSize() * sizeof(bool)) ||
+        reserveSpaceSizeInBytes < GetReserveSpaceSize(dyDesc.GetElementSize())) ||
        (use_mask && use_prng))
     {
         MIOPEN_THROW("Insufficient reservespace size");
@@ -453,16 +470,24 @@ void DropoutDescriptor::DropoutBackward(const Handle& handle,
                        out_len,
                        out_str);
 
-    size_t RD_BLCK    = /* (in_len[4] % 4 == 0) ? 4 : */ (in_len[2] % 2 == 0) ? 2 : 1;
+    // a bit-packed mask is addressed by element, one per work-item
+    bool use_bitmask = mask_format == MIOPEN_DROPOUT_MASK_BIT;
+
+    size_t RD_BLCK =
+        use_bitmask ? 1 : /* (in_len[4] % 4 == 0) ? 4 : */ (in_len[2] % 2 == 0) ? 2 : 1;
     size_t total_work = (in_len[4] / RD_BLCK) * in_len[3] * in_len[2] * in_len[1] * in_len[0];
 
-    size_t max_wk_grp =
-        use_prng ? std::min(size_t(MAX_PRNG_STATE), handle.GetImage3dMaxWidth()) : MAX_WORKITEM_NUM;
+    // counter-based generator keeps no per-thread state, so any grid size regenerates the same mask
+    bool use_philox = rng_mode == MIOPEN_RNG_PHILOX_4X32_10;
+
+    size_t max_wk_grp = (use_prng && !use_philox)
+                            ? std::min(size_t(MAX_PRNG_STATE), handle.GetImage3dMaxWidth())
+                            : MAX_WORKITEM_NUM;
     size_t wk_grp_num =
         std::min(max_wk_grp / 256,
                  ((in_len[4] * in_len[3] * in_len[2] * in_len[1] * in_len[0] + 255) / 256));
 
-    if(use_prng)
+    if(use_prng && !use_philox)
     {
         size_t states_num = stateSizeInBytes / sizeof(prngStates);
         if(states_num < wk_grp_num * 256)
@@ -474,11 +499,14 @@ void DropoutDescriptor::DropoutBackward(const Handle& handle,
     std::string program_name = "MIOpenDropout.cl";
     std::string kernel_name  = "DropoutBackward";
 
+    // philox takes the seed as a kernel argument
     std::string network_config =
         "bwd-" + std::string(dyDesc.GetType() == miopenHalf ? "fp16-" : "fp32-") + "-seed" +
-        std::to_string(seed) + "-rng" + std::to_string(rng_mode) + "-prng" +
+        (use_philox ? std::string() : std::to_string(seed)) + "-rng" + std::to_string(rng_mode) +
+        "-prng" +
         std::to_string(static_cast<int>(use_prng)) + "-evo" +
-        std::to_string(static_cast<int>(state_evo)) + "-blk" + std::to_string(RD_BLCK) + "-wg" +
+        std::to_string(static_cast<int>(state_evo)) + "-bit" +
+        std::to_string(static_cast<int>(use_bitmask)) + "-blk" + std::to_string(RD_BLCK) + "-wg" +
         std::to_string(wk_grp_num) /* + "-noise" + std::to_string(noise_shape.GetLengths()[0]) */;
 
     // TODO: Add noise shape
@@ -511,7 +539,9 @@ void DropoutDescriptor::DropoutBackward(const Handle& handle,
                         uint(total_work),
                         uint(in_offset),
                         uint(out_offset),
-                        uint(rsvsp_offset));
+                        uint(rsvsp_offset),
+                        uint(seed & 0xFFFFFFFF),
+                        uint(seed >> 32));
     }
     else
     {
@@ -529,6 +559,8 @@ void DropoutDescriptor::DropoutBackward(const Handle& handle,
         {
             params += " -DUSE_PRNG=1";
         }
+        params += " -DUSE_PHILOX=" + std::to_string(static_cast<size_t>(use_philox));
+        params += " -DUSE_BITMASK=" + std::to_string(static_cast<size_t>(use_bitmask));
 
         if(dyDesc.GetType() == miopenHalf)
             params += " -DMIOPEN_USE_FP16=1";
@@ -562,7 +594,9 @@ void DropoutDescriptor::DropoutBackward(const Handle& handle,
             uint(total_work),
             uint(in_offset),
             uint(out_offset),
-            uint(rsvsp_offset));
+            uint(rsvsp_offset),
+            uint(seed & 0xFFFFFFFF),
+            uint(seed >> 32));
     }
 
     if(miopen::CheckNumericsEnabled())
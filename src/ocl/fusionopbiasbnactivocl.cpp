@@ -81,6 +81,50 @@ std::vector<size_t> BiasFusionOpDescriptor::GetGlobalWGSz(Handle& /*handle*/,
     MIOPEN_THROW("Op does not support global workgroup size");
 }
 
+miopenStatus_t ResidualAddFwdFusionOpDescriptor::GetNetworkConfig(std::string& network_config,
+                                                                  Handle& /*handle*/)
+{
+    network_config += "ResAddFwd";
+    return miopenStatusSuccess;
+}
+
+miopenStatus_t ResidualAddFwdFusionOpDescriptor::GetCompileParms(
+    std::string& compile_config,
+    Handle& /*handle*/,
+    FusionKernelSourceType source,
+    const std::vector<solver::AnySolver>& solvers)
+{
+    // Batch norm kernels carry no solver, convolution kernels always do
+    const bool is_conv = !solvers.empty() && !solvers[0].IsEmpty();
+    std::string add;
+    switch(source)
+    {
+    case AsmText: add = " -Wa,-defsym,residual_mode=1"; break;
+    case OpenclText: add = is_conv ? " -DMLO_CONV_RESIDUAL=1" : " -DMIO_BN_RESIDUAL=1"; break;
+    case Binary: break;
+    }
+    MIOPEN_LOG_I2(add);
+    compile_config += add;
+    return miopenStatusSuccess;
+}
+
+miopenStatus_t ResidualAddBwdFusionOpDescriptor::GetNetworkConfig(std::string& network_config,
+                                                                  Handle& /*handle*/)
+{
+    network_config += "ResAddBwd";
+    return miopenStatusSuccess;
+}
+
+miopenStatus_t ResidualAddBwdFusionOpDescriptor::GetCompileParms(
+    std::string& compile_config,
+    Handle& /*handle*/,
+    FusionKernelSourceType /*source*/,
+    const std::vector<solver::AnySolver>& /*solvers*/)
+{
+    compile_config += " -DMIO_BN_RESIDUAL=1";
+    return miopenStatusSuccess;
+}
+
 miopenStatus_t ActivFwdFusionOpDescriptor::GetNetworkConfig(std::string& network_config,
                                                             Handle& /*handle*/)
 {
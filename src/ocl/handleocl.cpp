@@ -27,7 +27,11 @@
 #include <miopen/handle.hpp>
 
 #include <miopen/binary_cache.hpp>
+#include <miopen/cache_stats.hpp>
+#include <miopen/check_numerics.hpp>
+#include <miopen/compile_service.hpp>
 #include <miopen/config.h>
+#include <miopen/db_prefetch.hpp>
 #include <miopen/device_name.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/handle_lock.hpp>
@@ -35,8 +39,11 @@
 #include <miopen/kernel_cache.hpp>
 #include <miopen/load_file.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/trace.hpp>
 #include <miopen/manage_ptr.hpp>
 #include <miopen/ocldeviceinfo.hpp>
+#include <miopen/sqlite_db.hpp>
+#include <miopen/thread_streams.hpp>
 #include <miopen/timer.hpp>
 
 #if MIOPEN_USE_MIOPENGEMM
@@ -45,6 +52,9 @@
 
 #include <boost/filesystem.hpp>
 
+#include <atomic>
+#include <cstdio>
+#include <sstream>
 #include <string>
 
 #ifndef _WIN32
@@ -273,8 +283,8 @@ struct HandleImpl
     cl_device_id device = nullptr; // NOLINT
     Allocator allocator{};
     KernelCache cache;
-    bool enable_profiling  = false;
-    float profiling_result = 0.0;
+    std::atomic<bool> enable_profiling{false};
+    std::atomic<float> profiling_result{0.0f};
 
     ContextPtr create_context()
     {
@@ -342,16 +352,26 @@ struct HandleImpl
         return ContextPtr{ctx};
     }
     void ResetProfilingResult() { profiling_result = 0.0; }
-    void AccumProfilingResult(float curr_res) { profiling_result += curr_res; }
+    void AccumProfilingResult(float curr_res)
+    {
+        auto prev = profiling_result.load();
+        while(!profiling_result.compare_exchange_weak(prev, prev + curr_res))
+        {
+            // prev has been reloaded, retry.
+        }
+    }
 
-    void SetProfilingResult(cl_event& e)
+    void SetProfilingResult(cl_event& e, const std::string& kernel_name)
     {
-        if(this->enable_profiling)
+        if(this->enable_profiling || trace::IsEnabled())
         {
             size_t st, end;
             clGetEventProfilingInfo(e, CL_PROFILING_COMMAND_START, sizeof(size_t), &st, nullptr);
             clGetEventProfilingInfo(e, CL_PROFILING_COMMAND_END, sizeof(size_t), &end, nullptr);
-            profiling_result = static_cast<float>(end - st) * 1.0e-6; // NOLINT
+            const auto elapsed = static_cast<float>(end - st) * 1.0e-6; // NOLINT
+            if(this->enable_profiling)
+                profiling_result = elapsed;
+            trace::AddKernel(kernel_name, elapsed);
         }
     }
 };
@@ -363,6 +383,7 @@ Handle::Handle(miopenAcceleratorQueue_t stream) : impl(new HandleImpl())
     impl->context = impl->create_context_from_queue();
 
     this->SetAllocator(nullptr, nullptr, nullptr);
+    db_prefetch = PrefetchSystemDbs(*this);
 }
 
 Handle::Handle() : impl(new HandleImpl())
@@ -439,10 +460,25 @@ Handle::Handle() : impl(new HandleImpl())
     }
     this->SetAllocator(nullptr, nullptr, nullptr);
     MIOPEN_LOG_NQI(*this);
+    db_prefetch = PrefetchSystemDbs(*this);
 }
 
 Handle::Handle(Handle&&) noexcept = default;
-Handle::~Handle()                 = default;
+Handle::~Handle()
+{
+    // The last scans would not be reported otherwise. A destructor must not throw.
+    try
+    {
+        checkNumericsFlush(*this);
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_E(ex.what());
+    }
+#if MIOPEN_ENABLE_SQLITE
+    SQLite::FlushAll();
+#endif
+}
 
 void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
 {
@@ -455,7 +491,11 @@ void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
     impl->queue = HandleImpl::AqPtr{streamID};
 }
 
-miopenAcceleratorQueue_t Handle::GetStream() const { return impl->queue.get(); }
+miopenAcceleratorQueue_t Handle::GetStream() const
+{
+    const auto thread_stream = thread_streams::Find(id);
+    return thread_stream != nullptr ? *thread_stream : impl->queue.get();
+}
 
 void Handle::SetAllocator(miopenAllocatorFunction allocator,
                           miopenDeallocatorFunction deallocator,
@@ -468,6 +508,26 @@ void Handle::SetAllocator(miopenAllocatorFunction allocator,
     this->impl->allocator.allocator   = allocator == nullptr ? default_allocator : allocator;
     this->impl->allocator.deallocator = deallocator == nullptr ? default_deallocator : deallocator;
 
+    this->impl->allocator.allocator_ex = nullptr;
+
+    this->impl->allocator.context =
+        allocatorContext == nullptr ? this->impl->context.get() : allocatorContext;
+}
+
+void Handle::SetAllocatorEx(miopenAllocatorFunctionEx allocator,
+                            miopenDeallocatorFunction deallocator,
+                            void* allocatorContext) const
+{
+    if(allocator == nullptr)
+    {
+        this->SetAllocator(nullptr, deallocator, allocatorContext);
+        return;
+    }
+    this->impl->allocator.allocator   = nullptr;
+    this->impl->allocator.deallocator = deallocator == nullptr ? default_deallocator : deallocator;
+
+    this->impl->allocator.allocator_ex = allocator;
+
     this->impl->allocator.context =
         allocatorContext == nullptr ? this->impl->context.get() : allocatorContext;
 }
@@ -508,6 +568,7 @@ KernelInvoke Handle::AddKernel(const std::string& algorithm,
 Invoker Handle::PrepareInvoker(const InvokerFactory& factory,
                                const std::vector<solver::KernelInfo>& kernels) const
 {
+    MIOPEN_TRACE_SCOPE("invoker", "PrepareInvoker");
     std::vector<Kernel> built;
     for(auto& k : kernels)
     {
@@ -537,8 +598,8 @@ void Handle::ClearKernels(const std::string& algorithm, const std::string& netwo
     this->impl->cache.ClearKernels(algorithm, network_config);
 }
 
-const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
-                                                  const std::string& network_config) const
+std::vector<Kernel> Handle::GetKernelsImpl(const std::string& algorithm,
+                                           const std::string& network_config) const
 {
     return this->impl->cache.GetKernels(algorithm, network_config);
 }
@@ -546,12 +607,14 @@ const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
 KernelInvoke Handle::Run(Kernel k) const
 {
     auto q = this->GetStream();
-    if(this->impl->enable_profiling || MIOPEN_GPU_SYNC)
+    if(this->impl->enable_profiling || MIOPEN_GPU_SYNC || trace::IsEnabled())
     {
+        const auto kernel_name = trace::IsEnabled() ? k.GetName() : std::string{};
         return k.Invoke(q,
                         std::bind(&HandleImpl::SetProfilingResult,
                                   std::ref(*this->impl),
-                                  std::placeholders::_1));
+                                  std::placeholders::_1,
+                                  kernel_name));
     }
     else
     {
@@ -564,6 +627,21 @@ Program Handle::LoadProgram(const std::string& program_name,
                             bool is_kernel_str,
                             const std::string& kernel_src) const
 {
+    // Threads loading the same program at the same time share a single build.
+    std::ostringstream key;
+    key << miopen::GetContext(this->GetStream()) << ":" << program_name << ":" << params << ":"
+        << is_kernel_str << ":" << std::hash<std::string>{}(kernel_src);
+    return CompileService::Get().Build(key.str(), [&]() -> Program {
+        return this->LoadProgramImpl(program_name, params, is_kernel_str, kernel_src);
+    });
+}
+
+Program Handle::LoadProgramImpl(const std::string& program_name,
+                                const std::string& params,
+                                bool is_kernel_str,
+                                const std::string& kernel_src) const
+{
+    const cache_stats::Lookup lookup{miopenCacheBinary};
     auto hsaco = miopen::LoadBinary(
         this->GetDeviceName(), this->GetMaxComputeUnits(), program_name, params, is_kernel_str);
     if(hsaco.empty())
@@ -579,6 +657,7 @@ Program Handle::LoadProgram(const std::string& program_name,
 
 // Save to cache
 #if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+        const auto compile_time_ms = ct.ElapsedMs();
         std::string binary;
         miopen::GetProgramBinary(p, binary);
         miopen::SaveBinary(binary,
@@ -586,17 +665,20 @@ Program Handle::LoadProgram(const std::string& program_name,
                            this->GetMaxComputeUnits(),
                            program_name,
                            params,
-                           is_kernel_str);
+                           is_kernel_str,
+                           compile_time_ms);
 #else
         auto path = miopen::GetCachePath(false) / boost::filesystem::unique_path();
         miopen::SaveProgramBinary(p, path.string());
         miopen::SaveBinary(
             path.string(), this->GetDeviceName(), program_name, params, is_kernel_str);
 #endif
+        lookup.Miss();
         return std::move(p);
     }
     else
     {
+        lookup.Hit();
         return LoadBinaryProgram(miopen::GetContext(this->GetStream()),
                                  miopen::GetDevice(this->GetStream()),
 #if MIOPEN_ENABLE_SQLITE_KERN_CACHE
@@ -607,6 +689,27 @@ Program Handle::LoadProgram(const std::string& program_name,
     }
 }
 
+std::string Handle::LoadCodeObject(const std::string& program_name,
+                                   std::string params,
+                                   bool is_kernel_str) const
+{
+    return miopen::LoadBinaryBlob(
+        this->GetDeviceName(), this->GetMaxComputeUnits(), program_name, params, is_kernel_str);
+}
+
+void Handle::SaveCodeObject(const std::string& program_name,
+                            std::string params,
+                            bool is_kernel_str,
+                            const std::string& code_object) const
+{
+    miopen::SaveBinaryBlob(code_object,
+                           this->GetDeviceName(),
+                           this->GetMaxComputeUnits(),
+                           program_name,
+                           params,
+                           is_kernel_str);
+}
+
 bool Handle::HasProgram(const std::string& program_name, const std::string& params) const
 {
     return this->impl->cache.HasProgram(program_name, params);
@@ -619,12 +722,102 @@ void Handle::AddProgram(Program prog,
     this->impl->cache.AddProgram(prog, program_name, params);
 }
 
-void Handle::Finish() const { clFinish(this->GetStream()); }
+void Handle::SetProgramCacheLimits(std::size_t max_programs, std::size_t max_bytes) const
+{
+    this->impl->cache.SetLimits(max_programs, max_bytes);
+}
+
+void Handle::RunInvoker(const Invoker& invoker,
+                        const AnyInvokeParams& params,
+                        const std::string&) const
+{
+    invoker(*this, params);
+}
+
+void Handle::RunConcurrently(std::size_t count,
+                             const std::function<void(std::size_t)>& task) const
+{
+    for(std::size_t i = 0; i < count; ++i)
+        task(i);
+}
+
+void Handle::SetConcurrentStreamsPriority(int) const {}
+
+Handle Handle::CreateBackgroundHandle() const
+{
+    cl_int status = 0;
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-declarations"
+#endif
+    const auto queue = HandleImpl::AqPtr{clCreateCommandQueue(this->impl->context.get(),
+                                                              miopen::GetDevice(this->GetStream()),
+                                                              CL_QUEUE_PROFILING_ENABLE,
+                                                              &status)};
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+    if(status != CL_SUCCESS)
+        MIOPEN_THROW_CL_STATUS(status, "Creating Command Queue. (clCreateCommandQueue)");
+
+    // Retains the queue.
+    Handle background{queue.get()};
+    background.impl->allocator = this->impl->allocator;
+    return background;
+}
+
+miopenCacheFootprint_t Handle::GetCacheFootprint() const
+{
+    miopenCacheFootprint_t result{};
+    result.programCount    = this->impl->cache.GetProgramCount();
+    result.kernelCount     = this->impl->cache.GetKernelCount();
+    result.codeObjectBytes = this->impl->cache.GetProgramBytes();
+    result.invokerCount    = invokers.Size();
+    result.arenaBytes      = arena.GetBytes();
+    return result;
+}
+
+std::size_t Handle::GetKernelCacheGeneration() const
+{
+    return this->impl->cache.GetGeneration();
+}
+
+miopenDeviceMemoryUsage_t Handle::GetDeviceMemoryUsage() const
+{
+    miopenDeviceMemoryUsage_t result{};
+    result.codeObjectBytes = this->impl->cache.GetProgramBytes();
+    result.workspaceBytes  = arena.GetBytes(WorkspaceArena::Slot::Workspace);
+    result.rocblasBytes    = arena.GetBytes(WorkspaceArena::Slot::RocBLAS);
+    result.scratchBytes    = arena.GetBytes() - result.workspaceBytes - result.rocblasBytes;
+    result.totalBytes      = result.codeObjectBytes + arena.GetBytes();
+    return result;
+}
+
+void Handle::UpdateMemoryBudget() const
+{
+    if(device_memory_limit == 0)
+    {
+        this->impl->cache.SetMemoryBudget(std::numeric_limits<std::size_t>::max());
+        return;
+    }
+    const auto held = arena.GetBytes();
+    this->impl->cache.SetMemoryBudget(device_memory_limit > held ? device_memory_limit - held : 0);
+}
+
+void Handle::Finish() const
+{
+    clFinish(this->GetStream());
+    checkNumericsFlush(*this);
+}
 
 void Handle::Flush() const { clFlush(this->GetStream()); }
 
 bool Handle::IsProfilingEnabled() const { return this->impl->enable_profiling; }
 
+void Handle::ProfileBatch(const std::function<void()>& launches) const { launches(); }
+
+void Handle::ProfileLaunches(const std::function<void()>& launches) const { launches(); }
+
 std::size_t Handle::GetLocalMemorySize() const
 {
     return miopen::GetDeviceInfo<CL_DEVICE_LOCAL_MEM_SIZE>(miopen::GetDevice(this->GetStream()));
@@ -642,6 +835,31 @@ std::string Handle::GetDeviceName() const
     return GetDeviceNameFromMap(name);
 }
 
+std::string Handle::GetPciBusId() const
+{
+#ifdef CL_DEVICE_TOPOLOGY_AMD
+    cl_device_topology_amd topology{};
+    if(clGetDeviceInfo(miopen::GetDevice(this->GetStream()),
+                       CL_DEVICE_TOPOLOGY_AMD,
+                       sizeof(topology),
+                       &topology,
+                       nullptr) != CL_SUCCESS ||
+       topology.raw.type != CL_DEVICE_TOPOLOGY_TYPE_PCIE_AMD)
+        return {};
+    // The topology has no PCI domain, which is 0 on the systems MIOpen runs on.
+    char bus_id[16] = {};
+    std::snprintf(bus_id,
+                  sizeof(bus_id),
+                  "0000:%02x:%02x.%x",
+                  static_cast<unsigned char>(topology.pcie.bus),
+                  static_cast<unsigned char>(topology.pcie.device),
+                  static_cast<unsigned char>(topology.pcie.function));
+    return bus_id;
+#else
+    return {};
+#endif
+}
+
 std::ostream& Handle::Print(std::ostream& os) const
 {
     os << "stream: " << this->impl->queue.get() << ", device_id: " << this->impl->device;
@@ -672,11 +890,11 @@ std::size_t Handle::GetWavefrontWidth() const
         miopen::GetDevice(this->GetStream()));
 }
 
-Allocator::ManageDataPtr Handle::Create(std::size_t sz) const
+Allocator::ManageDataPtr Handle::Create(std::size_t sz, miopenAllocationHint_t hint) const
 {
     MIOPEN_HANDLE_LOCK
     this->Finish();
-    return this->impl->allocator(sz);
+    return this->impl->allocator(sz, hint, this->GetStream());
 }
 
 Allocator::ManageDataPtr&
@@ -694,17 +912,67 @@ Handle::WriteTo(const void* data, Allocator::ManageDataPtr& ddata, std::size_t s
 }
 
 void Handle::ReadTo(void* data, const Allocator::ManageDataPtr& ddata, std::size_t sz) const
+{
+    this->ReadTo(data, ddata.get(), sz);
+}
+
+void Handle::ReadTo(void* data, ConstData_t ddata, std::size_t sz) const
 {
     MIOPEN_HANDLE_LOCK
     this->Finish();
-    auto status = clEnqueueReadBuffer(
-        this->GetStream(), ddata.get(), CL_TRUE, 0, sz, data, 0, nullptr, nullptr);
+    auto status =
+        clEnqueueReadBuffer(this->GetStream(), ddata, CL_TRUE, 0, sz, data, 0, nullptr, nullptr);
+    if(status != CL_SUCCESS)
+    {
+        MIOPEN_THROW_CL_STATUS(status, "OpenCL error reading from buffer: " + std::to_string(sz));
+    }
+}
+
+void Handle::WriteToAsync(const void* data, Data_t ddata, std::size_t sz) const
+{
+    MIOPEN_HANDLE_LOCK
+    auto status =
+        clEnqueueWriteBuffer(this->GetStream(), ddata, CL_FALSE, 0, sz, data, 0, nullptr, nullptr);
+    if(status != CL_SUCCESS)
+    {
+        MIOPEN_THROW_CL_STATUS(status, "OpenCL error writing to buffer: " + std::to_string(sz));
+    }
+}
+
+void Handle::ReadToAsync(void* data, ConstData_t ddata, std::size_t sz) const
+{
+    MIOPEN_HANDLE_LOCK
+    auto status =
+        clEnqueueReadBuffer(this->GetStream(), ddata, CL_FALSE, 0, sz, data, 0, nullptr, nullptr);
     if(status != CL_SUCCESS)
     {
         MIOPEN_THROW_CL_STATUS(status, "OpenCL error reading from buffer: " + std::to_string(sz));
     }
 }
 
+StreamEvent Handle::RecordEvent() const
+{
+    cl_event event = nullptr;
+    auto status    = clEnqueueMarkerWithWaitList(this->GetStream(), 0, nullptr, &event);
+    if(status != CL_SUCCESS)
+    {
+        MIOPEN_THROW_CL_STATUS(status, "OpenCL error enqueueing a marker");
+    }
+    return {std::shared_ptr<void>(event, [](cl_event e) { clReleaseEvent(e); })};
+}
+
+void Handle::WaitFor(const StreamEvent& event) const
+{
+    if(!event.impl)
+        return;
+    auto cl_ev  = static_cast<cl_event>(event.impl.get());
+    auto status = clEnqueueBarrierWithWaitList(this->GetStream(), 1, &cl_ev, nullptr);
+    if(status != CL_SUCCESS)
+    {
+        MIOPEN_THROW_CL_STATUS(status, "OpenCL error enqueueing a barrier");
+    }
+}
+
 void Handle::Copy(ConstData_t src, Data_t dest, std::size_t size) const
 {
     MIOPEN_HANDLE_LOCK
@@ -728,6 +996,10 @@ shared<Data_t> Handle::CreateSubBuffer(Data_t data, std::size_t offset, std::siz
     cl_int error = 0;
     auto r       = region{offset, size};
     auto mem = clCreateSubBuffer(data, CL_MEM_READ_WRITE, CL_BUFFER_CREATE_TYPE_REGION, &r, &error);
+    if(error != CL_SUCCESS)
+        MIOPEN_THROW_CL_STATUS(error,
+                               "OpenCL error creating sub-buffer: " + std::to_string(offset) + ", " +
+                                   std::to_string(size));
     return {mem, manage_deleter<decltype(&clReleaseMemObject), &clReleaseMemObject>{}};
 }
 
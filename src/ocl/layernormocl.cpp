@@ -0,0 +1,262 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/layernorm.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/kernel_cache.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/tensor.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <string>
+
+namespace miopen {
+
+namespace {
+
+// The work-groups of MIOpenLayerNormBwdWeights are LN_COLS x LN_ROW_LANES work-items.
+constexpr std::size_t ln_cols      = 64;
+constexpr std::size_t ln_row_lanes = 4;
+
+struct LayerNormShape
+{
+    std::size_t outer; // rows
+    std::size_t inner; // elements of a row
+};
+
+LayerNormShape GetLayerNormShape(const TensorDescriptor& xDesc, int normalized_dim)
+{
+    const auto& lengths = xDesc.GetLengths();
+    if(normalized_dim <= 0 || normalized_dim >= static_cast<int>(lengths.size()))
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "Layer normalization needs at least one row dimension and one normalized "
+                     "dimension");
+
+    const auto split = lengths.begin() + normalized_dim;
+    const LayerNormShape shape{
+        std::accumulate(lengths.begin(), split, std::size_t{1}, std::multiplies<std::size_t>{}),
+        std::accumulate(split, lengths.end(), std::size_t{1}, std::multiplies<std::size_t>{})};
+
+    if(shape.inner > std::numeric_limits<unsigned>::max() ||
+       shape.outer > std::numeric_limits<unsigned>::max())
+        MIOPEN_THROW(miopenStatusBadParm, "Layer normalization tensor is too large");
+    return shape;
+}
+
+void CheckLayerNormData(const TensorDescriptor& xDesc, const TensorDescriptor& desc)
+{
+    if(xDesc.GetType() != miopenFloat && xDesc.GetType() != miopenHalf)
+        MIOPEN_THROW(miopenStatusBadParm, "Layer normalization supports fp32 and fp16 only");
+    if(desc.GetType() != xDesc.GetType() || desc.GetLengths() != xDesc.GetLengths())
+        MIOPEN_THROW(miopenStatusBadParm, "Layer normalization tensors differ");
+    if(!xDesc.IsPacked() || !desc.IsPacked())
+        MIOPEN_THROW(miopenStatusBadParm, "Layer normalization takes packed tensors");
+}
+
+/// weight, bias, mean and rstd are of the data type of x, or fp32 for fp16 x as in batch
+/// normalization. Returns true for the latter.
+bool CheckLayerNormParams(const TensorDescriptor& xDesc,
+                          const TensorDescriptor* weightDesc,
+                          const TensorDescriptor* meanDesc,
+                          const LayerNormShape& shape)
+{
+    if(weightDesc != nullptr &&
+       (!weightDesc->IsPacked() || weightDesc->GetElementSize() != shape.inner))
+        MIOPEN_THROW(miopenStatusBadParm, "Layer normalization needs one weight per row element");
+    if(meanDesc != nullptr && (!meanDesc->IsPacked() || meanDesc->GetElementSize() != shape.outer))
+        MIOPEN_THROW(miopenStatusBadParm, "Layer normalization needs one mean per row");
+    if(weightDesc != nullptr && meanDesc != nullptr && weightDesc->GetType() != meanDesc->GetType())
+        MIOPEN_THROW(miopenStatusBadParm, "Layer normalization weight and mean differ in type");
+
+    const auto params = weightDesc != nullptr ? weightDesc : meanDesc;
+    if(params == nullptr || params->GetType() == xDesc.GetType())
+        return false;
+    if(xDesc.GetType() == miopenHalf && params->GetType() == miopenFloat)
+        return true;
+    MIOPEN_THROW(miopenStatusBadParm, "Unsupported layer normalization parameter type");
+}
+
+std::string GetLayerNormTypeParams(miopenDataType_t type, bool mix)
+{
+    return " -DMIOPEN_USE_FP16=" + std::to_string(int(type == miopenHalf && !mix)) +
+           " -DMIOPEN_USE_FP32=" + std::to_string(int(type == miopenFloat)) +
+           " -DMIOPEN_USE_FPMIX=" + std::to_string(int(mix));
+}
+
+/// One work-group per row, halved down to a wave for short rows.
+std::size_t GetLayerNormLocalSize(std::size_t inner)
+{
+    std::size_t local = 256;
+    while(local > 64 && local / 2 >= inner)
+        local /= 2;
+    return local;
+}
+
+KernelInvoke GetLayerNormKernel(const Handle& handle,
+                                const std::string& network_config,
+                                const std::string& kernel_name,
+                                std::size_t local,
+                                std::size_t global,
+                                const std::string& params)
+{
+    const std::string algo_name = "miopenLayerNorm";
+    auto&& kernels              = handle.GetKernels(algo_name, network_config);
+    if(!kernels.empty())
+        return kernels.front();
+    return handle.AddKernel(algo_name,
+                            network_config,
+                            "MIOpenLayerNorm.cl",
+                            kernel_name,
+                            {local, 1, 1},
+                            {global, 1, 1},
+                            params);
+}
+
+} // namespace
+
+void LayerNormForward(const Handle& handle,
+                      const TensorDescriptor& xDesc,
+                      ConstData_t x,
+                      const TensorDescriptor* weightDesc,
+                      ConstData_t weight,
+                      ConstData_t bias,
+                      float epsilon,
+                      int normalized_dim,
+                      const TensorDescriptor& yDesc,
+                      Data_t y,
+                      const TensorDescriptor* meanDesc,
+                      Data_t mean,
+                      Data_t rstd)
+{
+    if(x == nullptr || y == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm);
+
+    CheckLayerNormData(xDesc, yDesc);
+    const auto shape = GetLayerNormShape(xDesc, normalized_dim);
+    const bool mix   = CheckLayerNormParams(xDesc, weightDesc, meanDesc, shape);
+    if(shape.outer == 0 || shape.inner == 0)
+        return;
+
+    const bool affine     = weight != nullptr;
+    const bool save_stats = mean != nullptr;
+    const auto local      = GetLayerNormLocalSize(shape.inner);
+
+    const auto network_config = "fwd-" + std::to_string(xDesc.GetType()) + "-m" +
+                                std::to_string(int(mix)) + "-l" + std::to_string(local) + "-a" +
+                                std::to_string(int(affine)) + "-s" +
+                                std::to_string(int(save_stats)) + "-n" +
+                                std::to_string(shape.outer);
+    const auto params = GetLayerNormTypeParams(xDesc.GetType(), mix) + " -DLN_LOCAL=" +
+                        std::to_string(local) + " -DLN_AFFINE=" + std::to_string(int(affine)) +
+                        " -DLN_SAVE_STATS=" + std::to_string(int(save_stats));
+
+    auto kernel = GetLayerNormKernel(
+        handle, network_config, "MIOpenLayerNormFwd", local, shape.outer * local, params);
+
+    // The buffers a variant does not use point to the input, so the kernel gets valid ones.
+    kernel(x,
+           y,
+           affine ? weight : x,
+           affine ? bias : x,
+           save_stats ? mean : y,
+           save_stats ? rstd : y,
+           epsilon,
+           static_cast<unsigned>(shape.inner));
+}
+
+void LayerNormBackward(const Handle& handle,
+                       const TensorDescriptor& xDesc,
+                       ConstData_t x,
+                       const TensorDescriptor& dyDesc,
+                       ConstData_t dy,
+                       const TensorDescriptor* weightDesc,
+                       ConstData_t weight,
+                       const TensorDescriptor& meanDesc,
+                       ConstData_t mean,
+                       ConstData_t rstd,
+                       int normalized_dim,
+                       const TensorDescriptor& dxDesc,
+                       Data_t dx,
+                       Data_t dweight,
+                       Data_t dbias)
+{
+    if(x == nullptr || dy == nullptr || mean == nullptr || rstd == nullptr || dx == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm);
+
+    CheckLayerNormData(xDesc, dyDesc);
+    CheckLayerNormData(xDesc, dxDesc);
+    const auto shape = GetLayerNormShape(xDesc, normalized_dim);
+    const bool mix   = CheckLayerNormParams(xDesc, weightDesc, &meanDesc, shape);
+    if(shape.outer == 0 || shape.inner == 0)
+        return;
+
+    const bool affine = weight != nullptr;
+    const auto local  = GetLayerNormLocalSize(shape.inner);
+    const auto types  = GetLayerNormTypeParams(xDesc.GetType(), mix);
+    const auto type_config =
+        std::to_string(xDesc.GetType()) + "-m" + std::to_string(int(mix)) + "-n";
+
+    const auto network_config = "bwd-" + type_config + std::to_string(shape.outer) + "-l" +
+                                std::to_string(local) + "-a" + std::to_string(int(affine));
+    const auto params = types + " -DLN_LOCAL=" + std::to_string(local) + " -DLN_AFFINE=" +
+                        std::to_string(int(affine));
+
+    auto kernel = GetLayerNormKernel(
+        handle, network_config, "MIOpenLayerNormBwd", local, shape.outer * local, params);
+    kernel(x, dy, affine ? weight : x, mean, rstd, dx, static_cast<unsigned>(shape.inner));
+
+    if(dweight == nullptr)
+        return;
+
+    const auto col_groups     = (shape.inner + ln_cols - 1) / ln_cols;
+    const auto weights_config = "bwd-w-" + type_config + std::to_string(col_groups);
+    const auto weights_params = types + " -DLN_COLS=" + std::to_string(ln_cols) +
+                                " -DLN_ROW_LANES=" + std::to_string(ln_row_lanes);
+
+    auto weights_kernel = GetLayerNormKernel(handle,
+                                             weights_config,
+                                             "MIOpenLayerNormBwdWeights",
+                                             ln_cols * ln_row_lanes,
+                                             col_groups * ln_cols * ln_row_lanes,
+                                             weights_params);
+
+    const auto dx_time = handle.IsProfilingEnabled() ? handle.GetKernelTime() : 0.f;
+    weights_kernel(x,
+                   dy,
+                   mean,
+                   rstd,
+                   dweight,
+                   dbias,
+                   static_cast<unsigned>(shape.outer),
+                   static_cast<unsigned>(shape.inner));
+    if(handle.IsProfilingEnabled())
+        handle.AccumKernelTime(dx_time);
+}
+
+} // namespace miopen
@@ -0,0 +1,178 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/linear.hpp>
+#include <miopen/activ.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/gemm_v2.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/kernel_cache.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/tensor.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+// The ops of MIOpenConvEpilogue.cl.
+static constexpr int epilogue_bias  = 1;
+static constexpr int epilogue_activ = 2;
+
+void LinearForward(const Handle& handle,
+                   const TensorDescriptor& xDesc,
+                   ConstData_t x,
+                   const TensorDescriptor& wDesc,
+                   ConstData_t w,
+                   const TensorDescriptor* bDesc,
+                   ConstData_t b,
+                   const ActivationDescriptor* activDesc,
+                   const TensorDescriptor& yDesc,
+                   Data_t y)
+{
+    if(x == nullptr || w == nullptr || y == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm);
+
+    const auto data_type = yDesc.GetType();
+    if(data_type != miopenFloat && data_type != miopenHalf)
+        MIOPEN_THROW(miopenStatusBadParm, "The linear layer supports fp32 and fp16 only");
+    if(xDesc.GetType() != data_type || wDesc.GetType() != data_type ||
+       (bDesc != nullptr && bDesc->GetType() != data_type))
+        MIOPEN_THROW(miopenStatusBadParm, "The tensors of the linear layer differ in data type");
+    if(xDesc.GetSize() != 2 || wDesc.GetSize() != 2 || yDesc.GetSize() != 2)
+        MIOPEN_THROW(miopenStatusBadParm, "The linear layer takes 2D tensors");
+    if(!xDesc.IsPacked() || !wDesc.IsPacked() || !yDesc.IsPacked() ||
+       (bDesc != nullptr && !bDesc->IsPacked()))
+        MIOPEN_THROW(miopenStatusBadParm, "The linear layer takes packed tensors");
+
+    const auto m = xDesc.GetLengths()[0];
+    const auto k = xDesc.GetLengths()[1];
+    const auto n = wDesc.GetLengths()[0];
+    if(wDesc.GetLengths()[1] != k || yDesc.GetLengths()[0] != m || yDesc.GetLengths()[1] != n)
+        MIOPEN_THROW(miopenStatusBadParm, "The tensors of the linear layer differ in size");
+    if(bDesc != nullptr && bDesc->GetElementSize() != n)
+        MIOPEN_THROW(miopenStatusBadParm, "The linear layer needs one bias value per output");
+
+#if MIOPEN_USE_GEMM
+    // y = x * w^T, row-major
+    GemmDescriptor gemm_desc{false,
+                             false,
+                             true,
+                             static_cast<int>(m),
+                             static_cast<int>(n),
+                             static_cast<int>(k),
+                             static_cast<int>(k),
+                             static_cast<int>(k),
+                             static_cast<int>(n),
+                             1,
+                             static_cast<long long>(m * k),
+                             static_cast<long long>(n * k),
+                             static_cast<long long>(m * n),
+                             1.0f,
+                             0.0f,
+                             data_type};
+
+    const auto gemm_status = CallGemm(handle, gemm_desc, x, 0, w, 0, y, 0, nullptr, false);
+    if(gemm_status != miopenStatusSuccess)
+        MIOPEN_THROW(gemm_status, "GEMM of the linear layer failed");
+#else
+    MIOPEN_THROW(miopenStatusNotImplemented, "The linear layer needs a GEMM library");
+#endif
+
+    const bool use_activ = activDesc != nullptr && activDesc->GetMode() != miopenActivationPASTHRU;
+    if(b == nullptr && !use_activ)
+        return;
+
+    // Bias and activation are one in-place pass of the fusion epilogue kernel over y, with a
+    // channel per column.
+    std::vector<int> ops;
+    if(b != nullptr)
+        ops.push_back(epilogue_bias);
+    if(use_activ)
+        ops.push_back(epilogue_activ);
+
+    const std::size_t local = 256;
+    const auto n_elems      = m * n;
+    const auto max_groups   = static_cast<std::size_t>(handle.GetMaxComputeUnits()) * 8;
+    const auto global       = std::min((n_elems + local - 1) / local, max_groups) * local;
+
+    std::string network_config = "linear-" + std::to_string(data_type) + "-" +
+                                 std::to_string(global) + "-b" + std::to_string(b != nullptr);
+    std::string params = " -DMIOPEN_USE_FP16=" + std::to_string(int(data_type == miopenHalf)) +
+                         " -DMIOPEN_USE_FP32=" + std::to_string(int(data_type == miopenFloat)) +
+                         " -DMIOPEN_EPILOGUE_SLOTS=" + std::to_string(ops.size());
+    for(std::size_t slot = 0; slot < ops.size(); slot++)
+    {
+        params += " -DMIOPEN_EPILOGUE_OP" + std::to_string(slot) + "=" + std::to_string(ops[slot]);
+        if(ops[slot] != epilogue_activ)
+            continue;
+        const auto mode = std::to_string(activDesc->GetMode());
+        params += " -DMIOPEN_EPILOGUE_MODE" + std::to_string(slot) + "=" + mode;
+        network_config += "-a" + mode;
+    }
+
+    const std::string algo_name = "miopenLinearForward";
+    auto&& kernels              = handle.GetKernels(algo_name, network_config);
+    auto kernel                 = !kernels.empty() ? kernels.front()
+                                   : handle.AddKernel(algo_name,
+                                                      network_config,
+                                                      "MIOpenConvEpilogue.cl",
+                                                      "MIOpenConvEpilogue",
+                                                      {local, 1, 1},
+                                                      {global, 1, 1},
+                                                      params);
+
+    std::vector<OpKernelArg> args;
+    args.emplace_back(y);
+    args.emplace_back(static_cast<unsigned>(n_elems));
+    args.emplace_back(1u);
+    args.emplace_back(static_cast<unsigned>(n));
+    args.emplace_back(y);
+    args.insert(args.end(), 4, OpKernelArg(0u));
+    for(const auto op : ops)
+    {
+        // The unused tensors of a slot point to the output, so the kernel gets valid buffers.
+        const ConstData_t p = op == epilogue_bias ? b : y;
+        args.insert(args.end(), {OpKernelArg(p), OpKernelArg(y), OpKernelArg(y), OpKernelArg(y)});
+        if(op == epilogue_activ)
+        {
+            args.emplace_back(static_cast<float>(activDesc->GetAlpha()));
+            args.emplace_back(static_cast<float>(activDesc->GetBeta()));
+            args.emplace_back(static_cast<float>(activDesc->GetGamma()));
+        }
+        else
+        {
+            args.insert(args.end(), 3, OpKernelArg(0.f));
+        }
+    }
+
+    const auto gemm_time = handle.IsProfilingEnabled() ? handle.GetKernelTime() : 0.f;
+    kernel(args);
+    if(handle.IsProfilingEnabled())
+        handle.AccumKernelTime(gemm_time);
+}
+
+} // namespace miopen
@@ -290,7 +290,9 @@ miopenStatus_t LRNDescriptor::Backward(Handle& handle,
         std::to_string(nIn) + std::to_string(nOut) + std::to_string(cInStride) +
         std::to_string(cOutStride) + std::to_string(cIn) + std::to_string(cOut) +
         std::to_string(hInStride) + std::to_string(hOutStride) + std::to_string(hIn) +
-        std::to_string(hOut) + std::to_string(wIn) + std::to_string(wOut);
+        std::to_string(hOut) + std::to_string(wIn) + std::to_string(wOut) +
+        std::to_string(ndInStride) + std::to_string(ndOutStride) + std::to_string(cdInStride) +
+        std::to_string(cdOutStride) + std::to_string(hdInStride) + std::to_string(hdOutStride);
 
     auto&& kernels = handle.GetKernels(algo_name, network_config);
     if(!kernels.empty())
@@ -309,10 +309,42 @@ int mlo_construct_norm::mloConstructBwd()
     _out_pix_tile1 = 1;
     _grp_tile0     = 8;
     _grp_tile1     = 8;
+    // across channels, contiguous maps are flattened and walked READ_UNIT pixels per work-item
+    int MAP_SZ4   = _in_df_width * _in_df_height;
+    int read_unit = 0;
     if(_norm_region == MLO_LRN_ACROSS_CHANNELS)
     {
         _grp_tile0 = (_in_df_width <= 8) ? 8 : 16;
         _grp_tile1 = (_in_df_height <= 8) ? 8 : 16;
+
+        bool maps_contiguous = _in_df_stride == _in_df_width && _out_df_stride == _in_df_width &&
+                               _search_params.in_stride == _in_df_width &&
+                               _search_params.out_stride == _in_df_width;
+        auto is_aligned = [&](int unit) {
+            return MAP_SZ4 % unit == 0 && _in_df_channel_stride % unit == 0 &&
+                   _in_df_batch_stride % unit == 0 && _out_df_channel_stride % unit == 0 &&
+                   _out_df_batch_stride % unit == 0 &&
+                   _search_params.in_channel_stride % unit == 0 &&
+                   _search_params.in_batch_stride % unit == 0 &&
+                   _search_params.out_channel_stride % unit == 0 &&
+                   _search_params.out_batch_stride % unit == 0;
+        };
+
+        if(maps_contiguous)
+        {
+            read_unit = is_aligned(4) ? 4 : is_aligned(2) ? 2 : 1;
+
+            // Workaround for ROCm 1.8.2 compiler issue (#1057).
+            if(_search_params.in_data_type == miopenHalf &&
+               _search_params.GetStream().GetDeviceName().find("gfx9") != std::string::npos)
+            {
+                read_unit = 1;
+            }
+
+            MAP_SZ4 /= read_unit;
+            _grp_tile0 = 8 * 8;
+            _grp_tile1 = 1;
+        }
     }
     else
     {
@@ -394,6 +426,19 @@ int mlo_construct_norm::mloConstructBwd()
         std::string(" -DMLO_LRN_N_OUTPUTS=") +
         std::to_string(static_cast<long long>(_search_params.n_outputs)) + getGeneralCompOptions();
 
+    if(read_unit > 0)
+    {
+        std::string READ_TYPE = (read_unit == 1)
+                                    ? "_FLOAT"
+                                    : "_FLOAT" + std::to_string(static_cast<long long>(read_unit));
+
+        _comp_options += std::string(" -DMLO_MAP_SZ4=") +
+                         std::to_string(static_cast<long long>(MAP_SZ4)) +
+                         std::string(" -DMLO_READ_TYPE=") + READ_TYPE +
+                         std::string(" -DMLO_READ_UNIT=") +
+                         std::to_string(static_cast<long long>(read_unit));
+    }
+
     _kernel_file = "MIOpenLRNBwd.cl";
 
     _l_wk.clear();
@@ -402,7 +447,14 @@ int mlo_construct_norm::mloConstructBwd()
     _l_wk.push_back(_grp_tile1);
     _l_wk.push_back(1);
 
-    if(_norm_region == MLO_LRN_ACROSS_CHANNELS)
+    if(read_unit > 0)
+    {
+        _g_wk.push_back(((MAP_SZ4 + _grp_tile0 - 1) / _grp_tile0) * _grp_tile0);
+        _g_wk.push_back(1);
+        _g_wk.push_back(_search_params.batch_sz);
+        _kernel_name = "MIOpenLRNAcrossChannelsBwd4";
+    }
+    else if(_norm_region == MLO_LRN_ACROSS_CHANNELS)
     {
         _g_wk.push_back(_in_df_width);
         _g_wk.push_back(_in_df_height);
@@ -0,0 +1,224 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/optimizer.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/kernel_cache.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/workspace_arena.hpp>
+#include <miopen/datatype.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <string>
+#include <utility>
+
+namespace miopen {
+
+// must match MT_FOR_SLOTS of MIOpenTensorKernels.cl
+static constexpr std::size_t mt_slots = 16;
+
+using MultiTensorSlots = std::array<Data_t, mt_slots>;
+
+template <class Kernel, std::size_t... Is, class... Ts>
+static void RunMultiTensorKernel(const Kernel& kernel,
+                                 const MultiTensorSlots& p,
+                                 const std::array<ConstData_t, mt_slots>& g,
+                                 const MultiTensorSlots& m,
+                                 const MultiTensorSlots& v,
+                                 const std::array<long, mt_slots>& n,
+                                 std::index_sequence<Is...>,
+                                 Ts... xs)
+{
+    kernel(p[Is]..., g[Is]..., m[Is]..., v[Is]..., n[Is]..., xs...);
+}
+
+void MultiTensorOptimizerUpdate(const Handle& handle,
+                                miopenOptimizerMode_t mode,
+                                miopenDataType_t dataType,
+                                const std::vector<size_t>& elementCounts,
+                                const std::vector<Data_t>& params,
+                                const std::vector<ConstData_t>& grads,
+                                const std::vector<Data_t>& expAvgs,
+                                const std::vector<Data_t>& expAvgSqs,
+                                float lr,
+                                float beta1,
+                                float beta2,
+                                float eps,
+                                float weightDecay,
+                                int step)
+{
+    if(dataType != miopenFloat && dataType != miopenHalf && dataType != miopenBFloat16)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Unsupported data type for the optimizer update");
+    }
+    if(mode < miopenOptimizerSGD || mode > miopenOptimizerLAMB)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Unknown optimizer mode");
+    }
+
+    const bool use_m     = mode != miopenOptimizerSGD;
+    const bool use_v     = mode == miopenOptimizerAdam || mode == miopenOptimizerLAMB;
+    const auto n_tensors = elementCounts.size();
+    if(params.size() != n_tensors || grads.size() != n_tensors ||
+       (use_m && expAvgs.size() != n_tensors) || (use_v && expAvgSqs.size() != n_tensors))
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Tensor lists of the optimizer update differ in length");
+    }
+    if(use_v && step < 1)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "The step of Adam and LAMB starts at 1");
+    }
+
+    const float bc1 = use_v ? 1.0f - std::pow(beta1, float(step)) : 1.0f;
+    const float bc2 = use_v ? 1.0f - std::pow(beta2, float(step)) : 1.0f;
+
+    const size_t local_threads = 256;
+    const size_t max_num_wg    = 4096;
+    const size_t lamb_groups   = 32;
+
+    std::string params_str = " -DMIOPEN_TYPE=" + GetKernelStorageType(dataType) +
+                             " -DUSE_MULTI_TENSOR_OPTIMIZER -DMT_MODE=" + std::to_string(mode) +
+                             " -DMT_LOCAL_SIZE=" + std::to_string(local_threads) +
+                             " -DMT_LAMB_GROUPS=" + std::to_string(lamb_groups);
+    params_str += GetDataTypeKernelParams(dataType);
+
+    // per work-group partial sums of w^2 and r^2 of the LAMB trust ratio
+    Allocator::ManageDataPtr local_norms;
+    constexpr auto slot   = WorkspaceArena::Slot::MultiTensor;
+    const auto norms_size = 2 * lamb_groups * mt_slots * sizeof(float);
+    const bool use_lamb   = mode == miopenOptimizerLAMB;
+    if(use_lamb && !handle.IsWorkspaceArenaEnabled())
+        local_norms = handle.Create(norms_size, miopenAllocationScratch);
+    auto& norms_d = handle.IsWorkspaceArenaEnabled() && use_lamb
+                        ? handle.GetArenaBuffer(slot, norms_size)
+                        : local_norms;
+
+    for(std::size_t first = 0; first < n_tensors; first += mt_slots)
+    {
+        const auto last = std::min(first + mt_slots, n_tensors);
+
+        // unused slots get 0 elements and point to a valid buffer
+        MultiTensorSlots p, m, v;
+        std::array<ConstData_t, mt_slots> g;
+        std::array<long, mt_slots> n{};
+        p.fill(params[first]);
+        g.fill(params[first]);
+        m.fill(params[first]);
+        v.fill(params[first]);
+        for(auto i = first; i < last; i++)
+        {
+            p[i - first] = params[i];
+            g[i - first] = grads[i];
+            if(use_m)
+                m[i - first] = expAvgs[i];
+            if(use_v)
+                v[i - first] = expAvgSqs[i];
+            n[i - first] = static_cast<long>(elementCounts[i]);
+        }
+
+        const long total_work = std::accumulate(n.begin(), n.end(), 0L);
+        if(total_work == 0)
+            continue;
+
+        const std::vector<size_t> vld{local_threads, 1, 1};
+        const auto slots = std::make_index_sequence<mt_slots>{};
+
+        if(!use_lamb)
+        {
+            size_t grp_sz = std::min(max_num_wg, (total_work + local_threads - 1) / local_threads);
+            const std::vector<size_t> vgd{grp_sz * local_threads, 1, 1};
+
+            std::string kernel_name    = "MultiTensorOptimizer";
+            std::string network_config = "mt-" + std::to_string(mode) + "-" +
+                                         std::to_string(dataType) + "-" + std::to_string(vgd[0]);
+
+            auto&& kernels = handle.GetKernels(kernel_name, network_config);
+            auto kernel    = !kernels.empty() ? kernels.front()
+                                           : handle.AddKernel(kernel_name,
+                                                              network_config,
+                                                              "MIOpenTensorKernels.cl",
+                                                              kernel_name,
+                                                              vld,
+                                                              vgd,
+                                                              params_str);
+
+            RunMultiTensorKernel(kernel,
+                                 p,
+                                 g,
+                                 m,
+                                 v,
+                                 n,
+                                 slots,
+                                 lr,
+                                 beta1,
+                                 beta2,
+                                 eps,
+                                 weightDecay,
+                                 bc1,
+                                 bc2,
+                                 total_work);
+            continue;
+        }
+
+        const std::vector<size_t> vgd{local_threads * lamb_groups * mt_slots, 1, 1};
+        for(const std::string kernel_name : {"MultiTensorLambNorms", "MultiTensorLambApply"})
+        {
+            std::string network_config = "mt-" + std::to_string(mode) + "-" +
+                                         std::to_string(dataType) + "-" + std::to_string(vgd[0]);
+
+            auto&& kernels = handle.GetKernels(kernel_name, network_config);
+            auto kernel    = !kernels.empty() ? kernels.front()
+                                           : handle.AddKernel(kernel_name,
+                                                              network_config,
+                                                              "MIOpenTensorKernels.cl",
+                                                              kernel_name,
+                                                              vld,
+                                                              vgd,
+                                                              params_str);
+
+            RunMultiTensorKernel(kernel,
+                                 p,
+                                 g,
+                                 m,
+                                 v,
+                                 n,
+                                 slots,
+                                 lr,
+                                 beta1,
+                                 beta2,
+                                 eps,
+                                 weightDecay,
+                                 bc1,
+                                 bc2,
+                                 norms_d.get());
+        }
+    }
+}
+
+} // namespace miopen
@@ -29,6 +29,9 @@
 #include <miopen/float_equal.hpp>
 #include <miopen/check_numerics.hpp>
 #include <miopen/datatype.hpp>
+#include <miopen/env.hpp>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_POOLING_BWD_TILED)
 
 namespace miopen {
 
@@ -88,12 +91,57 @@ std::string get_vect_config(std::vector<T> v)
     return str;
 }
 
+// LDS budget of the tiled ND backward kernels
+#define MAX_POOLING_BWD_TILE_LDS 32768
+
+// Bottom block {d, h, w} of the tiled ND backward kernels: a row segment as long as the image
+// allows up to 64 columns, then rows and slices up to one pixel per work-item. Empty when the top
+// values of the windows reaching a block do not fit in LDS.
+static std::vector<int> GetPoolingBwdNDTile(const std::vector<int>& bot_dims,
+                                            const std::vector<int>& lens,
+                                            const std::vector<int>& strides,
+                                            std::size_t top_elem_size,
+                                            int group_size)
+{
+    auto next_pow2 = [](int v) { return v <= 1 ? 1 : 2 * prePow2(v - 1); };
+
+    const int tile_w = std::min(std::max(next_pow2(bot_dims[2]), 8), 64);
+    const int tile_h = std::min(next_pow2(bot_dims[1]), group_size / tile_w);
+    const int tile_d =
+        std::max(std::min(next_pow2(bot_dims[0]), group_size / (tile_w * tile_h)), 1);
+    const std::vector<int> tile{tile_d, tile_h, tile_w};
+
+    std::size_t top_size = 1;
+    for(std::size_t i = 0; i < tile.size(); i++)
+        top_size *= (tile[i] + lens[i] - 2) / strides[i] + 1;
+
+    if(top_size * top_elem_size > MAX_POOLING_BWD_TILE_LDS)
+        return {};
+    return tile;
+}
+
+// int8x4 keeps four consecutive channels in each element, so its kernels see a tensor of char4
+// pixels with C / 4 channels.
+static TensorDescriptor GetInt8x4PixelDesc(const TensorDescriptor& desc)
+{
+    if(!desc.IsPacked())
+        MIOPEN_THROW(miopenStatusBadParm, "int8x4 pooling requires packed tensors");
+
+    auto lens    = desc.GetLengths();
+    auto strides = desc.GetStrides();
+    if(lens[1] % 4 != 0)
+        MIOPEN_THROW(miopenStatusBadParm, "int8x4 pooling requires a multiple of 4 channels");
+    lens[1] /= 4;
+    strides[0] /= 4;
+    return {miopenInt8x4, lens, strides};
+}
+
 miopenStatus_t PoolingDescriptor::Forward(Handle& handle,
                                           const void* alpha,
-                                          const TensorDescriptor& xDesc,
+                                          const TensorDescriptor& xDescIn,
                                           ConstData_t x,
                                           const void* beta,
-                                          const TensorDescriptor& yDesc,
+                                          const TensorDescriptor& yDescIn,
                                           Data_t y,
                                           bool save_index,
                                           Data_t workSpace,
@@ -107,18 +155,40 @@ miopenStatus_t PoolingDescriptor::Forward(Handle& handle,
     }
     if(miopen::CheckNumericsEnabled())
     {
-        miopen::checkNumericsInput(handle, xDesc, x);
+        miopen::checkNumericsInput(handle, xDescIn, x);
         if(!float_equal(*(static_cast<const float*>(beta)), 0))
         {
-            miopen::checkNumericsInput(handle, yDesc, y);
+            miopen::checkNumericsInput(handle, yDescIn, y);
         }
     }
 
-    int pool_dim = xDesc.GetSize();
+    int pool_dim = xDescIn.GetSize();
     if(pool_dim != 4 && pool_dim != 5)
     {
         MIOPEN_THROW("Unsupported pooling dimension");
     }
+    if(xDescIn.GetType() != yDescIn.GetType())
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Pooling input and output types must match");
+    }
+
+    // backward recomputes the max positions from x and y, so there is nothing to save
+    if(workspaceIndexMode == miopenPoolingWorkspaceIndexRecompute)
+        save_index = false;
+
+    const bool is_int8x4 = xDescIn.GetType() == miopenInt8x4;
+    if(is_int8x4 && mode == miopenPoolingMax && save_index)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "int8x4 max pooling does not save indices");
+    }
+    TensorDescriptor xPixelDesc, yPixelDesc;
+    if(is_int8x4)
+    {
+        xPixelDesc = GetInt8x4PixelDesc(xDescIn);
+        yPixelDesc = GetInt8x4PixelDesc(yDescIn);
+    }
+    const auto& xDesc = is_int8x4 ? xPixelDesc : xDescIn;
+    const auto& yDesc = is_int8x4 ? yPixelDesc : yDescIn;
 
     auto index_max = get_index_max(GetIndexType());
 
@@ -373,11 +443,11 @@ miopenStatus_t PoolingDescriptor::Forward(Handle& handle,
 miopenStatus_t PoolingDescriptor::Backward(Handle& handle,
                                            const void* alpha,
                                            const TensorDescriptor& yDesc,
-                                           ConstData_t /*y*/,
+                                           ConstData_t y,
                                            const TensorDescriptor& dyDesc,
                                            ConstData_t dy,
                                            const TensorDescriptor& xDesc,
-                                           ConstData_t /*x*/,
+                                           ConstData_t x,
                                            const void* beta,
                                            const TensorDescriptor& dxDesc,
                                            Data_t dx,
@@ -408,6 +478,15 @@ miopenStatus_t PoolingDescriptor::Backward(Handle& handle,
     {
         MIOPEN_THROW("Unsupported pooling dimension");
     }
+    if(dyDesc.GetType() == miopenInt8 || dyDesc.GetType() == miopenInt8x4)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Pooling backward does not support int8");
+    }
+
+    if(mode == miopenPoolingMax && workspaceIndexMode == miopenPoolingWorkspaceIndexRecompute)
+    {
+        return BackwardMaxRecompute(handle, yDesc, y, dyDesc, dy, xDesc, x, dxDesc, dx);
+    }
 
     miopenStatus_t status = miopenStatusSuccess;
 
@@ -472,6 +551,23 @@ miopenStatus_t PoolingDescriptor::Backward(Handle& handle,
     size_t lcl_work = 64;
     size_t grp_num  = (activ_work + lcl_work - 1) / lcl_work;
 
+    // 3D pooling gathers blocks of dx from the dy windows staged in LDS unless they do not fit.
+    const int tiled_lcl_work = 256;
+    std::vector<int> tile;
+    if(pool_dim == 5 && !miopen::IsDisabled(MIOPEN_DEBUG_POOLING_BWD_TILED{}))
+    {
+        const auto top_elem_size =
+            GetTypeSize(dyDesc.GetType()) +
+            (mode == miopenPoolingMax ? get_data_size(GetIndexType()) : 0);
+        tile = GetPoolingBwdNDTile(
+            {bot_d, bot_h, bot_w}, lens, strides, top_elem_size, tiled_lcl_work);
+    }
+    const bool use_tiled = !tile.empty();
+    const size_t tiled_blk_num =
+        use_tiled ? static_cast<size_t>((bot_d + tile[0] - 1) / tile[0]) *
+                        ((bot_h + tile[1] - 1) / tile[1]) * ((bot_w + tile[2] - 1) / tile[2])
+                  : 0;
+
     std::string network_config;
 
     if(pool_dim == 4)
@@ -499,6 +595,9 @@ miopenStatus_t PoolingDescriptor::Backward(Handle& handle,
                           std::to_string(static_cast<uint>(max_activ_workitem)) + "_lcl" +
                           std::to_string(static_cast<uint>(lcl_work)) + "_grp" +
                           std::to_string(static_cast<uint>(grp_num));
+        if(use_tiled)
+            network_config += "_tiled" + get_vect_config(tile) + "_blk" +
+                              std::to_string(tiled_blk_num) + "x" + std::to_string(batch * chal);
     }
 
     // printf("Pooling backward network_config: %s\n", network_config.c_str());
@@ -686,25 +785,43 @@ miopenStatus_t PoolingDescriptor::Backward(Handle& handle,
                 MIOPEN_THROW("Unknown backward pooling method");
             }
 
-            const std::vector<size_t> vld{lcl_work, 1, 1};
-            const std::vector<size_t> vgd{lcl_work * grp_num, 1, 1};
+            std::vector<size_t> vld{lcl_work, 1, 1};
+            std::vector<size_t> vgd{lcl_work * grp_num, 1, 1};
 
             std::string parms = std::string(" -DMLO_POOLING_OP_ID=") +
                                 std::to_string(static_cast<long long>(pooling_method));
 
-            parms += std::string(" -DMAX_ACTIV_WORKITEM=") +
-                     std::to_string(static_cast<uint>(max_activ_workitem));
-
-            parms += std::string(" -DMLO_POOLING_GROUP_SZ0=") +
-                     std::to_string(static_cast<long long>(lcl_work)) +
-                     std::string(" -DMLO_POOLING_GROUP_SZ1=1 -DMLO_POOLING_GROUP_SZ2=1");
-
-            parms += std::string(" -DPIX_W_PER_WORK=") +
-                     std::to_string(static_cast<uint>(pix_w_per_work)) +
-                     std::string(" -DPIX_H_PER_WORK=") +
-                     std::to_string(static_cast<uint>(pix_h_per_work)) +
-                     std::string(" -DPIX_D_PER_WORK=") +
-                     std::to_string(static_cast<uint>(pix_d_per_work));
+            if(use_tiled)
+            {
+                program_name = "MIOpenPoolingBwdNDTiled.cl";
+                kernel_name += "Tiled";
+                vld = {static_cast<size_t>(tiled_lcl_work), 1, 1};
+                vgd = {tiled_lcl_work * tiled_blk_num, static_cast<size_t>(batch * chal), 1};
+
+                parms += std::string(" -DMLO_POOLING_GROUP_SZ0=") +
+                         std::to_string(tiled_lcl_work) +
+                         std::string(" -DMLO_POOLING_GROUP_SZ1=1 -DMLO_POOLING_GROUP_SZ2=1");
+
+                parms += std::string(" -DPT_TILE_D=") + std::to_string(tile[0]) +
+                         std::string(" -DPT_TILE_H=") + std::to_string(tile[1]) +
+                         std::string(" -DPT_TILE_W=") + std::to_string(tile[2]);
+            }
+            else
+            {
+                parms += std::string(" -DMAX_ACTIV_WORKITEM=") +
+                         std::to_string(static_cast<uint>(max_activ_workitem));
+
+                parms += std::string(" -DMLO_POOLING_GROUP_SZ0=") +
+                         std::to_string(static_cast<long long>(lcl_work)) +
+                         std::string(" -DMLO_POOLING_GROUP_SZ1=1 -DMLO_POOLING_GROUP_SZ2=1");
+
+                parms += std::string(" -DPIX_W_PER_WORK=") +
+                         std::to_string(static_cast<uint>(pix_w_per_work)) +
+                         std::string(" -DPIX_H_PER_WORK=") +
+                         std::to_string(static_cast<uint>(pix_h_per_work)) +
+                         std::string(" -DPIX_D_PER_WORK=") +
+                         std::to_string(static_cast<uint>(pix_d_per_work));
+            }
 
             parms += std::string(" -DKERNEL_SZ_D=") + std::to_string(static_cast<uint>(lens[0])) +
                      std::string(" -DKERNEL_SZ_H=") + std::to_string(static_cast<uint>(lens[1])) +
@@ -791,4 +908,156 @@ miopenStatus_t PoolingDescriptor::Backward(Handle& handle,
 
     return (status);
 }
+
+miopenStatus_t PoolingDescriptor::BackwardMaxRecompute(Handle& handle,
+                                                       const TensorDescriptor& yDesc,
+                                                       ConstData_t y,
+                                                       const TensorDescriptor& dyDesc,
+                                                       ConstData_t dy,
+                                                       const TensorDescriptor& xDesc,
+                                                       ConstData_t x,
+                                                       const TensorDescriptor& dxDesc,
+                                                       Data_t dx) const
+{
+    if(x == nullptr || y == nullptr)
+    {
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "x and y cannot be NULL in Backward Pooling MAX recompute mode");
+    }
+    if(xDesc.GetStrides() != dxDesc.GetStrides() || yDesc.GetStrides() != dyDesc.GetStrides())
+    {
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "Backward Pooling MAX recompute mode requires x and dx, and y and dy, to "
+                     "have the same strides");
+    }
+
+    // 2D pooling runs as 3D pooling of depth 1
+    const int pool_dim = dyDesc.GetSize();
+    auto to_3d         = [&](const std::vector<int>& v, int unit) {
+        return pool_dim == 4 ? std::vector<int>{unit, v[0], v[1]} : v;
+    };
+    const auto ker_3d = to_3d(lens, 1);
+    const auto str_3d = to_3d(strides, 1);
+    const auto pad_3d = to_3d(pads, 0);
+
+    // {n, c, d, h, w} lengths and {n, c, d, h} strides
+    auto dims_3d = [&](const TensorDescriptor& desc) {
+        std::vector<int> v(desc.GetLengths().begin(), desc.GetLengths().end());
+        if(pool_dim == 4)
+            v.insert(v.begin() + 2, 1);
+        return v;
+    };
+    auto strides_3d = [&](const TensorDescriptor& desc) {
+        std::vector<int> v(desc.GetStrides().begin(), desc.GetStrides().end());
+        if(pool_dim == 4)
+            v.insert(v.begin() + 2, v[1]);
+        return v;
+    };
+    const auto bot_dims = dims_3d(dxDesc);
+    const auto top_dims = dims_3d(dyDesc);
+    const auto bot_strs = strides_3d(dxDesc);
+    const auto top_strs = strides_3d(dyDesc);
+
+    const int batch = bot_dims[0];
+    const int chal  = bot_dims[1];
+
+    int pix_w_per_work = 1;
+    int pix_h_per_work = pool_dim == 4 ? 8 : 4;
+    int pix_d_per_work = pool_dim == 4 ? 1 : 2;
+
+    int pix_blk_w = std::max((bot_dims[4] + pix_w_per_work - 1) / pix_w_per_work, 1);
+    int pix_blk_h = std::max((bot_dims[3] + pix_h_per_work - 1) / pix_h_per_work, 1);
+    int pix_blk_d = std::max((bot_dims[2] + pix_d_per_work - 1) / pix_d_per_work, 1);
+
+    int max_activ_workitem = 65536;
+    int total_work         = batch * chal * pix_blk_w * pix_blk_h * pix_blk_d;
+    int activ_work         = std::min(total_work, max_activ_workitem);
+
+    size_t lcl_work = 64;
+    size_t grp_num  = (activ_work + lcl_work - 1) / lcl_work;
+
+    std::string network_config =
+        "m" + std::to_string(MLO_POOLING_OP_MAX) + "_dt" + std::to_string(dyDesc.GetType()) +
+        "_ker" + get_vect_config(ker_3d) + "_str" + get_vect_config(str_3d) + "_wsidx" +
+        std::to_string(GetWorkspaceIndexMode()) + "_tile" + std::to_string(pix_d_per_work) + "x" +
+        std::to_string(pix_h_per_work) + "x" + std::to_string(pix_w_per_work) + "_maxwkitm" +
+        std::to_string(static_cast<uint>(max_activ_workitem)) + "_lcl" +
+        std::to_string(static_cast<uint>(lcl_work)) + "_grp" +
+        std::to_string(static_cast<uint>(grp_num));
+
+    std::string algo_name = "miopenPoolingNdBackward";
+
+    if(!handle.HasKernel(algo_name, network_config))
+    {
+        std::string program_name = "MIOpenPoolingBwdND.cl";
+        std::string kernel_name  = "mloPoolingNDMaxBwdRecompute";
+
+        const std::vector<size_t> vld{lcl_work, 1, 1};
+        const std::vector<size_t> vgd{lcl_work * grp_num, 1, 1};
+
+        std::string parms = std::string(" -DMLO_POOLING_OP_ID=") +
+                            std::to_string(static_cast<long long>(MLO_POOLING_OP_MAX));
+
+        parms += std::string(" -DMAX_ACTIV_WORKITEM=") +
+                 std::to_string(static_cast<uint>(max_activ_workitem));
+
+        parms += std::string(" -DMLO_POOLING_GROUP_SZ0=") +
+                 std::to_string(static_cast<long long>(lcl_work)) +
+                 std::string(" -DMLO_POOLING_GROUP_SZ1=1 -DMLO_POOLING_GROUP_SZ2=1");
+
+        parms += std::string(" -DPIX_W_PER_WORK=") +
+                 std::to_string(static_cast<uint>(pix_w_per_work)) +
+                 std::string(" -DPIX_H_PER_WORK=") +
+                 std::to_string(static_cast<uint>(pix_h_per_work)) +
+                 std::string(" -DPIX_D_PER_WORK=") +
+                 std::to_string(static_cast<uint>(pix_d_per_work));
+
+        parms += std::string(" -DKERNEL_SZ_D=") + std::to_string(static_cast<uint>(ker_3d[0])) +
+                 std::string(" -DKERNEL_SZ_H=") + std::to_string(static_cast<uint>(ker_3d[1])) +
+                 std::string(" -DKERNEL_SZ_W=") + std::to_string(static_cast<uint>(ker_3d[2])) +
+                 std::string(" -DSTRIDE_D=") + std::to_string(static_cast<uint>(str_3d[0])) +
+                 std::string(" -DSTRIDE_H=") + std::to_string(static_cast<uint>(str_3d[1])) +
+                 std::string(" -DSTRIDE_W=") + std::to_string(static_cast<uint>(str_3d[2]));
+
+        parms += std::string(" -DMLO_POOLING_INDEX_TYPE=") +
+                 get_pooling_index_type_name(GetIndexType()) +
+                 std::string(" -DMLO_POOLING_INDEX_MAX=") +
+                 get_pooling_index_type_max_name(GetIndexType()) +
+                 GetDataTypeKernelParams(dyDesc.GetType());
+
+        handle.AddKernel(algo_name, network_config, program_name, kernel_name, vld, vgd, parms);
+    }
+
+    handle.GetKernel(algo_name, network_config)(dy,
+                                                dx,
+                                                x,
+                                                y,
+                                                static_cast<uint>(pad_3d[0]),
+                                                static_cast<uint>(pad_3d[1]),
+                                                static_cast<uint>(pad_3d[2]),
+                                                static_cast<uint>(batch),
+                                                static_cast<uint>(chal),
+                                                static_cast<uint>(bot_dims[2]),
+                                                static_cast<uint>(bot_dims[3]),
+                                                static_cast<uint>(bot_dims[4]),
+                                                static_cast<uint>(top_dims[2]),
+                                                static_cast<uint>(top_dims[3]),
+                                                static_cast<uint>(top_dims[4]),
+                                                static_cast<uint>(bot_strs[0]),
+                                                static_cast<uint>(bot_strs[1]),
+                                                static_cast<uint>(bot_strs[2]),
+                                                static_cast<uint>(bot_strs[3]),
+                                                static_cast<uint>(top_strs[0]),
+                                                static_cast<uint>(top_strs[1]),
+                                                static_cast<uint>(top_strs[2]),
+                                                static_cast<uint>(top_strs[3]),
+                                                static_cast<uint>(total_work));
+
+    if(miopen::CheckNumericsEnabled())
+    {
+        miopen::checkNumericsOutput(handle, dxDesc, dx);
+    }
+
+    return miopenStatusSuccess;
+}
 } // namespace miopen
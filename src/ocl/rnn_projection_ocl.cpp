@@ -0,0 +1,1000 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/rnn.hpp>
+#include <miopen/rnn_util.hpp>
+
+#include <miopen/errors.hpp>
+#include <miopen/gemm_v2.hpp>
+#include <miopen/tensor_ops.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace miopen {
+
+namespace {
+
+// Offsets of the parameters and of the state of an LSTM whose hidden state is projected. The
+// rows of the reserve space (the workspace in inference) hold the gates, cells and hidden states
+// of all the directions as without projection, followed by the activated cells and then by the
+// projected states, which feed the next step and the next layer. The gradients of backward data
+// take the same places in the workspace.
+struct LSTMProjectionLayout
+{
+    LSTMProjectionLayout(const RNNDescriptor& rnn, int in_h_, int batch_n_)
+        : bi(rnn.dirMode == miopenRNNbidirection ? 2 : 1),
+          layers(static_cast<int>(rnn.nLayers)),
+          in_h(in_h_),
+          batch_n(batch_n_),
+          hy_h(static_cast<int>(rnn.hsize)),
+          pr_h(static_cast<int>(rnn.projSize)),
+          wei_len(4 * hy_h),
+          wei_stride(bi * wei_len),
+          hy_stride(bi * hy_h * static_cast<int>(rnn.workspaceScale)),
+          r_stride(bi * pr_h),
+          use_bias(rnn.biasMode == miopenRNNwithBias)
+    {
+    }
+
+    int bi, layers, in_h, batch_n, hy_h, pr_h, wei_len, wei_stride, hy_stride, r_stride;
+    bool use_bias;
+
+    int InputLen(int li) const { return li == 0 ? in_h : bi * pr_h; }
+
+    int InputWeights(int li) const
+    {
+        return li == 0 ? 0 : (in_h + pr_h + (li - 1) * (bi * pr_h + pr_h)) * wei_stride;
+    }
+
+    int HiddenWeights(int li, int ri) const
+    {
+        return InputWeights(li) + InputLen(li) * wei_stride + ri * wei_len * pr_h;
+    }
+
+    // The hidden biases are wei_stride past the input ones.
+    int Bias(int li, int ri) const
+    {
+        return InputWeights(layers) + li * 2 * wei_stride + ri * wei_len;
+    }
+
+    int Projection(int li, int ri) const
+    {
+        return InputWeights(layers) + (use_bias ? layers * 2 * wei_stride : 0) +
+               (li * bi + ri) * pr_h * hy_h;
+    }
+
+    int Gate(int li, int row, int ri, int gate) const
+    {
+        return (li * batch_n + row) * hy_stride + ri * wei_len + gate * hy_h;
+    }
+
+    int Cell(int li, int row, int ri) const
+    {
+        return (li * batch_n + row) * hy_stride + bi * wei_len + ri * hy_h;
+    }
+
+    int Hidden(int li, int row, int ri) const
+    {
+        return (li * batch_n + row) * hy_stride + bi * 5 * hy_h + ri * hy_h;
+    }
+
+    int ActivCell(int li, int row, int ri) const
+    {
+        return layers * batch_n * hy_stride + (li * batch_n + row) * bi * hy_h + ri * hy_h;
+    }
+
+    int Projected(int li, int row, int ri) const
+    {
+        return layers * batch_n * (hy_stride + bi * hy_h) + (li * batch_n + row) * r_stride +
+               ri * pr_h;
+    }
+
+    // Offsets of the rows of direction ri of the hidden state tensors.
+    int HiddenState(int li, int ri, int max_batch) const
+    {
+        return (li * bi + ri) * max_batch * pr_h;
+    }
+
+    int CellState(int li, int ri, int max_batch) const
+    {
+        return (li * bi + ri) * max_batch * hy_h;
+    }
+};
+
+// Batch sizes of the time steps, which shall not ascend and match the outputs.
+std::vector<int> ProjectionBatchSizes(int seqLen,
+                                      c_array_view<const miopenTensorDescriptor_t> xDesc,
+                                      c_array_view<const miopenTensorDescriptor_t> yDesc,
+                                      int out_h)
+{
+    if(seqLen <= 0)
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+
+    std::vector<int> in_n;
+    for(int i = 0; i < seqLen; i++)
+    {
+        const int batch = xDesc[i].GetLengths()[0];
+        if(batch != static_cast<int>(yDesc[i].GetLengths()[0]) ||
+           static_cast<int>(yDesc[i].GetLengths()[1]) != out_h)
+        {
+            MIOPEN_THROW(miopenStatusBadParm,
+                         "The output of time " + std::to_string(i) +
+                             " doesn't match the input batch and the projection size!");
+        }
+        if(batch <= 0 || (i > 0 && batch > in_n.back()))
+        {
+            MIOPEN_THROW(miopenStatusBadParm,
+                         "Incorrect input batch size at time " + std::to_string(i) +
+                             "! Batch size must be positive and must not ascend!");
+        }
+        in_n.push_back(batch);
+    }
+    return in_n;
+}
+
+void CheckProjectionStates(const LSTMProjectionLayout& layout,
+                           const TensorDescriptor& hxDesc,
+                           const TensorDescriptor& cxDesc)
+{
+    const auto& h_lens = hxDesc.GetLengths();
+    const auto& c_lens = cxDesc.GetLengths();
+    if(h_lens.size() != 3 || c_lens.size() != 3 ||
+       h_lens[0] != static_cast<std::size_t>(layout.layers * layout.bi) ||
+       c_lens[0] != h_lens[0] || c_lens[1] != h_lens[1] ||
+       h_lens[2] != static_cast<std::size_t>(layout.pr_h) ||
+       c_lens[2] != static_cast<std::size_t>(layout.hy_h))
+    {
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "The hidden state shall have the projection size and the cell state the "
+                     "hidden size!");
+    }
+}
+
+// C = op(A) * op(B) + beta * C for row-major matrices, with the recurrent GEMMs of the RNNs.
+void ProjectionGemm(const Handle& handle,
+                    miopenDataType_t data_type,
+                    bool transA,
+                    bool transB,
+                    int m,
+                    int n,
+                    int k,
+                    ConstData_t A,
+                    int a_offset,
+                    int lda,
+                    ConstData_t B,
+                    int b_offset,
+                    int ldb,
+                    Data_t C,
+                    int c_offset,
+                    int ldc,
+                    float beta)
+{
+    const auto gemm_desc = GemmDescriptor{false,
+                                          transA,
+                                          transB,
+                                          m,
+                                          n,
+                                          k,
+                                          lda,
+                                          ldb,
+                                          ldc,
+                                          1, // batch count
+                                          0, // Stride A
+                                          0, // Stride B
+                                          0, // Stride C
+                                          1, // alpha
+                                          beta,
+                                          data_type};
+
+    const auto gemm_status = CallGemm(handle,
+                                      gemm_desc,
+                                      A,
+                                      a_offset,
+                                      B,
+                                      b_offset,
+                                      C,
+                                      c_offset,
+                                      nullptr,
+                                      false,
+                                      GemmBackend_t::miopengemm);
+
+    if(gemm_status != miopenStatusSuccess)
+    {
+        MIOPEN_THROW(gemm_status, "GEMM failed");
+    }
+}
+
+TensorDescriptor RowsDesc(miopenDataType_t data_type, int rows, int cols, int stride)
+{
+    const std::vector<int> lens{1, rows, cols};
+    const std::vector<int> strides{rows * stride, stride, 1};
+    return TensorDescriptor(data_type, lens.data(), strides.data(), 3);
+}
+
+void CopyRows(const Handle& handle,
+              miopenDataType_t data_type,
+              int rows,
+              int cols,
+              ConstData_t src,
+              int src_offset,
+              int src_stride,
+              Data_t dst,
+              int dst_offset,
+              int dst_stride)
+{
+    CopyTensor(handle,
+               RowsDesc(data_type, rows, cols, src_stride),
+               src,
+               RowsDesc(data_type, rows, cols, dst_stride),
+               dst,
+               src_offset,
+               dst_offset);
+}
+
+// Sum of the rows of src added to the vector at dst.
+void AccumulateRows(const Handle& handle,
+                    miopenDataType_t data_type,
+                    int rows,
+                    int cols,
+                    ConstData_t src,
+                    int src_offset,
+                    int src_stride,
+                    Data_t dst,
+                    int dst_offset)
+{
+    float alpha0 = 0;
+    float alpha1 = 1;
+    float beta   = 1;
+
+    const auto dst_desc = RowsDesc(data_type, 1, cols, cols);
+    OpTensor(handle,
+             miopenTensorOpAdd,
+             &alpha0,
+             dst_desc,
+             dst,
+             &alpha1,
+             RowsDesc(data_type, rows, cols, src_stride),
+             src,
+             &beta,
+             dst_desc,
+             dst,
+             dst_offset,
+             src_offset,
+             dst_offset);
+}
+
+} // namespace
+
+void RNNDescriptor::LSTMProjectionForward(Handle& handle,
+                                          const int seqLen,
+                                          c_array_view<const miopenTensorDescriptor_t> xDesc,
+                                          ConstData_t x,
+                                          const TensorDescriptor& hxDesc,
+                                          ConstData_t hx,
+                                          const TensorDescriptor& cxDesc,
+                                          ConstData_t cx,
+                                          ConstData_t w,
+                                          c_array_view<const miopenTensorDescriptor_t> yDesc,
+                                          Data_t y,
+                                          Data_t hy,
+                                          Data_t cy,
+                                          Data_t space,
+                                          const bool is_inference) const
+{
+    const int bi = dirMode == miopenRNNbidirection ? 2 : 1;
+    const auto in_n =
+        ProjectionBatchSizes(seqLen, xDesc, yDesc, bi * static_cast<int>(projSize));
+    const int batch_n = std::accumulate(in_n.begin(), in_n.end(), 0);
+    const auto layout =
+        LSTMProjectionLayout{*this, static_cast<int>(xDesc[0].GetLengths()[1]), batch_n};
+    CheckProjectionStates(layout, hxDesc, cxDesc);
+
+    const auto data_type = dataType;
+    const int hy_n       = hxDesc.GetLengths()[1];
+    const int hy_h       = layout.hy_h;
+    const int pr_h       = layout.pr_h;
+
+    // Row of the first batch of every time step.
+    std::vector<int> batch_base(seqLen, 0);
+    std::partial_sum(in_n.begin(), in_n.end() - 1, batch_base.begin() + 1);
+
+    float ctime = 0.;
+    profileRNNkernels(handle, 0, ctime);
+
+    for(int li = 0; li < layout.layers; li++)
+    {
+        // The input GEMM covers all the time steps and directions, the gate kernel adds the
+        // biases.
+        const bool from_x = li == 0;
+        ProjectionGemm(handle,
+                       data_type,
+                       false,
+                       true,
+                       batch_n,
+                       layout.wei_stride,
+                       layout.InputLen(li),
+                       from_x ? x : space,
+                       from_x ? 0 : layout.Projected(li - 1, 0, 0),
+                       from_x ? layout.in_h : layout.r_stride,
+                       w,
+                       layout.InputWeights(li),
+                       layout.InputLen(li),
+                       space,
+                       layout.Gate(li, 0, 0, 0),
+                       layout.hy_stride,
+                       0);
+        // Update time
+        profileRNNkernels(handle, 1, ctime);
+
+        for(int ti = 0; ti < seqLen; ti++)
+        {
+            handle.RunConcurrently(bi, [&](std::size_t dir) {
+                const int ri       = static_cast<int>(dir);
+                const int cur_time = ri == 0 ? ti : seqLen - 1 - ti;
+                const int pre_time = ri == 0 ? cur_time - 1 : cur_time + 1;
+                const int cur_n    = in_n.at(cur_time);
+                // Rows continuing from the previous step, the others start from hx.
+                const int pre_n   = ti > 0 ? std::min(cur_n, in_n.at(pre_time)) : 0;
+                const int cur_row = batch_base.at(cur_time);
+                const int pre_row = ti > 0 ? batch_base.at(pre_time) : 0;
+
+                if(hx != nullptr && cur_n > pre_n)
+                {
+                    ProjectionGemm(handle,
+                                   data_type,
+                                   false,
+                                   true,
+                                   cur_n - pre_n,
+                                   layout.wei_len,
+                                   pr_h,
+                                   hx,
+                                   layout.HiddenState(li, ri, hy_n) + pre_n * pr_h,
+                                   pr_h,
+                                   w,
+                                   layout.HiddenWeights(li, ri),
+                                   pr_h,
+                                   space,
+                                   layout.Gate(li, cur_row + pre_n, ri, 0),
+                                   layout.hy_stride,
+                                   1);
+                    // Update time
+                    profileRNNkernels(handle, 1, ctime);
+                }
+
+                if(pre_n > 0)
+                {
+                    ProjectionGemm(handle,
+                                   data_type,
+                                   false,
+                                   true,
+                                   pre_n,
+                                   layout.wei_len,
+                                   pr_h,
+                                   space,
+                                   layout.Projected(li, pre_row, ri),
+                                   layout.r_stride,
+                                   w,
+                                   layout.HiddenWeights(li, ri),
+                                   pr_h,
+                                   space,
+                                   layout.Gate(li, cur_row, ri, 0),
+                                   layout.hy_stride,
+                                   1);
+                    // Update time
+                    profileRNNkernels(handle, 1, ctime);
+                }
+
+                LSTMForwardHiddenStateUpdate(handle,
+                                             data_type,
+                                             is_inference,
+                                             ti == 0,
+                                             ri,
+                                             in_n.at(0),
+                                             cur_n,
+                                             pre_n,
+                                             hy_h,
+                                             layout.hy_stride,
+                                             layout.wei_len,
+                                             layout.wei_stride,
+                                             cx,
+                                             layout.CellState(li, ri, hy_n),
+                                             space,
+                                             layout.Gate(li, cur_row, ri, 0),
+                                             layout.Gate(li, cur_row, ri, 1),
+                                             layout.Gate(li, cur_row, ri, 2),
+                                             layout.Gate(li, cur_row, ri, 3),
+                                             layout.Cell(li, cur_row, ri),
+                                             layout.Cell(li, pre_row, ri),
+                                             layout.ActivCell(li, cur_row, ri),
+                                             layout.Hidden(li, cur_row, ri),
+                                             w,
+                                             layout.Bias(li, ri),
+                                             layout.use_bias,
+                                             hx != nullptr);
+                // Update time
+                profileRNNkernels(handle, 1, ctime);
+
+                // Project the hidden state.
+                ProjectionGemm(handle,
+                               data_type,
+                               false,
+                               true,
+                               cur_n,
+                               pr_h,
+                               hy_h,
+                               space,
+                               layout.Hidden(li, cur_row, ri),
+                               layout.hy_stride,
+                               w,
+                               layout.Projection(li, ri),
+                               hy_h,
+                               space,
+                               layout.Projected(li, cur_row, ri),
+                               layout.r_stride,
+                               0);
+                // Update time
+                profileRNNkernels(handle, 1, ctime);
+            });
+        }
+
+        // The final states of the rows that end at step ti, which are the rows of time 0 for the
+        // reverse direction.
+        if(hy != nullptr || cy != nullptr)
+        {
+            for(int ri = 0; ri < bi; ri++)
+            {
+                for(int ti = 0; ti < seqLen; ti++)
+                {
+                    const int end_n   = ri == 0 && ti < seqLen - 1 ? in_n.at(ti + 1) : 0;
+                    const int cur_row = batch_base.at(ti) + end_n;
+                    const int rows    = in_n.at(ti) - end_n;
+                    if(rows <= 0 || (ri == 1 && ti > 0))
+                        continue;
+
+                    if(hy != nullptr)
+                    {
+                        CopyRows(handle,
+                                 data_type,
+                                 rows,
+                                 pr_h,
+                                 space,
+                                 layout.Projected(li, cur_row, ri),
+                                 layout.r_stride,
+                                 hy,
+                                 layout.HiddenState(li, ri, hy_n) + end_n * pr_h,
+                                 pr_h);
+                        // Update time
+                        profileRNNkernels(handle, 1, ctime);
+                    }
+                    if(cy != nullptr)
+                    {
+                        CopyRows(handle,
+                                 data_type,
+                                 rows,
+                                 hy_h,
+                                 space,
+                                 layout.Cell(li, cur_row, ri),
+                                 layout.hy_stride,
+                                 cy,
+                                 layout.CellState(li, ri, hy_n) + end_n * hy_h,
+                                 hy_h);
+                        // Update time
+                        profileRNNkernels(handle, 1, ctime);
+                    }
+                }
+            }
+        }
+    }
+
+    // The projected states of the last layer are the output.
+    CopyRows(handle,
+             data_type,
+             batch_n,
+             layout.r_stride,
+             space,
+             layout.Projected(layout.layers - 1, 0, 0),
+             layout.r_stride,
+             y,
+             0,
+             layout.r_stride);
+    // Update time
+    profileRNNkernels(handle, 2, ctime);
+}
+
+void RNNDescriptor::LSTMProjectionBackwardData(Handle& handle,
+                                               const int seqLen,
+                                               c_array_view<const miopenTensorDescriptor_t> dyDesc,
+                                               ConstData_t dy,
+                                               ConstData_t dhy,
+                                               ConstData_t dcy,
+                                               ConstData_t w,
+                                               const TensorDescriptor& hxDesc,
+                                               const TensorDescriptor& cxDesc,
+                                               ConstData_t cx,
+                                               c_array_view<const miopenTensorDescriptor_t> dxDesc,
+                                               Data_t dx,
+                                               Data_t dhx,
+                                               Data_t dcx,
+                                               Data_t workSpace,
+                                               Data_t reserveSpace) const
+{
+    const int bi = dirMode == miopenRNNbidirection ? 2 : 1;
+    const auto in_n =
+        ProjectionBatchSizes(seqLen, dxDesc, dyDesc, bi * static_cast<int>(projSize));
+    const int batch_n = std::accumulate(in_n.begin(), in_n.end(), 0);
+    const auto layout =
+        LSTMProjectionLayout{*this, static_cast<int>(dxDesc[0].GetLengths()[1]), batch_n};
+    CheckProjectionStates(layout, hxDesc, cxDesc);
+
+    const auto data_type = dataType;
+    const int hy_n       = hxDesc.GetLengths()[1];
+    const int hy_h       = layout.hy_h;
+    const int pr_h       = layout.pr_h;
+
+    std::vector<int> batch_base(seqLen, 0);
+    std::partial_sum(in_n.begin(), in_n.end() - 1, batch_base.begin() + 1);
+
+    float ctime = 0.;
+    profileRNNkernels(handle, 0, ctime);
+
+    for(int li = layout.layers - 1; li >= 0; li--)
+    {
+        // Gradients of the projected states from the output or from the layer above.
+        if(li == layout.layers - 1)
+        {
+            CopyRows(handle,
+                     data_type,
+                     batch_n,
+                     layout.r_stride,
+                     dy,
+                     0,
+                     layout.r_stride,
+                     workSpace,
+                     layout.Projected(li, 0, 0),
+                     layout.r_stride);
+        }
+        else
+        {
+            ProjectionGemm(handle,
+                           data_type,
+                           false,
+                           false,
+                           batch_n,
+                           layout.r_stride,
+                           layout.wei_stride,
+                           workSpace,
+                           layout.Gate(li + 1, 0, 0, 0),
+                           layout.hy_stride,
+                           w,
+                           layout.InputWeights(li + 1),
+                           layout.r_stride,
+                           workSpace,
+                           layout.Projected(li, 0, 0),
+                           layout.r_stride,
+                           0);
+        }
+        // Update time
+        profileRNNkernels(handle, 1, ctime);
+
+        // Steps in the reverse order of the forward pass of each direction.
+        for(int ti = 0; ti < seqLen; ti++)
+        {
+            handle.RunConcurrently(bi, [&](std::size_t dir) {
+                const int ri        = static_cast<int>(dir);
+                const int cur_time  = ri == 0 ? seqLen - 1 - ti : ti;
+                const int next_time = ri == 0 ? cur_time + 1 : cur_time - 1;
+                const int pre_time  = ri == 0 ? cur_time - 1 : cur_time + 1;
+                const int cur_n     = in_n.at(cur_time);
+                // Rows that go on to the next step and rows that come from the previous one.
+                const int next_n   = ti > 0 ? std::min(cur_n, in_n.at(next_time)) : 0;
+                const int pre_n    = ti < seqLen - 1 ? std::min(cur_n, in_n.at(pre_time)) : 0;
+                const int cur_row  = batch_base.at(cur_time);
+                const int next_row = ti > 0 ? batch_base.at(next_time) : 0;
+                const int pre_row  = ti < seqLen - 1 ? batch_base.at(pre_time) : 0;
+
+                if(next_n > 0)
+                {
+                    ProjectionGemm(handle,
+                                   data_type,
+                                   false,
+                                   false,
+                                   next_n,
+                                   pr_h,
+                                   layout.wei_len,
+                                   workSpace,
+                                   layout.Gate(li, next_row, ri, 0),
+                                   layout.hy_stride,
+                                   w,
+                                   layout.HiddenWeights(li, ri),
+                                   pr_h,
+                                   workSpace,
+                                   layout.Projected(li, cur_row, ri),
+                                   layout.r_stride,
+                                   1);
+                    // Update time
+                    profileRNNkernels(handle, 1, ctime);
+                }
+
+                if(dhy != nullptr && cur_n > next_n)
+                {
+                    const auto dr_desc =
+                        RowsDesc(data_type, cur_n - next_n, pr_h, layout.r_stride);
+                    float alpha0 = 1;
+                    float alpha1 = 1;
+                    float beta_t = 0;
+                    OpTensor(handle,
+                             miopenTensorOpAdd,
+                             &alpha0,
+                             dr_desc,
+                             workSpace,
+                             &alpha1,
+                             RowsDesc(data_type, cur_n - next_n, pr_h, pr_h),
+                             dhy,
+                             &beta_t,
+                             dr_desc,
+                             workSpace,
+                             layout.Projected(li, cur_row + next_n, ri),
+                             layout.HiddenState(li, ri, hy_n) + next_n * pr_h,
+                             layout.Projected(li, cur_row + next_n, ri));
+                    // Update time
+                    profileRNNkernels(handle, 1, ctime);
+                }
+
+                // Back through the projection to the hidden state.
+                ProjectionGemm(handle,
+                               data_type,
+                               false,
+                               false,
+                               cur_n,
+                               hy_h,
+                               pr_h,
+                               workSpace,
+                               layout.Projected(li, cur_row, ri),
+                               layout.r_stride,
+                               w,
+                               layout.Projection(li, ri),
+                               hy_h,
+                               workSpace,
+                               layout.Hidden(li, cur_row, ri),
+                               layout.hy_stride,
+                               0);
+                // Update time
+                profileRNNkernels(handle, 1, ctime);
+
+                LSTMBackwardHiddenStateUpdate(handle,
+                                              data_type,
+                                              ti == seqLen - 1,
+                                              ti == 0,
+                                              ri,
+                                              in_n.at(0),
+                                              cur_n,
+                                              next_n,
+                                              pre_n,
+                                              hy_h,
+                                              layout.hy_stride,
+                                              layout.wei_len,
+                                              layout.wei_stride,
+                                              cx,
+                                              layout.CellState(li, ri, hy_n),
+                                              reserveSpace,
+                                              layout.Gate(li, cur_row, ri, 0),
+                                              layout.Gate(li, cur_row, ri, 1),
+                                              layout.Gate(li, cur_row, ri, 2),
+                                              layout.Gate(li, cur_row, ri, 3),
+                                              layout.ActivCell(li, cur_row, ri),
+                                              layout.Cell(li, pre_row, ri),
+                                              dcy,
+                                              layout.CellState(li, ri, hy_n),
+                                              workSpace,
+                                              layout.Gate(li, cur_row, ri, 0),
+                                              layout.Gate(li, cur_row, ri, 1),
+                                              layout.Gate(li, cur_row, ri, 2),
+                                              layout.Gate(li, cur_row, ri, 3),
+                                              layout.Cell(li, cur_row, ri),
+                                              layout.Cell(li, next_row, ri),
+                                              layout.Hidden(li, cur_row, ri),
+                                              layout.Gate(li, next_row, ri, 1));
+                // Update time
+                profileRNNkernels(handle, 1, ctime);
+
+                // Rows that start at this step from hx and cx.
+                if(cur_n > pre_n)
+                {
+                    if(dhx != nullptr)
+                    {
+                        ProjectionGemm(handle,
+                                       data_type,
+                                       false,
+                                       false,
+                                       cur_n - pre_n,
+                                       pr_h,
+                                       layout.wei_len,
+                                       workSpace,
+                                       layout.Gate(li, cur_row + pre_n, ri, 0),
+                                       layout.hy_stride,
+                                       w,
+                                       layout.HiddenWeights(li, ri),
+                                       pr_h,
+                                       dhx,
+                                       layout.HiddenState(li, ri, hy_n) + pre_n * pr_h,
+                                       pr_h,
+                                       0);
+                        // Update time
+                        profileRNNkernels(handle, 1, ctime);
+                    }
+
+                    if(dcx != nullptr)
+                    {
+                        float alpha0 = 1;
+                        float alpha1 = 1;
+                        float beta_t = 0;
+                        const auto sp_desc =
+                            RowsDesc(data_type, cur_n - pre_n, hy_h, layout.hy_stride);
+                        OpTensor(handle,
+                                 miopenTensorOpMul,
+                                 &alpha0,
+                                 sp_desc,
+                                 workSpace,
+                                 &alpha1,
+                                 sp_desc,
+                                 reserveSpace,
+                                 &beta_t,
+                                 RowsDesc(data_type, cur_n - pre_n, hy_h, hy_h),
+                                 dcx,
+                                 layout.Cell(li, cur_row + pre_n, ri),
+                                 layout.Gate(li, cur_row + pre_n, ri, 1),
+                                 layout.CellState(li, ri, hy_n) + pre_n * hy_h);
+                        // Update time
+                        profileRNNkernels(handle, 1, ctime);
+                    }
+                }
+            });
+        }
+    }
+
+    ProjectionGemm(handle,
+                   data_type,
+                   false,
+                   false,
+                   batch_n,
+                   layout.in_h,
+                   layout.wei_stride,
+                   workSpace,
+                   layout.Gate(0, 0, 0, 0),
+                   layout.hy_stride,
+                   w,
+                   0,
+                   layout.in_h,
+                   dx,
+                   0,
+                   layout.in_h,
+                   0);
+    // Update time
+    profileRNNkernels(handle, 2, ctime);
+}
+
+void RNNDescriptor::LSTMProjectionBackwardWeights(
+    Handle& handle,
+    const int seqLen,
+    c_array_view<const miopenTensorDescriptor_t> xDesc,
+    ConstData_t x,
+    const TensorDescriptor& hxDesc,
+    ConstData_t hx,
+    c_array_view<const miopenTensorDescriptor_t> dyDesc,
+    Data_t dw,
+    ConstData_t workSpace,
+    ConstData_t reserveSpace) const
+{
+    const int bi = dirMode == miopenRNNbidirection ? 2 : 1;
+    const auto in_n =
+        ProjectionBatchSizes(seqLen, xDesc, dyDesc, bi * static_cast<int>(projSize));
+    const int batch_n = std::accumulate(in_n.begin(), in_n.end(), 0);
+    const auto layout =
+        LSTMProjectionLayout{*this, static_cast<int>(xDesc[0].GetLengths()[1]), batch_n};
+
+    const auto data_type = dataType;
+    const int hy_n       = hxDesc.GetLengths()[1];
+    const int hy_h       = layout.hy_h;
+    const int pr_h       = layout.pr_h;
+
+    std::vector<int> batch_base(seqLen, 0);
+    std::partial_sum(in_n.begin(), in_n.end() - 1, batch_base.begin() + 1);
+
+    float ctime  = 0.;
+    float beta_t = 0;
+    const auto w_desc =
+        TensorDescriptor(data_type, {GetParamsSize(handle, xDesc[0], data_type) / typeSize});
+    SetTensor(handle, w_desc, dw, &beta_t);
+    // Update time
+    profileRNNkernels(handle, 0, ctime);
+
+    for(int li = 0; li < layout.layers; li++)
+    {
+        const bool from_x = li == 0;
+        ProjectionGemm(handle,
+                       data_type,
+                       true,
+                       false,
+                       layout.wei_stride,
+                       layout.InputLen(li),
+                       batch_n,
+                       workSpace,
+                       layout.Gate(li, 0, 0, 0),
+                       layout.hy_stride,
+                       from_x ? x : reserveSpace,
+                       from_x ? 0 : layout.Projected(li - 1, 0, 0),
+                       from_x ? layout.in_h : layout.r_stride,
+                       dw,
+                       layout.InputWeights(li),
+                       layout.InputLen(li),
+                       1);
+        // Update time
+        profileRNNkernels(handle, 1, ctime);
+
+        for(int ri = 0; ri < bi; ri++)
+        {
+            // Recurrent weights, from the projected state of the previous step or from hx.
+            for(int ti = 0; ti < seqLen; ti++)
+            {
+                const int cur_time = ri == 0 ? ti : seqLen - 1 - ti;
+                const int pre_time = ri == 0 ? cur_time - 1 : cur_time + 1;
+                const int cur_n    = in_n.at(cur_time);
+                const int pre_n    = ti > 0 ? std::min(cur_n, in_n.at(pre_time)) : 0;
+                const int cur_row  = batch_base.at(cur_time);
+
+                if(pre_n > 0)
+                {
+                    ProjectionGemm(handle,
+                                   data_type,
+                                   true,
+                                   false,
+                                   layout.wei_len,
+                                   pr_h,
+                                   pre_n,
+                                   workSpace,
+                                   layout.Gate(li, cur_row, ri, 0),
+                                   layout.hy_stride,
+                                   reserveSpace,
+                                   layout.Projected(li, batch_base.at(pre_time), ri),
+                                   layout.r_stride,
+                                   dw,
+                                   layout.HiddenWeights(li, ri),
+                                   pr_h,
+                                   1);
+                    // Update time
+                    profileRNNkernels(handle, 1, ctime);
+                }
+
+                if(hx != nullptr && cur_n > pre_n)
+                {
+                    ProjectionGemm(handle,
+                                   data_type,
+                                   true,
+                                   false,
+                                   layout.wei_len,
+                                   pr_h,
+                                   cur_n - pre_n,
+                                   workSpace,
+                                   layout.Gate(li, cur_row + pre_n, ri, 0),
+                                   layout.hy_stride,
+                                   hx,
+                                   layout.HiddenState(li, ri, hy_n) + pre_n * pr_h,
+                                   pr_h,
+                                   dw,
+                                   layout.HiddenWeights(li, ri),
+                                   pr_h,
+                                   1);
+                    // Update time
+                    profileRNNkernels(handle, 1, ctime);
+                }
+            }
+
+            ProjectionGemm(handle,
+                           data_type,
+                           true,
+                           false,
+                           pr_h,
+                           hy_h,
+                           batch_n,
+                           workSpace,
+                           layout.Projected(li, 0, ri),
+                           layout.r_stride,
+                           reserveSpace,
+                           layout.Hidden(li, 0, ri),
+                           layout.hy_stride,
+                           dw,
+                           layout.Projection(li, ri),
+                           hy_h,
+                           1);
+            // Update time
+            profileRNNkernels(handle, 1, ctime);
+        }
+
+        if(layout.use_bias)
+        {
+            AccumulateRows(handle,
+                           data_type,
+                           batch_n,
+                           layout.wei_stride,
+                           workSpace,
+                           layout.Gate(li, 0, 0, 0),
+                           layout.hy_stride,
+                           dw,
+                           layout.Bias(li, 0));
+            // Update time
+            profileRNNkernels(handle, 1, ctime);
+
+            // The hidden biases only count in the rows that have a recurrent input.
+            if(hx != nullptr)
+            {
+                CopyRows(handle,
+                         data_type,
+                         1,
+                         layout.wei_stride,
+                         dw,
+                         layout.Bias(li, 0),
+                         layout.wei_stride,
+                         dw,
+                         layout.Bias(li, 0) + layout.wei_stride,
+                         layout.wei_stride);
+                // Update time
+                profileRNNkernels(handle, 1, ctime);
+            }
+            else
+            {
+                for(int ri = 0; ri < bi; ri++)
+                {
+                    for(int ti = 1; ti < seqLen; ti++)
+                    {
+                        const int cur_time = ri == 0 ? ti : seqLen - 1 - ti;
+                        const int pre_time = ri == 0 ? cur_time - 1 : cur_time + 1;
+                        const int pre_n = std::min(in_n.at(cur_time), in_n.at(pre_time));
+                        AccumulateRows(handle,
+                                       data_type,
+                                       pre_n,
+                                       layout.wei_len,
+                                       workSpace,
+                                       layout.Gate(li, batch_base.at(cur_time), ri, 0),
+                                       layout.hy_stride,
+                                       dw,
+                                       layout.Bias(li, ri) + layout.wei_stride);
+                        // Update time
+                        profileRNNkernels(handle, 1, ctime);
+                    }
+                }
+            }
+        }
+    }
+
+    // Update time
+    profileRNNkernels(handle, 2, ctime);
+}
+
+} // namespace miopen
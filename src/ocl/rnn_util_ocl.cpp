@@ -28,11 +28,60 @@
 #include <miopen/float_equal.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/datatype.hpp>
+#include <miopen/env.hpp>
 #include <miopen/rnn_util.hpp>
 #include <cassert>
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_RNN_PERSISTENT_INFERENCE)
+
 namespace miopen {
 
+namespace {
+
+// Launch geometry of the elementwise hidden state update kernels. The vector width and the
+// work-group size follow the largest batch, so that all the steps share one program, while the
+// grid only covers the rows of the sequences still active.
+struct HiddenStateUpdateGrid
+{
+    std::size_t rd_blck;
+    std::size_t item_per_grp;
+    std::size_t wg_sz;
+    std::size_t glb_sz;
+
+    HiddenStateUpdateGrid(const Handle& handle, int max_batch, int cur_batch, int hy_h)
+    {
+        const std::size_t max_active_threads =
+            handle.GetMaxComputeUnits() * handle.GetWavefrontWidth() * 32;
+
+        const std::size_t total_work = std::size_t(max_batch) * hy_h;
+
+        rd_blck = (total_work >= 4 * max_active_threads && hy_h % 4 == 0)
+                      ? 4
+                      : ((total_work >= 2 * max_active_threads && hy_h % 2 == 0) ? 2 : 1);
+
+        const std::size_t total_item = std::max(total_work / rd_blck, std::size_t(1));
+        item_per_grp = total_item <= 64 ? 64 : total_item <= 128 ? 128 : 256;
+
+        const std::size_t active_item =
+            std::max(std::size_t(cur_batch) * hy_h / rd_blck, std::size_t(1));
+        glb_sz = std::min(active_item, max_active_threads);
+        wg_sz  = (glb_sz + item_per_grp - 1) / item_per_grp;
+        glb_sz = wg_sz * item_per_grp;
+    }
+};
+
+// The kernels read and write RD_BLCK elements at once.
+std::string HiddenStateUpdateTypeParams(miopenDataType_t rnn_data_type, std::size_t rd_blck)
+{
+    const std::string data_type = GetKernelStorageType(rnn_data_type);
+    const std::string read_type = (rd_blck == 1) ? data_type : data_type + std::to_string(rd_blck);
+
+    return " -DRD_BLCK=" + std::to_string(rd_blck) + " -DREAD_TYPE=" + read_type +
+           GetDataTypeKernelParams(rnn_data_type);
+}
+
+} // namespace
+
 void LSTMForwardHiddenStateUpdate(const Handle& handle,
                                   miopenDataType_t rnn_data_type,
                                   bool is_inference,
@@ -55,27 +104,24 @@ void LSTMForwardHiddenStateUpdate(const Handle& handle,
                                   std::size_t cell_offset,
                                   std::size_t cell_offset_pre,
                                   std::size_t activ_cell_offset,
-                                  std::size_t hidden_offset)
+                                  std::size_t hidden_offset,
+                                  ConstData_t w,
+                                  std::size_t bias_offset,
+                                  bool use_bias,
+                                  bool use_hx)
 {
     std::string program_name = "MIOpenRNNHiddenStateUpdate.cl";
     std::string kernel_name  = "LSTMFwdHidUpdate";
 
-    size_t max_active_threads = handle.GetMaxComputeUnits() * handle.GetWavefrontWidth() * 32;
-
-    size_t total_work = max_batch * hy_h;
+    const auto grid = HiddenStateUpdateGrid{handle, max_batch, cur_batch, hy_h};
 
-    size_t RD_BLCK = (total_work >= 4 * max_active_threads && hy_h % 4 == 0)
-                         ? 4
-                         : ((total_work >= 2 * max_active_threads && hy_h % 2 == 0) ? 2 : 1);
-
-    size_t total_item   = std::max(total_work / RD_BLCK, size_t(1));
-    size_t item_per_grp = total_item <= 64 ? 64 : total_item <= 128 ? 128 : 256;
-    size_t glb_sz       = total_item < max_active_threads ? total_item : max_active_threads;
-    size_t wg_sz        = (glb_sz + item_per_grp - 1) / item_per_grp;
-    glb_sz              = wg_sz * item_per_grp;
+    const size_t RD_BLCK      = grid.rd_blck;
+    const size_t item_per_grp = grid.item_per_grp;
+    const size_t glb_sz       = grid.glb_sz;
+    const size_t wg_sz        = grid.wg_sz;
 
     std::string network_config =
-        "lstmfwdhid-" + std::string(rnn_data_type == miopenHalf ? "fp16-" : "fp32-") +
+        "lstmfwdhid-" + GetDataType(rnn_data_type) + "-" +
         std::to_string(static_cast<int>(is_inference)) + "x" + std::to_string(RD_BLCK) + "x" +
         std::to_string(item_per_grp) + "x" + std::to_string(wg_sz);
 
@@ -99,6 +145,11 @@ void LSTMForwardHiddenStateUpdate(const Handle& handle,
                static_cast<long long>(cell_offset_pre),
                static_cast<long long>(activ_cell_offset),
                static_cast<long long>(hidden_offset),
+               w,
+               static_cast<long long>(bias_offset),
+               static_cast<long long>(bias_offset + wei_stride),
+               static_cast<char>(use_bias),
+               static_cast<char>(use_hx),
                static_cast<char>(use_cx),
                static_cast<char>(is_seq_begin),
                direction,
@@ -109,16 +160,7 @@ void LSTMForwardHiddenStateUpdate(const Handle& handle,
     {
         std::string params = " -DLSTM_FWD_HID=1";
 
-        const std::string data_type = GetDataType(rnn_data_type);
-        const std::string READ_TYPE =
-            (RD_BLCK == 1) ? data_type : data_type + std::to_string(RD_BLCK);
-
-        params += " -DRD_BLCK=" + std::to_string(RD_BLCK) + " -DREAD_TYPE=" + READ_TYPE;
-
-        if(rnn_data_type == miopenHalf)
-            params += " -DMIOPEN_USE_FP16=1";
-        else
-            params += " -DMIOPEN_USE_FP32=1";
+        params += HiddenStateUpdateTypeParams(rnn_data_type, RD_BLCK);
 
         if(is_inference)
             params += " -DINFERENCE_MODE=1";
@@ -140,6 +182,11 @@ void LSTMForwardHiddenStateUpdate(const Handle& handle,
             static_cast<long long>(cell_offset_pre),
             static_cast<long long>(activ_cell_offset),
             static_cast<long long>(hidden_offset),
+            w,
+            static_cast<long long>(bias_offset),
+            static_cast<long long>(bias_offset + wei_stride),
+            static_cast<char>(use_bias),
+            static_cast<char>(use_hx),
             static_cast<char>(use_cx),
             static_cast<char>(is_seq_begin),
             direction,
@@ -148,7 +195,6 @@ void LSTMForwardHiddenStateUpdate(const Handle& handle,
     }
 
     (void)wei_len;
-    (void)wei_stride;
 }
 
 void LSTMBackwardHiddenStateUpdate(const Handle& handle,
@@ -188,22 +234,15 @@ void LSTMBackwardHiddenStateUpdate(const Handle& handle,
     std::string program_name = "MIOpenRNNHiddenStateUpdate.cl";
     std::string kernel_name  = "LSTMBwdHidUpdate";
 
-    size_t max_active_threads = handle.GetMaxComputeUnits() * handle.GetWavefrontWidth() * 32;
-
-    size_t total_work = max_batch * hy_h;
+    const auto grid = HiddenStateUpdateGrid{handle, max_batch, cur_batch, hy_h};
 
-    size_t RD_BLCK = (total_work >= 4 * max_active_threads && hy_h % 4 == 0)
-                         ? 4
-                         : ((total_work >= 2 * max_active_threads && hy_h % 2 == 0) ? 2 : 1);
-
-    size_t total_item   = std::max(total_work / RD_BLCK, size_t(1));
-    size_t item_per_grp = total_item <= 64 ? 64 : total_item <= 128 ? 128 : 256;
-    size_t glb_sz       = total_item < max_active_threads ? total_item : max_active_threads;
-    size_t wg_sz        = (glb_sz + item_per_grp - 1) / item_per_grp;
-    glb_sz              = wg_sz * item_per_grp;
+    const size_t RD_BLCK      = grid.rd_blck;
+    const size_t item_per_grp = grid.item_per_grp;
+    const size_t glb_sz       = grid.glb_sz;
+    const size_t wg_sz        = grid.wg_sz;
 
     std::string network_config =
-        "lstmbwdhid-" + std::string(rnn_data_type == miopenHalf ? "fp16-" : "fp32-") +
+        "lstmbwdhid-" + GetDataType(rnn_data_type) + "-" +
         std::to_string(RD_BLCK) + "x" + std::to_string(item_per_grp) + "x" + std::to_string(wg_sz);
 
     bool use_cx  = cx != nullptr;
@@ -249,16 +288,7 @@ void LSTMBackwardHiddenStateUpdate(const Handle& handle,
     {
         std::string params = " -DLSTM_BWD_HID=1";
 
-        const std::string data_type = GetDataType(rnn_data_type);
-        const std::string READ_TYPE =
-            (RD_BLCK == 1) ? data_type : data_type + std::to_string(RD_BLCK);
-
-        params += " -DRD_BLCK=" + std::to_string(RD_BLCK) + " -DREAD_TYPE=" + READ_TYPE;
-
-        if(rnn_data_type == miopenHalf)
-            params += " -DMIOPEN_USE_FP16=1";
-        else
-            params += " -DMIOPEN_USE_FP32=1";
+        params += HiddenStateUpdateTypeParams(rnn_data_type, RD_BLCK);
 
         const std::vector<size_t> vld{item_per_grp, 1, 1};
         const std::vector<size_t> vgd{glb_sz, 1, 1};
@@ -299,4 +329,407 @@ void LSTMBackwardHiddenStateUpdate(const Handle& handle,
     (void)wei_len;
     (void)wei_stride;
 }
+
+void GRUForwardHiddenStateUpdate(const Handle& handle,
+                                 miopenDataType_t rnn_data_type,
+                                 bool is_inference,
+                                 bool is_seq_begin,
+                                 int direction,
+                                 int max_batch,
+                                 int cur_batch,
+                                 int use_batch,
+                                 int hy_h,
+                                 int hy_stride,
+                                 ConstData_t hx,
+                                 std::size_t hx_offset,
+                                 Data_t reserve_space,
+                                 std::size_t z_offset,
+                                 std::size_t r_offset,
+                                 std::size_t c_offset,
+                                 std::size_t hidden_offset,
+                                 std::size_t hidden_offset_pre,
+                                 std::size_t activ_offset)
+{
+    std::string program_name = "MIOpenRNNHiddenStateUpdate.cl";
+    std::string kernel_name  = "GRUFwdHidUpdate";
+
+    const auto grid = HiddenStateUpdateGrid{handle, max_batch, cur_batch, hy_h};
+
+    const size_t RD_BLCK      = grid.rd_blck;
+    const size_t item_per_grp = grid.item_per_grp;
+    const size_t glb_sz       = grid.glb_sz;
+    const size_t wg_sz        = grid.wg_sz;
+
+    std::string network_config =
+        "grufwdhid-" + GetDataType(rnn_data_type) + "-" +
+        std::to_string(static_cast<int>(is_inference)) + "x" + std::to_string(RD_BLCK) + "x" +
+        std::to_string(item_per_grp) + "x" + std::to_string(wg_sz);
+
+    bool use_hx = hx != nullptr;
+
+    auto&& kernels = handle.GetKernels(kernel_name, network_config);
+
+    if(!kernels.empty())
+    {
+        auto kernel = kernels.front();
+        kernel(hx,
+               reserve_space,
+               hy_h,
+               hy_stride,
+               static_cast<long long>(hx_offset),
+               static_cast<long long>(z_offset),
+               static_cast<long long>(r_offset),
+               static_cast<long long>(c_offset),
+               static_cast<long long>(hidden_offset),
+               static_cast<long long>(hidden_offset_pre),
+               static_cast<long long>(activ_offset),
+               static_cast<char>(use_hx),
+               static_cast<char>(is_seq_begin),
+               direction,
+               cur_batch,
+               use_batch);
+    }
+    else
+    {
+        std::string params = " -DGRU_FWD_HID=1";
+
+        params += HiddenStateUpdateTypeParams(rnn_data_type, RD_BLCK);
+
+        if(is_inference)
+            params += " -DINFERENCE_MODE=1";
+
+        const std::vector<size_t> vld{item_per_grp, 1, 1};
+        const std::vector<size_t> vgd{glb_sz, 1, 1};
+
+        handle.AddKernel(kernel_name, network_config, program_name, kernel_name, vld, vgd, params)(
+            hx,
+            reserve_space,
+            hy_h,
+            hy_stride,
+            static_cast<long long>(hx_offset),
+            static_cast<long long>(z_offset),
+            static_cast<long long>(r_offset),
+            static_cast<long long>(c_offset),
+            static_cast<long long>(hidden_offset),
+            static_cast<long long>(hidden_offset_pre),
+            static_cast<long long>(activ_offset),
+            static_cast<char>(use_hx),
+            static_cast<char>(is_seq_begin),
+            direction,
+            cur_batch,
+            use_batch);
+    }
+}
+
+void GRUBackwardHiddenStateUpdate(const Handle& handle,
+                                  miopenDataType_t rnn_data_type,
+                                  bool is_seq_begin,
+                                  int direction,
+                                  int max_batch,
+                                  int cur_batch,
+                                  int use_batch,
+                                  int hy_h,
+                                  int hy_stride,
+                                  ConstData_t hx,
+                                  std::size_t hx_offset,
+                                  Data_t reserve_space,
+                                  std::size_t z_offset,
+                                  std::size_t r_offset,
+                                  std::size_t c_offset,
+                                  std::size_t hidden_offset,
+                                  std::size_t hidden_offset_pre,
+                                  Data_t work_space,
+                                  std::size_t dz_offset,
+                                  std::size_t dr_offset,
+                                  std::size_t dc_offset,
+                                  std::size_t dhidden_offset)
+{
+    std::string program_name = "MIOpenRNNHiddenStateUpdate.cl";
+    std::string kernel_name  = "GRUBwdHidUpdate";
+
+    const auto grid = HiddenStateUpdateGrid{handle, max_batch, cur_batch, hy_h};
+
+    const size_t RD_BLCK      = grid.rd_blck;
+    const size_t item_per_grp = grid.item_per_grp;
+    const size_t glb_sz       = grid.glb_sz;
+    const size_t wg_sz        = grid.wg_sz;
+
+    std::string network_config =
+        "grubwdhid-" + GetDataType(rnn_data_type) + "-" +
+        std::to_string(RD_BLCK) + "x" + std::to_string(item_per_grp) + "x" + std::to_string(wg_sz);
+
+    bool use_hx = hx != nullptr;
+
+    auto&& kernels = handle.GetKernels(kernel_name, network_config);
+
+    if(!kernels.empty())
+    {
+        auto kernel = kernels.front();
+        kernel(hx,
+               reserve_space,
+               work_space,
+               hy_h,
+               hy_stride,
+               static_cast<long long>(hx_offset),
+               static_cast<long long>(z_offset),
+               static_cast<long long>(r_offset),
+               static_cast<long long>(c_offset),
+               static_cast<long long>(hidden_offset),
+               static_cast<long long>(hidden_offset_pre),
+               static_cast<long long>(dz_offset),
+               static_cast<long long>(dr_offset),
+               static_cast<long long>(dc_offset),
+               static_cast<long long>(dhidden_offset),
+               static_cast<char>(use_hx),
+               static_cast<char>(is_seq_begin),
+               direction,
+               cur_batch,
+               use_batch);
+    }
+    else
+    {
+        std::string params = " -DGRU_BWD_HID=1";
+
+        params += HiddenStateUpdateTypeParams(rnn_data_type, RD_BLCK);
+
+        const std::vector<size_t> vld{item_per_grp, 1, 1};
+        const std::vector<size_t> vgd{glb_sz, 1, 1};
+
+        handle.AddKernel(kernel_name, network_config, program_name, kernel_name, vld, vgd, params)(
+            hx,
+            reserve_space,
+            work_space,
+            hy_h,
+            hy_stride,
+            static_cast<long long>(hx_offset),
+            static_cast<long long>(z_offset),
+            static_cast<long long>(r_offset),
+            static_cast<long long>(c_offset),
+            static_cast<long long>(hidden_offset),
+            static_cast<long long>(hidden_offset_pre),
+            static_cast<long long>(dz_offset),
+            static_cast<long long>(dr_offset),
+            static_cast<long long>(dc_offset),
+            static_cast<long long>(dhidden_offset),
+            static_cast<char>(use_hx),
+            static_cast<char>(is_seq_begin),
+            direction,
+            cur_batch,
+            use_batch);
+    }
+}
+
+void RNNQuantizedGemm(const Handle& handle,
+                      miopenDataType_t rnn_data_type,
+                      int m,
+                      int n,
+                      int k,
+                      ConstData_t a,
+                      std::size_t a_offset,
+                      int lda,
+                      ConstData_t w,
+                      std::size_t w_offset,
+                      ConstData_t scale,
+                      std::size_t scale_offset,
+                      Data_t c,
+                      std::size_t c_offset,
+                      int ldc)
+{
+    std::string program_name = "MIOpenRNNQuantizedGemm.cl";
+    std::string kernel_name  = "MIOpenRNNQuantizedGemm";
+
+    // Each work-group of local_size reduces one row of w against rows_per_group rows of a, see
+    // MIOpenRNNQuantizedGemm.cl
+    constexpr std::size_t local_size     = 64;
+    constexpr std::size_t rows_per_group = 4;
+    const std::size_t row_groups         = (m + rows_per_group - 1) / rows_per_group;
+
+    std::string network_config = "rnnqgemm-" + GetDataType(rnn_data_type) + "-" +
+                                 std::to_string(n) + "x" + std::to_string(row_groups);
+
+    auto&& kernels = handle.GetKernels(kernel_name, network_config);
+
+    if(!kernels.empty())
+    {
+        kernels.front()(a,
+                        w,
+                        scale,
+                        c,
+                        static_cast<long long>(a_offset),
+                        static_cast<long long>(w_offset),
+                        static_cast<long long>(scale_offset),
+                        static_cast<long long>(c_offset),
+                        lda,
+                        ldc,
+                        m,
+                        k);
+        return;
+    }
+
+    const std::string params = GetDataTypeKernelParams(rnn_data_type);
+
+    const std::vector<size_t> vld{local_size, 1, 1};
+    const std::vector<size_t> vgd{local_size * n, row_groups, 1};
+
+    handle.AddKernel(kernel_name, network_config, program_name, kernel_name, vld, vgd, params)(
+        a,
+        w,
+        scale,
+        c,
+        static_cast<long long>(a_offset),
+        static_cast<long long>(w_offset),
+        static_cast<long long>(scale_offset),
+        static_cast<long long>(c_offset),
+        lda,
+        ldc,
+        m,
+        k);
+}
+
+namespace {
+
+constexpr std::size_t persistent_rnn_local_size = 256;
+constexpr int persistent_rnn_max_batch          = 8;
+constexpr int persistent_rnn_max_hidden         = 1024;
+
+struct RNNPersistentConfig
+{
+    int gates;
+    int units;      // hidden units per work-group
+    int num_groups; // at most one per compute unit, so that all of them are resident
+    bool wei_in_lds;
+    std::size_t lds_bytes;
+};
+
+RNNPersistentConfig
+GetRNNPersistentConfig(const Handle& handle, miopenRNNMode_t rnn_mode, int batch, int hy_h)
+{
+    RNNPersistentConfig config{};
+    config.gates      = rnn_mode == miopenLSTM ? 4 : rnn_mode == miopenGRU ? 3 : 1;
+    const auto cus    = static_cast<int>(handle.GetMaxComputeUnits());
+    config.units      = (hy_h + cus - 1) / cus;
+    config.num_groups = (hy_h + config.units - 1) / config.units;
+
+    // h_prev, dot products and partial sums, see MIOpenRNNPersistentFwd.cl
+    const auto lds_floats =
+        static_cast<std::size_t>(batch * (hy_h + config.gates * config.units)) +
+        persistent_rnn_local_size;
+    const auto wei_floats = static_cast<std::size_t>(config.gates * config.units * hy_h);
+    const auto lds_size   = handle.GetLocalMemorySize();
+    config.wei_in_lds     = (lds_floats + wei_floats) * sizeof(float) <= lds_size;
+    config.lds_bytes      = (lds_floats + (config.wei_in_lds ? wei_floats : 0)) * sizeof(float);
+    return config;
+}
+
+} // namespace
+
+bool IsRNNPersistentInferenceApplicable(const Handle& handle,
+                                        miopenDataType_t rnn_data_type,
+                                        miopenRNNMode_t rnn_mode,
+                                        int batch,
+                                        int hy_h)
+{
+    if(miopen::IsDisabled(MIOPEN_RNN_PERSISTENT_INFERENCE{}))
+        return false;
+    if(rnn_data_type != miopenFloat && rnn_data_type != miopenHalf)
+        return false;
+    if(batch > persistent_rnn_max_batch || hy_h > persistent_rnn_max_hidden)
+        return false;
+
+    const auto config = GetRNNPersistentConfig(handle, rnn_mode, batch, hy_h);
+    // Each of the work-items updating the cells owns one unit of one batch.
+    if(static_cast<std::size_t>(batch * config.units) > persistent_rnn_local_size)
+        return false;
+    return config.lds_bytes <= handle.GetLocalMemorySize();
+}
+
+void RNNPersistentForwardInference(const Handle& handle,
+                                   miopenDataType_t rnn_data_type,
+                                   miopenRNNMode_t rnn_mode,
+                                   int seq_len,
+                                   int batch,
+                                   int hy_h,
+                                   int hy_stride,
+                                   int hid_off,
+                                   int cell_off,
+                                   ConstData_t w,
+                                   std::size_t wei_offset,
+                                   ConstData_t w_scale,
+                                   std::size_t scale_offset,
+                                   ConstData_t hx,
+                                   ConstData_t cx,
+                                   std::size_t hx_offset,
+                                   Data_t work_space,
+                                   std::size_t hid_offset,
+                                   Data_t sync,
+                                   int sync_index)
+{
+    std::string program_name = "MIOpenRNNPersistentFwd.cl";
+    std::string kernel_name  = "MIOpenRNNPersistentFwd";
+
+    const auto config = GetRNNPersistentConfig(handle, rnn_mode, batch, hy_h);
+
+    std::string network_config =
+        "rnnpersistfwd-" + std::string(rnn_data_type == miopenHalf ? "fp16-" : "fp32-") +
+        std::to_string(static_cast<int>(rnn_mode)) + "x" + std::to_string(batch) + "x" +
+        std::to_string(hy_h) + "x" + std::to_string(hy_stride) + "x" + std::to_string(hid_off) +
+        "x" + std::to_string(cell_off) + "x" + std::to_string(config.num_groups) +
+        (w_scale != nullptr ? "-q8" : "");
+
+    const auto use_hx = static_cast<int>(hx != nullptr);
+    const auto use_cx = static_cast<int>(cx != nullptr);
+
+    auto&& kernels = handle.GetKernels(kernel_name, network_config);
+
+    if(!kernels.empty())
+    {
+        kernels.front()(work_space,
+                        w,
+                        w_scale,
+                        hx,
+                        cx,
+                        sync,
+                        sync_index,
+                        static_cast<long long>(hid_offset),
+                        static_cast<long long>(wei_offset),
+                        static_cast<long long>(scale_offset),
+                        static_cast<long long>(hx_offset),
+                        seq_len,
+                        use_hx,
+                        use_cx);
+        return;
+    }
+
+    std::string params = GetDataTypeKernelParams(rnn_data_type);
+    params += " -DRNN_MODE=" + std::to_string(static_cast<int>(rnn_mode));
+    params += " -DRNN_GATES=" + std::to_string(config.gates);
+    params += " -DRNN_HY_H=" + std::to_string(hy_h);
+    params += " -DRNN_BATCH=" + std::to_string(batch);
+    params += " -DRNN_HY_STRIDE=" + std::to_string(hy_stride);
+    params += " -DRNN_HID_OFF=" + std::to_string(hid_off);
+    params += " -DRNN_CELL_OFF=" + std::to_string(cell_off);
+    params += " -DRNN_UNITS=" + std::to_string(config.units);
+    params += " -DRNN_NUM_GROUPS=" + std::to_string(config.num_groups);
+    params += " -DRNN_WEI_IN_LDS=" + std::to_string(static_cast<int>(config.wei_in_lds));
+    params += " -DRNN_QUANT_WEI=" + std::to_string(static_cast<int>(w_scale != nullptr));
+
+    const std::vector<size_t> vld{persistent_rnn_local_size, 1, 1};
+    const std::vector<size_t> vgd{persistent_rnn_local_size * config.num_groups, 1, 1};
+
+    handle.AddKernel(kernel_name, network_config, program_name, kernel_name, vld, vgd, params)(
+        work_space,
+        w,
+        w_scale,
+        hx,
+        cx,
+        sync,
+        sync_index,
+        static_cast<long long>(hid_offset),
+        static_cast<long long>(wei_offset),
+        static_cast<long long>(scale_offset),
+        static_cast<long long>(hx_offset),
+        seq_len,
+        use_hx,
+        use_cx);
+}
 } // namespace miopen
@@ -32,12 +32,41 @@
 #include <miopen/gemm_v2.hpp>
 #include <miopen/logger.hpp>
 
+#include <cassert>
 #include <vector>
 #include <numeric>
 #include <algorithm>
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_RNN_WAVEFRONT)
+
 namespace miopen {
 
+namespace {
+
+/// The first in_n[t + 1] rows of every time step t < seqLen - 1 of the packed sequence, as
+/// (first row, row count) runs of consecutive rows. The tiny tensor ops applied to these rows
+/// do not depend on each other, so each run takes one launch instead of one per step or row.
+std::vector<std::pair<int, int>> GetRowRunsWithNextStep(const std::vector<int>& in_n)
+{
+    std::vector<std::pair<int, int>> runs;
+    int step_row = 0;
+    for(std::size_t ti = 0; ti + 1 < in_n.size(); ++ti)
+    {
+        const auto rows = in_n[ti + 1];
+        if(rows > 0)
+        {
+            if(!runs.empty() && runs.back().first + runs.back().second == step_row)
+                runs.back().second += rows;
+            else
+                runs.emplace_back(step_row, rows);
+        }
+        step_row += in_n[ti];
+    }
+    return runs;
+}
+
+} // namespace
+
 // Assuming sequence length is set to > 0 otherwise throw exception.
 void RNNDescriptor::RNNForwardInference(Handle& handle,
                                         const int seqLen,
@@ -58,6 +87,97 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                                         Data_t workSpace,
                                         size_t workSpaceSize) const
 {
+    RNNForwardInferenceImpl(handle,
+                            seqLen,
+                            xDesc,
+                            x,
+                            hxDesc,
+                            hx,
+                            cxDesc,
+                            cx,
+                            wDesc,
+                            w,
+                            false,
+                            nullptr,
+                            nullptr,
+                            yDesc,
+                            y,
+                            hyDesc,
+                            hy,
+                            cyDesc,
+                            cy,
+                            workSpace,
+                            workSpaceSize);
+}
+
+void RNNDescriptor::RNNForwardInference(Handle& handle,
+                                        const int seqLen,
+                                        c_array_view<const miopenTensorDescriptor_t> xDesc,
+                                        ConstData_t x,
+                                        const TensorDescriptor& hxDesc,
+                                        ConstData_t hx,
+                                        const TensorDescriptor& cxDesc,
+                                        ConstData_t cx,
+                                        const RNNPreparedWeights& weights,
+                                        c_array_view<const miopenTensorDescriptor_t> yDesc,
+                                        Data_t y,
+                                        const TensorDescriptor& hyDesc,
+                                        Data_t hy,
+                                        const TensorDescriptor& cyDesc,
+                                        Data_t cy,
+                                        Data_t workSpace,
+                                        size_t workSpaceSize) const
+{
+    if(seqLen <= 0 || !weights.IsPreparedFor(*this, xDesc[0].GetLengths()[1]))
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Weights were prepared for another RNN.");
+    }
+
+    RNNForwardInferenceImpl(handle,
+                            seqLen,
+                            xDesc,
+                            x,
+                            hxDesc,
+                            hx,
+                            cxDesc,
+                            cx,
+                            weights.wDesc,
+                            weights.data.get(),
+                            !weights.quantized,
+                            weights.quantizedData.get(),
+                            weights.scales.get(),
+                            yDesc,
+                            y,
+                            hyDesc,
+                            hy,
+                            cyDesc,
+                            cy,
+                            workSpace,
+                            workSpaceSize);
+}
+
+void RNNDescriptor::RNNForwardInferenceImpl(Handle& handle,
+                                            const int seqLen,
+                                            c_array_view<const miopenTensorDescriptor_t> xDesc,
+                                            ConstData_t x,
+                                            const TensorDescriptor& hxDesc,
+                                            ConstData_t hx,
+                                            const TensorDescriptor& cxDesc,
+                                            ConstData_t cx,
+                                            const TensorDescriptor& wDesc,
+                                            ConstData_t w,
+                                            const bool transposed_weights,
+                                            ConstData_t wei_q,
+                                            ConstData_t wei_scale,
+                                            c_array_view<const miopenTensorDescriptor_t> yDesc,
+                                            Data_t y,
+                                            const TensorDescriptor& hyDesc,
+                                            Data_t hy,
+                                            const TensorDescriptor& cyDesc,
+                                            Data_t cy,
+                                            Data_t workSpace,
+                                            size_t workSpaceSize) const
+{
 
     if(x == nullptr || w == nullptr || y == nullptr)
     {
@@ -73,6 +193,14 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
         MIOPEN_THROW("Workspace is required");
     }
 
+    if(projSize != 0)
+    {
+        assert(!transposed_weights);
+        LSTMProjectionForward(
+            handle, seqLen, xDesc, x, hxDesc, hx, cxDesc, cx, w, yDesc, y, hy, cy, workSpace, true);
+        return;
+    }
+
     std::string network_config;
     std::vector<int> in_n;
     int in_h  = xDesc[0].GetLengths()[1]; // input vector size
@@ -228,7 +356,76 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
         activDesc = {miopenActivationTANH, 1, 1, 1};
     }
 
-    for(int li = 0; li < nLayers; li++)
+    // For short sequences of small layers the launch overhead of the per step kernels below
+    // dominates, so the recurrent part of each layer runs as one persistent kernel instead.
+    const bool use_persistent =
+        dirMode == 0u &&
+        std::all_of(in_n.begin(), in_n.end(), [&](int n) { return n == in_n.at(0); }) &&
+        IsRNNPersistentInferenceApplicable(handle, wDesc.GetType(), rnnMode, in_n.at(0), hy_h) &&
+        !transposed_weights;
+
+    // Counters of the global barriers of the persistent kernel, one per layer.
+    Allocator::ManageDataPtr local_sync;
+    constexpr auto sync_slot = WorkspaceArena::Slot::RNNSync;
+    const auto sync_size     = nLayers * sizeof(int);
+    if(use_persistent && !handle.IsWorkspaceArenaEnabled())
+        local_sync = handle.Create(sync_size, miopenAllocationScratch);
+    auto& sync_d = handle.IsWorkspaceArenaEnabled() && use_persistent
+                       ? handle.GetArenaBuffer(sync_slot, sync_size)
+                       : local_sync;
+    if(use_persistent)
+    {
+        const std::vector<int> zeros(nLayers, 0);
+        handle.WriteTo(zeros.data(), sync_d, sync_size);
+    }
+
+    // The LSTM gate kernel adds the biases of each step itself, the persistent kernel expects
+    // them added beforehand.
+    const bool fuse_lstm_bias = biasMode != 0u && rnnMode == miopenLSTM &&
+                                algoMode == miopenRNNdefault && !use_persistent;
+
+    // Stacked layers overlap along the diagonals of (layer, time) instead of running one
+    // after another.
+    const bool use_wavefront = !use_persistent && nLayers > 1 && rnnMode == miopenLSTM &&
+                               algoMode == miopenRNNdefault && dirMode == 0u &&
+                               inputMode != miopenRNNskip && wei_q == nullptr &&
+                               !miopen::IsDisabled(MIOPEN_RNN_WAVEFRONT{});
+    if(use_wavefront)
+        RNNForwardInferenceWavefront(
+            handle, in_n, in_h, x, hx, cx, w, transposed_weights, hy, cy, workSpace, hy_n, ctime);
+
+    // Prepared weights hold every matrix transposed, with rows of wei_stride, and the GEMMs
+    // read them as they are.
+    const bool wei_trans   = !transposed_weights;
+    const int in_wei_ld    = transposed_weights ? wei_stride : in_stride;
+    const int hid_wei_ld   = transposed_weights ? wei_stride : bi_stride;
+    const int uni_wei_ld   = transposed_weights ? wei_stride : uni_stride;
+    const int dir_wei_size = transposed_weights ? wei_len : wei_len * uni_stride;
+
+    // With quantized weights the recurrent GEMMs below read the int8 rows of wei_q instead, the
+    // recurrent matrix of layer li taking wei_stride rows of hy_h from li * wei_stride * hy_h.
+    const auto quantized_hidden_gemm =
+        [&](int li, int ri, int rows, ConstData_t a, int a_offset, int lda, int c_offset) {
+            RNNQuantizedGemm(handle,
+                             wDesc.GetType(),
+                             rows,
+                             wei_len,
+                             hy_h,
+                             a,
+                             a_offset,
+                             lda,
+                             wei_q,
+                             (li * wei_stride + ri * wei_len) * hy_h,
+                             wei_scale,
+                             li * wei_stride + ri * wei_len,
+                             workSpace,
+                             c_offset,
+                             hy_stride);
+            // Update time
+            profileRNNkernels(handle, 1, ctime);
+        };
+
+    for(int li = 0; li < nLayers && !use_wavefront; li++)
     {
         int hid_shift           = li * batch_n * hy_stride;
         int hx_shift            = li * hy_n * bi_stride;
@@ -259,12 +456,12 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
             {
                 miopen::GemmDescriptor gemm_desc = GemmDescriptor{false,
                                                                   false,
-                                                                  true,
+                                                                  wei_trans,
                                                                   batch_n,
                                                                   wei_len * bi,
                                                                   in_h,
                                                                   in_stride,
-                                                                  in_stride,
+                                                                  in_wei_ld,
                                                                   hy_stride,
                                                                   1, // batch count
                                                                   0, // Stride A
@@ -308,12 +505,12 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
 
             miopen::GemmDescriptor gemm_desc = GemmDescriptor{false,
                                                               false,
-                                                              true,
+                                                              wei_trans,
                                                               batch_n,
                                                               wei_len * bi,
                                                               hy_h * bi,
                                                               hy_stride,
-                                                              bi_stride,
+                                                              hid_wei_ld,
                                                               hy_stride,
                                                               1, // batch count
                                                               0, // Stride A
@@ -349,7 +546,7 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
             profileRNNkernels(handle, 1, ctime);
         }
 
-        if(biasMode != 0u)
+        if(biasMode != 0u && !fuse_lstm_bias)
         {
             alpha0 = 1;
             alpha1 = 1;
@@ -422,7 +619,7 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
             }
         }
 
-        if(biasMode != 0u)
+        if(biasMode != 0u && !fuse_lstm_bias)
         {
             wei_shift_bias_temp += wei_stride;
 
@@ -505,36 +702,31 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                     }
                     else
                     {
-                        int cur_batch = 0;
-                        for(int ti = 0; ti < seqLen; ti++)
+                        for(const auto& run : GetRowRunsWithNextStep(in_n))
                         {
-                            if(ti != (seqLen - 1))
-                            {
-                                offset = hid_shift + cur_batch * hy_stride;
+                            offset = hid_shift + run.first * hy_stride;
 
-                                sp_size[1] = in_n.at(ti + 1);
-                                sp_size[2] = wei_len;
-                                sp_desc    = miopen::TensorDescriptor(
-                                    wDesc.GetType(), sp_size.data(), sp_stride.data(), 3);
+                            sp_size[1] = run.second;
+                            sp_size[2] = wei_len;
+                            sp_desc    = miopen::TensorDescriptor(
+                                wDesc.GetType(), sp_size.data(), sp_stride.data(), 3);
 
-                                OpTensor(handle,
-                                         miopenTensorOpAdd,
-                                         &alpha0,
-                                         sp_desc,
-                                         workSpace,
-                                         &alpha1,
-                                         w_desc,
-                                         w,
-                                         &beta_t,
-                                         sp_desc,
-                                         workSpace,
-                                         offset + wei_len,
-                                         wei_shift_bias_temp + wei_len,
-                                         offset + wei_len);
-                                // Update time
-                                profileRNNkernels(handle, 1, ctime);
-                            }
-                            cur_batch += in_n.at(ti);
+                            OpTensor(handle,
+                                     miopenTensorOpAdd,
+                                     &alpha0,
+                                     sp_desc,
+                                     workSpace,
+                                     &alpha1,
+                                     w_desc,
+                                     w,
+                                     &beta_t,
+                                     sp_desc,
+                                     workSpace,
+                                     offset + wei_len,
+                                     wei_shift_bias_temp + wei_len,
+                                     offset + wei_len);
+                            // Update time
+                            profileRNNkernels(handle, 1, ctime);
                         }
                     }
                 }
@@ -542,6 +734,33 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
         }
 
         // from hidden state
+        if(use_persistent)
+        {
+            const int hid_wei_shift = in_h * wei_stride + li * (bi * hy_h + hy_h) * wei_stride;
+            RNNPersistentForwardInference(handle,
+                                          wDesc.GetType(),
+                                          rnnMode,
+                                          seqLen,
+                                          in_n.at(0),
+                                          hy_h,
+                                          hy_stride,
+                                          hid_off,
+                                          bi * wei_len,
+                                          wei_q != nullptr ? wei_q : w,
+                                          wei_q != nullptr ? li * wei_stride * hy_h : hid_wei_shift,
+                                          wei_scale,
+                                          li * wei_stride,
+                                          hx,
+                                          cx,
+                                          hx_shift,
+                                          workSpace,
+                                          hid_shift,
+                                          sync_d.get(),
+                                          li);
+            // Update time
+            profileRNNkernels(handle, 1, ctime);
+        }
+
         int bacc   = 0;
         int baccbi = batch_n;
         for(int ti = 0; ti < seqLen; ti++)
@@ -551,8 +770,9 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
             int pretime_shift = 0;
             int use_time      = 0;
 
-            for(int ri = 0; ri < bi; ri++)
-            {
+            // The directions are independent until their outputs are concatenated.
+            handle.RunConcurrently(bi, [&](std::size_t dir) {
+                const int ri = static_cast<int>(dir);
                 int cur_time  = ri == 0 ? ti : seqLen - 1 - ti;
                 int cur_batch = ri == 0 ? bacc : baccbi;
                 offset        = hid_shift + cur_batch * hy_stride;
@@ -564,20 +784,30 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                     use_time = ri == 0 ? ti : seqLen - ti;
                 }
 
-                if(in_n.at(cur_time) > 0)
+                if(in_n.at(cur_time) > 0 && !use_persistent)
                 {
                     if(ti == 0)
                     {
-                        if(hx != nullptr)
+                        if(hx != nullptr && wei_q != nullptr)
+                        {
+                            quantized_hidden_gemm(li,
+                                                  ri,
+                                                  in_n.at(cur_time),
+                                                  hx,
+                                                  hx_shift + ri * hy_n * hy_h,
+                                                  uni_stride,
+                                                  static_cast<int>(offset) + ri * wei_len);
+                        }
+                        else if(hx != nullptr)
                         {
                             miopen::GemmDescriptor gemm_desc = GemmDescriptor{false,
                                                                               false,
-                                                                              true,
+                                                                              wei_trans,
                                                                               in_n.at(cur_time),
                                                                               wei_len,
                                                                               hy_h,
                                                                               uni_stride,
-                                                                              uni_stride,
+                                                                              uni_wei_ld,
                                                                               hy_stride,
                                                                               1, // batch count
                                                                               0, // Stride A
@@ -593,7 +823,7 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                                          hx,
                                          hx_shift + ri * hy_n * hy_h,
                                          w,
-                                         wei_shift + ri * wei_len * uni_stride,
+                                         wei_shift + ri * dir_wei_size,
                                          workSpace,
                                          static_cast<int>(offset) + ri * wei_len,
                                          nullptr,
@@ -617,17 +847,31 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                     }
                     else
                     {
-                        if(ri == 1 && hx != nullptr && in_n.at(cur_time) > in_n.at(use_time))
+                        const bool from_hx =
+                            ri == 1 && hx != nullptr && in_n.at(cur_time) > in_n.at(use_time);
+                        if(from_hx && wei_q != nullptr)
+                        {
+                            quantized_hidden_gemm(li,
+                                                  ri,
+                                                  in_n.at(cur_time) - in_n.at(use_time),
+                                                  hx,
+                                                  hx_shift + ri * hy_n * hy_h +
+                                                      in_n.at(use_time) * hy_h,
+                                                  uni_stride,
+                                                  static_cast<int>(offset) + ri * wei_len +
+                                                      in_n.at(use_time) * hy_stride);
+                        }
+                        else if(from_hx)
                         {
                             miopen::GemmDescriptor gemm_desc =
                                 GemmDescriptor{false,
                                                false,
-                                               true,
+                                               wei_trans,
                                                (in_n.at(cur_time) - in_n.at(use_time)),
                                                wei_len,
                                                hy_h,
                                                uni_stride,
-                                               uni_stride,
+                                               uni_wei_ld,
                                                hy_stride,
                                                1, // batch count
                                                0, // Stride A
@@ -642,7 +886,7 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                                          hx,
                                          hx_shift + ri * hy_n * hy_h + in_n.at(use_time) * hy_h,
                                          w,
-                                         wei_shift + ri * wei_len * uni_stride,
+                                         wei_shift + ri * dir_wei_size,
                                          workSpace,
                                          static_cast<int>(offset) + ri * wei_len +
                                              in_n.at(use_time) * hy_stride,
@@ -665,16 +909,26 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                             profileRNNkernels(handle, 1, ctime);
                         }
 
-                        if(in_n.at(use_time) > 0)
+                        if(in_n.at(use_time) > 0 && wei_q != nullptr)
+                        {
+                            quantized_hidden_gemm(li,
+                                                  ri,
+                                                  in_n.at(use_time),
+                                                  workSpace,
+                                                  pretime_shift + hid_off + ri * hy_h,
+                                                  hy_stride,
+                                                  static_cast<int>(offset) + ri * wei_len);
+                        }
+                        else if(in_n.at(use_time) > 0)
                         {
                             miopen::GemmDescriptor gemm_desc = GemmDescriptor{false,
                                                                               false,
-                                                                              true,
+                                                                              wei_trans,
                                                                               in_n.at(use_time),
                                                                               wei_len,
                                                                               hy_h,
                                                                               hy_stride,
-                                                                              uni_stride,
+                                                                              uni_wei_ld,
                                                                               hy_stride,
                                                                               1, // batch count
                                                                               0, // Stride A
@@ -690,7 +944,7 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                                          workSpace,
                                          pretime_shift + hid_off + ri * hy_h,
                                          w,
-                                         wei_shift + ri * wei_len * uni_stride,
+                                         wei_shift + ri * dir_wei_size,
                                          workSpace,
                                          static_cast<int>(offset) + ri * wei_len,
                                          nullptr,
@@ -759,11 +1013,15 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                                                          offset + bi * wei_len + ri * hy_h,
                                                          pretime_shift + bi * wei_len + ri * hy_h,
                                                          0,
-                                                         offset + hid_off + ri * hy_h);
+                                                         offset + hid_off + ri * hy_h,
+                                                         w,
+                                                         wei_shift_bias_temp + ri * wei_len,
+                                                         fuse_lstm_bias,
+                                                         hx != nullptr);
 
                             // Update time
                             profileRNNkernels(handle, 1, ctime);
-                            continue;
+                            return;
                         }
 
                         // active gate i, f, o
@@ -955,6 +1213,33 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                     }
                     else if(rnnMode == miopenGRU)
                     {
+                        if(algoMode == miopenRNNdefault)
+                        {
+                            GRUForwardHiddenStateUpdate(handle,
+                                                        wDesc.GetType(),
+                                                        true,
+                                                        ti == 0,
+                                                        ri,
+                                                        in_n.at(0),
+                                                        in_n.at(cur_time),
+                                                        in_n.at(use_time),
+                                                        hy_h,
+                                                        hy_stride,
+                                                        hx,
+                                                        hx_shift + ri * hy_n * hy_h,
+                                                        workSpace,
+                                                        offset + ri * wei_len,
+                                                        offset + hy_h + ri * wei_len,
+                                                        offset + 2 * hy_h + ri * wei_len,
+                                                        offset + hid_off + ri * hy_h,
+                                                        pretime_shift + hid_off + ri * hy_h,
+                                                        0);
+
+                            // Update time
+                            profileRNNkernels(handle, 1, ctime);
+                            return;
+                        }
+
                         // active z, r gate
                         sp_size[2] = 2 * hy_h;
                         sp_desc    = miopen::TensorDescriptor(
@@ -1165,7 +1450,7 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                         }
                     }
                 }
-            }
+            });
 
             bacc += in_n.at(ti);
         }
@@ -1267,6 +1552,201 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
 #endif
 }
 
+// Runs inference of a stack of unidirectional LSTM layers cell by cell, where cell (li, ti) is
+// step ti of layer li: the input GEMM of its rows, the recurrent GEMM and the gate kernel,
+// which adds the biases. A cell depends on (li - 1, ti) and (li, ti - 1) only, so all the
+// cells of a diagonal li + ti are independent and run concurrently.
+void RNNDescriptor::RNNForwardInferenceWavefront(Handle& handle,
+                                                 const std::vector<int>& in_n,
+                                                 const int in_h,
+                                                 ConstData_t x,
+                                                 ConstData_t hx,
+                                                 ConstData_t cx,
+                                                 ConstData_t w,
+                                                 const bool transposed_weights,
+                                                 Data_t hy,
+                                                 Data_t cy,
+                                                 Data_t workSpace,
+                                                 const int hy_n,
+                                                 float& ctime) const
+{
+#if MIOPEN_USE_GEMM
+    const auto data_type = dataType;
+    const int seq_len    = static_cast<int>(in_n.size());
+    const int n_layers   = static_cast<int>(nLayers);
+    const int hy_h       = static_cast<int>(hsize);
+    const int hy_stride  = hy_h * static_cast<int>(workspaceScale);
+    const int wei_len    = hy_h * 4;
+    const int wei_stride = wei_len;
+    const int hid_off    = hy_h * 5;
+    const int batch_n    = std::accumulate(in_n.begin(), in_n.end(), 0);
+
+    // first row of each time step
+    std::vector<int> batch_begin(seq_len, 0);
+    std::partial_sum(in_n.begin(), in_n.end() - 1, batch_begin.begin() + 1);
+
+    const std::size_t wei_shift_bias =
+        static_cast<std::size_t>(in_h + hy_h + 2 * hy_h * (n_layers - 1)) * wei_stride;
+
+    const auto gemm = [&](int m,
+                          int k,
+                          int lda,
+                          int ldb,
+                          ConstData_t a,
+                          int a_offset,
+                          int b_offset,
+                          int c_offset) {
+        const auto gemm_desc = GemmDescriptor{false,
+                                              false,
+                                              !transposed_weights,
+                                              m,
+                                              wei_len,
+                                              k,
+                                              lda,
+                                              transposed_weights ? wei_stride : ldb,
+                                              hy_stride,
+                                              1, // batch count
+                                              0, // Stride A
+                                              0, // Stride B
+                                              0, // Stride C
+                                              1, // alpha
+                                              1, // beta
+                                              data_type};
+        const auto gemm_status = CallGemm(handle,
+                                          gemm_desc,
+                                          a,
+                                          a_offset,
+                                          w,
+                                          b_offset,
+                                          workSpace,
+                                          c_offset,
+                                          nullptr,
+                                          false,
+                                          GemmBackend_t::miopengemm);
+        if(gemm_status != miopenStatusSuccess)
+            MIOPEN_LOG_E((gemm_status == miopenStatusNotImplemented ? "GEMM not implemented"
+                                                                    : "GEMM failed"));
+        // Update time
+        profileRNNkernels(handle, 1, ctime);
+    };
+
+    const auto run_cell = [&](int li, int ti) {
+        const int hid_shift = li * batch_n * hy_stride;
+        const int hx_shift  = li * hy_n * hy_h;
+        const int cur_batch = in_n.at(ti);
+        const int offset    = hid_shift + batch_begin.at(ti) * hy_stride;
+
+        // from input
+        if(li == 0)
+            gemm(cur_batch, in_h, in_h, in_h, x, batch_begin.at(ti) * in_h, 0, offset);
+        else
+            gemm(cur_batch,
+                 hy_h,
+                 hy_stride,
+                 hy_h,
+                 workSpace,
+                 offset - batch_n * hy_stride + hid_off,
+                 (in_h + hy_h) * wei_stride + (li - 1) * 2 * hy_h * wei_stride,
+                 offset);
+
+        // from hidden state
+        const int wei_shift     = in_h * wei_stride + li * 2 * hy_h * wei_stride;
+        const int pretime_shift = ti > 0 ? offset - in_n.at(ti - 1) * hy_stride : 0;
+        if(ti > 0)
+            gemm(cur_batch,
+                 hy_h,
+                 hy_stride,
+                 hy_h,
+                 workSpace,
+                 pretime_shift + hid_off,
+                 wei_shift,
+                 offset);
+        else if(hx != nullptr)
+            gemm(cur_batch, hy_h, hy_h, hy_h, hx, hx_shift, wei_shift, offset);
+
+        LSTMForwardHiddenStateUpdate(handle,
+                                     data_type,
+                                     true,
+                                     ti == 0,
+                                     0,
+                                     in_n.at(0),
+                                     cur_batch,
+                                     ti > 0 ? in_n.at(ti - 1) : in_n.at(0),
+                                     hy_h,
+                                     hy_stride,
+                                     wei_len,
+                                     wei_stride,
+                                     cx,
+                                     hx_shift,
+                                     workSpace,
+                                     offset,
+                                     offset + hy_h,
+                                     offset + 2 * hy_h,
+                                     offset + 3 * hy_h,
+                                     offset + wei_len,
+                                     pretime_shift + wei_len,
+                                     0,
+                                     offset + hid_off,
+                                     w,
+                                     wei_shift_bias + li * 2 * wei_stride,
+                                     biasMode != 0u,
+                                     hx != nullptr);
+        // Update time
+        profileRNNkernels(handle, 1, ctime);
+
+        // Rows which end their sequence at this step go to hy and cy.
+        const int next_batch = ti + 1 < seq_len ? in_n.at(ti + 1) : 0;
+        if(cur_batch > next_batch)
+        {
+            const std::vector<int> sp_size{1, cur_batch - next_batch, hy_h};
+            const std::vector<int> sp_stride{batch_n * hy_stride, hy_stride, 1};
+            const std::vector<int> hx_stride{hy_n * hy_h, hy_h, 1};
+            const auto sp_desc = TensorDescriptor(data_type, sp_size.data(), sp_stride.data(), 3);
+            const auto hx_desc = TensorDescriptor(data_type, sp_size.data(), hx_stride.data(), 3);
+            const int src      = offset + next_batch * hy_stride;
+            const int dst      = hx_shift + next_batch * hy_h;
+
+            if(hy != nullptr)
+            {
+                CopyTensor(handle, sp_desc, workSpace, hx_desc, hy, src + hid_off, dst);
+                // Update time
+                profileRNNkernels(handle, 1, ctime);
+            }
+            if(cy != nullptr)
+            {
+                CopyTensor(handle, sp_desc, workSpace, hx_desc, cy, src + wei_len, dst);
+                // Update time
+                profileRNNkernels(handle, 1, ctime);
+            }
+        }
+    };
+
+    for(int diag = 0; diag < n_layers + seq_len - 1; ++diag)
+    {
+        const int li_begin = std::max(0, diag - seq_len + 1);
+        const int li_end   = std::min(n_layers, diag + 1);
+        handle.RunConcurrently(static_cast<std::size_t>(li_end - li_begin), [&](std::size_t i) {
+            const int li = li_begin + static_cast<int>(i);
+            run_cell(li, diag - li);
+        });
+    }
+#else
+    (void)handle;
+    (void)in_n;
+    (void)in_h;
+    (void)x;
+    (void)hx;
+    (void)cx;
+    (void)w;
+    (void)hy;
+    (void)cy;
+    (void)workSpace;
+    (void)hy_n;
+    (void)ctime;
+    MIOPEN_THROW("GEMM is not supported");
+#endif
+}
+
 void RNNDescriptor::RNNForwardTraining(Handle& handle,
                                        const int seqLen,
                                        c_array_view<const miopenTensorDescriptor_t> xDesc,
@@ -1308,6 +1788,60 @@ void RNNDescriptor::RNNForwardTraining(Handle& handle,
         MIOPEN_THROW("Reservespace is required");
     }
 
+    if(IsReserveCompressed())
+    {
+        // The pass runs on a full copy of the reserve space at the end of the workspace, which
+        // the forward pass does not use otherwise, and keeps the compressed activations.
+        auto full               = *this;
+        full.reserveDataType    = dataType;
+        const auto layout       = GetFullReserveLayout(seqLen, xDesc);
+        const auto full_offset  = GetFullReserveOffset(handle, seqLen, xDesc);
+        const auto full_size    = layout.first + layout.second;
+        const auto full_reserve = handle.CreateSubBuffer(workSpace, full_offset, full_size);
+        full.RNNForwardTraining(handle,
+                                seqLen,
+                                xDesc,
+                                x,
+                                hxDesc,
+                                hx,
+                                cxDesc,
+                                cx,
+                                wDesc,
+                                w,
+                                yDesc,
+                                y,
+                                hyDesc,
+                                hy,
+                                cyDesc,
+                                cy,
+                                workSpace,
+                                full_offset,
+                                full_reserve.get(),
+                                full_size);
+        CompressReserve(handle, seqLen, xDesc, full_reserve.get(), reserveSpace);
+        return;
+    }
+
+    if(projSize != 0)
+    {
+        LSTMProjectionForward(handle,
+                              seqLen,
+                              xDesc,
+                              x,
+                              hxDesc,
+                              hx,
+                              cxDesc,
+                              cx,
+                              w,
+                              yDesc,
+                              y,
+                              hy,
+                              cy,
+                              reserveSpace,
+                              false);
+        return;
+    }
+
     std::string network_config;
     std::vector<int> in_n;
     int in_h  = xDesc[0].GetLengths()[1]; // input vector size
@@ -1463,6 +1997,10 @@ void RNNDescriptor::RNNForwardTraining(Handle& handle,
         activDesc = {miopenActivationTANH, 1, 1, 1};
     }
 
+    // The LSTM gate kernel adds the biases of each step itself.
+    const bool fuse_lstm_bias =
+        biasMode != 0u && rnnMode == miopenLSTM && algoMode == miopenRNNdefault;
+
     for(int li = 0; li < nLayers; li++)
     {
         int hid_shift           = li * batch_n * hy_stride;
@@ -1555,7 +2093,8 @@ void RNNDescriptor::RNNForwardTraining(Handle& handle,
                 auto drop_out_desc = miopen::TensorDescriptor(
                     wDesc.GetType(), drop_size.data(), drop_out_str.data(), 2);
 
-                size_t drop_rsv_size = drop_out_desc.GetElementSize();
+                size_t drop_rsv_size = miopen::deref(dropoutDesc)
+                                           .GetReserveSpaceSize(drop_out_desc.GetElementSize());
                 size_t drop_rsv_start =
                     algoMode == miopenRNNdefault && rnnMode == miopenLSTM
                         ? nLayers * batch_n * hy_stride + nLayers * batch_n * hy_h * bi
@@ -1629,7 +2168,7 @@ void RNNDescriptor::RNNForwardTraining(Handle& handle,
             profileRNNkernels(handle, 1, ctime);
         }
 
-        if(biasMode != 0u)
+        if(biasMode != 0u && !fuse_lstm_bias)
         {
             alpha0 = 1;
             alpha1 = 1;
@@ -1702,7 +2241,7 @@ void RNNDescriptor::RNNForwardTraining(Handle& handle,
             }
         }
 
-        if(biasMode != 0u)
+        if(biasMode != 0u && !fuse_lstm_bias)
         {
             wei_shift_bias_temp += wei_stride;
 
@@ -1785,36 +2324,31 @@ void RNNDescriptor::RNNForwardTraining(Handle& handle,
                     }
                     else
                     {
-                        int cur_batch = 0;
-                        for(int ti = 0; ti < seqLen; ti++)
+                        for(const auto& run : GetRowRunsWithNextStep(in_n))
                         {
-                            if(ti != (seqLen - 1))
-                            {
-                                offset = hid_shift + cur_batch * hy_stride;
+                            offset = hid_shift + run.first * hy_stride;
 
-                                sp_size[1] = in_n.at(ti + 1);
-                                sp_size[2] = wei_len;
-                                sp_desc    = miopen::TensorDescriptor(
-                                    wDesc.GetType(), sp_size.data(), sp_stride.data(), 3);
+                            sp_size[1] = run.second;
+                            sp_size[2] = wei_len;
+                            sp_desc    = miopen::TensorDescriptor(
+                                wDesc.GetType(), sp_size.data(), sp_stride.data(), 3);
 
-                                OpTensor(handle,
-                                         miopenTensorOpAdd,
-                                         &alpha0,
-                                         sp_desc,
-                                         reserveSpace,
-                                         &alpha1,
-                                         w_desc,
-                                         w,
-                                         &beta_t,
-                                         sp_desc,
-                                         reserveSpace,
-                                         static_cast<int>(offset) + wei_len,
-                                         wei_shift_bias_temp + wei_len,
-                                         static_cast<int>(offset) + wei_len);
-                                // Update time
-                                profileRNNkernels(handle, 1, ctime);
-                            }
-                            cur_batch += in_n.at(ti);
+                            OpTensor(handle,
+                                     miopenTensorOpAdd,
+                                     &alpha0,
+                                     sp_desc,
+                                     reserveSpace,
+                                     &alpha1,
+                                     w_desc,
+                                     w,
+                                     &beta_t,
+                                     sp_desc,
+                                     reserveSpace,
+                                     offset + wei_len,
+                                     wei_shift_bias_temp + wei_len,
+                                     offset + wei_len);
+                            // Update time
+                            profileRNNkernels(handle, 1, ctime);
                         }
                     }
                 }
@@ -1831,8 +2365,9 @@ void RNNDescriptor::RNNForwardTraining(Handle& handle,
             int pretime_shift = 0;
             int use_time      = 0;
 
-            for(int ri = 0; ri < bi; ri++)
-            {
+            // The directions are independent until their outputs are concatenated.
+            handle.RunConcurrently(bi, [&](std::size_t dir) {
+                const int ri = static_cast<int>(dir);
                 int cur_time  = ri == 0 ? ti : seqLen - 1 - ti;
                 int cur_batch = ri == 0 ? bacc : baccbi;
                 offset        = hid_shift + cur_batch * hy_stride;
@@ -2042,11 +2577,15 @@ void RNNDescriptor::RNNForwardTraining(Handle& handle,
                                                          (li * batch_n + cur_batch) * bi * hy_h +
                                                              ri * hy_h +
                                                              nLayers * batch_n * hy_stride,
-                                                         offset + hid_off + ri * hy_h);
+                                                         offset + hid_off + ri * hy_h,
+                                                         w,
+                                                         wei_shift_bias_temp + ri * wei_len,
+                                                         fuse_lstm_bias,
+                                                         hx != nullptr);
 
                             // Update time
                             profileRNNkernels(handle, 1, ctime);
-                            continue;
+                            return;
                         }
 
                         // active gate i, f, o
@@ -2242,6 +2781,33 @@ void RNNDescriptor::RNNForwardTraining(Handle& handle,
                     }
                     else if(rnnMode == miopenGRU)
                     {
+                        if(algoMode == miopenRNNdefault)
+                        {
+                            GRUForwardHiddenStateUpdate(handle,
+                                                        wDesc.GetType(),
+                                                        false,
+                                                        ti == 0,
+                                                        ri,
+                                                        in_n.at(0),
+                                                        in_n.at(cur_time),
+                                                        in_n.at(use_time),
+                                                        hy_h,
+                                                        hy_stride,
+                                                        hx,
+                                                        hx_shift + ri * hy_n * hy_h,
+                                                        reserveSpace,
+                                                        offset + ri * wei_len,
+                                                        offset + hy_h + ri * wei_len,
+                                                        offset + 2 * hy_h + ri * wei_len,
+                                                        offset + hid_off + ri * hy_h,
+                                                        pretime_shift + hid_off + ri * hy_h,
+                                                        nLayers * batch_n * hy_stride);
+
+                            // Update time
+                            profileRNNkernels(handle, 1, ctime);
+                            return;
+                        }
+
                         // active z, r gate
                         sp_size[2] = 2 * hy_h;
                         sp_desc    = miopen::TensorDescriptor(
@@ -2467,7 +3033,7 @@ void RNNDescriptor::RNNForwardTraining(Handle& handle,
                         }
                     }
                 }
-            }
+            });
 
             bacc += in_n.at(ti);
         }
@@ -2626,6 +3192,67 @@ void RNNDescriptor::RNNBackwardData(Handle& handle,
         MIOPEN_THROW("Reservespace is required");
     }
 
+    if(IsReserveCompressed())
+    {
+        // The full reserve space restored at the end of the workspace stays there for
+        // RNNBackwardWeights().
+        auto full               = *this;
+        full.reserveDataType    = dataType;
+        const auto layout       = GetFullReserveLayout(seqLen, dxDesc);
+        const auto full_offset  = GetFullReserveOffset(handle, seqLen, dxDesc);
+        const auto full_size    = layout.first + layout.second;
+        const auto full_reserve = handle.CreateSubBuffer(workSpace, full_offset, full_size);
+        DecompressReserve(handle, seqLen, dxDesc, reserveSpace, full_reserve.get());
+        full.RNNBackwardData(handle,
+                             seqLen,
+                             yDesc,
+                             y,
+                             dyDesc,
+                             dy,
+                             dhyDesc,
+                             dhy,
+                             dcyDesc,
+                             dcy,
+                             wDesc,
+                             w,
+                             hxDesc,
+                             hx,
+                             cxDesc,
+                             cx,
+                             dxDesc,
+                             dx,
+                             dhxDesc,
+                             dhx,
+                             dcxDesc,
+                             dcx,
+                             workSpace,
+                             full_offset,
+                             full_reserve.get(),
+                             full_size);
+        return;
+    }
+
+    if(projSize != 0)
+    {
+        LSTMProjectionBackwardData(handle,
+                                   seqLen,
+                                   dyDesc,
+                                   dy,
+                                   dhy,
+                                   dcy,
+                                   w,
+                                   hxDesc,
+                                   cxDesc,
+                                   cx,
+                                   dxDesc,
+                                   dx,
+                                   dhx,
+                                   dcx,
+                                   workSpace,
+                                   reserveSpace);
+        return;
+    }
+
     std::vector<int> in_n;
     int in_h  = dxDesc[0].GetLengths()[1];
     int hy_d  = dhxDesc.GetLengths()[0];
@@ -2861,7 +3488,8 @@ void RNNDescriptor::RNNBackwardData(Handle& handle,
                 auto drop_in_desc = miopen::TensorDescriptor(
                     wDesc.GetType(), drop_size.data(), drop_in_str.data(), 2);
 
-                size_t drop_rsv_size = drop_in_desc.GetElementSize();
+                size_t drop_rsv_size = miopen::deref(dropoutDesc)
+                                           .GetReserveSpaceSize(drop_in_desc.GetElementSize());
                 size_t drop_rsv_start =
                     algoMode == miopenRNNdefault && rnnMode == miopenLSTM
                         ? nLayers * batch_n * hy_stride + nLayers * batch_n * hy_h * bi
@@ -2896,8 +3524,9 @@ void RNNDescriptor::RNNBackwardData(Handle& handle,
             bacc -= in_n.at(ti);
 
             // from post state
-            for(int ri = 0; ri < bi; ri++)
-            {
+            // The directions are independent until their outputs are concatenated.
+            handle.RunConcurrently(bi, [&](std::size_t dir) {
+                const int ri = static_cast<int>(dir);
                 cur_time  = ri == 0 ? ti : seqLen - 1 - ti;
                 cur_batch = ri == 0 ? bacc : baccbi;
                 offset    = hid_shift + cur_batch * hy_stride;
@@ -3170,7 +3799,7 @@ void RNNDescriptor::RNNBackwardData(Handle& handle,
 
                             // Update time
                             profileRNNkernels(handle, 1, ctime);
-                            continue;
+                            return;
                         }
 
                         alpha0 = 1;
@@ -3515,6 +4144,37 @@ void RNNDescriptor::RNNBackwardData(Handle& handle,
                     }
                     else if(rnnMode == miopenGRU)
                     {
+                        if(algoMode == miopenRNNdefault)
+                        {
+                            GRUBackwardHiddenStateUpdate(
+                                handle,
+                                wDesc.GetType(),
+                                ti == 0,
+                                ri,
+                                in_n.at(0),
+                                in_n.at(cur_time),
+                                in_n.at(use_time2),
+                                hy_h,
+                                hy_stride,
+                                hx,
+                                hx_shift + ri * hy_n * hy_h,
+                                reserveSpace,
+                                offset + ri * wei_len + nLayers * batch_n * hy_stride,
+                                offset + hy_h + ri * wei_len + nLayers * batch_n * hy_stride,
+                                offset + 2 * hy_h + ri * wei_len + nLayers * batch_n * hy_stride,
+                                offset + dhd_off + ri * hy_h + nLayers * batch_n * hy_stride,
+                                hid_shift + pre_batch2 * hy_stride + dhd_off + ri * hy_h,
+                                workSpace,
+                                offset + ri * wei_len,
+                                offset + hy_h + ri * wei_len,
+                                offset + 2 * hy_h + ri * wei_len,
+                                offset + dhd_off + ri * hy_h);
+
+                            // Update time
+                            profileRNNkernels(handle, 1, ctime);
+                            return;
+                        }
+
                         // c gate
                         alpha0 = 1;
                         alpha1 = -1;
@@ -3753,7 +4413,7 @@ void RNNDescriptor::RNNBackwardData(Handle& handle,
                         profileRNNkernels(handle, 1, ctime);
                     }
                 }
-            }
+            });
 
             baccbi += in_n.at(seqLen - 1 - ti);
         }
@@ -4115,6 +4775,39 @@ void RNNDescriptor::RNNBackwardWeights(Handle& handle,
         MIOPEN_THROW("Reservespace is required");
     }
 
+    if(IsReserveCompressed())
+    {
+        // RNNBackwardData() left the full reserve space at the end of the workspace.
+        auto full               = *this;
+        full.reserveDataType    = dataType;
+        const auto layout       = GetFullReserveLayout(seqLen, xDesc);
+        const auto full_offset  = GetFullReserveOffset(handle, seqLen, xDesc);
+        const auto full_size    = layout.first + layout.second;
+        const auto full_reserve = handle.CreateSubBuffer(workSpace, full_offset, full_size);
+        full.RNNBackwardWeights(handle,
+                                seqLen,
+                                xDesc,
+                                x,
+                                hxDesc,
+                                hx,
+                                dyDesc,
+                                dy,
+                                dwDesc,
+                                dw,
+                                workSpace,
+                                full_offset,
+                                full_reserve.get(),
+                                full_size);
+        return;
+    }
+
+    if(projSize != 0)
+    {
+        LSTMProjectionBackwardWeights(
+            handle, seqLen, xDesc, x, hxDesc, hx, dyDesc, dw, workSpace, reserveSpace);
+        return;
+    }
+
     std::string network_config;
     std::vector<int> in_n;
     int in_h  = xDesc[0].GetLengths()[1];
@@ -4445,76 +5138,80 @@ void RNNDescriptor::RNNBackwardWeights(Handle& handle,
             }
             else
             {
-                sp_size[1] = 1;
-                sp_size[2] = wei_len;
-                w_size[1]  = 1;
-                w_size[2]  = wei_len;
-                w_desc =
-                    miopen::TensorDescriptor(dwDesc.GetType(), w_size.data(), w_stride.data(), 3);
-                sp_desc =
-                    miopen::TensorDescriptor(dwDesc.GetType(), sp_size.data(), sp_stride.data(), 3);
+                // Without hx the first step has no recurrent GEMM, and the rows of all the
+                // later steps are summed into the bias gradient by one launch.
+                if(batch_n > in_n.at(0))
+                {
+                    sp_size[1] = batch_n - in_n.at(0);
+                    sp_size[2] = wei_len;
+                    w_size[1]  = 1;
+                    w_size[2]  = wei_len;
+                    w_desc     = miopen::TensorDescriptor(
+                        dwDesc.GetType(), w_size.data(), w_stride.data(), 3);
+                    sp_desc = miopen::TensorDescriptor(
+                        dwDesc.GetType(), sp_size.data(), sp_stride.data(), 3);
+
+                    float sum_alpha0 = 0;
+                    float sum_alpha1 = 1;
+                    float sum_beta   = 1;
+
+                    OpTensor(handle,
+                             miopenTensorOpAdd,
+                             &sum_alpha0,
+                             w_desc,
+                             dw,
+                             &sum_alpha1,
+                             sp_desc,
+                             workSpace,
+                             &sum_beta,
+                             w_desc,
+                             dw,
+                             wei_shift,
+                             hid_shift + in_n.at(0) * hy_stride,
+                             wei_shift);
+
+                    // Update time
+                    profileRNNkernels(handle, 1, ctime);
+                }
 
-                for(int bs = 0; bs < batch_n; bs++)
+                if(dirMode != 0u)
                 {
-                    if(!(hx == nullptr && bs < in_n.at(0)))
+                    w_size[1] = 1;
+                    w_size[2] = wei_len;
+                    w_desc    = miopen::TensorDescriptor(
+                        dwDesc.GetType(), w_size.data(), w_stride.data(), 3);
+
+                    float sum_alpha0 = 0;
+                    float sum_alpha1 = 1;
+                    float sum_beta   = 1;
+
+                    // Each run of rows is summed into the bias gradient by one launch.
+                    for(const auto& run : GetRowRunsWithNextStep(in_n))
                     {
+                        sp_size[1] = run.second;
+                        sp_size[2] = wei_len;
+                        sp_desc    = miopen::TensorDescriptor(
+                            dwDesc.GetType(), sp_size.data(), sp_stride.data(), 3);
+
                         OpTensor(handle,
                                  miopenTensorOpAdd,
-                                 &alpha0,
-                                 sp_desc,
-                                 workSpace,
-                                 &alpha1,
+                                 &sum_alpha0,
                                  w_desc,
                                  dw,
-                                 &beta_t,
+                                 &sum_alpha1,
+                                 sp_desc,
+                                 workSpace,
+                                 &sum_beta,
                                  w_desc,
                                  dw,
-                                 hid_shift + bs * hy_stride,
-                                 wei_shift,
-                                 wei_shift);
+                                 wei_shift + wei_len,
+                                 hid_shift + run.first * hy_stride + wei_len,
+                                 wei_shift + wei_len);
 
                         // Update time
                         profileRNNkernels(handle, 1, ctime);
                     }
                 }
-
-                if(dirMode != 0u)
-                {
-                    sp_size[1] = 1;
-                    sp_size[2] = wei_len;
-                    w_size[1]  = 1;
-                    w_size[2]  = wei_len;
-                    w_desc     = miopen::TensorDescriptor(
-                        dwDesc.GetType(), w_size.data(), w_stride.data(), 3);
-                    sp_desc = miopen::TensorDescriptor(
-                        dwDesc.GetType(), sp_size.data(), sp_stride.data(), 3);
-
-                    int cur_batch = 0;
-                    for(int ti = 0; ti < seqLen - 1; ti++)
-                    {
-                        for(int bs = 0; bs < in_n.at(ti + 1); bs++)
-                        {
-                            OpTensor(handle,
-                                     miopenTensorOpAdd,
-                                     &alpha0,
-                                     sp_desc,
-                                     workSpace,
-                                     &alpha1,
-                                     w_desc,
-                                     dw,
-                                     &beta_t,
-                                     w_desc,
-                                     dw,
-                                     hid_shift + (cur_batch + bs) * hy_stride + wei_len,
-                                     wei_shift + wei_len,
-                                     wei_shift + wei_len);
-
-                            // Update time
-                            profileRNNkernels(handle, 1, ctime);
-                        }
-                        cur_batch += in_n.at(ti);
-                    }
-                }
             }
         }
 
@@ -4528,6 +5225,60 @@ void RNNDescriptor::RNNBackwardWeights(Handle& handle,
             }
         }
 
+        // dw += dh^T * h of the previous step. The GEMMs of the directions of a step are
+        // independent, so they run as one group.
+        std::vector<GemmGroupProblem> hidden_gemms;
+        auto add_hidden_gemm =
+            [&](int k, int a_offset, ConstData_t h, int ldb, int b_offset, int c_offset) {
+                hidden_gemms.push_back({GemmDescriptor{false,
+                                                       true,
+                                                       false,
+                                                       wei_len,
+                                                       hy_h,
+                                                       k,
+                                                       hy_stride,
+                                                       ldb,
+                                                       uni_stride,
+                                                       1, // batch count
+                                                       0, // Stride A
+                                                       0, // Stride B
+                                                       0, // Stride C
+                                                       1, // alpha
+                                                       1, // beta
+                                                       xDesc[0].GetType()},
+                                        workSpace,
+                                        a_offset,
+                                        h,
+                                        b_offset,
+                                        dw,
+                                        c_offset});
+            };
+        auto run_hidden_gemms = [&](bool last) {
+            if(hidden_gemms.empty())
+                return;
+
+            miopenStatus_t gemm_status =
+                CallGemmGrouped(handle, hidden_gemms, GemmBackend_t::miopengemm);
+
+            if(gemm_status != miopenStatusSuccess)
+            {
+                if(gemm_status == miopenStatusNotImplemented)
+                {
+                    MIOPEN_LOG_E("GEMM not implemented");
+                }
+                else
+                {
+                    MIOPEN_LOG_E("GEMM failed");
+                }
+            }
+            // Update time
+            if(last)
+                profileRNNkernels(handle, 2, ctime);
+            else
+                profileRNNkernels(handle, 1, ctime);
+            hidden_gemms.clear();
+        };
+
         if(comb_check)
         {
             hx_shift  = li * hy_n * bi_stride;
@@ -4542,103 +5293,25 @@ void RNNDescriptor::RNNBackwardWeights(Handle& handle,
 
                 if(in_n.at(cur_time) > 0 && hx != nullptr)
                 {
-                    miopen::GemmDescriptor gemm_desc = GemmDescriptor{false,
-                                                                      true,
-                                                                      false,
-                                                                      wei_len,
-                                                                      hy_h,
-                                                                      in_n.at(cur_time),
-                                                                      hy_stride,
-                                                                      uni_stride,
-                                                                      uni_stride,
-                                                                      1, // batch count
-                                                                      0, // Stride A
-                                                                      0, // Stride B
-                                                                      0, // Stride C
-                                                                      1, // alpha
-                                                                      1, // beta
-                                                                      xDesc[0].GetType()};
-
-                    miopenStatus_t gemm_status = CallGemm(handle,
-                                                          gemm_desc,
-                                                          workSpace,
-                                                          hid_shift + ri * wei_len,
-                                                          hx,
-                                                          hx_shift + ri * hy_n * hy_h,
-                                                          dw,
-                                                          wei_shift + ri * wei_len * uni_stride,
-                                                          nullptr,
-                                                          false,
-                                                          GemmBackend_t::miopengemm);
-
-                    if(gemm_status != miopenStatusSuccess)
-                    {
-                        if(gemm_status == miopenStatusNotImplemented)
-                        {
-                            MIOPEN_LOG_E("GEMM not implemented");
-                        }
-                        else
-                        {
-                            MIOPEN_LOG_E("GEMM failed");
-                        }
-                    }
-
-                    // Update time
-                    if(li == nLayers - 1 && ri == bi - 1 && seqLen == 1)
-                        profileRNNkernels(handle, 2, ctime);
-                    else
-                        profileRNNkernels(handle, 1, ctime);
+                    add_hidden_gemm(in_n.at(cur_time),
+                                    hid_shift + ri * wei_len,
+                                    hx,
+                                    uni_stride,
+                                    hx_shift + ri * hy_n * hy_h,
+                                    wei_shift + ri * wei_len * uni_stride);
                 }
 
                 if(seqLen > 1)
                 {
                     if(ri == 1 && hx != nullptr && in_n.at(0) > in_n.at(seqLen - 1))
                     {
-                        miopen::GemmDescriptor gemm_desc =
-                            GemmDescriptor{false,
-                                           true,
-                                           false,
-                                           wei_len,
-                                           hy_h,
-                                           (in_n.at(0) - in_n.at(seqLen - 1)),
-                                           hy_stride,
-                                           uni_stride,
-                                           uni_stride,
-                                           1, // batch count
-                                           0, // Stride A
-                                           0, // Stride B
-                                           0, // Stride C
-                                           1, // alpha
-                                           1, // beta
-                                           xDesc[0].GetType()};
-
-                        miopenStatus_t gemm_status =
-                            CallGemm(handle,
-                                     gemm_desc,
-                                     workSpace,
-                                     hid_shift + ri * wei_len -
-                                         (in_n.at(0) - in_n.at(seqLen - 1)) * hy_stride,
-                                     hx,
-                                     hx_shift + ri * hy_n * hy_h + in_n.at(seqLen - 1) * hy_h,
-                                     dw,
-                                     wei_shift + ri * wei_len * uni_stride,
-                                     nullptr,
-                                     false,
-                                     GemmBackend_t::miopengemm);
-
-                        if(gemm_status != miopenStatusSuccess)
-                        {
-                            if(gemm_status == miopenStatusNotImplemented)
-                            {
-                                MIOPEN_LOG_E("GEMM not implemented");
-                            }
-                            else
-                            {
-                                MIOPEN_LOG_E("GEMM failed");
-                            }
-                        }
-                        // Update time
-                        profileRNNkernels(handle, 1, ctime);
+                        add_hidden_gemm((in_n.at(0) - in_n.at(seqLen - 1)),
+                                        hid_shift + ri * wei_len -
+                                            (in_n.at(0) - in_n.at(seqLen - 1)) * hy_stride,
+                                        hx,
+                                        uni_stride,
+                                        hx_shift + ri * hy_n * hy_h + in_n.at(seqLen - 1) * hy_h,
+                                        wei_shift + ri * wei_len * uni_stride);
                     }
 
                     hid_shift = ri == 0 ? (li * batch_n * hy_stride + in_n.at(0) * hy_stride)
@@ -4647,54 +5320,15 @@ void RNNDescriptor::RNNBackwardWeights(Handle& handle,
                         ri == 0 ? li * batch_n * hy_stride + hid_off
                                 : li * batch_n * hy_stride + in_n.at(0) * hy_stride + hid_off;
 
-                    miopen::GemmDescriptor gemm_desc =
-                        GemmDescriptor{false,
-                                       true,
-                                       false,
-                                       wei_len,
-                                       hy_h,
-                                       in_n.at(0) * (seqLen - 2) + in_n.at(seqLen - 1),
-                                       hy_stride,
-                                       hy_stride,
-                                       uni_stride,
-                                       1, // batch count
-                                       0, // Stride A
-                                       0, // Stride B
-                                       0, // Stride C
-                                       1, // alpha
-                                       1, // beta
-                                       xDesc[0].GetType()};
-
-                    miopenStatus_t gemm_status = CallGemm(handle,
-                                                          gemm_desc,
-                                                          workSpace,
-                                                          hid_shift + ri * wei_len,
-                                                          reserveSpace,
-                                                          pretime_shift + ri * hy_h,
-                                                          dw,
-                                                          wei_shift + ri * wei_len * uni_stride,
-                                                          nullptr,
-                                                          false,
-                                                          GemmBackend_t::miopengemm);
-
-                    if(gemm_status != miopenStatusSuccess)
-                    {
-                        if(gemm_status == miopenStatusNotImplemented)
-                        {
-                            MIOPEN_LOG_E("GEMM not implemented");
-                        }
-                        else
-                        {
-                            MIOPEN_LOG_E("GEMM failed");
-                        }
-                    }
-                    // Update time
-                    if(li == nLayers - 1 && ri == bi - 1)
-                        profileRNNkernels(handle, 2, ctime);
-                    else
-                        profileRNNkernels(handle, 1, ctime);
+                    add_hidden_gemm(in_n.at(0) * (seqLen - 2) + in_n.at(seqLen - 1),
+                                    hid_shift + ri * wei_len,
+                                    reserveSpace,
+                                    hy_stride,
+                                    pretime_shift + ri * hy_h,
+                                    wei_shift + ri * wei_len * uni_stride);
                 }
             }
+            run_hidden_gemms(li == nLayers - 1);
         }
         else
         {
@@ -4725,103 +5359,25 @@ void RNNDescriptor::RNNBackwardWeights(Handle& handle,
                         {
                             if(hx != nullptr)
                             {
-                                miopen::GemmDescriptor gemm_desc =
-                                    GemmDescriptor{false,
-                                                   true,
-                                                   false,
-                                                   wei_len,
-                                                   hy_h,
-                                                   in_n.at(cur_time),
-                                                   hy_stride,
-                                                   uni_stride,
-                                                   uni_stride,
-                                                   1, // batch count
-                                                   0, // Stride A
-                                                   0, // Stride B
-                                                   0, // Stride C
-                                                   1, // alpha
-                                                   1, // beta
-                                                   xDesc[0].GetType()};
-
-                                miopenStatus_t gemm_status =
-                                    CallGemm(handle,
-                                             gemm_desc,
-                                             workSpace,
-                                             hid_shift + ri * wei_len,
-                                             hx,
-                                             hx_shift + ri * hy_n * hy_h,
-                                             dw,
-                                             wei_shift + ri * wei_len * uni_stride,
-                                             nullptr,
-                                             false,
-                                             GemmBackend_t::miopengemm);
-
-                                if(gemm_status != miopenStatusSuccess)
-                                {
-                                    if(gemm_status == miopenStatusNotImplemented)
-                                    {
-                                        MIOPEN_LOG_E("GEMM not implemented");
-                                    }
-                                    else
-                                    {
-                                        MIOPEN_LOG_E("GEMM failed");
-                                    }
-                                }
-                                // Update time
-                                if(li == nLayers - 1 && ti == seqLen - 1 && ri == bi - 1)
-                                    profileRNNkernels(handle, 2, ctime);
-                                else
-                                    profileRNNkernels(handle, 1, ctime);
+                                add_hidden_gemm(in_n.at(cur_time),
+                                                hid_shift + ri * wei_len,
+                                                hx,
+                                                uni_stride,
+                                                hx_shift + ri * hy_n * hy_h,
+                                                wei_shift + ri * wei_len * uni_stride);
                             }
                         }
                         else
                         {
                             if(ri == 1 && hx != nullptr && in_n.at(cur_time) > in_n.at(use_time))
                             {
-                                miopen::GemmDescriptor gemm_desc =
-                                    GemmDescriptor{false,
-                                                   true,
-                                                   false,
-                                                   wei_len,
-                                                   hy_h,
-                                                   (in_n.at(cur_time) - in_n.at(use_time)),
-                                                   hy_stride,
-                                                   uni_stride,
-                                                   uni_stride,
-                                                   1, // batch count
-                                                   0, // Stride A
-                                                   0, // Stride B
-                                                   0, // Stride C
-                                                   1, // alpha
-                                                   1, // beta
-                                                   xDesc[0].GetType()};
-
-                                miopenStatus_t gemm_status = CallGemm(
-                                    handle,
-                                    gemm_desc,
-                                    workSpace,
+                                add_hidden_gemm(
+                                    (in_n.at(cur_time) - in_n.at(use_time)),
                                     hid_shift + ri * wei_len + in_n.at(use_time) * hy_stride,
                                     hx,
+                                    uni_stride,
                                     hx_shift + ri * hy_n * hy_h + in_n.at(use_time) * hy_h,
-                                    dw,
-                                    wei_shift + ri * wei_len * uni_stride,
-                                    nullptr,
-                                    false,
-                                    GemmBackend_t::miopengemm);
-
-                                if(gemm_status != miopenStatusSuccess)
-                                {
-                                    if(gemm_status == miopenStatusNotImplemented)
-                                    {
-                                        MIOPEN_LOG_E("GEMM not implemented");
-                                    }
-                                    else
-                                    {
-                                        MIOPEN_LOG_E("GEMM failed");
-                                    }
-                                }
-                                // Update time
-                                profileRNNkernels(handle, 1, ctime);
+                                    wei_shift + ri * wei_len * uni_stride);
                             }
 
                             pretime_shift =
@@ -4829,57 +5385,17 @@ void RNNDescriptor::RNNBackwardWeights(Handle& handle,
 
                             if(in_n.at(use_time) > 0)
                             {
-                                miopen::GemmDescriptor gemm_desc =
-                                    GemmDescriptor{false,
-                                                   true,
-                                                   false,
-                                                   wei_len,
-                                                   hy_h,
-                                                   in_n.at(use_time),
-                                                   hy_stride,
-                                                   hy_stride,
-                                                   uni_stride,
-                                                   1, // batch count
-                                                   0, // Stride A
-                                                   0, // Stride B
-                                                   0, // Stride C
-                                                   1, // alpha
-                                                   1, // beta
-                                                   xDesc[0].GetType()};
-
-                                miopenStatus_t gemm_status =
-                                    CallGemm(handle,
-                                             gemm_desc,
-                                             workSpace,
-                                             hid_shift + ri * wei_len,
-                                             reserveSpace,
-                                             pretime_shift + ri * hy_h,
-                                             dw,
-                                             wei_shift + ri * wei_len * uni_stride,
-                                             nullptr,
-                                             false,
-                                             GemmBackend_t::miopengemm);
-
-                                if(gemm_status != miopenStatusSuccess)
-                                {
-                                    if(gemm_status == miopenStatusNotImplemented)
-                                    {
-                                        MIOPEN_LOG_E("GEMM not implemented");
-                                    }
-                                    else
-                                    {
-                                        MIOPEN_LOG_E("GEMM failed");
-                                    }
-                                }
-                                // Update time
-                                if(li == nLayers - 1 && ti == seqLen - 1 && ri == bi - 1)
-                                    profileRNNkernels(handle, 2, ctime);
-                                else
-                                    profileRNNkernels(handle, 1, ctime);
+                                add_hidden_gemm(in_n.at(use_time),
+                                                hid_shift + ri * wei_len,
+                                                reserveSpace,
+                                                hy_stride,
+                                                pretime_shift + ri * hy_h,
+                                                wei_shift + ri * wei_len * uni_stride);
                             }
                         }
                     }
                 }
+                run_hidden_gemms(li == nLayers - 1 && ti == seqLen - 1);
 
                 bacc += in_n.at(ti);
             }
@@ -116,6 +116,10 @@ miopenStatus_t SoftmaxForward(const Handle& handle,
         size_t workgroups = std::min(grid_size, 64 * 40 * 8);
         const std::vector<size_t> vgd{workgroups * vld[0], 1, 1};
 
+        // Long rows no longer stay in cache between the max and the sum passes, so they are read
+        // once with a running max instead
+        const bool online = algorithm != MIOPEN_SOFTMAX_FAST && vector_size >= 4096;
+
         std::string algo_name = "SoftmaxForwardOneBatch";
         std::string network_config =
             "sfmfwd-n" + std::to_string(num_batch) + "half" +
@@ -127,7 +131,8 @@ miopenStatus_t SoftmaxForward(const Handle& handle,
             std::to_string(static_cast<int>(xDesc.IsPacked())) + "ypk" +
             std::to_string(static_cast<int>(yDesc.IsPacked())) + "a" + std::to_string(alpha_fp) +
             "b" + std::to_string(beta_fp) + "algo" + std::to_string(static_cast<int>(algorithm)) +
-            "mode" + std::to_string(static_cast<int>(mode));
+            "mode" + std::to_string(static_cast<int>(mode)) + "online" +
+            std::to_string(static_cast<int>(online));
 
         auto&& kernels = handle.GetKernels(algo_name, network_config);
 
@@ -173,6 +178,9 @@ miopenStatus_t SoftmaxForward(const Handle& handle,
             else
                 parms += " -DUSE_SOFTMAX_MODE_CHANNEL=1";
 
+            if(online)
+                parms += " -DUSE_SOFTMAX_ONLINE=1";
+
             parms += " -DRUN_FORWARD=1";
             parms += " -DIS_INPUT_PACKED=" + std::to_string(static_cast<int>(xDesc.IsPacked())) +
                      " -DIS_OUTPUT_PACKED=" + std::to_string(static_cast<int>(yDesc.IsPacked()));
@@ -610,4 +618,90 @@ miopenStatus_t SoftmaxBackward(const Handle& handle,
     return miopenStatusSuccess;
 }
 
+miopenStatus_t SoftmaxCrossEntropy(const Handle& handle,
+                                   const TensorDescriptor& xDesc,
+                                   ConstData_t x,
+                                   ConstData_t labels,
+                                   const TensorDescriptor& lossDesc,
+                                   Data_t loss,
+                                   const TensorDescriptor& dxDesc,
+                                   Data_t dx)
+{
+    if(x == nullptr || labels == nullptr || loss == nullptr)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Null pointer for tensor.");
+    }
+
+    int n, c, h, w;
+    std::tie(n, c, h, w) = tien<4>(xDesc.GetLengths());
+
+    const std::vector<std::size_t> loss_lens{std::size_t(n), 1, std::size_t(h), std::size_t(w)};
+    if(lossDesc.GetLengths() != loss_lens)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Loss tensor has to be of N x 1 x H x W.");
+    }
+
+    const bool use_dx = dx != nullptr;
+    if(use_dx && dxDesc.GetLengths() != xDesc.GetLengths())
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Tensor dimension lengths do not match.");
+    }
+
+    if(xDesc.GetType() != lossDesc.GetType() || (use_dx && xDesc.GetType() != dxDesc.GetType()))
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Tensor types do not match.");
+    }
+
+    if(!xDesc.IsPacked() || !lossDesc.IsPacked() || (use_dx && !dxDesc.IsPacked()))
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Only packed tensors are supported.");
+    }
+
+    const int grid_size   = n * h * w;
+    const int spatial_dim = h * w;
+    const int vector_size = c;
+
+    const std::vector<size_t> vld{256, 1, 1};
+    const size_t workgroups = std::min(grid_size, 64 * 40 * 8);
+    const std::vector<size_t> vgd{workgroups * vld[0], 1, 1};
+
+    const bool usefp16 = xDesc.GetType() == miopenHalf;
+    const bool usefp32 = !usefp16;
+
+    std::string algo_name      = "SoftmaxCrossEntropy";
+    std::string network_config = "sfmce-half" + std::to_string(static_cast<int>(usefp16)) +
+                                 "g" + std::to_string(vgd[0]) + "dim" +
+                                 std::to_string(spatial_dim) + "grid" + std::to_string(grid_size) +
+                                 "v" + std::to_string(vector_size) + "dx" +
+                                 std::to_string(static_cast<int>(use_dx));
+
+    auto&& kernels = handle.GetKernels(algo_name, network_config);
+
+    if(!kernels.empty())
+    {
+        kernels.front()(x, labels, loss, dx, vector_size, grid_size, spatial_dim, 0, 0);
+    }
+    else
+    {
+        std::string program_name = "MIOpenSoftmax.cl";
+        std::string kernel_name  = "SoftmaxCrossEntropy";
+
+        std::string parms = "-DMIOPEN_USE_FP16=" + std::to_string(static_cast<int>(usefp16)) +
+                            " -DMIOPEN_USE_FP32=" + std::to_string(static_cast<int>(usefp32)) +
+                            " -DUSE_SOFTMAX_LOG=1 -DUSE_SOFTMAX_MODE_CHANNEL=1" +
+                            " -DRUN_CROSS_ENTROPY=1 -DUSE_GRADIENT=" +
+                            std::to_string(static_cast<int>(use_dx));
+
+        handle.AddKernel(algo_name, network_config, program_name, kernel_name, vld, vgd, parms)(
+            x, labels, loss, dx, vector_size, grid_size, spatial_dim, 0, 0);
+    }
+    if(miopen::CheckNumericsEnabled())
+    {
+        miopen::checkNumericsOutput(handle, lossDesc, loss);
+        if(use_dx)
+            miopen::checkNumericsOutput(handle, dxDesc, dx);
+    }
+    return miopenStatusSuccess;
+}
+
 } // namespace miopen
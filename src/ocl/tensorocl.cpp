@@ -33,6 +33,7 @@
 #include <miopen/util.hpp>
 #include <algorithm>
 #include <cassert>
+#include <limits>
 #include <numeric>
 #include <boost/range/combine.hpp>
 
@@ -105,6 +106,12 @@ static void CreateBitmapAndGrid(unsigned int& bitmap,
     }
 }
 
+// The tensor kernels take the scaling factors of bfloat16 tensors in float.
+static miopenDataType_t GetTensorOpScalarType(miopenDataType_t type)
+{
+    return type == miopenBFloat16 ? miopenFloat : type;
+}
+
 static bool IsBitmapLeadingOnes(unsigned int bitmap, int n_size, int first_not_one)
 {
     bool leading_ones = true;
@@ -179,7 +186,7 @@ void OpTensor3d(const Handle& handle,
 
     // for naive tensor ops
     size_t RD_BLCK              = (clens[2] % 4 == 0) ? 4 : (clens[2] % 2 == 0) ? 2 : 1;
-    const std::string data_type = GetDataType(bTensorDesc.GetType());
+    const std::string data_type = GetKernelStorageType(bTensorDesc.GetType());
     const std::string READ_TYPE = (RD_BLCK == 1) ? data_type : data_type + std::to_string(RD_BLCK);
 
     size_t total_work = std::max(clens[2] / RD_BLCK, size_t(1));
@@ -193,7 +200,7 @@ void OpTensor3d(const Handle& handle,
     grp_sz2               = std::min(size_t(max_num_wg / grp_sz), grp_sz2);
     size_t glb_sz2        = local_threads2 * grp_sz2;
 
-    visit_float(bTensorDesc.GetType(), [&](auto as_float) {
+    visit_float(GetTensorOpScalarType(bTensorDesc.GetType()), [&](auto as_float) {
 
         auto miopen_alpha0 = as_float(*(static_cast<const float*>(alpha0)));
         auto miopen_alpha1 = as_float(*(static_cast<const float*>(alpha1)));
@@ -302,7 +309,7 @@ void OpTensor3d(const Handle& handle,
             }
         }
 
-        std::string parms = " -DMIOPEN_TYPE=" + GetDataType(bTensorDesc.GetType());
+        std::string parms = " -DMIOPEN_TYPE=" + GetKernelStorageType(bTensorDesc.GetType());
 
         parms += GetDataTypeKernelParams(aTensorDesc.GetType());
 
@@ -524,7 +531,7 @@ void OpTensor4d(const Handle& handle,
 #endif
 
     // for naive tensor ops
-    const std::string data_type = GetDataType(bTensorDesc.GetType());
+    const std::string data_type = GetKernelStorageType(bTensorDesc.GetType());
 
     size_t TENS_LEN             = cTensorDesc.GetElementSize();
     size_t RD_BLCK              = (TENS_LEN % 4 == 0) ? 4 : (TENS_LEN % 2 == 0) ? 2 : 1;
@@ -542,7 +549,7 @@ void OpTensor4d(const Handle& handle,
         ((fwd_conv_bias == 0 && packed_equal_tensor) ? "" : std::to_string(global_threads)) + "-" +
         std::to_string(local_threads);
 
-    visit_float(bTensorDesc.GetType(), [&](auto as_float) {
+    visit_float(GetTensorOpScalarType(bTensorDesc.GetType()), [&](auto as_float) {
 
         auto miopen_alpha0 = as_float(*(static_cast<const float*>(alpha0)));
         auto miopen_alpha1 = as_float(*(static_cast<const float*>(alpha1)));
@@ -737,7 +744,7 @@ void OpTensor4d(const Handle& handle,
             }
         }
 
-        std::string parms = " -DMIOPEN_TYPE=" + GetDataType(bTensorDesc.GetType()) +
+        std::string parms = " -DMIOPEN_TYPE=" + GetKernelStorageType(bTensorDesc.GetType()) +
                             " -DMAX_NUM_WG=" + std::to_string(max_num_wg);
 
         parms += GetDataTypeKernelParams(aTensorDesc.GetType());
@@ -1010,7 +1017,7 @@ void OpTensorOther(const Handle& handle,
                       std::to_string(aTensorDesc.GetType()) + "-" + std::to_string(tensorOp) + "-" +
                       std::to_string(global_threads) + "-" + std::to_string(local_threads);
 
-    visit_float(bTensorDesc.GetType(), [&](auto as_float) {
+    visit_float(GetTensorOpScalarType(bTensorDesc.GetType()), [&](auto as_float) {
 
         auto miopen_alpha0 = as_float(*(static_cast<const float*>(alpha0)));
         auto miopen_alpha1 = as_float(*(static_cast<const float*>(alpha1)));
@@ -1111,7 +1118,7 @@ void OpTensorOther(const Handle& handle,
             }
         }
 
-        std::string parms = " -DMIOPEN_TYPE=" + GetDataType(bTensorDesc.GetType()) +
+        std::string parms = " -DMIOPEN_TYPE=" + GetKernelStorageType(bTensorDesc.GetType()) +
                             " -DMAX_NUM_WG=" + std::to_string(max_num_wg);
 
         parms += GetDataTypeKernelParams(aTensorDesc.GetType());
@@ -1225,6 +1232,278 @@ void OpTensorOther(const Handle& handle,
     });
 }
 
+// Dimensions of an OpTensor problem, innermost first, after dropping unit dimensions and merging
+// every dimension into its inner neighbour that all three tensors walk contiguously.
+// B strides are 0 along the broadcast dimensions.
+struct OpTensorNdDims
+{
+    std::vector<std::size_t> lens;
+    std::vector<std::size_t> a_strides;
+    std::vector<std::size_t> b_strides;
+    std::vector<std::size_t> c_strides;
+};
+
+static OpTensorNdDims CollapseOpTensorDims(const TensorDescriptor& aTensorDesc,
+                                           const TensorDescriptor& bTensorDesc,
+                                           const TensorDescriptor& cTensorDesc)
+{
+    const auto& blens    = bTensorDesc.GetLengths();
+    const auto& clens    = cTensorDesc.GetLengths();
+    const auto& astrides = aTensorDesc.GetStrides();
+    const auto& bstrides = bTensorDesc.GetStrides();
+    const auto& cstrides = cTensorDesc.GetStrides();
+
+    OpTensorNdDims dims;
+    for(auto i = clens.size(); i-- > 0;)
+    {
+        if(clens[i] == 1)
+            continue;
+
+        std::size_t b_stride = blens[i] == 1 ? 0 : bstrides[i];
+
+        if(!dims.lens.empty() && astrides[i] == dims.a_strides.back() * dims.lens.back() &&
+           b_stride == dims.b_strides.back() * dims.lens.back() &&
+           cstrides[i] == dims.c_strides.back() * dims.lens.back())
+        {
+            dims.lens.back() *= clens[i];
+            continue;
+        }
+
+        dims.lens.push_back(clens[i]);
+        dims.a_strides.push_back(astrides[i]);
+        dims.b_strides.push_back(b_stride);
+        dims.c_strides.push_back(cstrides[i]);
+    }
+
+    if(dims.lens.empty())
+    {
+        dims.lens.push_back(1);
+        dims.a_strides.push_back(1);
+        dims.b_strides.push_back(0);
+        dims.c_strides.push_back(1);
+    }
+    return dims;
+}
+
+// Vector width of the (rows x cols) fast path, 0 when the collapsed problem does not fit it:
+// at most two dimensions, cols contiguous in a and c, and b either running along the cols or
+// constant along them.
+static std::size_t GetOpTensorNdLiteReadUnit(const OpTensorNdDims& dims,
+                                             const size_t Aoffset,
+                                             const size_t Boffset,
+                                             const size_t Coffset)
+{
+    if(dims.lens.size() > 2 || dims.a_strides[0] != 1 || dims.c_strides[0] != 1 ||
+       dims.b_strides[0] > 1)
+        return 0;
+
+    bool b_vec       = dims.b_strides[0] == 1;
+    auto is_multiple = [&](std::size_t unit) {
+        bool aligned = dims.lens[0] % unit == 0 && Aoffset % unit == 0 && Coffset % unit == 0 &&
+                       (!b_vec || Boffset % unit == 0);
+        if(dims.lens.size() == 2)
+            aligned = aligned && dims.a_strides[1] % unit == 0 && dims.c_strides[1] % unit == 0 &&
+                      (!b_vec || dims.b_strides[1] % unit == 0);
+        return aligned;
+    };
+
+    return is_multiple(4) ? 4 : is_multiple(2) ? 2 : 1;
+}
+
+// host-side twin of the uint4 (length, a stride, b stride, c stride) kernel argument
+struct OpTensorNdDim
+{
+    unsigned int len;
+    unsigned int a_stride;
+    unsigned int b_stride;
+    unsigned int c_stride;
+};
+
+// Broadcast engine for any rank: the collapsed problem runs as a vectorized (rows x cols) kernel
+// for elementwise, row and column broadcasts, and otherwise as a generic kernel over up to
+// 8 dimensions; dimensions beyond the 8 innermost are unrolled on the host.
+void OpTensorNd(const Handle& handle,
+                miopenTensorOp_t tensorOp,
+                const void* alpha0,
+                const TensorDescriptor& aTensorDesc,
+                ConstData_t ATensor,
+                const void* alpha1,
+                const TensorDescriptor& bTensorDesc,
+                ConstData_t BTensor,
+                const void* beta,
+                const TensorDescriptor& cTensorDesc,
+                Data_t CTensor,
+                const size_t Aoffset,
+                const size_t Boffset,
+                const size_t Coffset)
+{
+    const std::size_t max_nd_dims = 8;
+
+    auto dims      = CollapseOpTensorDims(aTensorDesc, bTensorDesc, cTensorDesc);
+    auto read_unit = GetOpTensorNdLiteReadUnit(dims, Aoffset, Boffset, Coffset);
+    auto n_dims    = std::min(dims.lens.size(), max_nd_dims);
+
+    std::size_t kernel_elems = std::accumulate(
+        dims.lens.begin(), dims.lens.begin() + n_dims, std::size_t(1), std::multiplies<>());
+    std::size_t outer_elems = std::accumulate(
+        dims.lens.begin() + n_dims, dims.lens.end(), std::size_t(1), std::multiplies<>());
+
+    if(read_unit == 0)
+    {
+        for(std::size_t i = 0; i < n_dims; i++)
+        {
+            if(dims.lens[i] > std::numeric_limits<unsigned int>::max() ||
+               dims.a_strides[i] > std::numeric_limits<unsigned int>::max() ||
+               dims.b_strides[i] > std::numeric_limits<unsigned int>::max() ||
+               dims.c_strides[i] > std::numeric_limits<unsigned int>::max())
+                MIOPEN_THROW("Tensor length or stride exceeds 32 bits");
+        }
+    }
+
+    int max_num_wg       = 4096;
+    size_t local_threads = 256;
+    size_t total_work    = read_unit == 0 ? kernel_elems : kernel_elems / read_unit;
+    size_t grp_sz        = (total_work + local_threads - 1) / local_threads;
+    grp_sz               = std::max(std::min(size_t(max_num_wg), grp_sz), size_t(1));
+
+    const std::vector<size_t> vld{local_threads, 1, 1};
+    const std::vector<size_t> vgd{grp_sz * local_threads, 1, 1};
+
+    bool b_vec = dims.b_strides[0] == 1;
+
+    std::string kernel_name = read_unit == 0 ? "OpTensorNdGeneric" : "OpTensorNdLite";
+    std::string network_config =
+        std::to_string(bTensorDesc.GetType()) + "-" + std::to_string(aTensorDesc.GetType()) + "-" +
+        std::to_string(tensorOp) + "-" + std::to_string(max_num_wg) + "-" +
+        std::to_string(vgd[0]) + "-" + std::to_string(local_threads) + "-" +
+        (read_unit == 0 ? "nd" + std::to_string(n_dims)
+                        : "lite" + std::to_string(read_unit) + "x" + std::to_string(int(b_vec)));
+
+    visit_float(GetTensorOpScalarType(bTensorDesc.GetType()), [&](auto as_float) {
+
+        auto miopen_alpha0 = as_float(*(static_cast<const float*>(alpha0)));
+        auto miopen_alpha1 = as_float(*(static_cast<const float*>(alpha1)));
+        auto miopen_beta   = as_float(*(static_cast<const float*>(beta)));
+
+        int use_beta = float_equal(*(static_cast<const float*>(beta)), 0) ? 0 : 1;
+
+        auto kernel = [&]() {
+            auto&& kernels = handle.GetKernels(kernel_name, network_config);
+            if(!kernels.empty())
+                return kernels.front();
+
+            const std::string data_type = GetKernelStorageType(bTensorDesc.GetType());
+
+            std::string parms = " -DMIOPEN_TYPE=" + data_type + " -DMAX_NUM_WG=" +
+                                std::to_string(max_num_wg);
+
+            parms += GetDataTypeKernelParams(aTensorDesc.GetType());
+
+            parms += " -DMIOPEN_TENSOR_OP=";
+            switch(tensorOp)
+            {
+            case 0: parms += "miopenAdd"; break;
+            case 1: parms += "miopenMul"; break;
+            case 2: parms += "miopenMin"; break;
+            case 3: parms += "miopenMax"; break;
+            }
+
+            if(read_unit == 0)
+            {
+                parms += " -DUSE_ND_TENSOR_GENERIC -DMIOPEN_ND_DIMS=" + std::to_string(n_dims);
+            }
+            else
+            {
+                const std::string READ_TYPE =
+                    (read_unit == 1) ? data_type : data_type + std::to_string(read_unit);
+                parms += " -DUSE_ND_TENSOR_LITE -DRD_BLCK=" + std::to_string(read_unit) +
+                         " -DREAD_TYPE=" + READ_TYPE + " -DB_COL_STRIDE=" +
+                         std::to_string(int(b_vec));
+            }
+
+            return handle.AddKernel(kernel_name,
+                                    network_config,
+                                    "MIOpenTensorKernels.cl",
+                                    kernel_name,
+                                    vld,
+                                    vgd,
+                                    parms);
+        }();
+
+        if(read_unit != 0)
+        {
+            size_t rows    = dims.lens.size() == 2 ? dims.lens[1] : 1;
+            long a_rstride = dims.lens.size() == 2 ? long(dims.a_strides[1]) : 0;
+            long b_rstride = dims.lens.size() == 2 ? long(dims.b_strides[1]) : 0;
+            long c_rstride = dims.lens.size() == 2 ? long(dims.c_strides[1]) : 0;
+            long cols_vec  = long(dims.lens[0] / read_unit);
+
+            kernel(ATensor,
+                   a_rstride,
+                   BTensor,
+                   b_rstride,
+                   CTensor,
+                   c_rstride,
+                   miopen_alpha0,
+                   miopen_alpha1,
+                   miopen_beta,
+                   long(Aoffset),
+                   long(Boffset),
+                   long(Coffset),
+                   cols_vec,
+                   long(rows * cols_vec),
+                   use_beta);
+            return;
+        }
+
+        std::vector<OpTensorNdDim> nd(max_nd_dims, OpTensorNdDim{1, 0, 0, 0});
+        for(std::size_t i = 0; i < n_dims; i++)
+        {
+            nd[i] = {static_cast<unsigned int>(dims.lens[i]),
+                     static_cast<unsigned int>(dims.a_strides[i]),
+                     static_cast<unsigned int>(dims.b_strides[i]),
+                     static_cast<unsigned int>(dims.c_strides[i])};
+        }
+
+        // one launch per index of the dimensions beyond the kernel's 8
+        for(std::size_t outer = 0; outer < outer_elems; outer++)
+        {
+            std::size_t rem   = outer;
+            std::size_t a_off = Aoffset;
+            std::size_t b_off = Boffset;
+            std::size_t c_off = Coffset;
+            for(std::size_t i = n_dims; i < dims.lens.size(); i++)
+            {
+                std::size_t idx = rem % dims.lens[i];
+                rem /= dims.lens[i];
+                a_off += idx * dims.a_strides[i];
+                b_off += idx * dims.b_strides[i];
+                c_off += idx * dims.c_strides[i];
+            }
+
+            kernel(ATensor,
+                   BTensor,
+                   CTensor,
+                   nd[0],
+                   nd[1],
+                   nd[2],
+                   nd[3],
+                   nd[4],
+                   nd[5],
+                   nd[6],
+                   nd[7],
+                   miopen_alpha0,
+                   miopen_alpha1,
+                   miopen_beta,
+                   long(a_off),
+                   long(b_off),
+                   long(c_off),
+                   long(kernel_elems),
+                   use_beta);
+        }
+    });
+}
+
 void OpTensor(const Handle& handle,
               miopenTensorOp_t tensorOp,
               const void* alpha0,
@@ -1267,11 +1546,6 @@ void OpTensor(const Handle& handle,
 #endif
     auto clens = cTensorDesc.GetLengths();
 
-    if(clens.size() > 5)
-    {
-        MIOPEN_THROW("Tensor dimension larger than 5: " + std::to_string(clens.size()));
-    }
-
     if(blens.size() != clens.size())
     {
         MIOPEN_THROW("Number of dims in B and C Tensors do not match: " +
@@ -1292,6 +1566,37 @@ void OpTensor(const Handle& handle,
         }
     }
 
+    if(!is_squash && clens.size() > 5 && aTensorDesc.GetLengths() != clens)
+    {
+        MIOPEN_THROW("A and C tensor lengths must match above 5 dimensions");
+    }
+
+    // ranks above 5, and the problems that collapse to an elementwise, row or column broadcast,
+    // go through the N-D engine
+    if(!is_squash && aTensorDesc.GetLengths() == clens &&
+       (clens.size() > 5 ||
+        GetOpTensorNdLiteReadUnit(CollapseOpTensorDims(aTensorDesc, bTensorDesc, cTensorDesc),
+                                  Aoffset,
+                                  Boffset,
+                                  Coffset) != 0))
+    {
+        OpTensorNd(handle,
+                   tensorOp,
+                   alpha0,
+                   aTensorDesc,
+                   ATensor,
+                   alpha1,
+                   bTensorDesc,
+                   BTensor,
+                   beta,
+                   cTensorDesc,
+                   CTensor,
+                   Aoffset,
+                   Boffset,
+                   Coffset);
+        return;
+    }
+
     auto bsize = blens.size();
     if(bsize == 3)
     {
@@ -1393,6 +1698,23 @@ static std::vector<std::size_t> get_worker_sizes(const std::vector<std::size_t>&
     return worker_sizes;
 }
 
+// The SubTensorOp kernels take sizes and strides as int unless built with
+// MIOPEN_USE_64BIT_INDEX, for tensors whose element space past the offset exceeds INT_MAX.
+static bool Needs64BitIndex(const TensorDescriptor& desc, int offset)
+{
+    return desc.GetElementSpace() + offset > std::numeric_limits<int>::max();
+}
+
+// Calls f with the cast of sizes and strides to the matching kernel argument type.
+template <class F>
+static void visit_index(bool use_64bit_index, F f)
+{
+    if(use_64bit_index)
+        f([](std::size_t x) { return static_cast<long long>(x); });
+    else
+        f([](std::size_t x) { return static_cast<int>(x); });
+}
+
 void SetTensor(const Handle& handle,
                const TensorDescriptor& yDesc,
                Data_t y,
@@ -1423,11 +1745,15 @@ void SetTensor(const Handle& handle,
 
     const miopenDataType_t dataType = yDesc_flat.GetType();
 
+    const bool use_64bit_index = Needs64BitIndex(yDesc_flat, offset);
+
     std::string network_config = "set " + std::to_string(dataType);
     for(auto& len : yDesc_flat.GetLengths())
     {
         network_config += " " + std::to_string(len);
     }
+    if(use_64bit_index)
+        network_config += " idx64";
 
     auto&& kernels = handle.GetKernels(kernel_name, network_config);
 
@@ -1456,6 +1782,8 @@ void SetTensor(const Handle& handle,
         {
             parms += " -DWORK_LENGTH_" + std::to_string(i) + "=" + std::to_string(worker_sizes[i]);
         }
+        if(use_64bit_index)
+            parms += " -DMIOPEN_USE_64BIT_INDEX=1";
 
         kernel = handle.AddKernel(kernel_name,
                                   network_config,
@@ -1466,90 +1794,92 @@ void SetTensor(const Handle& handle,
                                   parms);
     }
 
-    switch(yDim_flat)
-    {
-    case 1:
-    {
-        visit_float(dataType, [&](auto as_float) {
-            kernel(y,
-                   *as_float(alpha),
-                   offset,
-                   int(yDesc_flat.GetStrides()[0]),
-                   int(yDesc_flat.GetLengths()[0]));
-        });
+    visit_index(use_64bit_index, [&](auto index) {
+        switch(yDim_flat)
+        {
+        case 1:
+        {
+            visit_float(dataType, [&](auto as_float) {
+                kernel(y,
+                       *as_float(alpha),
+                       offset,
+                       index(yDesc_flat.GetStrides()[0]),
+                       index(yDesc_flat.GetLengths()[0]));
+            });
 
-        break;
-    }
-    case 2:
-    {
-        visit_float(dataType, [&](auto as_float) {
-            kernel(y,
-                   *as_float(alpha),
-                   offset,
-                   int(yDesc_flat.GetStrides()[0]),
-                   int(yDesc_flat.GetStrides()[1]),
-                   int(yDesc_flat.GetLengths()[0]),
-                   int(yDesc_flat.GetLengths()[1]));
-        });
+            break;
+        }
+        case 2:
+        {
+            visit_float(dataType, [&](auto as_float) {
+                kernel(y,
+                       *as_float(alpha),
+                       offset,
+                       index(yDesc_flat.GetStrides()[0]),
+                       index(yDesc_flat.GetStrides()[1]),
+                       index(yDesc_flat.GetLengths()[0]),
+                       index(yDesc_flat.GetLengths()[1]));
+            });
 
-        break;
-    }
-    case 3:
-    {
-        visit_float(dataType, [&](auto as_float) {
-            kernel(y,
-                   *as_float(alpha),
-                   offset,
-                   int(yDesc_flat.GetStrides()[0]),
-                   int(yDesc_flat.GetStrides()[1]),
-                   int(yDesc_flat.GetStrides()[2]),
-                   int(yDesc_flat.GetLengths()[0]),
-                   int(yDesc_flat.GetLengths()[1]),
-                   int(yDesc_flat.GetLengths()[2]));
-        });
+            break;
+        }
+        case 3:
+        {
+            visit_float(dataType, [&](auto as_float) {
+                kernel(y,
+                       *as_float(alpha),
+                       offset,
+                       index(yDesc_flat.GetStrides()[0]),
+                       index(yDesc_flat.GetStrides()[1]),
+                       index(yDesc_flat.GetStrides()[2]),
+                       index(yDesc_flat.GetLengths()[0]),
+                       index(yDesc_flat.GetLengths()[1]),
+                       index(yDesc_flat.GetLengths()[2]));
+            });
 
-        break;
-    }
-    case 4:
-    {
-        visit_float(dataType, [&](auto as_float) {
-            kernel(y,
-                   *as_float(alpha),
-                   offset,
-                   int(yDesc_flat.GetStrides()[0]),
-                   int(yDesc_flat.GetStrides()[1]),
-                   int(yDesc_flat.GetStrides()[2]),
-                   int(yDesc_flat.GetStrides()[3]),
-                   int(yDesc_flat.GetLengths()[0]),
-                   int(yDesc_flat.GetLengths()[1]),
-                   int(yDesc_flat.GetLengths()[2]),
-                   int(yDesc_flat.GetLengths()[3]));
-        });
+            break;
+        }
+        case 4:
+        {
+            visit_float(dataType, [&](auto as_float) {
+                kernel(y,
+                       *as_float(alpha),
+                       offset,
+                       index(yDesc_flat.GetStrides()[0]),
+                       index(yDesc_flat.GetStrides()[1]),
+                       index(yDesc_flat.GetStrides()[2]),
+                       index(yDesc_flat.GetStrides()[3]),
+                       index(yDesc_flat.GetLengths()[0]),
+                       index(yDesc_flat.GetLengths()[1]),
+                       index(yDesc_flat.GetLengths()[2]),
+                       index(yDesc_flat.GetLengths()[3]));
+            });
 
-        break;
-    }
-    case 5:
-    {
-        visit_float(dataType, [&](auto as_float) {
-            kernel(y,
-                   *as_float(alpha),
-                   offset,
-                   int(yDesc_flat.GetStrides()[0]),
-                   int(yDesc_flat.GetStrides()[1]),
-                   int(yDesc_flat.GetStrides()[2]),
-                   int(yDesc_flat.GetStrides()[3]),
-                   int(yDesc_flat.GetStrides()[4]),
-                   int(yDesc_flat.GetLengths()[0]),
-                   int(yDesc_flat.GetLengths()[1]),
-                   int(yDesc_flat.GetLengths()[2]),
-                   int(yDesc_flat.GetLengths()[3]),
-                   int(yDesc_flat.GetLengths()[4]));
-        });
+            break;
+        }
+        case 5:
+        {
+            visit_float(dataType, [&](auto as_float) {
+                kernel(y,
+                       *as_float(alpha),
+                       offset,
+                       index(yDesc_flat.GetStrides()[0]),
+                       index(yDesc_flat.GetStrides()[1]),
+                       index(yDesc_flat.GetStrides()[2]),
+                       index(yDesc_flat.GetStrides()[3]),
+                       index(yDesc_flat.GetStrides()[4]),
+                       index(yDesc_flat.GetLengths()[0]),
+                       index(yDesc_flat.GetLengths()[1]),
+                       index(yDesc_flat.GetLengths()[2]),
+                       index(yDesc_flat.GetLengths()[3]),
+                       index(yDesc_flat.GetLengths()[4]));
+            });
 
-        break;
-    }
-    default: assert(false);
-    }
+            break;
+        }
+        default: assert(false);
+        }
+    });
 }
 
 void ScaleTensor(const Handle& handle,
@@ -1589,11 +1919,15 @@ void ScaleTensor(const Handle& handle,
 
     const std::vector<std::size_t>& lens = yDesc_flat.GetLengths();
 
+    const bool use_64bit_index = Needs64BitIndex(yDesc_flat, offset);
+
     std::string network_config = "scale " + std::to_string(yDesc_flat.GetType());
     for(auto& len : lens)
     {
         network_config += " " + std::to_string(len);
     }
+    if(use_64bit_index)
+        network_config += " idx64";
 
     auto&& kernels = handle.GetKernels(kernel_name, network_config);
 
@@ -1622,6 +1956,8 @@ void ScaleTensor(const Handle& handle,
         {
             parms += " -DWORK_LENGTH_" + std::to_string(i) + "=" + std::to_string(worker_sizes[i]);
         }
+        if(use_64bit_index)
+            parms += " -DMIOPEN_USE_64BIT_INDEX=1";
 
         kernel = handle.AddKernel(kernel_name,
                                   network_config,
@@ -1632,90 +1968,245 @@ void ScaleTensor(const Handle& handle,
                                   parms);
     }
 
-    switch(yDim_flat)
-    {
-    case 1:
-    {
-        visit_float(dataType, [&](auto as_float) {
-            kernel(y,
-                   *as_float(alpha),
-                   offset,
-                   int(yDesc_flat.GetStrides()[0]),
-                   int(yDesc_flat.GetLengths()[0]));
-        });
+    visit_index(use_64bit_index, [&](auto index) {
+        switch(yDim_flat)
+        {
+        case 1:
+        {
+            visit_float(dataType, [&](auto as_float) {
+                kernel(y,
+                       *as_float(alpha),
+                       offset,
+                       index(yDesc_flat.GetStrides()[0]),
+                       index(yDesc_flat.GetLengths()[0]));
+            });
 
-        break;
-    }
-    case 2:
-    {
-        visit_float(dataType, [&](auto as_float) {
-            kernel(y,
-                   *as_float(alpha),
-                   offset,
-                   int(yDesc_flat.GetStrides()[0]),
-                   int(yDesc_flat.GetStrides()[1]),
-                   int(yDesc_flat.GetLengths()[0]),
-                   int(yDesc_flat.GetLengths()[1]));
-        });
+            break;
+        }
+        case 2:
+        {
+            visit_float(dataType, [&](auto as_float) {
+                kernel(y,
+                       *as_float(alpha),
+                       offset,
+                       index(yDesc_flat.GetStrides()[0]),
+                       index(yDesc_flat.GetStrides()[1]),
+                       index(yDesc_flat.GetLengths()[0]),
+                       index(yDesc_flat.GetLengths()[1]));
+            });
 
-        break;
-    }
-    case 3:
+            break;
+        }
+        case 3:
+        {
+            visit_float(dataType, [&](auto as_float) {
+                kernel(y,
+                       *as_float(alpha),
+                       offset,
+                       index(yDesc_flat.GetStrides()[0]),
+                       index(yDesc_flat.GetStrides()[1]),
+                       index(yDesc_flat.GetStrides()[2]),
+                       index(yDesc_flat.GetLengths()[0]),
+                       index(yDesc_flat.GetLengths()[1]),
+                       index(yDesc_flat.GetLengths()[2]));
+            });
+
+            break;
+        }
+        case 4:
+        {
+            visit_float(dataType, [&](auto as_float) {
+                kernel(y,
+                       *as_float(alpha),
+                       offset,
+                       index(yDesc_flat.GetStrides()[0]),
+                       index(yDesc_flat.GetStrides()[1]),
+                       index(yDesc_flat.GetStrides()[2]),
+                       index(yDesc_flat.GetStrides()[3]),
+                       index(yDesc_flat.GetLengths()[0]),
+                       index(yDesc_flat.GetLengths()[1]),
+                       index(yDesc_flat.GetLengths()[2]),
+                       index(yDesc_flat.GetLengths()[3]));
+            });
+
+            break;
+        }
+        case 5:
+        {
+            visit_float(dataType, [&](auto as_float) {
+                kernel(y,
+                       *as_float(alpha),
+                       offset,
+                       index(yDesc_flat.GetStrides()[0]),
+                       index(yDesc_flat.GetStrides()[1]),
+                       index(yDesc_flat.GetStrides()[2]),
+                       index(yDesc_flat.GetStrides()[3]),
+                       index(yDesc_flat.GetStrides()[4]),
+                       index(yDesc_flat.GetLengths()[0]),
+                       index(yDesc_flat.GetLengths()[1]),
+                       index(yDesc_flat.GetLengths()[2]),
+                       index(yDesc_flat.GetLengths()[3]),
+                       index(yDesc_flat.GetLengths()[4]));
+            });
+
+            break;
+        }
+        default: assert(false);
+        }
+    });
+}
+
+// Flattened layout change in which dimension a is contiguous in x and another dimension b in y,
+// e.g. NCHW <-> NHWC / CHWN / NCHWc. It runs as a batched 2-D transpose through LDS over the
+// other dimensions.
+struct TransposeTileProblem
+{
+    std::size_t a;
+    std::size_t b;
+    std::size_t tile_a;
+    std::size_t tile_b;
+};
+
+static std::size_t NextPow2(std::size_t v)
+{
+    std::size_t p = 1;
+    while(p < v)
+        p <<= 1;
+    return p;
+}
+
+static bool GetTransposeTileProblem(const TensorDescriptor& xDesc_flat,
+                                    const TensorDescriptor& yDesc_flat,
+                                    TransposeTileProblem& prob)
+{
+    const auto& lens     = xDesc_flat.GetLengths();
+    const auto& xstrides = xDesc_flat.GetStrides();
+    const auto& ystrides = yDesc_flat.GetStrides();
+    const auto type      = xDesc_flat.GetType();
+
+    // types of _FLOAT in MIOpenSubTensorOpWithTransformKernel.cl
+    if(type != miopenFloat && type != miopenHalf && type != miopenInt8)
+        return false;
+    if(lens.size() < 2 || lens.size() > 5)
+        return false;
+    if(xDesc_flat.GetElementSpace() > std::numeric_limits<uint>::max() ||
+       yDesc_flat.GetElementSpace() > std::numeric_limits<uint>::max())
+        return false;
+
+    auto a = std::find(xstrides.begin(), xstrides.end(), 1);
+    auto b = std::find(ystrides.begin(), ystrides.end(), 1);
+    if(a == xstrides.end() || b == ystrides.end())
+        return false;
+    prob.a = a - xstrides.begin();
+    prob.b = b - ystrides.begin();
+    if(prob.a == prob.b)
+        return false;
+
+    // 32 x 32 tiles, a short side such as the vector of NCHWc lengthens the other one
+    const std::size_t len_a = lens[prob.a];
+    const std::size_t len_b = lens[prob.b];
+    prob.tile_a             = std::min<std::size_t>(32, NextPow2(len_a));
+    prob.tile_b             = std::min<std::size_t>(32, NextPow2(len_b));
+    if(prob.tile_b < 32)
+        prob.tile_a = std::min(1024 / prob.tile_b, NextPow2(len_a));
+    if(prob.tile_a < 32)
+        prob.tile_b = std::min(1024 / prob.tile_a, NextPow2(len_b));
+
+    // too small to pay for the staging
+    return prob.tile_a * prob.tile_b >= 64;
+}
+
+static void TransposeTensorTile(const Handle& handle,
+                                const TransposeTileProblem& prob,
+                                const TensorDescriptor& xDesc_flat,
+                                ConstData_t x,
+                                const TensorDescriptor& yDesc_flat,
+                                Data_t y,
+                                float alpha,
+                                float beta,
+                                size_t Xoffset,
+                                size_t Yoffset)
+{
+    const auto& lens     = xDesc_flat.GetLengths();
+    const auto& xstrides = xDesc_flat.GetStrides();
+    const auto& ystrides = yDesc_flat.GetStrides();
+
+    // the batch dimensions, padded to 3 from the outside
+    std::vector<uint> batch_lens(3, 1);
+    std::vector<uint> x_batch_strides(3, 0);
+    std::vector<uint> y_batch_strides(3, 0);
+    std::size_t n_batch = 0;
+    for(std::size_t i = 0; i < lens.size(); i++)
     {
-        visit_float(dataType, [&](auto as_float) {
-            kernel(y,
-                   *as_float(alpha),
-                   offset,
-                   int(yDesc_flat.GetStrides()[0]),
-                   int(yDesc_flat.GetStrides()[1]),
-                   int(yDesc_flat.GetStrides()[2]),
-                   int(yDesc_flat.GetLengths()[0]),
-                   int(yDesc_flat.GetLengths()[1]),
-                   int(yDesc_flat.GetLengths()[2]));
-        });
+        if(i == prob.a || i == prob.b)
+            continue;
+        auto k             = 3 - (lens.size() - 2) + n_batch++;
+        batch_lens[k]      = lens[i];
+        x_batch_strides[k] = xstrides[i];
+        y_batch_strides[k] = ystrides[i];
+    }
 
-        break;
-    }
-    case 4:
-    {
-        visit_float(dataType, [&](auto as_float) {
-            kernel(y,
-                   *as_float(alpha),
-                   offset,
-                   int(yDesc_flat.GetStrides()[0]),
-                   int(yDesc_flat.GetStrides()[1]),
-                   int(yDesc_flat.GetStrides()[2]),
-                   int(yDesc_flat.GetStrides()[3]),
-                   int(yDesc_flat.GetLengths()[0]),
-                   int(yDesc_flat.GetLengths()[1]),
-                   int(yDesc_flat.GetLengths()[2]),
-                   int(yDesc_flat.GetLengths()[3]));
-        });
+    const std::size_t tiles_a = (lens[prob.a] + prob.tile_a - 1) / prob.tile_a;
+    const std::size_t tiles_b = (lens[prob.b] + prob.tile_b - 1) / prob.tile_b;
+    const std::size_t n_groups =
+        tiles_a * tiles_b * std::accumulate(batch_lens.begin(),
+                                            batch_lens.end(),
+                                            std::size_t{1},
+                                            std::multiplies<std::size_t>());
 
-        break;
-    }
-    case 5:
-    {
-        visit_float(dataType, [&](auto as_float) {
-            kernel(y,
-                   *as_float(alpha),
-                   offset,
-                   int(yDesc_flat.GetStrides()[0]),
-                   int(yDesc_flat.GetStrides()[1]),
-                   int(yDesc_flat.GetStrides()[2]),
-                   int(yDesc_flat.GetStrides()[3]),
-                   int(yDesc_flat.GetStrides()[4]),
-                   int(yDesc_flat.GetLengths()[0]),
-                   int(yDesc_flat.GetLengths()[1]),
-                   int(yDesc_flat.GetLengths()[2]),
-                   int(yDesc_flat.GetLengths()[3]),
-                   int(yDesc_flat.GetLengths()[4]));
-        });
+    const bool scale = !(float_equal(alpha, 1) && float_equal(beta, 0));
+
+    std::string kernel_name    = "SubTensorOpWithTransposeTile";
+    std::string network_config = "transpose " + std::to_string(xDesc_flat.GetType()) + "x" +
+                                 std::to_string(prob.tile_a) + "x" + std::to_string(prob.tile_b) +
+                                 "x" + std::to_string(int(scale)) + "x" + std::to_string(n_groups);
+
+    auto&& kernels = handle.GetKernels(kernel_name, network_config);
 
-        break;
+    KernelInvoke kernel;
+
+    if(!kernels.empty())
+    {
+        kernel = kernels.front();
     }
-    default: assert(false);
+    else
+    {
+        std::string program_name = "MIOpenSubTensorOpWithTransformKernel.cl";
+
+        std::string parms = GetDataTypeKernelParams(xDesc_flat.GetType()) + " -DTRANSPOSE_TILE_A=" +
+                            std::to_string(prob.tile_a) + " -DTRANSPOSE_TILE_B=" +
+                            std::to_string(prob.tile_b) + " -DTRANSPOSE_SCALE=" +
+                            std::to_string(int(scale));
+
+        kernel = handle.AddKernel(kernel_name,
+                                  network_config,
+                                  program_name,
+                                  kernel_name,
+                                  {256, 1, 1},
+                                  {256 * n_groups, 1, 1},
+                                  parms);
     }
+
+    kernel(x,
+           alpha,
+           y,
+           beta,
+           uint(Xoffset),
+           uint(Yoffset),
+           uint(lens[prob.a]),
+           uint(lens[prob.b]),
+           uint(xstrides[prob.b]),
+           uint(ystrides[prob.a]),
+           uint(tiles_a),
+           uint(tiles_b),
+           batch_lens[1],
+           batch_lens[2],
+           x_batch_strides[0],
+           x_batch_strides[1],
+           x_batch_strides[2],
+           y_batch_strides[0],
+           y_batch_strides[1],
+           y_batch_strides[2]);
 }
 
 void CopyTensor(const Handle& handle,
@@ -1763,17 +2254,32 @@ void CopyTensor(const Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm, "Tensor dimension sizes unsupported.");
     }
 
-    if(srcOffset > 0 || dstOffset > 0 || (!(srcDesc_flat.IsPacked() && dstDesc_flat.IsPacked())))
+    TransposeTileProblem transpose;
+    if(GetTransposeTileProblem(srcDesc_flat, dstDesc_flat, transpose))
+    {
+        TransposeTensorTile(
+            handle, transpose, srcDesc_flat, src, dstDesc_flat, dst, 1, 0, srcOffset, dstOffset);
+        return;
+    }
+
+    // both packed is not enough for a plain copy, the layouts may still be permutations
+    if(srcOffset > 0 || dstOffset > 0 || (!(srcDesc_flat.IsPacked() && dstDesc_flat.IsPacked())) ||
+       srcDesc_flat.GetStrides() != dstDesc_flat.GetStrides())
     {
         std::string kernel_name = "SubTensorOpWithSubTensor" + std::to_string(srcDim_flat) + "d";
 
         const std::vector<std::size_t>& lens = srcDesc_flat.GetLengths();
 
+        const bool use_64bit_index =
+            Needs64BitIndex(srcDesc_flat, srcOffset) || Needs64BitIndex(dstDesc_flat, dstOffset);
+
         std::string network_config = "copy " + std::to_string(srcDesc_flat.GetType());
         for(auto& len : lens)
         {
             network_config += " " + std::to_string(len);
         }
+        if(use_64bit_index)
+            network_config += " idx64";
 
         auto&& kernels = handle.GetKernels(kernel_name, network_config);
 
@@ -1803,6 +2309,8 @@ void CopyTensor(const Handle& handle,
                 parms +=
                     " -DWORK_LENGTH_" + std::to_string(i) + "=" + std::to_string(worker_sizes[i]);
             }
+            if(use_64bit_index)
+                parms += " -DMIOPEN_USE_64BIT_INDEX=1";
 
             kernel = handle.AddKernel(kernel_name,
                                       network_config,
@@ -1813,100 +2321,102 @@ void CopyTensor(const Handle& handle,
                                       parms);
         }
 
-        switch(srcDim_flat)
-        {
-        case 1:
-        {
-            kernel(src,
-                   srcOffset,
-                   int(srcDesc_flat.GetStrides()[0]),
-                   int(srcDesc_flat.GetLengths()[0]),
-                   dst,
-                   dstOffset,
-                   int(dstDesc_flat.GetStrides()[0]));
-
-            break;
-        }
-        case 2:
-        {
-            kernel(src,
-                   srcOffset,
-                   int(srcDesc_flat.GetStrides()[0]),
-                   int(srcDesc_flat.GetStrides()[1]),
-                   int(srcDesc_flat.GetLengths()[0]),
-                   int(srcDesc_flat.GetLengths()[1]),
-                   dst,
-                   dstOffset,
-                   int(dstDesc_flat.GetStrides()[0]),
-                   int(dstDesc_flat.GetStrides()[1]));
-
-            break;
-        }
-        case 3:
-        {
-            kernel(src,
-                   srcOffset,
-                   int(srcDesc_flat.GetStrides()[0]),
-                   int(srcDesc_flat.GetStrides()[1]),
-                   int(srcDesc_flat.GetStrides()[2]),
-                   int(srcDesc_flat.GetLengths()[0]),
-                   int(srcDesc_flat.GetLengths()[1]),
-                   int(srcDesc_flat.GetLengths()[2]),
-                   dst,
-                   dstOffset,
-                   int(dstDesc_flat.GetStrides()[0]),
-                   int(dstDesc_flat.GetStrides()[1]),
-                   int(dstDesc_flat.GetStrides()[2]));
-
-            break;
-        }
-        case 4:
-        {
-            kernel(src,
-                   srcOffset,
-                   int(srcDesc_flat.GetStrides()[0]),
-                   int(srcDesc_flat.GetStrides()[1]),
-                   int(srcDesc_flat.GetStrides()[2]),
-                   int(srcDesc_flat.GetStrides()[3]),
-                   int(srcDesc_flat.GetLengths()[0]),
-                   int(srcDesc_flat.GetLengths()[1]),
-                   int(srcDesc_flat.GetLengths()[2]),
-                   int(srcDesc_flat.GetLengths()[3]),
-                   dst,
-                   dstOffset,
-                   int(dstDesc_flat.GetStrides()[0]),
-                   int(dstDesc_flat.GetStrides()[1]),
-                   int(dstDesc_flat.GetStrides()[2]),
-                   int(dstDesc_flat.GetStrides()[3]));
-
-            break;
-        }
-        case 5:
-        {
-            kernel(src,
-                   srcOffset,
-                   int(srcDesc_flat.GetStrides()[0]),
-                   int(srcDesc_flat.GetStrides()[1]),
-                   int(srcDesc_flat.GetStrides()[2]),
-                   int(srcDesc_flat.GetStrides()[3]),
-                   int(srcDesc_flat.GetStrides()[4]),
-                   int(srcDesc_flat.GetLengths()[0]),
-                   int(srcDesc_flat.GetLengths()[1]),
-                   int(srcDesc_flat.GetLengths()[2]),
-                   int(srcDesc_flat.GetLengths()[3]),
-                   int(srcDesc_flat.GetLengths()[4]),
-                   dst,
-                   dstOffset,
-                   int(dstDesc_flat.GetStrides()[0]),
-                   int(dstDesc_flat.GetStrides()[1]),
-                   int(dstDesc_flat.GetStrides()[2]),
-                   int(dstDesc_flat.GetStrides()[3]),
-                   int(dstDesc_flat.GetStrides()[4]));
-
-            break;
-        }
-        default: assert(false);
-        }
+        visit_index(use_64bit_index, [&](auto index) {
+            switch(srcDim_flat)
+            {
+            case 1:
+            {
+                kernel(src,
+                       srcOffset,
+                       index(srcDesc_flat.GetStrides()[0]),
+                       index(srcDesc_flat.GetLengths()[0]),
+                       dst,
+                       dstOffset,
+                       index(dstDesc_flat.GetStrides()[0]));
+
+                break;
+            }
+            case 2:
+            {
+                kernel(src,
+                       srcOffset,
+                       index(srcDesc_flat.GetStrides()[0]),
+                       index(srcDesc_flat.GetStrides()[1]),
+                       index(srcDesc_flat.GetLengths()[0]),
+                       index(srcDesc_flat.GetLengths()[1]),
+                       dst,
+                       dstOffset,
+                       index(dstDesc_flat.GetStrides()[0]),
+                       index(dstDesc_flat.GetStrides()[1]));
+
+                break;
+            }
+            case 3:
+            {
+                kernel(src,
+                       srcOffset,
+                       index(srcDesc_flat.GetStrides()[0]),
+                       index(srcDesc_flat.GetStrides()[1]),
+                       index(srcDesc_flat.GetStrides()[2]),
+                       index(srcDesc_flat.GetLengths()[0]),
+                       index(srcDesc_flat.GetLengths()[1]),
+                       index(srcDesc_flat.GetLengths()[2]),
+                       dst,
+                       dstOffset,
+                       index(dstDesc_flat.GetStrides()[0]),
+                       index(dstDesc_flat.GetStrides()[1]),
+                       index(dstDesc_flat.GetStrides()[2]));
+
+                break;
+            }
+            case 4:
+            {
+                kernel(src,
+                       srcOffset,
+                       index(srcDesc_flat.GetStrides()[0]),
+                       index(srcDesc_flat.GetStrides()[1]),
+                       index(srcDesc_flat.GetStrides()[2]),
+                       index(srcDesc_flat.GetStrides()[3]),
+                       index(srcDesc_flat.GetLengths()[0]),
+                       index(srcDesc_flat.GetLengths()[1]),
+                       index(srcDesc_flat.GetLengths()[2]),
+                       index(srcDesc_flat.GetLengths()[3]),
+                       dst,
+                       dstOffset,
+                       index(dstDesc_flat.GetStrides()[0]),
+                       index(dstDesc_flat.GetStrides()[1]),
+                       index(dstDesc_flat.GetStrides()[2]),
+                       index(dstDesc_flat.GetStrides()[3]));
+
+                break;
+            }
+            case 5:
+            {
+                kernel(src,
+                       srcOffset,
+                       index(srcDesc_flat.GetStrides()[0]),
+                       index(srcDesc_flat.GetStrides()[1]),
+                       index(srcDesc_flat.GetStrides()[2]),
+                       index(srcDesc_flat.GetStrides()[3]),
+                       index(srcDesc_flat.GetStrides()[4]),
+                       index(srcDesc_flat.GetLengths()[0]),
+                       index(srcDesc_flat.GetLengths()[1]),
+                       index(srcDesc_flat.GetLengths()[2]),
+                       index(srcDesc_flat.GetLengths()[3]),
+                       index(srcDesc_flat.GetLengths()[4]),
+                       dst,
+                       dstOffset,
+                       index(dstDesc_flat.GetStrides()[0]),
+                       index(dstDesc_flat.GetStrides()[1]),
+                       index(dstDesc_flat.GetStrides()[2]),
+                       index(dstDesc_flat.GetStrides()[3]),
+                       index(dstDesc_flat.GetStrides()[4]));
+
+                break;
+            }
+            default: assert(false);
+            }
+        });
     }
     else
     {
@@ -2141,6 +2651,139 @@ void CastTensor(const Handle& handle,
     }
 }
 
+void CastTensor(const Handle& handle,
+                const void* alpha,
+                const CastTensorQuantization& quant,
+                const TensorDescriptor& srcDesc,
+                ConstData_t src,
+                const TensorDescriptor& dstDesc,
+                Data_t dst,
+                int srcOffset,
+                int dstOffset)
+{
+    if(src == nullptr || dst == nullptr)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Null pointer for tensor.");
+    }
+
+    if(srcDesc.GetLengths() != dstDesc.GetLengths())
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Tensor dimension lengths do not match.");
+    }
+
+    if(srcDesc.GetType() == miopenInt8x4 || dstDesc.GetType() == miopenInt8x4)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Tensor cast operation is not supported for int8x4.");
+    }
+
+    const auto& lens         = srcDesc.GetLengths();
+    const bool use_ch_scales = quant.channelScales != nullptr;
+    if(use_ch_scales && (quant.channelDim < 0 || quant.channelDim >= int(lens.size())))
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Channel dimension of the scales out of range.");
+    }
+
+    std::size_t ch_len   = 1;
+    std::size_t ch_inner = 1;
+    if(use_ch_scales)
+    {
+        ch_len   = lens[quant.channelDim];
+        ch_inner = std::accumulate(lens.begin() + quant.channelDim + 1,
+                                   lens.end(),
+                                   std::size_t{1},
+                                   std::multiplies<std::size_t>());
+    }
+
+    auto flat_descriptors = GetConsistentFlattenedTensorDescriptors(srcDesc, dstDesc);
+    const TensorDescriptor& srcDesc_flat = std::get<0>(flat_descriptors);
+    const TensorDescriptor& dstDesc_flat = std::get<1>(flat_descriptors);
+
+    std::size_t srcDim_flat = srcDesc_flat.GetSize();
+
+    if(srcDim_flat < 1 || srcDim_flat > 5)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Tensor dimension sizes unsupported.");
+    }
+
+    // flattened dimensions padded to 5 from the outside
+    std::vector<int> flat_lens(5, 1);
+    std::vector<int> src_strides(5, 0);
+    std::vector<int> dst_strides(5, 0);
+    for(std::size_t i = 0; i < srcDim_flat; i++)
+    {
+        flat_lens[5 - srcDim_flat + i]   = srcDesc_flat.GetLengths()[i];
+        src_strides[5 - srcDim_flat + i] = srcDesc_flat.GetStrides()[i];
+        dst_strides[5 - srcDim_flat + i] = dstDesc_flat.GetStrides()[i];
+    }
+
+    const std::size_t local_threads = 256;
+    const std::size_t total_work    = srcDesc_flat.GetElementSize();
+    const std::size_t grp_sz =
+        std::max(std::min(std::size_t{4096}, (total_work + local_threads - 1) / local_threads),
+                 std::size_t{1});
+
+    const std::vector<std::size_t> vld{local_threads, 1, 1};
+    const std::vector<std::size_t> vgd{grp_sz * local_threads, 1, 1};
+
+    std::string kernel_name    = "SubTensorOpWithCastTensorQuant";
+    std::string network_config = "castq " + std::to_string(srcDesc_flat.GetType()) + " " +
+                                 std::to_string(dstDesc_flat.GetType()) + " " +
+                                 std::to_string(int(quant.saturate)) + " " +
+                                 std::to_string(int(use_ch_scales)) + " " + std::to_string(vgd[0]);
+
+    auto&& kernels = handle.GetKernels(kernel_name, network_config);
+    KernelInvoke kernel;
+
+    if(!kernels.empty())
+    {
+        kernel = kernels.front();
+    }
+    else
+    {
+        std::string program_name = "MIOpenSubTensorOpWithCastTensorKernel.cl";
+
+        std::string parms =
+            GetCastTensorBuildOptionFromType(" -DMIOPEN_SRC_TYPE=", srcDesc_flat.GetType()) +
+            GetCastTensorBuildOptionFromType(" -DMIOPEN_DST_TYPE=", dstDesc_flat.GetType()) +
+            " -DMIOPEN_CAST_SATURATE=" + std::to_string(int(quant.saturate)) +
+            " -DMIOPEN_CAST_CHANNEL_SCALES=" + std::to_string(int(use_ch_scales));
+
+        if(dstDesc_flat.GetType() == miopenBFloat16)
+        {
+            parms += " -DMIOPEN_USE_RNE_BFLOAT16=1";
+        }
+
+        kernel = handle.AddKernel(
+            kernel_name, network_config, program_name, kernel_name, vld, vgd, parms);
+    }
+
+    kernel(src,
+           *(static_cast<const float*>(alpha)),
+           quant.srcZeroPoint,
+           quant.dstZeroPoint,
+           use_ch_scales ? quant.channelScales : src,
+           uint(ch_inner),
+           uint(ch_len),
+           srcOffset,
+           src_strides[0],
+           src_strides[1],
+           src_strides[2],
+           src_strides[3],
+           src_strides[4],
+           flat_lens[0],
+           flat_lens[1],
+           flat_lens[2],
+           flat_lens[3],
+           flat_lens[4],
+           dst,
+           dstOffset,
+           dst_strides[0],
+           dst_strides[1],
+           dst_strides[2],
+           dst_strides[3],
+           dst_strides[4]);
+}
+
 void TransformTensor(const Handle& handle,
                      const void* alpha,
                      const TensorDescriptor& xDesc,
@@ -2297,6 +2940,22 @@ void TransformTensor(const Handle& handle,
             MIOPEN_THROW("Tensor x and y have different data types");
         }
 
+        TransposeTileProblem transpose;
+        if(GetTransposeTileProblem(xDesc_flat, yDesc_flat, transpose))
+        {
+            TransposeTensorTile(handle,
+                                transpose,
+                                xDesc_flat,
+                                x,
+                                yDesc_flat,
+                                y,
+                                *(static_cast<const float*>(alpha)),
+                                *(static_cast<const float*>(beta)),
+                                Xoffset,
+                                Yoffset);
+            return;
+        }
+
         std::string kernel_name = "SubTensorOpWithTransform" + std::to_string(yDim_flat) + "d";
 
         const std::vector<std::size_t>& lens = yDesc_flat.GetLengths();
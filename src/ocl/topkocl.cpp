@@ -0,0 +1,165 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/topk.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/datatype.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/kernel_cache.hpp>
+#include <miopen/tensor.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <string>
+
+namespace miopen {
+
+namespace {
+
+// Work-group size of MIOpenTopK.cl, one work-group per row.
+constexpr std::size_t topk_local = 256;
+
+struct TopKShape
+{
+    std::size_t outer; // elements of the dimensions before dim
+    std::size_t len;   // elements along dim
+    std::size_t inner; // elements of the dimensions after dim
+};
+
+TopKShape GetTopKShape(const TensorDescriptor& xDesc, int dim)
+{
+    const auto& lengths = xDesc.GetLengths();
+    if(dim < 0 || dim >= static_cast<int>(lengths.size()))
+        MIOPEN_THROW(miopenStatusBadParm, "Top-k dimension out of range");
+
+    const auto split = lengths.begin() + dim;
+    const TopKShape shape{
+        std::accumulate(lengths.begin(), split, std::size_t{1}, std::multiplies<std::size_t>{}),
+        *split,
+        std::accumulate(split + 1, lengths.end(), std::size_t{1}, std::multiplies<std::size_t>{})};
+
+    if(xDesc.GetElementSize() > std::numeric_limits<int>::max())
+        MIOPEN_THROW(miopenStatusBadParm, "Top-k tensor is too large");
+    return shape;
+}
+
+void CheckTopKOutput(const TensorDescriptor& xDesc,
+                     int dim,
+                     int k,
+                     const TensorDescriptor& desc,
+                     miopenDataType_t type)
+{
+    auto lengths = xDesc.GetLengths();
+    lengths[dim] = k;
+    if(desc.GetType() != type || desc.GetLengths() != lengths || !desc.IsPacked())
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "Top-k outputs are packed tensors with k elements along dim");
+}
+
+/// The smallest power of 2 not less than k.
+std::size_t GetTopKRank(int k)
+{
+    std::size_t rank = 1;
+    while(rank < static_cast<std::size_t>(k))
+        rank *= 2;
+    return rank;
+}
+
+KernelInvoke GetTopKKernel(const Handle& handle,
+                           const std::string& network_config,
+                           std::size_t rows,
+                           const std::string& params)
+{
+    const std::string algo_name = "miopenTopK";
+    auto&& kernels              = handle.GetKernels(algo_name, network_config);
+    if(!kernels.empty())
+        return kernels.front();
+    return handle.AddKernel(algo_name,
+                            network_config,
+                            "MIOpenTopK.cl",
+                            "MIOpenTopK",
+                            {topk_local, 1, 1},
+                            {rows * topk_local, 1, 1},
+                            params);
+}
+
+} // namespace
+
+void TopK(const Handle& handle,
+          const TensorDescriptor& xDesc,
+          ConstData_t x,
+          int dim,
+          int k,
+          bool largest,
+          const TensorDescriptor& valuesDesc,
+          Data_t values,
+          const TensorDescriptor& indicesDesc,
+          Data_t indices)
+{
+    if(x == nullptr || values == nullptr || indices == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm);
+
+    const auto type = xDesc.GetType();
+    if(type != miopenFloat && type != miopenHalf && type != miopenBFloat16)
+        MIOPEN_THROW(miopenStatusBadParm, "Top-k supports fp32, fp16 and bfp16 only");
+    if(!xDesc.IsPacked())
+        MIOPEN_THROW(miopenStatusBadParm, "Top-k takes a packed tensor");
+
+    const auto shape = GetTopKShape(xDesc, dim);
+    if(k <= 0 || k > topk_max_k || static_cast<std::size_t>(k) > shape.len)
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "k has to be between 1 and the smaller of " + std::to_string(topk_max_k) +
+                         " and the length of dim");
+    CheckTopKOutput(xDesc, dim, k, valuesDesc, type);
+    CheckTopKOutput(xDesc, dim, k, indicesDesc, miopenInt32);
+
+    const auto rows = shape.outer * shape.inner;
+    if(rows == 0)
+        return;
+
+    // Chunks of at least two elements per work-item keep the whole work-group busy for small k.
+    const auto rank  = GetTopKRank(k);
+    const auto chunk = std::max(rank, 2 * topk_local);
+
+    const auto network_config = "topk-" + std::to_string(type) + "-p" + std::to_string(rank) +
+                                "-l" + std::to_string(int(largest)) + "-r" +
+                                std::to_string(rows);
+    const auto params = GetDataTypeKernelParams(type) + " -DTOPK_LOCAL=" +
+                        std::to_string(topk_local) + " -DTOPK_P=" + std::to_string(rank) +
+                        " -DTOPK_CHUNK=" + std::to_string(chunk) + " -DTOPK_LARGEST=" +
+                        std::to_string(int(largest));
+
+    auto kernel = GetTopKKernel(handle, network_config, rows, params);
+    kernel(x,
+           values,
+           indices,
+           static_cast<unsigned>(shape.len),
+           static_cast<unsigned>(k),
+           static_cast<unsigned>(shape.inner));
+}
+
+} // namespace miopen
@@ -29,6 +29,9 @@
 #include <miopen/logger.hpp>
 #include <miopen/float_equal.hpp>
 #include <miopen/datatype.hpp>
+#include <miopen/env.hpp>
+#include <miopen/numeric.hpp>
+#include <miopen/tensor.hpp>
 
 #include <boost/range/adaptors.hpp>
 
@@ -38,6 +41,9 @@
 
 namespace miopen {
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_COL2IM_GATHER)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_IM3D2COL_TILED)
+
 float Im2d2ColGPU(const Handle& handle,
                   ConstData_t im,
                   const int im_offset,
@@ -55,7 +61,8 @@ float Im2d2ColGPU(const Handle& handle,
                   const int dilation_h,
                   const int dilation_w,
                   Data_t col,
-                  miopenDataType_t type)
+                  miopenDataType_t type,
+                  const int col_offset)
 {
     std::string program_name = "MIOpenIm2d2Col.cl";
     std::string kernel_name  = "Im2d2Col";
@@ -82,6 +89,7 @@ float Im2d2ColGPU(const Handle& handle,
 
     int data_size_bound_pack = type == miopenInt8x4 ? data_size_bound * 4 : data_size_bound;
     int im_offset_pack       = type == miopenInt8x4 ? im_offset / 4 : im_offset;
+    int col_offset_pack      = type == miopenInt8x4 ? col_offset / 4 : col_offset;
 
     if(!kernels.empty())
     {
@@ -101,7 +109,8 @@ float Im2d2ColGPU(const Handle& handle,
                stride_w,
                dilation_h,
                dilation_w,
-               col);
+               col,
+               col_offset_pack);
     }
     else
     {
@@ -213,12 +222,129 @@ float Im2d2ColGPU(const Handle& handle,
             stride_w,
             dilation_h,
             dilation_w,
-            col);
+            col,
+            col_offset_pack);
     }
 
     return handle.GetKernelTime();
 }
 
+/// Im3d2ColTiled stages the input of an output block in LDS, one depth slice at a time.
+/// Returns false when it is disabled or even the smallest block does not fit.
+static bool Im3d2ColTiledGPU(const Handle& handle,
+                             float& time,
+                             ConstData_t im,
+                             const int im_offset,
+                             const int im_c,
+                             const int im_d,
+                             const int im_h,
+                             const int im_w,
+                             const int wei_d,
+                             const int wei_h,
+                             const int wei_w,
+                             const int out_d,
+                             const int out_h,
+                             const int out_w,
+                             const int pad_d,
+                             const int pad_h,
+                             const int pad_w,
+                             const int stride_d,
+                             const int stride_h,
+                             const int stride_w,
+                             const int dilation_d,
+                             const int dilation_h,
+                             const int dilation_w,
+                             Data_t col,
+                             miopenDataType_t type,
+                             const int col_offset,
+                             const std::string& network_config)
+{
+    if(miopen::IsDisabled(MIOPEN_DEBUG_IM3D2COL_TILED{}))
+        return false;
+
+    const int vec        = 4;
+    const int local_size = 256;
+    // int8x4 is moved as 32-bit words.
+    const auto elem_size = type == miopenInt8x4 ? 4 : static_cast<int>(GetTypeSize(type));
+    // Half of the LDS, so that two work-groups fit a CU.
+    const auto max_brick_size = MAX_LOCAL_MEM / 2;
+
+    int tile_ow            = std::min(64, (out_w + vec - 1) / vec * vec);
+    int tile_oh            = std::max(1, std::min(out_h, local_size / tile_ow));
+    const auto brick_bytes = [&]() {
+        return ((tile_oh - 1) * stride_h + (wei_h - 1) * dilation_h + 1) *
+               ((tile_ow - 1) * stride_w + (wei_w - 1) * dilation_w + 1) * elem_size;
+    };
+    while(brick_bytes() > max_brick_size && (tile_oh > 1 || tile_ow > vec))
+    {
+        if(tile_oh > 1)
+            tile_oh /= 2;
+        else
+            tile_ow = std::max(vec, tile_ow / 2 / vec * vec);
+    }
+    if(brick_bytes() > max_brick_size)
+        return false;
+
+    // The slices of consecutive output depths are the same ones shifted by one.
+    const bool depth_slide = stride_d == 1 && pad_d == 0 && dilation_d == 1;
+    const int tile_d       = depth_slide ? std::min(out_d, 4) : 1;
+
+    const auto key = network_config + "tile" + std::to_string(tile_d) + "_" +
+                     std::to_string(tile_oh) + "_" + std::to_string(tile_ow);
+    auto&& kernels = handle.GetKernels("miopenIm3d2ColTiled", key);
+
+    // int8x4 vectorize-c format
+    const unsigned im_offset_pack  = type == miopenInt8x4 ? im_offset / 4 : im_offset;
+    const unsigned col_offset_pack = type == miopenInt8x4 ? col_offset / 4 : col_offset;
+    const int im_c_pack            = type == miopenInt8x4 ? im_c / 4 : im_c;
+
+    if(!kernels.empty())
+    {
+        kernels.front()(im, im_offset_pack, col, col_offset_pack);
+    }
+    else
+    {
+        std::string params = GetDataTypeKernelParams(type);
+        params += " -DI3C_IM_D=" + std::to_string(im_d);
+        params += " -DI3C_IM_H=" + std::to_string(im_h);
+        params += " -DI3C_IM_W=" + std::to_string(im_w);
+        params += " -DI3C_WEI_D=" + std::to_string(wei_d);
+        params += " -DI3C_WEI_H=" + std::to_string(wei_h);
+        params += " -DI3C_WEI_W=" + std::to_string(wei_w);
+        params += " -DI3C_OUT_D=" + std::to_string(out_d);
+        params += " -DI3C_OUT_H=" + std::to_string(out_h);
+        params += " -DI3C_OUT_W=" + std::to_string(out_w);
+        params += " -DI3C_PAD_D=" + std::to_string(pad_d);
+        params += " -DI3C_PAD_H=" + std::to_string(pad_h);
+        params += " -DI3C_PAD_W=" + std::to_string(pad_w);
+        params += " -DI3C_STRIDE_D=" + std::to_string(stride_d);
+        params += " -DI3C_STRIDE_H=" + std::to_string(stride_h);
+        params += " -DI3C_STRIDE_W=" + std::to_string(stride_w);
+        params += " -DI3C_DILATION_D=" + std::to_string(dilation_d);
+        params += " -DI3C_DILATION_H=" + std::to_string(dilation_h);
+        params += " -DI3C_DILATION_W=" + std::to_string(dilation_w);
+        params += " -DI3C_TILE_D=" + std::to_string(tile_d);
+        params += " -DI3C_TILE_OH=" + std::to_string(tile_oh);
+        params += " -DI3C_TILE_OW=" + std::to_string(tile_ow);
+        params += " -DI3C_DEPTH_SLIDE=" + std::to_string(static_cast<int>(depth_slide));
+
+        const auto groups = static_cast<size_t>(im_c_pack) * ((out_d + tile_d - 1) / tile_d) *
+                            ((out_h + tile_oh - 1) / tile_oh) * ((out_w + tile_ow - 1) / tile_ow);
+        const std::vector<size_t> vld{static_cast<size_t>(local_size), 1, 1};
+        const std::vector<size_t> vgd{groups * local_size, 1, 1};
+
+        handle.AddKernel("miopenIm3d2ColTiled",
+                         key,
+                         "MIOpenIm3d2ColTiled.cl",
+                         "Im3d2ColTiled",
+                         vld,
+                         vgd,
+                         params)(im, im_offset_pack, col, col_offset_pack);
+    }
+    time = handle.GetKernelTime();
+    return true;
+}
+
 float Im3d2ColGPU(const Handle& handle,
                   ConstData_t im,
                   const int im_offset,
@@ -242,7 +368,8 @@ float Im3d2ColGPU(const Handle& handle,
                   const int dilation_h,
                   const int dilation_w,
                   Data_t col,
-                  miopenDataType_t type)
+                  miopenDataType_t type,
+                  const int col_offset)
 {
     std::string program_name = "MIOpenIm3d2Col.cl";
     std::string kernel_name  = "Im3d2Col";
@@ -268,11 +395,42 @@ float Im3d2ColGPU(const Handle& handle,
         "t" + std::to_string(type);
     // clang-format on
 
+    float tiled_time = 0;
+    if(Im3d2ColTiledGPU(handle,
+                        tiled_time,
+                        im,
+                        im_offset,
+                        im_c,
+                        im_d,
+                        im_h,
+                        im_w,
+                        wei_d,
+                        wei_h,
+                        wei_w,
+                        out_d,
+                        out_h,
+                        out_w,
+                        pad_d,
+                        pad_h,
+                        pad_w,
+                        stride_d,
+                        stride_h,
+                        stride_w,
+                        dilation_d,
+                        dilation_h,
+                        dilation_w,
+                        col,
+                        type,
+                        col_offset,
+                        network_config))
+        return tiled_time;
+
     auto&& kernels = handle.GetKernels("miopenIm3d2Col", network_config);
 
     // int8x4 vectorize-c format
-    int im_offset_pack = type == miopenInt8x4 ? im_offset / 4 : im_offset;
-    int im_c_pack      = type == miopenInt8x4 ? im_c / 4 : im_c;
+    int im_offset_pack  = type == miopenInt8x4 ? im_offset / 4 : im_offset;
+    int col_offset_pack = type == miopenInt8x4 ? col_offset / 4 : col_offset;
+    int im_c_pack       = type == miopenInt8x4 ? im_c / 4 : im_c;
 
     if(!kernels.empty())
     {
@@ -298,7 +456,8 @@ float Im3d2ColGPU(const Handle& handle,
                dilation_d,
                dilation_h,
                dilation_w,
-               col);
+               col,
+               col_offset_pack);
     }
     else
     {
@@ -334,12 +493,142 @@ float Im3d2ColGPU(const Handle& handle,
             dilation_d,
             dilation_h,
             dilation_w,
-            col);
+            col,
+            col_offset_pack);
     }
 
     return handle.GetKernelTime();
 }
 
+/// The window loops of Col2Im2d and Col2Im3d test every tap a window may hold, while
+/// Col2ImGather visits only those reaching the position. That pays off for large filters and
+/// for the strided or dilated ones, where most windows miss.
+static bool IsCol2ImGatherPreferred(const int wei_d,
+                                    const int wei_h,
+                                    const int wei_w,
+                                    const int stride_d,
+                                    const int stride_h,
+                                    const int stride_w,
+                                    const int dilation_d,
+                                    const int dilation_h,
+                                    const int dilation_w)
+{
+    if(miopen::IsDisabled(MIOPEN_DEBUG_COL2IM_GATHER{}))
+        return false;
+    if(miopen::IsEnabled(MIOPEN_DEBUG_COL2IM_GATHER{}))
+        return true;
+
+    const auto prefers = [](int wei, int stride, int dilation) {
+        return wei >= 5 || (wei > 1 && (stride > 1 || dilation > 1));
+    };
+    return prefers(wei_d, stride_d, dilation_d) || prefers(wei_h, stride_h, dilation_h) ||
+           prefers(wei_w, stride_w, dilation_w);
+}
+
+static float Col2ImGatherGPU(const Handle& handle,
+                             ConstData_t col,
+                             const int out_d,
+                             const int out_h,
+                             const int out_w,
+                             const int wei_d,
+                             const int wei_h,
+                             const int wei_w,
+                             const int pad_d,
+                             const int pad_h,
+                             const int pad_w,
+                             const int stride_d,
+                             const int stride_h,
+                             const int stride_w,
+                             const int dilation_d,
+                             const int dilation_h,
+                             const int dilation_w,
+                             const int in_c,
+                             const int in_d,
+                             const int in_h,
+                             const int in_w,
+                             Data_t im,
+                             int im_offset,
+                             miopenDataType_t type,
+                             const int col_offset)
+{
+    std::string program_name = "MIOpenCol2ImGather.cl";
+    std::string kernel_name  = "Col2ImGather";
+
+    // clang-format off
+    std::string network_config =
+        "c" + std::to_string(in_c) +
+        "i" + std::to_string(in_d) +
+        "_" + std::to_string(in_h) +
+        "_" + std::to_string(in_w) +
+        "o" + std::to_string(out_d) +
+        "_" + std::to_string(out_h) +
+        "_" + std::to_string(out_w) +
+        "w" + std::to_string(wei_d) +
+        "_" + std::to_string(wei_h) +
+        "_" + std::to_string(wei_w) +
+        "p" + std::to_string(pad_d) +
+        "_" + std::to_string(pad_h) +
+        "_" + std::to_string(pad_w) +
+        "s" + std::to_string(stride_d) +
+        "_" + std::to_string(stride_h) +
+        "_" + std::to_string(stride_w) +
+        "d" + std::to_string(dilation_d) +
+        "_" + std::to_string(dilation_h) +
+        "_" + std::to_string(dilation_w) +
+        "t" + std::to_string(type);
+    // clang-format on
+
+    auto&& kernels = handle.GetKernels("miopenCol2ImGather", network_config);
+
+    if(!kernels.empty())
+    {
+        auto kernel = kernels.front();
+        kernel(col, im, im_offset, col_offset);
+    }
+    else
+    {
+        const int tile_w = 4;
+
+        std::string params = GetDataTypeKernelParams(type);
+        params += " -DC2I_IN_D=" + std::to_string(in_d);
+        params += " -DC2I_IN_H=" + std::to_string(in_h);
+        params += " -DC2I_IN_W=" + std::to_string(in_w);
+        params += " -DC2I_COL_D=" + std::to_string(out_d);
+        params += " -DC2I_COL_H=" + std::to_string(out_h);
+        params += " -DC2I_COL_W=" + std::to_string(out_w);
+        params += " -DC2I_WEI_D=" + std::to_string(wei_d);
+        params += " -DC2I_WEI_H=" + std::to_string(wei_h);
+        params += " -DC2I_WEI_W=" + std::to_string(wei_w);
+        params += " -DC2I_PAD_D=" + std::to_string(pad_d);
+        params += " -DC2I_PAD_H=" + std::to_string(pad_h);
+        params += " -DC2I_PAD_W=" + std::to_string(pad_w);
+        params += " -DC2I_STRIDE_D=" + std::to_string(stride_d);
+        params += " -DC2I_STRIDE_H=" + std::to_string(stride_h);
+        params += " -DC2I_STRIDE_W=" + std::to_string(stride_w);
+        params += " -DC2I_DILATION_D=" + std::to_string(dilation_d);
+        params += " -DC2I_DILATION_H=" + std::to_string(dilation_h);
+        params += " -DC2I_DILATION_W=" + std::to_string(dilation_w);
+        params += " -DC2I_STEP_D=" + std::to_string(stride_d / gcd(stride_d, dilation_d));
+        params += " -DC2I_STEP_H=" + std::to_string(stride_h / gcd(stride_h, dilation_h));
+        params += " -DC2I_STEP_W=" + std::to_string(stride_w / gcd(stride_w, dilation_w));
+        params += " -DC2I_TILE_W=" + std::to_string(tile_w);
+
+        // A row of work-groups per image row, each covering the row's stride_w phases.
+        const size_t local_size  = 64;
+        const size_t phase_w     = (in_w + stride_w - 1) / stride_w;
+        const size_t phase_tiles = stride_w * ((phase_w + tile_w - 1) / tile_w);
+        const std::vector<size_t> vld{local_size, 1, 1};
+        const std::vector<size_t> vgd{((phase_tiles + local_size - 1) / local_size) * local_size,
+                                      static_cast<size_t>(in_c * in_d * in_h),
+                                      1};
+
+        handle.AddKernel(
+            "miopenCol2ImGather", network_config, program_name, kernel_name, vld, vgd, params)(
+            col, im, im_offset, col_offset);
+    }
+    return handle.GetKernelTime();
+}
+
 float Col2Im2dGPU(const Handle& handle,
                   ConstData_t col,
                   const int out_h,
@@ -357,8 +646,36 @@ float Col2Im2dGPU(const Handle& handle,
                   const int in_w,
                   Data_t im,
                   int im_offset,
-                  miopenDataType_t type)
+                  miopenDataType_t type,
+                  const int col_offset)
 {
+    if(IsCol2ImGatherPreferred(1, wei_h, wei_w, 1, stride_h, stride_w, 1, dilation_h, dilation_w))
+        return Col2ImGatherGPU(handle,
+                               col,
+                               1,
+                               out_h,
+                               out_w,
+                               1,
+                               wei_h,
+                               wei_w,
+                               0,
+                               pad_h,
+                               pad_w,
+                               1,
+                               stride_h,
+                               stride_w,
+                               1,
+                               dilation_h,
+                               dilation_w,
+                               in_c,
+                               1,
+                               in_h,
+                               in_w,
+                               im,
+                               im_offset,
+                               type,
+                               col_offset);
+
     std::string program_name = "MIOpenCol2Im2d.cl";
     std::string kernel_name  = "Col2Im2d";
 
@@ -397,7 +714,8 @@ float Col2Im2dGPU(const Handle& handle,
                in_h,
                in_w,
                im,
-               im_offset);
+               im_offset,
+               col_offset);
     }
     else
     {
@@ -423,7 +741,8 @@ float Col2Im2dGPU(const Handle& handle,
             in_h,
             in_w,
             im,
-            im_offset);
+            im_offset,
+            col_offset);
     }
     return handle.GetKernelTime();
 }
@@ -451,8 +770,37 @@ float Col2Im3dGPU(const Handle& handle,
                   const int in_w,
                   Data_t im,
                   int im_offset,
-                  miopenDataType_t type)
+                  miopenDataType_t type,
+                  const int col_offset)
 {
+    if(IsCol2ImGatherPreferred(
+           wei_d, wei_h, wei_w, stride_d, stride_h, stride_w, dilation_d, dilation_h, dilation_w))
+        return Col2ImGatherGPU(handle,
+                               col,
+                               out_d,
+                               out_h,
+                               out_w,
+                               wei_d,
+                               wei_h,
+                               wei_w,
+                               pad_d,
+                               pad_h,
+                               pad_w,
+                               stride_d,
+                               stride_h,
+                               stride_w,
+                               dilation_d,
+                               dilation_h,
+                               dilation_w,
+                               in_c,
+                               in_d,
+                               in_h,
+                               in_w,
+                               im,
+                               im_offset,
+                               type,
+                               col_offset);
+
     std::string program_name = "MIOpenCol2Im3d.cl";
     std::string kernel_name  = "Col2Im3d";
 
@@ -502,7 +850,8 @@ float Col2Im3dGPU(const Handle& handle,
                in_h,
                in_w,
                im,
-               im_offset);
+               im_offset,
+               col_offset);
     }
     else
     {
@@ -534,7 +883,8 @@ float Col2Im3dGPU(const Handle& handle,
             in_h,
             in_w,
             im,
-            im_offset);
+            im_offset,
+            col_offset);
     }
     return handle.GetKernelTime();
 }
@@ -552,7 +902,8 @@ float Im2ColGPU(
     const std::vector<int>& stride_spatial,
     const std::vector<int>& dilation_spatial,
     Data_t col,
-    miopenDataType_t type)
+    miopenDataType_t type,
+    std::size_t col_offset)
 {
     switch(spatial_dim)
     {
@@ -575,7 +926,8 @@ float Im2ColGPU(
                            dilation_spatial[0],
                            dilation_spatial[1],
                            col,
-                           type);
+                           type,
+                           col_offset);
     }
     case 3:
     {
@@ -602,7 +954,8 @@ float Im2ColGPU(
                            dilation_spatial[1],
                            dilation_spatial[2],
                            col,
-                           type);
+                           type,
+                           col_offset);
     }
     default: { MIOPEN_THROW("unsupported convolution dimension");
     }
@@ -622,7 +975,8 @@ float Col2ImGPU(
     const decltype(boost::adaptors::slice(std::vector<std::size_t>(), 0, 1))& in_spatial,
     Data_t im,
     std::size_t im_offset,
-    miopenDataType_t type)
+    miopenDataType_t type,
+    std::size_t col_offset)
 {
     switch(spatial_dim)
     {
@@ -645,7 +999,8 @@ float Col2ImGPU(
                            in_spatial[1],
                            im,
                            im_offset,
-                           type);
+                           type,
+                           col_offset);
     }
     case 3:
     {
@@ -672,7 +1027,8 @@ float Col2ImGPU(
                            in_spatial[2],
                            im,
                            im_offset,
-                           type);
+                           type,
+                           col_offset);
     }
     default: { MIOPEN_THROW("unsupported convolution dimension");
     }
@@ -24,19 +24,71 @@
  *
  *******************************************************************************/
 #include <cassert>
+#include <miopen/errors.hpp>
 #include <miopen/fusion.hpp>
 #include <miopen/logger.hpp>
 
+#include <mutex>
+
 namespace miopen {
 
+namespace {
+
+struct ArgKeys
+{
+    std::mutex mutex;
+    std::unordered_map<std::string, std::size_t> indices;
+    std::vector<std::string> keys;
+};
+
+// The keys are made of the argument names and the op indices, so there are few of them.
+ArgKeys& GetArgKeys()
+{
+    static ArgKeys arg_keys;
+    return arg_keys;
+}
+
+} // namespace
+
 // operator args
 OperatorArgs::OperatorArgs() {}
 
 void OperatorArgs::ins_arg(std::string name, OpKernelArg v)
 {
-    args_map.emplace(std::make_pair(name, v));
+    const auto key_index = GetKeyIndex(name);
+    const auto inserted  = args_map.emplace(std::make_pair(name, v)).second;
     //    args_map[name] = std::move(v);
     args_vec.push_back(v);
+    // The first value of a key is kept, as in the map.
+    if(!inserted)
+        return;
+    if(args_by_index.size() <= key_index)
+        args_by_index.resize(key_index + 1);
+    args_by_index[key_index] = std::move(v);
+}
+
+std::size_t OperatorArgs::GetKeyIndex(const std::string& key)
+{
+    auto& arg_keys = GetArgKeys();
+    const std::lock_guard<std::mutex> lock{arg_keys.mutex};
+    const auto inserted = arg_keys.indices.emplace(key, arg_keys.keys.size());
+    if(inserted.second)
+        arg_keys.keys.push_back(key);
+    return inserted.first->second;
+}
+
+std::string OperatorArgs::GetKey(std::size_t key_index)
+{
+    auto& arg_keys = GetArgKeys();
+    const std::lock_guard<std::mutex> lock{arg_keys.mutex};
+    return arg_keys.keys.at(key_index);
+}
+
+const OpKernelArg& OperatorArgs::Get(std::size_t key_index) const
+{
+    if(key_index >= args_by_index.size() || !args_by_index[key_index])
+        MIOPEN_THROW(miopenStatusInternalError, "Argument Not Set: " + GetKey(key_index));
+    return *args_by_index[key_index];
 }
 
 std::ostream& operator<<(std::ostream& stream, const OperatorArgs&) // x )
@@ -38,7 +38,10 @@ std::ostream& operator<<(std::ostream& stream, const FusionOpDescriptor& x)
                     miopenFusionOpBiasForward,
                     miopenFusionOpBatchNormFwdTrain,
                     miopenFusionOpBatchNormBwdTrain,
-                    miopenFusionOpActivBackward);
+                    miopenFusionOpActivBackward,
+                    miopenFusionOpResidualAddForward,
+                    miopenFusionOpResidualAddBackward,
+                    miopenFusionOpPoolingForward);
     return stream;
 }
 
@@ -0,0 +1,106 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/optimizer.hpp>
+
+#include <vector>
+
+extern "C" miopenStatus_t miopenMultiTensorOptimizerUpdate(miopenHandle_t handle,
+                                                           miopenOptimizerMode_t mode,
+                                                           miopenDataType_t dataType,
+                                                           int tensorCount,
+                                                           const size_t* elementCounts,
+                                                           void** params,
+                                                           const void* const* grads,
+                                                           void** expAvgs,
+                                                           void** expAvgSqs,
+                                                           float lr,
+                                                           float beta1,
+                                                           float beta2,
+                                                           float eps,
+                                                           float weightDecay,
+                                                           int step)
+{
+
+    MIOPEN_LOG_FUNCTION(handle,
+                        mode,
+                        dataType,
+                        tensorCount,
+                        elementCounts,
+                        params,
+                        grads,
+                        expAvgs,
+                        expAvgSqs,
+                        lr,
+                        beta1,
+                        beta2,
+                        eps,
+                        weightDecay,
+                        step);
+    return miopen::try_([&] {
+        if(tensorCount < 0)
+            MIOPEN_THROW(miopenStatusBadParm, "Negative tensor count");
+        if(tensorCount == 0)
+            return;
+        if(elementCounts == nullptr || params == nullptr || grads == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "Null tensor list");
+
+        const bool use_m = mode != miopenOptimizerSGD;
+        const bool use_v = mode == miopenOptimizerAdam || mode == miopenOptimizerLAMB;
+        if((use_m && expAvgs == nullptr) || (use_v && expAvgSqs == nullptr))
+            MIOPEN_THROW(miopenStatusBadParm, "Null optimizer state list");
+
+        std::vector<size_t> counts(elementCounts, elementCounts + tensorCount);
+        std::vector<Data_t> p_list, m_list, v_list;
+        std::vector<ConstData_t> g_list;
+        for(int i = 0; i < tensorCount; i++)
+        {
+            p_list.push_back(DataCast(params[i]));
+            g_list.push_back(DataCast(grads[i]));
+            if(use_m)
+                m_list.push_back(DataCast(expAvgs[i]));
+            if(use_v)
+                v_list.push_back(DataCast(expAvgSqs[i]));
+        }
+
+        miopen::MultiTensorOptimizerUpdate(miopen::deref(handle),
+                                           mode,
+                                           dataType,
+                                           counts,
+                                           p_list,
+                                           g_list,
+                                           m_list,
+                                           v_list,
+                                           lr,
+                                           beta1,
+                                           beta2,
+                                           eps,
+                                           weightDecay,
+                                           step);
+    });
+}
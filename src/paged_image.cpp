@@ -0,0 +1,118 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/paged_image.hpp>
+
+#include <miopen/bz2.hpp>
+#include <miopen/errors.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace miopen {
+
+constexpr const char* PagedImage::magic;
+constexpr std::size_t PagedImage::magic_size;
+constexpr std::size_t PagedImage::header_size;
+
+bool PagedImage::IsPagedImage(const char* data, std::size_t size)
+{
+    return size >= header_size && std::memcmp(data, magic, magic_size) == 0;
+}
+
+uint64_t PagedImage::ReadUInt64(const char* p)
+{
+    uint64_t value = 0;
+    for(int i = 7; i >= 0; --i)
+        value = (value << 8) | static_cast<unsigned char>(p[i]);
+    return value;
+}
+
+PagedImage::PagedImage(const char* data, std::size_t image_size)
+{
+    if(!IsPagedImage(data, image_size))
+        MIOPEN_THROW(miopenStatusInternalError, "Not a paged image");
+
+    page_size  = ReadUInt64(data + magic_size);
+    size       = ReadUInt64(data + magic_size + 8);
+    page_count = ReadUInt64(data + magic_size + 16);
+    offsets    = data + header_size;
+
+    const auto table_size = 8 * (page_count + 1);
+    if(page_size == 0 || (size + page_size - 1) / page_size != page_count ||
+       table_size > image_size - header_size)
+        MIOPEN_THROW(miopenStatusInternalError, "Malformed paged image header");
+    pages = offsets + table_size;
+
+    for(std::size_t i = 0; i < page_count; ++i)
+        if(GetOffset(i) > GetOffset(i + 1))
+            MIOPEN_THROW(miopenStatusInternalError, "Malformed paged image offsets");
+    if(GetOffset(page_count) != image_size - header_size - table_size)
+        MIOPEN_THROW(miopenStatusInternalError, "Truncated paged image");
+
+    cache.reset(new std::atomic<const unsigned char*>[page_count]);
+    for(std::size_t i = 0; i < page_count; ++i)
+        cache[i] = nullptr;
+}
+
+PagedImage::~PagedImage()
+{
+    for(std::size_t i = 0; i < page_count; ++i)
+        delete[] cache[i].load();
+}
+
+const unsigned char* PagedImage::GetPage(std::size_t index) const
+{
+    if(index >= page_count)
+        MIOPEN_THROW(miopenStatusInternalError,
+                     "Page " + std::to_string(index) + " is out of the paged image");
+
+    const auto begin  = GetOffset(index);
+    const auto stored = GetOffset(index + 1) - begin;
+    const auto length = std::min(page_size, size - index * page_size);
+    if(stored == length)
+        return reinterpret_cast<const unsigned char*>(pages + begin);
+
+    const auto cached = cache[index].load(std::memory_order_acquire);
+    if(cached != nullptr)
+        return cached;
+
+    const auto page = decompress({pages + begin, stored}, static_cast<unsigned int>(length));
+    if(page.size() != length)
+        MIOPEN_THROW(miopenStatusInternalError,
+                     "Page " + std::to_string(index) + " of the paged image is corrupted");
+
+    std::unique_ptr<unsigned char[]> buffer{new unsigned char[length]};
+    std::memcpy(buffer.get(), page.data(), length);
+
+    // Another thread may have decompressed the same page meanwhile, keep the first one.
+    const unsigned char* expected = nullptr;
+    if(!cache[index].compare_exchange_strong(expected, buffer.get(), std::memory_order_acq_rel))
+        return expected;
+    ++decompressed;
+    return buffer.release();
+}
+
+} // namespace miopen
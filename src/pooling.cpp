@@ -221,8 +221,10 @@ TensorDescriptor PoolingDescriptor::GetForwardOutputTensor(const TensorDescripto
 
 std::size_t PoolingDescriptor::GetWorkSpaceSize(const TensorDescriptor& yDesc) const
 {
-    return GetMode() == miopenPoolingMax ? yDesc.GetElementSize() * get_data_size(GetIndexType())
-                                         : 0;
+    return GetMode() == miopenPoolingMax &&
+                   GetWorkspaceIndexMode() != miopenPoolingWorkspaceIndexRecompute
+               ? yDesc.GetElementSize() * get_data_size(GetIndexType())
+               : 0;
 }
 
 std::ostream& operator<<(std::ostream& stream, const PoolingDescriptor& x)
@@ -59,6 +59,10 @@ void ProblemDescription::Serialize(std::ostream& stream) const
         if(group_counts != 1)
             optional << 'g' << group_counts;
     }
+    if(conv_problem.GetConv().prefer_latency)
+        optional << 'l';
+    if(conv_problem.IsDeterministic())
+        optional << 'd';
     if(!optional.str().empty())
     {
         stream << '_' << optional.str();
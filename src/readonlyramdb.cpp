@@ -25,6 +25,7 @@
  *******************************************************************************/
 
 #include <miopen/readonlyramdb.hpp>
+#include <miopen/env.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/errors.hpp>
 
@@ -40,36 +41,110 @@
 #include <sstream>
 #include <map>
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_RAMDB_PREPARSE)
+
 namespace miopen {
 extern boost::optional<std::string>&
 testing_find_db_path_override(); /// \todo Remove when #1723 is resolved.
+
+ReadonlyRamDb::ReadonlyRamDb(std::string path)
+    : db_path(path), preparsed(IsEnabled(MIOPEN_DEBUG_RAMDB_PREPARSE{}))
+{
+}
+
 ReadonlyRamDb& ReadonlyRamDb::GetCached(const std::string& path,
                                         bool warn_if_unreadable,
                                         const std::string& /*arch*/,
                                         const std::size_t /*num_cu*/)
 {
-    static std::mutex mutex;
-    const std::lock_guard<std::mutex> lock{mutex};
-
-    static auto instances = std::map<std::string, ReadonlyRamDb*>{};
-    const auto it         = instances.find(path);
-
-    if(it != instances.end())
-        return *it->second;
-
-    // The ReadonlyRamDb objects allocated here by "new" shall be alive during
-    // the calling app lifetime. Size of each is very small, and there couldn't
-    // be many of them (max number is number of _different_ GPU board installed
-    // in the user's system, which is _one_ for now). Therefore the total
-    // footprint in heap is very small. That is why we can omit deletion of
-    // these objects thus avoiding bothering with MP/MT syncronization.
-    // These will be destroyed altogether with heap.
-    auto instance = new ReadonlyRamDb{path};
-    instances.emplace(path, instance);
-    instance->Prefetch(path, warn_if_unreadable);
+    ReadonlyRamDb* instance = nullptr;
+    {
+        static std::mutex mutex;
+        const std::lock_guard<std::mutex> lock{mutex};
+
+        static auto instances = std::map<std::string, ReadonlyRamDb*>{};
+        const auto it         = instances.find(path);
+
+        if(it != instances.end())
+        {
+            instance = it->second;
+        }
+        else
+        {
+            // The ReadonlyRamDb objects allocated here by "new" shall be alive during
+            // the calling app lifetime. Size of each is very small, and there couldn't
+            // be many of them (max number is number of _different_ GPU board installed
+            // in the user's system, which is _one_ for now). Therefore the total
+            // footprint in heap is very small. That is why we can omit deletion of
+            // these objects thus avoiding bothering with MP/MT syncronization.
+            // These will be destroyed altogether with heap.
+            instance = new ReadonlyRamDb{path};
+            instances.emplace(path, instance);
+        }
+    }
+
+    // Outside of the lock, so the loads of different dbs do not wait for each other. A lookup
+    // of a db being loaded by another thread, e.g. by PrefetchSystemDbs(), waits here.
+    std::call_once(instance->prefetched, [&]() { instance->Prefetch(path, warn_if_unreadable); });
     return *instance;
 }
 
+boost::optional<DbRecord> ReadonlyRamDb::FindRecord(const std::string& problem) const
+{
+    const cache_stats::Lookup lookup{miopenCacheSystemFindDb};
+    auto record = FindRecordImpl(problem);
+    lookup.Done(record.is_initialized());
+    return record;
+}
+
+boost::optional<DbRecord> ReadonlyRamDb::FindRecordImpl(const std::string& problem) const
+{
+    if(preparsed && mapped == nullptr)
+    {
+        const auto record = FindParsedRecord(problem);
+        if(record == nullptr)
+            return boost::none;
+        return *record;
+    }
+
+    auto line    = 0;
+    auto content = std::string{};
+
+    if(mapped != nullptr)
+    {
+        auto mapped_item = mapped->Find(problem);
+        if(!mapped_item)
+            return boost::none;
+        line    = mapped_item->line;
+        content = std::move(mapped_item->content);
+    }
+    else
+    {
+        const auto index = cache.Find(problem);
+        if(index == StringArenaMap::npos)
+            return boost::none;
+        line    = cache_lines[index];
+        content = cache.GetValue(index);
+    }
+
+    auto record = DbRecord{problem};
+
+    if(!record.ParseContents(content))
+    {
+        MIOPEN_LOG_E("Error parsing payload under the key: " << problem << " form file " << db_path
+                                                             << "#"
+                                                             << line);
+        MIOPEN_LOG_E("Contents: " << content);
+        return boost::none;
+    }
+    else
+    {
+        MIOPEN_LOG_I2("Looking for key " << problem << " in file " << db_path);
+    }
+
+    return record;
+}
+
 template <class TFunc>
 static auto Measure(const std::string& funcName, TFunc&& func)
 {
@@ -113,11 +188,48 @@ void ReadonlyRamDb::ParseAndLoadDb(std::istream& input_stream,
             continue;
         }
 
+        if(!preparsed)
+        {
+            // Straight from the line buffer, no per-record allocations.
+            if(cache.Emplace(line.data(),
+                             key_size,
+                             line.data() + key_size + 1,
+                             line.size() - key_size - 1))
+                cache_lines.push_back(n_line);
+            continue;
+        }
+
         const auto key      = line.substr(0, key_size);
         const auto contents = line.substr(key_size + 1);
 
-        cache.emplace(key, CacheItem{n_line, contents});
+        auto record = DbRecord{key};
+        if(!record.ParseContents(contents))
+        {
+            MIOPEN_LOG_E("Error parsing payload under the key: " << key << " form file " << path
+                                                                 << "#"
+                                                                 << n_line);
+            MIOPEN_LOG_E("Contents: " << contents);
+            continue;
+        }
+        records.emplace(key, std::move(record));
+    }
+}
+
+bool ReadonlyRamDb::TryMapBinary(const std::string& path)
+{
+    const auto binary_path = binary_db::GetPath(path);
+    if(!boost::filesystem::exists(binary_path))
+        return false;
+
+    if(boost::filesystem::exists(path) &&
+       boost::filesystem::last_write_time(path) > boost::filesystem::last_write_time(binary_path))
+    {
+        MIOPEN_LOG_W("Binary db " << binary_path << " is older than " << path << ", ignoring it.");
+        return false;
     }
+
+    mapped = MappedDb::Open(binary_path);
+    return mapped != nullptr;
 }
 
 void ReadonlyRamDb::Prefetch(const std::string& path, bool warn_if_unreadable)
@@ -125,6 +237,9 @@ void ReadonlyRamDb::Prefetch(const std::string& path, bool warn_if_unreadable)
     Measure("Prefetch", [this, &path, warn_if_unreadable]() {
 
         constexpr bool isEmbedded = MIOPEN_EMBED_DB;
+        if(!isEmbedded && TryMapBinary(path))
+            return;
+
         if(!testing_find_db_path_override() && isEmbedded)
         {
 #if MIOPEN_EMBED_DB
@@ -96,10 +96,11 @@ struct ReductionKernelConfigurator
     ReductionKernelConfigurator(int blockSize, int warpSize)
         : blockSize_(blockSize), warpSize_(warpSize)
     {
-        GredDirectThreadWiseUpperReductionLen = warpSize;
-        GredDirectWarpWiseUpperReductionLen   = blockSize;
-        GredBlockWiseUpperReductionLen        = blockSize * 4;
-        GredUpperNumBlocksPerReduction        = 32;
+        GredDirectThreadWiseUpperReductionLen  = warpSize;
+        GredDirectWarpWiseUpperReductionLen    = blockSize;
+        GredBlockWiseUpperReductionLen         = blockSize * 4;
+        GredUpperNumBlocksPerReduction         = 32;
+        GredStridedThreadWiseLowerInvariantLen = blockSize * 64;
 
         numWarpsPerBlock = blockSize / warpSize;
     };
@@ -112,11 +113,25 @@ struct ReductionKernelConfigurator
     std::size_t GredDirectWarpWiseUpperReductionLen;
     std::size_t GredBlockWiseUpperReductionLen;
     std::size_t GredUpperNumBlocksPerReduction;
+    std::size_t GredStridedThreadWiseLowerInvariantLen;
 
-    std::size_t getGridSize(std::size_t invariantLength, std::size_t toReduceLength) const
+    // When the toReduce dimensions are strided and there are enough invariant elements to fill
+    // the device, letting one thread do each reduction keeps the loads of neighbouring threads
+    // adjacent in memory, while a warp or block working along one reduction would not coalesce.
+    bool useStridedThreadWise(std::size_t invariantLength, bool stridedReduce) const
+    {
+        return (stridedReduce && invariantLength >= GredStridedThreadWiseLowerInvariantLen);
+    };
+
+    std::size_t getGridSize(std::size_t invariantLength,
+                            std::size_t toReduceLength,
+                            bool stridedReduce) const
     {
         assert(invariantLength > 0 && toReduceLength > 1);
 
+        if(useStridedThreadWise(invariantLength, stridedReduce))
+            return ((invariantLength + blockSize_ - 1) / blockSize_);
+
         if(invariantLength == 1)
         {
             if(toReduceLength <
@@ -152,10 +167,14 @@ struct ReductionKernelConfigurator
     };
 
     ReductionMethod_t getReductionMethod(std::size_t invariantLength,
-                                         std::size_t toReduceLength) const
+                                         std::size_t toReduceLength,
+                                         bool stridedReduce) const
     {
         assert(invariantLength > 0 && toReduceLength > 1);
 
+        if(useStridedThreadWise(invariantLength, stridedReduce))
+            return (Reduce_DirectThreadWise);
+
         if(invariantLength == 1)
         {
             if(toReduceLength <
@@ -180,13 +199,15 @@ struct ReductionKernelConfigurator
         };
     };
 
-    std::size_t getWorkspaceSize(std::size_t invariantLength, std::size_t toReduceLength) const
+    std::size_t getWorkspaceSize(std::size_t invariantLength,
+                                 std::size_t toReduceLength,
+                                 bool stridedReduce) const
     {
         assert(invariantLength > 0 && toReduceLength > 1);
 
-        if(getReductionMethod(invariantLength, toReduceLength) == Reduce_MultiBlock)
+        if(getReductionMethod(invariantLength, toReduceLength, stridedReduce) == Reduce_MultiBlock)
         {
-            auto gridSize = getGridSize(invariantLength, toReduceLength);
+            auto gridSize = getGridSize(invariantLength, toReduceLength, stridedReduce);
 
             return (gridSize);
         };
@@ -247,6 +268,60 @@ inline int GetDataTypeId(miopenDataType_t t)
     };
 };
 
+// half and bfloat16 reductions accumulate, and keep their per-block partial results, in float
+inline miopenDataType_t GetAccumulationType(miopenDataType_t compType)
+{
+    return (compType == miopenHalf || compType == miopenBFloat16) ? miopenFloat : compType;
+};
+
+// true when the dimension contiguous in memory is an invariant one, so that neighbouring elements
+// of a reduction are strided
+inline bool IsReduceAlongStridedDims(const TensorDescriptor& inDesc,
+                                     const TensorDescriptor& outDesc)
+{
+    const auto& inDescLengths  = inDesc.GetLengths();
+    const auto& inDescStrides  = inDesc.GetStrides();
+    const auto& outDescLengths = outDesc.GetLengths();
+
+    for(int i = 0; i < inDescLengths.size(); i++)
+    {
+        if(inDescStrides[i] == 1 && inDescLengths[i] > 1)
+            return (outDescLengths[i] == inDescLengths[i]);
+    };
+
+    return (false);
+};
+
+// the widest vector, up to maxVectorSize, which can load the elements along the innermost toReduce
+// dimension when it is contiguous: every vector has to be aligned and stay within one row
+inline int GetSrcDataPerRead(const TensorDescriptor& inDesc,
+                             const std::vector<int>& toReduceDims,
+                             int maxVectorSize)
+{
+    const auto& inDescLengths = inDesc.GetLengths();
+    const auto& inDescStrides = inDesc.GetStrides();
+    const int innerDim        = toReduceDims.back();
+
+    if(inDescStrides[innerDim] != 1)
+        return (1);
+
+    for(int vectorSize = maxVectorSize; vectorSize > 1; vectorSize /= 2)
+    {
+        bool vectorizable = (inDescLengths[innerDim] % vectorSize == 0);
+
+        for(int i = 0; i < inDescLengths.size(); i++)
+        {
+            if(i != innerDim && inDescLengths[i] > 1 && inDescStrides[i] % vectorSize != 0)
+                vectorizable = false;
+        };
+
+        if(vectorizable)
+            return (vectorSize);
+    };
+
+    return (1);
+};
+
 inline int GetReduceTensorOpId(miopenReduceTensorOp_t t)
 {
     switch(t)
@@ -305,7 +380,8 @@ std::size_t ReduceTensorDescriptor::GetWorkspaceSize(const Handle& handle,
 
     detail::ReductionKernelConfigurator configurator(256, handle.GetWavefrontWidth());
 
-    auto workspace_size = configurator.getWorkspaceSize(invariantLength, toReduceLength);
+    auto workspace_size = configurator.getWorkspaceSize(
+        invariantLength, toReduceLength, detail::IsReduceAlongStridedDims(inDesc, outDesc));
 
     auto reduceIndicesOpt = this->reduceTensorIndices_;
     auto reduceOp         = this->reduceTensorOp_;
@@ -313,10 +389,13 @@ std::size_t ReduceTensorDescriptor::GetWorkspaceSize(const Handle& handle,
         (reduceIndicesOpt == MIOPEN_REDUCE_TENSOR_FLATTENED_INDICES) &&
         (reduceOp == MIOPEN_REDUCE_TENSOR_MIN || reduceOp == MIOPEN_REDUCE_TENSOR_MAX);
 
+    // the partial results of the first-time reduction are kept in the accumulation type
+    std::size_t wsTypeSize =
+        detail::GetDataTypeSize(detail::GetAccumulationType(this->reduceTensorCompType_));
+
     std::size_t wsSizeInBytes =
-        !need_indices ? workspace_size * detail::GetDataTypeSize(inDesc.GetType())
-                      : workspace_size * (detail::GetDataTypeSize(inDesc.GetType()) + sizeof(int)) +
-                            64 + sizeof(int);
+        !need_indices ? workspace_size * wsTypeSize
+                      : workspace_size * (wsTypeSize + sizeof(int)) + 64 + sizeof(int);
 
     return (wsSizeInBytes);
 };
@@ -365,7 +444,7 @@ void ReduceTensorDescriptor::ReduceTensor(const Handle& handle,
 {
     const auto srcDataType       = aDesc.GetType();
     const auto dstDataType       = cDesc.GetType();
-    const auto compType          = this->reduceTensorCompType_;
+    const auto compType          = detail::GetAccumulationType(this->reduceTensorCompType_);
     const auto reduceOp          = this->reduceTensorOp_;
     const auto nanPropaOpt       = this->reduceTensorNanOpt_;
     const auto reduceIndicesOpt  = this->reduceTensorIndices_;
@@ -411,10 +490,10 @@ void ReduceTensorDescriptor::ReduceTensor(const Handle& handle,
 
     if(need_indices && workspace != nullptr)
     {
-        std::size_t aTypeSize = detail::GetDataTypeSize(aDesc.GetType());
+        std::size_t wsTypeSize = detail::GetDataTypeSize(compType);
 
         long byteOffset =
-            static_cast<long>((workspaceSizeInBytes / (aTypeSize + sizeof(int))) * aTypeSize);
+            static_cast<long>((workspaceSizeInBytes / (wsTypeSize + sizeof(int))) * wsTypeSize);
 
         ws_buf2_bytes_offset = ((byteOffset + 63) / 64) * 64;
     };
@@ -450,8 +529,11 @@ void ReduceTensorDescriptor::ReduceTensor(const Handle& handle,
     const int blockSize = 256; // tunable
     detail::ReductionKernelConfigurator configurator(blockSize, handle.GetWavefrontWidth());
 
-    ReductionMethod_t reduceImpl = configurator.getReductionMethod(invariantLength, toReduceLength);
-    auto gridSize                = configurator.getGridSize(invariantLength, toReduceLength);
+    const bool stridedReduce = detail::IsReduceAlongStridedDims(aDesc, cDesc);
+
+    ReductionMethod_t reduceImpl =
+        configurator.getReductionMethod(invariantLength, toReduceLength, stridedReduce);
+    auto gridSize = configurator.getGridSize(invariantLength, toReduceLength, stridedReduce);
     int blkGroupSize =
         (reduceImpl == Reduce_MultiBlock) ? static_cast<int>(gridSize / invariantLength) : 0;
 
@@ -465,6 +547,15 @@ void ReduceTensorDescriptor::ReduceTensor(const Handle& handle,
     int GredAccessesPerThreadInBlock = get_constants.GredAccessesPerThreadInBlock;
     int GredAccessesPerThreadInWarp  = get_constants.GredAccessesPerThreadInWarp;
 
+    // the block loads of a reduction along the contiguous dimension are vectorized, with each
+    // thread accessing at least one vector per step
+    int GredSrcDataPerRead = 1;
+    if(reduceImpl == Reduce_BlockWise || reduceImpl == Reduce_MultiBlock)
+    {
+        GredSrcDataPerRead           = detail::GetSrcDataPerRead(aDesc, toReduceDims, 4);
+        GredAccessesPerThreadInBlock = std::max(GredAccessesPerThreadInBlock, GredSrcDataPerRead);
+    };
+
     std::string param;
 
     param = std::string(" -std=c++14 ");
@@ -546,6 +637,7 @@ void ReduceTensorDescriptor::ReduceTensor(const Handle& handle,
         " -DCK_PARAM_ACCESSES_PER_THREAD_INBLOCK=" + std::to_string(GredAccessesPerThreadInBlock);
     param +=
         " -DCK_PARAM_ACCESSES_PER_THREAD_INWARP=" + std::to_string(GredAccessesPerThreadInWarp);
+    param += " -DCK_PARAM_SRC_DATA_PER_READ=" + std::to_string(GredSrcDataPerRead);
 
     param += " -DCK_PARAM_REDUCE_IMPL=" + std::to_string(static_cast<int>(reduceImpl));
 
@@ -560,6 +652,9 @@ void ReduceTensorDescriptor::ReduceTensor(const Handle& handle,
                      std::to_string(compType) + "IN";
     for(auto dimLen : inDescLengths)
         network_config += std::to_string(dimLen) + "_";
+    network_config += "IS";
+    for(auto dimStride : inDescStrides)
+        network_config += std::to_string(dimStride) + "_";
     network_config += "OUT";
     for(auto dimLen : outDescLengths)
         network_config += std::to_string(dimLen) + "_";
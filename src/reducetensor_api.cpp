@@ -28,6 +28,7 @@
 #include <miopen/handle.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/tensor_ops.hpp>
+#include <miopen/topk.hpp>
 #include <algorithm>
 
 extern "C" miopenStatus_t
@@ -167,3 +168,31 @@ extern "C" miopenStatus_t miopenReduceTensor(miopenHandle_t handle,
                           DataCast(C));
     });
 };
+
+extern "C" miopenStatus_t miopenTopK(miopenHandle_t handle,
+                                     const miopenTensorDescriptor_t xDesc,
+                                     const void* x,
+                                     int dim,
+                                     int k,
+                                     bool largest,
+                                     const miopenTensorDescriptor_t valuesDesc,
+                                     void* values,
+                                     const miopenTensorDescriptor_t indicesDesc,
+                                     void* indices)
+{
+    MIOPEN_LOG_FUNCTION(
+        handle, xDesc, x, dim, k, largest, valuesDesc, values, indicesDesc, indices);
+
+    return miopen::try_([&] {
+        miopen::TopK(miopen::deref(handle),
+                     miopen::deref(xDesc),
+                     DataCast(x),
+                     dim,
+                     k,
+                     largest,
+                     miopen::deref(valuesDesc),
+                     DataCast(values),
+                     miopen::deref(indicesDesc),
+                     DataCast(indices));
+    });
+};
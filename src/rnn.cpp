@@ -27,10 +27,14 @@
 #include <miopen/handle.hpp>
 #include <miopen/rnn.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <numeric>
 #include <ostream>
+#include <vector>
 
 // MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_AMD_ROCM_PRECOMPILED_BINARIES)
 // MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_AMD_ASM_KERNELS_PERF_FILTERING)
@@ -145,31 +149,46 @@ size_t RNNDescriptor::paramsOffsetCalculation(const TensorDescriptor& xDesc,
                                               const int layer,
                                               const int paramID) const
 {
+    // The projection matrices follow the biases, in the order of the layers.
+    if(projSize != 0 && paramID == 2 * nHiddenTensorsPerLayer)
+    {
+        const int bi  = dirMode != 0u ? 2 : 1;
+        size_t offset = paramsOffsetCalculation(xDesc, static_cast<int>(nLayers) * bi, 0);
+        if(biasMode == miopenRNNwithBias)
+        {
+            offset += nLayers * 2 * nHiddenTensorsPerLayer * hsize * bi;
+        }
+        return offset + layer * projSize * hsize;
+    }
+
     auto inputVectorLen = xDesc.GetLengths()[1];
     if(inputMode == miopenRNNskip)
     {
         inputVectorLen = 0;
     }
 
+    // With a projection the hidden state matrices have rsize columns.
+    const auto rsize = RecurrentSize();
+
     size_t layerJump = 0;
     if(dirMode != 0u)
     {
         if(layer > 1)
         {
-            layerJump += (inputVectorLen * hsize + hsize * hsize) * nHiddenTensorsPerLayer * 2;
+            layerJump += (inputVectorLen * hsize + hsize * rsize) * nHiddenTensorsPerLayer * 2;
             layerJump +=
-                (hsize * hsize * 2 + hsize * hsize) * nHiddenTensorsPerLayer * (layer / 2 - 1) * 2;
+                (hsize * rsize * 2 + hsize * rsize) * nHiddenTensorsPerLayer * (layer / 2 - 1) * 2;
 
             if(paramID >= nHiddenTensorsPerLayer)
             {
-                layerJump += hsize * hsize * 2 * nHiddenTensorsPerLayer * 2;
-                layerJump += (layer % 2 == 1) ? nHiddenTensorsPerLayer * (hsize * hsize) : 0;
-                layerJump += (hsize * hsize) * (paramID - nHiddenTensorsPerLayer);
+                layerJump += hsize * rsize * 2 * nHiddenTensorsPerLayer * 2;
+                layerJump += (layer % 2 == 1) ? nHiddenTensorsPerLayer * (hsize * rsize) : 0;
+                layerJump += (hsize * rsize) * (paramID - nHiddenTensorsPerLayer);
             }
             else
             {
-                layerJump += (layer % 2 == 1) ? nHiddenTensorsPerLayer * (2 * hsize * hsize) : 0;
-                layerJump += (2 * hsize * hsize) * paramID;
+                layerJump += (layer % 2 == 1) ? nHiddenTensorsPerLayer * (2 * hsize * rsize) : 0;
+                layerJump += (2 * hsize * rsize) * paramID;
             }
         }
         else
@@ -180,8 +199,8 @@ size_t RNNDescriptor::paramsOffsetCalculation(const TensorDescriptor& xDesc,
                 {
                     layerJump += (inputVectorLen * hsize) * nHiddenTensorsPerLayer * 2;
                 }
-                layerJump += (layer == 1) ? nHiddenTensorsPerLayer * (hsize * hsize) : 0;
-                layerJump += (hsize * hsize) * (paramID - nHiddenTensorsPerLayer);
+                layerJump += (layer == 1) ? nHiddenTensorsPerLayer * (hsize * rsize) : 0;
+                layerJump += (hsize * rsize) * (paramID - nHiddenTensorsPerLayer);
             }
             else
             {
@@ -195,9 +214,9 @@ size_t RNNDescriptor::paramsOffsetCalculation(const TensorDescriptor& xDesc,
 
         if(layer > 0)
         {
-            layerJump += (inputVectorLen * hsize + hsize * hsize) * nHiddenTensorsPerLayer;
-            layerJump += (hsize * hsize * 2) * nHiddenTensorsPerLayer * (layer - 1);
-            layerJump += (hsize * hsize) * paramID;
+            layerJump += (inputVectorLen * hsize + hsize * rsize) * nHiddenTensorsPerLayer;
+            layerJump += (hsize * rsize * 2) * nHiddenTensorsPerLayer * (layer - 1);
+            layerJump += (hsize * rsize) * paramID;
         }
         else
         {
@@ -207,7 +226,7 @@ size_t RNNDescriptor::paramsOffsetCalculation(const TensorDescriptor& xDesc,
                 {
                     layerJump += (inputVectorLen * hsize) * nHiddenTensorsPerLayer;
                 }
-                layerJump += (hsize * hsize) * (paramID - nHiddenTensorsPerLayer);
+                layerJump += (hsize * rsize) * (paramID - nHiddenTensorsPerLayer);
             }
             else
             {
@@ -230,25 +249,36 @@ std::vector<int> RNNDescriptor::pTensorLengthsCalculation(const TensorDescriptor
 
     std::vector<int> tdim(2, 0);
 
+    if(projSize != 0 && paramID == 2 * nHiddenTensorsPerLayer)
+    {
+        tdim[0] = projSize;
+        tdim[1] = hsize;
+        return tdim;
+    }
+
+    const auto rsize = RecurrentSize();
+
     if(dirMode != 0u)
     {
         if(layer > 1) // NOT the input layer
         {
             if(paramID >= nHiddenTensorsPerLayer)
             {
-                tdim[0] = tdim[1] = hsize;
+                tdim[0] = hsize;
+                tdim[1] = rsize;
             }
             else
             {
                 tdim[0] = hsize;
-                tdim[1] = hsize * 2;
+                tdim[1] = rsize * 2;
             }
         }
         else // IS the input layer
         {
             if(paramID >= nHiddenTensorsPerLayer)
             {
-                tdim[0] = tdim[1] = hsize;
+                tdim[0] = hsize;
+                tdim[1] = rsize;
             }
             else
             {
@@ -261,13 +291,15 @@ std::vector<int> RNNDescriptor::pTensorLengthsCalculation(const TensorDescriptor
     {
         if(layer > 0) // NOT the input layer
         {
-            tdim[0] = tdim[1] = hsize;
+            tdim[0] = hsize;
+            tdim[1] = rsize;
         }
         else
         {
             if(paramID >= nHiddenTensorsPerLayer)
             {
-                tdim[0] = tdim[1] = hsize;
+                tdim[0] = hsize;
+                tdim[1] = rsize;
             }
             else
             {
@@ -332,14 +364,24 @@ RNNDescriptor::RNNDescriptor(int hsz,
                      "type must be 0 for disabled bias or 1 for enabled "
                      "bias.");
     }
-    if(dType != miopenFloat && dType != miopenHalf)
+    if(dType != miopenFloat && dType != miopenHalf && dType != miopenBFloat16)
     {
         MIOPEN_THROW(miopenStatusBadParm,
-                     "RNNDescriptor: Bad parameter(s). RNN datatype must be float or half.");
+                     "RNNDescriptor: Bad parameter(s). RNN datatype must be float, half or "
+                     "bfloat16.");
     }
     else
     {
-        typeSize = dType == miopenHalf ? 2 : 4;
+        typeSize = dType == miopenFloat ? 4 : 2;
+    }
+    // Only the fused gate kernels handle bfloat16, the activation kernels of vanilla RNNs and of
+    // the fundamental algorithm do not.
+    if(dType == miopenBFloat16 &&
+       !((rmode == miopenLSTM || rmode == miopenGRU) && amode == miopenRNNdefault))
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "RNNDescriptor: bfloat16 is only supported for LSTM and GRU with the default "
+                     "algorithm.");
     }
 
     hsize                       = hsz;
@@ -417,14 +459,30 @@ RNNDescriptor::RNNDescriptor(int hsz,
                      "type must be 0 for disabled bias or 1 for enabled "
                      "bias.");
     }
-    if(dType != miopenFloat && dType != miopenHalf)
+    if(dType != miopenFloat && dType != miopenHalf && dType != miopenBFloat16)
     {
         MIOPEN_THROW(miopenStatusBadParm,
-                     "RNNDescriptor: Bad parameter(s). RNN datatype must be float or half.");
+                     "RNNDescriptor: Bad parameter(s). RNN datatype must be float, half or "
+                     "bfloat16.");
     }
     else
     {
-        typeSize = dType == miopenHalf ? 2 : 4;
+        typeSize = dType == miopenFloat ? 4 : 2;
+    }
+    // Only the fused gate kernels handle bfloat16, the activation kernels of vanilla RNNs and of
+    // the fundamental algorithm do not.
+    if(dType == miopenBFloat16 &&
+       !((rmode == miopenLSTM || rmode == miopenGRU) && amode == miopenRNNdefault))
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "RNNDescriptor: bfloat16 is only supported for LSTM and GRU with the default "
+                     "algorithm.");
+    }
+    if(dType == miopenBFloat16 && dropDesc != nullptr &&
+       !float_equal(miopen::deref(dropDesc).dropout, 0))
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "RNNDescriptor: dropout is not supported for bfloat16 RNNs.");
     }
 
     switch(rmode)
@@ -445,7 +503,43 @@ RNNDescriptor::RNNDescriptor(int hsz,
     }
 }
 
-size_t RNNDescriptor::GetWorkspaceSize(Handle& /* handle */,
+void RNNDescriptor::SetProjectionSize(int proj_size)
+{
+    if(proj_size < 0 || static_cast<size_t>(proj_size) > hsize)
+    {
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "RNNDescriptor: Bad parameter(s). The projection size must be between 0 and "
+                     "the hidden size.");
+    }
+    if(proj_size != 0 &&
+       !(rnnMode == miopenLSTM && algoMode == miopenRNNdefault && inputMode == miopenRNNlinear))
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "RNNDescriptor: a projection is only supported for LSTM with the default "
+                     "algorithm and linear input.");
+    }
+    if(proj_size != 0 && dropoutDesc != nullptr &&
+       !float_equal(miopen::deref(dropoutDesc).dropout, 0))
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "RNNDescriptor: dropout is not supported for RNNs with a projection.");
+    }
+    projSize = proj_size;
+}
+
+void RNNDescriptor::SetReserveDataType(miopenDataType_t type)
+{
+    if(type != dataType &&
+       !(dataType == miopenFloat && (type == miopenHalf || type == miopenBFloat16)))
+    {
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "RNNDescriptor: the reserve space of an fp32 RNN may be fp32, fp16 or bf16, "
+                     "that of other RNNs must have their data type.");
+    }
+    reserveDataType = type;
+}
+
+size_t RNNDescriptor::GetWorkspaceSize(Handle& handle,
                                        const int seqLength,
                                        c_array_view<const miopenTensorDescriptor_t> xDesc) const
 {
@@ -461,7 +555,31 @@ size_t RNNDescriptor::GetWorkspaceSize(Handle& /* handle */,
             return x + deref(y).GetLengths()[0];
         });
     auto x = workspaceScale * nLayers * inputBatchLenSum * hsize * typeSize;
-    return size_t(dirMode == miopenRNNbidirection ? 2 * x : x);
+    if(projSize != 0)
+    {
+        // The inference runs in the workspace, which then holds the layout of the reserve
+        // space, and backward data adds the gradients of the projected states.
+        x += nLayers * inputBatchLenSum * (hsize + projSize) * typeSize;
+    }
+    x = dirMode == miopenRNNbidirection ? 2 * x : x;
+    if(IsReserveCompressed())
+    {
+        const auto layout = GetFullReserveLayout(seqLength, xDesc);
+        x = GetFullReserveOffset(handle, seqLength, xDesc) + layout.first + layout.second;
+    }
+    return size_t(x);
+}
+
+size_t RNNDescriptor::GetFullReserveOffset(Handle& handle,
+                                           const int seqLength,
+                                           c_array_view<const miopenTensorDescriptor_t> xDesc) const
+{
+    auto full            = *this;
+    full.reserveDataType = dataType;
+    // Sub-buffers of OpenCL need aligned origins.
+    const size_t alignment = 4096;
+    const auto size        = full.GetWorkspaceSize(handle, seqLength, xDesc);
+    return (size + alignment - 1) / alignment * alignment;
 }
 
 size_t RNNDescriptor::GetReserveSize(Handle& /* handle */,
@@ -473,6 +591,16 @@ size_t RNNDescriptor::GetReserveSize(Handle& /* handle */,
     {
         MIOPEN_THROW(miopenStatusBadParm, "Data type mismatch between descriptors");
     }
+    const auto layout = GetFullReserveLayout(seqLength, xDesc);
+    if(IsReserveCompressed())
+        return layout.first / typeSize * GetTypeSize(reserveDataType) + layout.second;
+    return layout.first + layout.second;
+}
+
+std::pair<size_t, size_t>
+RNNDescriptor::GetFullReserveLayout(const int seqLength,
+                                    c_array_view<const miopenTensorDescriptor_t> xDesc) const
+{
     std::size_t inputBatchLenSum = 0;
     inputBatchLenSum             = std::accumulate(
         xDesc.data, xDesc.data + seqLength, 0, [](size_t x, miopenTensorDescriptor_t y) {
@@ -484,12 +612,77 @@ size_t RNNDescriptor::GetReserveSize(Handle& /* handle */,
         x /= 2;
         x += nLayers * inputBatchLenSum * hsize * typeSize;
     }
+    if(projSize != 0)
+    {
+        x += nLayers * inputBatchLenSum * projSize * typeSize;
+    }
+    const std::size_t bi = dirMode == miopenRNNbidirection ? 2 : 1;
+    std::size_t masks    = 0;
     if(!float_equal(miopen::deref(dropoutDesc).dropout, 0))
     {
         x += (nLayers - 1) * inputBatchLenSum * hsize * typeSize;
-        x += (nLayers - 1) * inputBatchLenSum * hsize * sizeof(bool);
+        // one mask per layer in the format of the dropout descriptor
+        masks = (nLayers - 1) *
+                miopen::deref(dropoutDesc).GetReserveSpaceSize(bi * inputBatchLenSum * hsize);
+    }
+    return {bi * x, masks};
+}
+
+void RNNDescriptor::CompressReserve(const Handle& handle,
+                                    const int seqLength,
+                                    c_array_view<const miopenTensorDescriptor_t> xDesc,
+                                    ConstData_t fullReserve,
+                                    Data_t reserveSpace) const
+{
+    const auto layout      = GetFullReserveLayout(seqLength, xDesc);
+    const auto activations = layout.first / typeSize;
+    float alpha            = 1;
+    CastTensor(handle,
+               &alpha,
+               TensorDescriptor{dataType, {activations}},
+               fullReserve,
+               TensorDescriptor{reserveDataType, {activations}},
+               reserveSpace);
+    if(layout.second != 0)
+    {
+        // The masks are bytes, so the offsets are in bytes too.
+        const auto masks = TensorDescriptor{miopenInt8, {layout.second}};
+        CopyTensor(handle,
+                   masks,
+                   fullReserve,
+                   masks,
+                   reserveSpace,
+                   static_cast<int>(layout.first),
+                   static_cast<int>(activations * GetTypeSize(reserveDataType)));
+    }
+}
+
+void RNNDescriptor::DecompressReserve(const Handle& handle,
+                                      const int seqLength,
+                                      c_array_view<const miopenTensorDescriptor_t> xDesc,
+                                      ConstData_t reserveSpace,
+                                      Data_t fullReserve) const
+{
+    const auto layout      = GetFullReserveLayout(seqLength, xDesc);
+    const auto activations = layout.first / typeSize;
+    float alpha            = 1;
+    CastTensor(handle,
+               &alpha,
+               TensorDescriptor{reserveDataType, {activations}},
+               reserveSpace,
+               TensorDescriptor{dataType, {activations}},
+               fullReserve);
+    if(layout.second != 0)
+    {
+        const auto masks = TensorDescriptor{miopenInt8, {layout.second}};
+        CopyTensor(handle,
+                   masks,
+                   reserveSpace,
+                   masks,
+                   fullReserve,
+                   static_cast<int>(activations * GetTypeSize(reserveDataType)),
+                   static_cast<int>(layout.first));
     }
-    return size_t(dirMode == miopenRNNbidirection ? 2 * x : x);
 }
 
 size_t RNNDescriptor::GetParamsSize(Handle& /* handle */,
@@ -505,9 +698,10 @@ size_t RNNDescriptor::GetParamsSize(Handle& /* handle */,
     if(inputMode == miopenRNNskip)
         inputVectorLen = 0;
 
-    int bi  = dirMode == miopenRNNbidirection ? 2 : 1;
-    auto sz = nHiddenTensorsPerLayer * hsize * bi *
-              (inputVectorLen + hsize + (nLayers - 1) * (bi + 1) * hsize);
+    int bi     = dirMode == miopenRNNbidirection ? 2 : 1;
+    auto rsize = RecurrentSize();
+    auto sz    = nHiddenTensorsPerLayer * hsize * bi *
+                 (inputVectorLen + rsize + (nLayers - 1) * (bi + 1) * rsize);
 #if(MIO_RNN_DEBUG == 1)
     fprintf(stderr, "weight size: %lu\n", sz);
 #endif
@@ -515,6 +709,7 @@ size_t RNNDescriptor::GetParamsSize(Handle& /* handle */,
     {
         sz += nLayers * 2 * nHiddenTensorsPerLayer * hsize * bi;
     }
+    sz += nLayers * bi * projSize * hsize;
     return size_t(typeSize * sz);
 }
 
@@ -543,7 +738,7 @@ RNNDescriptor::GetRNNHiddenSuperTensorSize(Handle& /* handle */,
     {
         MIOPEN_THROW(miopenStatusBadParm, "Data type mismatch between descriptors");
     }
-    auto x = xDesc[0].GetLengths()[0] * hsize * nLayers * typeSize;
+    auto x = xDesc[0].GetLengths()[0] * RecurrentSize() * nLayers * typeSize;
     return size_t(dirMode == miopenRNNbidirection ? 2 * x : x);
 }
 
@@ -565,12 +760,17 @@ void RNNDescriptor::GetParamsDescriptor(Handle& /* handle */,
     // Create weight super tensor descriptor
     int bi = (dirMode == miopenRNNbidirection) ? 2 : 1;
     std::vector<int> weight_lens(2, 0);
-    weight_lens[0] = inputVectorLen + ((nLayers - 1) * (bi + 1) + 1) * hsize;
+    weight_lens[0] = inputVectorLen + ((nLayers - 1) * (bi + 1) + 1) * RecurrentSize();
     weight_lens[1] = bi * hsize * nHiddenTensorsPerLayer;
     if(biasMode == miopenRNNwithBias)
     {
         weight_lens[0] += (nLayers * 2);
     }
+    if(projSize != 0)
+    {
+        // Rows enough for the projection matrices, the last one padded.
+        weight_lens[0] += (nLayers * bi * projSize * hsize + weight_lens[1] - 1) / weight_lens[1];
+    }
 
     wDesc = miopen::TensorDescriptor(dtype, weight_lens.data(), 2);
 }
@@ -586,12 +786,18 @@ std::size_t RNNDescriptor::GetLayerParamSize(Handle& /*handle*/,
     }
     auto inputVectorLen = xDesc.GetLengths()[1]; // input vector size
     inputVectorLen      = (inputMode == miopenRNNskip) ? 0 : inputVectorLen;
+    auto rsize          = RecurrentSize();
+
+    if(projSize != 0 && paramID == 2 * nHiddenTensorsPerLayer)
+    {
+        return size_t(typeSize * projSize * hsize);
+    }
 
     // Assuming Djikstra counting
     if((((dirMode != 0u) && layer <= 1) || ((dirMode == 0u) && layer < 1)))
     {
         if(paramID >= nHiddenTensorsPerLayer)
-            return size_t(typeSize * hsize * hsize);
+            return size_t(typeSize * hsize * rsize);
         else if(isNotRNNskip())
             return size_t(typeSize * inputVectorLen * hsize);
         else
@@ -599,11 +805,11 @@ std::size_t RNNDescriptor::GetLayerParamSize(Handle& /*handle*/,
     }
     else if((dirMode != 0u) && paramID < nHiddenTensorsPerLayer)
     {
-        return size_t(typeSize * hsize * hsize * 2);
+        return size_t(typeSize * hsize * rsize * 2);
     }
     else
     {
-        return size_t(typeSize * hsize * hsize);
+        return size_t(typeSize * hsize * rsize);
     }
 }
 
@@ -868,6 +1074,124 @@ void RNNDescriptor::GetLayerBiasOffset(const int layer,
 #endif
 }
 
+RNNPreparedWeights::RNNPreparedWeights(Handle& handle,
+                                       const RNNDescriptor& rnn,
+                                       const TensorDescriptor& xDesc,
+                                       const TensorDescriptor& wDesc_,
+                                       ConstData_t w,
+                                       const bool quantize)
+    : rnnDesc(rnn), inputSize(xDesc.GetLengths()[1]), wDesc(wDesc_), quantized(quantize)
+{
+    if(w == nullptr)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Parameter tensor cannot be null.");
+    }
+
+    const auto params_size = rnn.GetParamsSize(handle, xDesc, wDesc.GetType());
+    if(wDesc.GetElementSpace() * rnn.typeSize < params_size)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Parameter tensor is smaller than the RNN parameters.");
+    }
+
+    if(rnn.projSize != 0)
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "Prepared weights are not supported for RNNs with a projection.");
+    }
+
+    if(quantize && wDesc.GetType() != miopenFloat)
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "Quantized RNN weights are only supported for float parameters.");
+    }
+
+    data = handle.Create(params_size);
+
+    const int bi         = rnn.dirMode == miopenRNNbidirection ? 2 : 1;
+    const int hy_h       = static_cast<int>(rnn.hsize);
+    const int in_h       = rnn.inputMode == miopenRNNskip ? 0 : inputSize;
+    const int wei_stride = hy_h * bi * static_cast<int>(rnn.nHiddenTensorsPerLayer);
+
+    if(quantize)
+    {
+        // The float copy serves the input GEMMs and the biases, the recurrent matrices are
+        // quantized symmetrically per row to int8.
+        const auto params_desc =
+            TensorDescriptor(wDesc.GetType(), {params_size / rnn.typeSize});
+        CopyTensor(handle, params_desc, w, params_desc, data.get());
+        std::vector<float> params(params_size / rnn.typeSize);
+        handle.ReadTo(params.data(), data, params_size);
+
+        std::vector<int8_t> wei_q(rnn.nLayers * wei_stride * hy_h);
+        std::vector<float> wei_scale(rnn.nLayers * wei_stride);
+        int offset = 0;
+        for(int li = 0; li < static_cast<int>(rnn.nLayers); li++)
+        {
+            offset += (li == 0 ? in_h : bi * hy_h) * wei_stride;
+            for(int j = 0; j < wei_stride; j++)
+            {
+                const auto row = params.begin() + offset + j * hy_h;
+                float max_abs  = 0;
+                std::for_each(row, row + hy_h, [&](float v) {
+                    max_abs = std::max(max_abs, std::fabs(v));
+                });
+                const float scale = max_abs > 0 ? max_abs / 127 : 1;
+                for(int k = 0; k < hy_h; k++)
+                {
+                    const auto q = std::round(row[k] / scale);
+                    wei_q[(li * wei_stride + j) * hy_h + k] =
+                        static_cast<int8_t>(std::min(std::max(q, -127.f), 127.f));
+                }
+                wei_scale[li * wei_stride + j] = scale;
+            }
+            offset += hy_h * wei_stride;
+        }
+        quantizedData = handle.Write(wei_q);
+        scales        = handle.Write(wei_scale);
+        return;
+    }
+
+    // The matrix of k columns at offset is transposed in place of the copy.
+    const auto transpose = [&](int k, int offset) {
+        const std::vector<int> lens{wei_stride, k};
+        const std::vector<int> src_strides{k, 1};
+        const std::vector<int> dst_strides{1, wei_stride};
+        const auto src_desc =
+            TensorDescriptor(wDesc.GetType(), lens.data(), src_strides.data(), 2);
+        const auto dst_desc =
+            TensorDescriptor(wDesc.GetType(), lens.data(), dst_strides.data(), 2);
+        CopyTensor(handle, src_desc, w, dst_desc, data.get(), offset, offset);
+    };
+
+    int offset = 0;
+    for(int li = 0; li < static_cast<int>(rnn.nLayers); li++)
+    {
+        const int in_k = li == 0 ? in_h : bi * hy_h;
+        if(in_k > 0)
+            transpose(in_k, offset);
+        offset += in_k * wei_stride;
+
+        transpose(hy_h, offset);
+        offset += hy_h * wei_stride;
+    }
+
+    const int bias_len = static_cast<int>(params_size / rnn.typeSize) - offset;
+    if(bias_len > 0)
+    {
+        const auto bias_desc = TensorDescriptor(wDesc.GetType(), {std::size_t(bias_len)});
+        CopyTensor(handle, bias_desc, w, bias_desc, data.get(), offset, offset);
+    }
+}
+
+bool RNNPreparedWeights::IsPreparedFor(const RNNDescriptor& rnn, int in_h) const
+{
+    return rnn.hsize == rnnDesc.hsize && rnn.nLayers == rnnDesc.nLayers &&
+           rnn.rnnMode == rnnDesc.rnnMode && rnn.dirMode == rnnDesc.dirMode &&
+           rnn.inputMode == rnnDesc.inputMode && rnn.biasMode == rnnDesc.biasMode &&
+           rnn.dataType == rnnDesc.dataType && rnn.projSize == rnnDesc.projSize &&
+           in_h == inputSize;
+}
+
 std::ostream& operator<<(std::ostream& stream, const RNNDescriptor& r)
 {
     stream << r.hsize << ", ";
@@ -880,6 +1204,13 @@ std::ostream& operator<<(std::ostream& stream, const RNNDescriptor& r)
     stream << r.inputMode << ", ";
     stream << r.biasMode << ", ";
     stream << r.dropoutDesc << ", ";
+    stream << r.projSize << ", ";
+    return stream;
+}
+
+std::ostream& operator<<(std::ostream& stream, const RNNPreparedWeights& w)
+{
+    stream << w.rnnDesc << w.inputSize << ", " << w.quantized << ", ";
     return stream;
 }
 
@@ -25,6 +25,7 @@
  *******************************************************************************/
 
 #include <miopen/rnn.hpp>
+#include <miopen/rnn_streaming.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/logger.hpp>
 #include <vector>
@@ -195,6 +196,37 @@ extern "C" miopenStatus_t miopenSetRNNDescriptor_V2(miopenRNNDescriptor_t rnnDes
     });
 }
 
+extern "C" miopenStatus_t miopenSetRNNProjectionSize(miopenRNNDescriptor_t rnnDesc,
+                                                     const int projSize)
+{
+    MIOPEN_LOG_FUNCTION(rnnDesc, projSize);
+    return miopen::try_([&] { miopen::deref(rnnDesc).SetProjectionSize(projSize); });
+}
+
+extern "C" miopenStatus_t miopenGetRNNProjectionSize(miopenRNNDescriptor_t rnnDesc, int* projSize)
+{
+    MIOPEN_LOG_FUNCTION(rnnDesc, projSize);
+    return miopen::try_(
+        [&] { miopen::deref(projSize) = static_cast<int>(miopen::deref(rnnDesc).projSize); });
+}
+
+extern "C" miopenStatus_t miopenSetRNNReserveSpaceDataType(miopenRNNDescriptor_t rnnDesc,
+                                                           miopenDataType_t dataType)
+{
+    MIOPEN_LOG_FUNCTION(rnnDesc, dataType);
+    return miopen::try_([&] { miopen::deref(rnnDesc).SetReserveDataType(dataType); });
+}
+
+extern "C" miopenStatus_t miopenGetRNNReserveSpaceDataType(miopenRNNDescriptor_t rnnDesc,
+                                                           miopenDataType_t* dataType)
+{
+    MIOPEN_LOG_FUNCTION(rnnDesc, dataType);
+    return miopen::try_([&] {
+        const auto& rnn         = miopen::deref(rnnDesc);
+        miopen::deref(dataType) = rnn.IsReserveCompressed() ? rnn.reserveDataType : rnn.dataType;
+    });
+}
+
 extern "C" miopenStatus_t miopenGetRNNWorkspaceSize(miopenHandle_t handle,
                                                     const miopenRNNDescriptor_t rnnDesc,
                                                     const int sequenceLen,
@@ -794,3 +826,193 @@ extern "C" miopenStatus_t miopenRNNForwardInference(miopenHandle_t handle,
                                                    workSpaceNumBytes);
     });
 }
+
+extern "C" miopenStatus_t
+miopenCreateRNNPreparedWeights(miopenHandle_t handle,
+                               miopenRNNDescriptor_t rnnDesc,
+                               miopenTensorDescriptor_t xDesc,
+                               miopenTensorDescriptor_t wDesc,
+                               const void* w,
+                               miopenRNNPreparedWeights_t* preparedWeights)
+{
+    MIOPEN_LOG_FUNCTION(handle, rnnDesc, xDesc, wDesc, w, preparedWeights);
+    return miopen::try_([&] {
+        miopen::deref(preparedWeights) = new miopen::RNNPreparedWeights(miopen::deref(handle),
+                                                                        miopen::deref(rnnDesc),
+                                                                        miopen::deref(xDesc),
+                                                                        miopen::deref(wDesc),
+                                                                        DataCast(w));
+    });
+}
+
+extern "C" miopenStatus_t
+miopenCreateRNNQuantizedWeights(miopenHandle_t handle,
+                                miopenRNNDescriptor_t rnnDesc,
+                                miopenTensorDescriptor_t xDesc,
+                                miopenTensorDescriptor_t wDesc,
+                                const void* w,
+                                miopenRNNPreparedWeights_t* preparedWeights)
+{
+    MIOPEN_LOG_FUNCTION(handle, rnnDesc, xDesc, wDesc, w, preparedWeights);
+    return miopen::try_([&] {
+        miopen::deref(preparedWeights) = new miopen::RNNPreparedWeights(miopen::deref(handle),
+                                                                        miopen::deref(rnnDesc),
+                                                                        miopen::deref(xDesc),
+                                                                        miopen::deref(wDesc),
+                                                                        DataCast(w),
+                                                                        true);
+    });
+}
+
+extern "C" miopenStatus_t
+miopenDestroyRNNPreparedWeights(miopenRNNPreparedWeights_t preparedWeights)
+{
+    MIOPEN_LOG_FUNCTION(preparedWeights);
+    return miopen::try_([&] { miopen_destroy_object(preparedWeights); });
+}
+
+extern "C" miopenStatus_t
+miopenRNNForwardInferencePrepared(miopenHandle_t handle,
+                                  miopenRNNDescriptor_t rnnDesc,
+                                  const int sequenceLen,
+                                  const miopenTensorDescriptor_t* xDesc,
+                                  const void* x,
+                                  const miopenTensorDescriptor_t hxDesc,
+                                  const void* hx,
+                                  const miopenTensorDescriptor_t cxDesc,
+                                  const void* cx,
+                                  const miopenRNNPreparedWeights_t preparedWeights,
+                                  const miopenTensorDescriptor_t* yDesc,
+                                  void* y,
+                                  const miopenTensorDescriptor_t hyDesc,
+                                  void* hy,
+                                  const miopenTensorDescriptor_t cyDesc,
+                                  void* cy,
+                                  void* workSpace,
+                                  size_t workSpaceNumBytes)
+{
+
+    MIOPEN_LOG_FUNCTION(handle,
+                        rnnDesc,
+                        sequenceLen,
+                        xDesc,
+                        x,
+                        hxDesc,
+                        hx,
+                        cxDesc,
+                        cx,
+                        preparedWeights,
+                        yDesc,
+                        y,
+                        hyDesc,
+                        hy,
+                        cyDesc,
+                        cy,
+                        workSpace,
+                        workSpaceNumBytes);
+    LogCmdRNN(xDesc, rnnDesc, sequenceLen, ForwardInference);
+    return miopen::try_([&] {
+        miopen::c_array_view<const miopenTensorDescriptor_t> xDescArray{xDesc, size_t(sequenceLen)};
+        miopen::c_array_view<const miopenTensorDescriptor_t> yDescArray{yDesc, size_t(sequenceLen)};
+        miopen::deref(rnnDesc).RNNForwardInference(miopen::deref(handle),
+                                                   sequenceLen,
+                                                   xDescArray,
+                                                   DataCast(x),
+                                                   miopen::deref(hxDesc),
+                                                   DataCast(hx),
+                                                   miopen::deref(cxDesc),
+                                                   DataCast(cx),
+                                                   miopen::deref(preparedWeights),
+                                                   yDescArray,
+                                                   DataCast(y),
+                                                   miopen::deref(hyDesc),
+                                                   DataCast(hy),
+                                                   miopen::deref(cyDesc),
+                                                   DataCast(cy),
+                                                   DataCast(workSpace),
+                                                   workSpaceNumBytes);
+    });
+}
+
+extern "C" miopenStatus_t
+miopenCreateRNNStreamingState(miopenHandle_t handle,
+                              miopenRNNDescriptor_t rnnDesc,
+                              miopenTensorDescriptor_t xDesc,
+                              miopenTensorDescriptor_t hxDesc,
+                              const int maxChunkLen,
+                              miopenRNNStreamingState_t* streamingState)
+{
+    MIOPEN_LOG_FUNCTION(handle, rnnDesc, xDesc, hxDesc, maxChunkLen, streamingState);
+    return miopen::try_([&] {
+        miopen::deref(streamingState) = new miopen::RNNStreamingState(miopen::deref(handle),
+                                                                      miopen::deref(rnnDesc),
+                                                                      miopen::deref(xDesc),
+                                                                      miopen::deref(hxDesc),
+                                                                      maxChunkLen);
+    });
+}
+
+extern "C" miopenStatus_t miopenDestroyRNNStreamingState(miopenRNNStreamingState_t streamingState)
+{
+    MIOPEN_LOG_FUNCTION(streamingState);
+    return miopen::try_([&] { miopen_destroy_object(streamingState); });
+}
+
+extern "C" miopenStatus_t miopenResetRNNStreamingState(miopenHandle_t handle,
+                                                       miopenRNNStreamingState_t streamingState,
+                                                       const void* hx,
+                                                       const void* cx)
+{
+    MIOPEN_LOG_FUNCTION(handle, streamingState, hx, cx);
+    return miopen::try_([&] {
+        miopen::deref(streamingState).Reset(miopen::deref(handle), DataCast(hx), DataCast(cx));
+    });
+}
+
+extern "C" miopenStatus_t
+miopenRNNForwardInferenceStreaming(miopenHandle_t handle,
+                                   miopenRNNStreamingState_t streamingState,
+                                   const int chunkLen,
+                                   const miopenTensorDescriptor_t* xDesc,
+                                   const void* x,
+                                   const miopenTensorDescriptor_t wDesc,
+                                   const void* w,
+                                   const miopenTensorDescriptor_t* yDesc,
+                                   void* y,
+                                   void* workSpace,
+                                   size_t workSpaceNumBytes)
+{
+    MIOPEN_LOG_FUNCTION(handle,
+                        streamingState,
+                        chunkLen,
+                        xDesc,
+                        x,
+                        wDesc,
+                        w,
+                        yDesc,
+                        y,
+                        workSpace,
+                        workSpaceNumBytes);
+    return miopen::try_([&] {
+        miopen::c_array_view<const miopenTensorDescriptor_t> xDescArray{xDesc, size_t(chunkLen)};
+        miopen::c_array_view<const miopenTensorDescriptor_t> yDescArray{yDesc, size_t(chunkLen)};
+        miopen::deref(streamingState)
+            .Forward(miopen::deref(handle),
+                     chunkLen,
+                     xDescArray,
+                     x,
+                     miopen::deref(wDesc),
+                     DataCast(w),
+                     yDescArray,
+                     y,
+                     DataCast(workSpace),
+                     workSpaceNumBytes);
+    });
+}
+
+extern "C" miopenStatus_t
+miopenSynchronizeRNNStreamingState(miopenRNNStreamingState_t streamingState)
+{
+    MIOPEN_LOG_FUNCTION(streamingState);
+    return miopen::try_([&] { miopen::deref(streamingState).Synchronize(); });
+}
@@ -0,0 +1,210 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/rnn_streaming.hpp>
+
+#include <miopen/errors.hpp>
+#include <miopen/tensor_ops.hpp>
+
+#include <ostream>
+
+namespace miopen {
+
+RNNStreamingState::RNNStreamingState(Handle& handle,
+                                     const RNNDescriptor& rnn,
+                                     const TensorDescriptor& xDesc,
+                                     const TensorDescriptor& hxDesc_,
+                                     int maxChunkLen_)
+    : rnnDesc(rnn),
+      hxDesc(hxDesc_),
+      maxChunkLen(maxChunkLen_),
+      xChunkSize(0),
+      yChunkSize(0),
+      upload(handle.CreateBackgroundHandle()),
+      download(handle.CreateBackgroundHandle())
+{
+    if(rnn.dirMode != miopenRNNunidirection)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Streaming RNN inference requires a unidirectional RNN.");
+    }
+    if(rnn.projSize != 0)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Streaming RNN inference does not support projections.");
+    }
+    if(maxChunkLen < 1)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "The maximum chunk length shall be positive.");
+    }
+    if(hxDesc.GetSize() != 3 || hxDesc.GetLengths()[0] != rnn.nLayers ||
+       hxDesc.GetLengths()[2] != rnn.hsize || xDesc.GetLengths()[0] != hxDesc.GetLengths()[1])
+    {
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "The hidden state descriptor does not match the RNN or the input batch.");
+    }
+
+    const auto batch = hxDesc.GetLengths()[1];
+    xChunkSize       = maxChunkLen * xDesc.GetElementSize() * GetTypeSize(xDesc.GetType());
+    yChunkSize       = maxChunkLen * batch * rnn.hsize * rnn.typeSize;
+
+    const auto state_size = hxDesc.GetElementSpace() * GetTypeSize(hxDesc.GetType());
+    for(std::size_t i = 0; i < 2; i++)
+    {
+        xStage[i] = handle.Create(xChunkSize);
+        yStage[i] = handle.Create(yChunkSize);
+        hState[i] = handle.Create(state_size);
+        if(rnn.rnnMode == miopenLSTM)
+            cState[i] = handle.Create(state_size);
+    }
+    Reset(handle, nullptr, nullptr);
+
+    // The buffers may come from a stream-ordered allocator of the stream of the handle.
+    const auto created = handle.RecordEvent();
+    upload.WaitFor(created);
+    download.WaitFor(created);
+}
+
+RNNStreamingState::~RNNStreamingState()
+{
+    // The staging buffers are freed after the copies using them.
+    try
+    {
+        Synchronize();
+    }
+    catch(...)
+    {
+    }
+}
+
+void RNNStreamingState::Reset(const Handle& handle, ConstData_t hx, ConstData_t cx)
+{
+    const float zero = 0;
+    const auto slot  = chunkCount % 2;
+
+    if(hx != nullptr)
+        CopyTensor(handle, hxDesc, hx, hxDesc, hState[slot].get());
+    else
+        SetTensor(handle, hxDesc, hState[slot].get(), &zero);
+
+    if(rnnDesc.rnnMode != miopenLSTM)
+        return;
+    if(cx != nullptr)
+        CopyTensor(handle, hxDesc, cx, hxDesc, cState[slot].get());
+    else
+        SetTensor(handle, hxDesc, cState[slot].get(), &zero);
+}
+
+void RNNStreamingState::Forward(Handle& handle,
+                                int chunkLen,
+                                c_array_view<const miopenTensorDescriptor_t> xDesc,
+                                const void* x,
+                                const TensorDescriptor& wDesc,
+                                ConstData_t w,
+                                c_array_view<const miopenTensorDescriptor_t> yDesc,
+                                void* y,
+                                Data_t workSpace,
+                                size_t workSpaceSize)
+{
+    if(x == nullptr || y == nullptr)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "The input and output of a chunk cannot be null.");
+    }
+    if(chunkLen < 1 || chunkLen > maxChunkLen)
+    {
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "The chunk length shall be between 1 and the maximum chunk length of the "
+                     "streaming state.");
+    }
+
+    const auto batch = hxDesc.GetLengths()[1];
+    std::size_t x_size = 0;
+    std::size_t y_size = 0;
+    for(int i = 0; i < chunkLen; i++)
+    {
+        if(xDesc[i].GetLengths()[0] != batch || yDesc[i].GetLengths()[0] != batch)
+        {
+            MIOPEN_THROW(miopenStatusBadParm,
+                         "Every time step of a chunk shall have the batch of the hidden state.");
+        }
+        x_size += xDesc[i].GetElementSize() * GetTypeSize(xDesc[i].GetType());
+        y_size += yDesc[i].GetElementSize() * GetTypeSize(yDesc[i].GetType());
+    }
+    if(x_size > xChunkSize || y_size > yChunkSize)
+    {
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "The chunk is larger than the streaming state was created for.");
+    }
+
+    const auto slot = chunkCount % 2;
+    const auto next = 1 - slot;
+    const auto lstm = rnnDesc.rnnMode == miopenLSTM;
+
+    // The staging buffers of this slot were last used by the chunk before the previous one, so
+    // the upload does not wait for the inference of the previous chunk.
+    upload.WaitFor(computed[slot]);
+    upload.WriteToAsync(x, xStage[slot].get(), x_size);
+    handle.WaitFor(upload.RecordEvent());
+    handle.WaitFor(downloaded[slot]);
+
+    rnnDesc.RNNForwardInference(handle,
+                                chunkLen,
+                                xDesc,
+                                xStage[slot].get(),
+                                hxDesc,
+                                hState[slot].get(),
+                                hxDesc,
+                                lstm ? cState[slot].get() : nullptr,
+                                wDesc,
+                                w,
+                                yDesc,
+                                yStage[slot].get(),
+                                hxDesc,
+                                hState[next].get(),
+                                hxDesc,
+                                lstm ? cState[next].get() : nullptr,
+                                workSpace,
+                                workSpaceSize);
+    computed[slot] = handle.RecordEvent();
+
+    download.WaitFor(computed[slot]);
+    download.ReadToAsync(y, yStage[slot].get(), y_size);
+    downloaded[slot] = download.RecordEvent();
+
+    ++chunkCount;
+}
+
+void RNNStreamingState::Synchronize() const
+{
+    upload.Finish();
+    download.Finish();
+}
+
+std::ostream& operator<<(std::ostream& stream, const RNNStreamingState& s)
+{
+    stream << s.rnnDesc << s.hxDesc << ", " << s.maxChunkLen << ", ";
+    return stream;
+}
+
+} // namespace miopen
@@ -0,0 +1,138 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/search_checkpoint.hpp>
+
+#include <miopen/db.hpp>
+#include <miopen/db_path.hpp>
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+
+#include <sstream>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_SEARCH_CHECKPOINT_INTERVAL)
+
+namespace miopen {
+namespace solver {
+
+namespace {
+
+std::string GetCheckpointPath() { return GetUserDbPath() + "/search_checkpoints.txt"; }
+
+} // namespace
+
+// total,next,best_time,best_index,failed indices separated by '.',best_config
+// The config goes last as it may contain commas. Db records reserve ';' and ':'.
+void SearchProgress::Serialize(std::ostream& stream) const
+{
+    stream << total << ',' << next << ',' << best_time << ',' << best_index << ',';
+    for(std::size_t i = 0; i < failed.size(); ++i)
+        stream << (i == 0 ? "" : ".") << failed[i];
+    stream << ',' << best_config;
+}
+
+bool SearchProgress::Deserialize(const std::string& str)
+{
+    std::istringstream ss{str};
+    auto field  = std::string{};
+    auto fields = std::vector<std::string>{};
+    for(auto i = 0; i < 5 && std::getline(ss, field, ','); ++i)
+        fields.push_back(field);
+    if(fields.size() != 5)
+        return false;
+
+    auto out = SearchProgress{};
+    if(!(std::istringstream{fields[0]} >> out.total) ||
+       !(std::istringstream{fields[1]} >> out.next) ||
+       !(std::istringstream{fields[2]} >> out.best_time) ||
+       !(std::istringstream{fields[3]} >> out.best_index))
+        return false;
+
+    std::istringstream failed_ss{fields[4]};
+    while(std::getline(failed_ss, field, '.'))
+    {
+        auto index = std::size_t{};
+        if(!(std::istringstream{field} >> index))
+            return false;
+        out.failed.push_back(index);
+    }
+
+    std::getline(ss, out.best_config);
+    *this = out;
+    return true;
+}
+
+SearchCheckpoint::SearchCheckpoint(const std::string& solver, const std::string& problem, int shard)
+    : key(solver + "_" + problem),
+      id(shard < 0 ? "progress" : "shard" + std::to_string(shard)),
+      interval(Value(MIOPEN_SEARCH_CHECKPOINT_INTERVAL{}, 0)),
+      last_save(std::chrono::steady_clock::now())
+{
+}
+
+boost::optional<SearchProgress> SearchCheckpoint::Load(std::size_t total) const
+{
+    if(!IsEnabled())
+        return boost::none;
+
+    auto db           = PlainTextDb{GetCheckpointPath()};
+    auto progress     = SearchProgress{};
+    const auto record = db.FindRecord(key);
+    if(!record || !record->GetValues(id, progress))
+        return boost::none;
+    if(progress.total != total || progress.next > total)
+    {
+        MIOPEN_LOG_W("Search checkpoint of another search space ignored: "
+                     << progress.total << " != " << total);
+        return boost::none;
+    }
+    return progress;
+}
+
+void SearchCheckpoint::Update(const SearchProgress& progress)
+{
+    if(!IsEnabled())
+        return;
+    const auto now = std::chrono::steady_clock::now();
+    if(now - last_save < interval)
+        return;
+    last_save = now;
+
+    auto db = PlainTextDb{GetCheckpointPath()};
+    if(!db.Update(key, id, progress))
+        MIOPEN_LOG_E("Unable to save the search checkpoint to " << GetCheckpointPath());
+}
+
+void SearchCheckpoint::Remove() const
+{
+    if(!IsEnabled())
+        return;
+    auto db = PlainTextDb{GetCheckpointPath()};
+    db.Remove(key, id);
+}
+
+} // namespace solver
+} // namespace miopen
@@ -0,0 +1,76 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/search_dump.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/md5.hpp>
+
+#include <boost/filesystem.hpp>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_SEARCH_DUMP_DIR)
+
+namespace miopen {
+namespace solver {
+
+SearchDump::SearchDump(const std::string& solver, const std::string& problem, int shard)
+{
+    const auto dir = GetStringEnv(MIOPEN_SEARCH_DUMP_DIR{});
+    if(dir == nullptr || *dir == '\0')
+        return;
+
+    auto error = boost::system::error_code{};
+    boost::filesystem::create_directories(dir, error);
+
+    auto name = solver + "_" + md5(problem);
+    if(shard >= 0)
+        name += ".shard" + std::to_string(shard);
+    const auto path = boost::filesystem::path{dir} / (name + ".csv");
+
+    file.open(path.string(), std::ios::out | std::ios::trunc);
+    if(!file)
+    {
+        MIOPEN_LOG_W("Unable to open the search dump file " << path.string());
+        return;
+    }
+    file << "# " << problem << '\n' << "index,config,time_ms,runs,failed,compile_ms\n";
+}
+
+void SearchDump::Add(std::size_t index,
+                     const std::string& config,
+                     float time_ms,
+                     std::size_t runs,
+                     bool failed,
+                     float compile_ms)
+{
+    if(!IsEnabled())
+        return;
+    file << index << ",\"" << config << "\"," << time_ms << ',' << runs << ','
+         << (failed ? 1 : 0) << ',' << compile_ms << '\n';
+}
+
+} // namespace solver
+} // namespace miopen
@@ -0,0 +1,182 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/search_shard.hpp>
+
+#include <miopen/db.hpp>
+#include <miopen/db_path.hpp>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+
+#include <chrono>
+#include <limits>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_SEARCH_SHARDS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_SEARCH_SHARD_INDEX)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_SEARCH_SHARD_SESSION)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_SEARCH_SHARD_TIMEOUT)
+
+namespace miopen {
+namespace solver {
+
+namespace {
+
+struct ShardResult
+{
+    float time = std::numeric_limits<float>::max();
+    std::string config; // Empty if the shard has failed.
+
+    void Serialize(std::ostream& stream) const { stream << time << ',' << config; }
+
+    bool Deserialize(const std::string& str)
+    {
+        const auto sep = str.find(',');
+        if(sep == std::string::npos)
+            return false;
+        std::istringstream ss{str.substr(0, sep)};
+        if(!(ss >> time))
+            return false;
+        config = str.substr(sep + 1);
+        return true;
+    }
+};
+
+std::string GetExchangePath()
+{
+    const auto session = GetStringEnv(MIOPEN_SEARCH_SHARD_SESSION{});
+    return GetUserDbPath() + "/search_shards." + (session != nullptr ? session : "default") +
+           ".txt";
+}
+
+std::string GetKey(const std::string& problem, const std::string& solver)
+{
+    return solver + "_" + problem;
+}
+
+std::string GetId(std::size_t index) { return "shard" + std::to_string(index); }
+
+} // namespace
+
+SearchShard::SearchShard(std::size_t index_, std::size_t count_) : index(index_), count(count_)
+{
+    if(count == 0 || index >= count)
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "Invalid search shard: " + std::to_string(index) + " of " +
+                         std::to_string(count));
+}
+
+SearchShard SearchShard::FromEnv()
+{
+    const auto count = Value(MIOPEN_SEARCH_SHARDS{}, 1);
+    if(count <= 1)
+        return {};
+    return {Value(MIOPEN_SEARCH_SHARD_INDEX{}), count};
+}
+
+void SearchShard::Reset(const std::string& problem, const std::string& solver) const
+{
+    if(!IsEnabled())
+        return;
+    auto db = PlainTextDb{GetExchangePath()};
+    db.Remove(GetKey(problem, solver), GetId(index));
+}
+
+boost::optional<std::string> SearchShard::Merge(const std::string& problem,
+                                                const std::string& solver,
+                                                const boost::optional<std::string>& local_best,
+                                                float local_time) const
+{
+    if(!IsEnabled())
+        return local_best;
+
+    const auto key = GetKey(problem, solver);
+    auto db        = PlainTextDb{GetExchangePath()};
+
+    auto own = ShardResult{};
+    if(local_best)
+    {
+        own.time   = local_time;
+        own.config = *local_best;
+    }
+    if(!db.Update(key, GetId(index), own))
+    {
+        MIOPEN_LOG_E("Search shard " << index << ": unable to publish results to "
+                                     << GetExchangePath());
+        return local_best;
+    }
+
+    const auto timeout = std::chrono::seconds{Value(MIOPEN_SEARCH_SHARD_TIMEOUT{}, 3600)};
+    const auto start   = std::chrono::steady_clock::now();
+    auto results       = std::vector<boost::optional<ShardResult>>(count);
+
+    while(true)
+    {
+        const auto record = db.FindRecord(key);
+        auto reported     = std::size_t{0};
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            auto result = ShardResult{};
+            if(record && record->GetValues(GetId(i), result))
+                results[i] = result;
+            if(results[i])
+                ++reported;
+        }
+
+        if(reported == count)
+            break;
+        if(std::chrono::steady_clock::now() - start > timeout)
+        {
+            MIOPEN_LOG_W("Search shard " << index << ": only " << reported << " of " << count
+                                         << " shards have reported for " << solver
+                                         << ", merging partial results.");
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::seconds{1});
+    }
+
+    auto best = boost::optional<ShardResult>{};
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        if(!results[i] || results[i]->config.empty())
+            continue;
+        MIOPEN_LOG_I("Search shard " << i << ": " << results[i]->time << ' '
+                                     << results[i]->config);
+        // Strict comparison together with the fixed order makes all shards agree.
+        if(!best || results[i]->time < best->time)
+            best = results[i];
+    }
+
+    if(!best)
+        return boost::none;
+    return best->config;
+}
+
+} // namespace solver
+} // namespace miopen
@@ -201,3 +201,30 @@ extern "C" miopenStatus_t miopenSoftmaxBackward_V2(miopenHandle_t handle,
                                 0);
     });
 }
+
+extern "C" miopenStatus_t miopenSoftmaxCrossEntropy(miopenHandle_t handle,
+                                                    const miopenTensorDescriptor_t xDesc,
+                                                    const void* x,
+                                                    const void* labels,
+                                                    const miopenTensorDescriptor_t lossDesc,
+                                                    void* loss,
+                                                    const miopenTensorDescriptor_t dxDesc,
+                                                    void* dx)
+{
+    MIOPEN_LOG_FUNCTION(handle, xDesc, x, labels, lossDesc, loss, dxDesc, dx);
+    if(miopen::deref(xDesc).GetType() == miopenBFloat16 ||
+       miopen::deref(lossDesc).GetType() == miopenBFloat16)
+    {
+        return miopenStatusNotImplemented;
+    }
+    return miopen::try_([&] {
+        miopen::SoftmaxCrossEntropy(miopen::deref(handle),
+                                    miopen::deref(xDesc),
+                                    DataCast(x),
+                                    DataCast(labels),
+                                    miopen::deref(lossDesc),
+                                    DataCast(loss),
+                                    dx == nullptr ? miopen::deref(xDesc) : miopen::deref(dxDesc),
+                                    DataCast(dx));
+    });
+}
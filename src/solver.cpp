@@ -29,13 +29,14 @@
 
 #include <miopen/db.hpp>
 #include <miopen/solver_id.hpp>
-#include <miopen/par_for.hpp>
+#include <miopen/compile_service.hpp>
 #include <miopen/stringutils.hpp>
 #include <miopen/any_solver.hpp>
 #include <miopen/timer.hpp>
 
 #include <boost/range/adaptor/transformed.hpp>
 #include <ostream>
+#include <set>
 
 namespace miopen {
 namespace solver {
@@ -58,22 +59,42 @@ std::vector<Program> PrecompileKernels(const Handle& h, const std::vector<Kernel
     CompileTimer ct;
     std::vector<Program> programs(kernels.size());
 
-    // clang-format off
-    par_for(kernels.size(),
-            max_threads{Value(MIOPEN_COMPILE_PARALLEL_LEVEL{}, 20)},
-            [&](auto i) {
-                const KernelInfo& k = kernels[i];
-                programs[i]         = h.LoadProgram(k.kernel_file, k.comp_options, false, "");
-            });
-    // clang-format on
+    CompileService::Get().ParallelFor(
+        kernels.size(), Value(MIOPEN_COMPILE_PARALLEL_LEVEL{}, 20), [&](auto i) {
+            const KernelInfo& k = kernels[i];
+            programs[i]         = h.LoadProgram(k.kernel_file, k.comp_options, false, "");
+        });
     ct.Log("PrecompileKernels");
     return programs;
 }
 
-void PrecompileSolutions(const Handle& h, const std::vector<ConvSolution>& sols)
+std::vector<boost::optional<Program>> TryPrecompileKernels(const Handle& h,
+                                                          const std::vector<KernelInfo>& kernels)
+{
+    CompileTimer ct;
+    std::vector<boost::optional<Program>> programs(kernels.size());
+
+    CompileService::Get().ParallelFor(
+        kernels.size(), Value(MIOPEN_COMPILE_PARALLEL_LEVEL{}, 20), [&](auto i) {
+            const KernelInfo& k = kernels[i];
+            try
+            {
+                programs[i] = h.LoadProgram(k.kernel_file, k.comp_options, false, "");
+            }
+            catch(...)
+            {
+                // Left empty here. The error is reported when the kernel is built again.
+            }
+        });
+    ct.Log("TryPrecompileKernels");
+    return programs;
+}
+
+std::vector<KernelInfo> GetUncompiledKernels(const Handle& h,
+                                             const std::vector<ConvSolution>& sols)
 {
-    // Find all kernels that need to be compiled from the solutions
     std::vector<KernelInfo> kernels;
+    std::set<std::pair<std::string, std::string>> seen;
     for(auto&& sol : sols)
     {
         if(!sol.Succeeded())
@@ -82,9 +103,18 @@ void PrecompileSolutions(const Handle& h, const std::vector<ConvSolution>& sols)
         {
             if(h.HasProgram(kernel.kernel_file, kernel.comp_options))
                 continue;
+            if(!seen.emplace(kernel.kernel_file, kernel.comp_options).second)
+                continue;
             kernels.push_back(kernel);
         }
     }
+    return kernels;
+}
+
+void PrecompileSolutions(const Handle& h, const std::vector<ConvSolution>& sols)
+{
+    // Find all kernels that need to be compiled from the solutions
+    const auto kernels = GetUncompiledKernels(h, sols);
 
     // Precompile the kernels in parallel, but dont add them to the cache
     std::vector<Program> programs = PrecompileKernels(h, kernels);
@@ -162,6 +192,26 @@ std::string Id::GetAlgo(conv::Direction dir) const
     return ConvolutionAlgoToDirectionalString(it->second, dir);
 }
 
+miopenConvAlgorithm_t Id::GetAlgorithm() const
+{
+    const auto it = IdRegistry().value_to_algo.find(value);
+    if(it == IdRegistry().value_to_algo.end())
+        MIOPEN_THROW(miopenStatusInternalError);
+    return it->second;
+}
+
+std::vector<Id> GetAllIds()
+{
+    std::vector<Id> ids;
+    ids.reserve(IdRegistry().value_to_str.size());
+    for(const auto& pair : IdRegistry().value_to_str)
+        ids.emplace_back(pair.first);
+    std::sort(ids.begin(), ids.end(), [](const Id& lhs, const Id& rhs) {
+        return lhs.Value() < rhs.Value();
+    });
+    return ids;
+}
+
 inline bool Register(IdRegistryData& registry,
                      uint64_t value,
                      const std::string& str,
@@ -340,6 +390,34 @@ inline SolverRegistrar::SolverRegistrar(IdRegistryData& registry)
         registry, ++id, ConvMPBidirectWinograd<5, 3>{}, miopenConvolutionAlgoWinograd);
     RegisterWithSolver(
         registry, ++id, ConvMPBidirectWinograd<6, 3>{}, miopenConvolutionAlgoWinograd);
+
+    RegisterWithSolver(registry, ++id, ConvDirectNaiveConvFwd{}, miopenConvolutionAlgoDirect);
+    RegisterWithSolver(registry, ++id, ConvDirectNaiveConvBwd{}, miopenConvolutionAlgoDirect);
+    RegisterWithSolver(registry, ++id, ConvDirectNaiveConvWrw{}, miopenConvolutionAlgoDirect);
+
+    RegisterWithSolver(registry, ++id, ConvDirectDepthwiseFwd{}, miopenConvolutionAlgoDirect);
+    RegisterWithSolver(registry, ++id, ConvDirectDepthwiseBwd{}, miopenConvolutionAlgoDirect);
+    RegisterWithSolver(registry, ++id, ConvDirectDepthwiseWrw{}, miopenConvolutionAlgoDirect);
+
+    RegisterWithSolver(registry,
+                       ++id,
+                       ConvHipImplicitGemmForwardV4R4XdlopsDynamic{},
+                       miopenConvolutionAlgoImplicitGEMM);
+    RegisterWithSolver(registry,
+                       ++id,
+                       ConvHipImplicitGemmBwdDataV4R1XdlopsDynamic{},
+                       miopenConvolutionAlgoImplicitGEMM);
+
+    RegisterWithSolver(registry, ++id, ConvDirectTransposePhaseBwd{}, miopenConvolutionAlgoDirect);
+
+    RegisterWithSolver(
+        registry, ++id, ConvBinWinogradRxSf3x2Dilated{}, miopenConvolutionAlgoWinograd);
+    RegisterWithSolver(registry, ++id, ConvBinWinogradRxSDilated{}, miopenConvolutionAlgoWinograd);
+
+    RegisterWithSolver(registry,
+                       ++id,
+                       ConvHipImplicitGemmWrwV4R4XdlopsDynamic{},
+                       miopenConvolutionAlgoImplicitGEMM);
 }
 
 } // namespace solver
@@ -36,6 +36,7 @@
 
 #if(MIOPEN_BACKEND_HIP && MIOPEN_USE_ROCBLAS)
 #include <miopen/conv/data_invoke_params.hpp>
+#include <miopen/transformed_weights.hpp>
 #define WORKAROUND_SWDEV_203031 1 // See also issues #2075, #2067
 #endif
 
@@ -48,6 +49,7 @@ MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_AMD_WINOGRAD_MPASS_F5X3)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_AMD_WINOGRAD_MPASS_F6X3)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_AMD_WINOGRAD_MPASS_WORKSPACE_MAX)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_CONV_PRECISE_ROCBLAS_TIMING)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_CONV_WINOGRAD_CACHE_WEIGHTS)
 
 // Introduces a number of shader-specific aliases (names) in the current scope at zero cost.
 // These names represent shader parameters, e.g. shader C is batch_size etc and useful for
@@ -384,6 +386,13 @@ ConvSolution ConvMPBidirectWinograd<WinoDataH, WinoFilterH, WinoDataW, WinoFilte
         lda,ldb,ldc,batch_count,strideA,strideB,
         strideC,alpha,beta,params.in_data_type};
 
+    // The transformed filters are the first GEMM operand, which may as well be kept out of the
+    // workspace and reused while the weights buffer stays the same.
+    const bool cache_weights = miopen::IsEnabled(MIOPEN_CONV_WINOGRAD_CACHE_WEIGHTS{});
+    const auto cache_key =
+        cache_weights ? SolverDbId(*this) + "/" + params.conv_problem.BuildConfKey().ToString()
+                      : std::string{};
+
     result.invoker_factory = [=](std::vector<Kernel> kernels) {
         return [=](const Handle& handle, const AnyInvokeParams& ctx) {
             decltype(auto) data_ctx = ctx.CastTo<conv::DataInvokeParams>();
@@ -391,15 +400,36 @@ ConvSolution ConvMPBidirectWinograd<WinoDataH, WinoFilterH, WinoDataW, WinoFilte
             Data_t workSpace = data_ctx.workSpace;
             float total_time    = 0;
 
+            Data_t wino_wei_addr        = workSpace;
+            size_t wino_wei_addr_offset = wino_wei_offset;
+            bool transform_weights      = true;
+            // Held until the GEMM is enqueued, the cache may replace the filters meanwhile.
+            TransformedWeightsCache::Filters cached_wei = nullptr;
+            if(cache_weights)
+            {
+                cached_wei = handle.GetTransformedWeightsCache().Find(cache_key, tensors.w);
+                transform_weights = cached_wei == nullptr;
+                if(transform_weights)
+                    cached_wei = handle.Create(wino_wei.buff_info.total_byte_size);
+                wino_wei_addr        = cached_wei.get();
+                wino_wei_addr_offset = 0;
+            }
+
             for(int i = 0, cur=0; i < 4; i++)
             {
                 std::string kernel_name ;
+                if(i == 1 && !transform_weights)
+                {
+                    ++cur;
+                    continue;
+                }
                 if(i == 2) // GEMM
                 {
                         CallGemmStridedBatched(handle,
                             wino_gemm_desc,
-                            workSpace,
-                            static_cast<int>(wino_wei_offset / GetTypeSize(params.in_data_type)),
+                            wino_wei_addr,
+                            static_cast<int>(wino_wei_addr_offset /
+                                GetTypeSize(params.in_data_type)),
                             workSpace,
                             static_cast<int>(wino_in_offset / GetTypeSize(params.in_data_type)),
                             workSpace,
@@ -438,8 +468,8 @@ ConvSolution ConvMPBidirectWinograd<WinoDataH, WinoFilterH, WinoDataW, WinoFilte
                         o_buf                = &(wino_wei.buff_info);
                         const_buff_in_adr    = tensors.w;
                         buff_in_addr_offset = 0;
-                        buff_out_addr         = workSpace;
-                        buff_out_addr_offset = wino_wei_offset;
+                        buff_out_addr         = wino_wei_addr;
+                        buff_out_addr_offset = wino_wei_addr_offset;
                         const_input          = true;
                     }
                     else if (i==3)
@@ -504,6 +534,11 @@ ConvSolution ConvMPBidirectWinograd<WinoDataH, WinoFilterH, WinoDataW, WinoFilte
                            d_buf->byte_stride.g,
                            unused,
                            o_buf->byte_stride.g);
+                    // Published once the transform is enqueued, the other users of the handle
+                    // follow it.
+                    if(i == 1 && cache_weights)
+                        handle.GetTransformedWeightsCache().Insert(
+                            cache_key, tensors.w, cached_wei);
                 }
                 if(handle.IsProfilingEnabled())
                 {
@@ -42,6 +42,7 @@
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_DIRECT_ASM_1X1U_PERF_VALS)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_DIRECT_ASM_1X1U_SEARCH_OPTIMIZED)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_DIRECT_ASM_1X1U)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_DIRECT_ASM_1X1U_BALANCE_WAVES)
 
 namespace miopen {
 namespace solver {
@@ -253,6 +254,79 @@ bool PerformanceConfigConvAsm1x1U::IsValidValue() const
         && IsTwoPower<1,8>(waves_k_in_group); // clang-format on
 }
 
+int PerformanceConfigConvAsm1x1U::GetVgprCount(const ConvolutionContext& config) const
+{
+    const auto elements_in_dword = 4 / GetTypeSize(config.in_data_type);
+    const auto in_gprs =
+        (chunks_per_wave * n_mult * c_mult + elements_in_dword - 1) / elements_in_dword;
+    const auto acc_gprs = chunks_per_wave * n_mult * k_mult;
+    const auto img_hw   = config.out_height * config.out_width;
+    // TODO last vgpr only for old card.
+    // ADD if(option.machine_version_major == 9)
+    // vgprs  = 4 + 2 * in_gprs + acc_gprs + (img_hw % elements_in_dword != 0 ? 1: 0);
+    // else
+    return static_cast<int>(4 + 2 * in_gprs + acc_gprs +
+                            (img_hw % elements_in_dword != 0 ? 1 : 0) + 1);
+}
+
+double PerformanceConfigConvAsm1x1U::GetWaveFill(const ConvolutionContext& config) const
+{
+    const auto waves_in_group = waves_c_in_group * waves_k_in_group;
+    const auto groups =
+        divide_round_plus_inf(AsmImgHeight(config) * AsmImgWidth(config),
+                              chunks_per_wave * chunk_size) *
+        divide_round_plus_inf(config.n_outputs, k_mult * waves_k_in_group) *
+        divide_round_plus_inf(config.batch_sz, n_mult * GetNPerGpr());
+    // GCN runs up to 10 waves per SIMD, the VGPRs may allow fewer.
+    const auto waves_per_CU  = std::min(256 / GetVgprCount(config), 10) * 4;
+    const auto groups_per_CU = std::max(waves_per_CU / waves_in_group, 1);
+    const auto slots =
+        static_cast<std::size_t>(groups_per_CU) * config.GetStream().GetMaxComputeUnits();
+    const auto waves = (groups + slots - 1) / slots;
+    return static_cast<double>(groups) / static_cast<double>(waves * slots);
+}
+
+void PerformanceConfigConvAsm1x1U::BalanceWaves(const ConvolutionContext& config)
+{
+    // Only worth it when the last wave of workgroups leaves much of the GPU idle.
+    const auto fill = GetWaveFill(config);
+    if(fill >= 0.75)
+        return;
+
+    // Smaller tiles in K and N give more workgroups, at the cost of reading the input and the
+    // filters more often. Take the largest tiles which fill the GPU evenly enough, or else the
+    // best filling ones.
+    auto best      = *this;
+    auto best_fill = fill;
+    for(const auto k : {k_mult, k_mult / 2, k_mult / 4})
+    {
+        for(const auto n : {n_mult, 1})
+        {
+            auto candidate   = *this;
+            candidate.k_mult = k;
+            candidate.n_mult = n;
+            if(k < 1 || !candidate.IsValidValue() || !candidate.IsValid(config))
+                continue;
+            const auto candidate_fill = candidate.GetWaveFill(config);
+            if(candidate_fill > best_fill + 0.1 || (best_fill < 0.9 && candidate_fill >= 0.9))
+            {
+                best      = candidate;
+                best_fill = candidate_fill;
+            }
+            if(best_fill >= 0.9)
+                break;
+        }
+        if(best_fill >= 0.9)
+            break;
+    }
+
+    if(!(best == *this))
+    {
+        MIOPEN_LOG_I("Wave fill " << fill << " -> " << best_fill << ": " << best.ToString());
+        *this = best;
+    }
+}
+
 bool PerformanceConfigConvAsm1x1U::IsValid(const ConvolutionContext& config) const
 {
     const auto elements_in_dword = 4 / GetTypeSize(config.in_data_type);
@@ -273,15 +347,8 @@ bool PerformanceConfigConvAsm1x1U::IsValid(const ConvolutionContext& config) con
         return false;
     if(chunks_per_wave % elements_in_dword != 0)
         return false;
-    const auto in_gprs =
-        (chunks_per_wave * n_mult * c_mult + elements_in_dword - 1) / elements_in_dword;
-    const auto acc_gprs = chunks_per_wave * n_mult * k_mult;
-    const auto img_hw   = config.out_height * config.out_width;
-    // TODO last vgpr only for old card.
-    // ADD if(option.machine_version_major == 9)
-    // vgprs  = 4 + 2 * in_gprs + acc_gprs + (img_hw % elements_in_dword != 0 ? 1: 0);
-    // else
-    const auto vgprs = 4 + 2 * in_gprs + acc_gprs + (img_hw % elements_in_dword != 0 ? 1 : 0) + 1;
+    const auto img_hw = config.out_height * config.out_width;
+    const auto vgprs  = GetVgprCount(config);
     if(!(vgprs < 256))
         return false;
     const auto max_waves_per_CU = (256 / vgprs) * 4;
@@ -348,6 +415,10 @@ void PerformanceConfigConvAsm1x1U::EuristicInit(const ConvolutionContext& config
         MIOPEN_LOG_E("All attempts failed");
         assert(false);
     }
+    else if(!miopen::IsDisabled(MIOPEN_DEBUG_CONV_DIRECT_ASM_1X1U_BALANCE_WAVES{}))
+    {
+        BalanceWaves(config);
+    }
     MIOPEN_LOG_I(ToString());
 }
 
@@ -385,7 +456,7 @@ bool ConvAsm1x1U::IsApplicable(const ConvolutionContext& params) const
         return false;
     if(!params.rmv.IsV2orV3())
         return false;
-    if(!(params.IsFp32() || params.IsFp16()))
+    if(!(params.IsFp32() || params.IsFp16() || params.IsBfp16()))
         return false;
 
     const std::string name = params.GetStream().GetDeviceName();
@@ -393,6 +464,8 @@ bool ConvAsm1x1U::IsApplicable(const ConvolutionContext& params) const
     {
         return false;
     }
+    if(params.IsBfp16() && name.find("gfx9") == std::string::npos)
+        return false;
     assert(params.weights_layout.length() == 0); // _weights_layout is not supported yet
     const auto elements_in_dword = 4 / GetTypeSize(params.in_data_type);
     // clang-format off
@@ -495,7 +568,7 @@ ConvSolution ConvAsm1x1U::GetSolution(const ConvolutionContext& params,
 
         const auto subsample_kernel_compilation_options =
             std::string(" -DDATA_TYPE=") +
-            (params.in_data_type == miopenHalf ? "ushort" : "float") +
+            (GetTypeSize(params.in_data_type) == 2 ? "ushort" : "float") +
             std::string(" -DMLO_GRP0_SZ0=") + std::to_string(n_grp0_size0) +
             std::string(" -DMLO_GRP0_SZ1=1 ") + std::string(" -DMLO_GRP0_SZ2=1 ") +
             std::string(" -DMLO_FILTER0_STRIDE0=") + std::to_string(params.kernel_stride_w) +
@@ -554,7 +627,9 @@ ConvSolution ConvAsm1x1U::GetSolution(const ConvolutionContext& params,
     GenerateClangDefsym(options, "vec_c_filter", 1);
 
     GenerateClangDefsym(options, "acc_type", 1);
-    GenerateClangDefsym(options, "buf_type", (data_len == 2 ? 2 : 1));
+    GenerateClangDefsym(options, "buf_type", (params.IsBfp16() ? 3 : data_len == 2 ? 2 : 1));
+    if(params.IsBfp16())
+        GenerateClangDefsym(options, "MIOPEN_USE_RNE_BFLOAT16", MIOPEN_USE_RNE_BFLOAT16);
     enum class MemLayout : int
     {
         NCHW = 0,
@@ -98,10 +98,10 @@ ConvBiasActivAsm1x1U::Search(const ConvolutionContext& context,
 #endif
 
     auto& handle        = cba_context.GetStream();
-    const auto bias_buf = handle.Create(cba_context.bias_sz);
-    const auto in_buf   = handle.Create(cba_context.bot_sz);
-    const auto wei_buf  = handle.Create(cba_context.weights_sz);
-    const auto out_buf  = handle.Create(cba_context.top_sz);
+    const auto bias_buf = handle.Create(cba_context.bias_sz, miopenAllocationScratch);
+    const auto in_buf   = handle.Create(cba_context.bot_sz, miopenAllocationScratch);
+    const auto wei_buf  = handle.Create(cba_context.weights_sz, miopenAllocationScratch);
+    const auto out_buf  = handle.Create(cba_context.top_sz, miopenAllocationScratch);
 
     auto tensors    = FusedConvDataTensors{};
     tensors.in      = in_buf.get();
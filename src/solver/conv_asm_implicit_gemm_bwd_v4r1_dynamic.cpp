@@ -138,7 +138,7 @@ bool ConvAsmImplicitGemmV4R1DynamicBwd::IsApplicable(const ConvolutionContext& c
     if(!ctx.Is2d())
         return false;
 
-    if(!ctx.IsFp32())
+    if(!conv::IsImplGemmDynamicDataTypeSupported(ctx.conv_problem))
         return false;
 
     if(!ctx.rmv.IsV3())
@@ -153,6 +153,11 @@ bool ConvAsmImplicitGemmV4R1DynamicBwd::IsApplicable(const ConvolutionContext& c
     return FindImplicitGemmDynamicKernelBwd(ctx, kernel_name, block_size, grid_size);
 }
 
+size_t ConvAsmImplicitGemmV4R1DynamicBwd::GetWorkspaceSize(const ConvolutionContext& ctx) const
+{
+    return conv::GetImplGemmDynamicFp32WorkspaceSize(ctx.conv_problem);
+}
+
 ConvSolution ConvAsmImplicitGemmV4R1DynamicBwd::GetSolution(const ConvolutionContext& ctx) const
 {
     ConvSolution result;
@@ -186,6 +191,7 @@ ConvSolution ConvAsmImplicitGemmV4R1DynamicBwd::GetSolution(const ConvolutionCon
 
     kernel.comp_options = options.str();
 
+    result.workspce_sz     = GetWorkspaceSize(ctx);
     result.invoker_factory = conv::MakeImplGemmDynamicBackwardDataInvokerFactory(ctx);
     result.construction_params.push_back(kernel);
     return result;
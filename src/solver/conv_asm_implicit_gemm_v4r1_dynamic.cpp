@@ -282,7 +282,7 @@ bool ConvAsmImplicitGemmV4R1DynamicFwd::IsApplicable(const ConvolutionContext& c
     if(!ctx.Is2d())
         return false;
 
-    if(!ctx.IsFp32())
+    if(!conv::IsImplGemmDynamicDataTypeSupported(ctx.conv_problem))
         return false;
 
     if(!ctx.rmv.IsV3())
@@ -308,7 +308,7 @@ bool ConvAsmImplicitGemmV4R1DynamicFwd_1x1::IsApplicable(const ConvolutionContex
     if(!ctx.Is2d())
         return false;
 
-    if(!ctx.IsFp32())
+    if(!conv::IsImplGemmDynamicDataTypeSupported(ctx.conv_problem))
         return false;
 
     if(!ctx.rmv.IsV3())
@@ -325,6 +325,16 @@ bool ConvAsmImplicitGemmV4R1DynamicFwd_1x1::IsApplicable(const ConvolutionContex
         tunables.begin(), tunables.end(), [&](auto tunable) { return tunable.IsValid(ctx); });
 }
 
+size_t ConvAsmImplicitGemmV4R1DynamicFwd::GetWorkspaceSize(const ConvolutionContext& ctx) const
+{
+    return conv::GetImplGemmDynamicFp32WorkspaceSize(ctx.conv_problem);
+}
+
+size_t ConvAsmImplicitGemmV4R1DynamicFwd_1x1::GetWorkspaceSize(const ConvolutionContext& ctx) const
+{
+    return conv::GetImplGemmDynamicFp32WorkspaceSize(ctx.conv_problem);
+}
+
 static inline ConvSolution GetSolutionBase(const ConvolutionContext& ctx,
                                            const TunableImplicitGemmV4R1Dynamic& config,
                                            const AsmImplicitGemmKernelV4R1Fwd_t& kernel_type)
@@ -361,6 +371,7 @@ static inline ConvSolution GetSolutionBase(const ConvolutionContext& ctx,
 
     MIOPEN_LOG_I2(kernel.kernel_file + ":" + kernel.kernel_name);
 
+    result.workspce_sz = conv::GetImplGemmDynamicFp32WorkspaceSize(ctx.conv_problem);
     if(kernel_is_1x1)
         result.invoker_factory = conv::MakeImplGemmDynamicForward1x1InvokerFactory(ctx);
     else
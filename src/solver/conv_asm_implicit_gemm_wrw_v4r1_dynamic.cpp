@@ -28,6 +28,7 @@
 #include "miopen/solver.hpp"
 #include "miopen/handle.hpp"
 #include <miopen/generic_search.hpp>
+#include <miopen/conv/invokers/impl_gemm_dynamic.hpp>
 #include <miopen/conv/wrw_invoke_params.hpp>
 #include "implicitgemm_util.hpp"
 #include <miopen/gcn_asm_utils.hpp>
@@ -252,7 +253,7 @@ size_t ConvAsmImplicitGemmV4R1DynamicWrw::GetWorkspaceSize(const ConvolutionCont
     int c            = ctx.n_outputs;
     int y            = ctx.kernel_size_h;
     int x            = ctx.kernel_size_w;
-    int ele_size     = 0;
+    int ele_size     = sizeof(float); // The reduction is always of fp32 partial results.
     int gemmk_groups = 0;
     int extra_groups = 0;
     int GemmKPerBlock;
@@ -263,18 +264,14 @@ size_t ConvAsmImplicitGemmV4R1DynamicWrw::GetWorkspaceSize(const ConvolutionCont
     else
         GemmKPerBlock = 4;
 
-    if(ctx.IsFp32())
-        ele_size = sizeof(float);
-    else
-        ele_size = 2;
-
     gemmk_groups = GetImplicitGemmWrwV4R1DynamicGemmkGroups(ctx.conv_problem, GemmKPerBlock);
 
     if(gemmk_groups == 0)
         extra_groups = 0;
     else
         extra_groups = 1 << gemmk_groups;
-    return k * c * y * x * ele_size * extra_groups;
+    return conv::GetImplGemmDynamicFp32WorkspaceSize(ctx.conv_problem) +
+           k * c * y * x * ele_size * extra_groups;
 }
 
 bool ConvAsmImplicitGemmV4R1DynamicWrw::IsApplicable(const ConvolutionContext& ctx) const
@@ -289,7 +286,7 @@ bool ConvAsmImplicitGemmV4R1DynamicWrw::IsApplicable(const ConvolutionContext& c
     if(!ctx.Is2d())
         return false;
 
-    if(!ctx.IsFp32())
+    if(!conv::IsImplGemmDynamicDataTypeSupported(ctx.conv_problem))
         return false;
 
     if(!ctx.rmv.IsV3())
@@ -395,9 +392,20 @@ ConvSolution ConvAsmImplicitGemmV4R1DynamicWrw::GetSolution(const ConvolutionCon
                            kernels.end(),
                            std::back_inserter(ks),
                            [&](const Kernel& k_wrw) { return handle.Run(k_wrw); });
-            float elapsed = 0;
-            elapsed       = CallImplicitGemmWrwDynamic(
-                handle, conv_problem, tensors.x, tensors.dy, tensors.dw, workSpace, ks);
+            const auto elapsed = conv::RunImplGemmDynamicOnFp32(
+                handle,
+                tensors.xDesc,
+                tensors.x,
+                tensors.dyDesc,
+                tensors.dy,
+                tensors.dwDesc,
+                tensors.dw,
+                workSpace,
+                data_ctx.workSpaceSize,
+                [&](ConstData_t x, ConstData_t dy, Data_t dw, Data_t reduction_workspace) {
+                    return CallImplicitGemmWrwDynamic(
+                        handle, conv_problem, x, dy, dw, reduction_workspace, ks);
+                });
             if(handle.IsProfilingEnabled())
             {
                 handle.ResetKernelTime();
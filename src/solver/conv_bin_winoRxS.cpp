@@ -506,6 +506,10 @@ bool ConvBinWinogradRxSFused::IsApplicable(const ConvolutionContext&) const
 
 ConvSolution ConvBinWinogradRxSFused::GetSolution(const ConvolutionContext& params) const
 {
+    // The fp16 kernels (v21) are only built with code object v3 metadata.
+    if(params.IsFp16() && !params.rmv.UseV3())
+        return ConvSolution{miopenStatusNotImplemented};
+
     ConvSolution result;
     KernelInfo kernel;
 
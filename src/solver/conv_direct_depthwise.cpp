@@ -0,0 +1,223 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/solver.hpp>
+
+#include <miopen/conv/data_invoke_params.hpp>
+#include <miopen/conv/wrw_invoke_params.hpp>
+#include <miopen/env.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/kernel_build_params.hpp>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_DIRECT_DEPTHWISE)
+
+namespace miopen {
+namespace solver {
+
+namespace {
+
+constexpr int depthwise_tile_h     = 2;
+constexpr int depthwise_tile_w     = 4;
+constexpr std::size_t local_size   = 64;
+constexpr std::size_t wrw_local_sz = 256;
+
+/// Geometry in forward naming: x is N x C x Hi x Wi, y is N x (C * mult) x Ho x Wo.
+struct DepthwiseGeometry
+{
+    int n, c, hi, wi, k, ho, wo, filter, stride, pad_h, pad_w;
+
+    int GetMultiplier() const { return k / c; }
+};
+
+DepthwiseGeometry GetDepthwiseGeometry(const ConvolutionContext& params)
+{
+    const auto& problem = params.conv_problem;
+    // conv_problem keeps the tensor being read as "in", so e.g. for backward data "in" is dy.
+    const bool is_fwd = problem.GetDirection() == conv::Direction::Forward;
+    const auto& x     = is_fwd ? problem.GetIn() : problem.GetOut();
+    const auto& y     = is_fwd ? problem.GetOut() : problem.GetIn();
+
+    int n, c, hi, wi, k, ho, wo;
+    std::tie(n, c, hi, wi) = tien<4>(x.GetLengths());
+    std::tie(std::ignore, k, ho, wo) = tien<4>(y.GetLengths());
+
+    return {n,
+            c,
+            hi,
+            wi,
+            k,
+            ho,
+            wo,
+            static_cast<int>(problem.GetWeightsHeight()),
+            problem.GetKernelStrideH(),
+            problem.GetPadH(),
+            problem.GetPadW()};
+}
+
+bool IsDepthwiseApplicable(const ConvolutionContext& params)
+{
+    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_DIRECT_DEPTHWISE{}))
+        return false;
+    if(!params.use_opencl_convolutions)
+        return false;
+    if(!params.Is2d() || !params.IsLayoutDefault())
+        return false;
+    if(!(params.IsFp32() || params.IsFp16() || params.IsBfp16()))
+        return false;
+
+    const auto& problem = params.conv_problem;
+    if(!problem.GetIn().IsPacked() || !problem.GetWeights().IsPacked() ||
+       !problem.GetOut().IsPacked())
+        return false;
+    if(params.IsAsymmetricPadH() || params.IsAsymmetricPadW())
+        return false;
+
+    const auto geometry = GetDepthwiseGeometry(params);
+    if(problem.GetGroupCount() != geometry.c)
+        return false;
+    if(geometry.k % geometry.c != 0)
+        return false;
+    if(geometry.GetMultiplier() != 1 && geometry.GetMultiplier() != 2)
+        return false;
+
+    const auto filter_h = problem.GetWeightsHeight();
+    const auto filter_w = problem.GetWeightsWidth();
+    if(filter_h != filter_w || (filter_h != 3 && filter_h != 5))
+        return false;
+    if(problem.GetKernelStrideH() != problem.GetKernelStrideW() ||
+       (problem.GetKernelStrideH() != 1 && problem.GetKernelStrideH() != 2))
+        return false;
+    return problem.GetDilationH() == 1 && problem.GetDilationW() == 1;
+}
+
+ConvSolution GetDepthwiseSolution(const ConvolutionContext& params,
+                                  const std::string& kernel_name)
+{
+    const auto direction = params.conv_problem.GetDirection();
+    const auto geometry  = GetDepthwiseGeometry(params);
+
+    const auto build_params = KernelBuildParameters{
+        {"DW_N", geometry.n},
+        {"DW_C", geometry.c},
+        {"DW_HI", geometry.hi},
+        {"DW_WI", geometry.wi},
+        {"DW_MULT", geometry.GetMultiplier()},
+        {"DW_HO", geometry.ho},
+        {"DW_WO", geometry.wo},
+        {"DW_FILTER", geometry.filter},
+        {"DW_STRIDE", geometry.stride},
+        {"DW_PAD_H", geometry.pad_h},
+        {"DW_PAD_W", geometry.pad_w},
+        {"DW_TILE_H", depthwise_tile_h},
+        {"DW_TILE_W", depthwise_tile_w},
+    };
+
+    KernelInfo kernel;
+    kernel.kernel_file  = "MIOpenConvDirDepthwise.cl";
+    kernel.kernel_name  = kernel_name;
+    kernel.comp_options = build_params.GenerateFor(kbp::OpenCL{}) + params.general_compile_options;
+
+    if(direction == conv::Direction::BackwardWeights)
+    {
+        // One work-group per output channel.
+        kernel.l_wk = {wrw_local_sz, 1, 1};
+        kernel.g_wk = {wrw_local_sz, static_cast<std::size_t>(geometry.k), 1};
+    }
+    else
+    {
+        // Forward tiles y, backward data tiles dx.
+        const bool is_fwd  = direction == conv::Direction::Forward;
+        const int tiled_h  = is_fwd ? geometry.ho : geometry.hi;
+        const int tiled_w  = is_fwd ? geometry.wo : geometry.wi;
+        const int channels = is_fwd ? geometry.k : geometry.c;
+        const auto tiles   = static_cast<std::size_t>(
+            ((tiled_h + depthwise_tile_h - 1) / depthwise_tile_h) *
+            ((tiled_w + depthwise_tile_w - 1) / depthwise_tile_w));
+        kernel.l_wk = {local_size, 1, 1};
+        kernel.g_wk = {((tiles + local_size - 1) / local_size) * local_size,
+                       static_cast<std::size_t>(geometry.n * channels),
+                       1};
+    }
+
+    ConvSolution result;
+    result.construction_params.push_back(kernel);
+
+    result.invoker_factory = [=](const std::vector<Kernel>& kernels) {
+        const auto k = kernels.front();
+        return [=](const Handle& handle, const AnyInvokeParams& primitive_parameters) {
+            if(direction == conv::Direction::BackwardWeights)
+            {
+                const auto& tensors = primitive_parameters.CastTo<conv::WrWInvokeParams>().tensors;
+                handle.Run(k)(tensors.x, tensors.dw, tensors.dy);
+            }
+            else
+            {
+                const auto& tensors = primitive_parameters.CastTo<conv::DataInvokeParams>().tensors;
+                // For backward data, tensors.in is dy and tensors.out is dx.
+                if(direction == conv::Direction::Forward)
+                    handle.Run(k)(tensors.in, tensors.w, tensors.out);
+                else
+                    handle.Run(k)(tensors.out, tensors.w, tensors.in);
+            }
+        };
+    };
+    return result;
+}
+
+} // namespace
+
+bool ConvDirectDepthwiseFwd::IsApplicable(const ConvolutionContext& params) const
+{
+    return params.direction.IsForward() && IsDepthwiseApplicable(params);
+}
+
+ConvSolution ConvDirectDepthwiseFwd::GetSolution(const ConvolutionContext& params) const
+{
+    return GetDepthwiseSolution(params, "MIOpenConvDepthwiseFwd");
+}
+
+bool ConvDirectDepthwiseBwd::IsApplicable(const ConvolutionContext& params) const
+{
+    return params.direction.IsBackwardData() && IsDepthwiseApplicable(params);
+}
+
+ConvSolution ConvDirectDepthwiseBwd::GetSolution(const ConvolutionContext& params) const
+{
+    return GetDepthwiseSolution(params, "MIOpenConvDepthwiseBwd");
+}
+
+bool ConvDirectDepthwiseWrw::IsApplicable(const ConvolutionContext& params) const
+{
+    return params.direction.IsBackwardWrW() && IsDepthwiseApplicable(params);
+}
+
+ConvSolution ConvDirectDepthwiseWrw::GetSolution(const ConvolutionContext& params) const
+{
+    return GetDepthwiseSolution(params, "MIOpenConvDepthwiseWrw");
+}
+
+} // namespace solver
+} // namespace miopen
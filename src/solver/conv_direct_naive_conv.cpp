@@ -0,0 +1,209 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/solver.hpp>
+
+#include <miopen/conv/data_invoke_params.hpp>
+#include <miopen/conv/wrw_invoke_params.hpp>
+#include <miopen/env.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/op_kernel_args.hpp>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_DIRECT_NAIVE_CONV)
+/// By default the naive solvers only apply to non-default layouts, where no other
+/// solver does. This makes them available for any layout (mostly for verification).
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_DIRECT_NAIVE_CONV_FORCE)
+
+namespace miopen {
+namespace solver {
+
+static bool IsNaiveConvApplicable(const ConvolutionContext& params)
+{
+    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_DIRECT_NAIVE_CONV{}))
+        return false;
+    if(params.IsLayoutDefault() && !miopen::IsEnabled(MIOPEN_DEBUG_CONV_DIRECT_NAIVE_CONV_FORCE{}))
+        return false;
+    if(!params.use_opencl_convolutions)
+        return false;
+    if(!params.Is2d() && !params.Is3d())
+        return false;
+    if(params.IsAsymmetricPadH() || params.IsAsymmetricPadW())
+        return false;
+    return params.IsFp32() || params.IsFp16() || params.IsBfp16();
+}
+
+/// Appends strides of a tensor in N,C,D,H,W order. For 2D problems the depth stride is unused.
+static void AppendNaiveStrides(std::vector<OpKernelArg>& args,
+                               int spatial_dims,
+                               const TensorDescriptor& desc)
+{
+    const std::vector<int> strides(desc.GetStrides().begin(), desc.GetStrides().end());
+    int s0, s1, s2, s3, s4;
+    std::tie(s0, s1, s2, s3, s4) = GetNCDHW(spatial_dims, strides);
+    args.emplace_back(s0);
+    args.emplace_back(s1);
+    args.emplace_back(s2);
+    args.emplace_back(s3);
+    args.emplace_back(s4);
+}
+
+static ConvSolution GetNaiveConvSolution(const ConvolutionContext& params,
+                                         const std::string& kernel_name,
+                                         std::size_t work_items)
+{
+    const auto& problem    = params.conv_problem;
+    const auto direction   = problem.GetDirection();
+    const int spatial_dims = problem.GetSpatialDims();
+
+    // conv_problem keeps the tensor being read as "in", so e.g. for backward data "in" is dy.
+    // The kernels use forward naming in all directions.
+    const bool is_fwd    = direction == conv::Direction::Forward;
+    const auto& in_lens  = (is_fwd ? problem.GetIn() : problem.GetOut()).GetLengths();
+    const auto& out_lens = (is_fwd ? problem.GetOut() : problem.GetIn()).GetLengths();
+    const auto& wei_lens = problem.GetWeights().GetLengths();
+
+    std::vector<int> geometry;
+    // clang-format off
+    geometry.push_back(GetN5(spatial_dims, in_lens));
+    geometry.push_back(GetC5(spatial_dims, in_lens));
+    geometry.push_back(GetD5(spatial_dims, in_lens));
+    geometry.push_back(GetH5(spatial_dims, in_lens));
+    geometry.push_back(GetW5(spatial_dims, in_lens));
+    geometry.push_back(GetC5(spatial_dims, out_lens));
+    geometry.push_back(GetD5(spatial_dims, out_lens));
+    geometry.push_back(GetH5(spatial_dims, out_lens));
+    geometry.push_back(GetW5(spatial_dims, out_lens));
+    geometry.push_back(GetD5(spatial_dims, wei_lens));
+    geometry.push_back(GetH5(spatial_dims, wei_lens));
+    geometry.push_back(GetW5(spatial_dims, wei_lens));
+    geometry.push_back(problem.GetGroupCount());
+    geometry.push_back(problem.GetPadD());
+    geometry.push_back(problem.GetPadH());
+    geometry.push_back(problem.GetPadW());
+    geometry.push_back(problem.GetKernelStrideD());
+    geometry.push_back(problem.GetKernelStrideH());
+    geometry.push_back(problem.GetKernelStrideW());
+    geometry.push_back(problem.GetDilationD());
+    geometry.push_back(problem.GetDilationH());
+    geometry.push_back(problem.GetDilationW());
+    // clang-format on
+
+    const std::size_t local_size = 256;
+
+    KernelInfo kernel;
+    kernel.kernel_file  = "MIOpenConvDirNaive.cl";
+    kernel.kernel_name  = kernel_name;
+    kernel.comp_options = params.general_compile_options;
+    kernel.l_wk.push_back(local_size);
+    kernel.l_wk.push_back(1);
+    kernel.l_wk.push_back(1);
+    kernel.g_wk.push_back(((work_items + local_size - 1) / local_size) * local_size);
+    kernel.g_wk.push_back(1);
+    kernel.g_wk.push_back(1);
+
+    ConvSolution result;
+    result.construction_params.push_back(kernel);
+
+    // Tensor strides are taken from the invoke parameters, so that the invoker works for
+    // any strides of the layout this network config describes.
+    result.invoker_factory = [=](const std::vector<Kernel>& kernels) {
+        const auto k = kernels.front();
+        return [=](const Handle& handle, const AnyInvokeParams& primitive_parameters) {
+            std::vector<OpKernelArg> args;
+            const TensorDescriptor* in_desc  = nullptr;
+            const TensorDescriptor* wei_desc = nullptr;
+            const TensorDescriptor* out_desc = nullptr;
+
+            if(direction == conv::Direction::BackwardWeights)
+            {
+                const auto& tensors = primitive_parameters.CastTo<conv::WrWInvokeParams>().tensors;
+                args.emplace_back(tensors.x);
+                args.emplace_back(tensors.dw);
+                args.emplace_back(tensors.dy);
+                in_desc  = &tensors.xDesc;
+                wei_desc = &tensors.dwDesc;
+                out_desc = &tensors.dyDesc;
+            }
+            else
+            {
+                const auto& tensors = primitive_parameters.CastTo<conv::DataInvokeParams>().tensors;
+                // For backward data, tensors.in is dy and tensors.out is dx.
+                args.emplace_back(is_fwd ? tensors.in : tensors.out);
+                args.emplace_back(tensors.w);
+                args.emplace_back(is_fwd ? tensors.out : tensors.in);
+                in_desc  = is_fwd ? &tensors.inDesc : &tensors.outDesc;
+                wei_desc = &tensors.wDesc;
+                out_desc = is_fwd ? &tensors.outDesc : &tensors.inDesc;
+            }
+
+            for(const auto value : geometry)
+                args.emplace_back(value);
+            AppendNaiveStrides(args, spatial_dims, *in_desc);
+            AppendNaiveStrides(args, spatial_dims, *wei_desc);
+            AppendNaiveStrides(args, spatial_dims, *out_desc);
+
+            handle.Run(k)(args);
+        };
+    };
+    return result;
+}
+
+bool ConvDirectNaiveConvFwd::IsApplicable(const ConvolutionContext& params) const
+{
+    return params.direction.IsForward() && IsNaiveConvApplicable(params);
+}
+
+ConvSolution ConvDirectNaiveConvFwd::GetSolution(const ConvolutionContext& params) const
+{
+    const auto& out = params.conv_problem.GetOut();
+    return GetNaiveConvSolution(params, "MIOpenConvNaiveFwd", out.GetElementSize());
+}
+
+bool ConvDirectNaiveConvBwd::IsApplicable(const ConvolutionContext& params) const
+{
+    return params.direction.IsBackwardData() && IsNaiveConvApplicable(params);
+}
+
+ConvSolution ConvDirectNaiveConvBwd::GetSolution(const ConvolutionContext& params) const
+{
+    // dx is conv_problem's "out".
+    const auto& dx = params.conv_problem.GetOut();
+    return GetNaiveConvSolution(params, "MIOpenConvNaiveBwd", dx.GetElementSize());
+}
+
+bool ConvDirectNaiveConvWrw::IsApplicable(const ConvolutionContext& params) const
+{
+    return params.direction.IsBackwardWrW() && IsNaiveConvApplicable(params);
+}
+
+ConvSolution ConvDirectNaiveConvWrw::GetSolution(const ConvolutionContext& params) const
+{
+    const auto& dw = params.conv_problem.GetWeights();
+    return GetNaiveConvSolution(params, "MIOpenConvNaiveWrw", dw.GetElementSize());
+}
+
+} // namespace solver
+} // namespace miopen
@@ -0,0 +1,174 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/solver.hpp>
+
+#include <miopen/conv/data_invoke_params.hpp>
+#include <miopen/env.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/kernel_build_params.hpp>
+#include <miopen/numeric.hpp>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_DIRECT_TRANSPOSE_PHASE)
+
+namespace miopen {
+namespace solver {
+
+namespace {
+
+constexpr int phase_tile_w       = 4;
+constexpr std::size_t local_size = 64;
+
+/// Geometry in forward naming: dx is N x C x Hi x Wi, dy is N x K x Ho x Wo.
+struct PhaseGeometry
+{
+    int n, c, hi, wi, k, ho, wo, y, x;
+    int stride_h, stride_w, dilation_h, dilation_w, pad_h, pad_w, groups;
+
+    /// Taps of one phase are this far apart.
+    int GetStepH() const { return stride_h / gcd(stride_h, dilation_h); }
+    int GetStepW() const { return stride_w / gcd(stride_w, dilation_w); }
+
+    /// dx channels of one work-item, the largest of 4, 2 and 1 that divides C / groups.
+    int GetTileC() const
+    {
+        const auto c_per_group = c / groups;
+        return c_per_group % 4 == 0 ? 4 : c_per_group % 2 == 0 ? 2 : 1;
+    }
+};
+
+PhaseGeometry GetPhaseGeometry(const ConvolutionContext& params)
+{
+    const auto& problem = params.conv_problem;
+    // For backward data conv_problem keeps dy as "in" and dx as "out".
+    int n, c, hi, wi, k, ho, wo;
+    std::tie(n, c, hi, wi) = tien<4>(problem.GetOut().GetLengths());
+    std::tie(std::ignore, k, ho, wo) = tien<4>(problem.GetIn().GetLengths());
+
+    return {n,
+            c,
+            hi,
+            wi,
+            k,
+            ho,
+            wo,
+            static_cast<int>(problem.GetWeightsHeight()),
+            static_cast<int>(problem.GetWeightsWidth()),
+            problem.GetKernelStrideH(),
+            problem.GetKernelStrideW(),
+            problem.GetDilationH(),
+            problem.GetDilationW(),
+            problem.GetPadH(),
+            problem.GetPadW(),
+            problem.GetGroupCount()};
+}
+
+} // namespace
+
+bool ConvDirectTransposePhaseBwd::IsApplicable(const ConvolutionContext& params) const
+{
+    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_DIRECT_TRANSPOSE_PHASE{}))
+        return false;
+    if(!params.use_opencl_convolutions)
+        return false;
+    if(!params.direction.IsBackwardData())
+        return false;
+    if(!params.Is2d() || !params.IsLayoutDefault())
+        return false;
+    if(!(params.IsFp32() || params.IsFp16() || params.IsBfp16()))
+        return false;
+
+    const auto& problem = params.conv_problem;
+    if(!problem.GetIn().IsPacked() || !problem.GetWeights().IsPacked() ||
+       !problem.GetOut().IsPacked())
+        return false;
+    if(params.IsAsymmetricPadH() || params.IsAsymmetricPadW())
+        return false;
+
+    // Without a stride there are no inserted zeros to skip and the general kernels do as well.
+    return problem.GetKernelStrideH() > 1 || problem.GetKernelStrideW() > 1;
+}
+
+ConvSolution ConvDirectTransposePhaseBwd::GetSolution(const ConvolutionContext& params) const
+{
+    const auto geometry = GetPhaseGeometry(params);
+    const auto tile_c   = geometry.GetTileC();
+
+    const auto build_params = KernelBuildParameters{
+        {"TP_N", geometry.n},
+        {"TP_C", geometry.c},
+        {"TP_HI", geometry.hi},
+        {"TP_WI", geometry.wi},
+        {"TP_K", geometry.k},
+        {"TP_HO", geometry.ho},
+        {"TP_WO", geometry.wo},
+        {"TP_Y", geometry.y},
+        {"TP_X", geometry.x},
+        {"TP_STRIDE_H", geometry.stride_h},
+        {"TP_STRIDE_W", geometry.stride_w},
+        {"TP_DILATION_H", geometry.dilation_h},
+        {"TP_DILATION_W", geometry.dilation_w},
+        {"TP_PAD_H", geometry.pad_h},
+        {"TP_PAD_W", geometry.pad_w},
+        {"TP_GROUPS", geometry.groups},
+        {"TP_TILE_C", tile_c},
+        {"TP_TILE_W", phase_tile_w},
+        {"TP_STEP_H", geometry.GetStepH()},
+        {"TP_STEP_W", geometry.GetStepW()},
+    };
+
+    KernelInfo kernel;
+    kernel.kernel_file  = "MIOpenConvDirTransposePhase.cl";
+    kernel.kernel_name  = "MIOpenConvTransposePhaseBwd";
+    kernel.comp_options = build_params.GenerateFor(kbp::OpenCL{}) + params.general_compile_options;
+
+    // Each of the stride_h * stride_w phases is covered by the tiles of the largest phase.
+    const auto phase_h     = (geometry.hi + geometry.stride_h - 1) / geometry.stride_h;
+    const auto phase_w     = (geometry.wi + geometry.stride_w - 1) / geometry.stride_w;
+    const auto phase_tiles = static_cast<std::size_t>(
+        phase_h * ((phase_w + phase_tile_w - 1) / phase_tile_w) * geometry.stride_h *
+        geometry.stride_w);
+    kernel.l_wk = {local_size, 1, 1};
+    kernel.g_wk = {((phase_tiles + local_size - 1) / local_size) * local_size,
+                   static_cast<std::size_t>(geometry.n * (geometry.c / tile_c)),
+                   1};
+
+    ConvSolution result;
+    result.construction_params.push_back(kernel);
+
+    result.invoker_factory = [](const std::vector<Kernel>& kernels) {
+        const auto k = kernels.front();
+        return [=](const Handle& handle, const AnyInvokeParams& primitive_parameters) {
+            const auto& tensors = primitive_parameters.CastTo<conv::DataInvokeParams>().tensors;
+            // tensors.in is dy and tensors.out is dx.
+            handle.Run(k)(tensors.out, tensors.w, tensors.in);
+        };
+    };
+    return result;
+}
+
+} // namespace solver
+} // namespace miopen
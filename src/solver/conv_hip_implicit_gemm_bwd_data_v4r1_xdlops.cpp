@@ -82,11 +82,12 @@ PerformanceImplicitGemmBwdDataV4R1Xdlops::CalculateGemmABlockCopyPerformancePara
         // calculate vector length on gemmk dimension
         SrcDataPerRead_GemmM = gcd(SrcDataPerRead_GemmM, GemmMPerBlock);
 
+        const auto z = ctx.Is3d() ? ConvolutionContextInterpreter::GetFilterDepthZ(ctx) : 1;
         const auto y = ConvolutionContextInterpreter::GetFilterHeightY(ctx);
         const auto x = ConvolutionContextInterpreter::GetFilterWidthX(ctx);
 
         // \todo too conservative
-        if(!(y == 1 && x == 1))
+        if(!(z == 1 && y == 1 && x == 1))
             SrcDataPerRead_GemmM = 1;
 
         // calculate threadwise copy size
@@ -177,15 +178,17 @@ PerformanceImplicitGemmBwdDataV4R1Xdlops::CalculateGemmBBlockCopyPerformancePara
         SrcDataPerRead_GemmN = gcd(SrcDataPerRead_GemmN, GemmNPerBlock);
 
         // calculate vector length on gemmn dimension
+        const auto z = ctx.Is3d() ? ConvolutionContextInterpreter::GetFilterDepthZ(ctx) : 1;
         const auto y = ConvolutionContextInterpreter::GetFilterHeightY(ctx);
         const auto x = ConvolutionContextInterpreter::GetFilterWidthX(ctx);
 
         // \todo too conversative
-        if(y == 1 && x == 1)
+        if(z == 1 && y == 1 && x == 1)
         {
-            const auto ho        = ConvolutionContextInterpreter::GetOutputHeightHo(ctx);
-            const auto wo        = ConvolutionContextInterpreter::GetOutputWidthWo(ctx);
-            SrcDataPerRead_GemmN = gcd(SrcDataPerRead_GemmN, ho * wo);
+            const auto do_ = ctx.Is3d() ? ConvolutionContextInterpreter::GetOutputDepthDo(ctx) : 1;
+            const auto ho  = ConvolutionContextInterpreter::GetOutputHeightHo(ctx);
+            const auto wo  = ConvolutionContextInterpreter::GetOutputWidthWo(ctx);
+            SrcDataPerRead_GemmN = gcd(SrcDataPerRead_GemmN, do_ * ho * wo);
         }
         else
         {
@@ -719,6 +722,18 @@ int ConvHipImplicitGemmBwdDataV4R1Xdlops::CalculateNumberOfGemm(const Convolutio
     const auto ytilda = conv_stride_h / gcd_stride_dilation_h;
     const auto xtilda = conv_stride_w / gcd_stride_dilation_w;
 
+    if(ctx.Is3d())
+    {
+        const auto conv_stride_d =
+            ConvolutionContextInterpreter::GetAdjustedConvolutionStrideD(ctx);
+        const auto conv_dilation_d =
+            ConvolutionContextInterpreter::GetAdjustedConvolutionDilationD(ctx);
+
+        const auto ztilda = conv_stride_d / gcd(conv_stride_d, conv_dilation_d);
+
+        return ztilda * ytilda * xtilda;
+    }
+
     return ytilda * xtilda;
 }
 
@@ -770,16 +785,49 @@ ConvHipImplicitGemmBwdDataV4R1Xdlops::CalculateGemmSize(const ConvolutionContext
     const auto htilda_slice = htilda_right - htilda_left;
     const auto wtilda_slice = wtilda_right - wtilda_left;
 
+    // depth is the outermost tilda dimension, a 2d problem behaves as a single depth slice
+    int dtilda_slice = 1;
+    int zdot_slice   = 1;
+    int i_yxtilda    = gemm_id;
+
+    if(ctx.Is3d())
+    {
+        const auto di  = ConvolutionContextInterpreter::GetInputDepthDi(ctx);
+        const auto do_ = ConvolutionContextInterpreter::GetOutputDepthDo(ctx);
+        const auto z   = ConvolutionContextInterpreter::GetFilterDepthZ(ctx);
+        const auto conv_stride_d =
+            ConvolutionContextInterpreter::GetAdjustedConvolutionStrideD(ctx);
+        const auto conv_dilation_d =
+            ConvolutionContextInterpreter::GetAdjustedConvolutionDilationD(ctx);
+        const auto in_left_pad_d = ConvolutionContextInterpreter::GetInputLeftPadD(ctx);
+
+        const auto ztilda = conv_stride_d / gcd(conv_stride_d, conv_dilation_d);
+        const auto zdot   = integer_divide_ceil(z, ztilda);
+        const auto dtilda = do_ + integer_divide_ceil(conv_dilation_d * (z - 1), conv_stride_d);
+
+        const auto dtilda_left =
+            std::max(0, in_left_pad_d - conv_dilation_d * (ztilda - 1)) / conv_stride_d;
+        const auto dtilda_right =
+            std::min(dtilda, integer_divide_ceil(in_left_pad_d + di - 1, conv_stride_d) + 1);
+
+        dtilda_slice = dtilda_right - dtilda_left;
+
+        const auto i_ztilda = gemm_id / (ytilda * xtilda);
+        i_yxtilda           = gemm_id % (ytilda * xtilda);
+
+        zdot_slice = (i_ztilda + 1) * zdot <= z ? zdot : z % zdot;
+    }
+
     // gemm_k size is different for each GEMM
-    const auto i_ytilda = gemm_id / xtilda;
-    const auto i_xtilda = gemm_id % xtilda;
+    const auto i_ytilda = i_yxtilda / xtilda;
+    const auto i_xtilda = i_yxtilda % xtilda;
 
     const auto ydot_slice = (i_ytilda + 1) * ydot <= y ? ydot : y % ydot;
     const auto xdot_slice = (i_xtilda + 1) * xdot <= x ? xdot : x % xdot;
 
     const auto gemm_m = c / g;
-    const auto gemm_n = n * htilda_slice * wtilda_slice;
-    const auto gemm_k = (k / g) * ydot_slice * xdot_slice;
+    const auto gemm_n = n * dtilda_slice * htilda_slice * wtilda_slice;
+    const auto gemm_k = (k / g) * zdot_slice * ydot_slice * xdot_slice;
 
     return std::make_tuple(g, gemm_m, gemm_n, gemm_k);
 }
@@ -790,7 +838,7 @@ bool ConvHipImplicitGemmBwdDataV4R1Xdlops::IsApplicable(const ConvolutionContext
         return false;
     if(!ctx.use_hip_kernels)
         return false;
-    if(!ctx.Is2d())
+    if(!ctx.Is2d() && !ctx.Is3d())
         return false;
     if(!(ctx.IsFp32() || ctx.IsFp16() || ctx.IsBfp16()))
         return false;
@@ -878,11 +926,26 @@ ConvSolution ConvHipImplicitGemmBwdDataV4R1Xdlops::GetSolution(
             construction_parameters.g_wk.push_back(1);
             construction_parameters.g_wk.push_back(1);
 
-            construction_parameters.kernel_file = "gridwise_convolution_backward_data_implicit_"
-                                                  "gemm_v4r1_xdlops_gnchw_gkcyx_gnkhw.cpp";
-
-            construction_parameters.kernel_name = "gridwise_convolution_backward_data_implicit_"
-                                                  "gemm_v4r1_xdlops_gnchw_gkcyx_gnkhw";
+            if(ctx.Is3d())
+            {
+                construction_parameters.kernel_file =
+                    "gridwise_convolution_backward_data_implicit_"
+                    "gemm_v4r1_xdlops_gncdhw_gkczyx_gnkdhw.cpp";
+
+                construction_parameters.kernel_name =
+                    "gridwise_convolution_backward_data_implicit_"
+                    "gemm_v4r1_xdlops_gncdhw_gkczyx_gnkdhw";
+            }
+            else
+            {
+                construction_parameters.kernel_file =
+                    "gridwise_convolution_backward_data_implicit_"
+                    "gemm_v4r1_xdlops_gnchw_gkcyx_gnkhw.cpp";
+
+                construction_parameters.kernel_name =
+                    "gridwise_convolution_backward_data_implicit_"
+                    "gemm_v4r1_xdlops_gnchw_gkcyx_gnkhw";
+            }
             // TODO: add fp16 calculation by GetWorkspaceSize(ctx);
             result.workspce_sz = 0;
 
@@ -968,6 +1031,18 @@ ConvSolution ConvHipImplicitGemmBwdDataV4R1Xdlops::GetSolution(
                     std::string(" -DCK_PARAM_TUNABLE_GEMM_A_BLOCK_COPY_DST_DATA_PER_WRITE_GEMM_KPACK=") + std::to_string(GemmABlockCopyDstDataPerWrite_GemmKPACK) +
                     std::string(" -DCK_PARAM_TUNABLE_GEMM_B_BLOCK_COPY_DST_DATA_PER_WRITE_GEMM_KPACK=") + std::to_string(GemmBBlockCopyDstDataPerWrite_GemmKPACK);
 
+            if(ctx.Is3d())
+            {
+                construction_parameters.comp_options +=
+                    std::string(" -DCK_PARAM_PROBLEM_DI=") + std::to_string(ConvolutionContextInterpreter::GetInputDepthDi(ctx)) +
+                    std::string(" -DCK_PARAM_PROBLEM_DO=") + std::to_string(ConvolutionContextInterpreter::GetOutputDepthDo(ctx)) +
+                    std::string(" -DCK_PARAM_PROBLEM_Z=") + std::to_string(ConvolutionContextInterpreter::GetFilterDepthZ(ctx)) +
+                    std::string(" -DCK_PARAM_PROBLEM_CONV_STRIDE_D=") + std::to_string(ConvolutionContextInterpreter::GetAdjustedConvolutionStrideD(ctx)) +
+                    std::string(" -DCK_PARAM_PROBLEM_CONV_DILATION_D=") + std::to_string(ConvolutionContextInterpreter::GetAdjustedConvolutionDilationD(ctx)) +
+                    std::string(" -DCK_PARAM_PROBLEM_IN_LEFT_PAD_D=") + std::to_string(ConvolutionContextInterpreter::GetInputLeftPadD(ctx)) +
+                    std::string(" -DCK_PARAM_PROBLEM_IN_RIGHT_PAD_D=") + std::to_string(ConvolutionContextInterpreter::GetAdjustedInputRightPadD(ctx));
+            }
+
             result.construction_params.push_back(construction_parameters);
 
         }
@@ -223,9 +223,44 @@ void PerformanceImplicitGemmForwardV4R4Xdlops::EuristicInit(const ConvolutionCon
                     break;
             } while(!all_visited);
         }
+        else if(ctx.IsInt8())
+        {
+            // int8 xdlops only exist as 32x32 and 16x16 k-reduction, which pack 4 int8 values
+            // into a register, so the wave-wise GEMM and GemmKPack ranges are narrower
+            tmp = {256, 256, 8, 32, 32, 8, false, true, 1};
+
+            bool all_visited = false;
+            do
+            {
+                do
+                {
+                    // list in reverse order of importance,
+                    // and favor large GEMM
+                    if(!PreviousTwoPower<1, 8>(tmp.GemmBThreadDataPerRead_GemmN))
+                        break;
+                    if(!PreviousTwoPower<1, 8>(tmp.GemmKPerBlock))
+                        break;
+                    if(!PreviousTwoPower<4, 8>(tmp.GemmKPack))
+                        break;
+                    if(!PreviousTwoPower<16, 32>(tmp.GemmNPerWave))
+                        break;
+                    if(!PreviousTwoPower<16, 32>(tmp.GemmMPerWave))
+                        break;
+                    if(!PreviousTwoPower<4, 256>(tmp.GemmNPerBlock))
+                        break;
+                    if(!PreviousTwoPower<4, 256>(tmp.GemmMPerBlock))
+                        break;
+
+                    all_visited = true;
+                } while(false);
+
+                if(is_valid_func(tmp, ctx))
+                    break;
+            } while(!all_visited);
+        }
         else
         {
-            MIOPEN_LOG_E("Only fp32, fp16, and bfp16 are supported");
+            MIOPEN_LOG_E("Only fp32, fp16, bfp16 and int8 are supported");
             assert(false);
         }
     };
@@ -320,6 +355,12 @@ PerformanceImplicitGemmForwardV4R4Xdlops::CalculateGemmABlockCopyPerformancePara
     int DstDataPerWrite_GemmKPack = ctx.IsFp32() ? amd_lds_write_max_length<float>()
                                                  : amd_lds_write_max_length<half_float::half>();
 
+    if(ctx.IsInt8())
+    {
+        SrcDataPerRead_GemmKPack  = amd_buffer_load_max_length<int8_t>();
+        DstDataPerWrite_GemmKPack = amd_lds_write_max_length<int8_t>();
+    }
+
     try
     {
         bool valid = false;
@@ -406,6 +447,12 @@ PerformanceImplicitGemmForwardV4R4Xdlops::CalculateGemmBBlockCopyPerformancePara
     int DstDataPerWrite_GemmKPack = ctx.IsFp32() ? amd_lds_write_max_length<float>()
                                                  : amd_lds_write_max_length<half_float::half>();
 
+    if(ctx.IsInt8())
+    {
+        SrcDataPerRead_GemmN      = amd_buffer_load_max_length<int8_t>();
+        DstDataPerWrite_GemmKPack = amd_lds_write_max_length<int8_t>();
+    }
+
     try
     {
         bool valid = false;
@@ -434,12 +481,26 @@ PerformanceImplicitGemmForwardV4R4Xdlops::CalculateGemmBBlockCopyPerformancePara
         const auto in_right_pad_h = ConvolutionContextInterpreter::GetAdjustedInputRightPadH(ctx);
         const auto in_right_pad_w = ConvolutionContextInterpreter::GetAdjustedInputRightPadW(ctx);
 
+        // depth is folded into GemmN ahead of Ho, so a 2d problem behaves as Do = Z = 1
+        const bool is_3d = ctx.Is3d();
+        const auto z     = is_3d ? ConvolutionContextInterpreter::GetFilterDepthZ(ctx) : 1;
+        const auto do_   = is_3d ? ConvolutionContextInterpreter::GetOutputDepthDo(ctx) : 1;
+        const auto conv_stride_d =
+            is_3d ? ConvolutionContextInterpreter::GetAdjustedConvolutionStrideD(ctx) : 1;
+        const auto in_left_pad_d = is_3d ? ConvolutionContextInterpreter::GetInputLeftPadD(ctx) : 0;
+        const auto in_right_pad_d =
+            is_3d ? ConvolutionContextInterpreter::GetAdjustedInputRightPadD(ctx) : 0;
+
+        const bool is_1x1_unit_stride_no_pad =
+            z == 1 && y == 1 && x == 1 && conv_stride_d == 1 && conv_stride_h == 1 &&
+            conv_stride_w == 1 && in_left_pad_d == 0 && in_left_pad_h == 0 && in_left_pad_w == 0 &&
+            in_right_pad_d == 0 && in_right_pad_h == 0 && in_right_pad_w == 0;
+
         // GemmN is src vector read dimension, bounded by input tensor global memory layout
         // TODO this logic need to be more aggresive
-        if(y == 1 && x == 1 && conv_stride_h == 1 && conv_stride_w == 1 && in_left_pad_h == 0 &&
-           in_left_pad_w == 0 && in_right_pad_h == 0 && in_right_pad_w == 0)
+        if(is_1x1_unit_stride_no_pad)
         {
-            SrcDataPerRead_GemmN = gcd(SrcDataPerRead_GemmN, ho * wo);
+            SrcDataPerRead_GemmN = gcd(SrcDataPerRead_GemmN, do_ * ho * wo);
         }
         else if(conv_stride_w == 1 && in_left_pad_w == 0 && in_right_pad_w == 0)
         {
@@ -455,6 +516,13 @@ PerformanceImplicitGemmForwardV4R4Xdlops::CalculateGemmBBlockCopyPerformancePara
             SrcDataPerRead_GemmN = 1;
         }
 
+        // int8 is loaded as packed 32-bit words, which needs the vector to be 4-byte aligned in
+        // the input tensor. Only the 1x1 case guarantees that.
+        if(ctx.IsInt8() && !is_1x1_unit_stride_no_pad)
+        {
+            SrcDataPerRead_GemmN = 1;
+        }
+
         // SrcDataPerRead_GemmN also bounded by GemmNPerBlock
         SrcDataPerRead_GemmN = gcd(SrcDataPerRead_GemmN, GemmNPerBlock);
 
@@ -544,8 +612,12 @@ std::tuple<std::size_t, bool> PerformanceImplicitGemmForwardV4R4Xdlops::Calculat
     const auto a_block_space = GemmKPerBlock * GemmMPerBlock * GemmKPack;
     const auto b_block_space = GemmKPerBlock * GemmNPerBlock * GemmKPack;
 
-    std::size_t lds_size =
-        (a_block_space + b_block_space) * (ctx.IsFp32() ? sizeof(float) : sizeof(half_float::half));
+    std::size_t data_size = ctx.IsFp32() ? sizeof(float) : sizeof(half_float::half);
+
+    if(ctx.IsInt8())
+        data_size = sizeof(int8_t);
+
+    std::size_t lds_size = (a_block_space + b_block_space) * data_size;
 
     return std::make_tuple(lds_size, true);
 }
@@ -755,6 +827,11 @@ bool PerformanceImplicitGemmForwardV4R4Xdlops::IsFastToBeUsedForTuning(
             if(a_data_per_thread_copy > 32 || b_data_per_thread_copy > 32)
                 return false;
         }
+        else if(ctx.IsInt8())
+        {
+            if(a_data_per_thread_copy > 64 || b_data_per_thread_copy > 64)
+                return false;
+        }
     }
 
     // GemmKPerBlock*GemmKPack should not be too small, otherwise read performance of A matrix would
@@ -773,6 +850,11 @@ bool PerformanceImplicitGemmForwardV4R4Xdlops::IsFastToBeUsedForTuning(
             if(GemmKPerBlock * GemmKPack < 16)
                 return false;
         }
+        else if(ctx.IsInt8())
+        {
+            if(GemmKPerBlock * GemmKPack < 32)
+                return false;
+        }
     }
 
     // DstDataPerWrite_GemmKPack should not be too small, otherwise too many ds_write instruction
@@ -834,13 +916,16 @@ ConvHipImplicitGemmForwardV4R4Xdlops::CalculateGemmSize(const ConvolutionContext
     const auto y  = ConvolutionContextInterpreter::GetFilterHeightY(ctx);
     const auto x  = ConvolutionContextInterpreter::GetFilterWidthX(ctx);
 
+    const auto do_ = ctx.Is3d() ? ConvolutionContextInterpreter::GetOutputDepthDo(ctx) : 1;
+    const auto z   = ctx.Is3d() ? ConvolutionContextInterpreter::GetFilterDepthZ(ctx) : 1;
+
     const auto k_per_group = k / g;
     const auto c_per_group = c / g;
 
     const auto gemm_g       = g;
     const auto gemm_m       = k_per_group;
-    const auto gemm_n       = n * ho * wo;
-    const auto gemm_k_total = c_per_group * y * x;
+    const auto gemm_n       = n * do_ * ho * wo;
+    const auto gemm_k_total = c_per_group * z * y * x;
 
     return std::make_tuple(gemm_g, gemm_m, gemm_n, gemm_k_total);
 }
@@ -864,11 +949,22 @@ ConvSolution ConvHipImplicitGemmForwardV4R4Xdlops::GetSolution(
 
     assert(config.IsReallyValid(ctx));
 
-    construction_parameters.kernel_file =
-        "gridwise_convolution_forward_implicit_gemm_v4r4_xdlops_nchw_kcyx_nkhw.cpp";
+    if(ctx.Is3d())
+    {
+        construction_parameters.kernel_file =
+            "gridwise_convolution_forward_implicit_gemm_v4r4_xdlops_ncdhw_kczyx_nkdhw.cpp";
+
+        construction_parameters.kernel_name =
+            "gridwise_convolution_forward_implicit_gemm_v4r4_xdlops_ncdhw_kczyx_nkdhw";
+    }
+    else
+    {
+        construction_parameters.kernel_file =
+            "gridwise_convolution_forward_implicit_gemm_v4r4_xdlops_nchw_kcyx_nkhw.cpp";
 
-    construction_parameters.kernel_name =
-        "gridwise_convolution_forward_implicit_gemm_v4r4_xdlops_nchw_kcyx_nkhw";
+        construction_parameters.kernel_name =
+            "gridwise_convolution_forward_implicit_gemm_v4r4_xdlops_nchw_kcyx_nkhw";
+    }
 
     int grid_size  = 0;
     int block_size = 0;
@@ -955,7 +1051,20 @@ ConvSolution ConvHipImplicitGemmForwardV4R4Xdlops::GetSolution(
         std::string(" -DCK_BLOCK_SYNC_LDS_WITHOUT_SYNC_VMEM=") + (miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_BLOCK_SYNC_LDS_WITHOUT_SYNC_VMEM{}) ? '0' : '1') +
         std::string(" -DCK_WORKAROUND_SWDEV_229564=") + std::to_string(WORKAROUND_SWDEV_229564) +
         std::string(" -DCK_WORKAROUND_SWDEV_231101=") + std::to_string(WORKAROUND_SWDEV_231101) +
+        std::string(" -DCK_PARAM_INT8_OUT_FP32=") + (ctx.IsInt8() && ctx.out_data_type == miopenFloat ? '1' : '0') +
         ctx.general_compile_options;
+
+    if(ctx.Is3d())
+    {
+        construction_parameters.comp_options +=
+            std::string(" -DCK_PARAM_PROBLEM_DI=") + std::to_string(ConvolutionContextInterpreter::GetInputDepthDi(ctx)) +
+            std::string(" -DCK_PARAM_PROBLEM_DO=") + std::to_string(ConvolutionContextInterpreter::GetOutputDepthDo(ctx)) +
+            std::string(" -DCK_PARAM_PROBLEM_Z=") + std::to_string(ConvolutionContextInterpreter::GetFilterDepthZ(ctx)) +
+            std::string(" -DCK_PARAM_PROBLEM_CONV_STRIDE_D=") + std::to_string(ConvolutionContextInterpreter::GetAdjustedConvolutionStrideD(ctx)) +
+            std::string(" -DCK_PARAM_PROBLEM_CONV_DILATION_D=") + std::to_string(ConvolutionContextInterpreter::GetAdjustedConvolutionDilationD(ctx)) +
+            std::string(" -DCK_PARAM_PROBLEM_IN_LEFT_PAD_D=") + std::to_string(ConvolutionContextInterpreter::GetInputLeftPadD(ctx)) +
+            std::string(" -DCK_PARAM_PROBLEM_IN_RIGHT_PAD_D=") + std::to_string(ConvolutionContextInterpreter::GetAdjustedInputRightPadD(ctx));
+    }
     // clang-format on
 
     result.invoker_factory = conv::MakeImplGemmDataInvokerFactory(ctx);
@@ -971,13 +1080,13 @@ bool ConvHipImplicitGemmForwardV4R4Xdlops::IsApplicable(const ConvolutionContext
     if(!IsXdlopsSupport(ctx))
         return false;
 
-    if(!(ctx.IsFp32() || ctx.IsFp16() || ctx.IsBfp16()))
+    if(!(ctx.IsFp32() || ctx.IsFp16() || ctx.IsBfp16() || ctx.IsInt8()))
         return false;
 
     if(!ctx.direction.IsForward())
         return false;
 
-    if(!ctx.Is2d())
+    if(!ctx.Is2d() && !ctx.Is3d())
         return false;
 
     if(!IsIndexRangeLargeEnough(ctx))
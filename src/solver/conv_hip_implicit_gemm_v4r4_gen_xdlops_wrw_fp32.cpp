@@ -65,10 +65,11 @@ PerformanceImplicitGemmV4R4GenXdlopsWrWFp32::CalculateGemmABlockCopyPerformanceP
         // GemmABlockCopySrcDataPerRead_GemmK also bounded by size of threadwise copy
         SrcDataPerRead_GemmK = gcd(SrcDataPerRead_GemmK, a_data_per_thread_copy);
 
-        const auto ho = ConvolutionContextInterpreter::GetOutputHeightHo(ctx);
-        const auto wo = ConvolutionContextInterpreter::GetOutputWidthWo(ctx);
+        const auto do_ = ctx.Is3d() ? ConvolutionContextInterpreter::GetOutputDepthDo(ctx) : 1;
+        const auto ho  = ConvolutionContextInterpreter::GetOutputHeightHo(ctx);
+        const auto wo  = ConvolutionContextInterpreter::GetOutputWidthWo(ctx);
 
-        SrcDataPerRead_GemmK = gcd(SrcDataPerRead_GemmK, ho * wo);
+        SrcDataPerRead_GemmK = gcd(SrcDataPerRead_GemmK, do_ * ho * wo);
 
         // decide threadwise copy lengths
         const auto a_data_per_thread_copy_gemmk = SrcDataPerRead_GemmK;
@@ -114,29 +115,41 @@ PerformanceImplicitGemmV4R4GenXdlopsWrWFp32::CalculateGemmBBlockCopyPerformanceP
 
         SrcDataPerRead_GemmK = gcd(SrcDataPerRead_GemmK, GemmKPerBlock);
 
+        // a 2d problem behaves as a 3d one with Di = Z = 1 and no stride or pad on depth
+        const bool is_3d = ctx.Is3d();
+
+        const auto z = is_3d ? ConvolutionContextInterpreter::GetFilterDepthZ(ctx) : 1;
         const auto y = ConvolutionContextInterpreter::GetFilterHeightY(ctx);
         const auto x = ConvolutionContextInterpreter::GetFilterWidthX(ctx);
 
+        const auto di = is_3d ? ConvolutionContextInterpreter::GetInputDepthDi(ctx) : 1;
         const auto hi = ConvolutionContextInterpreter::GetInputHeightHi(ctx);
         const auto wi = ConvolutionContextInterpreter::GetInputWidthWi(ctx);
         const auto wo = ConvolutionContextInterpreter::GetOutputWidthWo(ctx);
         // calculate vector length on gemmn dimension
+        const auto conv_stride_d =
+            is_3d ? ConvolutionContextInterpreter::GetAdjustedConvolutionStrideD(ctx) : 1;
         const auto conv_stride_h =
             ConvolutionContextInterpreter::GetAdjustedConvolutionStrideH(ctx);
         const auto conv_stride_w =
             ConvolutionContextInterpreter::GetAdjustedConvolutionStrideW(ctx);
         const auto conv_dilation_w =
             ConvolutionContextInterpreter::GetAdjustedConvolutionDilationW(ctx);
-        const auto in_left_pad_h  = ConvolutionContextInterpreter::GetInputLeftPadH(ctx);
-        const auto in_left_pad_w  = ConvolutionContextInterpreter::GetInputLeftPadW(ctx);
+        const auto in_left_pad_d =
+            is_3d ? ConvolutionContextInterpreter::GetInputLeftPadD(ctx) : 0;
+        const auto in_left_pad_h = ConvolutionContextInterpreter::GetInputLeftPadH(ctx);
+        const auto in_left_pad_w = ConvolutionContextInterpreter::GetInputLeftPadW(ctx);
+        const auto in_right_pad_d =
+            is_3d ? ConvolutionContextInterpreter::GetAdjustedInputRightPadD(ctx) : 0;
         const auto in_right_pad_h = ConvolutionContextInterpreter::GetAdjustedInputRightPadH(ctx);
         const auto in_right_pad_w = ConvolutionContextInterpreter::GetAdjustedInputRightPadW(ctx);
 
-        if(y == 1 && x == 1 && conv_stride_h == 1 && conv_stride_w == 1 && in_left_pad_h == 0 &&
-           in_left_pad_w == 0 && in_right_pad_h == 0 && in_right_pad_w == 0)
+        if(z == 1 && y == 1 && x == 1 && conv_stride_d == 1 && conv_stride_h == 1 &&
+           conv_stride_w == 1 && in_left_pad_d == 0 && in_left_pad_h == 0 && in_left_pad_w == 0 &&
+           in_right_pad_d == 0 && in_right_pad_h == 0 && in_right_pad_w == 0)
         {
             // \todo there are more configs that can go through this if branch
-            SrcDataPerRead_GemmK = gcd(SrcDataPerRead_GemmK, hi * wi);
+            SrcDataPerRead_GemmK = gcd(SrcDataPerRead_GemmK, di * hi * wi);
         }
         else if(in_left_pad_w == 0 && in_right_pad_w == 0)
         {
@@ -247,14 +260,16 @@ bool PerformanceImplicitGemmV4R4GenXdlopsWrWFp32::IsValid(const ConvolutionConte
     const std::size_t n  = ConvolutionContextInterpreter::GetBatchN(ctx);
     const std::size_t k  = ConvolutionContextInterpreter::GetOutputChannelK(ctx) / ctx.group_counts;
     const std::size_t c  = ConvolutionContextInterpreter::GetInputChannelC(ctx) / ctx.group_counts;
-    const std::size_t ho = ConvolutionContextInterpreter::GetOutputHeightHo(ctx);
-    const std::size_t wo = ConvolutionContextInterpreter::GetOutputWidthWo(ctx);
-    const std::size_t y  = ConvolutionContextInterpreter::GetFilterHeightY(ctx);
-    const std::size_t x  = ConvolutionContextInterpreter::GetFilterWidthX(ctx);
+    const std::size_t do_ = ctx.Is3d() ? ConvolutionContextInterpreter::GetOutputDepthDo(ctx) : 1;
+    const std::size_t ho  = ConvolutionContextInterpreter::GetOutputHeightHo(ctx);
+    const std::size_t wo  = ConvolutionContextInterpreter::GetOutputWidthWo(ctx);
+    const std::size_t z   = ctx.Is3d() ? ConvolutionContextInterpreter::GetFilterDepthZ(ctx) : 1;
+    const std::size_t y   = ConvolutionContextInterpreter::GetFilterHeightY(ctx);
+    const std::size_t x   = ConvolutionContextInterpreter::GetFilterWidthX(ctx);
 
     const std::size_t GemmM = k;
-    const std::size_t GemmN = c * y * x;
-    const std::size_t GemmK = n * ho * wo;
+    const std::size_t GemmN = c * z * y * x;
+    const std::size_t GemmK = n * do_ * ho * wo;
 
     // heuristic to reduce search space
     {
@@ -274,6 +289,10 @@ bool PerformanceImplicitGemmV4R4GenXdlopsWrWFp32::IsValid(const ConvolutionConte
             return false;
     }
 
+    // The K blocks add their partial results with atomics, in no particular order.
+    if(ctx.conv_problem.IsDeterministic() && GemmKBlocks > 1)
+        return false;
+
     if(!(GemmM % GemmMPerBlock == 0 && GemmN % GemmNPerBlock == 0 &&
          GemmK % (GemmKPerBlock * GemmKBlocks) == 0))
         return false; // wrong! cannot divice N evenly among thread
@@ -449,8 +468,10 @@ ConvSolution ConvHipImplicitGemmV4R4GenXdlopsWrWFp32::GetSolution(
     const std::size_t in_right_pad_w =
         ConvolutionContextInterpreter::GetAdjustedInputRightPadW(ctx);
 
+    const std::size_t z = ctx.Is3d() ? ConvolutionContextInterpreter::GetFilterDepthZ(ctx) : 1;
+
     const std::size_t GemmM = k;
-    const std::size_t GemmN = c * y * x;
+    const std::size_t GemmN = c * z * y * x;
 
     const std::size_t block_size = config.GemmNPerBlock * config.GemmMPerBlock /
                                    (config.GemmMPerWave * config.GemmNPerWave) * wave_size;
@@ -495,8 +516,16 @@ ConvSolution ConvHipImplicitGemmV4R4GenXdlopsWrWFp32::GetSolution(
              std::ignore) = config.CalculateGemmBBlockCopyPerformanceParameters(ctx);
 
     // clang-format off
-    construction_parameters.kernel_file = "gridwise_convolution_implicit_gemm_v4r4_gen_xdlops_wrw_fp32_nchw_kcyx_nkhw_lds_double_buffer.cpp";
-    construction_parameters.kernel_name = "gridwise_convolution_implicit_gemm_v4r4_gen_xdlops_wrw_fp32_nchw_kcyx_nkhw_lds_double_buffer";
+    if(ctx.Is3d())
+    {
+        construction_parameters.kernel_file = "gridwise_convolution_implicit_gemm_v4r4_gen_xdlops_wrw_fp32_ncdhw_kczyx_nkdhw_lds_double_buffer.cpp";
+        construction_parameters.kernel_name = "gridwise_convolution_implicit_gemm_v4r4_gen_xdlops_wrw_fp32_ncdhw_kczyx_nkdhw_lds_double_buffer";
+    }
+    else
+    {
+        construction_parameters.kernel_file = "gridwise_convolution_implicit_gemm_v4r4_gen_xdlops_wrw_fp32_nchw_kcyx_nkhw_lds_double_buffer.cpp";
+        construction_parameters.kernel_name = "gridwise_convolution_implicit_gemm_v4r4_gen_xdlops_wrw_fp32_nchw_kcyx_nkhw_lds_double_buffer";
+    }
 
     construction_parameters.comp_options =
         std::string(" -std=c++14 ") +
@@ -541,6 +570,18 @@ ConvSolution ConvHipImplicitGemmV4R4GenXdlopsWrWFp32::GetSolution(
         std::string(" -DCK_USE_AMD_XDLOPS_INLINE_ASM=") + (miopen::IsEnabled(MIOPEN_DEBUG_IMPLICIT_GEMM_XDLOPS_INLINE_ASM{}) ? '1' : '0') +
         std::string(" -DCK_USE_AMD_XDLOPS_EMULATE=") + (miopen::IsEnabled(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_XDLOPS_EMULATE{}) ? '1' : '0') +
         ctx.general_compile_options;
+
+    if(ctx.Is3d())
+    {
+        construction_parameters.comp_options +=
+            std::string(" -DCK_PARAM_PROBLEM_DI=") + std::to_string(ConvolutionContextInterpreter::GetInputDepthDi(ctx)) +
+            std::string(" -DCK_PARAM_PROBLEM_DO=") + std::to_string(ConvolutionContextInterpreter::GetOutputDepthDo(ctx)) +
+            std::string(" -DCK_PARAM_PROBLEM_Z=") + std::to_string(z) +
+            std::string(" -DCK_PARAM_PROBLEM_CONV_STRIDE_D=") + std::to_string(ConvolutionContextInterpreter::GetAdjustedConvolutionStrideD(ctx)) +
+            std::string(" -DCK_PARAM_PROBLEM_CONV_DILATION_D=") + std::to_string(ConvolutionContextInterpreter::GetAdjustedConvolutionDilationD(ctx)) +
+            std::string(" -DCK_PARAM_PROBLEM_LEFT_PAD_D=") + std::to_string(ConvolutionContextInterpreter::GetInputLeftPadD(ctx)) +
+            std::string(" -DCK_PARAM_PROBLEM_RIGHT_PAD_D=") + std::to_string(ConvolutionContextInterpreter::GetAdjustedInputRightPadD(ctx));
+    }
     // clang-format on
 
     result.construction_params.push_back(construction_parameters);
@@ -590,7 +631,7 @@ bool ConvHipImplicitGemmV4R4GenXdlopsWrWFp32::IsApplicable(const ConvolutionCont
         return false;
     if(!ctx.direction.IsBackwardWrW())
         return false;
-    if(!ctx.Is2d())
+    if(!ctx.Is2d() && !ctx.Is3d())
         return false;
     if(ctx.group_counts > 1)
         return false;
@@ -598,14 +639,16 @@ bool ConvHipImplicitGemmV4R4GenXdlopsWrWFp32::IsApplicable(const ConvolutionCont
     const std::size_t n  = ConvolutionContextInterpreter::GetBatchN(ctx);
     const std::size_t k  = ConvolutionContextInterpreter::GetOutputChannelK(ctx) / ctx.group_counts;
     const std::size_t c  = ConvolutionContextInterpreter::GetInputChannelC(ctx) / ctx.group_counts;
-    const std::size_t y  = ConvolutionContextInterpreter::GetFilterHeightY(ctx);
-    const std::size_t x  = ConvolutionContextInterpreter::GetFilterWidthX(ctx);
-    const std::size_t ho = ConvolutionContextInterpreter::GetOutputHeightHo(ctx);
-    const std::size_t wo = ConvolutionContextInterpreter::GetOutputWidthWo(ctx);
+    const std::size_t z   = ctx.Is3d() ? ConvolutionContextInterpreter::GetFilterDepthZ(ctx) : 1;
+    const std::size_t y   = ConvolutionContextInterpreter::GetFilterHeightY(ctx);
+    const std::size_t x   = ConvolutionContextInterpreter::GetFilterWidthX(ctx);
+    const std::size_t do_ = ctx.Is3d() ? ConvolutionContextInterpreter::GetOutputDepthDo(ctx) : 1;
+    const std::size_t ho  = ConvolutionContextInterpreter::GetOutputHeightHo(ctx);
+    const std::size_t wo  = ConvolutionContextInterpreter::GetOutputWidthWo(ctx);
 
     const std::size_t GemmM = k;
-    const std::size_t GemmN = c * y * x;
-    const std::size_t GemmK = n * ho * wo;
+    const std::size_t GemmN = c * z * y * x;
+    const std::size_t GemmK = n * do_ * ho * wo;
 
     return IsValidGridGemmXdlops(GemmM, GemmN, GemmK) && IsXdlopsSupport(ctx);
 #endif
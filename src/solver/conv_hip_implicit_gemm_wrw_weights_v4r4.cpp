@@ -30,6 +30,10 @@
 #include <miopen/conv/wrw_invoke_params.hpp>
 #include "implicitgemm_util.hpp"
 
+/// Overrides the number of GemmK groups the weight-gradient GEMM is split into.
+/// Must be a power of 2; 1 disables the split-K variant.
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_IMPLICIT_GEMM_HIP_WRW_V4R4_GEMM_K_GROUPS)
+
 namespace miopen {
 namespace solver {
 
@@ -438,6 +442,9 @@ bool PerformanceImplicitGemmV4R4WrW::IsValid(const ConvolutionContext& ctx) cons
 
     std::tie(gemm_m, gemm_n, gemm_k) = ConvHipImplicitGemmV4R4WrW::CalculateGemmSize(ctx);
 
+    // each GemmK group runs its own GEMM over a part of the batch
+    gemm_k /= ConvHipImplicitGemmV4R4WrW::CalculateGemmKGroups(ctx);
+
     if(!(gemm_m % GemmMPerBlock == 0 && gemm_n % GemmNPerBlock == 0 && gemm_k % GemmKPerBlock == 0))
         return false;
 
@@ -584,6 +591,62 @@ ConvHipImplicitGemmV4R4WrW::CalculateGemmSize(const ConvolutionContext& ctx)
     return std::make_tuple(gemm_m, gemm_n, gemm_k);
 }
 
+int ConvHipImplicitGemmV4R4WrW::CalculateGemmKGroups(const ConvolutionContext& ctx)
+{
+    const auto n = ConvolutionContextInterpreter::GetBatchN(ctx);
+
+    int gemm_m = 0;
+    int gemm_n = 0;
+    int gemm_k = 0;
+
+    std::tie(gemm_m, gemm_n, gemm_k) = CalculateGemmSize(ctx);
+
+    // A group must process whole images and still leave a multiple of the smallest
+    // GemmKPerBlock for the GEMM.
+    const auto is_valid_groups = [&](int groups) {
+        return n % groups == 0 && (gemm_k / groups) % 4 == 0;
+    };
+
+    const auto forced = miopen::Value(MIOPEN_DEBUG_IMPLICIT_GEMM_HIP_WRW_V4R4_GEMM_K_GROUPS{});
+    if(forced != 0)
+    {
+        const auto groups = static_cast<int>(forced);
+        if(groups > 0 && IsTwoPower<1, 64>(groups) && is_valid_groups(groups))
+            return groups;
+        MIOPEN_LOG_W("Ignoring invalid number of GemmK groups: " << forced);
+        return 1;
+    }
+
+    // The output tile grid does not depend on the batch size, so small batches leave
+    // most of the CUs idle. Split GemmK until the grid covers the device, estimating the
+    // grid with the largest tiles and keeping at least 256 GemmK elements per group
+    // to amortize the reduction.
+    const int n_cu   = ctx.GetStream().GetMaxComputeUnits();
+    const int blocks = std::max(gemm_m / 128, 1) * std::max(gemm_n / 128, 1);
+
+    int groups = 1;
+    while(groups < 64 && blocks * groups < n_cu && is_valid_groups(groups * 2) &&
+          gemm_k / (groups * 2) >= 256)
+        groups *= 2;
+
+    return groups;
+}
+
+size_t ConvHipImplicitGemmV4R4WrW::GetWorkspaceSize(const ConvolutionContext& ctx) const
+{
+    const auto groups = CalculateGemmKGroups(ctx);
+    if(groups == 1)
+        return 0;
+
+    int gemm_m = 0;
+    int gemm_n = 0;
+
+    std::tie(gemm_m, gemm_n, std::ignore) = CalculateGemmSize(ctx);
+
+    // one partial weight gradient per group
+    return static_cast<size_t>(groups) * gemm_m * gemm_n * sizeof(float);
+}
+
 bool ConvHipImplicitGemmV4R4WrW::IsApplicable(const ConvolutionContext& ctx) const
 {
     if(ctx.skip_solutions_that_take_long_time_to_build_and_have_narrow_coverage)
@@ -641,12 +704,15 @@ ConvSolution ConvHipImplicitGemmV4R4WrW::GetSolution(const ConvolutionContext& c
 
     std::tie(grid_size, std::ignore) = config.CalculateGridSize(ctx);
 
+    const auto gemmk_groups = CalculateGemmKGroups(ctx);
+
     construction_parameters.l_wk.push_back(config.BlockSize);
     construction_parameters.l_wk.push_back(1);
     construction_parameters.l_wk.push_back(1);
 
+    // GemmK groups are laid out along the second grid dimension
     construction_parameters.g_wk.push_back(config.BlockSize * grid_size);
-    construction_parameters.g_wk.push_back(1);
+    construction_parameters.g_wk.push_back(gemmk_groups);
     construction_parameters.g_wk.push_back(1);
 
     if(ctx.Is3d())
@@ -744,6 +810,7 @@ ConvSolution ConvHipImplicitGemmV4R4WrW::GetSolution(const ConvolutionContext& c
         std::string(" -DCK_PARAM_TUNABLE_GEMM_B_BLOCK_COPY_DST_DATA_PER_WRITE_GEMM_N=") + std::to_string(GemmBBlockCopyDstDataPerWrite_GemmN) +
         std::string(" -DCK_PARAM_TUNABLE_GEMM_C_THREAD_COPY_DST_DATA_PER_WRITE_GEMM_N1=") + std::to_string(GemmCThreadCopyDstDataPerWrite_GemmN1) +
         std::string(" -DCK_PARAM_DEPENDENT_GRID_SIZE=") + std::to_string(grid_size) +
+        std::string(" -DCK_PARAM_GEMM_K_GROUPS=") + std::to_string(gemmk_groups) +
         std::string(" -DCK_THREADWISE_GEMM_USE_AMD_INLINE_ASM=") + (use_amd_inline_asm(ctx) ? '1' : '0') +
         std::string(" -DCK_USE_AMD_INLINE_ASM=") + (use_amd_inline_asm(ctx) ? '1' : '0') +
         ctx.general_compile_options;
@@ -763,11 +830,69 @@ ConvSolution ConvHipImplicitGemmV4R4WrW::GetSolution(const ConvolutionContext& c
 
     result.construction_params.push_back(construction_parameters);
 
-    result.invoker_factory = [](const std::vector<Kernel>& kernels) {
+    if(gemmk_groups == 1)
+    {
+        result.invoker_factory = [](const std::vector<Kernel>& kernels) {
+            return [=](const Handle& handle, const AnyInvokeParams& primitive_params) {
+                const auto& invoke_params = primitive_params.CastTo<conv::WrWInvokeParams>();
+                const auto& tensors       = invoke_params.tensors;
+                handle.Run(kernels[0])(tensors.x, tensors.dy, tensors.dw);
+            };
+        };
+
+        return result;
+    }
+
+    // Split-K: every group writes its partial weight gradient into the workspace and the
+    // partials are summed into dw by a second kernel.
+    int gemm_m = 0;
+    int gemm_n = 0;
+
+    std::tie(gemm_m, gemm_n, std::ignore) = CalculateGemmSize(ctx);
+
+    // IsApplicable() guarantees that both GEMM dimensions are multiples of 32, so the
+    // weights tensor always splits evenly into float4 chunks of whole reduction blocks.
+    const int wei_size             = gemm_m * gemm_n;
+    const int reduction_per_thread = 4;
+    const int reduction_block_size = 256;
+
+    KernelInfo reduction;
+    reduction.kernel_file  = "wrw_reduction_hip.cpp";
+    reduction.kernel_name  = "wrw_reduction_hip";
+    reduction.l_wk         = {static_cast<size_t>(reduction_block_size), 1, 1};
+    reduction.g_wk         = {static_cast<size_t>(wei_size / reduction_per_thread), 1, 1};
+    reduction.comp_options = "-Wno-old-style-cast -Wno-cast-align";
+    result.construction_params.push_back(reduction);
+
+    result.workspce_sz = GetWorkspaceSize(ctx);
+
+    const auto ws_sz = result.workspce_sz;
+
+    result.invoker_factory = [=](const std::vector<Kernel>& kernels) {
         return [=](const Handle& handle, const AnyInvokeParams& primitive_params) {
             const auto& invoke_params = primitive_params.CastTo<conv::WrWInvokeParams>();
             const auto& tensors       = invoke_params.tensors;
-            handle.Run(kernels[0])(tensors.x, tensors.dy, tensors.dw);
+
+            if(invoke_params.workSpace == nullptr || invoke_params.workSpaceSize < ws_sz)
+                MIOPEN_THROW("Not enough workspace for ConvHipImplicitGemmV4R4WrW");
+
+            float elapsed = 0;
+
+            handle.Run(kernels[0])(tensors.x, tensors.dy, invoke_params.workSpace);
+            if(handle.IsProfilingEnabled())
+                elapsed += handle.GetKernelTime();
+
+            handle.Run(kernels[1])(tensors.dw,
+                                   invoke_params.workSpace,
+                                   reduction_per_thread,
+                                   wei_size,
+                                   gemmk_groups);
+            if(handle.IsProfilingEnabled())
+            {
+                elapsed += handle.GetKernelTime();
+                handle.ResetKernelTime();
+                handle.AccumKernelTime(elapsed);
+            }
         };
     };
 
@@ -114,6 +114,10 @@ bool PerformanceImplicitGemmXdlops::IsValid(const ConvolutionContext& ctx) const
     if(!(ctx.direction.IsBackwardWrW()) && GemmKBlocks > 1)
         return false;
 
+    // The K blocks add their partial results with atomics, in no particular order.
+    if(ctx.conv_problem.IsDeterministic() && GemmKBlocks > 1)
+        return false;
+
     if(!(GemmM % GemmMPerBlock == 0 && GemmN % GemmNPerBlock == 0 &&
          GemmK % (GemmKPerBlock * GemmKBlocks) == 0))
         return false; // wrong! cannot divice N evenly among thread
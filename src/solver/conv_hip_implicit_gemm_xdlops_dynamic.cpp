@@ -0,0 +1,707 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv/data_invoke_params.hpp>
+#include <miopen/conv/wrw_invoke_params.hpp>
+#include <miopen/solver.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/env.hpp>
+#include <miopen/generic_search.hpp>
+#include <miopen/sequences.hpp>
+#include <miopen/tensor_ops.hpp>
+#include "implicitgemm_util.hpp"
+
+#include <array>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_HIP_FWD_V4R4_XDLOPS_DYNAMIC)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_HIP_BWD_V4R1_XDLOPS_DYNAMIC)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_HIP_WRW_V4R4_XDLOPS_DYNAMIC)
+
+namespace miopen {
+namespace solver {
+
+namespace {
+
+struct XdlopsDynamicTile
+{
+    int block_size;
+    int gemm_m_per_block;
+    int gemm_n_per_block;
+    int gemm_k_per_block;
+    int gemm_m_per_wave;
+    int gemm_n_per_wave;
+};
+
+// The kernels are compiled once per entry of this set (and data type), whatever the shape.
+// Ordered from the largest tile to the smallest.
+const std::array<XdlopsDynamicTile, 4>& GetXdlopsDynamicTiles()
+{
+    // clang-format off
+    static const std::array<XdlopsDynamicTile, 4> tiles = {{
+        {256, 128, 128, 8, 64, 64},
+        {256, 128,  64, 8, 64, 32},
+        {256,  64, 128, 8, 32, 64},
+        { 64,  32,  32, 8, 32, 32},
+    }};
+    // clang-format on
+    return tiles;
+}
+
+/// The groups are folded into the grid, each one takes the blocks of a whole GEMM.
+int GetXdlopsDynamicGridSize(const XdlopsDynamicTile& tile, int gemm_g, int gemm_m, int gemm_n)
+{
+    return gemm_g * ((gemm_m + tile.gemm_m_per_block - 1) / tile.gemm_m_per_block) *
+           ((gemm_n + tile.gemm_n_per_block - 1) / tile.gemm_n_per_block);
+}
+
+struct XdlopsDynamicGemm
+{
+    int g;
+    int m;
+    int n;
+    int k;
+};
+
+XdlopsDynamicGemm GetXdlopsDynamicFwdGemm(const ConvolutionContext& ctx)
+{
+    const auto gemm_g = ctx.group_counts;
+    return {gemm_g,
+            ConvolutionContextInterpreter::GetOutputChannelK(ctx) / gemm_g,
+            ConvolutionContextInterpreter::GetBatchN(ctx) *
+                ConvolutionContextInterpreter::GetOutputHeightHo(ctx) *
+                ConvolutionContextInterpreter::GetOutputWidthWo(ctx),
+            ConvolutionContextInterpreter::GetInputChannelC(ctx) / gemm_g *
+                ConvolutionContextInterpreter::GetFilterHeightY(ctx) *
+                ConvolutionContextInterpreter::GetFilterWidthX(ctx)};
+}
+
+XdlopsDynamicGemm GetXdlopsDynamicWrwGemm(const ConvolutionContext& ctx)
+{
+    const auto gemm_g = ctx.group_counts;
+    return {gemm_g,
+            ConvolutionContextInterpreter::GetOutputChannelK(ctx) / gemm_g,
+            ConvolutionContextInterpreter::GetInputChannelC(ctx) / gemm_g *
+                ConvolutionContextInterpreter::GetFilterHeightY(ctx) *
+                ConvolutionContextInterpreter::GetFilterWidthX(ctx),
+            ConvolutionContextInterpreter::GetBatchN(ctx) *
+                ConvolutionContextInterpreter::GetOutputHeightHo(ctx) *
+                ConvolutionContextInterpreter::GetOutputWidthWo(ctx)};
+}
+
+/// gfx908 has buffer atomic adds of fp32 and of packed fp16.
+bool IsXdlopsDynamicBufferAtomicAddSupported(const ConvolutionContext& ctx)
+{
+    return StartsWith(ctx.GetStream().GetDeviceName(), "gfx908") &&
+           (ctx.IsFp32() || ctx.IsFp16());
+}
+
+/// Takes the largest tile which keeps all the CUs busy and wastes at most a quarter
+/// of its work on padding, or the smallest one.
+const XdlopsDynamicTile&
+SelectXdlopsDynamicTile(const ConvolutionContext& ctx, int gemm_g, int gemm_m, int gemm_n)
+{
+    const auto& tiles   = GetXdlopsDynamicTiles();
+    const auto cu_count = static_cast<int>(ctx.GetStream().GetMaxComputeUnits());
+
+    for(const auto& tile : tiles)
+    {
+        const auto grid_size = GetXdlopsDynamicGridSize(tile, gemm_g, gemm_m, gemm_n);
+        const auto padded =
+            static_cast<double>(grid_size) * tile.gemm_m_per_block * tile.gemm_n_per_block;
+
+        if(grid_size >= cu_count &&
+           static_cast<double>(gemm_g) * gemm_m * gemm_n >= 0.75 * padded)
+            return tile;
+    }
+
+    return tiles.back();
+}
+
+/// fp32 splits the reduction until the grid fills the CUs, while each K block still runs
+/// a few iterations of its K loop. fp16 partial results are rounded at every atomic add, so
+/// they are only split when tuning finds it pays off. In the deterministic mode the partial
+/// results are kept in fp32 for any data type, and this is also the most K blocks the
+/// workspace has room for.
+int GetXdlopsDynamicWrwKBlocks(const ConvolutionContext& ctx)
+{
+    const auto deterministic = ctx.conv_problem.IsDeterministic();
+    if(!ctx.IsFp32() && !deterministic)
+        return 1;
+
+    const auto gemm      = GetXdlopsDynamicWrwGemm(ctx);
+    const auto& tile     = SelectXdlopsDynamicTile(ctx, gemm.g, gemm.m, gemm.n);
+    const auto grid_size = GetXdlopsDynamicGridSize(tile, gemm.g, gemm.m, gemm.n);
+    const auto cu_count  = static_cast<int>(ctx.GetStream().GetMaxComputeUnits());
+    // The workspace is indexed with 32 bits.
+    const auto max_partial_size = static_cast<std::size_t>(std::numeric_limits<int>::max());
+    const auto wei_size         = static_cast<std::size_t>(gemm.g) * gemm.m * gemm.n;
+
+    int k_blocks = 1;
+    while(k_blocks < 64 && grid_size * k_blocks < cu_count &&
+          gemm.k >= 2 * k_blocks * 4 * tile.gemm_k_per_block &&
+          (!deterministic || 2 * k_blocks * wei_size <= max_partial_size))
+        k_blocks *= 2;
+    return k_blocks;
+}
+
+bool IsXdlopsDynamicApplicable(const ConvolutionContext& ctx)
+{
+    if(!IsXdlopsSupport(ctx))
+        return false;
+
+    if(!(ctx.IsFp32() || ctx.IsFp16() || ctx.IsBfp16()))
+        return false;
+
+    if(!ctx.Is2d() || !ctx.IsLayoutDefault())
+        return false;
+
+    return IsIndexRangeLargeEnough(ctx);
+}
+
+void RunXdlopsDynamicKernel(const Handle& handle,
+                            const Kernel& kernel,
+                            ConstData_t a,
+                            ConstData_t b,
+                            Data_t c,
+                            const std::vector<int>& geometry)
+{
+    std::vector<OpKernelArg> args;
+    args.emplace_back(a);
+    args.emplace_back(b);
+    args.emplace_back(c);
+    for(const auto arg : geometry)
+        args.emplace_back(arg);
+    handle.Run(kernel)(args);
+}
+
+/// The backward weights kernel also takes the buffer of the partial results, or null.
+void RunXdlopsDynamicKernel(const Handle& handle,
+                            const Kernel& kernel,
+                            ConstData_t a,
+                            ConstData_t b,
+                            Data_t c,
+                            const std::vector<int>& geometry,
+                            Data_t partial)
+{
+    std::vector<OpKernelArg> args;
+    args.emplace_back(a);
+    args.emplace_back(b);
+    args.emplace_back(c);
+    for(const auto arg : geometry)
+        args.emplace_back(arg);
+    args.emplace_back(partial);
+    handle.Run(kernel)(args);
+}
+
+/// With a split GemmK the output is zeroed first, and the profiled time covers both kernels.
+template <class F>
+void RunXdlopsDynamicSplitKernel(const Handle& handle,
+                                 int gemm_k_blocks,
+                                 const TensorDescriptor& c_desc,
+                                 Data_t c,
+                                 const F& run)
+{
+    float elapsed = 0;
+
+    if(gemm_k_blocks > 1)
+    {
+        float zero = 0.f;
+        SetTensor(handle, c_desc, c, &zero);
+        if(handle.IsProfilingEnabled())
+            elapsed += handle.GetKernelTime();
+    }
+
+    run();
+
+    if(handle.IsProfilingEnabled() && gemm_k_blocks > 1)
+    {
+        elapsed += handle.GetKernelTime();
+        handle.ResetKernelTime();
+        handle.AccumKernelTime(elapsed);
+    }
+}
+
+/// Problem sizes are passed to the kernel at launch, so the compile options only
+/// depend on the tile and the data type.
+ConvSolution GetXdlopsDynamicSolution(const ConvolutionContext& ctx,
+                                      const std::string& kernel_name,
+                                      int gemm_g,
+                                      int gemm_m,
+                                      int gemm_n,
+                                      int gemm_k_blocks = 1)
+{
+    const auto& tile     = SelectXdlopsDynamicTile(ctx, gemm_g, gemm_m, gemm_n);
+    const auto grid_size = GetXdlopsDynamicGridSize(tile, gemm_g, gemm_m, gemm_n) * gemm_k_blocks;
+
+    KernelInfo construction_parameters;
+
+    construction_parameters.kernel_file = kernel_name + ".cpp";
+    construction_parameters.kernel_name = kernel_name;
+
+    construction_parameters.l_wk.push_back(tile.block_size);
+    construction_parameters.l_wk.push_back(1);
+    construction_parameters.l_wk.push_back(1);
+
+    construction_parameters.g_wk.push_back(static_cast<std::size_t>(tile.block_size) * grid_size);
+    construction_parameters.g_wk.push_back(1);
+    construction_parameters.g_wk.push_back(1);
+
+    const char buffer_atomic_add = IsXdlopsDynamicBufferAtomicAddSupported(ctx) ? '1' : '0';
+
+    // clang-format off
+    construction_parameters.comp_options =
+        std::string(" -std=c++14 ") +
+        std::string(" -DCK_PARAM_TUNABLE_BLOCK_SIZE=") + std::to_string(tile.block_size) +
+        std::string(" -DCK_PARAM_TUNABLE_GEMM_M_PER_BLOCK=") + std::to_string(tile.gemm_m_per_block) +
+        std::string(" -DCK_PARAM_TUNABLE_GEMM_N_PER_BLOCK=") + std::to_string(tile.gemm_n_per_block) +
+        std::string(" -DCK_PARAM_TUNABLE_GEMM_K_PER_BLOCK=") + std::to_string(tile.gemm_k_per_block) +
+        std::string(" -DCK_PARAM_TUNABLE_GEMM_M_PER_WAVE=") + std::to_string(tile.gemm_m_per_wave) +
+        std::string(" -DCK_PARAM_TUNABLE_GEMM_N_PER_WAVE=") + std::to_string(tile.gemm_n_per_wave) +
+        std::string(" -DCK_USE_AMD_XDLOPS=1") +
+        std::string(" -DCK_USE_AMD_BUFFER_ATOMIC_ADD=") + buffer_atomic_add +
+        std::string(" -DCK_BLOCK_SYNC_LDS_WITHOUT_SYNC_VMEM=") + (miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_BLOCK_SYNC_LDS_WITHOUT_SYNC_VMEM{}) ? '0' : '1') +
+        ctx.general_compile_options;
+    // clang-format on
+
+    // The geometry is in forward terms for all the directions.
+    std::vector<int> geometry = {
+        ctx.group_counts,
+        ConvolutionContextInterpreter::GetBatchN(ctx),
+        ConvolutionContextInterpreter::GetInputChannelC(ctx),
+        ConvolutionContextInterpreter::GetInputHeightHi(ctx),
+        ConvolutionContextInterpreter::GetInputWidthWi(ctx),
+        ConvolutionContextInterpreter::GetOutputChannelK(ctx),
+        ConvolutionContextInterpreter::GetFilterHeightY(ctx),
+        ConvolutionContextInterpreter::GetFilterWidthX(ctx),
+        ConvolutionContextInterpreter::GetOutputHeightHo(ctx),
+        ConvolutionContextInterpreter::GetOutputWidthWo(ctx),
+        ConvolutionContextInterpreter::GetAdjustedConvolutionStrideH(ctx),
+        ConvolutionContextInterpreter::GetAdjustedConvolutionStrideW(ctx),
+        ConvolutionContextInterpreter::GetAdjustedConvolutionDilationH(ctx),
+        ConvolutionContextInterpreter::GetAdjustedConvolutionDilationW(ctx),
+        ConvolutionContextInterpreter::GetInputLeftPadH(ctx),
+        ConvolutionContextInterpreter::GetInputLeftPadW(ctx)};
+
+    ConvSolution result;
+    result.construction_params.push_back(construction_parameters);
+
+    // Every output element is written once, unless the forward or backward weights reduction
+    // is split between K blocks which accumulate into the zeroed output.
+    if(!ctx.direction.IsBackwardData())
+        geometry.push_back(gemm_k_blocks);
+
+    if(ctx.direction.IsBackwardWrW() && ctx.conv_problem.IsDeterministic() && gemm_k_blocks > 1)
+    {
+        // The K blocks store their partial results to the workspace instead of adding them to
+        // the weight gradient, and the second kernel sums them in order.
+        const auto wei_size       = gemm_g * gemm_m * gemm_n;
+        const auto reduction_size = std::size_t{256};
+        const auto ws_sz = static_cast<std::size_t>(wei_size) * gemm_k_blocks * sizeof(float);
+
+        auto reduction        = construction_parameters;
+        reduction.kernel_name = "gridwise_convolution_backward_weights_implicit_gemm_v4r4_xdlops_"
+                                "dynamic_reduction";
+        reduction.l_wk        = {reduction_size, 1, 1};
+        reduction.g_wk        = {
+            (static_cast<std::size_t>(wei_size) + reduction_size - 1) / reduction_size *
+                reduction_size,
+            1,
+            1};
+        result.construction_params.push_back(reduction);
+
+        result.invoker_factory = [=](const std::vector<Kernel>& kernels) {
+            return [=](const Handle& handle, const AnyInvokeParams& primitive_parameters) {
+                const auto& invoke_params = primitive_parameters.CastTo<conv::WrWInvokeParams>();
+                const auto& tensors       = invoke_params.tensors;
+
+                if(invoke_params.workSpace == nullptr || invoke_params.workSpaceSize < ws_sz)
+                    MIOPEN_THROW(
+                        "Not enough workspace for ConvHipImplicitGemmWrwV4R4XdlopsDynamic");
+
+                float elapsed = 0;
+
+                RunXdlopsDynamicKernel(handle,
+                                       kernels[0],
+                                       tensors.x,
+                                       tensors.dy,
+                                       tensors.dw,
+                                       geometry,
+                                       invoke_params.workSpace);
+                if(handle.IsProfilingEnabled())
+                    elapsed += handle.GetKernelTime();
+
+                handle.Run(kernels[1])(
+                    tensors.dw, invoke_params.workSpace, wei_size, gemm_k_blocks);
+                if(handle.IsProfilingEnabled())
+                {
+                    elapsed += handle.GetKernelTime();
+                    handle.ResetKernelTime();
+                    handle.AccumKernelTime(elapsed);
+                }
+            };
+        };
+    }
+    else if(ctx.direction.IsBackwardWrW())
+    {
+        result.invoker_factory = [geometry, gemm_k_blocks](const std::vector<Kernel>& kernels) {
+            return [=](const Handle& handle, const AnyInvokeParams& primitive_parameters) {
+                const auto& tensors = primitive_parameters.CastTo<conv::WrWInvokeParams>().tensors;
+                RunXdlopsDynamicSplitKernel(
+                    handle, gemm_k_blocks, tensors.dwDesc, tensors.dw, [&]() {
+                        RunXdlopsDynamicKernel(handle,
+                                               kernels[0],
+                                               tensors.x,
+                                               tensors.dy,
+                                               tensors.dw,
+                                               geometry,
+                                               nullptr);
+                    });
+            };
+        };
+    }
+    else
+    {
+        result.invoker_factory = [geometry, gemm_k_blocks](const std::vector<Kernel>& kernels) {
+            return [=](const Handle& handle, const AnyInvokeParams& primitive_parameters) {
+                const auto& tensors = primitive_parameters.CastTo<conv::DataInvokeParams>().tensors;
+                // For backward data, tensors.in is dy and tensors.out is dx, which is the order
+                // the backward kernel takes them in.
+                RunXdlopsDynamicSplitKernel(
+                    handle, gemm_k_blocks, tensors.outDesc, tensors.out, [&]() {
+                        RunXdlopsDynamicKernel(
+                            handle, kernels[0], tensors.in, tensors.w, tensors.out, geometry);
+                    });
+            };
+        };
+    }
+    return result;
+}
+
+} // namespace
+
+bool ConvHipImplicitGemmForwardV4R4XdlopsDynamic::IsApplicable(const ConvolutionContext& ctx) const
+{
+    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_HIP_FWD_V4R4_XDLOPS_DYNAMIC{}))
+        return false;
+
+    if(!ctx.direction.IsForward())
+        return false;
+
+    return IsXdlopsDynamicApplicable(ctx);
+}
+
+ConvSolution ConvHipImplicitGemmForwardV4R4XdlopsDynamic::GetSolution(
+    const ConvolutionContext& ctx, const PerformanceImplicitGemmFwdV4R4XdlopsDynamic& config, bool)
+    const
+{
+    const auto gemm = GetXdlopsDynamicFwdGemm(ctx);
+
+    return GetXdlopsDynamicSolution(
+        ctx,
+        "gridwise_convolution_forward_implicit_gemm_v4r4_xdlops_dynamic_nchw_kcyx_nkhw",
+        gemm.g,
+        gemm.m,
+        gemm.n,
+        config.GemmKBlocks);
+}
+
+PerformanceImplicitGemmFwdV4R4XdlopsDynamic::PerformanceImplicitGemmFwdV4R4XdlopsDynamic(
+    int GemmKBlocks_)
+    : GemmKBlocks(GemmKBlocks_)
+{
+}
+
+namespace {
+// clang-format off
+auto FwdXdlopsDynamicPerfFieldRules()
+{
+    return seq::MakeRuleSet(
+        std::make_tuple(seq::TwoPowersSpan<int, 1, 64>{}, &PerformanceImplicitGemmFwdV4R4XdlopsDynamic::GemmKBlocks)
+    );
+}
+// clang-format on
+} // namespace
+
+/// The output is not split by default: the zeroing kernel and the atomics cost more than
+/// the idle CUs when many calls are queued. With the latency preference fp32 splits the
+/// reduction until the grid fills the CUs, the same way as backward weights.
+void PerformanceImplicitGemmFwdV4R4XdlopsDynamic::EuristicInit(const ConvolutionContext& ctx)
+{
+    GemmKBlocks = 1;
+    if(!ctx.IsFp32() || !ctx.conv_problem.GetConv().prefer_latency)
+        return;
+
+    const auto gemm      = GetXdlopsDynamicFwdGemm(ctx);
+    const auto& tile     = SelectXdlopsDynamicTile(ctx, gemm.g, gemm.m, gemm.n);
+    const auto grid_size = GetXdlopsDynamicGridSize(tile, gemm.g, gemm.m, gemm.n);
+    const auto cu_count  = static_cast<int>(ctx.GetStream().GetMaxComputeUnits());
+
+    while(GemmKBlocks < 64 && grid_size * GemmKBlocks < cu_count &&
+          gemm.k >= 2 * GemmKBlocks * 4 * tile.gemm_k_per_block)
+        GemmKBlocks *= 2;
+}
+
+bool PerformanceImplicitGemmFwdV4R4XdlopsDynamic::IsValidValue() const
+{
+    return FwdXdlopsDynamicPerfFieldRules().IsIn(*this);
+}
+
+bool PerformanceImplicitGemmFwdV4R4XdlopsDynamic::SetNextValue()
+{
+    return !FwdXdlopsDynamicPerfFieldRules().Next(*this);
+}
+
+bool PerformanceImplicitGemmFwdV4R4XdlopsDynamic::IsValid(const ConvolutionContext& ctx) const
+{
+    if(!IsValidValue())
+        return false;
+    if(GemmKBlocks == 1)
+        return true;
+
+    // There are no atomic adds of bfloat16, and fp16 ones add pairs of elements.
+    if(ctx.IsBfp16())
+        return false;
+
+    const auto out_image_size = ConvolutionContextInterpreter::GetOutputHeightHo(ctx) *
+                                ConvolutionContextInterpreter::GetOutputWidthWo(ctx);
+    if(ctx.IsFp16() && out_image_size % 2 != 0)
+        return false;
+
+    const auto gemm = GetXdlopsDynamicFwdGemm(ctx);
+
+    // Splitting only pays off when the grid alone leaves CUs idle.
+    const auto& tile    = SelectXdlopsDynamicTile(ctx, gemm.g, gemm.m, gemm.n);
+    const auto cu_count = static_cast<int>(ctx.GetStream().GetMaxComputeUnits());
+    if(GetXdlopsDynamicGridSize(tile, gemm.g, gemm.m, gemm.n) >= cu_count)
+        return false;
+
+    return gemm.k >= GemmKBlocks * tile.gemm_k_per_block;
+}
+
+bool PerformanceImplicitGemmFwdV4R4XdlopsDynamic::
+operator==(const PerformanceImplicitGemmFwdV4R4XdlopsDynamic& other) const
+{
+    return GemmKBlocks == other.GemmKBlocks;
+}
+
+std::string PerformanceImplicitGemmFwdV4R4XdlopsDynamic::ToString() const
+{
+    std::ostringstream ss;
+    Serialize(ss);
+    return ss.str();
+}
+
+PerformanceImplicitGemmFwdV4R4XdlopsDynamic
+ConvHipImplicitGemmForwardV4R4XdlopsDynamic::GetPerformanceConfig(
+    const ConvolutionContext& ctx) const
+{
+    PerformanceImplicitGemmFwdV4R4XdlopsDynamic config;
+    config.EuristicInit(ctx);
+    MIOPEN_LOG_I(config.ToString());
+    return config;
+}
+
+bool ConvHipImplicitGemmForwardV4R4XdlopsDynamic::IsValidPerformanceConfig(
+    const ConvolutionContext& ctx, const PerformanceImplicitGemmFwdV4R4XdlopsDynamic& c) const
+{
+    return c.IsValid(ctx);
+}
+
+PerformanceImplicitGemmFwdV4R4XdlopsDynamic
+ConvHipImplicitGemmForwardV4R4XdlopsDynamic::Search(const ConvolutionContext& ctx,
+                                                    const AnyInvokeParams& invoke_ctx) const
+{
+    return GenericSearch(*this, ctx, invoke_ctx);
+}
+
+bool ConvHipImplicitGemmBwdDataV4R1XdlopsDynamic::IsApplicable(const ConvolutionContext& ctx) const
+{
+    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_HIP_BWD_V4R1_XDLOPS_DYNAMIC{}))
+        return false;
+
+    if(!ctx.direction.IsBackwardData())
+        return false;
+
+    return IsXdlopsDynamicApplicable(ctx);
+}
+
+ConvSolution
+ConvHipImplicitGemmBwdDataV4R1XdlopsDynamic::GetSolution(const ConvolutionContext& ctx) const
+{
+    const auto gemm_g = ctx.group_counts;
+    const auto gemm_m = ConvolutionContextInterpreter::GetInputChannelC(ctx) / gemm_g;
+    const auto gemm_n = ConvolutionContextInterpreter::GetBatchN(ctx) *
+                        ConvolutionContextInterpreter::GetInputHeightHi(ctx) *
+                        ConvolutionContextInterpreter::GetInputWidthWi(ctx);
+
+    return GetXdlopsDynamicSolution(
+        ctx,
+        "gridwise_convolution_backward_data_implicit_gemm_v4r1_xdlops_dynamic_nchw_kcyx_nkhw",
+        gemm_g,
+        gemm_m,
+        gemm_n);
+}
+
+PerformanceImplicitGemmWrwV4R4XdlopsDynamic::PerformanceImplicitGemmWrwV4R4XdlopsDynamic(
+    int GemmKBlocks_)
+    : GemmKBlocks(GemmKBlocks_)
+{
+}
+
+namespace {
+// clang-format off
+auto WrwXdlopsDynamicPerfFieldRules()
+{
+    return seq::MakeRuleSet(
+        std::make_tuple(seq::TwoPowersSpan<int, 1, 64>{}, &PerformanceImplicitGemmWrwV4R4XdlopsDynamic::GemmKBlocks)
+    );
+}
+// clang-format on
+} // namespace
+
+void PerformanceImplicitGemmWrwV4R4XdlopsDynamic::EuristicInit(const ConvolutionContext& ctx)
+{
+    GemmKBlocks = GetXdlopsDynamicWrwKBlocks(ctx);
+}
+
+bool PerformanceImplicitGemmWrwV4R4XdlopsDynamic::IsValidValue() const
+{
+    return WrwXdlopsDynamicPerfFieldRules().IsIn(*this);
+}
+
+bool PerformanceImplicitGemmWrwV4R4XdlopsDynamic::SetNextValue()
+{
+    return !WrwXdlopsDynamicPerfFieldRules().Next(*this);
+}
+
+bool PerformanceImplicitGemmWrwV4R4XdlopsDynamic::IsValid(const ConvolutionContext& ctx) const
+{
+    if(!IsValidValue())
+        return false;
+    if(GemmKBlocks == 1)
+        return true;
+
+    const auto gemm = GetXdlopsDynamicWrwGemm(ctx);
+
+    if(ctx.conv_problem.IsDeterministic())
+    {
+        // The workspace only has room for the partial results of the heuristic.
+        if(GemmKBlocks > GetXdlopsDynamicWrwKBlocks(ctx))
+            return false;
+    }
+    else
+    {
+        // There are no atomic adds of bfloat16, and fp16 ones add pairs of elements.
+        if(ctx.IsBfp16())
+            return false;
+        if(ctx.IsFp16() && gemm.n % 2 != 0)
+            return false;
+    }
+
+    const auto& tile = SelectXdlopsDynamicTile(ctx, gemm.g, gemm.m, gemm.n);
+    return gemm.k >= GemmKBlocks * tile.gemm_k_per_block;
+}
+
+bool PerformanceImplicitGemmWrwV4R4XdlopsDynamic::
+operator==(const PerformanceImplicitGemmWrwV4R4XdlopsDynamic& other) const
+{
+    return GemmKBlocks == other.GemmKBlocks;
+}
+
+std::string PerformanceImplicitGemmWrwV4R4XdlopsDynamic::ToString() const
+{
+    std::ostringstream ss;
+    Serialize(ss);
+    return ss.str();
+}
+
+PerformanceImplicitGemmWrwV4R4XdlopsDynamic
+ConvHipImplicitGemmWrwV4R4XdlopsDynamic::GetPerformanceConfig(const ConvolutionContext& ctx) const
+{
+    PerformanceImplicitGemmWrwV4R4XdlopsDynamic config;
+    config.EuristicInit(ctx);
+    MIOPEN_LOG_I(config.ToString());
+    return config;
+}
+
+bool ConvHipImplicitGemmWrwV4R4XdlopsDynamic::IsValidPerformanceConfig(
+    const ConvolutionContext& ctx, const PerformanceImplicitGemmWrwV4R4XdlopsDynamic& c) const
+{
+    return c.IsValid(ctx);
+}
+
+PerformanceImplicitGemmWrwV4R4XdlopsDynamic
+ConvHipImplicitGemmWrwV4R4XdlopsDynamic::Search(const ConvolutionContext& ctx,
+                                                const AnyInvokeParams& invoke_ctx) const
+{
+    return GenericSearch(*this, ctx, invoke_ctx);
+}
+
+size_t
+ConvHipImplicitGemmWrwV4R4XdlopsDynamic::GetWorkspaceSize(const ConvolutionContext& ctx) const
+{
+    // Does not depend on the config, configs with fewer K blocks leave a part of it unused.
+    if(!ctx.conv_problem.IsDeterministic())
+        return 0;
+
+    const auto k_blocks = GetXdlopsDynamicWrwKBlocks(ctx);
+    if(k_blocks == 1)
+        return 0;
+
+    const auto gemm = GetXdlopsDynamicWrwGemm(ctx);
+    return static_cast<std::size_t>(gemm.g) * gemm.m * gemm.n * k_blocks * sizeof(float);
+}
+
+bool ConvHipImplicitGemmWrwV4R4XdlopsDynamic::IsApplicable(const ConvolutionContext& ctx) const
+{
+    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_HIP_WRW_V4R4_XDLOPS_DYNAMIC{}))
+        return false;
+
+    if(!ctx.direction.IsBackwardWrW())
+        return false;
+
+    return IsXdlopsDynamicApplicable(ctx);
+}
+
+ConvSolution ConvHipImplicitGemmWrwV4R4XdlopsDynamic::GetSolution(
+    const ConvolutionContext& ctx, const PerformanceImplicitGemmWrwV4R4XdlopsDynamic& config, bool)
+    const
+{
+    const auto gemm = GetXdlopsDynamicWrwGemm(ctx);
+
+    auto solution = GetXdlopsDynamicSolution(
+        ctx,
+        "gridwise_convolution_backward_weights_implicit_gemm_v4r4_xdlops_dynamic_nchw_kcyx_nkhw",
+        gemm.g,
+        gemm.m,
+        gemm.n,
+        config.GemmKBlocks);
+    solution.workspce_sz = GetWorkspaceSize(ctx);
+    return solution;
+}
+
+} // namespace solver
+} // namespace miopen
@@ -255,7 +255,12 @@ bool ConvOclDirectFwd::IsValidPerformanceConfig(
     const auto mlo_lds_max_size = 65536;
     //    MIOPEN_LOG_I("((mlo_in_lcl_sz + mlo_weights_sz) * sizeof_float)=" << ((mlo_in_lcl_sz +
     //    mlo_weights_sz) * sizeof_float));
-    if(((mlo_in_lcl_sz + mlo_weights_sz) * sizeof_float) > mlo_lds_max_size)
+    if(searched_params.lds_double_buffer != 0 && searched_params.lds_double_buffer != 1)
+    {
+        return false;
+    }
+    const auto mlo_lds_n_buffers = searched_params.lds_double_buffer + 1;
+    if(((mlo_in_lcl_sz + mlo_weights_sz) * mlo_lds_n_buffers * sizeof_float) > mlo_lds_max_size)
     {
         return false; // NOLINT
     }
@@ -413,7 +418,10 @@ inline ConvSolution BaseGetSolution(const ConvolutionContext& params,
         + std::string(" -DMLO_N_READ_PROCS=") +
         std::to_string(static_cast<long long>(n_read_procs)) + std::string(" -DMLO_ALU_VTILE0=") +
         std::to_string(static_cast<long long>(alu_tile0)) + std::string(" -DMLO_ALU_VTILE1=") +
-        std::to_string(static_cast<long long>(alu_tile1)) + params.general_compile_options;
+        std::to_string(static_cast<long long>(alu_tile1)) +
+        std::string(" -DMLO_LDS_DOUBLE_BUFFER=") +
+        std::to_string(static_cast<long long>(searched_params.lds_double_buffer)) +
+        params.general_compile_options;
 
     if(group_counts >= 2)
     {
@@ -506,9 +506,9 @@ ConvOclDirectFwdLegacyExhaustiveSearch::SearchImpl(const ConvolutionContext& par
     }
     else
     {
-        MIOPEN_LOG_W("Searching the best solution in the 9 dim space. Please, be patient...");
+        MIOPEN_LOG_W("Searching the best solution in the 10 dim space. Please, be patient...");
         runs_left = /*n_grp_tiles * */ n_tiles_cnt * out_pix_tl_cnt * out_pix_tl_cnt * n_out_tls *
-                    n_in_tls * stack_cnt;
+                    n_in_tls * stack_cnt * 2;
         total_runs = runs_left;
 
         // tile1
@@ -603,60 +603,69 @@ ConvOclDirectFwdLegacyExhaustiveSearch::SearchImpl(const ConvolutionContext& par
                                         continue;
                                     }
 
-                                    const auto ret =
-                                        MeasurePerfConfig<Tgpu, ConvOclDirectFwd>(profile_h,
-                                                                                  bot_ocl_ptr,
-                                                                                  top_ocl_ptr,
-                                                                                  wei_ocl_ptr,
-                                                                                  bias_ocl_ptr,
-                                                                                  processing_time,
-                                                                                  params,
-                                                                                  result);
-
-                                    --runs_left;
-                                    if(ret != 0)
+                                    // Each layout is tried with one and with two LDS
+                                    // buffers.
+                                    for(int db = 0; db < 2; ++db)
                                     {
-                                        ++failed_counter;
-                                        continue;
-                                    }
+                                        result.lds_double_buffer = db;
+
+                                        const auto ret =
+                                            MeasurePerfConfig<Tgpu, ConvOclDirectFwd>(
+                                                profile_h,
+                                                bot_ocl_ptr,
+                                                top_ocl_ptr,
+                                                wei_ocl_ptr,
+                                                bias_ocl_ptr,
+                                                processing_time,
+                                                params,
+                                                result);
 
-                                    is_passed = true;
-                                    MIOPEN_LOG_T("##(n_current, n_failed, n_runs_total): "
-                                                 << run_counter
-                                                 << " / "
-                                                 << failed_counter
-                                                 << " / "
-                                                 << total_runs
-                                                 << " elapsed_time: "
-                                                 << processing_time
-                                                 << " best_time: "
-                                                 << processing_time
-                                                 << ", "
-                                                 << result);
-
-                                    if(processing_time < min_proc_time)
-                                    {
-                                        MIOPEN_LOG_I('#' << run_counter << ' ' << processing_time
-                                                         << " < "
-                                                         << min_proc_time
-                                                         << ' '
-                                                         << result);
-                                        min_proc_time = processing_time;
-                                        candidate     = result;
-                                    }
-
-                                    if(run_counter % report_inteval == 0)
-                                    {
-                                        MIOPEN_LOG_W("Runs left: " << runs_left << ", "
-                                                                   << "min time so far: "
-                                                                   << min_proc_time
-                                                                   << ", "
-                                                                   << "curr time: "
-                                                                   << processing_time
-                                                                   << ' '
-                                                                   << result);
+                                        --runs_left;
+                                        if(ret != 0)
+                                        {
+                                            ++failed_counter;
+                                            continue;
+                                        }
+
+                                        is_passed = true;
+                                        MIOPEN_LOG_T("##(n_current, n_failed, n_runs_total): "
+                                                     << run_counter
+                                                     << " / "
+                                                     << failed_counter
+                                                     << " / "
+                                                     << total_runs
+                                                     << " elapsed_time: "
+                                                     << processing_time
+                                                     << " best_time: "
+                                                     << processing_time
+                                                     << ", "
+                                                     << result);
+
+                                        if(processing_time < min_proc_time)
+                                        {
+                                            MIOPEN_LOG_I('#' << run_counter << ' '
+                                                             << processing_time
+                                                             << " < "
+                                                             << min_proc_time
+                                                             << ' '
+                                                             << result);
+                                            min_proc_time = processing_time;
+                                            candidate     = result;
+                                        }
+
+                                        if(run_counter % report_inteval == 0)
+                                        {
+                                            MIOPEN_LOG_W("Runs left: " << runs_left << ", "
+                                                                       << "min time so far: "
+                                                                       << min_proc_time
+                                                                       << ", "
+                                                                       << "curr time: "
+                                                                       << processing_time
+                                                                       << ' '
+                                                                       << result);
+                                        }
+                                        run_counter++;
                                     }
-                                    run_counter++;
                                 }
                             }
                         }
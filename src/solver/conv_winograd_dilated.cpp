@@ -0,0 +1,329 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+
+#include <miopen/solver.hpp>
+
+#include <miopen/conv/data_invoke_params.hpp>
+#include <miopen/env.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/kernel_build_params.hpp>
+#include <miopen/tensor.hpp>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_AMD_WINOGRAD_DILATED)
+
+namespace miopen {
+namespace solver {
+
+namespace {
+
+constexpr std::size_t local_size = 256;
+
+/// Geometry in forward naming: x is N x C x Hi x Wi, y is N x K x Ho x Wo.
+///
+/// With stride 1 a dilated convolution splits into dilation_h * dilation_w independent
+/// undilated convolutions over interleaved sub-grids of x and y. The sub-grids are batched
+/// along N, so the sub-problem is a single unpadded stride-1 convolution.
+struct SubGridGeometry
+{
+    int n, c, hi, wi, k, ho, wo, y, x;
+    int dilation_h, dilation_w, pad_h, pad_w;
+
+    int GetSubGrids() const { return dilation_h * dilation_w; }
+    /// y sub-grid sizes. Sub-grids of the trailing residues may end with dropped rows (columns).
+    int GetSubHo() const { return (ho + dilation_h - 1) / dilation_h; }
+    int GetSubWo() const { return (wo + dilation_w - 1) / dilation_w; }
+    /// x sub-grid sizes, just enough for an unpadded convolution to produce GetSubHo/Wo().
+    int GetSubHi() const { return GetSubHo() + y - 1; }
+    int GetSubWi() const { return GetSubWo() + x - 1; }
+
+    TensorDescriptor GetSubX(miopenDataType_t type) const
+    {
+        return {type,
+                {static_cast<std::size_t>(n * GetSubGrids()),
+                 static_cast<std::size_t>(c),
+                 static_cast<std::size_t>(GetSubHi()),
+                 static_cast<std::size_t>(GetSubWi())}};
+    }
+
+    TensorDescriptor GetSubY(miopenDataType_t type) const
+    {
+        return {type,
+                {static_cast<std::size_t>(n * GetSubGrids()),
+                 static_cast<std::size_t>(k),
+                 static_cast<std::size_t>(GetSubHo()),
+                 static_cast<std::size_t>(GetSubWo())}};
+    }
+};
+
+SubGridGeometry GetSubGridGeometry(const ConvolutionContext& ctx)
+{
+    const auto& problem = ctx.conv_problem;
+    // For backward data conv_problem keeps dy as "in" and dx as "out".
+    const auto& x_desc = ctx.direction.IsForward() ? problem.GetIn() : problem.GetOut();
+    const auto& y_desc = ctx.direction.IsForward() ? problem.GetOut() : problem.GetIn();
+    int n, c, hi, wi, k, ho, wo;
+    std::tie(n, c, hi, wi) = tien<4>(x_desc.GetLengths());
+    std::tie(std::ignore, k, ho, wo) = tien<4>(y_desc.GetLengths());
+
+    return {n,
+            c,
+            hi,
+            wi,
+            k,
+            ho,
+            wo,
+            static_cast<int>(problem.GetWeightsHeight()),
+            static_cast<int>(problem.GetWeightsWidth()),
+            problem.GetDilationH(),
+            problem.GetDilationW(),
+            problem.GetPadH(),
+            problem.GetPadW()};
+}
+
+/// The undilated problem solved by the inner Winograd solver. Shares the execution
+/// environment and the compile options of the original context.
+ConvolutionContext GetSubGridContext(const ConvolutionContext& ctx, const SubGridGeometry& geometry)
+{
+    const auto type = ctx.in_data_type;
+    auto sub_ctx    = ConvolutionContext{geometry.GetSubX(type),
+                                      ctx.conv_problem.GetWeights(),
+                                      geometry.GetSubY(type),
+                                      ConvolutionDescriptor{{0, 0}, {1, 1}, {1, 1}},
+                                      ctx.conv_problem.GetDirection()};
+    static_cast<ExecutionContext&>(sub_ctx) = ctx;
+    sub_ctx.general_compile_options         = ctx.general_compile_options;
+    return sub_ctx;
+}
+
+std::size_t GetSubGridWorkspaceSize(const ConvolutionContext& ctx)
+{
+    const auto geometry = GetSubGridGeometry(ctx);
+    const auto type     = ctx.in_data_type;
+    return geometry.GetSubX(type).GetElementSpace() * GetTypeSize(type) +
+           geometry.GetSubY(type).GetElementSpace() * GetTypeSize(type);
+}
+
+/// Kernel that splits a full tensor into its sub-grids or merges them back. The x sub-grids
+/// carry the padding, the y ones are aligned with y.
+KernelInfo GetSubGridKernel(const ConvolutionContext& ctx,
+                            const SubGridGeometry& geometry,
+                            bool split,
+                            bool is_x)
+{
+    const auto channels = is_x ? geometry.c : geometry.k;
+    const auto h        = is_x ? geometry.hi : geometry.ho;
+    const auto w        = is_x ? geometry.wi : geometry.wo;
+    const auto sub_h    = is_x ? geometry.GetSubHi() : geometry.GetSubHo();
+    const auto sub_w    = is_x ? geometry.GetSubWi() : geometry.GetSubWo();
+    const auto pad_h    = is_x ? geometry.pad_h : 0;
+    const auto pad_w    = is_x ? geometry.pad_w : 0;
+
+    const auto build_params = KernelBuildParameters{
+        {"SG_N", geometry.n},
+        {"SG_C", channels},
+        {"SG_H", h},
+        {"SG_W", w},
+        {"SG_HS", sub_h},
+        {"SG_WS", sub_w},
+        {"SG_DILATION_H", geometry.dilation_h},
+        {"SG_DILATION_W", geometry.dilation_w},
+        {"SG_PAD_H", pad_h},
+        {"SG_PAD_W", pad_w},
+    };
+
+    const auto work_size = static_cast<std::size_t>(geometry.n) * channels *
+                           (split ? geometry.GetSubGrids() * sub_h * sub_w : h * w);
+
+    KernelInfo kernel;
+    kernel.kernel_file  = "MIOpenConvDilatedSubGrid.cl";
+    kernel.kernel_name  = split ? "MIOpenConvDilatedSubGridSplit" : "MIOpenConvDilatedSubGridMerge";
+    kernel.comp_options = build_params.GenerateFor(kbp::OpenCL{}) + ctx.general_compile_options;
+    kernel.l_wk         = {local_size, 1, 1};
+    kernel.g_wk         = {((work_size + local_size - 1) / local_size) * local_size, 1, 1};
+    return kernel;
+}
+
+template <class Inner>
+bool IsSubGridApplicable(const Inner& inner, const ConvolutionContext& ctx)
+{
+#if MIOPEN_BACKEND_HIP
+    if(miopen::IsDisabled(MIOPEN_DEBUG_AMD_WINOGRAD_DILATED{}))
+        return false;
+    if(!ctx.use_opencl_convolutions)
+        return false;
+    if(!(ctx.direction.IsForward() || ctx.direction.IsBackwardData()))
+        return false;
+    if(!ctx.Is2d() || !ctx.IsLayoutDefault())
+        return false;
+    if(!(ctx.IsFp32() || ctx.IsFp16()))
+        return false;
+
+    const auto& problem = ctx.conv_problem;
+    if(!problem.GetIn().IsPacked() || !problem.GetWeights().IsPacked() ||
+       !problem.GetOut().IsPacked())
+        return false;
+    if(problem.GetGroupCount() != 1 || problem.GetBias() != 0)
+        return false;
+    if(problem.GetKernelStrideH() != 1 || problem.GetKernelStrideW() != 1)
+        return false;
+    if(ctx.IsAsymmetricPadH() || ctx.IsAsymmetricPadW())
+        return false;
+    // Undilated problems are served by the inner solver directly.
+    if(problem.GetDilationH() == 1 && problem.GetDilationW() == 1)
+        return false;
+
+    const auto geometry = GetSubGridGeometry(ctx);
+    if(geometry.ho < 1 || geometry.wo < 1)
+        return false;
+
+    return inner.IsApplicable(GetSubGridContext(ctx, geometry));
+#else
+    (void)inner;
+    (void)ctx;
+    return false;
+#endif
+}
+
+template <class Inner>
+ConvSolution GetSubGridSolution(const Inner& inner, const ConvolutionContext& ctx)
+{
+#if MIOPEN_BACKEND_HIP
+    const auto geometry    = GetSubGridGeometry(ctx);
+    const auto sub_ctx     = GetSubGridContext(ctx, geometry);
+    const auto type        = ctx.in_data_type;
+    const auto sub_x_desc  = geometry.GetSubX(type);
+    const auto sub_y_desc  = geometry.GetSubY(type);
+    const auto sub_x_bytes = sub_x_desc.GetElementSpace() * GetTypeSize(type);
+    const auto is_forward  = ctx.direction.IsForward();
+
+    const auto inner_solution = inner.GetSolution(sub_ctx);
+    if(!inner_solution.Succeeded())
+        return inner_solution;
+    if(!inner_solution.invoker_factory)
+        MIOPEN_THROW("Winograd solver for the dilated sub-grids has no invoker.");
+
+    // Forward splits x and merges y, backward data splits dy and merges dx.
+    const auto split = GetSubGridKernel(ctx, geometry, true, is_forward);
+    const auto merge = GetSubGridKernel(ctx, geometry, false, !is_forward);
+
+    ConvSolution result;
+    result.workspce_sz = GetSubGridWorkspaceSize(ctx);
+    result.construction_params.push_back(split);
+    result.construction_params.insert(result.construction_params.end(),
+                                      inner_solution.construction_params.begin(),
+                                      inner_solution.construction_params.end());
+    result.construction_params.push_back(merge);
+
+    // In forward naming the sub-grid x lives at the start of the workspace and y after it.
+    // The sub-problem keeps the direction, so its "in" and "out" swap for backward data.
+    const auto sub_in_desc    = is_forward ? sub_x_desc : sub_y_desc;
+    const auto sub_out_desc   = is_forward ? sub_y_desc : sub_x_desc;
+    const auto sub_in_offset  = is_forward ? 0 : sub_x_bytes;
+    const auto sub_out_offset = is_forward ? sub_x_bytes : 0;
+    const auto inner_factory  = *inner_solution.invoker_factory;
+    const auto workspace_size = result.workspce_sz;
+
+    result.invoker_factory = [=](const std::vector<Kernel>& kernels) {
+        const auto inner_invoker =
+            inner_factory(std::vector<Kernel>(kernels.begin() + 1, kernels.end() - 1));
+        const auto split_kernel = kernels.front();
+        const auto merge_kernel = kernels.back();
+
+        return [=](const Handle& handle, const AnyInvokeParams& primitive_parameters) {
+            const auto& invoke_params = primitive_parameters.CastTo<conv::DataInvokeParams>();
+            const auto& tensors       = invoke_params.tensors;
+            if(invoke_params.workSpace == nullptr || invoke_params.workSpaceSize < workspace_size)
+                MIOPEN_THROW("Not enough workspace for dilated Winograd sub-grids.");
+
+            const auto workspace = static_cast<char*>(invoke_params.workSpace);
+            const auto sub_in    = static_cast<void*>(workspace + sub_in_offset);
+            const auto sub_out   = static_cast<void*>(workspace + sub_out_offset);
+
+            float elapsed = 0.f;
+            handle.Run(split_kernel)(tensors.in, sub_in);
+            if(handle.IsProfilingEnabled())
+                elapsed += handle.GetKernelTime();
+
+            const auto sub_tensors = ConvDataTensors{
+                sub_in_desc, sub_in, tensors.wDesc, tensors.w, sub_out_desc, sub_out};
+            const auto sub_params =
+                conv::DataInvokeParams{invoke_params.type, sub_tensors, nullptr, 0};
+            inner_invoker(handle, sub_params);
+            if(handle.IsProfilingEnabled())
+                elapsed += handle.GetKernelTime();
+
+            handle.Run(merge_kernel)(sub_out, tensors.out);
+            if(handle.IsProfilingEnabled())
+            {
+                elapsed += handle.GetKernelTime();
+                handle.ResetKernelTime();
+                handle.AccumKernelTime(elapsed);
+            }
+        };
+    };
+    return result;
+#else
+    (void)inner;
+    (void)ctx;
+    MIOPEN_THROW(miopenStatusBadParm, "Dilated Winograd sub-grids are supported on HIP only.");
+#endif
+}
+
+} // namespace
+
+bool ConvBinWinogradRxSDilated::IsApplicable(const ConvolutionContext& ctx) const
+{
+    return IsSubGridApplicable(ConvBinWinogradRxS{}, ctx);
+}
+
+size_t ConvBinWinogradRxSDilated::GetWorkspaceSize(const ConvolutionContext& ctx) const
+{
+    return GetSubGridWorkspaceSize(ctx);
+}
+
+ConvSolution ConvBinWinogradRxSDilated::GetSolution(const ConvolutionContext& ctx) const
+{
+    return GetSubGridSolution(ConvBinWinogradRxS{}, ctx);
+}
+
+bool ConvBinWinogradRxSf3x2Dilated::IsApplicable(const ConvolutionContext& ctx) const
+{
+    return IsSubGridApplicable(ConvBinWinogradRxSf3x2{}, ctx);
+}
+
+size_t ConvBinWinogradRxSf3x2Dilated::GetWorkspaceSize(const ConvolutionContext& ctx) const
+{
+    return GetSubGridWorkspaceSize(ctx);
+}
+
+ConvSolution ConvBinWinogradRxSf3x2Dilated::GetSolution(const ConvolutionContext& ctx) const
+{
+    return GetSubGridSolution(ConvBinWinogradRxSf3x2{}, ctx);
+}
+
+} // namespace solver
+} // namespace miopen
@@ -528,6 +528,11 @@ static inline bool IsValidBlockwiseGemmXdlops(const ConvolutionContext& ctx,
     if(ctx.IsBfp16() && GemmKPack % 2 != 0)
         return false;
 
+    // int8 xdlops only come as 32x32 and 16x16 k-reduction, with 4 values packed per register
+    if(ctx.IsInt8() && !(GemmKPack % 4 == 0 && GemmMPerWave == GemmNPerWave &&
+                         (GemmMPerWave == 32 || GemmMPerWave == 16)))
+        return false;
+
     // check M, N and K
     std::vector<std::tuple<int, int, int>> validWaveGemmSize = {// std::make_tuple(128, 128, 1),
                                                                 std::make_tuple(128, 64, 1),
@@ -705,6 +710,10 @@ int amd_buffer_load_max_length()
     {
         return 8;
     }
+    else if(std::is_same<int8_t, T>())
+    {
+        return 16;
+    }
     else
     {
         MIOPEN_LOG_I("not implemented");
@@ -723,6 +732,10 @@ int amd_buffer_store_max_length()
     {
         return 8;
     }
+    else if(std::is_same<int8_t, T>())
+    {
+        return 16;
+    }
     else
     {
         MIOPEN_LOG_I("not implemented");
@@ -741,6 +754,10 @@ int amd_lds_read_max_length()
     {
         return 8;
     }
+    else if(std::is_same<int8_t, T>())
+    {
+        return 16;
+    }
     else
     {
         MIOPEN_LOG_I("not implemented");
@@ -759,6 +776,10 @@ int amd_lds_write_max_length()
     {
         return 8;
     }
+    else if(std::is_same<int8_t, T>())
+    {
+        return 16;
+    }
     else
     {
         MIOPEN_LOG_I("not implemented");
@@ -0,0 +1,225 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/solver_applicability.hpp>
+
+#include <miopen/any_solver.hpp>
+#include <miopen/env.hpp>
+#include <miopen/solver.hpp>
+#include <miopen/stringutils.hpp>
+
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_APPLICABILITY_INDEX)
+
+namespace miopen {
+namespace solver {
+namespace applicability {
+
+static unsigned GetDirectionBit(const ConvolutionContext& ctx)
+{
+    if(ctx.direction.IsForward())
+        return Fwd;
+    return ctx.direction.IsBackwardData() ? Bwd : WrW;
+}
+
+static unsigned GetDimsBit(int spatial_dims)
+{
+    return spatial_dims == 2 ? Dims2 : spatial_dims == 3 ? Dims3 : OtherDims;
+}
+
+// Unlike the input and output, the weights are not swapped for the backward directions, so
+// their type is taken.
+static unsigned GetTypeBit(miopenDataType_t type)
+{
+    switch(type)
+    {
+    case miopenFloat: return Fp32;
+    case miopenHalf: return Fp16;
+    case miopenBFloat16: return Bfp16;
+    case miopenInt8: return Int8;
+    case miopenInt8x4:
+    case miopenInt32: break;
+    }
+    return OtherTypes;
+}
+
+static unsigned GetFamilyBit(const std::string& device)
+{
+    if(StartsWith(device, "gfx8"))
+        return Gfx8;
+    if(StartsWith(device, "gfx9"))
+        return Gfx9;
+    if(StartsWith(device, "gfx10"))
+        return Gfx10;
+    return OtherFamilies;
+}
+
+Key Key::From(const ConvolutionContext& ctx)
+{
+    // Without a handle the device is unknown and any family is admitted.
+    const auto any_family = Gfx8 | Gfx9 | Gfx10 | OtherFamilies;
+    Key key;
+    key.direction    = GetDirectionBit(ctx);
+    key.type         = GetTypeBit(ctx.weights_data_type);
+    key.spatial_dims = GetDimsBit(ctx.spatial_dims);
+    key.family       = ctx.HasStream() ? GetFamilyBit(ctx.GetStream().GetDeviceName()) : any_family;
+    key.grouped      = ctx.group_counts != 1;
+    return key;
+}
+
+int Key::Encode() const
+{
+    return static_cast<int>(direction | (type << 3) | (spatial_dims << 8) | (family << 11) |
+                            (grouped ? 1u << 15 : 0u));
+}
+
+struct ProblemResults
+{
+    std::mutex mutex;
+    std::unordered_map<std::string, bool> by_solver;
+};
+
+static std::mutex& GetMemoMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+static std::unordered_map<std::string, std::shared_ptr<ProblemResults>>& GetMemo()
+{
+    static std::unordered_map<std::string, std::shared_ptr<ProblemResults>> memo;
+    return memo;
+}
+
+static std::string GetProblemKey(const ConvolutionContext& ctx)
+{
+    std::ostringstream ss;
+    ctx.Serialize(ss);
+    ss << ' ' << ctx.weights_layout << ' ' << ctx.out_layout;
+    ss << ' ' << ctx.conv_problem.GetConv().mode << ctx.conv_problem.GetConv().paddingMode;
+    // Packedness is not a part of the db key.
+    for(const auto* tensor :
+        {&ctx.conv_problem.GetIn(), &ctx.conv_problem.GetWeights(), &ctx.conv_problem.GetOut()})
+    {
+        ss << ' ';
+        for(const auto stride : tensor->GetStrides())
+            ss << stride << ',';
+    }
+    const auto& handle = ctx.GetStream();
+    ss << ' ' << handle.GetDeviceName() << ':' << handle.GetMaxComputeUnits();
+    ss << ' ' << ctx.use_asm_kernels << ctx.use_hip_kernels << ctx.use_opencl_convolutions
+       << ctx.use_binaries << ctx.rmv.getValue()
+       << ctx.skip_solutions_that_take_long_time_to_build_and_have_narrow_coverage
+       << ctx.use_dynamic_solutions_only;
+    return ss.str();
+}
+
+Memo::Memo(const ConvolutionContext& ctx)
+    : key(Key::From(ctx)),
+      enabled(!miopen::IsDisabled(MIOPEN_DEBUG_CONV_APPLICABILITY_INDEX{}) && ctx.HasStream())
+{
+    if(!enabled)
+        return;
+    const auto problem = GetProblemKey(ctx);
+    std::lock_guard<std::mutex> lock(GetMemoMutex());
+    auto& memo       = GetMemo();
+    const auto found = memo.find(problem);
+    if(found != memo.end())
+    {
+        results = found->second;
+        return;
+    }
+    // The memos still holding the dropped results keep them.
+    if(memo.size() >= max_problems)
+        memo.clear();
+    results = std::make_shared<ProblemResults>();
+    memo.emplace(problem, results);
+}
+
+bool Memo::IsApplicable(const AnySolver& solver, const ConvolutionContext& ctx) const
+{
+    if(!enabled)
+        return solver.IsApplicable(ctx);
+    return IsApplicableImpl(solver.GetApplicabilityTraits(), solver.GetSolverDbId(), [&]() {
+        return solver.IsApplicable(ctx);
+    });
+}
+
+bool Memo::IsApplicableImpl(const Traits& traits,
+                            const std::string& solver,
+                            const std::function<bool()>& is_applicable) const
+{
+    if(!enabled)
+        return is_applicable();
+    if(!traits.Admits(key))
+        return false;
+    {
+        std::lock_guard<std::mutex> lock(results->mutex);
+        const auto found = results->by_solver.find(solver);
+        if(found != results->by_solver.end())
+            return found->second;
+    }
+    // Solvers are checked outside of the lock, two threads may check the same one.
+    const auto result = is_applicable();
+    std::lock_guard<std::mutex> lock(results->mutex);
+    results->by_solver.emplace(solver, result);
+    return result;
+}
+
+void ClearMemo()
+{
+    std::lock_guard<std::mutex> lock(GetMemoMutex());
+    GetMemo().clear();
+}
+
+const std::vector<Id>& GetCandidateIds(const Key& key)
+{
+    static std::mutex mutex;
+    static std::unordered_map<int, std::vector<Id>> index;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto encoded = key.Encode();
+    const auto found   = index.find(encoded);
+    if(found != index.end())
+        return found->second;
+
+    const auto use_traits = !miopen::IsDisabled(MIOPEN_DEBUG_CONV_APPLICABILITY_INDEX{});
+    std::vector<Id> ids;
+    for(const auto& id : GetAllIds())
+    {
+        const auto solver = id.GetSolver();
+        if(!use_traits || solver.IsEmpty() || solver.GetApplicabilityTraits().Admits(key))
+            ids.push_back(id);
+    }
+    return index.emplace(encoded, std::move(ids)).first->second;
+}
+
+} // namespace applicability
+} // namespace solver
+} // namespace miopen
@@ -0,0 +1,104 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+// Build time tool that stores a file as a miopen::PagedImage for embedding into the library.
+//
+//     miopen_db_compress <input> <output> [page size]
+//
+// The page size defaults to 32 KiB, a few pages of the system db for each stored page.
+
+#include <miopen/paged_image.hpp>
+
+#include <bzlib.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+// The page itself when bzip2 doesn't make it smaller.
+std::string CompressPage(const std::string& page)
+{
+    std::string result = page;
+    auto len           = static_cast<unsigned int>(result.size());
+    std::string input  = page;
+    const auto e =
+        BZ2_bzBuffToBuffCompress(&result[0], &len, &input[0], input.size(), 9, 0, 30);
+    if(e == BZ_OUTBUFF_FULL)
+        return page;
+    if(e != BZ_OK)
+        throw std::runtime_error("BZ2_bzBuffToBuffCompress failed: " + std::to_string(e));
+    result.resize(len);
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if(argc != 3 && argc != 4)
+    {
+        std::cerr << "Usage: " << argv[0] << " <input> <output> [page size]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    const auto page_size = argc == 4 ? std::strtoul(argv[3], nullptr, 10) : 32 * 1024ul;
+    if(page_size == 0)
+    {
+        std::cerr << "Invalid page size: " << argv[3] << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::ifstream in(argv[1], std::ios::binary);
+    if(!in)
+    {
+        std::cerr << "Unable to open " << argv[1] << std::endl;
+        return EXIT_FAILURE;
+    }
+    const std::string file{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+
+    try
+    {
+        const auto image = miopen::PagedImage::Make(file, page_size, CompressPage);
+        std::ofstream out(argv[2], std::ios::binary);
+        out.write(image.data(), image.size());
+        if(!out)
+        {
+            std::cerr << "Unable to write " << argv[2] << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << argv[1] << ": " << file.size() << " -> " << image.size() << " bytes"
+                  << std::endl;
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -34,7 +34,10 @@
 **    freeonclose=  If true, then sqlite3_free() is called on the ptr=
 **                  value when the connection closes.
 **
-** The ptr= and sz= query parameters are required.  If maxsz= is omitted,
+**    pager=        The address of a miopen_memvfs_pager that supplies the
+**                  pages of a read-only database, in place of ptr=.
+**
+** The ptr= (or pager=) and sz= query parameters are required.  If maxsz= is omitted,
 ** then it defaults to the sz= value.  Parameter values can be in either
 ** decimal or hexadecimal.  The filename in the URI is ignored.
 */
@@ -44,6 +47,7 @@ extern "C" {
 SQLITE_EXTENSION_INIT1
 #include <string.h>
 #include <assert.h>
+#include <miopen/memvfs_pager.h>
 
 /*
 ** Forward declaration of objects used by this utility
@@ -59,11 +63,12 @@ typedef struct MemFile MemFile;
 /* An open file */
 struct MemFile
 {
-    sqlite3_file base;    /* IO methods */
-    sqlite3_int64 sz;     /* Size of the file */
-    sqlite3_int64 szMax;  /* Space allocated to aData */
-    unsigned char* aData; /* content of the file */
-    int bFreeOnClose;     /* Invoke sqlite3_free() on aData at close */
+    sqlite3_file base;                 /* IO methods */
+    sqlite3_int64 sz;                  /* Size of the file */
+    sqlite3_int64 szMax;               /* Space allocated to aData */
+    unsigned char* aData;              /* content of the file */
+    int bFreeOnClose;                  /* Invoke sqlite3_free() on aData at close */
+    const miopen_memvfs_pager* pPager; /* Pages of a read-only file, replaces aData */
 };
 
 /*
@@ -71,6 +76,7 @@ struct MemFile
 */
 static int memClose(sqlite3_file*);
 static int memRead(sqlite3_file*, void*, int iAmt, sqlite3_int64 iOfst);
+static int memPagerRead(MemFile*, unsigned char*, int iAmt, sqlite3_int64 iOfst);
 static int memWrite(sqlite3_file*, const void*, int iAmt, sqlite3_int64 iOfst);
 static int memTruncate(sqlite3_file*, sqlite3_int64 size);
 static int memSync(sqlite3_file*, int flags);
@@ -163,12 +169,46 @@ static int memClose(sqlite3_file* pFile)
     return SQLITE_OK;
 }
 
+/*
+** Read data from an mem-file served by a pager. A read may span pages.
+*/
+static int memPagerRead(MemFile* p, unsigned char* zBuf, int iAmt, sqlite_int64 iOfst)
+{
+    const miopen_memvfs_pager* pPager = p->pPager;
+    while(iAmt > 0)
+    {
+        if(iOfst >= p->sz)
+        {
+            /* SQLite requires the unread part of the buffer to be zero filled */
+            memset(zBuf, 0, iAmt);
+            return SQLITE_IOERR_SHORT_READ;
+        }
+        sqlite3_int64 iPage        = iOfst / pPager->page_size;
+        int iInPage                = (int)(iOfst % pPager->page_size);
+        int n                      = pPager->page_size - iInPage;
+        const unsigned char* aPage = pPager->page(pPager->ctx, iPage);
+        if(aPage == 0)
+            return SQLITE_IOERR_READ;
+        if(n > iAmt)
+            n = iAmt;
+        if(iOfst + n > p->sz)
+            n = (int)(p->sz - iOfst);
+        memcpy(zBuf, aPage + iInPage, n);
+        zBuf += n;
+        iAmt -= n;
+        iOfst += n;
+    }
+    return SQLITE_OK;
+}
+
 /*
 ** Read data from an mem-file.
 */
 static int memRead(sqlite3_file* pFile, void* zBuf, int iAmt, sqlite_int64 iOfst)
 {
     MemFile* p = (MemFile*)pFile;
+    if(p->pPager)
+        return memPagerRead(p, (unsigned char*)zBuf, iAmt, iOfst);
     memcpy(zBuf, p->aData + iOfst, iAmt);
     return SQLITE_OK;
 }
@@ -179,6 +219,8 @@ static int memRead(sqlite3_file* pFile, void* zBuf, int iAmt, sqlite_int64 iOfst
 static int memWrite(sqlite3_file* pFile, const void* z, int iAmt, sqlite_int64 iOfst)
 {
     MemFile* p = (MemFile*)pFile;
+    if(p->pPager)
+        return SQLITE_READONLY;
     if(iOfst + iAmt > p->sz)
     {
         if(iOfst + iAmt > p->szMax)
@@ -197,6 +239,8 @@ static int memWrite(sqlite3_file* pFile, const void* z, int iAmt, sqlite_int64 i
 static int memTruncate(sqlite3_file* pFile, sqlite_int64 size)
 {
     MemFile* p = (MemFile*)pFile;
+    if(p->pPager)
+        return SQLITE_READONLY;
     if(size > p->sz)
     {
         if(size > p->szMax)
@@ -248,7 +292,12 @@ static int memFileControl(sqlite3_file* pFile, int op, void* pArg)
 {
     MemFile* p = (MemFile*)pFile;
     int rc     = SQLITE_NOTFOUND;
-    if(op == SQLITE_FCNTL_VFSNAME)
+    if(op == SQLITE_FCNTL_VFSNAME && p->pPager)
+    {
+        *(char**)pArg = sqlite3_mprintf("mem(pager %p,%lld)", p->pPager, p->sz);
+        rc            = SQLITE_OK;
+    }
+    else if(op == SQLITE_FCNTL_VFSNAME)
     {
         *(char**)pArg = sqlite3_mprintf("mem(%p,%lld)", p->aData, p->sz);
         rc            = SQLITE_OK;
@@ -292,7 +341,21 @@ static int memShmUnmap(sqlite3_file* pFile, int deleteFlag) { return SQLITE_OK;
 static int memFetch(sqlite3_file* pFile, sqlite3_int64 iOfst, int iAmt, void** pp)
 {
     MemFile* p = (MemFile*)pFile;
-    *pp        = (void*)(p->aData + iOfst);
+    if(p->pPager)
+    {
+        /* Only a range within one page is contiguous, SQLite reads the rest with xRead */
+        const miopen_memvfs_pager* pPager = p->pPager;
+        int iInPage                       = (int)(iOfst % pPager->page_size);
+        *pp                               = 0;
+        if(iInPage + iAmt <= pPager->page_size && iOfst + iAmt <= p->sz)
+        {
+            const unsigned char* aPage = pPager->page(pPager->ctx, iOfst / pPager->page_size);
+            if(aPage != 0)
+                *pp = (void*)(aPage + iInPage);
+        }
+        return SQLITE_OK;
+    }
+    *pp = (void*)(p->aData + iOfst);
     return SQLITE_OK;
 }
 
@@ -309,8 +372,9 @@ memOpen(sqlite3_vfs* pVfs, const char* zName, sqlite3_file* pFile, int flags, in
     memset(p, 0, sizeof(*p));
     if((flags & SQLITE_OPEN_MAIN_DB) == 0)
         return SQLITE_CANTOPEN;
-    p->aData = (unsigned char*)sqlite3_uri_int64(zName, "ptr", 0);
-    if(p->aData == 0)
+    p->aData  = (unsigned char*)sqlite3_uri_int64(zName, "ptr", 0);
+    p->pPager = (const miopen_memvfs_pager*)sqlite3_uri_int64(zName, "pager", 0);
+    if(p->aData == 0 && (p->pPager == 0 || p->pPager->page_size <= 0))
         return SQLITE_CANTOPEN;
     p->sz = sqlite3_uri_int64(zName, "sz", 0);
     if(p->sz < 0)
@@ -536,7 +600,9 @@ __declspec(dllexport)
 {
     int rc = SQLITE_OK;
     SQLITE_EXTENSION_INIT2(pApi);
-    mem_vfs.pAppData = sqlite3_vfs_find(0);
+    /* Called for every new connection, once registered memvfs is the default VFS itself */
+    if(mem_vfs.pAppData == 0)
+        mem_vfs.pAppData = sqlite3_vfs_find(0);
     mem_vfs.szOsFile = sizeof(MemFile);
     rc               = sqlite3_vfs_register(&mem_vfs, 1);
 #ifdef MEMVFS_TEST
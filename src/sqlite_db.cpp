@@ -24,7 +24,9 @@
  *
  *******************************************************************************/
 #include <miopen/sqlite_db.hpp>
+#include <miopen/db_path.hpp>
 #include <miopen/db_record.hpp>
+#include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/lock_file.hpp>
 #include <miopen/logger.hpp>
@@ -32,6 +34,8 @@
 #include <miopen/problem_description.hpp>
 
 #if MIOPEN_EMBED_DB
+#include <miopen/memvfs_pager.h>
+#include <miopen/paged_image.hpp>
 #include <miopen_data.hpp>
 #endif
 #include <boost/date_time/posix_time/posix_time_types.hpp>
@@ -42,22 +46,82 @@
 
 #include <memory>
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
+#include <condition_variable>
 #include <cstdio>
 #include <fstream>
 #include <ios>
+#include <map>
 #include <mutex>
+#include <set>
 #include <shared_mutex>
 #include <string>
+#include <vector>
 
 extern "C" {
 int miopen_sqlite3_memvfs_init(sqlite3* db, char** pzErrMsg, const sqlite3_api_routines* pApi);
 }
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_SQLITE_WAL)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_PERFDB_WRITE_BEHIND_MS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_SQLITE_READ_CONNECTIONS)
+
 namespace miopen {
 
 class SQLite::impl
 {
+    /// User databases with write-behind transactions. A background thread commits
+    /// transactions older than the write-behind interval. The registry is never destroyed,
+    /// so that databases held by static objects may unregister at exit.
+    struct WriteBehindRegistry
+    {
+        std::mutex mutex;
+        std::set<impl*> dbs;
+        bool flusher_started = false;
+
+        static WriteBehindRegistry& Get()
+        {
+            static auto* const registry = new WriteBehindRegistry{}; // NOLINT
+            return *registry;
+        }
+
+        void Add(impl* db)
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            dbs.insert(db);
+            if(flusher_started || SQLitePerfDb::WriteBehindInterval().count() == 0)
+                return;
+            flusher_started = true;
+            std::thread{[this]() {
+                const auto interval = SQLitePerfDb::WriteBehindInterval();
+                while(true)
+                {
+                    std::this_thread::sleep_for(interval);
+                    Flush(interval);
+                }
+            }}.detach();
+        }
+
+        void Remove(impl* db)
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            dbs.erase(db);
+        }
+
+        void Flush(std::chrono::milliseconds min_age)
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            for(auto db : dbs)
+            {
+                std::lock_guard<std::mutex> db_lock{db->write_mutex};
+                if(db->in_transaction &&
+                   std::chrono::steady_clock::now() - db->transaction_start >= min_age)
+                    db->Commit();
+            }
+        }
+    };
+
     struct SQLiteCloser
     {
         void operator()(sqlite3* ptr)
@@ -73,6 +137,52 @@ class SQLite::impl
     };
     using sqlite3_ptr = std::unique_ptr<sqlite3, SQLiteCloser>;
 #if MIOPEN_EMBED_DB
+    /// Compressed embedded db, served to memvfs page by page.
+    struct EmbeddedPagedDb
+    {
+        PagedImage image;
+        miopen_memvfs_pager pager;
+
+        EmbeddedPagedDb(const char* begin, const char* end)
+            : image(begin, static_cast<std::size_t>(end - begin)),
+              pager{this, static_cast<int>(image.GetPageSize()), Page}
+        {
+        }
+
+        static const unsigned char* Page(void* ctx, long long index)
+        {
+            const auto& db = *static_cast<EmbeddedPagedDb*>(ctx);
+            try
+            {
+                return db.image.GetPage(index);
+            }
+            catch(const std::exception& ex)
+            {
+                MIOPEN_LOG_E("Unable to read page " << index << " of the embedded db: "
+                                                    << ex.what());
+                return nullptr;
+            }
+        }
+
+        /// Connections may be open until exit, so the images are never destroyed.
+        static const EmbeddedPagedDb&
+        Get(const std::string& name, const char* begin, const char* end)
+        {
+            static std::mutex mutex;
+            static auto& dbs = *new std::map<std::string, std::unique_ptr<EmbeddedPagedDb>>{};
+            std::lock_guard<std::mutex> lock(mutex);
+            auto& db = dbs[name];
+            if(db == nullptr)
+            {
+                db = std::make_unique<EmbeddedPagedDb>(begin, end);
+                MIOPEN_LOG_I2("Embedded db " << name << ": " << db->image.GetPageCount()
+                                             << " compressed pages, " << db->image.GetSize()
+                                             << " bytes");
+            }
+            return *db;
+        }
+    };
+
     int CreateInMemDb(const boost::filesystem::path& filepath, bool is_system)
     {
         sqlite3* ptr_tmp = nullptr;
@@ -99,8 +209,20 @@ class SQLite::impl
             }
             const auto& p    = it_p->second;
             ptrdiff_t ptr_sz = p.second - p.first;
-            char* memuri     = sqlite3_mprintf(
-                "file:ignoredFilename?ptr=0x%p&sz=%lld", p.first, static_cast<long long>(ptr_sz));
+            char* memuri     = nullptr;
+            if(PagedImage::IsPagedImage(p.first, ptr_sz))
+            {
+                const auto& db = EmbeddedPagedDb::Get(it_p->first, p.first, p.second);
+                memuri         = sqlite3_mprintf("file:ignoredFilename?pager=0x%p&sz=%lld",
+                                         &db.pager,
+                                         static_cast<long long>(db.image.GetSize()));
+            }
+            else
+            {
+                memuri = sqlite3_mprintf("file:ignoredFilename?ptr=0x%p&sz=%lld",
+                                         p.first,
+                                         static_cast<long long>(ptr_sz));
+            }
             if(sqlite3_open_v2(
                    memuri, &ptr_tmp, SQLITE_OPEN_READWRITE | SQLITE_OPEN_URI, nullptr) != SQLITE_OK)
             {
@@ -161,7 +283,7 @@ class SQLite::impl
     }
 
     public:
-    impl(const std::string& filename_, bool is_system)
+    impl(const std::string& filename_, bool is_system) : filename(filename_)
     {
         boost::filesystem::path filepath(filename_);
         int rc = 0;
@@ -172,10 +294,76 @@ class SQLite::impl
 #endif
         sqlite3_busy_timeout(ptrDb.get(), MIOPEN_SQL_BUSY_TIMEOUT_MS);
         isValid = (rc == 0);
+        // An in-memory user database is private to its connection.
+        readers_enabled = isValid && (!InMemDb || is_system) && MaxReaders() > 0;
+#if !MIOPEN_EMBED_DB
+        if(isValid && !is_system)
+        {
+            // WAL lets readers proceed while a write-behind transaction is open
+            // and syncs the disk less often than the rollback journal.
+            if(SQLitePerfDb::WriteBehindInterval().count() > 0 &&
+               !IsDisabled(MIOPEN_DEBUG_SQLITE_WAL{}))
+                Exec("PRAGMA journal_mode=WAL; PRAGMA synchronous=NORMAL;");
+            WriteBehindRegistry::Get().Add(this);
+            registered = true;
+        }
+#endif
+    }
+
+    impl(const impl&) = delete;
+    impl& operator=(const impl&) = delete;
+
+    ~impl()
+    {
+        if(registered)
+            WriteBehindRegistry::Get().Remove(this);
+        std::lock_guard<std::mutex> lock{write_mutex};
+        if(in_transaction)
+            Commit();
+    }
+
+    /// Executes the query, logging instead of throwing when it fails.
+    bool Exec(const char* query)
+    {
+        char* err = nullptr;
+        if(sqlite3_exec(ptrDb.get(), query, nullptr, nullptr, &err) == SQLITE_OK)
+            return true;
+        MIOPEN_LOG_W("SQLite: " << query << ": " << (err != nullptr ? err : ""));
+        sqlite3_free(err);
+        return false;
+    }
+
+    /// write_mutex shall be held.
+    void Commit()
+    {
+        in_transaction = false;
+        if(!Exec("COMMIT;"))
+            Exec("ROLLBACK;");
     }
 
     sqlite3_ptr ptrDb = nullptr;
     bool isValid;
+    bool registered = false;
+
+    std::mutex write_mutex;
+    bool in_transaction = false;
+    std::chrono::steady_clock::time_point transaction_start;
+
+    static void FlushAll() { WriteBehindRegistry::Get().Flush(std::chrono::milliseconds{0}); }
+
+    static std::size_t MaxReaders()
+    {
+        return Value(MIOPEN_DEBUG_SQLITE_READ_CONNECTIONS{}, std::thread::hardware_concurrency());
+    }
+
+    std::string filename;
+
+    // The pool of SQLite::Reader. The readers are opened as system databases, i.e. read-only
+    // and without write-behind.
+    std::atomic<bool> readers_enabled{false};
+    std::mutex readers_mutex;
+    std::vector<std::unique_ptr<SQLite>> free_readers;
+    std::size_t reader_count = 0;
 };
 
 static int find_callback(void* _res, int argc, char** argv, char** azColName)
@@ -190,6 +378,7 @@ static int find_callback(void* _res, int argc, char** argv, char** azColName)
 }
 
 SQLite::SQLite() : pImpl(nullptr) {}
+SQLite::SQLite(std::unique_ptr<impl> pImpl_) : pImpl(std::move(pImpl_)) {}
 SQLite::~SQLite()                 = default;
 SQLite::SQLite(SQLite&&) noexcept = default;
 SQLite& SQLite::operator=(SQLite&&) noexcept = default;
@@ -231,6 +420,89 @@ int SQLite::Retry(std::function<int()> f) const
     return SQLite::Retry(f, filename);
 }
 
+void SQLite::WriteBehind(const std::function<void()>& write,
+                         std::chrono::milliseconds interval) const
+{
+    if(interval.count() == 0 || !pImpl->registered)
+    {
+        write();
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock{pImpl->write_mutex};
+    if(!pImpl->in_transaction)
+    {
+        // IMMEDIATE takes the write lock right away, waiting for other writers if needed.
+        if(!pImpl->Exec("BEGIN IMMEDIATE;"))
+        {
+            write();
+            return;
+        }
+        pImpl->in_transaction    = true;
+        pImpl->transaction_start = std::chrono::steady_clock::now();
+    }
+    write();
+    if(std::chrono::steady_clock::now() - pImpl->transaction_start >= interval)
+        pImpl->Commit();
+}
+
+void SQLite::Flush() const
+{
+    if(pImpl == nullptr)
+        return;
+    std::lock_guard<std::mutex> lock{pImpl->write_mutex};
+    if(pImpl->in_transaction)
+        pImpl->Commit();
+}
+
+void SQLite::FlushAll() { impl::FlushAll(); }
+
+SQLite::Reader::Reader(const SQLite& sql_) : sql(sql_)
+{
+    auto& db = *sql.pImpl;
+    if(!db.readers_enabled)
+        return;
+    if(db.registered)
+    {
+        std::lock_guard<std::mutex> lock{db.write_mutex};
+        if(db.in_transaction)
+            return;
+    }
+    {
+        std::lock_guard<std::mutex> lock{db.readers_mutex};
+        if(!db.free_readers.empty())
+        {
+            connection = std::move(db.free_readers.back());
+            db.free_readers.pop_back();
+            return;
+        }
+        if(db.reader_count >= impl::MaxReaders())
+            return;
+        ++db.reader_count;
+    }
+
+    // Opened without holding the lock, as it touches the disk.
+    auto reader = std::make_unique<impl>(db.filename, true);
+    if(!reader->isValid)
+    {
+        MIOPEN_LOG_W("Unable to open a read connection to " << db.filename);
+        db.readers_enabled = false;
+        std::lock_guard<std::mutex> lock{db.readers_mutex};
+        --db.reader_count;
+        return;
+    }
+    connection = std::unique_ptr<SQLite>{new SQLite{std::move(reader)}};
+}
+
+SQLite::Reader::~Reader()
+{
+    if(connection == nullptr)
+        return;
+    auto& db = *sql.pImpl;
+    std::lock_guard<std::mutex> lock{db.readers_mutex};
+    db.free_readers.push_back(std::move(connection));
+}
+
 int SQLite::Changes() const { return sqlite3_changes(pImpl->ptrDb.get()); }
 
 std::string SQLite::ErrorMessage() const
@@ -336,6 +608,11 @@ int SQLite::Statement::BindInt64(int idx, const int64_t num)
     return 0;
 }
 
+std::chrono::milliseconds SQLitePerfDb::WriteBehindInterval()
+{
+    return std::chrono::milliseconds{Value(MIOPEN_DEBUG_PERFDB_WRITE_BEHIND_MS{}, 0)};
+}
+
 SQLitePerfDb::SQLitePerfDb(const std::string& filename_,
                            bool is_system,
                            const std::string& arch_,
@@ -420,5 +697,68 @@ SQLitePerfDb::SQLitePerfDb(const std::string& filename_,
             dbInvalid = true;
         }
     }
+    if(!dbInvalid)
+    {
+        hashed = CheckTableColumns(ProblemDescription::table_name(), {"hash"});
+        if(!hashed && !is_system)
+            AddConfigHashes();
+    }
+    // A device with a CU count the system db has not been tuned for gets the records of the
+    // nearest one. The configs are validated for the actual device as they are loaded.
+    if(is_system && !dbInvalid)
+    {
+        auto available   = std::vector<std::size_t>{};
+        const auto query = "SELECT DISTINCT num_cu FROM perf_db WHERE arch = '" + arch + "';";
+        for(const auto& row : sql.Exec(query))
+            available.push_back(std::stoull(row.at("num_cu")));
+        const auto nearest = GetNearestNumCu(num_cu, available);
+        if(nearest != num_cu)
+        {
+            MIOPEN_LOG_W("No " << arch << " records for " << num_cu << " CUs in " << filename
+                               << ", using the ones for "
+                               << nearest);
+            num_cu = nearest;
+        }
+    }
+}
+
+void SQLitePerfDb::AddConfigHashes()
+{
+    const auto table = ProblemDescription::table_name();
+    const auto names = ProblemDescription{conv::Direction::Forward}.FieldNames();
+
+    // Waits for another process that adds them at the same time.
+    sql.Exec("BEGIN IMMEDIATE;");
+    try
+    {
+        if(!CheckTableColumns(table, {"hash"}))
+        {
+            sql.Exec("ALTER TABLE `" + table + "` ADD COLUMN `hash` INT NOT NULL DEFAULT 0;");
+            for(const auto& row : sql.Exec("SELECT * FROM `" + table + "`;"))
+            {
+                auto values = std::vector<std::string>{};
+                for(const auto& name : names)
+                    values.push_back(row.at(name));
+                const auto hash = std::to_string(ProblemDescription::HashValues(values));
+                auto stmt       = SQLite::Statement{
+                    sql, "UPDATE `" + table + "` SET hash = ? WHERE id = ?;", {hash, row.at("id")}};
+                if(stmt.Step(sql) != SQLITE_DONE)
+                    MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+            }
+            // The index of the hashes replaces the one over all the fields.
+            sql.Exec("CREATE INDEX IF NOT EXISTS `idx_" + table + "_hash` ON " + table +
+                     "( hash );");
+            sql.Exec("DROP INDEX IF EXISTS `idx_" + table + "`;");
+            MIOPEN_LOG_I("Added the problem hashes to " << filename);
+        }
+        sql.Exec("COMMIT;");
+        hashed = true;
+    }
+    catch(const Exception& ex)
+    {
+        // The lookups without the hash still work, only slower.
+        MIOPEN_LOG_W("Unable to add the problem hashes to " << filename << ": " << ex.what());
+        sql.Exec("ROLLBACK;");
+    }
 }
 } // namespace miopen
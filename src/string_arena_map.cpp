@@ -0,0 +1,139 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/string_arena_map.hpp>
+#include <miopen/errors.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace miopen {
+
+void StringArenaMap::Reserve(std::size_t entry_count, std::size_t text_bytes)
+{
+    text.reserve(text_bytes);
+    entries.reserve(entry_count);
+    auto slot_count = std::size_t{16};
+    while(slot_count < 2 * entry_count)
+        slot_count *= 2;
+    if(slot_count > slots.size())
+        Rehash(slot_count);
+}
+
+bool StringArenaMap::Emplace(const char* key,
+                             std::size_t key_size,
+                             const char* value,
+                             std::size_t value_size)
+{
+    const auto hash = Hash(key, key_size);
+    if(FindImpl(key, key_size, hash) != npos)
+        return false;
+
+    constexpr auto max_offset = std::numeric_limits<std::uint32_t>::max();
+    if(text.size() + key_size + value_size > max_offset || entries.size() + 1 >= max_offset)
+        MIOPEN_THROW("String arena map is over 4 GB");
+
+    // Keep the load factor at or below 1/2 so that probe sequences stay short.
+    if(2 * (entries.size() + 1) > slots.size())
+        Rehash(std::max<std::size_t>(16, 2 * slots.size()));
+
+    entries.push_back({hash,
+                       static_cast<std::uint32_t>(text.size()),
+                       static_cast<std::uint32_t>(key_size),
+                       static_cast<std::uint32_t>(value_size)});
+    text.insert(text.end(), key, key + key_size);
+    text.insert(text.end(), value, value + value_size);
+
+    const auto mask = slots.size() - 1;
+    auto slot       = hash & mask;
+    while(slots[slot] != 0)
+        slot = (slot + 1) & mask;
+    slots[slot] = static_cast<std::uint32_t>(entries.size());
+    return true;
+}
+
+std::size_t StringArenaMap::Find(const std::string& key) const
+{
+    return FindImpl(key.data(), key.size(), Hash(key.data(), key.size()));
+}
+
+std::string StringArenaMap::GetKey(std::size_t index) const
+{
+    const auto& entry = entries.at(index);
+    return {text.data() + entry.text_offset, entry.key_size};
+}
+
+std::string StringArenaMap::GetValue(std::size_t index) const
+{
+    const auto& entry = entries.at(index);
+    return {text.data() + entry.text_offset + entry.key_size, entry.value_size};
+}
+
+std::uint32_t StringArenaMap::Hash(const char* str, std::size_t size)
+{
+    // FNV-1a
+    auto hash = std::uint32_t{2166136261U};
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= static_cast<unsigned char>(str[i]);
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+std::size_t
+StringArenaMap::FindImpl(const char* key, std::size_t key_size, std::uint32_t hash) const
+{
+    if(slots.empty())
+        return npos;
+
+    const auto mask = slots.size() - 1;
+    for(auto slot = hash & mask; slots[slot] != 0; slot = (slot + 1) & mask)
+    {
+        const auto index  = slots[slot] - 1;
+        const auto& entry = entries[index];
+        if(entry.hash == hash && entry.key_size == key_size &&
+           std::memcmp(text.data() + entry.text_offset, key, key_size) == 0)
+            return index;
+    }
+    return npos;
+}
+
+void StringArenaMap::Rehash(std::size_t slot_count)
+{
+    slots.assign(slot_count, 0);
+    const auto mask = slot_count - 1;
+    for(std::size_t i = 0; i < entries.size(); ++i)
+    {
+        auto slot = entries[i].hash & mask;
+        while(slots[slot] != 0)
+            slot = (slot + 1) & mask;
+        slots[slot] = static_cast<std::uint32_t>(i + 1);
+    }
+}
+
+} // namespace miopen
@@ -139,6 +139,43 @@ std::size_t TensorDescriptor::GetNumBytes() const
 
 bool TensorDescriptor::IsPacked() const { return this->packed; }
 
+std::string TensorDescriptor::GetLayout(std::string labels) const
+{
+    if(labels.size() != lens.size())
+        MIOPEN_THROW(miopenStatusInternalError,
+                     "Layout labels " + labels + " do not match tensor dimensions");
+
+    // Dimensions of length 1 do not change any address, so only the others are ordered by
+    // stride. Each one of length 1 is then put right after its logical predecessor, which
+    // keeps e.g. an NHWC tensor with H = W = 1 reported as the default NCHW.
+    std::vector<std::size_t> order;
+    for(std::size_t i = 0; i < lens.size(); ++i)
+        if(lens[i] != 1)
+            order.push_back(i);
+    std::stable_sort(order.begin(), order.end(), [&](auto l, auto r) {
+        return strides[l] > strides[r];
+    });
+    for(std::size_t i = 0; i < lens.size(); ++i)
+    {
+        if(lens[i] != 1)
+            continue;
+        const auto pred = (i == 0) ? order.end() : std::find(order.begin(), order.end(), i - 1);
+        order.insert(pred == order.end() ? order.begin() : std::next(pred), i);
+    }
+
+    std::string result;
+    for(auto i : order)
+        result += labels[i];
+    return result;
+}
+
+bool TensorDescriptor::IsDefaultLayout() const
+{
+    std::string labels(lens.size(), ' ');
+    std::iota(labels.begin(), labels.end(), 'a');
+    return GetLayout(labels) == labels;
+}
+
 bool TensorDescriptor::operator==(const TensorDescriptor& rhs) const
 {
     assert(this->lens.size() == rhs.strides.size());
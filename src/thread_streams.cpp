@@ -0,0 +1,65 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/thread_streams.hpp>
+
+#include <atomic>
+#include <unordered_map>
+
+namespace miopen {
+namespace thread_streams {
+
+static std::unordered_map<std::size_t, miopenAcceleratorQueue_t>& Overrides()
+{
+    // Only ever touched by the owning thread, no locking needed.
+    static thread_local std::unordered_map<std::size_t, miopenAcceleratorQueue_t> overrides;
+    return overrides;
+}
+
+std::size_t NewHandleId()
+{
+    static std::atomic<std::size_t> next_id{0};
+    return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+const miopenAcceleratorQueue_t* Find(std::size_t handle_id)
+{
+    const auto& overrides = Overrides();
+    if(overrides.empty())
+        return nullptr;
+    const auto it = overrides.find(handle_id);
+    return it != overrides.end() ? &it->second : nullptr;
+}
+
+void Set(std::size_t handle_id, miopenAcceleratorQueue_t stream)
+{
+    Overrides()[handle_id] = stream;
+}
+
+void Clear(std::size_t handle_id) { Overrides().erase(handle_id); }
+
+} // namespace thread_streams
+} // namespace miopen
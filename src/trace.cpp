@@ -0,0 +1,207 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/trace.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_TRACE_FILE)
+
+namespace miopen {
+namespace trace {
+
+namespace {
+
+// The GPU track, the host threads are numbered from 1 in the order of their first span.
+constexpr int gpu_tid = 0;
+
+struct Event
+{
+    std::string name;
+    const char* category;
+    std::int64_t start_ns;
+    std::int64_t duration_ns;
+    int tid;
+};
+
+void WriteString(std::ostream& os, const std::string& str)
+{
+    os << '"';
+    for(const auto c : str)
+    {
+        if(c == '"' || c == '\\')
+            os << '\\' << c;
+        else if(static_cast<unsigned char>(c) < 0x20)
+            os << ' ';
+        else
+            os << c;
+    }
+    os << '"';
+}
+
+void WriteMicroseconds(std::ostream& os, std::int64_t ns)
+{
+    os << ns / 1000 << '.' << std::setw(3) << std::setfill('0') << ns % 1000;
+}
+
+class Recorder
+{
+    public:
+    static Recorder& Get()
+    {
+        static Recorder recorder;
+        return recorder;
+    }
+
+    Recorder(const Recorder&) = delete;
+    Recorder& operator=(const Recorder&) = delete;
+    ~Recorder() { Write(); }
+
+    void Add(const char* category,
+             const std::string& name,
+             Clock::time_point start,
+             Clock::duration duration,
+             bool on_gpu)
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        if(events.size() >= max_events)
+        {
+            if(!dropping)
+                MIOPEN_LOG_W("Trace buffer is full, further spans are dropped");
+            dropping = true;
+            return;
+        }
+
+        auto tid = gpu_tid;
+        if(!on_gpu)
+        {
+            const auto next = static_cast<int>(threads.size()) + 1;
+            tid             = threads.emplace(std::this_thread::get_id(), next).first->second;
+        }
+
+        using std::chrono::duration_cast;
+        using std::chrono::nanoseconds;
+        events.push_back({name,
+                          category,
+                          duration_cast<nanoseconds>(start.time_since_epoch()).count(),
+                          duration_cast<nanoseconds>(duration).count(),
+                          tid});
+    }
+
+    private:
+    static constexpr std::size_t max_events = 1 << 22;
+
+    Recorder() = default;
+
+    void Write() const
+    {
+        if(events.empty())
+            return;
+
+        const auto path = GetStringEnv(MIOPEN_TRACE_FILE{});
+        std::ofstream file{path};
+        if(!file)
+        {
+            MIOPEN_LOG_E("Unable to write the trace to " << path);
+            return;
+        }
+
+#ifndef _WIN32
+        const auto pid = static_cast<int>(::getpid());
+#else
+        const auto pid = 0;
+#endif
+
+        file << "{\"traceEvents\":[\n";
+        file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << gpu_tid
+             << ",\"args\":{\"name\":\"GPU\"}}";
+        for(const auto& event : events)
+        {
+            file << ",\n{\"name\":";
+            WriteString(file, event.name);
+            file << ",\"cat\":\"" << event.category << "\",\"ph\":\"X\",\"ts\":";
+            WriteMicroseconds(file, event.start_ns);
+            file << ",\"dur\":";
+            WriteMicroseconds(file, event.duration_ns);
+            file << ",\"pid\":" << pid << ",\"tid\":" << event.tid << '}';
+        }
+        file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    }
+
+    std::mutex mutex;
+    std::vector<Event> events;
+    std::unordered_map<std::thread::id, int> threads;
+    bool dropping = false;
+};
+
+} // namespace
+
+bool IsEnabled()
+{
+    static const bool enabled = [] {
+        const auto path = GetStringEnv(MIOPEN_TRACE_FILE{});
+        if(path == nullptr || *path == '\0')
+            return false;
+        // Constructed before the first span, so destroyed (and written) after the last one.
+        Recorder::Get();
+        return true;
+    }();
+    return enabled;
+}
+
+void AddSpan(const char* category,
+             const std::string& name,
+             Clock::time_point start,
+             Clock::time_point end)
+{
+    if(IsEnabled())
+        Recorder::Get().Add(category, name, start, end - start, false);
+}
+
+void AddKernel(const std::string& name, float elapsed_ms)
+{
+    if(!IsEnabled())
+        return;
+    const auto duration = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<float, std::milli>{elapsed_ms});
+    Recorder::Get().Add("kernel", name, Clock::now() - duration, duration, true);
+}
+
+} // namespace trace
+} // namespace miopen
@@ -0,0 +1,68 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/transformed_weights.hpp>
+
+#include <miopen/handle.hpp>
+
+#include <atomic>
+#include <memory>
+
+namespace miopen {
+
+TransformedWeightsCache& Handle::GetTransformedWeightsCache() const
+{
+    // Of the threads sharing the handle which get here first, the first to store its cache wins.
+    auto current = std::atomic_load(&transformed_weights);
+    if(!current)
+    {
+        auto created = std::make_shared<TransformedWeightsCache>();
+        if(std::atomic_compare_exchange_strong(&transformed_weights, &current, created))
+            current = created;
+    }
+    return *current;
+}
+
+TransformedWeightsCache::Filters TransformedWeightsCache::Find(const std::string& key,
+                                                               ConstData_t weights) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto found = entries.find(key);
+    if(found == entries.end() || found->second.weights != weights)
+        return nullptr;
+    return found->second.transformed;
+}
+
+void TransformedWeightsCache::Insert(const std::string& key,
+                                     ConstData_t weights,
+                                     Filters transformed)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& entry       = entries[key];
+    entry.weights     = weights;
+    entry.transformed = std::move(transformed);
+}
+
+} // namespace miopen
@@ -0,0 +1,421 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/tuning_bundle.hpp>
+
+#include <miopen/any_solver.hpp>
+#include <miopen/db.hpp>
+#include <miopen/db_record.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/execution_context.hpp>
+#include <miopen/find_db.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/problem_description.hpp>
+#include <miopen/solver.hpp>
+#include <miopen/sqlite_db.hpp>
+
+#include <fstream>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <set>
+#include <sstream>
+#include <tuple>
+
+namespace miopen {
+
+namespace {
+
+const std::string& BundleMagic()
+{
+    static const std::string magic = "MIOpenTuningBundle";
+    return magic;
+}
+constexpr int bundle_version = 1;
+
+/// VALUES of a db record passed through as they are.
+struct RawValues
+{
+    std::string text;
+
+    void Serialize(std::ostream& stream) const { stream << text; }
+    bool Deserialize(const std::string& str)
+    {
+        text = str;
+        return true;
+    }
+};
+
+/// Db key of a bundled problem, which has no descriptors to build a ProblemDescription from.
+struct BundledProblem
+#if MIOPEN_ENABLE_SQLITE
+    : SQLiteSerializable<BundledProblem>
+#endif
+{
+    const TuningBundle::Problem& problem;
+
+    BundledProblem(const TuningBundle::Problem& problem_) : problem(problem_) {}
+
+    void Serialize(std::ostream& stream) const { stream << problem.key; }
+
+    static std::string table_name() { return ProblemDescription::table_name(); }
+
+    template <class Self>
+    static void Visit(Self&& self, std::function<void(int, std::string)> f)
+    {
+        for(const auto& field : self.problem.int_fields)
+            f(field.second, field.first);
+    }
+
+    template <class Self>
+    static void Visit(Self&& self, std::function<void(std::string, std::string)> f)
+    {
+        for(const auto& field : self.problem.text_fields)
+            f(field.second, field.first);
+    }
+};
+
+void WriteString(std::ostream& stream, const std::string& str)
+{
+    stream << str.size() << ' ';
+    stream.write(str.data(), str.size());
+    stream << '\n';
+}
+
+void WriteValue(std::ostream& stream, const std::string& value) { WriteString(stream, value); }
+void WriteValue(std::ostream& stream, int value) { WriteString(stream, std::to_string(value)); }
+
+template <class T>
+void WritePairs(std::ostream& stream, const std::vector<std::pair<std::string, T>>& pairs)
+{
+    stream << pairs.size() << '\n';
+    for(const auto& pair : pairs)
+    {
+        WriteString(stream, pair.first);
+        WriteValue(stream, pair.second);
+    }
+}
+
+class BundleReader
+{
+    public:
+    BundleReader(std::istream& stream_) : stream(stream_) {}
+
+    std::size_t ReadSize()
+    {
+        auto size = std::size_t{0};
+        if(!(stream >> size))
+            Fail();
+        return size;
+    }
+
+    std::string ReadString()
+    {
+        const auto size = ReadSize();
+        if(stream.get() != ' ')
+            Fail();
+        auto str = std::string(size, '\0');
+        if(!stream.read(&str[0], size) || stream.get() != '\n')
+            Fail();
+        return str;
+    }
+
+    void ReadValue(std::string& value) { value = ReadString(); }
+    void ReadValue(int& value)
+    {
+        auto str = std::istringstream{ReadString()};
+        if(!(str >> value))
+            Fail();
+    }
+
+    template <class T>
+    std::vector<std::pair<std::string, T>> ReadPairs()
+    {
+        auto pairs = std::vector<std::pair<std::string, T>>(ReadSize());
+        for(auto& pair : pairs)
+        {
+            pair.first = ReadString();
+            ReadValue(pair.second);
+        }
+        return pairs;
+    }
+
+    [[noreturn]] static void Fail()
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Invalid or truncated tuning bundle");
+    }
+
+    private:
+    std::istream& stream;
+};
+
+PerformanceDb GetUserPerfDb(Handle& handle)
+{
+    auto ctx = ExecutionContext{};
+    ctx.SetStream(&handle);
+#if MIOPEN_ENABLE_SQLITE
+    return {"", ctx.GetUserPerfDbPath(), handle.GetDeviceName(), handle.GetMaxComputeUnits()};
+#else
+    return {"", ctx.GetUserPerfDbPath()};
+#endif
+}
+
+/// Kernels of the find-db solutions of the problem, as the immediate mode would build them.
+std::vector<solver::KernelInfo> GetSolutionKernels(Handle& handle,
+                                                   const ProblemDescription& problem,
+                                                   const std::vector<solver::Id>& solvers)
+{
+    auto ctx = ConvolutionContext{problem};
+    ctx.SetStream(&handle);
+    ctx.disable_search_enforce = true;
+    ctx.DetectRocm();
+    ctx.SetupFloats();
+    auto db = GetDb(ctx);
+
+    auto kernels = std::vector<solver::KernelInfo>{};
+    for(const auto& solver_id : solvers)
+    {
+        // GEMM and FFT are not solvers, their kernels are not bundled.
+        if(!solver_id.IsValid() || solver_id == solver::Id::gemm() ||
+           solver_id == solver::Id::fft())
+            continue;
+        const auto solver = solver_id.GetSolver();
+        if(!solver.IsApplicable(ctx))
+            continue;
+        const auto solution = solver.FindSolution(ctx, db, {});
+        if(!solution.Succeeded())
+            continue;
+        kernels.insert(kernels.end(),
+                       solution.construction_params.begin(),
+                       solution.construction_params.end());
+    }
+    return kernels;
+}
+
+} // namespace
+
+void TuningBundle::Write(std::ostream& stream) const
+{
+    stream << BundleMagic() << ' ' << bundle_version << '\n';
+    WriteString(stream, device);
+    stream << num_cu << '\n';
+
+    stream << problems.size() << '\n';
+    for(const auto& problem : problems)
+    {
+        WriteString(stream, problem.key);
+        WritePairs(stream, problem.text_fields);
+        WritePairs(stream, problem.int_fields);
+        WritePairs(stream, problem.find_db);
+        WritePairs(stream, problem.perf_db);
+    }
+
+    stream << code_objects.size() << '\n';
+    for(const auto& code_object : code_objects)
+    {
+        WriteString(stream, code_object.program_name);
+        WriteString(stream, code_object.params);
+        stream << (code_object.is_kernel_str ? 1 : 0) << '\n';
+        WriteString(stream, code_object.blob);
+    }
+}
+
+TuningBundle TuningBundle::Read(std::istream& stream)
+{
+    auto magic   = std::string{};
+    auto version = 0;
+    if(!(stream >> magic >> version) || magic != BundleMagic())
+        BundleReader::Fail();
+    if(version != bundle_version)
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "Unsupported tuning bundle version: " + std::to_string(version));
+
+    auto reader  = BundleReader{stream};
+    auto bundle  = TuningBundle{};
+    bundle.device = reader.ReadString();
+    bundle.num_cu = reader.ReadSize();
+
+    bundle.problems.resize(reader.ReadSize());
+    for(auto& problem : bundle.problems)
+    {
+        problem.key         = reader.ReadString();
+        problem.text_fields = reader.ReadPairs<std::string>();
+        problem.int_fields  = reader.ReadPairs<int>();
+        problem.find_db     = reader.ReadPairs<std::string>();
+        problem.perf_db     = reader.ReadPairs<std::string>();
+    }
+
+    bundle.code_objects.resize(reader.ReadSize());
+    for(auto& code_object : bundle.code_objects)
+    {
+        code_object.program_name  = reader.ReadString();
+        code_object.params        = reader.ReadString();
+        code_object.is_kernel_str = reader.ReadSize() != 0;
+        code_object.blob          = reader.ReadString();
+    }
+    return bundle;
+}
+
+void ExportTuningBundle(Handle& handle,
+                        const std::vector<ProblemDescription>& problems,
+                        const std::string& path)
+{
+    MIOPEN_LOG_I("problems = " << problems.size() << ", path = " << path);
+
+    auto bundle   = TuningBundle{};
+    bundle.device = handle.GetDeviceName();
+    bundle.num_cu = handle.GetMaxComputeUnits();
+    auto programs = std::set<std::pair<std::string, std::string>>{};
+
+    for(const auto& problem : problems)
+    {
+        auto entry = TuningBundle::Problem{};
+        auto solvers = std::vector<solver::Id>{};
+        {
+            const FindDbRecord record{handle, problem};
+            // The records tuned for another batch size do not belong to this problem.
+            if(record.empty() || record.IsFromBatchBucket())
+            {
+                MIOPEN_LOG_W("No find-db record, skipped: " << problem);
+                continue;
+            }
+            for(const auto& pair : record)
+            {
+                std::ostringstream values;
+                pair.second.Serialize(values);
+                entry.find_db.emplace_back(pair.first, values.str());
+                solvers.emplace_back(pair.second.solver_id);
+            }
+        }
+
+        std::ostringstream key;
+        problem.Serialize(key);
+        entry.key = key.str();
+        ProblemDescription::Visit(problem, [&](std::string value, std::string name) {
+            entry.text_fields.emplace_back(name, value);
+        });
+        ProblemDescription::Visit(problem, [&](int value, std::string name) {
+            entry.int_fields.emplace_back(name, value);
+        });
+
+        auto ctx = ConvolutionContext{problem};
+        ctx.SetStream(&handle);
+        const auto perf_record = GetDb(ctx).FindRecord(ctx);
+        if(perf_record)
+        {
+            for(const auto& pair : perf_record->As<RawValues>())
+                entry.perf_db.emplace_back(pair.first, pair.second.text);
+        }
+
+        for(const auto& kernel : GetSolutionKernels(handle, problem, solvers))
+        {
+            // Kernels are built through the kernel cache, which prefixes the options by a space.
+            auto params = kernel.comp_options;
+            if(!params.empty() && params.front() != ' ')
+                params = " " + params;
+            if(!programs.emplace(kernel.kernel_file, params).second)
+                continue;
+
+            auto blob = handle.LoadCodeObject(kernel.kernel_file, params, false);
+            if(blob.empty())
+            {
+                handle.LoadProgram(kernel.kernel_file, params, false, "");
+                blob = handle.LoadCodeObject(kernel.kernel_file, params, false);
+            }
+            if(blob.empty())
+            {
+                MIOPEN_LOG_W("No code object of " << kernel.kernel_file << " in the binary cache, "
+                                                  << "it is not bundled");
+                continue;
+            }
+            bundle.code_objects.push_back({kernel.kernel_file, params, false, blob});
+        }
+
+        bundle.problems.push_back(entry);
+    }
+
+    std::ofstream file{path, std::ios::binary};
+    if(!file)
+        MIOPEN_THROW(miopenStatusBadParm, "Unable to create " + path);
+    bundle.Write(file);
+    if(!file.flush())
+        MIOPEN_THROW("Unable to write " + path);
+    MIOPEN_LOG_I(bundle.problems.size() << " problems and " << bundle.code_objects.size()
+                                        << " code objects written to "
+                                        << path);
+}
+
+void ImportTuningBundle(Handle& handle, const std::string& path)
+{
+    MIOPEN_LOG_I("path = " << path);
+
+    std::ifstream file{path, std::ios::binary};
+    if(!file)
+        MIOPEN_THROW(miopenStatusBadParm, "Unable to open " + path);
+    const auto bundle = TuningBundle::Read(file);
+
+    if(bundle.device != handle.GetDeviceName())
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "The tuning bundle is for " + bundle.device + ", not for " +
+                         handle.GetDeviceName());
+    // Tuning results hold for another CU count too, as the system dbs of the nearest one do.
+    if(bundle.num_cu != handle.GetMaxComputeUnits())
+        MIOPEN_LOG_W("The tuning bundle is for " << bundle.num_cu << " CUs, the device has "
+                                                 << handle.GetMaxComputeUnits());
+
+    const auto find_db_path = FindDbRecord::GetUserPath(handle);
+    if(find_db_path.empty())
+        MIOPEN_THROW(miopenStatusNotImplemented, "User databases are disabled in this build");
+    auto find_db = UserFindDb{find_db_path, false};
+    auto perf_db = GetUserPerfDb(handle);
+
+    for(const auto& problem : bundle.problems)
+    {
+        const auto key = BundledProblem{problem};
+
+        auto record = DbRecord{key};
+        for(const auto& entry : problem.find_db)
+            record.SetValues(entry.first, RawValues{entry.second});
+        if(!find_db.UpdateRecord(record))
+            MIOPEN_LOG_E("Failed to store record to find-db at <" << find_db_path << ">");
+
+        for(const auto& entry : problem.perf_db)
+            perf_db.Update(key, entry.first, RawValues{entry.second});
+    }
+
+    for(const auto& code_object : bundle.code_objects)
+        handle.SaveCodeObject(code_object.program_name,
+                              code_object.params,
+                              code_object.is_kernel_str,
+                              code_object.blob);
+
+    MIOPEN_LOG_I(bundle.problems.size() << " problems and " << bundle.code_objects.size()
+                                        << " code objects read from "
+                                        << path);
+}
+
+} // namespace miopen
@@ -0,0 +1,77 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/workspace_arena.hpp>
+#include <miopen/env.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_WORKSPACE_ARENA)
+
+namespace miopen {
+
+bool WorkspaceArena::IsEnabledByDefault() { return IsEnabled(MIOPEN_WORKSPACE_ARENA{}); }
+
+Allocator::ManageDataPtr& WorkspaceArena::Get(const Handle& handle, Slot slot, std::size_t size)
+{
+    auto& buffer = buffers[static_cast<std::size_t>(slot)];
+    if(buffer.data != nullptr && size <= buffer.size)
+        return buffer.data;
+
+    MIOPEN_LOG_I2("Growing arena slot " << static_cast<int>(slot) << " from " << buffer.size
+                                        << " to "
+                                        << size
+                                        << " bytes");
+    // Handle::Create() waits for the stream, so the old buffer is no longer in use.
+    auto grown  = handle.Create(size, miopenAllocationWorkspace);
+    buffer.data = std::move(grown);
+    buffer.size = size;
+    return buffer.data;
+}
+
+std::size_t WorkspaceArena::GetBytes() const
+{
+    std::size_t bytes = 0;
+    for(const auto& buffer : buffers)
+        bytes += buffer.size;
+    return bytes;
+}
+
+std::size_t WorkspaceArena::GetBytes(Slot slot) const
+{
+    return buffers[static_cast<std::size_t>(slot)].size;
+}
+
+void WorkspaceArena::Clear()
+{
+    for(auto& buffer : buffers)
+    {
+        buffer.data.reset();
+        buffer.size = 0;
+    }
+}
+
+} // namespace miopen
@@ -163,6 +163,62 @@ struct verify_backwards_activation
     }
 };
 
+/// Runs the forward pass over x and the backward pass from y alone over dy.
+template <class T>
+struct verify_inplace_backwards_activation : verify_backwards_activation<T>
+{
+    explicit verify_inplace_backwards_activation(verify_backwards_activation<T> base)
+        : verify_backwards_activation<T>(std::move(base))
+    {
+    }
+
+    template <class A>
+    tensor<T> gpu(A)
+    {
+        auto&& handle = get_handle();
+        auto dinput   = this->dout;
+
+        auto inout_dev = handle.Write(this->input.data);
+        auto diff_dev  = handle.Write(this->dout.data);
+
+        float alpha = 1, beta = 0;
+
+        this->desc.Forward(handle,
+                           &alpha,
+                           this->input.desc,
+                           inout_dev.get(),
+                           &beta,
+                           this->out.desc,
+                           inout_dev.get());
+        this->desc.Backward(handle,
+                            &alpha,
+                            // y
+                            this->out.desc,
+                            inout_dev.get(),
+                            // dy
+                            this->dout.desc,
+                            diff_dev.get(),
+                            // x
+                            this->input.desc,
+                            nullptr,
+                            &beta,
+                            // dx
+                            dinput.desc,
+                            diff_dev.get());
+
+        dinput.data = handle.Read<T>(diff_dev, dinput.data.size());
+        return dinput;
+    }
+
+    template <class A>
+    void fail(float, A)
+    {
+        std::cout << "In-place Backwards Activation: " << to_name(this->desc.GetMode())
+                  << std::endl;
+        std::cout << "Input tensor: " << this->input.desc.ToString() << std::endl;
+    }
+};
+
 struct select_first
 {
     template <class T>
@@ -292,6 +348,8 @@ struct activation_driver : test_driver
             return ((x * y) / 1301.0);
         });
         verify(verify_backwards_activation<T>{input, dout, out.first, desc}, b);
+        if(desc.IsBackwardFromOutputSupported())
+            verify(verify_inplace_backwards_activation<T>{{input, dout, out.first, desc}}, b);
     }
 };
 
@@ -0,0 +1,189 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "driver.hpp"
+#include "get_handle.hpp"
+#include "rms_check.hpp"
+#include "tensor_holder.hpp"
+#include "test.hpp"
+#include "verify.hpp"
+
+#include <miopen/attention.hpp>
+#include <miopen/miopen.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+template <class T>
+void chk_attention(std::size_t batch,
+                   std::size_t heads,
+                   std::size_t seq_q,
+                   std::size_t seq_kv,
+                   std::size_t d,
+                   bool causal)
+{
+    auto&& handle = get_handle();
+
+    const auto scale = static_cast<float>(1. / std::sqrt(double(d)));
+    const std::vector<std::size_t> q_lengths{batch, heads, seq_q, d};
+    const std::vector<std::size_t> kv_lengths{batch, heads, seq_kv, d};
+    const auto rows          = batch * heads;
+    const auto attention_gen = tensor_elem_gen_centered{13, 6.0, 8.0};
+
+    auto q   = tensor<T>{q_lengths}.generate(attention_gen);
+    auto k   = tensor<T>{kv_lengths}.generate(tensor_elem_gen_integer{7});
+    auto v   = tensor<T>{kv_lengths}.generate(attention_gen);
+    auto d_o = tensor<T>{q_lengths}.generate(tensor_elem_gen_integer{5});
+    auto o   = tensor<T>{q_lengths};
+    auto dq  = tensor<T>{q_lengths};
+    auto dk  = tensor<T>{kv_lengths};
+    auto dv  = tensor<T>{kv_lengths};
+    auto lse = tensor<float>{rows * seq_q};
+
+    // Host reference through the whole score matrix.
+    auto ref_o   = std::vector<double>(o.data.size(), 0.);
+    auto ref_lse = std::vector<double>(lse.data.size(), 0.);
+    auto ref_dq  = std::vector<double>(dq.data.size(), 0.);
+    auto ref_dk  = std::vector<double>(dk.data.size(), 0.);
+    auto ref_dv  = std::vector<double>(dv.data.size(), 0.);
+    for(std::size_t b = 0; b < rows; ++b)
+    {
+        const auto qb = b * seq_q * d;
+        const auto kb = b * seq_kv * d;
+        for(std::size_t i = 0; i < seq_q; ++i)
+        {
+            const auto keys = causal ? std::min(seq_kv, i + 1) : seq_kv;
+            std::vector<double> p(keys);
+            double max = -std::numeric_limits<double>::infinity();
+            for(std::size_t j = 0; j < keys; ++j)
+            {
+                double s = 0.;
+                for(std::size_t l = 0; l < d; ++l)
+                    s += double(q[qb + i * d + l]) * k[kb + j * d + l];
+                p[j] = s * scale;
+                max  = std::max(max, p[j]);
+            }
+            double sum = 0.;
+            for(auto& x : p)
+                sum += (x = std::exp(x - max));
+            ref_lse[b * seq_q + i] = max + std::log(sum);
+
+            for(std::size_t j = 0; j < keys; ++j)
+                for(std::size_t l = 0; l < d; ++l)
+                    ref_o[qb + i * d + l] += p[j] / sum * v[kb + j * d + l];
+
+            double delta = 0.;
+            for(std::size_t l = 0; l < d; ++l)
+                delta += double(d_o[qb + i * d + l]) * ref_o[qb + i * d + l];
+            for(std::size_t j = 0; j < keys; ++j)
+            {
+                const double pj = p[j] / sum;
+                double dp       = 0.;
+                for(std::size_t l = 0; l < d; ++l)
+                    dp += double(d_o[qb + i * d + l]) * v[kb + j * d + l];
+                const double ds = pj * (dp - delta);
+                for(std::size_t l = 0; l < d; ++l)
+                {
+                    ref_dq[qb + i * d + l] += scale * ds * k[kb + j * d + l];
+                    ref_dk[kb + j * d + l] += scale * ds * q[qb + i * d + l];
+                    ref_dv[kb + j * d + l] += pj * d_o[qb + i * d + l];
+                }
+            }
+        }
+    }
+
+    auto q_dev   = handle.Write(q.data);
+    auto k_dev   = handle.Write(k.data);
+    auto v_dev   = handle.Write(v.data);
+    auto do_dev  = handle.Write(d_o.data);
+    auto o_dev   = handle.Write(o.data);
+    auto lse_dev = handle.Write(lse.data);
+    auto dq_dev  = handle.Write(dq.data);
+    auto dk_dev  = handle.Write(dk.data);
+    auto dv_dev  = handle.Write(dv.data);
+
+    miopen::AttentionForward(handle,
+                             q.desc,
+                             q_dev.get(),
+                             k.desc,
+                             k_dev.get(),
+                             v.desc,
+                             v_dev.get(),
+                             scale,
+                             causal,
+                             o.desc,
+                             o_dev.get(),
+                             &lse.desc,
+                             lse_dev.get());
+    miopen::AttentionBackward(handle,
+                              q.desc,
+                              q_dev.get(),
+                              k.desc,
+                              k_dev.get(),
+                              v.desc,
+                              v_dev.get(),
+                              o.desc,
+                              o_dev.get(),
+                              do_dev.get(),
+                              lse.desc,
+                              lse_dev.get(),
+                              scale,
+                              causal,
+                              dq_dev.get(),
+                              dk_dev.get(),
+                              dv_dev.get());
+    o.data   = handle.Read<T>(o_dev, o.data.size());
+    lse.data = handle.Read<float>(lse_dev, lse.data.size());
+    dq.data  = handle.Read<T>(dq_dev, dq.data.size());
+    dk.data  = handle.Read<T>(dk_dev, dk.data.size());
+    dv.data  = handle.Read<T>(dv_dev, dv.data.size());
+
+    const double tolerance = sizeof(T) == 2 ? 5e-3 : 1e-5;
+    const auto problem     = " seq_q " + std::to_string(seq_q) + " seq_kv " +
+                         std::to_string(seq_kv) + " d " + std::to_string(d) + " causal " +
+                         std::to_string(causal);
+    expect_rms("Attention o" + problem, ref_o, o.data, tolerance);
+    expect_rms("Attention lse" + problem, ref_lse, lse.data, tolerance);
+    expect_rms("Attention dq" + problem, ref_dq, dq.data, tolerance);
+    expect_rms("Attention dk" + problem, ref_dk, dk.data, tolerance);
+    expect_rms("Attention dv" + problem, ref_dv, dv.data, tolerance);
+}
+
+int main()
+{
+    /*
+     * The tiled forward with the online softmax and both backward kernels must match the host
+     * reference computed through the whole score matrix, for sequences which are not multiples
+     * of the tiles, with and without the causal mask.
+     */
+    chk_attention<float>(2, 2, 70, 45, 16, false);
+    chk_attention<float>(1, 3, 80, 80, 64, true);
+    chk_attention<float>(1, 1, 33, 100, 128, true);
+    // fp16 data with fp32 accumulation
+    chk_attention<half_float::half>(2, 1, 64, 96, 32, false);
+}
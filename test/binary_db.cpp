@@ -0,0 +1,85 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include <miopen/binary_db.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace miopen {
+namespace tests {
+
+struct BinaryDbTest
+{
+    void Run() const
+    {
+        EXPECT(binary_db::GetPath("/db/gfx906_60.HIP.fdb.txt") == "/db/gfx906_60.HIP.fdb.bin");
+        EXPECT(binary_db::GetPath("/db/user.db") == "/db/user.db.bin");
+
+        const TempFile temp_file{"miopen.test.binary_db"};
+        const auto path = temp_file.Path();
+
+        {
+            std::istringstream text{"b-key=id1:1,2;id2:3\n"
+                                    "\n"
+                                    "ill-formed line\n"
+                                    "a-key=id3:x\n"
+                                    "b-key=id4:duplicate\n"
+                                    "a=id5:short\n"};
+            std::ofstream binary{path, std::ios::binary};
+            EXPECT(binary_db::Compile(text, binary, "test") == 3);
+        }
+
+        const auto db = MappedDb::Open(path);
+        EXPECT(db != nullptr);
+        EXPECT(db->Size() == 3);
+
+        const auto b = db->Find("b-key");
+        EXPECT(b && b->content == "id1:1,2;id2:3" && b->line == 1);
+        const auto a = db->Find("a-key");
+        EXPECT(a && a->content == "id3:x" && a->line == 4);
+        const auto shortest = db->Find("a");
+        EXPECT(shortest && shortest->content == "id5:short");
+
+        EXPECT(!db->Find("c-key"));
+        EXPECT(!db->Find("a-"));
+        EXPECT(!db->Find(""));
+
+        {
+            std::ofstream garbage{path, std::ios::binary | std::ios::trunc};
+            garbage << "definitely not a binary db";
+        }
+        EXPECT(MappedDb::Open(path) == nullptr);
+        EXPECT(MappedDb::Open(path + ".missing") == nullptr);
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::BinaryDbTest().Run(); }
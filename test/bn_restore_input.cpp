@@ -0,0 +1,91 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/miopen.h>
+#include <miopen/batch_norm.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/tensor.hpp>
+#include <cmath>
+#include <vector>
+
+#include "get_handle.hpp"
+#include "test.hpp"
+
+// The output of batch norm over x is turned back into x.
+void test_restore(miopenBatchNormMode_t bn_mode)
+{
+    auto&& handle = get_handle();
+
+    const int n = 2, c = 3, h = 5, w = 7;
+    const auto y_desc  = miopen::TensorDescriptor{miopenFloat, {n, c, h, w}};
+    const auto bn_desc = bn_mode == miopenBNSpatial
+                             ? miopen::TensorDescriptor{miopenFloat, {1, c, 1, 1}}
+                             : miopen::TensorDescriptor{miopenFloat, {1, c, h, w}};
+    const auto params = bn_desc.GetElementSize();
+    const auto stride = bn_mode == miopenBNSpatial ? h * w : 1;
+
+    std::vector<float> scale(params), bias(params), mean(params), inv_var(params);
+    for(std::size_t p = 0; p < params; ++p)
+    {
+        scale[p]   = 0.5f + 0.25f * (p % 5);
+        bias[p]    = -1.0f + 0.5f * (p % 3);
+        mean[p]    = 0.125f * (p % 7);
+        inv_var[p] = 1.0f + 0.5f * (p % 4);
+    }
+
+    std::vector<float> x(y_desc.GetElementSize()), y(x.size());
+    for(std::size_t i = 0; i < x.size(); ++i)
+    {
+        const auto p = (i / stride) % params;
+        x[i]         = static_cast<float>(static_cast<int>(i * 37 % 17) - 8) / 4;
+        y[i]         = scale[p] * (x[i] - mean[p]) * inv_var[p] + bias[p];
+    }
+
+    auto y_dev       = handle.Write(y);
+    auto scale_dev   = handle.Write(scale);
+    auto bias_dev    = handle.Write(bias);
+    auto mean_dev    = handle.Write(mean);
+    auto inv_var_dev = handle.Write(inv_var);
+
+    miopen::BatchNormRestoreInput(handle,
+                                  bn_mode,
+                                  y_desc,
+                                  y_dev.get(),
+                                  bn_desc,
+                                  scale_dev.get(),
+                                  bias_dev.get(),
+                                  mean_dev.get(),
+                                  inv_var_dev.get());
+
+    const auto restored = handle.Read<float>(y_dev, y.size());
+    for(std::size_t i = 0; i < x.size(); ++i)
+        EXPECT(std::abs(restored[i] - x[i]) < 1e-4f);
+}
+
+int main()
+{
+    test_restore(miopenBNSpatial);
+    test_restore(miopenBNPerActivation);
+}
@@ -0,0 +1,295 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/miopen.h>
+#include <miopen/batch_norm.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/tensor.hpp>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "get_handle.hpp"
+#include "test.hpp"
+#include "verify.hpp"
+
+// Spatial batch normalization of channel-last tensors against a host implementation that reads
+// the data as N*H*W rows of C channels.
+struct bn_spatial_nhwc_test
+{
+    int n;
+    int c;
+    int h;
+    int w;
+
+    bn_spatial_nhwc_test(int n_, int c_, int h_, int w_) : n(n_), c(c_), h(h_), w(w_) {}
+
+    static constexpr double epsilon      = 1e-5;
+    static constexpr double expAvgFactor = 0.1;
+
+    std::size_t rows() const { return static_cast<std::size_t>(n) * h * w; }
+
+    miopen::TensorDescriptor MakeNHWC() const
+    {
+        return {miopenFloat,
+                std::vector<int>{n, c, h, w},
+                std::vector<int>{h * w * c, 1, w * c, c}};
+    }
+
+    struct results
+    {
+        std::vector<float> y;
+        std::vector<float> runMean;
+        std::vector<float> runVar;
+        std::vector<float> saveMean;
+        std::vector<float> saveInvVar;
+        std::vector<float> yInfer;
+        std::vector<float> dx;
+        std::vector<float> dscale;
+        std::vector<float> dbias;
+    };
+
+    std::vector<float> x;
+    std::vector<float> dy;
+    std::vector<float> scale;
+    std::vector<float> bias;
+    std::vector<float> estMean;
+    std::vector<float> estVar;
+
+    results RunHost() const
+    {
+        const auto nhw = rows();
+        results res;
+        res.y.resize(x.size());
+        res.yInfer.resize(x.size());
+        res.dx.resize(x.size());
+        res.runMean.assign(c, 0.5f);
+        res.runVar.assign(c, 1.5f);
+        res.saveMean.resize(c);
+        res.saveInvVar.resize(c);
+        res.dscale.resize(c);
+        res.dbias.resize(c);
+
+        for(int ch = 0; ch < c; ++ch)
+        {
+            double sum = 0;
+            double sqr = 0;
+            for(std::size_t r = 0; r < nhw; ++r)
+            {
+                sum += x[r * c + ch];
+                sqr += x[r * c + ch] * x[r * c + ch];
+            }
+            const double mean   = sum / nhw;
+            const double var    = sqr / nhw - mean * mean;
+            const double invVar = 1.0 / std::sqrt(var + epsilon);
+            const double adjust = (nhw == 1) ? var : var * nhw / (nhw - 1.0);
+
+            res.saveMean[ch]   = mean;
+            res.saveInvVar[ch] = invVar;
+            res.runMean[ch]    = (1 - expAvgFactor) * res.runMean[ch] + expAvgFactor * mean;
+            res.runVar[ch]     = (1 - expAvgFactor) * res.runVar[ch] + expAvgFactor * adjust;
+
+            const double estInvVar = 1.0 / std::sqrt(estVar[ch] + epsilon);
+            double db              = 0;
+            double ds              = 0;
+            for(std::size_t r = 0; r < nhw; ++r)
+            {
+                const auto i      = r * c + ch;
+                const double xhat = (x[i] - mean) * invVar;
+                res.y[i]          = scale[ch] * xhat + bias[ch];
+                res.yInfer[i]     = scale[ch] * (x[i] - estMean[ch]) * estInvVar + bias[ch];
+                db += dy[i];
+                ds += xhat * dy[i];
+            }
+            res.dbias[ch]  = db;
+            res.dscale[ch] = ds;
+            for(std::size_t r = 0; r < nhw; ++r)
+            {
+                const auto i      = r * c + ch;
+                const double xhat = (x[i] - mean) * invVar;
+                res.dx[i] = scale[ch] * invVar / nhw * (nhw * dy[i] - db - xhat * ds);
+            }
+        }
+        return res;
+    }
+
+    results RunDevice() const
+    {
+        auto&& handle     = get_handle();
+        const auto x_desc = MakeNHWC();
+        const miopen::TensorDescriptor bn_desc{miopenFloat, std::vector<int>{1, c, 1, 1}};
+        const float alpha = 1.0f;
+        const float beta  = 0.0f;
+        results res;
+
+        auto x_dev          = handle.Write(x);
+        auto dy_dev         = handle.Write(dy);
+        auto scale_dev      = handle.Write(scale);
+        auto bias_dev       = handle.Write(bias);
+        auto est_mean_dev   = handle.Write(estMean);
+        auto est_var_dev    = handle.Write(estVar);
+        auto run_mean_dev   = handle.Write(std::vector<float>(c, 0.5f));
+        auto run_var_dev    = handle.Write(std::vector<float>(c, 1.5f));
+        auto save_mean_dev  = handle.Create(c * sizeof(float));
+        auto save_ivar_dev  = handle.Create(c * sizeof(float));
+        auto y_dev          = handle.Create(x.size() * sizeof(float));
+        auto dx_dev         = handle.Create(x.size() * sizeof(float));
+        auto dscale_dev     = handle.Create(c * sizeof(float));
+        auto dbias_dev      = handle.Create(c * sizeof(float));
+        auto dscale_rec_dev = handle.Create(c * sizeof(float));
+        auto dbias_rec_dev  = handle.Create(c * sizeof(float));
+
+        miopen::BatchNormForwardTraining(handle,
+                                         miopenBNSpatial,
+                                         &alpha,
+                                         &beta,
+                                         x_desc,
+                                         x_dev.get(),
+                                         x_desc,
+                                         y_dev.get(),
+                                         bn_desc,
+                                         scale_dev.get(),
+                                         bias_dev.get(),
+                                         expAvgFactor,
+                                         run_mean_dev.get(),
+                                         run_var_dev.get(),
+                                         epsilon,
+                                         save_mean_dev.get(),
+                                         save_ivar_dev.get());
+        res.y          = handle.Read<float>(y_dev, x.size());
+        res.runMean    = handle.Read<float>(run_mean_dev, c);
+        res.runVar     = handle.Read<float>(run_var_dev, c);
+        res.saveMean   = handle.Read<float>(save_mean_dev, c);
+        res.saveInvVar = handle.Read<float>(save_ivar_dev, c);
+
+        miopen::BatchNormForwardInference(handle,
+                                          miopenBNSpatial,
+                                          &alpha,
+                                          &beta,
+                                          x_desc,
+                                          x_dev.get(),
+                                          x_desc,
+                                          y_dev.get(),
+                                          bn_desc,
+                                          scale_dev.get(),
+                                          bias_dev.get(),
+                                          est_mean_dev.get(),
+                                          est_var_dev.get(),
+                                          epsilon);
+        res.yInfer = handle.Read<float>(y_dev, x.size());
+
+        miopen::BatchNormBackward(handle,
+                                  miopenBNSpatial,
+                                  &alpha,
+                                  &beta,
+                                  &alpha,
+                                  &beta,
+                                  x_desc,
+                                  x_dev.get(),
+                                  x_desc,
+                                  dy_dev.get(),
+                                  x_desc,
+                                  dx_dev.get(),
+                                  bn_desc,
+                                  scale_dev.get(),
+                                  dscale_dev.get(),
+                                  dbias_dev.get(),
+                                  epsilon,
+                                  save_mean_dev.get(),
+                                  save_ivar_dev.get());
+        res.dx     = handle.Read<float>(dx_dev, x.size());
+        res.dscale = handle.Read<float>(dscale_dev, c);
+        res.dbias  = handle.Read<float>(dbias_dev, c);
+
+        // Without the saved statistics the kernel recomputes them and has to agree.
+        miopen::BatchNormBackward(handle,
+                                  miopenBNSpatial,
+                                  &alpha,
+                                  &beta,
+                                  &alpha,
+                                  &beta,
+                                  x_desc,
+                                  x_dev.get(),
+                                  x_desc,
+                                  dy_dev.get(),
+                                  x_desc,
+                                  dx_dev.get(),
+                                  bn_desc,
+                                  scale_dev.get(),
+                                  dscale_rec_dev.get(),
+                                  dbias_rec_dev.get(),
+                                  epsilon,
+                                  nullptr,
+                                  nullptr);
+        EXPECT(miopen::rms_range(res.dx, handle.Read<float>(dx_dev, x.size())) < 1e-5);
+        EXPECT(miopen::rms_range(res.dscale, handle.Read<float>(dscale_rec_dev, c)) < 1e-5);
+        EXPECT(miopen::rms_range(res.dbias, handle.Read<float>(dbias_rec_dev, c)) < 1e-5);
+
+        return res;
+    }
+
+    void run()
+    {
+        std::mt19937 gen(c * 131 + h * 7 + n);
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+        auto random = [&](std::size_t size, float offset) {
+            std::vector<float> v(size);
+            for(auto& e : v)
+                e = dist(gen) + offset;
+            return v;
+        };
+
+        x       = random(rows() * c, 0.25f);
+        dy      = random(rows() * c, 0.0f);
+        scale   = random(c, 1.0f);
+        bias    = random(c, 0.0f);
+        estMean = random(c, 0.0f);
+        estVar  = random(c, 2.0f);
+
+        const auto expected = RunHost();
+        const auto actual   = RunDevice();
+
+        EXPECT(miopen::rms_range(expected.y, actual.y) < 1e-5);
+        EXPECT(miopen::rms_range(expected.runMean, actual.runMean) < 1e-5);
+        EXPECT(miopen::rms_range(expected.runVar, actual.runVar) < 1e-5);
+        EXPECT(miopen::rms_range(expected.saveMean, actual.saveMean) < 1e-5);
+        EXPECT(miopen::rms_range(expected.saveInvVar, actual.saveInvVar) < 1e-5);
+        EXPECT(miopen::rms_range(expected.yInfer, actual.yInfer) < 1e-5);
+        EXPECT(miopen::rms_range(expected.dx, actual.dx) < 1e-4);
+        EXPECT(miopen::rms_range(expected.dscale, actual.dscale) < 1e-4);
+        EXPECT(miopen::rms_range(expected.dbias, actual.dbias) < 1e-4);
+    }
+};
+
+int main()
+{
+    // Channel counts that take vectors of 4, 2 and 1, and ones that leave a partial work-group.
+    bn_spatial_nhwc_test(2, 64, 7, 7).run();
+    bn_spatial_nhwc_test(4, 6, 5, 3).run();
+    bn_spatial_nhwc_test(3, 5, 8, 8).run();
+    bn_spatial_nhwc_test(1, 100, 14, 14).run();
+    bn_spatial_nhwc_test(16, 3, 1, 1).run();
+}
@@ -31,6 +31,10 @@
 #include <miopen/md5.hpp>
 #include "test.hpp"
 
+#include <chrono>
+#include <limits>
+#include <thread>
+
 #if MIOPEN_ENABLE_SQLITE
 std::string random_string(size_t length)
 {
@@ -83,6 +87,26 @@ void check_bz2_decompress()
     EXPECT(decompressed_str == miopen::decompress(compressed_str, orig_str.size() + 10));
 }
 
+void check_codecs()
+{
+    const auto orig_str = random_string(4096);
+    bool success        = false;
+
+    // Entries written with any codec load regardless of the default one.
+    const auto bz2_str = miopen::compress_with(orig_str, miopen::Codec::Bzip2, &success);
+    EXPECT(success);
+    EXPECT(miopen::decompress(bz2_str, orig_str.size()) == orig_str);
+#if MIOPEN_USE_ZSTD
+    const auto zstd_str = miopen::compress_with(orig_str, miopen::Codec::Zstd, &success);
+    EXPECT(success);
+    EXPECT(zstd_str.size() < orig_str.size());
+    EXPECT(miopen::decompress(zstd_str, orig_str.size()) == orig_str);
+    CHECK(throws([&]() { miopen::decompress(zstd_str, 10); }));
+#else
+    CHECK(throws([&]() { miopen::compress_with(orig_str, miopen::Codec::Zstd, &success); }));
+#endif
+}
+
 void check_kern_db()
 {
     miopen::KernelConfig cfg0;
@@ -130,6 +154,66 @@ void check_kern_db()
         CHECK(err_db.RemoveRecordUnsafe(cfg0));
     }
 }
+
+void check_kern_db_trim()
+{
+    const auto store = [](miopen::KernDb& db, const std::string& name, std::int64_t time_ms) {
+        const auto cfg = miopen::KernelConfig{name, "args", random_string(4096), time_ms};
+        CHECK(db.StoreRecordUnsafe(cfg));
+        return cfg;
+    };
+    const auto total_bytes = [](miopen::KernDb& db) {
+        return db.Trim(std::numeric_limits<std::size_t>::max(), miopenKernelCacheEvictCheapest)
+            .remaining_bytes;
+    };
+
+    {
+        miopen::TempFile temp_file("tmp-kerndb");
+        miopen::KernDb db(std::string(temp_file), false, "gfx906", 60);
+        const auto slow = store(db, "slow", 10000);
+        const auto fast = store(db, "fast", 10);
+        const auto size = total_bytes(db);
+        CHECK(db.Trim(size, miopenKernelCacheEvictCheapest).removed_entries == 0);
+
+        // The kernel that is expensive to rebuild is kept.
+        const auto result = db.Trim(size - 1, miopenKernelCacheEvictCheapest);
+        EXPECT(result.removed_entries == 1);
+        EXPECT(result.removed_bytes + result.remaining_bytes == size);
+        EXPECT(db.FindRecordUnsafe(slow));
+        EXPECT(!db.FindRecordUnsafe(fast));
+
+        EXPECT(db.Trim(0, miopenKernelCacheEvictCheapest).remaining_bytes == 0);
+        EXPECT(!db.FindRecordUnsafe(slow));
+    }
+
+    {
+        miopen::TempFile temp_file("tmp-kerndb");
+        miopen::KernDb db(std::string(temp_file), false, "gfx906", 60);
+        const auto used   = store(db, "used", 10000);
+        const auto unused = store(db, "unused", 10000);
+        // The last use is kept in seconds.
+        std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+        CHECK(db.FindRecordUnsafe(used));
+
+        EXPECT(db.Trim(total_bytes(db) - 1, miopenKernelCacheEvictLeastRecentlyUsed)
+                   .removed_entries == 1);
+        EXPECT(db.FindRecordUnsafe(used));
+        EXPECT(!db.FindRecordUnsafe(unused));
+    }
+
+    {
+        // Databases created before the metadata columns are upgraded on open.
+        miopen::TempFile temp_file("tmp-kerndb");
+        miopen::SQLite{std::string(temp_file), false}.Exec(
+            "CREATE TABLE `kern_db` (`id` INTEGER PRIMARY KEY ASC, `kernel_name` TEXT NOT NULL, "
+            "`kernel_args` TEXT NOT NULL, `kernel_blob` BLOB NOT NULL, `kernel_hash` TEXT NOT "
+            "NULL, `uncompressed_size` INT NOT NULL);");
+        miopen::KernDb db(std::string(temp_file), false, "gfx906", 60);
+        CHECK(db.CheckTableColumns("kern_db", miopen::KernelConfig::MetadataFieldNames()));
+        const auto cfg = store(db, "kernel", 100);
+        EXPECT(db.FindRecordUnsafe(cfg));
+    }
+}
 #endif
 
 void check_cache_file()
@@ -152,6 +236,8 @@ int main()
 #if MIOPEN_ENABLE_SQLITE
     check_bz2_compress();
     check_bz2_decompress();
+    check_codecs();
     check_kern_db();
+    check_kern_db_trim();
 #endif
 }
@@ -0,0 +1,86 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include <miopen/invoker_cache.hpp>
+#include <miopen/miopen.h>
+
+namespace miopen {
+namespace tests {
+
+struct CacheStatisticsTest
+{
+    static miopenCacheStatistics_t Get(miopenCacheType_t cache)
+    {
+        auto stats = miopenCacheStatistics_t{};
+        EXPECT(miopenGetCacheStatistics(cache, &stats) == miopenStatusSuccess);
+        return stats;
+    }
+
+    static bool IsZero(const miopenCacheStatistics_t& stats)
+    {
+        return stats.hits == 0 && stats.misses == 0 && stats.hitTimeMs == 0 &&
+               stats.missTimeMs == 0;
+    }
+
+    void Run() const
+    {
+        EXPECT(miopenResetCacheStatistics() == miopenStatusSuccess);
+        EXPECT(IsZero(Get(miopenCacheInvokers)));
+
+        auto cache     = InvokerCache{};
+        const auto key = InvokerCache::Key{InternedString{"cache_stats_test_config"},
+                                           InternedString{"cache_stats_test_solver"}};
+
+        EXPECT(!cache[key]);
+        auto stats = Get(miopenCacheInvokers);
+        EXPECT(stats.hits == 0);
+        EXPECT(stats.misses == 1);
+
+        cache.Register(key, [](const Handle&, const AnyInvokeParams&) {});
+        EXPECT(cache[key]);
+        EXPECT(cache[key]);
+        stats = Get(miopenCacheInvokers);
+        EXPECT(stats.hits == 2);
+        EXPECT(stats.misses == 1);
+
+        // The counters are kept per cache.
+        EXPECT(IsZero(Get(miopenCachePerfDb)));
+
+        EXPECT(miopenResetCacheStatistics() == miopenStatusSuccess);
+        EXPECT(IsZero(Get(miopenCacheInvokers)));
+
+        EXPECT(!cache[InvokerCache::Key{InternedString{"cache_stats_test_config"},
+                                        InternedString{"cache_stats_test_other"}}]);
+        stats = Get(miopenCacheInvokers);
+        EXPECT(stats.hits == 0);
+        EXPECT(stats.misses == 1);
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::CacheStatisticsTest().Run(); }
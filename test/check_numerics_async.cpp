@@ -0,0 +1,72 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include <miopen/handle.hpp>
+#include <miopen/check_numerics.hpp>
+#include <miopen/tensor.hpp>
+
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+struct check_numerics_async
+{
+    static const int size = 42;
+    miopen::TensorDescriptor desc{miopenFloat, {size}};
+
+    static miopen::Allocator::ManageDataPtr Fill(miopen::Handle& h, float val)
+    {
+        return h.Write(std::vector<float>(size, val));
+    }
+
+    void run() const
+    {
+        {
+            // The abnormal value is only seen by the last scan, long before the report interval.
+            miopen::Handle h{};
+            const auto normal   = Fill(h, 1.0f);
+            const auto abnormal = Fill(h, std::numeric_limits<float>::quiet_NaN());
+            CHECK(!miopen::checkNumericsOutput(h, desc, normal.get()));
+            CHECK(!miopen::checkNumericsOutput(h, desc, abnormal.get()));
+            CHECK(throws([&] { h.Finish(); }));
+            CHECK(!miopen::checkNumericsFlush(h));
+        }
+        {
+            // Reported as well when the handle is destroyed, which must not throw.
+            miopen::Handle h{};
+            const auto abnormal = Fill(h, std::numeric_limits<float>::quiet_NaN());
+            CHECK(!miopen::checkNumericsOutput(h, desc, abnormal.get()));
+        }
+    }
+};
+
+int main()
+{
+    // Throw | Async
+    setenv("MIOPEN_CHECK_NUMERICS", "0x24", 1);
+    setenv("MIOPEN_CHECK_NUMERICS_REPORT_INTERVAL", "1000", 1);
+    run_test<check_numerics_async>();
+}
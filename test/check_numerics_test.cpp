@@ -72,6 +72,14 @@ struct check_numeric_normal : check_numerics_base<T>
                                          this->desc,
                                          this->buffer.get(),
                                          false));
+
+        CHECK(!miopen::checkNumericsImpl(this->h,
+                                         miopen::CheckNumerics::Throw |
+                                             miopen::CheckNumerics::Async,
+                                         this->desc,
+                                         this->buffer.get(),
+                                         true));
+        CHECK(!miopen::checkNumericsFlush(this->h, miopen::CheckNumerics::Throw));
     }
 };
 
@@ -125,6 +133,30 @@ struct check_numeric_abnormal : check_numerics_base<T>
                                       this->buffer.get(),
                                       false);
         }));
+
+        // The Async mode only reports at the flush.
+        CHECK(!miopen::checkNumericsImpl(this->h,
+                                         miopen::CheckNumerics::Throw |
+                                             miopen::CheckNumerics::Async,
+                                         this->desc,
+                                         this->buffer.get(),
+                                         true));
+        CHECK(!miopen::checkNumericsImpl(this->h,
+                                         miopen::CheckNumerics::Throw |
+                                             miopen::CheckNumerics::Async,
+                                         this->desc,
+                                         this->buffer.get(),
+                                         false));
+        CHECK(miopen::checkNumericsFlush(this->h, miopen::CheckNumerics::Warn));
+        CHECK(!miopen::checkNumericsFlush(this->h, miopen::CheckNumerics::Warn));
+
+        CHECK(!miopen::checkNumericsImpl(this->h,
+                                         miopen::CheckNumerics::Throw |
+                                             miopen::CheckNumerics::Async,
+                                         this->desc,
+                                         this->buffer.get(),
+                                         false));
+        CHECK(throws([&] { miopen::checkNumericsFlush(this->h, miopen::CheckNumerics::Throw); }));
     }
 };
 
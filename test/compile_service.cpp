@@ -0,0 +1,190 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include <miopen/compile_service.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+struct CompileServiceTest
+{
+    static constexpr int thread_num = 8;
+
+    void Run() const
+    {
+        DeduplicatesBuilds();
+        SharesErrors();
+        SharesLoadedPrograms();
+        ParallelForVisitsAll();
+    }
+
+    // A program which no backend call is made on.
+    static Program MakeProgram()
+    {
+        static int dummy = 0;
+#if MIOPEN_BACKEND_OPENCL
+        return Program{reinterpret_cast<cl_program>(&dummy), [](cl_program) {}};
+#else
+        Program program;
+        program.impl = {reinterpret_cast<const HIPOCProgramImpl*>(&dummy),
+                        [](const HIPOCProgramImpl*) {}};
+        return program;
+#endif
+    }
+
+    static void RunConcurrently(const std::function<void()>& request)
+    {
+        std::vector<std::thread> threads;
+        for(int i = 0; i < thread_num; i++)
+            threads.emplace_back(request);
+        for(auto& thread : threads)
+            thread.join();
+    }
+
+    void DeduplicatesBuilds() const
+    {
+        std::atomic<int> arrived{0};
+        std::atomic<int> builds{0};
+        std::atomic<int> results{0};
+
+        // The build waits for all the threads to ask for it, and a little longer, so that they
+        // find it in flight.
+        const auto build = [&]() -> Program {
+            builds++;
+            while(arrived < thread_num)
+                std::this_thread::yield();
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            return Program{};
+        };
+
+        RunConcurrently(
+            [&] {
+                arrived++;
+                CompileService::Get().Build("compile_service_test:dedup", build);
+                results++;
+            });
+
+        EXPECT(builds == 1);
+        EXPECT(results == thread_num);
+    }
+
+    void SharesErrors() const
+    {
+        std::atomic<int> arrived{0};
+        std::atomic<int> builds{0};
+        std::atomic<int> errors{0};
+
+        const auto build = [&]() -> Program {
+            builds++;
+            while(arrived < thread_num)
+                std::this_thread::yield();
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            throw std::runtime_error("build failed");
+        };
+
+        RunConcurrently(
+            [&] {
+                arrived++;
+                try
+                {
+                    CompileService::Get().Build("compile_service_test:error", build);
+                }
+                catch(const std::runtime_error&)
+                {
+                    errors++;
+                }
+            });
+
+        EXPECT(builds == 1);
+        EXPECT(errors == thread_num);
+
+        // Nothing is left in flight after a failure.
+        CompileService::Get().Build("compile_service_test:error", [&]() -> Program {
+            builds++;
+            return Program{};
+        });
+        EXPECT(builds == 2);
+    }
+
+    void SharesLoadedPrograms() const
+    {
+        const std::string key = "compile_service_test:shared";
+        int builds            = 0;
+        const auto build      = [&]() -> Program {
+            builds++;
+            return MakeProgram();
+        };
+
+        {
+            const auto first  = CompileService::Get().Build(key, build);
+            const auto second = CompileService::Get().Build(key, build);
+            EXPECT(builds == 1);
+            EXPECT(GetWeakProgram(first).lock() == GetWeakProgram(second).lock());
+        }
+
+        // Once nobody holds the program, it is built again.
+        CompileService::Get().Build(key, build);
+        EXPECT(builds == 2);
+    }
+
+    void ParallelForVisitsAll() const
+    {
+        const std::size_t n = 1000;
+        std::vector<std::atomic<int>> visits(n);
+        for(auto& v : visits)
+            v = 0;
+
+        CompileService::Get().ParallelFor(n, 4, [&](std::size_t i) { visits[i]++; });
+        for(auto& v : visits)
+            EXPECT(v == 1);
+
+        bool thrown = false;
+        try
+        {
+            CompileService::Get().ParallelFor(n, 4, [&](std::size_t i) {
+                if(i == n / 2)
+                    throw std::runtime_error("task failed");
+            });
+        }
+        catch(const std::runtime_error&)
+        {
+            thrown = true;
+        }
+        EXPECT(thrown);
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::CompileServiceTest().Run(); }
@@ -0,0 +1,202 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/miopen.h>
+#include <miopen/convolution.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/tensor.hpp>
+#include <algorithm>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "get_handle.hpp"
+#include "test.hpp"
+#include "verify.hpp"
+
+// A batch of convolutions shall compute what the convolutions compute one by one.
+struct conv_batched_test
+{
+    std::mt19937 gen{31};
+
+    std::vector<float> Random(std::size_t n)
+    {
+        std::uniform_real_distribution<float> dist(-0.5f, 0.5f);
+        std::vector<float> v(n);
+        for(auto& e : v)
+            e = dist(gen);
+        return v;
+    }
+
+    /// The buffers of count tensors of size elements each. With contiguous set, they are views
+    /// into a single allocation one after the other, as the HIP backend can tell.
+    struct Slots
+    {
+        std::vector<miopen::Allocator::ManageDataPtr> allocations;
+        std::vector<void*> buffers;
+
+        Slots(miopen::Handle& handle,
+              const std::vector<float>& data,
+              std::size_t count,
+              std::size_t size,
+              bool contiguous)
+        {
+#if MIOPEN_BACKEND_HIP
+            if(contiguous)
+            {
+                allocations.push_back(handle.Write(data));
+                for(std::size_t i = 0; i < count; ++i)
+                    buffers.push_back(static_cast<float*>(allocations.front().get()) + i * size);
+                return;
+            }
+#else
+            std::ignore = contiguous;
+#endif
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                const auto first = data.begin() + i * size;
+                allocations.push_back(handle.Write(std::vector<float>(first, first + size)));
+                buffers.push_back(allocations.back().get());
+            }
+        }
+    };
+
+    void run()
+    {
+        // One image per problem, run as a single grouped convolution by the HIP backend.
+        Compare({1, 8, 10, 10}, {8, 4, 3, 3}, 2, 6, true);
+        // Several images per problem, one launch per problem.
+        Compare({2, 4, 9, 9}, {6, 4, 3, 3}, 1, 3, false);
+        // One image per problem, but not one after the other.
+        Compare({1, 4, 9, 9}, {6, 4, 3, 3}, 1, 4, false);
+        InvalidArguments();
+    }
+
+    void Compare(std::vector<int> x_lens, std::vector<int> w_lens, int groups, int count, bool c)
+    {
+        auto&& handle = get_handle();
+
+        auto x_desc    = miopen::TensorDescriptor{miopenFloat, x_lens.data(), 4};
+        auto w_desc    = miopen::TensorDescriptor{miopenFloat, w_lens.data(), 4};
+        auto conv_desc = miopen::ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}, {0, 0}, groups};
+        auto y_desc    = conv_desc.GetForwardOutputTensor(x_desc, w_desc);
+
+        const auto x_size = x_desc.GetElementSize();
+        const auto w_size = w_desc.GetElementSize();
+        const auto y_size = y_desc.GetElementSize();
+        const auto x_data = Random(x_size * count);
+        const auto w_data = Random(w_size * count);
+
+        auto x = Slots{handle, x_data, std::size_t(count), x_size, c};
+        auto w = Slots{handle, w_data, std::size_t(count), w_size, c};
+        auto y = Slots{handle, std::vector<float>(y_size * count), std::size_t(count), y_size, c};
+
+        std::size_t ws_size = 0;
+        EXPECT(miopenConvolutionForwardBatchedGetWorkSpaceSize(
+                   &handle, &w_desc, &x_desc, &conv_desc, &y_desc, count, &ws_size) ==
+               miopenStatusSuccess);
+        auto ws_dev = handle.Create(std::max<std::size_t>(ws_size, 1));
+        EXPECT(miopenConvolutionForwardBatched(&handle,
+                                               &x_desc,
+                                               x.buffers.data(),
+                                               &w_desc,
+                                               w.buffers.data(),
+                                               &conv_desc,
+                                               &y_desc,
+                                               y.buffers.data(),
+                                               count,
+                                               ws_dev.get(),
+                                               ws_size) == miopenStatusSuccess);
+
+        std::size_t solution_count = 0;
+        miopenConvSolution_t solution;
+        EXPECT(miopenConvolutionForwardGetSolution(
+                   &handle, &w_desc, &x_desc, &conv_desc, &y_desc, 1, &solution_count, &solution) ==
+               miopenStatusSuccess);
+        auto ref_ws_dev = handle.Create(std::max<std::size_t>(solution.workspace_size, 1));
+        auto ref_dev    = handle.Create<float>(y_size);
+        for(auto i = 0; i < count; ++i)
+        {
+            auto x_dev = handle.Write(
+                std::vector<float>(x_data.begin() + i * x_size, x_data.begin() + (i + 1) * x_size));
+            auto w_dev = handle.Write(
+                std::vector<float>(w_data.begin() + i * w_size, w_data.begin() + (i + 1) * w_size));
+            EXPECT(miopenConvolutionForwardImmediate(&handle,
+                                                     &w_desc,
+                                                     w_dev.get(),
+                                                     &x_desc,
+                                                     x_dev.get(),
+                                                     &conv_desc,
+                                                     &y_desc,
+                                                     ref_dev.get(),
+                                                     ref_ws_dev.get(),
+                                                     solution.workspace_size,
+                                                     solution.solution_id) == miopenStatusSuccess);
+            const auto expected = handle.Read<float>(ref_dev, y_size);
+
+            std::vector<float> actual(y_size);
+            handle.ReadTo(actual.data(),
+                          DataCast(static_cast<const void*>(y.buffers[i])),
+                          y_size * sizeof(float));
+            EXPECT(miopen::range_distance(expected) == miopen::range_distance(actual));
+            EXPECT(miopen::rms_range(expected, actual) < 1e-5);
+        }
+    }
+
+    void InvalidArguments()
+    {
+        auto&& handle  = get_handle();
+        auto x_desc    = miopen::TensorDescriptor{miopenFloat, {1, 4, 8, 8}};
+        auto w_desc    = miopen::TensorDescriptor{miopenFloat, {4, 4, 3, 3}};
+        auto y_desc    = miopen::TensorDescriptor{miopenFloat, {1, 4, 8, 8}};
+        auto conv_desc = miopen::ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}};
+
+        EXPECT(miopenConvolutionForwardBatched(&handle,
+                                               &x_desc,
+                                               nullptr,
+                                               &w_desc,
+                                               nullptr,
+                                               &conv_desc,
+                                               &y_desc,
+                                               nullptr,
+                                               2,
+                                               nullptr,
+                                               0) == miopenStatusBadParm);
+        // Nothing to run.
+        EXPECT(miopenConvolutionForwardBatched(&handle,
+                                               &x_desc,
+                                               nullptr,
+                                               &w_desc,
+                                               nullptr,
+                                               &conv_desc,
+                                               &y_desc,
+                                               nullptr,
+                                               0,
+                                               nullptr,
+                                               0) == miopenStatusSuccess);
+    }
+};
+
+int main() { conv_batched_test{}.run(); }
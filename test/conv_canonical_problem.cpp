@@ -0,0 +1,107 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/tensor.hpp>
+
+#include <cstdlib>
+#include <sstream>
+
+namespace miopen {
+namespace tests {
+
+struct CanonicalProblemTest
+{
+    static std::string GetDbKey(const conv::ProblemDescription& problem)
+    {
+        std::ostringstream ss;
+        problem.Serialize(ss);
+        return ss.str();
+    }
+
+    void Run() const
+    {
+        const auto x_wide = TensorDescriptor{miopenFloat, {16, 64, 28, 56}};
+        const auto x_tall = TensorDescriptor{miopenFloat, {16, 64, 56, 28}};
+        const auto y_wide = TensorDescriptor{miopenFloat, {16, 128, 28, 56}};
+        const auto y_tall = TensorDescriptor{miopenFloat, {16, 128, 56, 28}};
+        const auto w      = TensorDescriptor{miopenFloat, {128, 64, 1, 1}};
+        const auto conv   = ConvolutionDescriptor{{0, 0}, {1, 1}, {1, 1}};
+
+        // The transposed problems share the keys of the one with the height not above the width.
+        for(const auto direction : {conv::Direction::Forward,
+                                    conv::Direction::BackwardData,
+                                    conv::Direction::BackwardWeights})
+        {
+            const auto wide = conv::ProblemDescription{x_wide, w, y_wide, conv, direction};
+            const auto tall = conv::ProblemDescription{x_tall, w, y_tall, conv, direction};
+            EXPECT(tall.GetInHeight() == 28 && tall.GetInWidth() == 56);
+            EXPECT(tall.GetOutHeight() == 28 && tall.GetOutWidth() == 56);
+            EXPECT(tall.BuildConfKey().ToString() == wide.BuildConfKey().ToString());
+            EXPECT(GetDbKey(tall) == GetDbKey(wide));
+        }
+
+        // The descriptors keep addressing the same memory.
+        auto in  = x_tall;
+        auto out = y_tall;
+        EXPECT(conv::CanonicalizeTensors(conv, w, in, out));
+        EXPECT(in.GetLengths() == x_wide.GetLengths() && in.GetStrides() == x_wide.GetStrides());
+        EXPECT(out.GetLengths() == y_wide.GetLengths());
+        EXPECT(!conv::CanonicalizeTensors(conv, w, in, out));
+
+        auto nhwc = TensorDescriptor{miopenFloat, {16, 64, 56, 28}, {64 * 56 * 28, 1, 28 * 64, 64}};
+        auto nhwc_out =
+            TensorDescriptor{miopenFloat, {16, 128, 56, 28}, {128 * 56 * 28, 1, 28 * 128, 128}};
+        EXPECT(conv::CanonicalizeTensors(conv, w, nhwc, nhwc_out));
+        EXPECT(nhwc.GetLengths() == (std::vector<std::size_t>{16, 64, 28, 56}));
+        EXPECT(nhwc.GetStrides() == (std::vector<std::size_t>{64 * 56 * 28, 1, 56 * 64, 64}));
+
+        // Problems which see the height and the width separately are left as they are.
+        const auto padded  = ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}};
+        const auto strided = ConvolutionDescriptor{{0, 0}, {2, 2}, {1, 1}};
+        const auto w3x3    = TensorDescriptor{miopenFloat, {128, 64, 3, 3}};
+        const auto y3x3    = TensorDescriptor{miopenFloat, {16, 128, 54, 26}};
+        const auto y_half  = TensorDescriptor{miopenFloat, {16, 128, 28, 14}};
+        const auto fwd     = conv::Direction::Forward;
+        EXPECT((conv::ProblemDescription{x_tall, w3x3, y3x3, conv, fwd}).GetInHeight() == 56);
+        EXPECT((conv::ProblemDescription{x_tall, w, y_tall, padded, fwd}).GetInHeight() == 56);
+        EXPECT((conv::ProblemDescription{x_tall, w, y_half, strided, fwd}).GetInHeight() == 56);
+
+        const auto x_strided =
+            TensorDescriptor{miopenFloat, {16, 64, 56, 28}, {64 * 56 * 32, 56 * 32, 32, 1}};
+        EXPECT((conv::ProblemDescription{x_strided, w, y_tall, conv, fwd}).GetInHeight() == 56);
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main()
+{
+    setenv("MIOPEN_CONV_CANONICAL_PROBLEMS", "1", 1);
+    miopen::tests::CanonicalProblemTest().Run();
+}
@@ -305,6 +305,7 @@ struct verify_forward_conv : conv_base<T, Tout>
         /// So we use one Immediate mode call during Find mode tests,
         /// to print solver name onto console.
         miopenConvSolution_t selected;
+        bool fallback     = false;
         std::size_t count = 0;
 
         std::vector<char> ws;
@@ -348,8 +349,14 @@ struct verify_forward_conv : conv_base<T, Tout>
 
                 auto solutions = std::vector<miopenConvSolution_t>(count);
 
-                filter.GetBackwardSolutions(
-                    handle, input.desc, weights.desc, rout.desc, count, &count, solutions.data());
+                filter.GetBackwardSolutions(handle,
+                                            input.desc,
+                                            weights.desc,
+                                            rout.desc,
+                                            count,
+                                            &count,
+                                            solutions.data(),
+                                            &fallback);
 
                 if(count == 0)
                 {
@@ -419,8 +426,14 @@ struct verify_forward_conv : conv_base<T, Tout>
                 // std::cout << "Forward Conv solutions available: " << count << std::endl;
                 auto solutions = std::vector<miopenConvSolution_t>(count);
 
-                filter.GetForwardSolutions(
-                    handle, weights.desc, input.desc, rout.desc, count, &count, solutions.data());
+                filter.GetForwardSolutions(handle,
+                                           weights.desc,
+                                           input.desc,
+                                           rout.desc,
+                                           count,
+                                           &count,
+                                           solutions.data(),
+                                           &fallback);
 
                 if(count == 0)
                 {
@@ -556,7 +569,8 @@ struct verify_forward_conv : conv_base<T, Tout>
                                            rout.desc,
                                            1,
                                            &count,
-                                           &selected); /// \ref read_solver_name
+                                           &selected,
+                                           &fallback); /// \ref read_solver_name
             }
             else
             {
@@ -616,7 +630,8 @@ struct verify_forward_conv : conv_base<T, Tout>
                                                 rout.desc,
                                                 1,
                                                 &count,
-                                                &selected); /// \ref read_solver_name
+                                                &selected,
+                                                &fallback); /// \ref read_solver_name
                 }
                 else
                 {
@@ -660,7 +675,8 @@ struct verify_forward_conv : conv_base<T, Tout>
                                                rout.desc,
                                                1,
                                                &count,
-                                               &selected); /// \ref read_solver_name
+                                               &selected,
+                                               &fallback); /// \ref read_solver_name
                 }
             }
         }
@@ -669,7 +685,7 @@ struct verify_forward_conv : conv_base<T, Tout>
         {
             stats->algorithm   = selected.algorithm;
             stats->solver_name = miopen::solver::Id(selected.solution_id).ToString();
-            if(selected.time < 0)
+            if(fallback)
                 stats->solver_name += "_fallback";
         }
         rout.data = handle.Read<Tout>(out_dev, rout.data.size());
@@ -756,6 +772,7 @@ struct verify_backward_conv : conv_base<T>
         auto in_dev  = handle.Write(rinput.data);
 
         miopenConvSolution_t selected;
+        bool fallback     = false;
         std::size_t count = 0;
 
         if(immed)
@@ -803,8 +820,14 @@ struct verify_backward_conv : conv_base<T>
                 // std::endl;
                 auto solutions = std::vector<miopenConvSolution_t>(count);
 
-                filter.GetForwardSolutions(
-                    handle, weights.desc, out.desc, rinput.desc, count, &count, solutions.data());
+                filter.GetForwardSolutions(handle,
+                                           weights.desc,
+                                           out.desc,
+                                           rinput.desc,
+                                           count,
+                                           &count,
+                                           solutions.data(),
+                                           &fallback);
 
                 if(count == 0)
                 {
@@ -875,8 +898,14 @@ struct verify_backward_conv : conv_base<T>
                 // std::cout << "Backward Conv solutions available: " << count << std::endl;
                 auto solutions = std::vector<miopenConvSolution_t>(count);
 
-                filter.GetBackwardSolutions(
-                    handle, out.desc, weights.desc, rinput.desc, count, &count, solutions.data());
+                filter.GetBackwardSolutions(handle,
+                                            out.desc,
+                                            weights.desc,
+                                            rinput.desc,
+                                            count,
+                                            &count,
+                                            solutions.data(),
+                                            &fallback);
 
                 if(count == 0)
                 {
@@ -975,7 +1004,8 @@ struct verify_backward_conv : conv_base<T>
                                            rinput.desc,
                                            1,
                                            &count,
-                                           &selected); /// \ref read_solver_name
+                                           &selected,
+                                           &fallback); /// \ref read_solver_name
             }
             else
             {
@@ -1019,7 +1049,8 @@ struct verify_backward_conv : conv_base<T>
                                             rinput.desc,
                                             1,
                                             &count,
-                                            &selected); /// \ref read_solver_name
+                                            &selected,
+                                            &fallback); /// \ref read_solver_name
             }
         }
 
@@ -1027,7 +1058,7 @@ struct verify_backward_conv : conv_base<T>
         {
             stats->algorithm   = selected.algorithm;
             stats->solver_name = miopen::solver::Id(selected.solution_id).ToString();
-            if(selected.time < 0)
+            if(fallback)
                 stats->solver_name += "_fallback";
         }
         rinput.data = handle.Read<T>(in_dev, rinput.data.size());
@@ -1114,6 +1145,7 @@ struct verify_backward_weights_conv : conv_base<T>
         auto in_dev  = handle.Write(input.data);
 
         miopenConvSolution_t selected;
+        bool fallback     = false;
         std::size_t count = 0;
 
         if(immed)
@@ -1169,7 +1201,8 @@ struct verify_backward_weights_conv : conv_base<T>
                                    rweights.desc,
                                    count,
                                    &count,
-                                   solutions.data());
+                                   solutions.data(),
+                                   &fallback);
 
             if(count == 0)
             {
@@ -1275,14 +1308,15 @@ struct verify_backward_weights_conv : conv_base<T>
                                    rweights.desc,
                                    1,
                                    &count,
-                                   &selected); /// \ref read_solver_name
+                                   &selected,
+                                   &fallback); /// \ref read_solver_name
         }
 
         if(count != 0)
         {
             stats->algorithm   = selected.algorithm;
             stats->solver_name = miopen::solver::Id(selected.solution_id).ToString();
-            if(selected.time < 0)
+            if(fallback)
                 stats->solver_name += "_fallback";
         }
         rweights.data = handle.Read<T>(wei_dev, rweights.data.size());
@@ -1431,6 +1465,7 @@ struct verify_forward_conv_int8 : conv_base<T>
 
         // std::cout << "Forward Conv solutions available: " << count << std::endl;
         auto solutions = std::vector<miopenConvSolution_t>(count);
+        bool fallback  = false;
 
         filter.GetForwardSolutions(handle,
                                    (is_transform ? weight_vpad_desc : weights.desc),
@@ -1438,7 +1473,8 @@ struct verify_forward_conv_int8 : conv_base<T>
                                    rout.desc,
                                    count,
                                    &count,
-                                   solutions.data());
+                                   solutions.data(),
+                                   &fallback);
 
         if(count == 0)
         {
@@ -1489,7 +1525,7 @@ struct verify_forward_conv_int8 : conv_base<T>
         {
             stats->algorithm   = selected.algorithm;
             stats->solver_name = miopen::solver::Id(selected.solution_id).ToString();
-            if(selected.time < 0)
+            if(fallback)
                 stats->solver_name += "_fallback";
         }
         rout.data = handle.Read<float>(out_dev, rout.data.size());
@@ -0,0 +1,133 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/miopen.h>
+#include <miopen/convolution.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/tensor.hpp>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "get_handle.hpp"
+#include "test.hpp"
+#include "verify.hpp"
+
+// The algorithms found in background shall be runnable on the handle the search was started with
+// and agree with each other.
+void test_find_async()
+{
+    auto&& handle = get_handle();
+
+    auto x_desc    = miopen::TensorDescriptor{miopenFloat, {2, 8, 14, 14}};
+    auto w_desc    = miopen::TensorDescriptor{miopenFloat, {16, 8, 3, 3}};
+    auto y_desc    = miopen::TensorDescriptor{miopenFloat, {2, 16, 14, 14}};
+    auto conv_desc = miopen::ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}};
+
+    std::mt19937 gen(17);
+    std::uniform_real_distribution<float> dist(-0.5f, 0.5f);
+    const auto random = [&](std::size_t n) {
+        std::vector<float> v(n);
+        for(auto& e : v)
+            e = dist(gen);
+        return v;
+    };
+
+    auto x_dev = handle.Write(random(x_desc.GetElementSize()));
+    auto w_dev = handle.Write(random(w_desc.GetElementSize()));
+    auto y_dev = handle.Write(random(y_desc.GetElementSize()));
+
+    std::size_t ws_size = 0;
+    EXPECT(miopenConvolutionForwardGetWorkSpaceSize(
+               &handle, &w_desc, &x_desc, &conv_desc, &y_desc, &ws_size) == miopenStatusSuccess);
+    auto ws_dev = handle.Create(std::max<std::size_t>(ws_size, 1));
+
+    const int request_count              = 5;
+    miopenConvolutionFindFuture_t future = nullptr;
+    EXPECT(miopenFindConvolutionForwardAlgorithmAsync(&handle,
+                                                      &x_desc,
+                                                      x_dev.get(),
+                                                      &w_desc,
+                                                      w_dev.get(),
+                                                      &conv_desc,
+                                                      &y_desc,
+                                                      y_dev.get(),
+                                                      request_count,
+                                                      ws_dev.get(),
+                                                      ws_size,
+                                                      false,
+                                                      &future) == miopenStatusSuccess);
+
+    auto ready = false;
+    while(!ready)
+    {
+        EXPECT(miopenConvolutionFindFutureIsReady(future, &ready) == miopenStatusSuccess);
+        if(!ready)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    auto count = 0;
+    std::vector<miopenConvAlgoPerf_t> perf(request_count);
+    EXPECT(miopenConvolutionFindFutureWait(future, &count, perf.data()) == miopenStatusSuccess);
+    EXPECT(count > 0);
+    // The results are kept for the later calls.
+    auto count_again = 0;
+    EXPECT(miopenConvolutionFindFutureWait(future, &count_again, perf.data()) ==
+           miopenStatusSuccess);
+    EXPECT(count_again == count);
+    EXPECT(miopenDestroyConvolutionFindFuture(future) == miopenStatusSuccess);
+
+    const float alpha = 1.0f;
+    const float beta  = 0.0f;
+    std::vector<float> expected;
+    for(int i = 0; i < count; i++)
+    {
+        EXPECT(miopenConvolutionForward(&handle,
+                                        &alpha,
+                                        &x_desc,
+                                        x_dev.get(),
+                                        &w_desc,
+                                        w_dev.get(),
+                                        &conv_desc,
+                                        perf[i].fwd_algo,
+                                        &beta,
+                                        &y_desc,
+                                        y_dev.get(),
+                                        ws_dev.get(),
+                                        ws_size) == miopenStatusSuccess);
+        const auto actual = handle.Read<float>(y_dev, y_desc.GetElementSize());
+        if(expected.empty())
+        {
+            expected = actual;
+            continue;
+        }
+        EXPECT(miopen::range_distance(expected) == miopen::range_distance(actual));
+        EXPECT(miopen::rms_range(expected, actual) < 1e-5);
+    }
+}
+
+int main() { test_find_async(); }
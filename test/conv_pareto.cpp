@@ -0,0 +1,121 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/miopen.h>
+#include <miopen/convolution.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/tensor.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "get_handle.hpp"
+#include "test.hpp"
+
+static miopenConvSolution_t MakeSolution(float time, std::size_t workspace, uint64_t id)
+{
+    return {time, workspace, id, miopenConvolutionAlgoDirect};
+}
+
+// Only the solutions needing less workspace than all the faster ones are kept.
+void test_front()
+{
+    const std::vector<miopenConvSolution_t> solutions = {MakeSolution(3.0f, 100, 1),
+                                                         MakeSolution(1.0f, 1000, 2),
+                                                         MakeSolution(2.0f, 0, 3),
+                                                         MakeSolution(1.5f, 1000, 4),
+                                                         MakeSolution(2.5f, 0, 5),
+                                                         MakeSolution(1.0f, 500, 6)};
+
+    const auto front = miopen::GetParetoSolutions(solutions, SIZE_MAX);
+    EXPECT(front.size() == 2);
+    EXPECT(front[0].solution_id == 6);
+    EXPECT(front[1].solution_id == 3);
+
+    const auto capped = miopen::GetParetoSolutions(solutions, 499);
+    EXPECT(capped.size() == 1);
+    EXPECT(capped[0].solution_id == 3);
+
+    const auto nothing = miopen::GetParetoSolutions({MakeSolution(1.0f, 10, 1)}, 9);
+    EXPECT(nothing.empty());
+}
+
+// The front returned by the API is ordered by time with decreasing workspace sizes, fits into
+// the budget, and is made of the solutions of miopenConvolutionForwardGetSolution.
+void test_api()
+{
+    auto&& handle = get_handle();
+
+    auto x_desc    = miopen::TensorDescriptor{miopenFloat, {4, 16, 28, 28}};
+    auto w_desc    = miopen::TensorDescriptor{miopenFloat, {32, 16, 3, 3}};
+    auto y_desc    = miopen::TensorDescriptor{miopenFloat, {4, 32, 28, 28}};
+    auto conv_desc = miopen::ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}};
+
+    std::size_t all_count = 0;
+    EXPECT(miopenConvolutionForwardGetSolutionCount(
+               &handle, &w_desc, &x_desc, &conv_desc, &y_desc, &all_count) ==
+           miopenStatusSuccess);
+    std::vector<miopenConvSolution_t> all(all_count);
+    EXPECT(miopenConvolutionForwardGetSolution(&handle,
+                                               &w_desc,
+                                               &x_desc,
+                                               &conv_desc,
+                                               &y_desc,
+                                               all.size(),
+                                               &all_count,
+                                               all.data()) == miopenStatusSuccess);
+    all.resize(all_count);
+
+    for(const auto limit : {SIZE_MAX, std::size_t{0}})
+    {
+        std::size_t count = 0;
+        std::vector<miopenConvSolution_t> front(all.size());
+        EXPECT(miopenConvolutionForwardGetSolutionWithinWorkspace(&handle,
+                                                                  &w_desc,
+                                                                  &x_desc,
+                                                                  &conv_desc,
+                                                                  &y_desc,
+                                                                  limit,
+                                                                  front.size(),
+                                                                  &count,
+                                                                  front.data()) ==
+               miopenStatusSuccess);
+        EXPECT(count == miopen::GetParetoSolutions(all, limit).size());
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            EXPECT(front[i].workspace_size <= limit);
+            if(i > 0)
+            {
+                EXPECT(front[i - 1].time <= front[i].time);
+                EXPECT(front[i - 1].workspace_size > front[i].workspace_size);
+            }
+        }
+    }
+}
+
+int main()
+{
+    test_front();
+    test_api();
+}
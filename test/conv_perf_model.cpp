@@ -0,0 +1,132 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "get_handle.hpp"
+#include "test.hpp"
+
+#include <miopen/conv/context.hpp>
+#include <miopen/conv/perf_model.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/solver_id.hpp>
+#include <miopen/tensor.hpp>
+
+namespace miopen {
+namespace tests {
+
+struct ConvPerfModelTest
+{
+    void Run() const
+    {
+        auto& handle = get_handle();
+        Ordering(handle);
+        Scaling(handle);
+        Latency(handle);
+        for(const auto direction : {conv::Direction::Forward,
+                                    conv::Direction::BackwardData,
+                                    conv::Direction::BackwardWeights})
+            Directions(handle, direction);
+    }
+
+    private:
+    static ConvolutionContext MakeContext(Handle& handle,
+                                          std::size_t n,
+                                          std::size_t c,
+                                          std::size_t hw,
+                                          std::size_t k,
+                                          std::size_t fil,
+                                          bool prefer_latency       = false,
+                                          conv::Direction direction = conv::Direction::Forward,
+                                          int stride                = 1)
+    {
+        const auto pad      = static_cast<int>(fil / 2);
+        auto conv           = ConvolutionDescriptor{{pad, pad}, {stride, stride}, {1, 1}};
+        conv.prefer_latency = prefer_latency;
+        const auto x        = TensorDescriptor{miopenFloat, {n, c, hw, hw}};
+        const auto w        = TensorDescriptor{miopenFloat, {k, c, fil, fil}};
+        const auto y        = conv.GetForwardOutputTensor(x, w);
+
+        auto ctx = ConvolutionContext{x, w, y, conv, direction};
+        ctx.SetStream(&handle);
+        return ctx;
+    }
+
+    static float Estimate(const ConvolutionContext& ctx, const char* solver, std::size_t ws = 0)
+    {
+        return conv::EstimateSolverTime(ctx, solver::Id{solver}, ws);
+    }
+
+    static void Ordering(Handle& handle)
+    {
+        const auto ctx = MakeContext(handle, 64, 256, 28, 256, 3);
+
+        const auto gemm     = Estimate(ctx, "gemm", 256 * 9 * 28 * 28 * sizeof(float));
+        const auto winograd = Estimate(ctx, "ConvBinWinogradRxSf2x3");
+        const auto naive    = Estimate(ctx, "ConvDirectNaiveConvFwd");
+
+        EXPECT(gemm > 0.0f);
+        EXPECT(winograd > 0.0f);
+        EXPECT(winograd < gemm);
+        EXPECT(gemm < naive);
+        EXPECT(Estimate(ctx, "fft") < 0.0f);
+    }
+
+    static void Scaling(Handle& handle)
+    {
+        const auto small = Estimate(MakeContext(handle, 8, 64, 56, 64, 1), "gemm");
+        const auto large = Estimate(MakeContext(handle, 64, 64, 56, 64, 1), "gemm");
+        EXPECT(small < large);
+    }
+
+    // Only the solutions of several kernels pay for the gaps between them.
+    static void Latency(Handle& handle)
+    {
+        const auto ctx     = MakeContext(handle, 1, 256, 14, 256, 3);
+        const auto latency = MakeContext(handle, 1, 256, 14, 256, 3, true);
+        const auto ws      = 256 * 9 * 14 * 14 * sizeof(float);
+
+        EXPECT(Estimate(ctx, "gemm", ws) < Estimate(latency, "gemm", ws));
+        EXPECT(Estimate(ctx, "ConvBinWinogradRxSf2x3") ==
+               Estimate(latency, "ConvBinWinogradRxSf2x3"));
+    }
+
+    // The backward problems are described by dy, so the model shall take the output size from
+    // the tensors of the forward convolution whatever the direction: a stride of 2 leaves a
+    // quarter of the output, and of the work, in every direction.
+    static void Directions(Handle& handle, conv::Direction direction)
+    {
+        const auto unstrided =
+            Estimate(MakeContext(handle, 32, 128, 56, 256, 3, false, direction, 1), "gemm");
+        const auto strided =
+            Estimate(MakeContext(handle, 32, 128, 56, 256, 3, false, direction, 2), "gemm");
+        EXPECT(strided > 0.0f);
+        EXPECT(strided * 2 < unstrided);
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::ConvPerfModelTest().Run(); }
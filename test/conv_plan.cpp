@@ -0,0 +1,144 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/miopen.h>
+#include <miopen/convolution.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/tensor.hpp>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "get_handle.hpp"
+#include "test.hpp"
+#include "verify.hpp"
+
+// Running a bound plan shall give the results of the immediate mode call with the same solution.
+struct conv_plan_test
+{
+    miopenConvDirection_t direction;
+
+    void run() const
+    {
+        auto&& handle = get_handle();
+
+        auto x_desc    = miopen::TensorDescriptor{miopenFloat, {2, 8, 14, 14}};
+        auto w_desc    = miopen::TensorDescriptor{miopenFloat, {16, 8, 3, 3}};
+        auto y_desc    = miopen::TensorDescriptor{miopenFloat, {2, 16, 14, 14}};
+        auto conv_desc = miopen::ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}};
+
+        std::mt19937 gen(23);
+        std::uniform_real_distribution<float> dist(-0.5f, 0.5f);
+        const auto random = [&](std::size_t n) {
+            std::vector<float> v(n);
+            for(auto& e : v)
+                e = dist(gen);
+            return v;
+        };
+
+        auto x_dev = handle.Write(random(x_desc.GetElementSize()));
+        auto w_dev = handle.Write(random(w_desc.GetElementSize()));
+        auto y_dev = handle.Write(random(y_desc.GetElementSize()));
+
+        std::size_t count = 0;
+        miopenConvSolution_t solution;
+        if(direction == miopenConvDirectionForward)
+            EXPECT(miopenConvolutionForwardGetSolution(
+                       &handle, &w_desc, &x_desc, &conv_desc, &y_desc, 1, &count, &solution) ==
+                   miopenStatusSuccess);
+        else
+            EXPECT(miopenConvolutionBackwardDataGetSolution(
+                       &handle, &y_desc, &w_desc, &conv_desc, &x_desc, 1, &count, &solution) ==
+                   miopenStatusSuccess);
+        EXPECT(count == 1);
+
+        auto ws_dev = handle.Create(std::max<std::size_t>(solution.workspace_size, 1));
+
+        // The output buffer of the direction, x for backward data and y for forward.
+        const auto& out_desc = direction == miopenConvDirectionForward ? y_desc : x_desc;
+        auto& out_dev        = direction == miopenConvDirectionForward ? y_dev : x_dev;
+
+        if(direction == miopenConvDirectionForward)
+            EXPECT(miopenConvolutionForwardImmediate(&handle,
+                                                     &w_desc,
+                                                     w_dev.get(),
+                                                     &x_desc,
+                                                     x_dev.get(),
+                                                     &conv_desc,
+                                                     &y_desc,
+                                                     y_dev.get(),
+                                                     ws_dev.get(),
+                                                     solution.workspace_size,
+                                                     solution.solution_id) == miopenStatusSuccess);
+        else
+            EXPECT(miopenConvolutionBackwardDataImmediate(&handle,
+                                                          &y_desc,
+                                                          y_dev.get(),
+                                                          &w_desc,
+                                                          w_dev.get(),
+                                                          &conv_desc,
+                                                          &x_desc,
+                                                          x_dev.get(),
+                                                          ws_dev.get(),
+                                                          solution.workspace_size,
+                                                          solution.solution_id) ==
+                   miopenStatusSuccess);
+        const auto expected = handle.Read<float>(out_dev, out_desc.GetElementSize());
+
+        miopenConvProblem_t problem  = {&x_desc, &w_desc, &y_desc, &conv_desc, direction};
+        miopenConvolutionPlan_t plan = nullptr;
+        EXPECT(miopenCreateConvolutionPlan(&handle, &problem, solution.solution_id, &plan) ==
+               miopenStatusSuccess);
+
+        std::size_t plan_ws_size = 0;
+        EXPECT(miopenGetConvolutionPlanWorkspaceSize(plan, &plan_ws_size) == miopenStatusSuccess);
+        EXPECT(plan_ws_size == solution.workspace_size);
+
+        // Run a few times to make sure the prepared arguments are not consumed by a run.
+        for(int i = 0; i < 3; i++)
+        {
+            const auto zeros = std::vector<float>(out_desc.GetElementSize(), 0.0f);
+            handle.WriteTo(zeros.data(), out_dev, zeros.size() * sizeof(float));
+            EXPECT(miopenRunConvolutionPlan(&handle,
+                                            plan,
+                                            x_dev.get(),
+                                            w_dev.get(),
+                                            y_dev.get(),
+                                            ws_dev.get(),
+                                            plan_ws_size) == miopenStatusSuccess);
+            const auto actual = handle.Read<float>(out_dev, out_desc.GetElementSize());
+            EXPECT(miopen::range_distance(expected) == miopen::range_distance(actual));
+            EXPECT(miopen::rms_range(expected, actual) < 1e-6);
+        }
+
+        EXPECT(miopenDestroyConvolutionPlan(plan) == miopenStatusSuccess);
+    }
+};
+
+int main()
+{
+    for(auto direction : {miopenConvDirectionForward, miopenConvDirectionBackwardData})
+        conv_plan_test{direction}.run();
+}
@@ -0,0 +1,93 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/conv/problem_key.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/tensor.hpp>
+
+namespace miopen {
+namespace tests {
+
+struct ProblemKeyTest
+{
+    void Run() const
+    {
+        const auto x    = TensorDescriptor{miopenFloat, {16, 64, 28, 28}};
+        const auto w    = TensorDescriptor{miopenFloat, {128, 64, 3, 3}};
+        const auto y    = TensorDescriptor{miopenFloat, {16, 128, 28, 28}};
+        const auto conv = ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}};
+        const auto fwd  = conv::Direction::Forward;
+
+        const auto key = conv::ProblemKey{x, w, y, conv, fwd};
+        EXPECT(key.IsValid());
+        EXPECT(key == (conv::ProblemKey{x, w, y, conv, fwd}));
+        EXPECT(key.Hash() == (conv::ProblemKey{x, w, y, conv, fwd}).Hash());
+
+        // Everything the network config depends on is a part of the key.
+        const auto x_nhwc =
+            TensorDescriptor{miopenFloat, {16, 64, 28, 28}, {64 * 28 * 28, 1, 28 * 64, 64}};
+        const auto y_half  = TensorDescriptor{miopenHalf, {16, 128, 28, 28}};
+        const auto padless = ConvolutionDescriptor{{0, 0}, {1, 1}, {1, 1}};
+        const auto grouped = ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}, {0, 0}, 2};
+
+        auto latency           = conv;
+        latency.prefer_latency = true;
+
+        EXPECT(key != (conv::ProblemKey{x_nhwc, w, y, conv, fwd}));
+        EXPECT(key != (conv::ProblemKey{x, w, y_half, conv, fwd}));
+        EXPECT(key != (conv::ProblemKey{x, w, y, padless, fwd}));
+        EXPECT(key != (conv::ProblemKey{x, w, y, grouped, fwd}));
+        EXPECT(key != (conv::ProblemKey{x, w, y, latency, fwd}));
+        EXPECT(key != (conv::ProblemKey{x, w, y, conv, conv::Direction::BackwardData}));
+        EXPECT(key != (conv::ProblemKey{y, w, x, conv, fwd}));
+
+        // The deterministic mode of the handle separates the backward weights problems.
+        const auto wrw = conv::Direction::BackwardWeights;
+        EXPECT((conv::ProblemKey{x, w, y, conv, wrw}) !=
+               (conv::ProblemKey{x, w, y, conv, wrw, true}));
+        auto wrw_problem      = conv::ProblemDescription{x, w, y, conv, wrw};
+        const auto wrw_config = wrw_problem.BuildConfKey();
+        wrw_problem.SetDeterministic(true);
+        EXPECT(wrw_problem.BuildConfKey().ToString() != wrw_config.ToString());
+
+        const auto x6 = TensorDescriptor{miopenFloat, {1, 16, 64, 8, 28, 28}};
+        EXPECT(!(conv::ProblemKey{x6, w, y, conv, fwd}).IsValid());
+
+        Handle handle;
+        EXPECT(handle.GetProblemConfig(key).IsEmpty());
+        const auto config = handle.RegisterProblemConfig(key, NetworkConfig{"problem_key_test"});
+        EXPECT(config.ToString() == "problem_key_test");
+        EXPECT(handle.GetProblemConfig(conv::ProblemKey{x, w, y, conv, fwd}) == config);
+        EXPECT(handle.GetProblemConfig(conv::ProblemKey{x, w, y, padless, fwd}).IsEmpty());
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::ProblemKeyTest().Run(); }
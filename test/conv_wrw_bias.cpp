@@ -0,0 +1,112 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "test.hpp"
+#include "driver.hpp"
+#include "get_handle.hpp"
+#include "tensor_holder.hpp"
+#include "rms_check.hpp"
+#include "verify.hpp"
+#include "cpu_conv.hpp"
+
+#include <miopen/config.h>
+#include <miopen/convolution.hpp>
+#include <miopen/miopen.h>
+
+/*
+ * The GEMM weights pass of a 3x3 convolution extends im2col(x) by a row of ones, so the
+ * bias gradient is the last column of the same GEMM over dy.
+ */
+void chk_conv_wrw_bias()
+{
+    auto&& handle  = get_handle();
+    const auto gen = tensor_elem_gen_centered{};
+
+    miopen::ConvolutionDescriptor filter{{1, 1}, {1, 1}, {1, 1}};
+    auto input   = tensor<float>{2, 8, 8, 8}.generate(gen);
+    auto weights = tensor<float>{16, 8, 3, 3};
+    auto bias    = tensor<float>{1, 16, 1, 1};
+    auto dout =
+        tensor<float>{filter.GetForwardOutputTensor(input.desc, weights.desc)}.generate(gen);
+
+    auto ref_weights = weights;
+    cpu_convolution_backward_weight(filter.GetSpatialDimension(),
+                                    input,
+                                    ref_weights,
+                                    dout,
+                                    filter.GetConvPads(),
+                                    filter.GetConvStrides(),
+                                    filter.GetConvDilations(),
+                                    filter.GetGroupCount());
+    auto ref_bias = bias;
+    dout.for_each([&](std::size_t n, std::size_t k, std::size_t h, std::size_t w) {
+        ref_bias(0, k, 0, 0) += dout(n, k, h, w);
+    });
+
+    std::size_t workspace_size = 0;
+    STATUS(miopenConvolutionBackwardWeightsBiasGetWorkSpaceSize(
+        &handle, &dout.desc, &input.desc, &filter, &weights.desc, &workspace_size));
+    EXPECT(workspace_size >= filter.BackwardWeightsGetWorkSpaceSizeGEMM(dout.desc, weights.desc));
+
+    auto in_dev   = handle.Write(input.data);
+    auto dout_dev = handle.Write(dout.data);
+    auto dw_dev   = handle.Write(weights.data);
+    auto db_dev   = handle.Write(bias.data);
+    auto ws_dev   = handle.Create(workspace_size);
+
+    float alpha = 1.f, beta = 0.f;
+    STATUS(miopenConvolutionBackwardWeightsBias(&handle,
+                                                &alpha,
+                                                &dout.desc,
+                                                dout_dev.get(),
+                                                &input.desc,
+                                                in_dev.get(),
+                                                &filter,
+                                                miopenConvolutionBwdWeightsAlgoGEMM,
+                                                &beta,
+                                                &weights.desc,
+                                                dw_dev.get(),
+                                                &bias.desc,
+                                                db_dev.get(),
+                                                ws_dev.get(),
+                                                workspace_size));
+    weights.data = handle.Read<float>(dw_dev, weights.data.size());
+    bias.data    = handle.Read<float>(db_dev, bias.data.size());
+
+    expect_rms("Conv wrw bias weights", ref_weights.data, weights.data);
+    expect_rms("Conv wrw bias bias", ref_bias.data, bias.data);
+}
+
+int main()
+{
+#if MIOPEN_USE_GEMM
+    /*
+     * This test ensures that the weights and bias gradients computed by the fused
+     * GEMM pass over dy match the host reference.
+     */
+    chk_conv_wrw_bias();
+#endif
+}
@@ -688,7 +688,7 @@ struct ctc_driver : test_driver
     {
         add(batchSize, "batch-size", generate_data({1, 16, 32, 64, 128}));
         add(inputLen, "input-len", generate_data({100}));
-        add(labelLen, "label-len", generate_data({40}));
+        add(labelLen, "label-len", generate_data({40, 200}));
         add(numClass, "num-class", generate_data({28, 5000}));
         add(is_softmax_applied, "apply-softmax-layer", generate_data({true, false}));
         add(blank_id, "blank-label-id", generate_data({0, 1000}));
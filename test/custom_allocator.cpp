@@ -113,10 +113,39 @@ struct test_deallocator2 : allocator_fixture
     }
 };
 
+struct test_allocator_ex : allocator_fixture
+{
+    miopenAcceleratorQueue_t stream = nullptr;
+
+    void run()
+    {
+        stream = h.GetStream();
+        h.SetAllocatorEx(
+            +[](void* ctx,
+                std::size_t n,
+                miopenAllocationHint_t hint,
+                miopenAcceleratorQueue_t queue) -> void* {
+                auto self = reinterpret_cast<test_allocator_ex*>(ctx);
+                CHECK(n == 64);
+                CHECK(hint == miopenAllocationScratch);
+                CHECK(queue == self->stream);
+                return self->buffer.get();
+            },
+            +[](void*, void*) {},
+            this);
+        miopen::Allocator::ManageDataPtr p = h.Create(size, miopenAllocationScratch);
+        CHECK(p.get() == buffer.get());
+        CHECK(miopen::Allocator::GetBucketSize(1) == 1);
+        CHECK(miopen::Allocator::GetBucketSize(64) == 64);
+        CHECK(miopen::Allocator::GetBucketSize(65) == 128);
+    }
+};
+
 int main()
 {
     run_test<test_allocator>();
     run_test<test_null_allocator>();
     run_test<test_deallocator>();
     run_test<test_deallocator2>();
+    run_test<test_allocator_ex>();
 }
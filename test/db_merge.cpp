@@ -0,0 +1,95 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "test.hpp"
+#include <miopen/db_merge.hpp>
+
+#include <sstream>
+#include <string>
+
+namespace miopen {
+namespace tests {
+
+struct DbMergeTest
+{
+    void Run() const
+    {
+        EXPECT(DbMerger::GetKind("/db/gfx906_60.HIP.fdb.txt") == DbMerger::Kind::Find);
+        EXPECT(DbMerger::GetKind("/db/gfx906_60.HIP.INT.ufdb.txt") == DbMerger::Kind::Find);
+        EXPECT(DbMerger::GetKind("/db/gfx906_60.cd.updb.txt") == DbMerger::Kind::Perf);
+
+        TestFind();
+        TestPerf();
+    }
+
+    private:
+    static std::string Merge(DbMerger& merger, const std::string& a, const std::string& b)
+    {
+        std::istringstream first{a};
+        std::istringstream second{b};
+        merger.Add(first, "a");
+        merger.Add(second, "b");
+        std::ostringstream out;
+        merger.Write(out);
+        return out.str();
+    }
+
+    static void TestFind()
+    {
+        auto merger = DbMerger{DbMerger::Kind::Find};
+        const auto out =
+            Merge(merger,
+                  "k2=algoA:SolverX,2.5,0,algoA,<unused>;algoB:SolverY,4,16,algoB,<unused>\n"
+                  "k1=algoA:SolverX,1,0,algoA,<unused>\n",
+                  "k2=algoA:SolverZ,1.5,32,algoA,<unused>;algoB:SolverY,5,16,algoB,<unused>\n"
+                  "k3=algoC:SolverW,3,0,algoC,<unused>\n"
+                  "ill-formed line\n");
+
+        EXPECT(out == "k1=algoA:SolverX,1,0,algoA,<unused>\n"
+                      "k2=algoA:SolverZ,1.5,32,algoA,<unused>;algoB:SolverY,4,16,algoB,<unused>\n"
+                      "k3=algoC:SolverW,3,0,algoC,<unused>\n");
+        EXPECT(merger.GetConflictCount() == 2);
+        // Only the fastest solver changed between the nodes for k2.
+        EXPECT(merger.GetDisputedKeys() == std::set<std::string>{"k2"});
+    }
+
+    static void TestPerf()
+    {
+        auto merger    = DbMerger{DbMerger::Kind::Perf};
+        const auto out = Merge(merger,
+                               "k1=SolverX:1,2,3;SolverY:4\n",
+                               "k1=SolverX:1,2,4;SolverZ:5\nk2=SolverX:7\nk1=SolverY:4\n");
+
+        EXPECT(out == "k1=SolverX:1,2,3;SolverY:4;SolverZ:5\nk2=SolverX:7\n");
+        EXPECT(merger.GetConflictCount() == 1);
+        EXPECT(merger.GetDisputedKeys() == std::set<std::string>{"k1"});
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::DbMergeTest().Run(); }
@@ -73,7 +73,8 @@ struct verify_forward_dropout
     tensor<T> cpu() const
     {
         auto states_cpu = std::vector<prngStates>(DropoutDesc.stateSizeInBytes);
-        InitKernelStateEmulator(states_cpu, DropoutDesc);
+        if(DropoutDesc.rng_mode != MIOPEN_RNG_PHILOX_4X32_10)
+            InitKernelStateEmulator(states_cpu, DropoutDesc);
 
         auto out_cpu   = output;
         auto rsvsp_cpu = rsvsp;
@@ -224,6 +225,7 @@ struct dropout_driver : test_driver
     bool mask{};
     std::vector<int> in_dim{};
     int rng_mode_cmd = 0;
+    int mask_format  = 0;
 
     dropout_driver()
     {
@@ -252,7 +254,8 @@ struct dropout_driver : test_driver
         add(dropout_rate, "dropout", generate_data({float(0.0), float(0.5), float(1.0)}));
         add(seed, "seed", generate_data({0x0ULL, 0xFFFFFFFFFFFFFFFFULL}));
         add(mask, "use-mask", generate_data({false, true}));
-        add(rng_mode_cmd, "rng-mode", generate_data({0}));
+        add(rng_mode_cmd, "rng-mode", generate_data({0, 1}));
+        add(mask_format, "mask-format", generate_data({0, 1}));
     }
 
     void run()
@@ -271,8 +274,12 @@ struct dropout_driver : test_driver
         miopenRNGType_t rng_mode = miopenRNGType_t(rng_mode_cmd);
 
         size_t stateSizeInBytes =
-            std::min(size_t(MAX_PRNG_STATE), handle.GetImage3dMaxWidth()) * sizeof(prngStates);
-        size_t reserveSpaceSizeInBytes = in.desc.GetElementSize() * sizeof(bool);
+            rng_mode == MIOPEN_RNG_PHILOX_4X32_10
+                ? 0
+                : std::min(size_t(MAX_PRNG_STATE), handle.GetImage3dMaxWidth()) *
+                      sizeof(prngStates);
+        DropoutDesc.mask_format        = miopenDropoutMaskFormat_t(mask_format);
+        size_t reserveSpaceSizeInBytes = DropoutDesc.GetReserveSpaceSize(in.desc.GetElementSize());
         size_t total_mem =
             2 * (2 * in.desc.GetNumBytes() + reserveSpaceSizeInBytes) + stateSizeInBytes;
         size_t device_mem = handle.GetGlobalMemorySize();
@@ -301,13 +308,16 @@ struct dropout_driver : test_driver
             return;
         }
 
-        auto reserveSpace = std::vector<unsigned char>(in.desc.GetElementSize());
+        auto reserveSpace = std::vector<unsigned char>(reserveSpaceSizeInBytes);
         if(mask)
         {
             srand(0);
             for(size_t i = 0; i < in.desc.GetElementSize(); i++)
-                reserveSpace[i] =
-                    static_cast<unsigned char>(float(rand()) / float(RAND_MAX) > dropout_rate);
+                SetMaskEmu(DropoutDesc,
+                           reserveSpace,
+                           0,
+                           i,
+                           float(rand()) / float(RAND_MAX) > dropout_rate);
         }
 
         DropoutDesc.dropout          = dropout_rate;
@@ -316,10 +326,15 @@ struct dropout_driver : test_driver
         DropoutDesc.use_mask         = mask;
         DropoutDesc.rng_mode         = rng_mode;
 
-        auto state_buf      = handle.Create<unsigned char>(stateSizeInBytes);
-        DropoutDesc.pstates = state_buf.get();
-        DropoutDesc.InitPRNGState(
-            handle, DropoutDesc.pstates, DropoutDesc.stateSizeInBytes, DropoutDesc.seed);
+        // philox runs without any state buffer
+        miopen::Allocator::ManageDataPtr state_buf = nullptr;
+        if(rng_mode != MIOPEN_RNG_PHILOX_4X32_10)
+        {
+            state_buf           = handle.Create<unsigned char>(stateSizeInBytes);
+            DropoutDesc.pstates = state_buf.get();
+            DropoutDesc.InitPRNGState(
+                handle, DropoutDesc.pstates, DropoutDesc.stateSizeInBytes, DropoutDesc.seed);
+        }
 #if DROPOUT_DEBUG_CTEST
         std::cout <<
 #if MIOPEN_BACKEND_OPENCL
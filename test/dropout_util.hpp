@@ -132,6 +132,28 @@ inline float uniform_distribution_emu(size_t v)
     return ROCRAND_2POW32_INV + (v * ROCRAND_2POW32_INV);
 }
 
+inline unsigned int philox_element_emu(size_t idx, size_t offset, unsigned long long seed)
+{
+    unsigned int ctr[4] = {
+        static_cast<unsigned int>(idx / 4), static_cast<unsigned int>(offset), 0, 0};
+    auto key0 = static_cast<unsigned int>(seed & 0xFFFFFFFF);
+    auto key1 = static_cast<unsigned int>(seed >> 32);
+    for(int r = 0; r < 10; r++)
+    {
+        unsigned long long p0 = 0xD2511F53ULL * ctr[0];
+        unsigned long long p1 = 0xCD9E8D57ULL * ctr[2];
+
+        ctr[0] = static_cast<unsigned int>(p1 >> 32) ^ ctr[1] ^ key0;
+        ctr[1] = static_cast<unsigned int>(p1);
+        ctr[2] = static_cast<unsigned int>(p0 >> 32) ^ ctr[3] ^ key1;
+        ctr[3] = static_cast<unsigned int>(p0);
+
+        key0 += 0x9E3779B9U;
+        key1 += 0xBB67AE85U;
+    }
+    return ctr[idx % 4];
+}
+
 inline void xorwow_skipahead_emu(unsigned long long skp,
                                  prngStates* state,
                                  const unsigned int skipahead_mat[XORWOW_PRECALC_MATRICES_NUM]
@@ -270,6 +292,33 @@ inline void ExpandTensorDim(std::vector<T> x_len,
         *(itr_os--) = *(itr_os + 1) * *(itr_os + 1 - out_str.begin() + out_len.begin());
 }
 
+// mask of element si of a reservespace laid out in the descriptor's mask format
+inline bool GetMaskEmu(const miopen::DropoutDescriptor& DropoutDesc,
+                       const std::vector<unsigned char>& reservespace,
+                       size_t rsvsp_offset,
+                       size_t si)
+{
+    if(DropoutDesc.mask_format == MIOPEN_DROPOUT_MASK_BIT)
+        return ((reservespace[rsvsp_offset + si / 8] >> (si % 8)) & 1) != 0;
+    return bool(reservespace[rsvsp_offset + si]);
+}
+
+inline void SetMaskEmu(const miopen::DropoutDescriptor& DropoutDesc,
+                       std::vector<unsigned char>& reservespace,
+                       size_t rsvsp_offset,
+                       size_t si,
+                       bool kept)
+{
+    if(DropoutDesc.mask_format == MIOPEN_DROPOUT_MASK_BIT)
+    {
+        auto& byte = reservespace[rsvsp_offset + si / 8];
+        byte       = static_cast<unsigned char>(kept ? byte | (1U << (si % 8))
+                                                     : byte & ~(1U << (si % 8)));
+    }
+    else
+        reservespace[rsvsp_offset + si] = static_cast<unsigned char>(kept);
+}
+
 template <typename T>
 void DropoutForwardVerify(miopen::Handle& handle,
                           const miopen::DropoutDescriptor& DropoutDesc,
@@ -319,15 +368,21 @@ void DropoutForwardVerify(miopen::Handle& handle,
                         size_t si = i0 * in_len[1] * in_len[2] * in_len[3] * in_len[4] +
                                     i1 * in_len[2] * in_len[3] * in_len[4] +
                                     i2 * in_len[3] * in_len[4] + i3 * in_len[4] + i4;
-                        size_t ri = rsvsp_offset + si;
 
                         if(!use_mask)
-                            reservespace[ri] =
-                                uniform_distribution_emu(xorwow_next(&states[si % glb_sz])) >
-                                dropout_rate;
+                            SetMaskEmu(
+                                DropoutDesc,
+                                reservespace,
+                                rsvsp_offset,
+                                si,
+                                uniform_distribution_emu(
+                                    DropoutDesc.rng_mode == MIOPEN_RNG_PHILOX_4X32_10
+                                        ? philox_element_emu(si, rsvsp_offset, DropoutDesc.seed)
+                                        : xorwow_next(&states[si % glb_sz])) > dropout_rate);
 
                         output[oi] =
-                            bool(reservespace[ri]) && !miopen::float_equal(dropout_rate, 1.0)
+                            GetMaskEmu(DropoutDesc, reservespace, rsvsp_offset, si) &&
+                                    !miopen::float_equal(dropout_rate, 1.0)
                                 ? static_cast<T>(input[ii] / (1 - dropout_rate))
                                 : T(0);
                     }
@@ -367,11 +422,12 @@ void DropoutBackwardVerify(const miopen::DropoutDescriptor& DropoutDesc,
             out_offset + i0 * out_str[0] + i1 * out_str[1] + i2 * out_str[2] + i3 * out_str[3] + i4;
         size_t ii =
             in_offset + i0 * in_str[0] + i1 * in_str[1] + i2 * in_str[2] + i3 * in_str[3] + i4;
-        size_t ri = rsvsp_offset + i0 * in_len[1] * in_len[2] * in_len[3] * in_len[4] +
+        size_t si = i0 * in_len[1] * in_len[2] * in_len[3] * in_len[4] +
                     i1 * in_len[2] * in_len[3] * in_len[4] + i2 * in_len[3] * in_len[4] +
                     i3 * in_len[4] + i4;
 
-        din[ii] = static_cast<T>(bool(reservespace[ri]) && !miopen::float_equal(dropout_rate, 1.0)
+        din[ii] = static_cast<T>(GetMaskEmu(DropoutDesc, reservespace, rsvsp_offset, si) &&
+                                         !miopen::float_equal(dropout_rate, 1.0)
                                      ? dout[oi] / (1 - dropout_rate)
                                      : 0);
     });
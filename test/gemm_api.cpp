@@ -0,0 +1,136 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include "driver.hpp"
+#include "get_handle.hpp"
+#include "tensor_holder.hpp"
+#include "rms_check.hpp"
+#include "verify.hpp"
+
+#include <miopen/config.h>
+#include <miopen/miopen.h>
+
+#include <vector>
+
+#if MIOPEN_USE_GEMM
+// batch row-major problems, of op(A) m x k, op(B) k x n and C m x n, each padded by one column.
+void chk_gemm_api(bool transA, bool transB, int m, int n, int k, int batch)
+{
+    auto&& handle = get_handle();
+
+    const int lda            = (transA ? m : k) + 1;
+    const int ldb            = (transB ? k : n) + 1;
+    const int ldc            = n + 1;
+    const long long stride_a = static_cast<long long>(transA ? k : m) * lda;
+    const long long stride_b = static_cast<long long>(transB ? n : k) * ldb;
+    const long long stride_c = static_cast<long long>(m) * ldc;
+    const float alpha        = 2;
+    const float beta         = 0.5;
+
+    auto a = tensor<float>{std::vector<std::size_t>(1, stride_a * batch)}.generate(
+        tensor_elem_gen_integer{7});
+    auto b = tensor<float>{std::vector<std::size_t>(1, stride_b * batch)}.generate(
+        tensor_elem_gen_integer{5});
+    auto c = tensor<float>{std::vector<std::size_t>(1, stride_c * batch)}.generate(
+        tensor_elem_gen_integer{3});
+
+    auto ref = c;
+    for(int p = 0; p < batch; ++p)
+    {
+        for(int i = 0; i < m; ++i)
+        {
+            for(int j = 0; j < n; ++j)
+            {
+                double acc = 0;
+                for(int l = 0; l < k; ++l)
+                    acc += double(a[p * stride_a + (transA ? l * lda + i : i * lda + l)]) *
+                           b[p * stride_b + (transB ? j * ldb + l : l * ldb + j)];
+                auto& out = ref[p * stride_c + i * ldc + j];
+                out       = alpha * acc + beta * out;
+            }
+        }
+    }
+
+    auto a_dev = handle.Write(a.data);
+    auto b_dev = handle.Write(b.data);
+    auto c_dev = handle.Write(c.data);
+    if(batch == 1)
+        EXPECT(miopenGemm(&handle,
+                          miopenFloat,
+                          transA,
+                          transB,
+                          m,
+                          n,
+                          k,
+                          alpha,
+                          a_dev.get(),
+                          lda,
+                          b_dev.get(),
+                          ldb,
+                          beta,
+                          c_dev.get(),
+                          ldc) == miopenStatusSuccess);
+    else
+        EXPECT(miopenGemmStridedBatched(&handle,
+                                        miopenFloat,
+                                        transA,
+                                        transB,
+                                        m,
+                                        n,
+                                        k,
+                                        alpha,
+                                        a_dev.get(),
+                                        lda,
+                                        stride_a,
+                                        b_dev.get(),
+                                        ldb,
+                                        stride_b,
+                                        beta,
+                                        c_dev.get(),
+                                        ldc,
+                                        stride_c,
+                                        batch) == miopenStatusSuccess);
+    c.data = handle.Read<float>(c_dev, c.data.size());
+
+    expect_rms("GEMM", ref.data, c.data);
+}
+#endif
+
+int main()
+{
+#if MIOPEN_USE_GEMM
+    chk_gemm_api(false, false, 9, 13, 7, 1);
+    chk_gemm_api(true, false, 9, 13, 7, 1);
+    chk_gemm_api(false, true, 16, 8, 12, 3);
+    chk_gemm_api(true, true, 5, 11, 6, 4);
+
+    // int32 has no GEMM of its own
+    auto&& handle = get_handle();
+    float x       = 0;
+    EXPECT(miopenGemm(&handle, miopenInt32, false, false, 1, 1, 1, 1, &x, 1, &x, 1, 0, &x, 1) ==
+           miopenStatusBadParm);
+#endif
+}
@@ -0,0 +1,129 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "test.hpp"
+#include "driver.hpp"
+#include "get_handle.hpp"
+#include "tensor_holder.hpp"
+#include "rms_check.hpp"
+#include "verify.hpp"
+
+#include <miopen/config.h>
+#include <miopen/gemm_v2.hpp>
+#include <miopen/miopen.h>
+
+#include <vector>
+
+#if MIOPEN_USE_GEMM
+// A row-major problem of the group, of m x k A, k x n B and m x n C, all packed.
+miopen::GemmGroupProblem
+grouped_problem(int m, int n, int k, float beta, int a_offset, int b_offset, int c_offset)
+{
+    return {miopen::GemmDescriptor{false,
+                                   false,
+                                   false,
+                                   m,
+                                   n,
+                                   k,
+                                   k,
+                                   n,
+                                   n,
+                                   1, // batch count
+                                   0, // Stride A
+                                   0, // Stride B
+                                   0, // Stride C
+                                   1, // alpha
+                                   beta,
+                                   miopenFloat},
+            nullptr,
+            a_offset,
+            nullptr,
+            b_offset,
+            nullptr,
+            c_offset};
+}
+
+void chk_gemm_grouped()
+{
+    auto&& handle = get_handle();
+
+    // Three evenly spaced problems of one size sharing a launch, two of another size and one
+    // accumulating into the C of an earlier problem.
+    std::vector<miopen::GemmGroupProblem> problems;
+    for(int i = 0; i < 3; ++i)
+        problems.push_back(grouped_problem(8, 12, 5, 0, i * 8 * 5, i * 5 * 12, i * 8 * 12));
+    problems.push_back(grouped_problem(3, 7, 9, 0, 200, 300, 400));
+    problems.push_back(grouped_problem(3, 7, 9, 0, 240, 400, 500));
+    problems.push_back(grouped_problem(8, 12, 5, 1, 300, 500, 8 * 12));
+
+    auto a = tensor<float>{std::vector<std::size_t>{1024}}.generate(tensor_elem_gen_integer{7});
+    auto b = tensor<float>{std::vector<std::size_t>{1024}}.generate(tensor_elem_gen_integer{5});
+    auto c = tensor<float>{std::vector<std::size_t>{1024}}.generate(tensor_elem_gen_integer{3});
+
+    auto ref = c;
+    for(const auto& problem : problems)
+    {
+        const auto& desc = problem.gemm_desc;
+        for(int i = 0; i < desc.m; ++i)
+        {
+            for(int j = 0; j < desc.n; ++j)
+            {
+                double acc = 0;
+                for(int l = 0; l < desc.k; ++l)
+                    acc += double(a[problem.a_offset + i * desc.lda + l]) *
+                           b[problem.b_offset + l * desc.ldb + j];
+                auto& out = ref[problem.c_offset + i * desc.ldc + j];
+                out       = desc.alpha * acc + desc.beta * out;
+            }
+        }
+    }
+
+    auto a_dev = handle.Write(a.data);
+    auto b_dev = handle.Write(b.data);
+    auto c_dev = handle.Write(c.data);
+    for(auto& problem : problems)
+    {
+        problem.A = a_dev.get();
+        problem.B = b_dev.get();
+        problem.C = c_dev.get();
+    }
+    EXPECT(miopen::CallGemmGrouped(handle, problems) == miopenStatusSuccess);
+    c.data = handle.Read<float>(c_dev, c.data.size());
+
+    expect_rms("Grouped GEMM", ref.data, c.data);
+}
+#endif
+
+int main()
+{
+#if MIOPEN_USE_GEMM
+    /*
+     * The problems of a grouped GEMM merged into strided batched launches must give the
+     * results of the problems run one by one.
+     */
+    chk_gemm_grouped();
+#endif
+}
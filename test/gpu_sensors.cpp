@@ -0,0 +1,122 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "test.hpp"
+#include <miopen/gpu_sensors.hpp>
+#include <miopen/tmp_dir.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <sstream>
+
+namespace miopen {
+namespace tests {
+
+struct GpuSensorsTest
+{
+    void Run() const
+    {
+        ParseSclk();
+        ReadSysfs();
+        MissingSysfs();
+        SerializeConditions();
+    }
+
+    private:
+    static void Write(const boost::filesystem::path& path, const std::string& contents)
+    {
+        std::ofstream file{path.string()};
+        file << contents;
+    }
+
+    static void ParseSclk()
+    {
+        EXPECT(ParseCurrentSclk("0: 500Mhz\n1: 1000Mhz *\n2: 1500Mhz\n") == 1000);
+        EXPECT(ParseCurrentSclk("0: 500Mhz *\n1: 1000Mhz\n") == 500);
+        EXPECT(ParseCurrentSclk("0: 500Mhz\n1: 1000Mhz\n") == 0);
+        EXPECT(ParseCurrentSclk("") == 0);
+    }
+
+    static void ReadSysfs()
+    {
+        const TmpDir device{"gpu_sensors"};
+        boost::filesystem::create_directories(device.path / "hwmon" / "hwmon3");
+        Write(device.path / "pp_dpm_sclk", "0: 800Mhz\n1: 1700Mhz *\n");
+        Write(device.path / "hwmon" / "hwmon3" / "temp1_input", "61000\n");
+
+        const GpuSensors sensors{device.path.string()};
+        EXPECT(sensors.IsEnabled());
+        const auto conditions = sensors.Read();
+        EXPECT(conditions.IsKnown());
+        EXPECT(conditions.sclk_mhz == 1700);
+        EXPECT(conditions.temperature_mc == 61000);
+    }
+
+    static void MissingSysfs()
+    {
+        const TmpDir device{"gpu_sensors"};
+        const GpuSensors sensors{device.path.string()};
+        EXPECT(!sensors.IsEnabled());
+        EXPECT(!sensors.Read().IsKnown());
+        EXPECT(!GpuSensors{}.IsEnabled());
+    }
+
+    static void SerializeConditions()
+    {
+        auto conditions = TuningConditions{};
+        for(const auto sclk : {1500, 1700, 1200})
+        {
+            auto sample           = GpuConditions{};
+            sample.sclk_mhz       = sclk;
+            sample.temperature_mc = sclk * 40;
+            conditions.Add(sample);
+            if(sclk == 1700)
+                conditions.SetBest(sample);
+        }
+        conditions.remeasured = 2;
+        EXPECT(conditions.min_sclk_mhz == 1200);
+        EXPECT(conditions.max_sclk_mhz == 1700);
+        EXPECT(conditions.max_temperature_mc == 68000);
+
+        std::ostringstream ss;
+        conditions.Serialize(ss);
+        EXPECT(ss.str() == "1700,68000,1200,1700,68000,2");
+
+        auto restored = TuningConditions{};
+        EXPECT(restored.Deserialize(ss.str()));
+        EXPECT(restored.best_sclk_mhz == 1700);
+        EXPECT(restored.min_sclk_mhz == 1200);
+        EXPECT(restored.remeasured == 2);
+        EXPECT(!restored.Deserialize("1700,68000,1200"));
+        EXPECT(!restored.Deserialize("1700;68000;1200;1700;68000;2"));
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::GpuSensorsTest().Run(); }
@@ -0,0 +1,271 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/miopen.h>
+#include <miopen/activ.hpp>
+#include <miopen/batch_norm.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/graph.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/pooling.hpp>
+#include <miopen/tensor.hpp>
+#include <miopen/tensor_ops.hpp>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "get_handle.hpp"
+#include "test.hpp"
+#include "verify.hpp"
+
+// A graph shall compute what the layers compute one by one.
+struct graph_test
+{
+    std::mt19937 gen{29};
+
+    std::vector<float> Random(std::size_t n, float lo = -0.5f, float hi = 0.5f)
+    {
+        std::uniform_real_distribution<float> dist(lo, hi);
+        std::vector<float> v(n);
+        for(auto& e : v)
+            e = dist(gen);
+        return v;
+    }
+
+    void run()
+    {
+        Network();
+        MemoryReuse();
+        InvalidGraphs();
+    }
+
+    // conv, bias, relu, max pooling, batch norm, relu
+    void Network()
+    {
+        auto&& handle = get_handle();
+
+        auto x_desc    = miopen::TensorDescriptor{miopenFloat, {2, 8, 14, 14}};
+        auto w_desc    = miopen::TensorDescriptor{miopenFloat, {16, 8, 3, 3}};
+        auto c_desc    = miopen::TensorDescriptor{miopenFloat, {2, 16, 14, 14}};
+        auto b_desc    = miopen::TensorDescriptor{miopenFloat, {1, 16, 1, 1}};
+        auto p_desc    = miopen::TensorDescriptor{miopenFloat, {2, 16, 7, 7}};
+        auto conv_desc = miopen::ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}};
+        auto relu      = miopen::ActivationDescriptor{miopenActivationRELU, 0., 0., 0.};
+        auto pooling   = miopen::PoolingDescriptor{miopenPoolingMax,
+                                                 miopenPaddingDefault,
+                                                 std::vector<int>{2, 2},
+                                                 std::vector<int>{2, 2},
+                                                 std::vector<int>{0, 0}};
+
+        auto x_dev     = handle.Write(Random(x_desc.GetElementSize()));
+        auto w_dev     = handle.Write(Random(w_desc.GetElementSize()));
+        auto b_dev     = handle.Write(Random(b_desc.GetElementSize()));
+        auto scale_dev = handle.Write(Random(b_desc.GetElementSize()));
+        auto shift_dev = handle.Write(Random(b_desc.GetElementSize()));
+        auto mean_dev  = handle.Write(Random(b_desc.GetElementSize()));
+        auto var_dev   = handle.Write(Random(b_desc.GetElementSize(), 0.5f, 1.5f));
+        auto out_dev   = handle.Write(std::vector<float>(p_desc.GetElementSize()));
+
+        const auto epsilon = 1e-5;
+
+        // The layers one by one.
+        std::vector<float> expected;
+        {
+            const float alpha = 1.0f;
+            const float beta  = 0.0f;
+            auto c_dev        = handle.Create<float>(c_desc.GetElementSize());
+            auto cb_dev       = handle.Create<float>(c_desc.GetElementSize());
+            auto p_dev        = handle.Create<float>(p_desc.GetElementSize());
+            auto bn_dev       = handle.Create<float>(p_desc.GetElementSize());
+
+            std::size_t count = 0;
+            miopenConvSolution_t solution;
+            EXPECT(miopenConvolutionForwardGetSolution(
+                       &handle, &w_desc, &x_desc, &conv_desc, &c_desc, 1, &count, &solution) ==
+                   miopenStatusSuccess);
+            auto ws_dev = handle.Create(std::max<std::size_t>(solution.workspace_size, 1));
+            EXPECT(miopenConvolutionForwardImmediate(&handle,
+                                                     &w_desc,
+                                                     w_dev.get(),
+                                                     &x_desc,
+                                                     x_dev.get(),
+                                                     &conv_desc,
+                                                     &c_desc,
+                                                     c_dev.get(),
+                                                     ws_dev.get(),
+                                                     solution.workspace_size,
+                                                     solution.solution_id) == miopenStatusSuccess);
+            miopen::OpTensor(handle,
+                             miopenTensorOpAdd,
+                             &alpha,
+                             c_desc,
+                             c_dev.get(),
+                             &alpha,
+                             b_desc,
+                             b_dev.get(),
+                             &beta,
+                             c_desc,
+                             cb_dev.get());
+            relu.Forward(handle, &alpha, c_desc, cb_dev.get(), &beta, c_desc, c_dev.get());
+            pooling.Forward(handle,
+                            &alpha,
+                            c_desc,
+                            c_dev.get(),
+                            &beta,
+                            p_desc,
+                            p_dev.get(),
+                            false,
+                            nullptr,
+                            0);
+            miopen::BatchNormForwardInference(handle,
+                                              miopenBNSpatial,
+                                              &alpha,
+                                              &beta,
+                                              p_desc,
+                                              p_dev.get(),
+                                              p_desc,
+                                              bn_dev.get(),
+                                              b_desc,
+                                              scale_dev.get(),
+                                              shift_dev.get(),
+                                              mean_dev.get(),
+                                              var_dev.get(),
+                                              epsilon);
+            relu.Forward(handle, &alpha, p_desc, bn_dev.get(), &beta, p_desc, p_dev.get());
+            expected = handle.Read<float>(p_dev, p_desc.GetElementSize());
+        }
+
+        miopenGraph_t graph = nullptr;
+        EXPECT(miopenCreateGraph(&graph) == miopenStatusSuccess);
+        const auto add = [&](miopen::TensorDescriptor& desc, bool external) {
+            int id = -1;
+            EXPECT(miopenGraphAddTensor(graph, &desc, external, &id) == miopenStatusSuccess);
+            return id;
+        };
+        const auto x     = add(x_desc, true);
+        const auto w     = add(w_desc, true);
+        const auto b     = add(b_desc, true);
+        const auto scale = add(b_desc, true);
+        const auto shift = add(b_desc, true);
+        const auto mean  = add(b_desc, true);
+        const auto var   = add(b_desc, true);
+        const auto out   = add(p_desc, true);
+        const auto c     = add(c_desc, false);
+        const auto cb    = add(c_desc, false);
+        const auto r     = add(c_desc, false);
+        const auto p     = add(p_desc, false);
+        const auto bn    = add(p_desc, false);
+
+        EXPECT(miopenGraphAddConvolutionForward(graph, &conv_desc, x, w, c) ==
+               miopenStatusSuccess);
+        EXPECT(miopenGraphAddOpTensor(graph, miopenTensorOpAdd, c, b, cb) == miopenStatusSuccess);
+        EXPECT(miopenGraphAddActivationForward(graph, &relu, cb, r) == miopenStatusSuccess);
+        EXPECT(miopenGraphAddPoolingForward(graph, &pooling, r, p) == miopenStatusSuccess);
+        EXPECT(miopenGraphAddBatchNormInference(
+                   graph, miopenBNSpatial, epsilon, p, scale, shift, mean, var, bn) ==
+               miopenStatusSuccess);
+        EXPECT(miopenGraphAddActivationForward(graph, &relu, bn, out) == miopenStatusSuccess);
+        EXPECT(miopenCompileGraph(&handle, graph) == miopenStatusSuccess);
+        EXPECT(miopen::deref(graph).GetStepCount() <= 6);
+
+        const int ids[]       = {x, w, b, scale, shift, mean, var, out};
+        void* const buffers[] = {x_dev.get(),
+                                 w_dev.get(),
+                                 b_dev.get(),
+                                 scale_dev.get(),
+                                 shift_dev.get(),
+                                 mean_dev.get(),
+                                 var_dev.get(),
+                                 out_dev.get()};
+        // Run a few times, the bindings are not kept from one run to the next.
+        for(int i = 0; i < 3; i++)
+        {
+            EXPECT(miopenRunGraph(&handle, graph, 8, ids, buffers) == miopenStatusSuccess);
+            const auto actual = handle.Read<float>(out_dev, p_desc.GetElementSize());
+            EXPECT(miopen::range_distance(expected) == miopen::range_distance(actual));
+            EXPECT(miopen::rms_range(expected, actual) < 1e-5);
+        }
+        // The output is not bound.
+        EXPECT(miopenRunGraph(&handle, graph, 7, ids, buffers) != miopenStatusSuccess);
+        EXPECT(miopenDestroyGraph(graph) == miopenStatusSuccess);
+    }
+
+    // Internal tensors which are never alive at the same time share memory.
+    void MemoryReuse()
+    {
+        auto&& handle    = get_handle();
+        auto desc        = miopen::TensorDescriptor{miopenFloat, {2, 16, 14, 14}};
+        auto activ       = miopen::ActivationDescriptor{miopenActivationTANH, 1., 1., 0.};
+        const auto input = Random(desc.GetElementSize());
+        auto x_dev       = handle.Write(input);
+        auto y_dev       = handle.Write(std::vector<float>(desc.GetElementSize()));
+
+        miopen::Graph graph;
+        const auto x  = graph.AddTensor(desc, true);
+        const auto y  = graph.AddTensor(desc, true);
+        auto previous = x;
+        for(auto i = 0; i < 4; ++i)
+        {
+            const auto next = graph.AddTensor(desc, false);
+            graph.AddActivationForward(activ, previous, next);
+            previous = next;
+        }
+        graph.AddActivationForward(activ, previous, y);
+        graph.Compile(handle);
+        EXPECT(graph.GetStepCount() == 5);
+
+        const auto bytes = desc.GetElementSpace() * sizeof(float);
+        EXPECT(graph.GetDeviceMemorySize() < 3 * bytes);
+
+        graph.Run(handle, {{x, x_dev.get()}, {y, y_dev.get()}});
+        auto expected = input;
+        for(auto i = 0; i < 5; ++i)
+            for(auto& e : expected)
+                e = std::tanh(e);
+        const auto actual = handle.Read<float>(y_dev, desc.GetElementSize());
+        EXPECT(miopen::rms_range(expected, actual) < 1e-5);
+    }
+
+    void InvalidGraphs()
+    {
+        auto desc = miopen::TensorDescriptor{miopenFloat, {1, 4, 8, 8}};
+        auto activ = miopen::ActivationDescriptor{miopenActivationTANH, 1., 1., 0.};
+
+        miopen::Graph graph;
+        const auto x = graph.AddTensor(desc, true);
+        const auto a = graph.AddTensor(desc, false);
+        const auto b = graph.AddTensor(desc, false);
+        // Read before it is written.
+        EXPECT(throws([&] { graph.AddActivationForward(activ, a, b); }));
+        EXPECT(throws([&] { graph.AddActivationForward(activ, x, x); }));
+        EXPECT(throws([&] { graph.AddActivationForward(activ, x, 42); }));
+        graph.AddActivationForward(activ, x, a);
+        // Written twice.
+        EXPECT(throws([&] { graph.AddActivationForward(activ, x, a); }));
+        EXPECT(throws([&] { graph.Run(get_handle(), {}); }));
+    }
+};
+
+int main() { graph_test{}.run(); }
@@ -27,6 +27,7 @@
 #include <miopen/config.h>
 #include <miopen/handle.hpp>
 #include "get_handle.hpp"
+#include <limits>
 #include <vector>
 #include <thread>
 #include "test.hpp"
@@ -189,6 +190,207 @@ void test_warnings(kernel_type_t kern_type)
 #endif
 }
 
+void test_program_cache_limits()
+{
+    miopen::Handle h{};
+    const auto src   = Write2s(miopenOpenCLKernelType);
+    const auto build = [&](int i) {
+        const auto config = std::to_string(i);
+        h.AddKernel("GEMM", config, src, "write", {1, 1, 1}, {1, 1, 1}, "-DVARIANT=" + config);
+    };
+
+    build(0);
+    build(1);
+    build(2);
+    auto footprint = h.GetCacheFootprint();
+    EXPECT(footprint.programCount == 3);
+    EXPECT(footprint.kernelCount == 3);
+
+    // Refresh the oldest one, the next eviction shall take the second.
+    EXPECT(!h.GetKernels("GEMM", "0").empty());
+    h.SetProgramCacheLimits(2, 0);
+    footprint = h.GetCacheFootprint();
+    EXPECT(footprint.programCount == 2);
+    EXPECT(footprint.kernelCount == 2);
+    EXPECT(h.HasKernel("GEMM", "0"));
+    EXPECT(!h.HasKernel("GEMM", "1"));
+    EXPECT(h.HasKernel("GEMM", "2"));
+
+    build(3);
+    EXPECT(h.GetCacheFootprint().programCount == 2);
+    EXPECT(!h.HasKernel("GEMM", "0"));
+    EXPECT(h.HasKernel("GEMM", "3"));
+}
+
+void test_workspace_arena()
+{
+    miopen::Handle h{};
+    const auto slot = miopen::WorkspaceArena::Slot::Workspace;
+    h.EnableWorkspaceArena();
+    EXPECT(h.IsWorkspaceArenaEnabled());
+
+    const auto first = h.GetArenaBuffer(slot, 1024).get();
+    EXPECT(first != nullptr);
+    // Smaller requests are served from the same buffer.
+    EXPECT(h.GetArenaBuffer(slot, 16).get() == first);
+    EXPECT(h.GetCacheFootprint().arenaBytes == 1024);
+
+    std::vector<int> data(4096, 1);
+    auto& grown = h.GetArenaBuffer(slot, data.size() * sizeof(int));
+    EXPECT(h.GetCacheFootprint().arenaBytes == data.size() * sizeof(int));
+    h.WriteTo(data.data(), grown, data.size() * sizeof(int));
+    EXPECT(h.Read<int>(grown, data.size()) == data);
+
+    h.EnableWorkspaceArena(false);
+    EXPECT(h.GetCacheFootprint().arenaBytes == 0);
+}
+
+void test_device_memory_limit()
+{
+    miopen::Handle h{};
+    const auto src   = Write2s(miopenOpenCLKernelType);
+    const auto build = [&](int i) {
+        const auto config = std::to_string(i);
+        h.AddKernel("GEMM", config, src, "write", {1, 1, 1}, {1, 1, 1}, "-DVARIANT=" + config);
+    };
+    build(0);
+    build(1);
+    h.EnableWorkspaceArena();
+    h.GetArenaBuffer(miopen::WorkspaceArena::Slot::Workspace, 1024);
+    h.GetArenaBuffer(miopen::WorkspaceArena::Slot::CheckNumerics, 256);
+
+    auto usage = h.GetDeviceMemoryUsage();
+    EXPECT(usage.workspaceBytes == 1024);
+    EXPECT(usage.scratchBytes == 256);
+    EXPECT(usage.rocblasBytes == 0);
+    EXPECT(usage.codeObjectBytes == h.GetCacheFootprint().codeObjectBytes);
+    EXPECT(usage.totalBytes == usage.codeObjectBytes + 1024 + 256);
+    EXPECT(h.GetWorkspaceBudget() == std::numeric_limits<std::size_t>::max());
+
+    // Below what the arena holds: only the most recent program is kept, the arena is untouched.
+    const auto had_code_objects = usage.codeObjectBytes != 0;
+    h.SetDeviceMemoryLimit(1024);
+    usage = h.GetDeviceMemoryUsage();
+    EXPECT(!had_code_objects || h.GetCacheFootprint().programCount == 1);
+    EXPECT(h.HasKernel("GEMM", "1"));
+    EXPECT(usage.workspaceBytes == 1024);
+    EXPECT(h.GetWorkspaceBudget() == 1024 - 256);
+
+    h.SetDeviceMemoryLimit(0);
+    build(0);
+    EXPECT(h.GetCacheFootprint().programCount == 2);
+    h.EnableWorkspaceArena(false);
+}
+
+void test_find_db_validation_flags()
+{
+    miopen::Handle h{};
+    const auto src = Write2s(miopenOpenCLKernelType);
+    h.AddKernel("GEMM", "0", src, "write", {1, 1, 1}, {1, 1, 1}, "");
+
+    EXPECT(!h.IsFindDbRecordValidated("0"));
+    h.SetFindDbRecordValidated("0", h.GetKernelCacheGeneration());
+    EXPECT(h.IsFindDbRecordValidated("0"));
+    EXPECT(!h.IsFindDbRecordValidated("1"));
+
+    // Dropping kernels invalidates the flags of all the configs.
+    h.ClearKernels("GEMM", "0");
+    EXPECT(!h.IsFindDbRecordValidated("0"));
+}
+
+#if MIOPEN_BACKEND_HIP
+void test_thread_streams()
+{
+    auto&& h                 = get_handle();
+    const auto handle_stream = h.GetStream();
+    std::vector<hipStream_t> streams(4);
+    for(auto& stream : streams)
+        EXPECT(hipStreamCreate(&stream) == hipSuccess);
+
+    // The threads share the handle and its caches, each on a stream of its own.
+    std::vector<std::thread> threads;
+    for(const auto stream : streams)
+    {
+        threads.emplace_back([&h, handle_stream, stream] {
+            h.SetThreadStream(stream);
+            EXPECT(h.GetStream() == stream);
+            EXPECT(!h.IsWorkspaceArenaEnabled());
+            run2s(h, 64, miopenHIPKernelType);
+            h.ResetThreadStream();
+            EXPECT(h.GetStream() == handle_stream);
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+
+    EXPECT(!h.HasThreadStream());
+    EXPECT(h.GetStream() == handle_stream);
+    for(const auto stream : streams)
+        hipStreamDestroy(stream);
+}
+
+void test_profile_batch()
+{
+    miopen::Handle h{};
+    const std::size_t n = 64;
+    std::vector<int> data_in(n, 1);
+    auto data_dev = h.Write(data_in);
+    const auto write2s = h.AddKernel("NoAlgo",
+                                     "",
+                                     "test_hip.cpp",
+                                     "write",
+                                     {n, 1, 1},
+                                     {n, 1, 1},
+                                     "",
+                                     0,
+                                     false,
+                                     Write2s(miopenHIPKernelType));
+
+    h.EnableProfiling(true);
+    h.ProfileBatch([&]() {
+        // Launches in a batch are not profiled one by one.
+        CHECK(!h.IsProfilingEnabled());
+        for(auto i = 0; i < 3; i++)
+            write2s(data_dev.get());
+    });
+    CHECK(h.IsProfilingEnabled());
+    CHECK(h.GetKernelTime() > 0.0f);
+    h.EnableProfiling(false);
+
+    std::fill(data_in.begin(), data_in.end(), 8);
+    CHECK(h.Read<int>(data_dev, n) == data_in);
+}
+
+void test_concurrent_streams_priority()
+{
+    miopen::Handle h{};
+    auto least    = 0;
+    auto greatest = 0;
+    EXPECT(hipDeviceGetStreamPriorityRange(&least, &greatest) == hipSuccess);
+    hipStream_t high = nullptr;
+    EXPECT(hipStreamCreateWithPriority(&high, hipStreamDefault, greatest) == hipSuccess);
+    h.SetStream(high);
+
+    const auto check = [&](int expected) {
+        h.RunConcurrently(2, [&](std::size_t) {
+            // The tasks run on the handle stream if the concurrency is disabled.
+            if(h.GetStream() == high)
+                return;
+            auto priority = 0;
+            EXPECT(hipStreamGetPriority(h.GetStream(), &priority) == hipSuccess);
+            EXPECT(priority == expected);
+        });
+    };
+    // Inherited from the handle stream by default.
+    check(greatest);
+    h.SetConcurrentStreamsPriority(least);
+    check(least);
+
+    h.SetStream(nullptr);
+    hipStreamDestroy(high);
+}
+#endif
+
 void test_arch_name()
 {
     auto&& h        = get_handle();
@@ -205,6 +407,11 @@ int main()
     {
         test_multithreads(miopenHIPKernelType);
         test_errors(miopenHIPKernelType);
+#if MIOPEN_BACKEND_HIP
+        test_thread_streams();
+        test_concurrent_streams_priority();
+        test_profile_batch();
+#endif
 // Warnings currently dont work in opencl
 #if !MIOPEN_BACKEND_OPENCL
         test_warnings(miopenHIPKernelType);
@@ -213,6 +420,10 @@ int main()
     test_multithreads(miopenOpenCLKernelType);
     test_errors(miopenOpenCLKernelType);
     test_arch_name();
+    test_program_cache_limits();
+    test_workspace_arena();
+    test_device_memory_limit();
+    test_find_db_validation_flags();
 // Warnings currently dont work in opencl
 #if !MIOPEN_BACKEND_OPENCL
     test_warnings(miopenOpenCLKernelType);
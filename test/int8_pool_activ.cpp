@@ -0,0 +1,222 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "get_handle.hpp"
+#include "test.hpp"
+
+#include <miopen/activ.hpp>
+#include <miopen/pooling.hpp>
+#include <miopen/tensor.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+static std::vector<int8_t> generate(std::size_t n)
+{
+    std::vector<int8_t> v(n);
+    for(std::size_t i = 0; i < n; ++i)
+        v[i] = static_cast<int8_t>(static_cast<int>((i * 37 + 11) % 256) - 128);
+    return v;
+}
+
+static int8_t saturate(float v)
+{
+    return static_cast<int8_t>(std::min(std::max(std::nearbyint(v), -128.0f), 127.0f));
+}
+
+// Position of element (n, c, d, h, w) of an NC[D]HW tensor, int8x4 keeps four channels together.
+static std::size_t offset(miopenDataType_t type,
+                          const std::vector<std::size_t>& lens,
+                          std::size_t n,
+                          std::size_t c,
+                          std::size_t d,
+                          std::size_t h,
+                          std::size_t w)
+{
+    const auto depth = lens.size() == 5 ? lens[2] : 1;
+    const auto pixel = (d * lens[lens.size() - 2] + h) * lens.back() + w;
+    const auto plane = depth * lens[lens.size() - 2] * lens.back();
+    if(type == miopenInt8x4)
+        return ((n * (lens[1] / 4) + c / 4) * plane + pixel) * 4 + c % 4;
+    return (n * lens[1] + c) * plane + pixel;
+}
+
+static void chk_pool(miopenDataType_t type,
+                     miopenPoolingMode_t mode,
+                     const std::vector<std::size_t>& x_lens,
+                     const std::vector<int>& kernel,
+                     const std::vector<int>& pads,
+                     const std::vector<int>& strides)
+{
+    auto&& handle = get_handle();
+
+    const auto pool = miopen::PoolingDescriptor{mode, miopenPaddingDefault, kernel, strides, pads};
+    const auto x_desc = miopen::TensorDescriptor{type, x_lens};
+    const auto y_desc = pool.GetForwardOutputTensor(x_desc);
+    auto y_lens       = y_desc.GetLengths();
+
+    // the spatial sizes as D x H x W, with D = 1 in 2D
+    const auto sp = [](const std::vector<std::size_t>& lens, int i) {
+        return lens.size() == 5 ? lens[2 + i] : i == 0 ? 1 : lens[1 + i];
+    };
+    // the window as D x H x W, a 2D window is one deep
+    auto k3 = kernel;
+    auto p3 = pads;
+    auto s3 = strides;
+    if(kernel.size() == 2)
+    {
+        k3.insert(k3.begin(), 1);
+        p3.insert(p3.begin(), 0);
+        s3.insert(s3.begin(), 1);
+    }
+
+    const auto x = generate(x_desc.GetElementSize());
+    std::vector<int8_t> y(y_desc.GetElementSize());
+    std::vector<int8_t> y_ref(y.size());
+
+    for(std::size_t n = 0; n < x_lens[0]; ++n)
+        for(std::size_t c = 0; c < x_lens[1]; ++c)
+            for(std::size_t od = 0; od < sp(y_lens, 0); ++od)
+                for(std::size_t oh = 0; oh < sp(y_lens, 1); ++oh)
+                    for(std::size_t ow = 0; ow < sp(y_lens, 2); ++ow)
+                    {
+                        float acc   = mode == miopenPoolingMax ? -128.0f : 0.0f;
+                        int inbound = 0;
+                        const int o[3] = {int(od), int(oh), int(ow)};
+                        int start[3];
+                        for(int i = 0; i < 3; ++i)
+                            start[i] = o[i] * s3[i] - p3[i];
+                        for(int kd = 0; kd < k3[0]; ++kd)
+                            for(int kh = 0; kh < k3[1]; ++kh)
+                                for(int kw = 0; kw < k3[2]; ++kw)
+                                {
+                                    const int p[3] = {start[0] + kd, start[1] + kh, start[2] + kw};
+                                    bool in = true;
+                                    for(int i = 0; i < 3; ++i)
+                                        in = in && p[i] >= 0 && p[i] < int(sp(x_lens, i));
+                                    if(!in)
+                                        continue;
+                                    ++inbound;
+                                    const float v = x[offset(type, x_lens, n, c, p[0], p[1], p[2])];
+                                    acc = mode == miopenPoolingMax ? std::max(acc, v) : acc + v;
+                                }
+                        if(mode == miopenPoolingAverage)
+                            acc *= 1.0f / std::max(inbound, 1);
+                        else if(mode == miopenPoolingAverageInclusive)
+                            acc *= 1.0f / (k3[0] * k3[1] * k3[2]);
+                        y_ref[offset(type, y_lens, n, c, od, oh, ow)] = saturate(acc);
+                    }
+
+    auto x_dev = handle.Write(x);
+    auto y_dev = handle.Write(y);
+    const float alpha = 1, beta = 0;
+    pool.Forward(
+        handle, &alpha, x_desc, x_dev.get(), &beta, y_desc, y_dev.get(), false, nullptr, 0);
+    y = handle.Read<int8_t>(y_dev, y.size());
+
+    // averages may round either way when the device scales by an inexact reciprocal
+    const int tolerance = mode == miopenPoolingMax ? 0 : 1;
+    std::size_t errors  = 0;
+    for(std::size_t i = 0; i < y.size(); ++i)
+        if(std::abs(int(y[i]) - int(y_ref[i])) > tolerance)
+            ++errors;
+    if(errors != 0)
+        std::cout << "Pooling " << x_desc.ToString() << " mode " << mode << " errors: " << errors
+                  << std::endl;
+    EXPECT(errors == 0);
+}
+
+static void chk_activ(miopenDataType_t type,
+                      miopenActivationMode_t mode,
+                      double activ_alpha,
+                      float scale,
+                      std::size_t len,
+                      std::size_t x_offset)
+{
+    auto&& handle = get_handle();
+
+    auto activ        = miopen::ActivationDescriptor{mode, activ_alpha, 1.0, 1.0};
+    const auto x_desc = miopen::TensorDescriptor{type, {len}};
+
+    const auto x = generate(len + x_offset);
+    std::vector<int8_t> y(len);
+    std::vector<int8_t> y_ref(len);
+    for(std::size_t i = 0; i < len; ++i)
+    {
+        const float v = x[x_offset + i];
+        float f       = v;
+        switch(mode)
+        {
+        case miopenActivationRELU: f = v > 0 ? v : 0; break;
+        case miopenActivationCLIPPEDRELU:
+            f = std::min(float(activ_alpha), std::max(v, 0.0f));
+            break;
+        case miopenActivationLEAKYRELU: f = v > 0 ? v : float(activ_alpha) * v; break;
+        case miopenActivationTANH: f = std::tanh(float(activ_alpha) * v); break;
+        default: break;
+        }
+        y_ref[i] = saturate(scale * f);
+    }
+
+    auto x_dev       = handle.Write(x);
+    auto y_dev       = handle.Write(y);
+    const float beta = 0;
+    activ.Forward(handle, &scale, x_desc, x_dev.get(), &beta, x_desc, y_dev.get(), x_offset, 0);
+    y = handle.Read<int8_t>(y_dev, y.size());
+
+    std::size_t errors = 0;
+    for(std::size_t i = 0; i < len; ++i)
+        if(std::abs(int(y[i]) - int(y_ref[i])) > 1)
+            ++errors;
+    if(errors != 0)
+        std::cout << "Activation mode " << mode << " len " << len << " offset " << x_offset
+                  << " errors: " << errors << std::endl;
+    EXPECT(errors == 0);
+}
+
+int main()
+{
+    /*
+     * Quantized pooling and activation must match an fp32 computation rounded back to int8 with
+     * saturation, for int8 and int8x4, 2D and 3D pooling with padding, and activations over
+     * lengths and offsets the vector loads do not divide.
+     */
+    for(auto mode : {miopenPoolingMax, miopenPoolingAverage, miopenPoolingAverageInclusive})
+    {
+        chk_pool(miopenInt8, mode, {2, 3, 17, 19}, {3, 3}, {1, 1}, {2, 2});
+        chk_pool(miopenInt8x4, mode, {2, 8, 14, 15}, {2, 3}, {0, 1}, {2, 1});
+        chk_pool(miopenInt8, mode, {1, 2, 6, 9, 10}, {2, 3, 3}, {1, 1, 0}, {2, 2, 2});
+    }
+
+    chk_activ(miopenInt8, miopenActivationRELU, 0.0, 0.5f, 1000, 0);
+    chk_activ(miopenInt8, miopenActivationCLIPPEDRELU, 50.0, 3.0f, 1001, 3);
+    chk_activ(miopenInt8, miopenActivationLEAKYRELU, 0.25, 1.0f, 257, 1);
+    chk_activ(miopenInt8x4, miopenActivationTANH, 0.05, 100.0f, 1024, 0);
+}
@@ -0,0 +1,174 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "driver.hpp"
+#include "get_handle.hpp"
+#include "rms_check.hpp"
+#include "tensor_holder.hpp"
+#include "test.hpp"
+#include "verify.hpp"
+
+#include <miopen/layernorm.hpp>
+#include <miopen/miopen.h>
+
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+/// T is the data type, P the type of weight, bias, mean and rstd.
+template <class T, class P>
+void chk_layernorm(const std::vector<std::size_t>& lengths, int normalized_dim, bool affine)
+{
+    auto&& handle = get_handle();
+
+    const auto split = lengths.begin() + normalized_dim;
+    const auto outer =
+        std::accumulate(lengths.begin(), split, std::size_t{1}, std::multiplies<std::size_t>{});
+    const auto inner =
+        std::accumulate(split, lengths.end(), std::size_t{1}, std::multiplies<std::size_t>{});
+    const float epsilon      = 1e-5f;
+    const auto layernorm_gen = tensor_elem_gen_centered{17, 8.0, 4.0};
+
+    auto x      = tensor<T>{lengths}.generate(layernorm_gen);
+    auto dy     = tensor<T>{lengths}.generate(tensor_elem_gen_integer{5});
+    auto weight = tensor<P>{inner}.generate(layernorm_gen);
+    auto bias   = tensor<P>{inner}.generate(tensor_elem_gen_integer{3});
+    auto y      = tensor<T>{lengths};
+    auto dx     = tensor<T>{lengths};
+    auto mean   = tensor<P>{outer};
+    auto rstd   = tensor<P>{outer};
+    auto dw     = tensor<P>{inner};
+    auto db     = tensor<P>{inner};
+
+    auto ref_y  = std::vector<double>(outer * inner);
+    auto ref_dx = std::vector<double>(outer * inner);
+    auto ref_dw = std::vector<double>(inner, 0.);
+    auto ref_db = std::vector<double>(inner, 0.);
+    for(std::size_t r = 0; r < outer; ++r)
+    {
+        double sum = 0., sum_sq = 0.;
+        for(std::size_t i = 0; i < inner; ++i)
+        {
+            const double v = x[r * inner + i];
+            sum += v;
+            sum_sq += v * v;
+        }
+        const double m = sum / inner;
+        const double s = 1. / std::sqrt(sum_sq / inner - m * m + epsilon);
+
+        double mean_g = 0., mean_g_xhat = 0.;
+        for(std::size_t i = 0; i < inner; ++i)
+        {
+            const auto k      = r * inner + i;
+            const double xhat = (x[k] - m) * s;
+            const double g    = affine ? double(dy[k]) * weight[i] : double(dy[k]);
+            ref_y[k]          = affine ? xhat * weight[i] + bias[i] : xhat;
+            mean_g += g / inner;
+            mean_g_xhat += g * xhat / inner;
+            ref_dw[i] += double(dy[k]) * xhat;
+            ref_db[i] += dy[k];
+        }
+        for(std::size_t i = 0; i < inner; ++i)
+        {
+            const auto k      = r * inner + i;
+            const double xhat = (x[k] - m) * s;
+            const double g    = affine ? double(dy[k]) * weight[i] : double(dy[k]);
+            ref_dx[k]         = s * (g - mean_g - xhat * mean_g_xhat);
+        }
+    }
+
+    auto x_dev    = handle.Write(x.data);
+    auto dy_dev   = handle.Write(dy.data);
+    auto w_dev    = handle.Write(weight.data);
+    auto b_dev    = handle.Write(bias.data);
+    auto y_dev    = handle.Write(y.data);
+    auto dx_dev   = handle.Write(dx.data);
+    auto mean_dev = handle.Write(mean.data);
+    auto rstd_dev = handle.Write(rstd.data);
+    auto dw_dev   = handle.Write(dw.data);
+    auto db_dev   = handle.Write(db.data);
+
+    miopen::LayerNormForward(handle,
+                             x.desc,
+                             x_dev.get(),
+                             affine ? &weight.desc : nullptr,
+                             affine ? w_dev.get() : nullptr,
+                             affine ? b_dev.get() : nullptr,
+                             epsilon,
+                             normalized_dim,
+                             y.desc,
+                             y_dev.get(),
+                             &mean.desc,
+                             mean_dev.get(),
+                             rstd_dev.get());
+    miopen::LayerNormBackward(handle,
+                              x.desc,
+                              x_dev.get(),
+                              dy.desc,
+                              dy_dev.get(),
+                              affine ? &weight.desc : nullptr,
+                              affine ? w_dev.get() : nullptr,
+                              mean.desc,
+                              mean_dev.get(),
+                              rstd_dev.get(),
+                              normalized_dim,
+                              dx.desc,
+                              dx_dev.get(),
+                              affine ? dw_dev.get() : nullptr,
+                              affine ? db_dev.get() : nullptr);
+    y.data  = handle.Read<T>(y_dev, y.data.size());
+    dx.data = handle.Read<T>(dx_dev, dx.data.size());
+    dw.data = handle.Read<P>(dw_dev, dw.data.size());
+    db.data = handle.Read<P>(db_dev, db.data.size());
+
+    const double tolerance = sizeof(T) == 2 ? 4e-3 : 1e-5;
+    const auto problem     = " outer " + std::to_string(outer) + " inner " +
+                         std::to_string(inner) + " affine " + std::to_string(affine);
+    expect_rms("LayerNorm y" + problem, ref_y, y.data, tolerance);
+    expect_rms("LayerNorm dx" + problem, ref_dx, dx.data, tolerance);
+    if(affine)
+    {
+        expect_rms("LayerNorm dweight" + problem, ref_dw, dw.data, tolerance);
+        expect_rms("LayerNorm dbias" + problem, ref_db, db.data, tolerance);
+    }
+}
+
+int main()
+{
+    /*
+     * Forward and backward must match the host reference for rows shorter than a work-group,
+     * longer than one and not a multiple of its size, and with more columns than one work-group
+     * of the weight gradient kernel.
+     */
+    chk_layernorm<float, float>({4, 3, 10}, 2, true);
+    chk_layernorm<float, float>({8, 1000}, 1, true);
+    chk_layernorm<float, float>({2, 3, 7, 9}, 2, false);
+    chk_layernorm<float, float>({300, 130}, 1, true);
+    // fp16 data is accumulated in fp32, with fp16 or fp32 parameters
+    chk_layernorm<half_float::half, half_float::half>({16, 768}, 1, true);
+    chk_layernorm<half_float::half, float>({16, 768}, 1, true);
+}
@@ -0,0 +1,99 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "fusionHost.hpp"
+#include "rms_check.hpp"
+
+#include <miopen/config.h>
+#include <miopen/linear.hpp>
+#include <miopen/miopen.h>
+
+void chk_linear(std::size_t m,
+                std::size_t n,
+                std::size_t k,
+                bool use_bias,
+                miopenActivationMode_t mode,
+                double alpha)
+{
+    auto&& handle = get_handle();
+
+    const auto linear_gen = tensor_elem_gen_centered{7, 3.0, 4.0};
+
+    auto x = tensor<float>{std::vector<std::size_t>{m, k}}.generate(linear_gen);
+    auto w = tensor<float>{std::vector<std::size_t>{n, k}}.generate(linear_gen);
+    auto b = tensor<float>{n}.generate(linear_gen);
+    auto y = tensor<float>{std::vector<std::size_t>{m, n}};
+
+    auto ref = y;
+    for(std::size_t i = 0; i < m; ++i)
+    {
+        for(std::size_t j = 0; j < n; ++j)
+        {
+            double acc = use_bias ? b[j] : 0.;
+            for(std::size_t l = 0; l < k; ++l)
+                acc += double(x(i, l)) * w(j, l);
+            ref(i, j) = acc;
+        }
+    }
+    auto tmp = ref;
+    activationHostInfer(mode, 0., 0., alpha, tmp.data, ref.data);
+
+    const miopen::ActivationDescriptor activ{mode, alpha, 0., 0.};
+    auto x_dev = handle.Write(x.data);
+    auto w_dev = handle.Write(w.data);
+    auto b_dev = handle.Write(b.data);
+    auto y_dev = handle.Write(y.data);
+    miopen::LinearForward(handle,
+                          x.desc,
+                          x_dev.get(),
+                          w.desc,
+                          w_dev.get(),
+                          use_bias ? &b.desc : nullptr,
+                          use_bias ? b_dev.get() : nullptr,
+                          &activ,
+                          y.desc,
+                          y_dev.get());
+    y.data = handle.Read<float>(y_dev, y.data.size());
+
+    expect_rms("Linear " + std::to_string(m) + "x" + std::to_string(n) + "x" + std::to_string(k) +
+                   " bias " + std::to_string(use_bias) + " activation " + std::to_string(mode),
+               ref.data,
+               y.data);
+}
+
+int main()
+{
+#if MIOPEN_USE_GEMM
+    /*
+     * The fused bias and activation pass after the GEMM of the linear layer must match the
+     * host reference, with and without each of the ops.
+     */
+    chk_linear(64, 96, 40, true, miopenActivationRELU, 0.);
+    chk_linear(7, 33, 129, true, miopenActivationLEAKYRELU, 0.1);
+    chk_linear(7, 33, 129, false, miopenActivationLEAKYRELU, 0.1);
+    chk_linear(16, 8, 5, true, miopenActivationPASTHRU, 0.);
+#endif
+}
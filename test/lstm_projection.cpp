@@ -0,0 +1,545 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/miopen.h>
+#include <miopen/handle.hpp>
+#include <miopen/rnn.hpp>
+#include <miopen/tensor.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "get_handle.hpp"
+#include "test.hpp"
+#include "verify.hpp"
+
+// Training of an LSTM with a projected hidden state (LSTMP) against a host implementation that
+// reads the parameters at the offsets the RNN descriptor reports.
+struct lstm_projection_test
+{
+    miopenRNNDirectionMode_t dir;
+    miopenRNNBiasMode_t bias;
+    int layers;
+    bool use_hx;
+
+    lstm_projection_test(miopenRNNDirectionMode_t d, miopenRNNBiasMode_t b, int l, bool h)
+        : dir(d), bias(b), layers(l), use_hx(h)
+    {
+    }
+
+    static constexpr int in_h = 5;
+    static constexpr int hy_h = 8;
+    static constexpr int pr_h = 3;
+    const std::vector<int> in_n = {4, 4, 2, 1};
+
+    int bi      = 0;
+    int seq_len = 0;
+    int batch_n = 0;
+    std::vector<int> base;
+
+    std::vector<float> x, hx, cx, w, dy, dhy, dcy;
+
+    // Offsets of the parameters of every layer and direction.
+    std::vector<std::array<std::size_t, 4>> wx_off, wh_off, bx_off, bh_off;
+    std::vector<std::size_t> wp_off;
+
+    struct step
+    {
+        std::vector<double> in, r_prev, c_prev, i, f, o, g, c, tc, m;
+        bool recurrent = false;
+        bool has_prev  = false;
+    };
+
+    // Steps of every layer, direction and row.
+    std::vector<std::vector<step>> steps;
+
+    struct results
+    {
+        std::vector<float> y, hy, cy, dx, dhx, dcx, dw;
+    };
+
+    static double sigmoid(double v) { return 1 / (1 + std::exp(-v)); }
+
+    int InputLen(int li) const { return li == 0 ? in_h : bi * pr_h; }
+
+    step& Step(int li, int ri, int t, int b) { return steps[li * bi + ri][base[t] + b]; }
+
+    results RunHost()
+    {
+        results res;
+        res.hy.assign(layers * bi * in_n[0] * pr_h, 0);
+        res.cy.assign(layers * bi * in_n[0] * hy_h, 0);
+        res.dhx.assign(res.hy.size(), 0);
+        res.dcx.assign(res.cy.size(), 0);
+        res.dw.assign(w.size(), 0);
+        steps.assign(layers * bi, std::vector<step>(batch_n));
+
+        const auto wx = [&](int lay, int g, int j, int k, int klen) {
+            return w[wx_off[lay][g] + j * klen + k];
+        };
+        const auto wh = [&](int lay, int g, int j, int q) {
+            return w[wh_off[lay][g] + j * pr_h + q];
+        };
+        const auto wp = [&](int lay, int q, int j) { return w[wp_off[lay] + q * hy_h + j]; };
+
+        std::vector<std::vector<double>> outs(layers);
+        for(int li = 0; li < layers; li++)
+        {
+            const int klen = InputLen(li);
+            outs[li].assign(batch_n * bi * pr_h, 0);
+            for(int ri = 0; ri < bi; ri++)
+            {
+                const int lay = li * bi + ri;
+                std::vector<std::vector<double>> r(in_n[0], std::vector<double>(pr_h, 0));
+                std::vector<std::vector<double>> c(in_n[0], std::vector<double>(hy_h, 0));
+                std::vector<bool> started(in_n[0], false);
+                for(int ti = 0; ti < seq_len; ti++)
+                {
+                    const int t = ri == 0 ? ti : seq_len - 1 - ti;
+                    for(int b = 0; b < in_n[t]; b++)
+                    {
+                        auto& s    = Step(li, ri, t, b);
+                        s.has_prev = started[b];
+                        s.recurrent = s.has_prev || use_hx;
+                        s.in.resize(klen);
+                        for(int k = 0; k < klen; k++)
+                            s.in[k] = li == 0 ? x[(base[t] + b) * in_h + k]
+                                              : outs[li - 1][(base[t] + b) * klen + k];
+                        s.r_prev = r[b];
+                        s.c_prev = c[b];
+                        if(!s.has_prev && use_hx)
+                        {
+                            for(int q = 0; q < pr_h; q++)
+                                s.r_prev[q] = hx[(lay * in_n[0] + b) * pr_h + q];
+                            for(int j = 0; j < hy_h; j++)
+                                s.c_prev[j] = cx[(lay * in_n[0] + b) * hy_h + j];
+                        }
+
+                        std::vector<std::vector<double>> a(4, std::vector<double>(hy_h, 0));
+                        for(int g = 0; g < 4; g++)
+                        {
+                            for(int j = 0; j < hy_h; j++)
+                            {
+                                double v = 0;
+                                for(int k = 0; k < klen; k++)
+                                    v += wx(lay, g, j, k, klen) * s.in[k];
+                                if(bias == miopenRNNwithBias)
+                                    v += w[bx_off[lay][g] + j];
+                                if(s.recurrent)
+                                {
+                                    for(int q = 0; q < pr_h; q++)
+                                        v += wh(lay, g, j, q) * s.r_prev[q];
+                                    if(bias == miopenRNNwithBias)
+                                        v += w[bh_off[lay][g] + j];
+                                }
+                                a[g][j] = v;
+                            }
+                        }
+
+                        s.i.resize(hy_h);
+                        s.f.resize(hy_h);
+                        s.o.resize(hy_h);
+                        s.g.resize(hy_h);
+                        s.c.resize(hy_h);
+                        s.tc.resize(hy_h);
+                        s.m.resize(hy_h);
+                        for(int j = 0; j < hy_h; j++)
+                        {
+                            s.i[j]  = sigmoid(a[0][j]);
+                            s.f[j]  = sigmoid(a[1][j]);
+                            s.o[j]  = sigmoid(a[2][j]);
+                            s.g[j]  = std::tanh(a[3][j]);
+                            s.c[j]  = s.i[j] * s.g[j] + s.f[j] * s.c_prev[j];
+                            s.tc[j] = std::tanh(s.c[j]);
+                            s.m[j]  = s.o[j] * s.tc[j];
+                        }
+                        for(int q = 0; q < pr_h; q++)
+                        {
+                            double v = 0;
+                            for(int j = 0; j < hy_h; j++)
+                                v += wp(lay, q, j) * s.m[j];
+                            r[b][q] = v;
+                            outs[li][(base[t] + b) * bi * pr_h + ri * pr_h + q] = v;
+                        }
+                        c[b]       = s.c;
+                        started[b] = true;
+                    }
+                }
+                for(int b = 0; b < in_n[0]; b++)
+                {
+                    for(int q = 0; q < pr_h; q++)
+                        res.hy[(lay * in_n[0] + b) * pr_h + q] = r[b][q];
+                    for(int j = 0; j < hy_h; j++)
+                        res.cy[(lay * in_n[0] + b) * hy_h + j] = c[b][j];
+                }
+            }
+        }
+        res.y.assign(outs.back().begin(), outs.back().end());
+
+        std::vector<double> dout(dy.begin(), dy.end());
+        for(int li = layers - 1; li >= 0; li--)
+        {
+            const int klen = InputLen(li);
+            std::vector<double> din(batch_n * klen, 0);
+            for(int ri = 0; ri < bi; ri++)
+            {
+                const int lay = li * bi + ri;
+                std::vector<std::vector<double>> dr_carry(in_n[0]), dc_carry(in_n[0]);
+                for(int b = 0; b < in_n[0]; b++)
+                {
+                    dr_carry[b].assign(dhy.begin() + (lay * in_n[0] + b) * pr_h,
+                                       dhy.begin() + (lay * in_n[0] + b + 1) * pr_h);
+                    dc_carry[b].assign(dcy.begin() + (lay * in_n[0] + b) * hy_h,
+                                       dcy.begin() + (lay * in_n[0] + b + 1) * hy_h);
+                }
+                for(int ti = seq_len - 1; ti >= 0; ti--)
+                {
+                    const int t = ri == 0 ? ti : seq_len - 1 - ti;
+                    for(int b = 0; b < in_n[t]; b++)
+                    {
+                        const auto& s = Step(li, ri, t, b);
+                        std::vector<double> dr(pr_h), dm(hy_h, 0), dc(hy_h);
+                        for(int q = 0; q < pr_h; q++)
+                            dr[q] = dout[(base[t] + b) * bi * pr_h + ri * pr_h + q] +
+                                    dr_carry[b][q];
+                        for(int q = 0; q < pr_h; q++)
+                        {
+                            for(int j = 0; j < hy_h; j++)
+                            {
+                                dm[j] += wp(lay, q, j) * dr[q];
+                                res.dw[wp_off[lay] + q * hy_h + j] += dr[q] * s.m[j];
+                            }
+                        }
+
+                        std::vector<std::vector<double>> da(4, std::vector<double>(hy_h));
+                        for(int j = 0; j < hy_h; j++)
+                        {
+                            dc[j] = dc_carry[b][j] + dm[j] * s.o[j] * (1 - s.tc[j] * s.tc[j]);
+                            da[0][j] = dc[j] * s.g[j] * s.i[j] * (1 - s.i[j]);
+                            da[1][j] = dc[j] * s.c_prev[j] * s.f[j] * (1 - s.f[j]);
+                            da[2][j] = dm[j] * s.tc[j] * s.o[j] * (1 - s.o[j]);
+                            da[3][j] = dc[j] * s.i[j] * (1 - s.g[j] * s.g[j]);
+                        }
+
+                        std::vector<double> dr_prev(pr_h, 0);
+                        for(int g = 0; g < 4; g++)
+                        {
+                            for(int j = 0; j < hy_h; j++)
+                            {
+                                for(int k = 0; k < klen; k++)
+                                {
+                                    din[(base[t] + b) * klen + k] +=
+                                        wx(lay, g, j, k, klen) * da[g][j];
+                                    res.dw[wx_off[lay][g] + j * klen + k] += da[g][j] * s.in[k];
+                                }
+                                for(int q = 0; q < pr_h; q++)
+                                {
+                                    dr_prev[q] += wh(lay, g, j, q) * da[g][j];
+                                    if(s.recurrent)
+                                        res.dw[wh_off[lay][g] + j * pr_h + q] +=
+                                            da[g][j] * s.r_prev[q];
+                                }
+                                if(bias == miopenRNNwithBias)
+                                {
+                                    res.dw[bx_off[lay][g] + j] += da[g][j];
+                                    if(s.recurrent)
+                                        res.dw[bh_off[lay][g] + j] += da[g][j];
+                                }
+                            }
+                        }
+
+                        for(int j = 0; j < hy_h; j++)
+                            dc[j] *= s.f[j];
+                        if(s.has_prev)
+                        {
+                            dr_carry[b] = dr_prev;
+                            dc_carry[b] = dc;
+                        }
+                        else if(use_hx)
+                        {
+                            std::copy(dr_prev.begin(),
+                                      dr_prev.end(),
+                                      res.dhx.begin() + (lay * in_n[0] + b) * pr_h);
+                            std::copy(
+                                dc.begin(), dc.end(), res.dcx.begin() + (lay * in_n[0] + b) * hy_h);
+                        }
+                    }
+                }
+            }
+            dout = din;
+        }
+        res.dx.assign(dout.begin(), dout.end());
+        return res;
+    }
+
+    results RunDevice(miopen::RNNDescriptor& rnn_desc,
+                      const std::vector<miopenTensorDescriptor_t>& x_desc_ptrs,
+                      const std::vector<miopenTensorDescriptor_t>& y_desc_ptrs,
+                      miopen::TensorDescriptor& h_desc,
+                      miopen::TensorDescriptor& c_desc,
+                      miopen::TensorDescriptor& w_desc)
+    {
+        auto&& handle = get_handle();
+        results res;
+
+        std::size_t ws_size = 0;
+        std::size_t rs_size = 0;
+        miopenGetRNNWorkspaceSize(&handle, &rnn_desc, seq_len, x_desc_ptrs.data(), &ws_size);
+        miopenGetRNNTrainingReserveSize(
+            &handle, &rnn_desc, seq_len, x_desc_ptrs.data(), &rs_size);
+
+        auto x_dev   = handle.Write(x);
+        auto hx_dev  = handle.Write(hx);
+        auto cx_dev  = handle.Write(cx);
+        auto w_dev   = handle.Write(w);
+        auto dy_dev  = handle.Write(dy);
+        auto dhy_dev = handle.Write(dhy);
+        auto dcy_dev = handle.Write(dcy);
+        auto y_dev   = handle.Create(dy.size() * sizeof(float));
+        auto hy_dev  = handle.Create(hx.size() * sizeof(float));
+        auto cy_dev  = handle.Create(cx.size() * sizeof(float));
+        auto dx_dev  = handle.Create(x.size() * sizeof(float));
+        auto dhx_dev = handle.Create(hx.size() * sizeof(float));
+        auto dcx_dev = handle.Create(cx.size() * sizeof(float));
+        auto dw_dev  = handle.Create(w.size() * sizeof(float));
+        auto ws_dev  = handle.Create(ws_size);
+        auto rs_dev  = handle.Create(rs_size);
+
+        EXPECT(miopenRNNForwardTraining(&handle,
+                                        &rnn_desc,
+                                        seq_len,
+                                        x_desc_ptrs.data(),
+                                        x_dev.get(),
+                                        &h_desc,
+                                        use_hx ? hx_dev.get() : nullptr,
+                                        &c_desc,
+                                        use_hx ? cx_dev.get() : nullptr,
+                                        &w_desc,
+                                        w_dev.get(),
+                                        y_desc_ptrs.data(),
+                                        y_dev.get(),
+                                        &h_desc,
+                                        hy_dev.get(),
+                                        &c_desc,
+                                        cy_dev.get(),
+                                        ws_dev.get(),
+                                        ws_size,
+                                        rs_dev.get(),
+                                        rs_size) == miopenStatusSuccess);
+
+        EXPECT(miopenRNNBackwardData(&handle,
+                                     &rnn_desc,
+                                     seq_len,
+                                     y_desc_ptrs.data(),
+                                     y_dev.get(),
+                                     y_desc_ptrs.data(),
+                                     dy_dev.get(),
+                                     &h_desc,
+                                     dhy_dev.get(),
+                                     &c_desc,
+                                     dcy_dev.get(),
+                                     &w_desc,
+                                     w_dev.get(),
+                                     &h_desc,
+                                     use_hx ? hx_dev.get() : nullptr,
+                                     &c_desc,
+                                     use_hx ? cx_dev.get() : nullptr,
+                                     x_desc_ptrs.data(),
+                                     dx_dev.get(),
+                                     &h_desc,
+                                     use_hx ? dhx_dev.get() : nullptr,
+                                     &c_desc,
+                                     use_hx ? dcx_dev.get() : nullptr,
+                                     ws_dev.get(),
+                                     ws_size,
+                                     rs_dev.get(),
+                                     rs_size) == miopenStatusSuccess);
+
+        EXPECT(miopenRNNBackwardWeights(&handle,
+                                        &rnn_desc,
+                                        seq_len,
+                                        x_desc_ptrs.data(),
+                                        x_dev.get(),
+                                        &h_desc,
+                                        use_hx ? hx_dev.get() : nullptr,
+                                        y_desc_ptrs.data(),
+                                        y_dev.get(),
+                                        &w_desc,
+                                        dw_dev.get(),
+                                        ws_dev.get(),
+                                        ws_size,
+                                        rs_dev.get(),
+                                        rs_size) == miopenStatusSuccess);
+
+        res.y   = handle.Read<float>(y_dev, dy.size());
+        res.hy  = handle.Read<float>(hy_dev, hx.size());
+        res.cy  = handle.Read<float>(cy_dev, cx.size());
+        res.dx  = handle.Read<float>(dx_dev, x.size());
+        if(use_hx)
+        {
+            res.dhx = handle.Read<float>(dhx_dev, hx.size());
+            res.dcx = handle.Read<float>(dcx_dev, cx.size());
+        }
+        res.dw  = handle.Read<float>(dw_dev, w.size());
+
+        // Inference runs the same forward pass in the workspace.
+        auto y_infer_dev = handle.Create(dy.size() * sizeof(float));
+        EXPECT(miopenRNNForwardInference(&handle,
+                                         &rnn_desc,
+                                         seq_len,
+                                         x_desc_ptrs.data(),
+                                         x_dev.get(),
+                                         &h_desc,
+                                         use_hx ? hx_dev.get() : nullptr,
+                                         &c_desc,
+                                         use_hx ? cx_dev.get() : nullptr,
+                                         &w_desc,
+                                         w_dev.get(),
+                                         y_desc_ptrs.data(),
+                                         y_infer_dev.get(),
+                                         &h_desc,
+                                         nullptr,
+                                         &c_desc,
+                                         nullptr,
+                                         ws_dev.get(),
+                                         ws_size) == miopenStatusSuccess);
+        EXPECT(miopen::rms_range(res.y, handle.Read<float>(y_infer_dev, dy.size())) < 1e-6);
+
+        return res;
+    }
+
+    void run()
+    {
+        bi      = dir == miopenRNNbidirection ? 2 : 1;
+        seq_len = static_cast<int>(in_n.size());
+        batch_n = std::accumulate(in_n.begin(), in_n.end(), 0);
+        base.assign(seq_len, 0);
+        std::partial_sum(in_n.begin(), in_n.end() - 1, base.begin() + 1);
+
+        auto&& handle = get_handle();
+        miopen::RNNDescriptor rnn_desc(hy_h,
+                                       layers,
+                                       miopenLSTM,
+                                       miopenRNNlinear,
+                                       dir,
+                                       bias,
+                                       miopenRNNdefault,
+                                       miopenFloat);
+        EXPECT(miopenSetRNNProjectionSize(&rnn_desc, pr_h) == miopenStatusSuccess);
+        int proj_size = 0;
+        EXPECT(miopenGetRNNProjectionSize(&rnn_desc, &proj_size) == miopenStatusSuccess);
+        EXPECT(proj_size == pr_h);
+
+        std::vector<miopen::TensorDescriptor> x_descs, y_descs;
+        for(auto n : in_n)
+        {
+            x_descs.push_back(miopen::TensorDescriptor(miopenFloat, std::vector<int>{n, in_h}));
+            y_descs.push_back(
+                miopen::TensorDescriptor(miopenFloat, std::vector<int>{n, bi * pr_h}));
+        }
+        std::vector<miopenTensorDescriptor_t> x_desc_ptrs, y_desc_ptrs;
+        for(int i = 0; i < seq_len; i++)
+        {
+            x_desc_ptrs.push_back(&x_descs[i]);
+            y_desc_ptrs.push_back(&y_descs[i]);
+        }
+        auto h_desc =
+            miopen::TensorDescriptor(miopenFloat, std::vector<int>{layers * bi, in_n[0], pr_h});
+        auto c_desc =
+            miopen::TensorDescriptor(miopenFloat, std::vector<int>{layers * bi, in_n[0], hy_h});
+
+        std::size_t w_size = 0;
+        miopenGetRNNParamsSize(&handle, &rnn_desc, &x_descs[0], &w_size, miopenFloat);
+        auto w_desc = miopen::TensorDescriptor(miopenFloat, {w_size / sizeof(float)});
+
+        miopen::TensorDescriptor param_desc;
+        for(int lay = 0; lay < layers * bi; lay++)
+        {
+            std::array<std::size_t, 4> wx_lay{}, wh_lay{}, bx_lay{}, bh_lay{};
+            for(int g = 0; g < 4; g++)
+            {
+                rnn_desc.GetLayerParamOffset(lay, x_descs[0], g, param_desc, &wx_lay[g]);
+                rnn_desc.GetLayerParamOffset(lay, x_descs[0], 4 + g, param_desc, &wh_lay[g]);
+                EXPECT(param_desc.GetLengths()[1] == pr_h);
+                if(bias == miopenRNNwithBias)
+                {
+                    rnn_desc.GetLayerBiasOffset(lay, x_descs[0], g, param_desc, &bx_lay[g]);
+                    rnn_desc.GetLayerBiasOffset(lay, x_descs[0], 4 + g, param_desc, &bh_lay[g]);
+                }
+            }
+            std::size_t wp_lay = 0;
+            rnn_desc.GetLayerParamOffset(lay, x_descs[0], 8, param_desc, &wp_lay);
+            EXPECT(param_desc.GetLengths()[0] == pr_h && param_desc.GetLengths()[1] == hy_h);
+            EXPECT(wp_lay + pr_h * hy_h <= w_desc.GetElementSize());
+            wx_off.push_back(wx_lay);
+            wh_off.push_back(wh_lay);
+            bx_off.push_back(bx_lay);
+            bh_off.push_back(bh_lay);
+            wp_off.push_back(wp_lay);
+        }
+
+        std::mt19937 gen(29);
+        std::uniform_real_distribution<float> dist(-0.5f, 0.5f);
+        const auto random = [&](std::size_t n) {
+            std::vector<float> v(n);
+            for(auto& e : v)
+                e = dist(gen);
+            return v;
+        };
+        x   = random(batch_n * in_h);
+        hx  = random(h_desc.GetElementSize());
+        cx  = random(c_desc.GetElementSize());
+        w   = random(w_desc.GetElementSize());
+        dy  = random(batch_n * bi * pr_h);
+        dhy = random(h_desc.GetElementSize());
+        dcy = random(c_desc.GetElementSize());
+
+        const auto expected = RunHost();
+        const auto actual = RunDevice(rnn_desc, x_desc_ptrs, y_desc_ptrs, h_desc, c_desc, w_desc);
+
+        EXPECT(miopen::rms_range(expected.y, actual.y) < 1e-5);
+        EXPECT(miopen::rms_range(expected.hy, actual.hy) < 1e-5);
+        EXPECT(miopen::rms_range(expected.cy, actual.cy) < 1e-5);
+        EXPECT(miopen::rms_range(expected.dx, actual.dx) < 1e-4);
+        if(use_hx)
+        {
+            EXPECT(miopen::rms_range(expected.dhx, actual.dhx) < 1e-4);
+            EXPECT(miopen::rms_range(expected.dcx, actual.dcx) < 1e-4);
+        }
+        EXPECT(miopen::rms_range(expected.dw, actual.dw) < 1e-4);
+    }
+};
+
+int main()
+{
+    for(auto dir : {miopenRNNunidirection, miopenRNNbidirection})
+        for(auto bias : {miopenRNNNoBias, miopenRNNwithBias})
+            for(int layers : {1, 2})
+                for(bool use_hx : {true, false})
+                    lstm_projection_test(dir, bias, layers, use_hx).run();
+}
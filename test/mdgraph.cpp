@@ -28,6 +28,7 @@
 #include <miopen/manage_ptr.hpp>
 #include <miopen/fusion_plan.hpp>
 #include <miopen/env.hpp>
+#include <miopen/stringutils.hpp>
 
 #include "get_handle.hpp"
 #include "test.hpp"
@@ -63,7 +64,8 @@ void ConvAlgTest(std::vector<int> inputs,
                  std::vector<int> conv_desc,
                  std::string& pgm,
                  std::string& krn,
-                 std::string& alg)
+                 std::string& alg,
+                 miopenDataType_t data_type = miopenFloat)
 {
     MIOPEN_LOG_I("*********************************************************");
     auto&& handle = get_handle();
@@ -74,10 +76,10 @@ void ConvAlgTest(std::vector<int> inputs,
 
     // input descriptor
     STATUS(miopenSet4dTensorDescriptor(
-        &inputTensor, miopenFloat, inputs[0], inputs[1], inputs[2], inputs[3]));
+        &inputTensor, data_type, inputs[0], inputs[1], inputs[2], inputs[3]));
     // convolution descriptor
     STATUS(miopenSet4dTensorDescriptor(&convFilter,
-                                       miopenFloat,
+                                       data_type,
                                        conv_filter[0], // outputs k
                                        conv_filter[1], // inputs c
                                        conv_filter[2], // kernel size
@@ -129,6 +131,22 @@ int main()
             {100, 15, 8, 8}, {64, 15, 3, 3}, {0, 0, 1, 1, 1, 1}, pgm_name, krn_name, alg_name);
         EXPECT(krn_name != "miopenSp3AsmConvRxSU_CBA");
         EXPECT(alg_name != "miopenConvolutionWinogradBiasActiv");
+
+        // fp16 is served by the dot2 f2x3 kernels where they are available
+        const auto device = get_handle().GetDeviceName();
+        if(miopen::StartsWith(device, "gfx906") || miopen::StartsWith(device, "gfx908"))
+        {
+            ConvAlgTest({100, 32, 8, 8},
+                        {64, 32, 3, 3},
+                        {1, 1, 1, 1, 1, 1},
+                        pgm_name,
+                        krn_name,
+                        alg_name,
+                        miopenHalf);
+            // The rest of the name depends on the kernel version, the arch and the stride.
+            EXPECT(miopen::StartsWith(krn_name, "miopenSp3AsmConv_v21"));
+            EXPECT(alg_name == "miopenConvolutionWinogradBiasActiv");
+        }
     }
     // the asm kernel is the fastest for 1x1 and padding
     if(!miopen::IsDisabled(MIOPEN_DEBUG_GCN_ASM_KERNELS{}))
@@ -0,0 +1,134 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "test.hpp"
+#include <miopen/measurement_policy.hpp>
+
+#include <cmath>
+
+namespace miopen {
+namespace tests {
+
+struct MeasurementPolicyTest
+{
+    void Run() const
+    {
+        Stats();
+        DefaultPolicy();
+        AdaptivePolicy();
+        BatchSize();
+        ClockDrift();
+    }
+
+    private:
+    static void Stats()
+    {
+        solver::RunningStats stats;
+        EXPECT(stats.Count() == 0);
+        EXPECT(stats.RelativeError() == 0.0f);
+        for(const auto sample : {2.0f, 4.0f, 4.0f, 4.0f, 5.0f, 5.0f, 7.0f, 9.0f})
+            stats.Add(sample);
+        EXPECT(stats.Count() == 8);
+        EXPECT(std::abs(stats.Mean() - 5.0f) < 1e-6f);
+        EXPECT(std::abs(stats.Variance() - 32.0f / 7) < 1e-5f);
+        EXPECT(std::abs(stats.RelativeError() - std::sqrt(32.0f / 7 / 8) / 5) < 1e-5f);
+    }
+
+    static void DefaultPolicy()
+    {
+        const solver::MeasurementPolicy policy;
+        EXPECT(!policy.IsPruned(1.0f, 1.0f));
+        EXPECT(!policy.IsPruned(1.04f, 1.0f));
+        EXPECT(policy.IsPruned(1.06f, 1.0f));
+
+        solver::RunningStats stats;
+        auto runs = 0;
+        do
+        {
+            stats.Add(1.0f);
+            ++runs;
+        } while(policy.NeedsMoreRuns(stats));
+        EXPECT(runs == 5);
+    }
+
+    static void AdaptivePolicy()
+    {
+        solver::MeasurementPolicy policy;
+        policy.max_runs         = 100;
+        policy.target_rel_error = 0.01f;
+
+        solver::RunningStats stable;
+        while(policy.NeedsMoreRuns(stable))
+            stable.Add(1.0f);
+        EXPECT(stable.Count() == 3);
+
+        solver::RunningStats noisy;
+        auto i = 0;
+        while(policy.NeedsMoreRuns(noisy))
+            noisy.Add((i++ % 2) == 0 ? 1.0f : 2.0f);
+        EXPECT(noisy.Count() > 3);
+        EXPECT(noisy.Count() <= 100);
+    }
+
+    static void BatchSize()
+    {
+        solver::MeasurementPolicy policy;
+        EXPECT(policy.GetBatchSize(0.001f) == 1);
+
+        policy.min_span_ms = 0.2f;
+        policy.max_batch   = 64;
+        EXPECT(policy.GetBatchSize(0.5f) == 1);
+        EXPECT(policy.GetBatchSize(0.2f) == 1);
+        EXPECT(policy.GetBatchSize(0.05f) == 4);
+        EXPECT(policy.GetBatchSize(0.03f) == 7);
+        EXPECT(policy.GetBatchSize(0.0001f) == 64);
+        EXPECT(policy.GetBatchSize(0.0f) == 64);
+    }
+
+    static void ClockDrift()
+    {
+        solver::MeasurementPolicy policy;
+        const auto at = [](int sclk_mhz) {
+            auto conditions     = GpuConditions{};
+            conditions.sclk_mhz = sclk_mhz;
+            return conditions;
+        };
+        EXPECT(!policy.IsClockDrifted(at(1000), at(1000)));
+        EXPECT(!policy.IsClockDrifted(at(1000), at(1040)));
+        EXPECT(policy.IsClockDrifted(at(1000), at(1100)));
+        EXPECT(policy.IsClockDrifted(at(1000), at(900)));
+        EXPECT(!policy.IsClockDrifted(at(0), at(900)));
+        EXPECT(!policy.IsClockDrifted(at(1000), at(0)));
+
+        policy.clock_drift_ratio = 0.0f;
+        EXPECT(!policy.IsClockDrifted(at(1000), at(500)));
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::MeasurementPolicyTest().Run(); }
@@ -0,0 +1,218 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "driver.hpp"
+#include "get_handle.hpp"
+#include "tensor_holder.hpp"
+#include "test.hpp"
+#include "verify.hpp"
+
+#include <miopen/miopen.h>
+#include <miopen/optimizer.hpp>
+
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+template <class T>
+struct verify_multi_tensor_optimizer
+{
+    miopenOptimizerMode_t mode;
+    std::vector<size_t> counts;
+    std::vector<std::vector<T>> params;
+    std::vector<std::vector<T>> grads;
+    std::vector<std::vector<float>> exp_avgs;
+    std::vector<std::vector<float>> exp_avg_sqs;
+    float lr           = 0.01f;
+    float beta1        = 0.9f;
+    float beta2        = 0.999f;
+    float eps          = 1e-6f;
+    float weight_decay = 0.01f;
+    int step           = 3;
+
+    verify_multi_tensor_optimizer(miopenOptimizerMode_t pmode, const std::vector<size_t>& pcounts)
+        : mode(pmode), counts(pcounts)
+    {
+        for(std::size_t t = 0; t < counts.size(); t++)
+        {
+            params.emplace_back(counts[t]);
+            grads.emplace_back(counts[t]);
+            exp_avgs.emplace_back(counts[t]);
+            exp_avg_sqs.emplace_back(counts[t]);
+            for(std::size_t i = 0; i < counts[t]; i++)
+            {
+                params[t][i]      = T(std::sin(float(t * 131 + i)));
+                grads[t][i]       = T(0.5f * std::cos(float(t * 17 + i)));
+                exp_avgs[t][i]    = 0.1f * std::sin(float(i));
+                exp_avg_sqs[t][i] = 0.01f + 0.01f * std::cos(float(t + i)) * std::cos(float(t + i));
+            }
+        }
+    }
+
+    // all the updated parameters, end to end
+    tensor<T> flatten(const std::vector<std::vector<T>>& tensors) const
+    {
+        std::size_t total = std::accumulate(counts.begin(), counts.end(), std::size_t(0));
+        tensor<T> flat{std::vector<std::size_t>{total}};
+        auto it = flat.data.begin();
+        for(const auto& t : tensors)
+            it = std::copy(t.begin(), t.end(), it);
+        return flat;
+    }
+
+    tensor<T> cpu() const
+    {
+        auto p       = params;
+        auto m       = exp_avgs;
+        auto v       = exp_avg_sqs;
+        float bc1    = 1.0f - std::pow(beta1, float(step));
+        float bc2    = 1.0f - std::pow(beta2, float(step));
+        auto adamdir = [&](float mm, float vv) { return (mm / bc1) / (std::sqrt(vv / bc2) + eps); };
+
+        for(std::size_t t = 0; t < counts.size(); t++)
+        {
+            double w2 = 0;
+            double r2 = 0;
+            for(std::size_t i = 0; i < counts[t]; i++)
+            {
+                float w = float(p[t][i]);
+                float d = float(grads[t][i]);
+                if(mode != miopenOptimizerLAMB)
+                    d += weight_decay * w;
+
+                if(mode == miopenOptimizerSGD)
+                {
+                    w -= lr * d;
+                }
+                else if(mode == miopenOptimizerMomentum)
+                {
+                    m[t][i] = beta1 * m[t][i] + d;
+                    w -= lr * m[t][i];
+                }
+                else
+                {
+                    m[t][i] = beta1 * m[t][i] + (1.0f - beta1) * d;
+                    v[t][i] = beta2 * v[t][i] + (1.0f - beta2) * d * d;
+                    if(mode == miopenOptimizerAdam)
+                    {
+                        w -= lr * adamdir(m[t][i], v[t][i]);
+                    }
+                    else
+                    {
+                        float r = adamdir(m[t][i], v[t][i]) + weight_decay * w;
+                        w2 += w * w;
+                        r2 += r * r;
+                    }
+                }
+                if(mode != miopenOptimizerLAMB)
+                    p[t][i] = T(w);
+            }
+
+            if(mode == miopenOptimizerLAMB)
+            {
+                float ratio = (w2 > 0 && r2 > 0) ? float(std::sqrt(w2) / std::sqrt(r2)) : 1.0f;
+                for(std::size_t i = 0; i < counts[t]; i++)
+                {
+                    float w = float(p[t][i]);
+                    p[t][i] = T(w - lr * ratio * (adamdir(m[t][i], v[t][i]) + weight_decay * w));
+                }
+            }
+        }
+        return flatten(p);
+    }
+
+    tensor<T> gpu() const
+    {
+        auto&& handle = get_handle();
+
+        std::vector<miopen::Allocator::ManageDataPtr> bufs;
+        std::vector<Data_t> p_dev, m_dev, v_dev;
+        std::vector<ConstData_t> g_dev;
+        for(std::size_t t = 0; t < counts.size(); t++)
+        {
+            bufs.push_back(handle.Write(params[t]));
+            p_dev.push_back(bufs.back().get());
+            bufs.push_back(handle.Write(grads[t]));
+            g_dev.push_back(bufs.back().get());
+            bufs.push_back(handle.Write(exp_avgs[t]));
+            m_dev.push_back(bufs.back().get());
+            bufs.push_back(handle.Write(exp_avg_sqs[t]));
+            v_dev.push_back(bufs.back().get());
+        }
+
+        miopen::MultiTensorOptimizerUpdate(handle,
+                                           mode,
+                                           miopen_type<T>{},
+                                           counts,
+                                           p_dev,
+                                           g_dev,
+                                           m_dev,
+                                           v_dev,
+                                           lr,
+                                           beta1,
+                                           beta2,
+                                           eps,
+                                           weight_decay,
+                                           step);
+
+        auto p = params;
+        for(std::size_t t = 0; t < counts.size(); t++)
+            p[t] = handle.Read<T>(bufs[4 * t], counts[t]);
+        return flatten(p);
+    }
+
+    void fail(int = 0) const
+    {
+        std::cout << "Multi-tensor optimizer update, mode " << mode << ", " << counts.size()
+                  << " tensors" << std::endl;
+    }
+};
+
+template <class T>
+struct multi_tensor_optimizer_driver : test_driver
+{
+    int mode          = 0;
+    int tensor_count  = 1;
+    int max_elem_size = 1;
+
+    multi_tensor_optimizer_driver()
+    {
+        add(mode, "mode", generate_data({0, 1, 2, 3}));
+        // more than 16 tensors take several launches
+        add(tensor_count, "tensors", generate_data({1, 7, 37}));
+        add(max_elem_size, "max-size", generate_data({1, 300, 70000}));
+    }
+
+    void run()
+    {
+        std::vector<size_t> counts;
+        for(int t = 0; t < tensor_count; t++)
+            counts.push_back(1 + (t * 7919) % max_elem_size);
+
+        verify(verify_multi_tensor_optimizer<T>{miopenOptimizerMode_t(mode), counts});
+    }
+};
+
+int main(int argc, const char* argv[]) { test_drive<multi_tensor_optimizer_driver>(argc, argv); }
@@ -0,0 +1,240 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+
+#include <miopen/config.h>
+
+#if MIOPEN_ENABLE_SQLITE
+#include <miopen/bz2.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/memvfs_pager.h>
+#include <miopen/paged_image.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <sqlite3.h>
+
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+extern "C" {
+int miopen_sqlite3_memvfs_init(sqlite3* db, char** pzErrMsg, const sqlite3_api_routines* pApi);
+}
+
+namespace miopen {
+namespace tests {
+
+std::string CompressPage(const std::string& page)
+{
+    bool compressed = false;
+    return compress(page, &compressed);
+}
+
+struct PagedImageTest
+{
+    void Run() const
+    {
+        RoundTrip();
+        ConcurrentReaders();
+        Malformed();
+        Sqlite();
+    }
+
+    private:
+    // Compressible and incompressible (random) pages, a short last page.
+    static std::string MakeFile()
+    {
+        std::string file;
+        for(auto i = 0; i < 300; ++i)
+            file += "solver_" + std::to_string(i % 7) + ";";
+        auto seed = 12345u;
+        for(auto i = 0; i < 700; ++i)
+        {
+            seed = seed * 1103515245u + 12345u;
+            file.push_back(static_cast<char>(seed >> 16));
+        }
+        return file;
+    }
+
+    static void RoundTrip()
+    {
+        const auto file  = MakeFile();
+        const auto size  = std::size_t{256};
+        const auto image = PagedImage::Make(file, size, CompressPage);
+        EXPECT(PagedImage::IsPagedImage(image.data(), image.size()));
+        EXPECT(!PagedImage::IsPagedImage(file.data(), file.size()));
+
+        const PagedImage paged{image.data(), image.size()};
+        EXPECT(paged.GetSize() == file.size());
+        EXPECT(paged.GetPageSize() == size);
+        EXPECT(paged.GetPageCount() == (file.size() + size - 1) / size);
+        EXPECT(paged.GetDecompressedPageCount() == 0);
+
+        const auto first = paged.GetPage(0);
+        EXPECT(std::memcmp(first, file.data(), size) == 0);
+        EXPECT(paged.GetDecompressedPageCount() == 1);
+        // Decompressed once.
+        EXPECT(paged.GetPage(0) == first);
+        EXPECT(paged.GetDecompressedPageCount() == 1);
+
+        for(std::size_t i = 0; i < paged.GetPageCount(); ++i)
+        {
+            const auto length = std::min(size, file.size() - i * size);
+            EXPECT(std::memcmp(paged.GetPage(i), file.data() + i * size, length) == 0);
+        }
+        // The random pages are kept verbatim.
+        EXPECT(paged.GetDecompressedPageCount() < paged.GetPageCount());
+        EXPECT(image.size() < file.size());
+    }
+
+    static void ConcurrentReaders()
+    {
+        const auto file  = MakeFile();
+        const auto image = PagedImage::Make(file, 64, CompressPage);
+        const PagedImage paged{image.data(), image.size()};
+        std::atomic<int> errors{0};
+
+        std::vector<std::thread> readers;
+        for(auto t = 0; t < 4; ++t)
+        {
+            readers.emplace_back([&]() {
+                for(std::size_t i = 0; i < paged.GetPageCount(); ++i)
+                {
+                    const auto length = std::min<std::size_t>(64, file.size() - i * 64);
+                    if(std::memcmp(paged.GetPage(i), file.data() + i * 64, length) != 0)
+                        ++errors;
+                }
+            });
+        }
+        for(auto& reader : readers)
+            reader.join();
+        EXPECT(errors == 0);
+    }
+
+    static void Malformed()
+    {
+        const auto image = PagedImage::Make(MakeFile(), 128, CompressPage);
+        EXPECT(throws([&]() { PagedImage(image.data(), image.size() - 1); }));
+        EXPECT(throws([&]() { PagedImage(image.data(), PagedImage::header_size); }));
+        EXPECT(throws([&]() { PagedImage(image.data(), 4); }));
+
+        auto corrupted = image;
+        // The first page is compressed, garble it past the codec magic.
+        const auto first = PagedImage::header_size + 8 * ((MakeFile().size() + 127) / 128 + 1);
+        corrupted[first + 10] ^= 0x55;
+        corrupted[first + 11] ^= 0x55;
+        const PagedImage paged{corrupted.data(), corrupted.size()};
+        EXPECT(throws([&]() { paged.GetPage(0); }));
+        EXPECT(throws([&]() { paged.GetPage(paged.GetPageCount()); }));
+    }
+
+    static const unsigned char* Page(void* ctx, long long index)
+    {
+        return static_cast<const PagedImage*>(ctx)->GetPage(index);
+    }
+
+    static void Exec(sqlite3* db, const std::string& sql)
+    {
+        char* error = nullptr;
+        if(sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &error) != SQLITE_OK)
+        {
+            const auto message = std::string{error};
+            sqlite3_free(error);
+            MIOPEN_THROW(message);
+        }
+    }
+
+    static int QueryInt(sqlite3* db, const std::string& sql)
+    {
+        sqlite3_stmt* stmt = nullptr;
+        EXPECT(sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK);
+        EXPECT(sqlite3_step(stmt) == SQLITE_ROW);
+        const auto value = sqlite3_column_int(stmt, 0);
+        sqlite3_finalize(stmt);
+        return value;
+    }
+
+    // The image is read by SQLite through memvfs as the embedded system db is.
+    static void Sqlite()
+    {
+        const TempFile file{"miopen.tests.paged_image"};
+        {
+            sqlite3* db = nullptr;
+            EXPECT(sqlite3_open(file.Path().c_str(), &db) == SQLITE_OK);
+            Exec(db, "CREATE TABLE config (id INTEGER PRIMARY KEY, name TEXT NOT NULL);");
+            Exec(db, "BEGIN;");
+            for(auto i = 0; i < 5000; ++i)
+                Exec(db,
+                     "INSERT INTO config (id, name) VALUES (" + std::to_string(i) +
+                         ", 'config_" + std::to_string(i) + "_" + std::string(40, 'x') + "');");
+            Exec(db, "COMMIT;");
+            sqlite3_close(db);
+        }
+        std::ifstream in(file.Path(), std::ios::binary);
+        const std::string content{std::istreambuf_iterator<char>{in},
+                                  std::istreambuf_iterator<char>{}};
+
+        // Pages not aligned to the db pages, so that reads span them.
+        const auto image = PagedImage::Make(content, 3000, CompressPage);
+        const PagedImage paged{image.data(), image.size()};
+        miopen_memvfs_pager pager{const_cast<PagedImage*>(&paged), 3000, Page};
+
+        sqlite3_auto_extension(reinterpret_cast<void (*)(void)>(miopen_sqlite3_memvfs_init));
+        sqlite3* db = nullptr;
+        EXPECT(sqlite3_open(":memory:", &db) == SQLITE_OK);
+        sqlite3_close(db);
+
+        char* uri = sqlite3_mprintf("file:ignoredFilename?pager=0x%p&sz=%lld",
+                                    &pager,
+                                    static_cast<long long>(content.size()));
+        EXPECT(sqlite3_open_v2(uri, &db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_URI, "memvfs") ==
+               SQLITE_OK);
+        sqlite3_free(uri);
+
+        EXPECT(QueryInt(db, "SELECT length(name) FROM config WHERE id = 4321;") == 52);
+        // A lookup touches a few pages only.
+        EXPECT(paged.GetDecompressedPageCount() < paged.GetPageCount() / 2);
+        EXPECT(QueryInt(db, "SELECT count(*) FROM config;") == 5000);
+        EXPECT(QueryInt(db, "SELECT sum(id) FROM config;") == 4999 * 5000 / 2);
+        EXPECT(throws([&]() { Exec(db, "INSERT INTO config (id, name) VALUES (-1, 'a');"); }));
+        sqlite3_close(db);
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+#endif
+
+int main()
+{
+#if MIOPEN_ENABLE_SQLITE
+    miopen::tests::PagedImageTest{}.Run();
+#endif
+}
@@ -31,6 +31,7 @@
 #include <miopen/db_record.hpp>
 #include <miopen/lock_file.hpp>
 #include <miopen/temp_file.hpp>
+#include <miopen/tmp_dir.hpp>
 
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/path.hpp>
@@ -347,6 +348,115 @@ class DbUpdateTest : public DbTest
     }
 };
 
+class DbJournalTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing db journal..." << std::endl;
+
+        ResetDb();
+        testing_user_db_journal_enabled = true;
+
+        DbRecord record0(key());
+        EXPECT(record0.SetValues(id0(), value0()));
+        DbRecord record1(key());
+        EXPECT(record1.SetValues(id1(), value1()));
+
+        {
+            PlainTextDb db(temp_file);
+            EXPECT(db.StoreRecord(record0));
+            EXPECT(db.UpdateRecord(record1));
+        }
+
+        // Merged in the returned record, journaled but not yet in the file.
+        TestData read0;
+        EXPECT(record1.GetValues(id0(), read0));
+        EXPECT_EQUAL(value0(), read0);
+        std::string line;
+        EXPECT(!std::getline(std::ifstream(temp_file), line));
+        ValidateSingleEntry(key(), common_data(), PlainTextDb(temp_file));
+
+        EXPECT(PlainTextDb(temp_file).FlushJournal());
+        testing_user_db_journal_enabled = false;
+        EXPECT(std::getline(std::ifstream(temp_file), line).good());
+        ValidateSingleEntry(key(), common_data(), PlainTextDb(temp_file));
+    }
+};
+
+class DbJournalRecoveryTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing db journal of a process which is gone..." << std::endl;
+
+        ResetDb();
+        RawWrite(temp_file, key(), std::array<std::pair<const std::string, TestData>, 1>{{
+                                       {id0(), value0()},
+                                   }});
+
+        // A pid no process can have, the journal shall be merged by the next process opening the
+        // db. The torn last line shall be skipped.
+        const auto orphan = temp_file.Path() + ".2147483647.journal";
+        {
+            std::ofstream journal(orphan);
+            journal << "U " << key().x << ',' << key().y << '=' << id1() << ':' << value1().x
+                    << ',' << value1().y << std::endl
+                    << "S " << key().x << ',' << key().y << '=' << id2();
+        }
+
+        testing_user_db_journal_enabled = true;
+        ValidateSingleEntry(key(), common_data(), PlainTextDb(temp_file));
+        testing_user_db_journal_enabled = false;
+
+        EXPECT(!boost::filesystem::exists(orphan));
+        ValidateSingleEntry(key(), common_data(), PlainTextDb(temp_file));
+    }
+};
+
+class DbSharedImageTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing db shared image..." << std::endl;
+
+        const TmpDir cache{"miopen.tests.perfdb.shared"};
+        testing_user_db_shared_cache_path = cache.path.string();
+        ResetDb();
+
+        DbRecord record0(key());
+        EXPECT(record0.SetValues(id0(), value0()));
+        DbRecord record1(key());
+        EXPECT(record1.SetValues(id1(), value1()));
+
+        PlainTextDb db(temp_file);
+        EXPECT(db.StoreRecord(record0));
+        EXPECT(db.FindRecord(key()));
+        EXPECT(!db.FindRecord(TestData(100, 200)));
+        EXPECT_EQUAL(CountImages(cache.path), 1);
+
+        // An update makes a new image and removes the outdated one.
+        EXPECT(db.UpdateRecord(record1));
+        ValidateSingleEntry(key(), common_data(), db);
+        ValidateSingleEntry(key(), common_data(), PlainTextDb(temp_file));
+        EXPECT_EQUAL(CountImages(cache.path), 1);
+
+        testing_user_db_shared_cache_path.clear();
+    }
+
+    private:
+    static int CountImages(const boost::filesystem::path& directory)
+    {
+        auto count = 0;
+        for(boost::filesystem::directory_iterator it(directory), end; it != end; ++it)
+            if(it->path().extension() == ".bin")
+                ++count;
+        return count;
+    }
+};
+
 class DbRemoveTest : public DbTest
 {
     public:
@@ -1299,6 +1409,9 @@ struct PerfDbDriver : test_driver
         DbWriteTest().Run();
         DbOperationsTest().Run();
         DbParallelTest().Run();
+        DbJournalTest().Run();
+        DbJournalRecoveryTest().Run();
+        DbSharedImageTest().Run();
 
         DbMultiThreadedReadTest().Run();
         DbMultiProcessReadTest().Run();
@@ -0,0 +1,145 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "driver.hpp"
+#include "get_handle.hpp"
+#include "tensor_holder.hpp"
+#include "test.hpp"
+
+#include <miopen/miopen.h>
+#include <miopen/pooling.hpp>
+
+#include <vector>
+
+struct pool_gen
+{
+    template <class... Ts>
+    double operator()(Ts... Xs) const
+    {
+        // Few distinct values, so that most windows hold ties.
+        return tensor_elem_gen_integer{5}(Xs...);
+    }
+};
+
+struct dy_gen
+{
+    template <class... Ts>
+    double operator()(Ts... Xs) const
+    {
+        return tensor_elem_gen_integer{61}(Xs...) + 1.0;
+    }
+};
+
+/// Runs max pooling forward and backward in the workspace index mode, and returns dx.
+std::vector<float> run_max_pooling(miopen::PoolingDescriptor filter,
+                                   miopenPoolingWorkspaceIndexMode_t index_mode,
+                                   const tensor<float>& x,
+                                   const tensor<float>& dy,
+                                   std::vector<float>& y_out)
+{
+    auto&& handle = get_handle();
+    filter.SetIndexType(miopenIndexUint32);
+    filter.SetWorkspaceIndexMode(index_mode);
+
+    const auto workspace_size = filter.GetWorkSpaceSize(dy.desc);
+    if(index_mode == miopenPoolingWorkspaceIndexRecompute)
+        EXPECT(workspace_size == 0);
+
+    auto x_dev         = handle.Write(x.data);
+    auto y_dev         = handle.Create<float>(dy.data.size());
+    auto dy_dev        = handle.Write(dy.data);
+    auto dx_dev        = handle.Create<float>(x.data.size());
+    auto workspace_dev = handle.Create(workspace_size == 0 ? 1 : workspace_size);
+
+    float alpha = 1, beta = 0;
+    filter.Forward(handle,
+                   &alpha,
+                   x.desc,
+                   x_dev.get(),
+                   &beta,
+                   dy.desc,
+                   y_dev.get(),
+                   true,
+                   workspace_size == 0 ? nullptr : workspace_dev.get(),
+                   workspace_size);
+    filter.Backward(handle,
+                    &alpha,
+                    dy.desc,
+                    y_dev.get(),
+                    dy.desc,
+                    dy_dev.get(),
+                    x.desc,
+                    x_dev.get(),
+                    &beta,
+                    x.desc,
+                    dx_dev.get(),
+                    workspace_size == 0 ? nullptr : workspace_dev.get());
+
+    y_out = handle.Read<float>(y_dev, dy.data.size());
+    return handle.Read<float>(dx_dev, x.data.size());
+}
+
+void chk_pooling_recompute(const std::vector<std::size_t>& lengths,
+                           const std::vector<int>& window,
+                           const std::vector<int>& strides,
+                           const std::vector<int>& pads)
+{
+    const auto filter =
+        miopen::PoolingDescriptor{miopenPoolingMax, miopenPaddingDefault, window, strides, pads};
+    const auto x  = tensor<float>{lengths}.generate(pool_gen{});
+    const auto dy = tensor<float>{filter.GetForwardOutputTensor(x.desc)}.generate(dy_gen{});
+
+    auto saved_y      = std::vector<float>{};
+    auto recomputed_y = std::vector<float>{};
+    const auto saved = run_max_pooling(filter, miopenPoolingWorkspaceIndexImage, x, dy, saved_y);
+    const auto recomputed =
+        run_max_pooling(filter, miopenPoolingWorkspaceIndexRecompute, x, dy, recomputed_y);
+
+    // Each dy lands where the saved index points, so the gradients only match if the recomputed
+    // positions are the saved ones, ties included.
+    std::size_t errors = 0;
+    for(std::size_t i = 0; i < saved.size(); ++i)
+        if(saved[i] != recomputed[i])
+            ++errors;
+    if(errors != 0)
+        std::cout << "Pooling recompute " << x.desc << " window " << window.front()
+                  << " stride " << strides.front() << " errors: " << errors << std::endl;
+    EXPECT(errors == 0);
+    EXPECT(saved_y == recomputed_y);
+}
+
+int main()
+{
+    /*
+     * The backward pass of max pooling without a workspace must route the gradients to the
+     * positions the forward pass saves, for disjoint and overlapping windows, with padding, in
+     * 2D and in 3D.
+     */
+    chk_pooling_recompute({2, 3, 16, 16}, {2, 2}, {2, 2}, {0, 0});
+    chk_pooling_recompute({2, 3, 17, 13}, {3, 3}, {2, 2}, {1, 1});
+    chk_pooling_recompute({1, 4, 9, 11}, {3, 2}, {1, 1}, {0, 1});
+    chk_pooling_recompute({2, 2, 6, 8, 8}, {3, 3, 3}, {2, 2, 2}, {1, 1, 1});
+}
@@ -0,0 +1,143 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include <miopen/interned_string.hpp>
+#include <miopen/read_mostly_map.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+struct InternedStringTest
+{
+    void Run() const
+    {
+        EXPECT(InternedString::TryGet("interned_string_test_absent").IsEmpty());
+        EXPECT(InternedString::TryGet("interned_string_test_absent").IsEmpty());
+
+        const auto a = InternedString{"interned_string_test_a"};
+        const auto b = InternedString{std::string{"interned_string_test_"} + "a"};
+        const auto c = InternedString{"interned_string_test_c"};
+
+        EXPECT(a == b);
+        EXPECT(a != c);
+        EXPECT(a.Hash() == b.Hash());
+        EXPECT(a.ToString() == "interned_string_test_a");
+        EXPECT(InternedString::TryGet("interned_string_test_c") == c);
+        EXPECT(InternedString{}.ToString().empty());
+    }
+};
+
+struct ReadMostlyMapTest
+{
+    void Run() const
+    {
+        Basic();
+        ConcurrentReaders();
+    }
+
+    private:
+    static void Basic()
+    {
+        ReadMostlyMap<int, std::string> map{2};
+        EXPECT(map.Find(1) == nullptr);
+        EXPECT(map.Insert(1, "one").second);
+        const auto one = map.Find(1);
+        EXPECT(one != nullptr && *one == "one");
+        EXPECT(!map.Insert(1, "uno").second);
+        EXPECT(*map.Find(1) == "one");
+
+        for(auto i = 2; i < 100; ++i)
+            map.Insert(i, std::to_string(i));
+        EXPECT(map.Size() == 99);
+        // References stay valid after rehashing.
+        EXPECT(*one == "one");
+
+        map.InsertOrAssign(1, "uno");
+        EXPECT(*map.Find(1) == "uno");
+        EXPECT(map.Size() == 99);
+        for(auto i = 2; i < 100; ++i)
+            EXPECT(*map.Find(i) == std::to_string(i));
+
+        const auto moved = std::move(map);
+        EXPECT(moved.Size() == 99);
+        EXPECT(*moved.Find(1) == "uno");
+        EXPECT(*moved.Find(42) == "42");
+
+        // The source is left as an empty map.
+        EXPECT(map.Size() == 0);
+        EXPECT(map.Find(1) == nullptr);
+        EXPECT(map.Insert(1, "one").second);
+        EXPECT(*map.Find(1) == "one");
+    }
+
+    static void ConcurrentReaders()
+    {
+        const auto keys = 2000;
+        ReadMostlyMap<int, int> map;
+        std::atomic<bool> done{false};
+        std::atomic<int> errors{0};
+
+        std::vector<std::thread> readers;
+        for(auto t = 0; t < 4; ++t)
+        {
+            readers.emplace_back([&]() {
+                while(!done.load())
+                {
+                    for(auto i = 0; i < keys; ++i)
+                    {
+                        const auto value = map.Find(i);
+                        if(value != nullptr && *value != i * 2)
+                            ++errors;
+                    }
+                }
+            });
+        }
+
+        for(auto i = 0; i < keys; ++i)
+            map.Insert(i, i * 2);
+        done = true;
+        for(auto& reader : readers)
+            reader.join();
+
+        EXPECT(errors.load() == 0);
+        for(auto i = 0; i < keys; ++i)
+            EXPECT(*map.Find(i) == i * 2);
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main()
+{
+    miopen::tests::InternedStringTest().Run();
+    miopen::tests::ReadMostlyMapTest().Run();
+}
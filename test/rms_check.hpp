@@ -0,0 +1,71 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_TEST_RMS_CHECK_HPP
+#define GUARD_MIOPEN_TEST_RMS_CHECK_HPP
+
+// driver.hpp has no include guard, the tests include it first.
+#include "test.hpp"
+#include "verify.hpp"
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+/// tensor_elem_gen_integer shifted by offset and divided by scale. Centred on zero, the values
+/// reach both sides of the activations and keep the sums of the host references exact.
+struct tensor_elem_gen_centered
+{
+    unsigned long max_value = 7;
+    double offset           = 3.0;
+    double scale            = 1.0;
+
+    template <class... Ts>
+    double operator()(Ts... Xs) const
+    {
+        return (tensor_elem_gen_integer{max_value}(Xs...) - offset) / scale;
+    }
+};
+
+/// Expects the rms error of the result against the host reference to be under the tolerance,
+/// the error is printed with the name of the check otherwise.
+template <class R1, class R2>
+void expect_rms(const std::string& name, const R1& ref, const R2& result, double tolerance = 1e-5)
+{
+    const double error = miopen::rms_range(ref, result);
+    if(!(error < tolerance))
+        std::cout << name << " rms error: " << error << std::endl;
+    EXPECT(error < tolerance);
+}
+
+/// Expects a check compared exactly to have found no mismatch, printing their count otherwise.
+inline void expect_exact(const std::string& name, std::size_t mismatches)
+{
+    if(mismatches != 0)
+        std::cout << name << " errors: " << mismatches << std::endl;
+    EXPECT(mismatches == 0);
+}
+
+#endif // GUARD_MIOPEN_TEST_RMS_CHECK_HPP
@@ -0,0 +1,189 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/miopen.h>
+#include <miopen/handle.hpp>
+#include <miopen/rnn.hpp>
+#include <miopen/tensor.hpp>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "get_handle.hpp"
+#include "test.hpp"
+#include "verify.hpp"
+
+// Inference with prepared weights shall give the results of the canonical parameter layout, and
+// with quantized weights the same up to the int8 rounding of the recurrent matrices.
+struct rnn_prepared_weights_test
+{
+    miopenRNNMode_t mode;
+    miopenRNNDirectionMode_t dir;
+    miopenRNNInputMode_t in_mode;
+    miopenRNNBiasMode_t bias;
+    std::size_t layers;
+
+    static constexpr std::size_t in_h   = 8;
+    static constexpr std::size_t hy_h   = 8;
+    const std::vector<std::size_t> in_n = {4, 4, 3, 1};
+
+    enum class weights_kind
+    {
+        canonical,
+        prepared,
+        quantized,
+    };
+
+    std::vector<float> Run(weights_kind kind) const
+    {
+        auto&& handle     = get_handle();
+        const std::size_t bi      = dir == miopenRNNbidirection ? 2 : 1;
+        const int seq_len         = static_cast<int>(in_n.size());
+        const std::size_t batch_n = std::accumulate(in_n.begin(), in_n.end(), std::size_t(0));
+
+        miopen::RNNDescriptor rnn_desc(static_cast<int>(hy_h),
+                                       static_cast<int>(layers),
+                                       mode,
+                                       in_mode,
+                                       dir,
+                                       bias,
+                                       miopenRNNdefault,
+                                       miopenFloat);
+
+        std::vector<miopen::TensorDescriptor> x_descs, y_descs;
+        for(auto n : in_n)
+        {
+            x_descs.push_back(miopen::TensorDescriptor(miopenFloat, {n, in_h}));
+            y_descs.push_back(miopen::TensorDescriptor(miopenFloat, {n, bi * hy_h}));
+        }
+        std::vector<miopenTensorDescriptor_t> x_desc_ptrs, y_desc_ptrs;
+        for(int i = 0; i < seq_len; i++)
+        {
+            x_desc_ptrs.push_back(&x_descs[i]);
+            y_desc_ptrs.push_back(&y_descs[i]);
+        }
+        auto h_desc = miopen::TensorDescriptor(miopenFloat, {layers * bi, in_n[0], hy_h});
+
+        std::size_t w_size = 0;
+        miopenGetRNNParamsSize(&handle, &rnn_desc, &x_descs[0], &w_size, miopenFloat);
+        auto w_desc = miopen::TensorDescriptor(miopenFloat, {w_size / sizeof(float)});
+
+        std::size_t ws_size = 0;
+        miopenGetRNNWorkspaceSize(&handle, &rnn_desc, seq_len, x_desc_ptrs.data(), &ws_size);
+
+        std::mt19937 gen(17);
+        std::uniform_real_distribution<float> dist(-0.5f, 0.5f);
+        const auto random = [&](std::size_t n) {
+            std::vector<float> v(n);
+            for(auto& e : v)
+                e = dist(gen);
+            return v;
+        };
+
+        auto x_dev  = handle.Write(random(batch_n * in_h));
+        auto hx_dev = handle.Write(random(h_desc.GetElementSize()));
+        auto cx_dev = handle.Write(random(h_desc.GetElementSize()));
+        auto w_dev  = handle.Write(random(w_desc.GetElementSize()));
+        auto y_dev  = handle.Create(batch_n * bi * hy_h * sizeof(float));
+        auto ws_dev = handle.Create(ws_size);
+
+        if(kind != weights_kind::canonical)
+        {
+            miopenRNNPreparedWeights_t weights = nullptr;
+            if(kind == weights_kind::quantized)
+                EXPECT(miopenCreateRNNQuantizedWeights(
+                           &handle, &rnn_desc, &x_descs[0], &w_desc, w_dev.get(), &weights) ==
+                       miopenStatusSuccess);
+            else
+                EXPECT(miopenCreateRNNPreparedWeights(
+                           &handle, &rnn_desc, &x_descs[0], &w_desc, w_dev.get(), &weights) ==
+                       miopenStatusSuccess);
+            EXPECT(miopenRNNForwardInferencePrepared(&handle,
+                                                     &rnn_desc,
+                                                     seq_len,
+                                                     x_desc_ptrs.data(),
+                                                     x_dev.get(),
+                                                     &h_desc,
+                                                     hx_dev.get(),
+                                                     &h_desc,
+                                                     cx_dev.get(),
+                                                     weights,
+                                                     y_desc_ptrs.data(),
+                                                     y_dev.get(),
+                                                     &h_desc,
+                                                     nullptr,
+                                                     &h_desc,
+                                                     nullptr,
+                                                     ws_dev.get(),
+                                                     ws_size) == miopenStatusSuccess);
+            miopenDestroyRNNPreparedWeights(weights);
+        }
+        else
+        {
+            EXPECT(miopenRNNForwardInference(&handle,
+                                             &rnn_desc,
+                                             seq_len,
+                                             x_desc_ptrs.data(),
+                                             x_dev.get(),
+                                             &h_desc,
+                                             hx_dev.get(),
+                                             &h_desc,
+                                             cx_dev.get(),
+                                             &w_desc,
+                                             w_dev.get(),
+                                             y_desc_ptrs.data(),
+                                             y_dev.get(),
+                                             &h_desc,
+                                             nullptr,
+                                             &h_desc,
+                                             nullptr,
+                                             ws_dev.get(),
+                                             ws_size) == miopenStatusSuccess);
+        }
+
+        return handle.Read<float>(y_dev, batch_n * bi * hy_h);
+    }
+
+    void run() const
+    {
+        const auto expected  = Run(weights_kind::canonical);
+        const auto actual    = Run(weights_kind::prepared);
+        const auto quantized = Run(weights_kind::quantized);
+        EXPECT(miopen::range_distance(expected) == miopen::range_distance(actual));
+        EXPECT(miopen::rms_range(expected, actual) < 1e-5);
+        EXPECT(miopen::rms_range(expected, quantized) < 2e-2);
+    }
+};
+
+int main()
+{
+    for(auto mode : {miopenRNNRELU, miopenRNNTANH, miopenLSTM, miopenGRU})
+        for(auto dir : {miopenRNNunidirection, miopenRNNbidirection})
+            for(auto in_mode : {miopenRNNlinear, miopenRNNskip})
+                for(auto bias : {miopenRNNNoBias, miopenRNNwithBias})
+                    for(std::size_t layers : {1, 3})
+                        rnn_prepared_weights_test{mode, dir, in_mode, bias, layers}.run();
+}
@@ -0,0 +1,229 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/miopen.h>
+#include <miopen/handle.hpp>
+#include <miopen/rnn.hpp>
+#include <miopen/tensor.hpp>
+#include <random>
+#include <vector>
+
+#include "get_handle.hpp"
+#include "test.hpp"
+#include "verify.hpp"
+
+// Training with an fp16 or bf16 reserve space against training with an fp32 one.
+struct rnn_reserve_compression_test
+{
+    miopenRNNMode_t mode;
+    miopenRNNDirectionMode_t dir;
+
+    static constexpr int in_h   = 6;
+    static constexpr int hy_h   = 16;
+    static constexpr int layers = 2;
+    const std::vector<int> in_n = {4, 4, 3, 1};
+
+    struct results
+    {
+        std::vector<float> y, dx, dw;
+        std::size_t ws_size, rs_size;
+    };
+
+    results Run(miopenDataType_t reserve_type,
+                const std::vector<float>& x,
+                const std::vector<float>& w,
+                const std::vector<float>& dy) const
+    {
+        auto&& handle      = get_handle();
+        const int bi       = dir == miopenRNNbidirection ? 2 : 1;
+        const auto seq_len = static_cast<int>(in_n.size());
+
+        miopen::RNNDescriptor rnn_desc(hy_h,
+                                       layers,
+                                       mode,
+                                       miopenRNNlinear,
+                                       dir,
+                                       miopenRNNwithBias,
+                                       miopenRNNdefault,
+                                       miopenFloat);
+        EXPECT(miopenSetRNNReserveSpaceDataType(&rnn_desc, reserve_type) == miopenStatusSuccess);
+        miopenDataType_t type = miopenInt32;
+        EXPECT(miopenGetRNNReserveSpaceDataType(&rnn_desc, &type) == miopenStatusSuccess);
+        EXPECT(type == reserve_type);
+
+        std::vector<miopen::TensorDescriptor> x_descs, y_descs;
+        for(auto n : in_n)
+        {
+            x_descs.push_back(miopen::TensorDescriptor(miopenFloat, std::vector<int>{n, in_h}));
+            y_descs.push_back(
+                miopen::TensorDescriptor(miopenFloat, std::vector<int>{n, bi * hy_h}));
+        }
+        std::vector<miopenTensorDescriptor_t> x_desc_ptrs, y_desc_ptrs;
+        for(int i = 0; i < seq_len; i++)
+        {
+            x_desc_ptrs.push_back(&x_descs[i]);
+            y_desc_ptrs.push_back(&y_descs[i]);
+        }
+        auto h_desc =
+            miopen::TensorDescriptor(miopenFloat, std::vector<int>{layers * bi, in_n[0], hy_h});
+        auto w_desc = miopen::TensorDescriptor(miopenFloat, {w.size()});
+
+        results res;
+        miopenGetRNNWorkspaceSize(&handle, &rnn_desc, seq_len, x_desc_ptrs.data(), &res.ws_size);
+        miopenGetRNNTrainingReserveSize(
+            &handle, &rnn_desc, seq_len, x_desc_ptrs.data(), &res.rs_size);
+
+        auto x_dev  = handle.Write(x);
+        auto w_dev  = handle.Write(w);
+        auto dy_dev = handle.Write(dy);
+        auto y_dev  = handle.Create(dy.size() * sizeof(float));
+        auto dx_dev = handle.Create(x.size() * sizeof(float));
+        auto dw_dev = handle.Create(w.size() * sizeof(float));
+        auto ws_dev = handle.Create(res.ws_size);
+        auto rs_dev = handle.Create(res.rs_size);
+
+        EXPECT(miopenRNNForwardTraining(&handle,
+                                        &rnn_desc,
+                                        seq_len,
+                                        x_desc_ptrs.data(),
+                                        x_dev.get(),
+                                        &h_desc,
+                                        nullptr,
+                                        &h_desc,
+                                        nullptr,
+                                        &w_desc,
+                                        w_dev.get(),
+                                        y_desc_ptrs.data(),
+                                        y_dev.get(),
+                                        &h_desc,
+                                        nullptr,
+                                        &h_desc,
+                                        nullptr,
+                                        ws_dev.get(),
+                                        res.ws_size,
+                                        rs_dev.get(),
+                                        res.rs_size) == miopenStatusSuccess);
+        EXPECT(miopenRNNBackwardData(&handle,
+                                     &rnn_desc,
+                                     seq_len,
+                                     y_desc_ptrs.data(),
+                                     y_dev.get(),
+                                     y_desc_ptrs.data(),
+                                     dy_dev.get(),
+                                     &h_desc,
+                                     nullptr,
+                                     &h_desc,
+                                     nullptr,
+                                     &w_desc,
+                                     w_dev.get(),
+                                     &h_desc,
+                                     nullptr,
+                                     &h_desc,
+                                     nullptr,
+                                     x_desc_ptrs.data(),
+                                     dx_dev.get(),
+                                     &h_desc,
+                                     nullptr,
+                                     &h_desc,
+                                     nullptr,
+                                     ws_dev.get(),
+                                     res.ws_size,
+                                     rs_dev.get(),
+                                     res.rs_size) == miopenStatusSuccess);
+        EXPECT(miopenRNNBackwardWeights(&handle,
+                                        &rnn_desc,
+                                        seq_len,
+                                        x_desc_ptrs.data(),
+                                        x_dev.get(),
+                                        &h_desc,
+                                        nullptr,
+                                        y_desc_ptrs.data(),
+                                        y_dev.get(),
+                                        &w_desc,
+                                        dw_dev.get(),
+                                        ws_dev.get(),
+                                        res.ws_size,
+                                        rs_dev.get(),
+                                        res.rs_size) == miopenStatusSuccess);
+
+        res.y  = handle.Read<float>(y_dev, dy.size());
+        res.dx = handle.Read<float>(dx_dev, x.size());
+        res.dw = handle.Read<float>(dw_dev, w.size());
+        return res;
+    }
+
+    void run() const
+    {
+        auto&& handle = get_handle();
+        const int bi  = dir == miopenRNNbidirection ? 2 : 1;
+        int batch_n   = 0;
+        for(auto n : in_n)
+            batch_n += n;
+
+        miopen::RNNDescriptor rnn_desc(hy_h,
+                                       layers,
+                                       mode,
+                                       miopenRNNlinear,
+                                       dir,
+                                       miopenRNNwithBias,
+                                       miopenRNNdefault,
+                                       miopenFloat);
+        miopen::TensorDescriptor x_desc(miopenFloat, std::vector<int>{in_n[0], in_h});
+        std::size_t w_size = 0;
+        miopenGetRNNParamsSize(&handle, &rnn_desc, &x_desc, &w_size, miopenFloat);
+
+        std::mt19937 gen(17);
+        std::uniform_real_distribution<float> dist(-0.5f, 0.5f);
+        const auto random = [&](std::size_t n) {
+            std::vector<float> v(n);
+            for(auto& e : v)
+                e = dist(gen);
+            return v;
+        };
+        const auto x  = random(batch_n * in_h);
+        const auto w  = random(w_size / sizeof(float));
+        const auto dy = random(batch_n * bi * hy_h);
+
+        const auto expected = Run(miopenFloat, x, w, dy);
+        for(auto type : {miopenHalf, miopenBFloat16})
+        {
+            const auto actual = Run(type, x, w, dy);
+            // The forward pass runs on the full reserve space and only the backward passes see
+            // the rounded activations.
+            EXPECT(miopen::rms_range(expected.y, actual.y) < 1e-6);
+            EXPECT(miopen::rms_range(expected.dx, actual.dx) < 2e-2);
+            EXPECT(miopen::rms_range(expected.dw, actual.dw) < 2e-2);
+            EXPECT(actual.rs_size < expected.rs_size);
+            EXPECT(actual.ws_size > expected.ws_size);
+        }
+    }
+};
+
+int main()
+{
+    for(auto mode : {miopenRNNTANH, miopenLSTM, miopenGRU})
+        for(auto dir : {miopenRNNunidirection, miopenRNNbidirection})
+            rnn_reserve_compression_test{mode, dir}.run();
+}
@@ -0,0 +1,157 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/miopen.h>
+#include <miopen/handle.hpp>
+#include <miopen/rnn.hpp>
+#include <miopen/tensor.hpp>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "get_handle.hpp"
+#include "test.hpp"
+#include "verify.hpp"
+
+// Streaming inference over chunks of a sequence shall give the outputs of the inference over the
+// whole sequence, whether the state starts at zero or is set.
+struct rnn_streaming_test
+{
+    miopenRNNMode_t mode;
+    std::size_t layers;
+    bool set_state;
+
+    static constexpr std::size_t in_h  = 8;
+    static constexpr std::size_t hy_h  = 8;
+    static constexpr std::size_t batch = 3;
+    const std::vector<int> chunks      = {2, 1, 3};
+
+    void run() const
+    {
+        auto&& handle     = get_handle();
+        const int seq_len = std::accumulate(chunks.begin(), chunks.end(), 0);
+        const int max_len = *std::max_element(chunks.begin(), chunks.end());
+
+        miopen::RNNDescriptor rnn_desc(static_cast<int>(hy_h),
+                                       static_cast<int>(layers),
+                                       mode,
+                                       miopenRNNlinear,
+                                       miopenRNNunidirection,
+                                       miopenRNNwithBias,
+                                       miopenRNNdefault,
+                                       miopenFloat);
+
+        auto x_desc = miopen::TensorDescriptor(miopenFloat, {batch, in_h});
+        auto y_desc = miopen::TensorDescriptor(miopenFloat, {batch, hy_h});
+        const std::vector<miopenTensorDescriptor_t> x_desc_ptrs(seq_len, &x_desc);
+        const std::vector<miopenTensorDescriptor_t> y_desc_ptrs(seq_len, &y_desc);
+        auto h_desc = miopen::TensorDescriptor(miopenFloat, {layers, batch, hy_h});
+
+        std::size_t w_size = 0;
+        miopenGetRNNParamsSize(&handle, &rnn_desc, &x_desc, &w_size, miopenFloat);
+        auto w_desc = miopen::TensorDescriptor(miopenFloat, {w_size / sizeof(float)});
+
+        std::size_t ws_size = 0;
+        miopenGetRNNWorkspaceSize(&handle, &rnn_desc, seq_len, x_desc_ptrs.data(), &ws_size);
+
+        std::mt19937 gen(23);
+        std::uniform_real_distribution<float> dist(-0.5f, 0.5f);
+        const auto random = [&](std::size_t n) {
+            std::vector<float> v(n);
+            for(auto& e : v)
+                e = dist(gen);
+            return v;
+        };
+
+        const auto x    = random(seq_len * batch * in_h);
+        const auto y_sz = seq_len * batch * hy_h;
+        auto hx_dev     = handle.Write(random(h_desc.GetElementSize()));
+        auto cx_dev     = handle.Write(random(h_desc.GetElementSize()));
+        auto w_dev      = handle.Write(random(w_desc.GetElementSize()));
+        auto x_dev      = handle.Write(x);
+        auto y_dev      = handle.Create(y_sz * sizeof(float));
+        auto ws_dev     = handle.Create(ws_size);
+
+        EXPECT(miopenRNNForwardInference(&handle,
+                                         &rnn_desc,
+                                         seq_len,
+                                         x_desc_ptrs.data(),
+                                         x_dev.get(),
+                                         &h_desc,
+                                         set_state ? hx_dev.get() : nullptr,
+                                         &h_desc,
+                                         set_state ? cx_dev.get() : nullptr,
+                                         &w_desc,
+                                         w_dev.get(),
+                                         y_desc_ptrs.data(),
+                                         y_dev.get(),
+                                         &h_desc,
+                                         nullptr,
+                                         &h_desc,
+                                         nullptr,
+                                         ws_dev.get(),
+                                         ws_size) == miopenStatusSuccess);
+        const auto expected = handle.Read<float>(y_dev, y_sz);
+
+        miopenRNNStreamingState_t state = nullptr;
+        EXPECT(miopenCreateRNNStreamingState(
+                   &handle, &rnn_desc, &x_desc, &h_desc, max_len, &state) == miopenStatusSuccess);
+        if(set_state)
+            EXPECT(miopenResetRNNStreamingState(&handle, state, hx_dev.get(), cx_dev.get()) ==
+                   miopenStatusSuccess);
+
+        std::vector<float> actual(y_sz);
+        int step = 0;
+        for(auto len : chunks)
+        {
+            EXPECT(miopenRNNForwardInferenceStreaming(&handle,
+                                                      state,
+                                                      len,
+                                                      x_desc_ptrs.data(),
+                                                      x.data() + step * batch * in_h,
+                                                      &w_desc,
+                                                      w_dev.get(),
+                                                      y_desc_ptrs.data(),
+                                                      actual.data() + step * batch * hy_h,
+                                                      ws_dev.get(),
+                                                      ws_size) == miopenStatusSuccess);
+            step += len;
+        }
+        EXPECT(miopenSynchronizeRNNStreamingState(state) == miopenStatusSuccess);
+        miopenDestroyRNNStreamingState(state);
+
+        EXPECT(miopen::range_distance(expected) == miopen::range_distance(actual));
+        EXPECT(miopen::rms_range(expected, actual) < 1e-5);
+    }
+};
+
+int main()
+{
+    for(auto mode : {miopenRNNRELU, miopenRNNTANH, miopenLSTM, miopenGRU})
+        for(std::size_t layers : {1, 3})
+            for(bool set_state : {false, true})
+                rnn_streaming_test{mode, layers, set_state}.run();
+}
@@ -0,0 +1,130 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include <miopen/search_shard.hpp>
+#include <miopen/tmp_dir.hpp>
+
+#include <boost/optional.hpp>
+
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+using solver::SearchShard;
+
+struct SearchShardTest
+{
+    void Run() const
+    {
+        Partition();
+        Invalid();
+        Merge();
+        MergeFailed();
+    }
+
+    private:
+    static void Partition()
+    {
+        EXPECT(!SearchShard{}.IsEnabled());
+        EXPECT(!SearchShard::FromEnv().IsEnabled());
+        EXPECT(SearchShard(2, 3).IsEnabled());
+
+        // Each config is measured by exactly one shard.
+        for(std::size_t n = 0; n < 12; ++n)
+        {
+            auto owners = 0;
+            for(std::size_t i = 0; i < 3; ++i)
+                owners += SearchShard(i, 3).Owns(n) ? 1 : 0;
+            EXPECT(owners == 1);
+            EXPECT(SearchShard(n % 3, 3).Owns(n));
+        }
+    }
+
+    static void Invalid()
+    {
+        EXPECT(throws([] { SearchShard(3, 3); }));
+        EXPECT(throws([] { SearchShard(0, 0); }));
+    }
+
+    /// Runs the shards in threads, as separate processes would, and returns what each merged.
+    static std::vector<boost::optional<std::string>>
+    RunShards(const std::string& problem, const std::vector<boost::optional<std::string>>& bests)
+    {
+        const auto count = bests.size();
+        auto merged      = std::vector<boost::optional<std::string>>(count);
+        std::vector<std::thread> threads;
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            threads.emplace_back([&, i]() {
+                const auto shard = SearchShard(i, count);
+                shard.Reset(problem, "solver");
+                // The times are distinct, the best one is the shard 1.
+                const auto time = i == 1 ? 1.0f : 2.0f + static_cast<float>(i);
+                merged[i]       = shard.Merge(problem, "solver", bests[i], time);
+            });
+        }
+        for(auto& thread : threads)
+            thread.join();
+        return merged;
+    }
+
+    static void Merge()
+    {
+        const auto merged = RunShards(
+            "problem_a", {std::string{"cfg0"}, std::string{"cfg1"}, std::string{"cfg2"}});
+        for(const auto& best : merged)
+            EXPECT(best && *best == "cfg1");
+    }
+
+    static void MergeFailed()
+    {
+        // The failed shard gets the best result of the others as well.
+        const auto merged =
+            RunShards("problem_b", {std::string{"cfg0"}, boost::none, std::string{"cfg2"}});
+        for(const auto& best : merged)
+            EXPECT(best && *best == "cfg0");
+
+        const auto none = RunShards("problem_c", {boost::none, boost::none});
+        for(const auto& best : none)
+            EXPECT(!best);
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main()
+{
+    // The shards exchange their results through the user db directory.
+    const miopen::TmpDir user_db{"search_shard"};
+    setenv("MIOPEN_USER_DB_PATH", user_db.path.string().c_str(), 1);
+    setenv("MIOPEN_SEARCH_SHARD_TIMEOUT", "60", 1);
+    miopen::tests::SearchShardTest().Run();
+}
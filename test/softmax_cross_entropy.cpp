@@ -0,0 +1,138 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "driver.hpp"
+#include "get_handle.hpp"
+#include "tensor_holder.hpp"
+#include "test.hpp"
+
+#include <miopen/miopen.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+struct logit_gen
+{
+    template <class... Ts>
+    double operator()(Ts... Xs) const
+    {
+        return (tensor_elem_gen_integer{17}(Xs...) - 8.0) / 2.0;
+    }
+};
+
+void chk_softmax_cross_entropy(std::size_t n, std::size_t c, std::size_t h, std::size_t w)
+{
+    auto&& handle = get_handle();
+
+    auto x    = tensor<float>{n, c, h, w}.generate(logit_gen{});
+    auto loss = tensor<float>{n, 1, h, w};
+    auto dx   = tensor<float>{n, c, h, w};
+
+    // Every few samples is ignored with a label out of [0, c).
+    const auto spatial = h * w;
+    auto labels        = std::vector<int>(n * spatial);
+    for(std::size_t i = 0; i < labels.size(); ++i)
+        labels[i] = i % 5 == 4 ? (i % 2 == 0 ? -1 : static_cast<int>(c)) : (i * 7) % c;
+
+    auto ref_loss = loss;
+    auto ref_dx   = dx;
+    for(std::size_t in = 0; in < n; ++in)
+    {
+        for(std::size_t s = 0; s < spatial; ++s)
+        {
+            const auto label = labels[in * spatial + s];
+            const auto at    = [&](std::size_t ic) { return (in * c + ic) * spatial + s; };
+            if(label < 0 || label >= static_cast<int>(c))
+            {
+                ref_loss[in * spatial + s] = 0;
+                for(std::size_t ic = 0; ic < c; ++ic)
+                    ref_dx[at(ic)] = 0;
+                continue;
+            }
+
+            auto max = double(x[at(0)]);
+            for(std::size_t ic = 1; ic < c; ++ic)
+                max = std::max(max, double(x[at(ic)]));
+            auto sum = 0.;
+            for(std::size_t ic = 0; ic < c; ++ic)
+                sum += std::exp(x[at(ic)] - max);
+            ref_loss[in * spatial + s] = max + std::log(sum) - x[at(label)];
+            for(std::size_t ic = 0; ic < c; ++ic)
+                ref_dx[at(ic)] =
+                    std::exp(x[at(ic)] - max) / sum - (static_cast<int>(ic) == label ? 1. : 0.);
+        }
+    }
+
+    auto x_dev      = handle.Write(x.data);
+    auto labels_dev = handle.Write(labels);
+    auto loss_dev   = handle.Write(loss.data);
+    auto dx_dev     = handle.Write(dx.data);
+    STATUS(miopenSoftmaxCrossEntropy(&handle,
+                                     &x.desc,
+                                     x_dev.get(),
+                                     labels_dev.get(),
+                                     &loss.desc,
+                                     loss_dev.get(),
+                                     &dx.desc,
+                                     dx_dev.get()));
+    loss.data = handle.Read<float>(loss_dev, loss.data.size());
+    dx.data   = handle.Read<float>(dx_dev, dx.data.size());
+
+    const double loss_error = miopen::rms_range(ref_loss.data, loss.data);
+    const double dx_error   = miopen::rms_range(ref_dx.data, dx.data);
+    if(!(loss_error < 1e-5) || !(dx_error < 1e-5))
+        std::cout << "Softmax cross-entropy " << n << "x" << c << "x" << h << "x" << w
+                  << " loss rms error: " << loss_error << " dx rms error: " << dx_error
+                  << std::endl;
+    EXPECT(loss_error < 1e-5);
+    EXPECT(dx_error < 1e-5);
+
+    // Without dx only the loss is computed.
+    auto loss_only_dev = handle.Write(std::vector<float>(loss.data.size()));
+    STATUS(miopenSoftmaxCrossEntropy(&handle,
+                                     &x.desc,
+                                     x_dev.get(),
+                                     labels_dev.get(),
+                                     &loss.desc,
+                                     loss_only_dev.get(),
+                                     nullptr,
+                                     nullptr));
+    const auto loss_only = handle.Read<float>(loss_only_dev, loss.data.size());
+    EXPECT(miopen::rms_range(ref_loss.data, loss_only) < 1e-5);
+}
+
+int main()
+{
+    /*
+     * The loss and the gradient must match log-softmax and the negative log-likelihood
+     * computed on the host, with some samples ignored, for a class count below and above one
+     * workgroup and with spatial dimensions.
+     */
+    chk_softmax_cross_entropy(8, 10, 1, 1);
+    chk_softmax_cross_entropy(4, 1000, 1, 1);
+    chk_softmax_cross_entropy(2, 21, 5, 7);
+}
@@ -28,6 +28,7 @@
 #include <miopen/db.hpp>
 #include <miopen/find_solution.hpp>
 #include <miopen/invoke_params.hpp>
+#include <miopen/legacy_exhaustive_search.hpp>
 #include <miopen/mlo_internal.hpp>
 #include <miopen/solver.hpp>
 #include <miopen/temp_file.hpp>
@@ -166,9 +167,32 @@ class SolverTest
 
         // Checking no more searches were done.
         EXPECT_EQUAL(searches, searchable_solver.searches_done());
+
+        LegacyConfigTest();
     }
 
     private:
+    static void LegacyConfigTest()
+    {
+        solver::LegacyPerformanceConfig config;
+        config.lds_double_buffer = 1;
+
+        // Records of the current layout round trip.
+        std::ostringstream ss;
+        config.Serialize(ss);
+        solver::LegacyPerformanceConfig read;
+        EXPECT(read.Deserialize(ss.str()));
+        EXPECT_EQUAL(read.lds_double_buffer, 1);
+
+        // Records written before double buffering still load, with a single buffer.
+        EXPECT(read.Deserialize("16,16,32,32,2,2,8,2,1"));
+        EXPECT_EQUAL(read.in_tile0, 32);
+        EXPECT_EQUAL(read.n_stacks, 1);
+        EXPECT_EQUAL(read.lds_double_buffer, 0);
+
+        EXPECT(!read.Deserialize("16,16,32,32,2,2,8,2"));
+    }
+
     static void ConstructTest(const std::string& db_path,
                               const char* expected_kernel,
                               const std::initializer_list<size_t>& in,
@@ -0,0 +1,169 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/any_solver.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/solver.hpp>
+#include <miopen/solver_applicability.hpp>
+#include <miopen/tensor.hpp>
+
+#include <algorithm>
+
+#include "get_handle.hpp"
+#include "test.hpp"
+
+namespace miopen {
+namespace tests {
+
+struct CountingTestSolver : solver::SolverBase<ConvolutionContext>
+{
+    static int& Calls()
+    {
+        static int calls = 0;
+        return calls;
+    }
+
+    bool IsApplicable(const ConvolutionContext& ctx) const
+    {
+        ++Calls();
+        return ctx.Is2d() && ctx.direction.IsForward();
+    }
+
+    solver::applicability::Traits GetApplicabilityTraits() const
+    {
+        using namespace solver::applicability;
+        return Traits{}.Directions(Fwd).SpatialDims(Dims2);
+    }
+};
+
+struct SolverApplicabilityTest
+{
+    void Run() const
+    {
+        solver::applicability::ClearMemo();
+        CheckMemo();
+
+        const auto x    = TensorDescriptor{miopenFloat, {2, 16, 14, 14}};
+        const auto w    = TensorDescriptor{miopenFloat, {32, 16, 3, 3}};
+        const auto y    = TensorDescriptor{miopenFloat, {2, 32, 14, 14}};
+        const auto x_h  = TensorDescriptor{miopenHalf, {2, 16, 14, 14}};
+        const auto w_h  = TensorDescriptor{miopenHalf, {32, 16, 3, 3}};
+        const auto y_h  = TensorDescriptor{miopenHalf, {2, 32, 14, 14}};
+        const auto w_g  = TensorDescriptor{miopenFloat, {32, 8, 3, 3}};
+        const auto x3   = TensorDescriptor{miopenFloat, {2, 16, 6, 14, 14}};
+        const auto w3   = TensorDescriptor{miopenFloat, {32, 16, 3, 3, 3}};
+        const auto y3   = TensorDescriptor{miopenFloat, {2, 32, 6, 14, 14}};
+        const auto conv    = ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}};
+        const auto grouped = ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}, {0, 0}, 2};
+        const auto conv3 =
+            ConvolutionDescriptor{3, miopenConvolution, miopenPaddingDefault, {1, 1, 1}};
+
+        for(const auto direction : {conv::Direction::Forward,
+                                    conv::Direction::BackwardData,
+                                    conv::Direction::BackwardWeights})
+        {
+            CheckTraits(x, w, y, conv, direction);
+            CheckTraits(x_h, w_h, y_h, conv, direction);
+            CheckTraits(x, w_g, y, grouped, direction);
+            CheckTraits(x3, w3, y3, conv3, direction);
+        }
+    }
+
+    private:
+    static void CheckMemo()
+    {
+        const auto x = TensorDescriptor{miopenFloat, {1, 8, 8, 8}};
+        const auto w = TensorDescriptor{miopenFloat, {8, 8, 1, 1}};
+        const auto c = ConvolutionDescriptor{{0, 0}, {1, 1}, {1, 1}};
+
+        auto ctx = ConvolutionContext{x, w, x, c, conv::Direction::Forward};
+        ctx.SetStream(&get_handle());
+        ctx.DetectRocm();
+
+        const auto solver = CountingTestSolver{};
+        EXPECT(solver::applicability::Memo{ctx}.IsApplicable(solver, ctx));
+        EXPECT(solver::applicability::Memo{ctx}.IsApplicable(solver, ctx));
+        EXPECT(CountingTestSolver::Calls() == 1);
+
+        // A problem that differs only in the tensor strides is checked again.
+        const auto x_strided = TensorDescriptor{miopenFloat, {1, 8, 8, 8}, {1024, 128, 16, 1}};
+        auto strided         = ConvolutionContext{x_strided, w, x, c, conv::Direction::Forward};
+        strided.SetStream(&get_handle());
+        strided.DetectRocm();
+        EXPECT(solver::applicability::Memo{strided}.IsApplicable(solver, strided));
+        EXPECT(CountingTestSolver::Calls() == 2);
+
+        // The traits exclude the backward problems without asking the solver.
+        auto bwd = ConvolutionContext{x, w, x, c, conv::Direction::BackwardData};
+        bwd.SetStream(&get_handle());
+        bwd.DetectRocm();
+        EXPECT(!solver::applicability::Memo{bwd}.IsApplicable(solver, bwd));
+        EXPECT(CountingTestSolver::Calls() == 2);
+
+        solver::applicability::ClearMemo();
+        EXPECT(solver::applicability::Memo{ctx}.IsApplicable(solver, ctx));
+        EXPECT(CountingTestSolver::Calls() == 3);
+    }
+
+    static void CheckTraits(const TensorDescriptor& x,
+                            const TensorDescriptor& w,
+                            const TensorDescriptor& y,
+                            const ConvolutionDescriptor& conv,
+                            conv::Direction direction)
+    {
+        const auto is_fwd = direction == conv::Direction::Forward;
+
+        auto ctx = ConvolutionContext{is_fwd ? x : y, w, is_fwd ? y : x, conv, direction};
+        ctx.SetStream(&get_handle());
+        ctx.DetectRocm();
+
+        const auto key        = solver::applicability::Key::From(ctx);
+        const auto& candidate = solver::applicability::GetCandidateIds(key);
+        const auto memo       = solver::applicability::Memo{ctx};
+
+        for(const auto& id : solver::GetAllIds())
+        {
+            const auto solver = id.GetSolver();
+            if(solver.IsEmpty())
+                continue;
+            const auto applicable = solver.IsApplicable(ctx);
+            // The traits are necessary conditions of the applicability.
+            if(!solver.GetApplicabilityTraits().Admits(key))
+            {
+                if(applicable)
+                    std::cerr << id.ToString() << " is excluded by its traits" << std::endl;
+                EXPECT(!applicable);
+                EXPECT(std::find(candidate.begin(), candidate.end(), id) == candidate.end());
+            }
+            EXPECT(memo.IsApplicable(solver, ctx) == applicable);
+        }
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::SolverApplicabilityTest().Run(); }
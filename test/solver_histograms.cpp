@@ -0,0 +1,108 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/miopen.h>
+#include <miopen/convolution.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/tensor.hpp>
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+#include "get_handle.hpp"
+#include "test.hpp"
+
+// The runs of a profiled handle shall all be recorded in the histogram of their solver.
+struct solver_histograms_test
+{
+    void run() const
+    {
+        auto&& handle = get_handle();
+
+        auto x_desc    = miopen::TensorDescriptor{miopenFloat, {2, 8, 14, 14}};
+        auto w_desc    = miopen::TensorDescriptor{miopenFloat, {16, 8, 3, 3}};
+        auto y_desc    = miopen::TensorDescriptor{miopenFloat, {2, 16, 14, 14}};
+        auto conv_desc = miopen::ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}};
+
+        auto x_dev = handle.Write(std::vector<float>(x_desc.GetElementSize(), 1.0f));
+        auto w_dev = handle.Write(std::vector<float>(w_desc.GetElementSize(), 1.0f));
+        auto y_dev = handle.Create<float>(y_desc.GetElementSize());
+
+        std::size_t count = 0;
+        miopenConvSolution_t solution;
+        EXPECT(miopenConvolutionForwardGetSolution(
+                   &handle, &w_desc, &x_desc, &conv_desc, &y_desc, 1, &count, &solution) ==
+               miopenStatusSuccess);
+        EXPECT(count == 1);
+        auto ws_dev = handle.Create(std::max<std::size_t>(solution.workspace_size, 1));
+
+        EXPECT(miopenResetSolverHistograms() == miopenStatusSuccess);
+        EXPECT(miopenGetSolverHistogramCount(&count) == miopenStatusSuccess);
+        EXPECT(count == 0);
+
+        const auto runs = std::size_t{3};
+        handle.EnableProfiling(true);
+        for(std::size_t i = 0; i < runs; i++)
+            EXPECT(miopenConvolutionForwardImmediate(&handle,
+                                                     &w_desc,
+                                                     w_dev.get(),
+                                                     &x_desc,
+                                                     x_dev.get(),
+                                                     &conv_desc,
+                                                     &y_desc,
+                                                     y_dev.get(),
+                                                     ws_dev.get(),
+                                                     solution.workspace_size,
+                                                     solution.solution_id) == miopenStatusSuccess);
+        handle.EnableProfiling(false);
+
+        EXPECT(miopenGetSolverHistogramCount(&count) == miopenStatusSuccess);
+        EXPECT(count == 1);
+
+        auto histograms = std::vector<miopenSolverHistogram_t>(2);
+        EXPECT(miopenGetSolverHistograms(histograms.size(), &count, histograms.data()) ==
+               miopenStatusSuccess);
+        EXPECT(count == 1);
+
+        const auto& histogram = histograms.front();
+        EXPECT(histogram.solverId == solution.solution_id);
+        EXPECT(histogram.direction == miopenConvDirectionForward);
+        EXPECT(histogram.dataType == miopenFloat);
+        EXPECT(histogram.count == runs);
+        EXPECT(histogram.minTimeMs <= histogram.maxTimeMs);
+        EXPECT(histogram.totalTimeMs >= histogram.minTimeMs * runs * 0.999f);
+        EXPECT(histogram.totalTimeMs <= histogram.maxTimeMs * runs * 1.001f);
+        EXPECT(std::accumulate(std::begin(histogram.buckets),
+                               std::end(histogram.buckets),
+                               std::size_t{0}) == runs);
+
+        EXPECT(miopenResetSolverHistograms() == miopenStatusSuccess);
+        EXPECT(miopenGetSolverHistogramCount(&count) == miopenStatusSuccess);
+        EXPECT(count == 0);
+    }
+};
+
+int main() { solver_histograms_test{}.run(); }
@@ -151,6 +151,10 @@ struct ProblemData : SQLiteSerializable<ProblemData>
     {
         ProblemDescription::Visit(self.prob, f);
     }
+    static const std::vector<std::string>& NearestFieldNames()
+    {
+        return ProblemDescription::NearestFieldNames();
+    }
 };
 
 struct SolverData
@@ -495,6 +499,213 @@ class DbParallelTest : public DbTest
     }
 };
 
+class DbWriteBehindTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing write-behind updates..." << std::endl;
+
+        SQLitePerfDb db(std::string(temp_file), false, "gfx906", 64);
+        SQLitePerfDb other(std::string(temp_file), false, "gfx906", 64);
+        db.sql.Exec("CREATE TABLE IF NOT EXISTS write_behind (value INTEGER);");
+
+        // The writes use the connection only: an update of the db itself would enter
+        // the write-behind again while it is held.
+        const auto write = [&](int value, std::chrono::milliseconds interval) {
+            db.sql.WriteBehind(
+                [&]() {
+                    db.sql.Exec("INSERT INTO write_behind VALUES (" + std::to_string(value) +
+                                ");");
+                },
+                interval);
+        };
+        const auto count = [](const SQLitePerfDb& from) {
+            return from.sql.Exec("SELECT count(*) AS n FROM write_behind;").front().at("n");
+        };
+
+        write(0, std::chrono::hours{1});
+        write(1, std::chrono::hours{1});
+
+        // Pending writes are visible through the same connection only, unless the background
+        // commit of MIOPEN_DEBUG_PERFDB_WRITE_BEHIND_MS came first.
+        EXPECT_EQUAL(count(db), "2");
+        if(SQLitePerfDb::WriteBehindInterval().count() == 0)
+            EXPECT_EQUAL(count(other), "0");
+
+        db.sql.Flush();
+        EXPECT_EQUAL(count(other), "2");
+
+        // An expired transaction is committed by the next write.
+        write(2, std::chrono::hours{1});
+        std::this_thread::sleep_for(std::chrono::milliseconds{2});
+        write(3, std::chrono::milliseconds{1});
+        EXPECT_EQUAL(count(other), "4");
+
+        db.sql.Exec("DROP TABLE write_behind;");
+    }
+};
+
+class DbSharedReadTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing one db object shared by reading threads..." << std::endl;
+
+        ProblemData p;
+        SQLitePerfDb db(std::string(temp_file), false, "gfx906", 64);
+        EXPECT(db.Update(p, id0(), value0()));
+
+        const auto read_in_threads = [&](const std::string& id, const SolverData& expected) {
+            std::vector<std::thread> threads;
+            for(auto i = 0; i < 8; i++)
+            {
+                threads.emplace_back([&]() {
+                    for(auto j = 0; j < 16; j++)
+                    {
+                        SolverData read;
+                        EXPECT(db.Load(p, id, read));
+                        EXPECT_EQUAL(read, expected);
+                    }
+                });
+            }
+            for(auto& thread : threads)
+                thread.join();
+        };
+
+        read_in_threads(id0(), value0());
+
+        // Pending updates shall stay visible through the object while other connections
+        // serve its reads.
+        db.sql.WriteBehind([&]() { EXPECT(db.Update(p, id1(), value1())); },
+                           std::chrono::hours{1});
+        read_in_threads(id1(), value1());
+
+        db.sql.Flush();
+        read_in_threads(id1(), value1());
+    }
+};
+
+class DbNearestTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing nearest problem lookups..." << std::endl;
+
+        SQLitePerfDb db(std::string(temp_file), false, "gfx906", 64);
+        const auto any_valid = [](const SolverData&) { return true; };
+
+        ProblemData tuned(16);
+        ProblemData near_batch(16);
+        ProblemData other_stride(16);
+        near_batch.prob.batch_sz          = 64;
+        other_stride.prob.kernel_stride_h = 2;
+        EXPECT(db.Update(tuned, id0(), value0()));
+        EXPECT(db.Update(near_batch, id0(), value1()));
+        EXPECT(db.Update(other_stride, id0(), value2()));
+        EXPECT(db.Update(other_stride, id1(), value2()));
+
+        ProblemData untuned(16);
+        untuned.prob.batch_sz = 128;
+        SolverData read;
+
+        // The closest batch size wins, the problem with another stride is never used.
+        auto distance = db.LoadNearest(untuned, id0(), read, any_valid);
+        EXPECT(distance);
+        EXPECT_EQUAL(*distance, 1.0);
+        EXPECT_EQUAL(read, value1());
+
+        // An invalid config falls back to the next closest problem.
+        distance = db.LoadNearest(
+            untuned, id0(), read, [](const SolverData& v) { return !(v == value1()); });
+        EXPECT(distance);
+        EXPECT_EQUAL(*distance, 3.0);
+        EXPECT_EQUAL(read, value0());
+
+        EXPECT(!db.LoadNearest(untuned, id1(), read, any_valid));
+        EXPECT(!db.LoadNearest(untuned, missing_id(), read, any_valid));
+    }
+};
+
+class DbHashTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing problem hashes..." << std::endl;
+        Collisions();
+        Migration();
+    }
+
+    private:
+    void Collisions() const
+    {
+        SQLitePerfDb db(std::string(temp_file), false, "gfx906", 64);
+        ClearDb(db);
+        ProblemData other(1);
+        EXPECT(db.Update(key(), id0(), value0()));
+        EXPECT(db.Update(other, id1(), value1()));
+
+        // Both rows get the hash of the other problem, the full row still tells them apart.
+        db.sql.Exec("UPDATE config SET hash = " + std::to_string(other.Hash()) + ";");
+        SolverData read;
+        const auto record = db.FindRecord(other);
+        EXPECT(record);
+        EXPECT(!record->GetValues(id0(), read));
+        EXPECT(record->GetValues(id1(), read));
+        EXPECT_EQUAL(read, value1());
+
+        // With no unique index, the rows are not duplicated by the updates of their problems.
+        EXPECT(db.Update(other, id0(), value0()));
+        EXPECT_EQUAL(db.sql.Exec("SELECT id FROM config;").size(), 2);
+    }
+
+    void Migration() const
+    {
+        TempFile legacy_file("miopen.tests.perfdb.legacy");
+        const auto path = std::string(legacy_file);
+        {
+            // The tables of the schema 1.0.0, without the hash column.
+            SQLite legacy{path, false};
+            legacy.Exec("CREATE TABLE `config` (`id` INTEGER PRIMARY KEY ASC, " +
+                        JoinStrings(key().FieldNames(), ", ") + ");" +
+                        "CREATE UNIQUE INDEX `idx_config` ON config(" +
+                        JoinStrings(key().FieldNames(), ", ") + ");"
+                        "CREATE TABLE `perf_db` (`id` INTEGER PRIMARY KEY ASC, `solver` TEXT, "
+                        "`config` INTEGER, `arch` TEXT, `num_cu` INTEGER, `params` TEXT);");
+            std::string query;
+            std::vector<std::string> values;
+            std::tie(query, values) = key().InsertQuery();
+            auto stmt = SQLite::Statement{legacy, query, values};
+            EXPECT(stmt.Step(legacy) == SQLITE_DONE);
+            std::ostringstream params;
+            value0().Serialize(params);
+            legacy.Exec("INSERT INTO perf_db(config, solver, params, arch, num_cu) "
+                        "VALUES(1, '" + id0() + "', '" + params.str() + "', 'gfx906', 64);");
+        }
+
+        SQLitePerfDb db(path, false, "gfx906", 64);
+        const auto hashes = db.sql.Exec("SELECT hash FROM config;");
+        EXPECT_EQUAL(hashes.size(), 1);
+        EXPECT_EQUAL(hashes.front().at("hash"), std::to_string(key().Hash()));
+
+        SolverData read;
+        EXPECT(db.Load(key(), id0(), read));
+        EXPECT_EQUAL(read, value0());
+        EXPECT(db.Update(key(), id1(), value1()));
+        EXPECT_EQUAL(db.sql.Exec("SELECT id FROM config;").size(), 1);
+
+        // The index of the hashes replaces the one over all the fields.
+        const auto indices =
+            db.sql.Exec("SELECT name FROM sqlite_master WHERE type = 'index' AND "
+                        "tbl_name = 'config';");
+        EXPECT_EQUAL(indices.size(), 1);
+        EXPECT_EQUAL(indices.front().at("name"), "idx_config_hash");
+    }
+};
+
 class DBMultiThreadedTestWork
 {
     public:
@@ -1248,6 +1459,10 @@ struct PerfDbDriver : test_driver
         DbFindTest().Run();
         DbOperationsTest().Run();
         DbParallelTest().Run();
+        DbWriteBehindTest().Run();
+        DbSharedReadTest().Run();
+        DbNearestTest().Run();
+        DbHashTest().Run();
         DbMultiThreadedTest().Run();
         DbMultiThreadedReadTest().Run();
         DbMultiProcessReadTest().Run();
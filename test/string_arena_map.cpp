@@ -0,0 +1,92 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "test.hpp"
+#include <miopen/string_arena_map.hpp>
+
+#include <string>
+
+namespace miopen {
+namespace tests {
+
+struct StringArenaMapTest
+{
+    void Run() const
+    {
+        Basic();
+        Growth();
+    }
+
+    private:
+    static void Basic()
+    {
+        StringArenaMap map;
+        EXPECT(map.Empty());
+        EXPECT(map.Find("a") == StringArenaMap::npos);
+
+        EXPECT(map.Emplace("a", "1"));
+        EXPECT(map.Emplace("", "empty key"));
+        EXPECT(map.Emplace("b", ""));
+        EXPECT(!map.Emplace("a", "2"));
+        EXPECT(map.Size() == 3);
+
+        const auto a = map.Find("a");
+        EXPECT(a == 0);
+        EXPECT(map.GetKey(a) == "a");
+        EXPECT(map.GetValue(a) == "1");
+        EXPECT(map.GetValue(map.Find("")) == "empty key");
+        EXPECT(map.GetValue(map.Find("b")).empty());
+        EXPECT(map.Find("ab") == StringArenaMap::npos);
+
+        const auto line = std::string{"key=value"};
+        EXPECT(map.Emplace(line.data(), 3, line.data() + 4, line.size() - 4));
+        EXPECT(map.GetValue(map.Find("key")) == "value");
+    }
+
+    static void Growth()
+    {
+        const auto count = 10000;
+        StringArenaMap map;
+        map.Reserve(count / 2, 0);
+        for(auto i = 0; i < count; ++i)
+            EXPECT(map.Emplace("key" + std::to_string(i), std::to_string(i * 3)));
+        EXPECT(map.Size() == count);
+
+        // Indices are stable across rehashing and follow the insertion order.
+        for(auto i = 0; i < count; ++i)
+        {
+            const auto index = map.Find("key" + std::to_string(i));
+            EXPECT(index == static_cast<std::size_t>(i));
+            EXPECT(map.GetValue(index) == std::to_string(i * 3));
+        }
+        EXPECT(map.Find("key" + std::to_string(count)) == StringArenaMap::npos);
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::StringArenaMapTest().Run(); }
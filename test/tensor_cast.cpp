@@ -52,6 +52,10 @@ struct verify_tensor_cast
     int dstOffset;
     float alpha;
     float max_val;
+    // quantization with one scale per index of dimension 0
+    bool quantize = false;
+    miopen::CastTensorQuantization quant;
+    std::vector<float> ch_scales;
 
     verify_tensor_cast(const tensor<int>& psrc_super,
                        const tensor<T>& pdst_super,
@@ -59,7 +63,8 @@ struct verify_tensor_cast
                        const miopen::TensorDescriptor& pdd,
                        std::vector<int> offsets,
                        const float palpha,
-                       const float pmax_val)
+                       const float pmax_val,
+                       const bool pquantize = false)
     {
         srcDesc   = psd;
         dstDesc   = pdd;
@@ -69,12 +74,35 @@ struct verify_tensor_cast
         dstOffset = offsets[1];
         alpha     = palpha;
         max_val   = pmax_val;
+        quantize  = pquantize;
+
+        if(quantize)
+        {
+            quant.srcZeroPoint = 3;
+            quant.dstZeroPoint = -5;
+            quant.saturate     = true;
+            quant.channelDim   = 0;
+            for(std::size_t c = 0; c < srcDesc.GetLengths()[0]; c++)
+                ch_scales.push_back(0.25f * (c % 7 + 1));
+        }
+    }
+
+    // saturated and, for integer types, rounded to nearest even
+    T quantize_value(float v) const
+    {
+        if(miopen_type<T>{} == miopenBFloat16)
+            return T(v);
+        if(miopen_type<T>{} == miopenInt8 || miopen_type<T>{} == miopenInt32)
+            v = std::nearbyint(v);
+        float min_val = miopen_type<T>{} == miopenInt8 ? -128.0f : -max_val;
+        return T(std::min(std::max(v, min_val), max_val));
     }
 
     void tensor_cast_for_loop(tensor<T>& dstSuperCpu,
                               int src_offset_index,
                               int dst_offset_index,
-                              int dim) const
+                              int dim,
+                              int ch = 0) const
     {
         auto src_stride = srcDesc.GetStrides()[dim];
         auto dst_stride = dstDesc.GetStrides()[dim];
@@ -88,11 +116,20 @@ struct verify_tensor_cast
 
             if(dim < (srcDesc.GetLengths().size() - 1))
             {
-                tensor_cast_for_loop(dstSuperCpu, src_super_index, dst_super_index, dim + 1);
+                tensor_cast_for_loop(
+                    dstSuperCpu, src_super_index, dst_super_index, dim + 1, dim == 0 ? idx : ch);
             }
             if(dst_super_index < dstSuperCpu.desc.GetElementSpace() &&
                src_super_index < srcSuper.desc.GetElementSpace())
             {
+                if(quantize)
+                {
+                    float v = alpha * ch_scales[dim == 0 ? idx : ch] *
+                                  (float(srcSuper[src_super_index]) - quant.srcZeroPoint) +
+                              quant.dstZeroPoint;
+                    dstSuperCpu[dst_super_index] = quantize_value(v);
+                    continue;
+                }
                 float temp_val               = float(srcSuper[src_super_index]) * alpha;
                 dstSuperCpu[dst_super_index] = T(temp_val >= max_val ? max_val : temp_val);
             }
@@ -116,14 +153,32 @@ struct verify_tensor_cast
         auto dstSuper_dev = handle.Write(dstSuperGpu.data);
         auto srcSuper_dev = handle.Write(srcSuper.data);
 
-        miopen::CastTensor(handle,
-                           &alpha,
-                           srcDesc,
-                           srcSuper_dev.get(),
-                           dstDesc,
-                           dstSuper_dev.get(),
-                           srcOffset,
-                           dstOffset);
+        if(quantize)
+        {
+            auto scales_dev = handle.Write(ch_scales);
+            auto q          = quant;
+            q.channelScales = scales_dev.get();
+            miopen::CastTensor(handle,
+                               &alpha,
+                               q,
+                               srcDesc,
+                               srcSuper_dev.get(),
+                               dstDesc,
+                               dstSuper_dev.get(),
+                               srcOffset,
+                               dstOffset);
+        }
+        else
+        {
+            miopen::CastTensor(handle,
+                               &alpha,
+                               srcDesc,
+                               srcSuper_dev.get(),
+                               dstDesc,
+                               dstSuper_dev.get(),
+                               srcOffset,
+                               dstOffset);
+        }
 
         dstSuperGpu.data = handle.Read<T>(dstSuper_dev, dstSuperGpu.data.size());
 
@@ -154,6 +209,7 @@ struct tensor_cast_driver : test_driver
     miopen::TensorDescriptor dstDesc;
     std::vector<int> castLens;
     std::vector<int> offsets;
+    bool quantize = false;
 
     tensor_cast_driver()
     {
@@ -166,6 +222,7 @@ struct tensor_cast_driver : test_driver
         add(castLens, "castLens", generate_data(get_sub_tensor(), {32, 8, 10}));
         add(offsets, "offsets", generate_data(get_tensor_offsets(), {7, 11}));
         add(alpha, "alpha", generate_data({1.0 / 127 / 127, 1.0 / 127, 127.0, 1.0}));
+        add(quantize, "quantize", generate_data({false, true}));
     }
 
     void run()
@@ -199,7 +256,7 @@ struct tensor_cast_driver : test_driver
         if(srcDesc.GetLengths().size() == dstDesc.GetLengths().size())
         {
             verify_equals(verify_tensor_cast<T>{
-                srcSuper, dstSuper, srcDesc, dstDesc, offsets, alpha, max_val});
+                srcSuper, dstSuper, srcDesc, dstDesc, offsets, alpha, max_val, quantize});
         }
     }
 };
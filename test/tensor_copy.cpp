@@ -139,6 +139,7 @@ struct tensor_copy_driver : test_driver
     miopen::TensorDescriptor dstDesc;
     std::vector<int> copyLens;
     std::vector<int> offsets;
+    bool channels_last = false;
 
     tensor_copy_driver()
     {
@@ -150,6 +151,7 @@ struct tensor_copy_driver : test_driver
         add(dstSuperLens, "dstSuperLens", generate_data({dst_lens}, dst_lens));
         add(copyLens, "copyLens", generate_data(get_sub_tensor(), {32, 8, 10}));
         add(offsets, "offsets", generate_data(get_tensor_offsets(), {7, 11}));
+        add(channels_last, "channels-last", generate_data({false, true}));
     }
 
     void run()
@@ -169,6 +171,21 @@ struct tensor_copy_driver : test_driver
                                                (dstSuper.desc.GetSize() - copyLens.size()),
                                            dstSuperStrides.end());
 
+        // packed destination with dimension 1 innermost, e.g. NCHW -> NHWC
+        if(channels_last && copyLens.size() > 1)
+        {
+            int stride           = 1;
+            dst_super_strides[1] = stride;
+            stride *= copyLens[1];
+            for(int i = copyLens.size() - 1; i >= 0; i--)
+            {
+                if(i == 1)
+                    continue;
+                dst_super_strides[i] = stride;
+                stride *= copyLens[i];
+            }
+        }
+
         srcDesc = miopen::TensorDescriptor(
             this->type, copyLens.data(), src_super_strides.data(), copyLens.size());
         dstDesc = miopen::TensorDescriptor(
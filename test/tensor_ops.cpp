@@ -251,12 +251,26 @@ struct tensor_ops_driver : test_driver
 
     std::vector<std::vector<int>> get_sub_tensor_a()
     {
-        return {{32, 16, 8, 4, 4}, {16, 20, 16, 8}, {20, 16, 8}, {1, 16, 8}, {16, 8}, {8}};
+        return {{2, 2, 16, 8, 4, 4, 4},
+                {2, 16, 8, 4, 4, 4},
+                {32, 16, 8, 4, 4},
+                {16, 20, 16, 8},
+                {20, 16, 8},
+                {1, 16, 8},
+                {16, 8},
+                {8}};
     }
 
     std::vector<std::vector<int>> get_sub_tensor_b()
     {
-        return {{32, 16, 8, 4, 4},
+        return {{2, 2, 16, 8, 4, 4, 4},
+                {2, 2, 16, 8, 1, 1, 1},
+                {1, 2, 1, 8, 4, 1, 1},
+                {1, 1, 1, 1, 1, 1, 4},
+                {2, 16, 8, 4, 4, 4},
+                {2, 1, 8, 4, 4, 4},
+                {1, 16, 1, 1, 1, 1},
+                {32, 16, 8, 4, 4},
                 {32, 16, 1, 1, 1},
                 {1, 16, 8, 1, 1},
                 {1, 1, 8, 4, 1},
@@ -284,9 +298,9 @@ struct tensor_ops_driver : test_driver
     tensor_ops_driver()
     {
         disabled_cache         = true;
-        std::vector<int> alens = {{32, 16, 20, 16, 8}};
-        std::vector<int> blens = {{32, 16, 20, 16, 8}};
-        std::vector<int> clens = {{32, 16, 20, 16, 8}};
+        std::vector<int> alens = {{2, 2, 32, 16, 20, 16, 8}};
+        std::vector<int> blens = {{2, 2, 32, 16, 20, 16, 8}};
+        std::vector<int> clens = {{2, 2, 32, 16, 20, 16, 8}};
 
         unsigned long max_value = miopen_type<T>{} == miopenHalf ? 5 : 17;
 
@@ -309,7 +323,8 @@ struct tensor_ops_driver : test_driver
         if(!isPacked)
         {
             std::vector<size_t> superStrides = super_tensor.desc.GetStrides();
-            std::vector<int> strides(superStrides.begin() + (5 - lens.size()), superStrides.end());
+            std::vector<int> strides(superStrides.begin() + (superStrides.size() - lens.size()),
+                                     superStrides.end());
             tensor<T> t = tensor<T>{lens, strides};
             t.data      = super_tensor.data;
             return t;
@@ -821,6 +821,32 @@ struct check_tensor_support : tensor_base
     }
 };
 
+void check_tensor_layout()
+{
+    using miopen::TensorDescriptor;
+
+    EXPECT(TensorDescriptor(miopenFloat, {2, 3, 4, 5}).GetLayout("NCHW") == "NCHW");
+    EXPECT(TensorDescriptor(miopenFloat, {2, 3, 4, 5}).IsDefaultLayout());
+
+    // NHWC strides for N=2, C=3, H=4, W=5.
+    const TensorDescriptor nhwc(miopenFloat, {2, 3, 4, 5}, {60, 1, 15, 3});
+    EXPECT(nhwc.GetLayout("NCHW") == "NHWC");
+    EXPECT(!nhwc.IsDefaultLayout());
+
+    // NDHWC strides for N=2, C=3, D=4, H=5, W=6.
+    const TensorDescriptor ndhwc(miopenFloat, {2, 3, 4, 5, 6}, {360, 1, 90, 18, 3});
+    EXPECT(ndhwc.GetLayout("NCDHW") == "NDHWC");
+
+    // Length 1 dimensions do not make a layout ambiguous.
+    EXPECT(TensorDescriptor(miopenFloat, {1, 3, 4, 5}, {60, 1, 15, 3}).GetLayout("NCHW") ==
+           "NHWC");
+    EXPECT(TensorDescriptor(miopenFloat, {2, 3, 1, 1}, {3, 1, 3, 3}).IsDefaultLayout());
+    EXPECT(TensorDescriptor(miopenFloat, {2, 1, 4, 5}, {20, 1, 5, 1}).IsDefaultLayout());
+
+    // Non-packed default layout is still default.
+    EXPECT(TensorDescriptor(miopenFloat, {2, 3, 4, 5}, {128, 32, 8, 1}).IsDefaultLayout());
+}
+
 void check_null_tensor()
 {
     EXPECT(miopenSet4dTensorDescriptor(nullptr, miopenFloat, 100, 32, 8, 8) != miopenStatusSuccess);
@@ -859,5 +885,6 @@ int main()
     tensor_test_suit_5d_bytes<tensor_fixture_n5d_numBytes>::run_tests();
 
     run_test<check_tensor_support>();
+    check_tensor_layout();
     check_null_tensor();
 }
@@ -0,0 +1,115 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "driver.hpp"
+#include "get_handle.hpp"
+#include "rms_check.hpp"
+#include "tensor_holder.hpp"
+#include "test.hpp"
+
+#include <miopen/topk.hpp>
+#include <miopen/miopen.h>
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+template <class T>
+void chk_topk(const std::vector<std::size_t>& lengths, int dim, int k, bool largest)
+{
+    auto&& handle = get_handle();
+
+    const auto split = lengths.begin() + dim;
+    const auto outer =
+        std::accumulate(lengths.begin(), split, std::size_t{1}, std::multiplies<std::size_t>{});
+    const auto len   = *split;
+    const auto inner = std::accumulate(
+        split + 1, lengths.end(), std::size_t{1}, std::multiplies<std::size_t>{});
+
+    auto out_lengths = lengths;
+    out_lengths[dim] = k;
+
+    // Few distinct values, so that the order of the ties is checked as well.
+    auto x       = tensor<T>{lengths}.generate(tensor_elem_gen_integer{97});
+    auto values  = tensor<T>{out_lengths};
+    auto indices = tensor<int>{out_lengths};
+
+    auto x_dev       = handle.Write(x.data);
+    auto values_dev  = handle.Write(values.data);
+    auto indices_dev = handle.Write(indices.data);
+
+    miopen::TopK(handle,
+                 x.desc,
+                 x_dev.get(),
+                 dim,
+                 k,
+                 largest,
+                 values.desc,
+                 values_dev.get(),
+                 indices.desc,
+                 indices_dev.get());
+    values.data  = handle.Read<T>(values_dev, values.data.size());
+    indices.data = handle.Read<int>(indices_dev, indices.data.size());
+
+    std::size_t errors = 0;
+    std::vector<int> order(len);
+    for(std::size_t o = 0; o < outer; ++o)
+    {
+        for(std::size_t i = 0; i < inner; ++i)
+        {
+            const auto at = [&](int j) { return double(x[(o * len + j) * inner + i]); };
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+                return largest ? at(a) > at(b) : at(a) < at(b);
+            });
+            for(int j = 0; j < k; ++j)
+            {
+                const auto out = (o * k + j) * inner + i;
+                if(indices[out] != order[j] || double(values[out]) != at(order[j]))
+                    ++errors;
+            }
+        }
+    }
+    expect_exact("TopK len " + std::to_string(len) + " inner " + std::to_string(inner) + " k " +
+                     std::to_string(k) + " largest " + std::to_string(largest),
+                 errors);
+}
+
+int main()
+{
+    /*
+     * The k best elements and their indices must match a stable sort on the host, for k below
+     * and above a chunk of the row, rows shorter and longer than one chunk, k equal to the row
+     * length, and a dimension which is not the innermost one.
+     */
+    chk_topk<float>({4, 1000}, 1, 5, true);
+    chk_topk<float>({4, 1000}, 1, 1, false);
+    chk_topk<float>({2, 5000}, 1, 1024, true);
+    chk_topk<float>({3, 700, 2}, 1, 100, false);
+    chk_topk<float>({7, 3, 5}, 0, 7, true);
+    chk_topk<half_float::half>({8, 2048}, 1, 40, true);
+}
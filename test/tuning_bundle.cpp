@@ -0,0 +1,124 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include <miopen/errors.hpp>
+#include <miopen/tuning_bundle.hpp>
+
+#include <sstream>
+#include <string>
+
+namespace miopen {
+namespace tests {
+
+struct TuningBundleTest
+{
+    void Run() const
+    {
+        TestRoundTrip();
+        TestInvalid();
+    }
+
+    private:
+    static TuningBundle MakeBundle()
+    {
+        auto bundle   = TuningBundle{};
+        bundle.device = "gfx906";
+        bundle.num_cu = 60;
+
+        auto problem        = TuningBundle::Problem{};
+        problem.key         = "3-32-32-3x3-16-32-32-8-1x1-1x1-1x1-0-NCHW-FP32-F";
+        problem.text_fields = {{"layout", "NCHW"}, {"data_type", "FP32"}, {"direction", "F"}};
+        problem.int_fields  = {{"in_channels", 3}, {"pad_h", -1}};
+        problem.find_db     = {{"miopenConvolutionFwdAlgoDirect",
+                            "ConvOclDirectFwd,0.5,0,miopenConvolutionFwdAlgoDirect,<unused>"}};
+        problem.perf_db     = {{"ConvOclDirectFwd", "1,16,16,4"}, {"Empty", ""}};
+        bundle.problems.push_back(problem);
+
+        // Code objects are binary: they have newlines, NULs and digits followed by spaces.
+        const auto blob = std::string("\x7f" "ELF\n\0\n12 34\n", 13);
+        bundle.code_objects.push_back({"MIOpenConvDirUni.cl", " -DMLO_HW_WAVE_SZ=64", false, blob});
+        bundle.code_objects.push_back({"gemm source", "", true, ""});
+        return bundle;
+    }
+
+    static void TestRoundTrip()
+    {
+        const auto bundle = MakeBundle();
+        std::stringstream stream;
+        bundle.Write(stream);
+        const auto read = TuningBundle::Read(stream);
+
+        EXPECT(read.device == bundle.device);
+        EXPECT(read.num_cu == bundle.num_cu);
+        EXPECT(read.problems.size() == 1);
+        const auto& problem = read.problems.front();
+        const auto& written = bundle.problems.front();
+        EXPECT(problem.key == written.key);
+        EXPECT(problem.text_fields == written.text_fields);
+        EXPECT(problem.int_fields == written.int_fields);
+        EXPECT(problem.find_db == written.find_db);
+        EXPECT(problem.perf_db == written.perf_db);
+        EXPECT(read.code_objects.size() == 2);
+        for(auto i = 0; i < 2; ++i)
+        {
+            EXPECT(read.code_objects[i].program_name == bundle.code_objects[i].program_name);
+            EXPECT(read.code_objects[i].params == bundle.code_objects[i].params);
+            EXPECT(read.code_objects[i].is_kernel_str == bundle.code_objects[i].is_kernel_str);
+            EXPECT(read.code_objects[i].blob == bundle.code_objects[i].blob);
+        }
+    }
+
+    static bool Rejects(const std::string& text)
+    {
+        std::istringstream stream{text};
+        try
+        {
+            TuningBundle::Read(stream);
+        }
+        catch(const Exception& ex)
+        {
+            return ex.status == miopenStatusBadParm;
+        }
+        return false;
+    }
+
+    static void TestInvalid()
+    {
+        std::ostringstream stream;
+        MakeBundle().Write(stream);
+        const auto text = stream.str();
+
+        EXPECT(Rejects(""));
+        EXPECT(Rejects("gfx906_60.HIP.fdb.txt"));
+        EXPECT(Rejects("MIOpenTuningBundle 2\n"));
+        EXPECT(Rejects(text.substr(0, text.size() - 8)));
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::TuningBundleTest{}.Run(); }
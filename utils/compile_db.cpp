@@ -0,0 +1,75 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Compiles text find-db / perf-db files into the memory-mappable binary form
+// which ReadonlyRamDb picks up instead of parsing the text at start-up.
+
+#include <miopen/binary_db.hpp>
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[])
+{
+    if(argc < 2 || argc > 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <db.txt> [<db.bin>]" << std::endl;
+        std::cerr << "If the output is omitted, the name is derived from the input, e.g. "
+                     "gfx906_60.HIP.fdb.txt -> gfx906_60.HIP.fdb.bin"
+                  << std::endl;
+        return 1;
+    }
+
+    const auto input_path = std::string{argv[1]};
+    const auto output_path =
+        argc > 2 ? std::string{argv[2]} : miopen::binary_db::GetPath(input_path);
+
+    std::ifstream input{input_path};
+    if(!input)
+    {
+        std::cerr << "Unable to open " << input_path << std::endl;
+        return 1;
+    }
+
+    std::ofstream output{output_path, std::ios::binary | std::ios::trunc};
+    if(!output)
+    {
+        std::cerr << "Unable to create " << output_path << std::endl;
+        return 1;
+    }
+
+    const auto records = miopen::binary_db::Compile(input, output, input_path);
+    output.close();
+    if(!output)
+    {
+        std::cerr << "Failed to write " << output_path << std::endl;
+        return 1;
+    }
+
+    std::cout << input_path << ": " << records << " records -> " << output_path << std::endl;
+    return 0;
+}
@@ -0,0 +1,44 @@
+#!/usr/bin/env bash
+# Turns the find-db miss logs of MIOPEN_FIND_MISS_LOG into a list of tuning jobs, e.g.
+#   find_miss_jobs.sh 20 /tmp/misses.*.txt > jobs.sh
+# The problems of all the logs are ranked by the number of their lookups and immediate calls
+# times the estimated time of the fallback solution, and the first <count> of them (0 for all)
+# are written as MIOpenDriver command lines tuning the problem, preceded by their score.
+# MIOPEN_DRIVER selects the driver binary.
+if [ $# -lt 2 ];
+then
+    echo "Usage: $0 <count> <miss log>..."
+    exit 1
+fi
+
+DRIVER=${MIOPEN_DRIVER:-$(dirname "$0")/MIOpenDriver}
+COUNT=$1
+shift
+
+# lookups calls estimated_ms solver find-db-key driver-args
+awk '
+    /^#/ { next }
+    {
+        key = $5
+        calls[key] += $1 + $2
+        if($3 > time[key])
+            time[key] = $3
+        args = $6
+        for(i = 7; i <= NF; ++i)
+            args = args " " $i
+        driver_args[key] = args
+    }
+    END {
+        for(key in calls)
+            printf "%.6f %s\n", calls[key] * time[key], driver_args[key]
+    }
+' "$@" | sort -g -r -k 1,1 | awk -v count="$COUNT" -v driver="$DRIVER" '
+    count > 0 && NR > count { exit }
+    {
+        score = $1
+        args = $2
+        for(i = 3; i <= NF; ++i)
+            args = args " " $i
+        printf "# %s ms\n%s %s -s 1 -V 0 -i 1\n", score, driver, args
+    }
+'
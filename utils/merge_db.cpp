@@ -0,0 +1,106 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Merges the user find-dbs or perf-dbs collected from several tuning nodes into one db which
+// may be installed as the system db, e.g.
+//   MIOpenMergeDb gfx906_60.HIP.fdb.txt node*/gfx906_60.HIP.*.ufdb.txt
+
+#include <miopen/db_merge.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[])
+{
+    auto disputes_path = std::string{};
+    auto paths         = std::vector<std::string>{};
+    for(auto i = 1; i < argc; ++i)
+    {
+        if(std::strcmp(argv[i], "--disputes") == 0 && i + 1 < argc)
+            disputes_path = argv[++i];
+        else
+            paths.emplace_back(argv[i]);
+    }
+
+    if(paths.size() < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " [--disputes <keys.txt>] <out.txt> <in.txt>..."
+                  << std::endl;
+        std::cerr << "Find-db conflicts keep the fastest entry, perf-db conflicts the entry of "
+                     "the first input. The kind of db is taken from the output name: *.fdb.txt "
+                     "is a find-db. Keys the inputs disagreed on are written to the disputes "
+                     "file, one per line, to be re-tuned."
+                  << std::endl;
+        return 1;
+    }
+
+    const auto& output_path = paths.front();
+    auto merger             = miopen::DbMerger{miopen::DbMerger::GetKind(output_path)};
+
+    for(auto i = std::size_t{1}; i < paths.size(); ++i)
+    {
+        std::ifstream input{paths[i]};
+        if(!input)
+        {
+            std::cerr << "Unable to open " << paths[i] << std::endl;
+            return 1;
+        }
+        std::cout << paths[i] << ": " << merger.Add(input, paths[i]) << " records" << std::endl;
+    }
+
+    std::ofstream output{output_path, std::ios::trunc};
+    if(!output)
+    {
+        std::cerr << "Unable to create " << output_path << std::endl;
+        return 1;
+    }
+    const auto records = merger.Write(output);
+    output.close();
+    if(!output)
+    {
+        std::cerr << "Failed to write " << output_path << std::endl;
+        return 1;
+    }
+
+    std::cout << output_path << ": " << records << " records, " << merger.GetConflictCount()
+              << " conflicts, " << merger.GetDisputedKeys().size() << " disputed" << std::endl;
+
+    if(!disputes_path.empty())
+    {
+        std::ofstream disputes{disputes_path, std::ios::trunc};
+        for(const auto& key : merger.GetDisputedKeys())
+            disputes << key << '\n';
+        if(!disputes)
+        {
+            std::cerr << "Failed to write " << disputes_path << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,279 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Builds the kernels of every solution recorded in a system find-db and stores them into
+// a kernel cache file (<arch>_<cu>.kdb). Installed into the system db directory, it lets
+// the library load code objects on demand instead of compiling them on the first run.
+// Must be run on a GPU matching the find-db.
+
+#include <miopen/binary_cache.hpp>
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/solver_id.hpp>
+#include <miopen/sqlite_db.hpp>
+#include <miopen/stringutils.hpp>
+#include <miopen/tensor.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/optional.hpp>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<std::string> Split(const std::string& s, char delim)
+{
+    std::vector<std::string> result;
+    std::istringstream ss(s);
+    std::string item;
+    while(std::getline(ss, item, delim))
+        result.push_back(item);
+    return result;
+}
+
+std::vector<int> SplitInts(const std::string& s)
+{
+    std::vector<int> result;
+    for(const auto& item : Split(s, 'x'))
+        result.push_back(std::stoi(item));
+    return result;
+}
+
+boost::optional<miopenDataType_t> ParseDataType(const std::string& s)
+{
+    // Mixed-type problems are encoded as a concatenation and are not supported here.
+    for(auto type : {miopenFloat, miopenHalf, miopenBFloat16, miopenInt8, miopenInt8x4})
+    {
+        if(miopen::GetDataTypeName(type) == s)
+            return type;
+    }
+    return boost::none;
+}
+
+/// Problem recorded in a find-db key, e.g. 128-28-28-3x3-128-28-28-128-1x1-1x1-1x1-0-NCHW-FP32-F
+/// For backward directions the "input" of the key is the output of the forward convolution.
+struct Problem
+{
+    miopen::TensorDescriptor x;
+    miopen::TensorDescriptor w;
+    miopen::TensorDescriptor y;
+    miopen::ConvolutionDescriptor conv;
+    char direction = 'F';
+
+    bool Parse(const std::string& key)
+    {
+        const auto parts  = Split(key, '_');
+        const auto fields = Split(parts[0], '-');
+        if(fields.size() != 15 && fields.size() != 17)
+            return false;
+        const auto spatial = fields.size() == 15 ? 2 : 3;
+
+        std::size_t i       = 0;
+        const auto get_dims = [&]() {
+            std::vector<int> dims;
+            for(auto d = 0; d < spatial; ++d)
+                dims.push_back(std::stoi(fields[i++]));
+            return dims;
+        };
+
+        const auto in_c     = std::stoi(fields[i++]);
+        const auto in_dims  = get_dims();
+        const auto filter   = SplitInts(fields[i++]);
+        const auto out_c    = std::stoi(fields[i++]);
+        const auto out_dims = get_dims();
+        const auto batch    = std::stoi(fields[i++]);
+        const auto pads     = SplitInts(fields[i++]);
+        const auto strides  = SplitInts(fields[i++]);
+        const auto dilation = SplitInts(fields[i++]);
+        ++i; // bias
+        const auto& layout = fields[i++];
+        const auto type    = ParseDataType(fields[i++]);
+        direction          = fields[i++].front();
+
+        auto groups = 1;
+        if(parts.size() > 1 && miopen::StartsWith(parts[1], "g"))
+            groups = std::stoi(parts[1].substr(1));
+
+        if(layout != "NCHW" && layout != "NCDHW")
+            return false;
+        if(!type)
+            return false;
+
+        const auto forward = direction == 'F';
+        const auto c       = forward ? in_c : out_c;
+        const auto k       = forward ? out_c : in_c;
+        const auto& x_dims = forward ? in_dims : out_dims;
+        const auto& y_dims = forward ? out_dims : in_dims;
+
+        const auto make_lens = [&](int n, int ch, const std::vector<int>& dims) {
+            std::vector<int> lens{n, ch};
+            lens.insert(lens.end(), dims.begin(), dims.end());
+            return lens;
+        };
+
+        x    = miopen::TensorDescriptor(*type, make_lens(batch, c, x_dims));
+        w    = miopen::TensorDescriptor(*type, make_lens(k, c / groups, filter));
+        y    = miopen::TensorDescriptor(*type, make_lens(batch, k, y_dims));
+        conv = miopen::ConvolutionDescriptor(spatial,
+                                             miopenConvolution,
+                                             miopenPaddingDefault,
+                                             pads,
+                                             strides,
+                                             dilation,
+                                             std::vector<int>(spatial, 0),
+                                             groups);
+        return true;
+    }
+
+    void Compile(miopen::Handle& handle, miopen::solver::Id id) const
+    {
+        switch(direction)
+        {
+        case 'F': conv.CompileForwardSolution(handle, w, x, y, id); break;
+        case 'B': conv.CompileBackwardSolution(handle, y, w, x, id); break;
+        case 'W': conv.CompileWrwSolution(handle, y, x, w, id); break;
+        default: MIOPEN_THROW("Unknown direction: " + std::string(1, direction));
+        }
+    }
+};
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if(argc != 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <find-db.txt> <output.kdb>" << std::endl;
+        return 1;
+    }
+    const auto input_path  = std::string{argv[1]};
+    const auto output_path = boost::filesystem::path{argv[2]};
+
+    // Kernels are collected in a private cache which becomes the output.
+    const auto cache_dir =
+        boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("miopen-%%%%");
+    setenv("MIOPEN_CUSTOM_CACHE_DIR", cache_dir.string().c_str(), 1);
+
+    std::ifstream input{input_path};
+    if(!input)
+    {
+        std::cerr << "Unable to open " << input_path << std::endl;
+        return 1;
+    }
+
+    miopen::Handle handle;
+    const auto basename = handle.GetDbBasename();
+    if(!miopen::StartsWith(boost::filesystem::path{input_path}.filename().string(), basename))
+    {
+        std::cerr << input_path << " does not match the device " << basename << std::endl;
+        return 1;
+    }
+
+    std::size_t n_compiled = 0;
+    std::size_t n_failed   = 0;
+    std::size_t n_skipped  = 0;
+    std::string line;
+    while(std::getline(input, line))
+    {
+        const auto eq = line.find('=');
+        if(eq == std::string::npos)
+            continue;
+        Problem problem;
+        try
+        {
+            if(!problem.Parse(line.substr(0, eq)))
+            {
+                ++n_skipped;
+                continue;
+            }
+        }
+        catch(const std::exception&)
+        {
+            ++n_skipped;
+            continue;
+        }
+
+        // algorithm:solver,time,workspace,algorithm,cache_key;...
+        for(const auto& value : Split(line.substr(eq + 1), ';'))
+        {
+            const auto colon = value.find(':');
+            if(colon == std::string::npos)
+                continue;
+            const auto solver = value.substr(colon + 1, value.find(',', colon) - colon - 1);
+            const auto id     = miopen::solver::Id{solver};
+            if(!id.IsValid())
+            {
+                ++n_skipped;
+                continue;
+            }
+            try
+            {
+                problem.Compile(handle, id);
+                ++n_compiled;
+            }
+            catch(const std::exception& ex)
+            {
+                std::cerr << line.substr(0, eq) << ' ' << solver << ": " << ex.what()
+                          << std::endl;
+                ++n_failed;
+            }
+        }
+    }
+
+    const auto user_kdb = miopen::GetCachePath(false) / (basename + ".ukdb");
+    if(!boost::filesystem::exists(user_kdb))
+    {
+        std::cerr << "No kernels were built" << std::endl;
+        return 1;
+    }
+    boost::filesystem::copy_file(
+        user_kdb, output_path, boost::filesystem::copy_option::overwrite_if_exists);
+
+    // Kernels found in the installed system cache were not rebuilt, take them from there.
+    const auto sys_kdb = miopen::GetCachePath(true) / (basename + ".kdb");
+    if(!miopen::GetCachePath(true).empty() && boost::filesystem::exists(sys_kdb) &&
+       !boost::filesystem::equivalent(sys_kdb, output_path))
+    {
+        const auto columns = "kernel_name, kernel_args, kernel_blob, kernel_hash, "
+                             "uncompressed_size";
+        miopen::SQLite db{output_path.string(), false};
+        db.Exec("ATTACH DATABASE '" + sys_kdb.string() + "' AS sys;" +
+                "INSERT OR IGNORE INTO kern_db (" + columns + ") SELECT " + columns +
+                " FROM sys.kern_db; DETACH DATABASE sys;");
+    }
+    boost::filesystem::remove_all(cache_dir);
+
+    std::cout << input_path << ": " << n_compiled << " solutions built, " << n_failed
+              << " failed, " << n_skipped << " skipped -> " << output_path.string() << std::endl;
+    return 0;
+}
@@ -0,0 +1,21 @@
+#!/usr/bin/env bash
+# Runs Find for a convolution at every batch size of a bucket set, so that the user find-db
+# holds a record per bucket for MIOPEN_FIND_BATCH_BUCKETS to fall back on, e.g.
+#   pretune_batch_buckets.sh 1,8,16,32,64 conv -c 64 -H 56 -W 56 -k 64 -y 3 -x 3 -p 1 -q 1
+# All the arguments after the buckets go to MIOpenDriver, followed by -n <bucket>. Add -s 1
+# to tune the solvers as well. MIOPEN_DRIVER selects the driver binary.
+if [ $# -lt 2 ];
+then
+    echo "Usage: $0 <bucket>[,<bucket>...] <MIOpenDriver arguments without -n>"
+    exit 1
+fi
+
+DRIVER=${MIOPEN_DRIVER:-$(dirname "$0")/MIOpenDriver}
+BUCKETS=$1
+shift
+
+for n in ${BUCKETS//,/ };
+do
+    echo "$DRIVER $* -n $n -V 0 -i 1"
+    "$DRIVER" "$@" -n "$n" -V 0 -i 1 || exit $?
+done
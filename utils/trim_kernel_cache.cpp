@@ -0,0 +1,103 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Bounds the user kernel caches (*.ukdb) on shared build nodes, e.g.
+//   MIOpenTrimKernelCache --policy cheapest 512 ~/.cache/miopen/2.11.0.0
+// Every file is trimmed to the budget on its own. Directories are searched for *.ukdb files.
+
+#include <miopen/kern_db.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[])
+{
+    auto policy = miopenKernelCacheEvictLeastRecentlyUsed;
+    auto args   = std::vector<std::string>{};
+    for(auto i = 1; i < argc; ++i)
+    {
+        if(std::strcmp(argv[i], "--policy") == 0 && i + 1 < argc)
+        {
+            const std::string name = argv[++i];
+            if(name == "cheapest")
+                policy = miopenKernelCacheEvictCheapest;
+            else if(name != "lru")
+            {
+                std::cerr << "Unknown policy: " << name << std::endl;
+                return 1;
+            }
+        }
+        else
+            args.emplace_back(argv[i]);
+    }
+
+    if(args.size() < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " [--policy lru|cheapest] <max-MB> <cache>..."
+                  << std::endl;
+        std::cerr << "Removes entries from each kernel cache until its code objects take at most "
+                     "max-MB. lru removes the entries loaded longest ago first, cheapest those "
+                     "with the lowest compile time per byte, keeping the expensive kernels."
+                  << std::endl;
+        return 1;
+    }
+
+    const auto max_bytes = std::strtoull(args.front().c_str(), nullptr, 10) * 1024 * 1024;
+
+    auto files = std::vector<boost::filesystem::path>{};
+    for(auto i = std::size_t{1}; i < args.size(); ++i)
+    {
+        const auto path = boost::filesystem::path{args[i]};
+        if(boost::filesystem::is_directory(path))
+        {
+            for(const auto& entry : boost::filesystem::recursive_directory_iterator{path})
+                if(entry.path().extension() == ".ukdb")
+                    files.push_back(entry.path());
+        }
+        else if(boost::filesystem::exists(path))
+            files.push_back(path);
+        else
+        {
+            std::cerr << "Unable to open " << path.string() << std::endl;
+            return 1;
+        }
+    }
+
+    for(const auto& file : files)
+    {
+        auto db           = miopen::KernDb{file.string(), false, "", 0};
+        const auto result = db.Trim(max_bytes, policy);
+        std::cout << file.string() << ": removed " << result.removed_entries << " entries, "
+                  << result.removed_bytes << " bytes, " << result.remaining_bytes
+                  << " bytes remain" << std::endl;
+    }
+    return 0;
+}